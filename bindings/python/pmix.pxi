@@ -1,8 +1,9 @@
-from libc.string cimport memset, strncpy, strcpy, strlen, strdup
+from libc.string cimport memset, strncpy, strcpy, strlen, strdup, strncmp
 from libc.stdlib cimport malloc, realloc, free
 from libc.string cimport memcpy
 from cpython.mem cimport PyMem_Malloc, PyMem_Realloc, PyMem_Free
 from cpython.pycapsule cimport PyCapsule_New, PyCapsule_GetPointer
+from cpython.bytearray cimport PyByteArray_FromStringAndSize
 
 # pull in all the constant definitions - we
 # store them in a separate file for neatness
@@ -32,13 +33,9 @@ class myLock(threading.Event):
         return self.status
 
     def cache_data(self, data, sz):
-        self.data = array.array('B', data[0])
         # need to copy the data bytes as the
         # PMIx server will free it upon return
-        n = 1
-        while n < sz:
-            self.data.append(data[n])
-            n += 1
+        self.data = array.array('B', data)
         self.sz = sz
 
     def fetch_data(self):
@@ -56,6 +53,56 @@ class myLock(threading.Event):
         for x in self.info:
             info.append(x)
 
+# deliver the completions of non-blocking requests to an asyncio
+# event loop. Callbacks run on the PMIx progress thread, so they
+# queue their result here and wake the loop through a pipe that
+# the loop watches. Only the first completion queued while the
+# loop is busy writes to the pipe - the loop then resolves every
+# future queued by the time it gets to run, so thousands of
+# requests completing together cost a handful of wakeups
+class pmixAsyncBridge:
+    def __init__(self, loop):
+        self.loop = loop
+        self.lock = threading.Lock()
+        self.pending = collections.deque()
+        self.signalled = False
+        self.rfd, self.wfd = os.pipe()
+        os.set_blocking(self.rfd, False)
+        os.set_blocking(self.wfd, False)
+        loop.add_reader(self.rfd, self.drain)
+
+    # called from the progress thread
+    def post(self, fut, result):
+        with self.lock:
+            self.pending.append((fut, result))
+            wake = not self.signalled
+            self.signalled = True
+        if wake:
+            try:
+                os.write(self.wfd, b'x')
+            except BlockingIOError:
+                # the loop already has a wakeup waiting
+                pass
+
+    # called in the event loop
+    def drain(self):
+        try:
+            os.read(self.rfd, 4096)
+        except BlockingIOError:
+            pass
+        with self.lock:
+            ready = self.pending
+            self.pending = collections.deque()
+            self.signalled = False
+        for fut, result in ready:
+            if not fut.cancelled():
+                fut.set_result(result)
+
+    def close(self):
+        self.loop.remove_reader(self.rfd)
+        os.close(self.rfd)
+        os.close(self.wfd)
+
 ctypedef struct pmix_pyshift_t:
     char *op
     pmix_byte_object_t payload
@@ -365,13 +412,10 @@ cdef int pmix_load_darray(pmix_data_array_t *array, mytype, mylist:list):
         n = 0
         boptr = <pmix_byte_object_t*>array[0].array
         for item in mylist:
-            boptr[n].size = item['size']
-            boptr[n].bytes = <char*> PyMem_Malloc(boptr[n].size)
-            if not boptr[n].bytes:
-                return PMIX_ERR_NOMEM
-            pyarr = bytes(item['bytes'])
-            pyptr = <const char*> pyarr
-            memcpy(boptr[n].bytes, pyptr, boptr[n].size)
+            rc = pmix_load_bytes(&boptr[n].bytes, &boptr[n].size,
+                                 item['bytes'], item.get('size'))
+            if PMIX_SUCCESS != rc:
+                return rc
             n += 1
     elif PMIX_PERSISTENCE == mytype:
         array[0].array = PyMem_Malloc(mysize * sizeof(pmix_persistence_t))
@@ -721,7 +765,8 @@ cdef dict pmix_unload_darray(pmix_data_array_t *array):
         while n < array.size:
             if not boptr[n].bytes:
                 return PMIX_ERR_NOMEM
-            d = {'bytes': boptr[n].bytes, 'size': boptr[n].size}
+            d = {'bytes': pmix_copy_bytes(boptr[n].bytes, boptr[n].size),
+                 'size': boptr[n].size}
             list.append(d)
             PyMem_Free(boptr[n].bytes)
             n += 1
@@ -1088,14 +1133,11 @@ cdef int pmix_load_value(pmix_value_t *value, val:dict):
             print("uint32 value is out of bounds")
             return PMIX_ERR_BAD_PARAM
         value[0].data.proc[0].rank = val['value']['rank']
-    # TODO: pmix byte object conversion isn't working
     elif val['val_type'] == PMIX_BYTE_OBJECT:
-        value[0].data.bo.size = val['value']['size']
-        value[0].data.bo.bytes = <char*> PyMem_Malloc(value[0].data.bo.size)
-        if not value[0].data.bo.bytes:
-            return PMIX_ERR_NOMEM
-        pyptr = <char*>val['value']['bytes']
-        memcpy(value[0].data.bo.bytes, pyptr, value[0].data.bo.size)
+        rc = pmix_load_bytes(&value[0].data.bo.bytes, &value[0].data.bo.size,
+                             val['value']['bytes'], val['value'].get('size'))
+        if PMIX_SUCCESS != rc:
+            return rc
     elif val['val_type'] == PMIX_PERSISTENCE:
         # pmix_persistence_t is defined as uint8
         if not isinstance(val['value'], pmix_int_types):
@@ -1536,6 +1578,48 @@ cdef void pmix_free_queries(pmix_query_t *queries, size_t sz):
     if queries != NULL:
         PyMem_Free(queries)
 
+# Convert a list of query dictionaries, each with a list of
+# 'keys' and a list of 'qualifiers' dictionaries, into a
+# PyMem-allocated array of pmix_query_t structs
+#
+# @queries [OUTPUT]
+#          - the array, NULL if pyq is empty
+#
+# @nqueries [OUTPUT]
+#           - number of elements in the array
+cdef int pmix_load_queries(pmix_query_t **queries, size_t *nqueries, pyq:list):
+    cdef pmix_query_t *qry
+    cdef size_t n = 0
+
+    queries[0] = NULL
+    nqueries[0] = 0
+    if pyq is None or 0 == len(pyq):
+        return PMIX_SUCCESS
+    qry = <pmix_query_t*> PyMem_Malloc(len(pyq) * sizeof(pmix_query_t))
+    if not qry:
+        return PMIX_ERR_NOMEM
+    memset(qry, 0, len(pyq) * sizeof(pmix_query_t))
+    for q in pyq:
+        nstrings = len(q['keys'])
+        if 0 < nstrings:
+            qry[n].keys = <char **> PyMem_Malloc((nstrings+1) * sizeof(char*))
+            if not qry[n].keys:
+                pmix_free_queries(qry, len(pyq))
+                return PMIX_ERR_NOMEM
+            rc = pmix_load_argv(qry[n].keys, q['keys'])
+            if PMIX_SUCCESS != rc:
+                pmix_free_queries(qry, len(pyq))
+                return rc
+        # allocate and load pmix info structs from python list of dictionaries
+        rc = pmix_alloc_info(&qry[n].qualifiers, &qry[n].nqual, q['qualifiers'])
+        if PMIX_SUCCESS != rc:
+            pmix_free_queries(qry, len(pyq))
+            return rc
+        n += 1
+    queries[0] = qry
+    nqueries[0] = n
+    return PMIX_SUCCESS
+
 # Convert a list of (nspace, rank) tuples into an
 # array of pmix_proc_t structs
 #
@@ -1545,21 +1629,33 @@ cdef void pmix_free_queries(pmix_query_t *queries, size_t sz):
 # @peers [INPUT]
 #       - list of (nspace,rank) tuples
 #
+# Proc arrays are normally long runs of ranks from the same nspace,
+# so the nspace is only encoded when it changes and otherwise copied
+# from the previous entry
 cdef int pmix_load_procs(pmix_proc_t *proc, peers:list):
-    n = 0
+    cdef size_t n = 0
+    lastns = None
     for p in peers:
-        pmix_copy_nspace(proc[n].nspace, p['nspace'])
+        ns = p['nspace']
+        if 0 < n and ns == lastns:
+            memcpy(proc[n].nspace, proc[n-1].nspace, PMIX_MAX_NSLEN+1)
+        else:
+            pmix_copy_nspace(proc[n].nspace, ns)
+            lastns = ns
         proc[n].rank = p['rank']
         n += 1
     return PMIX_SUCCESS
 
+# Likewise, decode each nspace once per run and share the resulting
+# string among all the entries of that run
 cdef int pmix_unload_procs(const pmix_proc_t *procs, size_t nprocs, peers:list):
-    cdef char* kystr
-    n = 0
+    cdef size_t n = 0
+    cdef const char *last = NULL
+    myns = None
     while n < nprocs:
-        kystr = strdup(procs[n].nspace)
-        myns = kystr.decode('ascii')
-        free(kystr)
+        if NULL == last or 0 != strncmp(last, procs[n].nspace, PMIX_MAX_NSLEN):
+            last = procs[n].nspace
+            myns = last[:strlen(last)].decode('ascii')
         peers.append({'nspace':myns, 'rank':procs[n].rank})
         n += 1
     return PMIX_SUCCESS
@@ -1575,11 +1671,33 @@ cdef int pmix_unload_procs(const pmix_proc_t *procs, size_t nprocs, peers:list):
 cdef void pmix_free_procs(pmix_proc_t *array, size_t sz):
     PyMem_Free(array)
 
-cdef void pmix_unload_bytes(char *data, size_t ndata, blist:list):
-    cdef size_t n = 0
-    while n < ndata:
-        blist.append(data[n])
-        n += 1
+# Copy a block of bytes into a Python bytearray with a single
+# memcpy - the block belongs to the PMIx library and will be
+# released when we return, so it cannot be referenced in place
+cdef object pmix_copy_bytes(const char *data, size_t ndata):
+    if NULL == data or 0 == ndata:
+        return bytearray()
+    return PyByteArray_FromStringAndSize(data, ndata)
+
+# Copy the contents of any object supporting the buffer protocol
+# (bytes, bytearray, memoryview, array.array, numpy arrays, ...)
+# into a PyMem-allocated block without an intermediate Python copy.
+# If size is given, only that many bytes are taken
+cdef int pmix_load_bytes(char **dest, size_t *ndest, obj, size=None):
+    cdef const unsigned char[::1] view = memoryview(obj).cast('B')
+    cdef size_t n = view.shape[0]
+
+    if size is not None and size < n:
+        n = size
+    dest[0] = NULL
+    ndest[0] = n
+    if 0 == n:
+        return PMIX_SUCCESS
+    dest[0] = <char*> PyMem_Malloc(n)
+    if not dest[0]:
+        return PMIX_ERR_NOMEM
+    memcpy(dest[0], &view[0], n)
+    return PMIX_SUCCESS
 
 cdef void pmix_free_apps(pmix_app_t *array, size_t sz):
     n = 0
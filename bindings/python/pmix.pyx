@@ -12,6 +12,7 @@ import threading, ctypes
 import queue
 import array
 import os
+import asyncio, collections
 #import time
 from threading import Timer
 
@@ -98,12 +99,79 @@ progressThread = threading.Thread(target = pyevhdlr, args =(lambda : stop_progre
 # if we should terminate without finalizing
 progressThread.setDaemon(True)
 
+# non-blocking requests issued through the *_async methods, keyed
+# by the id we pass to the library as the cbdata of the request
+async_lock = threading.Lock()
+async_requests = {}
+async_reqid = 0
+async_bridges = {}
+
+# get the bridge for the given loop, or for the running loop
+def pmix_async_bridge(loop=None):
+    if loop is None:
+        try:
+            loop = asyncio.get_running_loop()
+        except RuntimeError:
+            loop = asyncio.get_event_loop()
+    with async_lock:
+        bridge = async_bridges.get(loop)
+        if bridge is None:
+            bridge = pmixAsyncBridge(loop)
+            async_bridges[loop] = bridge
+    return bridge
+
+# stop delivering completions to the given loop - to be called
+# before the loop is closed
+def pmix_async_close(loop):
+    with async_lock:
+        bridge = async_bridges.pop(loop, None)
+    if bridge is not None:
+        bridge.close()
+
+cdef size_t pmix_async_track(bridge, fut):
+    global async_reqid
+    with async_lock:
+        async_reqid += 1
+        # the list holds the batches of a streamed answer
+        async_requests[async_reqid] = (bridge, fut, [])
+        return async_reqid
+
+cdef void pmix_async_untrack(size_t reqid):
+    with async_lock:
+        async_requests.pop(reqid, None)
+
+cdef void pmix_async_query_cbfunc(pmix_status_t status,
+                                  pmix_info_t *info, size_t ninfo,
+                                  void *cbdata,
+                                  pmix_release_cbfunc_t release_fn,
+                                  void *release_cbdata) with gil:
+    cdef size_t reqid = <size_t>cbdata
+    pyresults = []
+    if NULL != info:
+        pmix_unload_info(info, ninfo, pyresults)
+    if NULL != release_fn:
+        release_fn(release_cbdata)
+    with async_lock:
+        if PMIX_QUERY_PARTIAL_SUCCESS == status:
+            # more to come - hold this batch
+            req = async_requests.get(reqid)
+            if req is not None:
+                req[2].extend(pyresults)
+            return
+        req = async_requests.pop(reqid, None)
+    if req is None:
+        return
+    bridge, fut, held = req
+    held.extend(pyresults)
+    bridge.post(fut, (status, held))
+    return
+
 cdef void dmodx_cbfunc(pmix_status_t status,
                        char *data, size_t sz,
                        void *cbdata):
     global active
     if PMIX_SUCCESS == status:
-        active.cache_data(data, sz)
+        active.cache_data(data[:sz], sz)
     active.set(status)
     return
 
@@ -485,7 +553,9 @@ cdef class PMIxClient:
         return rc
 
     def commit(self):
-        rc = PMIx_Commit()
+        cdef pmix_status_t rc
+        with nogil:
+            rc = PMIx_Commit()
         return rc
 
     def fence(self, peers:list, dicts:list):
@@ -493,6 +563,7 @@ cdef class PMIxClient:
         cdef pmix_info_t *info
         cdef pmix_info_t **info_ptr
         cdef size_t ninfo, nprocs
+        cdef pmix_status_t rc
         nprocs = 0
         ninfo = 0
         # convert list of procs to array of pmix_proc_t's
@@ -529,7 +600,8 @@ cdef class PMIxClient:
             return rc
 
         # pass it into the fence API
-        rc = PMIx_Fence(procs, nprocs, info, ninfo)
+        with nogil:
+            rc = PMIx_Fence(procs, nprocs, info, ninfo)
         if 0 < nprocs:
             pmix_free_procs(procs, nprocs)
         if 0 < ninfo:
@@ -556,6 +628,7 @@ cdef class PMIxClient:
         cdef pmix_key_t key;
         cdef pmix_value_t *val_ptr;
         cdef pmix_proc_t p;
+        cdef pmix_status_t rc
 
         ninfo   = 0
         val_ptr = NULL
@@ -578,7 +651,8 @@ cdef class PMIxClient:
         val = None
 
         # pass it into the get API
-        rc = PMIx_Get(&p, key, info, ninfo, &val_ptr)
+        with nogil:
+            rc = PMIx_Get(&p, key, info, ninfo, &val_ptr)
         if PMIX_SUCCESS == rc:
             val = pmix_unload_value(val_ptr)
             pmix_free_value(self, val_ptr)
@@ -764,6 +838,7 @@ cdef class PMIxClient:
         cdef pmix_info_t **info_ptr
         cdef size_t ninfo
         cdef size_t nprocs
+        cdef pmix_status_t rc
         nprocs = 0
         ninfo = 0
 
@@ -798,7 +873,8 @@ cdef class PMIxClient:
         rc = pmix_alloc_info(info_ptr, &ninfo, pyinfo)
 
         # Call the library
-        rc = PMIx_Connect(procs, nprocs, info, ninfo)
+        with nogil:
+            rc = PMIx_Connect(procs, nprocs, info, ninfo)
         if 0 < nprocs:
             pmix_free_procs(procs, nprocs)
         if 0 < ninfo:
@@ -811,6 +887,7 @@ cdef class PMIxClient:
         cdef pmix_info_t **info_ptr
         cdef size_t ninfo
         cdef size_t nprocs
+        cdef pmix_status_t rc
         nprocs = 0
         ninfo = 0
 
@@ -845,7 +922,8 @@ cdef class PMIxClient:
         rc = pmix_alloc_info(info_ptr, &ninfo, pyinfo)
 
         # Call the library
-        rc = PMIx_Disconnect(procs, nprocs, info, ninfo)
+        with nogil:
+            rc = PMIx_Disconnect(procs, nprocs, info, ninfo)
         if 0 < nprocs:
             pmix_free_procs(procs, nprocs)
         if 0 < ninfo:
@@ -892,47 +970,20 @@ cdef class PMIxClient:
         cdef pmix_query_t *queries
         cdef size_t nqueries
         cdef pmix_info_t *results
-        cdef pmix_info_t **results_ptr
         cdef size_t nresults
-        cdef pmix_info_t **qual_ptr
-        nqueries   = 0
+        cdef pmix_status_t rc
         nresults   = 0
-        queries    = NULL
-        qual_ptr   = NULL
+        results    = NULL
 
         pyresults = []
-        if pyq is not None:
-            nqueries = len(pyq)
-            if 0 < nqueries:
-                queries = <pmix_query_t*> PyMem_Malloc(nqueries * sizeof(pmix_query_t))
-                if not queries:
-                    return PMIX_ERR_NOMEM,pyresults
-                n = 0
-                for q in pyq:
-                    queries[n].keys       = NULL
-                    queries[n].qualifiers = NULL
-                    nstrings = len(q['keys'])
-                    if 0 < nstrings:
-                        queries[n].keys = <char **> PyMem_Malloc((nstrings+1) * sizeof(char*))
-                        if not queries[n].keys:
-                            pmix_free_queries(queries, nqueries)
-                            return PMIX_ERR_NOMEM,pyresults
-                        rc = pmix_load_argv(queries[n].keys, q['keys'])
-                        if PMIX_SUCCESS != rc:
-                            pmix_free_queries(queries, nqueries)
-                            return rc,pyresults
-                    # allocate and load pmix info structs from python list of dictionaries
-                    queries[n].nqual = 0
-                    qual_ptr         = &(queries[n].qualifiers)
-                    rc               = pmix_alloc_info(qual_ptr, &(queries[n].nqual), q['qualifiers'])
-                    n += 1
-            else:
-                nqueries = 0
-        else:
-            nqueries = 0
+        rc = pmix_load_queries(&queries, &nqueries, pyq)
+        if PMIX_SUCCESS != rc:
+            return rc,pyresults
 
-        # pass it into the query_info API
-        rc = PMIx_Query_info(queries, nqueries, &results, &nresults)
+        # pass it into the query_info API - it blocks until the
+        # answer arrives, so let other Python threads run meanwhile
+        with nogil:
+            rc = PMIx_Query_info(queries, nqueries, &results, &nresults)
         if PMIX_SUCCESS == rc:
             rc = pmix_unload_info(results, nresults,  pyresults)
             # free results info structs
@@ -941,6 +992,38 @@ cdef class PMIxClient:
         pmix_free_queries(queries, nqueries)
         return rc, pyresults
 
+    # Non-blocking version of query for use with asyncio - returns
+    # an asyncio.Future that is resolved in the given (or the
+    # running) event loop with the (status, results) tuple
+    #
+    # @pyq [INPUT]
+    #      - list of query dictionaries, as for query
+    #
+    # @loop [INPUT]
+    #       - the asyncio event loop to deliver the result to
+    def query_async(self, pyq:list, loop=None):
+        cdef pmix_query_t *queries
+        cdef size_t nqueries
+        cdef pmix_status_t rc
+        cdef size_t reqid
+
+        bridge = pmix_async_bridge(loop)
+        fut = bridge.loop.create_future()
+        rc = pmix_load_queries(&queries, &nqueries, pyq)
+        if PMIX_SUCCESS != rc:
+            fut.set_result((rc, []))
+            return fut
+
+        reqid = pmix_async_track(bridge, fut)
+        with nogil:
+            rc = PMIx_Query_info_nb(queries, nqueries, pmix_async_query_cbfunc, <void*>reqid)
+        # the library has its own copy of the queries
+        pmix_free_queries(queries, nqueries)
+        if PMIX_SUCCESS != rc:
+            pmix_async_untrack(reqid)
+            fut.set_result((rc, []))
+        return fut
+
     def log(self, pydata:list, pydirs:list):
         cdef pmix_info_t *data
         cdef pmix_info_t **data_ptr
@@ -1107,12 +1190,10 @@ cdef class PMIxClient:
         rc = PMIx_Get_credential(info, ninfo, boptr)
         if 0 < ninfo:
             pmix_free_info(info, ninfo)
-        blist = []
         cred = {}
         if PMIX_SUCCESS == rc and 0 < bo.size:
             # convert the results
-            pmix_unload_bytes(bo.bytes, bo.size, blist)
-            barray = bytearray(blist)
+            barray = pmix_copy_bytes(bo.bytes, bo.size)
             cred['bytes'] = barray
             cred['size'] = bo.size
         return rc, cred
@@ -2219,7 +2300,6 @@ cdef int fencenb(const pmix_proc_t procs[], size_t nprocs,
     if 'fencenb' in keys:
         args = {}
         myprocs = []
-        blist = []
         ilist = []
         barray = None
 
@@ -2234,8 +2314,7 @@ cdef int fencenb(const pmix_proc_t procs[], size_t nprocs,
                 return rc
             args['directives'] = ilist
         if NULL != data:
-            pmix_unload_bytes(data, ndata, blist)
-            barray = bytearray(blist)
+            barray = pmix_copy_bytes(data, ndata)
             args['data'] = barray
         rc, ret_data = pmixservermodule['fencenb'](args)
     else:
@@ -2976,14 +3055,12 @@ cdef int validatecredential(const pmix_proc_t *proc,
         keyvals = {}
         myproc = []
         mydirs = {}
-        blist = []
         pycred = {}
         if NULL != proc:
             pmix_unload_procs(proc, 1, myproc)
             args['source'] = myproc[0]
         if NULL != cred:
-            pmix_unload_bytes(cred[0].bytes, cred[0].size, blist)
-            barray = bytearray(blist)
+            barray = pmix_copy_bytes(cred[0].bytes, cred[0].size)
             pycred['bytes'] = barray
             pycred['size'] = cred[0].size
             args['credential'] = pycred
@@ -3075,7 +3152,6 @@ cdef int pushstdin(const pmix_proc_t *source,
         myproc = []
         mytargets = []
         mydirs = {}
-        blist = []
         pyload = {}
         if NULL != source:
             pmix_unload_procs(source, 1, myproc)
@@ -3087,8 +3163,7 @@ cdef int pushstdin(const pmix_proc_t *source,
             pmix_unload_info(directives, ndirs, mydirs)
             args['directives'] = mydirs
         if NULL != bo:
-            pmix_unload_bytes(bo[0].bytes, bo[0].size, blist)
-            barray = bytearray(blist)
+            barray = pmix_copy_bytes(bo[0].bytes, bo[0].size)
             pyload['bytes'] = barray
             pyload['size'] = bo[0].size
             args['payload'] = pyload
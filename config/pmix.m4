@@ -397,7 +397,9 @@ AC_DEFUN([PMIX_SETUP_CORE],[
                       netdb.h ucred.h zlib.h sys/auxv.h \
                       sys/sysctl.h termio.h termios.h pty.h \
                       libutil.h util.h grp.h sys/cdefs.h utmp.h stropts.h \
-                      sys/utsname.h])
+                      sys/utsname.h sys/eventfd.h sys/inotify.h spawn.h \
+                      sys/syscall.h linux/io_uring.h \
+                      linux/netlink.h linux/rtnetlink.h])
 
     AC_CHECK_HEADERS([sys/mount.h], [], [],
                      [AC_INCLUDES_DEFAULT
@@ -646,7 +648,7 @@ AC_DEFUN([PMIX_SETUP_CORE],[
     # -lrt might be needed for clock_gettime
     PMIX_SEARCH_LIBS_CORE([clock_gettime], [rt])
 
-    AC_CHECK_FUNCS([asprintf snprintf vasprintf vsnprintf strsignal socketpair strncpy_s usleep statfs statvfs getpeereid getpeerucred strnlen posix_fallocate tcgetpgrp setpgid ptsname openpty setenv fork execve waitpid atexit])
+    AC_CHECK_FUNCS([asprintf snprintf vasprintf vsnprintf strsignal socketpair strncpy_s usleep statfs statvfs getpeereid getpeerucred strnlen posix_fallocate tcgetpgrp setpgid ptsname openpty setenv fork execve waitpid atexit posix_spawn posix_spawn_file_actions_addclosefrom_np])
 
     # On some hosts, htonl is a define, so the AC_CHECK_FUNC will get
     # confused.  On others, it's in the standard library, but stubbed with
@@ -1212,6 +1214,28 @@ fi
 AC_DEFINE_UNQUOTED([PMIX_ENABLE_TIMING], [$WANT_PMIX_TIMING],
                    [Whether we want developer-level timing support or not])
 
+#
+# USDT tracepoints
+#
+AC_MSG_CHECKING([if want USDT tracepoints])
+AC_ARG_ENABLE(pmix-usdt,
+              AS_HELP_STRING([--enable-pmix-usdt],
+                             [compile static USDT tracepoints into PMIx hot paths - requires sys/sdt.h (default: disabled)]))
+WANT_PMIX_USDT=0
+if test "$enable_pmix_usdt" = "yes"; then
+    AC_MSG_RESULT([yes])
+    AC_CHECK_HEADER([sys/sdt.h],
+                    [WANT_PMIX_USDT=1],
+                    [AC_MSG_WARN([USDT tracepoints were requested but sys/sdt.h])
+                     AC_MSG_WARN([was not found - install the SystemTap SDT headers])
+                     AC_MSG_ERROR([Cannot continue])])
+else
+    AC_MSG_RESULT([no])
+fi
+
+AC_DEFINE_UNQUOTED([PMIX_ENABLE_USDT], [$WANT_PMIX_USDT],
+                   [Whether we want USDT tracepoints or not])
+
 #
 # Do we want to install binaries?
 #
@@ -359,6 +359,38 @@ AC_DEFUN([PMIX_SETUP_CC],[
     AC_DEFINE_UNQUOTED([PMIX_C_HAVE_BUILTIN_CLZ], [$have_cc_builtin_clz],
         [Whether C compiler supports __builtin_clz])
 
+    # see if the C compiler supports __builtin_popcountll
+    AC_CACHE_CHECK([if $CC supports __builtin_popcountll],
+        [pmix_cv_cc_supports___builtin_popcountll],
+        [AC_LINK_IFELSE([AC_LANG_PROGRAM([
+            [unsigned long long value = 0xffffULL; /* we know we have 16 bits set */
+             if (16 != __builtin_popcountll(value)) return 0;]],
+            [pmix_cv_cc_supports___builtin_popcountll="yes"],
+            [pmix_cv_cc_supports___builtin_popcountll="no"])])])
+    if test "$pmix_cv_cc_supports___builtin_popcountll" = "yes" ; then
+        have_cc_builtin_popcount=1
+    else
+        have_cc_builtin_popcount=0
+    fi
+    AC_DEFINE_UNQUOTED([PMIX_C_HAVE_BUILTIN_POPCOUNT], [$have_cc_builtin_popcount],
+        [Whether C compiler supports __builtin_popcountll])
+
+    # see if the C compiler supports __builtin_ctzll
+    AC_CACHE_CHECK([if $CC supports __builtin_ctzll],
+        [pmix_cv_cc_supports___builtin_ctzll],
+        [AC_LINK_IFELSE([AC_LANG_PROGRAM([
+            [unsigned long long value = 0x10000ULL; /* we know bit 16 is the lowest set */
+             if (16 != __builtin_ctzll(value)) return 0;]],
+            [pmix_cv_cc_supports___builtin_ctzll="yes"],
+            [pmix_cv_cc_supports___builtin_ctzll="no"])])])
+    if test "$pmix_cv_cc_supports___builtin_ctzll" = "yes" ; then
+        have_cc_builtin_ctz=1
+    else
+        have_cc_builtin_ctz=0
+    fi
+    AC_DEFINE_UNQUOTED([PMIX_C_HAVE_BUILTIN_CTZ], [$have_cc_builtin_ctz],
+        [Whether C compiler supports __builtin_ctzll])
+
     # Preload the optflags for the case where the user didn't specify
     # any.  If we're using GNU compilers, use -O3 (since it GNU
     # doesn't require all compilation units to be compiled with the
@@ -17,6 +17,8 @@ import sys
 from optparse import OptionParser, OptionGroup
 
 index = 0
+# attribute strings in dictionary order, for the lookup table
+keystrings = []
 
 
 def harvest_constants(options, path, constants):
@@ -74,6 +76,7 @@ def harvest_constants(options, path, constants):
                     firstline = False
                     constants.write("    {.index = " + str(index) + ", .name = \"" + tokens[0] + "\", .string = " + tokens[1])
                     index = index + 1
+                    keystrings.append(tokens[1].strip('"'))
                     # only one attribute violates the one-word rule for type
                     if tokens[0] == "PMIX_EVENT_BASE":
                         dstart = 3
@@ -149,6 +152,10 @@ def harvest_constants(options, path, constants):
                             datatype = "PMIX_DEVICE_DIST"
                         elif tokens[3] == "(pmix_endpoint_t)" or tokens[3] == "(pmix_endpoint_t*)":
                             datatype = "PMIX_ENDPOINT"
+                        elif tokens[3] == "(pmix_proc_stats_t)" or tokens[3] == "(pmix_proc_stats_t*)":
+                            datatype = "PMIX_PROC_STATS"
+                        elif tokens[3] == "(pmix_node_stats_t)" or tokens[3] == "(pmix_node_stats_t*)":
+                            datatype = "PMIX_NODE_STATS"
                         elif tokens[3] == "(pmix_device_type_t)":
                             datatype = "PMIX_DEVTYPE"
                         elif tokens[3] == "(varies)":
@@ -239,7 +246,65 @@ def harvest_constants(options, path, constants):
     return 0
 
 
-def _write_header(options, base_path, num_elements):
+def dictionary_hash(key, seed):
+    # must match dictionary_hash() in src/util/pmix_hash.c
+    mask = 0xffffffff
+    h = seed & mask
+    for c in bytearray(key.encode()):
+        h = (h + c) & mask
+        h = (h + (h << 10)) & mask
+        h ^= h >> 6
+    h = (h + (h << 3)) & mask
+    h ^= h >> 11
+    return (h + (h << 15)) & mask
+
+
+def _write_hash(constants):
+    # Build a perfect hash of the attribute strings by "hash and
+    # displace": keys are grouped into buckets by their unseeded
+    # hash, and each bucket is given the first seed that places all
+    # of its keys into unused slots of the table. A string that
+    # appears more than once maps to its first index, as a search
+    # of the dictionary would find
+    first = {}
+    for n, k in enumerate(keystrings):
+        if k not in first:
+            first[k] = n
+    size = 1
+    while size < len(first) + len(first) // 2:
+        size <<= 1
+    nbuckets = max(1, len(first) // 4)
+    buckets = [[] for b in range(nbuckets)]
+    for k in first:
+        buckets[dictionary_hash(k, 0) % nbuckets].append(k)
+    slots = [None] * size
+    seeds = [0] * nbuckets
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if 0 == len(buckets[b]):
+            continue
+        seed = 1
+        while True:
+            pos = [dictionary_hash(k, seed) & (size - 1) for k in buckets[b]]
+            if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+                break
+            seed += 1
+        for k, p in zip(buckets[b], pos):
+            slots[p] = first[k]
+        seeds[b] = seed
+
+    constants.write("\nconst uint32_t pmix_dictionary_hash_seeds[] = {\n")
+    for n in range(0, nbuckets, 8):
+        constants.write("    " + ", ".join(str(x) for x in seeds[n:n+8]) + ",\n")
+    constants.write("};\n")
+    constants.write("\nconst uint32_t pmix_dictionary_hash_slots[] = {\n")
+    for n in range(0, size, 8):
+        constants.write("    " + ", ".join("UINT32_MAX" if x is None else str(x)
+                                          for x in slots[n:n+8]) + ",\n")
+    constants.write("};\n")
+    return nbuckets, size
+
+
+def _write_header(options, base_path, num_elements, nbuckets, hsize):
     contents = '''/*
  * This file is autogenerated by construct_dictionary.py.
  * Do not edit this file by hand.
@@ -258,10 +323,20 @@ PMIX_EXPORT extern const pmix_regattr_input_t pmix_dictionary[{ne}];
 
 #define PMIX_INDEX_BOUNDARY {nem1}
 
+/* perfect hash of the attribute strings - the seed for a key is
+ * found from its unseeded hash modulo the number of buckets, and
+ * its seeded hash masked by the table size gives the slot holding
+ * its dictionary index (UINT32_MAX for an unused slot) */
+#define PMIX_DICTIONARY_HASH_BUCKETS {nb}
+#define PMIX_DICTIONARY_HASH_SIZE {hs}
+
+PMIX_EXPORT extern const uint32_t pmix_dictionary_hash_seeds[{nb}];
+PMIX_EXPORT extern const uint32_t pmix_dictionary_hash_slots[{hs}];
+
 END_C_DECLS
 
 #endif\n
-'''.format(ne=num_elements, nem1=num_elements - 1)
+'''.format(ne=num_elements, nem1=num_elements - 1, nb=nbuckets, hs=hsize)
 
     if options.dryrun:
         constants = sys.stdout
@@ -367,11 +442,12 @@ const pmix_regattr_input_t pmix_dictionary[] = {
     {.index = UINT32_MAX, .name = "", .string = "", .type = PMIX_POINTER, .description = (char *[]){"NONE", NULL}}
 };
 """)
+    nbuckets, hsize = _write_hash(constants)
     constants.write("\n")
     constants.close()
 
     # write the header
-    return _write_header(options, build_src_include_dir, index + 1)
+    return _write_header(options, build_src_include_dir, index + 1, nbuckets, hsize)
 
 
 if __name__ == '__main__':
@@ -0,0 +1,200 @@
+#
+# Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+# $COPYRIGHT$
+#
+# Construct a catalog of the topics in the help files of the source
+# tree so that pmix_show_help can find its messages in the library
+# itself instead of reading them from the installed files
+#
+
+from __future__ import print_function
+import os
+import os.path
+import sys
+from optparse import OptionParser, OptionGroup
+
+
+def catalog_hash(key, seed):
+    # must match catalog_hash() in src/util/pmix_show_help.c
+    h = seed
+    for c in key.encode("utf-8"):
+        h = (h + c) & 0xffffffff
+        h = (h + (h << 10)) & 0xffffffff
+        h ^= (h >> 6)
+    h = (h + (h << 3)) & 0xffffffff
+    h ^= (h >> 11)
+    return (h + (h << 15)) & 0xffffffff
+
+
+def harvest_topics(path, base, topics):
+    try:
+        with open(path, "r") as inputfile:
+            lines = inputfile.read().splitlines()
+    except Exception as e:
+        print("Error reading file {path}: {e}".format(path=path, e=e))
+        return 1
+
+    # the same parse as find_topic/read_topic in pmix_show_help.c,
+    # except that includes are kept so they resolve at runtime
+    current = None
+    for line in lines:
+        if line.startswith("["):
+            end = line.find("]")
+            if end < 0:
+                # not a valid topic - it still ends the previous one
+                current = None
+                continue
+            key = base + "#" + line[1:end]
+            if key in topics:
+                # the first one is what a search of the file finds
+                current = None
+            else:
+                current = []
+                topics[key] = current
+            continue
+        if current is None:
+            continue
+        if line.startswith("#") and not line.startswith("#include#"):
+            continue
+        current.append(line)
+    return 0
+
+
+def c_string(line):
+    out = ""
+    for c in line:
+        if c == "\\" or c == "\"":
+            out += "\\" + c
+        elif c == "\t":
+            out += "\\t"
+        elif ord(c) < 32 or ord(c) == 127:
+            out += "\\{0:03o}".format(ord(c))
+        elif c == "?":
+            # avoid forming trigraphs
+            out += "\\?"
+        else:
+            out += c
+    return out
+
+
+def write_hash(keys, catalog):
+    # hash and displace, as for the dictionary - see
+    # construct_dictionary.py
+    size = 1
+    while size < len(keys) + len(keys) // 2:
+        size <<= 1
+    nbuckets = max(1, len(keys) // 4)
+    buckets = [[] for b in range(nbuckets)]
+    for n, k in enumerate(keys):
+        buckets[catalog_hash(k, 0) % nbuckets].append(n)
+    slots = [None] * size
+    seeds = [0] * nbuckets
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if 0 == len(buckets[b]):
+            continue
+        seed = 1
+        while True:
+            pos = [catalog_hash(keys[n], seed) & (size - 1) for n in buckets[b]]
+            if len(set(pos)) == len(pos) and all(slots[p] is None for p in pos):
+                break
+            seed += 1
+        for n, p in zip(buckets[b], pos):
+            slots[p] = n
+        seeds[b] = seed
+
+    catalog.write("\nconst uint32_t pmix_show_help_catalog_nbuckets = {0};\n".format(nbuckets))
+    catalog.write("const uint32_t pmix_show_help_catalog_hsize = {0};\n".format(size))
+    catalog.write("\nconst uint32_t pmix_show_help_catalog_seeds[] = {\n")
+    for n in range(0, nbuckets, 8):
+        catalog.write("    " + ", ".join(str(x) for x in seeds[n:n+8]) + ",\n")
+    catalog.write("};\n")
+    catalog.write("\nconst uint32_t pmix_show_help_catalog_slots[] = {\n")
+    for n in range(0, size, 8):
+        catalog.write("    " + ", ".join("UINT32_MAX" if x is None else str(x)
+                                         for x in slots[n:n+8]) + ",\n")
+    catalog.write("};\n")
+
+
+def main():
+    parser = OptionParser("usage: %prog [options]")
+    debugGroup = OptionGroup(parser, "Debug Options")
+    debugGroup.add_option("--dryrun",
+                          action="store_true", dest="dryrun", default=False,
+                          help="Show output to screen")
+    parser.add_option_group(debugGroup)
+
+    (options, args) = parser.parse_args()
+
+    # Find the top-level PMIx source tree dir.
+    # Start with the location of this script, which we know is in
+    # $top_srcdir/contrib.
+    top_src_dir = os.path.dirname(sys.argv[0])
+    top_src_dir = os.path.join(top_src_dir, "..")
+    top_src_dir = os.path.abspath(top_src_dir)
+
+    # Sanity check
+    checkfile = os.path.join(top_src_dir, "VERSION")
+    if not os.path.exists(checkfile):
+        print("ERROR: Could not find top source directory for Open PMIx")
+        return 1
+
+    # collect the topics of every help file in the source tree
+    topics = {}
+    helpfiles = []
+    for dirpath, dirnames, filenames in os.walk(os.path.join(top_src_dir, "src")):
+        dirnames.sort()
+        for f in sorted(filenames):
+            if f.startswith("help-") and f.endswith(".txt"):
+                helpfiles.append((f[:-4], os.path.join(dirpath, f)))
+    for base, path in helpfiles:
+        rc = harvest_topics(path, base, topics)
+        if 0 != rc:
+            return rc
+    keys = sorted(topics.keys())
+
+    if options.dryrun:
+        catalog = sys.stdout
+        outpath = None
+    else:
+        # This script is invoked from src/util/Makefile.am, and
+        # therefore the cwd will be $(builddir)/src/util
+        outpath = os.path.join(os.getcwd(), "pmix_show_help_content.c")
+        try:
+            catalog = open(outpath, "w+")
+        except Exception as e:
+            print("{outpath} CANNOT BE OPENED - HELP CATALOG COULD NOT BE CONSTRUCTED: {e}"
+                  .format(outpath=outpath, e=e))
+            return 1
+
+    catalog.write("""/*
+ * This file is autogenerated by construct_help_catalog.py.
+ * Do not edit this file by hand.
+ */
+
+#include "src/include/pmix_config.h"
+#include "src/util/pmix_show_help.h"
+
+const pmix_show_help_topic_t pmix_show_help_catalog[] = {
+""")
+    for k in keys:
+        base, topic = k.split("#", 1)
+        catalog.write("    {{\"{0}\", \"{1}\",\n".format(c_string(base), c_string(topic)))
+        lines = topics[k]
+        if 0 == len(lines):
+            catalog.write("     \"\"},\n")
+            continue
+        # every line is terminated, so an empty line is still seen
+        for n, line in enumerate(lines):
+            tail = "},\n" if n == len(lines) - 1 else "\n"
+            catalog.write("     \"{0}\\n\"{1}".format(c_string(line), tail))
+    catalog.write("    {NULL, NULL, NULL}\n};\n")
+    catalog.write("\nconst size_t pmix_show_help_catalog_size = {0};\n".format(len(keys)))
+    write_hash(keys, catalog)
+
+    if outpath is not None:
+        catalog.close()
+    return 0
+
+
+if __name__ == '__main__':
+    exit(main())
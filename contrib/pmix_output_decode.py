@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+# Decode the file written by pmix_output when PMIX_OUTPUT_ASYNC=binary
+# - one line per message, in the order the writer thread consumed them:
+#
+#    pmix_output_decode.py /tmp/pmix-output-pid1234-async.bin
+#
+# The layout of the file is described in src/util/pmix_output_async.c
+#
+
+import re
+import struct
+import sys
+import time
+from optparse import OptionParser
+
+MAGIC = b"PMIXLOG1"
+SPEC = re.compile(r"%([-+ #0']*)(\d*)(\.\d*)?(hh|h|ll|l|q|z|j|t|L)?([diucoxXfFeEgGaAps%])")
+
+
+def read_args(data, pos, nargs, order):
+    args = []
+    for _ in range(nargs):
+        tag = chr(data[pos])
+        pos += 1
+        if tag == "i":
+            args.append(struct.unpack_from(order + "q", data, pos)[0])
+            pos += 8
+        elif tag in ("u", "p"):
+            args.append(struct.unpack_from(order + "Q", data, pos)[0])
+            pos += 8
+        elif tag == "f":
+            args.append(struct.unpack_from(order + "d", data, pos)[0])
+            pos += 8
+        elif tag == "s":
+            slen = struct.unpack_from(order + "I", data, pos)[0]
+            pos += 4
+            args.append(data[pos:pos + slen].decode("utf-8", "replace"))
+            pos += slen
+        elif tag == "n":
+            args.append("(null)")
+        else:
+            raise ValueError("unknown argument tag {}".format(tag))
+    return args
+
+
+def render(fmt, args):
+    it = iter(args)
+
+    def convert(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        value = next(it)
+        flags = flags.replace("'", "")
+        prec = prec or ""
+        if conv == "p":
+            return ("%" + flags + width + "s") % hex(value)
+        if conv == "c":
+            return ("%" + flags + width + "s") % chr(value & 0xff)
+        if conv in "aA":
+            out = float(value).hex()
+            return out.upper() if conv == "A" else out
+        if conv == "o" and "#" in flags:
+            # python would write 0o
+            return ("%" + flags.replace("#", "") + width + "s") % ("0%o" % value if value else "0")
+        if conv in "iu":
+            conv = "d"
+        elif conv == "F":
+            conv = "f"
+        return ("%" + flags + width + prec + conv) % value
+
+    return SPEC.sub(convert, fmt)
+
+
+def decode(path, out):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < 16 or data[:8] != MAGIC:
+        raise ValueError("{} is not a pmix_output binary log".format(path))
+    # the file is in the byte order of the host that wrote it
+    order = "<" if struct.unpack_from("<I", data, 12)[0] == 0x01020304 else ">"
+    header = struct.Struct(order + "IHHIIQ")
+    pos = 16
+    while pos + header.size <= len(data):
+        reclen, stream, nargs, thread, fmtlen, nsec = header.unpack_from(data, pos)
+        if reclen < header.size or pos + reclen > len(data):
+            break
+        fpos = pos + header.size
+        fmt = data[fpos:fpos + fmtlen - 1].decode("utf-8", "replace")
+        args = read_args(data, fpos + fmtlen, nargs, order)
+        stamp = time.strftime("%Y-%m-%d %H:%M:%S", time.localtime(nsec // 1000000000))
+        msg = render(fmt, args)
+        out.write("[{}.{:06d}] [thread {}] [stream {}] {}{}".format(
+            stamp, (nsec % 1000000000) // 1000, thread, stream, msg,
+            "" if msg.endswith("\n") else "\n"))
+        pos += reclen
+
+
+def main():
+    parser = OptionParser(usage="%prog file [file ...]")
+    (options, args) = parser.parse_args()
+    if not args:
+        parser.print_help()
+        return 1
+    for path in args:
+        try:
+            decode(path, sys.stdout)
+        except (IOError, ValueError) as e:
+            sys.stderr.write("{}: {}\n".format(path, e))
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
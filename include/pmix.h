@@ -215,6 +215,46 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char key[],
                                       const pmix_info_t info[], size_t ninfo,
                                       pmix_value_cbfunc_t cbfunc, void *cbdata);
 
+/* Retrieve several values at once. The "data" parameter consists of an
+ * array of pmix_pdata_t structs, each giving the proc and key of one
+ * requested value - the procs need not be the same. Values that are
+ * held locally are returned directly, while requests for data that
+ * must come from the server are combined into a single message and
+ * answered with a single reply.
+ *
+ * Each found value is returned in the value field of its pmix_pdata_t;
+ * any key that cannot be found will return with a data type of
+ * "PMIX_UNDEF". The function returns PMIX_SUCCESS if all values were
+ * found, PMIX_ERR_PARTIAL_SUCCESS if only some of them were, and
+ * PMIX_ERR_NOT_FOUND if none were. The info array applies to every
+ * request and is used as described above for PMIx_Get. */
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(pmix_pdata_t data[], size_t ndata,
+                                         const pmix_info_t info[], size_t ninfo);
+
+/* Retrieve a value without taking ownership of it. The value is
+ * written into the caller-provided pmix_value_t: scalars are held
+ * there outright, while anything the value points to - the
+ * characters of a string, the bytes of a byte object, etc. - is a
+ * borrowed view of the library's cache that must neither be modified
+ * nor released. Nothing is allocated once a value has been
+ * retrieved the first time.
+ *
+ * A borrowed view remains valid as long as PMIx_Get_epoch returns
+ * the epoch given back with it in the "epoch" parameter (which may
+ * be NULL). The epoch changes whenever data is added to the cache -
+ * e.g., when a fence or commit completes - after which the value has
+ * to be retrieved again. Values required past that point must be
+ * copied (e.g., with PMIx_Value_xfer).
+ *
+ * The key cannot be NULL, and the PMIX_GET_POINTER_VALUES and
+ * PMIX_GET_STATIC_VALUES directives are not accepted. Otherwise, the
+ * info array is used as described above for PMIx_Get. */
+PMIX_EXPORT pmix_status_t PMIx_Get_view(const pmix_proc_t *proc, const char key[],
+                                        const pmix_info_t info[], size_t ninfo,
+                                        pmix_value_t *val, uint64_t *epoch);
+
+PMIX_EXPORT uint64_t PMIx_Get_epoch(void);
+
 
 /* Publish the data in the info array for lookup. By default,
  * the data will be published into the PMIX_SESSION range and
@@ -1025,6 +1065,44 @@ PMIX_EXPORT pmix_status_t PMIx_Fabric_deregister_nb(pmix_fabric_t *fabric,
 												    pmix_op_cbfunc_t cbfunc, void *cbdata);
 
 
+/* Build the communication cost model of a registered fabric from
+ * the PMIX_FABRIC_COST_MODEL in its info array - or, if there is
+ * none, from its PMIX_FABRIC_COST_MATRIX - so that the cost between
+ * any two devices can be resolved with PMIx_Fabric_cost without
+ * expanding a dense matrix. The model keeps its own copy of the
+ * description, except for a dense matrix which is referenced, and
+ * is not changed by PMIx_Fabric_update - build a new one to pick
+ * up the changes
+ *
+ * fabric - pointer to the pmix_fabric_t struct provided
+ *          to the registration function
+ *
+ * model - address where the model is to be returned. It must be
+ *         released with PMIx_Fabric_cost_model_free
+ *
+ * Return values include:
+ *
+ * PMIX_SUCCESS - indicates success
+ *
+ * PMIX_ERR_NOT_AVAILABLE - the fabric provides no cost information
+ *
+ * PMIX_ERR_BAD_PARAM - the cost description is malformed
+ */
+PMIX_EXPORT pmix_status_t PMIx_Fabric_cost_model(const pmix_fabric_t *fabric,
+                                                 pmix_fabric_cost_model_t **model);
+
+/* Return the relative cost of communicating between the devices
+ * with the given PMIX_FABRIC_DEVICE_INDEX - in constant time for a
+ * hierarchical model, and in time proportional to the number of
+ * dimensions for a torus. Returns UINT16_MAX if either index is out
+ * of range. The model is not modified, so any number of threads
+ * may query it concurrently */
+PMIX_EXPORT uint16_t PMIx_Fabric_cost(const pmix_fabric_cost_model_t *model,
+                                      uint32_t src, uint32_t dst);
+
+PMIX_EXPORT void PMIx_Fabric_cost_model_free(pmix_fabric_cost_model_t *model);
+
+
 /* Compute the distance information for the current process
  * Returns an array of distances from the current process
  * location to each of the local devices of the specified type(s)
@@ -1106,6 +1184,27 @@ PMIX_EXPORT pmix_status_t PMIx_Get_relative_locality(const char *locality1,
 	                                                 const char *locality2,
 	                                                 pmix_locality_t *locality);
 
+/* Get the relative locality of two processes. When both are from the
+ * same nspace, the answer is taken from the PMIX_LOCALITY_MATRIX the
+ * local server computed for the nspace - it is retrieved once, after
+ * which each lookup needs neither communication nor string parsing,
+ * and procs that are not on this node are reported as
+ * PMIX_LOCALITY_NONLOCAL. Otherwise, the PMIX_LOCALITY_STRING of each
+ * proc is retrieved and the two compared as in PMIx_Get_relative_locality.
+ *
+ * proc1, proc2 - the processes of interest
+ *
+ * locality - Pointer to the location where the relative locality bitmask is
+ *            to be constructed
+ *
+ * Return values include:
+ * PMIX_SUCCESS - indicates return of a valid value
+ * other error constant
+ */
+PMIX_EXPORT pmix_status_t PMIx_Get_proc_relative_locality(const pmix_proc_t *proc1,
+                                                          const pmix_proc_t *proc2,
+                                                          pmix_locality_t *locality);
+
 PMIX_EXPORT void PMIx_Progress(void);
 
 /******    PRETTY-PRINT DEFINED VALUE TYPES     ******/
@@ -1639,7 +1738,9 @@ PMIX_EXPORT pmix_status_t PMIx_Info_list_xfer(void *ptr,
                                               const pmix_info_t *info);
 
 /* Convert the constructed list of pmix_info_t structs to a pmix_data_array_t
- * of pmix_info_t. Data on the list is COPIED to the array elements.
+ * of pmix_info_t. The list is kept as a single array internally, which
+ * is handed over to the pmix_data_array_t without copying - the list
+ * is left empty, and must still be released.
  */
 PMIX_EXPORT pmix_status_t PMIx_Info_list_convert(void *ptr, pmix_data_array_t *par);
 
@@ -125,7 +125,17 @@ typedef pmix_status_t (*pmix_server_abort_fn_t)(const pmix_proc_t *proc, void *s
  * This can include directives as to the algorithm to be used to execute the
  * fence operation. The directives are optional _unless_ the _mandatory_ flag
  * has been set - in such cases, the host RM is required to return an error
- * if the directive cannot be met. */
+ * if the directive cannot be met.
+ *
+ * The data is malloc'd, and ownership of it passes to the host when the
+ * function returns PMIX_SUCCESS or PMIX_OPERATION_SUCCEEDED - the host
+ * can hold and forward it without copying, and must free() it when done.
+ * On any other return, the PMIx server library releases it. Likewise, the
+ * data given to the modex cbfunc is used in place, not copied - the host
+ * must keep it valid until the release_fn it provided with it is called.
+ * Thus a host that returns a contribution as part of the result - e.g.,
+ * all of it when it is the only participating server - can pass it
+ * straight back with free() as the release_fn. */
 typedef pmix_status_t (*pmix_server_fencenb_fn_t)(const pmix_proc_t procs[], size_t nprocs,
                                                   const pmix_info_t info[], size_t ninfo,
                                                   char *data, size_t ndata,
@@ -293,7 +303,15 @@ typedef pmix_status_t (*pmix_server_listener_fn_t)(int listening_sd,
 /* Query information from the resource manager. The query will include
  * the nspace/rank of the proc that is requesting the info, an
  * array of pmix_query_t describing the request, and a callback
- * function/data for the return. */
+ * function/data for the return.
+ *
+ * A host that collects the answer from many places - e.g., through
+ * a tree of its daemons when asked with PMIX_QUERY_TREE_RADIX - may
+ * return it in batches as they come in, by executing the callback
+ * with PMIX_QUERY_PARTIAL_SUCCESS for each batch and once more with
+ * the final status. The calls must not overlap. The batches are
+ * forwarded to requestors that asked for PMIX_QUERY_STREAM, and
+ * combined into the final answer for the others. */
 typedef pmix_status_t (*pmix_server_query_fn_t)(pmix_proc_t *proct,
                                                 pmix_query_t *queries, size_t nqueries,
                                                 pmix_info_cbfunc_t cbfunc,
@@ -629,6 +647,17 @@ PMIX_EXPORT pmix_status_t PMIx_generate_regex(const char *input, char **regex);
  */
 PMIX_EXPORT pmix_status_t PMIx_generate_ppn(const char *input, char **ppn);
 
+/* Same as PMIx_generate_ppn, but taking the ranks on each node as
+ * an array of integers instead of a string: ranks[n] holds the
+ * nranks[n] ranks located on the n-th node of the list provided to
+ * PMIx_generate_regex. Hosts that build their process map in memory
+ * can use this to avoid printing it out only to have it parsed
+ * again. The result is the same as PMIx_generate_ppn would return
+ * for the equivalent string input.
+ */
+PMIX_EXPORT pmix_status_t PMIx_generate_ppn_ranks(const pmix_rank_t **ranks, const size_t *nranks,
+                                                  size_t nnodes, char **ppn);
+
 /* Setup the data about a particular nspace so it can
  * be passed to any child process upon startup. The PMIx
  * connection procedure provides an opportunity for the
@@ -658,6 +687,26 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace
                                           pmix_info_t info[], size_t ninfo,
                                           pmix_op_cbfunc_t cbfunc, void *cbdata);
 
+/* Register a set of nspaces in a single operation - e.g., the many
+ * small jobs of a workflow. Each nspaces[i] is registered as if by
+ * PMIx_server_register_nspace with nlocalprocs[i] and the ninfo[i]
+ * entries of info[i] (info may be NULL if no nspace has any), but
+ * all of them are processed in one pass with one callback.
+ *
+ * The shared array holds info common to all the nspaces - e.g.,
+ * the node-level info for the nodes they run on - and is added to
+ * each of them ahead of its own entries, so those take precedence.
+ * None of the arrays may be released until the callback has been
+ * executed. The callback is given PMIX_SUCCESS if every nspace was
+ * registered, or else the error of the first that failed - the
+ * others are registered regardless */
+PMIX_EXPORT pmix_status_t PMIx_server_register_nspaces(const pmix_nspace_t nspaces[],
+                                                       const int nlocalprocs[],
+                                                       pmix_info_t *info[], const size_t ninfo[],
+                                                       size_t nnspaces,
+                                                       pmix_info_t shared[], size_t nshared,
+                                                       pmix_op_cbfunc_t cbfunc, void *cbdata);
+
 /* Deregister an nspace and purge all objects relating to
  * it, including any client info from that nspace. This is
  * intended to support persistent PMIx servers by providing
@@ -858,12 +907,17 @@ PMIX_EXPORT pmix_status_t PMIx_server_delete_process_set(char *pset_name);
 
 
 /* Register non-namespace related information with the local PMIx server library.
+ * A PMIX_NODE_INFO_ARRAY naming a node that was already registered only
+ * updates the values it carries for that node, so a host need only pass
+ * what changed.
  */
 PMIX_EXPORT pmix_status_t PMIx_server_register_resources(pmix_info_t info[], size_t ninfo,
                                                          pmix_op_cbfunc_t cbfunc,
                                                          void *cbdata);
 
 /* Remove specified non-namespace related information from the local PMIx server library.
+ * A PMIX_NODE_INFO_ARRAY removes the values it names from the node it
+ * identifies, or the whole node if it carries nothing but its identifiers.
  */
 PMIX_EXPORT pmix_status_t PMIx_server_deregister_resources(pmix_info_t info[], size_t ninfo,
                                                            pmix_op_cbfunc_t cbfunc,
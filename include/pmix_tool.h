@@ -132,6 +132,35 @@ PMIX_EXPORT pmix_status_t PMIx_tool_attach_to_server(pmix_proc_t *myproc, pmix_p
                                                      pmix_info_t info[], size_t ninfo);
 
 
+/* Establish connections to a set of PMIx servers at once - e.g., to
+ * the servers on every node of an allocation. Each server is described
+ * by its own info array, which must give either its PMIX_SERVER_URI
+ * or a PMIX_TOOL_ATTACHMENT_FILE containing its connection info. The
+ * PMIX_PRIMARY_SERVER attribute may be included for one of them.
+ *
+ * The handshakes with the servers proceed concurrently, so the time
+ * taken is not the sum of the time taken by each of them.
+ *
+ * myproc - filled with the tool's nspace/rank if not _NULL_
+ *
+ * info, ninfo - arrays of nservers info arrays and their sizes
+ *
+ * servers - array of nservers procs, filled with the identifier of
+ *           each server the tool attached to
+ *
+ * status - array of nservers status codes, filled with the outcome
+ *          of the attach to each server
+ *
+ * Returns PMIX_SUCCESS if the tool attached to all the servers,
+ * PMIX_ERR_PARTIAL_SUCCESS if it attached to some of them, or a PMIx
+ * error constant
+ */
+PMIX_EXPORT pmix_status_t PMIx_tool_attach_to_servers(pmix_proc_t *myproc,
+                                                      pmix_info_t *info[], size_t ninfo[],
+                                                      size_t nservers, pmix_proc_t servers[],
+                                                      pmix_status_t status[]);
+
+
 /* Disconnect the PMIx tool from the specified server connection while
  * leaving the tool library initialized.
  *
@@ -157,6 +186,39 @@ PMIX_EXPORT pmix_status_t PMIx_tool_disconnect(const pmix_proc_t *server);
 PMIX_EXPORT pmix_status_t PMIx_tool_get_servers(pmix_proc_t *servers[], size_t *nservers);
 
 
+/* Send the same queries to several of the servers the tool is
+ * attached to, and collect their answers in a single callback.
+ * The requests to all the servers are in flight at the same time.
+ *
+ * servers - array of the servers to query. A _NULL_ value queries
+ *           every server the tool is currently attached to
+ *
+ * queries, nqueries - the queries, as for PMIx_Query_info
+ *
+ * info, ninfo - directives. PMIX_TIMEOUT bounds the time to wait for
+ *               the servers - those that did not answer by then are
+ *               reported with PMIX_ERR_TIMEOUT
+ *
+ * The callback is given one PMIX_SERVER_INFO_ARRAY per server, holding
+ * its PMIX_SERVER_NSPACE, PMIX_SERVER_RANK and PMIX_QUERY_SERVER_STATUS,
+ * followed by whatever the server returned. The status passed to the
+ * callback is PMIX_SUCCESS if all the servers answered successfully,
+ * PMIX_ERR_PARTIAL_SUCCESS if some of them did, or the error of the
+ * first server otherwise.
+ */
+PMIX_EXPORT pmix_status_t PMIx_tool_query_servers_nb(const pmix_proc_t servers[], size_t nservers,
+                                                     pmix_query_t queries[], size_t nqueries,
+                                                     pmix_info_t info[], size_t ninfo,
+                                                     pmix_info_cbfunc_t cbfunc, void *cbdata);
+
+/* Blocking form of PMIx_tool_query_servers_nb - the caller is
+ * responsible for releasing the returned array with PMIX_INFO_FREE */
+PMIX_EXPORT pmix_status_t PMIx_tool_query_servers(const pmix_proc_t servers[], size_t nservers,
+                                                  pmix_query_t queries[], size_t nqueries,
+                                                  pmix_info_t info[], size_t ninfo,
+                                                  pmix_info_t **results, size_t *nresults);
+
+
 /* Designate a server as the tool’s primary server.
  *
  * server - Process identifier of the target server
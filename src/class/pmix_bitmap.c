@@ -35,6 +35,42 @@
  */
 #define SIZE_OF_BASE_TYPE 64
 
+/* number of set bits in a word */
+static inline int pmix_bitmap_popcount(uint64_t val)
+{
+#if PMIX_C_HAVE_BUILTIN_POPCOUNT
+    return __builtin_popcountll((unsigned long long) val);
+#else
+    int cnt;
+
+    /*  Peter Wegner in CACM 3 (1960), 322. This method goes through as many
+     *  iterations as there are set bits. */
+    for (cnt = 0; val; cnt++) {
+        val &= val - 1; /* clear the least significant bit set */
+    }
+    return cnt;
+#endif
+}
+
+/* position of the lowest set bit of a non-zero word */
+static inline int pmix_bitmap_ctz(uint64_t val)
+{
+#if PMIX_C_HAVE_BUILTIN_CTZ
+    return __builtin_ctzll((unsigned long long) val);
+#else
+    int pos = 0;
+
+    while (!(val & 0x1)) {
+        ++pos;
+        val >>= 1;
+    }
+    return pos;
+#endif
+}
+
+/* mask of the bits from offset up to the end of the word */
+#define PMIX_BITMAP_MASK_FROM(offset) (~0UL << (offset))
+
 static void pmix_bitmap_construct(pmix_bitmap_t *bm);
 static void pmix_bitmap_destruct(pmix_bitmap_t *bm);
 
@@ -215,13 +251,9 @@ int pmix_bitmap_find_and_set_first_unset_bit(pmix_bitmap_t *bm, int *position)
 
     /* This one has an unset bit, find its bit number */
 
-    temp = bm->bitmap[i];
-    bm->bitmap[i] |= (bm->bitmap[i] + 1); /* Set the first zero bit */
-    temp ^= bm->bitmap[i]; /* Compute the change: the first unset bit in the original number */
-    while (!(temp & 0x1)) {
-        ++(*position);
-        temp >>= 1;
-    }
+    temp = ~bm->bitmap[i];
+    *position = pmix_bitmap_ctz(temp);
+    bm->bitmap[i] |= (1UL << *position);
 
     (*position) += i * SIZE_OF_BASE_TYPE;
     return PMIX_SUCCESS;
@@ -229,6 +261,7 @@ int pmix_bitmap_find_and_set_first_unset_bit(pmix_bitmap_t *bm, int *position)
 
 int pmix_bitmap_bitwise_and_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 {
+    uint64_t *d, *r;
     int i;
 
     /*
@@ -244,8 +277,10 @@ int pmix_bitmap_bitwise_and_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
     /*
      * Bitwise AND
      */
+    d = dest->bitmap;
+    r = right->bitmap;
     for (i = 0; i < dest->array_size; ++i) {
-        dest->bitmap[i] &= right->bitmap[i];
+        d[i] &= r[i];
     }
 
     return PMIX_SUCCESS;
@@ -253,6 +288,7 @@ int pmix_bitmap_bitwise_and_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 
 int pmix_bitmap_bitwise_or_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 {
+    uint64_t *d, *r;
     int i;
 
     /*
@@ -268,8 +304,10 @@ int pmix_bitmap_bitwise_or_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
     /*
      * Bitwise OR
      */
+    d = dest->bitmap;
+    r = right->bitmap;
     for (i = 0; i < dest->array_size; ++i) {
-        dest->bitmap[i] |= right->bitmap[i];
+        d[i] |= r[i];
     }
 
     return PMIX_SUCCESS;
@@ -277,6 +315,7 @@ int pmix_bitmap_bitwise_or_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 
 int pmix_bitmap_bitwise_xor_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 {
+    uint64_t *d, *r;
     int i;
 
     /*
@@ -292,8 +331,10 @@ int pmix_bitmap_bitwise_xor_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
     /*
      * Bitwise XOR
      */
+    d = dest->bitmap;
+    r = right->bitmap;
     for (i = 0; i < dest->array_size; ++i) {
-        dest->bitmap[i] ^= right->bitmap[i];
+        d[i] ^= r[i];
     }
 
     return PMIX_SUCCESS;
@@ -301,8 +342,6 @@ int pmix_bitmap_bitwise_xor_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 
 bool pmix_bitmap_are_different(pmix_bitmap_t *left, pmix_bitmap_t *right)
 {
-    int i;
-
     /*
      * Sanity check
      */
@@ -317,13 +356,7 @@ bool pmix_bitmap_are_different(pmix_bitmap_t *left, pmix_bitmap_t *right)
     /*
      * Direct comparison
      */
-    for (i = 0; i < left->array_size; ++i) {
-        if (left->bitmap[i] != right->bitmap[i]) {
-            return true;
-        }
-    }
-
-    return false;
+    return (0 != memcmp(left->bitmap, right->bitmap, left->array_size * sizeof(uint64_t)));
 }
 
 char *pmix_bitmap_get_string(pmix_bitmap_t *bitmap)
@@ -371,11 +404,7 @@ int pmix_bitmap_num_set_bits(pmix_bitmap_t *bm, int len)
     for (i = 0; i < len; ++i) {
         if (0 == (val = bm->bitmap[i]))
             continue;
-        /*  Peter Wegner in CACM 3 (1960), 322. This method goes through as many
-         *  iterations as there are set bits. */
-        for (; val; cnt++) {
-            val &= val - 1; /* clear the least significant bit set */
-        }
+        cnt += pmix_bitmap_popcount(val);
     }
 
     return cnt;
@@ -392,3 +421,109 @@ bool pmix_bitmap_is_clear(pmix_bitmap_t *bm)
     }
     return true;
 }
+
+/* grow the bitmap to hold the given number of words */
+static int pmix_bitmap_grow(pmix_bitmap_t *bm, int words)
+{
+    uint64_t *tmp;
+
+    if (words <= bm->array_size) {
+        return PMIX_SUCCESS;
+    }
+    if (words > bm->max_size) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    tmp = (uint64_t *) realloc(bm->bitmap, words * sizeof(uint64_t));
+    if (NULL == tmp) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    bm->bitmap = tmp;
+    memset(&bm->bitmap[bm->array_size], 0, (words - bm->array_size) * sizeof(uint64_t));
+    bm->array_size = words;
+    return PMIX_SUCCESS;
+}
+
+int pmix_bitmap_set_range(pmix_bitmap_t *bm, int start, int count)
+{
+    int first, last, end, rc;
+    uint64_t lo, hi;
+
+    if (NULL == bm || start < 0 || count < 0 || INT_MAX - start < count) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (0 == count) {
+        return PMIX_SUCCESS;
+    }
+    end = start + count - 1;
+    first = start / SIZE_OF_BASE_TYPE;
+    last = end / SIZE_OF_BASE_TYPE;
+    if (PMIX_SUCCESS != (rc = pmix_bitmap_grow(bm, last + 1))) {
+        return rc;
+    }
+
+    lo = PMIX_BITMAP_MASK_FROM(start % SIZE_OF_BASE_TYPE);
+    hi = ~0UL >> (SIZE_OF_BASE_TYPE - 1 - (end % SIZE_OF_BASE_TYPE));
+    if (first == last) {
+        bm->bitmap[first] |= (lo & hi);
+        return PMIX_SUCCESS;
+    }
+    bm->bitmap[first] |= lo;
+    if (first + 1 < last) {
+        memset(&bm->bitmap[first + 1], 0xff, (last - first - 1) * sizeof(uint64_t));
+    }
+    bm->bitmap[last] |= hi;
+    return PMIX_SUCCESS;
+}
+
+int pmix_bitmap_clear_range(pmix_bitmap_t *bm, int start, int count)
+{
+    int first, last, end;
+    uint64_t lo, hi;
+
+    if (NULL == bm || start < 0 || count < 0 || INT_MAX - start < count) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* bits beyond the end are already clear */
+    end = start + count - 1;
+    if (end >= bm->array_size * SIZE_OF_BASE_TYPE) {
+        end = bm->array_size * SIZE_OF_BASE_TYPE - 1;
+    }
+    if (end < start) {
+        return PMIX_SUCCESS;
+    }
+    first = start / SIZE_OF_BASE_TYPE;
+    last = end / SIZE_OF_BASE_TYPE;
+
+    lo = PMIX_BITMAP_MASK_FROM(start % SIZE_OF_BASE_TYPE);
+    hi = ~0UL >> (SIZE_OF_BASE_TYPE - 1 - (end % SIZE_OF_BASE_TYPE));
+    if (first == last) {
+        bm->bitmap[first] &= ~(lo & hi);
+        return PMIX_SUCCESS;
+    }
+    bm->bitmap[first] &= ~lo;
+    if (first + 1 < last) {
+        memset(&bm->bitmap[first + 1], 0, (last - first - 1) * sizeof(uint64_t));
+    }
+    bm->bitmap[last] &= ~hi;
+    return PMIX_SUCCESS;
+}
+
+int pmix_bitmap_next_set_bit(pmix_bitmap_t *bm, int bit)
+{
+    int index;
+    uint64_t val;
+
+    if (NULL == bm || bit < 0 || bit >= (bm->array_size * SIZE_OF_BASE_TYPE)) {
+        return -1;
+    }
+
+    index = bit / SIZE_OF_BASE_TYPE;
+    val = bm->bitmap[index] & PMIX_BITMAP_MASK_FROM(bit % SIZE_OF_BASE_TYPE);
+    while (0 == val) {
+        if (++index == bm->array_size) {
+            return -1;
+        }
+        val = bm->bitmap[index];
+    }
+    return index * SIZE_OF_BASE_TYPE + pmix_bitmap_ctz(val);
+}
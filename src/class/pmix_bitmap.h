@@ -246,6 +246,50 @@ PMIX_EXPORT int pmix_bitmap_num_set_bits(pmix_bitmap_t *bm, int len);
  */
 PMIX_EXPORT bool pmix_bitmap_is_clear(pmix_bitmap_t *bm);
 
+/**
+ * Set a range of bits. The bitmap is extended if the range goes
+ * beyond its current size
+ *
+ * @param bitmap The input bitmap (IN)
+ * @param start The first bit to be set (IN)
+ * @param count The number of bits to be set (IN)
+ * @return PMIX error code or success
+ */
+PMIX_EXPORT int pmix_bitmap_set_range(pmix_bitmap_t *bm, int start, int count);
+
+/**
+ * Clear a range of bits. Bits beyond the current size of the
+ * bitmap are already clear and are ignored
+ *
+ * @param bitmap The input bitmap (IN)
+ * @param start The first bit to be cleared (IN)
+ * @param count The number of bits to be cleared (IN)
+ * @return PMIX error code or success
+ */
+PMIX_EXPORT int pmix_bitmap_clear_range(pmix_bitmap_t *bm, int start, int count);
+
+/**
+ * Find the first set bit at or after the given position
+ *
+ * @param bitmap The input bitmap (IN)
+ * @param bit The position to start searching from (IN)
+ * @return The position of the bit, or -1 if there is none
+ */
+PMIX_EXPORT int pmix_bitmap_next_set_bit(pmix_bitmap_t *bm, int bit);
+
+/**
+ * Loop over the set bits of a bitmap in ascending order
+ *
+ * @param bit An int that holds the position of each set bit
+ * @param bm The bitmap
+ *
+ * Bits may be cleared inside the loop - bits set at positions
+ * beyond the current one will be visited.
+ */
+#define PMIX_BITMAP_FOREACH_SET_BIT(bit, bm)                         \
+    for ((bit) = pmix_bitmap_next_set_bit((bm), 0); 0 <= (bit);      \
+         (bit) = pmix_bitmap_next_set_bit((bm), (bit) + 1))
+
 END_C_DECLS
 
 #endif
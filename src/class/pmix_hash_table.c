@@ -24,6 +24,9 @@
 
 #include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
 
 #include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
@@ -37,6 +40,9 @@
 
 #define HASH_MULTIPLIER 31
 
+/* number of slots of a uint32/uint64 table checked at a time */
+#define PMIX_HASH_GROUP 16
+
 /*
  * Define the structs that are opaque in the .h
  */
@@ -60,11 +66,27 @@ struct pmix_hash_type_methods_t {
      * The value is not owned by the hash table
      * The key,key_size of pointer keys is
      */
-    void (*elt_destructor)(pmix_hash_element_t *elt);
+    void (*elt_destructor)(pmix_hash_table_t *ht, pmix_hash_element_t *elt);
     /* Hash the key of the element -- for growing and adjusting-after-removal */
     uint64_t (*hash_elt)(pmix_hash_element_t *elt);
 };
 
+/* the key type of a table is kept as an index into the methods
+ * rather than a pointer to them, and its storage comes from the
+ * allocator of the table object, so a table built in shared memory
+ * can be read by processes that map this library elsewhere */
+#define PMIX_HASH_KEY_NONE   0
+#define PMIX_HASH_KEY_UINT32 1
+#define PMIX_HASH_KEY_UINT64 2
+#define PMIX_HASH_KEY_PTR    3
+
+static const struct pmix_hash_type_methods_t *pmix_hash_methods(const pmix_hash_table_t *ht);
+
+static inline pmix_tma_t *pmix_hash_tma(pmix_hash_table_t *ht)
+{
+    return pmix_obj_get_tma(&ht->super);
+}
+
 /* interact with the class-like mechanism */
 
 static void pmix_hash_table_construct(pmix_hash_table_t *ht);
@@ -79,13 +101,22 @@ static void pmix_hash_table_construct(pmix_hash_table_t *ht)
     ht->ht_capacity = ht->ht_size = ht->ht_growth_trigger = 0;
     ht->ht_density_numer = ht->ht_density_denom = 0;
     ht->ht_growth_numer = ht->ht_growth_denom = 0;
-    ht->ht_type_methods = NULL;
+    ht->ht_key_type = PMIX_HASH_KEY_NONE;
+    ht->ht_tags = NULL;
+    ht->ht_keys = NULL;
+    ht->ht_values = NULL;
+    ht->ht_dense = NULL;
+    ht->ht_dense_size = 0;
 }
 
 static void pmix_hash_table_destruct(pmix_hash_table_t *ht)
 {
     pmix_hash_table_remove_all(ht);
-    free(ht->ht_table);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_table);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_tags);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_keys);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_values);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_dense);
 }
 
 /*
@@ -106,7 +137,8 @@ pmix_hash_table_init2(pmix_hash_table_t *ht, size_t estimated_max_size, int dens
 {
     size_t est_capacity = estimated_max_size * density_denom / density_numer;
     size_t capacity = pmix_hash_round_capacity_up(est_capacity);
-    ht->ht_table = (pmix_hash_element_t *) calloc(capacity, sizeof(pmix_hash_element_t));
+    ht->ht_table = (pmix_hash_element_t *) pmix_tma_calloc(pmix_hash_tma(ht), capacity,
+                                                           sizeof(pmix_hash_element_t));
     if (NULL == ht->ht_table) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
@@ -116,7 +148,7 @@ pmix_hash_table_init2(pmix_hash_table_t *ht, size_t estimated_max_size, int dens
     ht->ht_growth_numer = growth_numer;
     ht->ht_growth_denom = growth_denom;
     ht->ht_growth_trigger = capacity * density_numer / density_denom;
-    ht->ht_type_methods = NULL;
+    ht->ht_key_type = PMIX_HASH_KEY_NONE;
     return PMIX_SUCCESS;
 }
 
@@ -131,10 +163,21 @@ int /* PMIX_ return code */
 pmix_hash_table_remove_all(pmix_hash_table_t *ht)
 {
     size_t ii;
+
+    if (0 < ht->ht_dense_size) {
+        memset(ht->ht_dense, 0, ht->ht_dense_size * sizeof(void *));
+    }
+    if (NULL != ht->ht_tags) {
+        memset(ht->ht_tags, 0, ht->ht_capacity + PMIX_HASH_GROUP);
+        ht->ht_size = 0;
+        ht->ht_key_type = PMIX_HASH_KEY_NONE;
+        return PMIX_SUCCESS;
+    }
     for (ii = 0; ii < ht->ht_capacity; ii += 1) {
         pmix_hash_element_t *elt = &ht->ht_table[ii];
-        if (elt->valid && ht->ht_type_methods && ht->ht_type_methods->elt_destructor) {
-            ht->ht_type_methods->elt_destructor(elt);
+        if (elt->valid && PMIX_HASH_KEY_NONE != ht->ht_key_type
+            && pmix_hash_methods(ht)->elt_destructor) {
+            pmix_hash_methods(ht)->elt_destructor(ht, elt);
         }
         elt->valid = 0;
         elt->value = NULL;
@@ -142,7 +185,7 @@ pmix_hash_table_remove_all(pmix_hash_table_t *ht)
     ht->ht_size = 0;
     /* the tests reuse the hash table for different types after removing all */
     /* so we should allow that by forgetting what type it used to be */
-    ht->ht_type_methods = NULL;
+    ht->ht_key_type = PMIX_HASH_KEY_NONE;
     return PMIX_SUCCESS;
 }
 
@@ -161,7 +204,8 @@ pmix_hash_grow(pmix_hash_table_t *ht)
     new_capacity = old_capacity * ht->ht_growth_numer / ht->ht_growth_denom;
     new_capacity = pmix_hash_round_capacity_up(new_capacity);
 
-    new_table = (pmix_hash_element_t *) calloc(new_capacity, sizeof(new_table[0]));
+    new_table = (pmix_hash_element_t *) pmix_tma_calloc(pmix_hash_tma(ht), new_capacity,
+                                                        sizeof(new_table[0]));
     if (NULL == new_table) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
@@ -179,7 +223,7 @@ pmix_hash_grow(pmix_hash_table_t *ht)
         pmix_hash_element_t *new_elt;
         old_elt = &old_table[jj];
         if (old_elt->valid) {
-            for (ii = (ht->ht_type_methods->hash_elt(old_elt) % new_capacity);; ii += 1) {
+            for (ii = (pmix_hash_methods(ht)->hash_elt(old_elt) % new_capacity);; ii += 1) {
                 if (ii == new_capacity) {
                     ii = 0;
                 }
@@ -195,7 +239,7 @@ pmix_hash_grow(pmix_hash_table_t *ht)
     ht->ht_table = new_table;
     ht->ht_capacity = new_capacity;
     ht->ht_growth_trigger = new_capacity * ht->ht_density_numer / ht->ht_density_denom;
-    free(old_table);
+    pmix_tma_free(pmix_hash_tma(ht), old_table);
     return PMIX_SUCCESS;
 }
 
@@ -218,8 +262,8 @@ pmix_hash_table_remove_elt_at(pmix_hash_table_t *ht, size_t ii)
     }
 
     elt->valid = 0;
-    if (ht->ht_type_methods->elt_destructor) {
-        ht->ht_type_methods->elt_destructor(elt);
+    if (pmix_hash_methods(ht)->elt_destructor) {
+        pmix_hash_methods(ht)->elt_destructor(ht, elt);
     }
 
     /* need to possibly re-insert followers because of the now-gap */
@@ -241,7 +285,7 @@ pmix_hash_table_remove_elt_at(pmix_hash_table_t *ht, size_t ii)
             break; /* done */
         }
         /* rehash it and move it if necessary */
-        for (jj = ht->ht_type_methods->hash_elt(elt) % capacity;; jj += 1) {
+        for (jj = pmix_hash_methods(ht)->hash_elt(elt) % capacity;; jj += 1) {
             if (jj == capacity) {
                 jj = 0;
             }
@@ -264,6 +308,18 @@ pmix_hash_table_remove_elt_at(pmix_hash_table_t *ht, size_t ii)
 
 /***************************************************************************/
 
+/* Tables with uint32/uint64 keys - those keyed by rank are looked up
+ * on every get - use a layout of their own: a power-of-two number of
+ * slots with the keys, values and a one-byte tag per slot in separate
+ * arrays. The tag is the top bits of a hash of the key (with the high
+ * bit set, so 0 marks an empty slot), which lets a probe check a group of
+ * PMIX_HASH_GROUP slots with a couple of SSE2 compares and only look at
+ * the keys whose tag matches. The tags of the first group are mirrored
+ * past the end of the array so a group never wraps. As in the element
+ * table, collisions are resolved by linear probing and entries are
+ * moved back into the gap left by a removal, so there are no tombstones
+ * and lookups never scan past deleted entries */
+
 static uint64_t pmix_hash_hash_elt_uint32(pmix_hash_element_t *elt)
 {
     return elt->key.u32;
@@ -272,250 +328,396 @@ static uint64_t pmix_hash_hash_elt_uint32(pmix_hash_element_t *elt)
 static const struct pmix_hash_type_methods_t pmix_hash_type_methods_uint32
     = {NULL, pmix_hash_hash_elt_uint32};
 
+static uint64_t pmix_hash_hash_elt_uint64(pmix_hash_element_t *elt)
+{
+    return elt->key.u64;
+}
+
+static const struct pmix_hash_type_methods_t pmix_hash_type_methods_uint64
+    = {NULL, pmix_hash_hash_elt_uint64};
+
+static inline uint64_t pmix_hash_int(uint64_t key)
+{
+    key *= 0x9E3779B97F4A7C15ULL;
+    return key ^ (key >> 29);
+}
+
+static inline uint8_t pmix_hash_int_tag(uint64_t key)
+{
+    return (uint8_t) (0x80 | (pmix_hash_int(key) >> 57));
+}
+
+/* ranks are dense, so consecutive keys are kept in consecutive slots -
+ * the bits above the slot index are folded in to spread other patterns */
+static inline size_t pmix_hash_int_slot(pmix_hash_table_t *ht, uint64_t key)
+{
+    key ^= key >> 32;
+    key ^= key >> __builtin_ctzll((unsigned long long) ht->ht_capacity);
+    return (size_t) key & (ht->ht_capacity - 1);
+}
+
+static inline void pmix_hash_int_set_tag(pmix_hash_table_t *ht, size_t ii, uint8_t tag)
+{
+    ht->ht_tags[ii] = tag;
+    if (ii < PMIX_HASH_GROUP) {
+        ht->ht_tags[ht->ht_capacity + ii] = tag;
+    }
+}
+
+static int pmix_hash_int_alloc(pmix_hash_table_t *ht, size_t capacity)
+{
+    pmix_tma_t *tma = pmix_hash_tma(ht);
+    size_t cap = PMIX_HASH_GROUP;
+
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    ht->ht_tags = (uint8_t *) pmix_tma_calloc(tma, cap + PMIX_HASH_GROUP, sizeof(uint8_t));
+    ht->ht_keys = (uint64_t *) pmix_tma_malloc(tma, cap * sizeof(uint64_t));
+    ht->ht_values = (void **) pmix_tma_malloc(tma, cap * sizeof(void *));
+    if (NULL == ht->ht_tags || NULL == ht->ht_keys || NULL == ht->ht_values) {
+        pmix_tma_free(tma, ht->ht_tags);
+        pmix_tma_free(tma, ht->ht_keys);
+        pmix_tma_free(tma, ht->ht_values);
+        ht->ht_tags = NULL;
+        ht->ht_keys = NULL;
+        ht->ht_values = NULL;
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    ht->ht_capacity = cap;
+    ht->ht_growth_trigger = cap * ht->ht_density_numer / ht->ht_density_denom;
+    if (ht->ht_growth_trigger >= cap) {
+        /* always leave an empty slot to end a probe */
+        ht->ht_growth_trigger = cap - 1;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* switch an empty table to the integer layout the first time it is used
+ * with uint32/uint64 keys */
+static int pmix_hash_int_setup(pmix_hash_table_t *ht, uint8_t key_type)
+{
+    int rc;
+
+    if (NULL == ht->ht_tags) {
+        if (0 < ht->ht_size) {
+            /* holds ptr keys */
+            return PMIX_ERROR;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_hash_int_alloc(ht, ht->ht_capacity))) {
+            return rc;
+        }
+        pmix_tma_free(pmix_hash_tma(ht), ht->ht_table);
+        ht->ht_table = NULL;
+    }
+    ht->ht_key_type = key_type;
+    return PMIX_SUCCESS;
+}
+
+/* find the slot holding the key - if it isn't there, return the
+ * empty slot where it would go */
+static bool pmix_hash_int_find(pmix_hash_table_t *ht, uint64_t key, size_t *slot)
+{
+    uint8_t tag = pmix_hash_int_tag(key);
+    size_t mask = ht->ht_capacity - 1;
+    size_t ii = pmix_hash_int_slot(ht, key);
+#ifdef __SSE2__
+    size_t jj;
+    __m128i group, want = _mm_set1_epi8((char) tag), empty = _mm_setzero_si128();
+    unsigned int match, gaps;
+
+    for (;;) {
+        group = _mm_loadu_si128((const __m128i *) &ht->ht_tags[ii]);
+        match = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(group, want));
+        gaps = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(group, empty));
+        if (0 != gaps) {
+            /* the key cannot be past the first empty slot */
+            match &= (gaps & -gaps) - 1;
+        }
+        while (0 != match) {
+            jj = (ii + __builtin_ctz(match)) & mask;
+            if (ht->ht_keys[jj] == key) {
+                *slot = jj;
+                return true;
+            }
+            match &= match - 1;
+        }
+        if (0 != gaps) {
+            *slot = (ii + __builtin_ctz(gaps)) & mask;
+            return false;
+        }
+        ii = (ii + PMIX_HASH_GROUP) & mask;
+    }
+#else
+    for (;; ii = (ii + 1) & mask) {
+        if (0 == ht->ht_tags[ii]) {
+            *slot = ii;
+            return false;
+        }
+        if (tag == ht->ht_tags[ii] && ht->ht_keys[ii] == key) {
+            *slot = ii;
+            return true;
+        }
+    }
+#endif
+}
+
+static int pmix_hash_int_grow(pmix_hash_table_t *ht)
+{
+    uint8_t *old_tags = ht->ht_tags;
+    uint64_t *old_keys = ht->ht_keys;
+    void **old_values = ht->ht_values;
+    size_t ii, jj, old_capacity = ht->ht_capacity;
+    size_t new_capacity;
+    int rc;
+
+    new_capacity = old_capacity * ht->ht_growth_numer / ht->ht_growth_denom;
+    if (new_capacity <= old_capacity) {
+        new_capacity = old_capacity << 1;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_hash_int_alloc(ht, new_capacity))) {
+        ht->ht_tags = old_tags;
+        ht->ht_keys = old_keys;
+        ht->ht_values = old_values;
+        return rc;
+    }
+    for (ii = 0; ii < old_capacity; ii++) {
+        if (0 != old_tags[ii]) {
+            (void) pmix_hash_int_find(ht, old_keys[ii], &jj);
+            ht->ht_keys[jj] = old_keys[ii];
+            ht->ht_values[jj] = old_values[ii];
+            pmix_hash_int_set_tag(ht, jj, old_tags[ii]);
+        }
+    }
+    pmix_tma_free(pmix_hash_tma(ht), old_tags);
+    pmix_tma_free(pmix_hash_tma(ht), old_keys);
+    pmix_tma_free(pmix_hash_tma(ht), old_values);
+    return PMIX_SUCCESS;
+}
+
+static int pmix_hash_int_get(pmix_hash_table_t *ht, uint64_t key, void **value)
+{
+    size_t ii;
+
+    if (NULL == ht->ht_tags || !pmix_hash_int_find(ht, key, &ii)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    *value = ht->ht_values[ii];
+    return PMIX_SUCCESS;
+}
+
+static int pmix_hash_int_set(pmix_hash_table_t *ht, uint64_t key, void *value)
+{
+    size_t ii;
+
+    if (pmix_hash_int_find(ht, key, &ii)) {
+        /* replace existing element */
+        ht->ht_values[ii] = value;
+        return PMIX_SUCCESS;
+    }
+    ht->ht_keys[ii] = key;
+    ht->ht_values[ii] = value;
+    pmix_hash_int_set_tag(ht, ii, pmix_hash_int_tag(key));
+    ht->ht_size += 1;
+    if (ht->ht_size >= ht->ht_growth_trigger) {
+        return pmix_hash_int_grow(ht);
+    }
+    return PMIX_SUCCESS;
+}
+
+static int pmix_hash_int_remove(pmix_hash_table_t *ht, uint64_t key)
+{
+    size_t ii, jj, home, mask = ht->ht_capacity - 1;
+
+    if (NULL == ht->ht_tags || !pmix_hash_int_find(ht, key, &ii)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    pmix_hash_int_set_tag(ht, ii, 0);
+    /* move back any follower that may no longer be found
+     * across the gap - see pmix_hash_table_remove_elt_at */
+    for (jj = (ii + 1) & mask; 0 != ht->ht_tags[jj]; jj = (jj + 1) & mask) {
+        home = pmix_hash_int_slot(ht, ht->ht_keys[jj]);
+        /* it stays if its home lies cyclically in (ii, jj] */
+        if (ii <= jj ? (ii < home && home <= jj) : (ii < home || home <= jj)) {
+            continue;
+        }
+        ht->ht_keys[ii] = ht->ht_keys[jj];
+        ht->ht_values[ii] = ht->ht_values[jj];
+        pmix_hash_int_set_tag(ht, ii, ht->ht_tags[jj]);
+        pmix_hash_int_set_tag(ht, jj, 0);
+        ii = jj;
+    }
+    ht->ht_size -= 1;
+    return PMIX_SUCCESS;
+}
+
 int /* PMIX_ return code */
 pmix_hash_table_get_value_uint32(pmix_hash_table_t *ht, uint32_t key, void **value)
 {
-    size_t ii, capacity = ht->ht_capacity;
-    pmix_hash_element_t *elt;
-
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_get_value_uint32:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERROR;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_uint32 != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT32 != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_get_value_uint32:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_uint32;
-    for (ii = key % capacity;; ii += 1) {
-        if (ii == capacity) {
-            ii = 0;
-        }
-        elt = &ht->ht_table[ii];
-        if (!elt->valid) {
-            return PMIX_ERR_NOT_FOUND;
-        } else if (elt->key.u32 == key) {
-            *value = elt->value;
-            return PMIX_SUCCESS;
-        } else {
-            /* keep looking */
-        }
-    }
+    ht->ht_key_type = PMIX_HASH_KEY_UINT32;
+    return pmix_hash_int_get(ht, key, value);
 }
 
 int /* PMIX_ return code */
 pmix_hash_table_set_value_uint32(pmix_hash_table_t *ht, uint32_t key, void *value)
 {
     int rc;
-    size_t ii, capacity = ht->ht_capacity;
-    pmix_hash_element_t *elt;
 
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_set_value_uint32:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERR_BAD_PARAM;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_uint32 != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT32 != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_set_value_uint32:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_uint32;
-    for (ii = key % capacity;; ii += 1) {
-        if (ii == capacity) {
-            ii = 0;
-        }
-        elt = &ht->ht_table[ii];
-        if (!elt->valid) {
-            /* new entry */
-            elt->key.u32 = key;
-            elt->value = value;
-            elt->valid = 1;
-            ht->ht_size += 1;
-            if (ht->ht_size >= ht->ht_growth_trigger) {
-                if (PMIX_SUCCESS != (rc = pmix_hash_grow(ht))) {
-                    return rc;
-                }
-            }
-            return PMIX_SUCCESS;
-        } else if (elt->key.u32 == key) {
-            /* replace existing element */
-            elt->value = value;
-            return PMIX_SUCCESS;
-        } else {
-            /* keep looking */
-        }
+    if (PMIX_SUCCESS != (rc = pmix_hash_int_setup(ht, PMIX_HASH_KEY_UINT32))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_hash_int_set(ht, key, value))) {
+        return rc;
+    }
+    if (key < ht->ht_dense_size) {
+        ht->ht_dense[key] = value;
     }
+    return PMIX_SUCCESS;
 }
 
 int pmix_hash_table_remove_value_uint32(pmix_hash_table_t *ht, uint32_t key)
 {
-    size_t ii, capacity = ht->ht_capacity;
-
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_get_value_uint32:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERROR;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_uint32 != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT32 != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_remove_value_uint32:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_uint32;
-    for (ii = key % capacity;; ii += 1) {
-        pmix_hash_element_t *elt;
-        if (ii == capacity)
-            ii = 0;
-        elt = &ht->ht_table[ii];
-        if (!elt->valid) {
-            return PMIX_ERR_NOT_FOUND;
-        } else if (elt->key.u32 == key) {
-            return pmix_hash_table_remove_elt_at(ht, ii);
-        } else {
-            /* keep looking */
-        }
+    ht->ht_key_type = PMIX_HASH_KEY_UINT32;
+    if (key < ht->ht_dense_size) {
+        ht->ht_dense[key] = NULL;
     }
+    return pmix_hash_int_remove(ht, key);
 }
 
-/***************************************************************************/
-
-static uint64_t pmix_hash_hash_elt_uint64(pmix_hash_element_t *elt)
+int pmix_hash_table_set_dense_uint32(pmix_hash_table_t *ht, uint32_t size)
 {
-    return elt->key.u64;
+    void **dense;
+    size_t ii;
+    int rc;
+
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT32 != ht->ht_key_type) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (size <= ht->ht_dense_size) {
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_hash_int_setup(ht, PMIX_HASH_KEY_UINT32))) {
+        return rc;
+    }
+    dense = (void **) pmix_tma_calloc(pmix_hash_tma(ht), size, sizeof(void *));
+    if (NULL == dense) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    /* pick up whatever was stored before the size was known */
+    for (ii = 0; ii < ht->ht_capacity; ii++) {
+        if (0 != ht->ht_tags[ii] && ht->ht_keys[ii] < size) {
+            dense[ht->ht_keys[ii]] = ht->ht_values[ii];
+        }
+    }
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_dense);
+    ht->ht_dense = dense;
+    ht->ht_dense_size = size;
+    return PMIX_SUCCESS;
 }
 
-static const struct pmix_hash_type_methods_t pmix_hash_type_methods_uint64
-    = {NULL, pmix_hash_hash_elt_uint64};
+/***************************************************************************/
 
 int /* PMIX_ return code */
 pmix_hash_table_get_value_uint64(pmix_hash_table_t *ht, uint64_t key, void **value)
 {
-    size_t ii;
-    size_t capacity = ht->ht_capacity;
-    pmix_hash_element_t *elt;
-
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_get_value_uint64:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERROR;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_uint64 != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT64 != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_get_value_uint64:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_uint64;
-    for (ii = key % capacity;; ii += 1) {
-        if (ii == capacity) {
-            ii = 0;
-        }
-        elt = &ht->ht_table[ii];
-        if (!elt->valid) {
-            return PMIX_ERR_NOT_FOUND;
-        } else if (elt->key.u64 == key) {
-            *value = elt->value;
-            return PMIX_SUCCESS;
-        } else {
-            /* keep looking */
-        }
-    }
+    ht->ht_key_type = PMIX_HASH_KEY_UINT64;
+    return pmix_hash_int_get(ht, key, value);
 }
 
 int /* PMIX_ return code */
 pmix_hash_table_set_value_uint64(pmix_hash_table_t *ht, uint64_t key, void *value)
 {
     int rc;
-    size_t ii, capacity = ht->ht_capacity;
-    pmix_hash_element_t *elt;
 
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_set_value_uint64:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERR_BAD_PARAM;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_uint64 != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT64 != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_set_value_uint64:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_uint64;
-    for (ii = key % capacity;; ii += 1) {
-        if (ii == capacity) {
-            ii = 0;
-        }
-        elt = &ht->ht_table[ii];
-        if (!elt->valid) {
-            /* new entry */
-            elt->key.u64 = key;
-            elt->value = value;
-            elt->valid = 1;
-            ht->ht_size += 1;
-            if (ht->ht_size >= ht->ht_growth_trigger) {
-                if (PMIX_SUCCESS != (rc = pmix_hash_grow(ht))) {
-                    return rc;
-                }
-            }
-            return PMIX_SUCCESS;
-        } else if (elt->key.u64 == key) {
-            elt->value = value;
-            return PMIX_SUCCESS;
-        } else {
-            /* keep looking */
-        }
+    if (PMIX_SUCCESS != (rc = pmix_hash_int_setup(ht, PMIX_HASH_KEY_UINT64))) {
+        return rc;
     }
+    return pmix_hash_int_set(ht, key, value);
 }
 
 int /* PMIX_ return code */
 pmix_hash_table_remove_value_uint64(pmix_hash_table_t *ht, uint64_t key)
 {
-    size_t ii, capacity = ht->ht_capacity;
-
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_get_value_uint64:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERROR;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_uint64 != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_UINT64 != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_remove_value_uint64:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_uint64;
-    for (ii = key % capacity;; ii += 1) {
-        pmix_hash_element_t *elt;
-        if (ii == capacity) {
-            ii = 0;
-        }
-        elt = &ht->ht_table[ii];
-        if (!elt->valid) {
-            return PMIX_ERR_NOT_FOUND;
-        } else if (elt->key.u64 == key) {
-            return pmix_hash_table_remove_elt_at(ht, ii);
-        } else {
-            /* keep looking */
-        }
-    }
+    ht->ht_key_type = PMIX_HASH_KEY_UINT64;
+    return pmix_hash_int_remove(ht, key);
 }
 
 /***************************************************************************/
@@ -535,15 +737,90 @@ static uint64_t pmix_hash_hash_key_ptr(const void *key, size_t key_size)
     return hash;
 }
 
+/* switch an empty table back to the element layout if it was last
+ * used with uint32/uint64 keys */
+static int pmix_hash_ptr_setup(pmix_hash_table_t *ht)
+{
+    size_t capacity;
+
+    if (NULL != ht->ht_table) {
+        return PMIX_SUCCESS;
+    }
+    if (0 < ht->ht_size) {
+        /* holds uint32/uint64 keys */
+        return PMIX_ERROR;
+    }
+    capacity = pmix_hash_round_capacity_up(ht->ht_capacity);
+    ht->ht_table = (pmix_hash_element_t *) pmix_tma_calloc(pmix_hash_tma(ht), capacity,
+                                                           sizeof(pmix_hash_element_t));
+    if (NULL == ht->ht_table) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_tags);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_keys);
+    pmix_tma_free(pmix_hash_tma(ht), ht->ht_values);
+    ht->ht_tags = NULL;
+    ht->ht_keys = NULL;
+    ht->ht_values = NULL;
+    ht->ht_capacity = capacity;
+    ht->ht_growth_trigger = capacity * ht->ht_density_numer / ht->ht_density_denom;
+    return PMIX_SUCCESS;
+}
+
+/* the storage a table needs per slot, whichever kind of key it holds -
+ * used to size tables built in a fixed region of memory */
+size_t pmix_hash_table_sizeof_hash_element(void)
+{
+    size_t islot = sizeof(uint8_t) + sizeof(uint64_t) + sizeof(void *);
+
+    return (sizeof(pmix_hash_element_t) > islot) ? sizeof(pmix_hash_element_t) : islot;
+}
+
+void pmix_hash_table_relocate(pmix_hash_table_t *ht, ptrdiff_t delta)
+{
+    size_t ii;
+
+    PMIX_TMA_RELOCATE(ht->ht_table, delta);
+    PMIX_TMA_RELOCATE(ht->ht_tags, delta);
+    PMIX_TMA_RELOCATE(ht->ht_keys, delta);
+    PMIX_TMA_RELOCATE(ht->ht_values, delta);
+    PMIX_TMA_RELOCATE(ht->ht_dense, delta);
+
+    if (NULL != ht->ht_tags) {
+        for (ii = 0; ii < ht->ht_capacity; ii++) {
+            if (0 != ht->ht_tags[ii]) {
+                PMIX_TMA_RELOCATE(ht->ht_values[ii], delta);
+            }
+        }
+        for (ii = 0; ii < ht->ht_dense_size; ii++) {
+            PMIX_TMA_RELOCATE(ht->ht_dense[ii], delta);
+        }
+        return;
+    }
+    if (NULL == ht->ht_table) {
+        return;
+    }
+    for (ii = 0; ii < ht->ht_capacity; ii++) {
+        pmix_hash_element_t *elt = &ht->ht_table[ii];
+        if (!elt->valid) {
+            continue;
+        }
+        if (PMIX_HASH_KEY_PTR == ht->ht_key_type) {
+            PMIX_TMA_RELOCATE(elt->key.ptr.key, delta);
+        }
+        PMIX_TMA_RELOCATE(elt->value, delta);
+    }
+}
+
 /* ptr methods */
 
-static void pmix_hash_destruct_elt_ptr(pmix_hash_element_t *elt)
+static void pmix_hash_destruct_elt_ptr(pmix_hash_table_t *ht, pmix_hash_element_t *elt)
 {
     elt->key.ptr.key_size = 0;
     void *key = (void *) elt->key.ptr.key; /* cast away const so we can free it */
     if (NULL != key) {
         elt->key.ptr.key = NULL;
-        free(key);
+        pmix_tma_free(pmix_hash_tma(ht), key);
     }
 }
 
@@ -555,6 +832,15 @@ static uint64_t pmix_hash_hash_elt_ptr(pmix_hash_element_t *elt)
 static const struct pmix_hash_type_methods_t pmix_hash_type_methods_ptr
     = {pmix_hash_destruct_elt_ptr, pmix_hash_hash_elt_ptr};
 
+static const struct pmix_hash_type_methods_t *pmix_hash_methods(const pmix_hash_table_t *ht)
+{
+    static const struct pmix_hash_type_methods_t *methods[] = {
+        NULL, &pmix_hash_type_methods_uint32, &pmix_hash_type_methods_uint64,
+        &pmix_hash_type_methods_ptr};
+
+    return methods[ht->ht_key_type];
+}
+
 int /* PMIX_ return code */
 pmix_hash_table_get_value_ptr(pmix_hash_table_t *ht, const void *key, size_t key_size, void **value)
 {
@@ -567,14 +853,17 @@ pmix_hash_table_get_value_ptr(pmix_hash_table_t *ht, const void *key, size_t key
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERROR;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_ptr != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_PTR != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_get_value_ptr:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_ptr;
+    ht->ht_key_type = PMIX_HASH_KEY_PTR;
+    if (NULL == ht->ht_table) {
+        return PMIX_ERR_NOT_FOUND;
+    }
     for (ii = pmix_hash_hash_key_ptr(key, key_size) % capacity;; ii += 1) {
         if (ii == capacity) {
             ii = 0;
@@ -596,23 +885,27 @@ int /* PMIX_ return code */
 pmix_hash_table_set_value_ptr(pmix_hash_table_t *ht, const void *key, size_t key_size, void *value)
 {
     int rc;
-    size_t ii, capacity = ht->ht_capacity;
+    size_t ii, capacity;
     pmix_hash_element_t *elt;
 
 #if PMIX_ENABLE_DEBUG
-    if (capacity == 0) {
+    if (ht->ht_capacity == 0) {
         pmix_output(0, "pmix_hash_table_set_value_ptr:"
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERR_BAD_PARAM;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_ptr != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_PTR != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_set_value_ptr:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_ptr;
+    if (PMIX_SUCCESS != (rc = pmix_hash_ptr_setup(ht))) {
+        return rc;
+    }
+    ht->ht_key_type = PMIX_HASH_KEY_PTR;
+    capacity = ht->ht_capacity;
     for (ii = pmix_hash_hash_key_ptr(key, key_size) % capacity;; ii += 1) {
         if (ii == capacity) {
             ii = 0;
@@ -620,7 +913,7 @@ pmix_hash_table_set_value_ptr(pmix_hash_table_t *ht, const void *key, size_t key
         elt = &ht->ht_table[ii];
         if (!elt->valid) {
             /* new entry */
-            void *key_local = malloc(key_size);
+            void *key_local = pmix_tma_malloc(pmix_hash_tma(ht), key_size);
             memcpy(key_local, key, key_size);
             elt->key.ptr.key = key_local;
             elt->key.ptr.key_size = key_size;
@@ -655,14 +948,17 @@ pmix_hash_table_remove_value_ptr(pmix_hash_table_t *ht, const void *key, size_t
                        "pmix_hash_table_init() has not been called");
         return PMIX_ERROR;
     }
-    if (NULL != ht->ht_type_methods && &pmix_hash_type_methods_ptr != ht->ht_type_methods) {
+    if (PMIX_HASH_KEY_NONE != ht->ht_key_type && PMIX_HASH_KEY_PTR != ht->ht_key_type) {
         pmix_output(0, "pmix_hash_table_remove_value_ptr:"
                        "hash table is for a different key type");
         return PMIX_ERROR;
     }
 #endif
 
-    ht->ht_type_methods = &pmix_hash_type_methods_ptr;
+    ht->ht_key_type = PMIX_HASH_KEY_PTR;
+    if (NULL == ht->ht_table) {
+        return PMIX_ERR_NOT_FOUND;
+    }
     for (ii = pmix_hash_hash_key_ptr(key, key_size) % capacity;; ii += 1) {
         pmix_hash_element_t *elt;
         if (ii == capacity) {
@@ -691,6 +987,9 @@ pmix_hash_table_get_next_elt(pmix_hash_table_t *ht,
     pmix_hash_element_t *elts = ht->ht_table;
     size_t ii, capacity = ht->ht_capacity;
 
+    if (NULL == elts) {
+        return PMIX_ERROR;
+    }
     for (ii = (NULL == prev_elt ? 0 : (prev_elt - elts) + 1); ii < capacity; ii += 1) {
         pmix_hash_element_t *elt = &elts[ii];
         if (elt->valid) {
@@ -708,15 +1007,34 @@ pmix_hash_table_get_first_key_uint32(pmix_hash_table_t *ht, uint32_t *key, void
     return pmix_hash_table_get_next_key_uint32(ht, key, value, NULL, node);
 }
 
+/* the node of a uint32/uint64 table is the index of the slot + 1 */
+static int /* PMIX_ return code */
+pmix_hash_table_get_next_slot(pmix_hash_table_t *ht, void *in_node, size_t *slot)
+{
+    size_t ii;
+
+    if (NULL == ht->ht_tags) {
+        return PMIX_ERROR;
+    }
+    for (ii = (size_t) (uintptr_t) in_node; ii < ht->ht_capacity; ii++) {
+        if (0 != ht->ht_tags[ii]) {
+            *slot = ii;
+            return PMIX_SUCCESS;
+        }
+    }
+    return PMIX_ERROR;
+}
+
 int /* PMIX_ return code */
 pmix_hash_table_get_next_key_uint32(pmix_hash_table_t *ht, uint32_t *key, void **value,
                                     void *in_node, void **out_node)
 {
-    pmix_hash_element_t *elt;
-    if (PMIX_SUCCESS == pmix_hash_table_get_next_elt(ht, (pmix_hash_element_t *) in_node, &elt)) {
-        *key = elt->key.u32;
-        *value = elt->value;
-        *out_node = elt;
+    size_t ii;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_next_slot(ht, in_node, &ii)) {
+        *key = (uint32_t) ht->ht_keys[ii];
+        *value = ht->ht_values[ii];
+        *out_node = (void *) (uintptr_t) (ii + 1);
         return PMIX_SUCCESS;
     }
     return PMIX_ERROR;
@@ -755,11 +1073,12 @@ int /* PMIX_ return code */
 pmix_hash_table_get_next_key_uint64(pmix_hash_table_t *ht, uint64_t *key, void **value,
                                     void *in_node, void **out_node)
 {
-    pmix_hash_element_t *elt;
-    if (PMIX_SUCCESS == pmix_hash_table_get_next_elt(ht, (pmix_hash_element_t *) in_node, &elt)) {
-        *key = elt->key.u64;
-        *value = elt->value;
-        *out_node = elt;
+    size_t ii;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_next_slot(ht, in_node, &ii)) {
+        *key = ht->ht_keys[ii];
+        *value = ht->ht_values[ii];
+        *out_node = (void *) (uintptr_t) (ii + 1);
         return PMIX_SUCCESS;
     }
     return PMIX_ERROR;
@@ -30,6 +30,11 @@
  *  (e.g. uint32_t/uint64_t) or arbitrary size binary key
  *  values. However, only one key type may be used in a given table
  *  concurrently.
+ *
+ *  A table constructed with a TMA (e.g., PMIX_NEW(pmix_hash_table_t,
+ *  tma)) takes all of its storage from that allocator, and holds no
+ *  pointers into the library, so it can be built in shared memory and
+ *  read by any process that maps it at the same address.
  */
 
 #ifndef PMIX_HASH_TABLE_H
@@ -59,7 +64,15 @@ struct pmix_hash_table_t {
     size_t ht_growth_trigger;               /**< size hits this and table is grown  */
     int ht_density_numer, ht_density_denom; /**< max allowed density of table */
     int ht_growth_numer, ht_growth_denom;   /**< growth factor when grown  */
-    const struct pmix_hash_type_methods_t *ht_type_methods;
+    uint8_t ht_key_type;                    /**< type of the keys (opaque to users) */
+    /* tables with uint32/uint64 keys keep them apart from the
+     * values so a probe only touches the tags and keys */
+    uint8_t *ht_tags;                       /**< per-slot tag, 0 => empty */
+    uint64_t *ht_keys;                      /**< key of each slot */
+    void **ht_values;                       /**< value of each slot */
+    /* uint32 keys below ht_dense_size are also indexed directly */
+    void **ht_dense;                        /**< value of each dense key */
+    uint32_t ht_dense_size;                 /**< number of dense keys */
 };
 typedef struct pmix_hash_table_t pmix_hash_table_t;
 
@@ -75,7 +88,12 @@ typedef struct pmix_hash_table_t pmix_hash_table_t;
     .ht_density_denom = 0,                          \
     .ht_growth_numer = 0,                           \
     .ht_growth_denom = 0,                           \
-    .ht_type_methods = NULL                         \
+    .ht_key_type = 0,                               \
+    .ht_tags = NULL,                                \
+    .ht_keys = NULL,                                \
+    .ht_values = NULL,                              \
+    .ht_dense = NULL,                               \
+    .ht_dense_size = 0                              \
 }
 /**
  *  Initializes the table size, must be called before using
@@ -118,6 +136,26 @@ static inline size_t pmix_hash_table_get_size(pmix_hash_table_t *ht)
 
 PMIX_EXPORT int pmix_hash_table_remove_all(pmix_hash_table_t *ht);
 
+/**
+ * Return the storage a table uses per slot, not counting the
+ * values themselves - for sizing tables whose storage comes from
+ * an allocator that manages a fixed region of memory (e.g., a
+ * table constructed with a TMA in a shared-memory segment).
+ */
+PMIX_EXPORT size_t pmix_hash_table_sizeof_hash_element(void);
+
+/**
+ * Move every pointer the table holds - to its storage, its pointer
+ * keys and its values - by delta bytes. For a table built with a TMA
+ * whose region, values included, has since been mapped delta bytes
+ * away from where the table was built. The values themselves are
+ * not touched.
+ *
+ * @param   table   The input hash table (IN).
+ * @param   delta   Distance the region moved by, in bytes (IN).
+ */
+PMIX_EXPORT void pmix_hash_table_relocate(pmix_hash_table_t *ht, ptrdiff_t delta);
+
 /**
  *  Retrieve value via uint32_t key.
  *
@@ -158,6 +196,41 @@ PMIX_EXPORT int pmix_hash_table_set_value_uint32(pmix_hash_table_t *table, uint3
 
 PMIX_EXPORT int pmix_hash_table_remove_value_uint32(pmix_hash_table_t *table, uint32_t key);
 
+/**
+ *  Index the uint32_t keys 0..size-1 directly.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @param   size    The number of keys to index (IN).
+ *  @return  PMIX return code.
+ *
+ *  Meant for tables keyed by rank when the job size is known. The
+ *  values are still kept in the table, so traversal and all other
+ *  keys work as before - pmix_hash_table_get_dense_uint32 is what
+ *  lets a caller avoid the hash for the dense keys. The size can
+ *  only be increased.
+ */
+
+PMIX_EXPORT int pmix_hash_table_set_dense_uint32(pmix_hash_table_t *table, uint32_t size);
+
+/**
+ *  Retrieve value via a dense uint32_t key.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @param   key     The input key (IN).
+ *  @return  The value, or NULL if the key is not dense or was not
+ *           stored - use pmix_hash_table_get_value_uint32 to tell
+ *           a missing key from one stored with a NULL value.
+ *
+ */
+
+static inline void *pmix_hash_table_get_dense_uint32(pmix_hash_table_t *ht, uint32_t key)
+{
+    if (key < ht->ht_dense_size) {
+        return ht->ht_dense[key];
+    }
+    return NULL;
+}
+
 /**
  *  Retrieve value via uint64_t key.
  *
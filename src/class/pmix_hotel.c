@@ -20,28 +20,71 @@
 #include <event.h>
 #include "src/class/pmix_hotel.h"
 
+/* time left until the given room is to be evicted */
+static void time_left(pmix_hotel_room_t *room, struct timeval *now, struct timeval *left)
+{
+    if (timercmp(&room->expires, now, >)) {
+        timersub(&room->expires, now, left);
+    } else {
+        left->tv_sec = 0;
+        left->tv_usec = 0;
+    }
+}
+
+void pmix_hotel_start_timer(pmix_hotel_t *hotel)
+{
+    struct timeval now, left;
+
+    if (0 > hotel->oldest_room) {
+        return;
+    }
+    gettimeofday(&now, NULL);
+    time_left(&hotel->rooms[hotel->oldest_room], &now, &left);
+    /* adding a pending event moves it to the new time */
+    pmix_event_add(&hotel->eviction_timer_event, &left);
+    hotel->eviction_timer_active = true;
+}
+
 static void local_eviction_callback(int fd, short flags, void *arg)
 {
+    pmix_hotel_t *hotel = (pmix_hotel_t *) arg;
+    pmix_hotel_room_t *room;
+    struct timeval now;
+    void *occupant;
+    int room_num;
     (void) fd;
     (void) flags;
-    pmix_hotel_room_eviction_callback_arg_t *eargs = (pmix_hotel_room_eviction_callback_arg_t *)
-        arg;
-    void *occupant = eargs->hotel->rooms[eargs->room_num].occupant;
-
-    /* Remove the occurpant from the room.
-
-       Do not change this logic without also changing the same logic
-       in pmix_hotel_checkout() and
-       pmix_hotel_checkout_and_return_occupant(). */
-    pmix_hotel_t *hotel = eargs->hotel;
-    pmix_hotel_room_t *room = &(hotel->rooms[eargs->room_num]);
-    room->occupant = NULL;
-    hotel->last_unoccupied_room++;
-    assert(hotel->last_unoccupied_room < hotel->num_rooms);
-    hotel->unoccupied_rooms[hotel->last_unoccupied_room] = eargs->room_num;
-
-    /* Invoke the user callback to tell them that they were evicted */
-    hotel->evict_callback_fn(hotel, eargs->room_num, occupant);
+
+    hotel->eviction_timer_active = false;
+    gettimeofday(&now, NULL);
+
+    /* occupants that checked out early are already gone, so the
+     * oldest remaining one is the next to expire */
+    while (0 <= (room_num = hotel->oldest_room)) {
+        room = &(hotel->rooms[room_num]);
+        if (timercmp(&room->expires, &now, >)) {
+            break;
+        }
+        occupant = room->occupant;
+
+        /* Remove the occupant from the room.
+
+           Do not change this logic without also changing the same logic
+           in pmix_hotel_checkout() and
+           pmix_hotel_checkout_and_return_occupant(). */
+        room->occupant = NULL;
+        pmix_hotel_unlink_room(hotel, room_num);
+        hotel->last_unoccupied_room++;
+        assert(hotel->last_unoccupied_room < hotel->num_rooms);
+        hotel->unoccupied_rooms[hotel->last_unoccupied_room] = room_num;
+
+        /* Invoke the user callback to tell them that they were evicted */
+        hotel->evict_callback_fn(hotel, room_num, occupant);
+    }
+
+    /* wait for the next one - this also covers a timer started by
+     * an occupant that checked in from the callback */
+    pmix_hotel_start_timer(hotel);
 }
 
 pmix_status_t pmix_hotel_init(pmix_hotel_t *h, int num_rooms, pmix_event_base_t *evbase,
@@ -61,29 +104,25 @@ pmix_status_t pmix_hotel_init(pmix_hotel_t *h, int num_rooms, pmix_event_base_t
     h->eviction_timeout.tv_sec = eviction_timeout;
     h->evict_callback_fn = evict_callback_fn;
     h->rooms = (pmix_hotel_room_t *) malloc(num_rooms * sizeof(pmix_hotel_room_t));
-    if (NULL != evict_callback_fn) {
-        h->eviction_args = (pmix_hotel_room_eviction_callback_arg_t *) malloc(
-            num_rooms * sizeof(pmix_hotel_room_eviction_callback_arg_t));
-    }
     h->unoccupied_rooms = (int *) malloc(num_rooms * sizeof(int));
     h->last_unoccupied_room = num_rooms - 1;
+    h->oldest_room = -1;
+    h->newest_room = -1;
 
     for (i = 0; i < num_rooms; ++i) {
         /* Mark this room as unoccupied */
         h->rooms[i].occupant = NULL;
+        h->rooms[i].older = -1;
+        h->rooms[i].newer = -1;
 
         /* Setup this room in the unoccupied index array */
         h->unoccupied_rooms[i] = i;
+    }
 
-        /* Setup the eviction callback args */
-        h->eviction_args[i].hotel = h;
-        h->eviction_args[i].room_num = i;
-
-        /* Create this room's event (but don't add it) */
-        if (NULL != h->evbase) {
-            pmix_event_assign(&(h->rooms[i].eviction_timer_event), h->evbase, -1, 0,
-                              local_eviction_callback, &(h->eviction_args[i]));
-        }
+    /* Create the eviction event (but don't add it) */
+    if (NULL != h->evbase) {
+        pmix_event_assign(&h->eviction_timer_event, h->evbase, -1, 0,
+                          local_eviction_callback, h);
     }
 
     return PMIX_SUCCESS;
@@ -97,30 +136,23 @@ static void constructor(pmix_hotel_t *h)
     h->eviction_timeout.tv_usec = 0;
     h->evict_callback_fn = NULL;
     h->rooms = NULL;
-    h->eviction_args = NULL;
+    h->eviction_timer_active = false;
     h->unoccupied_rooms = NULL;
     h->last_unoccupied_room = -1;
+    h->oldest_room = -1;
+    h->newest_room = -1;
 }
 
 static void destructor(pmix_hotel_t *h)
 {
-    int i;
-
-    /* Go through all occupied rooms and destroy their events */
-    if (NULL != h->evbase) {
-        for (i = 0; i < h->num_rooms; ++i) {
-            if (NULL != h->rooms[i].occupant) {
-                pmix_event_del(&(h->rooms[i].eviction_timer_event));
-            }
-        }
+    /* Destroy the pending eviction event */
+    if (NULL != h->evbase && h->eviction_timer_active) {
+        pmix_event_del(&h->eviction_timer_event);
     }
 
     if (NULL != h->rooms) {
         free(h->rooms);
     }
-    if (NULL != h->eviction_args) {
-        free(h->eviction_args);
-    }
     if (NULL != h->unoccupied_rooms) {
         free(h->unoccupied_rooms);
     }
@@ -48,9 +48,13 @@
  *
  * There is an pmix_hotel_init() function to create a hotel, but no
  * corresponding finalize; the destructor will handle all finalization
- * issues.  Note that when a hotel is destroyed, it will delete all
- * pending events from the event base (i.e., all pending eviction
+ * issues.  Note that when a hotel is destroyed, it will delete its
+ * pending event from the event base (i.e., all pending eviction
  * callbacks); no further eviction callbacks will be invoked.
+ *
+ * Every stay has the same length, so occupants expire in the order
+ * they checked in. The hotel therefore keeps a single timer, set for
+ * the expiration of its oldest occupant, instead of one per room.
  */
 
 #ifndef PMIX_HOTEL_H
@@ -62,6 +66,9 @@
 #include "src/include/pmix_prefetch.h"
 #include "src/include/pmix_types.h"
 #include <event.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
@@ -86,32 +93,13 @@ typedef void (*pmix_hotel_eviction_callback_fn_t)(struct pmix_hotel_t *hotel, in
    contiguous set of rooms in an array. */
 typedef struct {
     void *occupant;
-    pmix_event_t eviction_timer_event;
+    /* neighbors in the check-in ordered list of occupied rooms */
+    int older;
+    int newer;
+    /* time at which the occupant is to be evicted */
+    struct timeval expires;
 } pmix_hotel_room_t;
 
-/* Note that this is an internal data structure; it is not part of the
-   public pmix_hotel interface.  Public consumers of pmix_hotel
-   shouldn't need to use this struct at all (we only have it here in
-   this .h file because some functions are inlined for speed, and need
-   to get to the internals of this struct).
-
-   Use a unique struct for holding the arguments for eviction
-   callbacks.  We *could* make the to-be-evicted pmix_hotel_room_t
-   instance as the argument, but we don't, for 2 reasons:
-
-   1. We want as many pmix_hotel_room_t's to fit in a cache line as
-      possible (i.e., to be as cache-friendly as possible).  The
-      common/fast code path only needs to access the data in the
-      pmix_hotel_room_t (and not the callback argument data).
-
-   2. Evictions will be uncommon, so we don't mind penalizing them a
-      bit by making the data be in a separate cache line.
-*/
-typedef struct {
-    struct pmix_hotel_t *hotel;
-    int room_num;
-} pmix_hotel_room_eviction_callback_arg_t;
-
 typedef struct pmix_hotel_t {
     /* make this an object */
     pmix_object_t super;
@@ -127,14 +115,18 @@ typedef struct pmix_hotel_t {
     /* All rooms in this hotel */
     pmix_hotel_room_t *rooms;
 
-    /* Separate array for all the eviction callback arguments (see
-       rationale above for why this is a separate array) */
-    pmix_hotel_room_eviction_callback_arg_t *eviction_args;
+    /* Timer for the eviction of the oldest occupant */
+    pmix_event_t eviction_timer_event;
+    bool eviction_timer_active;
 
     /* All currently unoccupied rooms in this hotel (not necessarily
        in any particular order) */
     int *unoccupied_rooms;
     int last_unoccupied_room;
+
+    /* Occupied rooms linked in the order they were checked in */
+    int oldest_room;
+    int newest_room;
 } pmix_hotel_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_hotel_t);
 
@@ -146,9 +138,11 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_hotel_t);
     .eviction_timeout = {0, 0},                     \
     .evict_callback_fn = NULL,                      \
     .rooms = NULL,                                  \
-    .eviction_args = NULL,                          \
+    .eviction_timer_active = false,                 \
     .unoccupied_rooms = NULL,                       \
-    .last_unoccupied_room = 0                       \
+    .last_unoccupied_room = 0,                      \
+    .oldest_room = -1,                              \
+    .newest_room = -1                               \
 }
 
 
@@ -179,6 +173,61 @@ PMIX_EXPORT pmix_status_t pmix_hotel_init(pmix_hotel_t *hotel, int num_rooms,
                                           pmix_event_base_t *evbase, uint32_t eviction_timeout,
                                           pmix_hotel_eviction_callback_fn_t evict_callback_fn);
 
+/* Note that these are internal functions; they are not part of the
+ * public pmix_hotel interface. They maintain the list of occupied
+ * rooms in check-in order. */
+static inline void pmix_hotel_link_room(pmix_hotel_t *hotel, int room_num)
+{
+    pmix_hotel_room_t *room = &(hotel->rooms[room_num]);
+
+    room->older = hotel->newest_room;
+    room->newer = -1;
+    if (0 <= hotel->newest_room) {
+        hotel->rooms[hotel->newest_room].newer = room_num;
+    } else {
+        hotel->oldest_room = room_num;
+    }
+    hotel->newest_room = room_num;
+}
+
+PMIX_EXPORT void pmix_hotel_start_timer(pmix_hotel_t *hotel);
+
+static inline void pmix_hotel_occupy_room(pmix_hotel_t *hotel, int room_num, void *occupant)
+{
+    pmix_hotel_room_t *room = &(hotel->rooms[room_num]);
+
+    room->occupant = occupant;
+    pmix_hotel_link_room(hotel, room_num);
+
+    /* the timer is already running for an older occupant, and will
+     * be moved on to this one when they leave */
+    if (NULL != hotel->evbase) {
+        gettimeofday(&room->expires, NULL);
+        timeradd(&room->expires, &hotel->eviction_timeout, &room->expires);
+        if (!hotel->eviction_timer_active) {
+            pmix_hotel_start_timer(hotel);
+        }
+    }
+}
+
+static inline void pmix_hotel_unlink_room(pmix_hotel_t *hotel, int room_num)
+{
+    pmix_hotel_room_t *room = &(hotel->rooms[room_num]);
+
+    if (0 <= room->older) {
+        hotel->rooms[room->older].newer = room->newer;
+    } else {
+        hotel->oldest_room = room->newer;
+    }
+    if (0 <= room->newer) {
+        hotel->rooms[room->newer].older = room->older;
+    } else {
+        hotel->newest_room = room->older;
+    }
+    room->older = -1;
+    room->newer = -1;
+}
+
 /**
  * Check in an occupant to the hotel.
  *
@@ -187,12 +236,12 @@ PMIX_EXPORT pmix_status_t pmix_hotel_init(pmix_hotel_t *hotel, int num_rooms,
  * @param room The room number that identifies this occupant in the
  * hotel (OUT).
  *
- * If there is room in the hotel, the occupant is checked in and the
- * timer for that occupant is started.  The occupant's room is
+ * If there is room in the hotel, the occupant is checked in and their
+ * eviction time is set.  The occupant's room is
  * returned in the "room" param.
  *
- * Note that once a room's checkout_expire timer expires, the occupant
- * is forcibly checked out, and then the eviction callback is invoked.
+ * Note that once a room's eviction time passes, the occupant is
+ * forcibly checked out, and then the eviction callback is invoked.
  *
  * @return PMIX_SUCCESS if the occupant is successfully checked in,
  * and the room parameter will contain a valid value.
@@ -201,8 +250,6 @@ PMIX_EXPORT pmix_status_t pmix_hotel_init(pmix_hotel_t *hotel, int num_rooms,
  */
 static inline pmix_status_t pmix_hotel_checkin(pmix_hotel_t *hotel, void *occupant, int *room_num)
 {
-    pmix_hotel_room_t *room;
-
     /* Do we have any rooms available? */
     if (PMIX_UNLIKELY(hotel->last_unoccupied_room < 0)) {
         *room_num = -1;
@@ -211,13 +258,7 @@ static inline pmix_status_t pmix_hotel_checkin(pmix_hotel_t *hotel, void *occupa
 
     /* Put this occupant into the first empty room that we have */
     *room_num = hotel->unoccupied_rooms[hotel->last_unoccupied_room--];
-    room = &(hotel->rooms[*room_num]);
-    room->occupant = occupant;
-
-    /* Assign the event and make it pending */
-    if (NULL != hotel->evbase) {
-        pmix_event_add(&(room->eviction_timer_event), &(hotel->eviction_timeout));
-    }
+    pmix_hotel_occupy_room(hotel, *room_num, occupant);
 
     return PMIX_SUCCESS;
 }
@@ -228,18 +269,10 @@ static inline pmix_status_t pmix_hotel_checkin(pmix_hotel_t *hotel, void *occupa
  */
 static inline void pmix_hotel_checkin_with_res(pmix_hotel_t *hotel, void *occupant, int *room_num)
 {
-    pmix_hotel_room_t *room;
-
     /* Put this occupant into the first empty room that we have */
     *room_num = hotel->unoccupied_rooms[hotel->last_unoccupied_room--];
-    room = &(hotel->rooms[*room_num]);
-    assert(room->occupant == NULL);
-    room->occupant = occupant;
-
-    /* Assign the event and make it pending */
-    if (NULL != hotel->evbase) {
-        pmix_event_add(&(room->eviction_timer_event), &(hotel->eviction_timeout));
-    }
+    assert(hotel->rooms[*room_num].occupant == NULL);
+    pmix_hotel_occupy_room(hotel, *room_num, occupant);
 }
 
 /**
@@ -248,8 +281,8 @@ static inline void pmix_hotel_checkin_with_res(pmix_hotel_t *hotel, void *occupa
  * @param hotel Pointer to hotel (IN)
  * @param room Room number to checkout (IN)
  *
- * If there is an occupant in the room, their timer is canceled and
- * they are checked out.
+ * If there is an occupant in the room, they are checked out. The
+ * hotel's timer simply finds them gone when it fires.
  *
  * Nothing is returned (as a minor optimization).
  */
@@ -271,9 +304,7 @@ static inline void pmix_hotel_checkout(pmix_hotel_t *hotel, int room_num)
            logic in pmix_hotel_checkout_and_return_occupant() and
            pmix_hotel.c:local_eviction_callback(). */
         room->occupant = NULL;
-        if (NULL != hotel->evbase) {
-            pmix_event_del(&(room->eviction_timer_event));
-        }
+        pmix_hotel_unlink_room(hotel, room_num);
         hotel->last_unoccupied_room++;
         assert(hotel->last_unoccupied_room < hotel->num_rooms);
         hotel->unoccupied_rooms[hotel->last_unoccupied_room] = room_num;
@@ -290,8 +321,8 @@ static inline void pmix_hotel_checkout(pmix_hotel_t *hotel, int room_num)
  * @param hotel Pointer to hotel (IN)
  * @param room Room number to checkout (IN)
  * @param void * occupant (OUT)
- * If there is an occupant in the room, their timer is canceled and
- * they are checked out.
+ * If there is an occupant in the room, they are checked out. The
+ * hotel's timer simply finds them gone when it fires.
  *
  * Use this checkout and when caller needs the occupant
  */
@@ -317,9 +348,7 @@ static inline void pmix_hotel_checkout_and_return_occupant(pmix_hotel_t *hotel,
            pmix_hotel.c:local_eviction_callback(). */
         *occupant = room->occupant;
         room->occupant = NULL;
-        if (NULL != hotel->evbase) {
-            pmix_event_del(&(room->eviction_timer_event));
-        }
+        pmix_hotel_unlink_room(hotel, room_num);
         hotel->last_unoccupied_room++;
         assert(hotel->last_unoccupied_room < hotel->num_rooms);
         hotel->unoccupied_rooms[hotel->last_unoccupied_room] = room_num;
@@ -373,6 +402,46 @@ static inline void pmix_hotel_knock(pmix_hotel_t *hotel, int room_num, void **oc
     }
 }
 
+/**
+ * Return the number of occupied rooms in the hotel.
+ *
+ * @param hotel Pointer to hotel (IN)
+ * @return int number of occupants
+ */
+static inline int pmix_hotel_num_occupants(pmix_hotel_t *hotel)
+{
+    return hotel->num_rooms - 1 - hotel->last_unoccupied_room;
+}
+
+/**
+ * Return the room of the occupant that has been checked in the longest.
+ *
+ * @param hotel Pointer to hotel (IN)
+ * @return int room number, or -1 if the hotel is empty
+ *
+ * Together with pmix_hotel_next_room(), this allows cycling across the
+ * occupants in check-in order without knocking on every empty room.
+ */
+static inline int pmix_hotel_oldest_room(pmix_hotel_t *hotel)
+{
+    return hotel->oldest_room;
+}
+
+/**
+ * Return the room of the occupant checked in right after the one in
+ * the given room.
+ *
+ * @param hotel Pointer to hotel (IN)
+ * @param room_num Occupied room number (IN)
+ * @return int room number, or -1 if there are no newer occupants
+ *
+ * The given room may be checked out once its successor was obtained.
+ */
+static inline int pmix_hotel_next_room(pmix_hotel_t *hotel, int room_num)
+{
+    return hotel->rooms[room_num].newer;
+}
+
 END_C_DECLS
 
 #endif /* PMIX_HOTEL_H */
@@ -207,6 +207,25 @@ void pmix_list_splice(pmix_list_t *thislist, pmix_list_item_t *pos, pmix_list_t
     }
 }
 
+void pmix_list_relocate(pmix_list_t *list, ptrdiff_t delta)
+{
+    pmix_list_item_t *item;
+
+    PMIX_TMA_RELOCATE(list->pmix_list_sentinel.pmix_list_next, delta);
+    PMIX_TMA_RELOCATE(list->pmix_list_sentinel.pmix_list_prev, delta);
+#if PMIX_ENABLE_DEBUG
+    PMIX_TMA_RELOCATE(list->pmix_list_sentinel.pmix_list_item_belong_to, delta);
+#endif
+    for (item = (pmix_list_item_t *) list->pmix_list_sentinel.pmix_list_next;
+         item != &list->pmix_list_sentinel; item = (pmix_list_item_t *) item->pmix_list_next) {
+        PMIX_TMA_RELOCATE(item->pmix_list_next, delta);
+        PMIX_TMA_RELOCATE(item->pmix_list_prev, delta);
+#if PMIX_ENABLE_DEBUG
+        PMIX_TMA_RELOCATE(item->pmix_list_item_belong_to, delta);
+#endif
+    }
+}
+
 int pmix_list_sort(pmix_list_t *list, pmix_list_item_compare_fn_t compare)
 {
     pmix_list_item_t *item;
@@ -913,6 +913,20 @@ typedef int (*pmix_list_item_compare_fn_t)(pmix_list_item_t **a,
 PMIX_EXPORT int pmix_list_sort(pmix_list_t *list,
                                pmix_list_item_compare_fn_t compare);
 
+/**
+ * Move the links of a list and of its items by delta bytes.
+ *
+ * @param list The list container (IN)
+ * @param delta Distance the list moved by, in bytes (IN)
+ *
+ * For a list that, together with all of its items, lives in a
+ * region of memory (e.g., that of a TMA) that has since been
+ * mapped delta bytes away from where the list was built. Only the
+ * links are moved - any pointers held by the items are left to
+ * the caller.
+ */
+PMIX_EXPORT void pmix_list_relocate(pmix_list_t *list, ptrdiff_t delta);
+
 END_C_DECLS
 
 #endif /* PMIX_LIST_H */
@@ -0,0 +1,172 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <stdlib.h>
+
+#include "src/class/pmix_obj_pool.h"
+#include "src/util/pmix_output.h"
+
+/* active pools, for reporting */
+static pmix_mutex_t pools_lock = PMIX_MUTEX_STATIC_INIT;
+static pmix_obj_pool_t *pools = NULL;
+
+static void *pool_malloc(pmix_tma_t *tma, size_t size)
+{
+    pmix_obj_pool_t *pool = (pmix_obj_pool_t *) tma->data_ptr;
+    pmix_obj_pool_item_t *item;
+
+    /* we only hold storage for our own class */
+    if (size > pool->size) {
+        return NULL;
+    }
+
+    pmix_mutex_lock(&pool->lock);
+    ++pool->nallocs;
+    if (++pool->live > pool->peak) {
+        pool->peak = pool->live;
+    }
+    item = pool->items;
+    if (NULL != item) {
+        pool->items = item->next;
+        --pool->nitems;
+        ++pool->nreused;
+    }
+    pmix_mutex_unlock(&pool->lock);
+
+    if (NULL == item) {
+        item = (pmix_obj_pool_item_t *) malloc(pool->size);
+    }
+    return item;
+}
+
+static void pool_free(pmix_tma_t *tma, void *ptr)
+{
+    pmix_obj_pool_t *pool = (pmix_obj_pool_t *) tma->data_ptr;
+    pmix_obj_pool_item_t *item = (pmix_obj_pool_item_t *) ptr;
+
+    pmix_mutex_lock(&pool->lock);
+    /* objects created before the pool was attached to their
+     * class were not counted */
+    if (0 < pool->live) {
+        --pool->live;
+    }
+    if (pool->active && pool->nitems < pool->max) {
+        item->next = pool->items;
+        pool->items = item;
+        ++pool->nitems;
+        item = NULL;
+    }
+    pmix_mutex_unlock(&pool->lock);
+
+    if (NULL != item) {
+        free(item);
+    }
+}
+
+void pmix_obj_pool_init(pmix_obj_pool_t *pool, const char *name, size_t size, size_t max)
+{
+    pool->tma.tma_malloc = pool_malloc;
+    pool->tma.tma_calloc = NULL;
+    pool->tma.tma_realloc = NULL;
+    pool->tma.tma_strdup = NULL;
+    pool->tma.tma_memmove = NULL;
+    pool->tma.tma_free = pool_free;
+    pool->tma.data_ptr = (void **) pool;
+    pool->name = name;
+    /* every element must be able to hold the link */
+    if (size < sizeof(pmix_obj_pool_item_t)) {
+        size = sizeof(pmix_obj_pool_item_t);
+    }
+    pool->size = size;
+    pool->max = max;
+    pool->items = NULL;
+    pool->nitems = 0;
+    pool->nallocs = 0;
+    pool->nreused = 0;
+    pool->live = 0;
+    pool->peak = 0;
+    pool->active = (0 < max);
+    if (pool->active) {
+        pmix_mutex_lock(&pools_lock);
+        pool->next = pools;
+        pools = pool;
+        pmix_mutex_unlock(&pools_lock);
+    }
+}
+
+void pmix_obj_pool_attach(pmix_obj_pool_t *pool, pmix_class_t *cls, size_t max)
+{
+    pmix_obj_pool_init(pool, cls->cls_name, cls->cls_sizeof, max);
+    if (pool->active) {
+        pool->cls = cls;
+        cls->cls_tma = &pool->tma;
+    }
+}
+
+void pmix_obj_pool_finalize(pmix_obj_pool_t *pool)
+{
+    pmix_obj_pool_item_t *item;
+    pmix_obj_pool_t **pp;
+
+    pmix_mutex_lock(&pools_lock);
+    for (pp = &pools; NULL != *pp; pp = &(*pp)->next) {
+        if (pool == *pp) {
+            *pp = pool->next;
+            break;
+        }
+    }
+    pool->next = NULL;
+    pmix_mutex_unlock(&pools_lock);
+
+    if (NULL != pool->cls) {
+        if (&pool->tma == pool->cls->cls_tma) {
+            pool->cls->cls_tma = NULL;
+        }
+        pool->cls = NULL;
+    }
+
+    pmix_mutex_lock(&pool->lock);
+    pool->active = false;
+    while (NULL != (item = pool->items)) {
+        pool->items = item->next;
+        free(item);
+    }
+    pool->nitems = 0;
+    pmix_mutex_unlock(&pool->lock);
+}
+
+static void report(int output, pmix_obj_pool_t *pool)
+{
+    pmix_mutex_lock(&pool->lock);
+    pmix_output(output,
+                "pool %s: %lu allocations, %lu from the pool, %lu live, %lu peak, %lu held",
+                (NULL == pool->name) ? "UNKNOWN" : pool->name,
+                (unsigned long) pool->nallocs, (unsigned long) pool->nreused,
+                (unsigned long) pool->live, (unsigned long) pool->peak,
+                (unsigned long) pool->nitems);
+    pmix_mutex_unlock(&pool->lock);
+}
+
+void pmix_obj_pool_report(int output, pmix_obj_pool_t *pool)
+{
+    pmix_obj_pool_t *p;
+
+    if (NULL != pool) {
+        report(output, pool);
+        return;
+    }
+    pmix_mutex_lock(&pools_lock);
+    for (p = pools; NULL != p; p = p->next) {
+        report(output, p);
+    }
+    pmix_mutex_unlock(&pools_lock);
+}
@@ -0,0 +1,135 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file
+ *
+ * Free list of object storage for a single class. Storage released
+ * by PMIX_RELEASE is kept for reuse, up to a maximum number of
+ * elements, instead of being returned to the heap.
+ *
+ * A pool can either be handed to PMIX_NEW as the memory allocator
+ * (TMA) of individual objects, or attached to the class so that
+ * every PMIX_NEW of that class that does not give its own allocator
+ * is served by the pool. In the first case the allocator serves
+ * object storage only - objects created from a pool must not use
+ * their TMA for any other allocation.
+ *
+ * Pools must be statically initialized with PMIX_OBJ_POOL_STATIC_INIT
+ * as objects can outlive the pool's active period.
+ */
+
+#ifndef PMIX_OBJ_POOL_H
+#define PMIX_OBJ_POOL_H
+
+#include "src/include/pmix_config.h"
+
+#include "src/class/pmix_object.h"
+#include "src/threads/pmix_mutex.h"
+
+BEGIN_C_DECLS
+
+typedef struct pmix_obj_pool_item_t {
+    struct pmix_obj_pool_item_t *next;
+} pmix_obj_pool_item_t;
+
+typedef struct pmix_obj_pool_t {
+    /** allocator given to PMIX_NEW */
+    pmix_tma_t tma;
+    /** name of the pooled class, for reporting */
+    const char *name;
+    /** class the pool is attached to, if any */
+    pmix_class_t *cls;
+    /** size of each element */
+    size_t size;
+    /** maximum number of elements held for reuse */
+    size_t max;
+    /** next active pool, for reporting */
+    struct pmix_obj_pool_t *next;
+    /** protects the fields below */
+    pmix_mutex_t lock;
+    bool active;
+    pmix_obj_pool_item_t *items;
+    size_t nitems;
+    /** number of allocations served, and how many of those
+     * were satisfied from the pool */
+    uint64_t nallocs;
+    uint64_t nreused;
+    /** number of objects currently in use, and the most
+     * that have been in use at one time */
+    size_t live;
+    size_t peak;
+} pmix_obj_pool_t;
+
+#define PMIX_OBJ_POOL_STATIC_INIT           \
+    {                                       \
+        .tma = {NULL, NULL, NULL, NULL,     \
+                NULL, NULL, NULL},          \
+        .name = NULL,                       \
+        .cls = NULL,                        \
+        .size = 0,                          \
+        .max = 0,                           \
+        .next = NULL,                       \
+        .lock = PMIX_MUTEX_STATIC_INIT,     \
+        .active = false,                    \
+        .items = NULL,                      \
+        .nitems = 0,                        \
+        .nallocs = 0,                       \
+        .nreused = 0,                       \
+        .live = 0,                          \
+        .peak = 0                           \
+    }
+
+/**
+ * Setup a pool for objects of the given class, holding at most
+ * max elements for reuse. A max of zero leaves the pool inactive,
+ * in which case objects are allocated from the heap as usual.
+ */
+#define PMIX_OBJ_POOL_INIT(p, type, m) \
+    pmix_obj_pool_init((p), #type, sizeof(type), (m))
+
+PMIX_EXPORT void pmix_obj_pool_init(pmix_obj_pool_t *pool, const char *name,
+                                    size_t size, size_t max);
+
+/**
+ * Setup a pool as above and attach it to the class, so that
+ * PMIX_NEW of the class is served by the pool unless an allocator
+ * is given. Storage of objects of the class that were created
+ * before the pool was attached may also be returned to it.
+ */
+#define PMIX_OBJ_POOL_ATTACH(p, type, m) \
+    pmix_obj_pool_attach((p), PMIX_CLASS(type), (m))
+
+PMIX_EXPORT void pmix_obj_pool_attach(pmix_obj_pool_t *pool, pmix_class_t *cls,
+                                      size_t max);
+
+/**
+ * Detach the pool from its class, if attached, return the storage
+ * held by the pool to the heap and deactivate it. Objects still in
+ * use will return their storage to the heap when they are released.
+ */
+PMIX_EXPORT void pmix_obj_pool_finalize(pmix_obj_pool_t *pool);
+
+/**
+ * Output the allocation counts of the given pool, or of all active
+ * pools if pool is NULL, on the given output stream
+ */
+PMIX_EXPORT void pmix_obj_pool_report(int output, pmix_obj_pool_t *pool);
+
+/**
+ * Return the allocator to pass to PMIX_NEW for objects of this
+ * pool's class, or NULL if the pool is not active
+ */
+static inline pmix_tma_t *pmix_obj_pool_tma(pmix_obj_pool_t *pool)
+{
+    return pool->active ? &pool->tma : NULL;
+}
+
+END_C_DECLS
+
+#endif /* PMIX_OBJ_POOL_H */
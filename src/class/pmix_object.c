@@ -49,10 +49,15 @@ PMIX_EXPORT pmix_class_t pmix_object_t_class = {
     0,                    /* class hierarchy depth */
     NULL,                 /* array of constructors */
     NULL,                 /* array of destructors */
-    sizeof(pmix_object_t) /* size of the pmix object */
+    sizeof(pmix_object_t), /* size of the pmix object */
+    NULL,                 /* allocator for instances */
+    NULL,                 /* next initialized class */
+    0,                    /* live instances */
+    0                     /* instances created */
 };
 
 int pmix_class_init_epoch = 1;
+bool pmix_class_accounting = false;
 
 /*
  * Local variables
@@ -62,6 +67,7 @@ static void **classes = NULL;
 static int num_classes = 0;
 static int max_classes = 0;
 static const int increment = 10;
+static pmix_class_t *class_list = NULL;
 
 /*
  * Local functions
@@ -155,6 +161,8 @@ void pmix_class_initialize(pmix_class_t *cls)
 
     cls->cls_initialized = pmix_class_init_epoch;
     save_class(cls);
+    cls->cls_next = class_list;
+    __atomic_store_n(&class_list, cls, __ATOMIC_RELEASE);
 
     /* All done */
 
@@ -185,10 +193,16 @@ int pmix_class_finalize(void)
         num_classes = 0;
         max_classes = 0;
     }
+    __atomic_store_n(&class_list, NULL, __ATOMIC_RELEASE);
 
     return 0;
 }
 
+pmix_class_t *pmix_class_list(void)
+{
+    return __atomic_load_n(&class_list, __ATOMIC_ACQUIRE);
+}
+
 static void save_class(pmix_class_t *cls)
 {
     if (num_classes >= max_classes) {
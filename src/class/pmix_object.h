@@ -66,7 +66,8 @@
  *     sally_construct,
  *     sally_destruct,
  *     0, 0, NULL, NULL,
- *     sizeof ("sally_t")
+ *     sizeof ("sally_t"),
+ *     NULL
  *   };
  * @endcode
  * This variable should be declared in the interface (.h) file using
@@ -285,6 +286,18 @@ static inline void pmix_tma_free(pmix_tma_t *tma, void *ptr)
     }
 }
 
+/**
+ * Move a pointer into the memory of a TMA whose region has been
+ * mapped delta bytes away from where the pointer was set. NULL
+ * pointers are left alone.
+ */
+#define PMIX_TMA_RELOCATE(ptr, delta)                                   \
+    do {                                                                \
+        if (NULL != (ptr)) {                                            \
+            (ptr) = (void *) ((uintptr_t) (ptr) + (uintptr_t) (delta)); \
+        }                                                               \
+    } while (0)
+
 /**
  * Class descriptor.
  *
@@ -303,10 +316,22 @@ struct pmix_class_t {
     pmix_destruct_t *cls_destruct_array;
     /**< array of parent class destructors */
     size_t cls_sizeof; /**< size of an object instance */
+    pmix_tma_t *cls_tma;
+    /**< allocator for instances created without one (NULL = heap) */
+    pmix_class_t *cls_next;  /**< next initialized class */
+    int64_t cls_live;        /**< instances alive when accounting */
+    uint64_t cls_allocs;     /**< instances created when accounting */
 };
 
 PMIX_EXPORT extern int pmix_class_init_epoch;
 
+/**
+ * Whether to count the instances of each class created with
+ * PMIX_NEW and not yet released. Objects remember whether they were
+ * counted, so this can be turned on at any time.
+ */
+PMIX_EXPORT extern bool pmix_class_accounting;
+
 /**
  * For static initializations of OBJects.
  *
@@ -359,6 +384,7 @@ struct pmix_object_t {
     pthread_mutex_t obj_lock;
     pmix_class_t *obj_class;                 /**< class descriptor */
     int32_t obj_reference_count;             /**< reference count */
+    int32_t obj_counted;                     /**< counted by its class */
     pmix_tma_t obj_tma;                      /**< allocator for this object */
 #if PMIX_ENABLE_DEBUG
     const char *cls_init_file_name; /**< In debug mode store the file where the object get constructed */
@@ -396,7 +422,8 @@ struct pmix_object_t {
                                  0,                                \
                                  NULL,                             \
                                  NULL,                             \
-                                 sizeof(NAME)}
+                                 sizeof(NAME),                     \
+                                 NULL}
 
 /**
  * Declaration for class descriptor
@@ -503,12 +530,13 @@ static inline pmix_object_t *pmix_obj_new_debug_tma(pmix_class_t *type, pmix_tma
             if (0 == pmix_obj_update(_obj, -1)) {                          \
                 PMIX_SET_MAGIC_ID((object), 0);                            \
                 pmix_obj_run_destructors(_obj);                            \
+                pmix_obj_uncount(_obj);                                    \
                 PMIX_REMEMBER_FILE_AND_LINENO(object, __FILE__, __LINE__); \
                 if (NULL != _obj->obj_tma.tma_free) {                      \
                     pmix_tma_free(&_obj->obj_tma, object);                 \
                 }                                                          \
                 else {                                                     \
-                    free(object);                                          \
+                    pmix_tma_free(_obj->obj_class->cls_tma, object);       \
                 }                                                          \
                 object = NULL;                                             \
             }                                                              \
@@ -519,11 +547,13 @@ static inline pmix_object_t *pmix_obj_new_debug_tma(pmix_class_t *type, pmix_tma
             pmix_object_t *_obj = (pmix_object_t *) object; \
             if (0 == pmix_obj_update(_obj, -1)) {           \
                 pmix_obj_run_destructors(_obj);             \
+                pmix_obj_uncount(_obj);                     \
                 if (NULL != _obj->obj_tma.tma_free) {       \
                     pmix_tma_free(&_obj->obj_tma, object);  \
                 }                                           \
                 else {                                      \
-                    free(object);                           \
+                    pmix_tma_free(_obj->obj_class->cls_tma, \
+                                  object);                  \
                 }                                           \
                 object = NULL;                              \
             }                                               \
@@ -538,6 +568,7 @@ static inline pmix_object_t *pmix_obj_new_debug_tma(pmix_class_t *type, pmix_tma
  */
 static inline void pmix_obj_construct_tma(pmix_object_t *obj, pmix_tma_t *tma)
 {
+    obj->obj_counted = 0;
     if (NULL == tma) {
         obj->obj_tma.tma_malloc = NULL;
         obj->obj_tma.tma_calloc = NULL;
@@ -671,6 +702,25 @@ static inline void pmix_obj_run_destructors(pmix_object_t *object)
     }
 }
 
+/**
+ * Drop a released object from the count of its class
+ *
+ * Do not use this function directly: it is called by PMIX_RELEASE()
+ */
+static inline void pmix_obj_uncount(pmix_object_t *object)
+{
+    if (object->obj_counted) {
+        __atomic_sub_fetch(&object->obj_class->cls_live, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * Return the first of the classes initialized so far - the rest
+ * follow through their cls_next. Classes are only ever added to
+ * the front, so the list can be walked while others are added.
+ */
+PMIX_EXPORT pmix_class_t *pmix_class_list(void);
+
 /**
  * Create new object: dynamically allocate storage and run the class
  * constructor.
@@ -686,7 +736,14 @@ static inline pmix_object_t *pmix_obj_new_tma(pmix_class_t *cls, pmix_tma_t *tma
     pmix_object_t *object;
     assert(cls->cls_sizeof >= sizeof(pmix_object_t));
 
-    object = (pmix_object_t *) pmix_tma_malloc(tma, cls->cls_sizeof);
+    /* objects of a class with its own allocator come from it
+     * unless the caller gave one, but do not carry it - the
+     * allocator only serves the object's storage */
+    if (NULL != tma) {
+        object = (pmix_object_t *) pmix_tma_malloc(tma, cls->cls_sizeof);
+    } else {
+        object = (pmix_object_t *) pmix_tma_malloc(cls->cls_tma, cls->cls_sizeof);
+    }
 
     if (pmix_class_init_epoch != cls->cls_initialized) {
         pmix_class_initialize(cls);
@@ -714,6 +771,12 @@ static inline pmix_object_t *pmix_obj_new_tma(pmix_class_t *cls, pmix_tma_t *tma
 #endif /* PMIX_ENABLE_DEBUG */
         object->obj_class = cls;
         object->obj_reference_count = 1;
+        object->obj_counted = 0;
+        if (pmix_class_accounting) {
+            object->obj_counted = 1;
+            __atomic_add_fetch(&cls->cls_live, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&cls->cls_allocs, 1, __ATOMIC_RELAXED);
+        }
         if (NULL == tma) {
             object->obj_tma.tma_malloc = NULL;
             object->obj_tma.tma_calloc = NULL;
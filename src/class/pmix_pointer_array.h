@@ -26,6 +26,9 @@
  * normally expect size_t.  There's some code that makes sure indices
  * don't go above FORTRAN_HANDLE_MAX (which is min(INT_MAX, fortran
  * INTEGER max)), just to be sure.
+ *
+ * An array constructed with a TMA takes its storage from that
+ * allocator, so it can live in shared memory.
  */
 
 #ifndef PMIX_POINTER_ARRAY_H
@@ -187,6 +190,18 @@ PMIX_EXPORT int pmix_pointer_array_set_size(pmix_pointer_array_t *array, int siz
 PMIX_EXPORT bool pmix_pointer_array_test_and_set_item(pmix_pointer_array_t *table, int index,
                                                       void *value);
 
+/**
+ * Move every pointer the array holds - to its storage and its
+ * items - by delta bytes. For an array built with a TMA whose
+ * region, items included, has since been mapped delta bytes away
+ * from where the array was built. The items themselves are not
+ * touched.
+ *
+ * @param array Pointer to array (IN)
+ * @param delta Distance the region moved by, in bytes (IN)
+ */
+PMIX_EXPORT void pmix_pointer_array_relocate(pmix_pointer_array_t *array, ptrdiff_t delta);
+
 /**
  * Empty the array.
  *
@@ -44,6 +44,7 @@
 #ifdef HAVE_SYS_TYPES_H
 #    include <sys/types.h>
 #endif
+#include <sys/mman.h>
 
 #include <event.h>
 #if !PMIX_HAVE_LIBEV
@@ -66,6 +67,7 @@ static pmix_status_t pmix_init_result = PMIX_ERR_INIT;
 #include "src/class/pmix_list.h"
 #include "src/common/pmix_attributes.h"
 #include "src/common/pmix_iof.h"
+#include "src/common/pmix_modex_shmem.h"
 #include "src/event/pmix_event.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/bfrops/base/base.h"
@@ -82,6 +84,7 @@ static pmix_status_t pmix_init_result = PMIX_ERR_INIT;
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_timings.h"
 
 #include "pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
@@ -144,50 +147,30 @@ cleanup:
     PMIX_RELEASE(chain);
 }
 
-static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
-                                    pmix_buffer_t *buf, void *cbdata)
+/* unpack a single notification and pass it to our handlers */
+static pmix_status_t _notify_unpack(pmix_buffer_t *buf, bool batched)
 {
     pmix_status_t rc;
     int32_t cnt;
-    pmix_cmd_t cmd;
     pmix_event_chain_t *chain;
+    pmix_data_range_t range;
     size_t ninfo;
 
-    pmix_output_verbose(2, pmix_client_globals.event_output,
-                        "%s pmix:client_notify_recv - processing event",
-                        PMIX_NAME_PRINT(&pmix_globals.myid));
-
-    PMIX_HIDE_UNUSED_PARAMS(peer, hdr, cbdata);
-
-    /* a zero-byte buffer indicates that this recv is being
-     * completed due to a lost connection */
-    if (PMIX_BUFFER_IS_EMPTY(buf)) {
-        return;
-    }
-
     /* start the local notification chain */
     chain = PMIX_NEW(pmix_event_chain_t);
     if (NULL == chain) {
-        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
-        return;
+        return PMIX_ERR_NOMEM;
     }
     chain->final_cbfunc = _notify_complete;
     chain->final_cbdata = chain;
 
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &cmd, &cnt, PMIX_COMMAND);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_RELEASE(chain);
-        goto error;
-    }
     /* unpack the status */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &chain->status, &cnt, PMIX_STATUS);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(chain);
-        goto error;
+        return rc;
     }
 
     /* unpack the source of the event */
@@ -196,7 +179,7 @@ static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hd
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(chain);
-        goto error;
+        return rc;
     }
 
     /* unpack the info that might have been provided */
@@ -205,7 +188,7 @@ static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hd
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(chain);
-        goto error;
+        return rc;
     }
 
     /* we always leave space for event hdlr name and a callback object */
@@ -214,7 +197,7 @@ static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hd
     if (NULL == chain->info) {
         PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
         PMIX_RELEASE(chain);
-        return;
+        return PMIX_ERR_NOMEM;
     }
 
     if (0 < ninfo) {
@@ -224,7 +207,18 @@ static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hd
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(chain);
-            goto error;
+            return rc;
+        }
+    }
+    /* the range follows each notification in a batch - it is
+     * only of use to tools, so just step over it */
+    if (batched) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &range, &cnt, PMIX_DATA_RANGE);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(chain);
+            return rc;
         }
     }
     /* prep the chain for processing */
@@ -235,7 +229,57 @@ static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hd
                         PMIX_NAME_PRINT(&pmix_globals.myid), PMIx_Error_string(chain->status));
 
     pmix_invoke_local_event_hdlr(chain);
-    return;
+    return PMIX_SUCCESS;
+}
+
+static void pmix_client_notify_recv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                                    pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_status_t rc;
+    int32_t cnt, nevents, n;
+    pmix_cmd_t cmd;
+    pmix_event_chain_t *chain;
+
+    pmix_output_verbose(2, pmix_client_globals.event_output,
+                        "%s pmix:client_notify_recv - processing event",
+                        PMIX_NAME_PRINT(&pmix_globals.myid));
+
+    PMIX_HIDE_UNUSED_PARAMS(peer, hdr, cbdata);
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection */
+    if (PMIX_BUFFER_IS_EMPTY(buf)) {
+        return;
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &cmd, &cnt, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+
+    /* the server may have delivered several notifications at once */
+    if (PMIX_NOTIFY_BATCH_CMD == cmd) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &nevents, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+        for (n = 0; n < nevents; n++) {
+            rc = _notify_unpack(buf, true);
+            if (PMIX_SUCCESS != rc) {
+                goto error;
+            }
+        }
+        return;
+    }
+
+    rc = _notify_unpack(buf, false);
+    if (PMIX_SUCCESS == rc || PMIX_ERR_NOMEM == rc) {
+        return;
+    }
 
 error:
     /* we always need to return */
@@ -255,7 +299,10 @@ error:
 pmix_client_globals_t pmix_client_globals = {
     .myserver = NULL,
     .singleton = false,
+    .jobinfo_in_ack = false,
+    .jobinfo = NULL,
     .pending_requests = PMIX_LIST_STATIC_INIT,
+    .refresh_epochs = PMIX_LIST_STATIC_INIT,
     .peers = PMIX_POINTER_ARRAY_STATIC_INIT,
     .get_output = -1,
     .get_verbose = 0,
@@ -274,9 +321,48 @@ pmix_client_globals_t pmix_client_globals = {
     .base_output = -1,
     .base_verbose = 0,
     .iof_stdout = PMIX_IOF_SINK_STATIC_INIT,
-    .iof_stderr = PMIX_IOF_SINK_STATIC_INIT
+    .iof_stderr = PMIX_IOF_SINK_STATIC_INIT,
+    .hbeat_base = NULL,
+    .hbeat_size = 0,
+    .hbeat = NULL,
+    .log_batch_max = 32,
+    .log_batch_delay = 5,
+    .commit_delta = true,
+    .commit_sent = false,
+    .commit_keys = NULL,
+    .put_stage = true
 };
 
+/* A client's puts are copied into a staging list in the caller's
+ * thread, and stored in the gds in one pass on the progress thread
+ * when they are needed - at commit, or when we are asked for data -
+ * so the string of puts made at startup does not each cost a
+ * thread shift */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_scope_t scope;
+    char *key;
+    pmix_value_t value;
+} pmix_put_staged_t;
+static void pscon(pmix_put_staged_t *p)
+{
+    p->key = NULL;
+    PMIX_VALUE_CONSTRUCT(&p->value);
+}
+static void psdes(pmix_put_staged_t *p)
+{
+    if (NULL != p->key) {
+        free(p->key);
+    }
+    PMIX_VALUE_DESTRUCT(&p->value);
+}
+static PMIX_CLASS_INSTANCE(pmix_put_staged_t, pmix_list_item_t, pscon, psdes);
+
+static pmix_mutex_t put_lock = PMIX_MUTEX_STATIC_INIT;
+static pmix_list_t put_staged;
+static bool put_stage_ready = false;
+static volatile size_t put_nstaged = 0;
+
 /* callback for wait completion */
 static void wait_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf,
                         void *cbdata)
@@ -333,6 +419,111 @@ static void job_data(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer_t
     PMIX_WAKEUP_THREAD(&cb->lock);
 }
 
+/* state of a job info reply that is processed as it arrives */
+typedef struct {
+    pmix_cb_t *cb;
+    pmix_buffer_t buf;
+    char *nspace;
+    /* number of bytes that must be pending before the entry that
+     * was incomplete last time is tried again */
+    size_t retry;
+    pmix_status_t status;
+} pmix_jobinfo_stream_t;
+
+static pmix_status_t job_data_process(pmix_jobinfo_stream_t *js, bool last)
+{
+    pmix_status_t rc;
+    int32_t cnt = 1;
+    char *start;
+
+    if (NULL == js->nspace) {
+        /* unpack the nspace - should be same as our own */
+        start = js->buf.unpack_ptr;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, &js->buf, &js->nspace, &cnt,
+                           PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            js->nspace = NULL;
+            if (last) {
+                PMIX_ERROR_LOG(rc);
+                return rc;
+            }
+            /* wait for the rest of it */
+            js->buf.unpack_ptr = start;
+            js->retry = 2 * (size_t) (js->buf.pack_ptr - js->buf.unpack_ptr);
+            return PMIX_SUCCESS;
+        }
+        if (!PMIX_CHECK_NSPACE(js->nspace, pmix_globals.myid.nspace)) {
+            PMIX_ERROR_LOG(PMIX_ERR_INVALID_VAL);
+            return PMIX_ERR_INVALID_VAL;
+        }
+    }
+    if (js->buf.unpack_ptr == js->buf.pack_ptr) {
+        /* nothing pending */
+        js->retry = 0;
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_GDS_STREAM_JOB_INFO(rc, pmix_client_globals.myserver, js->nspace, &js->buf, last);
+    /* an entry that is still incomplete is only tried again once
+     * twice as many bytes are pending, so a large one isn't unpacked
+     * over and over as its pieces arrive */
+    js->retry = 2 * (size_t) (js->buf.pack_ptr - js->buf.unpack_ptr);
+    return rc;
+}
+
+/* callback for each piece of the job info as it arrives */
+static void job_data_stream(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, char *data, size_t ndata,
+                            void *cbdata)
+{
+    pmix_jobinfo_stream_t *js = (pmix_jobinfo_stream_t *) cbdata;
+
+    PMIX_HIDE_UNUSED_PARAMS(pr, hdr);
+
+    if (PMIX_SUCCESS != js->status) {
+        /* drop the rest */
+        return;
+    }
+    js->status = pmix_bfrops_base_buffer_feed(&js->buf, data, ndata);
+    if (PMIX_SUCCESS != js->status) {
+        PMIX_ERROR_LOG(js->status);
+        return;
+    }
+    if ((size_t) (js->buf.pack_ptr - js->buf.unpack_ptr) < js->retry) {
+        return;
+    }
+    js->status = job_data_process(js, false);
+}
+
+/* callback once all of the streamed job info has arrived */
+static void job_data_done(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf,
+                          void *cbdata)
+{
+    pmix_jobinfo_stream_t *js = (pmix_jobinfo_stream_t *) cbdata;
+
+    PMIX_HIDE_UNUSED_PARAMS(pr, hdr);
+
+    if (NULL != buf) {
+        /* the recv is being completed due to a lost connection */
+        js->status = PMIX_ERROR;
+    } else if (PMIX_SUCCESS == js->status) {
+        /* whatever is still pending must now be complete */
+        js->status = job_data_process(js, true);
+    }
+    js->cb->status = js->status;
+    PMIX_POST_OBJECT(js->cb);
+    PMIX_WAKEUP_THREAD(&js->cb->lock);
+}
+
+/* process job info that was returned with the connect handshake */
+static void jobinfo_ack(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cb);
+    job_data(pmix_client_globals.myserver, NULL, pmix_client_globals.jobinfo, cb);
+}
+
 PMIX_EXPORT const char *PMIx_Get_version(void)
 {
     return pmix_version_string;
@@ -475,7 +666,7 @@ static void client_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix
     pmix_peer_t *peer = (pmix_peer_t *) pr;
     pmix_proc_t source;
     pmix_iof_channel_t channel;
-    pmix_byte_object_t bo;
+    pmix_byte_object_t bo, raw, *data;
     int32_t cnt;
     pmix_status_t rc;
     size_t refid, ninfo = 0;
@@ -493,6 +684,7 @@ static void client_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix
         return;
     }
     PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&raw);
 
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &source, &cnt, PMIX_PROC);
@@ -527,29 +719,38 @@ static void client_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix
             goto cleanup;
         }
     }
+    /* the output is only needed until it has been delivered */
     cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+    PMIX_BFROPS_UNPACK_VIEW(rc, peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    /* expand the data if the server compressed it */
+    rc = pmix_iof_decompress(&channel, &bo, &raw);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
     }
+    data = (NULL == raw.bytes) ? &bo : &raw;
     /* lookup the handler for this IOF package */
     req = (pmix_iof_req_t *) pmix_pointer_array_get_item(&pmix_globals.iof_requests, refid);
     if (NULL != req && NULL != req->cbfunc) {
-        req->cbfunc(refid, channel, &source, &bo, info, ninfo);
+        req->cbfunc(refid, channel, &source, data, info, ninfo);
     } else {
         /* otherwise, simply write it out to the specified std IO channel */
-        if (NULL != bo.bytes && 0 < bo.size) {
-            pmix_iof_write_output(&source, channel, &bo);
+        if (NULL != data->bytes && 0 < data->size) {
+            pmix_iof_write_output(&source, channel, data);
         }
     }
 
 cleanup:
     /* cleanup the memory */
+    PMIX_BYTE_OBJECT_DESTRUCT(&raw);
     if (0 < ninfo) {
         PMIX_INFO_FREE(info, ninfo);
     }
-    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    PMIX_BFROPS_VIEW_FREE(buf, bo.bytes);
 }
 
 PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_t ninfo)
@@ -557,6 +758,7 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
     char *evar;
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_cb_t cb;
+    pmix_jobinfo_stream_t js;
     pmix_buffer_t *req;
     pmix_cmd_t cmd = PMIX_REQ_CMD;
     pmix_status_t code;
@@ -605,6 +807,7 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
         return pmix_init_result;
     }
     ++pmix_globals.init_cntr;
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_INIT);
 
     /* backward compatibility fix - remove any directive to use
      * the old usock component so we avoid a warning message */
@@ -660,6 +863,9 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.refresh_epochs, pmix_list_t);
+    PMIX_CONSTRUCT(&put_staged, pmix_list_t);
+    put_stage_ready = true;
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
@@ -813,7 +1019,9 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
     PMIX_INFO_DESTRUCT(&ginfo);
 
     /* attempt to connect to a server */
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_CONNECT);
     rc = pmix_ptl.connect_to_peer((struct pmix_peer_t *) pmix_client_globals.myserver, info, ninfo);
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_CONNECT);
     if (PMIX_SUCCESS != rc) {
         /* mark that we couldn't connect to a server */
         pmix_client_globals.singleton = true;
@@ -833,10 +1041,23 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
             PMIX_RELEASE_THREAD(&pmix_global_lock);
             return rc;
         }
+    } else if (NULL != pmix_client_globals.jobinfo) {
+        /* our server returned our job info with the handshake - process
+         * it in the progress thread just as if we had asked for it */
+        pmix_timing_phase_start(PMIX_TIMING_PHASE_JOBINFO);
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        PMIX_THREADSHIFT(&cb, jobinfo_ack);
+        PMIX_WAIT_THREAD(&cb.lock);
+        pmix_timing_phase_stop(PMIX_TIMING_PHASE_JOBINFO);
+        rc = cb.status;
+        PMIX_DESTRUCT(&cb);
+        PMIX_RELEASE(pmix_client_globals.jobinfo);
+        pmix_client_globals.jobinfo = NULL;
     } else {
         /* send a request for our job info - we do this as a non-blocking
          * transaction because some systems cannot handle very large
          * blocking operations and error out if we try them. */
+        pmix_timing_phase_start(PMIX_TIMING_PHASE_JOBINFO);
         req = PMIX_NEW(pmix_buffer_t);
         PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, req, &cmd, 1, PMIX_COMMAND);
         if (PMIX_SUCCESS != rc) {
@@ -848,14 +1069,41 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
         }
         /* send to the server */
         PMIX_CONSTRUCT(&cb, pmix_cb_t);
-        PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, req, job_data, (void *) &cb);
-        if (PMIX_SUCCESS != rc) {
-            pmix_init_result = rc;
-            PMIX_RELEASE_THREAD(&pmix_global_lock);
-            return rc;
+        if (0 < pmix_ptl_base.stream_chunk_size
+            && NULL != pmix_client_globals.myserver->nptr->compat.gds->stream_job_info) {
+            /* store the job info as it arrives instead of waiting for
+             * all of it - for large jobs, this overlaps the transfer
+             * with the processing and only holds a piece at a time */
+            js.cb = &cb;
+            PMIX_CONSTRUCT(&js.buf, pmix_buffer_t);
+            js.buf.type = pmix_client_globals.myserver->nptr->compat.type;
+            js.nspace = NULL;
+            js.retry = 0;
+            js.status = PMIX_SUCCESS;
+            PMIX_PTL_SEND_RECV_STREAM(rc, pmix_client_globals.myserver, req, job_data_stream,
+                                      job_data_done, (void *) &js);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_DESTRUCT(&js.buf);
+                pmix_init_result = rc;
+                PMIX_RELEASE_THREAD(&pmix_global_lock);
+                return rc;
+            }
+            PMIX_WAIT_THREAD(&cb.lock);
+            PMIX_DESTRUCT(&js.buf);
+            if (NULL != js.nspace) {
+                free(js.nspace);
+            }
+        } else {
+            PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, req, job_data, (void *) &cb);
+            if (PMIX_SUCCESS != rc) {
+                pmix_init_result = rc;
+                PMIX_RELEASE_THREAD(&pmix_global_lock);
+                return rc;
+            }
+            /* wait for the data to return */
+            PMIX_WAIT_THREAD(&cb.lock);
         }
-        /* wait for the data to return */
-        PMIX_WAIT_THREAD(&cb.lock);
+        pmix_timing_phase_stop(PMIX_TIMING_PHASE_JOBINFO);
         rc = cb.status;
         PMIX_DESTRUCT(&cb);
     }
@@ -955,6 +1203,7 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
 
     /* register the client supported attrs */
     rc = pmix_register_client_attrs();
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_INIT);
     return rc;
 }
 
@@ -1051,6 +1300,10 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
             }
         }
 
+        /* make sure any log requests being held for
+         * aggregation get to the server first */
+        pmix_log_flush();
+
         /* setup a cmd message to notify the PMIx
          * server that we are normally terminating */
         msg = PMIX_NEW(pmix_buffer_t);
@@ -1104,6 +1357,18 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
     pmix_iof_static_dump_output(&pmix_client_globals.iof_stderr);
 
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.refresh_epochs);
+    put_stage_ready = false;
+    PMIX_LIST_DESTRUCT(&put_staged);
+    pmix_argv_free(pmix_client_globals.commit_keys);
+    pmix_client_globals.commit_keys = NULL;
+    pmix_client_globals.commit_sent = false;
+    pmix_modex_shmem_finalize();
+    if (NULL != pmix_client_globals.hbeat_base) {
+        pmix_client_globals.hbeat = NULL;
+        (void) munmap(pmix_client_globals.hbeat_base, pmix_client_globals.hbeat_size);
+        pmix_client_globals.hbeat_base = NULL;
+    }
     for (i = 0; i < pmix_client_globals.peers.size; i++) {
         if (NULL
             != (peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_client_globals.peers,
@@ -1183,22 +1448,13 @@ PMIX_EXPORT pmix_status_t PMIx_Abort(int flag, const char msg[], pmix_proc_t pro
         PMIX_RELEASE(bfr);
         return rc;
     }
-    /* pack the number of procs */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, bfr, &nprocs, 1, PMIX_SIZE);
+    /* pack any provided procs */
+    rc = pmix_pack_proc_set(pmix_client_globals.myserver, bfr, procs, nprocs);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(bfr);
         return rc;
     }
-    /* pack any provided procs */
-    if (0 < nprocs) {
-        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, bfr, procs, nprocs, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(bfr);
-            return rc;
-        }
-    }
 
     /* send to the server */
     PMIX_CONSTRUCT_LOCK(&reglock);
@@ -1214,36 +1470,21 @@ PMIX_EXPORT pmix_status_t PMIx_Abort(int flag, const char msg[], pmix_proc_t pro
     return PMIX_SUCCESS;
 }
 
-static void _putfn(int sd, short args, void *cbdata)
+static pmix_status_t store_put(pmix_scope_t scope, const char *key, pmix_value_t *val)
 {
-    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
     pmix_status_t rc;
-    pmix_kval_t *kv = NULL;
+    pmix_kval_t *kv;
     uint8_t *tmp;
     size_t len;
 
-    /* need to acquire the cb object from its originating thread */
-    PMIX_ACQUIRE_OBJECT(cb);
-
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-    if (PMIX_CHECK_KEY(cb, PMIX_QUALIFIED_VALUE)) {
-        /* type must be a data array */
-        if (PMIX_DATA_ARRAY != cb->value->type) {
-            rc = PMIX_ERR_BAD_PARAM;
-            goto done;
-        }
-    }
-
     /* setup to xfer the data */
     kv = PMIX_NEW(pmix_kval_t);
-    kv->key = strdup(cb->key); // need to copy as the input belongs to the user
+    kv->key = strdup(key); // need to copy as the input belongs to the user
     kv->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-    if (PMIX_STRING_SIZE_CHECK(cb->value)) {
+    if (PMIX_STRING_SIZE_CHECK(val)) {
         /* compress large strings */
-        if (pmix_compress.compress_string(cb->value->data.string, &tmp, &len)) {
+        if (pmix_compress.compress_string(val->data.string, &tmp, &len)) {
             if (NULL == tmp) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
                 rc = PMIX_ERR_NOMEM;
                 PMIX_ERROR_LOG(rc);
                 goto done;
@@ -1253,10 +1494,10 @@ static void _putfn(int sd, short args, void *cbdata)
             kv->value->data.bo.size = len;
             rc = PMIX_SUCCESS;
         } else {
-            PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, cb->value);
+            PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, val);
         }
     } else {
-        PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, cb->value);
+        PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, val);
     }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
@@ -1264,20 +1505,65 @@ static void _putfn(int sd, short args, void *cbdata)
     }
 
     /* store it */
-    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, cb->scope, kv);
+    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, scope, kv);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
 
     /* mark that fresh values have been stored so we know
-     * to commit them later */
+     * to commit them later - once the server has everything
+     * that was committed before, only the keys put since
+     * need to be sent */
     pmix_globals.commits_pending = true;
+    if (pmix_client_globals.commit_sent) {
+        pmix_argv_append_unique_nosize(&pmix_client_globals.commit_keys, key);
+    }
 
 done:
-    if (NULL != kv) {
-        PMIX_RELEASE(kv); // maintain accounting
+    PMIX_RELEASE(kv); // maintain accounting
+    return rc;
+}
+
+bool pmix_client_put_pending(void)
+{
+    return (0 < put_nstaged);
+}
+
+void pmix_client_put_drain(void)
+{
+    pmix_list_t staged;
+    pmix_put_staged_t *ps;
+
+    if (0 == put_nstaged) {
+        return;
     }
-    cb->pstatus = rc;
+    PMIX_CONSTRUCT(&staged, pmix_list_t);
+    pmix_mutex_lock(&put_lock);
+    pmix_list_join(&staged, pmix_list_get_end(&staged), &put_staged);
+    put_nstaged = 0;
+    pmix_mutex_unlock(&put_lock);
+
+    /* store them in the order they were put, so a later
+     * put of a key replaces an earlier one */
+    PMIX_LIST_FOREACH (ps, &staged, pmix_put_staged_t) {
+        (void) store_put(ps->scope, ps->key, &ps->value);
+    }
+    PMIX_LIST_DESTRUCT(&staged);
+}
+
+static void _putfn(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+
+    /* need to acquire the cb object from its originating thread */
+    PMIX_ACQUIRE_OBJECT(cb);
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    /* keep the puts in order */
+    pmix_client_put_drain();
+    cb->pstatus = store_put(cb->scope, cb->key, cb->value);
+
     /* post the data so the receiving thread can acquire it */
     PMIX_POST_OBJECT(cb);
     PMIX_WAKEUP_THREAD(&cb->lock);
@@ -1288,7 +1574,9 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
                                    pmix_value_t *val)
 {
     pmix_cb_t *cb;
+    pmix_put_staged_t *ps;
     pmix_status_t rc;
+    bool stage;
 
     pmix_output_verbose(2, pmix_client_globals.base_output,
                           "pmix: executing put for key %s type %s",
@@ -1299,11 +1587,36 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
         PMIX_RELEASE_THREAD(&pmix_global_lock);
         return PMIX_ERR_INIT;
     }
+    /* servers and tools store their puts right away */
+    stage = (put_stage_ready && pmix_client_globals.put_stage
+             && !PMIX_PEER_IS_SERVER(pmix_globals.mypeer));
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
     if (NULL == key || PMIX_MAX_KEYLEN < pmix_keylen(key)) {
         return PMIX_ERR_BAD_PARAM;
     }
+    if (0 == strncmp(key, PMIX_QUALIFIED_VALUE, PMIX_MAX_KEYLEN)) {
+        /* type must be a data array */
+        if (PMIX_DATA_ARRAY != val->type) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+
+    if (stage) {
+        ps = PMIX_NEW(pmix_put_staged_t);
+        ps->scope = scope;
+        ps->key = strdup(key);
+        rc = PMIx_Value_xfer(&ps->value, val);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(ps);
+            return rc;
+        }
+        pmix_mutex_lock(&put_lock);
+        pmix_list_append(&put_staged, &ps->super);
+        ++put_nstaged;
+        pmix_mutex_unlock(&put_lock);
+        return PMIX_SUCCESS;
+    }
 
     /* create a callback object */
     cb = PMIX_NEW(pmix_cb_t);
@@ -1322,14 +1635,70 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
     return rc;
 }
 
+/* fetch the values of the given scope - all of them, or only those
+ * of the given keys - and pack them into the commit message. Nothing
+ * is packed if there are none */
+static pmix_status_t pack_commit(pmix_cb_t *cb, pmix_buffer_t *msgout, pmix_scope_t scope,
+                                 bool copy, char **keys)
+{
+    pmix_buffer_t bkt;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    int n;
+
+    cb->proc = &pmix_globals.myid;
+    cb->scope = scope;
+    cb->copy = copy;
+    PMIX_LIST_DESTRUCT(&cb->kvs);
+    PMIX_CONSTRUCT(&cb->kvs, pmix_list_t);
+    if (NULL == keys) {
+        cb->key = NULL;
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        if (PMIX_SUCCESS != rc) {
+            return PMIX_SUCCESS;
+        }
+    } else {
+        /* a key that isn't found was put with another scope */
+        for (n = 0; NULL != keys[n]; n++) {
+            cb->key = keys[n];
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        }
+        cb->key = NULL;
+        if (0 == pmix_list_get_size(&cb->kvs)) {
+            return PMIX_SUCCESS;
+        }
+    }
+
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &scope, 1, PMIX_SCOPE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
+    PMIX_LIST_FOREACH(kv, &cb->kvs, pmix_kval_t) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &bkt, kv, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&bkt);
+            return rc;
+        }
+    }
+    /* now pack the result */
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &bkt, 1, PMIX_BUFFER);
+    PMIX_DESTRUCT(&bkt);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
 static void _commitfn(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
     pmix_status_t rc;
-    pmix_scope_t scope;
-    pmix_buffer_t *msgout, bkt;
+    pmix_buffer_t *msgout;
     pmix_cmd_t cmd = PMIX_COMMIT_CMD;
-    pmix_kval_t *kv;
+    char **keys = NULL;
 
     /* need to acquire the cb object from its originating thread */
     PMIX_ACQUIRE_OBJECT(cb);
@@ -1345,84 +1714,41 @@ static void _commitfn(int sd, short args, void *cbdata)
         goto error;
     }
 
+    /* store whatever was put since we were last here */
+    pmix_client_put_drain();
+
     /* if we haven't already done it, ensure we have committed our values */
     if (pmix_globals.commits_pending) {
-        /* fetch and pack the local values */
-        scope = PMIX_LOCAL;
-        /* allow the GDS module to pass us this info
-         * as a local connection as this data would
-         * only go to another local client */
-        cb->proc = &pmix_globals.myid;
-        cb->scope = scope;
-        cb->copy = false;
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
-        if (PMIX_SUCCESS == rc) {
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &scope, 1, PMIX_SCOPE);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
-            PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
-            PMIX_LIST_FOREACH(kv, &cb->kvs, pmix_kval_t) {
-                PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &bkt, kv, 1, PMIX_KVAL);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&bkt);
-                    PMIX_RELEASE(msgout);
-                    goto error;
-                }
-            }
-            /* now pack the result */
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &bkt, 1, PMIX_BUFFER);
-            PMIX_DESTRUCT(&bkt);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
+        /* the server stores each value it is given over any prior
+         * one of the same key, so once it has all the values we
+         * committed before, we need only send the keys put since */
+        if (pmix_client_globals.commit_delta && pmix_client_globals.commit_sent) {
+            keys = pmix_client_globals.commit_keys;
         }
 
-        /* fetch and pack the remote values */
-        scope = PMIX_REMOTE;
-        /* we need real copies here as this data will
-         * go to remote procs - so a connection will
-         * not suffice */
-        cb->proc = &pmix_globals.myid;
-        cb->scope = scope;
-        cb->copy = true;
-        PMIX_LIST_DESTRUCT(&cb->kvs);
-        PMIX_CONSTRUCT(&cb->kvs, pmix_list_t);
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
-        if (PMIX_SUCCESS == rc) {
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &scope, 1, PMIX_SCOPE);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
-            PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
-            PMIX_LIST_FOREACH(kv, &cb->kvs, pmix_kval_t) {
-                PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &bkt, kv, 1, PMIX_KVAL);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&bkt);
-                    PMIX_RELEASE(msgout);
-                    goto error;
-                }
-            }
-            /* now pack the result */
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &bkt, 1, PMIX_BUFFER);
-            PMIX_DESTRUCT(&bkt);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
+        /* fetch and pack the local values - allow the GDS
+         * module to pass us this info as a local connection
+         * as this data would only go to another local client */
+        rc = pack_commit(cb, msgout, PMIX_LOCAL, false, keys);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(msgout);
+            goto error;
+        }
+
+        /* fetch and pack the remote values - we need real
+         * copies here as this data will go to remote procs
+         * so a connection will not suffice */
+        rc = pack_commit(cb, msgout, PMIX_REMOTE, true, keys);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(msgout);
+            goto error;
         }
 
         /* record that all committed data to-date has been sent */
         pmix_globals.commits_pending = false;
+        pmix_argv_free(pmix_client_globals.commit_keys);
+        pmix_client_globals.commit_keys = NULL;
+        pmix_client_globals.commit_sent = pmix_client_globals.commit_delta;
     }
 
     /* always send, even if we have nothing to contribute, so the server knows
@@ -1483,6 +1809,144 @@ PMIX_EXPORT pmix_status_t PMIx_Commit(void)
     return rc;
 }
 
+static pmix_namespace_t *resolve_find_nspace(const char *nspace)
+{
+    pmix_namespace_t *ns;
+
+    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (PMIX_CHECK_NSPACE(ns->nspace, nspace)) {
+            return ns;
+        }
+    }
+    return NULL;
+}
+
+static inline bool resolve_same_host(const char *a, const char *b)
+{
+    if (NULL == a || NULL == b) {
+        return (a == b);
+    }
+    return (0 == strcmp(a, b));
+}
+
+/* load a copy of the cached local peers of the given node, if
+ * we have them. Must be called with the nspace resolve_lock held */
+static bool resolve_cached_peers(pmix_namespace_t *ns, const char *nodename,
+                                 pmix_proc_t **procs, size_t *nprocs)
+{
+    pmix_resolved_peers_t *rp;
+    size_t n;
+
+    PMIX_LIST_FOREACH (rp, &ns->resolved_peers, pmix_resolved_peers_t) {
+        if (resolve_same_host(rp->hostname, nodename)) {
+            PMIX_PROC_CREATE(*procs, rp->nranks);
+            for (n = 0; n < rp->nranks; n++) {
+                PMIX_LOAD_NSPACE((*procs)[n].nspace, ns->nspace);
+                (*procs)[n].rank = rp->ranks[n];
+            }
+            *nprocs = rp->nranks;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* get the local peers of the given nspace on the given node,
+ * consulting the nspace cache first so that repeated calls
+ * need neither a PMIx_Get nor a string split */
+static pmix_status_t resolve_peers_of(pmix_namespace_t *ns, const char *nspace,
+                                      const char *nodename, pmix_proc_t *proc,
+                                      pmix_info_t *iptr, size_t ninfo,
+                                      pmix_proc_t **procs, size_t *nprocs)
+{
+    pmix_resolved_peers_t *rp;
+    pmix_value_t *val;
+    pmix_proc_t *pa;
+    pmix_status_t rc;
+    char **p;
+    size_t n, np;
+
+    *procs = NULL;
+    *nprocs = 0;
+
+    if (NULL != ns) {
+        pmix_mutex_lock(&ns->resolve_lock);
+        if (resolve_cached_peers(ns, nodename, procs, nprocs)) {
+            pmix_mutex_unlock(&ns->resolve_lock);
+            return PMIX_SUCCESS;
+        }
+        pmix_mutex_unlock(&ns->resolve_lock);
+    }
+
+    PMIX_LOAD_NSPACE(proc->nspace, nspace);
+    rc = PMIx_Get(proc, PMIX_LOCAL_PEERS, iptr, ninfo, &val);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* sanity check */
+    if (NULL == val) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (PMIX_STRING != val->type || NULL == val->data.string) {
+        PMIX_VALUE_FREE(val, 1);
+        return PMIX_ERR_INVALID_VAL;
+    }
+
+    /* split the procs to get a list */
+    p = pmix_argv_split(val->data.string, ',');
+    np = pmix_argv_count(p);
+    PMIX_VALUE_FREE(val, 1);
+
+    /* allocate the proc array */
+    PMIX_PROC_CREATE(pa, np);
+    if (NULL == pa && 0 < np) {
+        pmix_argv_free(p);
+        return PMIX_ERR_NOMEM;
+    }
+    /* transfer the results */
+    for (n = 0; n < np; n++) {
+        PMIX_LOAD_NSPACE(&pa[n].nspace, nspace);
+        pa[n].rank = strtoul(p[n], NULL, 10);
+    }
+    pmix_argv_free(p);
+    *procs = pa;
+    *nprocs = np;
+
+    if (NULL == ns) {
+        return PMIX_SUCCESS;
+    }
+    /* cache the ranks - another thread may have beaten us to it */
+    pmix_mutex_lock(&ns->resolve_lock);
+    PMIX_LIST_FOREACH (rp, &ns->resolved_peers, pmix_resolved_peers_t) {
+        if (resolve_same_host(rp->hostname, nodename)) {
+            pmix_mutex_unlock(&ns->resolve_lock);
+            return PMIX_SUCCESS;
+        }
+    }
+    rp = PMIX_NEW(pmix_resolved_peers_t);
+    if (NULL != nodename) {
+        rp->hostname = strdup(nodename);
+    }
+    if (0 < np) {
+        rp->ranks = (pmix_rank_t *) malloc(np * sizeof(pmix_rank_t));
+        if (NULL == rp->ranks) {
+            /* just don't cache it */
+            PMIX_RELEASE(rp);
+            pmix_mutex_unlock(&ns->resolve_lock);
+            return PMIX_SUCCESS;
+        }
+        for (n = 0; n < np; n++) {
+            rp->ranks[n] = pa[n].rank;
+        }
+    }
+    rp->nranks = np;
+    pmix_list_append(&ns->resolved_peers, &rp->super);
+    pmix_mutex_unlock(&ns->resolve_lock);
+
+    return PMIX_SUCCESS;
+}
+
 /* need to thread-shift this request */
 PMIX_EXPORT pmix_status_t PMIx_Resolve_peers(const char *nodename, const pmix_nspace_t nspace,
                                              pmix_proc_t **procs, size_t *nprocs)
@@ -1490,10 +1954,8 @@ PMIX_EXPORT pmix_status_t PMIx_Resolve_peers(const char *nodename, const pmix_ns
     pmix_info_t info[2], *iptr;
     pmix_status_t rc;
     pmix_proc_t proc;
-    pmix_value_t *val;
-    char **p, **tmp = NULL, *prs;
-    pmix_proc_t *pa;
-    size_t m, n, np, ninfo;
+    pmix_proc_t *pa, *pp;
+    size_t np, ninfo;
     pmix_namespace_t *ns;
 
     /* set default response */
@@ -1525,139 +1987,109 @@ PMIX_EXPORT pmix_status_t PMIx_Resolve_peers(const char *nodename, const pmix_ns
 
     if (NULL == nspace || 0 == pmix_nslen(nspace)) {
         rc = PMIX_ERR_NOT_FOUND;
-        np = 0;
         /* cycle across all known nspaces and aggregate the results */
         PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-            PMIX_LOAD_NSPACE(proc.nspace, ns->nspace);
-            rc = PMIx_Get(&proc, PMIX_LOCAL_PEERS, iptr, ninfo, &val);
+            rc = resolve_peers_of(ns, ns->nspace, nodename, &proc, iptr, ninfo, &pa, &np);
             if (PMIX_SUCCESS != rc) {
                 continue;
             }
-
-            /* sanity check */
-            if (NULL == val) {
-                rc = PMIX_ERR_NOT_FOUND;
-                continue;
-            }
-            if (PMIX_STRING != val->type) {
-                rc = PMIX_ERR_INVALID_VAL;
-                PMIX_VALUE_FREE(val, 1);
-                continue;
-            }
-            if (NULL == val->data.string) {
+            if (0 == np) {
                 /* no local peers on this node */
-                PMIX_VALUE_FREE(val, 1);
-                continue;
-            }
-            /* prepend the nspace */
-            if (0 > asprintf(&prs, "%s:%s", ns->nspace, val->data.string)) {
-                PMIX_VALUE_FREE(val, 1);
                 continue;
             }
-            /* add to our list of results */
-            pmix_argv_append_nosize(&tmp, prs);
-            /* split to count the npeers */
-            p = pmix_argv_split(val->data.string, ',');
-            np += pmix_argv_count(p);
-            /* done with this entry */
-            pmix_argv_free(p);
-            free(prs);
-            PMIX_VALUE_FREE(val, 1);
-        }
-        if (0 < np) {
-            /* allocate the proc array */
-            PMIX_PROC_CREATE(pa, np);
-            if (NULL == pa) {
+            /* add to our results */
+            PMIX_PROC_CREATE(pp, *nprocs + np);
+            if (NULL == pp) {
+                PMIX_PROC_FREE(pa, np);
+                PMIX_PROC_FREE(*procs, *nprocs);
+                *nprocs = 0;
                 rc = PMIX_ERR_NOMEM;
-                pmix_argv_free(tmp);
                 goto done;
             }
-            *procs = pa;
-            *nprocs = np;
-            /* transfer the results */
-            np = 0;
-            for (n = 0; NULL != tmp[n]; n++) {
-                /* find the nspace delimiter */
-                prs = strchr(tmp[n], ':');
-                if (NULL == prs) {
-                    /* should never happen, but silence a Coverity warning */
-                    rc = PMIX_ERR_BAD_PARAM;
-                    pmix_argv_free(tmp);
-                    PMIX_PROC_FREE(pa, np);
-                    *procs = NULL;
-                    *nprocs = 0;
-                    goto done;
-                }
-                *prs = '\0';
-                ++prs;
-                p = pmix_argv_split(prs, ',');
-                for (m = 0; NULL != p[m]; m++) {
-                    PMIX_LOAD_NSPACE(&pa[np].nspace, tmp[n]);
-                    pa[np].rank = strtoul(p[m], NULL, 10);
-                    ++np;
-                }
-                pmix_argv_free(p);
+            if (NULL != *procs) {
+                memcpy(pp, *procs, *nprocs * sizeof(pmix_proc_t));
+                PMIX_PROC_FREE(*procs, *nprocs);
             }
-            pmix_argv_free(tmp);
+            memcpy(&pp[*nprocs], pa, np * sizeof(pmix_proc_t));
+            PMIX_PROC_FREE(pa, np);
+            *procs = pp;
+            *nprocs += np;
+        }
+        if (0 < *nprocs) {
             rc = PMIX_SUCCESS;
         }
         goto done;
     }
 
     /* get the list of local peers for this nspace and node */
-    PMIX_LOAD_NSPACE(proc.nspace, nspace);
+    rc = resolve_peers_of(resolve_find_nspace(nspace), nspace, nodename,
+                          &proc, iptr, ninfo, procs, nprocs);
+
+done:
+    if (NULL != iptr) {
+        PMIX_INFO_DESTRUCT(&info[0]);
+        PMIX_INFO_DESTRUCT(&info[1]);
+    }
+    return rc;
+}
+
+/* get the node list of the given nspace, consulting the
+ * nspace cache first */
+static pmix_status_t resolve_nodes_of(pmix_namespace_t *ns, const char *nspace,
+                                      char **nodelist)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_value_t *val;
+
+    *nodelist = NULL;
 
-    rc = PMIx_Get(&proc, PMIX_LOCAL_PEERS, iptr, ninfo, &val);
+    if (NULL != ns) {
+        pmix_mutex_lock(&ns->resolve_lock);
+        if (NULL != ns->resolved_nodes) {
+            *nodelist = strdup(ns->resolved_nodes);
+            pmix_mutex_unlock(&ns->resolve_lock);
+            return (NULL == *nodelist) ? PMIX_ERR_NOMEM : PMIX_SUCCESS;
+        }
+        pmix_mutex_unlock(&ns->resolve_lock);
+    }
+
+    PMIX_LOAD_PROCID(&proc, nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Get(&proc, PMIX_NODE_LIST, NULL, 0, &val);
     if (PMIX_SUCCESS != rc) {
-        goto done;
+        return rc;
     }
 
     /* sanity check */
     if (NULL == val) {
-        rc = PMIX_ERR_NOT_FOUND;
-        goto done;
+        return PMIX_ERR_NOT_FOUND;
     }
     if (PMIX_STRING != val->type || NULL == val->data.string) {
-        rc = PMIX_ERR_INVALID_VAL;
         PMIX_VALUE_FREE(val, 1);
-        goto done;
+        return PMIX_ERR_INVALID_VAL;
     }
 
-    /* split the procs to get a list */
-    p = pmix_argv_split(val->data.string, ',');
-    np = pmix_argv_count(p);
-    PMIX_VALUE_FREE(val, 1);
+    /* pass back the result */
+    *nodelist = strdup(val->data.string);
 
-    /* allocate the proc array */
-    PMIX_PROC_CREATE(pa, np);
-    if (NULL == pa) {
-        rc = PMIX_ERR_NOMEM;
-        pmix_argv_free(p);
-        goto done;
-    }
-    /* transfer the results */
-    for (n = 0; n < np; n++) {
-        PMIX_LOAD_NSPACE(&pa[n].nspace, nspace);
-        pa[n].rank = strtoul(p[n], NULL, 10);
+    if (NULL != ns) {
+        pmix_mutex_lock(&ns->resolve_lock);
+        if (NULL == ns->resolved_nodes) {
+            /* take the string from the value */
+            ns->resolved_nodes = val->data.string;
+            val->data.string = NULL;
+        }
+        pmix_mutex_unlock(&ns->resolve_lock);
     }
-    pmix_argv_free(p);
-    *procs = pa;
-    *nprocs = np;
+    PMIX_VALUE_FREE(val, 1);
 
-done:
-    if (NULL != iptr) {
-        PMIX_INFO_DESTRUCT(&info[0]);
-        PMIX_INFO_DESTRUCT(&info[1]);
-    }
-    return rc;
+    return PMIX_SUCCESS;
 }
 
 PMIX_EXPORT pmix_status_t PMIx_Resolve_nodes(const pmix_nspace_t nspace, char **nodelist)
 {
     pmix_status_t rc;
-    pmix_proc_t proc;
-    pmix_value_t *val;
-    char **tmp = NULL, **p;
+    char **tmp = NULL, **p, *nodes;
     size_t n;
     pmix_namespace_t *ns;
 
@@ -1671,41 +2103,21 @@ PMIX_EXPORT pmix_status_t PMIx_Resolve_nodes(const pmix_nspace_t nspace, char **
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
-    /* get the list of nodes for this nspace */
-    proc.rank = PMIX_RANK_WILDCARD;
-
     if (NULL == nspace || 0 == pmix_nslen(nspace)) {
         rc = PMIX_ERR_NOT_FOUND;
         /* cycle across all known nspaces and aggregate the results */
         PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-            PMIX_LOAD_NSPACE(proc.nspace, ns->nspace);
-            rc = PMIx_Get(&proc, PMIX_NODE_LIST, NULL, 0, &val);
+            rc = resolve_nodes_of(ns, ns->nspace, &nodes);
             if (PMIX_SUCCESS != rc) {
                 continue;
             }
-
-            /* sanity check */
-            if (NULL == val) {
-                rc = PMIX_ERR_NOT_FOUND;
-                continue;
-            }
-            if (PMIX_STRING != val->type) {
-                rc = PMIX_ERR_INVALID_VAL;
-                PMIX_VALUE_FREE(val, 1);
-                continue;
-            }
-            if (NULL == val->data.string) {
-                /* no nodes found */
-                PMIX_VALUE_FREE(val, 1);
-                continue;
-            }
             /* add to our list of results, ensuring uniqueness */
-            p = pmix_argv_split(val->data.string, ',');
+            p = pmix_argv_split(nodes, ',');
             for (n = 0; NULL != p[n]; n++) {
                 pmix_argv_append_unique_nosize(&tmp, p[n]);
             }
             pmix_argv_free(p);
-            PMIX_VALUE_FREE(val, 1);
+            free(nodes);
         }
         if (0 < pmix_argv_count(tmp)) {
             *nodelist = pmix_argv_join(tmp, ',');
@@ -1715,24 +2127,5 @@ PMIX_EXPORT pmix_status_t PMIx_Resolve_nodes(const pmix_nspace_t nspace, char **
         return rc;
     }
 
-    PMIX_LOAD_NSPACE(proc.nspace, nspace);
-    rc = PMIx_Get(&proc, PMIX_NODE_LIST, NULL, 0, &val);
-    if (PMIX_SUCCESS != rc) {
-        return rc;
-    }
-
-    /* sanity check */
-    if (NULL == val) {
-        return PMIX_ERR_NOT_FOUND;
-    }
-    if (PMIX_STRING != val->type || NULL == val->data.string) {
-        PMIX_VALUE_FREE(val, 1);
-        return PMIX_ERR_INVALID_VAL;
-    }
-
-    /* pass back the result */
-    *nodelist = strdup(val->data.string);
-    PMIX_VALUE_FREE(val, 1);
-
-    return PMIX_SUCCESS;
+    return resolve_nodes_of(resolve_find_nspace(nspace), nspace, nodelist);
 }
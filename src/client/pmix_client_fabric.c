@@ -54,6 +54,66 @@
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_environ.h"
 
+/* apply the info returned by the server to the fabric - either
+ * all of it, or only the entries that changed since the revision
+ * we held */
+static void apply_fabric_info(pmix_fabric_t *fabric, pmix_info_t *info, size_t ninfo)
+{
+    pmix_info_t *tmp;
+    size_t n, m, cnt;
+    bool delta = false;
+    pmix_status_t rc;
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_DELTA)) {
+            delta = PMIX_INFO_TRUE(&info[n]);
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_INDEX)) {
+            PMIX_VALUE_GET_NUMBER(rc, &info[n].value, fabric->index, size_t);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+        }
+    }
+
+    if (!delta) {
+        if (NULL != fabric->info) {
+            PMIX_INFO_FREE(fabric->info, fabric->ninfo);
+        }
+        fabric->info = info;
+        fabric->ninfo = ninfo;
+        return;
+    }
+
+    /* merge the changes - each replaces the entry with the same key,
+     * is added if there is none, or removes it if undefined */
+    PMIX_INFO_CREATE(tmp, fabric->ninfo + ninfo);
+    cnt = 0;
+    for (m = 0; m < fabric->ninfo; m++) {
+        for (n = 0; n < ninfo; n++) {
+            if (PMIX_CHECK_KEY(&info[n], fabric->info[m].key)) {
+                break;
+            }
+        }
+        if (n == ninfo) {
+            PMIX_INFO_XFER(&tmp[cnt], &fabric->info[m]);
+            ++cnt;
+        }
+    }
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_UNDEF == info[n].value.type || PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_DELTA)) {
+            continue;
+        }
+        PMIX_INFO_XFER(&tmp[cnt], &info[n]);
+        ++cnt;
+    }
+    if (NULL != fabric->info) {
+        PMIX_INFO_FREE(fabric->info, fabric->ninfo);
+    }
+    PMIX_INFO_FREE(info, ninfo);
+    fabric->info = tmp;
+    fabric->ninfo = cnt;
+}
+
 static void fcb(pmix_status_t status, pmix_info_t *info, size_t ninfo, void *cbdata,
                 pmix_release_cbfunc_t release_fn, void *release_cbdata)
 {
@@ -84,6 +144,8 @@ static void frecv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
     pmix_status_t rc;
+    pmix_info_t *info = NULL;
+    size_t ninfo = 0;
     int cnt;
 
     PMIX_HIDE_UNUSED_PARAMS(hdr);
@@ -111,20 +173,23 @@ static void frecv(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *
 
     /* unpack any returned data */
     cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, peer, buf, &cb->fabric->ninfo, &cnt, PMIX_SIZE);
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &ninfo, &cnt, PMIX_SIZE);
     if (PMIX_SUCCESS != rc && PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         PMIX_ERROR_LOG(rc);
         goto complete;
     }
-    if (0 < cb->fabric->ninfo) {
-        PMIX_INFO_CREATE(cb->fabric->info, cb->fabric->ninfo);
-        cnt = cb->fabric->ninfo;
-        PMIX_BFROPS_UNPACK(rc, peer, buf, cb->fabric->info, &cnt, PMIX_INFO);
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(info, ninfo);
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, info, &cnt, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            PMIX_INFO_FREE(info, ninfo);
             goto complete;
         }
+        apply_fabric_info(cb->fabric, info, ninfo);
     }
+    rc = PMIX_SUCCESS;
 
 complete:
     pmix_output_verbose(2, pmix_globals.debug_output, "pmix:fabric recv from server releasing");
@@ -332,6 +397,8 @@ PMIX_EXPORT pmix_status_t PMIx_Fabric_update_nb(pmix_fabric_t *fabric, pmix_op_c
     pmix_status_t rc;
     pmix_buffer_t *msg;
     pmix_cmd_t cmd = PMIX_FABRIC_UPDATE_CMD;
+    uint64_t revision;
+    size_t n;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -394,6 +461,23 @@ PMIX_EXPORT pmix_status_t PMIx_Fabric_update_nb(pmix_fabric_t *fabric, pmix_op_c
         PMIX_RELEASE(msg);
         return rc;
     }
+    /* pack the revision we hold so the server can just send the
+     * changes since - servers that don't track revisions ignore it */
+    for (n = 0; n < fabric->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&fabric->info[n], PMIX_FABRIC_REVISION)) {
+            PMIX_VALUE_GET_NUMBER(rc, &fabric->info[n].value, revision, uint64_t);
+            if (PMIX_SUCCESS == rc) {
+                PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &revision, 1,
+                                 PMIX_UINT64);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_RELEASE(msg);
+                    return rc;
+                }
+            }
+            break;
+        }
+    }
 
     /* create a callback object as we need to pass it to the
      * recv routine so we know which callback to use when
@@ -457,3 +541,239 @@ PMIX_EXPORT pmix_status_t PMIx_Fabric_deregister_nb(pmix_fabric_t *fabric, pmix_
 
     return PMIX_OPERATION_SUCCEEDED;
 }
+
+/* cost models - a hierarchical model holds the switch and group of
+ * each device, a torus the coordinates of each device, so either
+ * grows linearly with the number of devices */
+typedef enum {
+    PMIX_FABRIC_COST_DENSE,
+    PMIX_FABRIC_COST_HIER,
+    PMIX_FABRIC_COST_TORUS
+} pmix_fabric_cost_type_t;
+
+struct pmix_fabric_cost_model_s {
+    pmix_fabric_cost_type_t type;
+    uint32_t ndevices;
+    /* dense - referenced from the fabric */
+    uint16_t **matrix;
+    /* hierarchical */
+    uint32_t *switches;
+    uint32_t *groups;
+    uint16_t levels[4];
+    /* torus */
+    uint32_t ndims;
+    uint32_t *shape;
+    uint32_t *coords;
+    uint16_t hop;
+    bool wrap;
+};
+
+static pmix_status_t copy_u32(const pmix_value_t *val, uint32_t **array, size_t *n)
+{
+    pmix_data_array_t *darray;
+
+    if (PMIX_DATA_ARRAY != val->type || NULL == val->data.darray
+        || PMIX_UINT32 != val->data.darray->type || 0 == val->data.darray->size) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    darray = val->data.darray;
+    *array = (uint32_t *) malloc(darray->size * sizeof(uint32_t));
+    if (NULL == *array) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(*array, darray->array, darray->size * sizeof(uint32_t));
+    *n = darray->size;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t load_cost_model(pmix_fabric_cost_model_t *model, const pmix_value_t *val)
+{
+    pmix_info_t *info;
+    pmix_data_array_t *darray;
+    size_t n, ninfo, nswitches = 0, ngroups = 0, nshape = 0, ncoords = 0, nlevels = 0;
+    char *type = NULL;
+    uint16_t *levels = NULL;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (PMIX_DATA_ARRAY != val->type || NULL == val->data.darray
+        || PMIX_INFO != val->data.darray->type) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    info = (pmix_info_t *) val->data.darray->array;
+    ninfo = val->data.darray->size;
+    model->wrap = true;
+
+    for (n = 0; n < ninfo && PMIX_SUCCESS == rc; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_TYPE)) {
+            if (PMIX_STRING != info[n].value.type) {
+                rc = PMIX_ERR_BAD_PARAM;
+            }
+            type = info[n].value.data.string;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_SWITCHES)) {
+            rc = copy_u32(&info[n].value, &model->switches, &nswitches);
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_GROUPS)) {
+            rc = copy_u32(&info[n].value, &model->groups, &ngroups);
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_SHAPE)) {
+            rc = copy_u32(&info[n].value, &model->shape, &nshape);
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_COORDS)) {
+            rc = copy_u32(&info[n].value, &model->coords, &ncoords);
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_LEVELS)) {
+            darray = info[n].value.data.darray;
+            if (PMIX_DATA_ARRAY != info[n].value.type || NULL == darray
+                || PMIX_UINT16 != darray->type) {
+                rc = PMIX_ERR_BAD_PARAM;
+            } else {
+                levels = (uint16_t *) darray->array;
+                nlevels = darray->size;
+            }
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_HOP)) {
+            PMIX_VALUE_GET_NUMBER(rc, &info[n].value, model->hop, uint16_t);
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_FABRIC_COST_WRAP)) {
+            model->wrap = PMIX_INFO_TRUE(&info[n]);
+        }
+    }
+    if (PMIX_SUCCESS != rc || NULL == type) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    if (0 == strcmp(type, "hierarchical")) {
+        /* every device needs a switch and a group, and
+         * there is a cost for each level */
+        if (0 == nswitches || nswitches != ngroups || 4 != nlevels || UINT32_MAX < nswitches) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+        model->type = PMIX_FABRIC_COST_HIER;
+        model->ndevices = (uint32_t) nswitches;
+        memcpy(model->levels, levels, 4 * sizeof(uint16_t));
+        return PMIX_SUCCESS;
+    }
+
+    if (0 == strcmp(type, "torus")) {
+        if (0 == nshape || 0 != ncoords % nshape || 2 != nlevels
+            || UINT32_MAX < ncoords / nshape) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+        for (n = 0; n < ncoords; n++) {
+            if (model->coords[n] >= model->shape[n % nshape]) {
+                return PMIX_ERR_BAD_PARAM;
+            }
+        }
+        model->type = PMIX_FABRIC_COST_TORUS;
+        model->ndims = (uint32_t) nshape;
+        model->ndevices = (uint32_t) (ncoords / nshape);
+        memcpy(model->levels, levels, 2 * sizeof(uint16_t));
+        return PMIX_SUCCESS;
+    }
+
+    return PMIX_ERR_BAD_PARAM;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Fabric_cost_model(const pmix_fabric_t *fabric,
+                                                 pmix_fabric_cost_model_t **model)
+{
+    pmix_fabric_cost_model_t *mdl;
+    const pmix_value_t *cmodel = NULL;
+    uint16_t **matrix = NULL;
+    size_t n, ndevices = 0;
+    pmix_status_t rc;
+
+    if (NULL == fabric || NULL == model) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *model = NULL;
+
+    for (n = 0; n < fabric->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&fabric->info[n], PMIX_FABRIC_COST_MODEL)) {
+            cmodel = &fabric->info[n].value;
+        } else if (PMIX_CHECK_KEY(&fabric->info[n], PMIX_FABRIC_COST_MATRIX)
+                   && PMIX_POINTER == fabric->info[n].value.type) {
+            matrix = (uint16_t **) fabric->info[n].value.data.ptr;
+        } else if (PMIX_CHECK_KEY(&fabric->info[n], PMIX_FABRIC_NUM_DEVICES)) {
+            PMIX_VALUE_GET_NUMBER(rc, &fabric->info[n].value, ndevices, size_t);
+            if (PMIX_SUCCESS != rc) {
+                ndevices = 0;
+            }
+        }
+    }
+    if (NULL == cmodel && (NULL == matrix || 0 == ndevices)) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+
+    mdl = (pmix_fabric_cost_model_t *) calloc(1, sizeof(pmix_fabric_cost_model_t));
+    if (NULL == mdl) {
+        return PMIX_ERR_NOMEM;
+    }
+    if (NULL != cmodel) {
+        rc = load_cost_model(mdl, cmodel);
+        if (PMIX_SUCCESS != rc) {
+            PMIx_Fabric_cost_model_free(mdl);
+            return rc;
+        }
+    } else {
+        if (UINT32_MAX < ndevices) {
+            free(mdl);
+            return PMIX_ERR_BAD_PARAM;
+        }
+        mdl->type = PMIX_FABRIC_COST_DENSE;
+        mdl->matrix = matrix;
+        mdl->ndevices = (uint32_t) ndevices;
+    }
+    *model = mdl;
+    return PMIX_SUCCESS;
+}
+
+PMIX_EXPORT uint16_t PMIx_Fabric_cost(const pmix_fabric_cost_model_t *model,
+                                      uint32_t src, uint32_t dst)
+{
+    const uint32_t *a, *b;
+    uint32_t d, n;
+    uint64_t hops = 0, cost;
+
+    if (NULL == model || src >= model->ndevices || dst >= model->ndevices) {
+        return UINT16_MAX;
+    }
+
+    switch (model->type) {
+    case PMIX_FABRIC_COST_DENSE:
+        return model->matrix[src][dst];
+    case PMIX_FABRIC_COST_HIER:
+        if (src == dst) {
+            return model->levels[0];
+        }
+        if (model->groups[src] != model->groups[dst]) {
+            return model->levels[3];
+        }
+        if (model->switches[src] != model->switches[dst]) {
+            return model->levels[2];
+        }
+        return model->levels[1];
+    default:
+        if (src == dst) {
+            return model->levels[0];
+        }
+        a = &model->coords[(size_t) src * model->ndims];
+        b = &model->coords[(size_t) dst * model->ndims];
+        for (n = 0; n < model->ndims; n++) {
+            d = (a[n] > b[n]) ? a[n] - b[n] : b[n] - a[n];
+            if (model->wrap && model->shape[n] - d < d) {
+                d = model->shape[n] - d;
+            }
+            hops += d;
+        }
+        /* saturate below the out-of-range marker */
+        cost = model->levels[1] + hops * model->hop;
+        return (cost < UINT16_MAX) ? (uint16_t) cost : UINT16_MAX - 1;
+    }
+}
+
+PMIX_EXPORT void PMIx_Fabric_cost_model_free(pmix_fabric_cost_model_t *model)
+{
+    if (NULL == model) {
+        return;
+    }
+    free(model->switches);
+    free(model->groups);
+    free(model->shape);
+    free(model->coords);
+    free(model);
+}
@@ -46,11 +46,13 @@
 #include <event.h>
 
 #include "src/class/pmix_list.h"
+#include "src/common/pmix_modex_shmem.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/ptl/ptl.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_timings.h"
 
 #include "pmix_client_ops.h"
 
@@ -96,7 +98,9 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
     cb = PMIX_NEW(pmix_cb_t);
 
     /* push the message into our event base to send to the server */
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_FENCE);
     if (PMIX_SUCCESS != (rc = PMIx_Fence_nb(procs, nprocs, info, ninfo, op_cbfunc, cb))) {
+        pmix_timing_phase_stop(PMIX_TIMING_PHASE_FENCE);
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(cb);
         return rc;
@@ -104,6 +108,7 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
 
     /* wait for the fence to complete */
     PMIX_WAIT_THREAD(&cb->lock);
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_FENCE);
     rc = cb->status;
     PMIX_RELEASE(cb);
 
@@ -184,6 +189,7 @@ static pmix_status_t unpack_return(pmix_buffer_t *data)
     pmix_status_t rc;
     pmix_status_t ret;
     int32_t cnt;
+    char *path = NULL;
 
     pmix_output_verbose(2, pmix_client_globals.fence_output,
                         "client:unpack fence called");
@@ -197,6 +203,24 @@ static pmix_status_t unpack_return(pmix_buffer_t *data)
     }
     pmix_output_verbose(2, pmix_client_globals.fence_output,
                         "client:unpack fence received status %d", ret);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+
+    /* the server may have published the collected data in
+     * shared memory for us - older servers won't send this */
+    if (data->unpack_ptr < data->base_ptr + data->bytes_used) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, data, &path, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS == rc && NULL != path) {
+            rc = pmix_modex_shmem_attach(path);
+            /* we can always ask the server for the data */
+            pmix_output_verbose(2, pmix_client_globals.fence_output,
+                                "client:unpack fence modex segment %s: %s",
+                                path, PMIx_Error_string(rc));
+            free(path);
+        }
+    }
     return ret;
 }
 
@@ -47,7 +47,9 @@
 #include <event.h>
 
 #include "src/class/pmix_list.h"
+#include "src/common/pmix_modex_shmem.h"
 #include "src/mca/bfrops/bfrops.h"
+#include "src/mca/gds/base/base.h"
 #include "src/mca/gds/gds.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/mca/ptl/base/base.h"
@@ -56,6 +58,7 @@
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_timings.h"
 
 #include "pmix_client_ops.h"
 
@@ -72,7 +75,65 @@ static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata);
 
 static pmix_status_t process_values(pmix_cb_t *cb);
 
-static pmix_status_t refresh_cache(void);
+static pmix_status_t refresh_cache(const pmix_proc_t *proc);
+
+/* a request for data that has to come from the server */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_buffer_t *msg;
+    pmix_cb_t *cb;
+} pmix_get_req_t;
+static void grcon(pmix_get_req_t *p)
+{
+    p->msg = NULL;
+    p->cb = NULL;
+}
+static void grdes(pmix_get_req_t *p)
+{
+    if (NULL != p->msg) {
+        PMIX_RELEASE(p->msg);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_req_t, pmix_list_item_t, grcon, grdes);
+
+/* tracks a PMIx_Get_multi operation */
+struct pmix_get_batch_t;
+typedef struct {
+    struct pmix_get_batch_t *bt;
+    pmix_cb_t *cb;
+} pmix_get_batch_item_t;
+
+typedef struct pmix_get_batch_t {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_lock_t lock;
+    pmix_get_batch_item_t *items;
+    size_t nitems;
+    size_t nleft;
+    pmix_list_t reqs;
+} pmix_get_batch_t;
+static void gbcon(pmix_get_batch_t *p)
+{
+    PMIX_CONSTRUCT_LOCK(&p->lock);
+    p->items = NULL;
+    p->nitems = 0;
+    p->nleft = 0;
+    PMIX_CONSTRUCT(&p->reqs, pmix_list_t);
+}
+static void gbdes(pmix_get_batch_t *p)
+{
+    PMIX_DESTRUCT_LOCK(&p->lock);
+    if (NULL != p->items) {
+        free(p->items);
+    }
+    PMIX_LIST_DESTRUCT(&p->reqs);
+}
+static PMIX_CLASS_INSTANCE(pmix_get_batch_t, pmix_object_t, gbcon, gbdes);
+
+/* while a batch is being processed, requests that have to go to
+ * the server are collected here instead of being sent one by one.
+ * Only ever touched from within the progress thread */
+static pmix_list_t *batch_reqs = NULL;
 
 static pmix_status_t process_request(const pmix_proc_t *proc, const char key[],
                                      const pmix_info_t info[], size_t ninfo,
@@ -257,12 +318,112 @@ static pmix_status_t process_request(const pmix_proc_t *proc, const char key[],
     return PMIX_SUCCESS;
 }
 
+/* a request can be answered from the direct-read cache if the
+ * result is fully determined by the proc and key - any directive
+ * beyond those listed here could change what the GDS returns */
+static bool direct_eligible(const char key[], const pmix_info_t info[], size_t ninfo,
+                            pmix_get_logic_t *lg)
+{
+    size_t n;
+
+    if (NULL == key || lg->pntrval || lg->refresh_cache) {
+        return false;
+    }
+    /* staged puts have yet to reach the GDS */
+    if (pmix_client_put_pending()) {
+        return false;
+    }
+    for (n = 0; n < ninfo; n++) {
+        if (!PMIX_CHECK_KEY(&info[n], PMIX_OPTIONAL) &&
+            !PMIX_CHECK_KEY(&info[n], PMIX_IMMEDIATE) &&
+            !PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT) &&
+            !PMIX_CHECK_KEY(&info[n], PMIX_GET_STATIC_VALUES)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* a key can only be remembered as absent if the request looked
+ * everywhere it could be - a request that only checked what we
+ * hold locally says nothing about what the server could provide */
+static bool absence_definitive(const pmix_info_t info[], size_t ninfo)
+{
+    size_t n;
+
+    for (n = 0; n < ninfo; n++) {
+        if ((PMIX_CHECK_KEY(&info[n], PMIX_OPTIONAL) ||
+             PMIX_CHECK_KEY(&info[n], PMIX_IMMEDIATE)) &&
+            PMIX_INFO_TRUE(&info[n])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static pmix_status_t direct_lookup(pmix_get_logic_t *lg, const char key[], pmix_value_t **val)
+{
+    pmix_value_t *ival;
+    pmix_status_t rc;
+
+    if (lg->stval) {
+        return pmix_gds_base_dcache_lookup(&lg->p, key, *val);
+    }
+    PMIX_VALUE_CREATE(ival, 1);
+    if (NULL == ival) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = pmix_gds_base_dcache_lookup(&lg->p, key, ival);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_VALUE_RELEASE(ival);
+        return rc;
+    }
+    *val = ival;
+    return PMIX_SUCCESS;
+}
+
+/* fetch a value through the progress thread, blocking until it arrives */
+static pmix_status_t fetch_value(pmix_get_logic_t *lg, const char key[], const pmix_info_t info[],
+                                 size_t ninfo, pmix_value_t **val)
+{
+    pmix_cb_t *cb;
+    pmix_status_t rc;
+
+    cb = PMIX_NEW(pmix_cb_t);
+    cb->lg = lg;
+    cb->key = (char*)key;
+    cb->info = (pmix_info_t*)info;
+    cb->ninfo = ninfo;
+    cb->cbfunc.valuefn = _value_cbfunc;
+    cb->cbdata = cb;
+
+    /* MUST threadshift here to avoid touching global
+     * data while in the user's thread */
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_GET);
+    PMIX_THREADSHIFT(cb, get_data);
+
+    /* wait for the data to be obtained */
+    PMIX_WAIT_THREAD(&cb->lock);
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_GET);
+    rc = cb->status;
+    if (PMIX_OPERATION_SUCCEEDED == rc) {
+        rc = PMIX_SUCCESS;
+    }
+    *val = cb->value;
+    cb->value = NULL;
+    PMIX_RELEASE(cb);
+    return rc;
+}
+
 PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc, const char key[],
                                    const pmix_info_t info[], size_t ninfo, pmix_value_t **val)
 {
-    pmix_cb_t *cb;
+    pmix_value_t *ival;
     pmix_get_logic_t *lg;
     pmix_status_t rc;
+    pmix_proc_t dproc;
+    uint64_t gen = 0;
+    bool direct;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -294,7 +455,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc, const char key[],
 
     /* if we are to refresh the cache, go do that */
     if (lg->refresh_cache) {
-        rc = refresh_cache();
+        rc = refresh_cache(&lg->p);
         if (PMIX_SUCCESS != rc) {
             // couldn't refresh for some reason
             PMIX_RELEASE(lg);
@@ -302,40 +463,162 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc, const char key[],
         }
     }
 
+    /* values we have already returned once can be given back
+     * without touching the progress thread */
+    direct = direct_eligible(key, info, ninfo, lg);
+    if (direct) {
+        if (PMIX_SUCCESS == direct_lookup(lg, key, val)) {
+            PMIX_RELEASE(lg);
+            pmix_output_verbose(2, pmix_client_globals.get_output,
+                                "pmix:client get completed from direct-read cache");
+            return PMIX_SUCCESS;
+        }
+        /* nor do we ask again for keys that were not there */
+        if (pmix_gds_base_dcache_absent(&lg->p, key)) {
+            PMIX_RELEASE(lg);
+            *val = NULL;
+            pmix_output_verbose(2, pmix_client_globals.get_output,
+                                "pmix:client get of absent key %s completed from cache", key);
+            return PMIX_ERR_NOT_FOUND;
+        }
+        /* get_data may alter the proc, so remember what was asked */
+        memcpy(&dproc, &lg->p, sizeof(pmix_proc_t));
+        gen = pmix_gds_base_dcache_generation();
+    }
+
     /* the request is good - let's go get the data */
-    cb = PMIX_NEW(pmix_cb_t);
-    cb->lg = lg;
-    cb->key = (char*)key;
-    cb->info = (pmix_info_t*)info;
-    cb->ninfo = ninfo;
-    cb->cbfunc.valuefn = _value_cbfunc;
-    cb->cbdata = cb;
+    rc = fetch_value(lg, key, info, ninfo, &ival);
+    if (PMIX_SUCCESS == rc && NULL != ival) {
+        *val = ival;
+        if (direct) {
+            pmix_gds_base_dcache_insert(gen, &dproc, key, *val);
+        }
+    } else {
+        *val = NULL;
+        if (direct && PMIX_ERR_NOT_FOUND == rc && absence_definitive(info, ninfo)) {
+            pmix_gds_base_dcache_insert(gen, &dproc, key, NULL);
+        }
+    }
+    PMIX_RELEASE(lg);
 
-    /* MUST threadshift here to avoid touching global
-     * data while in the user's thread */
-    PMIX_THREADSHIFT(cb, get_data);
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get completed with status %s", PMIx_Error_string(rc));
 
-    /* wait for the data to be obtained */
-    PMIX_WAIT_THREAD(&cb->lock);
-    rc = cb->status;
+    return rc;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Get_view(const pmix_proc_t *proc, const char key[],
+                                        const pmix_info_t info[], size_t ninfo,
+                                        pmix_value_t *val, uint64_t *epoch)
+{
+    pmix_get_logic_t *lg;
+    pmix_status_t rc;
+    pmix_proc_t dproc;
+    pmix_value_t *ival = NULL;
+    uint64_t gen;
+    bool direct;
+    size_t n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    pmix_output_verbose(2, pmix_client_globals.get_output, "pmix:client get view for %s key %s",
+                        (NULL == proc) ? "NULL" : PMIX_NAME_PRINT(proc),
+                        (NULL == key) ? "NULL" : key);
+
+    if (NULL == key || NULL == val || PMIX_MAX_KEYLEN < pmix_keylen(key)) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* we decide where the value lives */
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_GET_POINTER_VALUES) ||
+            PMIX_CHECK_KEY(&info[n], PMIX_GET_STATIC_VALUES)) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+    }
+
+    lg = PMIX_NEW(pmix_get_logic_t);
+    /* our own ID and rank come back pointing at our globals,
+     * which outlive any epoch */
+    lg->pntrval = true;
+    rc = process_request(proc, key, info, ninfo, lg, &ival);
+    lg->pntrval = false;
     if (PMIX_OPERATION_SUCCEEDED == rc) {
-        rc = PMIX_SUCCESS;
+        memcpy(val, ival, sizeof(pmix_value_t));
+        if (NULL != epoch) {
+            *epoch = pmix_gds_base_dcache_generation();
+        }
+        PMIX_RELEASE(lg);
+        return PMIX_SUCCESS;
+    } else if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(lg);
+        return rc;
     }
-    if (PMIX_SUCCESS == rc && NULL != cb->value) {
-        *val = cb->value;
-        cb->value = NULL;
-    } else {
-        *val = NULL;
+
+    if (lg->refresh_cache) {
+        rc = refresh_cache(&lg->p);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(lg);
+            return rc;
+        }
+    }
+
+    /* sample the generation first - a view found in a table that
+     * is flushed after this is simply reported as already stale */
+    gen = pmix_gds_base_dcache_generation();
+    direct = direct_eligible(key, info, ninfo, lg);
+    if (direct) {
+        if (PMIX_SUCCESS == pmix_gds_base_dcache_borrow(&lg->p, key, val)) {
+            if (NULL != epoch) {
+                *epoch = gen;
+            }
+            PMIX_RELEASE(lg);
+            pmix_output_verbose(2, pmix_client_globals.get_output,
+                                "pmix:client get view completed from direct-read cache");
+            return PMIX_SUCCESS;
+        }
+        if (pmix_gds_base_dcache_absent(&lg->p, key)) {
+            PMIX_RELEASE(lg);
+            return PMIX_ERR_NOT_FOUND;
+        }
+        memcpy(&dproc, &lg->p, sizeof(pmix_proc_t));
+    }
+
+    rc = fetch_value(lg, key, info, ninfo, &ival);
+    if (PMIX_SUCCESS == rc && NULL == ival) {
+        rc = PMIX_ERR_NOT_FOUND;
+    } else if (PMIX_SUCCESS == rc) {
+        /* the cache keeps the value for as long as the view is good,
+         * making it available to later lookups if nothing but the
+         * proc and key determined it */
+        rc = pmix_gds_base_dcache_adopt(gen, direct ? &dproc : NULL, direct ? key : NULL, ival,
+                                        val, &gen);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_VALUE_RELEASE(ival);
+        } else if (NULL != epoch) {
+            *epoch = gen;
+        }
+    } else if (direct && PMIX_ERR_NOT_FOUND == rc && absence_definitive(info, ninfo)) {
+        pmix_gds_base_dcache_insert(gen, &dproc, key, NULL);
     }
     PMIX_RELEASE(lg);
-    PMIX_RELEASE(cb);
 
     pmix_output_verbose(2, pmix_client_globals.get_output,
-                        "pmix:client get completed with status %s", PMIx_Error_string(rc));
+                        "pmix:client get view completed with status %s", PMIx_Error_string(rc));
 
     return rc;
 }
 
+PMIX_EXPORT uint64_t PMIx_Get_epoch(void)
+{
+    return pmix_gds_base_dcache_generation();
+}
+
 static void gcbfn(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
@@ -391,7 +674,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char key[],
 
     /* if we are to refresh the cache, go do that */
     if (lg->refresh_cache) {
-        rc = refresh_cache();
+        rc = refresh_cache(&lg->p);
         if (PMIX_SUCCESS != rc) {
             // couldn't refresh for some reason
             PMIX_RELEASE(lg);
@@ -421,6 +704,362 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char key[],
     return rc;
 }
 
+static void _batch_value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    pmix_get_batch_item_t *item = (pmix_get_batch_item_t *) cbdata;
+    pmix_get_batch_t *bt = item->bt;
+    pmix_cb_t *cb = item->cb;
+    pmix_status_t rc;
+
+    cb->status = status;
+    if (PMIX_SUCCESS == status && NULL != kv) {
+        PMIX_BFROPS_COPY(rc, pmix_client_globals.myserver, (void **)&cb->value, kv, PMIX_VALUE);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            cb->status = rc;
+        }
+    }
+    --bt->nleft;
+    if (0 == bt->nleft) {
+        PMIX_POST_OBJECT(bt);
+        PMIX_WAKEUP_THREAD(&bt->lock);
+    }
+}
+
+static void batch_fail(pmix_get_req_t *req, pmix_status_t status, struct pmix_peer_t *pr,
+                       pmix_ptl_hdr_t *hdr)
+{
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    /* give the request a reply carrying just the error so it is
+     * completed the same way as an individual get */
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &buf, &status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    _getnb_cbfunc(pr, hdr, &buf, req->cb);
+    PMIX_DESTRUCT(&buf);
+}
+
+/* this callback is coming from the ptl recv, and thus
+ * is occurring inside of our progress thread */
+static void _getbatch_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
+                             pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_list_t *reqs = (pmix_list_t *) cbdata;
+    pmix_get_req_t *req;
+    pmix_status_t rc, ret;
+    pmix_byte_object_t bo;
+    pmix_buffer_t sub;
+    int32_t cnt;
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix: get batch callback recvd");
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection - pass it along */
+    if (PMIX_BUFFER_IS_EMPTY(buf)) {
+        PMIX_LIST_FOREACH (req, reqs, pmix_get_req_t) {
+            _getnb_cbfunc(pr, hdr, buf, req->cb);
+        }
+        PMIX_LIST_RELEASE(reqs);
+        return;
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = rc;
+    }
+    /* the replies come back in the order the requests were sent */
+    PMIX_LIST_FOREACH (req, reqs, pmix_get_req_t) {
+        if (PMIX_SUCCESS != ret) {
+            batch_fail(req, ret, pr, hdr);
+            continue;
+        }
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = rc;
+            batch_fail(req, ret, pr, hdr);
+            continue;
+        }
+        PMIX_CONSTRUCT(&sub, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &sub, bo.bytes, bo.size);
+        _getnb_cbfunc(pr, hdr, &sub, req->cb);
+        PMIX_DESTRUCT(&sub);
+    }
+    PMIX_LIST_RELEASE(reqs);
+}
+
+static void send_batch(pmix_list_t *reqs)
+{
+    pmix_get_req_t *req;
+    pmix_list_t *sent;
+    pmix_buffer_t *msg;
+    pmix_status_t rc;
+    pmix_byte_object_t bo;
+    pmix_cmd_t cmd = PMIX_GET_BATCH_CMD;
+    size_t n;
+
+    n = pmix_list_get_size(reqs);
+    if (0 == n) {
+        return;
+    }
+
+    if (1 < n && !PMIX_PEER_IS_EARLIER(pmix_client_globals.myserver, 5, 0, 0)) {
+        msg = PMIX_NEW(pmix_buffer_t);
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &n, 1, PMIX_SIZE);
+        }
+        PMIX_LIST_FOREACH (req, reqs, pmix_get_req_t) {
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            bo.bytes = req->msg->base_ptr;
+            bo.size = req->msg->bytes_used;
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &bo, 1, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            pmix_output_verbose(2, pmix_client_globals.get_output,
+                                "%s REQUESTING DATA FROM SERVER FOR %lu PROCS IN ONE MESSAGE",
+                                PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) n);
+            /* the reply callback takes over the requests */
+            sent = PMIX_NEW(pmix_list_t);
+            pmix_list_join(sent, pmix_list_get_end(sent), reqs);
+            PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, _getbatch_cbfunc,
+                               (void *) sent);
+            if (PMIX_SUCCESS == rc) {
+                return;
+            }
+            PMIX_RELEASE(msg);
+            while (NULL != (req = (pmix_get_req_t *) pmix_list_remove_first(sent))) {
+                pmix_list_remove_item(&pmix_client_globals.pending_requests, &req->cb->super);
+                req->cb->cbfunc.valuefn(PMIX_ERROR, NULL, req->cb->cbdata);
+                PMIX_RELEASE(req);
+            }
+            PMIX_RELEASE(sent);
+            return;
+        }
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+    }
+
+    /* send them one at a time */
+    while (NULL != (req = (pmix_get_req_t *) pmix_list_remove_first(reqs))) {
+        PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, req->msg, _getnb_cbfunc,
+                           (void *) req->cb);
+        if (PMIX_SUCCESS == rc) {
+            /* the ptl owns the message now */
+            req->msg = NULL;
+        } else {
+            pmix_list_remove_item(&pmix_client_globals.pending_requests, &req->cb->super);
+            req->cb->cbfunc.valuefn(PMIX_ERROR, NULL, req->cb->cbdata);
+        }
+        PMIX_RELEASE(req);
+    }
+}
+
+static void get_batch_data(int sd, short args, void *cbdata)
+{
+    pmix_get_batch_t *bt = (pmix_get_batch_t *) cbdata;
+    size_t n;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(bt);
+
+    /* make sure our own staged puts can be found */
+    pmix_client_put_drain();
+
+    /* run each request through the usual logic, holding
+     * back anything that needs to go to the server */
+    batch_reqs = &bt->reqs;
+    for (n = 0; n < bt->nitems; n++) {
+        if (NULL != bt->items[n].cb) {
+            get_data(0, 0, bt->items[n].cb);
+        }
+    }
+    batch_reqs = NULL;
+
+    send_batch(&bt->reqs);
+
+    /* release our own hold on the batch */
+    --bt->nleft;
+    if (0 == bt->nleft) {
+        PMIX_POST_OBJECT(bt);
+        PMIX_WAKEUP_THREAD(&bt->lock);
+    }
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(pmix_pdata_t data[], size_t ndata,
+                                         const pmix_info_t info[], size_t ninfo)
+{
+    pmix_get_batch_t *bt;
+    pmix_get_logic_t *lg;
+    pmix_cb_t *cb;
+    pmix_value_t *vptr;
+    pmix_status_t rc;
+    pmix_proc_t *dprocs = NULL;
+    bool refresh = false, *direct = NULL;
+    uint64_t gen;
+    size_t n, nfound = 0;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == data || 0 == ndata) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get multi for %lu keys", (unsigned long) ndata);
+
+    bt = PMIX_NEW(pmix_get_batch_t);
+    bt->items = (pmix_get_batch_item_t *) calloc(ndata, sizeof(pmix_get_batch_item_t));
+    dprocs = (pmix_proc_t *) calloc(ndata, sizeof(pmix_proc_t));
+    direct = (bool *) calloc(ndata, sizeof(bool));
+    if (NULL == bt->items || NULL == dprocs || NULL == direct) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    bt->nitems = ndata;
+    /* hold the batch open until all requests have been issued */
+    bt->nleft = 1;
+    gen = pmix_gds_base_dcache_generation();
+
+    for (n = 0; n < ndata; n++) {
+        bt->items[n].bt = bt;
+        PMIX_VALUE_CONSTRUCT(&data[n].value);
+        if (PMIX_MAX_KEYLEN < pmix_keylen(data[n].key)) {
+            continue;
+        }
+        lg = PMIX_NEW(pmix_get_logic_t);
+        vptr = &data[n].value;
+        rc = process_request(&data[n].proc, data[n].key, info, ninfo, lg, &vptr);
+        if (PMIX_OPERATION_SUCCEEDED == rc) {
+            /* the value has already been prepped */
+            if (vptr != &data[n].value) {
+                PMIx_Value_xfer(&data[n].value, vptr);
+                if (!lg->pntrval) {
+                    PMIX_VALUE_RELEASE(vptr);
+                }
+            }
+            ++nfound;
+            PMIX_RELEASE(lg);
+            continue;
+        } else if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(lg);
+            continue;
+        }
+        if (lg->refresh_cache) {
+            /* note the proc whose data is to be refreshed */
+            refresh = true;
+            memcpy(&dprocs[n], &lg->p, sizeof(pmix_proc_t));
+        } else if (direct_eligible(data[n].key, info, ninfo, lg)) {
+            if (PMIX_SUCCESS
+                == pmix_gds_base_dcache_lookup(&lg->p, data[n].key, &data[n].value)) {
+                ++nfound;
+                PMIX_RELEASE(lg);
+                continue;
+            }
+            if (pmix_gds_base_dcache_absent(&lg->p, data[n].key)) {
+                PMIX_RELEASE(lg);
+                continue;
+            }
+            direct[n] = true;
+            memcpy(&dprocs[n], &lg->p, sizeof(pmix_proc_t));
+        }
+
+        cb = PMIX_NEW(pmix_cb_t);
+        cb->lg = lg;
+        cb->key = data[n].key;
+        cb->info = (pmix_info_t *) info;
+        cb->ninfo = ninfo;
+        cb->cbfunc.valuefn = _batch_value_cbfunc;
+        cb->cbdata = &bt->items[n];
+        bt->items[n].cb = cb;
+        ++bt->nleft;
+    }
+
+    if (1 < bt->nleft) {
+        /* if we are to refresh the cache, go do that */
+        for (n = 0; refresh && n < ndata; n++) {
+            if (direct[n] || '\0' == dprocs[n].nspace[0]
+                || (0 < n && dprocs[n].rank == dprocs[n - 1].rank
+                    && PMIX_CHECK_NSPACE(dprocs[n].nspace, dprocs[n - 1].nspace))) {
+                continue;
+            }
+            rc = refresh_cache(&dprocs[n]);
+            if (PMIX_SUCCESS != rc) {
+                goto cleanup;
+            }
+        }
+        /* MUST threadshift here to avoid touching global
+         * data while in the user's thread */
+        PMIX_THREADSHIFT(bt, get_batch_data);
+        PMIX_WAIT_THREAD(&bt->lock);
+    }
+
+    for (n = 0; n < ndata; n++) {
+        cb = bt->items[n].cb;
+        if (NULL == cb) {
+            continue;
+        }
+        if (PMIX_SUCCESS == cb->status && NULL != cb->value) {
+            PMIx_Value_xfer(&data[n].value, cb->value);
+            if (direct[n]) {
+                pmix_gds_base_dcache_insert(gen, &dprocs[n], data[n].key, cb->value);
+            }
+            ++nfound;
+        } else if (direct[n] && PMIX_ERR_NOT_FOUND == cb->status
+                   && absence_definitive(info, ninfo)) {
+            pmix_gds_base_dcache_insert(gen, &dprocs[n], data[n].key, NULL);
+        }
+    }
+
+    if (nfound == ndata) {
+        rc = PMIX_SUCCESS;
+    } else if (0 == nfound) {
+        rc = PMIX_ERR_NOT_FOUND;
+    } else {
+        rc = PMIX_ERR_PARTIAL_SUCCESS;
+    }
+
+cleanup:
+    for (n = 0; NULL != bt->items && n < bt->nitems; n++) {
+        cb = bt->items[n].cb;
+        if (NULL != cb) {
+            if (NULL != cb->value) {
+                PMIX_VALUE_RELEASE(cb->value);
+            }
+            PMIX_RELEASE(cb->lg);
+            PMIX_RELEASE(cb);
+        }
+    }
+    PMIX_RELEASE(bt);
+    if (NULL != dprocs) {
+        free(dprocs);
+    }
+    if (NULL != direct) {
+        free(direct);
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get multi completed with status %s",
+                        PMIx_Error_string(rc));
+    return rc;
+}
+
 static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
 {
     pmix_cb_t *cb;
@@ -693,6 +1332,9 @@ static void get_data(int sd, short args, void *cbdata)
     pmix_info_t optional, *iptr;
     size_t nfo, n;
     pmix_kval_t *kv;
+    pmix_byte_object_t bo;
+    pmix_buffer_t mbuf;
+    pmix_get_req_t *req;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(cb);
@@ -701,6 +1343,9 @@ static void get_data(int sd, short args, void *cbdata)
     iptr = cb->info;
     nfo = cb->ninfo;
 
+    /* make sure our own staged puts can be found */
+    pmix_client_put_drain();
+
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix:client:get_data value for proc %s key %s",
                         PMIX_NAME_PRINT(&lg->p), (NULL == cb->key) ? "NULL" : cb->key);
@@ -1052,6 +1697,27 @@ doget:
         goto done;
     }
 
+    /* the server may have published this proc's collected data in
+     * shared memory - if so, load it without asking the server */
+    if (PMIX_RANK_IS_VALID(proc.rank) && pmix_modex_shmem_lookup(&proc, &bo)) {
+        PMIX_CONSTRUCT(&mbuf, pmix_buffer_t);
+        PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_client_globals.myserver, &mbuf, bo.bytes, bo.size);
+        PMIX_GDS_ACCEPT_KVS_RESP(rc, pmix_globals.mypeer, &mbuf);
+        /* the payload belongs to the segment */
+        mbuf.base_ptr = NULL;
+        mbuf.bytes_used = 0;
+        PMIX_DESTRUCT(&mbuf);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+            if (PMIX_SUCCESS == rc) {
+                pmix_output_verbose(5, pmix_client_globals.get_output,
+                                    "pmix:client data found in shared-memory modex");
+                cb->status = process_values(cb);
+                goto done;
+            }
+        }
+    }
+
     /* see if we already have a request in place with the server for data from
      * this nspace:rank. If we do, then no need to ask again as the
      * request will return _all_ data from that proc */
@@ -1080,6 +1746,14 @@ doget:
 
     /* track the callback object */
     pmix_list_append(&pmix_client_globals.pending_requests, &cb->super);
+    if (NULL != batch_reqs) {
+        /* it will be sent along with the rest of the batch */
+        req = PMIX_NEW(pmix_get_req_t);
+        req->msg = msg;
+        req->cb = cb;
+        pmix_list_append(batch_reqs, &req->super);
+        return;
+    }
     /* send to the server */
     PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, _getnb_cbfunc, (void *) cb);
     if (PMIX_SUCCESS != rc) {
@@ -1101,10 +1775,43 @@ done:
     return;
 }
 
+/* the epoch of the data of a proc as the server last sent it to us */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t proc;
+    uint64_t epoch;
+} pmix_client_epoch_t;
+static PMIX_CLASS_INSTANCE(pmix_client_epoch_t, pmix_list_item_t, NULL, NULL);
+
+/* only accessed from the progress thread */
+static pmix_client_epoch_t *refresh_epoch(const pmix_proc_t *proc, bool create)
+{
+    pmix_client_epoch_t *ep;
+
+    PMIX_LIST_FOREACH (ep, &pmix_client_globals.refresh_epochs, pmix_client_epoch_t) {
+        if (ep->proc.rank == proc->rank && PMIX_CHECK_NSPACE(ep->proc.nspace, proc->nspace)) {
+            return ep;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    ep = PMIX_NEW(pmix_client_epoch_t);
+    if (NULL == ep) {
+        return NULL;
+    }
+    PMIX_XFER_PROCID(&ep->proc, proc);
+    ep->epoch = 0;
+    pmix_list_append(&pmix_client_globals.refresh_epochs, &ep->super);
+    return ep;
+}
+
 static void refcb(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
                   pmix_buffer_t *buf, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_client_epoch_t *ep;
+    uint64_t epoch;
     int32_t cnt;
     pmix_status_t rc, ret;
 
@@ -1132,6 +1839,28 @@ static void refcb(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
         PMIX_ERROR_LOG(rc);
         ret = rc;
     }
+    if (PMIX_SUCCESS != ret) {
+        goto done;
+    }
+
+    /* the server's epoch for the proc, followed by the values
+     * that changed since the one we presented */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &epoch, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = rc;
+        goto done;
+    }
+    PMIX_GDS_ACCEPT_KVS_RESP(rc, pmix_globals.mypeer, buf);
+    if (PMIX_SUCCESS != rc && PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        ret = rc;
+        goto done;
+    }
+    ep = refresh_epoch(cb->proc, true);
+    if (NULL != ep) {
+        ep->epoch = epoch;
+    }
 
 done:
     cb->status = ret;
@@ -1141,37 +1870,84 @@ done:
     return;
 }
 
-static pmix_status_t refresh_cache(void)
+static void _refresh(int sd, short args, void *cbdata)
 {
-    pmix_cb_t cb;
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_client_epoch_t *ep;
     pmix_buffer_t *msg;
-    pmix_status_t rc;
     pmix_cmd_t cmd = PMIX_REFRESH_CACHE;
+    uint64_t since = 0;
+    pmix_status_t rc;
 
-    pmix_output_verbose(2, pmix_client_globals.get_output,
-                        "%s REQUESTING CACHE REFRESH BY SERVER",
-                        PMIX_NAME_PRINT(&pmix_globals.myid));
+    PMIX_ACQUIRE_OBJECT(cb);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    ep = refresh_epoch(cb->proc, false);
+    if (NULL != ep) {
+        since = ep->epoch;
+    }
 
-    /* pack a quick message to the server asking it
-     * to refresh our cache */
+    /* ask the server for what changed since we last asked */
     msg = PMIX_NEW(pmix_buffer_t);
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, cb->proc, 1, PMIX_PROC);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &since, 1, PMIX_UINT64);
+    }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
-        return rc;
+        goto error;
     }
 
-    PMIX_CONSTRUCT(&cb, pmix_cb_t);
-
     /* send to the server */
-    PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, refcb, (void *)&cb);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_DESTRUCT(&cb);
+    PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, refcb, (void *) cb);
+    if (PMIX_SUCCESS == rc) {
+        return;
+    }
+    PMIX_RELEASE(msg);
+
+error:
+    cb->status = rc;
+    PMIX_POST_OBJECT(cb);
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+static pmix_status_t refresh_cache(const pmix_proc_t *proc)
+{
+    pmix_cb_t cb;
+    pmix_status_t rc;
+    pmix_namespace_t *ns;
+
+    /* job-level info updated in shared memory only needs us to
+     * check its version - only ask the server if that can't be done */
+    rc = pmix_gds_base_refresh();
+    if (PMIX_SUCCESS == rc) {
+        pmix_output_verbose(2, pmix_client_globals.get_output,
+                            "%s CACHE REFRESHED LOCALLY",
+                            PMIX_NAME_PRINT(&pmix_globals.myid));
         return rc;
     }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "%s REQUESTING CACHE REFRESH OF %s BY SERVER",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), PMIX_NAME_PRINT(proc));
+
+    /* the epochs we hold are only touched by the progress thread */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = (pmix_proc_t *) proc;
+    PMIX_THREADSHIFT(&cb, _refresh);
     PMIX_WAIT_THREAD(&cb.lock);
     rc = cb.status;
+    cb.proc = NULL;
     PMIX_DESTRUCT(&cb);
+    if (PMIX_SUCCESS == rc) {
+        /* anything resolved from the old data is now stale */
+        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+            pmix_namespace_flush_resolved(ns);
+        }
+    }
     return rc;
 }
@@ -24,6 +24,8 @@ BEGIN_C_DECLS
 typedef struct {
     pmix_peer_t *myserver;        // messaging support to/from my server
     bool singleton;               // no server
+    bool jobinfo_in_ack;          // asked the server for our job info in the connect handshake
+    pmix_buffer_t *jobinfo;       // job info returned with the connect handshake
     pmix_list_t pending_requests; // list of pmix_cb_t pending data requests
     pmix_pointer_array_t peers;   // array of pmix_peer_t cached for data ops
     // verbosity for client get operations
@@ -53,10 +55,31 @@ typedef struct {
     /* IOF output sinks */
     pmix_iof_sink_t iof_stdout;
     pmix_iof_sink_t iof_stderr;
+    /* heartbeat counter in the page shared with our server */
+    void *hbeat_base;
+    size_t hbeat_size;
+    volatile uint64_t *hbeat;
+    /* PMIx_Log_nb aggregation */
+    int log_batch_max;
+    int log_batch_delay;
+    /* incremental commits */
+    bool commit_delta;            // commit only the keys put since the last commit
+    bool commit_sent;             // the server has all values committed so far
+    char **commit_keys;           // keys put since the last commit
+    bool put_stage;               // stage puts in the caller's thread until they are needed
+    /* incremental cache refresh */
+    pmix_list_t refresh_epochs;   // server epoch of the data last refreshed for each proc
 } pmix_client_globals_t;
 
 PMIX_EXPORT extern pmix_client_globals_t pmix_client_globals;
 
+/* store the values staged by PMIx_Put - must be called
+ * from the progress thread */
+PMIX_EXPORT void pmix_client_put_drain(void);
+
+/* are there staged values not yet stored? */
+PMIX_EXPORT bool pmix_client_put_pending(void);
+
 END_C_DECLS
 
 #endif /* PMIX_CLIENT_OPS_H */
@@ -22,6 +22,7 @@
 #include "src/client/pmix_client_ops.h"
 #include "src/hwloc/pmix_hwloc.h"
 #include "src/include/pmix_globals.h"
+#include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 
 static void _loadtp(int sd, short args, void *cbdata)
@@ -133,6 +134,183 @@ PMIX_EXPORT pmix_status_t PMIx_Get_relative_locality(const char *locality1, cons
     return rc;
 }
 
+/* get the locality matrix published for the given nspace along
+ * with the matrix row of each of its local peers - the matrix is
+ * left empty if the server did not provide one */
+static pmix_resolved_locality_t *load_locality(const char *nspace)
+{
+    pmix_resolved_locality_t *loc;
+    pmix_proc_t wildcard;
+    pmix_info_t optional;
+    pmix_value_t *val;
+    pmix_status_t rc;
+    pmix_rank_t rank;
+    char **peers;
+    size_t n, row, npeers;
+
+    loc = (pmix_resolved_locality_t *) calloc(1, sizeof(pmix_resolved_locality_t));
+    if (NULL == loc) {
+        return NULL;
+    }
+    PMIX_BYTE_OBJECT_CONSTRUCT(&loc->matrix);
+
+    /* only take what is already here */
+    PMIX_LOAD_PROCID(&wildcard, nspace, PMIX_RANK_WILDCARD);
+    PMIX_INFO_LOAD(&optional, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    rc = PMIx_Get(&wildcard, PMIX_LOCALITY_MATRIX, &optional, 1, &val);
+    if (PMIX_SUCCESS != rc || NULL == val) {
+        PMIX_INFO_DESTRUCT(&optional);
+        return loc;
+    }
+    if (PMIX_BYTE_OBJECT == val->type) {
+        loc->matrix = val->data.bo;
+        PMIX_BYTE_OBJECT_CONSTRUCT(&val->data.bo);
+    }
+    PMIX_VALUE_FREE(val, 1);
+
+    /* the matrix rows follow the order of the local peers */
+    rc = PMIx_Get(&wildcard, PMIX_LOCAL_PEERS, &optional, 1, &val);
+    PMIX_INFO_DESTRUCT(&optional);
+    if (PMIX_SUCCESS != rc || NULL == val) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&loc->matrix);
+        return loc;
+    }
+    peers = NULL;
+    if (PMIX_STRING == val->type && NULL != val->data.string) {
+        peers = pmix_argv_split(val->data.string, ',');
+    }
+    PMIX_VALUE_FREE(val, 1);
+    npeers = pmix_argv_count(peers);
+    if (0 == npeers || npeers * (npeers + 1) / 2 != loc->matrix.size) {
+        /* doesn't belong to this set of peers */
+        pmix_argv_free(peers);
+        PMIX_BYTE_OBJECT_DESTRUCT(&loc->matrix);
+        return loc;
+    }
+
+    loc->ranks = (pmix_rank_t *) malloc(npeers * sizeof(pmix_rank_t));
+    loc->rows = (size_t *) malloc(npeers * sizeof(size_t));
+    if (NULL == loc->ranks || NULL == loc->rows) {
+        pmix_argv_free(peers);
+        PMIX_BYTE_OBJECT_DESTRUCT(&loc->matrix);
+        return loc;
+    }
+    /* sort them by rank - they usually arrive in order,
+     * so an insertion sort costs little */
+    for (row = 0; row < npeers; row++) {
+        rank = strtoul(peers[row], NULL, 10);
+        for (n = row; 0 < n && rank < loc->ranks[n - 1]; n--) {
+            loc->ranks[n] = loc->ranks[n - 1];
+            loc->rows[n] = loc->rows[n - 1];
+        }
+        loc->ranks[n] = rank;
+        loc->rows[n] = row;
+    }
+    loc->npeers = npeers;
+    pmix_argv_free(peers);
+    return loc;
+}
+
+static bool locality_row(pmix_resolved_locality_t *loc, pmix_rank_t rank, size_t *row)
+{
+    size_t lo = 0, hi = loc->npeers, mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (loc->ranks[mid] == rank) {
+            *row = loc->rows[mid];
+            return true;
+        }
+        if (loc->ranks[mid] < rank) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Get_proc_relative_locality(const pmix_proc_t *proc1,
+                                                          const pmix_proc_t *proc2,
+                                                          pmix_locality_t *locality)
+{
+    pmix_namespace_t *ns, *nptr;
+    pmix_resolved_locality_t *loc;
+    pmix_value_t *val1, *val2;
+    pmix_status_t rc;
+    size_t i, j, n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    /* see if the server gave us the answer */
+    if (PMIX_CHECK_NSPACE(proc1->nspace, proc2->nspace)) {
+        nptr = NULL;
+        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+            if (PMIX_CHECK_NSPACE(ns->nspace, proc1->nspace)) {
+                nptr = ns;
+                break;
+            }
+        }
+        if (NULL != nptr) {
+            pmix_mutex_lock(&nptr->resolve_lock);
+            if (NULL == nptr->resolved_locality) {
+                pmix_mutex_unlock(&nptr->resolve_lock);
+                loc = load_locality(proc1->nspace);
+                pmix_mutex_lock(&nptr->resolve_lock);
+                if (NULL == nptr->resolved_locality) {
+                    nptr->resolved_locality = loc;
+                } else {
+                    /* someone beat us to it */
+                    pmix_resolved_locality_free(loc);
+                }
+            }
+            loc = nptr->resolved_locality;
+            if (NULL != loc && 0 < loc->matrix.size) {
+                if (!locality_row(loc, proc1->rank, &i) || !locality_row(loc, proc2->rank, &j)) {
+                    *locality = PMIX_LOCALITY_NONLOCAL;
+                } else {
+                    if (i > j) {
+                        n = i;
+                        i = j;
+                        j = n;
+                    }
+                    n = i * (2 * loc->npeers - i + 1) / 2 + (j - i);
+                    *locality = PMIX_LOCALITY_SHARE_NODE | (uint8_t) loc->matrix.bytes[n];
+                }
+                pmix_mutex_unlock(&nptr->resolve_lock);
+                return PMIX_SUCCESS;
+            }
+            pmix_mutex_unlock(&nptr->resolve_lock);
+        }
+    }
+
+    /* compare their locality strings */
+    rc = PMIx_Get(proc1, PMIX_LOCALITY_STRING, NULL, 0, &val1);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = PMIx_Get(proc2, PMIX_LOCALITY_STRING, NULL, 0, &val2);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_VALUE_FREE(val1, 1);
+        return rc;
+    }
+    if (PMIX_STRING != val1->type || NULL == val1->data.string
+        || PMIX_STRING != val2->type || NULL == val2->data.string) {
+        rc = PMIX_ERR_INVALID_VAL;
+    } else {
+        rc = pmix_hwloc_get_relative_locality(val1->data.string, val2->data.string, locality);
+    }
+    PMIX_VALUE_FREE(val1, 1);
+    PMIX_VALUE_FREE(val2, 1);
+    return rc;
+}
+
 static void icbrelfn(void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
@@ -14,6 +14,8 @@
  */
 #include "src/include/pmix_config.h"
 
+#include <ctype.h>
+
 #include "include/pmix.h"
 #include "pmix_common.h"
 #include "include/pmix_server.h"
@@ -34,6 +36,9 @@ static pmix_list_t client_attrs;
 static pmix_list_t server_attrs;
 static pmix_list_t host_attrs;
 static pmix_list_t tool_attrs;
+/* dictionary entries indexed by name and by string */
+static pmix_hash_table_t attr_names;
+static pmix_hash_table_t attr_strings;
 
 typedef struct {
     char *function;
@@ -60,6 +65,59 @@ static void atrkdes(pmix_attribute_trk_t *p)
 }
 static PMIX_CLASS_INSTANCE(pmix_attribute_trk_t, pmix_list_item_t, atrkcon, atrkdes);
 
+/* names and strings are matched without regard to case, so the
+ * indices are keyed by their lower-case form. Returns the length
+ * of the folded key, or zero if it cannot be in the dictionary */
+static size_t fold_key(const char *in, char *out)
+{
+    size_t n;
+
+    for (n = 0; '\0' != in[n]; n++) {
+        if (PMIX_MAX_KEYLEN <= n) {
+            return 0;
+        }
+        out[n] = tolower((unsigned char) in[n]);
+    }
+    out[n] = '\0';
+    return n;
+}
+
+static void index_entry(pmix_hash_table_t *table, const char *key,
+                        const pmix_regattr_input_t *entry)
+{
+    char tmp[PMIX_MAX_KEYLEN + 1];
+    size_t len;
+    void *ptr;
+
+    if (0 == (len = fold_key(key, tmp))) {
+        return;
+    }
+    /* keep the first entry, as a search of the dictionary would */
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(table, tmp, len, &ptr)) {
+        pmix_hash_table_set_value_ptr(table, tmp, len, (void *) entry);
+    }
+}
+
+/* returns false if the indices are not available, in which
+ * case the caller has to search the dictionary */
+static bool indexed_lookup(pmix_hash_table_t *table, const char *key,
+                           const pmix_regattr_input_t **entry)
+{
+    char tmp[PMIX_MAX_KEYLEN + 1];
+    size_t len;
+    void *ptr;
+
+    if (!initialized) {
+        return false;
+    }
+    *entry = NULL;
+    if (0 != (len = fold_key(key, tmp))
+        && PMIX_SUCCESS == pmix_hash_table_get_value_ptr(table, tmp, len, &ptr)) {
+        *entry = (const pmix_regattr_input_t *) ptr;
+    }
+    return true;
+}
+
 PMIX_EXPORT void pmix_init_registered_attrs(void)
 {
     size_t n;
@@ -70,10 +128,16 @@ PMIX_EXPORT void pmix_init_registered_attrs(void)
         PMIX_CONSTRUCT(&server_attrs, pmix_list_t);
         PMIX_CONSTRUCT(&host_attrs, pmix_list_t);
         PMIX_CONSTRUCT(&tool_attrs, pmix_list_t);
+        PMIX_CONSTRUCT(&attr_names, pmix_hash_table_t);
+        pmix_hash_table_init(&attr_names, PMIX_INDEX_BOUNDARY);
+        PMIX_CONSTRUCT(&attr_strings, pmix_hash_table_t);
+        pmix_hash_table_init(&attr_strings, PMIX_INDEX_BOUNDARY);
 
         /* cycle across the dictionary and load a hash
          * table with translations of key -> index */
         for (n=0; UINT32_MAX != pmix_dictionary[n].index; n++) {
+            index_entry(&attr_names, pmix_dictionary[n].name, &pmix_dictionary[n]);
+            index_entry(&attr_strings, pmix_dictionary[n].string, &pmix_dictionary[n]);
             p = (pmix_regattr_input_t*)pmix_malloc(sizeof(pmix_regattr_input_t));
             p->index = pmix_dictionary[n].index;
             p->name = strdup(pmix_dictionary[n].name);
@@ -144,6 +208,8 @@ PMIX_EXPORT void pmix_release_registered_attrs(void)
         PMIX_LIST_DESTRUCT(&server_attrs);
         PMIX_LIST_DESTRUCT(&host_attrs);
         PMIX_LIST_DESTRUCT(&tool_attrs);
+        PMIX_DESTRUCT(&attr_names);
+        PMIX_DESTRUCT(&attr_strings);
    }
     initialized = false;
 }
@@ -233,14 +299,34 @@ static pmix_attr_init_t client_fns[] = {
     {.function = "PMIx_Query_info",
      .attrs = (char *[]){"PMIX_QUERY_ATTRIBUTE_SUPPORT",
                          "PMIX_QUERY_AVAIL_SERVERS",
+                         "PMIX_QUERY_DMODEX_REQUESTS",
+                         "PMIX_QUERY_DMODEX_PREFETCHED",
+                         "PMIX_QUERY_DMODEX_PREFETCH_HITS",
+                         "PMIX_QUERY_OBJECT_USAGE",
+                         "PMIX_QUERY_PROGRESS_LAG",
+                         "PMIX_QUERY_PROGRESS_PROFILE",
                          "PMIX_QUERY_REFRESH_CACHE",
+                         "PMIX_QUERY_SERVER_CMD_STATS",
+                         "PMIX_QUERY_SERVER_COLLECTIVES",
+                         "PMIX_QUERY_SERVER_LOCAL_REQS",
+                         "PMIX_QUERY_STARTUP_TIMING",
                          "PMIX_QUERY_SUPPORTED_KEYS",
                          "PMIX_QUERY_SUPPORTED_QUALIFIERS",
                          NULL}},
     {.function = "PMIx_Query_info_nb",
      .attrs = (char *[]){"PMIX_QUERY_ATTRIBUTE_SUPPORT",
                          "PMIX_QUERY_AVAIL_SERVERS",
+                         "PMIX_QUERY_DMODEX_REQUESTS",
+                         "PMIX_QUERY_DMODEX_PREFETCHED",
+                         "PMIX_QUERY_DMODEX_PREFETCH_HITS",
+                         "PMIX_QUERY_OBJECT_USAGE",
+                         "PMIX_QUERY_PROGRESS_LAG",
+                         "PMIX_QUERY_PROGRESS_PROFILE",
                          "PMIX_QUERY_REFRESH_CACHE",
+                         "PMIX_QUERY_SERVER_CMD_STATS",
+                         "PMIX_QUERY_SERVER_COLLECTIVES",
+                         "PMIX_QUERY_SERVER_LOCAL_REQS",
+                         "PMIX_QUERY_STARTUP_TIMING",
                          "PMIX_QUERY_SUPPORTED_KEYS",
                          "PMIX_QUERY_SUPPORTED_QUALIFIERS",
                          NULL}},
@@ -383,7 +469,12 @@ static pmix_attr_init_t server_fns[] = {
     {.function = "PMIx_server_finalize", .attrs = (char *[]){"NONE", NULL}},
     {.function = "PMIx_generate_regex", .attrs = (char *[]){"N/A", NULL}},
     {.function = "PMIx_generate_ppn", .attrs = (char *[]){"N/A", NULL}},
-    {.function = "PMIx_server_register_nspace", .attrs = (char *[]){"PMIX_REGISTER_NODATA", NULL}},
+    {.function = "PMIx_generate_ppn_ranks", .attrs = (char *[]){"N/A", NULL}},
+    {.function = "PMIx_server_register_nspace",
+     .attrs = (char *[]){"PMIX_MODEX_RELEASE_FETCHED",
+                         "PMIX_MODEX_RELEASE_TIME",
+                         "PMIX_REGISTER_NODATA",
+                         NULL}},
     {.function = "PMIx_server_deregister_nspace", .attrs = (char *[]){"N/A", NULL}},
     {.function = "PMIx_server_register_client", .attrs = (char *[]){"N/A", NULL}},
     {.function = "PMIx_server_deregister_client", .attrs = (char *[]){"N/A", NULL}},
@@ -849,8 +940,12 @@ release:
 /*****   LOCATE A GIVEN ATTRIBUTE    *****/
 PMIX_EXPORT const char *pmix_attributes_lookup(const char *attr)
 {
+    const pmix_regattr_input_t *entry;
     size_t n;
 
+    if (indexed_lookup(&attr_names, attr, &entry)) {
+        return (NULL == entry) ? attr : entry->string;
+    }
     for (n = 0; 0 != strlen(pmix_dictionary[n].name); n++) {
         if (0 == strcasecmp(pmix_dictionary[n].name, attr)) {
             return pmix_dictionary[n].string;
@@ -861,8 +956,12 @@ PMIX_EXPORT const char *pmix_attributes_lookup(const char *attr)
 
 PMIX_EXPORT const char *pmix_attributes_reverse_lookup(const char *attrstring)
 {
+    const pmix_regattr_input_t *entry;
     size_t n;
 
+    if (indexed_lookup(&attr_strings, attrstring, &entry)) {
+        return (NULL == entry) ? attrstring : entry->name;
+    }
     for (n = 0; 0 != strlen(pmix_dictionary[n].name); n++) {
         if (0 == strcasecmp(pmix_dictionary[n].string, attrstring)) {
             return pmix_dictionary[n].name;
@@ -873,8 +972,15 @@ PMIX_EXPORT const char *pmix_attributes_reverse_lookup(const char *attrstring)
 
 PMIX_EXPORT const pmix_regattr_input_t *pmix_attributes_lookup_term(char *attr)
 {
+    const pmix_regattr_input_t *entry;
     size_t n;
 
+    /* this match is case-sensitive - the index gives us the
+     * answer unless the name only matched without regard to case */
+    if (indexed_lookup(&attr_names, attr, &entry)
+        && (NULL == entry || 0 == strcmp(entry->name, attr))) {
+        return entry;
+    }
     for (n = 0; 0 != strlen(pmix_dictionary[n].name); n++) {
         if (0 == strcmp(pmix_dictionary[n].name, attr)) {
             return &pmix_dictionary[n];
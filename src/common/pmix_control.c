@@ -18,6 +18,12 @@
 #include "src/include/pmix_socket_errno.h"
 #include "src/include/pmix_stdint.h"
 
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#include <sys/mman.h>
+
 #include "include/pmix.h"
 #include "pmix_common.h"
 #include "include/pmix_server.h"
@@ -45,6 +51,46 @@ static void relcbfunc(void *cbdata)
     }
     PMIX_RELEASE(cd);
 }
+/* if the server gave us a slot in its shared heartbeat page,
+ * map it so heartbeats can be counted there rather than sent */
+static void attach_heartbeat(pmix_info_t *info, size_t ninfo)
+{
+    char *path = NULL;
+    uint32_t slot = UINT32_MAX;
+    size_t n, size;
+    void *base;
+    int fd;
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_MONITOR_HEARTBEAT_SHMEM)) {
+            path = info[n].value.data.string;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_MONITOR_HEARTBEAT_SLOT)) {
+            slot = info[n].value.data.uint32;
+        }
+    }
+    if (NULL == path || UINT32_MAX == slot || NULL != pmix_client_globals.hbeat_base) {
+        return;
+    }
+
+    fd = open(path, O_RDWR);
+    if (0 > fd) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pmix:monitor cannot open heartbeat page %s - sending beats", path);
+        return;
+    }
+    size = ((size_t) slot + 1) * sizeof(uint64_t);
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        return;
+    }
+    pmix_client_globals.hbeat_base = base;
+    pmix_client_globals.hbeat_size = size;
+    pmix_client_globals.hbeat = (volatile uint64_t *) base + slot;
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:monitor counting heartbeats in slot %u of %s", slot, path);
+}
+
 static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
                          pmix_buffer_t *buf, void *cbdata)
 {
@@ -96,6 +142,7 @@ static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
             PMIX_ERROR_LOG(rc);
             goto complete;
         }
+        attach_heartbeat(results->info, results->ninfo);
     }
 
 complete:
@@ -225,24 +272,15 @@ PMIX_EXPORT pmix_status_t PMIx_Job_control_nb(const pmix_proc_t targets[], size_
         return rc;
     }
 
-    /* pack the number of targets */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &ntargets, 1, PMIX_SIZE);
+    /* pack the targets - remember, the targets can be NULL to indicate
+     * that the operation is to be done against all members of our nspace */
+    rc = pmix_pack_proc_set(pmix_client_globals.myserver, msg, targets,
+                            (NULL == targets) ? 0 : ntargets);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
         return rc;
     }
-    /* remember, the targets can be NULL to indicate that the operation
-     * is to be done against all members of our nspace */
-    if (NULL != targets && 0 < ntargets) {
-        /* pack the targets */
-        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, targets, ntargets, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(msg);
-            return rc;
-        }
-    }
 
     /* pack the directives */
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &ndirs, 1, PMIX_SIZE);
@@ -366,8 +404,13 @@ PMIX_EXPORT pmix_status_t PMIx_Process_monitor_nb(const pmix_info_t *monitor, pm
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
-    /* if the monitor is PMIX_SEND_HEARTBEAT, then send it */
+    /* if the monitor is PMIX_SEND_HEARTBEAT, then send it - unless
+     * the server lets us just count it in shared memory */
     if (PMIX_CHECK_KEY(monitor, PMIX_SEND_HEARTBEAT)) {
+        if (NULL != pmix_client_globals.hbeat) {
+            ++(*pmix_client_globals.hbeat);
+            return PMIX_SUCCESS;
+        }
         msg = PMIX_NEW(pmix_buffer_t);
         if (NULL == msg) {
             return PMIX_ERR_NOMEM;
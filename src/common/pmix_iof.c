@@ -23,6 +23,15 @@
 #    endif
 #endif
 #include <ctype.h>
+#ifdef HAVE_SYS_UIO_H
+#    include <sys/uio.h>
+#endif
+#ifdef HAVE_SYS_IOCTL_H
+#    include <sys/ioctl.h>
+#endif
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 
 #include "src/include/pmix_socket_errno.h"
 #include "src/include/pmix_stdint.h"
@@ -32,8 +41,9 @@
 #include "include/pmix_server.h"
 
 #include "src/mca/bfrops/bfrops.h"
+#include "src/mca/pcompress/pcompress.h"
 #include "src/mca/pfexec/base/base.h"
-#include "src/mca/ptl/ptl.h"
+#include "src/mca/ptl/base/base.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_basename.h"
@@ -129,7 +139,9 @@ static void process_cache(int sd, short args, void *cbdata)
 {
     pmix_iof_req_t *req = (pmix_iof_req_t *) cbdata;
     pmix_iof_cache_t *iof, *ionext;
-    bool found;
+    pmix_byte_object_t bo, cbo;
+    pmix_iof_channel_t channel;
+    bool found, compressed;
     size_t n;
     pmix_status_t rc;
     pmix_buffer_t *msg;
@@ -157,7 +169,7 @@ static void process_cache(int sd, short args, void *cbdata)
                 break;
             }
         }
-        if (found) {
+        if (found && pmix_server_iof_cache_data(iof, &bo)) {
             /* setup the msg */
             if (NULL == (msg = PMIX_NEW(pmix_buffer_t))) {
                 PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
@@ -171,9 +183,12 @@ static void process_cache(int sd, short args, void *cbdata)
                 return;
             }
             /* provide the channel */
-            PMIX_BFROPS_PACK(rc, req->requestor, msg, &iof->channel, 1, PMIX_IOF_CHANNEL);
+            channel = iof->channel;
+            compressed = pmix_iof_compress(req->requestor, &channel, &bo, &cbo);
+            PMIX_BFROPS_PACK(rc, req->requestor, msg, &channel, 1, PMIX_IOF_CHANNEL);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
+                PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                 PMIX_RELEASE(msg);
                 return;
             }
@@ -181,6 +196,7 @@ static void process_cache(int sd, short args, void *cbdata)
             PMIX_BFROPS_PACK(rc, req->requestor, msg, &req->local_id, 1, PMIX_SIZE);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
+                PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                 PMIX_RELEASE(msg);
                 return;
             }
@@ -188,6 +204,7 @@ static void process_cache(int sd, short args, void *cbdata)
             PMIX_BFROPS_PACK(rc, req->requestor, msg, &iof->ninfo, 1, PMIX_SIZE);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
+                PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                 PMIX_RELEASE(msg);
                 return;
             }
@@ -196,12 +213,15 @@ static void process_cache(int sd, short args, void *cbdata)
                 PMIX_BFROPS_PACK(rc, req->requestor, msg, iof->info, iof->ninfo, PMIX_INFO);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
+                    PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                     PMIX_RELEASE(msg);
                     return;
                 }
             }
             /* pack the data */
-            PMIX_BFROPS_PACK(rc, req->requestor, msg, iof->bo, 1, PMIX_BYTE_OBJECT);
+            PMIX_BFROPS_PACK(rc, req->requestor, msg, compressed ? &cbo : &bo, 1,
+                             PMIX_BYTE_OBJECT);
+            PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(msg);
@@ -521,7 +541,7 @@ static void stdincbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
         if (NULL != cd->cbfunc) {
             cd->cbfunc(PMIX_ERR_COMM_FAILURE, cd->cbdata);
         }
-        free(cd);
+        PMIX_RELEASE(cd);
         return;
     }
 
@@ -534,7 +554,8 @@ static void stdincbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
     if (NULL != cd->cbfunc) {
         cd->cbfunc(status, cd->cbdata);
     }
-    free(cd);
+    /* a blocking caller holds its own reference */
+    PMIX_RELEASE(cd);
 }
 
 static void myopcb(pmix_status_t status, void *cbdata)
@@ -731,7 +752,10 @@ pmix_status_t PMIx_IOF_push(const pmix_proc_t targets[], size_t ntargets, pmix_b
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msg);
-            free(cd);
+            if (NULL == cbfunc) {
+                PMIX_RELEASE(cd);
+            }
+            PMIX_RELEASE(cd);
         } else if (NULL == cbfunc) {
             PMIX_WAIT_THREAD(&cd->lock);
             rc = cd->status;
@@ -965,6 +989,58 @@ void pmix_iof_check_flags(pmix_info_t *info, pmix_iof_flags_t *flags)
     }
 }
 
+/* Forwarded output at least pmix_iof_compress_limit bytes long is
+ * compressed by the active pcompress component before it goes to a
+ * tool or client, and the channel is flagged so the receiver knows
+ * to expand it. Peers that predate the flag are sent the raw data.
+ * Returns true if out holds the compressed data */
+bool pmix_iof_compress(pmix_peer_t *peer, pmix_iof_channel_t *channel,
+                       const pmix_byte_object_t *bo, pmix_byte_object_t *out)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(out);
+
+    if (0 == pmix_globals.iof_compress_limit || NULL == bo ||
+        bo->size < pmix_globals.iof_compress_limit) {
+        return false;
+    }
+    if (PMIX_PEER_IS_EARLIER(peer, 5, 0, 0)) {
+        return false;
+    }
+    if (!pmix_compress.compress((const uint8_t *) bo->bytes, bo->size,
+                                (uint8_t **) &out->bytes, &out->size)) {
+        /* too small for the component, or didn't shrink */
+        return false;
+    }
+    *channel |= PMIX_IOF_COMPRESSED_CHANNEL;
+    return true;
+}
+
+/* expand data received from a server that compressed it, clearing
+ * the flag from the channel. If the data was not compressed, out is
+ * left empty and the data should be used as is */
+pmix_status_t pmix_iof_decompress(pmix_iof_channel_t *channel,
+                                  const pmix_byte_object_t *bo,
+                                  pmix_byte_object_t *out)
+{
+    uint8_t *data;
+    size_t size;
+
+    PMIX_BYTE_OBJECT_CONSTRUCT(out);
+    if (!(PMIX_IOF_COMPRESSED_CHANNEL & *channel)) {
+        return PMIX_SUCCESS;
+    }
+    *channel &= ~PMIX_IOF_COMPRESSED_CHANNEL;
+    if (NULL == bo->bytes || 0 == bo->size) {
+        return PMIX_SUCCESS;
+    }
+    if (!pmix_compress.decompress(&data, &size, (const uint8_t *) bo->bytes, bo->size)) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    out->bytes = (char *) data;
+    out->size = size;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_t *source,
                                    const pmix_byte_object_t *bo, const pmix_info_t *info,
                                    size_t ninfo, const pmix_iof_req_t *req)
@@ -972,6 +1048,8 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
     bool match;
     size_t m;
     pmix_buffer_t *msg;
+    pmix_byte_object_t cbo;
+    bool compressed;
     pmix_status_t rc;
 
     /* if the channel wasn't included, then ignore it */
@@ -1008,10 +1086,12 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
         PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
+    compressed = pmix_iof_compress(req->requestor, &channels, bo, &cbo);
     /* provide the source */
     PMIX_BFROPS_PACK(rc, req->requestor, msg, source, 1, PMIX_PROC);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
         PMIX_RELEASE(msg);
         return rc;
     }
@@ -1019,6 +1099,7 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
     PMIX_BFROPS_PACK(rc, req->requestor, msg, &channels, 1, PMIX_IOF_CHANNEL);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
         PMIX_RELEASE(msg);
         return rc;
     }
@@ -1026,6 +1107,7 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
     PMIX_BFROPS_PACK(rc, req->requestor, msg, &req->remote_id, 1, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
         PMIX_RELEASE(msg);
         return rc;
     }
@@ -1033,6 +1115,7 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
     PMIX_BFROPS_PACK(rc, req->requestor, msg, &ninfo, 1, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
         PMIX_RELEASE(msg);
         return rc;
     }
@@ -1041,12 +1124,14 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
         PMIX_BFROPS_PACK(rc, req->requestor, msg, info, ninfo, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
             PMIX_RELEASE(msg);
             return rc;
         }
     }
     /* pack the data */
-    PMIX_BFROPS_PACK(rc, req->requestor, msg, bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BFROPS_PACK(rc, req->requestor, msg, compressed ? &cbo : bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
@@ -1061,20 +1146,69 @@ pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels, const pmix_proc_
     return PMIX_OPERATION_SUCCEEDED;
 }
 
-static pmix_status_t write_output_line(const pmix_proc_t *name,
-                                       pmix_iof_write_event_t *channel,
-                                       pmix_iof_flags_t *myflags,
-                                       pmix_iof_channel_t stream,
-                                       bool copystdout, bool copystderr,
-                                       const pmix_byte_object_t *bo)
+/* Lines that need tagging can be formatted by a pool of threads
+ * rather than the progress thread. Every chunk of output - formatted
+ * by the pool or not - that arrives while earlier work is still out
+ * at the pool joins the back of a queue owned by the progress thread,
+ * and nothing is handed to a sink until everything in front of it is
+ * ready. So the order in which output reaches the sinks never depends
+ * on which thread formatted it */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_proc_t name;
+    pmix_iof_write_event_t *channel;
+    pmix_iof_flags_t flags;
+    pmix_iof_channel_t stream;
+    bool copystdout;
+    bool copystderr;
+    char *data;
+    size_t size;
+    pmix_list_t outputs;
+    int ready;
+} pmix_iof_format_t;
+
+static void fcon(pmix_iof_format_t *p)
+{
+    p->channel = NULL;
+    p->copystdout = false;
+    p->copystderr = false;
+    p->data = NULL;
+    p->size = 0;
+    PMIX_CONSTRUCT(&p->outputs, pmix_list_t);
+    p->ready = 0;
+}
+static void fdes(pmix_iof_format_t *p)
+{
+    if (NULL != p->data) {
+        free(p->data);
+    }
+    PMIX_LIST_DESTRUCT(&p->outputs);
+}
+static PMIX_CLASS_INSTANCE(pmix_iof_format_t, pmix_list_item_t, fcon, fdes);
+
+static pmix_list_t format_queue = PMIX_LIST_STATIC_INIT;
+static bool format_queue_ready = false;
+static pmix_event_base_t **format_evbases = NULL;
+static int nformat = 0;
+static int next_format = 0;
+static bool format_failed = false;
+static pmix_event_t format_kick;
+static int format_kick_pending = 0;
+
+static pmix_status_t format_output_line(const pmix_proc_t *name,
+                                        pmix_iof_flags_t *myflags,
+                                        pmix_iof_channel_t stream,
+                                        const pmix_byte_object_t *bo,
+                                        pmix_iof_write_output_t **out)
 {
     char starttag[PMIX_IOF_BASE_TAG_MAX], endtag[PMIX_IOF_BASE_TAG_MAX], *suffix;
     char timestamp[PMIX_IOF_BASE_TAG_MAX], outtag[PMIX_IOF_BASE_TAG_MAX];
     char begintag[PMIX_IOF_BASE_TAG_MAX];
     char **segments = NULL;
-    pmix_iof_write_output_t *output, *copy;
+    pmix_iof_write_output_t *output;
     size_t offset, j, n, m, bufsize;
-    char *buffer, qprint[15], *cptr;
+    char *buffer, qprint[15], *cptr, tbuf[64];
     const char *usestring;
     bool bufcopy;
     pmix_cb_t cb2;
@@ -1120,6 +1254,7 @@ static pmix_status_t write_output_line(const pmix_proc_t *name,
         PMIX_ERROR_LOG(PMIX_ERR_VALUE_OUT_OF_BOUNDS);
         PMIX_OUTPUT_VERBOSE((1, pmix_client_globals.iof_output, "%s stream %0x",
                              PMIX_NAME_PRINT(&pmix_globals.myid), stream));
+        PMIX_RELEASE(output);
         return PMIX_ERR_VALUE_OUT_OF_BOUNDS;
     }
 
@@ -1318,7 +1453,8 @@ static pmix_status_t write_output_line(const pmix_proc_t *name,
         time_t mytime;
         /* get the timestamp */
         time(&mytime);
-        cptr = ctime(&mytime);
+        /* may be running in a formatting thread */
+        cptr = ctime_r(&mytime, tbuf);
         cptr[strlen(cptr) - 1] = '\0'; /* remove trailing newline */
 
         if (myflags->xml && !myflags->tag && !myflags->rank) {
@@ -1442,24 +1578,45 @@ static pmix_status_t write_output_line(const pmix_proc_t *name,
     }
 
 process:
+    *out = output;
+    return PMIX_SUCCESS;
+}
+
+static pmix_iof_write_output_t *copy_output(pmix_iof_write_output_t *output)
+{
+    pmix_iof_write_output_t *copy;
+
+    copy = PMIX_NEW(pmix_iof_write_output_t);
+    if (NULL != output->buffer) {
+        PMIX_RETAIN(output->buffer);
+        copy->buffer = output->buffer;
+        copy->data = output->data;
+    } else {
+        copy->data = (char *) malloc(output->numbytes);
+        memcpy(copy->data, output->data, output->numbytes);
+    }
+    copy->numbytes = output->numbytes;
+    return copy;
+}
+
+static void append_output(pmix_iof_write_event_t *channel,
+                          bool copystdout, bool copystderr,
+                          pmix_iof_write_output_t *output)
+{
+    pmix_iof_write_output_t *copy;
+
     /* add this data to the write list for this fd */
     pmix_list_append(&channel->outputs, &output->super);
 
     if (copystdout){
-        copy = PMIX_NEW(pmix_iof_write_output_t);
-        copy->data = (char *) malloc(output->numbytes);
-        memcpy(copy->data, output->data, output->numbytes);
-        copy->numbytes = output->numbytes;
+        copy = copy_output(output);
         pmix_list_append(&pmix_client_globals.iof_stdout.wev.outputs, &copy->super);
         if (!pmix_client_globals.iof_stdout.wev.pending) {
             PMIX_IOF_SINK_ACTIVATE(&pmix_client_globals.iof_stdout.wev);
         }
     }
     if (copystderr){
-        copy = PMIX_NEW(pmix_iof_write_output_t);
-        copy->data = (char *) malloc(output->numbytes);
-        memcpy(copy->data, output->data, output->numbytes);
-        copy->numbytes = output->numbytes;
+        copy = copy_output(output);
         pmix_list_append(&pmix_client_globals.iof_stderr.wev.outputs, &copy->super);
         if (!pmix_client_globals.iof_stderr.wev.pending) {
             PMIX_IOF_SINK_ACTIVATE(&pmix_client_globals.iof_stderr.wev);
@@ -1474,10 +1631,273 @@ process:
                              PMIX_NAME_PRINT(&pmix_globals.myid)));
         PMIX_IOF_SINK_ACTIVATE(channel);
     }
+}
+
+/* hand over everything at the front of the queue that is ready */
+static void format_deliver(void)
+{
+    pmix_iof_format_t *fmt;
+    pmix_iof_write_output_t *output;
+
+    while (NULL != (fmt = (pmix_iof_format_t *) pmix_list_get_first(&format_queue))
+           && &fmt->super != pmix_list_get_end(&format_queue)
+           && __atomic_load_n(&fmt->ready, __ATOMIC_ACQUIRE)) {
+        pmix_list_remove_item(&format_queue, &fmt->super);
+        while (NULL != (output = (pmix_iof_write_output_t *) pmix_list_remove_first(&fmt->outputs))) {
+            append_output(fmt->channel, fmt->copystdout, fmt->copystderr, output);
+        }
+        PMIX_RELEASE(fmt);
+    }
+}
+
+static void format_kick_cb(int sd, short args, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    __atomic_store_n(&format_kick_pending, 0, __ATOMIC_SEQ_CST);
+    format_deliver();
+}
+
+/* runs in one of the formatting threads */
+static void format_lines(int sd, short args, void *cbdata)
+{
+    pmix_iof_format_t *fmt = (pmix_iof_format_t *) cbdata;
+    pmix_iof_write_output_t *output;
+    pmix_byte_object_t bopass;
+    char *ptr, *end, *eol;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(fmt);
+
+    ptr = fmt->data;
+    end = fmt->data + fmt->size;
+    while (ptr < end) {
+        eol = (char *) memchr(ptr, '\n', end - ptr);
+        if (NULL == eol) {
+            eol = end - 1;
+        }
+        bopass.bytes = ptr;
+        bopass.size = eol - ptr + 1;
+        if (PMIX_SUCCESS == format_output_line(&fmt->name, &fmt->flags, fmt->stream,
+                                               &bopass, &output)) {
+            pmix_list_append(&fmt->outputs, &output->super);
+        }
+        ptr = eol + 1;
+    }
+    __atomic_store_n(&fmt->ready, 1, __ATOMIC_RELEASE);
+
+    /* one wakeup covers everything finished before it is serviced */
+    if (0 == __atomic_exchange_n(&format_kick_pending, 1, __ATOMIC_SEQ_CST)) {
+        pmix_progress_thread_shift(&format_kick);
+    }
+}
+
+static void format_thread_name(int n, char *name, size_t len)
+{
+    snprintf(name, len, "PMIX-IOF-%d", n);
+}
+
+static bool format_start(void)
+{
+    char name[32];
+    int n;
+
+#if PMIX_HAVE_LIBEV
+    /* libev cannot be used across threads */
+    return false;
+#endif
+
+    if (0 < nformat) {
+        return true;
+    }
+    if (format_failed || 0 >= pmix_globals.iof_format_threads) {
+        return false;
+    }
+    format_evbases = (pmix_event_base_t **) calloc(pmix_globals.iof_format_threads,
+                                                   sizeof(pmix_event_base_t *));
+    if (NULL == format_evbases) {
+        format_failed = true;
+        return false;
+    }
+    if (!format_queue_ready) {
+        PMIX_CONSTRUCT(&format_queue, pmix_list_t);
+        format_queue_ready = true;
+    }
+    pmix_event_assign(&format_kick, pmix_globals.evbase, -1, EV_WRITE, format_kick_cb, NULL);
+    for (n = 0; n < pmix_globals.iof_format_threads; n++) {
+        format_thread_name(n, name, sizeof(name));
+        format_evbases[n] = pmix_progress_thread_init(name);
+        if (NULL == format_evbases[n]) {
+            break;
+        }
+        if (PMIX_SUCCESS != pmix_progress_thread_start(name)) {
+            (void) pmix_progress_thread_stop(name);
+            break;
+        }
+        ++nformat;
+    }
+    if (0 == nformat) {
+        PMIX_ERROR_LOG(PMIX_ERR_INIT);
+        free(format_evbases);
+        format_evbases = NULL;
+        format_failed = true;
+        return false;
+    }
+    PMIX_OUTPUT_VERBOSE((1, pmix_client_globals.iof_output,
+                         "%s iof: started %d formatting threads",
+                         PMIX_NAME_PRINT(&pmix_globals.myid), nformat));
+    return true;
+}
+
+/* pass complete lines to the formatting threads */
+static bool format_dispatch(const pmix_proc_t *name, pmix_iof_write_event_t *channel,
+                            pmix_iof_flags_t *myflags, pmix_iof_channel_t stream,
+                            bool copystdout, bool copystderr,
+                            const char *data, size_t size)
+{
+    pmix_iof_format_t *fmt;
+
+    if (!format_start()) {
+        return false;
+    }
+    fmt = PMIX_NEW(pmix_iof_format_t);
+    fmt->data = (char *) malloc(size);
+    if (NULL == fmt->data) {
+        PMIX_RELEASE(fmt);
+        return false;
+    }
+    memcpy(fmt->data, data, size);
+    fmt->size = size;
+    PMIX_XFER_PROCID(&fmt->name, name);
+    fmt->channel = channel;
+    memcpy(&fmt->flags, myflags, sizeof(pmix_iof_flags_t));
+    fmt->stream = stream;
+    fmt->copystdout = copystdout;
+    fmt->copystderr = copystderr;
+    pmix_list_append(&format_queue, &fmt->super);
+
+    pmix_event_assign(&fmt->ev, format_evbases[next_format], -1, EV_WRITE, format_lines, fmt);
+    next_format = (next_format + 1) % nformat;
+    PMIX_POST_OBJECT(fmt);
+    pmix_event_active(&fmt->ev, EV_WRITE, 1);
+    return true;
+}
+
+/* wait for the formatting threads to finish everything they were
+ * given and hand it all over - only to be called by the progress
+ * thread or while it is paused */
+static void format_drain(void)
+{
+    pmix_iof_format_t *fmt;
+
+    if (0 == pmix_list_get_size(&format_queue)) {
+        return;
+    }
+    PMIX_LIST_FOREACH (fmt, &format_queue, pmix_iof_format_t) {
+        while (!__atomic_load_n(&fmt->ready, __ATOMIC_ACQUIRE)) {
+            usleep(10);
+        }
+    }
+    format_deliver();
+}
+
+static void queue_output(pmix_iof_write_event_t *channel,
+                         bool copystdout, bool copystderr,
+                         pmix_iof_write_output_t *output)
+{
+    pmix_iof_format_t *fmt;
+
+    if (0 == pmix_list_get_size(&format_queue)) {
+        append_output(channel, copystdout, copystderr, output);
+        return;
+    }
+    /* earlier output is still being formatted, so wait behind it */
+    fmt = (pmix_iof_format_t *) pmix_list_get_last(&format_queue);
+    if (NULL != fmt->data || fmt->channel != channel ||
+        fmt->copystdout != copystdout || fmt->copystderr != copystderr) {
+        fmt = PMIX_NEW(pmix_iof_format_t);
+        fmt->channel = channel;
+        fmt->copystdout = copystdout;
+        fmt->copystderr = copystderr;
+        fmt->ready = 1;
+        pmix_list_append(&format_queue, &fmt->super);
+    }
+    pmix_list_append(&fmt->outputs, &output->super);
+}
 
+static pmix_status_t write_output_line(const pmix_proc_t *name,
+                                       pmix_iof_write_event_t *channel,
+                                       pmix_iof_flags_t *myflags,
+                                       pmix_iof_channel_t stream,
+                                       bool copystdout, bool copystderr,
+                                       const pmix_byte_object_t *bo)
+{
+    pmix_iof_write_output_t *output;
+    pmix_status_t rc;
+
+    rc = format_output_line(name, myflags, stream, bo, &output);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    queue_output(channel, copystdout, copystderr, output);
     return PMIX_SUCCESS;
 }
 
+/* stdin read by a launcher goes directly to each of its children
+ * that is among the targets, wildcard ranks included. The children
+ * all write from a single copy of the data. Returns true if any
+ * child was a target */
+static bool push_local_stdin(pmix_iof_read_event_t *rev, const pmix_byte_object_t *bo)
+{
+    pmix_pfexec_child_t *child;
+    pmix_iof_write_output_t *output;
+    pmix_iof_buffer_t *buf = NULL;
+    bool found = false;
+    size_t n;
+
+    PMIX_LIST_FOREACH (child, &pmix_pfexec_globals.children, pmix_pfexec_child_t) {
+        for (n = 0; n < rev->ntargets; n++) {
+            if (PMIX_CHECK_PROCID(&child->proc, &rev->targets[n])) {
+                break;
+            }
+        }
+        if (n == rev->ntargets) {
+            continue;
+        }
+        found = true;
+        output = PMIX_NEW(pmix_iof_write_output_t);
+        if (NULL == output) {
+            continue;
+        }
+        /* zero bytes are passed on as is so the fd
+         * gets closed once everything is written */
+        if (0 < bo->size) {
+            if (NULL == buf) {
+                buf = PMIX_NEW(pmix_iof_buffer_t);
+                if (NULL == buf) {
+                    PMIX_RELEASE(output);
+                    continue;
+                }
+                buf->bytes = (char *) malloc(bo->size);
+                if (NULL == buf->bytes) {
+                    PMIX_RELEASE(buf);
+                    PMIX_RELEASE(output);
+                    continue;
+                }
+                memcpy(buf->bytes, bo->bytes, bo->size);
+                buf->size = bo->size;
+            } else {
+                PMIX_RETAIN(buf);
+            }
+            output->buffer = buf;
+            output->data = buf->bytes;
+        }
+        output->numbytes = bo->size;
+        queue_output(&child->stdinsink.wev, false, false, output);
+    }
+    return found;
+}
+
 pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t stream,
                                     const pmix_byte_object_t *bo)
 {
@@ -1492,7 +1912,7 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
     bool copystderr = false;
     pmix_iof_sink_t *sink;
     pmix_iof_residual_t *res;
-    char *inputdata;
+    char *inputdata, *eol;
     size_t inputsize;
     bool copied;
 
@@ -1629,22 +2049,33 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
         }
     }
 
-    /* search the input data stream for '\n' */
+    /* find the end of the last complete line - anything after
+     * it is either passed raw or held until the line is done */
+    for (n = inputsize; 0 < n && '\n' != inputdata[n - 1]; n--) {
+        continue;
+    }
     start = 0;
-    for (n=0; n < inputsize; n++) {
-        if ('\n' == inputdata[n]) {
-            bopass.bytes = &inputdata[start];
-            bopass.size = n - start + 1;
-            rc = write_output_line(name, channel, &myflags, stream,
-                                   copystdout, copystderr, &bopass);
-            if (PMIX_SUCCESS != rc) {
-                if (copied) {
-                    free(inputdata);
-                }
-                return rc;
+    /* tagging can be left to the formatting threads, except when
+     * it requires data that only the progress thread can fetch */
+    if (0 < n && myflags.set && !myflags.tag_detailed &&
+        format_dispatch(name, channel, &myflags, stream, copystdout, copystderr,
+                        inputdata, n)) {
+        start = n;
+    }
+    /* search the input data stream for '\n' */
+    while (start < n) {
+        eol = (char *) memchr(&inputdata[start], '\n', n - start);
+        bopass.bytes = &inputdata[start];
+        bopass.size = eol - &inputdata[start] + 1;
+        rc = write_output_line(name, channel, &myflags, stream,
+                               copystdout, copystderr, &bopass);
+        if (PMIX_SUCCESS != rc) {
+            if (copied) {
+                free(inputdata);
             }
-            start = n + 1;
+            return rc;
         }
+        start += bopass.size;
     }
 
     if (start < inputsize) {
@@ -1703,6 +2134,9 @@ void pmix_iof_static_dump_output(pmix_iof_sink_t *sink)
     pmix_iof_write_event_t *wev = &sink->wev;
     pmix_iof_write_output_t *output;
 
+    /* collect anything still being formatted */
+    format_drain();
+
     if (!pmix_list_is_empty(&wev->outputs)) {
         dump = false;
         /* make one last attempt to write this out */
@@ -1725,7 +2159,10 @@ void pmix_iof_write_handler(int sd, short args, void *cbdata)
     pmix_iof_write_event_t *wev = &sink->wev;
     pmix_list_item_t *item;
     pmix_iof_write_output_t *output;
-    int num_written, total_written = 0;
+    struct iovec iov[PMIX_IOF_SINK_IOV_MAX];
+    int iovcnt;
+    ssize_t num_written, remaining;
+    size_t total_written = 0;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(sink);
@@ -1734,22 +2171,32 @@ void pmix_iof_write_handler(int sd, short args, void *cbdata)
                          "%s write:handler writing data to %d",
                          PMIX_NAME_PRINT(&pmix_globals.myid), wev->fd));
 
-    while (NULL != (item = pmix_list_remove_first(&wev->outputs))) {
-        output = (pmix_iof_write_output_t *) item;
-        if (0 == output->numbytes) {
-            /* don't reactivate the event */
-            PMIX_RELEASE(output);
+    while (!pmix_list_is_empty(&wev->outputs)) {
+        /* gather everything queued ahead of any close
+         * marker so it goes out in a single call */
+        iovcnt = 0;
+        PMIX_LIST_FOREACH (output, &wev->outputs, pmix_iof_write_output_t) {
+            if (0 == output->numbytes || PMIX_IOF_SINK_IOV_MAX == iovcnt) {
+                break;
+            }
+            iov[iovcnt].iov_base = output->data;
+            iov[iovcnt].iov_len = output->numbytes;
+            ++iovcnt;
+        }
+        if (0 == iovcnt) {
+            /* the first item is a zero-byte marker - don't
+             * reactivate the event */
+            item = pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(item);
             if (2 < wev->fd) {  // close the channel
                 close(wev->fd);
                 wev->fd = -1;
             }
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+        num_written = writev(wev->fd, iov, iovcnt);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                pmix_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
                     pmix_output(0, "IO Forwarding is running too far behind - something is "
@@ -1771,31 +2218,43 @@ void pmix_iof_write_handler(int sd, short args, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
-            PMIX_RELEASE(output);
+            item = pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(item);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
-            /* incomplete write - adjust data to avoid duplicate output */
-            memmove(output->data, &output->data[num_written], output->numbytes - num_written);
-            /* adjust the number of bytes remaining to be written */
-            output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            pmix_list_prepend(&wev->outputs, item);
-            /* if the list is getting too large, abort */
-            if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
-                pmix_output(0, "IO Forwarding is running too far behind - something is blocking us "
-                               "from writing");
-                goto ABORT;
-            }
-            /* leave the write event running so it will call us again
-             * when the fd is ready
-             */
-            wev->numtries = 0;
-            goto NEXT_CALL;
         }
-        PMIX_RELEASE(output);
         wev->numtries = 0;
-
         total_written += num_written;
+
+        /* release everything that was completely written */
+        remaining = num_written;
+        while (0 < remaining) {
+            output = (pmix_iof_write_output_t *) pmix_list_get_first(&wev->outputs);
+            if (remaining < output->numbytes) {
+                /* incomplete write - adjust data to avoid duplicate output */
+                if (NULL != output->buffer) {
+                    /* others may still need the whole buffer */
+                    output->data += remaining;
+                } else {
+                    memmove(output->data, &output->data[remaining], output->numbytes - remaining);
+                }
+                /* adjust the number of bytes remaining to be written */
+                output->numbytes -= remaining;
+                /* if the list is getting too large, abort */
+                if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
+                    pmix_output(0, "IO Forwarding is running too far behind - something is "
+                                   "blocking us from writing");
+                    goto ABORT;
+                }
+                /* leave the write event running so it will call us again
+                 * when the fd is ready
+                 */
+                goto NEXT_CALL;
+            }
+            remaining -= output->numbytes;
+            item = pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(item);
+        }
+
         if (wev->always_writable && (PMIX_IOF_SINK_BLOCKSIZE <= total_written)) {
             /* If this is a regular file it will never tell us it will block
              * Write no more than PMIX_IOF_SINK_BLOCKSIZE at a time to allow
@@ -1886,11 +2345,159 @@ static void opcbfn(pmix_status_t status, void *cbdata)
     PMIX_BYTE_OBJECT_FREE(boptr, 1);
 }
 
+/* Scratch space for the local read handler. Read events only fire
+ * in the progress thread, and everything done with the data copies
+ * what it keeps, so one buffer serves all of the channels. Reading
+ * as much as the channel holds in one go means chatty procs cost
+ * one pass through the output path per pipe-full rather than per
+ * PMIX_IOF_BASE_MSG_MAX bytes */
+static unsigned char *iof_readbuf = NULL;
+static size_t iof_readbuf_size = 0;
+
+static bool grow_readbuf(size_t size)
+{
+    unsigned char *data;
+
+    if (iof_readbuf_size >= size) {
+        return true;
+    }
+    data = (unsigned char *) realloc(iof_readbuf, size);
+    if (NULL == data) {
+        return false;
+    }
+    iof_readbuf = data;
+    iof_readbuf_size = size;
+    return true;
+}
+
+/* Take what a channel holds in one pass, so a chatty proc costs one
+ * message through the output path per pass rather than per read. The
+ * pass keeps reading while FIONREAD says there is more - which also
+ * keeps it from blocking on a channel that is not non-blocking - and
+ * grows its buffer while the channel keeps it full, up to
+ * pmix_iof_read_max. It stops after pmix_iof_flush_usec so a channel
+ * that never drains still has its output passed on. The size a pass
+ * ends up with is where the next one starts, shrinking again when the
+ * traffic drops. Returns the bytes read, or the result of the failed
+ * read if there were none - data is left NULL if there is no buffer
+ * to read into */
+static int32_t read_pass(pmix_iof_read_event_t *rev, int fd, unsigned char **data)
+{
+    size_t size, base, max, target, total = 0;
+    struct timeval start, now;
+    ssize_t n;
+#ifdef FIONREAD
+    int avail;
+#endif
+
+    max = pmix_globals.iof_read_max;
+    if (max > INT32_MAX) {
+        max = INT32_MAX;
+    }
+    base = pmix_globals.iof_read_size;
+    if (base < PMIX_IOF_BASE_MSG_MAX) {
+        base = PMIX_IOF_BASE_MSG_MAX;
+    } else if (base > INT32_MAX) {
+        base = INT32_MAX;
+    }
+    if (max < base) {
+        max = base;
+    }
+    size = (0 == rev->readsize) ? base : rev->readsize;
+    if (!grow_readbuf(size)) {
+        /* stick with what we have, if anything */
+        if (0 == iof_readbuf_size) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+            return -1;
+        }
+        size = iof_readbuf_size;
+    }
+    gettimeofday(&start, NULL);
+
+    while (1) {
+        n = read(fd, iof_readbuf + total, size - total);
+        if (0 >= n) {
+            if (0 == total) {
+                *data = iof_readbuf;
+                return (int32_t) n;
+            }
+            /* pass on what we have - the event fires again
+             * for the rest, or the close */
+            break;
+        }
+        total += n;
+        if (total == size) {
+            /* the channel kept up with us */
+            target = (2 * size > max) ? max : 2 * size;
+            if (size >= max || !grow_readbuf(target)) {
+                break;
+            }
+            size = target;
+        }
+#ifdef FIONREAD
+        if (0 != ioctl(fd, FIONREAD, &avail) || 0 >= avail) {
+            break;
+        }
+        if ((size_t) avail > size - total && size < max) {
+            target = (total + avail > max) ? max : total + avail;
+            if (grow_readbuf(target)) {
+                size = target;
+            }
+        }
+#else
+        break;
+#endif
+        gettimeofday(&now, NULL);
+        if ((now.tv_sec - start.tv_sec) * 1000000 + (now.tv_usec - start.tv_usec)
+            >= pmix_globals.iof_flush_usec) {
+            break;
+        }
+    }
+
+    /* start the next pass where this one ended */
+    if (total < size / 4 && size / 2 >= base) {
+        rev->readsize = size / 2;
+    } else {
+        rev->readsize = size;
+    }
+    *data = iof_readbuf;
+    return (int32_t) total;
+}
+
+void pmix_iof_finalize(void)
+{
+    char name[32];
+    int n;
+
+    format_drain();
+    for (n = 0; n < nformat; n++) {
+        format_thread_name(n, name, sizeof(name));
+        (void) pmix_progress_thread_stop(name);
+    }
+    nformat = 0;
+    next_format = 0;
+    format_failed = false;
+    if (format_queue_ready) {
+        PMIX_LIST_DESTRUCT(&format_queue);
+        format_queue_ready = false;
+    }
+    if (NULL != format_evbases) {
+        free(format_evbases);
+        format_evbases = NULL;
+    }
+
+    if (NULL != iof_readbuf) {
+        free(iof_readbuf);
+        iof_readbuf = NULL;
+    }
+    iof_readbuf_size = 0;
+}
+
 /* this is the read handler for stdin */
 void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
 {
     pmix_iof_read_event_t *rev = (pmix_iof_read_event_t *) cbdata;
-    unsigned char data[PMIX_IOF_BASE_MSG_MAX];
+    unsigned char *data = NULL;
     int32_t numbytes;
     pmix_status_t rc;
     pmix_buffer_t *msg;
@@ -1907,9 +2514,10 @@ void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
     } else {
         fd = rev->fd;
     }
-    /* read up to the fragment size */
-    memset(data, 0, PMIX_IOF_BASE_MSG_MAX);
-    numbytes = read(fd, data, sizeof(data));
+    numbytes = read_pass(rev, fd, &data);
+    if (NULL == data) {
+        return;
+    }
 
     /* The event has fired, so it's no longer active until we
      re-add it */
@@ -1969,15 +2577,8 @@ void pmix_iof_read_local_handler(int sd, short args, void *cbdata)
      * for a child of ours that matches this target - this has precedence over
      * anything else */
     if (PMIX_PEER_IS_LAUNCHER(pmix_globals.mypeer)) {
-        if (rev == stdinev_global && NULL != rev->targets) {
-            PMIX_LIST_FOREACH(child, &pmix_pfexec_globals.children, pmix_pfexec_child_t) {
-                if (PMIX_CHECK_PROCID(&child->proc, &rev->targets[0])) {
-                    /* send the input to that target */
-                    rc = write_output_line(&child->proc, &child->stdinsink.wev, NULL,
-                                           PMIX_FWD_STDIN_CHANNEL, false, false, &bo);
-                    goto reactivate;
-                }
-            }
+        if (rev == stdinev_global && NULL != rev->targets && push_local_stdin(rev, &bo)) {
+            goto reactivate;
         }
     }
 
@@ -2107,6 +2708,7 @@ static void iof_read_event_construct(pmix_iof_read_event_t *rev)
     rev->active = false;
     rev->childproc = NULL;
     rev->always_readable = false;
+    rev->readsize = 0;
     rev->targets = NULL;
     rev->ntargets = 0;
     rev->directives = NULL;
@@ -2165,10 +2767,13 @@ static void wocon(pmix_iof_write_output_t *p)
 {
     p->data = NULL;
     p->numbytes = 0;
+    p->buffer = NULL;
 }
 static void wodes(pmix_iof_write_output_t *p)
 {
-    if (NULL != p->data) {
+    if (NULL != p->buffer) {
+        PMIX_RELEASE(p->buffer);
+    } else if (NULL != p->data) {
         free(p->data);
     }
 }
@@ -2176,6 +2781,21 @@ PMIX_CLASS_INSTANCE(pmix_iof_write_output_t,
                     pmix_list_item_t,
                     wocon, wodes);
 
+static void bufcon(pmix_iof_buffer_t *p)
+{
+    p->bytes = NULL;
+    p->size = 0;
+}
+static void bufdes(pmix_iof_buffer_t *p)
+{
+    if (NULL != p->bytes) {
+        free(p->bytes);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_iof_buffer_t,
+                    pmix_object_t,
+                    bufcon, bufdes);
+
 static void iofrescon(pmix_iof_residual_t *p)
 {
     PMIX_BYTE_OBJECT_CONSTRUCT(&p->bo);
@@ -55,6 +55,10 @@
 
 BEGIN_C_DECLS
 
+/* internal flag set on the channel of forwarded output whose
+ * data was compressed by the sender */
+#define PMIX_IOF_COMPRESSED_CHANNEL 0x8000
+
 /*
  * Maximum size of single msg
  */
@@ -107,10 +111,22 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_sink_t);
     .closed = false                             \
 }
 
+/* data written unchanged to several sinks - e.g., stdin going to
+ * many local procs - is held once and shared by their outputs */
+typedef struct {
+    pmix_object_t super;
+    char *bytes;
+    size_t size;
+} pmix_iof_buffer_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_buffer_t);
+
 typedef struct {
     pmix_list_item_t super;
     char *data;
     int numbytes;
+    /* if set, data points into this shared buffer and
+     * is not owned by the output */
+    pmix_iof_buffer_t *buffer;
 } pmix_iof_write_output_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_write_output_t);
 
@@ -122,6 +138,8 @@ typedef struct {
     bool active;
     void *childproc;
     bool always_readable;
+    /* bytes to take in the next pass - adapted to the traffic */
+    size_t readsize;
     pmix_proc_t name;
     pmix_iof_channel_t channel;
     pmix_proc_t *targets;
@@ -153,6 +171,9 @@ static inline bool pmix_iof_fd_always_ready(int fd)
 
 #define PMIX_IOF_SINK_BLOCKSIZE (1024)
 
+/* max number of queued outputs gathered into a single writev */
+#define PMIX_IOF_SINK_IOV_MAX 64
+
 #define PMIX_IOF_SINK_ACTIVATE(w)                                      \
     do {                                                               \
         struct timeval *tv = NULL;                                     \
@@ -275,8 +296,14 @@ PMIX_EXPORT pmix_status_t pmix_iof_process_iof(pmix_iof_channel_t channels,
                                                const pmix_byte_object_t *bo,
                                                const pmix_info_t *info, size_t ninfo,
                                                const pmix_iof_req_t *req);
+PMIX_EXPORT bool pmix_iof_compress(pmix_peer_t *peer, pmix_iof_channel_t *channel,
+                                   const pmix_byte_object_t *bo, pmix_byte_object_t *out);
+PMIX_EXPORT pmix_status_t pmix_iof_decompress(pmix_iof_channel_t *channel,
+                                              const pmix_byte_object_t *bo,
+                                              pmix_byte_object_t *out);
 PMIX_EXPORT void pmix_iof_check_flags(pmix_info_t *info, pmix_iof_flags_t *flags);
 PMIX_EXPORT void pmix_iof_flush_residuals(void);
+PMIX_EXPORT void pmix_iof_finalize(void);
 
 END_C_DECLS
 
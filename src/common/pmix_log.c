@@ -18,6 +18,10 @@
 #include "src/include/pmix_socket_errno.h"
 #include "src/include/pmix_stdint.h"
 
+#ifdef HAVE_SYSLOG_H
+#    include <syslog.h>
+#endif
+
 #include "include/pmix.h"
 #include "pmix_common.h"
 #include "include/pmix_server.h"
@@ -33,8 +37,47 @@
 
 #include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
+#include "src/runtime/pmix_rte.h"
 #include "src/server/pmix_server_ops.h"
 
+#ifndef LOG_ERR
+#    define LOG_ERR 3
+#endif
+
+/* Non-blocking log requests from a client are held briefly and sent
+ * to the server as a single PMIX_LOG_BATCH_CMD message. Each entry
+ * keeps its own data and directives (including PMIX_LOG_ONCE), so
+ * the server handles them exactly as it would individual requests.
+ * Blocking requests and those of high syslog priority push out
+ * everything queued ahead of them at once. Only accessed from the
+ * progress thread */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_buffer_t *msg;
+    bool urgent;
+    pmix_op_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_log_entry_t;
+static void lecon(pmix_log_entry_t *p)
+{
+    p->msg = NULL;
+    p->urgent = false;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void ledes(pmix_log_entry_t *p)
+{
+    if (NULL != p->msg) {
+        PMIX_RELEASE(p->msg);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_log_entry_t, pmix_list_item_t, lecon, ledes);
+
+static pmix_list_t pending = PMIX_LIST_STATIC_INIT;
+static pmix_event_t flush_ev;
+static bool flush_armed = false;
+
 static void opcbfunc(pmix_status_t status, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
@@ -63,6 +106,175 @@ static void log_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
     PMIX_RELEASE(cd);
 }
 
+static void logbatch_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                            pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_list_t *sent = (pmix_list_t *) cbdata;
+    pmix_log_entry_t *entry;
+    int32_t m;
+    pmix_status_t rc, status, ret;
+    PMIX_HIDE_UNUSED_PARAMS(hdr);
+
+    /* unpack the overall status */
+    m = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &status, &m, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        status = rc;
+    }
+
+    /* the server replies for each entry in the order sent */
+    while (NULL != (entry = (pmix_log_entry_t *) pmix_list_remove_first(sent))) {
+        ret = status;
+        if (PMIX_SUCCESS == status) {
+            m = 1;
+            PMIX_BFROPS_UNPACK(rc, peer, buf, &ret, &m, PMIX_STATUS);
+            if (PMIX_SUCCESS != rc) {
+                ret = rc;
+            }
+        }
+        if (NULL != entry->cbfunc) {
+            entry->cbfunc(ret, entry->cbdata);
+        }
+        PMIX_RELEASE(entry);
+    }
+    PMIX_RELEASE(sent);
+}
+
+static void send_pending(void)
+{
+    pmix_log_entry_t *entry;
+    pmix_shift_caddy_t *cd;
+    pmix_list_t *sent;
+    pmix_buffer_t *msg;
+    pmix_byte_object_t bo;
+    pmix_cmd_t cmd = PMIX_LOG_BATCH_CMD;
+    pmix_status_t rc;
+    size_t n;
+
+    if (flush_armed) {
+        pmix_event_del(&flush_ev);
+        flush_armed = false;
+    }
+
+    n = pmix_list_get_size(&pending);
+    if (1 < n) {
+        msg = PMIX_NEW(pmix_buffer_t);
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &n, 1, PMIX_SIZE);
+        }
+        PMIX_LIST_FOREACH (entry, &pending, pmix_log_entry_t) {
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            bo.bytes = entry->msg->base_ptr;
+            bo.size = entry->msg->bytes_used;
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &bo, 1, PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            pmix_output_verbose(2, pmix_plog_base_framework.framework_output,
+                                "pmix:log sending %lu requests to server in one message",
+                                (unsigned long) n);
+            /* the reply callback takes over the entries */
+            sent = PMIX_NEW(pmix_list_t);
+            pmix_list_join(sent, pmix_list_get_end(sent), &pending);
+            PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, logbatch_cbfunc,
+                               (void *) sent);
+            if (PMIX_SUCCESS == rc) {
+                return;
+            }
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(msg);
+            while (NULL != (entry = (pmix_log_entry_t *) pmix_list_remove_first(sent))) {
+                if (NULL != entry->cbfunc) {
+                    entry->cbfunc(rc, entry->cbdata);
+                }
+                PMIX_RELEASE(entry);
+            }
+            PMIX_RELEASE(sent);
+            return;
+        }
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+    }
+
+    /* send them one at a time */
+    while (NULL != (entry = (pmix_log_entry_t *) pmix_list_remove_first(&pending))) {
+        cd = PMIX_NEW(pmix_shift_caddy_t);
+        cd->cbfunc.opcbfn = entry->cbfunc;
+        cd->cbdata = entry->cbdata;
+        PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, entry->msg, log_cbfunc,
+                           (void *) cd);
+        if (PMIX_SUCCESS == rc) {
+            /* the ptl owns the message now */
+            entry->msg = NULL;
+        } else {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(cd);
+            if (NULL != entry->cbfunc) {
+                entry->cbfunc(rc, entry->cbdata);
+            }
+        }
+        PMIX_RELEASE(entry);
+    }
+}
+
+static void flush_timeout(int sd, short args, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    flush_armed = false;
+    send_pending();
+}
+
+static void enqueue(int sd, short args, void *cbdata)
+{
+    pmix_log_entry_t *entry = (pmix_log_entry_t *) cbdata;
+    struct timeval tv;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(entry);
+
+    pmix_list_append(&pending, &entry->super);
+    if (entry->urgent
+        || pmix_client_globals.log_batch_max <= (int) pmix_list_get_size(&pending)) {
+        send_pending();
+        return;
+    }
+    if (!flush_armed) {
+        tv.tv_sec = pmix_client_globals.log_batch_delay / 1000;
+        tv.tv_usec = (pmix_client_globals.log_batch_delay % 1000) * 1000;
+        pmix_event_evtimer_set(pmix_globals.evbase, &flush_ev, flush_timeout, NULL);
+        pmix_event_evtimer_add(&flush_ev, &tv);
+        flush_armed = true;
+    }
+}
+
+static void flushop(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    send_pending();
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+/* push out any requests still being held - must not be
+ * called from the progress thread */
+void pmix_log_flush(void)
+{
+    pmix_cb_t cb;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    PMIX_THREADSHIFT(&cb, flushop);
+    PMIX_WAIT_THREAD(&cb.lock);
+    PMIX_DESTRUCT(&cb);
+}
+
+static pmix_status_t log_nb(const pmix_info_t data[], size_t ndata,
+                            const pmix_info_t directives[], size_t ndirs, bool urgent,
+                            pmix_op_cbfunc_t cbfunc, void *cbdata);
+
 PMIX_EXPORT pmix_status_t PMIx_Log(const pmix_info_t data[], size_t ndata,
                                    const pmix_info_t directives[], size_t ndirs)
 {
@@ -80,7 +292,8 @@ PMIX_EXPORT pmix_status_t PMIx_Log(const pmix_info_t data[], size_t ndata,
      * recv routine so we know which callback to use when
      * the return message is recvd */
     PMIX_CONSTRUCT(&cb, pmix_cb_t);
-    rc = PMIx_Log_nb(data, ndata, directives, ndirs, opcbfunc, &cb);
+    /* the caller is waiting, so don't hold the request */
+    rc = log_nb(data, ndata, directives, ndirs, true, opcbfunc, &cb);
     if (PMIX_SUCCESS == rc) {
         /* wait for the operation to complete */
         PMIX_WAIT_THREAD(&cb.lock);
@@ -126,6 +339,14 @@ void pmix_log_local_op(int sd, short args, void *cbdata_)
     size_t n;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
+    rc = pmix_rte_open_plog();
+    if (PMIX_SUCCESS != rc) {
+        if (NULL != cbfunc) {
+            cbfunc(rc, cbdata);
+        }
+        return;
+    }
+
     /* if no recorded source was found, then we must be it */
     if (NULL == source) {
         source = &pmix_globals.myid;
@@ -159,7 +380,13 @@ void pmix_log_local_op(int sd, short args, void *cbdata_)
 PMIX_EXPORT pmix_status_t PMIx_Log_nb(const pmix_info_t data[], size_t ndata,
                                       const pmix_info_t directives[], size_t ndirs,
                                       pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    return log_nb(data, ndata, directives, ndirs, false, cbfunc, cbdata);
+}
 
+static pmix_status_t log_nb(const pmix_info_t data[], size_t ndata,
+                            const pmix_info_t directives[], size_t ndirs, bool urgent,
+                            pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
     pmix_cmd_t cmd = PMIX_LOG_CMD;
     pmix_buffer_t *msg;
@@ -167,6 +394,7 @@ PMIX_EXPORT pmix_status_t PMIx_Log_nb(const pmix_info_t data[], size_t ndata,
     time_t timestamp = 0;
     pmix_proc_t *source = NULL;
     pmix_shift_caddy_t *cd;
+    pmix_log_entry_t *entry;
 
     pmix_output_verbose(2, pmix_globals.debug_output, "pmix:log non-blocking");
 
@@ -189,6 +417,11 @@ PMIX_EXPORT pmix_status_t PMIx_Log_nb(const pmix_info_t data[], size_t ndata,
                 }
             } else if (0 == strncmp(directives[n].key, PMIX_LOG_SOURCE, PMIX_MAX_KEYLEN)) {
                 source = directives[n].value.data.proc;
+            } else if (0 == strncmp(directives[n].key, PMIX_LOG_SYSLOG_PRI, PMIX_MAX_KEYLEN)) {
+                /* don't hold back anything of error severity or worse */
+                if (LOG_ERR >= directives[n].value.data.integer) {
+                    urgent = true;
+                }
             }
         }
     }
@@ -259,6 +492,19 @@ PMIX_EXPORT pmix_status_t PMIx_Log_nb(const pmix_info_t data[], size_t ndata,
             }
         }
 
+        if (1 < pmix_client_globals.log_batch_max
+            && !PMIX_PEER_IS_EARLIER(pmix_client_globals.myserver, 5, 0, 0)) {
+            /* hold it for aggregation with others */
+            PMIX_RELEASE(cd);
+            entry = PMIX_NEW(pmix_log_entry_t);
+            entry->msg = msg;
+            entry->urgent = urgent;
+            entry->cbfunc = cbfunc;
+            entry->cbdata = cbdata;
+            PMIX_THREADSHIFT(entry, enqueue);
+            return PMIX_SUCCESS;
+        }
+
         pmix_output_verbose(2, pmix_plog_base_framework.framework_output,
                             "pmix:log sending to server");
         PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, log_cbfunc, (void *) cd);
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2021-2022 Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_TYPES_H
+#    include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include "src/common/pmix_modex_shmem.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_name_fns.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
+#include "src/util/pmix_shmem.h"
+#include "src/util/pmix_string_copy.h"
+
+/* segment layout - all offsets are relative to the start of the
+ * segment so that it can be mapped at any address:
+ *
+ *     header
+ *     entries[nentries]    sorted by (nsidx, rank)
+ *     nspaces[nnspaces]
+ *     blobs
+ */
+#define PMIX_MODEX_SHMEM_MAGIC 0x7865646f6d786d70ULL
+
+typedef struct {
+    uint64_t magic;
+    uint64_t nentries;
+    uint64_t nnspaces;
+    uint64_t nspaces_offset;
+} pmix_modex_shmem_hdr_t;
+
+typedef struct {
+    uint32_t nsidx;
+    uint32_t rank;
+    uint64_t offset;
+    uint64_t size;
+} pmix_modex_shmem_entry_t;
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    pmix_shmem_t *shmem;
+} pmix_modex_shmem_seg_t;
+static void sgcon(pmix_modex_shmem_seg_t *p)
+{
+    memset(p->nspace, 0, sizeof(p->nspace));
+    p->shmem = NULL;
+}
+static void sgdes(pmix_modex_shmem_seg_t *p)
+{
+    if (NULL != p->shmem) {
+        PMIX_RELEASE(p->shmem);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_modex_shmem_seg_t,
+                           pmix_list_item_t,
+                           sgcon, sgdes);
+
+static void blcon(pmix_modex_shmem_blob_t *p)
+{
+    PMIX_LOAD_PROCID(&p->proc, NULL, PMIX_RANK_UNDEF);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->blob);
+}
+static void bldes(pmix_modex_shmem_blob_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->blob);
+}
+PMIX_CLASS_INSTANCE(pmix_modex_shmem_blob_t,
+                    pmix_list_item_t,
+                    blcon, bldes);
+
+/* the segments we either published (server) or
+ * attached to (client), most recent first */
+static pmix_list_t segments;
+static bool initialized = false;
+static uint32_t nsegs = 0;
+
+static void add_segment(pmix_modex_shmem_seg_t *seg)
+{
+    if (!initialized) {
+        PMIX_CONSTRUCT(&segments, pmix_list_t);
+        initialized = true;
+    }
+    pmix_list_prepend(&segments, &seg->super);
+}
+
+#define PMIX_MODEX_SHMEM_ALIGN(n) (((n) + 7) & ~(size_t) 7)
+
+static int entcmp(const void *a, const void *b)
+{
+    const pmix_modex_shmem_entry_t *ea = (const pmix_modex_shmem_entry_t *) a;
+    const pmix_modex_shmem_entry_t *eb = (const pmix_modex_shmem_entry_t *) b;
+
+    if (ea->nsidx != eb->nsidx) {
+        return (ea->nsidx < eb->nsidx) ? -1 : 1;
+    }
+    if (ea->rank != eb->rank) {
+        return (ea->rank < eb->rank) ? -1 : 1;
+    }
+    return 0;
+}
+
+pmix_status_t pmix_modex_shmem_publish(const char *nspace,
+                                       const char *basedir,
+                                       pmix_list_t *blobs,
+                                       char **path)
+{
+    pmix_modex_shmem_blob_t *bl;
+    pmix_modex_shmem_seg_t *seg;
+    pmix_modex_shmem_hdr_t *hdr;
+    pmix_modex_shmem_entry_t *ents;
+    pmix_nspace_t *nspaces;
+    char *fname = NULL;
+    uint8_t *base;
+    uintptr_t addr;
+    size_t n, m, nents, nns = 0, offset, size;
+    pmix_status_t rc;
+
+    *path = NULL;
+    nents = pmix_list_get_size(blobs);
+    if (0 == nents) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    /* the participants typically come from a handful of nspaces,
+     * so a linear search for each blob's nspace is fine */
+    nspaces = (pmix_nspace_t *) calloc(nents, sizeof(pmix_nspace_t));
+    ents = (pmix_modex_shmem_entry_t *) calloc(nents, sizeof(pmix_modex_shmem_entry_t));
+    if (NULL == nspaces || NULL == ents) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    size = 0;
+    n = 0;
+    PMIX_LIST_FOREACH (bl, blobs, pmix_modex_shmem_blob_t) {
+        for (m = 0; m < nns; m++) {
+            if (PMIX_CHECK_NSPACE(nspaces[m], bl->proc.nspace)) {
+                break;
+            }
+        }
+        if (m == nns) {
+            PMIX_LOAD_NSPACE(nspaces[nns], bl->proc.nspace);
+            ++nns;
+        }
+        ents[n].nsidx = m;
+        ents[n].rank = bl->proc.rank;
+        ents[n].size = bl->blob.size;
+        /* stash the blob's position in the list until we know
+         * where the blobs will start */
+        ents[n].offset = size;
+        size += PMIX_MODEX_SHMEM_ALIGN(bl->blob.size);
+        ++n;
+    }
+
+    offset = PMIX_MODEX_SHMEM_ALIGN(sizeof(pmix_modex_shmem_hdr_t))
+             + PMIX_MODEX_SHMEM_ALIGN(nents * sizeof(pmix_modex_shmem_entry_t))
+             + PMIX_MODEX_SHMEM_ALIGN(nns * sizeof(pmix_nspace_t));
+    size += offset;
+
+    if (0 > pmix_asprintf(&fname, "%s/pmix-modex.%s.%d.%u", basedir, nspace,
+                          (int) getpid(), nsegs)) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    seg = PMIX_NEW(pmix_modex_shmem_seg_t);
+    if (NULL == seg) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    PMIX_LOAD_NSPACE(seg->nspace, nspace);
+    seg->shmem = PMIX_NEW(pmix_shmem_t);
+    if (NULL == seg->shmem) {
+        PMIX_RELEASE(seg);
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    rc = pmix_shmem_segment_create(seg->shmem, size, fname);
+    if (PMIX_SUCCESS != rc) {
+        /* nothing was created, so there is nothing to unlink */
+        memset(seg->shmem->backing_path, 0, PMIX_PATH_MAX);
+        PMIX_RELEASE(seg);
+        goto cleanup;
+    }
+    rc = pmix_shmem_segment_attach(seg->shmem, NULL, &addr);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(seg);
+        goto cleanup;
+    }
+    base = (uint8_t *) seg->shmem->base_address;
+
+    /* copy the blobs in list order, then sort the index */
+    n = 0;
+    PMIX_LIST_FOREACH (bl, blobs, pmix_modex_shmem_blob_t) {
+        ents[n].offset += offset;
+        memcpy(base + ents[n].offset, bl->blob.bytes, bl->blob.size);
+        ++n;
+    }
+    qsort(ents, nents, sizeof(pmix_modex_shmem_entry_t), entcmp);
+    memcpy(base + PMIX_MODEX_SHMEM_ALIGN(sizeof(pmix_modex_shmem_hdr_t)), ents,
+           nents * sizeof(pmix_modex_shmem_entry_t));
+    memcpy(base + PMIX_MODEX_SHMEM_ALIGN(sizeof(pmix_modex_shmem_hdr_t))
+               + PMIX_MODEX_SHMEM_ALIGN(nents * sizeof(pmix_modex_shmem_entry_t)),
+           nspaces, nns * sizeof(pmix_nspace_t));
+    hdr = (pmix_modex_shmem_hdr_t *) base;
+    hdr->nentries = nents;
+    hdr->nnspaces = nns;
+    hdr->nspaces_offset = PMIX_MODEX_SHMEM_ALIGN(sizeof(pmix_modex_shmem_hdr_t))
+                          + PMIX_MODEX_SHMEM_ALIGN(nents * sizeof(pmix_modex_shmem_entry_t));
+    /* the magic goes in last - clients only attach after being
+     * told about the segment, but be conservative */
+    hdr->magic = PMIX_MODEX_SHMEM_MAGIC;
+    /* we never touch it again */
+    (void) mprotect(base, size, PROT_READ);
+
+    add_segment(seg);
+    ++nsegs;
+    *path = fname;
+    fname = NULL;
+
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "%s published %lu modex blobs for nspace %s in %s (%lu bytes)",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) nents,
+                        nspace, seg->shmem->backing_path, (unsigned long) size);
+
+cleanup:
+    if (NULL != fname) {
+        free(fname);
+    }
+    if (NULL != nspaces) {
+        free(nspaces);
+    }
+    if (NULL != ents) {
+        free(ents);
+    }
+    return rc;
+}
+
+void pmix_modex_shmem_release(const char *nspace)
+{
+    pmix_modex_shmem_seg_t *seg, *next;
+
+    if (!initialized) {
+        return;
+    }
+    PMIX_LIST_FOREACH_SAFE (seg, next, &segments, pmix_modex_shmem_seg_t) {
+        if (PMIX_CHECK_NSPACE(seg->nspace, nspace)) {
+            pmix_list_remove_item(&segments, &seg->super);
+            PMIX_RELEASE(seg);
+        }
+    }
+}
+
+pmix_status_t pmix_modex_shmem_attach(const char *path)
+{
+    pmix_modex_shmem_seg_t *seg;
+    pmix_modex_shmem_hdr_t *hdr;
+    struct stat sbuf;
+    uintptr_t addr;
+    size_t tblsize;
+    pmix_status_t rc;
+
+    if (0 != stat(path, &sbuf)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if ((size_t) sbuf.st_size < sizeof(pmix_modex_shmem_hdr_t)) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    seg = PMIX_NEW(pmix_modex_shmem_seg_t);
+    if (NULL == seg) {
+        return PMIX_ERR_NOMEM;
+    }
+    seg->shmem = PMIX_NEW(pmix_shmem_t);
+    if (NULL == seg->shmem) {
+        PMIX_RELEASE(seg);
+        return PMIX_ERR_NOMEM;
+    }
+    seg->shmem->size = (size_t) sbuf.st_size;
+    pmix_string_copy(seg->shmem->backing_path, path, PMIX_PATH_MAX);
+    rc = pmix_shmem_segment_attach(seg->shmem, NULL, &addr);
+    /* the segment belongs to the server - we must never unlink it */
+    memset(seg->shmem->backing_path, 0, PMIX_PATH_MAX);
+    if (PMIX_SUCCESS != rc) {
+        seg->shmem->base_address = NULL;
+        seg->shmem->size = 0;
+        PMIX_RELEASE(seg);
+        return rc;
+    }
+    (void) mprotect(seg->shmem->base_address, seg->shmem->size, PROT_READ);
+
+    /* sanity check what the server gave us */
+    hdr = (pmix_modex_shmem_hdr_t *) seg->shmem->base_address;
+    tblsize = hdr->nspaces_offset + hdr->nnspaces * sizeof(pmix_nspace_t);
+    if (PMIX_MODEX_SHMEM_MAGIC != hdr->magic || tblsize > seg->shmem->size
+        || hdr->nspaces_offset < hdr->nentries * sizeof(pmix_modex_shmem_entry_t)) {
+        PMIX_RELEASE(seg);
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    add_segment(seg);
+    return PMIX_SUCCESS;
+}
+
+bool pmix_modex_shmem_lookup(const pmix_proc_t *proc, pmix_byte_object_t *blob)
+{
+    pmix_modex_shmem_seg_t *seg;
+    pmix_modex_shmem_hdr_t *hdr;
+    pmix_modex_shmem_entry_t *ents, key;
+    pmix_nspace_t *nspaces;
+    uint8_t *base;
+    size_t n, lo, hi, mid;
+    int cmp;
+
+    if (!initialized) {
+        return false;
+    }
+    PMIX_LIST_FOREACH (seg, &segments, pmix_modex_shmem_seg_t) {
+        base = (uint8_t *) seg->shmem->base_address;
+        hdr = (pmix_modex_shmem_hdr_t *) base;
+        nspaces = (pmix_nspace_t *) (base + hdr->nspaces_offset);
+        for (n = 0; n < hdr->nnspaces; n++) {
+            if (PMIX_CHECK_NSPACE(nspaces[n], proc->nspace)) {
+                break;
+            }
+        }
+        if (n == hdr->nnspaces) {
+            continue;
+        }
+        key.nsidx = n;
+        key.rank = proc->rank;
+        ents = (pmix_modex_shmem_entry_t *) (base
+                                             + PMIX_MODEX_SHMEM_ALIGN(sizeof(pmix_modex_shmem_hdr_t)));
+        lo = 0;
+        hi = hdr->nentries;
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2;
+            cmp = entcmp(&key, &ents[mid]);
+            if (0 == cmp) {
+                if (ents[mid].offset + ents[mid].size > seg->shmem->size) {
+                    return false;
+                }
+                blob->bytes = (char *) (base + ents[mid].offset);
+                blob->size = ents[mid].size;
+                return true;
+            }
+            if (cmp < 0) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+    }
+    return false;
+}
+
+void pmix_modex_shmem_finalize(void)
+{
+    if (!initialized) {
+        return;
+    }
+    PMIX_LIST_DESTRUCT(&segments);
+    initialized = false;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021-2022 Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Shared-memory modex segments
+ *
+ * When a fence collects data, the server can write the blobs of the
+ * participants that are not local to it into a read-only segment that
+ * its local clients map directly. Each blob is stored exactly as the
+ * server would have returned it in response to a PMIX_GETNB_CMD, so a
+ * client can hand it to its GDS without asking the server. A segment
+ * is written once and never modified afterwards.
+ */
+
+#ifndef PMIX_MODEX_SHMEM_H
+#define PMIX_MODEX_SHMEM_H
+
+#include "src/include/pmix_config.h"
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+
+BEGIN_C_DECLS
+
+/* a blob to be published in a segment */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t proc;
+    pmix_byte_object_t blob;
+} pmix_modex_shmem_blob_t;
+PMIX_CLASS_DECLARATION(pmix_modex_shmem_blob_t);
+
+/* SERVER FN: write the given list of pmix_modex_shmem_blob_t into a
+ * new segment created in basedir on behalf of the clients
+ * in the given nspace. The caller is responsible for
+ * releasing the returned path */
+PMIX_EXPORT pmix_status_t pmix_modex_shmem_publish(const char *nspace,
+                                                   const char *basedir,
+                                                   pmix_list_t *blobs,
+                                                   char **path);
+
+/* SERVER FN: release all segments published on behalf
+ * of the given nspace */
+PMIX_EXPORT void pmix_modex_shmem_release(const char *nspace);
+
+/* CLIENT FN: map the segment at the given path */
+PMIX_EXPORT pmix_status_t pmix_modex_shmem_attach(const char *path);
+
+/* CLIENT FN: find the blob for the given proc in the attached
+ * segments, most recent first. The returned blob points
+ * into the segment and must not be modified or free'd */
+PMIX_EXPORT bool pmix_modex_shmem_lookup(const pmix_proc_t *proc,
+                                         pmix_byte_object_t *blob);
+
+/* release all segments */
+PMIX_EXPORT void pmix_modex_shmem_finalize(void);
+
+END_C_DECLS
+
+#endif /* PMIX_MODEX_SHMEM_H */
@@ -32,9 +32,12 @@
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_timings.h"
 
 #include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
+#include "src/runtime/pmix_progress_threads.h"
+#include "src/runtime/pmix_rte.h"
 #include "src/server/pmix_server_ops.h"
 
 /*
@@ -121,7 +124,6 @@ static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
     int cnt;
     size_t n;
     pmix_kval_t *kv;
-    PMIX_HIDE_UNUSED_PARAMS(hdr);
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix:query cback from server");
@@ -142,7 +144,7 @@ static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
         results->status = rc;
         goto complete;
     }
-    if (PMIX_SUCCESS != results->status) {
+    if (PMIX_SUCCESS != results->status && PMIX_QUERY_PARTIAL_SUCCESS != results->status) {
         goto complete;
     }
 
@@ -176,6 +178,24 @@ static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
     }
 
 complete:
+    if (PMIX_QUERY_PARTIAL_SUCCESS == results->status) {
+        /* one batch of a streamed answer - keep listening for the rest */
+        rc = pmix_ptl_base_repost_recv(hdr->tag, query_cbfunc, cd);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            results->status = rc;
+        } else {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                                "pmix:query cback from server with partial results");
+            if (NULL != cd->cbfunc) {
+                cd->cbfunc(results->status, results->info, results->ninfo, cd->cbdata,
+                           relcbfunc, results);
+            } else {
+                relcbfunc(results);
+            }
+            return;
+        }
+    }
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix:query cback from server releasing with status %s",
                         PMIx_Error_string(results->status));
@@ -190,19 +210,32 @@ static void qinfocb(pmix_status_t status, pmix_info_t info[], size_t ninfo, void
                     pmix_release_cbfunc_t release_fn, void *release_cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_info_t *tmp;
     size_t n;
 
-    cb->status = status;
-    if (NULL != info) {
-        cb->ninfo = ninfo;
-        PMIX_INFO_CREATE(cb->info, cb->ninfo);
+    /* a streamed answer arrives in batches - the blocking
+     * caller gets all of them at once */
+    if (NULL != info && 0 < ninfo) {
+        PMIX_INFO_CREATE(tmp, cb->ninfo + ninfo);
+        for (n = 0; n < cb->ninfo; n++) {
+            PMIX_INFO_XFER(&tmp[n], &cb->info[n]);
+        }
         for (n = 0; n < ninfo; n++) {
-            PMIX_INFO_XFER(&cb->info[n], &info[n]);
+            PMIX_INFO_XFER(&tmp[cb->ninfo + n], &info[n]);
         }
+        if (NULL != cb->info) {
+            PMIX_INFO_FREE(cb->info, cb->ninfo);
+        }
+        cb->info = tmp;
+        cb->ninfo += ninfo;
     }
     if (NULL != release_fn) {
         release_fn(release_cbdata);
     }
+    if (PMIX_QUERY_PARTIAL_SUCCESS == status) {
+        return;
+    }
+    cb->status = status;
     PMIX_WAKEUP_THREAD(&cb->lock);
 }
 
@@ -255,6 +288,16 @@ static void finalstep(pmix_status_t status, pmix_info_t info[], size_t ninfo, vo
     pmix_query_caddy_t *cd = (pmix_query_caddy_t*)cbdata;
     pmix_status_t rc;
 
+    /* the host is returning the answer in batches - more to come */
+    if (PMIX_QUERY_PARTIAL_SUCCESS == status) {
+        if (NULL != cd->cbfunc) {
+            cd->cbfunc(status, info, ninfo, cd->cbdata, release_fn, release_cbdata);
+        } else if (NULL != release_fn) {
+            release_fn(release_cbdata);
+        }
+        return;
+    }
+
     /* if the host satisfied the request, then we are done */
     if (PMIX_SUCCESS == status) {
         if (NULL != cd->cbfunc) {
@@ -365,6 +408,201 @@ static void _local_relcb(void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* look for the data in what we already hold - the job-level data
+ * our server gave us lives in its gds module (which may be a shared
+ * memory segment), anything else in our own */
+static pmix_status_t fetch_local(pmix_cb_t *cb)
+{
+    pmix_status_t rc;
+
+    if (!PMIX_PEER_IS_SERVER(pmix_globals.mypeer) && NULL != pmix_client_globals.myserver
+        && NULL != pmix_client_globals.myserver->nptr
+        && NULL != pmix_client_globals.myserver->nptr->compat.gds
+        && !PMIX_GDS_CHECK_COMPONENT(pmix_client_globals.myserver, "hash")) {
+        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, cb);
+        if (PMIX_SUCCESS == rc) {
+            return rc;
+        }
+    }
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+    return rc;
+}
+
+/* report the time we spent in each of our startup phases */
+static void startup_timing_query(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+    pmix_data_array_t *darray;
+    pmix_info_t *iptr;
+    double elapsed;
+    size_t n, p, m, nphases;
+    int phase;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    nphases = 0;
+    for (phase = 0; phase < PMIX_TIMING_PHASE_MAX; phase++) {
+        if (pmix_timing_phase_elapsed(phase, &elapsed)) {
+            ++nphases;
+        }
+    }
+
+    cd->ninfo = 0;
+    for (n = 0; n < cd->nqueries; n++) {
+        for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+            if (0 == strcmp(cd->queries[n].keys[p], PMIX_QUERY_STARTUP_TIMING)) {
+                ++cd->ninfo;
+            }
+        }
+    }
+    if (0 == cd->ninfo || 0 == nphases) {
+        cd->ninfo = 0;
+        cd->cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, cd->cbdata, _local_relcb, cd);
+        return;
+    }
+
+    PMIX_INFO_CREATE(cd->info, cd->ninfo);
+    for (m = 0; m < cd->ninfo; m++) {
+        PMIX_DATA_ARRAY_CREATE(darray, nphases, PMIX_INFO);
+        iptr = (pmix_info_t *) darray->array;
+        n = 0;
+        for (phase = 0; phase < PMIX_TIMING_PHASE_MAX; phase++) {
+            if (pmix_timing_phase_elapsed(phase, &elapsed)) {
+                PMIX_INFO_LOAD(&iptr[n], pmix_timing_phase_name(phase), &elapsed, PMIX_DOUBLE);
+                ++n;
+            }
+        }
+        PMIX_LOAD_KEY(cd->info[m].key, PMIX_QUERY_STARTUP_TIMING);
+        cd->info[m].value.type = PMIX_DATA_ARRAY;
+        cd->info[m].value.data.darray = darray;
+    }
+    cd->cbfunc(PMIX_SUCCESS, cd->info, cd->ninfo, cd->cbdata, _local_relcb, cd);
+}
+
+/* report the lag and callback profile of our progress threads */
+static void progress_query(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+    pmix_data_array_t *darray;
+    size_t n, p, m;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    cd->ninfo = 0;
+    for (n = 0; n < cd->nqueries; n++) {
+        for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+            if (0 == strcmp(cd->queries[n].keys[p], PMIX_QUERY_PROGRESS_LAG)
+                || 0 == strcmp(cd->queries[n].keys[p], PMIX_QUERY_PROGRESS_PROFILE)) {
+                ++cd->ninfo;
+            }
+        }
+    }
+    if (0 == cd->ninfo) {
+        cd->cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, cd->cbdata, _local_relcb, cd);
+        return;
+    }
+
+    PMIX_INFO_CREATE(cd->info, cd->ninfo);
+    m = 0;
+    for (n = 0; n < cd->nqueries; n++) {
+        for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+            if (0 == strcmp(cd->queries[n].keys[p], PMIX_QUERY_PROGRESS_LAG)) {
+                darray = pmix_progress_thread_lag_report();
+            } else if (0 == strcmp(cd->queries[n].keys[p], PMIX_QUERY_PROGRESS_PROFILE)) {
+                darray = pmix_progress_thread_profile_report();
+            } else {
+                continue;
+            }
+            if (NULL == darray) {
+                /* not profiling, or nothing to show yet */
+                continue;
+            }
+            PMIX_LOAD_KEY(cd->info[m].key, cd->queries[n].keys[p]);
+            cd->info[m].value.type = PMIX_DATA_ARRAY;
+            cd->info[m].value.data.darray = darray;
+            ++m;
+        }
+    }
+    if (0 == m) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+        cd->info = NULL;
+        cd->ninfo = 0;
+        cd->cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, cd->cbdata, _local_relcb, cd);
+        return;
+    }
+    cd->ninfo = m;
+    cd->cbfunc(PMIX_SUCCESS, cd->info, cd->ninfo, cd->cbdata, _local_relcb, cd);
+}
+
+/* report the objects alive in each class */
+static void memory_query(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+    pmix_class_t *head, *cls;
+    pmix_data_array_t *darray, *vals;
+    pmix_info_t *iptr;
+    uint64_t *u64;
+    int64_t live;
+    size_t n, p, m, nclasses;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    head = pmix_class_list();
+    nclasses = 0;
+    for (cls = head; NULL != cls; cls = cls->cls_next) {
+        if (0 < cls->cls_allocs) {
+            ++nclasses;
+        }
+    }
+
+    cd->ninfo = 0;
+    for (n = 0; n < cd->nqueries; n++) {
+        for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+            if (0 == strcmp(cd->queries[n].keys[p], PMIX_QUERY_OBJECT_USAGE)) {
+                ++cd->ninfo;
+            }
+        }
+    }
+    if (0 == cd->ninfo || 0 == nclasses) {
+        cd->ninfo = 0;
+        cd->cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, cd->cbdata, _local_relcb, cd);
+        return;
+    }
+
+    PMIX_INFO_CREATE(cd->info, cd->ninfo);
+    for (m = 0; m < cd->ninfo; m++) {
+        PMIX_DATA_ARRAY_CREATE(darray, nclasses, PMIX_INFO);
+        iptr = (pmix_info_t *) darray->array;
+        n = 0;
+        for (cls = head; NULL != cls && n < nclasses; cls = cls->cls_next) {
+            if (0 == cls->cls_allocs) {
+                continue;
+            }
+            live = __atomic_load_n(&cls->cls_live, __ATOMIC_RELAXED);
+            if (0 > live) {
+                live = 0;
+            }
+            PMIX_DATA_ARRAY_CREATE(vals, 3, PMIX_UINT64);
+            u64 = (uint64_t *) vals->array;
+            u64[0] = (uint64_t) live;
+            u64[1] = (uint64_t) live * cls->cls_sizeof;
+            u64[2] = __atomic_load_n(&cls->cls_allocs, __ATOMIC_RELAXED);
+            PMIX_LOAD_KEY(iptr[n].key, cls->cls_name);
+            iptr[n].value.type = PMIX_DATA_ARRAY;
+            iptr[n].value.data.darray = vals;
+            ++n;
+        }
+        darray->size = n;
+        PMIX_LOAD_KEY(cd->info[m].key, PMIX_QUERY_OBJECT_USAGE);
+        cd->info[m].value.type = PMIX_DATA_ARRAY;
+        cd->info[m].value.data.darray = darray;
+    }
+    cd->cbfunc(PMIX_SUCCESS, cd->info, cd->ninfo, cd->cbdata, _local_relcb, cd);
+}
+
 static void nxtcbfunc(pmix_status_t status, pmix_list_t *results, void *cbdata)
 {
     pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
@@ -419,8 +657,9 @@ static void localquery(int sd, short args, void *cbdata)
     size_t n, p;
     pmix_list_t results;
     pmix_kval_t *kv, *kvnxt;
-    pmix_proc_t proc;
+    pmix_proc_t proc, wild;
     bool rank_given = false;
+    char *psetname;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     /* setup the list of local results */
@@ -428,6 +667,7 @@ static void localquery(int sd, short args, void *cbdata)
 
     for (n = 0; n < nqueries; n++) {
         PMIX_LOAD_PROCID(&proc, NULL, PMIX_RANK_INVALID);
+        psetname = NULL;
         for (p = 0; p < queries[n].nqual; p++) {
             if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_PROCID)) {
                 PMIX_LOAD_NSPACE(proc.nspace, queries[n].qualifiers[p].value.data.proc->nspace);
@@ -438,6 +678,8 @@ static void localquery(int sd, short args, void *cbdata)
             } else if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_RANK)) {
                 proc.rank = queries[n].qualifiers[p].value.data.rank;
                 rank_given = true;
+            } else if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_PSET_NAME)) {
+                psetname = queries[n].qualifiers[p].value.data.string;
             }
         }
 
@@ -458,7 +700,7 @@ static void localquery(int sd, short args, void *cbdata)
             } else {
                 if (0 == strlen(proc.nspace)) {
                     /* use our nspace */
-                    PMIX_LOAD_NSPACE(cb.proc->nspace, pmix_globals.myid.nspace);
+                    PMIX_LOAD_NSPACE(proc.nspace, pmix_globals.myid.nspace);
                 }
                 if (PMIX_RANK_INVALID == proc.rank) {
                     /* user the wildcard rank */
@@ -482,8 +724,30 @@ static void localquery(int sd, short args, void *cbdata)
                 PMIx_Value_load(kv->value, PMIX_STD_ABI_PROVISIONAL_VERSION, PMIX_STRING);
                 pmix_list_append(&cb.kvs, &kv->super);
                 rc = PMIX_SUCCESS;
+            } else if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) &&
+                       0 == strcmp(queries[n].keys[p], PMIX_QUERY_PSET_MEMBERSHIP)) {
+                /* a server holds the process sets its host defined */
+                rc = pmix_server_pset_membership(psetname, &kv);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_DESTRUCT(&cb);
+                    goto nextstep;
+                }
+                pmix_list_append(&cb.kvs, &kv->super);
             } else {
-                PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+                rc = fetch_local(&cb);
+                if (PMIX_SUCCESS != rc && !rank_given) {
+                    /* not a node or app value - it may be one
+                     * describing the job (e.g., its size, number
+                     * of nodes, or local peers) */
+                    if (0 == strlen(proc.nspace)) {
+                        PMIX_LOAD_PROCID(&wild, pmix_globals.myid.nspace, PMIX_RANK_WILDCARD);
+                    } else {
+                        PMIX_LOAD_PROCID(&wild, proc.nspace, PMIX_RANK_WILDCARD);
+                    }
+                    cb.proc = &wild;
+                    rc = fetch_local(&cb);
+                    cb.proc = &proc;
+                }
                 if (PMIX_SUCCESS != rc) {
                     /* not in our gds */
                     PMIX_DESTRUCT(&cb);
@@ -502,7 +766,10 @@ static void localquery(int sd, short args, void *cbdata)
 nextstep:
     /* pass the queries thru our active plugins with query
      * interfaces to see if someone can resolve it */
-    rc = pmix_pstrg.query(queries, nqueries, &results, nxtcbfunc, cd);
+    rc = pmix_rte_open_pstrg();
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_pstrg.query(queries, nqueries, &results, nxtcbfunc, cd);
+    }
     if (PMIX_OPERATION_SUCCEEDED == rc) {
         /* if we get here, then all queries were locally
          * resolved, so construct the results for return */
@@ -669,6 +936,62 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
              * was accepted for processing */
             return PMIX_SUCCESS;
         }
+        /* check for request for our own startup timing */
+        if (0 == strcmp(queries[n].keys[0], PMIX_QUERY_STARTUP_TIMING)) {
+            cd = PMIX_NEW(pmix_query_caddy_t);
+            cd->queries = queries;
+            cd->nqueries = nqueries;
+            cd->cbfunc = cbfunc;
+            cd->cbdata = cbdata;
+            PMIX_THREADSHIFT(cd, startup_timing_query);
+            return PMIX_SUCCESS;
+        }
+        /* check for request for a server's direct modex
+         * statistics - clients get them from their server */
+        if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) &&
+            pmix_server_dmdx_stat(queries[n].keys[0], NULL)) {
+            cd = PMIX_NEW(pmix_query_caddy_t);
+            cd->queries = queries;
+            cd->nqueries = nqueries;
+            cd->cbfunc = cbfunc;
+            cd->cbdata = cbdata;
+            PMIX_THREADSHIFT(cd, pmix_server_dmdx_query);
+            return PMIX_SUCCESS;
+        }
+        /* likewise for its per-command statistics */
+        if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) &&
+            pmix_server_stats_key(queries[n].keys[0])) {
+            cd = PMIX_NEW(pmix_query_caddy_t);
+            cd->queries = queries;
+            cd->nqueries = nqueries;
+            cd->cbfunc = cbfunc;
+            cd->cbdata = cbdata;
+            PMIX_THREADSHIFT(cd, pmix_server_stats_query);
+            return PMIX_SUCCESS;
+        }
+        /* and for the objects it holds */
+        if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer)
+            && 0 == strcmp(queries[n].keys[0], PMIX_QUERY_OBJECT_USAGE)) {
+            cd = PMIX_NEW(pmix_query_caddy_t);
+            cd->queries = queries;
+            cd->nqueries = nqueries;
+            cd->cbfunc = cbfunc;
+            cd->cbdata = cbdata;
+            PMIX_THREADSHIFT(cd, memory_query);
+            return PMIX_SUCCESS;
+        }
+        /* and for the profile of its progress threads */
+        if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer)
+            && (0 == strcmp(queries[n].keys[0], PMIX_QUERY_PROGRESS_LAG)
+                || 0 == strcmp(queries[n].keys[0], PMIX_QUERY_PROGRESS_PROFILE))) {
+            cd = PMIX_NEW(pmix_query_caddy_t);
+            cd->queries = queries;
+            cd->nqueries = nqueries;
+            cd->cbfunc = cbfunc;
+            cd->cbdata = cbdata;
+            PMIX_THREADSHIFT(cd, progress_query);
+            return PMIX_SUCCESS;
+        }
         for (p = 0; p < queries[n].nqual; p++) {
             if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_REFRESH_CACHE)) {
                 if (PMIX_INFO_TRUE(&queries[n].qualifiers[p])) {
@@ -960,6 +1283,18 @@ void pmix_query_local_resolve_cbfunc(pmix_status_t status,
                         "pmix:query local resolve callback (ninfo %d, local %d)",
                         (int)ninfo, (int)local_cd->num_local);
 
+    if (PMIX_QUERY_PARTIAL_SUCCESS == status) {
+        /* a batch of a streamed answer - the local
+         * values go out with the last one */
+        if (NULL != local_cd->orig_cbfunc) {
+            local_cd->orig_cbfunc(status, info, ninfo, local_cd->orig_cbdata,
+                                  release_fn, release_cbdata);
+        } else if (NULL != release_fn) {
+            release_fn(release_cbdata);
+        }
+        return;
+    }
+
     local_cd->num_info = ninfo + local_cd->num_local;
     PMIX_INFO_CREATE(local_cd->info, local_cd->num_info);
 
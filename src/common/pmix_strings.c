@@ -268,6 +268,12 @@ PMIX_EXPORT const char *pmix_command_string(pmix_cmd_t cmd)
         return "COMPUTE DEVICE DIST";
     case PMIX_REFRESH_CACHE:
         return "REFRESH CACHE";
+    case PMIX_GET_BATCH_CMD:
+        return "GET BATCH";
+    case PMIX_NOTIFY_BATCH_CMD:
+        return "NOTIFY BATCH";
+    case PMIX_LOG_BATCH_CMD:
+        return "LOG BATCH";
     default:
         return "UNKNOWN";
     }
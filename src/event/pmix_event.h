@@ -179,9 +179,14 @@ typedef struct pmix_event_chain_t {
     pmix_info_t *info;
     size_t ninfo;
     size_t nallocated;
+    /* the first nborrowed entries of the info are shallow
+     * copies of those held by the infosrc object */
+    pmix_object_t *infosrc;
+    size_t nborrowed;
     pmix_status_t interim_status;
     pmix_info_t *results;
     size_t nresults;
+    size_t nresalloc;
     pmix_info_t *interim;
     size_t ninterim;
     pmix_event_hdlr_t *evhdlr;
@@ -198,6 +203,13 @@ PMIX_CLASS_DECLARATION(pmix_event_chain_t);
 PMIX_EXPORT pmix_status_t pmix_prep_event_chain(pmix_event_chain_t *chain, const pmix_info_t *info,
                                                 size_t ninfo, bool xfer);
 
+/* setup the info of a chain to use that of the given notification
+ * without copying it - the notification is retained until the
+ * chain is released */
+struct pmix_notify_caddy_t;
+PMIX_EXPORT pmix_status_t pmix_event_chain_borrow(pmix_event_chain_t *chain,
+                                                  struct pmix_notify_caddy_t *cd);
+
 /* invoke the error handler that is registered against the given
  * status, passing it the provided info on the procs that were
  * affected, plus any additional info provided by the server */
@@ -205,6 +217,9 @@ PMIX_EXPORT void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain);
 
 PMIX_EXPORT bool pmix_notify_check_range(pmix_range_trkr_t *rng, const pmix_proc_t *proc);
 
+/* drop any notifications still held for batched delivery to clients */
+PMIX_EXPORT void pmix_notify_batch_finalize(void);
+
 PMIX_EXPORT bool pmix_notify_check_affected(pmix_proc_t *interested, size_t ninterested,
                                             pmix_proc_t *affected, size_t naffected);
 
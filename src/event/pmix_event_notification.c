@@ -18,14 +18,17 @@
 #include "pmix_common.h"
 #include "include/pmix_server.h"
 
+#include "src/class/pmix_bitmap.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_trace.h"
 
 #include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/bfrops/bfrops.h"
+#include "src/mca/ptl/base/base.h"
 #include "src/server/pmix_server_ops.h"
 
 static void progress_local_event_hdlr(pmix_status_t status, pmix_info_t *results, size_t nresults,
@@ -112,47 +115,135 @@ static void notify_event_cbfunc(struct pmix_peer_t *pr,
     PMIX_RELEASE(cb);
 }
 
+static void notify_index_add(pmix_notify_caddy_t *cd)
+{
+    pmix_notify_caddy_t *head = NULL;
+
+    pmix_hash_table_get_value_uint32(&pmix_globals.notify_codes, (uint32_t) cd->status,
+                                     (void **) &head);
+    if (NULL == head) {
+        cd->code_prev = cd;
+        cd->code_next = cd;
+        pmix_hash_table_set_value_uint32(&pmix_globals.notify_codes, (uint32_t) cd->status, cd);
+        return;
+    }
+    /* append so the ring stays in the order of arrival */
+    cd->code_next = head;
+    cd->code_prev = head->code_prev;
+    head->code_prev->code_next = cd;
+    head->code_prev = cd;
+}
+
+void pmix_notify_event_uncache(pmix_notify_caddy_t *cd)
+{
+    pmix_notify_caddy_t *head = NULL;
+
+    if (NULL != cd->code_next) {
+        if (cd->code_next == cd) {
+            pmix_hash_table_remove_value_uint32(&pmix_globals.notify_codes,
+                                                (uint32_t) cd->status);
+        } else {
+            cd->code_prev->code_next = cd->code_next;
+            cd->code_next->code_prev = cd->code_prev;
+            pmix_hash_table_get_value_uint32(&pmix_globals.notify_codes, (uint32_t) cd->status,
+                                             (void **) &head);
+            if (head == cd) {
+                pmix_hash_table_set_value_uint32(&pmix_globals.notify_codes,
+                                                 (uint32_t) cd->status, cd->code_next);
+            }
+        }
+        cd->code_prev = NULL;
+        cd->code_next = NULL;
+    }
+    pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
+    cd->room = -1;
+}
+
+pmix_status_t pmix_notify_event_cached(pmix_status_t *codes, size_t ncodes,
+                                       pmix_notify_caddy_t ***cds, size_t *ncds)
+{
+    pmix_notify_caddy_t **array, *head, *ncd;
+    size_t n, m, cnt = 0;
+    int i;
+
+    *cds = NULL;
+    *ncds = 0;
+    if (pmix_hotel_is_empty(&pmix_globals.notifications)) {
+        return PMIX_SUCCESS;
+    }
+    array = (pmix_notify_caddy_t **) malloc(pmix_hotel_num_occupants(&pmix_globals.notifications)
+                                            * sizeof(pmix_notify_caddy_t *));
+    if (NULL == array) {
+        return PMIX_ERR_NOMEM;
+    }
+
+    if (NULL == codes) {
+        /* a default handler sees everything that wasn't
+         * restricted to non-default handlers */
+        for (i = pmix_hotel_oldest_room(&pmix_globals.notifications); 0 <= i;
+             i = pmix_hotel_next_room(&pmix_globals.notifications, i)) {
+            pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &ncd);
+            if (NULL != ncd && !ncd->nondefault) {
+                array[cnt++] = ncd;
+            }
+        }
+    } else {
+        for (n = 0; n < ncodes; n++) {
+            /* protect against the same code being given twice */
+            for (m = 0; m < n; m++) {
+                if (codes[m] == codes[n]) {
+                    break;
+                }
+            }
+            if (m < n) {
+                continue;
+            }
+            head = NULL;
+            pmix_hash_table_get_value_uint32(&pmix_globals.notify_codes, (uint32_t) codes[n],
+                                             (void **) &head);
+            if (NULL == head) {
+                continue;
+            }
+            ncd = head;
+            do {
+                array[cnt++] = ncd;
+                ncd = ncd->code_next;
+            } while (ncd != head);
+        }
+    }
+
+    if (0 == cnt) {
+        free(array);
+        return PMIX_SUCCESS;
+    }
+    *cds = array;
+    *ncds = cnt;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_notify_event_cache(pmix_notify_caddy_t *cd)
 {
     pmix_status_t rc;
-    int j;
     pmix_notify_caddy_t *pk;
     int idx;
-    time_t etime;
 
     /* add to our cache */
     rc = pmix_hotel_checkin(&pmix_globals.notifications, cd, &cd->room);
-    /* if there wasn't room, then search for the longest tenured
-     * occupant and evict them */
+    /* if there wasn't room, then evict the longest tenured
+     * occupant - rooms are kept in check-in order, so that
+     * is simply the oldest one */
     if (PMIX_SUCCESS != rc) {
-        etime = 0;
-        idx = -1;
-        for (j = 0; j < pmix_globals.max_events; j++) {
-            pmix_hotel_knock(&pmix_globals.notifications, j, (void **) &pk);
-            if (NULL == pk) {
-                /* hey, there is room! */
-                pmix_hotel_checkin_with_res(&pmix_globals.notifications, cd, &cd->room);
-                return PMIX_SUCCESS;
-            }
-            /* check the age */
-            if (0 == j) {
-                etime = pk->ts;
-                idx = j;
-            } else {
-                if (difftime(pk->ts, etime) < 0) {
-                    etime = pk->ts;
-                    idx = j;
-                }
-            }
-        }
+        idx = pmix_hotel_oldest_room(&pmix_globals.notifications);
         if (0 <= idx) {
-            /* we found the oldest occupant - evict it */
-            pmix_hotel_checkout_and_return_occupant(&pmix_globals.notifications, idx,
-                                                    (void **) &pk);
+            pmix_hotel_knock(&pmix_globals.notifications, idx, (void **) &pk);
+            pmix_notify_event_uncache(pk);
             PMIX_RELEASE(pk);
             rc = pmix_hotel_checkin(&pmix_globals.notifications, cd, &cd->room);
         }
     }
+    if (PMIX_SUCCESS == rc) {
+        notify_index_add(cd);
+    }
     return rc;
 }
 
@@ -228,27 +319,27 @@ pmix_status_t pmix_notify_server_of_event(pmix_status_t status, const pmix_proc_
         } else {
             PMIX_LOAD_PROCID(&chain->source, source->nspace, source->rank);
         }
-        /* we always leave space for event hdlr name and a callback object */
-        chain->nallocated = ninfo + 2;
-        PMIX_INFO_CREATE(chain->info, chain->nallocated);
-        /* prep the chain for processing */
-        pmix_prep_event_chain(chain, info, ninfo, true);
 
         /* we need to cache this event so we can pass it into
-         * ourselves should someone later register for it */
+         * ourselves should someone later register for it - the
+         * cache takes the copy of the info, and the chain uses it */
         cd = PMIX_NEW(pmix_notify_caddy_t);
         cd->status = status;
         PMIX_LOAD_PROCID(&cd->source, chain->source.nspace, chain->source.rank);
         cd->range = chain->range;
-        if (0 < chain->ninfo) {
-            cd->ninfo = chain->ninfo;
+        if (NULL != info && 0 < ninfo) {
+            cd->ninfo = ninfo;
             PMIX_INFO_CREATE(cd->info, cd->ninfo);
-            cd->nondefault = chain->nondefault;
             /* need to copy the info */
             for (n = 0; n < cd->ninfo; n++) {
-                PMIX_INFO_XFER(&cd->info[n], &chain->info[n]);
+                PMIX_INFO_XFER(&cd->info[n], &info[n]);
             }
         }
+        /* we always leave space for event hdlr name and a callback object */
+        pmix_event_chain_borrow(chain, cd);
+        /* prep the chain for processing */
+        pmix_prep_event_chain(chain, chain->info, chain->ninfo, false);
+        cd->nondefault = chain->nondefault;
         if (NULL != chain->targets) {
             cd->ntargets = chain->ntargets;
             PMIX_PROC_CREATE(cd->targets, cd->ntargets);
@@ -342,51 +433,54 @@ static void cycle_events(int sd, short args, void *cbdata)
 
     /* aggregate the results per RFC0018 - first search the
      * prior chained results to see if any keys have been NULL'd
-     * as this indicates that info struct should be removed */
-    nsave = 0;
+     * as this indicates that info struct should be removed. The
+     * survivors are compacted in place */
+    cnt = 0;
     for (n = 0; n < chain->nresults; n++) {
-        if (0 < strlen(chain->results[n].key)) {
-            ++nsave;
+        if (0 == strlen(chain->results[n].key)) {
+            PMIX_INFO_DESTRUCT(&chain->results[n]);
+            continue;
         }
+        if (cnt != n) {
+            memcpy(&chain->results[cnt], &chain->results[n], sizeof(pmix_info_t));
+        }
+        ++cnt;
     }
+    chain->nresults = cnt;
     /* we have to at least record the status returned by each
-     * stage of the event handler chain, so we have to reallocate
-     * the array to make space */
-
-    /* add in any new results plus space for the returned status */
-    nsave += chain->ninterim + 1;
-    /* create the new space */
-    PMIX_INFO_CREATE(newinfo, nsave);
-    /* transfer over the prior data */
-    cnt = 0;
-    for (n = 0; n < chain->nresults; n++) {
-        if (0 < strlen(chain->results[n].key)) {
-            PMIX_INFO_XFER(&newinfo[cnt], &chain->results[n]);
-            ++cnt;
+     * stage of the event handler chain, so make space for it
+     * and any new results - the array grows by doubling so
+     * a long chain doesn't reallocate at every stage */
+    nsave = cnt + chain->ninterim + 1;
+    if (nsave > chain->nresalloc) {
+        n = (2 * chain->nresalloc > nsave) ? 2 * chain->nresalloc : nsave;
+        newinfo = (pmix_info_t *) realloc(chain->results, n * sizeof(pmix_info_t));
+        if (NULL == newinfo) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+            nsave = 0;
+        } else {
+            chain->results = newinfo;
+            chain->nresalloc = n;
         }
     }
-
-    /* save this handler's returned status */
-    if (NULL != chain->evhdlr->name) {
-        pmix_strncpy(newinfo[cnt].key, chain->evhdlr->name, PMIX_MAX_KEYLEN);
-    } else {
-        pmix_strncpy(newinfo[cnt].key, "UNKNOWN", PMIX_MAX_KEYLEN);
-    }
-    newinfo[cnt].value.type = PMIX_STATUS;
-    newinfo[cnt].value.data.status = chain->status;
-    ++cnt;
-    /* transfer across the new results */
-    for (n = 0; n < chain->ninterim; n++) {
-        PMIX_INFO_XFER(&newinfo[cnt], &chain->interim[n]);
+    if (0 < nsave) {
+        memset(&chain->results[cnt], 0, (nsave - cnt) * sizeof(pmix_info_t));
+        /* save this handler's returned status */
+        if (NULL != chain->evhdlr->name) {
+            pmix_strncpy(chain->results[cnt].key, chain->evhdlr->name, PMIX_MAX_KEYLEN);
+        } else {
+            pmix_strncpy(chain->results[cnt].key, "UNKNOWN", PMIX_MAX_KEYLEN);
+        }
+        chain->results[cnt].value.type = PMIX_STATUS;
+        chain->results[cnt].value.data.status = chain->status;
         ++cnt;
+        /* transfer across the new results */
+        for (n = 0; n < chain->ninterim; n++) {
+            PMIX_INFO_XFER(&chain->results[cnt], &chain->interim[n]);
+            ++cnt;
+        }
+        chain->nresults = cnt;
     }
-    /* release the prior results */
-    if (0 < chain->nresults) {
-        PMIX_INFO_FREE(chain->results, chain->nresults);
-    }
-    /* pass along the new ones */
-    chain->results = newinfo;
-    chain->nresults = cnt;
     /* clear any loaded name and object */
     if (chain->nallocated > chain->ninfo) {
         chain->ninfo = chain->nallocated - 2;
@@ -674,6 +768,7 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain)
                         "%s invoke_local_event_hdlr for status %s",
                         PMIX_NAME_PRINT(&pmix_globals.myid),
                         PMIx_Error_string(chain->status));
+    PMIX_TRACE1(event_dispatch, chain->status);
 
     /* sanity check */
     if (NULL == chain->info) {
@@ -891,21 +986,235 @@ static void local_cbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* pack everything but the command of a notification for a client */
+static pmix_status_t notify_pack_event(pmix_peer_t *peer, pmix_buffer_t *bfr,
+                                       pmix_notify_caddy_t *cd)
+{
+    pmix_status_t rc;
+
+    /* pack the status */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    /* pack the source */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->source, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    /* pack any info */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 < cd->ninfo) {
+        PMIX_BFROPS_PACK(rc, peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    /* pack the range in case they need to relay */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->range, 1, PMIX_DATA_RANGE);
+    return rc;
+}
+
+/* Notifications held for a local client so that a burst of
+ * events can be delivered in a single message. Batches are
+ * indexed by the peer's position in the clients array */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    bool active;
+    pmix_peer_t *peer;
+    pmix_buffer_t bfr;
+    int32_t count;
+} pmix_notify_batch_t;
+static void nbcon(pmix_notify_batch_t *p)
+{
+    p->active = false;
+    p->peer = NULL;
+    PMIX_CONSTRUCT(&p->bfr, pmix_buffer_t);
+    p->count = 0;
+}
+static void nbdes(pmix_notify_batch_t *p)
+{
+    if (p->active) {
+        pmix_event_del(&p->ev);
+    }
+    if (NULL != p->peer) {
+        PMIX_RELEASE(p->peer);
+    }
+    PMIX_DESTRUCT(&p->bfr);
+}
+static PMIX_CLASS_INSTANCE(pmix_notify_batch_t, pmix_object_t, nbcon, nbdes);
+
+static pmix_pointer_array_t notify_batches = PMIX_POINTER_ARRAY_STATIC_INIT;
+static bool notify_batches_init = false;
+
+static bool notify_batch_wanted(pmix_peer_t *peer)
+{
+    if (0 >= pmix_server_globals.event_batch_window || 1 >= pmix_server_globals.event_batch_max) {
+        return false;
+    }
+    /* tools relay what they receive, so only batch for
+     * clients that know how to unpack it */
+    if (!PMIX_PEER_IS_CLIENT(peer) || PMIX_PEER_IS_TOOL(peer) || 0 > peer->index) {
+        return false;
+    }
+    if (PMIX_PEER_IS_EARLIER(peer, PMIX_VERSION_MAJOR, PMIX_VERSION_MINOR,
+                             PMIX_VERSION_RELEASE)) {
+        return false;
+    }
+    return true;
+}
+
+static void notify_batch_send(pmix_notify_batch_t *batch)
+{
+    pmix_buffer_t *bfr;
+    pmix_cmd_t cmd;
+    pmix_status_t rc;
+
+    if (batch->active) {
+        pmix_event_del(&batch->ev);
+        batch->active = false;
+    }
+    if (0 == batch->count) {
+        goto reset;
+    }
+    bfr = PMIX_NEW(pmix_buffer_t);
+    if (NULL == bfr) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        goto reset;
+    }
+    /* a lone notification goes out in the usual form */
+    if (1 == batch->count) {
+        cmd = PMIX_NOTIFY_CMD;
+        PMIX_BFROPS_PACK(rc, batch->peer, bfr, &cmd, 1, PMIX_COMMAND);
+    } else {
+        cmd = PMIX_NOTIFY_BATCH_CMD;
+        PMIX_BFROPS_PACK(rc, batch->peer, bfr, &cmd, 1, PMIX_COMMAND);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, batch->peer, bfr, &batch->count, 1, PMIX_INT32);
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_COPY_PAYLOAD(rc, batch->peer, bfr, &batch->bfr);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bfr);
+        goto reset;
+    }
+    pmix_output_verbose(2, pmix_server_globals.event_output,
+                        "pmix_server: delivering %d notifications to client %s",
+                        (int) batch->count, PMIX_PEER_PRINT(batch->peer));
+    PMIX_SERVER_QUEUE_REPLY(rc, batch->peer, 0, bfr);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(bfr);
+    }
+
+reset:
+    PMIX_DESTRUCT(&batch->bfr);
+    PMIX_CONSTRUCT(&batch->bfr, pmix_buffer_t);
+    batch->count = 0;
+    /* don't hold the peer between bursts */
+    if (NULL != batch->peer) {
+        PMIX_RELEASE(batch->peer);
+        batch->peer = NULL;
+    }
+}
+
+static void notify_batch_timeout(int sd, short args, void *cbdata)
+{
+    pmix_notify_batch_t *batch = (pmix_notify_batch_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(batch);
+    batch->active = false;
+    notify_batch_send(batch);
+}
+
+static pmix_status_t notify_batch_add(pmix_peer_t *peer, pmix_notify_caddy_t *cd)
+{
+    pmix_notify_batch_t *batch;
+    pmix_status_t rc;
+    struct timeval tv;
+
+    if (!notify_batches_init) {
+        PMIX_CONSTRUCT(&notify_batches, pmix_pointer_array_t);
+        pmix_pointer_array_init(&notify_batches, 16, INT_MAX, 16);
+        notify_batches_init = true;
+    }
+    batch = (pmix_notify_batch_t *) pmix_pointer_array_get_item(&notify_batches, peer->index);
+    if (NULL == batch) {
+        batch = PMIX_NEW(pmix_notify_batch_t);
+        if (NULL == batch) {
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_pointer_array_set_item(&notify_batches, peer->index, batch);
+    } else if (NULL != batch->peer && batch->peer != peer) {
+        /* the slot was taken over by a new client - deliver
+         * whatever is left for the old one */
+        notify_batch_send(batch);
+    }
+    if (NULL == batch->peer) {
+        PMIX_RETAIN(peer);
+        batch->peer = peer;
+    }
+
+    rc = notify_pack_event(peer, &batch->bfr, cd);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    ++batch->count;
+
+    if (batch->count >= pmix_server_globals.event_batch_max) {
+        notify_batch_send(batch);
+    } else if (!batch->active) {
+        tv.tv_sec = pmix_server_globals.event_batch_window / 1000000;
+        tv.tv_usec = pmix_server_globals.event_batch_window % 1000000;
+        pmix_event_evtimer_set(pmix_globals.evbase, &batch->ev, notify_batch_timeout, batch);
+        PMIX_POST_OBJECT(batch);
+        pmix_event_evtimer_add(&batch->ev, &tv);
+        batch->active = true;
+    }
+    return PMIX_SUCCESS;
+}
+
+void pmix_notify_batch_finalize(void)
+{
+    pmix_notify_batch_t *batch;
+    int i;
+
+    if (!notify_batches_init) {
+        return;
+    }
+    for (i = 0; i < notify_batches.size; i++) {
+        batch = (pmix_notify_batch_t *) pmix_pointer_array_get_item(&notify_batches, i);
+        if (NULL != batch) {
+            PMIX_RELEASE(batch);
+        }
+    }
+    PMIX_DESTRUCT(&notify_batches);
+    notify_batches_init = false;
+}
+
 static void _notify_client_event(int sd, short args, void *cbdata)
 {
     (void) sd;
     (void) args;
     pmix_notify_caddy_t *cd = (pmix_notify_caddy_t *) cbdata;
-    pmix_regevents_info_t *reginfoptr;
+    pmix_regevents_info_t *reginfoptr, *regs[2];
     pmix_peer_events_info_t *pr;
     pmix_event_chain_t *chain;
     size_t n, nleft;
-    bool matched, holdcd;
-    pmix_buffer_t *bfr;
+    int r;
+    bool holdcd;
+    pmix_buffer_t *bfr, *shared = NULL;
+    pmix_peer_t *sharedpeer = NULL;
     pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
     pmix_status_t rc;
-    pmix_list_t trk;
-    pmix_namelist_t *nm;
+    pmix_bitmap_t trk;
     pmix_namespace_t *nptr, *tmp;
     pmix_range_trkr_t rngtrk;
     pmix_proc_t proc;
@@ -916,6 +1225,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     pmix_output_verbose(2, pmix_server_globals.event_output,
                         "pmix_server: _notify_client_event notifying clients of event %s range %s",
                         PMIx_Error_string(cd->status), PMIx_Data_range_string(cd->range));
+    PMIX_TRACE3(event_notify, cd->status, cd->source.nspace, cd->source.rank);
 
     /* check for caching instructions */
     holdcd = true;
@@ -951,11 +1261,10 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     }
     PMIX_LOAD_PROCID(&chain->source, cd->source.nspace, cd->source.rank);
     /* we always leave space for a callback object and
-     * the evhandler name. */
-    chain->nallocated = cd->ninfo + 2;
-    PMIX_INFO_CREATE(chain->info, chain->nallocated);
+     * the evhandler name, but use the info of the cd */
+    pmix_event_chain_borrow(chain, cd);
     /* prep the chain for processing */
-    pmix_prep_event_chain(chain, cd->info, cd->ninfo, true);
+    pmix_prep_event_chain(chain, chain->info, chain->ninfo, false);
     cd->nondefault = chain->nondefault;
     /* if the range is PMIX_RANGE_RM, then we only process this
      * event ourselves - the PMIx server may aggregate the
@@ -1080,19 +1389,30 @@ static void _notify_client_event(int sd, short args, void *cbdata)
         grp->nmbrs = cd->ntargets;
         PMIX_PROC_CREATE(grp->members, grp->nmbrs);
         memcpy(grp->members, cd->targets, cd->ntargets * sizeof(pmix_proc_t));
-        pmix_list_append(&pmix_server_globals.groups, &grp->super);
+        rc = pmix_server_group_index(grp);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        pmix_server_group_add(grp);
     }
 
     holdcd = false;
     if (PMIX_RANGE_PROC_LOCAL != cd->range) {
-        PMIX_CONSTRUCT(&trk, pmix_list_t);
+        PMIX_CONSTRUCT(&trk, pmix_bitmap_t);
         rngtrk.procs = NULL;
         rngtrk.nprocs = 0;
-        /* cycle across our registered events and send the message to
-         * any client who registered for it */
-        PMIX_LIST_FOREACH (reginfoptr, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if ((PMIX_MAX_ERR_CONSTANT == reginfoptr->code && !cd->nondefault) ||
-                cd->status == reginfoptr->code) {
+        /* only the registrations for this code and, unless told
+         * otherwise, the default handlers can receive it - so look
+         * those up directly and send the message to each client
+         * registered against them */
+        regs[0] = pmix_server_event_lookup(cd->status);
+        regs[1] = NULL;
+        if (!cd->nondefault && PMIX_MAX_ERR_CONSTANT != cd->status) {
+            regs[1] = pmix_server_event_lookup(PMIX_MAX_ERR_CONSTANT);
+        }
+        for (r = 0; r < 2; r++) {
+            reginfoptr = regs[r];
+            if (NULL != reginfoptr) {
                 PMIX_LIST_FOREACH (pr, &reginfoptr->peers, pmix_peer_events_info_t) {
                     /* if this client was the source of the event, then
                      * don't send it back as they will have processed it
@@ -1105,14 +1425,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                         continue;
                     }
                     /* if we have already notified this client, then don't do it again */
-                    matched = false;
-                    PMIX_LIST_FOREACH (nm, &trk, pmix_namelist_t) {
-                        if (nm->pname == &pr->peer->info->pname) {
-                            matched = true;
-                            break;
-                        }
-                    }
-                    if (matched) {
+                    if (0 <= pr->peer->index && pmix_bitmap_is_set_bit(&trk, pr->peer->index)) {
                         continue;
                     }
                     /* check if the affected procs (if given) match those they
@@ -1137,64 +1450,58 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                                         PMIx_Error_string(cd->status));
 
                     /* record that we notified this client */
-                    nm = PMIX_NEW(pmix_namelist_t);
-                    nm->pname = &pr->peer->info->pname;
-                    pmix_list_append(&trk, &nm->super);
-
-                    bfr = PMIX_NEW(pmix_buffer_t);
-                    if (NULL == bfr) {
-                        continue;
-                    }
-                    /* pack the command */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cmd, 1, PMIX_COMMAND);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    /* pack the status */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->status, 1, PMIX_STATUS);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
+                    if (0 <= pr->peer->index) {
+                        pmix_bitmap_set_bit(&trk, pr->peer->index);
                     }
 
-                    /* pack the source */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->source, 1, PMIX_PROC);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-                    /* pack any info */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    if (0 < cd->ninfo) {
-                        PMIX_BFROPS_PACK(rc, pr->peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
+                    if (notify_batch_wanted(pr->peer)) {
+                        /* hold it so it can go out together with
+                         * any others that follow shortly */
+                        rc = notify_batch_add(pr->peer, cd);
                         if (PMIX_SUCCESS != rc) {
                             PMIX_ERROR_LOG(rc);
+                            continue;
+                        }
+                    } else if (NULL != shared &&
+                               pr->peer->nptr->compat.bfrops == sharedpeer->nptr->compat.bfrops &&
+                               pr->peer->nptr->compat.type == sharedpeer->nptr->compat.type) {
+                        /* the message only depends on the event and the
+                         * peer's bfrops, so reuse the one already packed */
+                        bfr = shared;
+                        PMIX_RETAIN(bfr);
+                        PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
+                        if (PMIX_SUCCESS != rc) {
                             PMIX_RELEASE(bfr);
+                        }
+                    } else {
+                        bfr = PMIX_NEW(pmix_buffer_t);
+                        if (NULL == bfr) {
                             continue;
                         }
-                    }
-                    /* pack the range in case they need to relay */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->range, 1, PMIX_DATA_RANGE);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_RELEASE(bfr);
+                        /* pack the command */
+                        PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cmd, 1, PMIX_COMMAND);
+                        if (PMIX_SUCCESS != rc) {
+                            PMIX_ERROR_LOG(rc);
+                            PMIX_RELEASE(bfr);
+                            continue;
+                        }
+                        rc = notify_pack_event(pr->peer, bfr, cd);
+                        if (PMIX_SUCCESS != rc) {
+                            PMIX_ERROR_LOG(rc);
+                            PMIX_RELEASE(bfr);
+                            continue;
+                        }
+                        /* hold a reference for the peers that follow */
+                        if (NULL != shared) {
+                            PMIX_RELEASE(shared);
+                        }
+                        PMIX_RETAIN(bfr);
+                        shared = bfr;
+                        sharedpeer = pr->peer;
+                        PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
+                        if (PMIX_SUCCESS != rc) {
+                            PMIX_RELEASE(bfr);
+                        }
                     }
                     if (NULL != cd->targets && 0 < cd->nleft) {
                         /* track the number of targets we have left to notify */
@@ -1202,7 +1509,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                         /* if the event was cached and this is the last one,
                          * then evict this event from the cache */
                         if (0 == cd->nleft) {
-                            pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
+                            pmix_notify_event_uncache(cd);
                             holdcd = false;
                             break;
                         }
@@ -1210,7 +1517,10 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                 }
             }
         }
-        PMIX_LIST_DESTRUCT(&trk);
+        PMIX_DESTRUCT(&trk);
+        if (NULL != shared) {
+            PMIX_RELEASE(shared);
+        }
         if (PMIX_RANGE_LOCAL != cd->range &&
             PMIX_CHECK_PROCID(&cd->source, &pmix_globals.myid)) {
             /* if we are the source, then we need to post this upwards as
@@ -1443,6 +1753,25 @@ pmix_status_t pmix_prep_event_chain(pmix_event_chain_t *chain, const pmix_info_t
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_event_chain_borrow(pmix_event_chain_t *chain, pmix_notify_caddy_t *cd)
+{
+    /* we always leave space for event hdlr name and a callback object */
+    chain->nallocated = cd->ninfo + 2;
+    PMIX_INFO_CREATE(chain->info, chain->nallocated);
+    if (NULL == chain->info) {
+        chain->nallocated = 0;
+        return PMIX_ERR_NOMEM;
+    }
+    if (0 < cd->ninfo) {
+        memcpy(chain->info, cd->info, cd->ninfo * sizeof(pmix_info_t));
+        chain->ninfo = cd->ninfo;
+        chain->nborrowed = cd->ninfo;
+        PMIX_RETAIN(cd);
+        chain->infosrc = &cd->super;
+    }
+    return PMIX_SUCCESS;
+}
+
 /****    CLASS INSTANTIATIONS    ****/
 
 static void sevcon(pmix_event_hdlr_t *p)
@@ -1531,9 +1860,12 @@ static void chcon(pmix_event_chain_t *p)
     p->info = NULL;
     p->ninfo = 0;
     p->nallocated = 0;
+    p->infosrc = NULL;
+    p->nborrowed = 0;
     p->interim_status = PMIX_ERROR;
     p->results = NULL;
     p->nresults = 0;
+    p->nresalloc = 0;
     p->interim = NULL;
     p->ninterim = 0;
     p->evhdlr = NULL;
@@ -1544,6 +1876,8 @@ static void chcon(pmix_event_chain_t *p)
 }
 static void chdes(pmix_event_chain_t *p)
 {
+    size_t n;
+
     if (p->timer_active) {
         pmix_event_del(&p->ev);
     }
@@ -1553,9 +1887,18 @@ static void chdes(pmix_event_chain_t *p)
     if (NULL != p->affected) {
         PMIX_PROC_FREE(p->affected, p->naffected);
     }
-    if (NULL != p->info) {
+    if (NULL != p->info && 0 < p->nborrowed) {
+        /* the borrowed values belong to the source */
+        for (n = p->nborrowed; n < p->nallocated; n++) {
+            PMIX_INFO_DESTRUCT(&p->info[n]);
+        }
+        pmix_free(p->info);
+    } else if (NULL != p->info) {
         PMIX_INFO_FREE(p->info, p->nallocated);
     }
+    if (NULL != p->infosrc) {
+        PMIX_RELEASE(p->infosrc);
+    }
     if (NULL != p->results) {
         PMIX_INFO_FREE(p->results, p->nresults);
     }
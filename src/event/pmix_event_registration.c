@@ -81,27 +81,44 @@ PMIX_CLASS_INSTANCE(pmix_rshift_caddy_t, pmix_object_t, rscon, rsdes);
 
 static void check_cached_events(pmix_rshift_caddy_t *cd);
 
-/* catch the event registration response message from the
- * server and process it */
-static void regevents_cbfunc(struct pmix_peer_t *peer,
-                             pmix_ptl_hdr_t *hdr,
-                             pmix_buffer_t *buf,
-                             void *cbdata)
+/* registrations that only add codes and carry no directives are
+ * collected while the progress thread works through its current
+ * pass and then sent to the server as a single message, so a
+ * caller registering many handlers at once costs the server one
+ * registration - and one scan of its cached events - instead of
+ * one per handler */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_rshift_caddy_t **regs;
+    size_t nregs;
+    size_t nalloc;
+} pmix_regevents_batch_t;
+static void rbcon(pmix_regevents_batch_t *p)
 {
-    pmix_rshift_caddy_t *rb = (pmix_rshift_caddy_t *) cbdata;
-    pmix_rshift_caddy_t *cd = (pmix_rshift_caddy_t *) rb->cd;
-    pmix_status_t rc, ret;
-    int cnt;
-    size_t index = rb->index;
+    p->regs = NULL;
+    p->nregs = 0;
+    p->nalloc = 0;
+}
+static void rbdes(pmix_regevents_batch_t *p)
+{
+    if (NULL != p->regs) {
+        free(p->regs);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_regevents_batch_t, pmix_object_t, rbcon, rbdes);
 
-    pmix_output_verbose(2, pmix_client_globals.event_output, "pmix: regevents callback recvd");
+/* the batch still being collected - only touched
+ * from within the progress thread */
+static pmix_regevents_batch_t *regbatch = NULL;
 
-    PMIX_HIDE_UNUSED_PARAMS(hdr);
+/* complete a registration once the server has responded */
+static void regevents_complete(pmix_rshift_caddy_t *rb, pmix_status_t ret)
+{
+    pmix_rshift_caddy_t *cd = (pmix_rshift_caddy_t *) rb->cd;
+    size_t index = rb->index;
 
-    /* unpack the status code */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, peer, buf, &ret, &cnt, PMIX_STATUS);
-    if ((PMIX_SUCCESS != rc) || (PMIX_SUCCESS != ret)) {
+    if (PMIX_SUCCESS != ret) {
         /* remove the err handler and call the error handler
          * reg completion callback fn so the requestor
          * doesn't hang */
@@ -142,6 +159,166 @@ static void regevents_cbfunc(struct pmix_peer_t *peer,
     PMIX_RELEASE(rb);
 }
 
+/* catch the event registration response message from the
+ * server and process it */
+static void regevents_cbfunc(struct pmix_peer_t *peer,
+                             pmix_ptl_hdr_t *hdr,
+                             pmix_buffer_t *buf,
+                             void *cbdata)
+{
+    pmix_rshift_caddy_t *rb = (pmix_rshift_caddy_t *) cbdata;
+    pmix_status_t rc, ret;
+    int cnt;
+
+    pmix_output_verbose(2, pmix_client_globals.event_output, "pmix: regevents callback recvd");
+
+    PMIX_HIDE_UNUSED_PARAMS(hdr);
+
+    /* unpack the status code */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        ret = rc;
+    }
+    regevents_complete(rb, ret);
+}
+
+/* the response to a batch applies to every registration in it */
+static void regbatch_cbfunc(struct pmix_peer_t *peer,
+                            pmix_ptl_hdr_t *hdr,
+                            pmix_buffer_t *buf,
+                            void *cbdata)
+{
+    pmix_regevents_batch_t *bt = (pmix_regevents_batch_t *) cbdata;
+    pmix_status_t rc, ret;
+    int cnt;
+    size_t n;
+
+    pmix_output_verbose(2, pmix_client_globals.event_output,
+                        "pmix: regevents batch callback recvd for %lu registrations",
+                        (unsigned long) bt->nregs);
+
+    PMIX_HIDE_UNUSED_PARAMS(hdr);
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        ret = rc;
+    }
+    for (n = 0; n < bt->nregs; n++) {
+        regevents_complete(bt->regs[n], ret);
+    }
+    PMIX_RELEASE(bt);
+}
+
+/* send the codes of every registration in the batch */
+static void send_batch(int sd, short args, void *cbdata)
+{
+    pmix_regevents_batch_t *bt = (pmix_regevents_batch_t *) cbdata;
+    pmix_rshift_caddy_t *cd;
+    pmix_status_t rc, *codes = NULL;
+    pmix_buffer_t *msg = NULL;
+    pmix_cmd_t cmd = PMIX_REGEVENTS_CMD;
+    size_t n, m, k, ncodes = 0, ninfo = 0;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    /* later registrations start a new batch */
+    regbatch = NULL;
+
+    for (n = 0; n < bt->nregs; n++) {
+        ncodes += ((pmix_rshift_caddy_t *) bt->regs[n]->cd)->ncodes;
+    }
+    codes = (pmix_status_t *) malloc(ncodes * sizeof(pmix_status_t));
+    if (NULL == codes) {
+        rc = PMIX_ERR_NOMEM;
+        goto error;
+    }
+    /* the server would register us once for each copy of a code */
+    ncodes = 0;
+    for (n = 0; n < bt->nregs; n++) {
+        cd = (pmix_rshift_caddy_t *) bt->regs[n]->cd;
+        for (m = 0; m < cd->ncodes; m++) {
+            for (k = 0; k < ncodes; k++) {
+                if (codes[k] == cd->codes[m]) {
+                    break;
+                }
+            }
+            if (k == ncodes) {
+                codes[ncodes++] = cd->codes[m];
+            }
+        }
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.event_output,
+                        "pmix: sending %lu codes of %lu registrations to server",
+                        (unsigned long) ncodes, (unsigned long) bt->nregs);
+
+    msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &ncodes, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, codes, ncodes, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    free(codes);
+    codes = NULL;
+    PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, regbatch_cbfunc, bt);
+    if (PMIX_SUCCESS != rc) {
+        goto error;
+    }
+    return;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    if (NULL != msg) {
+        PMIX_RELEASE(msg);
+    }
+    if (NULL != codes) {
+        free(codes);
+    }
+    for (n = 0; n < bt->nregs; n++) {
+        regevents_complete(bt->regs[n], rc);
+    }
+    PMIX_RELEASE(bt);
+}
+
+/* add a registration to the batch being collected */
+static pmix_status_t _batch_to_server(pmix_rshift_caddy_t *rcd)
+{
+    pmix_rshift_caddy_t **tmp;
+    size_t nalloc;
+
+    if (NULL == regbatch) {
+        regbatch = PMIX_NEW(pmix_regevents_batch_t);
+        if (NULL == regbatch) {
+            return PMIX_ERR_NOMEM;
+        }
+        PMIX_THREADSHIFT_DELAY(regbatch, send_batch, 0);
+    }
+    if (regbatch->nregs == regbatch->nalloc) {
+        nalloc = (0 == regbatch->nalloc) ? 8 : 2 * regbatch->nalloc;
+        tmp = (pmix_rshift_caddy_t **) realloc(regbatch->regs,
+                                               nalloc * sizeof(pmix_rshift_caddy_t *));
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        regbatch->regs = tmp;
+        regbatch->nalloc = nalloc;
+    }
+    regbatch->regs[regbatch->nregs++] = rcd;
+    return PMIX_SUCCESS;
+}
+
 static void reg_cbfunc(pmix_status_t status, void *cbdata)
 {
     pmix_rshift_caddy_t *rb = (pmix_rshift_caddy_t *) cbdata;
@@ -316,8 +493,15 @@ static pmix_status_t _add_hdlr(pmix_rshift_caddy_t *cd, pmix_list_t *xfer)
         pmix_output_verbose(2, pmix_client_globals.event_output,
                             "pmix: _add_hdlr sending to server");
         /* send the directives to the server - we will ack this
-         * registration upon return from there */
-        if (PMIX_SUCCESS != (rc = _send_to_server(cd2))) {
+         * registration upon return from there. Registrations that
+         * only add codes are combined with any others made in the
+         * meantime */
+        if (0 < cd->ncodes && 0 == cd2->ninfo) {
+            rc = _batch_to_server(cd2);
+        } else {
+            rc = _send_to_server(cd2);
+        }
+        if (PMIX_SUCCESS != rc) {
             pmix_output_verbose(2, pmix_client_globals.event_output,
                                 "pmix: add_hdlr - pack send_to_server failed status=%d", rc);
             if (NULL != cd2->info) {
@@ -357,34 +541,18 @@ static pmix_status_t _add_hdlr(pmix_rshift_caddy_t *cd, pmix_list_t *xfer)
 
 static void check_cached_events(pmix_rshift_caddy_t *cd)
 {
-    size_t n;
-    pmix_notify_caddy_t *ncd;
-    bool found, matched;
+    size_t n, j, ncds;
+    pmix_notify_caddy_t *ncd, **cds;
+    bool matched;
     pmix_event_chain_t *chain;
-    int j;
 
-    for (j = 0; j < pmix_globals.max_events; j++) {
-        pmix_hotel_knock(&pmix_globals.notifications, j, (void **) &ncd);
-        if (NULL == ncd) {
-            continue;
-        }
-        found = false;
-        if (NULL == cd->codes) {
-            if (!ncd->nondefault) {
-                /* they registered a default event handler - always matches */
-                found = true;
-            }
-        } else {
-            for (n = 0; n < cd->ncodes; n++) {
-                if (cd->codes[n] == ncd->status) {
-                    found = true;
-                    break;
-                }
-            }
-        }
-        if (!found) {
-            continue;
-        }
+    /* only look at the cached events matching the codes - a
+     * default event handler matches all of them */
+    if (PMIX_SUCCESS != pmix_notify_event_cached(cd->codes, cd->ncodes, &cds, &ncds)) {
+        return;
+    }
+    for (j = 0; j < ncds; j++) {
+        ncd = cds[j];
         /* if we were given specific targets, check if we are one */
         if (NULL != ncd->targets) {
             matched = false;
@@ -409,14 +577,11 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
         chain->status = ncd->status;
         pmix_strncpy(chain->source.nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
         chain->source.rank = pmix_globals.myid.rank;
-        /* we always leave space for event hdlr name and a callback object */
-        chain->nallocated = ncd->ninfo + 2;
-        PMIX_INFO_CREATE(chain->info, chain->nallocated);
+        /* we always leave space for event hdlr name and a callback
+         * object, but use the info of the cached notification */
+        pmix_event_chain_borrow(chain, ncd);
         if (0 < ncd->ninfo) {
-            chain->ninfo = ncd->ninfo;
-            /* need to copy the info */
             for (n = 0; n < ncd->ninfo; n++) {
-                PMIX_INFO_XFER(&chain->info[n], &ncd->info[n]);
                 if (0 == strncmp(ncd->info[n].key, PMIX_EVENT_NON_DEFAULT, PMIX_MAX_KEYLEN)) {
                     chain->nondefault = true;
                 } else if (0
@@ -425,6 +590,7 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
                     PMIX_PROC_CREATE(chain->affected, 1);
                     if (NULL == chain->affected) {
                         PMIX_RELEASE(chain);
+                        free(cds);
                         return;
                     }
                     chain->naffected = 1;
@@ -437,6 +603,7 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
                     if (NULL == chain->affected) {
                         chain->naffected = 0;
                         PMIX_RELEASE(chain);
+                        free(cds);
                         return;
                     }
                     memcpy(chain->affected, ncd->info[n].value.data.darray->array,
@@ -446,7 +613,7 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
         }
         /* check this event out of the cache since we
          * are processing it */
-        pmix_hotel_checkout(&pmix_globals.notifications, ncd->room);
+        pmix_notify_event_uncache(ncd);
         /* release the storage */
         PMIX_RELEASE(ncd);
 
@@ -456,6 +623,9 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
         /* now notify any matching registered callbacks we have */
         pmix_invoke_local_event_hdlr(chain);
     }
+    if (NULL != cds) {
+        free(cds);
+    }
 }
 
 static void reg_event_hdlr(int sd, short args, void *cbdata)
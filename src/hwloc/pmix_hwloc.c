@@ -48,6 +48,7 @@
 #include "src/mca/bfrops/base/base.h"
 #include "src/mca/pnet/pnet.h"
 #include "src/server/pmix_server_ops.h"
+#include "src/threads/pmix_mutex.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_fd.h"
@@ -55,6 +56,7 @@
 #include "src/util/pmix_path.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_timings.h"
 #include "src/util/pmix_vmem.h"
 
 #include "pmix_common.h"
@@ -72,12 +74,28 @@ static char *topo_file = NULL;
 static char *testcpuset = NULL;
 static int pmix_hwloc_output = -1;
 static int pmix_hwloc_verbose = 0;
+static int pmix_hwloc_dist_cache_size = 64;
+static int pmix_hwloc_cpuset_cache_size = 256;
+static int pmix_hwloc_shmem_alternates = 1;
+/* how this process came by its topology */
+static const char *topo_mode = NULL;
 
 #if HWLOC_API_VERSION >= 0x20000
+/* the kinds of hole to fall back to, in order, when the one that
+ * was requested cannot hold the segment */
+static const pmix_vmem_hole_kind_t hole_order[] = {VMEM_HOLE_BIGGEST, VMEM_HOLE_IN_LIBS,
+                                                   VMEM_HOLE_AFTER_HEAP, VMEM_HOLE_BEFORE_STACK,
+                                                   VMEM_HOLE_BEGIN};
+#    define PMIX_HWLOC_MAX_SEGMENTS (1 + sizeof(hole_order) / sizeof(hole_order[0]))
+
+/* the first segment is the one published under the original keys,
+ * any others are copies at other addresses for clients that
+ * already have something mapped where the first one sits */
 static size_t shmemsize = 0;
-static size_t shmemaddr;
-static char *shmemfile = NULL;
-static int shmemfd = -1;
+static size_t shmemaddr[PMIX_HWLOC_MAX_SEGMENTS];
+static char *shmemfile[PMIX_HWLOC_MAX_SEGMENTS];
+static int shmemfd[PMIX_HWLOC_MAX_SEGMENTS];
+static int nsegments = 0;
 static bool space_available = false;
 static uint64_t amount_space_avail = 0;
 
@@ -136,19 +154,48 @@ pmix_status_t pmix_hwloc_register(void)
                                       PMIX_MCA_BASE_VAR_TYPE_STRING,
                                       &testcpuset);
 
+    pmix_hwloc_dist_cache_size = 64;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "hwloc", "dist_cache_size",
+                                      "Number of device distance results computed for distinct "
+                                      "cpusets to keep for reuse (default: 64, 0 = disabled)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_hwloc_dist_cache_size);
+
+    pmix_hwloc_cpuset_cache_size = 256;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "hwloc", "cpuset_cache_size",
+                                      "Number of slots in the cache of cpuset and locality "
+                                      "strings generated or parsed for distinct cpusets - "
+                                      "rounded up to a power of two (default: 256, 0 = disabled)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_hwloc_cpuset_cache_size);
+
+    pmix_hwloc_shmem_alternates = 1;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "hwloc", "shmem_alternates",
+                                      "Number of additional copies of the topology shared memory "
+                                      "segment to place at other addresses for clients unable "
+                                      "to map the first one (default: 1)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_hwloc_shmem_alternates);
+
     return PMIX_SUCCESS;
 }
 
+static void flush_distcache(void);
+static void flush_cpucache(void);
+
 void pmix_hwloc_finalize(void)
 {
+    flush_distcache();
+    flush_cpucache();
 #if HWLOC_API_VERSION >= 0x20000
-    if (NULL != shmemfile) {
-        unlink(shmemfile);
-        free(shmemfile);
-    }
-    if (0 <= shmemfd) {
-        close(shmemfd);
+    int n;
+
+    for (n = 0; n < nsegments; n++) {
+        unlink(shmemfile[n]);
+        free(shmemfile[n]);
+        close(shmemfd[n]);
     }
+    nsegments = 0;
 #endif
     if (NULL != pmix_globals.topology.topology && !pmix_globals.external_topology
         && !topo_in_shmem) {
@@ -157,15 +204,193 @@ void pmix_hwloc_finalize(void)
     return;
 }
 
+/* record our topology locally in case someone does a PMIx_Get
+ * to retrieve it, along with how we came by it */
+static pmix_status_t record_topology(const char *mode)
+{
+    pmix_kval_t kv;
+    pmix_value_t val;
+    pmix_status_t rc;
+
+    topo_mode = mode;
+    kv.key = PMIX_TOPOLOGY2;
+    kv.value = &val;
+    val.type = PMIX_TOPO;
+    val.data.topo = &pmix_globals.topology;
+    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
+    if (PMIX_SUCCESS == rc) {
+        kv.key = PMIX_TOPOLOGY_MODE;
+        val.type = PMIX_STRING;
+        val.data.string = (char *) mode;
+        PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
+    }
+    pmix_output_verbose(2, pmix_hwloc_output, "%s:%s stored", __FILE__, __func__);
+    return rc;
+}
+
+#if HWLOC_API_VERSION >= 0x20000
+/* attach to a topology segment written by our server - returns
+ * PMIX_ERR_NOT_FOUND if we cannot see the backing file */
+static pmix_status_t adopt_segment(const char *file, size_t addr, size_t size)
+{
+    int fd;
+
+    if (0 > (fd = open(file, O_RDONLY))) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 != hwloc_shmem_topology_adopt((hwloc_topology_t *) &pmix_globals.topology.topology,
+                                        fd, 0, (void *) addr, size, 0)) {
+        close(fd);
+        return PMIX_ERROR;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* try any copies of the segment the server placed elsewhere */
+static bool adopt_alternate(pmix_proc_t *wildcard, size_t size)
+{
+    pmix_cb_t cb;
+    pmix_status_t rc;
+    char *alts, **segs, *file;
+    size_t addr;
+    bool adopted = false;
+    int n;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.key = PMIX_TOPOLOGY_SHMEM_ALTS;
+    cb.proc = wildcard;
+    PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+    alts = (PMIX_SUCCESS == rc) ? popstr(&cb) : NULL;
+    cb.key = NULL;
+    PMIX_DESTRUCT(&cb);
+    if (NULL == alts) {
+        return false;
+    }
+    /* each entry is "addr@file" */
+    segs = pmix_argv_split(alts, ',');
+    free(alts);
+    for (n = 0; NULL != segs && NULL != segs[n] && !adopted; n++) {
+        addr = strtoull(segs[n], &file, 0);
+        if ('@' != *file) {
+            continue;
+        }
+        if (PMIX_SUCCESS == adopt_segment(file + 1, addr, size)) {
+            pmix_output_verbose(2, pmix_hwloc_output, "%s:%s adopted shmem at 0x%lx",
+                                __FILE__, __func__, (unsigned long) addr);
+            adopted = true;
+        }
+    }
+    pmix_argv_free(segs);
+    return adopted;
+}
+
+static bool overlaps_segment(size_t addr)
+{
+    int n;
+
+    for (n = 0; n < nsegments; n++) {
+        if (addr < shmemaddr[n] + shmemsize && shmemaddr[n] < addr + shmemsize) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* write a copy of the topology at the given address, tracking
+ * it so the backing file can be removed at finalize. Returns
+ * PMIX_ERR_OUT_OF_RESOURCE if no segment can be created at all */
+static pmix_status_t write_segment(size_t addr)
+{
+    char *file;
+    int fd, rc;
+
+    /* create the shmem file in our session dir so it
+     * will automatically get cleaned up */
+    if (0 == nsegments) {
+        pmix_asprintf(&file, "%s/hwloc.sm", pmix_server_globals.tmpdir);
+    } else {
+        pmix_asprintf(&file, "%s/hwloc.sm.%d", pmix_server_globals.tmpdir, nsegments);
+    }
+    /* let's make sure we have enough space for the backing file */
+    if (PMIX_SUCCESS != enough_space(file, shmemsize, &amount_space_avail, &space_available)) {
+        pmix_output_verbose(2, pmix_hwloc_output,
+                            "%s an error occurred while determining "
+                            "whether or not %s could be created for topo shmem.",
+                            PMIX_NAME_PRINT(&pmix_globals.myid), file);
+        free(file);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    if (!space_available) {
+        if (1 < pmix_output_get_verbosity(pmix_hwloc_output)) {
+            pmix_show_help("help-pmix-ploc-hwloc.txt", "target full", true, file,
+                           pmix_globals.hostname, (unsigned long) shmemsize,
+                           (unsigned long long) amount_space_avail);
+        }
+        free(file);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    /* enough space is available, so create the segment */
+    if (-1 == (fd = open(file, O_CREAT | O_RDWR, 0600))) {
+        int err = errno;
+        if (1 < pmix_output_get_verbosity(pmix_hwloc_output)) {
+            pmix_show_help("help-pmix-ploc-hwloc-hwloc.txt", "sys call fail", true,
+                           pmix_globals.hostname, "open(2)", "", strerror(err), err);
+        }
+        free(file);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    /* ensure nobody inherits this fd */
+    pmix_fd_set_cloexec(fd);
+    /* populate the shmem segment with the topology */
+    rc = hwloc_shmem_topology_write(pmix_globals.topology.topology, fd, 0, (void *) addr,
+                                    shmemsize, 0);
+    if (0 != rc) {
+        pmix_output_verbose(2, pmix_hwloc_output,
+                            "%s an error %d (%s) occurred while writing topology to %s at 0x%lx",
+                            PMIX_NAME_PRINT(&pmix_globals.myid), rc, strerror(errno), file,
+                            (unsigned long) addr);
+        unlink(file);
+        free(file);
+        close(fd);
+        return PMIX_ERROR;
+    }
+    shmemfile[nsegments] = file;
+    shmemfd[nsegments] = fd;
+    shmemaddr[nsegments] = addr;
+    ++nsegments;
+    return PMIX_SUCCESS;
+}
+#endif
+
+static pmix_status_t setup_topology(pmix_info_t *info, size_t ninfo);
+
 pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
+{
+    pmix_status_t rc;
+
+    /* only go thru here ONCE! */
+    if (passed_thru) {
+        return PMIX_SUCCESS;
+    }
+    passed_thru = true;
+
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_TOPOLOGY);
+    rc = setup_topology(info, ninfo);
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_TOPOLOGY);
+    pmix_output_verbose(1, pmix_hwloc_output, "%s topology obtained via %s",
+                        PMIX_NAME_PRINT(&pmix_globals.myid),
+                        (NULL == topo_mode) ? "none" : topo_mode);
+    return rc;
+}
+
+static pmix_status_t setup_topology(pmix_info_t *info, size_t ninfo)
 {
     pmix_cb_t cb;
     pmix_proc_t wildcard;
     char *xmlbuffer = NULL;
     int len;
     size_t n;
-    pmix_kval_t kv, *kptr;
-    pmix_value_t val;
+    pmix_kval_t *kptr;
     bool share = false;
     bool found_dep = false;
     bool found_new = false;
@@ -173,12 +398,6 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
     char *file;
     pmix_status_t rc;
 
-    /* only go thru here ONCE! */
-    if (passed_thru) {
-        return PMIX_SUCCESS;
-    }
-    passed_thru = true;
-
     pmix_output_verbose(2, pmix_hwloc_output,
                         "%s:%s", __FILE__, __func__);
 
@@ -209,13 +428,7 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
     if (NULL != pmix_globals.topology.topology) {
         pmix_output_verbose(2, pmix_hwloc_output,
                             "%s:%s topology externally provided", __FILE__, __func__);
-        /* record locally in case someone does a PMIx_Get to retrieve it */
-        kv.key = PMIX_TOPOLOGY2;
-        kv.value = &val;
-        val.type = PMIX_TOPO;
-        val.data.topo = &pmix_globals.topology;
-        PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
-        pmix_output_verbose(2, pmix_hwloc_output, "%s:%s stored", __FILE__, __func__);
+        rc = record_topology("external");
         if (PMIX_SUCCESS != rc) {
             return rc;
         }
@@ -230,8 +443,8 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
 
     /* try to get it ourselves */
 #if HWLOC_API_VERSION >= 0x20000
-    int fd;
     uint64_t addr, size;
+    const char *mode = NULL;
 
     pmix_output_verbose(2, pmix_hwloc_output, "%s:%s checking shmem",
                         __FILE__, __func__);
@@ -270,18 +483,29 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
     cb.key = NULL;
     PMIX_DESTRUCT(&cb);
 
-    if (0 > (fd = open(file, O_RDONLY))) {
-        free(file);
+    rc = adopt_segment(file, addr, size);
+    free(file);
+    if (PMIX_ERR_NOT_FOUND == rc) {
         /* it may be that a tool has connected to a remote
          * daemon, in which case the file won't be found.
          * Could also be some other error, but let's not
          * treat this as fatal */
         goto tryself;
     }
-    free(file);
-    rc = hwloc_shmem_topology_adopt((hwloc_topology_t *) &pmix_globals.topology.topology, fd, 0,
-                                    (void *) addr, size, 0);
-    if (0 == rc) {
+    if (PMIX_SUCCESS == rc) {
+        mode = "shmem";
+    } else {
+        /* something of ours is already where the segment sits -
+         * provide some feedback and see if the server put a
+         * copy somewhere else before falling back to XML */
+        if (4 < pmix_output_get_verbosity(pmix_hwloc_output)) {
+            print_maps();
+        }
+        if (adopt_alternate(&wildcard, size)) {
+            mode = "shmem-alt";
+        }
+    }
+    if (NULL != mode) {
         pmix_output_verbose(2, pmix_hwloc_output, "%s:%s shmem adopted",
                             __FILE__, __func__);
         /* got it - we are done */
@@ -290,24 +514,11 @@ pmix_status_t pmix_hwloc_setup_topology(pmix_info_t *info, size_t ninfo)
 #    else
         pmix_globals.topology.source = strdup("hwloc");
 #    endif
-        /* record locally in case someone does a PMIx_Get to retrieve it */
-        kv.key = PMIX_TOPOLOGY2;
-        kv.value = &val;
-        val.type = PMIX_TOPO;
-        val.data.topo = &pmix_globals.topology;
-        PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
-        pmix_output_verbose(2, pmix_hwloc_output, "%s:%s stored", __FILE__,
-                            __func__);
+        (void) record_topology(mode);
         topo_in_shmem = true;
         return PMIX_SUCCESS;
     }
 
-    /* failed to adopt from shmem, so provide some feedback and
-     * then fallback to other ways to get the topology */
-    if (4 < pmix_output_get_verbosity(pmix_hwloc_output)) {
-        print_maps();
-    }
-
 tryxml:
     pmix_output_verbose(2, pmix_hwloc_output, "%s:%s checking v2 xml",
                         __FILE__, __func__);
@@ -326,14 +537,7 @@ tryxml:
         if (PMIX_SUCCESS == rc) {
             pmix_output_verbose(2, pmix_hwloc_output,
                                 "%s:%s v2 xml adopted", __FILE__, __func__);
-            /* record locally in case someone does a PMIx_Get to retrieve it */
-            kv.key = PMIX_TOPOLOGY2;
-            kv.value = &val;
-            val.type = PMIX_TOPO;
-            val.data.topo = &pmix_globals.topology;
-            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
-            pmix_output_verbose(2, pmix_hwloc_output, "%s:%s stored",
-                                __FILE__, __func__);
+            rc = record_topology("xml-v2");
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
             }
@@ -364,15 +568,7 @@ tryxml:
         if (PMIX_SUCCESS == rc) {
             pmix_output_verbose(2, pmix_hwloc_output,
                                 "%s:%s v1 xml adopted", __FILE__, __func__);
-
-            /* record locally in case someone does a PMIx_Get to retrieve it */
-            kv.key = PMIX_TOPOLOGY2;
-            kv.value = &val;
-            val.type = PMIX_TOPO;
-            val.data.topo = &pmix_globals.topology;
-            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
-            pmix_output_verbose(2, pmix_hwloc_output, "%s:%s stored",
-                                __FILE__, __func__);
+            rc = record_topology("xml-v1");
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
             }
@@ -438,14 +634,7 @@ tryself:
                             "%s:%s discovery complete - source %s", __FILE__, __func__,
                             pmix_globals.topology.source);
     }
-    /* record locally in case someone does a PMIx_Get to retrieve it */
-    kv.key = PMIX_TOPOLOGY2;
-    kv.value = &val;
-    val.type = PMIX_TOPO;
-    val.data.topo = &pmix_globals.topology;
-    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, &kv);
-    pmix_output_verbose(2, pmix_hwloc_output, "%s:%s stored", __FILE__,
-                        __func__);
+    (void) record_topology((NULL != topo_file) ? "file" : "discovered");
 
     /* if we don't need to share it, then we are done */
     if (!share) {
@@ -485,6 +674,11 @@ sharetopo:
     /* we don't have the ability to do shared memory, so we are done */
     return PMIX_SUCCESS;
 #else
+    pmix_vmem_hole_kind_t kind;
+    size_t segaddr;
+    char **alts = NULL;
+    int maxsegs, m;
+
     /* pass the topology as a v2 xml string */
     if (0 == hwloc_topology_export_xmlbuffer(pmix_globals.topology.topology, &xmlbuffer, &len, 0)) {
         pmix_output_verbose(2, pmix_hwloc_output, "%s:%s export v2 xml",
@@ -532,79 +726,48 @@ sharetopo:
         return PMIX_SUCCESS;
     }
 
-    /* try and find a hole */
-    if (PMIX_SUCCESS != pmix_vmem_find_hole(hole_kind, &shmemaddr, shmemsize)) {
-        /* we couldn't find a hole, so don't use the shmem support */
-        if (4 < pmix_output_get_verbosity(pmix_hwloc_output)) {
-            print_maps();
+    /* try the requested kind of hole first, then the others, until
+     * the segment has been written with the requested number of
+     * copies at non-overlapping addresses */
+    maxsegs = 1 + ((0 < pmix_hwloc_shmem_alternates) ? pmix_hwloc_shmem_alternates : 0);
+    for (n = 0; n < PMIX_HWLOC_MAX_SEGMENTS && nsegments < maxsegs; n++) {
+        if (0 == n) {
+            kind = hole_kind;
+        } else if (hole_kind == (kind = hole_order[n - 1])) {
+            continue;
         }
-        return PMIX_SUCCESS;
-    }
-    /* create the shmem file in our session dir so it
-     * will automatically get cleaned up */
-    pmix_asprintf(&shmemfile, "%s/hwloc.sm", pmix_server_globals.tmpdir);
-    /* let's make sure we have enough space for the backing file */
-    if (PMIX_SUCCESS != enough_space(shmemfile, shmemsize, &amount_space_avail, &space_available)) {
-        pmix_output_verbose(2, pmix_hwloc_output,
-                            "%s an error occurred while determining "
-                            "whether or not %s could be created for topo shmem.",
-                            PMIX_NAME_PRINT(&pmix_globals.myid), shmemfile);
-        free(shmemfile);
-        shmemfile = NULL;
-        return PMIX_SUCCESS;
-    }
-    if (!space_available) {
-        if (1 < pmix_output_get_verbosity(pmix_hwloc_output)) {
-            pmix_show_help("help-pmix-ploc-hwloc.txt", "target full", true, shmemfile,
-                           pmix_globals.hostname, (unsigned long) shmemsize,
-                           (unsigned long long) amount_space_avail);
+        if (PMIX_SUCCESS != pmix_vmem_find_hole(kind, &segaddr, shmemsize)
+            || overlaps_segment(segaddr)) {
+            continue;
+        }
+        if (PMIX_ERR_OUT_OF_RESOURCE == write_segment(segaddr)) {
+            break;
         }
-        free(shmemfile);
-        shmemfile = NULL;
-        return PMIX_SUCCESS;
     }
-    /* enough space is available, so create the segment */
-    if (-1 == (shmemfd = open(shmemfile, O_CREAT | O_RDWR, 0600))) {
-        int err = errno;
-        if (1 < pmix_output_get_verbosity(pmix_hwloc_output)) {
-            pmix_show_help("help-pmix-ploc-hwloc-hwloc.txt", "sys call fail", true,
-                           pmix_globals.hostname, "open(2)", "", strerror(err), err);
+    if (0 == nsegments) {
+        /* we couldn't find a hole, so don't use the shmem support */
+        if (4 < pmix_output_get_verbosity(pmix_hwloc_output)) {
+            print_maps();
         }
-        free(shmemfile);
-        shmemfile = NULL;
         return PMIX_SUCCESS;
     }
-    /* ensure nobody inherits this fd */
-    pmix_fd_set_cloexec(shmemfd);
-    /* populate the shmem segment with the topology */
-    rc = hwloc_shmem_topology_write(pmix_globals.topology.topology, shmemfd, 0, (void *) shmemaddr,
-                                    shmemsize, 0);
-    if (0 != rc) {
-        pmix_output_verbose(2, pmix_hwloc_output,
-                            "%s an error %d (%s) occurred while writing topology to %s",
-                            PMIX_NAME_PRINT(&pmix_globals.myid), rc, strerror(errno), shmemfile);
-        unlink(shmemfile);
-        free(shmemfile);
-        shmemfile = NULL;
-        close(shmemfd);
-        shmemfd = -1;
-        return PMIX_SUCCESS;
+    for (m = 0; m < nsegments; m++) {
+        pmix_output_verbose(2, pmix_hwloc_output, "%s:%s exported shmem to %s at 0x%lx",
+                            __FILE__, __func__, shmemfile[m], (unsigned long) shmemaddr[m]);
     }
-    pmix_output_verbose(2, pmix_hwloc_output, "%s:%s exported shmem",
-                        __FILE__, __func__);
 
     /* add the requisite key-values to the global data to be
      * given to each client for older PMIx versions */
     kptr = PMIX_NEW(pmix_kval_t);
     kptr->key = strdup(PMIX_HWLOC_SHMEM_FILE);
     kptr->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-    PMIX_VALUE_LOAD(kptr->value, shmemfile, PMIX_STRING);
+    PMIX_VALUE_LOAD(kptr->value, shmemfile[0], PMIX_STRING);
     pmix_list_append(&pmix_server_globals.gdata, &kptr->super);
 
     kptr = PMIX_NEW(pmix_kval_t);
     kptr->key = strdup(PMIX_HWLOC_SHMEM_ADDR);
     kptr->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-    PMIX_VALUE_LOAD(kptr->value, &shmemaddr, PMIX_SIZE);
+    PMIX_VALUE_LOAD(kptr->value, &shmemaddr[0], PMIX_SIZE);
     pmix_list_append(&pmix_server_globals.gdata, &kptr->super);
 
     kptr = PMIX_NEW(pmix_kval_t);
@@ -613,6 +776,22 @@ sharetopo:
     PMIX_VALUE_LOAD(kptr->value, &shmemsize, PMIX_SIZE);
     pmix_list_append(&pmix_server_globals.gdata, &kptr->super);
 
+    /* and where the copies are */
+    if (1 < nsegments) {
+        for (m = 1; m < nsegments; m++) {
+            pmix_asprintf(&file, "0x%lx@%s", (unsigned long) shmemaddr[m], shmemfile[m]);
+            pmix_argv_append_nosize(&alts, file);
+            free(file);
+        }
+        kptr = PMIX_NEW(pmix_kval_t);
+        kptr->key = strdup(PMIX_TOPOLOGY_SHMEM_ALTS);
+        kptr->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        kptr->value->type = PMIX_STRING;
+        kptr->value->data.string = pmix_argv_join(alts, ',');
+        pmix_argv_free(alts);
+        pmix_list_append(&pmix_server_globals.gdata, &kptr->super);
+    }
+
 #endif
 
     return PMIX_SUCCESS;
@@ -696,9 +875,180 @@ pmix_status_t pmix_hwloc_load_topology(pmix_topology_t *topo)
     return rc;
 }
 
+/* The server generates the cpuset and locality strings of every
+ * local proc when the nspace is registered, and the clients parse
+ * them back - yet the procs of a node are bound to a handful of
+ * distinct cpusets. Each distinct cpuset is therefore kept once,
+ * with its strings as they are computed, in two direct-mapped
+ * tables - one hashed by the bitmap and one by the cpuset string.
+ * A colliding cpuset simply replaces the previous one in its slot */
+typedef struct {
+    pmix_object_t super;
+    hwloc_cpuset_t bitmap;
+    char *cpustr;
+    char *locality;
+    bool have_locality;
+} pmix_hwloc_cpucache_t;
+static void cccon(pmix_hwloc_cpucache_t *p)
+{
+    p->bitmap = NULL;
+    p->cpustr = NULL;
+    p->locality = NULL;
+    p->have_locality = false;
+}
+static void ccdes(pmix_hwloc_cpucache_t *p)
+{
+    if (NULL != p->bitmap) {
+        hwloc_bitmap_free(p->bitmap);
+    }
+    if (NULL != p->cpustr) {
+        free(p->cpustr);
+    }
+    if (NULL != p->locality) {
+        free(p->locality);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_hwloc_cpucache_t, pmix_object_t, cccon, ccdes);
+
+static pmix_mutex_t cpulock = PMIX_MUTEX_STATIC_INIT;
+static pmix_hwloc_cpucache_t **bybitmap = NULL;
+static pmix_hwloc_cpucache_t **bystring = NULL;
+static size_t cpucache_mask = 0;
+/* the topology the cached locality strings were computed for */
+static hwloc_topology_t cpucache_topo = NULL;
+
+static void flush_cpucache(void)
+{
+    size_t n;
+
+    if (NULL == bybitmap) {
+        return;
+    }
+    for (n = 0; n <= cpucache_mask; n++) {
+        if (NULL != bybitmap[n]) {
+            PMIX_RELEASE(bybitmap[n]);
+        }
+        if (NULL != bystring[n]) {
+            PMIX_RELEASE(bystring[n]);
+        }
+    }
+    free(bybitmap);
+    free(bystring);
+    bybitmap = NULL;
+    bystring = NULL;
+    cpucache_mask = 0;
+    cpucache_topo = NULL;
+}
+
+/* must be called with the cpulock held */
+static bool cpucache_ready(void)
+{
+    size_t nslots;
+
+    if (NULL != bybitmap) {
+        return true;
+    }
+    if (0 >= pmix_hwloc_cpuset_cache_size) {
+        return false;
+    }
+    for (nslots = 1; nslots < (size_t) pmix_hwloc_cpuset_cache_size; nslots <<= 1) {
+        continue;
+    }
+    bybitmap = (pmix_hwloc_cpucache_t **) calloc(nslots, sizeof(pmix_hwloc_cpucache_t *));
+    bystring = (pmix_hwloc_cpucache_t **) calloc(nslots, sizeof(pmix_hwloc_cpucache_t *));
+    if (NULL == bybitmap || NULL == bystring) {
+        free(bybitmap);
+        free(bystring);
+        bybitmap = NULL;
+        bystring = NULL;
+        return false;
+    }
+    cpucache_mask = nslots - 1;
+    cpucache_topo = pmix_globals.topology.topology;
+    return true;
+}
+
+static size_t hash_bitmap(hwloc_const_cpuset_t bitmap)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned long word;
+    int last, n;
+
+    last = hwloc_bitmap_last(bitmap);
+    if (0 > last) {
+        /* empty or infinite */
+        return hwloc_bitmap_iszero(bitmap) ? 0 : 1;
+    }
+    for (n = 0; n <= last / (int) (8 * sizeof(unsigned long)); n++) {
+        word = hwloc_bitmap_to_ith_ulong(bitmap, n);
+        hash = (hash ^ (uint64_t) word) * 1099511628211ULL;
+    }
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+static size_t hash_string(const char *str)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (; '\0' != *str; str++) {
+        hash = (hash ^ (unsigned char) *str) * 1099511628211ULL;
+    }
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+/* must be called with the cpulock held */
+static pmix_hwloc_cpucache_t *find_bitmap(hwloc_const_cpuset_t bitmap)
+{
+    pmix_hwloc_cpucache_t *cc;
+
+    cc = bybitmap[hash_bitmap(bitmap) & cpucache_mask];
+    if (NULL != cc && hwloc_bitmap_isequal(cc->bitmap, bitmap)) {
+        return cc;
+    }
+    return NULL;
+}
+
+/* must be called with the cpulock held - returns the entry of the
+ * bitmap, adding one if there is none */
+static pmix_hwloc_cpucache_t *add_bitmap(hwloc_const_cpuset_t bitmap)
+{
+    pmix_hwloc_cpucache_t *cc;
+    size_t slot;
+
+    slot = hash_bitmap(bitmap) & cpucache_mask;
+    cc = bybitmap[slot];
+    if (NULL != cc && hwloc_bitmap_isequal(cc->bitmap, bitmap)) {
+        return cc;
+    }
+    if (NULL != cc) {
+        PMIX_RELEASE(cc);
+    }
+    cc = PMIX_NEW(pmix_hwloc_cpucache_t);
+    cc->bitmap = hwloc_bitmap_dup(bitmap);
+    bybitmap[slot] = cc;
+    return cc;
+}
+
+/* must be called with the cpulock held */
+static void add_string(pmix_hwloc_cpucache_t *cc)
+{
+    size_t slot;
+
+    slot = hash_string(cc->cpustr) & cpucache_mask;
+    if (bystring[slot] == cc) {
+        return;
+    }
+    if (NULL != bystring[slot]) {
+        PMIX_RELEASE(bystring[slot]);
+    }
+    PMIX_RETAIN(cc);
+    bystring[slot] = cc;
+}
+
 pmix_status_t pmix_hwloc_generate_cpuset_string(const pmix_cpuset_t *cpuset,
                                                 char **cpuset_string)
 {
+    pmix_hwloc_cpucache_t *cc;
     char *tmp;
 
     if (NULL == cpuset || NULL == cpuset->bitmap) {
@@ -711,15 +1061,37 @@ pmix_status_t pmix_hwloc_generate_cpuset_string(const pmix_cpuset_t *cpuset,
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
 
+    pmix_mutex_lock(&cpulock);
+    if (cpucache_ready()) {
+        cc = find_bitmap(cpuset->bitmap);
+        if (NULL != cc && NULL != cc->cpustr) {
+            *cpuset_string = strdup(cc->cpustr);
+            pmix_mutex_unlock(&cpulock);
+            return PMIX_SUCCESS;
+        }
+    }
+    pmix_mutex_unlock(&cpulock);
+
     hwloc_bitmap_list_asprintf(&tmp, cpuset->bitmap);
     pmix_asprintf(cpuset_string, "hwloc:%s", tmp);
     free(tmp);
 
+    pmix_mutex_lock(&cpulock);
+    if (cpucache_ready() && NULL != *cpuset_string) {
+        cc = add_bitmap(cpuset->bitmap);
+        if (NULL == cc->cpustr) {
+            cc->cpustr = strdup(*cpuset_string);
+        }
+        add_string(cc);
+    }
+    pmix_mutex_unlock(&cpulock);
+
     return PMIX_SUCCESS;
 }
 
 pmix_status_t pmix_hwloc_parse_cpuset_string(const char *cpuset_string, pmix_cpuset_t *cpuset)
 {
+    pmix_hwloc_cpucache_t *cc;
     char *src;
 
     /* if we aren't the source, then pass */
@@ -737,15 +1109,91 @@ pmix_status_t pmix_hwloc_parse_cpuset_string(const char *cpuset_string, pmix_cpu
     ++src;
 
     cpuset->source = strdup("hwloc");
+
+    pmix_mutex_lock(&cpulock);
+    if (cpucache_ready()) {
+        cc = bystring[hash_string(cpuset_string) & cpucache_mask];
+        if (NULL != cc && 0 == strcmp(cc->cpustr, cpuset_string)) {
+            cpuset->bitmap = hwloc_bitmap_dup(cc->bitmap);
+            pmix_mutex_unlock(&cpulock);
+            return PMIX_SUCCESS;
+        }
+    }
+    pmix_mutex_unlock(&cpulock);
+
     cpuset->bitmap = hwloc_bitmap_alloc();
     hwloc_bitmap_list_sscanf(cpuset->bitmap, src);
 
+    pmix_mutex_lock(&cpulock);
+    if (cpucache_ready()) {
+        cc = add_bitmap(cpuset->bitmap);
+        if (NULL == cc->cpustr) {
+            cc->cpustr = strdup(cpuset_string);
+        }
+        if (0 == strcmp(cc->cpustr, cpuset_string)) {
+            add_string(cc);
+        }
+    }
+    pmix_mutex_unlock(&cpulock);
+
     return PMIX_SUCCESS;
 }
 
+static pmix_status_t generate_locality_string(const pmix_cpuset_t *cpuset, char **loc);
+
 pmix_status_t pmix_hwloc_generate_locality_string(const pmix_cpuset_t *cpuset, char **loc)
 {
-    char *locality = NULL, *tmp, *t2;
+    pmix_hwloc_cpucache_t *cc;
+    pmix_status_t rc;
+
+    /* if we aren't the source, then pass */
+    if (0 != strncasecmp(cpuset->source, "hwloc", 5)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (NULL == cpuset->bitmap) {
+        *loc = NULL;
+        return PMIX_SUCCESS;
+    }
+
+    pmix_mutex_lock(&cpulock);
+    if (cpucache_ready()) {
+        if (cpucache_topo != pmix_globals.topology.topology) {
+            /* our topology was replaced */
+            flush_cpucache();
+            if (!cpucache_ready()) {
+                goto compute;
+            }
+        }
+        cc = find_bitmap(cpuset->bitmap);
+        if (NULL != cc && cc->have_locality) {
+            *loc = (NULL == cc->locality) ? NULL : strdup(cc->locality);
+            pmix_mutex_unlock(&cpulock);
+            return PMIX_SUCCESS;
+        }
+    }
+
+compute:
+    pmix_mutex_unlock(&cpulock);
+    rc = generate_locality_string(cpuset, loc);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    pmix_mutex_lock(&cpulock);
+    if (cpucache_ready() && cpucache_topo == pmix_globals.topology.topology) {
+        cc = add_bitmap(cpuset->bitmap);
+        if (!cc->have_locality) {
+            cc->locality = (NULL == *loc) ? NULL : strdup(*loc);
+            cc->have_locality = true;
+        }
+    }
+    pmix_mutex_unlock(&cpulock);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t generate_locality_string(const pmix_cpuset_t *cpuset, char **loc)
+{
+    char *locality = NULL, *tmp, *t2;
     unsigned depth, d;
     hwloc_cpuset_t result;
     hwloc_obj_type_t type;
@@ -900,9 +1348,13 @@ pmix_status_t pmix_hwloc_generate_locality_string(const pmix_cpuset_t *cpuset, c
 
     hwloc_bitmap_free(result);
 
-    /* remove the trailing colon */
+    /* remove the trailing colon and mark the string as
+     * ours so pmix_hwloc_get_relative_locality accepts it */
     if (NULL != locality) {
         locality[strlen(locality) - 1] = '\0';
+        pmix_asprintf(&t2, "hwloc:%s", locality);
+        free(locality);
+        locality = t2;
     }
     *loc = locality;
     return PMIX_SUCCESS;
@@ -916,7 +1368,7 @@ pmix_status_t pmix_hwloc_get_relative_locality(const char *locality1,
     char *loc1, *loc2, **set1, **set2;
     hwloc_bitmap_t bit1, bit2;
     size_t n1, n2;
-    pmix_status_t rc = PMIX_ERR_TAKE_NEXT_OPTION;
+    pmix_status_t rc = PMIX_SUCCESS;
 
     /* check that locality was generated by us */
     if (0 != strncasecmp(locality1, "hwloc:", strlen("hwloc:"))
@@ -979,6 +1431,103 @@ pmix_status_t pmix_hwloc_get_relative_locality(const char *locality1,
     return rc;
 }
 
+/* the types that can appear in a locality string and the
+ * relative locality bit that each of them contributes */
+static const struct {
+    const char *type;
+    pmix_locality_t bit;
+} loclevels[] = {
+    {"NM", PMIX_LOCALITY_SHARE_NUMA},
+    {"SK", PMIX_LOCALITY_SHARE_PACKAGE},
+    {"L3", PMIX_LOCALITY_SHARE_L3CACHE},
+    {"L2", PMIX_LOCALITY_SHARE_L2CACHE},
+    {"L1", PMIX_LOCALITY_SHARE_L1CACHE},
+    {"CR", PMIX_LOCALITY_SHARE_CORE},
+    {"HT", PMIX_LOCALITY_SHARE_HWTHREAD}
+};
+#define PMIX_HWLOC_NUM_LOCLEVELS (sizeof(loclevels) / sizeof(loclevels[0]))
+
+pmix_status_t pmix_hwloc_get_locality_matrix(char **localities, size_t n,
+                                             pmix_byte_object_t *matrix)
+{
+    hwloc_bitmap_t *sets, b1, b2;
+    char **fields;
+    size_t i, j, k, m;
+    uint8_t bits;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    PMIX_BYTE_OBJECT_CONSTRUCT(matrix);
+    if (0 == n) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* convert each string just once - sets[i * NUM_LOCLEVELS + k]
+     * holds the location of proc i at level k, if it has one */
+    sets = (hwloc_bitmap_t *) calloc(n * PMIX_HWLOC_NUM_LOCLEVELS, sizeof(hwloc_bitmap_t));
+    if (NULL == sets) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (i = 0; i < n && PMIX_SUCCESS == rc; i++) {
+        /* check that locality was generated by us */
+        if (NULL == localities[i] || 0 != strncasecmp(localities[i], "hwloc:", strlen("hwloc:"))) {
+            rc = PMIX_ERR_TAKE_NEXT_OPTION;
+            break;
+        }
+        fields = pmix_argv_split(&localities[i][strlen("hwloc:")], ':');
+        for (m = 0; NULL != fields && NULL != fields[m]; m++) {
+            for (k = 0; k < PMIX_HWLOC_NUM_LOCLEVELS; k++) {
+                if (0 == strncmp(fields[m], loclevels[k].type, 2)) {
+                    break;
+                }
+            }
+            if (PMIX_HWLOC_NUM_LOCLEVELS == k) {
+                /* should never happen */
+                pmix_output(0, "UNRECOGNIZED LOCALITY %s", fields[m]);
+                rc = PMIX_ERROR;
+                break;
+            }
+            if (NULL == sets[i * PMIX_HWLOC_NUM_LOCLEVELS + k]) {
+                sets[i * PMIX_HWLOC_NUM_LOCLEVELS + k] = hwloc_bitmap_alloc();
+                hwloc_bitmap_list_sscanf(sets[i * PMIX_HWLOC_NUM_LOCLEVELS + k], &fields[m][2]);
+            }
+        }
+        pmix_argv_free(fields);
+    }
+
+    if (PMIX_SUCCESS == rc) {
+        matrix->size = n * (n + 1) / 2;
+        matrix->bytes = (char *) malloc(matrix->size);
+        if (NULL == matrix->bytes) {
+            matrix->size = 0;
+            rc = PMIX_ERR_NOMEM;
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        m = 0;
+        for (i = 0; i < n; i++) {
+            for (j = i; j < n; j++) {
+                bits = 0;
+                for (k = 0; k < PMIX_HWLOC_NUM_LOCLEVELS; k++) {
+                    b1 = sets[i * PMIX_HWLOC_NUM_LOCLEVELS + k];
+                    b2 = sets[j * PMIX_HWLOC_NUM_LOCLEVELS + k];
+                    if (NULL != b1 && NULL != b2 && hwloc_bitmap_intersects(b1, b2)) {
+                        bits |= (uint8_t) loclevels[k].bit;
+                    }
+                }
+                matrix->bytes[m++] = (char) bits;
+            }
+        }
+    }
+
+    for (i = 0; i < n * PMIX_HWLOC_NUM_LOCLEVELS; i++) {
+        if (NULL != sets[i]) {
+            hwloc_bitmap_free(sets[i]);
+        }
+    }
+    free(sets);
+    return rc;
+}
+
 pmix_status_t pmix_hwloc_get_cpuset(pmix_cpuset_t *cpuset, pmix_bind_envelope_t ref)
 {
     int rc, flag;
@@ -1041,20 +1590,6 @@ static hwloc_obj_t dsearch(hwloc_topology_t t, int depth, hwloc_cpuset_t cpuset)
     return NULL;
 }
 
-typedef struct {
-    pmix_list_item_t super;
-    pmix_device_distance_t dist;
-} pmix_devdist_item_t;
-static void dvcon(pmix_devdist_item_t *p)
-{
-    PMIX_DEVICE_DIST_CONSTRUCT(&p->dist);
-}
-static void dvdes(pmix_devdist_item_t *p)
-{
-    PMIX_DEVICE_DIST_DESTRUCT(&p->dist);
-}
-static PMIX_CLASS_INSTANCE(pmix_devdist_item_t, pmix_list_item_t, dvcon, dvdes);
-
 typedef struct {
     hwloc_obj_osdev_type_t hwtype;
     pmix_device_type_t pxtype;
@@ -1087,67 +1622,217 @@ static int countcolons(char *str)
     return cnt;
 }
 
-pmix_status_t pmix_hwloc_compute_distances(pmix_topology_t *topo, pmix_cpuset_t *cpuset,
-                                           pmix_info_t info[], size_t ninfo,
-                                           pmix_device_distance_t **dist, size_t *ndist)
+/* a device of a topology that distances can be computed to */
+typedef struct {
+    pmix_device_type_t type;
+    char *uuid;
+    char *osname;
+    hwloc_obj_t obj;        // nearest object with a cpuset, if any
+    pmix_status_t status;   // error to report if this device is requested
+} pmix_hwloc_device_t;
+
+typedef struct {
+    hwloc_topology_t topology;
+    unsigned depth;
+    pmix_hwloc_device_t *devices;
+    size_t ndevices;
+} pmix_hwloc_devtable_t;
+
+/* computed distances for one cpuset and set of directives */
+typedef struct {
+    pmix_list_item_t super;
+    hwloc_bitmap_t cpuset;
+    pmix_device_type_t type;
+    char *devids;
+    pmix_device_distance_t *dist;
+    size_t ndist;
+} pmix_hwloc_distcache_t;
+static void dccon(pmix_hwloc_distcache_t *p)
 {
-    hwloc_obj_t obj = NULL;
-    hwloc_obj_t tgt;
-    hwloc_obj_t device;
-    hwloc_obj_t ancestor;
-    hwloc_obj_t pu;
-    unsigned dp, depth;
-    unsigned maxdist = 0;
-    unsigned mindist = UINT_MAX;
+    p->cpuset = NULL;
+    p->type = 0;
+    p->devids = NULL;
+    p->dist = NULL;
+    p->ndist = 0;
+}
+static void dcdes(pmix_hwloc_distcache_t *p)
+{
+    if (NULL != p->cpuset) {
+        hwloc_bitmap_free(p->cpuset);
+    }
+    if (NULL != p->devids) {
+        free(p->devids);
+    }
+    if (NULL != p->dist) {
+        PMIX_DEVICE_DIST_FREE(p->dist, p->ndist);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_hwloc_distcache_t, pmix_list_item_t, dccon, dcdes);
+
+/* the devices of our own topology are found just once and the
+ * distances computed for it are kept, as the procs on a node
+ * typically ask about only a handful of distinct cpusets. Both
+ * can be reached from the caller's thread in a client */
+static pmix_mutex_t distlock = PMIX_MUTEX_STATIC_INIT;
+static pmix_hwloc_devtable_t devtable = {NULL, 0, NULL, 0};
+static pmix_list_t distcache;
+static bool distcache_init = false;
+
+static void release_devtable(pmix_hwloc_devtable_t *tbl)
+{
+    size_t n;
+
+    for (n = 0; n < tbl->ndevices; n++) {
+        if (NULL != tbl->devices[n].uuid) {
+            free(tbl->devices[n].uuid);
+        }
+        if (NULL != tbl->devices[n].osname) {
+            free(tbl->devices[n].osname);
+        }
+    }
+    if (NULL != tbl->devices) {
+        free(tbl->devices);
+    }
+    tbl->topology = NULL;
+    tbl->devices = NULL;
+    tbl->ndevices = 0;
+}
+
+static pmix_status_t build_devtable(hwloc_topology_t topology, pmix_hwloc_devtable_t *tbl)
+{
+    hwloc_obj_t device, tgt;
+    pmix_hwloc_device_t *d;
+    size_t n, ntypes, ndevs;
     unsigned i;
-    pmix_list_t dists;
-    pmix_devdist_item_t *d;
-    pmix_device_distance_t *array;
-    size_t n, ntypes, dn;
     int cnt;
-    unsigned w, width, pudepth;
-    pmix_device_type_t type = 0;
-    char **devids = NULL;
-    bool found;
 
-    if (NULL == topo->source || NULL == cpuset->source) {
-        return PMIX_ERR_BAD_PARAM;
-    }
+    tbl->topology = topology;
+    tbl->depth = hwloc_topology_get_depth(topology);
+    tbl->devices = NULL;
+    tbl->ndevices = 0;
 
-    if (0 != strncasecmp(topo->source, "hwloc", 5)
-        || 0 != strncasecmp(cpuset->source, "hwloc", 5)) {
-        return PMIX_ERR_TAKE_NEXT_OPTION;
+    /* count the OS devices to get an upper bound */
+    ndevs = 0;
+    device = hwloc_get_obj_by_type(topology, HWLOC_OBJ_OS_DEVICE, 0);
+    while (NULL != device) {
+        ++ndevs;
+        device = hwloc_get_next_osdev(topology, device);
+    }
+    if (0 == ndevs) {
+        return PMIX_SUCCESS;
+    }
+    tbl->devices = (pmix_hwloc_device_t *) calloc(ndevs, sizeof(pmix_hwloc_device_t));
+    if (NULL == tbl->devices) {
+        return PMIX_ERR_NOMEM;
     }
-
-    /* set default returns */
-    *dist = NULL;
-    *ndist = 0;
 
     /* determine number of types we support */
     ntypes = sizeof(table) / sizeof(pmix_type_conversion_t);
 
-    /* determine what they want us to look at */
-    if (NULL == info) {
-        /* find everything */
-        for (n = 0; n < ntypes; n++) {
-            type |= table[n].pxtype;
+    /* record the devices in the order they are to be reported */
+    for (n = 0; n < ntypes; n++) {
+        if (HWLOC_OBJ_OSDEV_BLOCK == table[n].hwtype || HWLOC_OBJ_OSDEV_DMA == table[n].hwtype
+#if HWLOC_API_VERSION >= 0x00010800
+            || HWLOC_OBJ_OSDEV_COPROC == table[n].hwtype
+#endif
+            ) {
+            continue;
         }
-    } else {
-        for (n = 0; n < ninfo; n++) {
-            if (PMIX_CHECK_KEY(&info[n], PMIX_DEVICE_TYPE)) {
-                type |= info[n].value.data.devtype;
-            } else if (PMIX_CHECK_KEY(&info[n], PMIX_DEVICE_ID)) {
-                pmix_argv_append_nosize(&devids, info[n].value.data.string);
+        device = hwloc_get_obj_by_type(topology, HWLOC_OBJ_OS_DEVICE, 0);
+        for (; NULL != device; device = hwloc_get_next_osdev(topology, device)) {
+            if (device->attr->osdev.type != table[n].hwtype) {
+                continue;
+            }
+            d = &tbl->devices[tbl->ndevices];
+            d->type = table[n].pxtype;
+            d->status = PMIX_SUCCESS;
+
+            /* Construct a UUID for this device */
+            if (HWLOC_OBJ_OSDEV_NETWORK == table[n].hwtype) {
+                char *addr = NULL;
+                /* find the address */
+                for (i = 0; i < device->infos_count; i++) {
+                    if (0 == strcasecmp(device->infos[i].name, "Address")) {
+                        addr = device->infos[i].value;
+                        break;
+                    }
+                }
+                if (NULL == addr) {
+                    /* couldn't find an address - report it as an error */
+                    d->status = PMIX_ERROR;
+                } else {
+                    /* could be IPv4 or IPv6 */
+                    cnt = countcolons(addr);
+                    if (5 == cnt) {
+                        pmix_asprintf(&d->uuid, "ipv4://%s", addr);
+                    } else if (19 == cnt) {
+                        pmix_asprintf(&d->uuid, "ipv6://%s", addr);
+                    } else {
+                        /* unknown address type */
+                        d->status = PMIX_ERROR;
+                    }
+                }
+            } else if (HWLOC_OBJ_OSDEV_OPENFABRICS == table[n].hwtype) {
+                char *ngid = NULL;
+                char *sgid = NULL;
+                /* find the UIDs */
+                for (i = 0; i < device->infos_count; i++) {
+                    if (0 == strcasecmp(device->infos[i].name, "NodeGUID")) {
+                        ngid = device->infos[i].value;
+                    } else if (0 == strcasecmp(device->infos[i].name, "SysImageGUID")) {
+                        sgid = device->infos[i].value;
+                    }
+                }
+                if (NULL == ngid || NULL == sgid) {
+                    d->status = PMIX_ERROR;
+                } else {
+                    pmix_asprintf(&d->uuid, "fab://%s::%s", ngid, sgid);
+                }
+            } else if (HWLOC_OBJ_OSDEV_GPU == table[n].hwtype) {
+                /* if the name starts with "card", then this is just the aux card of the GPU */
+                if (0 == strncasecmp(device->name, "card", 4)) {
+                    continue;
+                }
+                pmix_asprintf(&d->uuid, "gpu://%s::%s", pmix_globals.hostname, device->name);
+            } else {
+                /* unknown type */
+                continue;
+            }
+            d->osname = strdup(device->name);
+
+            /* climb the topology until we find a non-NULL cpuset */
+            tgt = device;
+            while (NULL != tgt && NULL == tgt->cpuset) {
+                tgt = tgt->parent;
             }
+            d->obj = tgt;
+            ++tbl->ndevices;
         }
     }
 
-    /* find the max depth of this topology */
-    depth = hwloc_topology_get_depth(topo->topology);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t compute_from_table(pmix_hwloc_devtable_t *tbl, hwloc_cpuset_t cpuset,
+                                        pmix_device_type_t type, char **devids,
+                                        pmix_device_distance_t **dist, size_t *ndist)
+{
+    hwloc_obj_t obj = NULL;
+    hwloc_obj_t tgt;
+    hwloc_obj_t ancestor;
+    hwloc_obj_t pu;
+    pmix_hwloc_device_t *d;
+    pmix_device_distance_t *array;
+    unsigned dp, depth = tbl->depth;
+    unsigned w, width, pudepth;
+    unsigned *dists;
+    size_t n, m, dn, *found;
+    bool inset, match;
+    pmix_status_t rc = PMIX_SUCCESS;
 
     /* get the lowest object that completely covers the cpuset */
     for (dp = 1; dp < depth; dp++) {
-        tgt = dsearch(topo->topology, dp, cpuset->bitmap);
+        tgt = dsearch(tbl->topology, dp, cpuset);
         if (NULL == tgt) {
             /* nothing found at that depth, so we are done */
             break;
@@ -1162,199 +1847,285 @@ pmix_status_t pmix_hwloc_compute_distances(pmix_topology_t *topo, pmix_cpuset_t
         return PMIX_ERR_NOT_AVAILABLE;
     }
 
-    /* get the PU depth */
-    pudepth = (unsigned) hwloc_get_type_depth(topo->topology, HWLOC_OBJ_PU);
-    width = hwloc_get_nbobjs_by_depth(topo->topology, pudepth);
+    /* the distance to a device is taken from the common ancestor
+     * of the cpuset and the device, so it is the same from every
+     * PU in the cpuset - we only need to know there is one */
+    pudepth = (unsigned) hwloc_get_type_depth(tbl->topology, HWLOC_OBJ_PU);
+    width = hwloc_get_nbobjs_by_depth(tbl->topology, pudepth);
+    inset = false;
+    for (w = 0; w < width && !inset; w++) {
+        pu = hwloc_get_obj_by_depth(tbl->topology, pudepth, w);
+        inset = hwloc_bitmap_intersects(pu->cpuset, cpuset);
+    }
 
-    PMIX_CONSTRUCT(&dists, pmix_list_t);
+    if (0 == tbl->ndevices) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    found = (size_t *) malloc(tbl->ndevices * sizeof(size_t));
+    dists = (unsigned *) malloc(tbl->ndevices * sizeof(unsigned));
+    if (NULL == found || NULL == dists) {
+        rc = PMIX_ERR_NOMEM;
+        goto done;
+    }
 
-    /* loop over the specified devices in the topology */
-    for (n = 0; n < ntypes; n++) {
-        if (!(type & table[n].pxtype)) {
+    m = 0;
+    for (n = 0; n < tbl->ndevices; n++) {
+        d = &tbl->devices[n];
+        if (!(type & d->type)) {
             continue;
         }
-        if (HWLOC_OBJ_OSDEV_BLOCK == table[n].hwtype || HWLOC_OBJ_OSDEV_DMA == table[n].hwtype
-#if HWLOC_API_VERSION >= 0x00010800
-            || HWLOC_OBJ_OSDEV_COPROC == table[n].hwtype
-#endif
-            ) {
-            continue;
+        if (PMIX_SUCCESS != d->status) {
+            rc = d->status;
+            goto done;
         }
-        device = hwloc_get_obj_by_type(topo->topology, HWLOC_OBJ_OS_DEVICE, 0);
-        while (NULL != device) {
-            if (device->attr->osdev.type == table[n].hwtype) {
-
-                d = PMIX_NEW(pmix_devdist_item_t);
-                pmix_list_append(&dists, &d->super);
-
-                d->dist.type = table[n].pxtype;
-
-                /* Construct a UUID for this device */
-                if (HWLOC_OBJ_OSDEV_NETWORK == table[n].hwtype) {
-                    char *addr = NULL;
-                    /* find the address */
-                    for (i = 0; i < device->infos_count; i++) {
-                        if (0 == strcasecmp(device->infos[i].name, "Address")) {
-                            addr = device->infos[i].value;
-                            break;
-                        }
-                    }
-                    if (NULL == addr) {
-                        /* couldn't find an address - report it as an error */
-                        PMIX_LIST_DESTRUCT(&dists);
-                        return PMIX_ERROR;
-                    }
-                    /* could be IPv4 or IPv6 */
-                    cnt = countcolons(addr);
-                    if (5 == cnt) {
-                        pmix_asprintf(&d->dist.uuid, "ipv4://%s", addr);
-                    } else if (19 == cnt) {
-                        pmix_asprintf(&d->dist.uuid, "ipv6://%s", addr);
-                    } else {
-                        /* unknown address type */
-                        PMIX_LIST_DESTRUCT(&dists);
-                        return PMIX_ERROR;
-                    }
-                } else if (HWLOC_OBJ_OSDEV_OPENFABRICS == table[n].hwtype) {
-                    char *ngid = NULL;
-                    char *sgid = NULL;
-                    /* find the UIDs */
-                    for (i = 0; i < device->infos_count; i++) {
-                        if (0 == strcasecmp(device->infos[i].name, "NodeGUID")) {
-                            ngid = device->infos[i].value;
-                        } else if (0 == strcasecmp(device->infos[i].name, "SysImageGUID")) {
-                            sgid = device->infos[i].value;
-                        }
-                    }
-                    if (NULL == ngid || NULL == sgid) {
-                        PMIX_LIST_DESTRUCT(&dists);
-                        return PMIX_ERROR;
-                    }
-                    pmix_asprintf(&d->dist.uuid, "fab://%s::%s", ngid, sgid);
-                } else if (HWLOC_OBJ_OSDEV_GPU == table[n].hwtype) {
-                    /* if the name starts with "card", then this is just the aux card of the GPU */
-                    if (0 == strncasecmp(device->name, "card", 4)) {
-                        pmix_list_remove_item(&dists, &d->super);
-                        PMIX_RELEASE(d);
-                        device = hwloc_get_next_osdev(topo->topology, device);
-                        continue;
-                    }
-                    pmix_asprintf(&d->dist.uuid, "gpu://%s::%s", pmix_globals.hostname,
-                                  device->name);
-                } else {
-                    /* unknown type */
-                    pmix_list_remove_item(&dists, &d->super);
-                    PMIX_RELEASE(d);
-                    device = hwloc_get_next_osdev(topo->topology, device);
-                    continue;
-                }
-
-                /* if device id was given, then check if this one matches either
-                 * the UUID or osname */
-                if (NULL != devids) {
-                    found = false;
-                    for (dn = 0; NULL != devids[dn]; dn++) {
-                        if (0 == strcasecmp(devids[dn], device->name)
-                            || 0 == strcasecmp(devids[dn], d->dist.uuid)) {
-                            found = true;
-                        }
-                    }
-                    if (!found) {
-                        /* skip this one */
-                        pmix_list_remove_item(&dists, &d->super);
-                        PMIX_RELEASE(d);
-                        device = hwloc_get_next_osdev(topo->topology, device);
-                        continue;
-                    }
-                }
-                /* save the osname */
-                d->dist.osname = strdup(device->name);
-                if (NULL == device->cpuset) {
-                    /* climb the topology until we find a non-NULL cpuset */
-                    tgt = device->parent;
-                    while (NULL != tgt && NULL == tgt->cpuset) {
-                        tgt = tgt->parent;
-                    }
-                    if (NULL == tgt) {
-                        PMIX_LIST_DESTRUCT(&dists);
-                        return PMIX_ERR_NOT_FOUND;
-                    }
-                } else {
-                    tgt = device;
-                }
-                /* loop over the PUs on this node */
-                maxdist = 0;
-                mindist = UINT_MAX;
-                for (w = 0; w < width; w++) {
-                    /* get the pu at this index */
-                    pu = hwloc_get_obj_by_depth(topo->topology, pudepth, w);
-                    /* is this PU in our cpuset? */
-                    if (!hwloc_bitmap_intersects(pu->cpuset, cpuset->bitmap)) {
-                        continue;
-                    }
-                    /* find the common ancestor between the cpuset and NIC objects */
-                    ancestor = hwloc_get_common_ancestor_obj(topo->topology, obj, tgt);
-                    if (NULL != ancestor) {
-                        if (0 == ancestor->depth) {
-                            /* we only share the machine - need to do something more
-                             * to compute the distance. This can, however, get a little
-                             * hairy as there is no good measure of package-to-package
-                             * distance - it is all typically given in terms of NUMA
-                             * domains, which is no longer a valid way of looking at
-                             * locations due to overlapping domains. For now, we will
-                             * just take the depth of the device in its package and
-                             * add that to the depth of the object in its package
-                             * plus the depth of a package to ensure it is further away */
-                            dp = obj->depth + depth;
-                        } else {
-                            /* the depth value can be used as an indicator of relative
-                             * locality - the higher the value, the closer the device.
-                             * We invert the pyramid to set the dist to be closer for
-                             * smaller values */
-                            dp = depth - ancestor->depth;
-                        }
-                    } else {
-                        /* shouldn't happen - consider this an error condition */
-                        PMIX_LIST_DESTRUCT(&dists);
-                        return PMIX_ERROR;
-                    }
-                    if (mindist > dp) {
-                        mindist = dp;
-                    }
-                    if (maxdist < dp) {
-                        maxdist = dp;
-                    }
+        /* if device id was given, then check if this one matches either
+         * the UUID or osname */
+        if (NULL != devids) {
+            match = false;
+            for (dn = 0; NULL != devids[dn]; dn++) {
+                if (0 == strcasecmp(devids[dn], d->osname)
+                    || 0 == strcasecmp(devids[dn], d->uuid)) {
+                    match = true;
                 }
-                d->dist.mindist = mindist;
-                d->dist.maxdist = maxdist;
             }
-            device = hwloc_get_next_osdev(topo->topology, device);
+            if (!match) {
+                continue;
+            }
+        }
+        if (NULL == d->obj) {
+            rc = PMIX_ERR_NOT_FOUND;
+            goto done;
+        }
+        dp = 0;
+        if (inset) {
+            /* find the common ancestor between the cpuset and NIC objects */
+            ancestor = hwloc_get_common_ancestor_obj(tbl->topology, obj, d->obj);
+            if (NULL == ancestor) {
+                /* shouldn't happen - consider this an error condition */
+                rc = PMIX_ERROR;
+                goto done;
+            }
+            if (0 == ancestor->depth) {
+                /* we only share the machine - need to do something more
+                 * to compute the distance. This can, however, get a little
+                 * hairy as there is no good measure of package-to-package
+                 * distance - it is all typically given in terms of NUMA
+                 * domains, which is no longer a valid way of looking at
+                 * locations due to overlapping domains. For now, we will
+                 * just take the depth of the device in its package and
+                 * add that to the depth of the object in its package
+                 * plus the depth of a package to ensure it is further away */
+                dp = obj->depth + depth;
+            } else {
+                /* the depth value can be used as an indicator of relative
+                 * locality - the higher the value, the closer the device.
+                 * We invert the pyramid to set the dist to be closer for
+                 * smaller values */
+                dp = depth - ancestor->depth;
+            }
         }
+        found[m] = n;
+        dists[m] = dp;
+        ++m;
     }
 
     /* create the return array */
-    n = pmix_list_get_size(&dists);
-    if (0 == n) {
+    if (0 == m) {
         /* no devices found */
-        return PMIX_ERR_NOT_FOUND;
+        rc = PMIX_ERR_NOT_FOUND;
+        goto done;
+    }
+    PMIX_DEVICE_DIST_CREATE(array, m);
+    for (n = 0; n < m; n++) {
+        d = &tbl->devices[found[n]];
+        array[n].uuid = strdup(d->uuid);
+        array[n].osname = strdup(d->osname);
+        array[n].type = d->type;
+        if (inset) {
+            array[n].mindist = dists[n];
+            array[n].maxdist = dists[n];
+        } else {
+            array[n].mindist = UINT16_MAX;
+            array[n].maxdist = 0;
+        }
     }
-    PMIX_DEVICE_DIST_CREATE(array, n);
-    *ndist = n;
-    n = 0;
-    PMIX_LIST_FOREACH (d, &dists, pmix_devdist_item_t) {
-        array[n].uuid = strdup(d->dist.uuid);
-        array[n].osname = strdup(d->dist.osname);
-        array[n].type = d->dist.type;
-        array[n].mindist = d->dist.mindist;
-        array[n].maxdist = d->dist.maxdist;
-        ++n;
-    }
-    PMIX_LIST_DESTRUCT(&dists);
     *dist = array;
+    *ndist = m;
+
+done:
+    if (NULL != found) {
+        free(found);
+    }
+    if (NULL != dists) {
+        free(dists);
+    }
+    return rc;
+}
+
+static pmix_device_distance_t *copy_distances(pmix_device_distance_t *src, size_t n)
+{
+    pmix_device_distance_t *array;
+    size_t m;
 
+    PMIX_DEVICE_DIST_CREATE(array, n);
+    for (m = 0; m < n; m++) {
+        array[m].uuid = strdup(src[m].uuid);
+        array[m].osname = strdup(src[m].osname);
+        array[m].type = src[m].type;
+        array[m].mindist = src[m].mindist;
+        array[m].maxdist = src[m].maxdist;
+    }
+    return array;
+}
+
+static void flush_distcache(void)
+{
+    if (distcache_init) {
+        PMIX_LIST_DESTRUCT(&distcache);
+        distcache_init = false;
+    }
+    release_devtable(&devtable);
+}
+
+/* must be called with the distlock held */
+static pmix_status_t get_devtable(hwloc_topology_t topology)
+{
+    pmix_status_t rc;
+
+    if (topology == devtable.topology) {
+        return PMIX_SUCCESS;
+    }
+    /* our topology was replaced */
+    flush_distcache();
+    rc = build_devtable(topology, &devtable);
+    if (PMIX_SUCCESS != rc) {
+        release_devtable(&devtable);
+        return rc;
+    }
+    PMIX_CONSTRUCT(&distcache, pmix_list_t);
+    distcache_init = true;
+    pmix_output_verbose(2, pmix_hwloc_output, "%s:%s found %lu devices",
+                        __FILE__, __func__, (unsigned long) devtable.ndevices);
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_hwloc_setup_distances(void)
+{
+    pmix_status_t rc;
+
+    if (NULL == pmix_globals.topology.topology || NULL == pmix_globals.topology.source
+        || 0 != strncasecmp(pmix_globals.topology.source, "hwloc", 5)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    pmix_mutex_lock(&distlock);
+    rc = get_devtable(pmix_globals.topology.topology);
+    pmix_mutex_unlock(&distlock);
+    return rc;
+}
+
+pmix_status_t pmix_hwloc_compute_distances(pmix_topology_t *topo, pmix_cpuset_t *cpuset,
+                                           pmix_info_t info[], size_t ninfo,
+                                           pmix_device_distance_t **dist, size_t *ndist)
+{
+    pmix_hwloc_devtable_t tbl;
+    pmix_hwloc_distcache_t *dc;
+    pmix_device_type_t type = 0;
+    char **devids = NULL, *ids = NULL;
+    size_t n, ntypes;
+    pmix_status_t rc;
+
+    if (NULL == topo->source || NULL == cpuset->source) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    if (0 != strncasecmp(topo->source, "hwloc", 5)
+        || 0 != strncasecmp(cpuset->source, "hwloc", 5)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* set default returns */
+    *dist = NULL;
+    *ndist = 0;
+
+    /* determine number of types we support */
+    ntypes = sizeof(table) / sizeof(pmix_type_conversion_t);
+
+    /* determine what they want us to look at */
+    if (NULL == info) {
+        /* find everything */
+        for (n = 0; n < ntypes; n++) {
+            type |= table[n].pxtype;
+        }
+    } else {
+        for (n = 0; n < ninfo; n++) {
+            if (PMIX_CHECK_KEY(&info[n], PMIX_DEVICE_TYPE)) {
+                type |= info[n].value.data.devtype;
+            } else if (PMIX_CHECK_KEY(&info[n], PMIX_DEVICE_ID)) {
+                pmix_argv_append_nosize(&devids, info[n].value.data.string);
+            }
+        }
+    }
+
+    /* a topology we were handed is only used this once */
+    if (topo->topology != pmix_globals.topology.topology || 0 == pmix_hwloc_dist_cache_size) {
+        rc = build_devtable(topo->topology, &tbl);
+        if (PMIX_SUCCESS == rc) {
+            rc = compute_from_table(&tbl, cpuset->bitmap, type, devids, dist, ndist);
+        }
+        release_devtable(&tbl);
+        pmix_argv_free(devids);
+        return rc;
+    }
+
+    if (NULL != devids) {
+        ids = pmix_argv_join(devids, ',');
+    }
+    pmix_mutex_lock(&distlock);
+    rc = get_devtable(topo->topology);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+
+    /* see if we have already answered this one */
+    PMIX_LIST_FOREACH (dc, &distcache, pmix_hwloc_distcache_t) {
+        if (dc->type == type && hwloc_bitmap_isequal(dc->cpuset, cpuset->bitmap)
+            && (dc->devids == ids || (NULL != dc->devids && NULL != ids
+                                      && 0 == strcmp(dc->devids, ids)))) {
+            *dist = copy_distances(dc->dist, dc->ndist);
+            *ndist = dc->ndist;
+            /* keep the most recently used at the end */
+            pmix_list_remove_item(&distcache, &dc->super);
+            pmix_list_append(&distcache, &dc->super);
+            goto done;
+        }
+    }
+
+    rc = compute_from_table(&devtable, cpuset->bitmap, type, devids, dist, ndist);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    if ((size_t) pmix_hwloc_dist_cache_size <= pmix_list_get_size(&distcache)) {
+        dc = (pmix_hwloc_distcache_t *) pmix_list_remove_first(&distcache);
+        PMIX_RELEASE(dc);
+    }
+    dc = PMIX_NEW(pmix_hwloc_distcache_t);
+    dc->cpuset = hwloc_bitmap_dup(cpuset->bitmap);
+    dc->type = type;
+    dc->devids = ids;
+    ids = NULL;
+    dc->dist = copy_distances(*dist, *ndist);
+    dc->ndist = *ndist;
+    pmix_list_append(&distcache, &dc->super);
+
+done:
+    pmix_mutex_unlock(&distlock);
+    if (NULL != ids) {
+        free(ids);
+    }
+    pmix_argv_free(devids);
+    return rc;
+}
+
 pmix_status_t pmix_hwloc_check_vendor(pmix_topology_t *topo,
                                       unsigned short vendorID,
                                       uint16_t class)
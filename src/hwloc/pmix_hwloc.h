@@ -93,9 +93,19 @@ PMIX_EXPORT pmix_status_t pmix_hwloc_get_relative_locality(const char *locality1
                                                            const char *locality2,
                                                            pmix_locality_t *loc);
 
+/* Get the relative locality of every pair from a set of locality strings,
+ * packed as the upper triangle (diagonal included) of the n x n matrix
+ * with one byte per pair holding its PMIX_LOCALITY_SHARE_* bits below
+ * PMIX_LOCALITY_SHARE_NODE. Row i starts at byte i*(2n-i+1)/2 */
+PMIX_EXPORT pmix_status_t pmix_hwloc_get_locality_matrix(char **localities, size_t n,
+                                                         pmix_byte_object_t *matrix);
+
 /* Get current bound location */
 PMIX_EXPORT pmix_status_t pmix_hwloc_get_cpuset(pmix_cpuset_t *cpuset, pmix_bind_envelope_t ref);
 
+/* Find the devices of our own topology ahead of the first distance request */
+PMIX_EXPORT pmix_status_t pmix_hwloc_setup_distances(void);
+
 /* Get distance array */
 PMIX_EXPORT pmix_status_t pmix_hwloc_compute_distances(pmix_topology_t *topo, pmix_cpuset_t *cpuset,
                                                        pmix_info_t info[], size_t ninfo,
@@ -50,7 +50,9 @@
 
 #include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
+#include "src/mca/bfrops/bfrops.h"
 #include "src/mca/bfrops/bfrops_types.h"
+#include "src/mca/ptl/base/base.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_os_path.h"
@@ -129,6 +131,23 @@ static void cddes(pmix_cleanup_dir_t *p)
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_cleanup_dir_t, pmix_list_item_t, cdcon, cddes);
 
+static void rpcon(pmix_resolved_peers_t *p)
+{
+    p->hostname = NULL;
+    p->ranks = NULL;
+    p->nranks = 0;
+}
+static void rpdes(pmix_resolved_peers_t *p)
+{
+    if (NULL != p->hostname) {
+        free(p->hostname);
+    }
+    if (NULL != p->ranks) {
+        free(p->ranks);
+    }
+}
+PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_resolved_peers_t, pmix_list_item_t, rpcon, rpdes);
+
 static void nscon(pmix_namespace_t *p)
 {
     p->nspace = NULL;
@@ -149,7 +168,13 @@ static void nscon(pmix_namespace_t *p)
     PMIX_CONSTRUCT(&p->setup_data, pmix_list_t);
     memset(&p->iof_flags, 0, sizeof(p->iof_flags));
     PMIX_CONSTRUCT(&p->sinks, pmix_list_t);
-
+    PMIX_CONSTRUCT(&p->resolve_lock, pmix_mutex_t);
+    p->resolved_nodes = NULL;
+    PMIX_CONSTRUCT(&p->resolved_peers, pmix_list_t);
+    p->resolved_locality = NULL;
+    p->mdx_release_time = 0;
+    p->mdx_release_fetched = false;
+    p->mdx_fetches = NULL;
 }
 static void nsdes(pmix_namespace_t *p)
 {
@@ -174,6 +199,15 @@ static void nsdes(pmix_namespace_t *p)
         free(p->iof_flags.directory);
     }
     PMIX_LIST_DESTRUCT(&p->sinks);
+    if (NULL != p->resolved_nodes) {
+        free(p->resolved_nodes);
+    }
+    PMIX_LIST_DESTRUCT(&p->resolved_peers);
+    pmix_resolved_locality_free(p->resolved_locality);
+    if (NULL != p->mdx_fetches) {
+        free(p->mdx_fetches);
+    }
+    PMIX_DESTRUCT(&p->resolve_lock);
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_namespace_t, pmix_list_item_t, nscon, nsdes);
 
@@ -209,23 +243,33 @@ PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_rank_info_t, pmix_list_item_t, info_con, in
 
 static void pcon(pmix_peer_t *p)
 {
+    p->nptr = NULL;
+    p->info = NULL;
     p->proc_type.type = PMIX_PROC_UNDEF;
     p->proc_type.major = PMIX_MAJOR_WILDCARD;
     p->proc_type.minor = PMIX_MINOR_WILDCARD;
     p->proc_type.release = PMIX_RELEASE_WILDCARD;
     p->proc_type.flag = 0;
-    p->protocol = PMIX_PROTOCOL_UNDEF;
-    p->finalized = false;
-    p->info = NULL;
-    p->proc_cnt = 0;
     p->index = 0;
     p->sd = -1;
+    p->finalized = false;
+    p->purged = false;
     p->send_ev_active = false;
     p->recv_ev_active = false;
-    PMIX_CONSTRUCT(&p->send_queue, pmix_list_t);
+    p->send_batched = false;
+    p->evbase = NULL;
     p->send_msg = NULL;
     p->recv_msg = NULL;
+    p->rahead = NULL;
+    p->rahead_off = 0;
+    p->rahead_len = 0;
+    PMIX_CONSTRUCT(&p->send_queue, pmix_list_t);
+    p->protocol = PMIX_PROTOCOL_UNDEF;
+    p->proc_cnt = 0;
     p->commit_cnt = 0;
+    PMIX_CONSTRUCT(&p->pending_reqs, pmix_list_t);
+    p->nqueued = 0;
+    p->qclass = 0;
     PMIX_CONSTRUCT(&p->epilog.cleanup_dirs, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.cleanup_files, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.ignores, pmix_list_t);
@@ -248,12 +292,16 @@ static void pdes(pmix_peer_t *p)
     }
 
     PMIX_LIST_DESTRUCT(&p->send_queue);
+    PMIX_LIST_DESTRUCT(&p->pending_reqs);
     if (NULL != p->send_msg) {
         PMIX_RELEASE(p->send_msg);
     }
     if (NULL != p->recv_msg) {
         PMIX_RELEASE(p->recv_msg);
     }
+    if (NULL != p->rahead) {
+        free(p->rahead);
+    }
     /* perform any epilog */
     pmix_execute_epilog(&p->epilog);
     /* cleanup the epilog */
@@ -462,6 +510,8 @@ static void ncon(pmix_notify_caddy_t *p)
     p->ts = tv.tv_sec;
 #endif
     p->room = -1;
+    p->code_prev = NULL;
+    p->code_next = NULL;
     memset(p->source.nspace, 0, PMIX_MAX_NSLEN + 1);
     p->source.rank = PMIX_RANK_UNDEF;
     p->range = PMIX_RANGE_UNDEF;
@@ -487,42 +537,324 @@ static void ndes(pmix_notify_caddy_t *p)
 }
 PMIX_CLASS_INSTANCE(pmix_notify_caddy_t, pmix_object_t, ncon, ndes);
 
-void pmix_execute_epilog(pmix_epilog_t *epi)
+void pmix_namespace_flush_resolved(pmix_namespace_t *ns)
+{
+    if (NULL == ns) {
+        return;
+    }
+    pmix_mutex_lock(&ns->resolve_lock);
+    if (NULL != ns->resolved_nodes) {
+        free(ns->resolved_nodes);
+        ns->resolved_nodes = NULL;
+    }
+    PMIX_LIST_DESTRUCT(&ns->resolved_peers);
+    PMIX_CONSTRUCT(&ns->resolved_peers, pmix_list_t);
+    pmix_resolved_locality_free(ns->resolved_locality);
+    ns->resolved_locality = NULL;
+    pmix_mutex_unlock(&ns->resolve_lock);
+}
+
+void pmix_resolved_locality_free(pmix_resolved_locality_t *loc)
+{
+    if (NULL == loc) {
+        return;
+    }
+    if (NULL != loc->ranks) {
+        free(loc->ranks);
+    }
+    if (NULL != loc->rows) {
+        free(loc->rows);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&loc->matrix);
+    free(loc);
+}
+
+/* Sets of procs - the targets of an abort or of job control - are
+ * sent as runs of consecutive ranks: the first proc of each run, then
+ * the length of each run. Asking for every rank of a job then costs a
+ * single entry however large the job. Peers that predate this are
+ * sent the plain array */
+static bool proc_set_as_runs(pmix_peer_t *peer)
+{
+    return !PMIX_PEER_IS_EARLIER(peer, PMIX_VERSION_MAJOR, PMIX_VERSION_MINOR,
+                                 PMIX_VERSION_RELEASE);
+}
+
+static int proc_set_cmp(const void *a, const void *b)
+{
+    const pmix_proc_t *pa = (const pmix_proc_t *) a;
+    const pmix_proc_t *pb = (const pmix_proc_t *) b;
+    int rc;
+
+    rc = strncmp(pa->nspace, pb->nspace, PMIX_MAX_NSLEN);
+    if (0 != rc) {
+        return rc;
+    }
+    return (pa->rank < pb->rank) ? -1 : (pa->rank > pb->rank);
+}
+
+pmix_status_t pmix_pack_proc_set(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                 const pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_proc_t *sorted = NULL, *starts = NULL, *last;
+    uint32_t *counts = NULL;
+    size_t n, m, k, g, nruns = 0;
+    bool wild;
+    pmix_status_t rc;
+
+    if (!proc_set_as_runs(peer)) {
+        PMIX_BFROPS_PACK(rc, peer, buf, &nprocs, 1, PMIX_SIZE);
+        if (PMIX_SUCCESS == rc && 0 < nprocs) {
+            PMIX_BFROPS_PACK(rc, peer, buf, procs, nprocs, PMIX_PROC);
+        }
+        return rc;
+    }
+
+    if (0 < nprocs) {
+        sorted = (pmix_proc_t *) malloc(nprocs * sizeof(pmix_proc_t));
+        starts = (pmix_proc_t *) malloc(nprocs * sizeof(pmix_proc_t));
+        counts = (uint32_t *) malloc(nprocs * sizeof(uint32_t));
+        if (NULL == sorted || NULL == starts || NULL == counts) {
+            rc = PMIX_ERR_NOMEM;
+            goto done;
+        }
+        memcpy(sorted, procs, nprocs * sizeof(pmix_proc_t));
+        qsort(sorted, nprocs, sizeof(pmix_proc_t), proc_set_cmp);
+        for (n = 0; n < nprocs; n = m) {
+            wild = false;
+            for (m = n; m < nprocs && PMIX_CHECK_NSPACE(sorted[m].nspace, sorted[n].nspace); m++) {
+                if (PMIX_RANK_WILDCARD == sorted[m].rank) {
+                    wild = true;
+                }
+            }
+            if (wild) {
+                /* the rest of the nspace adds nothing */
+                PMIX_LOAD_PROCID(&starts[nruns], sorted[n].nspace, PMIX_RANK_WILDCARD);
+                counts[nruns++] = 1;
+                continue;
+            }
+            g = nruns;
+            for (k = n; k < m; k++) {
+                if (g < nruns) {
+                    last = &starts[nruns - 1];
+                    if (sorted[k].rank == last->rank) {
+                        continue;
+                    }
+                    if (PMIX_RANK_IS_VALID(sorted[k].rank) && PMIX_RANK_IS_VALID(last->rank)) {
+                        if (sorted[k].rank < last->rank + counts[nruns - 1]) {
+                            continue;
+                        }
+                        if (sorted[k].rank == last->rank + counts[nruns - 1]) {
+                            ++counts[nruns - 1];
+                            continue;
+                        }
+                    }
+                }
+                memcpy(&starts[nruns], &sorted[k], sizeof(pmix_proc_t));
+                counts[nruns++] = 1;
+            }
+        }
+    }
+    PMIX_BFROPS_PACK(rc, peer, buf, &nruns, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc && 0 < nruns) {
+        PMIX_BFROPS_PACK(rc, peer, buf, starts, nruns, PMIX_PROC);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, buf, counts, nruns, PMIX_UINT32);
+        }
+    }
+
+done:
+    if (NULL != sorted) {
+        free(sorted);
+    }
+    if (NULL != starts) {
+        free(starts);
+    }
+    if (NULL != counts) {
+        free(counts);
+    }
+    return rc;
+}
+
+/* the number of procs in the nspace, if we know it */
+static uint32_t proc_set_job_size(const char *nspace)
+{
+    pmix_namespace_t *ns;
+
+    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (PMIX_CHECK_NSPACE(ns->nspace, nspace)) {
+            return ns->nprocs;
+        }
+    }
+    return 0;
+}
+
+pmix_status_t pmix_unpack_proc_set(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                   pmix_proc_t **procs, size_t *nprocs)
+{
+    pmix_proc_t *starts = NULL, *out;
+    uint32_t *counts = NULL, c, size;
+    size_t nruns, n, total;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    *procs = NULL;
+    *nprocs = 0;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &nruns, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc || 0 == nruns) {
+        return rc;
+    }
+    if (INT32_MAX < nruns) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    PMIX_PROC_CREATE(starts, nruns);
+    if (NULL == starts) {
+        return PMIX_ERR_NOMEM;
+    }
+    cnt = nruns;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, starts, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_PROC_FREE(starts, nruns);
+        return rc;
+    }
+    if (!proc_set_as_runs(peer)) {
+        *procs = starts;
+        *nprocs = nruns;
+        return PMIX_SUCCESS;
+    }
+
+    counts = (uint32_t *) malloc(nruns * sizeof(uint32_t));
+    if (NULL == counts) {
+        PMIX_PROC_FREE(starts, nruns);
+        return PMIX_ERR_NOMEM;
+    }
+    cnt = nruns;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, counts, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    /* a run covering a job we know is the whole job - pass it
+     * on as such, so the job is handled as one, not rank by rank */
+    total = 0;
+    for (n = 0; n < nruns; n++) {
+        if (0 == counts[n]) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            goto done;
+        }
+        if (0 == starts[n].rank && 1 < counts[n]) {
+            size = proc_set_job_size(starts[n].nspace);
+            if (0 < size && counts[n] == size) {
+                starts[n].rank = PMIX_RANK_WILDCARD;
+                counts[n] = 1;
+            }
+        }
+        total += counts[n];
+    }
+    PMIX_PROC_CREATE(out, total);
+    if (NULL == out) {
+        rc = PMIX_ERR_NOMEM;
+        goto done;
+    }
+    *procs = out;
+    *nprocs = total;
+    for (n = 0; n < nruns; n++) {
+        for (c = 0; c < counts[n]; c++) {
+            PMIX_LOAD_PROCID(out, starts[n].nspace, starts[n].rank + c);
+            ++out;
+        }
+    }
+
+done:
+    PMIX_PROC_FREE(starts, nruns);
+    free(counts);
+    return rc;
+}
+
+/* check the effective uid/gid of the file and ensure it
+ * matches that of the peer - we do this to provide at least
+ * some minimum level of protection */
+static void cleanup_file(const char *path, pmix_epilog_t *epi)
+{
+    struct stat statbuf;
+    int rc;
+
+    /* coverity[TOCTOU] */
+    rc = stat(path, &statbuf);
+    if (0 != rc) {
+        pmix_output_verbose(10, pmix_globals.debug_output, "File %s failed to stat: %d",
+                            path, rc);
+        return;
+    }
+    if (statbuf.st_uid != epi->uid || statbuf.st_gid != epi->gid) {
+        pmix_output_verbose(10, pmix_globals.debug_output,
+                            "File %s uid/gid doesn't match: uid %lu(%lu) gid %lu(%lu)",
+                            path, (unsigned long) statbuf.st_uid,
+                            (unsigned long) epi->uid, (unsigned long) statbuf.st_gid,
+                            (unsigned long) epi->gid);
+        return;
+    }
+    rc = unlink(path);
+    if (0 != rc) {
+        pmix_output_verbose(10, pmix_globals.debug_output, "File %s failed to unlink: %d",
+                            path, rc);
+    }
+}
+
+/* same protection for a directory we were asked to remove */
+static bool check_dir(const char *path, pmix_epilog_t *epi)
 {
-    pmix_cleanup_file_t *cf, *cfnext;
-    pmix_cleanup_dir_t *cd, *cdnext;
     struct stat statbuf;
     int rc;
+
+    /* coverity[TOCTOU] */
+    rc = stat(path, &statbuf);
+    if (0 != rc) {
+        pmix_output_verbose(10, pmix_globals.debug_output,
+                            "Directory %s failed to stat: %d", path, rc);
+        return false;
+    }
+    if (statbuf.st_uid != epi->uid || statbuf.st_gid != epi->gid) {
+        pmix_output_verbose(10, pmix_globals.debug_output,
+                            "Directory %s uid/gid doesn't match: uid %lu(%lu) gid %lu(%lu)",
+                            path, (unsigned long) statbuf.st_uid,
+                            (unsigned long) epi->uid, (unsigned long) statbuf.st_gid,
+                            (unsigned long) epi->gid);
+        return false;
+    }
+    if ((statbuf.st_mode & S_IRWXU) != S_IRWXU) {
+        pmix_output_verbose(10, pmix_globals.debug_output, "Directory %s lacks permissions",
+                            path);
+        return false;
+    }
+    return true;
+}
+
+static bool ignored(const char *path, pmix_epilog_t *epi)
+{
+    pmix_cleanup_file_t *cf;
+
+    PMIX_LIST_FOREACH (cf, &epi->ignores, pmix_cleanup_file_t) {
+        if (0 == strcmp(cf->path, path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void execute_epilog(pmix_epilog_t *epi)
+{
+    pmix_cleanup_file_t *cf, *cfnext;
+    pmix_cleanup_dir_t *cd, *cdnext;
     char **tmp;
     size_t n;
 
     /* start with any specified files */
     PMIX_LIST_FOREACH_SAFE (cf, cfnext, &epi->cleanup_files, pmix_cleanup_file_t) {
-        /* check the effective uid/gid of the file and ensure it
-         * matches that of the peer - we do this to provide at least
-         * some minimum level of protection */
         tmp = pmix_argv_split(cf->path, ',');
         for (n = 0; NULL != tmp[n]; n++) {
-            /* coverity[TOCTOU] */
-            rc = stat(tmp[n], &statbuf);
-            if (0 != rc) {
-                pmix_output_verbose(10, pmix_globals.debug_output, "File %s failed to stat: %d",
-                                    tmp[n], rc);
-                continue;
-            }
-            if (statbuf.st_uid != epi->uid || statbuf.st_gid != epi->gid) {
-                pmix_output_verbose(10, pmix_globals.debug_output,
-                                    "File %s uid/gid doesn't match: uid %lu(%lu) gid %lu(%lu)",
-                                    cf->path, (unsigned long) statbuf.st_uid,
-                                    (unsigned long) epi->uid, (unsigned long) statbuf.st_gid,
-                                    (unsigned long) epi->gid);
-                continue;
-            }
-            rc = unlink(tmp[n]);
-            if (0 != rc) {
-                pmix_output_verbose(10, pmix_globals.debug_output, "File %s failed to unlink: %d",
-                                    tmp[n], rc);
-            }
+            cleanup_file(tmp[n], epi);
         }
         pmix_argv_free(tmp);
         pmix_list_remove_item(&epi->cleanup_files, &cf->super);
@@ -531,31 +863,10 @@ void pmix_execute_epilog(pmix_epilog_t *epi)
 
     /* now cleanup the directories */
     PMIX_LIST_FOREACH_SAFE (cd, cdnext, &epi->cleanup_dirs, pmix_cleanup_dir_t) {
-        /* check the effective uid/gid of the file and ensure it
-         * matches that of the peer - we do this to provide at least
-         * some minimum level of protection */
         tmp = pmix_argv_split(cd->path, ',');
         for (n = 0; NULL != tmp[n]; n++) {
-            /* coverity[TOCTOU] */
-            rc = stat(tmp[n], &statbuf);
-            if (0 != rc) {
-                pmix_output_verbose(10, pmix_globals.debug_output,
-                                    "Directory %s failed to stat: %d", tmp[n], rc);
-                continue;
-            }
-            if (statbuf.st_uid != epi->uid || statbuf.st_gid != epi->gid) {
-                pmix_output_verbose(10, pmix_globals.debug_output,
-                                    "Directory %s uid/gid doesn't match: uid %lu(%lu) gid %lu(%lu)",
-                                    cd->path, (unsigned long) statbuf.st_uid,
-                                    (unsigned long) epi->uid, (unsigned long) statbuf.st_gid,
-                                    (unsigned long) epi->gid);
-                continue;
-            }
-            if ((statbuf.st_mode & S_IRWXU) == S_IRWXU) {
+            if (check_dir(tmp[n], epi)) {
                 dirpath_destroy(tmp[n], cd, epi);
-            } else {
-                pmix_output_verbose(10, pmix_globals.debug_output, "Directory %s lacks permissions",
-                                    tmp[n]);
             }
         }
         pmix_argv_free(tmp);
@@ -564,6 +875,390 @@ void pmix_execute_epilog(pmix_epilog_t *epi)
     }
 }
 
+/* Removing the session directories of a terminated client or job
+ * can take seconds, so the epilogs are normally handed to a pool of
+ * pmix_globals.epilog_threads workers and the caller moves on. The
+ * epilogs are executed one at a time in the order they were given
+ * to us - a job's directory is then not removed while the directory
+ * of one of its clients is still being emptied - but the trees of
+ * each are traversed in parallel: every subdirectory is a task of
+ * its own, and a directory is removed once the tasks for all of its
+ * subdirectories are done */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_epilog_t epi;
+    /* top-level tasks not yet done */
+    int pending;
+} pmix_epilog_job_t;
+static void ejcon(pmix_epilog_job_t *p)
+{
+    PMIX_CONSTRUCT(&p->epi.cleanup_dirs, pmix_list_t);
+    PMIX_CONSTRUCT(&p->epi.cleanup_files, pmix_list_t);
+    PMIX_CONSTRUCT(&p->epi.ignores, pmix_list_t);
+    p->pending = 0;
+}
+static void ejdes(pmix_epilog_job_t *p)
+{
+    PMIX_LIST_DESTRUCT(&p->epi.cleanup_dirs);
+    PMIX_LIST_DESTRUCT(&p->epi.cleanup_files);
+    PMIX_LIST_DESTRUCT(&p->epi.ignores);
+}
+static PMIX_CLASS_INSTANCE(pmix_epilog_job_t, pmix_list_item_t, ejcon, ejdes);
+
+typedef struct pmix_epilog_task_t {
+    pmix_list_item_t super;
+    pmix_epilog_job_t *job;
+    struct pmix_epilog_task_t *parent;
+    /* NULL if this is a file */
+    pmix_cleanup_dir_t *cd;
+    char *path;
+    /* the scan of this directory plus the tasks of its
+     * subdirectories that are not yet done */
+    int pending;
+} pmix_epilog_task_t;
+static void etcon(pmix_epilog_task_t *p)
+{
+    p->job = NULL;
+    p->parent = NULL;
+    p->cd = NULL;
+    p->path = NULL;
+    p->pending = 1;
+}
+static void etdes(pmix_epilog_task_t *p)
+{
+    if (NULL != p->job) {
+        PMIX_RELEASE(p->job);
+    }
+    if (NULL != p->parent) {
+        PMIX_RELEASE(p->parent);
+    }
+    if (NULL != p->cd) {
+        PMIX_RELEASE(p->cd);
+    }
+    if (NULL != p->path) {
+        free(p->path);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_epilog_task_t, pmix_list_item_t, etcon, etdes);
+
+static struct {
+    pmix_lock_t lock;
+    pmix_thread_t **threads;
+    int nthreads;
+    bool stop;
+    /* set once the workers are gone for good */
+    bool shutdown;
+    pmix_list_t jobs;
+    pmix_epilog_job_t *active;
+    pmix_list_t tasks;
+} epilog_workers = {
+    .lock = {.mutex = PMIX_MUTEX_STATIC_INIT,
+             .cond = PMIX_CONDITION_STATIC_INIT,
+             .active = false},
+    .threads = NULL,
+    .nthreads = 0,
+    .stop = false,
+    .shutdown = false,
+    .jobs = PMIX_LIST_STATIC_INIT,
+    .active = NULL,
+    .tasks = PMIX_LIST_STATIC_INIT
+};
+
+/* must be called with the lock held */
+static pmix_epilog_task_t *new_task(pmix_epilog_job_t *job, pmix_epilog_task_t *parent,
+                                    pmix_cleanup_dir_t *cd, const char *path)
+{
+    pmix_epilog_task_t *task;
+
+    task = PMIX_NEW(pmix_epilog_task_t);
+    if (NULL == task) {
+        return NULL;
+    }
+    task->path = strdup(path);
+    if (NULL == task->path) {
+        PMIX_RELEASE(task);
+        return NULL;
+    }
+    PMIX_RETAIN(job);
+    task->job = job;
+    if (NULL != parent) {
+        PMIX_RETAIN(parent);
+        task->parent = parent;
+        ++parent->pending;
+    } else {
+        ++job->pending;
+    }
+    if (NULL != cd) {
+        PMIX_RETAIN(cd);
+        task->cd = cd;
+    }
+    pmix_list_append(&epilog_workers.tasks, &task->super);
+    return task;
+}
+
+/* must be called with the lock held */
+static void start_jobs(void)
+{
+    pmix_epilog_job_t *job;
+    pmix_cleanup_file_t *cf;
+    pmix_cleanup_dir_t *cd;
+    char **tmp;
+    size_t n;
+
+    while (NULL == epilog_workers.active
+           && NULL != (job = (pmix_epilog_job_t *) pmix_list_remove_first(&epilog_workers.jobs))) {
+        PMIX_LIST_FOREACH (cf, &job->epi.cleanup_files, pmix_cleanup_file_t) {
+            tmp = pmix_argv_split(cf->path, ',');
+            for (n = 0; NULL != tmp[n]; n++) {
+                (void) new_task(job, NULL, NULL, tmp[n]);
+            }
+            pmix_argv_free(tmp);
+        }
+        PMIX_LIST_FOREACH (cd, &job->epi.cleanup_dirs, pmix_cleanup_dir_t) {
+            tmp = pmix_argv_split(cd->path, ',');
+            for (n = 0; NULL != tmp[n]; n++) {
+                (void) new_task(job, NULL, cd, tmp[n]);
+            }
+            pmix_argv_free(tmp);
+        }
+        if (0 < job->pending) {
+            epilog_workers.active = job;
+        } else {
+            PMIX_RELEASE(job);
+        }
+    }
+    pmix_condition_broadcast(&epilog_workers.lock.cond);
+}
+
+static void task_done(pmix_epilog_task_t *task)
+{
+    pmix_epilog_task_t *parent;
+    pmix_epilog_job_t *job;
+
+    while (NULL != task) {
+        pmix_mutex_lock(&epilog_workers.lock.mutex);
+        if (0 < --task->pending) {
+            pmix_mutex_unlock(&epilog_workers.lock.mutex);
+            return;
+        }
+        pmix_mutex_unlock(&epilog_workers.lock.mutex);
+
+        /* everything below this directory is gone - remove it
+         * unless we were told to leave it */
+        if (NULL != task->cd && !(NULL == task->parent && task->cd->leave_topdir)
+            && dirpath_is_empty(task->path)) {
+            rmdir(task->path);
+        }
+
+        parent = task->parent;
+        if (NULL == parent) {
+            job = task->job;
+            pmix_mutex_lock(&epilog_workers.lock.mutex);
+            if (0 == --job->pending) {
+                if (epilog_workers.active == job) {
+                    epilog_workers.active = NULL;
+                    PMIX_RELEASE(job);
+                }
+                start_jobs();
+            }
+            pmix_mutex_unlock(&epilog_workers.lock.mutex);
+            PMIX_RELEASE(task);
+            return;
+        }
+        /* the parent cannot complete until we tell it this
+         * subdirectory is done, so it stays with us */
+        PMIX_RELEASE(task);
+        task = parent;
+    }
+}
+
+/* the parallel counterpart of dirpath_destroy - rather than descending
+ * into the subdirectories, queue them for any worker to take */
+static void scan_dir(pmix_epilog_task_t *task)
+{
+    pmix_epilog_t *epi = &task->job->epi;
+    DIR *dp;
+    struct dirent *ep;
+    char *filenm;
+    struct stat buf;
+    int rc;
+
+    if (NULL == task->parent && !check_dir(task->path, epi)) {
+        /* make sure we don't remove it */
+        PMIX_RELEASE(task->cd);
+        task->cd = NULL;
+        return;
+    }
+    if (ignored(task->path, epi)) {
+        PMIX_RELEASE(task->cd);
+        task->cd = NULL;
+        return;
+    }
+    dp = opendir(task->path);
+    if (NULL == dp) {
+        return;
+    }
+    while (NULL != (ep = readdir(dp))) {
+        if ((0 == strcmp(ep->d_name, ".")) || (0 == strcmp(ep->d_name, ".."))) {
+            continue;
+        }
+        filenm = pmix_os_path(false, task->path, ep->d_name, NULL);
+        if (NULL == filenm) {
+            continue;
+        }
+        if (ignored(filenm, epi)) {
+            free(filenm);
+            continue;
+        }
+        /* coverity[TOCTOU] */
+        rc = stat(filenm, &buf);
+        /* leave alone anything that is already gone or not theirs */
+        if (0 > rc || buf.st_uid != epi->uid || buf.st_gid != epi->gid) {
+            free(filenm);
+            continue;
+        }
+        if (S_ISDIR(buf.st_mode)) {
+            if (task->cd->recurse && ((buf.st_mode & S_IRWXU) == S_IRWXU)) {
+                pmix_mutex_lock(&epilog_workers.lock.mutex);
+                if (NULL != new_task(task->job, task, task->cd, filenm)) {
+                    pmix_condition_broadcast(&epilog_workers.lock.cond);
+                }
+                pmix_mutex_unlock(&epilog_workers.lock.mutex);
+            }
+        } else {
+            unlink(filenm);
+        }
+        free(filenm);
+    }
+    closedir(dp);
+}
+
+static void *epilog_worker(pmix_object_t *obj)
+{
+    pmix_epilog_task_t *task;
+    PMIX_HIDE_UNUSED_PARAMS(obj);
+
+    pmix_mutex_lock(&epilog_workers.lock.mutex);
+    while (1) {
+        task = (pmix_epilog_task_t *) pmix_list_remove_first(&epilog_workers.tasks);
+        if (NULL == task) {
+            if (epilog_workers.stop) {
+                break;
+            }
+            pmix_condition_wait(&epilog_workers.lock.cond, &epilog_workers.lock.mutex);
+            continue;
+        }
+        pmix_mutex_unlock(&epilog_workers.lock.mutex);
+        if (NULL == task->cd) {
+            cleanup_file(task->path, &task->job->epi);
+        } else {
+            scan_dir(task);
+        }
+        task_done(task);
+        pmix_mutex_lock(&epilog_workers.lock.mutex);
+    }
+    pmix_mutex_unlock(&epilog_workers.lock.mutex);
+    return NULL;
+}
+
+/* must be called with the lock held */
+static bool start_workers(void)
+{
+    int n;
+
+    epilog_workers.threads = (pmix_thread_t **) calloc(pmix_globals.epilog_threads,
+                                                       sizeof(pmix_thread_t *));
+    if (NULL == epilog_workers.threads) {
+        return false;
+    }
+    epilog_workers.stop = false;
+    for (n = 0; n < pmix_globals.epilog_threads; n++) {
+        epilog_workers.threads[n] = PMIX_NEW(pmix_thread_t);
+        epilog_workers.threads[n]->t_run = epilog_worker;
+        epilog_workers.threads[n]->t_arg = NULL;
+        if (PMIX_SUCCESS != pmix_thread_start(epilog_workers.threads[n])) {
+            PMIX_RELEASE(epilog_workers.threads[n]);
+            epilog_workers.threads[n] = NULL;
+            break;
+        }
+        ++epilog_workers.nthreads;
+    }
+    if (0 == epilog_workers.nthreads) {
+        free(epilog_workers.threads);
+        epilog_workers.threads = NULL;
+        return false;
+    }
+    return true;
+}
+
+void pmix_execute_epilog(pmix_epilog_t *epi)
+{
+    pmix_epilog_job_t *job;
+    pmix_cleanup_file_t *cf, *ig;
+
+    if (0 == pmix_list_get_size(&epi->cleanup_files)
+        && 0 == pmix_list_get_size(&epi->cleanup_dirs)) {
+        return;
+    }
+
+    pmix_mutex_lock(&epilog_workers.lock.mutex);
+    if (epilog_workers.shutdown || 0 >= pmix_globals.epilog_threads
+        || (0 == epilog_workers.nthreads && !start_workers())) {
+        pmix_mutex_unlock(&epilog_workers.lock.mutex);
+        execute_epilog(epi);
+        return;
+    }
+    job = PMIX_NEW(pmix_epilog_job_t);
+    if (NULL == job) {
+        pmix_mutex_unlock(&epilog_workers.lock.mutex);
+        execute_epilog(epi);
+        return;
+    }
+    job->epi.uid = epi->uid;
+    job->epi.gid = epi->gid;
+    /* take the work - the ignores stay with the caller, so copy them */
+    pmix_list_join(&job->epi.cleanup_files, pmix_list_get_end(&job->epi.cleanup_files),
+                   &epi->cleanup_files);
+    pmix_list_join(&job->epi.cleanup_dirs, pmix_list_get_end(&job->epi.cleanup_dirs),
+                   &epi->cleanup_dirs);
+    PMIX_LIST_FOREACH (cf, &epi->ignores, pmix_cleanup_file_t) {
+        ig = PMIX_NEW(pmix_cleanup_file_t);
+        ig->path = strdup(cf->path);
+        pmix_list_append(&job->epi.ignores, &ig->super);
+    }
+    pmix_list_append(&epilog_workers.jobs, &job->super);
+    start_jobs();
+    pmix_mutex_unlock(&epilog_workers.lock.mutex);
+}
+
+/* complete all queued epilogs and stop the workers - any epilog
+ * given to us after this is executed by the caller */
+void pmix_epilog_finalize(void)
+{
+    int n;
+
+    pmix_mutex_lock(&epilog_workers.lock.mutex);
+    epilog_workers.shutdown = true;
+    if (0 == epilog_workers.nthreads) {
+        pmix_mutex_unlock(&epilog_workers.lock.mutex);
+        return;
+    }
+    while (NULL != epilog_workers.active || 0 < pmix_list_get_size(&epilog_workers.jobs)) {
+        pmix_condition_wait(&epilog_workers.lock.cond, &epilog_workers.lock.mutex);
+    }
+    epilog_workers.stop = true;
+    pmix_condition_broadcast(&epilog_workers.lock.cond);
+    pmix_mutex_unlock(&epilog_workers.lock.mutex);
+
+    for (n = 0; n < epilog_workers.nthreads; n++) {
+        pmix_thread_join(epilog_workers.threads[n], NULL);
+        PMIX_RELEASE(epilog_workers.threads[n]);
+    }
+    free(epilog_workers.threads);
+    epilog_workers.threads = NULL;
+    epilog_workers.nthreads = 0;
+}
+
 static void dirpath_destroy(char *path, pmix_cleanup_dir_t *cd, pmix_epilog_t *epi)
 {
     int rc;
@@ -42,8 +42,11 @@
 #include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_hotel.h"
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_obj_pool.h"
 #include "src/event/pmix_event.h"
 #include "src/runtime/pmix_init_util.h"
+#include "src/runtime/pmix_progress_threads.h"
+#include "src/runtime/pmix_timer.h"
 #include "src/threads/pmix_threads.h"
 
 #include "src/mca/bfrops/bfrops.h"
@@ -177,6 +180,9 @@ typedef uint8_t pmix_cmd_t;
 #define PMIX_FABRIC_UPDATE_CMD            31
 #define PMIX_COMPUTE_DEVICE_DISTANCES_CMD 32
 #define PMIX_REFRESH_CACHE                33
+#define PMIX_GET_BATCH_CMD                34
+#define PMIX_NOTIFY_BATCH_CMD             35
+#define PMIX_LOG_BATCH_CMD                36
 
 /* provide a "pretty-print" function for cmds */
 const char *pmix_command_string(pmix_cmd_t cmd);
@@ -269,6 +275,24 @@ typedef struct {
     .raw = false                    \
 }
 
+/* cached result of PMIx_Resolve_peers for one node */
+typedef struct {
+    pmix_list_item_t super;
+    char *hostname;     // NULL if the caller asked about its own node
+    pmix_rank_t *ranks;
+    size_t nranks;
+} pmix_resolved_peers_t;
+PMIX_CLASS_DECLARATION(pmix_resolved_peers_t);
+
+/* cached PMIX_LOCALITY_MATRIX of an nspace, with the matrix
+ * row of each local peer - the peers are sorted by rank */
+typedef struct {
+    pmix_rank_t *ranks;
+    size_t *rows;
+    size_t npeers;
+    pmix_byte_object_t matrix;  // empty if the server provided none
+} pmix_resolved_locality_t;
+
 /* objects used by servers for tracking active nspaces */
 typedef struct {
     pmix_list_item_t super;
@@ -298,6 +322,17 @@ typedef struct {
                             // for setting up the local node for this nspace/application
     pmix_iof_flags_t iof_flags;   // output formatting flags
     pmix_list_t sinks;   // IOF write events for output to files or directories
+    /* pre-split results of PMIx_Resolve_nodes/peers - flushed
+     * whenever job-level data for this nspace is updated */
+    pmix_mutex_t resolve_lock;
+    char *resolved_nodes;
+    pmix_list_t resolved_peers;   // list of pmix_resolved_peers_t
+    pmix_resolved_locality_t *resolved_locality;  // NULL until first looked up
+    /* when the server may discard the modex data it holds for
+     * remote procs - see PMIX_MODEX_RELEASE_TIME/FETCHED */
+    uint32_t mdx_release_time;  // secs after each fence, 0 to keep it
+    bool mdx_release_fetched;   // once each local proc has fetched it
+    uint32_t *mdx_fetches;      // fetches served for each rank
 } pmix_namespace_t;
 PMIX_CLASS_DECLARATION(pmix_namespace_t);
 
@@ -369,22 +404,36 @@ PMIX_CLASS_DECLARATION(pmix_proclist_t);
  * by the socket, not the process nspace/rank */
 typedef struct pmix_peer_t {
     pmix_object_t super;
+    /* fields read on every message and by the server's walks over
+     * its clients - kept together at the front of the object */
     pmix_namespace_t *nptr; // point to the nspace object for this process
     pmix_rank_info_t *info;
     pmix_proc_type_t proc_type;
-    pmix_listener_protocol_t protocol;
-    int proc_cnt;
     int index; // index into the local clients array on the server
     int sd;
     bool finalized;          // peer has called finalize
-    pmix_event_t send_event; /**< registration with event thread for send events */
+    bool purged;             // its registrations were purged when it finalized
     bool send_ev_active;
-    pmix_event_t recv_event; /**< registration with event thread for recv events */
     bool recv_ev_active;
-    pmix_list_t send_queue;    /**< list of messages to send */
+    bool send_batched;         // waiting to be written with other peers
+    pmix_event_base_t *evbase; // I/O thread servicing the socket, NULL => shared thread
     pmix_ptl_send_t *send_msg; /**< current send in progress */
     pmix_ptl_recv_t *recv_msg; /**< current recv in progress */
+    char *rahead;              /**< bytes read from the socket ahead of the current recv */
+    size_t rahead_off;         /**< next unconsumed byte in rahead */
+    size_t rahead_len;         /**< number of valid bytes in rahead */
+    pmix_list_t send_queue;    /**< list of messages to send */
+    /* fields only used when the connection is set up or torn
+     * down, or by less frequent operations - the event structures
+     * are large, so they stay out of the way of the above */
+    pmix_listener_protocol_t protocol;
+    int proc_cnt;
     int commit_cnt;
+    pmix_list_t pending_reqs;  /**< arrival times of requests awaiting a reply */
+    int nqueued;               /**< messages held by the server's scheduler */
+    int qclass;                /**< scheduler class those messages are queued in */
+    pmix_event_t send_event; /**< registration with event thread for send events */
+    pmix_event_t recv_event; /**< registration with event thread for recv events */
     pmix_epilog_t epilog; /**< things to be performed upon
                                termination of this peer */
 } pmix_peer_t;
@@ -448,7 +497,8 @@ PMIX_CLASS_DECLARATION(pmix_grpinfo_t);
 typedef struct {
     pmix_list_item_t super;
     pmix_event_t ev;
-    bool event_active;
+    pmix_timer_t timer; // timeout of the operation
+    bool event_active;  // timer is pending
     bool host_called; // tracker has been passed up to host
     bool local;       // operation is strictly local
     char *id;         // string identifier for the collective
@@ -457,6 +507,7 @@ typedef struct {
     bool hybrid;            // true if participating procs are from more than one nspace
     pmix_proc_t *pcs;       // copy of the original array of participants
     size_t npcs;            // number of procs in the array
+    uint64_t sig;           // signature indexing the tracker in the server's table
     pmix_list_t nslist;     // unique nspace list of participants
     pmix_lock_t lock;       // flag for waiting for completion
     bool def_complete;      // all local procs have been registered and the trk definition is complete
@@ -469,6 +520,11 @@ typedef struct {
     size_t ninfo;           // number of info structs in array
     pmix_list_t grpinfo;    // list of group info to be distributed
     pmix_collect_t collect_type; // whether or not data is to be returned at completion
+    char **collect_keys;         // keys (or prefixes ending in '*') to collect - NULL for all
+    uint32_t mdx_release_time;   // PMIX_MODEX_RELEASE_TIME given to the fence
+    bool mdx_release_fetched;    // PMIX_MODEX_RELEASE_FETCHED given to the fence
+    pmix_buffer_t *pipeline;     // blob assembled as local contributions arrive
+    size_t npipelined;           // number of contributions in the pipelined blob
     pmix_modex_cbfunc_t modexcbfunc;
     pmix_op_cbfunc_t op_cbfunc;
     void *cbdata;
@@ -594,11 +650,17 @@ typedef struct {
 } pmix_cb_t;
 PMIX_CLASS_DECLARATION(pmix_cb_t);
 
-#define PMIX_THREADSHIFT(r, c)                                                      \
-    do {                                                                            \
-        pmix_event_assign(&((r)->ev), pmix_globals.evbase, -1, EV_WRITE, (c), (r)); \
-        PMIX_POST_OBJECT((r));                                                      \
-        pmix_event_active(&((r)->ev), EV_WRITE, 1);                                 \
+#define PMIX_THREADSHIFT(r, c)                                                          \
+    do {                                                                                \
+        if (pmix_progress_thread_profile) {                                             \
+            static pmix_progress_site_t _pmix_site = PMIX_PROGRESS_SITE_STATIC_INIT(c); \
+            PMIX_POST_OBJECT((r));                                                      \
+            pmix_progress_thread_shift_profiled(&_pmix_site, &((r)->ev), (r));          \
+        } else {                                                                        \
+            pmix_event_assign(&((r)->ev), pmix_globals.evbase, -1, EV_WRITE, (c), (r)); \
+            PMIX_POST_OBJECT((r));                                                      \
+            pmix_progress_thread_shift(&((r)->ev));                                     \
+        }                                                                               \
     } while (0)
 
 #define PMIX_THREADSHIFT_DELAY(r, c, t)                                  \
@@ -611,7 +673,7 @@ PMIX_CLASS_DECLARATION(pmix_cb_t);
         pmix_event_evtimer_add(&(r)->ev, &_tv);                          \
     } while (0)
 
-typedef struct {
+typedef struct pmix_notify_caddy_t {
     pmix_object_t super;
     pmix_event_t ev;
     pmix_lock_t lock;
@@ -620,6 +682,9 @@ typedef struct {
     time_t ts;
     /* what room of the hotel they are in */
     int room;
+    /* ring of the cached notifications with the same status */
+    struct pmix_notify_caddy_t *code_prev;
+    struct pmix_notify_caddy_t *code_next;
     pmix_status_t status;
     pmix_proc_t source;
     pmix_data_range_t range;
@@ -685,6 +750,7 @@ typedef struct {
     int max_events;                    // size of the notifications hotel
     int event_eviction_time;           // max time to cache notifications
     pmix_hotel_t notifications;        // hotel of pending notifications
+    pmix_hash_table_t notify_codes;    // cached notifications indexed by status code
     /* IOF controls */
     bool pushstdin;
     pmix_list_t stdin_targets; // list of pmix_namelist_t
@@ -692,6 +758,16 @@ typedef struct {
     bool xml_output;
     bool timestamp_output;
     size_t output_limit;
+    size_t iof_read_size;   // bytes first taken from a local IO channel in one pass
+    size_t iof_read_max;    // largest a pass may grow to while the channel stays full
+    int iof_flush_usec;     // longest a pass may keep reading before passing the data on
+    size_t iof_compress_limit; // forwarded output at least this large is compressed, 0 => never
+    int iof_format_threads; // threads that tag output, 0 => progress thread does it
+    int epilog_threads;     // threads that execute epilogs, 0 => caller does it
+    /* placement of shared-memory segments */
+    bool shmem_hugepages;   // ask for the segments to be backed by huge pages
+    bool shmem_interleave;  // spread the pages of the segments across NUMA domains
+    bool shmem_prefault;    // fault the segments in when they are mapped
     pmix_list_t nspaces;
     pmix_topology_t topology;
     pmix_cpuset_t cpuset;
@@ -699,20 +775,52 @@ typedef struct {
     bool external_progress;
     pmix_iof_flags_t iof_flags;
     pmix_pointer_array_t keyindex;  // translation table of key <-> index
+    pmix_hash_table_t keynames;     // user-defined keys indexed by string
     uint32_t next_keyid;
+    /* storage pools for frequently created objects */
+    size_t obj_pool_max;       // max objects of each class held for reuse
+    bool obj_pool_report;      // output pool usage at finalize
+    pmix_obj_pool_t kval_pool;
+    pmix_obj_pool_t buffer_pool;
+    pmix_obj_pool_t send_pool;
+    pmix_obj_pool_t recv_pool;
 } pmix_globals_t;
 
 /* provide access to a function to cleanup epilogs */
 PMIX_EXPORT void pmix_execute_epilog(pmix_epilog_t *ep);
+PMIX_EXPORT void pmix_epilog_finalize(void);
 
 PMIX_EXPORT pmix_status_t pmix_notify_event_cache(pmix_notify_caddy_t *cd);
 
+/* remove a notification from the cache - the caller retains
+ * their reference to it */
+PMIX_EXPORT void pmix_notify_event_uncache(pmix_notify_caddy_t *cd);
+
+/* return an array of the cached notifications for the given codes, or
+ * of all cached notifications that default handlers may receive if no
+ * codes are given. The array must be free'd by the caller */
+PMIX_EXPORT pmix_status_t pmix_notify_event_cached(pmix_status_t *codes, size_t ncodes,
+                                                   pmix_notify_caddy_t ***cds, size_t *ncds);
+
+/* discard the cached PMIx_Resolve_nodes/peers results of an nspace */
+PMIX_EXPORT void pmix_namespace_flush_resolved(pmix_namespace_t *ns);
+
+PMIX_EXPORT void pmix_resolved_locality_free(pmix_resolved_locality_t *loc);
+
+/* pack/unpack a set of procs, such as the targets of an abort - the
+ * unpacked array must be free'd with PMIX_PROC_FREE */
+PMIX_EXPORT pmix_status_t pmix_pack_proc_set(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                             const pmix_proc_t *procs, size_t nprocs);
+PMIX_EXPORT pmix_status_t pmix_unpack_proc_set(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                               pmix_proc_t **procs, size_t *nprocs);
+
 PMIX_EXPORT extern pmix_globals_t pmix_globals;
 PMIX_EXPORT extern pmix_lock_t pmix_global_lock;
 PMIX_EXPORT extern const char* PMIX_PROXY_VERSION;
 PMIX_EXPORT extern const char* PMIX_PROXY_BUGREPORT;
 
 PMIX_EXPORT void pmix_log_local_op(int sd, short args, void *cbdata_);
+PMIX_EXPORT void pmix_log_flush(void);
 
 static inline bool pmix_check_node_info(const char *key)
 {
@@ -72,6 +72,7 @@ PMIX_EXPORT extern char *pmix_mca_base_component_path;
 PMIX_EXPORT extern char *pmix_mca_base_component_show_load_errors;
 PMIX_EXPORT extern bool pmix_mca_base_component_track_load_errors;
 PMIX_EXPORT extern bool pmix_mca_base_component_disable_dlopen;
+PMIX_EXPORT extern bool pmix_mca_base_component_use_manifest;
 PMIX_EXPORT extern char *pmix_mca_base_system_default_path;
 PMIX_EXPORT extern char *pmix_mca_base_user_default_path;
 
@@ -34,6 +34,9 @@
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
 
 #include "pmix_common.h"
 #include "src/class/pmix_hash_table.h"
@@ -43,6 +46,7 @@
 #include "src/mca/base/pmix_mca_base_component_repository.h"
 #include "src/mca/mca.h"
 #include "src/mca/pdl/base/base.h"
+#include "src/util/pmix_os_path.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/pmix_basename.h"
 #include "src/util/pmix_show_help.h"
@@ -108,6 +112,12 @@ static int process_repository_item(const char *filename, void *data)
         return PMIX_ERROR;
     }
 
+    /* the component manifest lives alongside the components */
+    if (0 == strcmp(base, PMIX_MCA_BASE_COMPONENT_MANIFEST)) {
+        free(base);
+        return PMIX_SUCCESS;
+    }
+
     /* check if the plugin has the appropriate prefix */
     pmix_asprintf(&prefix, "%s_mca_", project);
     if (0 != strncmp(base, prefix, strlen(prefix))) {
@@ -190,6 +200,59 @@ static int process_repository_item(const char *filename, void *data)
     return PMIX_SUCCESS;
 }
 
+/* process the components listed in the manifest of the given
+ * directory. Returns PMIX_ERR_NOT_FOUND if there is no manifest,
+ * or if it is older than the directory and so may be missing
+ * components that were added since it was written */
+static int process_manifest(const char *dir, char *project)
+{
+    struct stat dbuf, mbuf;
+    char line[PMIX_PATH_MAX], *path, *ptr;
+    FILE *fp;
+    int ret = PMIX_SUCCESS;
+
+    if (!pmix_mca_base_component_use_manifest) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    path = pmix_os_path(false, dir, PMIX_MCA_BASE_COMPONENT_MANIFEST, NULL);
+    if (NULL == path) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 != stat(dir, &dbuf) || 0 != stat(path, &mbuf) || mbuf.st_mtime < dbuf.st_mtime
+        || NULL == (fp = fopen(path, "r"))) {
+        free(path);
+        return PMIX_ERR_NOT_FOUND;
+    }
+    free(path);
+
+    /* each line holds the name of a component file without
+     * its suffix, as the directory scan would report it */
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        if (NULL != (ptr = strchr(line, '\n'))) {
+            *ptr = '\0';
+        }
+        if ('\0' == line[0] || NULL != strchr(line, '/')) {
+            continue;
+        }
+        path = pmix_os_path(false, dir, line, NULL);
+        if (NULL == path) {
+            ret = PMIX_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+        ret = process_repository_item(path, (void *) project);
+        free(path);
+        if (PMIX_SUCCESS != ret) {
+            break;
+        }
+    }
+    fclose(fp);
+
+    pmix_output_verbose(PMIX_MCA_BASE_VERBOSE_COMPONENT, 0,
+                        "mca: base: component_repository: found components of %s in manifest",
+                        dir);
+    return ret;
+}
+
 static int file_exists(const char *filename, const char *ext)
 {
     char *final;
@@ -217,6 +280,7 @@ int pmix_mca_base_component_repository_add(const char *project,
 #if PMIX_HAVE_PDL_SUPPORT
     char *path_to_use = NULL, *dir, *ctx;
     const char sep[] = {PMIX_ENV_SEP, '\0'};
+    int ret;
 
     if (NULL == path) {
         /* nothing to do */
@@ -227,7 +291,11 @@ int pmix_mca_base_component_repository_add(const char *project,
 
     dir = strtok_r(path_to_use, sep, &ctx);
     do {
-        if (0 != pmix_pdl_foreachfile(dir, process_repository_item, (void*)project) &&
+        ret = process_manifest(dir, (char *) project);
+        if (PMIX_ERR_NOT_FOUND == ret) {
+            ret = pmix_pdl_foreachfile(dir, process_repository_item, (void*)project);
+        }
+        if (0 != ret &&
             !(0 == strcmp(dir, pmix_mca_base_system_default_path) ||
               0 == strcmp(dir, pmix_mca_base_user_default_path))) {
             // It is not an error if a directory fails to add (e.g.,
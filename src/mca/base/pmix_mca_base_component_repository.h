@@ -85,6 +85,14 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_mca_base_failed_component_t);
  */
 PMIX_EXPORT int pmix_mca_base_component_repository_init(void);
 
+/**
+ * Name of the manifest file listing the components installed in a
+ * component directory. The manifest is written when the components
+ * are installed, and is used in place of a scan of the directory as
+ * long as it is not older than the directory itself.
+ */
+#define PMIX_MCA_BASE_COMPONENT_MANIFEST "pmix-mca-components"
+
 /**
  * @brief add search path for dynamically loaded components
  *
@@ -16,6 +16,7 @@
 
 #include "pmix_common.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_timings.h"
 
 #include "pmix_mca_base_framework.h"
 #include "pmix_mca_base_var.h"
@@ -168,11 +169,13 @@ int pmix_mca_base_framework_open(struct pmix_mca_base_framework_t *framework,
     /* check the verbosity level and open (or close) the output */
     framework_open_output(framework);
 
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_OPEN);
     if (NULL != framework->framework_open) {
         ret = framework->framework_open(flags);
     } else {
         ret = pmix_mca_base_framework_components_open(framework, flags);
     }
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_OPEN);
 
     if (PMIX_SUCCESS != ret) {
         framework->framework_refcnt--;
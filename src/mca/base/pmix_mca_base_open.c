@@ -53,6 +53,7 @@ char *pmix_mca_base_user_default_path = NULL;
 char *pmix_mca_base_component_show_load_errors = NULL;
 bool pmix_mca_base_component_track_load_errors = false;
 bool pmix_mca_base_component_disable_dlopen = false;
+bool pmix_mca_base_component_use_manifest = true;
 
 static char *pmix_mca_base_verbose = NULL;
 static char *path_from_param = NULL;
@@ -163,6 +164,14 @@ int pmix_mca_base_open(const char *add_path)
                                               "component_disable_dlopen",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    pmix_mca_base_component_use_manifest = true;
+    var_id = pmix_mca_base_var_register(
+        "pmix", "mca", "base", "component_use_manifest",
+        "Whether to find dynamic components from the manifest written when they were "
+        "installed instead of scanning the component directories",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_mca_base_component_use_manifest);
+
     /* What verbosity level do we want for the default 0 stream? */
     pmix_mca_base_verbose = "stderr";
     var_id = pmix_mca_base_var_register(
@@ -31,6 +31,7 @@
 #include "src/mca/base/pmix_base.h"
 #include "src/mca/base/pmix_mca_base_vari.h"
 #include "src/mca/mca.h"
+#include "src/util/pmix_environ.h"
 #include "src/util/pmix_keyval_parse.h"
 
 static void save_value(const char *file, int lineno,
@@ -44,7 +45,9 @@ int pmix_mca_base_parse_paramfile(const char *paramfile, pmix_list_t *list)
     file_being_read = (char *) paramfile;
     _param_list = list;
 
-    return pmix_util_keyval_parse(paramfile, save_value);
+    return pmix_util_keyval_parse_cached(paramfile,
+                                         pmix_mca_base_var_file_cache ? pmix_tmp_directory() : NULL,
+                                         save_value);
 }
 
 int pmix_mca_base_internal_env_store(void)
@@ -66,11 +66,22 @@ static char *pmix_mca_base_var_override_file = NULL;
 static char *pmix_mca_base_var_file_prefix = NULL;
 static char *pmix_mca_base_param_file_path = NULL;
 static bool pmix_mca_base_var_suppress_override_warning = false;
+bool pmix_mca_base_var_file_cache = true;
 static pmix_list_t pmix_mca_base_var_file_values = PMIX_LIST_STATIC_INIT;
 static pmix_list_t pmix_mca_base_var_override_values = PMIX_LIST_STATIC_INIT;
 static int pmix_mca_base_var_count = 0;
 static pmix_hash_table_t pmix_mca_base_var_index_hash = PMIX_HASH_TABLE_STATIC_INIT;
 
+/* snapshot of the MCA entries in the environment so that each
+ * registration does not search the full environment for every
+ * name of the variable. The entries point into environ and the
+ * snapshot is rebuilt whenever the environment has changed */
+static pmix_hash_table_t pmix_mca_base_var_env_hash = PMIX_HASH_TABLE_STATIC_INIT;
+static bool pmix_mca_base_var_env_current = false;
+static char **pmix_mca_base_var_env_base = NULL;
+static size_t pmix_mca_base_var_env_count = 0;
+static uintptr_t pmix_mca_base_var_env_sum = 0;
+
 #define PMIX_MCA_VAR_MBV_ENUMERATOR_FREE(mbv_enumerator)         \
     {                                                            \
         if (mbv_enumerator && !mbv_enumerator->enum_is_static) { \
@@ -212,6 +223,66 @@ static char *append_filename_to_list(const char *filename)
     return NULL;
 }
 
+/*
+ * Take a snapshot of the MCA entries in the environment unless
+ * the one we have is still current. The environment is taken to
+ * be unchanged if the array, the number of entries and the
+ * entries themselves are the same as when the snapshot was taken
+ */
+static void env_snapshot_update(void)
+{
+    char **env = environ;
+    uintptr_t sum = 0;
+    size_t n, count;
+    void *value;
+    char *ptr, *mca;
+
+    for (n = 0; NULL != env && NULL != env[n]; n++) {
+        sum += (uintptr_t) env[n];
+    }
+    count = n;
+
+    if (pmix_mca_base_var_env_current && env == pmix_mca_base_var_env_base
+        && count == pmix_mca_base_var_env_count && sum == pmix_mca_base_var_env_sum) {
+        return;
+    }
+
+    pmix_hash_table_remove_all(&pmix_mca_base_var_env_hash);
+    for (n = 0; n < count; n++) {
+        ptr = strchr(env[n], '=');
+        if (NULL == ptr) {
+            continue;
+        }
+        mca = strstr(env[n], "_MCA_");
+        if (NULL == mca || mca > ptr) {
+            continue;
+        }
+        /* getenv returns the first of any duplicates */
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_mca_base_var_env_hash, env[n],
+                                                          ptr - env[n], &value)) {
+            continue;
+        }
+        pmix_hash_table_set_value_ptr(&pmix_mca_base_var_env_hash, env[n], ptr - env[n],
+                                      ptr + 1);
+    }
+
+    pmix_mca_base_var_env_current = true;
+    pmix_mca_base_var_env_base = env;
+    pmix_mca_base_var_env_count = count;
+    pmix_mca_base_var_env_sum = sum;
+}
+
+static char *env_snapshot_get(const char *name)
+{
+    void *value;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_mca_base_var_env_hash, name,
+                                                      strlen(name), &value)) {
+        return NULL;
+    }
+    return (char *) value;
+}
+
 /*
  * Set it up
  */
@@ -242,6 +313,14 @@ int pmix_mca_base_var_init(void)
             return ret;
         }
 
+        PMIX_CONSTRUCT(&pmix_mca_base_var_env_hash, pmix_hash_table_t);
+        ret = pmix_hash_table_init(&pmix_mca_base_var_env_hash, 64);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        pmix_mca_base_var_env_current = false;
+        env_snapshot_update();
+
         ret = pmix_mca_base_var_group_init();
         if (PMIX_SUCCESS != ret) {
             return ret;
@@ -370,6 +449,17 @@ int pmix_mca_base_var_cache_files(bool rel_path_search)
         return ret;
     }
 
+    pmix_mca_base_var_file_cache = true;
+    ret = pmix_mca_base_var_register(
+        "pmix", "mca", "base", "param_file_cache",
+        "Keep the parsed contents of MCA parameter files in the temporary directory "
+        "so the other processes on the node can map them instead of parsing the files "
+        "(default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_base_var_file_cache);
+    if (0 > ret) {
+        return ret;
+    }
+
     /* Aggregate MCA parameter files
      * A prefix search path to look up aggregate MCA parameter file
      * requests that do not specify an absolute path
@@ -947,7 +1037,8 @@ int pmix_mca_base_var_finalize(void)
         (void) pmix_mca_base_var_group_finalize();
 
         PMIX_DESTRUCT(&pmix_mca_base_var_index_hash);
-
+        PMIX_DESTRUCT(&pmix_mca_base_var_env_hash);
+        pmix_mca_base_var_env_current = false;
     }
 
     /* All done */
@@ -1345,8 +1436,8 @@ static int var_get_env(pmix_mca_base_var_t *var, const char *name, char **source
         return PMIX_ERROR;
     }
 
-    *source = getenv(source_env);
-    *value = getenv(value_env);
+    *source = env_snapshot_get(source_env);
+    *value = env_snapshot_get(value_env);
 
     free(source_env);
     free(value_env);
@@ -1371,6 +1462,8 @@ static int var_set_from_env(pmix_mca_base_var_t *var, pmix_mca_base_var_t *origi
     char *source_env, *value_env;
     int ret;
 
+    env_snapshot_update();
+
     ret = var_get_env(var, var_long_name, &source_env, &value_env);
     if (PMIX_SUCCESS != ret) {
         ret = var_get_env(var, var_full_name, &source_env, &value_env);
@@ -105,6 +105,13 @@ PMIX_EXPORT int pmix_mca_base_var_group_get_internal(const int group_index,
                                                      pmix_mca_base_var_group_t **group,
                                                      bool invalidok);
 
+/**
+ * \internal
+ *
+ * Whether parsed parameter files are cached in the temporary directory
+ */
+PMIX_EXPORT extern bool pmix_mca_base_var_file_cache;
+
 /**
  * \internal
  *
@@ -35,6 +35,12 @@
 #ifdef HAVE_STRING_H
 #    include <string.h>
 #endif
+#ifdef HAVE_SYS_UIO_H
+#    include <sys/uio.h>
+#endif
+#ifdef HAVE_NET_UIO_H
+#    include <net/uio.h>
+#endif
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/include/pmix_globals.h"
@@ -192,28 +198,46 @@ PMIX_EXPORT extern pmix_bfrops_globals_t pmix_bfrops_globals;
         }                                                                                         \
     } while (0)
 
-#define PMIX_BFROPS_PACK_TYPE(r, b, s, n, t, arr)                                    \
-    do {                                                                             \
-        pmix_bfrop_type_info_t *__info;                                              \
-        /* Lookup the pack function for this type and call it */                     \
-        __info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item((arr), (t)); \
-        if (NULL == __info) {                                                        \
-            (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                        \
-        } else {                                                                     \
-            (r) = __info->odti_pack_fn(arr, b, s, n, t);                             \
-        }                                                                            \
+#define PMIX_BFROPS_PACK_TYPE(r, b, s, n, t, arr)                                        \
+    do {                                                                                 \
+        pmix_bfrop_type_info_t *__info;                                                  \
+        if (PMIX_LIKELY((arr) == pmix_bfrops_base_native_types                           \
+                        && (t) < PMIX_BFROP_JUMP_TABLE_SIZE)) {                          \
+            if (NULL == pmix_bfrops_base_jump_table.pack[(t)]) {                         \
+                (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                        \
+            } else {                                                                     \
+                (r) = pmix_bfrops_base_jump_table.pack[(t)](arr, b, s, n, t);            \
+            }                                                                            \
+            break;                                                                       \
+        }                                                                                \
+        /* Lookup the pack function for this type and call it */                         \
+        __info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item((arr), (t));     \
+        if (NULL == __info) {                                                            \
+            (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                            \
+        } else {                                                                         \
+            (r) = __info->odti_pack_fn(arr, b, s, n, t);                                 \
+        }                                                                                \
     } while (0)
 
-#define PMIX_BFROPS_UNPACK_TYPE(r, b, d, n, t, arr)                                  \
-    do {                                                                             \
-        pmix_bfrop_type_info_t *__info;                                              \
-        /* Lookup the unpack function for this type and call it */                   \
-        __info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item((arr), (t)); \
-        if (NULL == __info) {                                                        \
-            (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                        \
-        } else {                                                                     \
-            (r) = __info->odti_unpack_fn(arr, b, d, n, t);                           \
-        }                                                                            \
+#define PMIX_BFROPS_UNPACK_TYPE(r, b, d, n, t, arr)                                      \
+    do {                                                                                 \
+        pmix_bfrop_type_info_t *__info;                                                  \
+        if (PMIX_LIKELY((arr) == pmix_bfrops_base_native_types                           \
+                        && (t) < PMIX_BFROP_JUMP_TABLE_SIZE)) {                          \
+            if (NULL == pmix_bfrops_base_jump_table.unpack[(t)]) {                       \
+                (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                        \
+            } else {                                                                     \
+                (r) = pmix_bfrops_base_jump_table.unpack[(t)](arr, b, d, n, t);          \
+            }                                                                            \
+            break;                                                                       \
+        }                                                                                \
+        /* Lookup the unpack function for this type and call it */                       \
+        __info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item((arr), (t));     \
+        if (NULL == __info) {                                                            \
+            (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                            \
+        } else {                                                                         \
+            (r) = __info->odti_unpack_fn(arr, b, d, n, t);                               \
+        }                                                                                \
     } while (0)
 
 /* NOTE: do not need to deal with endianness here, as the unpacking of
@@ -267,6 +291,19 @@ typedef struct {
 } pmix_bfrop_type_info_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_bfrop_type_info_t);
 
+/* Jump tables of the pack and unpack functions of the native types,
+ * indexed by type. They cover every standard type, so the native
+ * component's functions are reached without going through its
+ * registered type info - other types use the lookup */
+#define PMIX_BFROP_JUMP_TABLE_SIZE 128
+
+typedef struct {
+    pmix_bfrop_internal_pack_fn_t pack[PMIX_BFROP_JUMP_TABLE_SIZE];
+    pmix_bfrop_internal_unpack_fn_t unpack[PMIX_BFROP_JUMP_TABLE_SIZE];
+} pmix_bfrops_jump_table_t;
+
+PMIX_EXPORT extern pmix_bfrops_jump_table_t pmix_bfrops_base_jump_table;
+
 /* macro for registering data types - overwrite an existing
  * duplicate one based on type name */
 #define PMIX_REGISTER_TYPE(n, t, p, u, c, pr, arr)                    \
@@ -319,9 +356,6 @@ PMIX_EXPORT const char *pmix_bfrops_base_data_type_string(pmix_pointer_array_t *
 /*
  * "Standard" pack functions
  */
-PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack(pmix_pointer_array_t *regtypes,
-                                                pmix_buffer_t *buffer, const void *src,
-                                                int num_vals, pmix_data_type_t type);
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_buffer(pmix_pointer_array_t *regtypes,
                                                        pmix_buffer_t *buffer, const void *src,
                                                        int32_t num_vals, pmix_data_type_t type);
@@ -521,9 +555,6 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_satyp(pmix_pointer_array_t *regt
 /*
  * "Standard" unpack functions
  */
-PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes,
-                                                  pmix_buffer_t *buffer, void *dst,
-                                                  int32_t *num_vals, pmix_data_type_t type);
 
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_bool(pmix_pointer_array_t *regtypes,
                                                        pmix_buffer_t *buffer, void *dest,
@@ -985,6 +1016,37 @@ PMIX_EXPORT char *pmix_bfrop_buffer_extend(pmix_buffer_t *bptr, size_t bytes_to_
 
 PMIX_EXPORT bool pmix_bfrop_too_small(pmix_buffer_t *buffer, size_t bytes_reqd);
 
+/* make sure at least the given number of bytes can be packed into
+ * the buffer without it having to grow again */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_buffer_reserve(pmix_buffer_t *buffer, size_t bytes);
+
+/* add bytes received from a peer behind the ones still to be
+ * unpacked, first dropping those already unpacked so that a buffer
+ * fed a piece at a time only holds what is pending */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_buffer_feed(pmix_buffer_t *buffer, const char *bytes,
+                                                       size_t size);
+
+/* rough number of bytes the value/info array will take once packed
+ * into a fully-described buffer - meant to size a buffer up front
+ * with pmix_bfrops_base_buffer_reserve, not to be exact */
+PMIX_EXPORT size_t pmix_bfrops_base_value_size_estimate(const pmix_value_t *v);
+
+PMIX_EXPORT size_t pmix_bfrops_base_info_size_estimate(const pmix_info_t *info, size_t ninfo);
+
+/* append memory to the payload of the buffer without copying it -
+ * the buffer owns it from then on, even if an error is returned, and
+ * hands it to release(cbdata) once done with it, or frees it if
+ * release is NULL. Packing may continue afterwards */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_buffer_chain(pmix_buffer_t *buffer, char *bytes,
+                                                        size_t size, pmix_release_cbfunc_t release,
+                                                        void *cbdata);
+
+/* describe the payload of the buffer from the given offset on in
+ * at most maxiov entries, returning the number used and setting
+ * nbytes to the number of bytes they cover */
+PMIX_EXPORT int pmix_bfrops_base_buffer_iov(pmix_buffer_t *buffer, size_t offset,
+                                            struct iovec *iov, int maxiov, size_t *nbytes);
+
 PMIX_EXPORT pmix_status_t pmix_bfrop_store_data_type(pmix_pointer_array_t *regtypes,
                                                      pmix_buffer_t *buffer, pmix_data_type_t type);
 
@@ -993,6 +1055,9 @@ PMIX_EXPORT pmix_status_t pmix_bfrop_get_data_type(pmix_pointer_array_t *regtype
 
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_copy_payload(pmix_buffer_t *dest, pmix_buffer_t *src);
 
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_chain_payload(pmix_pointer_array_t *regtypes,
+                                                         pmix_buffer_t *dest, pmix_buffer_t *src);
+
 PMIX_EXPORT void pmix_bfrops_base_value_load(pmix_value_t *v, const void *data,
                                              pmix_data_type_t type);
 
@@ -1000,10 +1065,31 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_value_unload(pmix_value_t *kv, void *
 
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_value_xfer(pmix_value_t *p, const pmix_value_t *src);
 
+/* Size of the field of the value union used by each type that is
+ * held by value - these are compared and copied as plain memory,
+ * without looking at the type any further. Zero for all other types
+ * (strings, pointers to structures, ...) and PMIX_UNDEF */
+#define PMIX_BFROPS_BASE_SCALAR_MAX (PMIX_STOR_ACCESS_TYPE + 1)
+PMIX_EXPORT extern const uint8_t pmix_bfrops_base_scalar_size[PMIX_BFROPS_BASE_SCALAR_MAX];
+
+#define PMIX_BFROPS_BASE_SCALAR_SIZE(t) \
+    ((t) < PMIX_BFROPS_BASE_SCALAR_MAX ? pmix_bfrops_base_scalar_size[(t)] : 0)
+
 PMIX_EXPORT pmix_value_cmp_t pmix_bfrops_base_value_cmp(pmix_value_t *p, pmix_value_t *p1);
 
 PMIX_EXPORT void pmix_bfrops_base_value_destruct(pmix_value_t *v);
 
+/* move the contents of src to dest without copying them - src is
+ * left undefined, and any prior contents of dest are NOT released */
+PMIX_EXPORT void pmix_bfrops_base_value_move(pmix_value_t *dest, pmix_value_t *src);
+
+PMIX_EXPORT void pmix_bfrops_base_info_move(pmix_info_t *dest, pmix_info_t *src);
+
+/* replace an info array with one that has nadd more (empty) slots
+ * at its end, moving the existing entries over */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_info_array_grow(pmix_info_t **info, size_t *ninfo,
+                                                           size_t nadd);
+
 PMIX_EXPORT void pmix_bfrops_base_darray_destruct(pmix_data_array_t *d);
 
 END_C_DECLS
@@ -48,6 +48,50 @@ do {                                \
     }                               \
 } while(0)
 
+/* compare values held in the value union the same way memcmp does -
+ * most callers only want to know if they are equal, so check that
+ * with plain loads and leave the ordering to memcmp */
+static inline pmix_value_cmp_t cmp_scalar(const void *d1, const void *d2, size_t sz)
+{
+    uint8_t a8, b8;
+    uint16_t a16, b16;
+    uint32_t a32, b32;
+    uint64_t a64, b64;
+    bool equal;
+    int ret;
+
+    switch (sz) {
+    case 1:
+        memcpy(&a8, d1, 1);
+        memcpy(&b8, d2, 1);
+        equal = (a8 == b8);
+        break;
+    case 2:
+        memcpy(&a16, d1, 2);
+        memcpy(&b16, d2, 2);
+        equal = (a16 == b16);
+        break;
+    case 4:
+        memcpy(&a32, d1, 4);
+        memcpy(&b32, d2, 4);
+        equal = (a32 == b32);
+        break;
+    case 8:
+        memcpy(&a64, d1, 8);
+        memcpy(&b64, d2, 8);
+        equal = (a64 == b64);
+        break;
+    default:
+        equal = false;
+        break;
+    }
+    if (equal) {
+        return PMIX_EQUAL;
+    }
+    ret = memcmp(d1, d2, sz);
+    PMIX_CHECK_SIMPLE(ret);
+}
+
 PMIX_EXPORT pmix_value_cmp_t PMIx_Value_compare(pmix_value_t *v1,
                                                 pmix_value_t *v2)
 {
@@ -1020,6 +1064,12 @@ static pmix_value_cmp_t cmp_darray(pmix_data_array_t *d1,
     }
     /* the size is greater than zero */
 
+    if (0 != PMIX_BFROPS_BASE_SCALAR_SIZE(d1->type)) {
+        ret = memcmp(d1->array, d2->array,
+                     d1->size * PMIX_BFROPS_BASE_SCALAR_SIZE(d1->type));
+        PMIX_CHECK_SIMPLE(ret);
+    }
+
     switch (d1->type) {
         case PMIX_UNDEF:
             return PMIX_EQUAL;
@@ -1349,12 +1399,18 @@ pmix_value_cmp_t pmix_bfrops_base_value_cmp(pmix_value_t *p1,
                                             pmix_value_t *p2)
 {
     pmix_value_cmp_t rc;
+    size_t sz;
     int ret;
 
     if (p1->type != p2->type) {
         return PMIX_VALUE_TYPE_DIFFERENT;
     }
 
+    sz = PMIX_BFROPS_BASE_SCALAR_SIZE(p1->type);
+    if (0 != sz) {
+        return cmp_scalar(&p1->data, &p2->data, sz);
+    }
+
     switch (p1->type) {
     case PMIX_UNDEF:
         return PMIX_EQUAL;
@@ -77,6 +77,10 @@ pmix_status_t pmix_bfrops_base_copy_payload(pmix_buffer_t *dest, pmix_buffer_t *
     if (PMIX_BUFFER_IS_EMPTY(src)) {
         return PMIX_SUCCESS;
     }
+    if (PMIX_SUCCESS != pmix_bfrops_base_buffer_flatten(src)) {
+        PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
 
     /* extend the dest if necessary */
     to_copy = src->pack_ptr - src->unpack_ptr;
@@ -457,6 +461,19 @@ pmix_status_t pmix_bfrops_base_copy_darray(pmix_data_array_t **dest, pmix_data_a
         return PMIX_SUCCESS;
     }
 
+    m = PMIX_BFROPS_BASE_SCALAR_SIZE(src->type);
+    if (0 != m) {
+        /* elements held by value */
+        p->array = malloc(src->size * m);
+        if (NULL == p->array) {
+            free(p);
+            return PMIX_ERR_NOMEM;
+        }
+        memcpy(p->array, src->array, src->size * m);
+        *dest = p;
+        return PMIX_SUCCESS;
+    }
+
     /* process based on type of array element */
     switch (src->type) {
     case PMIX_UINT8:
@@ -870,8 +870,51 @@ void pmix_bfrops_base_darray_destruct(pmix_data_array_t *d)
     return;
 }
 
+const uint8_t pmix_bfrops_base_scalar_size[PMIX_BFROPS_BASE_SCALAR_MAX] = {
+    [PMIX_BOOL] = sizeof(bool),
+    [PMIX_BYTE] = sizeof(uint8_t),
+    [PMIX_SIZE] = sizeof(size_t),
+    [PMIX_PID] = sizeof(pid_t),
+    [PMIX_INT] = sizeof(int),
+    [PMIX_INT8] = sizeof(int8_t),
+    [PMIX_INT16] = sizeof(int16_t),
+    [PMIX_INT32] = sizeof(int32_t),
+    [PMIX_INT64] = sizeof(int64_t),
+    [PMIX_UINT] = sizeof(unsigned int),
+    [PMIX_UINT8] = sizeof(uint8_t),
+    [PMIX_UINT16] = sizeof(uint16_t),
+    [PMIX_UINT32] = sizeof(uint32_t),
+    [PMIX_UINT64] = sizeof(uint64_t),
+    [PMIX_FLOAT] = sizeof(float),
+    [PMIX_DOUBLE] = sizeof(double),
+    [PMIX_TIMEVAL] = sizeof(struct timeval),
+    [PMIX_TIME] = sizeof(time_t),
+    [PMIX_STATUS] = sizeof(pmix_status_t),
+    [PMIX_PERSIST] = sizeof(pmix_persistence_t),
+    [PMIX_SCOPE] = sizeof(pmix_scope_t),
+    [PMIX_DATA_RANGE] = sizeof(pmix_data_range_t),
+    [PMIX_PROC_STATE] = sizeof(pmix_proc_state_t),
+    [PMIX_PROC_RANK] = sizeof(pmix_rank_t),
+    [PMIX_ALLOC_DIRECTIVE] = sizeof(pmix_alloc_directive_t),
+    [PMIX_JOB_STATE] = sizeof(pmix_job_state_t),
+    [PMIX_LINK_STATE] = sizeof(pmix_link_state_t),
+    [PMIX_DEVTYPE] = sizeof(pmix_device_type_t),
+    [PMIX_LOCTYPE] = sizeof(pmix_locality_t),
+    [PMIX_STOR_MEDIUM] = sizeof(uint64_t),
+    [PMIX_STOR_ACCESS] = sizeof(uint64_t),
+    [PMIX_STOR_PERSIST] = sizeof(uint64_t),
+    [PMIX_STOR_ACCESS_TYPE] = sizeof(uint16_t)
+};
+
 void pmix_bfrops_base_value_destruct(pmix_value_t *v)
 {
+    if (0 != PMIX_BFROPS_BASE_SCALAR_SIZE(v->type)) {
+        /* nothing to release */
+        memset(v, 0, sizeof(pmix_value_t));
+        v->type = PMIX_UNDEF;
+        return;
+    }
+
     switch (v->type) {
         case PMIX_STRING:
             if (NULL != v->data.string) {
@@ -984,13 +1027,59 @@ void pmix_bfrops_base_value_destruct(pmix_value_t *v)
     return;
 }
 
+/* MOVE FUNCTIONS - transfer ownership of the contents instead of
+ * copying them, leaving the source undefined so that destructing
+ * it is a no-op. Any prior contents of the destination are NOT
+ * released */
+void pmix_bfrops_base_value_move(pmix_value_t *dest, pmix_value_t *src)
+{
+    memcpy(dest, src, sizeof(pmix_value_t));
+    memset(src, 0, sizeof(pmix_value_t));
+    src->type = PMIX_UNDEF;
+}
+
+void pmix_bfrops_base_info_move(pmix_info_t *dest, pmix_info_t *src)
+{
+    /* a persistent source does not own its value, so
+     * neither will the destination */
+    PMIX_LOAD_KEY(dest->key, src->key);
+    dest->flags = src->flags;
+    pmix_bfrops_base_value_move(&dest->value, &src->value);
+}
+
+pmix_status_t pmix_bfrops_base_info_array_grow(pmix_info_t **info, size_t *ninfo, size_t nadd)
+{
+    pmix_info_t *iptr;
+    size_t n;
+
+    PMIX_INFO_CREATE(iptr, *ninfo + nadd);
+    if (NULL == iptr) {
+        return PMIX_ERR_NOMEM;
+    }
+    if (NULL != *info) {
+        for (n = 0; n < *ninfo; n++) {
+            pmix_bfrops_base_info_move(&iptr[n], &(*info)[n]);
+        }
+        PMIX_INFO_FREE(*info, *ninfo);
+    }
+    *info = iptr;
+    *ninfo += nadd;
+    return PMIX_SUCCESS;
+}
+
 /* Xfer FUNCTIONS FOR GENERIC PMIX TYPES */
 pmix_status_t pmix_bfrops_base_value_xfer(pmix_value_t *p, const pmix_value_t *src)
 {
     pmix_status_t rc;
 
-    /* copy the right field */
     p->type = src->type;
+    if (0 != PMIX_BFROPS_BASE_SCALAR_SIZE(src->type)) {
+        /* held by value - copying the union avoids the switch */
+        p->data = src->data;
+        return PMIX_SUCCESS;
+    }
+
+    /* copy the right field */
     switch (src->type) {
     case PMIX_UNDEF:
         break;
@@ -1205,7 +1294,14 @@ char *pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
 
     required = buffer->bytes_used + bytes_to_add;
     if (required >= pmix_bfrops_globals.threshold_size) {
-        to_alloc = ((required + pmix_bfrops_globals.threshold_size - 1)
+        /* grow by at least half of what we have, so packing a
+         * large payload a piece at a time costs a bounded number
+         * of reallocs instead of one per threshold_size */
+        to_alloc = buffer->bytes_allocated + (buffer->bytes_allocated >> 1);
+        if (to_alloc < required) {
+            to_alloc = required;
+        }
+        to_alloc = ((to_alloc + pmix_bfrops_globals.threshold_size - 1)
                     / pmix_bfrops_globals.threshold_size)
                    * pmix_bfrops_globals.threshold_size;
     } else {
@@ -1242,6 +1338,279 @@ char *pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
     return buffer->pack_ptr;
 }
 
+pmix_status_t pmix_bfrops_base_buffer_reserve(pmix_buffer_t *buffer, size_t bytes)
+{
+    if (NULL == pmix_bfrop_buffer_extend(buffer, bytes)) {
+        return PMIX_ERR_NOMEM;
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_bfrops_base_buffer_feed(pmix_buffer_t *buffer, const char *bytes, size_t size)
+{
+    size_t done, pending;
+    char *dst;
+
+    if (NULL != buffer->base_ptr && buffer->unpack_ptr > buffer->base_ptr) {
+        done = buffer->unpack_ptr - buffer->base_ptr;
+        pending = buffer->bytes_used - done;
+        if (0 < pending) {
+            memmove(buffer->base_ptr, buffer->unpack_ptr, pending);
+        }
+        buffer->bytes_used = pending;
+        buffer->unpack_ptr = buffer->base_ptr;
+        buffer->pack_ptr = buffer->base_ptr + pending;
+    }
+    if (0 == size) {
+        return PMIX_SUCCESS;
+    }
+    dst = pmix_bfrop_buffer_extend(buffer, size);
+    if (NULL == dst) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(dst, bytes, size);
+    buffer->pack_ptr += size;
+    buffer->bytes_used += size;
+    return PMIX_SUCCESS;
+}
+
+/* what a string costs in a fully-described buffer: the type,
+ * the int32 length and the bytes including the NULL */
+static inline size_t string_size_estimate(const char *s)
+{
+    return sizeof(pmix_data_type_t) + sizeof(int32_t) + ((NULL == s) ? 0 : strlen(s) + 1);
+}
+
+/* anything we don't walk into - structures of a few fields */
+#define PMIX_BFROPS_BASE_OTHER_ESTIMATE 64
+
+static size_t darray_size_estimate(const pmix_data_array_t *d)
+{
+    size_t n, sz, elem;
+    char **s;
+    pmix_byte_object_t *bo;
+    pmix_value_t *v;
+
+    /* the type of the array, the type of its elements and the count */
+    sz = 2 * sizeof(pmix_data_type_t) + sizeof(size_t);
+    if (NULL == d || NULL == d->array || 0 == d->size) {
+        return sz;
+    }
+    switch (d->type) {
+    case PMIX_INFO:
+        return sz + pmix_bfrops_base_info_size_estimate((pmix_info_t *) d->array, d->size);
+    case PMIX_VALUE:
+        v = (pmix_value_t *) d->array;
+        for (n = 0; n < d->size; n++) {
+            sz += pmix_bfrops_base_value_size_estimate(&v[n]);
+        }
+        return sz;
+    case PMIX_STRING:
+        s = (char **) d->array;
+        for (n = 0; n < d->size; n++) {
+            sz += string_size_estimate(s[n]);
+        }
+        return sz;
+    case PMIX_BYTE_OBJECT:
+    case PMIX_COMPRESSED_BYTE_OBJECT:
+        bo = (pmix_byte_object_t *) d->array;
+        for (n = 0; n < d->size; n++) {
+            sz += sizeof(size_t) + bo[n].size;
+        }
+        return sz;
+    case PMIX_PROC:
+        return sz + d->size * (string_size_estimate(NULL) + PMIX_MAX_NSLEN + sizeof(pmix_rank_t));
+    default:
+        elem = PMIX_BFROPS_BASE_SCALAR_SIZE(d->type);
+        if (0 == elem) {
+            elem = PMIX_BFROPS_BASE_OTHER_ESTIMATE;
+        }
+        return sz + d->size * elem;
+    }
+}
+
+size_t pmix_bfrops_base_value_size_estimate(const pmix_value_t *v)
+{
+    size_t sz;
+
+    /* the type of the value */
+    sz = sizeof(pmix_data_type_t);
+    switch (v->type) {
+    case PMIX_UNDEF:
+        return sz;
+    case PMIX_STRING:
+        return sz + string_size_estimate(v->data.string);
+    case PMIX_BYTE_OBJECT:
+    case PMIX_COMPRESSED_STRING:
+    case PMIX_COMPRESSED_BYTE_OBJECT:
+    case PMIX_REGEX:
+        return sz + sizeof(size_t) + v->data.bo.size;
+    case PMIX_PROC:
+        return sz + string_size_estimate(NULL) + PMIX_MAX_NSLEN + sizeof(pmix_rank_t);
+    case PMIX_DATA_ARRAY:
+        return sz + darray_size_estimate(v->data.darray);
+    default:
+        if (0 < PMIX_BFROPS_BASE_SCALAR_SIZE(v->type)) {
+            return sz + PMIX_BFROPS_BASE_SCALAR_SIZE(v->type);
+        }
+        return sz + PMIX_BFROPS_BASE_OTHER_ESTIMATE;
+    }
+}
+
+size_t pmix_bfrops_base_info_size_estimate(const pmix_info_t *info, size_t ninfo)
+{
+    size_t n, sz = 0;
+
+    for (n = 0; n < ninfo; n++) {
+        /* the key, the directives and the value */
+        sz += string_size_estimate(info[n].key) + sizeof(pmix_info_directives_t)
+              + pmix_bfrops_base_value_size_estimate(&info[n].value);
+    }
+    return sz;
+}
+
+/* close out what has been packed so far as a segment of its own,
+ * so that whatever is chained next follows it */
+static pmix_status_t seal_buffer(pmix_buffer_t *buffer)
+{
+    pmix_buffer_segment_t *seg;
+
+    if (NULL == buffer->base_ptr) {
+        return PMIX_SUCCESS;
+    }
+    if (0 == buffer->bytes_used) {
+        free(buffer->base_ptr);
+    } else {
+        seg = PMIX_NEW(pmix_buffer_segment_t);
+        if (NULL == seg) {
+            return PMIX_ERR_NOMEM;
+        }
+        seg->bytes = buffer->base_ptr;
+        seg->size = buffer->bytes_used;
+        pmix_list_append(buffer->chain, &seg->super);
+        buffer->chain_bytes += seg->size;
+    }
+    buffer->base_ptr = NULL;
+    buffer->pack_ptr = NULL;
+    buffer->unpack_ptr = NULL;
+    buffer->bytes_allocated = 0;
+    buffer->bytes_used = 0;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_bfrops_base_buffer_chain(pmix_buffer_t *buffer, char *bytes, size_t size,
+                                            pmix_release_cbfunc_t release, void *cbdata)
+{
+    pmix_buffer_segment_t *seg;
+    pmix_status_t rc;
+
+    seg = PMIX_NEW(pmix_buffer_segment_t);
+    if (NULL == seg) {
+        if (NULL != release) {
+            release(cbdata);
+        } else {
+            free(bytes);
+        }
+        return PMIX_ERR_NOMEM;
+    }
+    seg->bytes = bytes;
+    seg->size = size;
+    seg->release = release;
+    seg->cbdata = cbdata;
+    if (0 == size) {
+        PMIX_RELEASE(seg);
+        return PMIX_SUCCESS;
+    }
+
+    if (NULL == buffer->chain) {
+        buffer->chain = PMIX_NEW(pmix_list_t);
+        if (NULL == buffer->chain) {
+            PMIX_RELEASE(seg);
+            return PMIX_ERR_NOMEM;
+        }
+    }
+    rc = seal_buffer(buffer);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(seg);
+        return rc;
+    }
+    pmix_list_append(buffer->chain, &seg->super);
+    buffer->chain_bytes += size;
+    return PMIX_SUCCESS;
+}
+
+int pmix_bfrops_base_buffer_iov(pmix_buffer_t *buffer, size_t offset, struct iovec *iov,
+                                int maxiov, size_t *nbytes)
+{
+    pmix_buffer_segment_t *seg;
+    int n = 0;
+
+    *nbytes = 0;
+    if (NULL != buffer->chain) {
+        PMIX_LIST_FOREACH (seg, buffer->chain, pmix_buffer_segment_t) {
+            if (offset >= seg->size) {
+                offset -= seg->size;
+                continue;
+            }
+            if (n == maxiov) {
+                return n;
+            }
+            iov[n].iov_base = seg->bytes + offset;
+            iov[n].iov_len = seg->size - offset;
+            *nbytes += iov[n].iov_len;
+            ++n;
+            offset = 0;
+        }
+    }
+    if (offset < buffer->bytes_used && n < maxiov) {
+        iov[n].iov_base = buffer->base_ptr + offset;
+        iov[n].iov_len = buffer->bytes_used - offset;
+        *nbytes += iov[n].iov_len;
+        ++n;
+    }
+    return n;
+}
+
+pmix_status_t pmix_bfrops_base_buffer_flatten(pmix_buffer_t *buffer)
+{
+    pmix_buffer_segment_t *seg;
+    size_t total;
+    char *ptr, *dst;
+
+    if (NULL == buffer->chain) {
+        return PMIX_SUCCESS;
+    }
+    total = PMIX_BUFFER_TOTAL_BYTES(buffer);
+    if (0 < total) {
+        ptr = (char *) malloc(total);
+        if (NULL == ptr) {
+            return PMIX_ERR_NOMEM;
+        }
+        dst = ptr;
+        PMIX_LIST_FOREACH (seg, buffer->chain, pmix_buffer_segment_t) {
+            memcpy(dst, seg->bytes, seg->size);
+            dst += seg->size;
+        }
+        if (0 < buffer->bytes_used) {
+            memcpy(dst, buffer->base_ptr, buffer->bytes_used);
+        }
+    } else {
+        ptr = NULL;
+    }
+    PMIX_LIST_RELEASE(buffer->chain);
+    buffer->chain = NULL;
+    buffer->chain_bytes = 0;
+    if (NULL != buffer->base_ptr) {
+        free(buffer->base_ptr);
+    }
+    buffer->base_ptr = ptr;
+    buffer->pack_ptr = (NULL == ptr) ? NULL : ptr + total;
+    buffer->unpack_ptr = ptr;
+    buffer->bytes_allocated = total;
+    buffer->bytes_used = total;
+    return PMIX_SUCCESS;
+}
+
 /*
  * Internal function that checks to see if the specified number of bytes
  * remain in the buffer for unpacking
@@ -1297,11 +1666,64 @@ const char *pmix_bfrops_base_data_type_string(pmix_pointer_array_t *regtypes, pm
     return info->odti_name;
 }
 
+/* The handle given out by PMIx_Info_list_start is an arena: entries
+ * are appended to a single array that grows by doubling, and that
+ * PMIx_Info_list_convert hands over as it is instead of copying it
+ * element by element. Internal callers may also pass their own
+ * pmix_list_t of pmix_infolist_t, which is still accepted */
+typedef struct {
+    pmix_object_t super;
+    pmix_info_t *array;
+    size_t size;
+    size_t alloc;
+} pmix_info_arena_t;
+static void iacon(pmix_info_arena_t *p)
+{
+    p->array = NULL;
+    p->size = 0;
+    p->alloc = 0;
+}
+static void iades(pmix_info_arena_t *p)
+{
+    size_t n;
+
+    for (n = 0; n < p->size; n++) {
+        PMIX_INFO_DESTRUCT(&p->array[n]);
+    }
+    if (NULL != p->array) {
+        pmix_free(p->array);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_info_arena_t, pmix_object_t, iacon, iades);
+
+#define PMIX_INFO_IS_ARENA(p) \
+    (PMIX_CLASS(pmix_info_arena_t) == ((pmix_object_t *) (p))->obj_class)
+
+/* reserve the next entry of an arena */
+static pmix_info_t *arena_next(pmix_info_arena_t *ar)
+{
+    pmix_info_t *tmp;
+    size_t alloc;
+
+    if (ar->size == ar->alloc) {
+        alloc = (0 == ar->alloc) ? 8 : 2 * ar->alloc;
+        tmp = (pmix_info_t *) realloc(ar->array, alloc * sizeof(pmix_info_t));
+        if (NULL == tmp) {
+            return NULL;
+        }
+        ar->array = tmp;
+        ar->alloc = alloc;
+    }
+    tmp = &ar->array[ar->size];
+    memset(tmp, 0, sizeof(pmix_info_t));
+    return tmp;
+}
+
 PMIX_EXPORT void *PMIx_Info_list_start(void)
 {
-    pmix_list_t *p;
+    pmix_info_arena_t *p;
 
-    p = PMIX_NEW(pmix_list_t);
+    p = PMIX_NEW(pmix_info_arena_t);
     return p;
 }
 
@@ -1312,6 +1734,24 @@ PMIX_EXPORT pmix_status_t PMIx_Info_list_add(void *ptr,
 {
     pmix_list_t *p = (pmix_list_t *) ptr;
     pmix_infolist_t *iptr;
+    pmix_info_arena_t *ar;
+    pmix_info_t *info;
+    pmix_status_t rc;
+
+    if (PMIX_INFO_IS_ARENA(ptr)) {
+        ar = (pmix_info_arena_t *) ptr;
+        info = arena_next(ar);
+        if (NULL == info) {
+            return PMIX_ERR_NOMEM;
+        }
+        rc = PMIx_Info_load(info, key, value, type);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_VALUE_DESTRUCT(&info->value);
+            return rc;
+        }
+        ++ar->size;
+        return PMIX_SUCCESS;
+    }
 
     iptr = PMIX_NEW(pmix_infolist_t);
     if (NULL == iptr) {
@@ -1327,6 +1767,20 @@ PMIX_EXPORT pmix_status_t PMIx_Info_list_insert(void *ptr,
 {
     pmix_list_t *p = (pmix_list_t *) ptr;
     pmix_infolist_t *iptr;
+    pmix_info_arena_t *ar;
+    pmix_info_t *dest;
+
+    if (PMIX_INFO_IS_ARENA(ptr)) {
+        ar = (pmix_info_arena_t *) ptr;
+        dest = arena_next(ar);
+        if (NULL == dest) {
+            return PMIX_ERR_NOMEM;
+        }
+        memcpy(dest, info, sizeof(pmix_info_t));
+        PMIX_INFO_SET_PERSISTENT(dest);
+        ++ar->size;
+        return PMIX_SUCCESS;
+    }
 
     iptr = PMIX_NEW(pmix_infolist_t);
     if (NULL == iptr) {
@@ -1346,6 +1800,24 @@ PMIX_EXPORT pmix_status_t PMIx_Info_list_xfer(void *ptr, const pmix_info_t *info
 {
     pmix_list_t *p = (pmix_list_t *) ptr;
     pmix_infolist_t *iptr;
+    pmix_info_arena_t *ar;
+    pmix_info_t *dest;
+    pmix_status_t rc;
+
+    if (PMIX_INFO_IS_ARENA(ptr)) {
+        ar = (pmix_info_arena_t *) ptr;
+        dest = arena_next(ar);
+        if (NULL == dest) {
+            return PMIX_ERR_NOMEM;
+        }
+        rc = PMIx_Info_xfer(dest, info);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_INFO_DESTRUCT(dest);
+            return rc;
+        }
+        ++ar->size;
+        return PMIX_SUCCESS;
+    }
 
     iptr = PMIX_NEW(pmix_infolist_t);
     if (NULL == iptr) {
@@ -1362,12 +1834,29 @@ PMIX_EXPORT pmix_status_t PMIx_Info_list_convert(void *ptr, pmix_data_array_t *p
     size_t n;
     pmix_infolist_t *iptr;
     pmix_info_t *array;
+    pmix_info_arena_t *ar;
 
     if (NULL == par || NULL == ptr) {
         return PMIX_ERR_BAD_PARAM;
     }
     PMIX_DATA_ARRAY_INIT(par, PMIX_INFO);
 
+    if (PMIX_INFO_IS_ARENA(ptr)) {
+        ar = (pmix_info_arena_t *) ptr;
+        if (0 == ar->size) {
+            return PMIX_ERR_EMPTY;
+        }
+        /* hand the array over - the arena starts afresh */
+        ar->array[ar->size - 1].flags |= PMIX_INFO_ARRAY_END;
+        par->type = PMIX_INFO;
+        par->array = ar->array;
+        par->size = ar->size;
+        ar->array = NULL;
+        ar->size = 0;
+        ar->alloc = 0;
+        return PMIX_SUCCESS;
+    }
+
     n = pmix_list_get_size(p);
     if (0 == n) {
         return PMIX_ERR_EMPTY;
@@ -1393,5 +1882,12 @@ PMIX_EXPORT pmix_status_t PMIx_Info_list_convert(void *ptr, pmix_data_array_t *p
 PMIX_EXPORT void PMIx_Info_list_release(void *ptr)
 {
     pmix_list_t *p = (pmix_list_t *) ptr;
+    pmix_info_arena_t *ar;
+
+    if (PMIX_INFO_IS_ARENA(ptr)) {
+        ar = (pmix_info_arena_t *) ptr;
+        PMIX_RELEASE(ar);
+        return;
+    }
     PMIX_LIST_RELEASE(p);
 }
@@ -60,6 +60,9 @@ pmix_bfrops_globals_t pmix_bfrops_globals = {
 #endif
 };
 int pmix_bfrops_base_output = 0;
+pmix_bfrops_module_t *pmix_bfrops_base_native = NULL;
+pmix_pointer_array_t *pmix_bfrops_base_native_types = NULL;
+pmix_bfrops_jump_table_t pmix_bfrops_base_jump_table = {{NULL}, {NULL}};
 
 static int pmix_bfrop_register(pmix_mca_base_register_flag_t flags)
 {
@@ -98,6 +101,9 @@ static pmix_status_t pmix_bfrop_close(void)
     }
     pmix_bfrops_globals.initialized = false;
     pmix_bfrops_globals.selected = false;
+    pmix_bfrops_base_native = NULL;
+    pmix_bfrops_base_native_types = NULL;
+    memset(&pmix_bfrops_base_jump_table, 0, sizeof(pmix_bfrops_base_jump_table));
 
     /* the components will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_bfrops_globals.actives);
@@ -145,6 +151,9 @@ static void pmix_buffer_construct(pmix_buffer_t *buffer)
     /* Make everything NULL to begin with */
     buffer->base_ptr = buffer->pack_ptr = buffer->unpack_ptr = NULL;
     buffer->bytes_allocated = buffer->bytes_used = 0;
+    buffer->borrow = false;
+    buffer->chain = NULL;
+    buffer->chain_bytes = 0;
 }
 
 static void pmix_buffer_destruct(pmix_buffer_t *buffer)
@@ -152,10 +161,30 @@ static void pmix_buffer_destruct(pmix_buffer_t *buffer)
     if (NULL != buffer->base_ptr) {
         free(buffer->base_ptr);
     }
+    if (NULL != buffer->chain) {
+        PMIX_LIST_RELEASE(buffer->chain);
+    }
 }
 
 PMIX_CLASS_INSTANCE(pmix_buffer_t, pmix_object_t, pmix_buffer_construct, pmix_buffer_destruct);
 
+static void segcon(pmix_buffer_segment_t *p)
+{
+    p->bytes = NULL;
+    p->size = 0;
+    p->release = NULL;
+    p->cbdata = NULL;
+}
+static void segdes(pmix_buffer_segment_t *p)
+{
+    if (NULL != p->release) {
+        p->release(p->cbdata);
+    } else if (NULL != p->bytes) {
+        free(p->bytes);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_buffer_segment_t, pmix_list_item_t, segcon, segdes);
+
 static void pmix_bfrop_type_info_construct(pmix_bfrop_type_info_t *obj)
 {
     obj->odti_name = NULL;
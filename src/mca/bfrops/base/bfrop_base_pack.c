@@ -81,6 +81,71 @@ pmix_status_t pmix_bfrops_base_pack_buffer(pmix_pointer_array_t *regtypes, pmix_
     return rc;
 }
 
+pmix_status_t pmix_bfrops_base_chain_payload(pmix_pointer_array_t *regtypes, pmix_buffer_t *dest,
+                                             pmix_buffer_t *src)
+{
+    pmix_buffer_segment_t *seg;
+    pmix_status_t rc;
+    size_t size;
+    int32_t n = 1;
+
+    if (NULL == dest || NULL == src) {
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* the same header pmix_bfrops_base_pack and pack_bo would
+     * produce for a single byte object */
+    size = PMIX_BUFFER_TOTAL_BYTES(src);
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == dest->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(regtypes, dest, PMIX_INT32))) {
+            return rc;
+        }
+    }
+    PMIX_BFROPS_PACK_TYPE(rc, dest, &n, 1, PMIX_INT32, regtypes);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == dest->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(regtypes, dest, PMIX_BYTE_OBJECT))) {
+            return rc;
+        }
+    }
+    PMIX_BFROPS_PACK_TYPE(rc, dest, &size, 1, PMIX_SIZE, regtypes);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* now move the payload over - the chain of the source first,
+     * then its own memory */
+    if (NULL != src->chain) {
+        while (NULL != (seg = (pmix_buffer_segment_t *) pmix_list_remove_first(src->chain))) {
+            src->chain_bytes -= seg->size;
+            rc = pmix_bfrops_base_buffer_chain(dest, seg->bytes, seg->size, seg->release,
+                                               seg->cbdata);
+            /* the memory now belongs to dest */
+            seg->release = NULL;
+            seg->bytes = NULL;
+            PMIX_RELEASE(seg);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+        }
+    }
+    if (0 < src->bytes_used) {
+        rc = pmix_bfrops_base_buffer_chain(dest, src->base_ptr, src->bytes_used, NULL, NULL);
+        src->base_ptr = NULL;
+        src->pack_ptr = NULL;
+        src->unpack_ptr = NULL;
+        src->bytes_allocated = 0;
+        src->bytes_used = 0;
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
 /* PACK FUNCTIONS FOR GENERIC SYSTEM TYPES */
 
 /*
@@ -1417,6 +1482,10 @@ pmix_status_t pmix_bfrops_base_pack_pstats(pmix_pointer_array_t *regtypes, pmix_
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
+        PMIX_BFROPS_PACK_TYPE(ret, buffer, &ptr[i].peak_vsize, 1, PMIX_FLOAT, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
         PMIX_BFROPS_PACK_TYPE(ret, buffer, &ptr[i].processor, 1, PMIX_INT16, regtypes);
         if (PMIX_SUCCESS != ret) {
             return ret;
@@ -1611,7 +1680,7 @@ pmix_status_t pmix_bfrops_base_pack_ndstats(pmix_pointer_array_t *regtypes, pmix
             return ret;
         }
         if (0 < ptr[i].ndiskstats) {
-            PMIX_BFROPS_PACK_TYPE(ret, buffer, &ptr[i].diskstats, ptr[i].ndiskstats,
+            PMIX_BFROPS_PACK_TYPE(ret, buffer, ptr[i].diskstats, ptr[i].ndiskstats,
                                   PMIX_DISK_STATS, regtypes);
             if (PMIX_SUCCESS != ret) {
                 return ret;
@@ -1622,7 +1691,7 @@ pmix_status_t pmix_bfrops_base_pack_ndstats(pmix_pointer_array_t *regtypes, pmix
             return ret;
         }
         if (0 < ptr[i].nnetstats) {
-            PMIX_BFROPS_PACK_TYPE(ret, buffer, &ptr[i].netstats, ptr[i].nnetstats, PMIX_NET_STATS,
+            PMIX_BFROPS_PACK_TYPE(ret, buffer, ptr[i].netstats, ptr[i].nnetstats, PMIX_NET_STATS,
                                   regtypes);
             if (PMIX_SUCCESS != ret) {
                 return ret;
@@ -41,7 +41,8 @@ int pmix_bfrop_base_select(void)
     pmix_mca_base_module_t *module = NULL;
     pmix_bfrops_module_t *nmodule;
     pmix_bfrops_base_active_module_t *newmodule, *mod;
-    int rc, priority;
+    pmix_bfrop_type_info_t *info;
+    int rc, priority, n;
     bool inserted;
 
     if (pmix_bfrops_globals.selected) {
@@ -121,6 +122,22 @@ int pmix_bfrop_base_select(void)
         return PMIX_ERR_SILENT;
     }
 
+    /* peers that negotiate the highest priority module - normally all
+     * of them - can be dispatched directly if its component allows */
+    mod = (pmix_bfrops_base_active_module_t *) pmix_list_get_first(&pmix_bfrops_globals.actives);
+    if (mod->component->base_dispatch) {
+        for (n = 0; n < PMIX_BFROP_JUMP_TABLE_SIZE && n < mod->component->types.size; n++) {
+            info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item(&mod->component->types,
+                                                                          n);
+            if (NULL != info) {
+                pmix_bfrops_base_jump_table.pack[n] = info->odti_pack_fn;
+                pmix_bfrops_base_jump_table.unpack[n] = info->odti_unpack_fn;
+            }
+        }
+        pmix_bfrops_base_native_types = &mod->component->types;
+        pmix_bfrops_base_native = mod->module;
+    }
+
     if (4 < pmix_output_get_verbosity(pmix_bfrops_base_framework.framework_output)) {
         pmix_output(0, "Final Bfrop priorities");
         /* show the prioritized list */
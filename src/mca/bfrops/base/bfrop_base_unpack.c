@@ -410,6 +410,17 @@ pmix_status_t pmix_bfrops_base_unpack_string(pmix_pointer_array_t *regtypes, pmi
         }
         if (0 == len) { /* zero-length string - unpack the NULL */
             sdest[i] = NULL;
+        } else if (buffer->borrow) {
+            /* point at the string in the buffer - the NULL
+             * terminator is included, but check it is there */
+            if (0 > len || pmix_bfrop_too_small(buffer, len)) {
+                return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+            }
+            if ('\0' != buffer->unpack_ptr[len - 1]) {
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
+            sdest[i] = buffer->unpack_ptr;
+            buffer->unpack_ptr += len;
         } else {
             sdest[i] = (char *) malloc(len); // NULL terminator is included
             if (NULL == sdest[i]) {
@@ -1096,7 +1107,15 @@ pmix_status_t pmix_bfrops_base_unpack_bo(pmix_pointer_array_t *regtypes, pmix_bu
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
-        if (0 < ptr[i].size) {
+        if (0 < ptr[i].size && buffer->borrow) {
+            /* point at the bytes in the buffer */
+            if (pmix_bfrop_too_small(buffer, ptr[i].size)) {
+                ptr[i].size = 0;
+                return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+            }
+            ptr[i].bytes = buffer->unpack_ptr;
+            buffer->unpack_ptr += ptr[i].size;
+        } else if (0 < ptr[i].size) {
             ptr[i].bytes = (char *) malloc(ptr[i].size * sizeof(char));
             m = ptr[i].size;
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].bytes, &m, PMIX_BYTE, regtypes);
@@ -2194,7 +2213,7 @@ pmix_status_t pmix_bfrops_base_unpack_ndstats(pmix_pointer_array_t *regtypes, pm
         if (0 < ptr[i].ndiskstats) {
             m = ptr[i].ndiskstats;
             PMIX_DISK_STATS_CREATE(ptr[i].diskstats, ptr[i].ndiskstats);
-            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].diskstats, &m, PMIX_DISK_STATS, regtypes);
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].diskstats, &m, PMIX_DISK_STATS, regtypes);
             if (PMIX_SUCCESS != ret) {
                 PMIX_DISK_STATS_FREE(ptr[i].diskstats, ptr[i].ndiskstats);
                 PMIX_ERROR_LOG(ret);
@@ -2210,7 +2229,7 @@ pmix_status_t pmix_bfrops_base_unpack_ndstats(pmix_pointer_array_t *regtypes, pm
         if (0 < ptr[i].nnetstats) {
             m = ptr[i].nnetstats;
             PMIX_NET_STATS_CREATE(ptr[i].netstats, ptr[i].nnetstats);
-            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].netstats, &m, PMIX_NET_STATS, regtypes);
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].netstats, &m, PMIX_NET_STATS, regtypes);
             if (PMIX_SUCCESS != ret) {
                 PMIX_NET_STATS_FREE(ptr[i].netstats, ptr[i].nnetstats);
                 PMIX_ERROR_LOG(ret);
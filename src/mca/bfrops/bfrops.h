@@ -267,6 +267,16 @@ typedef pmix_status_t (*pmix_bfrop_unpack_fn_t)(pmix_buffer_t *buffer, void *des
  */
 typedef pmix_status_t (*pmix_bfrop_copy_payload_fn_t)(pmix_buffer_t *dest, pmix_buffer_t *src);
 
+/**
+ * Pack the payload of one buffer into another as a byte object,
+ * moving it instead of copying it. The result is the same as
+ * unloading the source buffer and packing the blob as a
+ * PMIX_BYTE_OBJECT, but the memory is chained onto the destination
+ * buffer (see pmix_bfrops_base_buffer_chain). The source buffer
+ * is left empty.
+ */
+typedef pmix_status_t (*pmix_bfrop_chain_payload_fn_t)(pmix_buffer_t *dest, pmix_buffer_t *src);
+
 /**
  * Copy a data value from one location to another.
  *
@@ -359,6 +369,7 @@ typedef struct {
     pmix_bfrop_value_unload_fn_t value_unload;
     pmix_bfrop_value_cmp_fn_t value_cmp;
     pmix_bfrop_data_type_string_fn_t data_type_string;
+    pmix_bfrop_chain_payload_fn_t chain_payload;
 } pmix_bfrops_module_t;
 
 /* get a list of available versions - caller must free results
@@ -371,6 +382,24 @@ PMIX_EXPORT pmix_bfrops_module_t *pmix_bfrops_base_assign_module(const char *ver
 /* provide a backdoor to access the framework debug output */
 PMIX_EXPORT extern int pmix_bfrops_base_output;
 
+/* the module of the highest priority component and its registered
+ * types - set only when that component packs and unpacks through the
+ * base functions. Peers that negotiated our own version are then
+ * dispatched straight to the base instead of through their module */
+PMIX_EXPORT extern pmix_bfrops_module_t *pmix_bfrops_base_native;
+PMIX_EXPORT extern pmix_pointer_array_t *pmix_bfrops_base_native_types;
+
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack(pmix_pointer_array_t *regtypes,
+                                                pmix_buffer_t *buffer, const void *src,
+                                                int num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, void *dst,
+                                                  int32_t *num_vals, pmix_data_type_t type);
+
+/* copy any chained segments of the buffer into a single
+ * contiguous payload */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_buffer_flatten(pmix_buffer_t *buffer);
+
 /* MACROS FOR EXECUTING BFROPS FUNCTIONS */
 #define PMIX_BFROPS_ASSIGN_TYPE(p, b) (b)->type = (p)->nptr->compat.type
 
@@ -381,11 +410,13 @@ PMIX_EXPORT extern int pmix_bfrops_base_output;
                             PMIx_Data_type_string(t));                                      \
         if (PMIX_BFROP_BUFFER_UNDEF == (b)->type) {                                          \
             (b)->type = (p)->nptr->compat.type;                                              \
-            (r) = (p)->nptr->compat.bfrops->pack(b, s, n, t);                                \
-        } else if ((b)->type == (p)->nptr->compat.type) {                                    \
-            (r) = (p)->nptr->compat.bfrops->pack(b, s, n, t);                                \
-        } else {                                                                             \
+        }                                                                                    \
+        if ((b)->type != (p)->nptr->compat.type) {                                           \
             (r) = PMIX_ERR_PACK_MISMATCH;                                                    \
+        } else if (PMIX_LIKELY((p)->nptr->compat.bfrops == pmix_bfrops_base_native)) {      \
+            (r) = pmix_bfrops_base_pack(pmix_bfrops_base_native_types, b, s, n, t);          \
+        } else {                                                                             \
+            (r) = (p)->nptr->compat.bfrops->pack(b, s, n, t);                                \
         }                                                                                    \
     } while (0)
 
@@ -394,13 +425,37 @@ PMIX_EXPORT extern int pmix_bfrops_base_output;
         pmix_output_verbose(2, pmix_bfrops_base_output, "[%s:%d] UNPACK version %s type %s",   \
                             __FILE__, __LINE__, (p)->nptr->compat.bfrops->version,             \
                             PMIx_Data_type_string(t));                                         \
-        if ((b)->type == (p)->nptr->compat.type) {                                             \
-            (r) = (p)->nptr->compat.bfrops->unpack(b, d, m, t);                                \
-        } else {                                                                               \
+        if ((b)->type != (p)->nptr->compat.type) {                                             \
             (r) = PMIX_ERR_UNPACK_FAILURE;                                                     \
+        } else if (PMIX_LIKELY((p)->nptr->compat.bfrops == pmix_bfrops_base_native)) {        \
+            (r) = pmix_bfrops_base_unpack(pmix_bfrops_base_native_types, b, d, m, t);          \
+        } else {                                                                               \
+            (r) = (p)->nptr->compat.bfrops->unpack(b, d, m, t);                                \
         }                                                                                      \
     } while (0)
 
+/* Unpack strings or byte objects as views of the buffer memory
+ * instead of copies. The views are only valid as long as the buffer
+ * holds its payload - retain the buffer object to keep them longer.
+ * Only the base unpack functions honor this, so components that
+ * have their own still return copies: release the result with
+ * PMIX_BFROPS_VIEW_FREE, which only frees memory that does not
+ * belong to the buffer */
+#define PMIX_BFROPS_UNPACK_VIEW(r, p, b, d, m, t)   \
+    do {                                            \
+        (b)->borrow = true;                         \
+        PMIX_BFROPS_UNPACK(r, p, b, d, m, t);       \
+        (b)->borrow = false;                        \
+    } while (0)
+
+#define PMIX_BFROPS_VIEW_FREE(b, d)                         \
+    do {                                                    \
+        if (NULL != (d) && !PMIX_BUFFER_CONTAINS(b, d)) {   \
+            free(d);                                        \
+        }                                                   \
+        (d) = NULL;                                         \
+    } while (0)
+
 #define PMIX_BFROPS_COPY(r, p, d, s, t) (r) = (p)->nptr->compat.bfrops->copy(d, s, t)
 
 #define PMIX_BFROPS_PRINT(r, p, o, pr, s, t) (r) = (p)->nptr->compat.bfrops->print(o, pr, s, t)
@@ -417,6 +472,24 @@ PMIX_EXPORT extern int pmix_bfrops_base_output;
         }                                                       \
     } while (0)
 
+/* modules that cannot chain fall back to copying the payload */
+#define PMIX_BFROPS_CHAIN_PAYLOAD(r, p, d, s)                                    \
+    do {                                                                         \
+        pmix_byte_object_t _bo;                                                  \
+        if (PMIX_BFROP_BUFFER_UNDEF == (d)->type) {                              \
+            (d)->type = (p)->nptr->compat.type;                                  \
+        }                                                                        \
+        if ((d)->type != (p)->nptr->compat.type) {                               \
+            (r) = PMIX_ERR_PACK_MISMATCH;                                        \
+        } else if (NULL != (p)->nptr->compat.bfrops->chain_payload) {            \
+            (r) = (p)->nptr->compat.bfrops->chain_payload(d, s);                 \
+        } else if (PMIX_SUCCESS == ((r) = pmix_bfrops_base_buffer_flatten(s))) { \
+            PMIX_UNLOAD_BUFFER(s, _bo.bytes, _bo.size);                          \
+            (r) = (p)->nptr->compat.bfrops->pack(d, &_bo, 1, PMIX_BYTE_OBJECT);  \
+            PMIX_BYTE_OBJECT_DESTRUCT(&_bo);                                     \
+        }                                                                        \
+    } while (0)
+
 #define PMIX_BFROPS_VALUE_XFER(r, p, d, s) (r) = (p)->nptr->compat.bfrops->value_xfer(d, s)
 
 #define PMIX_BFROPS_VALUE_LOAD(p, v, d, t) (p)->nptr->compat.bfrops->value_load(v, d, t)
@@ -444,6 +517,9 @@ struct pmix_bfrops_base_component_t {
     int priority;
     pmix_pointer_array_t types;
     pmix_bfrop_base_component_assign_module_fn_t assign_module;
+    /* true if the module's pack and unpack only pass the types
+     * to the base functions, and so can be bypassed */
+    bool base_dispatch;
 };
 typedef struct pmix_bfrops_base_component_t pmix_bfrops_base_component_t;
 
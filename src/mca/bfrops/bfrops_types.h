@@ -86,6 +86,20 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_kval_t);
         }                                                               \
     } while (0)
 
+/**
+ * A segment of a chained buffer - memory that is sent as part of
+ * the buffer without being copied into it. Once the buffer is done
+ * with it, the release function is called or, if there is none,
+ * the memory is free'd */
+typedef struct {
+    pmix_list_item_t super;
+    char *bytes;
+    size_t size;
+    pmix_release_cbfunc_t release;
+    void *cbdata;
+} pmix_buffer_segment_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_segment_t);
+
 /**
  * Structure for holding a buffer */
 typedef struct {
@@ -107,6 +121,17 @@ typedef struct {
     /** Number of bytes used by the buffer (i.e., amount of data --
         including overhead -- packed in the buffer) */
     size_t bytes_used;
+    /** Strings and byte objects are unpacked as views of the
+        buffer memory instead of copies - see PMIX_BFROPS_UNPACK_VIEW */
+    bool borrow;
+    /** Segments that precede the memory at base_ptr in the payload -
+        NULL unless something was chained onto the buffer with
+        pmix_bfrops_base_buffer_chain. A chained buffer can only be
+        packed into and sent - it must be flattened before it is
+        unpacked or unloaded */
+    pmix_list_t *chain;
+    /** Number of bytes held in the chain */
+    size_t chain_bytes;
 } pmix_buffer_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_t);
 
@@ -172,9 +197,20 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_t);
         (b)->unpack_ptr = NULL;         \
     } while (0)
 
+/* Convenience macro to check if memory lies within the payload
+ * of a buffer - e.g., if it is a view returned by
+ * PMIX_BFROPS_UNPACK_VIEW */
+#define PMIX_BUFFER_CONTAINS(b, p)                                   \
+    (NULL != (b)->base_ptr && (char *) (p) >= (b)->base_ptr          \
+     && (char *) (p) < (b)->base_ptr + (b)->bytes_used)
+
 /* Convenience macro to check for empty buffer without
  * exposing the internals */
-#define PMIX_BUFFER_IS_EMPTY(b) (0 == (b)->bytes_used || (b)->pack_ptr == (b)->unpack_ptr)
+#define PMIX_BUFFER_IS_EMPTY(b) \
+    (0 == (b)->chain_bytes && (0 == (b)->bytes_used || (b)->pack_ptr == (b)->unpack_ptr))
+
+/* Size of the whole payload, including any chained segments */
+#define PMIX_BUFFER_TOTAL_BYTES(b) ((b)->bytes_used + (b)->chain_bytes)
 
 END_C_DECLS
 
@@ -39,6 +39,7 @@ static pmix_status_t pmix3_unpack(pmix_buffer_t *buffer, void *dest, int32_t *nu
 static pmix_status_t pmix3_copy(void **dest, void *src, pmix_data_type_t type);
 static pmix_status_t pmix3_print(char **output, char *prefix, void *src, pmix_data_type_t type);
 static const char *data_type_string(pmix_data_type_t type);
+static pmix_status_t pmix3_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src);
 
 pmix_bfrops_module_t pmix_bfrops_pmix3_module = {
     .version = "v3",
@@ -53,7 +54,8 @@ pmix_bfrops_module_t pmix_bfrops_pmix3_module = {
     .value_load = pmix_bfrops_base_value_load,
     .value_unload = pmix_bfrops_base_value_unload,
     .value_cmp = pmix_bfrops_base_value_cmp,
-    .data_type_string = data_type_string
+    .data_type_string = data_type_string,
+    .chain_payload = pmix3_chain_payload
 };
 
 /* DEPRECATED data type values */
@@ -306,6 +308,11 @@ static pmix_status_t pmix3_pack(pmix_buffer_t *buffer, const void *src, int num_
     return pmix_bfrops_base_pack(&pmix_mca_bfrops_v3_component.types, buffer, src, num_vals, type);
 }
 
+static pmix_status_t pmix3_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src)
+{
+    return pmix_bfrops_base_chain_payload(&pmix_mca_bfrops_v3_component.types, dest, src);
+}
+
 static pmix_status_t pmix3_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
                                   pmix_data_type_t type)
 {
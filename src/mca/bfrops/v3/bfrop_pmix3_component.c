@@ -63,7 +63,8 @@ pmix_bfrops_base_component_t pmix_mca_bfrops_v3_component = {
         .pmix_mca_query_component = component_query,
     },
     .priority = 40,
-    .assign_module = assign_module
+    .assign_module = assign_module,
+    .base_dispatch = true
 };
 
 pmix_status_t component_open(void)
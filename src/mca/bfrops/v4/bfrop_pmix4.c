@@ -42,6 +42,7 @@ static pmix_status_t pmix4_unpack(pmix_buffer_t *buffer, void *dest, int32_t *nu
 static pmix_status_t pmix4_copy(void **dest, void *src, pmix_data_type_t type);
 static pmix_status_t pmix4_print(char **output, char *prefix, void *src, pmix_data_type_t type);
 static const char *data_type_string(pmix_data_type_t type);
+static pmix_status_t pmix4_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src);
 
 static pmix_status_t pmix4_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
                                                         pmix_buffer_t *buffer, const void *src,
@@ -75,7 +76,8 @@ pmix_bfrops_module_t pmix_bfrops_pmix4_module = {
     .value_load = pmix_bfrops_base_value_load,
     .value_unload = pmix_bfrops_base_value_unload,
     .value_cmp = pmix_bfrops_base_value_cmp,
-    .data_type_string = data_type_string
+    .data_type_string = data_type_string,
+    .chain_payload = pmix4_chain_payload
 };
 
 static pmix_status_t init(void)
@@ -340,6 +342,11 @@ static pmix_status_t pmix4_pack(pmix_buffer_t *buffer, const void *src, int num_
     return pmix_bfrops_base_pack(&pmix_mca_bfrops_v4_component.types, buffer, src, num_vals, type);
 }
 
+static pmix_status_t pmix4_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src)
+{
+    return pmix_bfrops_base_chain_payload(&pmix_mca_bfrops_v4_component.types, dest, src);
+}
+
 static pmix_status_t pmix4_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
                                   pmix_data_type_t type)
 {
@@ -398,6 +405,17 @@ static pmix_status_t pmix4_bfrops_base_pack_general_int(pmix_pointer_array_t *re
         return rc;
     }
 
+    if (NULL != pmix_psquash.encode_int_array) {
+        rc = pmix_psquash.encode_int_array(type, (void *) src, num_vals, dst, &pkg_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->pack_ptr += pkg_size;
+        buffer->bytes_used += pkg_size;
+        return PMIX_SUCCESS;
+    }
+
     for (i = 0; i < num_vals; ++i) {
         rc = (pmix_psquash.encode_int)(type, (uint8_t *) src + i * val_size, dst, &pkg_size);
         if (PMIX_SUCCESS != rc) {
@@ -493,6 +511,24 @@ static pmix_status_t pmix4_bfrops_base_unpack_general_int(pmix_pointer_array_t *
         return rc;
     }
 
+    if (NULL != pmix_psquash.decode_int_array) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = pmix_psquash.decode_int_array(type, buffer->unpack_ptr, avail_size, *num_vals,
+                                           dest, &unpack_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* sanity check */
+        if (unpack_size > avail_size) {
+            rc = PMIX_ERR_FATAL;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->unpack_ptr += unpack_size;
+        return PMIX_SUCCESS;
+    }
+
     /* unpack the data */
     for (i = 0; i < (*num_vals); ++i) {
         avail_size = buffer->pack_ptr - buffer->unpack_ptr;
@@ -42,6 +42,7 @@ static pmix_status_t pmix41_unpack(pmix_buffer_t *buffer, void *dest, int32_t *n
 static pmix_status_t pmix41_copy(void **dest, void *src, pmix_data_type_t type);
 static pmix_status_t pmix41_print(char **output, char *prefix, void *src, pmix_data_type_t type);
 static const char *data_type_string(pmix_data_type_t type);
+static pmix_status_t pmix41_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src);
 
 static pmix_status_t pmix41_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
                                                          pmix_buffer_t *buffer, const void *src,
@@ -62,6 +63,18 @@ static pmix_status_t pmix41_bfrops_base_unpack_int(pmix_pointer_array_t *regtype
 static pmix_status_t pmix41_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes,
                                                      pmix_buffer_t *buffer, void *dest,
                                                      int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix41_bfrops_base_pack_proc(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix41_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix41_bfrops_base_pack_info(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix41_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type);
 
 pmix_bfrops_module_t pmix_bfrops_pmix41_module = {
     .version = "v41",
@@ -76,7 +89,8 @@ pmix_bfrops_module_t pmix_bfrops_pmix41_module = {
     .value_load = pmix_bfrops_base_value_load,
     .value_unload = pmix_bfrops_base_value_unload,
     .value_cmp = pmix_bfrops_base_value_cmp,
-    .data_type_string = data_type_string
+    .data_type_string = data_type_string,
+    .chain_payload = pmix41_chain_payload
 };
 
 static pmix_status_t init(void)
@@ -168,16 +182,16 @@ static pmix_status_t init(void)
                        pmix_bfrops_base_unpack_value, pmix_bfrops_base_copy_value,
                        pmix_bfrops_base_print_value, &pmix_mca_bfrops_v41_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_PROC", PMIX_PROC, pmix_bfrops_base_pack_proc,
-                       pmix_bfrops_base_unpack_proc, pmix_bfrops_base_copy_proc,
+    PMIX_REGISTER_TYPE("PMIX_PROC", PMIX_PROC, pmix41_bfrops_base_pack_proc,
+                       pmix41_bfrops_base_unpack_proc, pmix_bfrops_base_copy_proc,
                        pmix_bfrops_base_print_proc, &pmix_mca_bfrops_v41_component.types);
 
     PMIX_REGISTER_TYPE("PMIX_APP", PMIX_APP, pmix_bfrops_base_pack_app, pmix_bfrops_base_unpack_app,
                        pmix_bfrops_base_copy_app, pmix_bfrops_base_print_app,
                        &pmix_mca_bfrops_v41_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_INFO", PMIX_INFO, pmix_bfrops_base_pack_info,
-                       pmix_bfrops_base_unpack_info, pmix_bfrops_base_copy_info,
+    PMIX_REGISTER_TYPE("PMIX_INFO", PMIX_INFO, pmix41_bfrops_base_pack_info,
+                       pmix41_bfrops_base_unpack_info, pmix_bfrops_base_copy_info,
                        pmix_bfrops_base_print_info, &pmix_mca_bfrops_v41_component.types);
 
     PMIX_REGISTER_TYPE("PMIX_PDATA", PMIX_PDATA, pmix_bfrops_base_pack_pdata,
@@ -381,6 +395,11 @@ static pmix_status_t pmix41_pack(pmix_buffer_t *buffer, const void *src, int num
     return pmix_bfrops_base_pack(&pmix_mca_bfrops_v41_component.types, buffer, src, num_vals, type);
 }
 
+static pmix_status_t pmix41_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src)
+{
+    return pmix_bfrops_base_chain_payload(&pmix_mca_bfrops_v41_component.types, dest, src);
+}
+
 static pmix_status_t pmix41_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
                                    pmix_data_type_t type)
 {
@@ -439,6 +458,17 @@ static pmix_status_t pmix41_bfrops_base_pack_general_int(pmix_pointer_array_t *r
         return rc;
     }
 
+    if (NULL != pmix_psquash.encode_int_array) {
+        rc = pmix_psquash.encode_int_array(type, (void *) src, num_vals, dst, &pkg_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->pack_ptr += pkg_size;
+        buffer->bytes_used += pkg_size;
+        return PMIX_SUCCESS;
+    }
+
     for (i = 0; i < num_vals; ++i) {
         rc = (pmix_psquash.encode_int)(type, (uint8_t *) src + i * val_size, dst, &pkg_size);
         if (PMIX_SUCCESS != rc) {
@@ -534,6 +564,24 @@ static pmix_status_t pmix41_bfrops_base_unpack_general_int(pmix_pointer_array_t
         return rc;
     }
 
+    if (NULL != pmix_psquash.decode_int_array) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = pmix_psquash.decode_int_array(type, buffer->unpack_ptr, avail_size, *num_vals,
+                                           dest, &unpack_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* sanity check */
+        if (unpack_size > avail_size) {
+            rc = PMIX_ERR_FATAL;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->unpack_ptr += unpack_size;
+        return PMIX_SUCCESS;
+    }
+
     /* unpack the data */
     for (i = 0; i < (*num_vals); ++i) {
         avail_size = buffer->pack_ptr - buffer->unpack_ptr;
@@ -627,3 +675,287 @@ static pmix_status_t pmix41_bfrops_base_unpack_sizet(pmix_pointer_array_t *regty
     }
     return ret;
 }
+
+/*
+ * Helpers for the structured types below. A string goes on the
+ * wire as its length (including the NULL terminator) encoded as an
+ * INT32, followed by the bytes, and ranks and directives are encoded
+ * as UINT32 - the helpers produce exactly what the generic path
+ * would without a type lookup and buffer check per member.
+ */
+static inline pmix_status_t pmix41_encode_int(pmix_data_type_t type, const void *src,
+                                              char **dst, size_t *used)
+{
+    pmix_status_t rc;
+    size_t pkg_size;
+
+    rc = (pmix_psquash.encode_int)(type, (void *) src, *dst, &pkg_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    *dst += pkg_size;
+    *used += pkg_size;
+    return PMIX_SUCCESS;
+}
+
+static inline pmix_status_t pmix41_encode_string(const char *str, size_t len,
+                                                 char **dst, size_t *used)
+{
+    pmix_status_t rc;
+    int32_t slen = len + 1;
+
+    rc = pmix41_encode_int(PMIX_INT32, &slen, dst, used);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    memcpy(*dst, str, slen);
+    *dst += slen;
+    *used += slen;
+    return PMIX_SUCCESS;
+}
+
+static inline void pmix41_commit_packed(pmix_buffer_t *buffer, size_t used)
+{
+    buffer->pack_ptr += used;
+    buffer->bytes_used += used;
+}
+
+static inline pmix_status_t pmix41_decode_int(pmix_buffer_t *buffer, pmix_data_type_t type,
+                                              size_t max_size, void *dest)
+{
+    pmix_status_t rc;
+    size_t avail_size, unpack_size;
+
+    if (buffer->pack_ptr == buffer->unpack_ptr) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+    rc = (pmix_psquash.decode_int)(type, buffer->unpack_ptr, avail_size, dest, &unpack_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (unpack_size > max_size) {
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (unpack_size > avail_size) {
+        rc = PMIX_ERR_FATAL;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    buffer->unpack_ptr += unpack_size;
+    return PMIX_SUCCESS;
+}
+
+/* unpack a string directly into a fixed-size field of maxlen+1
+ * bytes, truncating it as pmix_strncpy would. A NULL string
+ * is returned as PMIX_ERROR as these fields cannot be NULL */
+static inline pmix_status_t pmix41_decode_fixed_string(pmix_buffer_t *buffer, size_t int_size,
+                                                       char *dest, size_t maxlen)
+{
+    pmix_status_t rc;
+    int32_t len;
+    size_t n;
+
+    rc = pmix41_decode_int(buffer, PMIX_INT32, int_size, &len);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 == len) {
+        return PMIX_ERROR;
+    }
+    if (len < 0) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    if (pmix_bfrop_too_small(buffer, len)) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    n = ((size_t) len < maxlen) ? (size_t) len : maxlen;
+    memcpy(dest, buffer->unpack_ptr, n);
+    dest[n] = '\0';
+    buffer->unpack_ptr += len;
+    return PMIX_SUCCESS;
+}
+
+/*
+ * PMIX_PROC
+ */
+static pmix_status_t pmix41_bfrops_base_pack_proc(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_proc_t *proc = (pmix_proc_t *) src;
+    pmix_status_t rc;
+    int32_t i;
+    size_t int_size, rank_size, total, used = 0;
+    char *dst;
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &rank_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* size the buffer once for the entire array */
+    total = 0;
+    for (i = 0; i < num_vals; ++i) {
+        total += int_size + strlen(proc[i].nspace) + 1 + rank_size;
+    }
+    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, total))) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < num_vals; ++i) {
+        rc = pmix41_encode_string(proc[i].nspace, strlen(proc[i].nspace), &dst, &used);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        rc = pmix41_encode_int(PMIX_UINT32, &proc[i].rank, &dst, &used);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    pmix41_commit_packed(buffer, used);
+    return rc;
+}
+
+static pmix_status_t pmix41_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_proc_t *ptr = (pmix_proc_t *) dest;
+    pmix_status_t rc;
+    int32_t i, n = *num_vals;
+    size_t int_size, rank_size;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix41_bfrop_unpack: %d procs", n);
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &rank_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < n; ++i) {
+        memset(&ptr[i], 0, sizeof(pmix_proc_t));
+        rc = pmix41_decode_fixed_string(buffer, int_size, ptr[i].nspace, PMIX_MAX_NSLEN);
+        if (PMIX_SUCCESS != rc) {
+            if (PMIX_ERROR == rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+            return rc;
+        }
+        rc = pmix41_decode_int(buffer, PMIX_UINT32, rank_size, &ptr[i].rank);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/*
+ * PMIX_INFO
+ */
+static pmix_status_t pmix41_bfrops_base_pack_info(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_info_t *info = (pmix_info_t *) src;
+    pmix_status_t rc;
+    int32_t i;
+    size_t int_size, flag_size, keylen, used;
+    char *dst;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &flag_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < num_vals; ++i) {
+        /* the key and directives are written in one step - the
+         * value has to go through the generic path */
+        keylen = strlen(info[i].key);
+        if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, int_size + keylen + 1 + flag_size))) {
+            rc = PMIX_ERR_OUT_OF_RESOURCE;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        used = 0;
+        rc = pmix41_encode_string(info[i].key, keylen, &dst, &used);
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix41_encode_int(PMIX_UINT32, &info[i].flags, &dst, &used);
+        }
+        pmix41_commit_packed(buffer, used);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* pack the type */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(regtypes, buffer, info[i].value.type))) {
+            return rc;
+        }
+        /* pack value */
+        if (PMIX_SUCCESS != (rc = pmix_bfrops_base_pack_val(regtypes, buffer, &info[i].value))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pmix41_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_info_t *ptr = (pmix_info_t *) dest;
+    pmix_status_t rc;
+    int32_t i, n = *num_vals;
+    size_t int_size, flag_size;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix41_bfrop_unpack: %d info", n);
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &flag_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < n; ++i) {
+        memset(ptr[i].key, 0, sizeof(ptr[i].key));
+        memset(&ptr[i].value, 0, sizeof(pmix_value_t));
+        rc = pmix41_decode_fixed_string(buffer, int_size, ptr[i].key, PMIX_MAX_KEYLEN);
+        if (PMIX_SUCCESS != rc) {
+            if (PMIX_ERROR != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+            return rc;
+        }
+        rc = pmix41_decode_int(buffer, PMIX_UINT32, flag_size, &ptr[i].flags);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* unpack value - directly into the statically-defined
+         * value structure to avoid the malloc */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(regtypes, buffer, &ptr[i].value.type))) {
+            return rc;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i].value))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
@@ -0,0 +1,1220 @@
+/*
+ * Copyright (c) 20041-2010 The Trustees of Indiana University and Indiana
+ *                         University Research and Technology
+ *                         Corporation.  All rights reserved.
+ * Copyright (c) 20041-2011 The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * Copyright (c) 20041-2005 High Performance Computing Center Stuttgart,
+ *                         University of Stuttgart.  All rights reserved.
+ * Copyright (c) 20041-2005 The Regents of the University of California.
+ *                         All rights reserved.
+ * Copyright (c) 2010-2011 Oak Ridge National Labs.  All rights reserved.
+ * Copyright (c) 2011-20141 Cisco Systems, Inc.  All rights reserved.
+ * Copyright (c) 2011-20141 Los Alamos National Security, LLC.  All rights
+ *                         reserved.
+ * Copyright (c) 20141-2020 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2019      IBM Corporation.  All rights reserved.
+ * Copyright (c) 2021-2022 Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "bfrop_pmix42.h"
+#include "src/mca/bfrops/base/base.h"
+
+#include "src/include/pmix_dictionary.h"
+#include "src/mca/psquash/base/base.h"
+#include "src/mca/psquash/psquash.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_hash.h"
+
+static pmix_status_t init(void);
+static void finalize(void);
+static pmix_status_t pmix42_pack(pmix_buffer_t *buffer, const void *src, int num_vals,
+                                 pmix_data_type_t type);
+static pmix_status_t pmix42_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                   pmix_data_type_t type);
+static pmix_status_t pmix42_copy(void **dest, void *src, pmix_data_type_t type);
+static pmix_status_t pmix42_print(char **output, char *prefix, void *src, pmix_data_type_t type);
+static const char *data_type_string(pmix_data_type_t type);
+static pmix_status_t pmix42_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src);
+
+static pmix_status_t pmix42_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
+                                                         pmix_buffer_t *buffer, const void *src,
+                                                         int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_pack_int(pmix_pointer_array_t *regtypes,
+                                                 pmix_buffer_t *buffer, const void *src,
+                                                 int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_pack_sizet(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, const void *src,
+                                                   int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_general_int(pmix_pointer_array_t *regtypes,
+                                                           pmix_buffer_t *buffer, void *dest,
+                                                           int32_t *num_vals,
+                                                           pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_int(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, void *dest,
+                                                   int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes,
+                                                     pmix_buffer_t *buffer, void *dest,
+                                                     int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_pack_proc(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_pack_info(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_pack_pdata(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, const void *src,
+                                                   int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes,
+                                                     pmix_buffer_t *buffer, void *dest,
+                                                     int32_t *num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_pack_kval(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type);
+static pmix_status_t pmix42_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type);
+
+pmix_bfrops_module_t pmix_bfrops_pmix42_module = {
+    .version = "v42",
+    .init = init,
+    .finalize = finalize,
+    .pack = pmix42_pack,
+    .unpack = pmix42_unpack,
+    .copy = pmix42_copy,
+    .print = pmix42_print,
+    .copy_payload = pmix_bfrops_base_copy_payload,
+    .value_xfer = pmix_bfrops_base_value_xfer,
+    .value_load = pmix_bfrops_base_value_load,
+    .value_unload = pmix_bfrops_base_value_unload,
+    .value_cmp = pmix_bfrops_base_value_cmp,
+    .data_type_string = data_type_string,
+    .chain_payload = pmix42_chain_payload
+};
+
+static pmix_status_t init(void)
+{
+    /* some standard types don't require anything special */
+    PMIX_REGISTER_TYPE("PMIX_BOOL", PMIX_BOOL, pmix_bfrops_base_pack_bool,
+                       pmix_bfrops_base_unpack_bool, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_bool, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_BYTE", PMIX_BYTE, pmix_bfrops_base_pack_byte,
+                       pmix_bfrops_base_unpack_byte, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_byte, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_STRING", PMIX_STRING, pmix_bfrops_base_pack_string,
+                       pmix_bfrops_base_unpack_string, pmix_bfrops_base_copy_string,
+                       pmix_bfrops_base_print_string, &pmix_mca_bfrops_v42_component.types);
+
+    /* Register the rest of the standard generic types to point to internal functions */
+    PMIX_REGISTER_TYPE("PMIX_SIZE", PMIX_SIZE, pmix42_bfrops_base_pack_sizet,
+                       pmix42_bfrops_base_unpack_sizet, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_size, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PID", PMIX_PID, pmix_bfrops_base_pack_pid, pmix_bfrops_base_unpack_pid,
+                       pmix_bfrops_base_std_copy, pmix_bfrops_base_print_pid,
+                       &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_INT", PMIX_INT, pmix42_bfrops_base_pack_int,
+                       pmix42_bfrops_base_unpack_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_int, &pmix_mca_bfrops_v42_component.types);
+
+    /* Register all the standard fixed types to point to base functions */
+    PMIX_REGISTER_TYPE("PMIX_INT8", PMIX_INT8, pmix_bfrops_base_pack_byte,
+                       pmix_bfrops_base_unpack_byte, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_int8, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_INT16", PMIX_INT16, pmix42_bfrops_base_pack_general_int,
+                       pmix42_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_int16, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_INT32", PMIX_INT32, pmix42_bfrops_base_pack_general_int,
+                       pmix42_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_int32, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_INT64", PMIX_INT64, pmix42_bfrops_base_pack_general_int,
+                       pmix42_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_int64, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_UINT", PMIX_UINT, pmix42_bfrops_base_pack_int,
+                       pmix42_bfrops_base_unpack_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_uint, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_UINT8", PMIX_UINT8, pmix_bfrops_base_pack_byte,
+                       pmix_bfrops_base_unpack_byte, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_uint8, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_UINT16", PMIX_UINT16, pmix42_bfrops_base_pack_general_int,
+                       pmix42_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_uint16, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_UINT32", PMIX_UINT32, pmix42_bfrops_base_pack_general_int,
+                       pmix42_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_uint32, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_UINT64", PMIX_UINT64, pmix42_bfrops_base_pack_general_int,
+                       pmix42_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_uint64, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_FLOAT", PMIX_FLOAT, pmix_bfrops_base_pack_float,
+                       pmix_bfrops_base_unpack_float, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_float, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DOUBLE", PMIX_DOUBLE, pmix_bfrops_base_pack_double,
+                       pmix_bfrops_base_unpack_double, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_double, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_TIMEVAL", PMIX_TIMEVAL, pmix_bfrops_base_pack_timeval,
+                       pmix_bfrops_base_unpack_timeval, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_timeval, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_TIME", PMIX_TIME, pmix_bfrops_base_pack_time,
+                       pmix_bfrops_base_unpack_time, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_time, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_STATUS", PMIX_STATUS, pmix_bfrops_base_pack_status,
+                       pmix_bfrops_base_unpack_status, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_status, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_VALUE", PMIX_VALUE, pmix_bfrops_base_pack_value,
+                       pmix_bfrops_base_unpack_value, pmix_bfrops_base_copy_value,
+                       pmix_bfrops_base_print_value, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC", PMIX_PROC, pmix42_bfrops_base_pack_proc,
+                       pmix42_bfrops_base_unpack_proc, pmix_bfrops_base_copy_proc,
+                       pmix_bfrops_base_print_proc, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_APP", PMIX_APP, pmix_bfrops_base_pack_app, pmix_bfrops_base_unpack_app,
+                       pmix_bfrops_base_copy_app, pmix_bfrops_base_print_app,
+                       &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_INFO", PMIX_INFO, pmix42_bfrops_base_pack_info,
+                       pmix42_bfrops_base_unpack_info, pmix_bfrops_base_copy_info,
+                       pmix_bfrops_base_print_info, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PDATA", PMIX_PDATA, pmix42_bfrops_base_pack_pdata,
+                       pmix42_bfrops_base_unpack_pdata, pmix_bfrops_base_copy_pdata,
+                       pmix_bfrops_base_print_pdata, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_BUFFER", PMIX_BUFFER, pmix_bfrops_base_pack_buf,
+                       pmix_bfrops_base_unpack_buf, pmix_bfrops_base_copy_buf,
+                       pmix_bfrops_base_print_buf, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_BYTE_OBJECT", PMIX_BYTE_OBJECT, pmix_bfrops_base_pack_bo,
+                       pmix_bfrops_base_unpack_bo, pmix_bfrops_base_copy_bo,
+                       pmix_bfrops_base_print_bo, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_KVAL", PMIX_KVAL, pmix42_bfrops_base_pack_kval,
+                       pmix42_bfrops_base_unpack_kval, pmix_bfrops_base_copy_kval,
+                       pmix_bfrops_base_print_kval, &pmix_mca_bfrops_v42_component.types);
+
+    /* these are fixed-sized values and can be done by base */
+    PMIX_REGISTER_TYPE("PMIX_PERSIST", PMIX_PERSIST, pmix_bfrops_base_pack_persist,
+                       pmix_bfrops_base_unpack_persist, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_persist, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_POINTER", PMIX_POINTER, pmix_bfrops_base_pack_ptr,
+                       pmix_bfrops_base_unpack_ptr, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_ptr, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_SCOPE", PMIX_SCOPE, pmix_bfrops_base_pack_scope,
+                       pmix_bfrops_base_unpack_scope, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_scope, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DATA_RANGE", PMIX_DATA_RANGE, pmix_bfrops_base_pack_range,
+                       pmix_bfrops_base_unpack_range, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_ptr, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_COMMAND", PMIX_COMMAND, pmix_bfrops_base_pack_cmd,
+                       pmix_bfrops_base_unpack_cmd, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_cmd, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_INFO_DIRECTIVES", PMIX_INFO_DIRECTIVES,
+                       pmix_bfrops_base_pack_info_directives,
+                       pmix_bfrops_base_unpack_info_directives, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_info_directives, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DATA_TYPE", PMIX_DATA_TYPE, pmix_bfrops_base_pack_datatype,
+                       pmix_bfrops_base_unpack_datatype, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_datatype, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC_STATE", PMIX_PROC_STATE, pmix_bfrops_base_pack_pstate,
+                       pmix_bfrops_base_unpack_pstate, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_pstate, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC_INFO", PMIX_PROC_INFO, pmix_bfrops_base_pack_pinfo,
+                       pmix_bfrops_base_unpack_pinfo, pmix_bfrops_base_copy_pinfo,
+                       pmix_bfrops_base_print_pinfo, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DATA_ARRAY", PMIX_DATA_ARRAY, pmix_bfrops_base_pack_darray,
+                       pmix_bfrops_base_unpack_darray, pmix_bfrops_base_copy_darray,
+                       pmix_bfrops_base_print_darray, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC_RANK", PMIX_PROC_RANK, pmix_bfrops_base_pack_rank,
+                       pmix_bfrops_base_unpack_rank, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_rank, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_QUERY", PMIX_QUERY, pmix_bfrops_base_pack_query,
+                       pmix_bfrops_base_unpack_query, pmix_bfrops_base_copy_query,
+                       pmix_bfrops_base_print_query, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_COMPRESSED_STRING", PMIX_COMPRESSED_STRING, pmix_bfrops_base_pack_bo,
+                       pmix_bfrops_base_unpack_bo, pmix_bfrops_base_copy_bo,
+                       pmix_bfrops_base_print_bo, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_ALLOC_DIRECTIVE", PMIX_ALLOC_DIRECTIVE,
+                       pmix_bfrops_base_pack_alloc_directive,
+                       pmix_bfrops_base_unpack_alloc_directive, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_alloc_directive, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_IOF_CHANNEL", PMIX_IOF_CHANNEL, pmix_bfrops_base_pack_iof_channel,
+                       pmix_bfrops_base_unpack_iof_channel, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_iof_channel, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_ENVAR", PMIX_ENVAR, pmix_bfrops_base_pack_envar,
+                       pmix_bfrops_base_unpack_envar, pmix_bfrops_base_copy_envar,
+                       pmix_bfrops_base_print_envar, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_COORD", PMIX_COORD, pmix_bfrops_base_pack_coord,
+                       pmix_bfrops_base_unpack_coord, pmix_bfrops_base_copy_coord,
+                       pmix_bfrops_base_print_coord, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_REGATTR", PMIX_REGATTR, pmix_bfrops_base_pack_regattr,
+                       pmix_bfrops_base_unpack_regattr, pmix_bfrops_base_copy_regattr,
+                       pmix_bfrops_base_print_regattr, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_REGEX", PMIX_REGEX, pmix_bfrops_base_pack_regex,
+                       pmix_bfrops_base_unpack_regex, pmix_bfrops_base_copy_regex,
+                       pmix_bfrops_base_print_regex, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_JOB_STATE", PMIX_JOB_STATE, pmix_bfrops_base_pack_jobstate,
+                       pmix_bfrops_base_unpack_jobstate, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_jobstate, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_LINK_STATE", PMIX_LINK_STATE, pmix_bfrops_base_pack_linkstate,
+                       pmix_bfrops_base_unpack_linkstate, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_linkstate, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC_CPUSET", PMIX_PROC_CPUSET, pmix_bfrops_base_pack_cpuset,
+                       pmix_bfrops_base_unpack_cpuset, pmix_bfrops_base_copy_cpuset,
+                       pmix_bfrops_base_print_cpuset, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_GEOMETRY", PMIX_GEOMETRY, pmix_bfrops_base_pack_geometry,
+                       pmix_bfrops_base_unpack_geometry, pmix_bfrops_base_copy_geometry,
+                       pmix_bfrops_base_print_geometry, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DEVICE_DIST", PMIX_DEVICE_DIST, pmix_bfrops_base_pack_devdist,
+                       pmix_bfrops_base_unpack_devdist, pmix_bfrops_base_copy_devdist,
+                       pmix_bfrops_base_print_devdist, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_ENDPOINT", PMIX_ENDPOINT, pmix_bfrops_base_pack_endpoint,
+                       pmix_bfrops_base_unpack_endpoint, pmix_bfrops_base_copy_endpoint,
+                       pmix_bfrops_base_print_endpoint, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_TOPO", PMIX_TOPO, pmix_bfrops_base_pack_topology,
+                       pmix_bfrops_base_unpack_topology, pmix_bfrops_base_copy_topology,
+                       pmix_bfrops_base_print_topology, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DEVTYPE", PMIX_DEVTYPE, pmix_bfrops_base_pack_devtype,
+                       pmix_bfrops_base_unpack_devtype, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_devtype, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_LOCTYPE", PMIX_LOCTYPE, pmix_bfrops_base_pack_locality,
+                       pmix_bfrops_base_unpack_locality, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_locality, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_COMPRESSED_BYTE_OBJECT", PMIX_COMPRESSED_BYTE_OBJECT,
+                       pmix_bfrops_base_pack_bo, pmix_bfrops_base_unpack_bo,
+                       pmix_bfrops_base_copy_bo, pmix_bfrops_base_print_bo,
+                       &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC_NSPACE", PMIX_PROC_NSPACE, pmix_bfrops_base_pack_nspace,
+                       pmix_bfrops_base_unpack_nspace, pmix_bfrops_base_copy_nspace,
+                       pmix_bfrops_base_print_nspace, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_PROC_STATS", PMIX_PROC_STATS, pmix_bfrops_base_pack_pstats,
+                       pmix_bfrops_base_unpack_pstats, pmix_bfrops_base_copy_pstats,
+                       pmix_bfrops_base_print_pstats, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DISK_STATS", PMIX_DISK_STATS, pmix_bfrops_base_pack_dkstats,
+                       pmix_bfrops_base_unpack_dkstats, pmix_bfrops_base_copy_dkstats,
+                       pmix_bfrops_base_print_dkstats, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_NET_STATS", PMIX_NET_STATS, pmix_bfrops_base_pack_netstats,
+                       pmix_bfrops_base_unpack_netstats, pmix_bfrops_base_copy_netstats,
+                       pmix_bfrops_base_print_netstats, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_NODE_STATS", PMIX_NODE_STATS, pmix_bfrops_base_pack_ndstats,
+                       pmix_bfrops_base_unpack_ndstats, pmix_bfrops_base_copy_ndstats,
+                       pmix_bfrops_base_print_ndstats, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_DATA_BUFFER", PMIX_DATA_BUFFER, pmix_bfrops_base_pack_dbuf,
+                       pmix_bfrops_base_unpack_dbuf, pmix_bfrops_base_copy_dbuf,
+                       pmix_bfrops_base_print_dbuf, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_STOR_MEDIUM", PMIX_STOR_MEDIUM, pmix_bfrops_base_pack_smed,
+                       pmix_bfrops_base_unpack_smed, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_smed, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_STOR_ACCESS", PMIX_STOR_ACCESS, pmix_bfrops_base_pack_sacc,
+                       pmix_bfrops_base_unpack_sacc, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_sacc, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_STOR_PERSIST", PMIX_STOR_PERSIST, pmix_bfrops_base_pack_spers,
+                       pmix_bfrops_base_unpack_spers, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_spers, &pmix_mca_bfrops_v42_component.types);
+
+    PMIX_REGISTER_TYPE("PMIX_STOR_ACCESS_TYPE", PMIX_STOR_ACCESS_TYPE, pmix_bfrops_base_pack_satyp,
+                       pmix_bfrops_base_unpack_satyp, pmix_bfrops_base_std_copy,
+                       pmix_bfrops_base_print_satyp, &pmix_mca_bfrops_v42_component.types);
+
+    return PMIX_SUCCESS;
+}
+
+static void finalize(void)
+{
+    int n;
+    pmix_bfrop_type_info_t *info;
+
+    for (n = 0; n < pmix_mca_bfrops_v42_component.types.size; n++) {
+        if (NULL
+            != (info = (pmix_bfrop_type_info_t *)
+                    pmix_pointer_array_get_item(&pmix_mca_bfrops_v42_component.types, n))) {
+            PMIX_RELEASE(info);
+            pmix_pointer_array_set_item(&pmix_mca_bfrops_v42_component.types, n, NULL);
+        }
+    }
+}
+
+static pmix_status_t pmix42_pack(pmix_buffer_t *buffer, const void *src, int num_vals,
+                                 pmix_data_type_t type)
+{
+    /* kick the process off by passing this in to the base */
+    return pmix_bfrops_base_pack(&pmix_mca_bfrops_v42_component.types, buffer, src, num_vals, type);
+}
+
+static pmix_status_t pmix42_chain_payload(pmix_buffer_t *dest, pmix_buffer_t *src)
+{
+    return pmix_bfrops_base_chain_payload(&pmix_mca_bfrops_v42_component.types, dest, src);
+}
+
+static pmix_status_t pmix42_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                   pmix_data_type_t type)
+{
+    /* kick the process off by passing this in to the base */
+    return pmix_bfrops_base_unpack(&pmix_mca_bfrops_v42_component.types, buffer, dest, num_vals, type);
+}
+
+static pmix_status_t pmix42_copy(void **dest, void *src, pmix_data_type_t type)
+{
+    return pmix_bfrops_base_copy(&pmix_mca_bfrops_v42_component.types, dest, src, type);
+}
+
+static pmix_status_t pmix42_print(char **output, char *prefix, void *src, pmix_data_type_t type)
+{
+    return pmix_bfrops_base_print(&pmix_mca_bfrops_v42_component.types, output, prefix, src, type);
+}
+
+static const char *data_type_string(pmix_data_type_t type)
+{
+    return pmix_bfrops_base_data_type_string(&pmix_mca_bfrops_v42_component.types, type);
+}
+
+/*
+ * INT16, INT32, INT641
+ */
+static pmix_status_t pmix42_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
+                                                         pmix_buffer_t *buffer, const void *src,
+                                                         int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_status_t rc;
+    int32_t i;
+    char *dst;
+    size_t val_size, max_size, pkg_size;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix_bfrops_base_pack_integer * %d\n", num_vals);
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes);
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    rc = pmix_psquash.get_max_size(type, &max_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* check to see if buffer needs extending */
+    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, num_vals * max_size))) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (NULL != pmix_psquash.encode_int_array) {
+        rc = pmix_psquash.encode_int_array(type, (void *) src, num_vals, dst, &pkg_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->pack_ptr += pkg_size;
+        buffer->bytes_used += pkg_size;
+        return PMIX_SUCCESS;
+    }
+
+    for (i = 0; i < num_vals; ++i) {
+        rc = (pmix_psquash.encode_int)(type, (uint8_t *) src + i * val_size, dst, &pkg_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        dst += pkg_size;
+        buffer->pack_ptr += pkg_size;
+        buffer->bytes_used += pkg_size;
+    }
+
+    return PMIX_SUCCESS;
+}
+
+/*
+ * INT
+ */
+static pmix_status_t pmix42_bfrops_base_pack_int(pmix_pointer_array_t *regtypes,
+                                                 pmix_buffer_t *buffer, const void *src,
+                                                 int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_status_t ret;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (false == pmix_psquash.int_type_is_encoded) {
+        /* System types need to always be described so we can properly
+           unpack them */
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_store_data_type(regtypes, buffer, BFROP_TYPE_INT))) {
+            return ret;
+        }
+    }
+
+    /* Turn around and pack the real type */
+    PMIX_BFROPS_PACK_TYPE(ret, buffer, src, num_vals, BFROP_TYPE_INT, regtypes);
+    return ret;
+}
+
+/*
+ * SIZE_T
+ */
+static pmix_status_t pmix42_bfrops_base_pack_sizet(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, const void *src,
+                                                   int32_t num_vals, pmix_data_type_t type)
+{
+    int ret;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (false == pmix_psquash.int_type_is_encoded) {
+        /* System types need to always be described so we can properly
+           unpack them. */
+        if (PMIX_SUCCESS
+            != (ret = pmix_bfrop_store_data_type(regtypes, buffer, BFROP_TYPE_SIZE_T))) {
+            return ret;
+        }
+    }
+
+    PMIX_BFROPS_PACK_TYPE(ret, buffer, src, num_vals, BFROP_TYPE_SIZE_T, regtypes);
+    return ret;
+}
+
+/*
+ * INT16, INT32, INT641
+ */
+static pmix_status_t pmix42_bfrops_base_unpack_general_int(pmix_pointer_array_t *regtypes,
+                                                           pmix_buffer_t *buffer, void *dest,
+                                                           int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_status_t rc;
+    size_t val_size, avail_size, unpack_size, max_size;
+    int32_t i;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix_bfrops_base_unpack_integer * %d\n", (int) *num_vals);
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
+
+    /* check to see if there's enough data in buffer */
+    if (buffer->pack_ptr == buffer->unpack_ptr) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    rc = pmix_psquash.get_max_size(type, &max_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (NULL != pmix_psquash.decode_int_array) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = pmix_psquash.decode_int_array(type, buffer->unpack_ptr, avail_size, *num_vals,
+                                           dest, &unpack_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* sanity check */
+        if (unpack_size > avail_size) {
+            rc = PMIX_ERR_FATAL;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->unpack_ptr += unpack_size;
+        return PMIX_SUCCESS;
+    }
+
+    /* unpack the data */
+    for (i = 0; i < (*num_vals); ++i) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = (pmix_psquash.decode_int)(type, buffer->unpack_ptr, avail_size,
+                                       (uint8_t *) dest + i * val_size, &unpack_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* sanity checks */
+        if (unpack_size > max_size) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (unpack_size > avail_size) {
+            rc = PMIX_ERR_FATAL;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->unpack_ptr += unpack_size;
+    }
+
+    return PMIX_SUCCESS;
+}
+
+/*
+ * INT
+ */
+static pmix_status_t pmix42_bfrops_base_unpack_int(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, void *dest,
+                                                   int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_status_t ret;
+    pmix_data_type_t remote_type;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (false == pmix_psquash.int_type_is_encoded) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(regtypes, buffer, &remote_type))) {
+            return ret;
+        }
+        if (remote_type == BFROP_TYPE_INT) {
+            /* fast path it if the sizes are the same */
+            /* Turn around and unpack the real type */
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_INT, regtypes);
+        } else {
+            /* slow path - types are different sizes */
+            PMIX_BFROP_UNPACK_SIZE_MISMATCH(regtypes, int, remote_type, ret);
+        }
+    } else {
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_INT, regtypes);
+    }
+
+    return ret;
+}
+
+/*
+ * SIZE_T
+ */
+static pmix_status_t pmix42_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes,
+                                                     pmix_buffer_t *buffer, void *dest,
+                                                     int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_status_t ret;
+    pmix_data_type_t remote_type;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (false == pmix_psquash.int_type_is_encoded) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(regtypes, buffer, &remote_type))) {
+            PMIX_ERROR_LOG(ret);
+            return ret;
+        }
+        if (remote_type == BFROP_TYPE_SIZE_T) {
+            /* fast path it if the sizes are the same */
+            /* Turn around and unpack the real type */
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_SIZE_T, regtypes);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+            }
+        } else {
+            /* slow path - types are different sizes */
+            PMIX_BFROP_UNPACK_SIZE_MISMATCH(regtypes, size_t, remote_type, ret);
+        }
+    } else {
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_SIZE_T, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+        }
+    }
+    return ret;
+}
+
+/*
+ * Helpers for the structured types below. A string goes on the
+ * wire as its length (including the NULL terminator) encoded as an
+ * INT32, followed by the bytes, and ranks and directives are encoded
+ * as UINT32 - the helpers produce exactly what the generic path
+ * would without a type lookup and buffer check per member.
+ */
+static inline pmix_status_t pmix42_encode_int(pmix_data_type_t type, const void *src,
+                                              char **dst, size_t *used)
+{
+    pmix_status_t rc;
+    size_t pkg_size;
+
+    rc = (pmix_psquash.encode_int)(type, (void *) src, *dst, &pkg_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    *dst += pkg_size;
+    *used += pkg_size;
+    return PMIX_SUCCESS;
+}
+
+static inline pmix_status_t pmix42_encode_string(const char *str, size_t len,
+                                                 char **dst, size_t *used)
+{
+    pmix_status_t rc;
+    int32_t slen = len + 1;
+
+    rc = pmix42_encode_int(PMIX_INT32, &slen, dst, used);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    memcpy(*dst, str, slen);
+    *dst += slen;
+    *used += slen;
+    return PMIX_SUCCESS;
+}
+
+static inline void pmix42_commit_packed(pmix_buffer_t *buffer, size_t used)
+{
+    buffer->pack_ptr += used;
+    buffer->bytes_used += used;
+}
+
+static inline pmix_status_t pmix42_decode_int(pmix_buffer_t *buffer, pmix_data_type_t type,
+                                              size_t max_size, void *dest)
+{
+    pmix_status_t rc;
+    size_t avail_size, unpack_size;
+
+    if (buffer->pack_ptr == buffer->unpack_ptr) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+    rc = (pmix_psquash.decode_int)(type, buffer->unpack_ptr, avail_size, dest, &unpack_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (unpack_size > max_size) {
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (unpack_size > avail_size) {
+        rc = PMIX_ERR_FATAL;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    buffer->unpack_ptr += unpack_size;
+    return PMIX_SUCCESS;
+}
+
+/* unpack a string directly into a fixed-size field of maxlen+1
+ * bytes, truncating it as pmix_strncpy would. A NULL string
+ * is returned as PMIX_ERROR as these fields cannot be NULL */
+static inline pmix_status_t pmix42_decode_fixed_string(pmix_buffer_t *buffer, size_t int_size,
+                                                       char *dest, size_t maxlen)
+{
+    pmix_status_t rc;
+    int32_t len;
+    size_t n;
+
+    rc = pmix42_decode_int(buffer, PMIX_INT32, int_size, &len);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 == len) {
+        return PMIX_ERROR;
+    }
+    if (len < 0) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    if (pmix_bfrop_too_small(buffer, len)) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    n = ((size_t) len < maxlen) ? (size_t) len : maxlen;
+    memcpy(dest, buffer->unpack_ptr, n);
+    dest[n] = '\0';
+    buffer->unpack_ptr += len;
+    return PMIX_SUCCESS;
+}
+
+/*
+ * Keys go on the wire as a UINT32 code - one more than the index
+ * of the key in the dictionary of reserved attributes, or zero
+ * when the key is not in the dictionary, in which case the key
+ * string follows
+ */
+static inline uint32_t pmix42_key_code(const char *key)
+{
+    pmix_regattr_input_t *ptr;
+
+    if (NULL == key || !PMIX_CHECK_RESERVED_KEY(key)) {
+        return 0;
+    }
+    ptr = pmix_hash_lookup_key(UINT32_MAX, key);
+    if (NULL == ptr || PMIX_INDEX_BOUNDARY <= ptr->index) {
+        return 0;
+    }
+    return ptr->index + 1;
+}
+
+/* return the reserved key for the given code - the code has
+ * to have come from a peer using the same dictionary */
+static inline pmix_status_t pmix42_reserved_key(uint32_t code, const char **key)
+{
+    if (PMIX_INDEX_BOUNDARY < code) {
+        PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *key = pmix_dictionary[code - 1].string;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pmix42_pack_key(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                     char *key)
+{
+    pmix_status_t rc;
+    uint32_t code;
+
+    code = pmix42_key_code(key);
+    PMIX_BFROPS_PACK_TYPE(rc, buffer, &code, 1, PMIX_UINT32, regtypes);
+    if (PMIX_SUCCESS == rc && 0 == code) {
+        PMIX_BFROPS_PACK_TYPE(rc, buffer, &key, 1, PMIX_STRING, regtypes);
+    }
+    return rc;
+}
+
+/* a reserved key is returned in *rkey and points into the
+ * dictionary - anything else is returned in *key, which the
+ * caller must free */
+static pmix_status_t pmix42_unpack_key(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                       const char **rkey, char **key)
+{
+    pmix_status_t rc;
+    uint32_t code;
+    int32_t m = 1;
+
+    *rkey = NULL;
+    *key = NULL;
+    PMIX_BFROPS_UNPACK_TYPE(rc, buffer, &code, &m, PMIX_UINT32, regtypes);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 != code) {
+        return pmix42_reserved_key(code, rkey);
+    }
+    m = 1;
+    PMIX_BFROPS_UNPACK_TYPE(rc, buffer, key, &m, PMIX_STRING, regtypes);
+    return rc;
+}
+
+/*
+ * PMIX_PROC
+ */
+static pmix_status_t pmix42_bfrops_base_pack_proc(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_proc_t *proc = (pmix_proc_t *) src;
+    pmix_status_t rc;
+    int32_t i;
+    size_t int_size, rank_size, total, used = 0;
+    char *dst;
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &rank_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* size the buffer once for the entire array */
+    total = 0;
+    for (i = 0; i < num_vals; ++i) {
+        total += int_size + strlen(proc[i].nspace) + 1 + rank_size;
+    }
+    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, total))) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < num_vals; ++i) {
+        rc = pmix42_encode_string(proc[i].nspace, strlen(proc[i].nspace), &dst, &used);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        rc = pmix42_encode_int(PMIX_UINT32, &proc[i].rank, &dst, &used);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    pmix42_commit_packed(buffer, used);
+    return rc;
+}
+
+static pmix_status_t pmix42_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_proc_t *ptr = (pmix_proc_t *) dest;
+    pmix_status_t rc;
+    int32_t i, n = *num_vals;
+    size_t int_size, rank_size;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix42_bfrop_unpack: %d procs", n);
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &rank_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < n; ++i) {
+        memset(&ptr[i], 0, sizeof(pmix_proc_t));
+        rc = pmix42_decode_fixed_string(buffer, int_size, ptr[i].nspace, PMIX_MAX_NSLEN);
+        if (PMIX_SUCCESS != rc) {
+            if (PMIX_ERROR == rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+            return rc;
+        }
+        rc = pmix42_decode_int(buffer, PMIX_UINT32, rank_size, &ptr[i].rank);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/*
+ * PMIX_INFO
+ */
+static pmix_status_t pmix42_bfrops_base_pack_info(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_info_t *info = (pmix_info_t *) src;
+    pmix_status_t rc;
+    int32_t i;
+    uint32_t code;
+    size_t int_size, flag_size, keylen, used;
+    char *dst;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &flag_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < num_vals; ++i) {
+        /* the key and directives are written in one step - the
+         * value has to go through the generic path */
+        code = pmix42_key_code(info[i].key);
+        keylen = (0 == code) ? strlen(info[i].key) : 0;
+        if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, flag_size
+                                                    + (0 == code ? int_size + keylen + 1 : 0)
+                                                    + flag_size))) {
+            rc = PMIX_ERR_OUT_OF_RESOURCE;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        used = 0;
+        rc = pmix42_encode_int(PMIX_UINT32, &code, &dst, &used);
+        if (PMIX_SUCCESS == rc && 0 == code) {
+            rc = pmix42_encode_string(info[i].key, keylen, &dst, &used);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix42_encode_int(PMIX_UINT32, &info[i].flags, &dst, &used);
+        }
+        pmix42_commit_packed(buffer, used);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* pack the type */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(regtypes, buffer, info[i].value.type))) {
+            return rc;
+        }
+        /* pack value */
+        if (PMIX_SUCCESS != (rc = pmix_bfrops_base_pack_val(regtypes, buffer, &info[i].value))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pmix42_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_info_t *ptr = (pmix_info_t *) dest;
+    pmix_status_t rc;
+    int32_t i, n = *num_vals;
+    uint32_t code;
+    const char *rkey;
+    size_t int_size, flag_size;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix42_bfrop_unpack: %d info", n);
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_INT32, &int_size))
+        || PMIX_SUCCESS != (rc = pmix_psquash.get_max_size(PMIX_UINT32, &flag_size))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (i = 0; i < n; ++i) {
+        memset(ptr[i].key, 0, sizeof(ptr[i].key));
+        memset(&ptr[i].value, 0, sizeof(pmix_value_t));
+        rc = pmix42_decode_int(buffer, PMIX_UINT32, flag_size, &code);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (0 != code) {
+            rc = pmix42_reserved_key(code, &rkey);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+            pmix_strncpy(ptr[i].key, rkey, PMIX_MAX_KEYLEN);
+        } else {
+            rc = pmix42_decode_fixed_string(buffer, int_size, ptr[i].key, PMIX_MAX_KEYLEN);
+            if (PMIX_SUCCESS != rc) {
+                if (PMIX_ERROR != rc) {
+                    PMIX_ERROR_LOG(rc);
+                }
+                return rc;
+            }
+        }
+        rc = pmix42_decode_int(buffer, PMIX_UINT32, flag_size, &ptr[i].flags);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* unpack value - directly into the statically-defined
+         * value structure to avoid the malloc */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(regtypes, buffer, &ptr[i].value.type))) {
+            return rc;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i].value))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/*
+ * PMIX_PDATA
+ */
+static pmix_status_t pmix42_bfrops_base_pack_pdata(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, const void *src,
+                                                   int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_pdata_t *pdata = (pmix_pdata_t *) src;
+    pmix_status_t rc;
+    int32_t i;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    for (i = 0; i < num_vals; ++i) {
+        /* pack the proc */
+        PMIX_BFROPS_PACK_TYPE(rc, buffer, &pdata[i].proc, 1, PMIX_PROC, regtypes);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* pack key */
+        rc = pmix42_pack_key(regtypes, buffer, pdata[i].key);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* pack the type */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(regtypes, buffer, pdata[i].value.type))) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* pack value */
+        if (PMIX_SUCCESS != (rc = pmix_bfrops_base_pack_val(regtypes, buffer, &pdata[i].value))) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pmix42_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes,
+                                                     pmix_buffer_t *buffer, void *dest,
+                                                     int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_pdata_t *ptr = (pmix_pdata_t *) dest;
+    pmix_status_t rc;
+    int32_t i, m, n = *num_vals;
+    const char *rkey;
+    char *tmp;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix42_bfrop_unpack: %d pdata", n);
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    for (i = 0; i < n; ++i) {
+        PMIX_PDATA_CONSTRUCT(&ptr[i]);
+        /* unpack the proc */
+        m = 1;
+        PMIX_BFROPS_UNPACK_TYPE(rc, buffer, &ptr[i].proc, &m, PMIX_PROC, regtypes);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* unpack key */
+        rc = pmix42_unpack_key(regtypes, buffer, &rkey, &tmp);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (NULL != rkey) {
+            pmix_strncpy(ptr[i].key, rkey, PMIX_MAX_KEYLEN);
+        } else if (NULL != tmp) {
+            pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
+            free(tmp);
+        } else {
+            PMIX_ERROR_LOG(PMIX_ERROR);
+            return PMIX_ERROR;
+        }
+        /* unpack value - directly into the statically-defined
+         * value structure to avoid the malloc */
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_get_data_type(regtypes, buffer, &ptr[i].value.type))) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i].value))) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/*
+ * PMIX_KVAL
+ */
+static pmix_status_t pmix42_bfrops_base_pack_kval(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_kval_t *ptr = (pmix_kval_t *) src;
+    pmix_status_t rc;
+    int32_t i;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    for (i = 0; i < num_vals; ++i) {
+        /* pack the key */
+        rc = pmix42_pack_key(regtypes, buffer, ptr[i].key);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        /* pack the value */
+        PMIX_BFROPS_PACK_TYPE(rc, buffer, ptr[i].value, 1, PMIX_VALUE, regtypes);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pmix42_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_kval_t *ptr = (pmix_kval_t *) dest;
+    pmix_status_t rc;
+    int32_t i, m, n = *num_vals;
+    const char *rkey;
+
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix42_bfrop_unpack: %d kvals", n);
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    for (i = 0; i < n; ++i) {
+        PMIX_CONSTRUCT(&ptr[i], pmix_kval_t);
+        /* unpack the key */
+        rc = pmix42_unpack_key(regtypes, buffer, &rkey, &ptr[i].key);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (NULL != rkey) {
+            ptr[i].key = strdup(rkey);
+        }
+        /* allocate the space */
+        ptr[i].value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        /* unpack the value */
+        m = 1;
+        PMIX_BFROPS_UNPACK_TYPE(rc, buffer, ptr[i].value, &m, PMIX_VALUE, regtypes);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
@@ -75,6 +75,8 @@ struct pmix_gds_globals_t {
     bool initialized;
     bool selected;
     char *all_mods;
+    int dcache_size;
+    bool dcache_negative;
 };
 
 typedef enum {
@@ -89,9 +91,26 @@ typedef uint8_t pmix_gds_modex_blob_info_t;
 
 #define PMIX_GDS_COLLECT_BIT 0x0001
 #define PMIX_GDS_KEYMAP_BIT  0x0002
+#define PMIX_GDS_VALTAB_BIT  0x0004
 
 #define PMIX_GDS_KEYMAP_IS_SET(byte)  (PMIX_GDS_KEYMAP_BIT & (byte))
 #define PMIX_GDS_COLLECT_IS_SET(byte) (PMIX_GDS_COLLECT_BIT & (byte))
+#define PMIX_GDS_VALTAB_IS_SET(byte)  (PMIX_GDS_VALTAB_BIT & (byte))
+
+/* values held by more than one rank of a modex blob - the blob
+ * header carries each of them once, and the kvals of the ranks
+ * refer to them by index. Values unpacked by reference point
+ * into the table, so holders of such a value must keep the
+ * table alive instead of releasing the value */
+typedef struct {
+    pmix_object_t super;
+    pmix_value_t *vals;
+    uint32_t nvals;
+} pmix_gds_modex_vtab_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_gds_modex_vtab_t);
+
+#define PMIX_GDS_MODEX_VTAB_HOLDS(vt, v) \
+    (NULL != (vt) && (v) >= (vt)->vals && (v) < (vt)->vals + (vt)->nvals)
 
 typedef struct pmix_gds_globals_t pmix_gds_globals_t;
 
@@ -99,7 +118,9 @@ typedef void *pmix_gds_base_ctx_t;
 typedef pmix_status_t (*pmix_gds_base_store_modex_cb_fn_t)(pmix_gds_base_ctx_t ctx,
                                                            pmix_proc_t *proc,
                                                            pmix_gds_modex_key_fmt_t key_fmt,
-                                                           char **kmap, pmix_buffer_t *pbkt);
+                                                           char **kmap,
+                                                           pmix_gds_modex_vtab_t *vtab,
+                                                           pmix_buffer_t *pbkt);
 
 PMIX_EXPORT extern pmix_gds_globals_t pmix_gds_globals;
 
@@ -120,18 +141,63 @@ PMIX_EXPORT pmix_gds_base_module_t *pmix_gds_base_assign_module(pmix_info_t *inf
  */
 PMIX_EXPORT pmix_status_t pmix_gds_base_setup_fork(const pmix_proc_t *proc, char ***env);
 
+/**
+ * Offer a job-level value registered after the job info of the
+ * nspace was delivered to every active module that can publish it
+ * to the clients of the nspace
+ */
+PMIX_EXPORT void pmix_gds_base_update_job_info(const char *nspace, pmix_kval_t *kv);
+
+/**
+ * Refresh the job-level info of every nspace we know without asking
+ * the server, flushing whatever was resolved from data that changed.
+ * Returns PMIX_ERR_NOT_SUPPORTED if any of their modules cannot.
+ */
+PMIX_EXPORT pmix_status_t pmix_gds_base_refresh(void);
+
+/* direct-read cache for PMIx_Get - lookups may be made from any
+ * thread without locking. Callers sample the generation before
+ * fetching a value and pass it to the insert so that a value made
+ * stale by an intervening store is not cached. Inserting a NULL
+ * value records that the key is absent, which the lookup reports
+ * as PMIX_ERR_NOT_FOUND and pmix_gds_base_dcache_absent as true
+ * until the next store.
+ *
+ * A borrowed value is a shallow copy of the cached one, and adopting
+ * a value hands it to the cache (inserting it if gen is current and
+ * a proc and key are given) and returns a borrowed copy of it. What
+ * a borrowed value points to remains valid as long as the generation
+ * is the epoch returned with it */
+PMIX_EXPORT uint64_t pmix_gds_base_dcache_generation(void);
+PMIX_EXPORT pmix_status_t pmix_gds_base_dcache_lookup(const pmix_proc_t *proc, const char *key,
+                                                      pmix_value_t *dest);
+PMIX_EXPORT pmix_status_t pmix_gds_base_dcache_borrow(const pmix_proc_t *proc, const char *key,
+                                                      pmix_value_t *dest);
+PMIX_EXPORT bool pmix_gds_base_dcache_absent(const pmix_proc_t *proc, const char *key);
+PMIX_EXPORT void pmix_gds_base_dcache_insert(uint64_t gen, const pmix_proc_t *proc,
+                                             const char *key, const pmix_value_t *val);
+PMIX_EXPORT pmix_status_t pmix_gds_base_dcache_adopt(uint64_t gen, const pmix_proc_t *proc,
+                                                     const char *key, pmix_value_t *val,
+                                                     pmix_value_t *dest, uint64_t *epoch);
+PMIX_EXPORT void pmix_gds_base_dcache_finalize(void);
+
 PMIX_EXPORT pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace,
                                                     pmix_buffer_t *buff, pmix_gds_base_ctx_t ctx,
                                                     pmix_gds_base_store_modex_cb_fn_t cb_fn,
                                                     void *cbdata);
 
+/* a non-NULL vref packs the kval for a blob that carries a value
+ * table: zero packs the value inline, anything else refers to
+ * entry vref-1 of the table. Likewise, a non-NULL vtab unpacks
+ * such a kval */
 PMIX_EXPORT
 pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
-                                            char ***kmap, pmix_kval_t *kv);
+                                            char ***kmap, pmix_kval_t *kv, const uint32_t *vref);
 
 PMIX_EXPORT
 pmix_status_t pmix_gds_base_modex_unpack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
-                                              char **kmap, pmix_kval_t *kv);
+                                              char **kmap, pmix_gds_modex_vtab_t *vtab,
+                                              pmix_kval_t *kv);
 END_C_DECLS
 
 #endif
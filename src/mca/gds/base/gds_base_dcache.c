@@ -0,0 +1,394 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "pmix_common.h"
+
+#include <stdlib.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_mutex.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/gds/base/base.h"
+
+/* Values returned by a blocking PMIx_Get are remembered here so
+ * that the next request for the same nspace/rank/key can be
+ * answered by the calling thread without shifting into the
+ * progress thread.
+ *
+ * Readers never lock. Entries are immutable once published in a
+ * table slot, and a table is never modified after it has been
+ * retired - any change to the data held by a GDS component simply
+ * detaches the current table so the next insert starts a new one.
+ * A retired table is only freed once no reader is inside a lookup,
+ * which readers advertise by bumping a counter around their probe.
+ *
+ * A value fetched before a store must not be cached after it, so
+ * each insert carries the generation observed before the fetch
+ * and is dropped if a flush happened in the meantime.
+ *
+ * Keys that were looked for and not found are remembered the same
+ * way, as optional keys tend to be probed over and over. As with
+ * values, any store invalidates them - including the ones made when
+ * a commit or fence completes.
+ *
+ * PMIx_Get_view hands out shallow copies of entries, so whatever a
+ * value points to is only valid until the table holding it is freed
+ * - i.e., until the generation moves on. Values fetched for a view
+ * that cannot be looked up again are kept on the loose list of the
+ * current table so they share its lifetime */
+
+typedef struct dcache_entry_t {
+    struct dcache_entry_t *next;
+    uint64_t hash;
+    pmix_proc_t proc;
+    char key[PMIX_MAX_KEYLEN + 1];
+    bool absent;
+    pmix_value_t value;
+} dcache_entry_t;
+
+typedef struct dcache_table_t {
+    struct dcache_table_t *next;
+    size_t mask;
+    size_t count;
+    dcache_entry_t *loose;
+    dcache_entry_t *slots[];
+} dcache_table_t;
+
+static dcache_table_t *current = NULL;
+static dcache_table_t *retired = NULL;
+static uint64_t generation = 0;
+static int readers = 0;
+static pmix_mutex_t dcache_lock = PMIX_MUTEX_STATIC_INIT;
+
+static uint64_t dcache_hash(const pmix_proc_t *proc, const char *key)
+{
+    uint64_t h = 14695981039346656037ULL;
+    const unsigned char *c;
+
+    for (c = (const unsigned char *) proc->nspace; '\0' != *c; c++) {
+        h = (h ^ *c) * 1099511628211ULL;
+    }
+    h = (h ^ proc->rank) * 1099511628211ULL;
+    for (c = (const unsigned char *) key; '\0' != *c; c++) {
+        h = (h ^ *c) * 1099511628211ULL;
+    }
+    return h;
+}
+
+static void table_free(dcache_table_t *tbl)
+{
+    dcache_entry_t *e;
+    size_t n;
+
+    for (n = 0; n <= tbl->mask; n++) {
+        if (NULL != tbl->slots[n]) {
+            PMIX_VALUE_DESTRUCT(&tbl->slots[n]->value);
+            free(tbl->slots[n]);
+        }
+    }
+    while (NULL != (e = tbl->loose)) {
+        tbl->loose = e->next;
+        PMIX_VALUE_DESTRUCT(&e->value);
+        free(e);
+    }
+    free(tbl);
+}
+
+/* must be called with the lock held */
+static dcache_table_t *current_table(void)
+{
+    dcache_table_t *tbl;
+    size_t nslots;
+
+    tbl = current;
+    if (NULL == tbl) {
+        for (nslots = 16; nslots < (size_t) pmix_gds_globals.dcache_size; nslots <<= 1) {
+            continue;
+        }
+        tbl = (dcache_table_t *) calloc(1, sizeof(dcache_table_t)
+                                           + nslots * sizeof(dcache_entry_t *));
+        if (NULL == tbl) {
+            return NULL;
+        }
+        tbl->mask = nslots - 1;
+        __atomic_store_n(&current, tbl, __ATOMIC_SEQ_CST);
+    }
+    return tbl;
+}
+
+/* must be called with the lock held */
+static void retire_current(void)
+{
+    dcache_table_t *tbl;
+
+    tbl = __atomic_exchange_n(&current, NULL, __ATOMIC_SEQ_CST);
+    if (NULL != tbl) {
+        tbl->next = retired;
+        retired = tbl;
+    }
+    if (NULL != retired && 0 == __atomic_load_n(&readers, __ATOMIC_SEQ_CST)) {
+        while (NULL != (tbl = retired)) {
+            retired = tbl->next;
+            table_free(tbl);
+        }
+    }
+}
+
+uint64_t pmix_gds_base_dcache_generation(void)
+{
+    return __atomic_load_n(&generation, __ATOMIC_SEQ_CST);
+}
+
+/* probe for an entry, copying its value to dest if there is one -
+ * a shallow copy leaves dest pointing into the entry. Returns
+ * PMIX_SUCCESS if the value was copied, PMIX_ERR_NOT_FOUND if there
+ * is no entry, and PMIX_ERR_NOT_AVAILABLE if the entry records the
+ * key as absent */
+static pmix_status_t probe(const pmix_proc_t *proc, const char *key, pmix_value_t *dest,
+                           bool shallow)
+{
+    dcache_table_t *tbl;
+    dcache_entry_t *e;
+    pmix_status_t rc = PMIX_ERR_NOT_FOUND;
+    uint64_t h;
+    size_t n, i;
+
+    if (NULL == __atomic_load_n(&current, __ATOMIC_RELAXED)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    h = dcache_hash(proc, key);
+
+    __atomic_add_fetch(&readers, 1, __ATOMIC_SEQ_CST);
+    tbl = __atomic_load_n(&current, __ATOMIC_SEQ_CST);
+    if (NULL != tbl) {
+        for (n = 0; n <= tbl->mask; n++) {
+            i = (h + n) & tbl->mask;
+            e = __atomic_load_n(&tbl->slots[i], __ATOMIC_ACQUIRE);
+            if (NULL == e) {
+                break;
+            }
+            if (e->hash == h && PMIX_CHECK_PROCID(&e->proc, proc) &&
+                PMIX_CHECK_KEY(e, key)) {
+                if (e->absent) {
+                    rc = PMIX_ERR_NOT_AVAILABLE;
+                } else if (NULL != dest && shallow) {
+                    memcpy(dest, &e->value, sizeof(pmix_value_t));
+                    rc = PMIX_SUCCESS;
+                } else if (NULL != dest) {
+                    rc = PMIx_Value_xfer(dest, &e->value);
+                } else {
+                    rc = PMIX_SUCCESS;
+                }
+                break;
+            }
+        }
+    }
+    __atomic_sub_fetch(&readers, 1, __ATOMIC_SEQ_CST);
+    return rc;
+}
+
+pmix_status_t pmix_gds_base_dcache_lookup(const pmix_proc_t *proc, const char *key,
+                                          pmix_value_t *dest)
+{
+    pmix_status_t rc;
+
+    rc = probe(proc, key, dest, false);
+    if (PMIX_ERR_NOT_AVAILABLE == rc) {
+        rc = PMIX_ERR_NOT_FOUND;
+    }
+    return rc;
+}
+
+pmix_status_t pmix_gds_base_dcache_borrow(const pmix_proc_t *proc, const char *key,
+                                          pmix_value_t *dest)
+{
+    pmix_status_t rc;
+
+    rc = probe(proc, key, dest, true);
+    if (PMIX_ERR_NOT_AVAILABLE == rc) {
+        rc = PMIX_ERR_NOT_FOUND;
+    }
+    return rc;
+}
+
+bool pmix_gds_base_dcache_absent(const pmix_proc_t *proc, const char *key)
+{
+    return (PMIX_ERR_NOT_AVAILABLE == probe(proc, key, NULL, false));
+}
+
+void pmix_gds_base_dcache_insert(uint64_t gen, const pmix_proc_t *proc, const char *key,
+                                 const pmix_value_t *val)
+{
+    dcache_table_t *tbl;
+    dcache_entry_t *e;
+    uint64_t h;
+    size_t n, i;
+
+    if (0 >= pmix_gds_globals.dcache_size) {
+        return;
+    }
+    if (NULL == val && !pmix_gds_globals.dcache_negative) {
+        return;
+    }
+
+    pmix_mutex_lock(&dcache_lock);
+    if (gen != __atomic_load_n(&generation, __ATOMIC_SEQ_CST)) {
+        goto done;
+    }
+    tbl = current_table();
+    if (NULL == tbl) {
+        goto done;
+    }
+    /* keep the probe sequences short */
+    if (4 * (tbl->count + 1) > 3 * (tbl->mask + 1)) {
+        goto check;
+    }
+
+    h = dcache_hash(proc, key);
+    for (n = 0; n <= tbl->mask; n++) {
+        i = (h + n) & tbl->mask;
+        e = tbl->slots[i];
+        if (NULL == e) {
+            break;
+        }
+        if (e->hash == h && PMIX_CHECK_PROCID(&e->proc, proc) && PMIX_CHECK_KEY(e, key)) {
+            /* already there - it cannot be stale as any
+             * store would have detached this table */
+            goto check;
+        }
+    }
+    e = (dcache_entry_t *) calloc(1, sizeof(dcache_entry_t));
+    if (NULL == e) {
+        goto check;
+    }
+    e->hash = h;
+    PMIX_LOAD_PROCID(&e->proc, proc->nspace, proc->rank);
+    pmix_strncpy(e->key, key, PMIX_MAX_KEYLEN);
+    if (NULL == val) {
+        e->absent = true;
+    } else if (PMIX_SUCCESS != PMIx_Value_xfer(&e->value, val)) {
+        PMIX_VALUE_DESTRUCT(&e->value);
+        free(e);
+        goto check;
+    }
+    __atomic_store_n(&tbl->slots[i], e, __ATOMIC_RELEASE);
+    ++tbl->count;
+
+check:
+    /* a flush that raced with us may not have seen the table we
+     * just published, so drop it ourselves */
+    if (gen != __atomic_load_n(&generation, __ATOMIC_SEQ_CST)) {
+        retire_current();
+    }
+
+done:
+    pmix_mutex_unlock(&dcache_lock);
+}
+
+pmix_status_t pmix_gds_base_dcache_adopt(uint64_t gen, const pmix_proc_t *proc, const char *key,
+                                         pmix_value_t *val, pmix_value_t *dest, uint64_t *epoch)
+{
+    dcache_table_t *tbl;
+    dcache_entry_t *e;
+    uint64_t h = 0;
+    size_t n, i = 0;
+    bool slot = false;
+
+    e = (dcache_entry_t *) calloc(1, sizeof(dcache_entry_t));
+    if (NULL == e) {
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_mutex_lock(&dcache_lock);
+    tbl = current_table();
+    if (NULL == tbl) {
+        pmix_mutex_unlock(&dcache_lock);
+        free(e);
+        return PMIX_ERR_NOMEM;
+    }
+    *epoch = __atomic_load_n(&generation, __ATOMIC_SEQ_CST);
+
+    /* take the value over - only the shell is ours to free */
+    memcpy(&e->value, val, sizeof(pmix_value_t));
+    pmix_free(val);
+    memcpy(dest, &e->value, sizeof(pmix_value_t));
+
+    /* make it visible to lookups if it is current and there is room */
+    if (NULL != proc && NULL != key && gen == *epoch && 0 < pmix_gds_globals.dcache_size
+        && 4 * (tbl->count + 1) <= 3 * (tbl->mask + 1)) {
+        h = dcache_hash(proc, key);
+        slot = true;
+        for (n = 0; n <= tbl->mask; n++) {
+            i = (h + n) & tbl->mask;
+            if (NULL == tbl->slots[i]) {
+                break;
+            }
+            if (tbl->slots[i]->hash == h && PMIX_CHECK_PROCID(&tbl->slots[i]->proc, proc)
+                && PMIX_CHECK_KEY(tbl->slots[i], key)) {
+                slot = false;
+                break;
+            }
+        }
+    }
+    if (slot) {
+        e->hash = h;
+        PMIX_LOAD_PROCID(&e->proc, proc->nspace, proc->rank);
+        pmix_strncpy(e->key, key, PMIX_MAX_KEYLEN);
+        __atomic_store_n(&tbl->slots[i], e, __ATOMIC_RELEASE);
+        ++tbl->count;
+    } else {
+        e->next = tbl->loose;
+        tbl->loose = e;
+    }
+
+    /* a flush that raced with us may not have seen the table - the
+     * caller's epoch is already stale in that case */
+    if (*epoch != __atomic_load_n(&generation, __ATOMIC_SEQ_CST)) {
+        retire_current();
+    }
+    pmix_mutex_unlock(&dcache_lock);
+    return PMIX_SUCCESS;
+}
+
+void pmix_gds_base_dcache_flush(void)
+{
+    __atomic_add_fetch(&generation, 1, __ATOMIC_SEQ_CST);
+    if (NULL == __atomic_load_n(&current, __ATOMIC_SEQ_CST) &&
+        NULL == __atomic_load_n(&retired, __ATOMIC_RELAXED)) {
+        return;
+    }
+    pmix_mutex_lock(&dcache_lock);
+    retire_current();
+    pmix_mutex_unlock(&dcache_lock);
+}
+
+void pmix_gds_base_dcache_finalize(void)
+{
+    dcache_table_t *tbl;
+
+    pmix_mutex_lock(&dcache_lock);
+    __atomic_add_fetch(&generation, 1, __ATOMIC_SEQ_CST);
+    tbl = __atomic_exchange_n(&current, NULL, __ATOMIC_SEQ_CST);
+    if (NULL != tbl) {
+        tbl->next = retired;
+        retired = tbl;
+    }
+    /* nobody can be looking anymore */
+    while (NULL != (tbl = retired)) {
+        retired = tbl->next;
+        table_free(tbl);
+    }
+    pmix_mutex_unlock(&dcache_lock);
+}
@@ -88,6 +88,68 @@ pmix_status_t pmix_gds_base_setup_fork(const pmix_proc_t *proc, char ***env)
     return PMIX_SUCCESS;
 }
 
+void pmix_gds_base_update_job_info(const char *nspace, pmix_kval_t *kv)
+{
+    pmix_gds_base_active_module_t *active;
+    pmix_status_t rc;
+
+    if (!pmix_gds_globals.initialized) {
+        return;
+    }
+
+    PMIX_LIST_FOREACH (active, &pmix_gds_globals.actives, pmix_gds_base_active_module_t) {
+        if (NULL == active->module->update_job_info) {
+            continue;
+        }
+        rc = active->module->update_job_info(nspace, kv);
+        if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_SUPPORTED != rc && PMIX_ERR_NOT_FOUND != rc) {
+            pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                                "gds:%s cannot publish update of %s for nspace %s: %s",
+                                active->module->name, kv->key, nspace, PMIx_Error_string(rc));
+        }
+    }
+}
+
+pmix_status_t pmix_gds_base_refresh(void)
+{
+    pmix_namespace_t *ns;
+    pmix_status_t rc;
+    bool changed, flush = false;
+
+    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (NULL == ns->compat.gds) {
+            continue;
+        }
+        if (NULL == ns->compat.gds->refresh) {
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+        changed = false;
+        rc = ns->compat.gds->refresh(ns->nspace, &changed);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (changed) {
+            pmix_namespace_flush_resolved(ns);
+            flush = true;
+        }
+    }
+    if (flush) {
+        pmix_gds_base_dcache_flush();
+    }
+    return PMIX_SUCCESS;
+}
+
+/* the blobs are unpacked as views of the buffer they came in, so
+ * the buffer they are loaded into must only release its payload
+ * if the bfrops module made a copy of it */
+static void release_blob(pmix_buffer_t *bkt, pmix_buffer_t *src)
+{
+    if (PMIX_BUFFER_CONTAINS(src, bkt->base_ptr)) {
+        bkt->base_ptr = NULL;
+    }
+    PMIX_DESTRUCT(bkt);
+}
+
 pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_buffer_t *buff,
                                         pmix_gds_base_ctx_t ctx,
                                         pmix_gds_base_store_modex_cb_fn_t cb_fn, void *cbdata)
@@ -105,14 +167,15 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
     pmix_nspace_caddy_t *nm;
     bool found;
     char **kmap = NULL;
-    uint32_t kmap_size;
+    uint32_t kmap_size, n;
     pmix_gds_modex_key_fmt_t kmap_type;
     pmix_gds_modex_blob_info_t blob_info_byte = 0;
+    pmix_gds_modex_vtab_t *vtab = NULL;
 
     /* Loop over the enclosed byte object envelopes and
      * store them in our GDS module */
     cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buff, &bo, &cnt, PMIX_BYTE_OBJECT);
+    PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, buff, &bo, &cnt, PMIX_BYTE_OBJECT);
 
     /* If the collect flag is set, we should have some data for unpacking */
     if ((PMIX_COLLECT_YES == trk->collect_type)
@@ -128,13 +191,13 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
         PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &blob_info_byte, &cnt, PMIX_BYTE);
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
             /* no data was returned, so we are done with this blob */
-            PMIX_DESTRUCT(&bkt);
+            release_blob(&bkt, buff);
             break;
         }
         if (PMIX_SUCCESS != rc) {
             /* we have an error */
             PMIX_ERROR_LOG(rc);
-            PMIX_DESTRUCT(&bkt);
+            release_blob(&bkt, buff);
             goto exit;
         }
         /* Check that this blob was accumulated with the same data collection
@@ -155,11 +218,11 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
             PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &kmap_size, &cnt, PMIX_UINT32);
             if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
                 rc = PMIX_SUCCESS;
-                PMIX_DESTRUCT(&bkt);
+                release_blob(&bkt, buff);
                 break;
             } else if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&bkt);
+                release_blob(&bkt, buff);
                 break;
             }
 
@@ -175,19 +238,46 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
             PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, kmap, &cnt, PMIX_STRING);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&bkt);
+                release_blob(&bkt, buff);
                 goto exit;
             }
             if (pmix_argv_count(kmap) != (int) kmap_size) {
                 rc = PMIX_ERR_UNPACK_FAILURE;
                 PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&bkt);
+                release_blob(&bkt, buff);
+                goto exit;
+            }
+        }
+        if (PMIX_GDS_VALTAB_IS_SET(blob_info_byte)) {
+            /* unpack the values shared by the ranks of this blob */
+            vtab = PMIX_NEW(pmix_gds_modex_vtab_t);
+            if (NULL == vtab) {
+                rc = PMIX_ERR_NOMEM;
+                release_blob(&bkt, buff);
+                goto exit;
+            }
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &vtab->nvals, &cnt, PMIX_UINT32);
+            if (PMIX_SUCCESS == rc && 0 < vtab->nvals) {
+                PMIX_VALUE_CREATE(vtab->vals, vtab->nvals);
+                if (NULL == vtab->vals) {
+                    rc = PMIX_ERR_NOMEM;
+                }
+                for (n = 0; PMIX_SUCCESS == rc && n < vtab->nvals; n++) {
+                    cnt = 1;
+                    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &vtab->vals[n], &cnt,
+                                       PMIX_VALUE);
+                }
+            }
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                release_blob(&bkt, buff);
                 goto exit;
             }
         }
         /* unpack the enclosed blobs from the various peers */
         cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
         while (PMIX_SUCCESS == rc) {
             /* unpack all the kval's from this peer and store them in
              * our GDS. Note that PMIx by design holds all data at
@@ -233,7 +323,7 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
 
             /* call a specific GDS function to storing
              * part of the process data */
-            rc = cb_fn(ctx, &proc, kmap_type, kmap, &pbkt);
+            rc = cb_fn(ctx, &proc, kmap_type, kmap, vtab, &pbkt);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 pbkt.base_ptr = NULL;
@@ -242,12 +332,17 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
             }
             pbkt.base_ptr = NULL;
             PMIX_DESTRUCT(&pbkt);
-            PMIX_BYTE_OBJECT_DESTRUCT(&bo2);
+            PMIX_BFROPS_VIEW_FREE(&bkt, bo2.bytes);
             /* get the next blob */
             cnt = 1;
-            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+            PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+        }
+        release_blob(&bkt, buff);
+        /* anything stored by reference holds its own */
+        if (NULL != vtab) {
+            PMIX_RELEASE(vtab);
+            vtab = NULL;
         }
-        PMIX_DESTRUCT(&bkt);
 
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
             rc = PMIX_SUCCESS;
@@ -257,7 +352,7 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
         }
         /* unpack and process the next blob */
         cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buff, &bo, &cnt, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, buff, &bo, &cnt, PMIX_BYTE_OBJECT);
     }
 
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
@@ -266,6 +361,9 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
         PMIX_ERROR_LOG(rc);
     }
 exit:
+    if (NULL != vtab) {
+        PMIX_RELEASE(vtab);
+    }
     pmix_argv_free(kmap);
     return rc;
 }
@@ -282,9 +380,13 @@ exit:
  * buf - output buffer to pack key-values
  *
  * kv - pmix key-value pair
+ *
+ * vref - if not NULL, the reference to the value table of the
+ *        blob packed ahead of the value - the value itself only
+ *        follows if the reference is zero
  */
 pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
-                                            char ***kmap, pmix_kval_t *kv)
+                                            char ***kmap, pmix_kval_t *kv, const uint32_t *vref)
 {
     uint32_t key_idx;
     pmix_status_t rc = PMIX_SUCCESS;
@@ -301,14 +403,16 @@ pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pm
             PMIX_ERROR_LOG(rc);
             return rc;
         }
-        /* pack key-value */
-        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, kv->value, 1, PMIX_VALUE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
+    } else if (PMIX_MODEX_KEY_NATIVE_FMT == key_fmt) {
+        if (NULL == vref) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, kv, 1, PMIX_KVAL);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
             return rc;
         }
-    } else if (PMIX_MODEX_KEY_NATIVE_FMT == key_fmt) {
-        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, kv, 1, PMIX_KVAL);
+        /* pack key-name */
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &kv->key, 1, PMIX_STRING);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -319,6 +423,23 @@ pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pm
         return rc;
     }
 
+    if (NULL != vref) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, (uint32_t *) vref, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (0 != *vref) {
+            return PMIX_SUCCESS;
+        }
+    }
+    /* pack key-value */
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, kv->value, 1, PMIX_VALUE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
     return PMIX_SUCCESS;
 }
 
@@ -330,13 +451,17 @@ pmix_status_t pmix_gds_base_modex_pack_kval(pmix_gds_modex_key_fmt_t key_fmt, pm
  *
  * buf - input buffer to unpack key-values
  *
+ * vtab - if not NULL, the value table of the blob - a value
+ *        packed by reference is left pointing into the table
+ *
  * kv - unpacked pmix key-value pair
  */
 pmix_status_t pmix_gds_base_modex_unpack_kval(pmix_gds_modex_key_fmt_t key_fmt, pmix_buffer_t *buf,
-                                              char **kmap, pmix_kval_t *kv)
+                                              char **kmap, pmix_gds_modex_vtab_t *vtab,
+                                              pmix_kval_t *kv)
 {
     int32_t cnt;
-    uint32_t key_idx;
+    uint32_t key_idx, vref = 0;
     pmix_status_t rc = PMIX_SUCCESS;
 
     if (PMIX_MODEX_KEY_KEYMAP_FMT == key_fmt) {
@@ -352,18 +477,13 @@ pmix_status_t pmix_gds_base_modex_unpack_kval(pmix_gds_modex_key_fmt_t key_fmt,
             return rc;
         }
         kv->key = strdup(kmap[key_idx]);
+    } else if (PMIX_MODEX_KEY_NATIVE_FMT == key_fmt) {
         cnt = 1;
-        PMIX_VALUE_CREATE(kv->value, 1);
-        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, kv->value, &cnt, PMIX_VALUE);
-        if (PMIX_SUCCESS != rc) {
-            free(kv->key);
-            PMIX_VALUE_RELEASE(kv->value);
-            PMIX_ERROR_LOG(rc);
+        if (NULL == vtab) {
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, kv, &cnt, PMIX_KVAL);
             return rc;
         }
-    } else if (PMIX_MODEX_KEY_NATIVE_FMT == key_fmt) {
-        cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, kv, &cnt, PMIX_KVAL);
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &kv->key, &cnt, PMIX_STRING);
         if (PMIX_SUCCESS != rc) {
             return rc;
         }
@@ -373,5 +493,34 @@ pmix_status_t pmix_gds_base_modex_unpack_kval(pmix_gds_modex_key_fmt_t key_fmt,
         return rc;
     }
 
+    if (NULL != vtab) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &vref, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS == rc && vtab->nvals < vref) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+        }
+        if (PMIX_SUCCESS != rc) {
+            free(kv->key);
+            kv->key = NULL;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (0 != vref) {
+            /* shared with other ranks of the blob */
+            kv->value = &vtab->vals[vref - 1];
+            return PMIX_SUCCESS;
+        }
+    }
+    cnt = 1;
+    PMIX_VALUE_CREATE(kv->value, 1);
+    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, kv->value, &cnt, PMIX_VALUE);
+    if (PMIX_SUCCESS != rc) {
+        free(kv->key);
+        kv->key = NULL;
+        PMIX_VALUE_RELEASE(kv->value);
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
     return PMIX_SUCCESS;
 }
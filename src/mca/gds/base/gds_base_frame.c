@@ -51,10 +51,29 @@ pmix_gds_globals_t pmix_gds_globals = {
     .actives = PMIX_LIST_STATIC_INIT,
     .initialized = false,
     .selected = false,
-    .all_mods = NULL
+    .all_mods = NULL,
+    .dcache_size = 4096,
+    .dcache_negative = true
 };
 int pmix_gds_base_output = -1;
 
+static int pmix_gds_register(pmix_mca_base_register_flag_t flags)
+{
+    (void) flags;
+
+    pmix_mca_base_var_register("pmix", "gds", "base", "get_cache_size",
+                               "Number of values PMIx_Get may return directly from the "
+                               "calling thread without shifting into the progress thread "
+                               "(0 disables the cache)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_gds_globals.dcache_size);
+    pmix_mca_base_var_register("pmix", "gds", "base", "get_cache_misses",
+                               "Also remember keys found to be absent, so that repeated "
+                               "requests for them fail without asking the server again "
+                               "until new data is stored",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_gds_globals.dcache_negative);
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t pmix_gds_close(void)
 {
     pmix_gds_base_active_module_t *active, *prev;
@@ -74,6 +93,7 @@ static pmix_status_t pmix_gds_close(void)
         PMIX_RELEASE(active);
     }
     PMIX_DESTRUCT(&pmix_gds_globals.actives);
+    pmix_gds_base_dcache_finalize();
 
     if (NULL != pmix_gds_globals.all_mods) {
         free(pmix_gds_globals.all_mods);
@@ -96,8 +116,21 @@ static pmix_status_t pmix_gds_open(pmix_mca_base_open_flag_t flags)
     return rc;
 }
 
-PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, gds, "PMIx Generalized Data Store", NULL, pmix_gds_open,
-                                pmix_gds_close, pmix_mca_gds_base_static_components,
+PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, gds, "PMIx Generalized Data Store", pmix_gds_register,
+                                pmix_gds_open, pmix_gds_close, pmix_mca_gds_base_static_components,
                                 PMIX_MCA_BASE_FRAMEWORK_FLAG_DEFAULT);
 
 PMIX_CLASS_INSTANCE(pmix_gds_base_active_module_t, pmix_list_item_t, NULL, NULL);
+
+static void vtcon(pmix_gds_modex_vtab_t *p)
+{
+    p->vals = NULL;
+    p->nvals = 0;
+}
+static void vtdes(pmix_gds_modex_vtab_t *p)
+{
+    if (NULL != p->vals) {
+        PMIX_VALUE_FREE(p->vals, p->nvals);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_gds_modex_vtab_t, pmix_object_t, vtcon, vtdes);
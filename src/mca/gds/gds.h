@@ -49,6 +49,11 @@ struct pmix_namespace_t;
 /* backdoor to base verbosity */
 PMIX_EXPORT extern int pmix_gds_base_output;
 
+/* discard every value cached for direct reads by PMIx_Get - called
+ * by the macros below whenever data is added to, or removed from,
+ * a GDS module */
+PMIX_EXPORT void pmix_gds_base_dcache_flush(void);
+
 /**
  * Initialize the module. Returns an error if the module cannot
  * run, success if it can.
@@ -106,6 +111,7 @@ typedef pmix_status_t (*pmix_gds_base_module_accept_kvs_resp_fn_t)(pmix_buffer_t
             pmix_output_verbose(1, pmix_gds_base_output, "[%s:%d] GDS ACCEPT RESP WITH %s", \
                                 __FILE__, __LINE__, _g->name);                              \
             (s) = _g->accept_kvs_resp(b);                                                   \
+            pmix_gds_base_dcache_flush();                                                   \
         }                                                                                   \
     } while (0)
 
@@ -125,6 +131,7 @@ typedef pmix_status_t (*pmix_gds_base_module_cache_job_info_fn_t)(struct pmix_na
         pmix_output_verbose(1, pmix_gds_base_output, "[%s:%d] GDS CACHE JOB INFO WITH %s", \
                             __FILE__, __LINE__, _g->name);                                 \
         (s) = _g->cache_job_info((struct pmix_namespace_t *) (n), (i), (ni));              \
+        pmix_gds_base_dcache_flush();                                                      \
     } while (0)
 
 /* register job-level info - this is provided as a special function
@@ -167,6 +174,15 @@ typedef pmix_status_t (*pmix_gds_base_module_register_job_info_fn_t)(struct pmix
         (s) = _g->register_job_info((struct pmix_peer_t *) (p), b);                                \
     } while (0)
 
+/* hand back a reference to the job info already packed for another
+ * local client in the peer's nspace, so it can be sent to this client
+ * as well without being repacked or copied. Returns PMIX_ERR_NOT_FOUND
+ * if nothing has been packed yet, in which case register_job_info must
+ * be used. This is optional - modules whose reply is more than the
+ * prepacked job info should not provide it */
+typedef pmix_status_t (*pmix_gds_base_module_share_job_info_fn_t)(struct pmix_peer_t *pr,
+                                                                  pmix_buffer_t **reply);
+
 /* update job-level info - this is provided as a special function
  * to allow for optimization. Called solely by the client. The buffer
  * provided to this API is the same one given to the server by the
@@ -182,6 +198,28 @@ typedef pmix_status_t (*pmix_gds_base_module_store_job_info_fn_t)(const char *ns
         pmix_output_verbose(1, pmix_gds_base_output, "[%s:%d] GDS STORE JOB INFO WITH %s", \
                             __FILE__, __LINE__, _g->name);                                 \
         (s) = _g->store_job_info(n, b);                                                    \
+        pmix_gds_base_dcache_flush();                                                      \
+    } while (0)
+
+/* store job-level info that is still arriving - the buffer holds what
+ * has been received of the reply so far. The complete entries at its
+ * front are stored, and its unpack pointer is left at the first entry
+ * that is not yet complete so the caller can add the bytes that follow
+ * and call again. The final call is made with "last" set, at which point
+ * an incomplete entry is an error. This is optional - modules that do
+ * not provide it are given the reply in one piece */
+typedef pmix_status_t (*pmix_gds_base_module_stream_job_info_fn_t)(const char *nspace,
+                                                                   pmix_buffer_t *buf,
+                                                                   bool last);
+
+/* define a convenience macro for streaming job info based on peer */
+#define PMIX_GDS_STREAM_JOB_INFO(s, p, n, b, l)                                             \
+    do {                                                                                    \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds;                                 \
+        pmix_output_verbose(1, pmix_gds_base_output, "[%s:%d] GDS STREAM JOB INFO WITH %s", \
+                            __FILE__, __LINE__, _g->name);                                  \
+        (s) = _g->stream_job_info(n, b, l);                                                 \
+        pmix_gds_base_dcache_flush();                                                       \
     } while (0)
 
 /**
@@ -212,6 +250,7 @@ typedef pmix_status_t (*pmix_gds_base_module_store_fn_t)(const pmix_proc_t *proc
         pmix_output_verbose(1, pmix_gds_base_output, "[%s:%d] GDS STORE KV WITH %s", __FILE__, \
                             __LINE__, _g->name);                                               \
         (s) = _g->store(pc, sc, k);                                                            \
+        pmix_gds_base_dcache_flush();                                                          \
     } while (0)
 
 /**
@@ -247,6 +286,7 @@ typedef pmix_status_t (*pmix_gds_base_module_store_modex_fn_t)(struct pmix_names
         pmix_output_verbose(1, pmix_gds_base_output, "[%s:%d] GDS STORE MODEX WITH %s", __FILE__, \
                             __LINE__, (n)->compat.gds->name);                                     \
         (r) = (n)->compat.gds->store_modex((struct pmix_namespace_t *) n, b, t);                  \
+        pmix_gds_base_dcache_flush();                                                             \
     } while (0)
 
 /**
@@ -370,6 +410,60 @@ typedef pmix_status_t (*pmix_gds_base_module_del_nspace_fn_t)(const char *nspace
                 (s) = PMIX_ERROR;                                                           \
             }                                                                               \
         }                                                                                   \
+        pmix_gds_base_dcache_flush();                                                       \
+    } while (0)
+
+/**
+ * publish a job-level value that was registered after the job info
+ * of the given nspace was delivered to its clients, so that they see
+ * it without being sent anything - e.g., resources registered with
+ * PMIx_server_register_resources. Modules that cannot do so leave
+ * this NULL or return PMIX_ERR_NOT_SUPPORTED.
+ */
+typedef pmix_status_t (*pmix_gds_base_module_update_job_info_fn_t)(const char *nspace,
+                                                                  pmix_kval_t *kv);
+
+/**
+ * bring a client's view of the job-level info of the given nspace up
+ * to date without asking the server, setting changed if anything was
+ * updated since the last refresh. Returns PMIX_ERR_NOT_SUPPORTED if
+ * that cannot be done locally.
+ */
+typedef pmix_status_t (*pmix_gds_base_module_refresh_fn_t)(const char *nspace, bool *changed);
+
+/**
+ * discard the modex data held for the given proc of the given nspace
+ * so that later requests for it go back to the host. Only ever asked
+ * of a server, and only for procs that are not local to it.
+ */
+typedef pmix_status_t (*pmix_gds_base_module_release_modex_fn_t)(const char *nspace,
+                                                                pmix_rank_t rank);
+
+/**
+ * collect the values stored for the given proc after the given epoch,
+ * returning the epoch of the latest change to its data so that a
+ * client can later be sent only what changed since. Only ever asked
+ * of a server. Modules that do not track changes leave this NULL.
+ */
+typedef pmix_status_t (*pmix_gds_base_module_fetch_changed_fn_t)(const pmix_proc_t *proc,
+                                                                uint64_t since,
+                                                                uint64_t *epoch,
+                                                                pmix_list_t *kvs);
+
+/* define a convenience macro for release_modex across the active modules */
+#define PMIX_GDS_RELEASE_MODEX(s, n, r)                                                    \
+    do {                                                                                   \
+        pmix_gds_base_active_module_t *_g;                                                 \
+        pmix_status_t _s = PMIX_SUCCESS;                                                   \
+        (s) = PMIX_SUCCESS;                                                                \
+        PMIX_LIST_FOREACH (_g, &pmix_gds_globals.actives, pmix_gds_base_active_module_t) { \
+            if (NULL != _g->module->release_modex) {                                       \
+                _s = _g->module->release_modex((n), (r));                                  \
+            }                                                                              \
+            if (PMIX_SUCCESS != _s) {                                                      \
+                (s) = PMIX_ERROR;                                                          \
+            }                                                                              \
+        }                                                                                  \
     } while (0)
 
 /* define a convenience macro for is_tsafe for fetch operation */
@@ -409,7 +503,9 @@ typedef struct {
     pmix_gds_base_assign_module_fn_t                assign_module;
     pmix_gds_base_module_cache_job_info_fn_t        cache_job_info;
     pmix_gds_base_module_register_job_info_fn_t     register_job_info;
+    pmix_gds_base_module_share_job_info_fn_t        share_job_info;
     pmix_gds_base_module_store_job_info_fn_t        store_job_info;
+    pmix_gds_base_module_stream_job_info_fn_t       stream_job_info;
     pmix_gds_base_module_store_fn_t                 store;
     pmix_gds_base_module_store_modex_fn_t           store_modex;
     pmix_gds_base_module_fetch_fn_t                 fetch;
@@ -419,6 +515,10 @@ typedef struct {
     pmix_gds_base_module_assemb_kvs_req_fn_t        assemb_kvs_req;
     pmix_gds_base_module_accept_kvs_resp_fn_t       accept_kvs_resp;
     pmix_gds_base_module_fetch_array_fn_t           fetch_arrays;
+    pmix_gds_base_module_update_job_info_fn_t       update_job_info;
+    pmix_gds_base_module_refresh_fn_t               refresh;
+    pmix_gds_base_module_release_modex_fn_t         release_modex;
+    pmix_gds_base_module_fetch_changed_fn_t         fetch_changed;
 
 } pmix_gds_base_module_t;
 
@@ -47,6 +47,7 @@
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_environ.h"
+#include "src/util/pmix_trace.h"
 
 #include "gds_hash.h"
 #include "src/mca/gds/base/base.h"
@@ -263,9 +264,11 @@ pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk, pmi
         hostname = pmix_globals.hostname;
     }
 
-    /* scan the list of nodes to find the matching entry */
+    /* find the matching entry - the job's own node list is indexed */
     nd = NULL;
-    if (UINT32_MAX!= nid) {
+    if (tgt == &trk->nodeinfo) {
+        nd = pmix_gds_hash_lookup_node(trk, nid, hostname);
+    } else if (UINT32_MAX != nid) {
         PMIX_LIST_FOREACH (ndptr, tgt, pmix_nodeinfo_t) {
             if (UINT32_MAX != ndptr->nodeid &&
                 nid == ndptr->nodeid) {
@@ -449,12 +452,16 @@ pmix_status_t pmix_gds_hash_fetch_appinfo(const char *key, pmix_job_t *trk, pmix
         appnum = pmix_globals.appnum;
     }
 
-    /* scan the list of apps to find the matching entry */
+    /* find the matching entry - the job's own app list is indexed */
     app = NULL;
-    PMIX_LIST_FOREACH (apptr, tgt, pmix_apptrkr_t) {
-        if (appnum == apptr->appnum) {
-            app = apptr;
-            break;
+    if (tgt == &trk->apps) {
+        app = pmix_gds_hash_lookup_app(trk, appnum);
+    } else {
+        PMIX_LIST_FOREACH (apptr, tgt, pmix_apptrkr_t) {
+            if (appnum == apptr->appnum) {
+                app = apptr;
+                break;
+            }
         }
     }
     if (NULL == app) {
@@ -515,7 +522,7 @@ pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, b
                         "%s pmix:gds:hash fetch %s for proc %s on scope %s",
                         PMIX_NAME_PRINT(&pmix_globals.myid), (NULL == key) ? "NULL" : key,
                         PMIX_NAME_PRINT(proc), PMIx_Scope_string(scope));
-
+    PMIX_TRACE3(gds_fetch, proc->nspace, proc->rank, key);
 
     PMIX_HIDE_UNUSED_PARAMS(copy);
 
@@ -529,6 +536,19 @@ pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, b
         return PMIX_ERR_INVALID_NAMESPACE;
     }
 
+    /* unpack any job info we are still holding in packed form
+     * for the rank(s) this request could touch */
+    if (PMIX_RANK_IS_VALID(proc->rank)) {
+        rc = pmix_gds_hash_expand_rank(trk, proc->rank);
+    } else if (PMIX_RANK_UNDEF == proc->rank || NULL == key) {
+        rc = pmix_gds_hash_expand_all(trk);
+    } else {
+        rc = PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
     /* if the rank is wildcard and the key is NULL, then
      * they are asking for a complete copy of the job-level
      * info for this nspace - retrieve it */
@@ -573,6 +593,13 @@ pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, b
                 PMIX_LIST_DESTRUCT(&rkvs);
                 return rc;
             }
+            if (trk->implicit) {
+                rc = pmix_gds_hash_fetch_implicit(trk, rnk, NULL, &rkvs);
+                if (PMIX_ERR_NOMEM == rc) {
+                    PMIX_LIST_DESTRUCT(&rkvs);
+                    return rc;
+                }
+            }
             if (0 == pmix_list_get_size(&rkvs)) {
                 PMIX_DESTRUCT(&rkvs);
                 continue;
@@ -735,6 +762,17 @@ doover:
             }
         }
     }
+    /* the server may have left out values we can compute */
+    if (trk->implicit && PMIX_RANK_IS_VALID(proc->rank) && 0 == nqual &&
+        PMIX_LOCAL != scope && PMIX_REMOTE != scope &&
+        (NULL == key || 0 == pmix_list_get_size(kvs))) {
+        if (PMIX_ERR_NOMEM == pmix_gds_hash_fetch_implicit(trk, proc->rank, key, kvs)) {
+            return PMIX_ERR_NOMEM;
+        }
+        if (0 < pmix_list_get_size(kvs)) {
+            rc = PMIX_SUCCESS;
+        }
+    }
     if (0 == pmix_list_get_size(kvs)) {
         /* if we didn't find it and the rank was valid, then
          * check to see if the data exists in a different scope.
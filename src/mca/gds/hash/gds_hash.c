@@ -36,6 +36,7 @@
 #include "src/class/pmix_list.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/mca/pmdl/pmdl.h"
 #include "src/mca/preg/preg.h"
@@ -47,6 +48,7 @@
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_environ.h"
+#include "src/util/pmix_trace.h"
 
 #include "gds_hash.h"
 #include "src/mca/gds/base/base.h"
@@ -61,14 +63,18 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns, pmix_info_
 
 static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr, pmix_buffer_t *reply);
 
+static pmix_status_t hash_share_job_info(struct pmix_peer_t *pr, pmix_buffer_t **reply);
+
 static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf);
 
+static pmix_status_t hash_stream_job_info(const char *nspace, pmix_buffer_t *buf, bool last);
+
 static pmix_status_t hash_store_modex(struct pmix_namespace_t *ns, pmix_buffer_t *buff,
                                       void *cbdata);
 
 static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx, pmix_proc_t *proc,
                                        pmix_gds_modex_key_fmt_t key_fmt, char **kmap,
-                                       pmix_buffer_t *pbkt);
+                                       pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt);
 
 static pmix_status_t setup_fork(const pmix_proc_t *peer, char ***env);
 
@@ -90,7 +96,9 @@ pmix_gds_base_module_t pmix_hash_module = {
     .assign_module = hash_assign_module,
     .cache_job_info = hash_cache_job_info,
     .register_job_info = hash_register_job_info,
+    .share_job_info = hash_share_job_info,
     .store_job_info = hash_store_job_info,
+    .stream_job_info = hash_stream_job_info,
     .store = pmix_gds_hash_store,
     .store_modex = hash_store_modex,
     .fetch = pmix_gds_hash_fetch,
@@ -99,7 +107,9 @@ pmix_gds_base_module_t pmix_hash_module = {
     .del_nspace = nspace_del,
     .assemb_kvs_req = assemb_kvs_req,
     .accept_kvs_resp = accept_kvs_resp,
-    .fetch_arrays = pmix_gds_hash_fetch_arrays
+    .fetch_arrays = pmix_gds_hash_fetch_arrays,
+    .release_modex = pmix_gds_hash_release_modex,
+    .fetch_changed = pmix_gds_hash_fetch_changed
 };
 
 static pmix_status_t hash_init(pmix_info_t info[], size_t ninfo)
@@ -109,6 +119,7 @@ static pmix_status_t hash_init(pmix_info_t info[], size_t ninfo)
 
     PMIX_CONSTRUCT(&pmix_mca_gds_hash_component.mysessions, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_mca_gds_hash_component.myjobs, pmix_list_t);
+    pmix_gds_hash_init_key_actions();
 
     return PMIX_SUCCESS;
 }
@@ -156,7 +167,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     pmix_kval_t *kp2 = NULL, *kvptr, kv;
     pmix_value_t val;
     pmix_info_t *iptr;
-    char **nodes = NULL, **procs = NULL;
+    char *nodes = NULL, **procs = NULL;
     uint32_t sid = UINT32_MAX;
     pmix_rank_t rank;
     pmix_status_t rc = PMIX_SUCCESS;
@@ -174,6 +185,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     if (NULL == trk) {
         return PMIX_ERR_NOMEM;
     }
+    pmix_namespace_flush_resolved(trk->nptr);
 
     /* if there isn't any data, then be content with just
      * creating the tracker */
@@ -222,19 +234,12 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                 return PMIX_ERR_BAD_PARAM;
             }
-            /* parse the regex to get the argv array of node names */
+            /* the regex is parsed when the map is stored so
+             * that we never hold the full list of node names */
             if (PMIX_REGEX == info[n].value.type) {
-                rc = pmix_preg.parse_nodes(info[n].value.data.bo.bytes, &nodes);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+                nodes = info[n].value.data.bo.bytes;
             } else if (PMIX_STRING == info[n].value.type) {
-                rc = pmix_preg.parse_nodes(info[n].value.data.string, &nodes);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    goto release;
-                }
+                nodes = info[n].value.data.string;
             } else {
                 PMIX_ERROR_LOG(PMIX_ERR_TYPE_MISMATCH);
                 rc = PMIX_ERR_TYPE_MISMATCH;
@@ -367,7 +372,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
         } else if (pmix_check_node_info(info[n].key)) {
             /* they are passing us the node-level info for just this
              * node - start by seeing if our node is on the list */
-            nd = pmix_gds_hash_check_nodename(&trk->nodeinfo, pmix_globals.hostname);
+            nd = pmix_gds_hash_lookup_node(trk, UINT32_MAX, pmix_globals.hostname);
             /* if not, then add it */
             if (NULL == nd) {
                 nd = PMIX_NEW(pmix_nodeinfo_t);
@@ -445,7 +450,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                 /* if this is the job size, then store it in
                  * the nptr tracker and flag that we were given it */
                 if (PMIX_CHECK_KEY(&info[n], PMIX_JOB_SIZE)) {
-                    nptr->nprocs = info[n].value.data.uint32;
+                    pmix_gds_hash_set_job_size(trk, info[n].value.data.uint32);
                     flags |= PMIX_HASH_JOB_SIZE;
                 } else if (PMIX_CHECK_KEY(&info[n], PMIX_NUM_NODES)) {
                     flags |= PMIX_HASH_NUM_NODES;
@@ -490,15 +495,29 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     }
 
 release:
-    if (NULL != nodes) {
-        pmix_argv_free(nodes);
-    }
     if (NULL != procs) {
         pmix_argv_free(procs);
     }
     return rc;
 }
 
+/* rough packed size of a list of kvals, used to reserve room in
+ * the buffer before packing it so it doesn't have to grow a
+ * little at a time */
+static size_t kvlist_size_estimate(pmix_list_t *kvs)
+{
+    pmix_kval_t *kv;
+    size_t sz = 0;
+
+    PMIX_LIST_FOREACH (kv, kvs, pmix_kval_t) {
+        sz += sizeof(pmix_data_type_t) + sizeof(int32_t) + strlen(kv->key) + 1;
+        if (NULL != kv->value) {
+            sz += pmix_bfrops_base_value_size_estimate(kv->value);
+        }
+    }
+    return sz;
+}
+
 static pmix_status_t register_info(pmix_peer_t *peer,
                                    pmix_namespace_t *ns,
                                    pmix_buffer_t *reply)
@@ -516,6 +535,7 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     pmix_list_t results;
     char *hname;
     pmix_session_t *sptr;
+    bool implicit;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "REGISTERING FOR PEER %s type %d.%d.%d",
@@ -528,6 +548,10 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     }
     /* the job data is stored on the internal hash table */
     ht = &trk->internal;
+    rc = pmix_gds_hash_expand_all(trk);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     /* fetch all values from the hash table tied to rank=wildcard */
     PMIX_CONSTRUCT(&values, pmix_list_t);
@@ -537,6 +561,8 @@ static pmix_status_t register_info(pmix_peer_t *peer,
         PMIX_LIST_DESTRUCT(&values);
         return rc;
     }
+    pmix_bfrops_base_buffer_reserve(reply, kvlist_size_estimate(&values)
+                                               + kvlist_size_estimate(&trk->jobinfo));
     PMIX_LIST_FOREACH(kvptr, &values, pmix_kval_t) {
         PMIX_BFROPS_PACK(rc, peer, reply, kvptr, 1, PMIX_KVAL);
     }
@@ -552,6 +578,7 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     PMIX_CONSTRUCT(&results, pmix_list_t);
     rc = pmix_gds_hash_fetch_sessioninfo(NULL, trk, NULL, 0, &results);
     if (PMIX_SUCCESS == rc) {
+        pmix_bfrops_base_buffer_reserve(reply, kvlist_size_estimate(&results));
         PMIX_LIST_FOREACH (kvptr, &results, pmix_kval_t) {
             PMIX_BFROPS_PACK(rc, peer, reply, kvptr, 1, PMIX_KVAL);
         }
@@ -578,6 +605,7 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     PMIX_CONSTRUCT(&results, pmix_list_t);
     rc = pmix_gds_hash_fetch_nodeinfo(NULL, trk, &trk->nodeinfo, NULL, 0, &results);
     if (PMIX_SUCCESS == rc) {
+        pmix_bfrops_base_buffer_reserve(reply, kvlist_size_estimate(&results));
         PMIX_LIST_FOREACH (kvptr, &results, pmix_kval_t) {
             /* if the peer is earlier than v3.2.x, it is expecting
              * node info to be in the form of an array, but with the
@@ -618,12 +646,29 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     PMIX_CONSTRUCT(&results, pmix_list_t);
     rc = pmix_gds_hash_fetch_appinfo(NULL, trk, &trk->apps, NULL, 0, &results);
     if (PMIX_SUCCESS == rc) {
+        pmix_bfrops_base_buffer_reserve(reply, kvlist_size_estimate(&results));
         PMIX_LIST_FOREACH (kvptr, &results, pmix_kval_t) {
             PMIX_BFROPS_PACK(rc, peer, reply, kvptr, 1, PMIX_KVAL);
         }
     }
     PMIX_LIST_DESTRUCT(&results);
 
+    /* tell the client if the values it can compute from the
+     * node and app info are being left out */
+    implicit = pmix_mca_gds_hash_component.implicit_proc_data &&
+               !PMIX_PEER_IS_EARLIER(peer, 5, 0, 0);
+    if (implicit) {
+        pmix_gds_hash_release_rank_index(trk);
+        kv.key = PMIX_GDS_HASH_IMPLICIT_PROC_DATA;
+        kv.value = &blob;
+        PMIX_VALUE_LOAD(&blob, &implicit, PMIX_BOOL);
+        PMIX_BFROPS_PACK(rc, peer, reply, &kv, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
     /* get the proc-level data for each proc in the job */
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "FETCHING PROC INFO FOR NSPACE %s NPROCS %u", ns->nspace, ns->nprocs);
@@ -637,11 +682,16 @@ static pmix_status_t register_info(pmix_peer_t *peer,
             PMIX_LIST_DESTRUCT(&values);
             return rc;
         }
+        if (implicit) {
+            pmix_gds_hash_trim_implicit(trk, rank, &values);
+        }
         if (0 == pmix_list_get_size(&values)) {
             PMIX_LIST_DESTRUCT(&values);
             continue;
         }
         PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        pmix_bfrops_base_buffer_reserve(&buf, sizeof(pmix_data_type_t) + sizeof(pmix_rank_t)
+                                                  + kvlist_size_estimate(&values));
         PMIX_BFROPS_PACK(rc, peer, &buf, &rank, 1, PMIX_PROC_RANK);
 
         PMIX_LIST_FOREACH(kvptr, &values, pmix_kval_t) {
@@ -741,10 +791,43 @@ static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr, pmix_buffer_
     return rc;
 }
 
+static pmix_status_t hash_share_job_info(struct pmix_peer_t *pr, pmix_buffer_t **reply)
+{
+    pmix_peer_t *peer = (pmix_peer_t *) pr;
+    pmix_namespace_t *ns = peer->nptr;
+
+    if (NULL == ns->jobbkt) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:share_job_info sharing prepacked payload with peer %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, PMIX_PEER_PRINT(peer));
+    /* the packed buffer is never modified once built, so every
+     * local client can be sent the same one */
+    PMIX_RETAIN(ns->jobbkt);
+    *reply = ns->jobbkt;
+    /* now see if we have delivered it to all our local
+     * clients for this nspace */
+    if (!PMIX_PEER_IS_LAUNCHER(pmix_globals.mypeer) && ns->ndelivered == ns->nlocalprocs) {
+        PMIX_RELEASE(ns->jobbkt);
+        ns->jobbkt = NULL;
+    }
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
+{
+    return hash_stream_job_info(nspace, buf, true);
+}
+
+/* each entry is stored as soon as it has been unpacked, and the only
+ * state carried from one to the next (the session) is kept on the job
+ * tracker - so the buffer can be processed a section at a time */
+static pmix_status_t hash_stream_job_info(const char *nspace, pmix_buffer_t *buf, bool last)
 {
     pmix_status_t rc = PMIX_SUCCESS;
-    pmix_kval_t kptr, kp2, *kp3, *kp4, kv, kv2;
+    pmix_kval_t kptr, *kp3, *kp4, kv, kv2;
     pmix_value_t val;
     int32_t cnt;
     size_t nnodes, n, sz;
@@ -762,6 +845,7 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
     pmix_session_t *s = NULL;
     pmix_apptrkr_t *apptr;
     bool found;
+    char *start;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%u] pmix:gds:hash store job info for nspace %s",
@@ -792,9 +876,13 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
         /* only can happen if we are out of mem */
         return PMIX_ERR_NOMEM;
     }
+    pmix_namespace_flush_resolved(nptr);
+    /* the node info the computed values come from may change */
+    pmix_gds_hash_release_rank_index(trk);
 
     cnt = 1;
     PMIX_CONSTRUCT(&kptr, pmix_kval_t);
+    start = buf->unpack_ptr;
     PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &kptr, &cnt, PMIX_KVAL);
     while (PMIX_SUCCESS == rc) {
         pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
@@ -803,48 +891,25 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
                             PMIx_Get_attribute_name(kptr.key));
         if (PMIX_CHECK_KEY(&kptr, PMIX_PROC_BLOB)) {
             bo = &(kptr.value->data.bo);
-            PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
-            PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &buf2, bo->bytes, bo->size);
-            /* start by unpacking the rank */
-            cnt = 1;
-            PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, &buf2,
-                               &rank, &cnt, PMIX_PROC_RANK);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&kptr);
-                PMIX_DESTRUCT(&buf2);
-                return rc;
-            }
-            /* unpack the blob and save the values for this rank */
-            cnt = 1;
-            PMIX_CONSTRUCT(&kp2, pmix_kval_t);
-            PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, &buf2, &kp2, &cnt, PMIX_KVAL);
-            while (PMIX_SUCCESS == rc) {
-                /* this is data provided by a job-level exchange, so store it
-                 * in the job-level data hash_table */
-                pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                    "%s pmix:gds:hash store proc info for rank %u working key %s",
-                    PMIX_NAME_PRINT(&pmix_globals.myid), rank, kp2.key);
-                if (PMIX_CHECK_KEY(&kp2, PMIX_QUALIFIED_VALUE)) {
-                    rc = pmix_gds_hash_store_qualified(ht, rank, kp2.value);
-                } else {
-                    rc = pmix_hash_store(ht, rank, &kp2, NULL, 0);
+            if (pmix_mca_gds_hash_component.lazy_job_info) {
+                /* leave it packed until someone asks for this rank */
+                rc = pmix_gds_hash_defer_proc_blob(trk, bo);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_DESTRUCT(&kptr);
+                    return rc;
                 }
+            } else {
+                PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
+                PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &buf2, bo->bytes, bo->size);
+                rc = pmix_gds_hash_store_proc_blob(trk, &buf2);
+                PMIX_DESTRUCT(&buf2); // releases the original kptr data
                 if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&kp2);
                     PMIX_DESTRUCT(&kptr);
-                    PMIX_DESTRUCT(&buf2);
                     return rc;
                 }
-                cnt = 1;
-                PMIX_DESTRUCT(&kp2);
-                PMIX_CONSTRUCT(&kp2, pmix_kval_t);
-                PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, &buf2, &kp2, &cnt, PMIX_KVAL);
             }
-            /* cleanup */
-            PMIX_DESTRUCT(&buf2); // releases the original kptr data
-            PMIX_DESTRUCT(&kp2);
+        } else if (PMIX_CHECK_KEY(&kptr, PMIX_GDS_HASH_IMPLICIT_PROC_DATA)) {
+            trk->implicit = (PMIX_BOOL == kptr.value->type && kptr.value->data.flag);
         } else if (PMIX_CHECK_KEY(&kptr, PMIX_MAP_BLOB)) {
             /* transfer the byte object for unpacking */
             bo = &(kptr.value->data.bo);
@@ -1041,7 +1106,7 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
         } else if (pmix_check_node_info(kptr.key)) {
             /* they are passing us the node-level info for just this
              * node - start by seeing if our node is on the list */
-            nd = pmix_gds_hash_check_nodename(&trk->nodeinfo, pmix_globals.hostname);
+            nd = pmix_gds_hash_lookup_node(trk, UINT32_MAX, pmix_globals.hostname);
             /* if not, then add it */
             if (NULL == nd) {
                 nd = PMIX_NEW(pmix_nodeinfo_t);
@@ -1079,6 +1144,11 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
                 PMIX_DESTRUCT(&kptr);
                 return rc;
             }
+            rc = pmix_gds_hash_expand_rank(trk, rank);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_DESTRUCT(&kptr);
+                return rc;
+            }
             for (n=1; n < sz; n++) {
                 PMIX_CONSTRUCT(&kv, pmix_kval_t);
                 kv.key = iptr[n].key;
@@ -1111,17 +1181,23 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
             /* if this is the job size, then store it in
              * the nptr tracker */
             if (0 == nptr->nprocs && PMIX_CHECK_KEY(&kptr, PMIX_JOB_SIZE)) {
-                nptr->nprocs = kptr.value->data.uint32;
+                pmix_gds_hash_set_job_size(trk, kptr.value->data.uint32);
             }
         }
         PMIX_DESTRUCT(&kptr);
         PMIX_CONSTRUCT(&kptr, pmix_kval_t);
         cnt = 1;
+        start = buf->unpack_ptr;
         PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &kptr, &cnt, PMIX_KVAL);
     }
     /* need to release the leftover kptr */
     PMIX_DESTRUCT(&kptr);
 
+    if (!last) {
+        /* the rest of this entry has yet to arrive */
+        buf->unpack_ptr = start;
+        return PMIX_SUCCESS;
+    }
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         PMIX_ERROR_LOG(rc);
     } else {
@@ -1145,6 +1221,7 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
                         "%s gds:hash:hash_store for proc %s key %s type %s scope %s",
                         PMIX_NAME_PRINT(&pmix_globals.myid), PMIX_NAME_PRINT(proc), kv->key,
                         PMIx_Data_type_string(kv->value->type), PMIx_Scope_string(scope));
+    PMIX_TRACE3(gds_store, proc->nspace, proc->rank, kv->key);
 
     if (NULL == kv->key) {
         return PMIX_ERR_BAD_PARAM;
@@ -1155,6 +1232,18 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
     if (NULL == trk) {
         return PMIX_ERR_NOMEM;
     }
+    /* anything still deferred for this rank must not
+     * later overwrite what we are storing now */
+    if (PMIX_RANK_IS_VALID(proc->rank)) {
+        rc = pmix_gds_hash_expand_rank(trk, proc->rank);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    } else {
+        /* job/node-level data may change what
+         * PMIx_Resolve_nodes/peers report */
+        pmix_namespace_flush_resolved(trk->nptr);
+    }
 
     /* if this is node/app data, then process it accordingly */
     if (PMIX_CHECK_KEY(kv, PMIX_NODE_INFO_ARRAY)) {
@@ -1191,7 +1280,7 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
 
     /* if the number of procs for the nspace object is new, then update it */
     if (0 == trk->nptr->nprocs && PMIX_CHECK_KEY(kv, PMIX_JOB_SIZE)) {
-        trk->nptr->nprocs = kv->value->data.uint32;
+        pmix_gds_hash_set_job_size(trk, kv->value->data.uint32);
     }
 
     /* store it in the corresponding hash table */
@@ -1214,6 +1303,11 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
                 return rc;
             }
             rank = iptr[0].value.data.rank;
+            rc = pmix_gds_hash_expand_rank(trk, rank);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                return rc;
+            }
             /* cycle thru the values for this rank and store them */
             for (j = 1; j < size; j++) {
                 if (PMIX_CHECK_KEY(&iptr[j], PMIX_QUALIFIED_VALUE)) {
@@ -1295,6 +1389,16 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
     return PMIX_SUCCESS;
 }
 
+/* the ranks of a blob all use the key map given with it, so
+ * deferred data shares one copy of the map of the blob being
+ * stored - the base holds each map until it is done */
+typedef struct {
+    char **kmap;
+    pmix_gds_hash_kmap_t *copy;
+    /* data to be unpacked in parallel, if asked for */
+    pmix_list_t *work;
+} hash_kmap_ctx_t;
+
 /* this function is only called by the PMIx server when its
  * host has received data from some other peer. It therefore
  * always contains data solely from remote procs, and we
@@ -1302,23 +1406,42 @@ pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc,
 static pmix_status_t hash_store_modex(struct pmix_namespace_t *nspace, pmix_buffer_t *buf,
                                       void *cbdata)
 {
-    return pmix_gds_base_store_modex(nspace, buf, NULL, _hash_store_modex, cbdata);
+    hash_kmap_ctx_t ctx = {NULL, NULL, NULL};
+    pmix_list_t work;
+    pmix_status_t rc;
+
+    if (pmix_mca_gds_hash_component.lazy_modex
+        || 1 >= pmix_mca_gds_hash_component.modex_threads) {
+        rc = pmix_gds_base_store_modex(nspace, buf, &ctx, _hash_store_modex, cbdata);
+    } else {
+        PMIX_CONSTRUCT(&work, pmix_list_t);
+        ctx.work = &work;
+        /* the merge of the work touches every job in the blob */
+        pmix_gds_hash_lock_all();
+        rc = pmix_gds_base_store_modex(nspace, buf, &ctx, _hash_store_modex, cbdata);
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_gds_hash_store_modex_work(&work, pmix_mca_gds_hash_component.modex_threads);
+        }
+        pmix_gds_hash_unlock_all();
+        PMIX_LIST_DESTRUCT(&work);
+    }
+    if (NULL != ctx.copy) {
+        PMIX_RELEASE(ctx.copy);
+    }
+    return rc;
 }
 
-static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx, pmix_proc_t *proc,
-                                       pmix_gds_modex_key_fmt_t key_fmt, char **kmap,
-                                       pmix_buffer_t *pbkt)
+static pmix_status_t store_proc_modex(hash_kmap_ctx_t *kctx, pmix_proc_t *proc,
+                                      pmix_gds_modex_key_fmt_t key_fmt, char **kmap,
+                                      pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt)
 {
     pmix_job_t *trk;
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_kval_t kv;
+    pmix_rank_t rank;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%d] gds:hash:store_modex for nspace %s", pmix_globals.myid.nspace,
                         pmix_globals.myid.rank, proc->nspace);
 
-    PMIX_HIDE_UNUSED_PARAMS(ctx);
-
     /* find the hash table for this nspace */
     trk = pmix_gds_hash_get_tracker(proc->nspace, true);
     if (NULL == trk) {
@@ -1329,49 +1452,62 @@ static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx, pmix_proc_t *pro
      * data collection was requested, so it only contains
      * REMOTE/GLOBAL data. The byte object contains
      * the rank followed by pmix_kval_t's. The list of callbacks
-     * contains all local participants. */
-
-    /* unpack the remaining values until we hit the end of the buffer */
-    PMIX_CONSTRUCT(&kv, pmix_kval_t);
-    rc = pmix_gds_base_modex_unpack_kval(key_fmt, pbkt, kmap, &kv);
+     * contains all local participants.
+     *
+     * if the rank is undefined, then we store it on the
+     * remote table of rank=0 as we know that rank must
+     * always exist */
+    rank = (PMIX_RANK_UNDEF == proc->rank) ? 0 : proc->rank;
+
+    if (!pmix_mca_gds_hash_component.lazy_modex && NULL == kctx->work) {
+        return pmix_gds_hash_store_modex_kvals(trk, rank, key_fmt, kmap, vtab, pbkt);
+    }
 
-    while (PMIX_SUCCESS == rc) {
-        if (PMIX_RANK_UNDEF == proc->rank) {
-            /* if the rank is undefined, then we store it on the
-             * remote table of rank=0 as we know that rank must
-             * always exist */
-            if (PMIX_CHECK_KEY(&kv, PMIX_QUALIFIED_VALUE)) {
-                rc = pmix_gds_hash_store_qualified(&trk->remote, 0, kv.value);
-            } else {
-                rc = pmix_hash_store(&trk->remote, 0, &kv, NULL, 0);
-            }
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
-        } else {
-            /* store this in the hash table */
-            if (PMIX_CHECK_KEY(&kv, PMIX_QUALIFIED_VALUE)) {
-                rc = pmix_gds_hash_store_qualified(&trk->remote, proc->rank, kv.value);
-            } else {
-                rc = pmix_hash_store(&trk->remote, proc->rank, &kv, NULL, 0);
-            }
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
+    /* most of the data in a large job is never read, so just
+     * keep the packed data of each rank and only unpack it
+     * when the data for that rank is first requested - or,
+     * if all of it is wanted, unpack the ranks in parallel */
+    if (PMIX_MODEX_KEY_KEYMAP_FMT != key_fmt) {
+        if (NULL != kctx->work) {
+            return pmix_gds_hash_queue_modex(kctx->work, trk, rank, key_fmt, NULL, vtab, pbkt);
         }
-        PMIX_DESTRUCT(&kv);
-        /* continue along */
-        PMIX_CONSTRUCT(&kv, pmix_kval_t);
-        rc = pmix_gds_base_modex_unpack_kval(key_fmt, pbkt, kmap, &kv);
+        return pmix_gds_hash_defer_modex(trk, rank, key_fmt, NULL, vtab, pbkt);
     }
-    PMIX_DESTRUCT(&kv);
-    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
-        PMIX_ERROR_LOG(rc);
-    } else {
-        rc = PMIX_SUCCESS;
+    if (kctx->kmap != kmap) {
+        /* first rank of a new blob */
+        if (NULL != kctx->copy) {
+            PMIX_RELEASE(kctx->copy);
+        }
+        kctx->copy = PMIX_NEW(pmix_gds_hash_kmap_t);
+        if (NULL == kctx->copy) {
+            return PMIX_ERR_NOMEM;
+        }
+        kctx->copy->keys = pmix_argv_copy(kmap);
+        kctx->kmap = kmap;
+    }
+    if (NULL != kctx->work) {
+        return pmix_gds_hash_queue_modex(kctx->work, trk, rank, key_fmt, kctx->copy, vtab,
+                                         pbkt);
+    }
+    return pmix_gds_hash_defer_modex(trk, rank, key_fmt, kctx->copy, vtab, pbkt);
+}
+
+static pmix_status_t _hash_store_modex(pmix_gds_base_ctx_t ctx, pmix_proc_t *proc,
+                                       pmix_gds_modex_key_fmt_t key_fmt, char **kmap,
+                                       pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt)
+{
+    hash_kmap_ctx_t *kctx = (hash_kmap_ctx_t *) ctx;
+    pmix_status_t rc;
+
+    if (NULL != kctx->work) {
+        /* already holding every job */
+        return store_proc_modex(kctx, proc, key_fmt, kmap, vtab, pbkt);
     }
+    /* with the thread-safe module, only the job of this proc
+     * is held, so fetches of the other jobs carry on */
+    pmix_gds_hash_lock_job(proc->nspace, true);
+    rc = store_proc_modex(kctx, proc, key_fmt, kmap, vtab, pbkt);
+    pmix_gds_hash_unlock_job(proc->nspace);
     return rc;
 }
 
@@ -1399,6 +1535,7 @@ static pmix_status_t nspace_del(const char *nspace)
     pmix_job_t *t;
 
     /* find the hash table for this nspace */
+    pmix_gds_hash_lock_jobs();
     PMIX_LIST_FOREACH (t, &pmix_mca_gds_hash_component.myjobs, pmix_job_t) {
         if (0 == strcmp(nspace, t->ns)) {
             /* release it */
@@ -1407,6 +1544,7 @@ static pmix_status_t nspace_del(const char *nspace)
             break;
         }
     }
+    pmix_gds_hash_unlock_jobs();
     return PMIX_SUCCESS;
 }
 
@@ -1457,6 +1595,7 @@ static pmix_status_t store_node_info(pmix_nspace_t nspace, pmix_kval_t *kv)
         return PMIX_ERR_NOMEM;
     }
     rc = pmix_gds_hash_process_node_array(kv->value, &trk->nodeinfo);
+    pmix_gds_hash_release_rank_index(trk);
     return rc;
 }
 
@@ -22,6 +22,7 @@
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
 
+#include "src/mca/gds/base/base.h"
 #include "src/mca/gds/gds.h"
 
 BEGIN_C_DECLS
@@ -30,11 +31,21 @@ typedef struct {
     pmix_gds_base_component_t super;
     pmix_list_t mysessions;
     pmix_list_t myjobs;
+    bool lazy_job_info;
+    bool lazy_modex;
+    int modex_threads;
+    int dense_rank_limit;
+    bool implicit_proc_data;
+    int shards;
 } pmix_gds_hash_component_t;
 
 /* the component must be visible data for the linker to find it */
 PMIX_EXPORT extern pmix_gds_hash_component_t pmix_mca_gds_hash_component;
 extern pmix_gds_base_module_t pmix_hash_module;
+extern pmix_gds_base_module_t pmix_hash_tsafe_module;
+
+/* true when the thread-safe module is in use - see gds_hash_tsafe.c */
+extern bool pmix_gds_hash_tsafe;
 
 /* Define a bitmask to track what information may not have
  * been provided but is computable from other info */
@@ -45,6 +56,10 @@ extern pmix_gds_base_module_t pmix_hash_module;
 #define PMIX_HASH_PROC_MAP  0x00000010
 #define PMIX_HASH_NODE_MAP  0x00000020
 
+/* job-level flag telling the client that per-proc values which
+ * follow from the node and app info were left out of the job info */
+#define PMIX_GDS_HASH_IMPLICIT_PROC_DATA "pmix.gds.hash.implicit"
+
 /* struct definitions */
 typedef struct {
     pmix_list_item_t super;
@@ -61,14 +76,53 @@ typedef struct {
     pmix_hash_table_t internal;
     pmix_hash_table_t remote;
     pmix_hash_table_t local;
+    /* packed per-rank job info that has not yet been
+     * unpacked into the internal hash table, indexed by rank */
+    pmix_hash_table_t deferred;
+    /* packed modex data of remote procs that has not yet been
+     * unpacked into the remote hash table, indexed by rank */
+    pmix_hash_table_t modex;
     bool gdata_added;
     pmix_list_t jobinfo;
     pmix_list_t apps;
     pmix_list_t nodeinfo;
     pmix_session_t *session;
+    /* per-proc values left out by the server are computed
+     * from the node each rank is on and its position in
+     * that node's list of local peers */
+    bool implicit;
+    bool rank_indexed;
+    pmix_rank_t nindexed;
+    struct pmix_nodeinfo_t **rank_node;
+    uint16_t *rank_lrank;
+    /* index of the nodeinfo and apps lists, filled as
+     * nodes and apps are looked up */
+    pmix_hash_table_t nodes_by_id;
+    pmix_hash_table_t nodes_by_name;
+    pmix_hash_table_t apps_by_num;
+    /* guards the above index, which lookups fill in */
+    pmix_mutex_t index_lock;
 } pmix_job_t;
 PMIX_CLASS_DECLARATION(pmix_job_t);
 
+/* key-name map of a modex blob, shared by the
+ * packed data of all the ranks in that blob */
+typedef struct {
+    pmix_object_t super;
+    char **keys;
+} pmix_gds_hash_kmap_t;
+PMIX_CLASS_DECLARATION(pmix_gds_hash_kmap_t);
+
+/* the packed modex data of one rank */
+typedef struct {
+    pmix_object_t super;
+    pmix_gds_modex_key_fmt_t key_fmt;
+    pmix_gds_hash_kmap_t *kmap;
+    pmix_gds_modex_vtab_t *vtab;
+    pmix_byte_object_t bo;
+} pmix_gds_hash_modex_t;
+PMIX_CLASS_DECLARATION(pmix_gds_hash_modex_t);
+
 typedef struct {
     pmix_list_item_t super;
     uint32_t appnum;
@@ -78,7 +132,7 @@ typedef struct {
 } pmix_apptrkr_t;
 PMIX_CLASS_DECLARATION(pmix_apptrkr_t);
 
-typedef struct {
+typedef struct pmix_nodeinfo_t {
     pmix_list_item_t super;
     uint32_t nodeid;
     char *hostname;
@@ -87,12 +141,15 @@ typedef struct {
 } pmix_nodeinfo_t;
 PMIX_CLASS_DECLARATION(pmix_nodeinfo_t);
 
+extern void pmix_gds_hash_init_key_actions(void);
+
 extern pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *tgt);
 
 extern pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk);
 
 extern pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk,
-                                                     uint32_t *flags, char ***procs, char ***nodes);
+                                                     uint32_t *flags, char ***procs,
+                                                     char **nodes);
 
 extern pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t *trk);
 
@@ -112,7 +169,17 @@ extern bool pmix_gds_hash_check_node(pmix_nodeinfo_t *n1, pmix_nodeinfo_t *n2);
 
 extern pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname);
 
-extern pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
+/* find the node with the given nodeid or, if that is UINT32_MAX,
+ * the given hostname or alias on the nodeinfo list of the job */
+extern pmix_nodeinfo_t *pmix_gds_hash_lookup_node(pmix_job_t *trk, uint32_t nid,
+                                                  const char *hostname);
+
+/* find the app with the given appnum on the apps list of the job */
+extern pmix_apptrkr_t *pmix_gds_hash_lookup_app(pmix_job_t *trk, uint32_t appnum);
+
+/* store the node map - the node regex is parsed here so the
+ * per-node info can be stored as each name is extracted */
+extern pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, const char *nodemap, char **ppn,
                                              uint32_t flags);
 
 extern pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t scope, bool copy,
@@ -138,8 +205,57 @@ extern pmix_status_t pmix_gds_hash_store_qualified(pmix_hash_table_t *ht,
                                                    pmix_rank_t rank,
                                                    pmix_value_t *value);
 
+extern pmix_status_t pmix_gds_hash_store_proc_blob(pmix_job_t *trk, pmix_buffer_t *buf);
+
+extern pmix_status_t pmix_gds_hash_defer_proc_blob(pmix_job_t *trk, pmix_byte_object_t *bo);
+
+extern pmix_status_t pmix_gds_hash_store_modex_kvals(pmix_job_t *trk, pmix_rank_t rank,
+                                                     pmix_gds_modex_key_fmt_t key_fmt,
+                                                     char **kmap, pmix_gds_modex_vtab_t *vtab,
+                                                     pmix_buffer_t *pbkt);
+
+extern pmix_status_t pmix_gds_hash_defer_modex(pmix_job_t *trk, pmix_rank_t rank,
+                                               pmix_gds_modex_key_fmt_t key_fmt,
+                                               pmix_gds_hash_kmap_t *kmap,
+                                               pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt);
+
+extern pmix_status_t pmix_gds_hash_queue_modex(pmix_list_t *work, pmix_job_t *trk,
+                                               pmix_rank_t rank,
+                                               pmix_gds_modex_key_fmt_t key_fmt,
+                                               pmix_gds_hash_kmap_t *kmap,
+                                               pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt);
+
+extern pmix_status_t pmix_gds_hash_store_modex_work(pmix_list_t *work, int nthreads);
+
+extern pmix_status_t pmix_gds_hash_expand_rank(pmix_job_t *trk, pmix_rank_t rank);
+
+extern pmix_status_t pmix_gds_hash_expand_all(pmix_job_t *trk);
+
+extern pmix_status_t pmix_gds_hash_release_modex(const char *nspace, pmix_rank_t rank);
+
+extern pmix_status_t pmix_gds_hash_fetch_changed(const pmix_proc_t *proc, uint64_t since,
+                                                 uint64_t *epoch, pmix_list_t *kvs);
+
+extern pmix_status_t pmix_gds_hash_fetch_implicit(pmix_job_t *trk, pmix_rank_t rank,
+                                                  const char *key, pmix_list_t *kvs);
+
+extern void pmix_gds_hash_trim_implicit(pmix_job_t *trk, pmix_rank_t rank, pmix_list_t *kvs);
+
+extern void pmix_gds_hash_release_rank_index(pmix_job_t *trk);
+
 extern pmix_status_t pmix_gds_hash_fetch_arrays(struct pmix_peer_t *pr, pmix_buffer_t *reply);
 
+extern void pmix_gds_hash_set_job_size(pmix_job_t *trk, uint32_t nprocs);
+
+/* locks of the thread-safe module - they do nothing
+ * when the plain module is in use */
+extern void pmix_gds_hash_lock_job(const char *nspace, bool exclusive);
+extern void pmix_gds_hash_unlock_job(const char *nspace);
+extern void pmix_gds_hash_lock_all(void);
+extern void pmix_gds_hash_unlock_all(void);
+extern void pmix_gds_hash_lock_jobs(void);
+extern void pmix_gds_hash_unlock_jobs(void);
+
 END_C_DECLS
 
 #endif
@@ -36,6 +36,7 @@
 #include "gds_hash.h"
 #include "src/mca/gds/gds.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
 
 /*
@@ -55,16 +56,77 @@ pmix_gds_hash_component_t pmix_mca_gds_hash_component = {
 
         /* Component open and close functions */
         .pmix_mca_query_component = component_query,
+        .pmix_mca_register_component_params = component_register,
         .reserved = {0}
     },
     .mysessions = PMIX_LIST_STATIC_INIT,
-    .myjobs = PMIX_LIST_STATIC_INIT
+    .myjobs = PMIX_LIST_STATIC_INIT,
+    .lazy_job_info = false,
+    .lazy_modex = true,
+    .modex_threads = 0,
+    .dense_rank_limit = 65536,
+    .implicit_proc_data = false,
+    .shards = 0
 };
 
+static pmix_status_t component_register(void)
+{
+    pmix_mca_gds_hash_component.lazy_job_info = false;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_gds_hash_component.super, "lazy_job_info",
+        "Keep the per-rank job info received at startup in packed form and "
+        "only unpack the data for a rank when it is first accessed",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_gds_hash_component.lazy_job_info);
+
+    pmix_mca_gds_hash_component.lazy_modex = true;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_gds_hash_component.super, "lazy_modex",
+        "Keep the data of each remote proc received in a fence in packed form "
+        "and only unpack it when the data of that proc is first accessed",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_gds_hash_component.lazy_modex);
+
+    pmix_mca_gds_hash_component.modex_threads = 0;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_gds_hash_component.super, "modex_threads",
+        "Number of threads used to unpack the data received in a fence when "
+        "it is not kept packed (see gds_hash_lazy_modex) - 0 or 1 => unpack it "
+        "on the progress thread",
+        PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_mca_gds_hash_component.modex_threads);
+
+    pmix_mca_gds_hash_component.dense_rank_limit = 65536;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_gds_hash_component.super, "dense_rank_limit",
+        "Index the data of the procs of jobs with up to this many procs "
+        "directly by rank instead of hashing the rank (0 => never)",
+        PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_mca_gds_hash_component.dense_rank_limit);
+
+    pmix_mca_gds_hash_component.implicit_proc_data = false;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_gds_hash_component.super, "implicit_proc_data",
+        "Leave out of the job info sent to clients the hostname, node id, local, "
+        "node and app rank of each proc when they follow from the node and app "
+        "info, and let the client compute them when asked",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_gds_hash_component.implicit_proc_data);
+
+    pmix_mca_gds_hash_component.shards = 0;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_gds_hash_component.super, "shards",
+        "Use the thread-safe module, whose jobs are spread over this many "
+        "reader-writer locks (rounded up to a power of 2) so fetches can be "
+        "served by several threads at once (0 => use the module that may only "
+        "be called from the progress thread)",
+        PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_mca_gds_hash_component.shards);
+    return PMIX_SUCCESS;
+}
+
 static int component_query(pmix_mca_base_module_t **module, int *priority)
 {
     *priority = 10;
-    *module = (pmix_mca_base_module_t *) &pmix_hash_module;
+    if (0 < pmix_mca_gds_hash_component.shards) {
+        *module = (pmix_mca_base_module_t *) &pmix_hash_tsafe_module;
+    } else {
+        *module = (pmix_mca_base_module_t *) &pmix_hash_module;
+    }
     return PMIX_SUCCESS;
 }
 
@@ -97,13 +159,34 @@ static void htcon(pmix_job_t *p)
     PMIX_CONSTRUCT(&p->local, pmix_hash_table_t);
     pmix_hash_table_init(&p->local, 256);
     p->local.ht_label = "local";
+    PMIX_CONSTRUCT(&p->deferred, pmix_hash_table_t);
+    pmix_hash_table_init(&p->deferred, 256);
+    PMIX_CONSTRUCT(&p->modex, pmix_hash_table_t);
+    pmix_hash_table_init(&p->modex, 256);
     p->gdata_added = false;
     PMIX_CONSTRUCT(&p->apps, pmix_list_t);
     PMIX_CONSTRUCT(&p->nodeinfo, pmix_list_t);
     p->session = NULL;
+    p->implicit = false;
+    p->rank_indexed = false;
+    p->nindexed = 0;
+    p->rank_node = NULL;
+    p->rank_lrank = NULL;
+    PMIX_CONSTRUCT(&p->nodes_by_id, pmix_hash_table_t);
+    pmix_hash_table_init(&p->nodes_by_id, 32);
+    PMIX_CONSTRUCT(&p->nodes_by_name, pmix_hash_table_t);
+    pmix_hash_table_init(&p->nodes_by_name, 32);
+    PMIX_CONSTRUCT(&p->apps_by_num, pmix_hash_table_t);
+    pmix_hash_table_init(&p->apps_by_num, 8);
+    PMIX_CONSTRUCT(&p->index_lock, pmix_mutex_t);
 }
 static void htdes(pmix_job_t *p)
 {
+    pmix_byte_object_t *bo;
+    pmix_gds_hash_modex_t *mdx;
+    uint32_t rank;
+    void *node;
+
     if (NULL != p->ns) {
         free(p->ns);
     }
@@ -117,6 +200,28 @@ static void htdes(pmix_job_t *p)
     PMIX_DESTRUCT(&p->remote);
     pmix_hash_remove_data(&p->local, PMIX_RANK_WILDCARD, NULL);
     PMIX_DESTRUCT(&p->local);
+    if (PMIX_SUCCESS == pmix_hash_table_get_first_key_uint32(&p->deferred, &rank,
+                                                             (void **) &bo, &node)) {
+        do {
+            PMIX_BYTE_OBJECT_FREE(bo, 1);
+        } while (PMIX_SUCCESS == pmix_hash_table_get_next_key_uint32(&p->deferred, &rank,
+                                                                     (void **) &bo, node, &node));
+    }
+    PMIX_DESTRUCT(&p->deferred);
+    if (PMIX_SUCCESS == pmix_hash_table_get_first_key_uint32(&p->modex, &rank,
+                                                             (void **) &mdx, &node)) {
+        do {
+            PMIX_RELEASE(mdx);
+        } while (PMIX_SUCCESS == pmix_hash_table_get_next_key_uint32(&p->modex, &rank,
+                                                                     (void **) &mdx, node, &node));
+    }
+    PMIX_DESTRUCT(&p->modex);
+    pmix_gds_hash_release_rank_index(p);
+    /* the indexes don't own the objects they point at */
+    PMIX_DESTRUCT(&p->nodes_by_id);
+    PMIX_DESTRUCT(&p->nodes_by_name);
+    PMIX_DESTRUCT(&p->apps_by_num);
+    PMIX_DESTRUCT(&p->index_lock);
     PMIX_LIST_DESTRUCT(&p->apps);
     PMIX_LIST_DESTRUCT(&p->nodeinfo);
     if (NULL != p->session) {
@@ -139,6 +244,35 @@ static void apdes(pmix_apptrkr_t *p)
 }
 PMIX_CLASS_INSTANCE(pmix_apptrkr_t, pmix_list_item_t, apcon, apdes);
 
+static void kmapcon(pmix_gds_hash_kmap_t *p)
+{
+    p->keys = NULL;
+}
+static void kmapdes(pmix_gds_hash_kmap_t *p)
+{
+    pmix_argv_free(p->keys);
+}
+PMIX_CLASS_INSTANCE(pmix_gds_hash_kmap_t, pmix_object_t, kmapcon, kmapdes);
+
+static void mdxcon(pmix_gds_hash_modex_t *p)
+{
+    p->key_fmt = PMIX_MODEX_KEY_NATIVE_FMT;
+    p->kmap = NULL;
+    p->vtab = NULL;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->bo);
+}
+static void mdxdes(pmix_gds_hash_modex_t *p)
+{
+    if (NULL != p->kmap) {
+        PMIX_RELEASE(p->kmap);
+    }
+    if (NULL != p->vtab) {
+        PMIX_RELEASE(p->vtab);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->bo);
+}
+PMIX_CLASS_INSTANCE(pmix_gds_hash_modex_t, pmix_object_t, mdxcon, mdxdes);
+
 static void ndinfocon(pmix_nodeinfo_t *p)
 {
     p->nodeid = UINT32_MAX;
@@ -0,0 +1,384 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_hash_string.h"
+#include "src/threads/pmix_rwlock.h"
+
+#include "gds_hash.h"
+
+/* The thread-safe variant of the module. The jobs are spread over
+ * a fixed set of shards by the hash of their nspace, each guarded
+ * by a reader-writer lock. A fetch holds the shard of its job
+ * shared, so fetches proceed in parallel with each other and with
+ * stores to any other shard - a fence storing the data of one job
+ * doesn't hold up the Gets of another. Whatever only changes a
+ * single job - a store, a release of modex data, the data of each
+ * proc in a fence - holds its shard exclusive. The rest, which can
+ * touch several jobs or the session list at once, holds every
+ * shard, but that is only done when jobs come and go.
+ *
+ * The shards are picked by nspace alone: the data of all the ranks
+ * of a job are in the same tables, so two ranks of one job cannot
+ * be stored in parallel anyway.
+ *
+ * A fetch that has to unpack data still held packed, or to build
+ * the rank index of the job, changes the job and so holds it
+ * exclusive instead. The list of jobs, the node and app indexes
+ * of a job and the key registry have their own locks. The plain
+ * module is used unless gds_hash_shards is set */
+
+bool pmix_gds_hash_tsafe = false;
+static pmix_rwlock_t *shards = NULL;
+static uint32_t nshards = 0;
+static pmix_mutex_t jobs_lock = PMIX_MUTEX_STATIC_INIT;
+
+static pmix_rwlock_t *shard_of(const char *nspace)
+{
+    uint32_t hash;
+
+    PMIX_HASH_STR(nspace, hash);
+    return &shards[hash & (nshards - 1)];
+}
+
+void pmix_gds_hash_lock_job(const char *nspace, bool exclusive)
+{
+    if (!pmix_gds_hash_tsafe) {
+        return;
+    }
+    if (exclusive) {
+        pmix_rwlock_wrlock(shard_of(nspace));
+    } else {
+        pmix_rwlock_rdlock(shard_of(nspace));
+    }
+}
+
+void pmix_gds_hash_unlock_job(const char *nspace)
+{
+    if (!pmix_gds_hash_tsafe) {
+        return;
+    }
+    pmix_rwlock_unlock(shard_of(nspace));
+}
+
+/* always in the same order, so two of these can't deadlock */
+void pmix_gds_hash_lock_all(void)
+{
+    uint32_t n;
+
+    if (!pmix_gds_hash_tsafe) {
+        return;
+    }
+    for (n = 0; n < nshards; n++) {
+        pmix_rwlock_wrlock(&shards[n]);
+    }
+}
+
+void pmix_gds_hash_unlock_all(void)
+{
+    uint32_t n;
+
+    if (!pmix_gds_hash_tsafe) {
+        return;
+    }
+    for (n = nshards; 0 < n; n--) {
+        pmix_rwlock_unlock(&shards[n - 1]);
+    }
+}
+
+void pmix_gds_hash_lock_jobs(void)
+{
+    if (pmix_gds_hash_tsafe) {
+        pmix_mutex_lock(&jobs_lock);
+    }
+}
+
+void pmix_gds_hash_unlock_jobs(void)
+{
+    if (pmix_gds_hash_tsafe) {
+        pmix_mutex_unlock(&jobs_lock);
+    }
+}
+
+/* does a fetch of the data of this proc change the job? */
+static bool fetch_changes_job(const pmix_proc_t *proc, const char *key)
+{
+    pmix_job_t *trk;
+    void *ptr;
+
+    trk = pmix_gds_hash_get_tracker(proc->nspace, false);
+    if (NULL == trk) {
+        return false;
+    }
+    if (trk->implicit && !trk->rank_indexed) {
+        return true;
+    }
+    if (PMIX_RANK_IS_VALID(proc->rank)) {
+        return (0 < pmix_hash_table_get_size(&trk->deferred)
+                && PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&trk->deferred, proc->rank,
+                                                                    &ptr))
+               || (0 < pmix_hash_table_get_size(&trk->modex)
+                   && PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&trk->modex, proc->rank,
+                                                                       &ptr));
+    }
+    if (PMIX_RANK_UNDEF == proc->rank || NULL == key) {
+        return 0 < pmix_hash_table_get_size(&trk->deferred)
+               || 0 < pmix_hash_table_get_size(&trk->modex);
+    }
+    return false;
+}
+
+static pmix_status_t tsafe_init(pmix_info_t info[], size_t ninfo)
+{
+    uint32_t n;
+
+    nshards = 1;
+    while (nshards < (uint32_t) pmix_mca_gds_hash_component.shards) {
+        nshards <<= 1;
+    }
+    shards = (pmix_rwlock_t *) malloc(nshards * sizeof(pmix_rwlock_t));
+    if (NULL == shards) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nshards; n++) {
+        pmix_rwlock_init(&shards[n]);
+    }
+    pmix_gds_hash_tsafe = true;
+    pmix_hash_lock_keys();
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "gds:hash thread-safe module with %u shards", nshards);
+    return pmix_hash_module.init(info, ninfo);
+}
+
+static void tsafe_finalize(void)
+{
+    uint32_t n;
+
+    pmix_hash_module.finalize();
+    pmix_gds_hash_tsafe = false;
+    for (n = 0; n < nshards; n++) {
+        pmix_rwlock_destroy(&shards[n]);
+    }
+    free(shards);
+    shards = NULL;
+    nshards = 0;
+}
+
+static pmix_status_t tsafe_assign_module(pmix_info_t *info, size_t ninfo, int *priority)
+{
+    return pmix_hash_module.assign_module(info, ninfo, priority);
+}
+
+static pmix_status_t tsafe_cache_job_info(struct pmix_namespace_t *ns, pmix_info_t info[],
+                                          size_t ninfo)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.cache_job_info(ns, info, ninfo);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_register_job_info(struct pmix_peer_t *pr, pmix_buffer_t *reply)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.register_job_info(pr, reply);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_share_job_info(struct pmix_peer_t *pr, pmix_buffer_t **reply)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.share_job_info(pr, reply);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_store_job_info(const char *nspace, pmix_buffer_t *buf)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.store_job_info(nspace, buf);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_stream_job_info(const char *nspace, pmix_buffer_t *buf, bool last)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.stream_job_info(nspace, buf, last);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_store(const pmix_proc_t *proc, pmix_scope_t scope, pmix_kval_t *kv)
+{
+    pmix_status_t rc;
+
+    if (NULL != kv->key
+        && (PMIX_CHECK_KEY(kv, PMIX_NODE_INFO_ARRAY) || PMIX_CHECK_KEY(kv, PMIX_APP_INFO_ARRAY)
+            || PMIX_CHECK_KEY(kv, PMIX_SESSION_INFO_ARRAY))) {
+        /* these can add to the session list */
+        pmix_gds_hash_lock_all();
+        rc = pmix_gds_hash_store(proc, scope, kv);
+        pmix_gds_hash_unlock_all();
+        return rc;
+    }
+    pmix_gds_hash_lock_job(proc->nspace, true);
+    rc = pmix_gds_hash_store(proc, scope, kv);
+    pmix_gds_hash_unlock_job(proc->nspace);
+    return rc;
+}
+
+static pmix_status_t tsafe_fetch(const pmix_proc_t *proc, pmix_scope_t scope, bool copy,
+                                 const char *key, pmix_info_t qualifiers[], size_t nqual,
+                                 pmix_list_t *kvs)
+{
+    pmix_status_t rc;
+    bool exclusive;
+
+    pmix_gds_hash_lock_job(proc->nspace, false);
+    exclusive = fetch_changes_job(proc, key);
+    if (exclusive) {
+        /* the job may change while we switch - the fetch
+         * itself copes with whatever it finds */
+        pmix_gds_hash_unlock_job(proc->nspace);
+        pmix_gds_hash_lock_job(proc->nspace, true);
+    }
+    rc = pmix_gds_hash_fetch(proc, scope, copy, key, qualifiers, nqual, kvs);
+    pmix_gds_hash_unlock_job(proc->nspace);
+    return rc;
+}
+
+/* the data of each proc in a fence is stored under the lock
+ * of its own job - see _hash_store_modex */
+static pmix_status_t tsafe_store_modex(struct pmix_namespace_t *ns, pmix_buffer_t *buff,
+                                       void *cbdata)
+{
+    return pmix_hash_module.store_modex(ns, buff, cbdata);
+}
+
+static pmix_status_t tsafe_setup_fork(const pmix_proc_t *proc, char ***env)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_job(proc->nspace, false);
+    rc = pmix_hash_module.setup_fork(proc, env);
+    pmix_gds_hash_unlock_job(proc->nspace);
+    return rc;
+}
+
+static pmix_status_t tsafe_add_nspace(const char *nspace, uint32_t nlocalprocs,
+                                      pmix_info_t info[], size_t ninfo)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.add_nspace(nspace, nlocalprocs, info, ninfo);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_del_nspace(const char *nspace)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.del_nspace(nspace);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_assemb_kvs_req(const pmix_proc_t *proc, pmix_list_t *kvs,
+                                          pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_job(proc->nspace, false);
+    rc = pmix_hash_module.assemb_kvs_req(proc, kvs, buf, cbdata);
+    pmix_gds_hash_unlock_job(proc->nspace);
+    return rc;
+}
+
+static pmix_status_t tsafe_accept_kvs_resp(pmix_buffer_t *buf)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_hash_module.accept_kvs_resp(buf);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_fetch_arrays(struct pmix_peer_t *pr, pmix_buffer_t *reply)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_all();
+    rc = pmix_gds_hash_fetch_arrays(pr, reply);
+    pmix_gds_hash_unlock_all();
+    return rc;
+}
+
+static pmix_status_t tsafe_release_modex(const char *nspace, pmix_rank_t rank)
+{
+    pmix_status_t rc;
+
+    pmix_gds_hash_lock_job(nspace, true);
+    rc = pmix_gds_hash_release_modex(nspace, rank);
+    pmix_gds_hash_unlock_job(nspace);
+    return rc;
+}
+
+static pmix_status_t tsafe_fetch_changed(const pmix_proc_t *proc, uint64_t since,
+                                         uint64_t *epoch, pmix_list_t *kvs)
+{
+    pmix_status_t rc;
+
+    /* may unpack what is still packed for the rank */
+    pmix_gds_hash_lock_job(proc->nspace, true);
+    rc = pmix_gds_hash_fetch_changed(proc, since, epoch, kvs);
+    pmix_gds_hash_unlock_job(proc->nspace);
+    return rc;
+}
+
+pmix_gds_base_module_t pmix_hash_tsafe_module = {
+    .name = "hash",
+    .is_tsafe = true,
+    .init = tsafe_init,
+    .finalize = tsafe_finalize,
+    .assign_module = tsafe_assign_module,
+    .cache_job_info = tsafe_cache_job_info,
+    .register_job_info = tsafe_register_job_info,
+    .share_job_info = tsafe_share_job_info,
+    .store_job_info = tsafe_store_job_info,
+    .stream_job_info = tsafe_stream_job_info,
+    .store = tsafe_store,
+    .store_modex = tsafe_store_modex,
+    .fetch = tsafe_fetch,
+    .setup_fork = tsafe_setup_fork,
+    .add_nspace = tsafe_add_nspace,
+    .del_nspace = tsafe_del_nspace,
+    .assemb_kvs_req = tsafe_assemb_kvs_req,
+    .accept_kvs_resp = tsafe_accept_kvs_resp,
+    .fetch_arrays = tsafe_fetch_arrays,
+    .release_modex = tsafe_release_modex,
+    .fetch_changed = tsafe_fetch_changed
+};
@@ -41,6 +41,7 @@
 #include "src/mca/preg/preg.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/server/pmix_server_ops.h"
+#include "src/threads/pmix_threads.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_hash.h"
@@ -51,7 +52,7 @@
 #include "gds_hash.h"
 #include "src/mca/gds/base/base.h"
 
-pmix_job_t *pmix_gds_hash_get_tracker(const pmix_nspace_t nspace, bool create)
+static pmix_job_t *get_tracker(const pmix_nspace_t nspace, bool create)
 {
     pmix_job_t *trk, *t;
     pmix_namespace_t *ns, *nptr;
@@ -92,6 +93,32 @@ pmix_job_t *pmix_gds_hash_get_tracker(const pmix_nspace_t nspace, bool create)
     return trk;
 }
 
+pmix_job_t *pmix_gds_hash_get_tracker(const pmix_nspace_t nspace, bool create)
+{
+    pmix_job_t *trk;
+
+    /* with the thread-safe module, a fetch of one job
+     * may look for it while another job is added */
+    pmix_gds_hash_lock_jobs();
+    trk = get_tracker(nspace, create);
+    pmix_gds_hash_unlock_jobs();
+    return trk;
+}
+
+/* once the job size is known, the data of each rank in the tables
+ * that hold every rank of the job can be found without hashing */
+void pmix_gds_hash_set_job_size(pmix_job_t *trk, uint32_t nprocs)
+{
+    trk->nptr->nprocs = nprocs;
+    if (0 == nprocs || 0 >= pmix_mca_gds_hash_component.dense_rank_limit
+        || (uint32_t) pmix_mca_gds_hash_component.dense_rank_limit < nprocs) {
+        return;
+    }
+    /* failing to do so just means the ranks keep being hashed */
+    (void) pmix_hash_table_set_dense_uint32(&trk->internal, nprocs);
+    (void) pmix_hash_table_set_dense_uint32(&trk->remote, nprocs);
+}
+
 bool pmix_gds_hash_check_hostname(char *h1, char *h2)
 {
     if (0 == strcmp(h1, h2)) {
@@ -289,149 +316,315 @@ pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname
     return NULL;
 }
 
-pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn, uint32_t flags)
+/* Nodes and apps are never removed from the lists of a job, but
+ * a node may only learn its nodeid or hostname after it was listed.
+ * So rather than keeping the index in step with every change made
+ * to the lists, it is filled by the lookups themselves: a miss
+ * falls back to scanning the list and records what it found, and
+ * a hit is checked against the record it points at */
+
+static bool node_has_name(pmix_nodeinfo_t *nd, const char *hostname)
+{
+    int i;
+
+    if (NULL != nd->hostname && 0 == strcmp(nd->hostname, hostname)) {
+        return true;
+    }
+    for (i = 0; NULL != nd->aliases && NULL != nd->aliases[i]; i++) {
+        if (0 == strcmp(nd->aliases[i], hostname)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static pmix_nodeinfo_t *find_node(pmix_job_t *trk, uint32_t nid, const char *hostname)
+{
+    pmix_nodeinfo_t *nd;
+    size_t len;
+
+    if (UINT32_MAX != nid) {
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&trk->nodes_by_id, nid,
+                                                             (void **) &nd)
+            && nid == nd->nodeid) {
+            return nd;
+        }
+        PMIX_LIST_FOREACH (nd, &trk->nodeinfo, pmix_nodeinfo_t) {
+            if (nid == nd->nodeid) {
+                pmix_hash_table_set_value_uint32(&trk->nodes_by_id, nid, nd);
+                return nd;
+            }
+        }
+        return NULL;
+    }
+    if (NULL == hostname) {
+        return NULL;
+    }
+    len = strlen(hostname);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&trk->nodes_by_name, hostname, len,
+                                                      (void **) &nd)
+        && node_has_name(nd, hostname)) {
+        return nd;
+    }
+    nd = pmix_gds_hash_check_nodename(&trk->nodeinfo, (char *) hostname);
+    if (NULL != nd) {
+        pmix_hash_table_set_value_ptr(&trk->nodes_by_name, hostname, len, nd);
+    }
+    return nd;
+}
+
+static pmix_apptrkr_t *find_app(pmix_job_t *trk, uint32_t appnum)
+{
+    pmix_apptrkr_t *app;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&trk->apps_by_num, appnum,
+                                                         (void **) &app)
+        && appnum == app->appnum) {
+        return app;
+    }
+    PMIX_LIST_FOREACH (app, &trk->apps, pmix_apptrkr_t) {
+        if (appnum == app->appnum) {
+            pmix_hash_table_set_value_uint32(&trk->apps_by_num, appnum, app);
+            return app;
+        }
+    }
+    return NULL;
+}
+
+/* the thread-safe module lets several fetches of a job
+ * in at once, and each may add to the index */
+pmix_nodeinfo_t *pmix_gds_hash_lookup_node(pmix_job_t *trk, uint32_t nid, const char *hostname)
+{
+    pmix_nodeinfo_t *nd;
+
+    if (!pmix_gds_hash_tsafe) {
+        return find_node(trk, nid, hostname);
+    }
+    pmix_mutex_lock(&trk->index_lock);
+    nd = find_node(trk, nid, hostname);
+    pmix_mutex_unlock(&trk->index_lock);
+    return nd;
+}
+
+pmix_apptrkr_t *pmix_gds_hash_lookup_app(pmix_job_t *trk, uint32_t appnum)
+{
+    pmix_apptrkr_t *app;
+
+    if (!pmix_gds_hash_tsafe) {
+        return find_app(trk, appnum);
+    }
+    pmix_mutex_lock(&trk->index_lock);
+    app = find_app(trk, appnum);
+    pmix_mutex_unlock(&trk->index_lock);
+    return app;
+}
+
+/* track the storage of a node map as the names
+ * are extracted from the regex */
+typedef struct {
+    pmix_job_t *trk;
+    char **ppn;
+    size_t nppn;
+    uint32_t flags;
+    size_t nnodes;
+    uint32_t totalprocs;
+    /* the comma-delimited list of node names - built as we
+     * go and stored as-is for PMIx v2 clients */
+    char *list;
+    size_t len;
+    size_t size;
+} store_map_t;
+
+static pmix_status_t append_node_list(store_map_t *map, const char *name)
+{
+    size_t need;
+    char *tmp;
+
+    /* room for the name, a separator, and the NUL terminator */
+    need = map->len + strlen(name) + 2;
+    if (need > map->size) {
+        if (need < 2 * map->size) {
+            need = 2 * map->size;
+        }
+        tmp = (char *) realloc(map->list, need);
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        map->list = tmp;
+        map->size = need;
+    }
+    if (0 < map->len) {
+        map->list[map->len++] = ',';
+    }
+    strcpy(&map->list[map->len], name);
+    map->len += strlen(name);
+    return PMIX_SUCCESS;
+}
+
+/* store the info for one node in the map, in the
+ * order in which it appears in the node regex */
+static pmix_status_t store_map_node(const char *name, void *cbdata)
 {
+    store_map_t *map = (store_map_t *) cbdata;
+    pmix_job_t *trk = map->trk;
+    pmix_hash_table_t *ht = &trk->internal;
     pmix_status_t rc;
     size_t m, n;
     pmix_rank_t rank;
     pmix_kval_t *kp1, *kp2;
     char **procs;
-    uint32_t totalprocs = 0;
-    pmix_hash_table_t *ht = &trk->internal;
     pmix_nodeinfo_t *nd;
 
-    pmix_output_verbose(2, pmix_gds_base_framework.framework_output, "[%s:%d] gds:hash:store_map",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank);
-
     /* if the lists don't match, then that's wrong */
-    if (pmix_argv_count(nodes) != pmix_argv_count(ppn)) {
+    n = map->nnodes;
+    if (n >= map->nppn) {
         PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
         return PMIX_ERR_BAD_PARAM;
     }
+    ++map->nnodes;
 
-    /* if they didn't provide the number of nodes, then
-     * compute it from the list of nodes */
-    if (!(PMIX_HASH_NUM_NODES & flags)) {
-        kp2 = PMIX_NEW(pmix_kval_t);
-        kp2->key = strdup(PMIX_NUM_NODES);
-        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-        kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = pmix_argv_count(nodes);
-        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                            "[%s:%d] gds:hash:store_map adding key %s to job info",
-                            pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key);
-        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(kp2);
-            return rc;
-        }
-        PMIX_RELEASE(kp2); // maintain acctg
+    if (PMIX_SUCCESS != (rc = append_node_list(map, name))) {
+        return rc;
     }
 
-    for (n = 0; NULL != nodes[n]; n++) {
-        /* check and see if we already have this node */
-        nd = pmix_gds_hash_check_nodename(&trk->nodeinfo, nodes[n]);
-        if (NULL == nd) {
-            nd = PMIX_NEW(pmix_nodeinfo_t);
-            nd->hostname = strdup(nodes[n]);
-            nd->nodeid = n;
-            pmix_list_append(&trk->nodeinfo, &nd->super);
-        }
-        /* store the proc list as-is */
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
-        }
-        kp2->key = strdup(PMIX_LOCAL_PEERS);
-        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-        if (NULL == kp2->value) {
-            PMIX_RELEASE(kp2);
-            return PMIX_ERR_NOMEM;
-        }
-        kp2->value->type = PMIX_STRING;
-        kp2->value->data.string = strdup(ppn[n]);
-        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                            "[%s:%d] gds:hash:store_map adding key %s to node %s info",
-                            pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key, nodes[n]);
-        /* ensure this item only appears once on the list */
-        PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
-            if (PMIX_CHECK_KEY(kp1, kp2->key)) {
-                pmix_list_remove_item(&nd->info, &kp1->super);
-                PMIX_RELEASE(kp1);
-                break;
-            }
+    /* check and see if we already have this node */
+    nd = pmix_gds_hash_check_nodename(&trk->nodeinfo, (char *) name);
+    if (NULL == nd) {
+        nd = PMIX_NEW(pmix_nodeinfo_t);
+        nd->hostname = strdup(name);
+        nd->nodeid = n;
+        pmix_list_append(&trk->nodeinfo, &nd->super);
+    }
+    /* store the proc list as-is */
+    kp2 = PMIX_NEW(pmix_kval_t);
+    if (NULL == kp2) {
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->key = strdup(PMIX_LOCAL_PEERS);
+    kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+    if (NULL == kp2->value) {
+        PMIX_RELEASE(kp2);
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->value->type = PMIX_STRING;
+    kp2->value->data.string = strdup(map->ppn[n]);
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:store_map adding key %s to node %s info",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key, name);
+    /* ensure this item only appears once on the list */
+    PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
+        if (PMIX_CHECK_KEY(kp1, kp2->key)) {
+            pmix_list_remove_item(&nd->info, &kp1->super);
+            PMIX_RELEASE(kp1);
+            break;
         }
-        pmix_list_append(&nd->info, &kp2->super);
+    }
+    pmix_list_append(&nd->info, &kp2->super);
 
-        /* save the local leader */
-        rank = strtoul(ppn[n], NULL, 10);
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
-        }
-        kp2->key = strdup(PMIX_LOCALLDR);
-        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-        if (NULL == kp2->value) {
-            PMIX_RELEASE(kp2);
-            return PMIX_ERR_NOMEM;
-        }
-        kp2->value->type = PMIX_PROC_RANK;
-        kp2->value->data.rank = rank;
-        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                            "[%s:%d] gds:hash:store_map adding key %s to node %s info",
-                            pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key, nodes[n]);
-        /* ensure this item only appears once on the list */
-        PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
-            if (PMIX_CHECK_KEY(kp1, kp2->key)) {
-                pmix_list_remove_item(&nd->info, &kp1->super);
-                PMIX_RELEASE(kp1);
-                break;
-            }
+    /* save the local leader */
+    rank = strtoul(map->ppn[n], NULL, 10);
+    kp2 = PMIX_NEW(pmix_kval_t);
+    if (NULL == kp2) {
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->key = strdup(PMIX_LOCALLDR);
+    kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+    if (NULL == kp2->value) {
+        PMIX_RELEASE(kp2);
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->value->type = PMIX_PROC_RANK;
+    kp2->value->data.rank = rank;
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:store_map adding key %s to node %s info",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key, name);
+    /* ensure this item only appears once on the list */
+    PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
+        if (PMIX_CHECK_KEY(kp1, kp2->key)) {
+            pmix_list_remove_item(&nd->info, &kp1->super);
+            PMIX_RELEASE(kp1);
+            break;
         }
-        pmix_list_append(&nd->info, &kp2->super);
+    }
+    pmix_list_append(&nd->info, &kp2->super);
 
-        /* split the list of procs so we can store their
-         * individual location data */
-        procs = pmix_argv_split(ppn[n], ',');
-        /* save the local size in case they don't
-         * give it to us */
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            pmix_argv_free(procs);
-            return PMIX_ERR_NOMEM;
+    /* split the list of procs so we can store their
+     * individual location data */
+    procs = pmix_argv_split(map->ppn[n], ',');
+    /* save the local size in case they don't
+     * give it to us */
+    kp2 = PMIX_NEW(pmix_kval_t);
+    if (NULL == kp2) {
+        pmix_argv_free(procs);
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->key = strdup(PMIX_LOCAL_SIZE);
+    kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+    if (NULL == kp2->value) {
+        PMIX_RELEASE(kp2);
+        pmix_argv_free(procs);
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->value->type = PMIX_UINT32;
+    kp2->value->data.uint32 = pmix_argv_count(procs);
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:store_map adding key %s to node %s info",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key, name);
+    /* ensure this item only appears once on the list */
+    PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
+        if (PMIX_CHECK_KEY(kp1, kp2->key)) {
+            pmix_list_remove_item(&nd->info, &kp1->super);
+            PMIX_RELEASE(kp1);
+            break;
         }
-        kp2->key = strdup(PMIX_LOCAL_SIZE);
+    }
+    pmix_list_append(&nd->info, &kp2->super);
+    /* track total procs in job in case they
+     * didn't give it to us */
+    map->totalprocs += pmix_argv_count(procs);
+    for (m = 0; NULL != procs[m]; m++) {
+        /* store the hostname for each proc */
+        kp2 = PMIX_NEW(pmix_kval_t);
+        kp2->key = strdup(PMIX_HOSTNAME);
         kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-        if (NULL == kp2->value) {
+        kp2->value->type = PMIX_STRING;
+        kp2->value->data.string = strdup(name);
+        rank = strtol(procs[m], NULL, 10);
+        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                            "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
+                            kp2->key);
+        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2, NULL, 0))) {
+            PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(kp2);
             pmix_argv_free(procs);
-            return PMIX_ERR_NOMEM;
+            return rc;
         }
-        kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = pmix_argv_count(procs);
-        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                            "[%s:%d] gds:hash:store_map adding key %s to node %s info",
-                            pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key, nodes[n]);
-        /* ensure this item only appears once on the list */
-        PMIX_LIST_FOREACH (kp1, &nd->info, pmix_kval_t) {
-            if (PMIX_CHECK_KEY(kp1, kp2->key)) {
-                pmix_list_remove_item(&nd->info, &kp1->super);
-                PMIX_RELEASE(kp1);
-                break;
+        PMIX_RELEASE(kp2); // maintain acctg
+        if (!(PMIX_HASH_PROC_DATA & map->flags)) {
+            /* add an entry for the nodeid */
+            kp2 = PMIX_NEW(pmix_kval_t);
+            kp2->key = strdup(PMIX_NODEID);
+            kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+            kp2->value->type = PMIX_UINT32;
+            pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                                "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
+                                pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
+                                kp2->key);
+            kp2->value->data.uint32 = n;
+            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2, NULL, 0))) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_RELEASE(kp2);
+                pmix_argv_free(procs);
+                return rc;
             }
-        }
-        pmix_list_append(&nd->info, &kp2->super);
-        /* track total procs in job in case they
-         * didn't give it to us */
-        totalprocs += pmix_argv_count(procs);
-        for (m = 0; NULL != procs[m]; m++) {
-            /* store the hostname for each proc */
+            PMIX_RELEASE(kp2); // maintain acctg
+            /* add an entry for the local rank */
             kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(PMIX_HOSTNAME);
+            kp2->key = strdup(PMIX_LOCAL_RANK);
             kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-            kp2->value->type = PMIX_STRING;
-            kp2->value->data.string = strdup(nodes[n]);
-            rank = strtol(procs[m], NULL, 10);
+            kp2->value->type = PMIX_UINT16;
+            kp2->value->data.uint16 = m;
             pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                                 "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
                                 pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
@@ -443,62 +636,77 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
                 return rc;
             }
             PMIX_RELEASE(kp2); // maintain acctg
-            if (!(PMIX_HASH_PROC_DATA & flags)) {
-                /* add an entry for the nodeid */
-                kp2 = PMIX_NEW(pmix_kval_t);
-                kp2->key = strdup(PMIX_NODEID);
-                kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-                kp2->value->type = PMIX_UINT32;
-                pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                                    "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
-                                    pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
-                                    kp2->key);
-                kp2->value->data.uint32 = n;
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2, NULL, 0))) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(kp2);
-                    pmix_argv_free(procs);
-                    return rc;
-                }
-                PMIX_RELEASE(kp2); // maintain acctg
-                /* add an entry for the local rank */
-                kp2 = PMIX_NEW(pmix_kval_t);
-                kp2->key = strdup(PMIX_LOCAL_RANK);
-                kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-                kp2->value->type = PMIX_UINT16;
-                kp2->value->data.uint16 = m;
-                pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                                    "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
-                                    pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
-                                    kp2->key);
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2, NULL, 0))) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(kp2);
-                    pmix_argv_free(procs);
-                    return rc;
-                }
-                PMIX_RELEASE(kp2); // maintain acctg
-                /* add an entry for the node rank - for now, we assume
-                 * only the one job is running */
-                kp2 = PMIX_NEW(pmix_kval_t);
-                kp2->key = strdup(PMIX_NODE_RANK);
-                kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-                kp2->value->type = PMIX_UINT16;
-                kp2->value->data.uint16 = m;
-                pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                                    "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
-                                    pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
-                                    kp2->key);
-                if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2, NULL, 0))) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(kp2);
-                    pmix_argv_free(procs);
-                    return rc;
-                }
-                PMIX_RELEASE(kp2); // maintain acctg
+            /* add an entry for the node rank - for now, we assume
+             * only the one job is running */
+            kp2 = PMIX_NEW(pmix_kval_t);
+            kp2->key = strdup(PMIX_NODE_RANK);
+            kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+            kp2->value->type = PMIX_UINT16;
+            kp2->value->data.uint16 = m;
+            pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                                "[%s:%d] gds:hash:store_map for [%s:%u]: key %s",
+                                pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, rank,
+                                kp2->key);
+            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2, NULL, 0))) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_RELEASE(kp2);
+                pmix_argv_free(procs);
+                return rc;
             }
+            PMIX_RELEASE(kp2); // maintain acctg
         }
-        pmix_argv_free(procs);
+    }
+    pmix_argv_free(procs);
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, const char *nodemap, char **ppn,
+                                      uint32_t flags)
+{
+    pmix_status_t rc;
+    store_map_t map;
+    pmix_kval_t *kp2;
+    pmix_hash_table_t *ht = &trk->internal;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output, "[%s:%d] gds:hash:store_map",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank);
+
+    memset(&map, 0, sizeof(map));
+    map.trk = trk;
+    map.ppn = ppn;
+    map.nppn = pmix_argv_count(ppn);
+    map.flags = flags;
+
+    /* store each node as its name is extracted so
+     * we never hold the fully expanded list */
+    rc = pmix_preg.parse_nodes_stream(nodemap, store_map_node, &map);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    /* if the lists don't match, then that's wrong */
+    if (map.nnodes != map.nppn) {
+        rc = PMIX_ERR_BAD_PARAM;
+        PMIX_ERROR_LOG(rc);
+        goto done;
+    }
+
+    /* if they didn't provide the number of nodes, then
+     * compute it from the list of nodes */
+    if (!(PMIX_HASH_NUM_NODES & flags)) {
+        kp2 = PMIX_NEW(pmix_kval_t);
+        kp2->key = strdup(PMIX_NUM_NODES);
+        kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        kp2->value->type = PMIX_UINT32;
+        kp2->value->data.uint32 = map.nnodes;
+        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                            "[%s:%d] gds:hash:store_map adding key %s to job info",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank, kp2->key);
+        if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(kp2);
+            goto done;
+        }
+        PMIX_RELEASE(kp2); // maintain acctg
     }
 
     /* store the comma-delimited list of nodes hosting
@@ -508,14 +716,15 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
     kp2->key = strdup(PMIX_NODE_LIST);
     kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
     kp2->value->type = PMIX_STRING;
-    kp2->value->data.string = pmix_argv_join(nodes, ',');
+    kp2->value->data.string = map.list;
+    map.list = NULL; // the kval now owns it
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%d] gds:hash:store_map for nspace %s: key %s",
                         pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
     if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(kp2);
-        return rc;
+        goto done;
     }
     PMIX_RELEASE(kp2); // maintain acctg
 
@@ -527,18 +736,17 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
         kp2->key = strdup(PMIX_JOB_SIZE);
         kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
         kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = totalprocs;
+        kp2->value->data.uint32 = map.totalprocs;
         pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                             "[%s:%d] gds:hash:store_map for nspace %s: key %s",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
         if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(kp2);
-            return rc;
+            goto done;
         }
         PMIX_RELEASE(kp2); // maintain acctg
-        flags |= PMIX_HASH_JOB_SIZE;
-        trk->nptr->nprocs = totalprocs;
+        pmix_gds_hash_set_job_size(trk, map.totalprocs);
     }
 
     /* if they didn't provide a value for max procs, just
@@ -549,20 +757,23 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
         kp2->key = strdup(PMIX_MAX_PROCS);
         kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
         kp2->value->type = PMIX_UINT32;
-        kp2->value->data.uint32 = totalprocs;
+        kp2->value->data.uint32 = map.totalprocs;
         pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                             "[%s:%d] gds:hash:store_map for nspace %s: key %s",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank, trk->ns, kp2->key);
         if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2, NULL, 0))) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(kp2);
-            return rc;
+            goto done;
         }
         PMIX_RELEASE(kp2); // maintain acctg
-        flags |= PMIX_HASH_MAX_PROCS;
     }
 
-    return PMIX_SUCCESS;
+done:
+    if (NULL != map.list) {
+        free(map.list);
+    }
+    return rc;
 }
 
 pmix_status_t pmix_gds_hash_store_qualified(pmix_hash_table_t *ht,
@@ -600,3 +811,812 @@ pmix_status_t pmix_gds_hash_store_qualified(pmix_hash_table_t *ht,
     PMIX_INFO_FREE(quals, nquals);
     return rc;
 }
+
+/* unpack a PMIX_PROC_BLOB - the rank followed by the kvals
+ * for that rank - into the internal hash table of the job */
+pmix_status_t pmix_gds_hash_store_proc_blob(pmix_job_t *trk, pmix_buffer_t *buf)
+{
+    pmix_status_t rc;
+    pmix_rank_t rank;
+    pmix_kval_t kv;
+    int32_t cnt;
+
+    /* start by unpacking the rank */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &rank, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    /* unpack the blob and save the values for this rank */
+    cnt = 1;
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &kv, &cnt, PMIX_KVAL);
+    while (PMIX_SUCCESS == rc) {
+        /* this is data provided by a job-level exchange, so store it
+         * in the job-level data hash_table */
+        pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                            "%s pmix:gds:hash store proc info for rank %u working key %s",
+                            PMIX_NAME_PRINT(&pmix_globals.myid), rank, kv.key);
+        if (PMIX_CHECK_KEY(&kv, PMIX_QUALIFIED_VALUE)) {
+            rc = pmix_gds_hash_store_qualified(&trk->internal, rank, kv.value);
+        } else {
+            rc = pmix_hash_store(&trk->internal, rank, &kv, NULL, 0);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&kv);
+            return rc;
+        }
+        cnt = 1;
+        PMIX_DESTRUCT(&kv);
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &kv, &cnt, PMIX_KVAL);
+    }
+    PMIX_DESTRUCT(&kv);
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* hold a PMIX_PROC_BLOB in packed form until the data for its
+ * rank is requested. Only the rank is unpacked - ownership of
+ * the bytes in the byte object is transferred to the tracker */
+pmix_status_t pmix_gds_hash_defer_proc_blob(pmix_job_t *trk, pmix_byte_object_t *bo)
+{
+    pmix_byte_object_t *saved;
+    pmix_buffer_t buf;
+    pmix_rank_t rank;
+    pmix_status_t rc;
+    int32_t cnt;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_client_globals.myserver, &buf, bo->bytes, bo->size);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, &buf, &rank, &cnt, PMIX_PROC_RANK);
+    buf.base_ptr = NULL;
+    PMIX_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* a second blob for the same rank must land on top
+     * of the first one, so expand the earlier one now */
+    rc = pmix_gds_hash_expand_rank(trk, rank);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    saved = (pmix_byte_object_t *) malloc(sizeof(pmix_byte_object_t));
+    if (NULL == saved) {
+        return PMIX_ERR_NOMEM;
+    }
+    saved->bytes = bo->bytes;
+    saved->size = bo->size;
+    bo->bytes = NULL;
+    bo->size = 0;
+    rc = pmix_hash_table_set_value_uint32(&trk->deferred, rank, saved);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_BYTE_OBJECT_FREE(saved, 1);
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+/* unpack the kvals of a remote proc's modex data and store them
+ * in the remote hash table */
+pmix_status_t pmix_gds_hash_store_modex_kvals(pmix_job_t *trk, pmix_rank_t rank,
+                                              pmix_gds_modex_key_fmt_t key_fmt,
+                                              char **kmap, pmix_gds_modex_vtab_t *vtab,
+                                              pmix_buffer_t *pbkt)
+{
+    pmix_status_t rc;
+    pmix_kval_t kv;
+
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    rc = pmix_gds_base_modex_unpack_kval(key_fmt, pbkt, kmap, vtab, &kv);
+    while (PMIX_SUCCESS == rc) {
+        if (PMIX_CHECK_KEY(&kv, PMIX_QUALIFIED_VALUE)) {
+            rc = pmix_gds_hash_store_qualified(&trk->remote, rank, kv.value);
+        } else if (PMIX_GDS_MODEX_VTAB_HOLDS(vtab, kv.value)) {
+            /* common to several ranks - keep one copy for all */
+            rc = pmix_hash_store_shared(&trk->remote, rank, &kv, &vtab->super);
+        } else {
+            rc = pmix_hash_store(&trk->remote, rank, &kv, NULL, 0);
+        }
+        if (PMIX_GDS_MODEX_VTAB_HOLDS(vtab, kv.value)) {
+            kv.value = NULL;
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&kv);
+            return rc;
+        }
+        PMIX_DESTRUCT(&kv);
+        /* continue along */
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        rc = pmix_gds_base_modex_unpack_kval(key_fmt, pbkt, kmap, vtab, &kv);
+    }
+    PMIX_DESTRUCT(&kv);
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* copy the unread part of a remote proc's modex data - the key
+ * map and value table are shared by all ranks of the blob */
+static pmix_status_t copy_modex(pmix_gds_modex_key_fmt_t key_fmt, pmix_gds_hash_kmap_t *kmap,
+                                pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt,
+                                pmix_gds_hash_modex_t **mdxout)
+{
+    pmix_gds_hash_modex_t *mdx;
+    size_t size;
+
+    *mdxout = NULL;
+    size = pbkt->bytes_used - (pbkt->unpack_ptr - pbkt->base_ptr);
+    if (0 == size) {
+        return PMIX_SUCCESS;
+    }
+    mdx = PMIX_NEW(pmix_gds_hash_modex_t);
+    if (NULL == mdx) {
+        return PMIX_ERR_NOMEM;
+    }
+    mdx->bo.bytes = (char *) malloc(size);
+    if (NULL == mdx->bo.bytes) {
+        PMIX_RELEASE(mdx);
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(mdx->bo.bytes, pbkt->unpack_ptr, size);
+    mdx->bo.size = size;
+    mdx->key_fmt = key_fmt;
+    if (NULL != kmap) {
+        PMIX_RETAIN(kmap);
+        mdx->kmap = kmap;
+    }
+    if (NULL != vtab) {
+        PMIX_RETAIN(vtab);
+        mdx->vtab = vtab;
+    }
+    *mdxout = mdx;
+    return PMIX_SUCCESS;
+}
+
+/* hold the unread part of a remote proc's modex data in packed
+ * form until the data for its rank is requested */
+pmix_status_t pmix_gds_hash_defer_modex(pmix_job_t *trk, pmix_rank_t rank,
+                                        pmix_gds_modex_key_fmt_t key_fmt,
+                                        pmix_gds_hash_kmap_t *kmap,
+                                        pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt)
+{
+    pmix_gds_hash_modex_t *mdx;
+    pmix_status_t rc;
+
+    /* data from a later fence must land on top of what
+     * we have from an earlier one, so expand that now */
+    rc = pmix_gds_hash_expand_rank(trk, rank);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc = copy_modex(key_fmt, kmap, vtab, pbkt, &mdx);
+    if (PMIX_SUCCESS != rc || NULL == mdx) {
+        return rc;
+    }
+    rc = pmix_hash_table_set_value_uint32(&trk->modex, rank, mdx);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(mdx);
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+/* In parallel mode the data of each remote proc in the fence
+ * result is copied out as the blob is walked, the copies are split
+ * into contiguous ranges - the ranks of a node sit next to each
+ * other in the blob - and each range is unpacked into kvals by its
+ * own thread. The key registry and the hash tables are not thread
+ * safe, so the kvals are then stored by the caller, in blob order */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_job_t *trk;
+    pmix_rank_t rank;
+    pmix_gds_hash_modex_t *mdx;
+    pmix_list_t kvs;
+    pmix_status_t status;
+} modex_work_t;
+static void mwcon(modex_work_t *p)
+{
+    p->trk = NULL;
+    p->rank = PMIX_RANK_UNDEF;
+    p->mdx = NULL;
+    PMIX_CONSTRUCT(&p->kvs, pmix_list_t);
+    p->status = PMIX_SUCCESS;
+}
+static void mwdes(modex_work_t *p)
+{
+    pmix_kval_t *kv;
+
+    if (NULL != p->mdx) {
+        /* values that point into the table are not ours */
+        PMIX_LIST_FOREACH (kv, &p->kvs, pmix_kval_t) {
+            if (PMIX_GDS_MODEX_VTAB_HOLDS(p->mdx->vtab, kv->value)) {
+                kv->value = NULL;
+            }
+        }
+        PMIX_RELEASE(p->mdx);
+    }
+    PMIX_LIST_DESTRUCT(&p->kvs);
+}
+static PMIX_CLASS_INSTANCE(modex_work_t, pmix_list_item_t, mwcon, mwdes);
+
+typedef struct {
+    pmix_thread_t thread;
+    bool started;
+    modex_work_t **items;
+    size_t nitems;
+} modex_worker_t;
+
+pmix_status_t pmix_gds_hash_queue_modex(pmix_list_t *work, pmix_job_t *trk, pmix_rank_t rank,
+                                        pmix_gds_modex_key_fmt_t key_fmt,
+                                        pmix_gds_hash_kmap_t *kmap,
+                                        pmix_gds_modex_vtab_t *vtab, pmix_buffer_t *pbkt)
+{
+    modex_work_t *w;
+    pmix_status_t rc;
+
+    w = PMIX_NEW(modex_work_t);
+    if (NULL == w) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = copy_modex(key_fmt, kmap, vtab, pbkt, &w->mdx);
+    if (PMIX_SUCCESS != rc || NULL == w->mdx) {
+        PMIX_RELEASE(w);
+        return rc;
+    }
+    w->trk = trk;
+    w->rank = rank;
+    pmix_list_append(work, &w->super);
+    return PMIX_SUCCESS;
+}
+
+static void unpack_modex(modex_work_t *w)
+{
+    pmix_buffer_t buf;
+    pmix_kval_t *kv;
+    char **kmap;
+
+    kmap = (NULL == w->mdx->kmap) ? NULL : w->mdx->kmap->keys;
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_globals.mypeer, &buf, w->mdx->bo.bytes, w->mdx->bo.size);
+    while (1) {
+        kv = PMIX_NEW(pmix_kval_t);
+        if (NULL == kv) {
+            w->status = PMIX_ERR_NOMEM;
+            break;
+        }
+        w->status = pmix_gds_base_modex_unpack_kval(w->mdx->key_fmt, &buf, kmap, w->mdx->vtab,
+                                                    kv);
+        if (PMIX_SUCCESS != w->status) {
+            PMIX_RELEASE(kv);
+            if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == w->status) {
+                w->status = PMIX_SUCCESS;
+            }
+            break;
+        }
+        pmix_list_append(&w->kvs, &kv->super);
+    }
+    buf.base_ptr = NULL;
+    PMIX_DESTRUCT(&buf);
+}
+
+static void *modex_thread(pmix_object_t *obj)
+{
+    pmix_thread_t *t = (pmix_thread_t *) obj;
+    modex_worker_t *mw = (modex_worker_t *) t->t_arg;
+    size_t n;
+
+    for (n = 0; n < mw->nitems; n++) {
+        unpack_modex(mw->items[n]);
+    }
+    return NULL;
+}
+
+pmix_status_t pmix_gds_hash_store_modex_work(pmix_list_t *work, int nthreads)
+{
+    modex_work_t **items, *w;
+    modex_worker_t *workers;
+    pmix_kval_t *kv;
+    pmix_status_t rc = PMIX_SUCCESS;
+    size_t nitems, n, nw, start;
+
+    nitems = pmix_list_get_size(work);
+    if (0 == nitems) {
+        return PMIX_SUCCESS;
+    }
+    nw = ((size_t) nthreads < nitems) ? (size_t) nthreads : nitems;
+    items = (modex_work_t **) malloc(nitems * sizeof(modex_work_t *));
+    workers = (modex_worker_t *) calloc(nw, sizeof(modex_worker_t));
+    if (NULL == items || NULL == workers) {
+        free(items);
+        free(workers);
+        return PMIX_ERR_NOMEM;
+    }
+    n = 0;
+    PMIX_LIST_FOREACH (w, work, modex_work_t) {
+        items[n++] = w;
+    }
+
+    /* the first range is ours */
+    for (n = 0; n < nw; n++) {
+        start = n * nitems / nw;
+        PMIX_CONSTRUCT(&workers[n].thread, pmix_thread_t);
+        workers[n].items = &items[start];
+        workers[n].nitems = (n + 1) * nitems / nw - start;
+        workers[n].thread.t_run = modex_thread;
+        workers[n].thread.t_arg = &workers[n];
+        if (0 < n && PMIX_SUCCESS == pmix_thread_start(&workers[n].thread)) {
+            workers[n].started = true;
+        }
+    }
+    for (n = 0; n < nw; n++) {
+        if (!workers[n].started) {
+            /* do it ourselves */
+            modex_thread(&workers[n].thread.super);
+        }
+    }
+    for (n = 0; n < nw; n++) {
+        if (workers[n].started) {
+            pmix_thread_join(&workers[n].thread, NULL);
+        }
+        PMIX_DESTRUCT(&workers[n].thread);
+    }
+    free(workers);
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "%s pmix:gds:hash unpacked modex data of %lu procs on %lu threads",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) nitems,
+                        (unsigned long) nw);
+
+    /* merge - in blob order, so later data lands on top */
+    for (n = 0; n < nitems && PMIX_SUCCESS == rc; n++) {
+        w = items[n];
+        if (PMIX_SUCCESS != w->status) {
+            rc = w->status;
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+        rc = pmix_gds_hash_expand_rank(w->trk, w->rank);
+        PMIX_LIST_FOREACH (kv, &w->kvs, pmix_kval_t) {
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            if (PMIX_CHECK_KEY(kv, PMIX_QUALIFIED_VALUE)) {
+                rc = pmix_gds_hash_store_qualified(&w->trk->remote, w->rank, kv->value);
+            } else if (PMIX_GDS_MODEX_VTAB_HOLDS(w->mdx->vtab, kv->value)) {
+                rc = pmix_hash_store_shared(&w->trk->remote, w->rank, kv, &w->mdx->vtab->super);
+            } else {
+                rc = pmix_hash_store(&w->trk->remote, w->rank, kv, NULL, 0);
+            }
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+        }
+    }
+    free(items);
+    return rc;
+}
+
+static pmix_status_t expand_modex(pmix_job_t *trk, pmix_rank_t rank)
+{
+    pmix_gds_hash_modex_t *mdx;
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    if (0 == pmix_hash_table_get_size(&trk->modex) ||
+        PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&trk->modex, rank, (void **) &mdx)) {
+        return PMIX_SUCCESS;
+    }
+    pmix_hash_table_remove_value_uint32(&trk->modex, rank);
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "%s pmix:gds:hash expanding deferred modex data for %s:%u",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), trk->ns, rank);
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_globals.mypeer, &buf, mdx->bo.bytes, mdx->bo.size);
+    rc = pmix_gds_hash_store_modex_kvals(trk, rank, mdx->key_fmt,
+                                         (NULL == mdx->kmap) ? NULL : mdx->kmap->keys, mdx->vtab,
+                                         &buf);
+    buf.base_ptr = NULL;
+    PMIX_DESTRUCT(&buf);
+    PMIX_RELEASE(mdx);
+    return rc;
+}
+
+/* unpack the deferred job info and modex data for the given rank, if any */
+pmix_status_t pmix_gds_hash_expand_rank(pmix_job_t *trk, pmix_rank_t rank)
+{
+    pmix_byte_object_t *bo;
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    rc = expand_modex(trk, rank);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 == pmix_hash_table_get_size(&trk->deferred) ||
+        PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&trk->deferred, rank, (void **) &bo)) {
+        return PMIX_SUCCESS;
+    }
+    pmix_hash_table_remove_value_uint32(&trk->deferred, rank);
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "%s pmix:gds:hash expanding deferred job info for %s:%u",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), trk->ns, rank);
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &buf, bo->bytes, bo->size);
+    rc = pmix_gds_hash_store_proc_blob(trk, &buf);
+    PMIX_DESTRUCT(&buf); // releases the blob data
+    free(bo);
+    return rc;
+}
+
+/* unpack all deferred job info and modex data for the job */
+pmix_status_t pmix_gds_hash_expand_all(pmix_job_t *trk)
+{
+    void *ptr;
+    pmix_status_t rc;
+    uint32_t rank;
+    void *node;
+
+    while (0 < pmix_hash_table_get_size(&trk->deferred)) {
+        rc = pmix_hash_table_get_first_key_uint32(&trk->deferred, &rank, &ptr, &node);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        rc = pmix_gds_hash_expand_rank(trk, rank);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    while (0 < pmix_hash_table_get_size(&trk->modex)) {
+        rc = pmix_hash_table_get_first_key_uint32(&trk->modex, &rank, &ptr, &node);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        rc = expand_modex(trk, rank);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* drop the modex data of a remote proc - whether or not it has been
+ * unpacked - so the server asks its host for it if it is wanted again */
+pmix_status_t pmix_gds_hash_release_modex(const char *nspace, pmix_rank_t rank)
+{
+    pmix_job_t *trk;
+    pmix_gds_hash_modex_t *mdx;
+
+    trk = pmix_gds_hash_get_tracker(nspace, false);
+    if (NULL == trk) {
+        return PMIX_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "%s pmix:gds:hash releasing modex data for %s:%u",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), trk->ns, rank);
+
+    if (0 < pmix_hash_table_get_size(&trk->modex) &&
+        PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&trk->modex, rank, (void **) &mdx)) {
+        pmix_hash_table_remove_value_uint32(&trk->modex, rank);
+        PMIX_RELEASE(mdx);
+    }
+    (void) pmix_hash_remove_data(&trk->remote, rank, NULL);
+    return PMIX_SUCCESS;
+}
+
+/* collect what changed for a proc since the given epoch - its
+ * job info and whatever it has put, wherever that is held */
+pmix_status_t pmix_gds_hash_fetch_changed(const pmix_proc_t *proc, uint64_t since,
+                                          uint64_t *epoch, pmix_list_t *kvs)
+{
+    pmix_job_t *trk;
+    pmix_hash_table_t *tables[3];
+    uint64_t ep;
+    pmix_status_t rc;
+    int n;
+
+    *epoch = 0;
+    trk = pmix_gds_hash_get_tracker(proc->nspace, false);
+    if (NULL == trk) {
+        return PMIX_ERR_INVALID_NAMESPACE;
+    }
+    if (PMIX_RANK_IS_VALID(proc->rank)) {
+        /* anything still packed has to be stored before
+         * we can tell what changed */
+        rc = pmix_gds_hash_expand_rank(trk, proc->rank);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    } else if (PMIX_RANK_WILDCARD != proc->rank) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    tables[0] = &trk->internal;
+    tables[1] = &trk->local;
+    tables[2] = &trk->remote;
+    for (n = 0; n < 3; n++) {
+        rc = pmix_hash_fetch_changed(tables[n], proc->rank, since, &ep, kvs);
+        if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_FOUND != rc) {
+            return rc;
+        }
+        if (ep > *epoch) {
+            *epoch = ep;
+        }
+    }
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "%s pmix:gds:hash %lu values of %s changed since epoch %lu",
+                        PMIX_NAME_PRINT(&pmix_globals.myid),
+                        (unsigned long) pmix_list_get_size(kvs), PMIX_NAME_PRINT(proc),
+                        (unsigned long) since);
+    return PMIX_SUCCESS;
+}
+
+/* In implicit mode the server leaves out of the job info any of
+ * these per-proc values that matches what follows from the node
+ * and app info the client is sent anyway, and the client computes
+ * it when asked. Both sides compute it the same way - from the
+ * node that lists the rank among its local peers and the position
+ * of the rank in that list, which is how store_map assigns them */
+static const char *implicit_keys[] = {PMIX_HOSTNAME, PMIX_NODEID, PMIX_LOCAL_RANK,
+                                      PMIX_NODE_RANK, PMIX_APP_RANK, NULL};
+
+static char *local_peers(pmix_nodeinfo_t *nd)
+{
+    pmix_kval_t *kv;
+
+    PMIX_LIST_FOREACH (kv, &nd->info, pmix_kval_t) {
+        if (PMIX_CHECK_KEY(kv, PMIX_LOCAL_PEERS)) {
+            if (NULL == kv->value || PMIX_STRING != kv->value->type) {
+                return NULL;
+            }
+            return kv->value->data.string;
+        }
+    }
+    return NULL;
+}
+
+/* step through a comma-delimited list of ranks */
+static bool next_rank(char **ptr, pmix_rank_t *rank)
+{
+    char *end;
+    unsigned long r;
+
+    if ('\0' == **ptr) {
+        return false;
+    }
+    r = strtoul(*ptr, &end, 10);
+    if (end == *ptr || (',' != *end && '\0' != *end) || !PMIX_RANK_IS_VALID(r)) {
+        return false;
+    }
+    *rank = (pmix_rank_t) r;
+    *ptr = (',' == *end) ? end + 1 : end;
+    return true;
+}
+
+static pmix_status_t build_rank_index(pmix_job_t *trk)
+{
+    pmix_nodeinfo_t *nd;
+    pmix_rank_t rank, nranks = 0;
+    uint16_t lrank;
+    char *ptr;
+
+    /* size the index by the highest rank on any node */
+    PMIX_LIST_FOREACH (nd, &trk->nodeinfo, pmix_nodeinfo_t) {
+        ptr = local_peers(nd);
+        if (NULL == ptr) {
+            continue;
+        }
+        while (next_rank(&ptr, &rank)) {
+            if (nranks <= rank) {
+                nranks = rank + 1;
+            }
+        }
+    }
+    trk->rank_indexed = true;
+    if (0 == nranks) {
+        return PMIX_SUCCESS;
+    }
+
+    trk->rank_node = (pmix_nodeinfo_t **) calloc(nranks, sizeof(pmix_nodeinfo_t *));
+    trk->rank_lrank = (uint16_t *) calloc(nranks, sizeof(uint16_t));
+    if (NULL == trk->rank_node || NULL == trk->rank_lrank) {
+        pmix_gds_hash_release_rank_index(trk);
+        return PMIX_ERR_NOMEM;
+    }
+    trk->nindexed = nranks;
+    PMIX_LIST_FOREACH (nd, &trk->nodeinfo, pmix_nodeinfo_t) {
+        ptr = local_peers(nd);
+        if (NULL == ptr) {
+            continue;
+        }
+        lrank = 0;
+        while (next_rank(&ptr, &rank)) {
+            trk->rank_node[rank] = nd;
+            trk->rank_lrank[rank] = lrank++;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+void pmix_gds_hash_release_rank_index(pmix_job_t *trk)
+{
+    if (NULL != trk->rank_node) {
+        free(trk->rank_node);
+        trk->rank_node = NULL;
+    }
+    if (NULL != trk->rank_lrank) {
+        free(trk->rank_lrank);
+        trk->rank_lrank = NULL;
+    }
+    trk->nindexed = 0;
+    trk->rank_indexed = false;
+}
+
+/* the rank of the proc within its app, if the app it belongs
+ * to can be told from the app leaders and sizes */
+static bool app_rank(pmix_job_t *trk, pmix_rank_t rank, pmix_rank_t *arank)
+{
+    pmix_apptrkr_t *apptr;
+    pmix_kval_t *kv;
+    pmix_rank_t ldr;
+    uint32_t size;
+    bool hasldr, hassize;
+    pmix_status_t rc;
+
+    PMIX_LIST_FOREACH (apptr, &trk->apps, pmix_apptrkr_t) {
+        hasldr = false;
+        hassize = false;
+        PMIX_LIST_FOREACH (kv, &apptr->appinfo, pmix_kval_t) {
+            if (PMIX_CHECK_KEY(kv, PMIX_APPLDR)) {
+                PMIX_VALUE_GET_NUMBER(rc, kv->value, ldr, pmix_rank_t);
+                hasldr = (PMIX_SUCCESS == rc);
+            } else if (PMIX_CHECK_KEY(kv, PMIX_APP_SIZE)) {
+                PMIX_VALUE_GET_NUMBER(rc, kv->value, size, uint32_t);
+                hassize = (PMIX_SUCCESS == rc);
+            }
+        }
+        if (hasldr && hassize && ldr <= rank && rank - ldr < size) {
+            *arank = rank - ldr;
+            return true;
+        }
+    }
+    return false;
+}
+
+static pmix_status_t implicit_value(pmix_job_t *trk, pmix_rank_t rank, const char *key,
+                                    pmix_value_t *val)
+{
+    pmix_nodeinfo_t *nd;
+    pmix_rank_t arank;
+    pmix_status_t rc;
+
+    if (!trk->rank_indexed) {
+        rc = build_rank_index(trk);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    if (trk->nindexed <= rank || NULL == (nd = trk->rank_node[rank])) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    if (0 == strcmp(key, PMIX_HOSTNAME)) {
+        if (NULL == nd->hostname) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        PMIX_VALUE_LOAD(val, nd->hostname, PMIX_STRING);
+    } else if (0 == strcmp(key, PMIX_NODEID)) {
+        if (UINT32_MAX == nd->nodeid) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        PMIX_VALUE_LOAD(val, &nd->nodeid, PMIX_UINT32);
+    } else if (0 == strcmp(key, PMIX_LOCAL_RANK) || 0 == strcmp(key, PMIX_NODE_RANK)) {
+        /* as in store_map, we assume only the one job is on the node */
+        PMIX_VALUE_LOAD(val, &trk->rank_lrank[rank], PMIX_UINT16);
+    } else if (0 == strcmp(key, PMIX_APP_RANK)) {
+        if (!app_rank(trk, rank, &arank)) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        PMIX_VALUE_LOAD(val, &arank, PMIX_PROC_RANK);
+    } else {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* add the computed value of the given key for the rank - or of
+ * each key not already on the list if the key is NULL */
+pmix_status_t pmix_gds_hash_fetch_implicit(pmix_job_t *trk, pmix_rank_t rank,
+                                           const char *key, pmix_list_t *kvs)
+{
+    pmix_kval_t *kv;
+    pmix_value_t val;
+    pmix_status_t rc, ret = PMIX_ERR_NOT_FOUND;
+    bool found;
+    int n;
+
+    for (n = 0; NULL != implicit_keys[n]; n++) {
+        if (NULL != key) {
+            if (0 != strcmp(key, implicit_keys[n])) {
+                continue;
+            }
+        } else {
+            found = false;
+            PMIX_LIST_FOREACH (kv, kvs, pmix_kval_t) {
+                if (PMIX_CHECK_KEY(kv, implicit_keys[n])) {
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                continue;
+            }
+        }
+        PMIX_VALUE_CONSTRUCT(&val);
+        rc = implicit_value(trk, rank, implicit_keys[n], &val);
+        if (PMIX_ERR_NOMEM == rc) {
+            return rc;
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_KVAL_NEW(kv, implicit_keys[n]);
+            if (NULL == kv) {
+                PMIX_VALUE_DESTRUCT(&val);
+                return PMIX_ERR_NOMEM;
+            }
+            /* the kval takes over the contents of the value */
+            memcpy(kv->value, &val, sizeof(pmix_value_t));
+            pmix_list_append(kvs, &kv->super);
+            ret = PMIX_SUCCESS;
+        }
+        if (NULL != key) {
+            break;
+        }
+    }
+    return ret;
+}
+
+/* remove from a rank's values those the client can compute */
+void pmix_gds_hash_trim_implicit(pmix_job_t *trk, pmix_rank_t rank, pmix_list_t *kvs)
+{
+    pmix_kval_t *kv, *next;
+    pmix_value_t val;
+    int n;
+
+    PMIX_LIST_FOREACH_SAFE (kv, next, kvs, pmix_kval_t) {
+        for (n = 0; NULL != implicit_keys[n]; n++) {
+            if (PMIX_CHECK_KEY(kv, implicit_keys[n])) {
+                break;
+            }
+        }
+        if (NULL == implicit_keys[n] || NULL == kv->value) {
+            continue;
+        }
+        PMIX_VALUE_CONSTRUCT(&val);
+        if (PMIX_SUCCESS == implicit_value(trk, rank, kv->key, &val) &&
+            PMIX_EQUAL == PMIx_Value_compare(kv->value, &val)) {
+            pmix_list_remove_item(kvs, &kv->super);
+            PMIX_RELEASE(kv);
+        }
+        PMIX_VALUE_DESTRUCT(&val);
+    }
+}
@@ -35,6 +35,7 @@
 
 #include "src/class/pmix_list.h"
 #include "src/client/pmix_client_ops.h"
+#include "src/include/pmix_dictionary.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/pcompress/base/base.h"
 #include "src/mca/pmdl/pmdl.h"
@@ -51,6 +52,123 @@
 #include "gds_hash.h"
 #include "src/mca/gds/base/base.h"
 
+/* The arrays are processed with a switch on what to do with each
+ * key. The keys that need special handling are all in the dictionary,
+ * so their action is kept in a table indexed by the dictionary index
+ * of the key - that index is looked up with the perfect hash of the
+ * dictionary, so the keys are not compared against each candidate */
+typedef enum {
+    PMIX_HASH_KEY_OTHER = 0,
+    PMIX_HASH_KEY_NODEID,
+    PMIX_HASH_KEY_HOSTNAME,
+    PMIX_HASH_KEY_HOSTNAME_ALIASES,
+    PMIX_HASH_KEY_APPNUM,
+    PMIX_HASH_KEY_NODE_INFO_ARRAY,
+    PMIX_HASH_KEY_APP_INFO_ARRAY,
+    PMIX_HASH_KEY_PROC_MAP,
+    PMIX_HASH_KEY_NODE_MAP,
+    PMIX_HASH_KEY_MODEL,
+    PMIX_HASH_KEY_JOB_SIZE,
+    PMIX_HASH_KEY_DEBUG_STOP,
+    PMIX_HASH_KEY_SESSION_ID
+} pmix_hash_key_action_t;
+
+static const struct {
+    const char *key;
+    pmix_hash_key_action_t action;
+} key_table[] = {
+    {PMIX_NODEID, PMIX_HASH_KEY_NODEID},
+    {PMIX_HOSTNAME, PMIX_HASH_KEY_HOSTNAME},
+    {PMIX_HOSTNAME_ALIASES, PMIX_HASH_KEY_HOSTNAME_ALIASES},
+    {PMIX_APPNUM, PMIX_HASH_KEY_APPNUM},
+    {PMIX_NODE_INFO_ARRAY, PMIX_HASH_KEY_NODE_INFO_ARRAY},
+    {PMIX_APP_INFO_ARRAY, PMIX_HASH_KEY_APP_INFO_ARRAY},
+    {PMIX_PROC_MAP, PMIX_HASH_KEY_PROC_MAP},
+    {PMIX_NODE_MAP, PMIX_HASH_KEY_NODE_MAP},
+    {PMIX_MODEL_LIBRARY_NAME, PMIX_HASH_KEY_MODEL},
+    {PMIX_PROGRAMMING_MODEL, PMIX_HASH_KEY_MODEL},
+    {PMIX_MODEL_LIBRARY_VERSION, PMIX_HASH_KEY_MODEL},
+    {PMIX_PERSONALITY, PMIX_HASH_KEY_MODEL},
+    {PMIX_JOB_SIZE, PMIX_HASH_KEY_JOB_SIZE},
+    {PMIX_DEBUG_STOP_ON_EXEC, PMIX_HASH_KEY_DEBUG_STOP},
+    {PMIX_DEBUG_STOP_IN_INIT, PMIX_HASH_KEY_DEBUG_STOP},
+    {PMIX_DEBUG_STOP_IN_APP, PMIX_HASH_KEY_DEBUG_STOP},
+    {PMIX_SESSION_ID, PMIX_HASH_KEY_SESSION_ID},
+    {NULL, PMIX_HASH_KEY_OTHER}
+};
+
+/* anything not in the table is left at PMIX_HASH_KEY_OTHER */
+static uint8_t key_actions[PMIX_INDEX_BOUNDARY + 1];
+
+/* the component is initialized before the attributes are registered,
+ * so the indices are taken from the dictionary itself */
+void pmix_gds_hash_init_key_actions(void)
+{
+    int n, m;
+
+    for (n = 0; NULL != key_table[n].key; n++) {
+        for (m = 0; UINT32_MAX != pmix_dictionary[m].index; m++) {
+            if (0 == strcmp(key_table[n].key, pmix_dictionary[m].string)) {
+                key_actions[pmix_dictionary[m].index] = (uint8_t) key_table[n].action;
+                break;
+            }
+        }
+    }
+}
+
+static inline pmix_hash_key_action_t key_action(const char *key)
+{
+    pmix_regattr_input_t *p;
+
+    if (!PMIX_CHECK_RESERVED_KEY(key)) {
+        return PMIX_HASH_KEY_OTHER;
+    }
+    p = pmix_hash_lookup_key(UINT32_MAX, key);
+    if (NULL == p || PMIX_INDEX_BOUNDARY < p->index) {
+        return PMIX_HASH_KEY_OTHER;
+    }
+    return (pmix_hash_key_action_t) key_actions[p->index];
+}
+
+/* copy an info onto the end of a list of kvals */
+static pmix_status_t cache_value(pmix_list_t *list, pmix_info_t *info)
+{
+    pmix_kval_t *kp2;
+    pmix_status_t rc;
+
+    kp2 = PMIX_NEW(pmix_kval_t);
+    kp2->key = strdup(info->key);
+    kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+    PMIX_VALUE_XFER(rc, kp2->value, &info->value);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(kp2);
+        return rc;
+    }
+    pmix_list_append(list, &kp2->super);
+    return PMIX_SUCCESS;
+}
+
+/* move the kvals of an update onto an existing list, ensuring
+ * each data item only appears once on it */
+static void merge_values(pmix_list_t *tgt, pmix_list_t *src)
+{
+    pmix_kval_t *kp2, *k1;
+
+    kp2 = (pmix_kval_t *) pmix_list_remove_first(src);
+    while (NULL != kp2) {
+        PMIX_LIST_FOREACH (k1, tgt, pmix_kval_t) {
+            if (PMIX_CHECK_KEY(k1, kp2->key)) {
+                pmix_list_remove_item(tgt, &k1->super);
+                PMIX_RELEASE(k1);
+                break;
+            }
+        }
+        pmix_list_append(tgt, &kp2->super);
+        kp2 = (pmix_kval_t *) pmix_list_remove_first(src);
+    }
+}
+
 /* process a node array - contains an array of
  * node-level info for a single node. Either the
  * nodeid, hostname, or both must be included
@@ -60,10 +178,8 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
     size_t size, j, n;
     pmix_info_t *iptr;
     pmix_status_t rc = PMIX_SUCCESS;
-    pmix_kval_t *kp2, *k1;
-    pmix_list_t cache;
-    pmix_nodeinfo_t *nd = NULL, *ndptr;
-    bool update;
+    pmix_nodeinfo_t *nd, *ndptr;
+    bool ident = false, update = false;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "PROCESSING NODE ARRAY");
@@ -77,75 +193,63 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
     /* setup arrays */
     size = val->data.darray->size;
     iptr = (pmix_info_t *) val->data.darray->array;
-    PMIX_CONSTRUCT(&cache, pmix_list_t);
 
-    /* cache the values while searching for the nodeid
-     * and/or hostname */
+    /* the values go straight onto a new node object - it is only
+     * merged into an existing one if the node turns out to be
+     * on the list already */
+    nd = PMIX_NEW(pmix_nodeinfo_t);
     for (j = 0; j < size; j++) {
         pmix_output_verbose(12, pmix_gds_base_framework.framework_output,
                             "%s gds:hash:node_array for key %s",
                             PMIX_NAME_PRINT(&pmix_globals.myid), iptr[j].key);
-        if (PMIX_CHECK_KEY(&iptr[j], PMIX_NODEID)) {
-            if (NULL == nd) {
-                nd = PMIX_NEW(pmix_nodeinfo_t);
-            }
+        switch (key_action(iptr[j].key)) {
+        case PMIX_HASH_KEY_NODEID:
             PMIX_VALUE_GET_NUMBER(rc, &iptr[j].value, nd->nodeid, uint32_t);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(nd);
-                PMIX_LIST_DESTRUCT(&cache);
                 return rc;
             }
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_HOSTNAME)) {
-            if (NULL == nd) {
-                nd = PMIX_NEW(pmix_nodeinfo_t);
+            ident = true;
+            break;
+        case PMIX_HASH_KEY_HOSTNAME:
+            if (NULL != nd->hostname) {
+                free(nd->hostname);
             }
             nd->hostname = strdup(iptr[j].value.data.string);
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_HOSTNAME_ALIASES)) {
-            if (NULL == nd) {
-                nd = PMIX_NEW(pmix_nodeinfo_t);
+            ident = true;
+            break;
+        case PMIX_HASH_KEY_HOSTNAME_ALIASES:
+            if (NULL != nd->aliases) {
+                pmix_argv_free(nd->aliases);
             }
             nd->aliases = pmix_argv_split(iptr[j].value.data.string, ',');
+            ident = true;
             /* need to cache this value as well */
-            kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(iptr[j].key);
-            kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-            PMIX_VALUE_XFER(rc, kp2->value, &iptr[j].value);
+            rc = cache_value(&nd->info, &iptr[j]);
             if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
                 PMIX_RELEASE(nd);
-                PMIX_LIST_DESTRUCT(&cache);
                 return rc;
             }
-            pmix_list_append(&cache, &kp2->super);
-        } else {
-            kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(iptr[j].key);
-            kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-            PMIX_VALUE_XFER(rc, kp2->value, &iptr[j].value);
+            break;
+        default:
+            rc = cache_value(&nd->info, &iptr[j]);
             if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
-                if (NULL != nd) {
-                    PMIX_RELEASE(nd);
-                }
-                PMIX_LIST_DESTRUCT(&cache);
+                PMIX_RELEASE(nd);
                 return rc;
             }
-            pmix_list_append(&cache, &kp2->super);
+            break;
         }
     }
 
-    if (NULL == nd) {
+    if (!ident) {
         /* they forgot to pass us the ident for the node */
-        PMIX_LIST_DESTRUCT(&cache);
+        PMIX_RELEASE(nd);
         return PMIX_ERR_BAD_PARAM;
     }
 
     /* see if we already have this node on the
      * provided list */
-    update = false;
     PMIX_LIST_FOREACH (ndptr, tgt, pmix_nodeinfo_t) {
         if (UINT32_MAX != ndptr->nodeid &&
             UINT32_MAX != nd->nodeid) {
@@ -154,13 +258,6 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
                     NULL != nd->hostname) {
                     ndptr->hostname = strdup(nd->hostname);
                 }
-                if (NULL != nd->aliases) {
-                    for (n=0; NULL != nd->aliases[n]; n++) {
-                        pmix_argv_append_unique_nosize(&ndptr->aliases, nd->aliases[n]);
-                    }
-                }
-                PMIX_RELEASE(nd);
-                nd = ndptr;
                 update = true;
                 break;
             }
@@ -171,40 +268,25 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
                     UINT32_MAX != nd->nodeid) {
                     ndptr->nodeid = nd->nodeid;
                 }
-                if (NULL != nd->aliases) {
-                    for (n=0; NULL != nd->aliases[n]; n++) {
-                        pmix_argv_append_unique_nosize(&ndptr->aliases, nd->aliases[n]);
-                    }
-                }
-                PMIX_RELEASE(nd);
-                nd = ndptr;
                 update = true;
                 break;
             }
         }
     }
     if (!update) {
+        /* a new node - the common case */
         pmix_list_append(tgt, &nd->super);
+        return PMIX_SUCCESS;
     }
 
-    /* transfer the cached items to the nodeinfo list */
-    kp2 = (pmix_kval_t *) pmix_list_remove_first(&cache);
-    while (NULL != kp2) {
-        /* if this is an update, we have to ensure each data
-         * item only appears once on the list */
-        if (update) {
-            PMIX_LIST_FOREACH (k1, &nd->info, pmix_kval_t) {
-                if (PMIX_CHECK_KEY(k1, kp2->key)) {
-                    pmix_list_remove_item(&nd->info, &k1->super);
-                    PMIX_RELEASE(k1);
-                    break;
-                }
-            }
+    /* this is an update */
+    if (NULL != nd->aliases) {
+        for (n = 0; NULL != nd->aliases[n]; n++) {
+            pmix_argv_append_unique_nosize(&ndptr->aliases, nd->aliases[n]);
         }
-        pmix_list_append(&nd->info, &kp2->super);
-        kp2 = (pmix_kval_t *) pmix_list_remove_first(&cache);
     }
-    PMIX_LIST_DESTRUCT(&cache);
+    merge_values(&ndptr->info, &nd->info);
+    PMIX_RELEASE(nd);
 
     return PMIX_SUCCESS;
 }
@@ -217,15 +299,13 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
  * an error if violated */
 pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk)
 {
-    pmix_list_t cache, ncache;
     size_t size, j;
     pmix_info_t *iptr;
     pmix_status_t rc = PMIX_SUCCESS;
     uint32_t appnum;
-    pmix_apptrkr_t *app = NULL, *apptr;
-    pmix_kval_t *kp2, *k1;
+    pmix_apptrkr_t *app, *apptr;
     pmix_nodeinfo_t *nd;
-    bool update;
+    bool have_appnum = false;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "PROCESSING APP ARRAY");
@@ -241,135 +321,99 @@ pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk
         return PMIX_ERR_TYPE_MISMATCH;
     }
 
-    /* setup arrays and lists */
-    PMIX_CONSTRUCT(&cache, pmix_list_t);
-    PMIX_CONSTRUCT(&ncache, pmix_list_t);
+    /* setup arrays */
     size = val->data.darray->size;
     iptr = (pmix_info_t *) val->data.darray->array;
 
+    /* as with nodes, the values go straight onto a new app
+     * object that is merged into an existing one if need be */
+    app = PMIX_NEW(pmix_apptrkr_t);
     for (j = 0; j < size; j++) {
         pmix_output_verbose(12, pmix_gds_base_framework.framework_output,
                             "%s gds:hash:app_array for key %s", PMIX_NAME_PRINT(&pmix_globals.myid),
                             iptr[j].key);
-        if (PMIX_CHECK_KEY(&iptr[j], PMIX_APPNUM)) {
+        switch (key_action(iptr[j].key)) {
+        case PMIX_HASH_KEY_APPNUM:
             PMIX_VALUE_GET_NUMBER(rc, &iptr[j].value, appnum, uint32_t);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 goto release;
             }
-            if (NULL != app) {
+            if (have_appnum) {
                 /* this is an error - there can be only one app
                  * described in this array */
-                PMIX_RELEASE(app);
-                PMIX_LIST_DESTRUCT(&cache);
-                PMIX_LIST_DESTRUCT(&ncache);
-                return PMIX_ERR_BAD_PARAM;
+                rc = PMIX_ERR_BAD_PARAM;
+                goto release;
             }
-            app = PMIX_NEW(pmix_apptrkr_t);
             app->appnum = appnum;
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_NODE_INFO_ARRAY)) {
-            if (PMIX_SUCCESS != (rc = pmix_gds_hash_process_node_array(&iptr[j].value, &ncache))) {
+            have_appnum = true;
+            break;
+        case PMIX_HASH_KEY_NODE_INFO_ARRAY:
+            if (PMIX_SUCCESS != (rc = pmix_gds_hash_process_node_array(&iptr[j].value, &app->nodeinfo))) {
                 PMIX_ERROR_LOG(rc);
                 goto release;
             }
-        } else {
-            kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(iptr[j].key);
-            kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-            PMIX_VALUE_XFER(rc, kp2->value, &iptr[j].value);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
+            break;
+        case PMIX_HASH_KEY_MODEL:
+            if (PMIX_SUCCESS != (rc = cache_value(&app->appinfo, &iptr[j]))) {
+                goto release;
+            }
+            // pass this info to the pmdl framework
+            pmix_pmdl.setup_nspace_kv(trk->nptr, (pmix_kval_t *) pmix_list_get_last(&app->appinfo));
+            break;
+        default:
+            if (PMIX_SUCCESS != (rc = cache_value(&app->appinfo, &iptr[j]))) {
                 goto release;
             }
-            pmix_list_append(&cache, &kp2->super);
+            break;
         }
     }
-    if (NULL == app) {
+    if (!have_appnum && 0 != pmix_list_get_size(&trk->apps)) {
         /* per the standard, they don't have to provide us with
-         * an appnum so long as only one app is in the job */
-        if (0 == pmix_list_get_size(&trk->apps)) {
-            app = PMIX_NEW(pmix_apptrkr_t);
-            app->appnum = 0;
-        } else {
-            /* this is not allowed to happen - they are required
-             * to provide us with an app number per the standard */
-            rc = PMIX_ERR_BAD_PARAM;
-            PMIX_ERROR_LOG(rc);
-            goto release;
-        }
+         * an appnum so long as only one app is in the job - so
+         * this is not allowed to happen */
+        rc = PMIX_ERR_BAD_PARAM;
+        PMIX_ERROR_LOG(rc);
+        goto release;
     }
+
     /* see if we already have this app on the
      * provided list */
-    update = false;
     PMIX_LIST_FOREACH (apptr, &trk->apps, pmix_apptrkr_t) {
         if (apptr->appnum == app->appnum) {
             /* we assume that the data is updating the current
              * values */
+            merge_values(&apptr->appinfo, &app->appinfo);
+            /* transfer the associated node-level data across */
+            nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&app->nodeinfo);
+            while (NULL != nd) {
+                pmix_list_append(&apptr->nodeinfo, &nd->super);
+                nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&app->nodeinfo);
+            }
             PMIX_RELEASE(app);
-            app = apptr;
-            update = true;
-            break;
+            return PMIX_SUCCESS;
         }
     }
-    if (!update) {
-        pmix_list_append(&trk->apps, &app->super);
-    }
-    /* point the app at its job */
-    if (NULL == app->job) {
-        /* do NOT retain the tracker - we will not release
-         * it in the app destructor. If we retain the tracker,
-         * then we won't release it later because the refcount
-         * is wrong */
-        app->job = trk;
-    }
 
-    /* transfer the app-level data across */
-    kp2 = (pmix_kval_t *) pmix_list_remove_first(&cache);
-    while (NULL != kp2) {
-        /* if this is an update, we have to ensure each data
-         * item only appears once on the list */
-        if (update) {
-            PMIX_LIST_FOREACH (k1, &app->appinfo, pmix_kval_t) {
-                if (PMIX_CHECK_KEY(k1, kp2->key)) {
-                    pmix_list_remove_item(&app->appinfo, &k1->super);
-                    PMIX_RELEASE(k1);
-                    break;
-                }
-            }
-        }
-        if (PMIX_CHECK_KEY(kp2, PMIX_MODEL_LIBRARY_NAME) ||
-            PMIX_CHECK_KEY(kp2, PMIX_PROGRAMMING_MODEL) ||
-            PMIX_CHECK_KEY(kp2, PMIX_MODEL_LIBRARY_VERSION) ||
-            PMIX_CHECK_KEY(kp2, PMIX_PERSONALITY)) {
-            // pass this info to the pmdl framework
-            pmix_pmdl.setup_nspace_kv(trk->nptr, kp2);
-        }
-        pmix_list_append(&app->appinfo, &kp2->super);
-        kp2 = (pmix_kval_t *) pmix_list_remove_first(&cache);
-    }
-    /* transfer the associated node-level data across */
-    nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache);
-    while (NULL != nd) {
-        pmix_list_append(&app->nodeinfo, &nd->super);
-        nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache);
-    }
+    pmix_list_append(&trk->apps, &app->super);
+    /* point the app at its job - do NOT retain the tracker,
+     * we will not release it in the app destructor. If we
+     * retain the tracker, then we won't release it later
+     * because the refcount is wrong */
+    app->job = trk;
+    return PMIX_SUCCESS;
 
 release:
-    PMIX_LIST_DESTRUCT(&cache);
-    PMIX_LIST_DESTRUCT(&ncache);
-
+    PMIX_RELEASE(app);
     return rc;
 }
 
 /* process a job array */
 pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk, uint32_t *flags,
-                                              char ***procs, char ***nodes)
+                                              char ***procs, char **nodes)
 {
-    pmix_list_t cache;
     size_t j, size;
     pmix_info_t *iptr;
-    pmix_kval_t *kp2;
     pmix_status_t rc;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
@@ -382,19 +426,21 @@ pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk
     }
     size = info->value.data.darray->size;
     iptr = (pmix_info_t *) info->value.data.darray->array;
-    PMIX_CONSTRUCT(&cache, pmix_list_t);
     for (j = 0; j < size; j++) {
-        if (PMIX_CHECK_KEY(&iptr[j], PMIX_APP_INFO_ARRAY)) {
+        switch (key_action(iptr[j].key)) {
+        case PMIX_HASH_KEY_APP_INFO_ARRAY:
             if (PMIX_SUCCESS != (rc = pmix_gds_hash_process_app_array(&iptr[j].value, trk))) {
                 return rc;
             }
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_NODE_INFO_ARRAY)) {
+            break;
+        case PMIX_HASH_KEY_NODE_INFO_ARRAY:
             if (PMIX_SUCCESS
                 != (rc = pmix_gds_hash_process_node_array(&iptr[j].value, &trk->nodeinfo))) {
                 PMIX_ERROR_LOG(rc);
                 return rc;
             }
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_PROC_MAP)) {
+            break;
+        case PMIX_HASH_KEY_PROC_MAP:
             /* not allowed to get this more than once */
             if (*flags & PMIX_HASH_PROC_MAP) {
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
@@ -407,53 +453,47 @@ pmix_status_t pmix_gds_hash_process_job_array(pmix_info_t *info, pmix_job_t *trk
             }
             /* mark that we got the map */
             *flags |= PMIX_HASH_PROC_MAP;
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_NODE_MAP)) {
+            break;
+        case PMIX_HASH_KEY_NODE_MAP:
             /* not allowed to get this more than once */
             if (*flags & PMIX_HASH_NODE_MAP) {
                 PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                 return PMIX_ERR_BAD_PARAM;
             }
-            /* parse the regex to get the argv array of node names */
-            if (PMIX_SUCCESS != (rc = pmix_preg.parse_nodes(iptr[j].value.data.bo.bytes, nodes))) {
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
+            /* the regex is parsed when the map is stored */
+            *nodes = iptr[j].value.data.bo.bytes;
             /* mark that we got the map */
             *flags |= PMIX_HASH_NODE_MAP;
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_MODEL_LIBRARY_NAME) ||
-                   PMIX_CHECK_KEY(&iptr[j], PMIX_PROGRAMMING_MODEL) ||
-                   PMIX_CHECK_KEY(&iptr[j], PMIX_MODEL_LIBRARY_VERSION) ||
-                   PMIX_CHECK_KEY(&iptr[j], PMIX_PERSONALITY)) {
+            break;
+        case PMIX_HASH_KEY_MODEL:
             // pass this info to the pmdl framework
             pmix_pmdl.setup_nspace(trk->nptr, &iptr[j]);
-        } else {
-            kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(iptr[j].key);
-            kp2->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-            PMIX_VALUE_XFER(rc, kp2->value, &iptr[j].value);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_RELEASE(kp2);
-                PMIX_LIST_DESTRUCT(&cache);
+            break;
+        case PMIX_HASH_KEY_JOB_SIZE:
+            if (PMIX_SUCCESS != (rc = cache_value(&trk->jobinfo, &iptr[j]))) {
                 return rc;
             }
-            pmix_list_append(&trk->jobinfo, &kp2->super);
-            /* check for job size */
-            if (PMIX_CHECK_KEY(&iptr[j], PMIX_JOB_SIZE)) {
-                if (!(PMIX_HASH_JOB_SIZE & *flags)) {
-                    trk->nptr->nprocs = iptr[j].value.data.uint32;
-                    *flags |= PMIX_HASH_JOB_SIZE;
-                }
-            } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_DEBUG_STOP_ON_EXEC) ||
-                       PMIX_CHECK_KEY(&iptr[j], PMIX_DEBUG_STOP_IN_INIT) ||
-                       PMIX_CHECK_KEY(&iptr[j], PMIX_DEBUG_STOP_IN_APP)) {
-                if (PMIX_RANK_WILDCARD == iptr[j].value.data.rank) {
-                    trk->nptr->num_waiting = trk->nptr->nlocalprocs;
-                } else {
-                    trk->nptr->num_waiting = 1;
-                }
+            if (!(PMIX_HASH_JOB_SIZE & *flags)) {
+                pmix_gds_hash_set_job_size(trk, iptr[j].value.data.uint32);
+                *flags |= PMIX_HASH_JOB_SIZE;
+            }
+            break;
+        case PMIX_HASH_KEY_DEBUG_STOP:
+            if (PMIX_SUCCESS != (rc = cache_value(&trk->jobinfo, &iptr[j]))) {
+                return rc;
+            }
+            if (PMIX_RANK_WILDCARD == iptr[j].value.data.rank) {
+                trk->nptr->num_waiting = trk->nptr->nlocalprocs;
             } else {
-                pmix_iof_check_flags(&iptr[j], &trk->nptr->iof_flags);
+                trk->nptr->num_waiting = 1;
+            }
+            break;
+        default:
+            if (PMIX_SUCCESS != (rc = cache_value(&trk->jobinfo, &iptr[j]))) {
+                return rc;
             }
+            pmix_iof_check_flags(&iptr[j], &trk->nptr->iof_flags);
+            break;
         }
     }
     return PMIX_SUCCESS;
@@ -486,7 +526,8 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
                     "%s gds:hash:session_array for key %s",
                     PMIX_NAME_PRINT(&pmix_globals.myid),
                     iptr[j].key);
-        if (PMIX_CHECK_KEY(&iptr[j], PMIX_SESSION_ID)) {
+        switch (key_action(iptr[j].key)) {
+        case PMIX_HASH_KEY_SESSION_ID:
             PMIX_VALUE_GET_NUMBER(rc, &iptr[j].value, sid, uint32_t);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
@@ -495,28 +536,22 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
                 return rc;
             }
             sptr = pmix_gds_hash_check_session(trk, sid, true);
-        } else if (PMIX_CHECK_KEY(&iptr[j], PMIX_NODE_INFO_ARRAY)) {
+            break;
+        case PMIX_HASH_KEY_NODE_INFO_ARRAY:
             if (PMIX_SUCCESS != (rc = pmix_gds_hash_process_node_array(&iptr[j].value, &ncache))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_LIST_DESTRUCT(&ncache);
                 PMIX_LIST_DESTRUCT(&scache);
                 return rc;
             }
-        } else {
-            kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(iptr[j].key);
-            kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-            PMIX_VALUE_XFER(rc, kp2->value, &iptr[j].value);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
+            break;
+        default:
+            if (PMIX_SUCCESS != (rc = cache_value(&scache, &iptr[j]))) {
                 PMIX_LIST_DESTRUCT(&ncache);
                 PMIX_LIST_DESTRUCT(&scache);
                 return rc;
             }
-            char *tmp = PMIx_Value_string(kp2->value);
-            free(tmp);
-            pmix_list_append(&scache, &kp2->super);
+            break;
         }
     }
 
@@ -50,6 +50,7 @@
 #ifdef HAVE_TIME_H
 #include <time.h>
 #endif
+#include <sys/mman.h>
 
 // Some notes:
 // We cannot use PMIX_CONSTRUCT for data that are stored in shared memory
@@ -59,7 +60,6 @@
 // TODO(skg) Address FT case at some point. Need to have a broader conversion
 // about how we go about doing this. Ralph has some ideas.
 
-// TODO(skg) Consider using mprotect.
 // TODO(skg) We way need to implement a different hash table.
 
 /**
@@ -69,6 +69,14 @@
 #define PMIX_GDS_SHMEM_KEY_SEG_SIZE "PMIX_GDS_SHMEM_SEG_SIZE"
 #define PMIX_GDS_SHMEM_KEY_SEG_ADDR "PMIX_GDS_SHMEM_SEG_ADDR"
 
+/**
+ * Key names used to find the job-level data delivered alongside the segment
+ * info: the residual holds what does not live in the segment, and the fallback
+ * holds the full-featured gds module's payload for clients that cannot attach.
+ */
+#define PMIX_GDS_SHMEM_KEY_RESIDUAL "PMIX_GDS_SHMEM_RESIDUAL"
+#define PMIX_GDS_SHMEM_KEY_FALLBACK "PMIX_GDS_SHMEM_FALLBACK"
+
 /**
  * String to size_t.
  */
@@ -118,69 +126,129 @@ addr_align_8(
     return result;
 }
 
-// TODO(skg) Add memory arena boundary checks.
+/**
+ * Every TMA allocation is preceded by a header that records its size. This
+ * lets tma_realloc() know how much data must be carried over to new storage.
+ */
+#define TMA_HDR_SIZE sizeof(uint64_t)
+
+/**
+ * Returns the end of the memory arena managed by the given TMA. Objects keep
+ * their own copy of the TMA, so only its data_ptr is shared by all of them.
+ * That points at the current_addr in the shared data located at the base of
+ * the shared-memory segment, so the arena's bounds are found from there.
+ */
+static inline void *
+tma_arena_end(
+    pmix_tma_t *tma
+) {
+    pmix_gds_shmem_shared_data_t *smdata = (pmix_gds_shmem_shared_data_t *)
+        ((uint8_t *)tma->data_ptr -
+         offsetof(pmix_gds_shmem_shared_data_t, current_addr));
+    return smdata->end_addr;
+}
+
+/**
+ * Bump-allocates size bytes from the arena. Returns NULL if the request
+ * cannot be satisfied by the space remaining in the shared-memory segment.
+ */
+static inline void *
+tma_alloc(
+    pmix_tma_t *tma,
+    size_t size
+) {
+    uint8_t *current = (uint8_t *)*(tma->data_ptr);
+    uint8_t *next = (uint8_t *)addr_align_8(current, TMA_HDR_SIZE + size);
+    if (next > (uint8_t *)tma_arena_end(tma)) {
+        PMIX_GDS_SHMEM_VOUT(
+            "%s: out of segment space (requested=%zd B, available=%zd B)",
+            __func__, size,
+            (size_t)((uint8_t *)tma_arena_end(tma) - current)
+        );
+        return NULL;
+    }
+    *(uint64_t *)current = (uint64_t)size;
+    *(tma->data_ptr) = next;
+    return current + TMA_HDR_SIZE;
+}
+
 static inline void *
 tma_malloc(
     pmix_tma_t *tma,
     size_t size
 ) {
-    void *current = *(tma->data_ptr);
-    memset(current, 0, size);
-    *(tma->data_ptr) = addr_align_8(current, size);
+    void *current = tma_alloc(tma, size);
+    if (current) {
+        memset(current, 0, size);
+    }
     return current;
 }
 
-// TODO(skg) Add memory arena boundary checks.
 static inline void *
 tma_calloc(
     struct pmix_tma *tma,
     size_t nmemb,
     size_t size
 ) {
-    const size_t real_size = nmemb * size;
-    void *current = *(tma->data_ptr);
-    memset(current, 0, real_size);
-    *(tma->data_ptr) = addr_align_8(current, real_size);
-    return current;
+    // Guard against multiplication overflow.
+    if (0 != size && nmemb > SIZE_MAX / size) {
+        return NULL;
+    }
+    return tma_malloc(tma, nmemb * size);
 }
 
-// TODO(skg)
 static inline void *
 tma_realloc(
     pmix_tma_t *tma,
     void *ptr,
     size_t size
 ) {
-    PMIX_HIDE_UNUSED_PARAMS(tma, ptr, size);
-    assert(false);
-    return NULL;
+    if (!ptr) {
+        return tma_malloc(tma, size);
+    }
+    const size_t old_size = (size_t)*(uint64_t *)((uint8_t *)ptr - TMA_HDR_SIZE);
+    if (size <= old_size) {
+        return ptr;
+    }
+    // Space is never reclaimed from the arena, so simply move the
+    // existing contents to a new, larger allocation.
+    void *current = tma_malloc(tma, size);
+    if (current) {
+        memmove(current, ptr, old_size);
+    }
+    return current;
 }
 
-// TODO(skg) Add memory arena boundary checks.
 static inline char *
 tma_strdup(
     pmix_tma_t *tma,
     const char *s
 ) {
-    void *current = *(tma->data_ptr);
     const size_t size = strlen(s) + 1;
-    *(tma->data_ptr) = addr_align_8(current, size);
+    void *current = tma_alloc(tma, size);
+    if (!current) {
+        return NULL;
+    }
     return (char *)memmove(current, s, size);
 }
 
-// TODO(skg) Add memory arena boundary checks.
 static inline void *
 tma_memmove(
     struct pmix_tma *tma,
     const void *src,
     size_t size
 ) {
-    void *current = *(tma->data_ptr);
-    *(tma->data_ptr) = addr_align_8(current, size);
+    void *current = tma_alloc(tma, size);
+    if (!current) {
+        return NULL;
+    }
     return memmove(current, src, size);
 }
 
-// TODO(skg)
+/**
+ * The segment's contents live as long as the job, and the entire arena is
+ * released when the segment is removed, so individual frees are no-ops.
+ */
 static inline void
 tma_free(
     struct pmix_tma *tma,
@@ -276,6 +344,8 @@ job_construct(
     job->ffgds = NULL;
     job->shmem = PMIX_NEW(pmix_shmem_t);
     job->smdata = NULL;
+    job->relocated = false;
+    job->update_seq = 0;
 }
 
 static void
@@ -363,7 +433,7 @@ assign_module(
     PMIX_GDS_SHMEM_VOUT_HERE();
 
     static const int max_priority = 100;
-    *priority = PMIX_GDS_SHMEM_DEFAULT_PRIORITY;
+    *priority = pmix_mca_gds_shmem_component.priority;
     // The incoming info always overrides anything in the
     // environment as it is set by the application itself.
     bool specified = false;
@@ -383,12 +453,6 @@ assign_module(
             break;
         }
     }
-#if (PMIX_GDS_SHMEM_DISABLE == 1)
-    if (true) {
-        *priority = 0;
-        return PMIX_SUCCESS;
-    }
-#endif
     // If they don't want us, then disqualify ourselves.
     if (specified && *priority != max_priority) {
         *priority = 0;
@@ -410,12 +474,15 @@ server_cache_job_info(
 }
 
 /**
- *
+ * Creates the shared-memory segment that backs the given job's data and sets
+ * up the data structures located at its base. The size of the segment is an
+ * estimate based on data_size scaled by size_factor.
  */
 static pmix_status_t
 prepare_backing_store_for_local_job_data(
     pmix_gds_shmem_job_t *job,
-    size_t data_size
+    size_t data_size,
+    size_t size_factor
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
     // Initial hash table size.
@@ -440,8 +507,8 @@ prepare_backing_store_for_local_job_data(
     seg_size += nlists * sizeof(pmix_list_t) * nranks;
     // We need to store a hash table in the shared-memory segment, so calculate
     // a rough estimate on the memory required for its storage.
-    seg_size += sizeof(pmix_hash_table2_t);
-    seg_size += ihtsize * pmix_hash_table2_t_sizeof_hash_element();
+    seg_size += sizeof(pmix_hash_table_t);
+    seg_size += ihtsize * pmix_hash_table_sizeof_hash_element();
     // Add a little extra to compensate for the value storage requirements. Here
     // we add an additional storage space for each entry.
     seg_size += ihtsize * (sizeof(pmix_kval_t) + sizeof(pmix_value_t));
@@ -449,11 +516,9 @@ prepare_backing_store_for_local_job_data(
     seg_size += data_size;
     // Add some extra fluff in case we weren't precise enough.
     seg_size *= 1.5;
+    seg_size *= size_factor;
     // Pad to fill an entire page.
     seg_size += pmix_gds_shmem_pad_amount_to_page(seg_size);
-    if (PMIX_SUCCESS != rc) {
-        return rc;
-    }
     // Create and attach to the shared-memory segment associated with this job.
     // This will be the backing store for metadata associated with static,
     // read-only data shared between the server and its clients.
@@ -481,6 +546,8 @@ prepare_backing_store_for_local_job_data(
     memset(job->smdata, 0, sizeof(*job->smdata));
     // Save the starting address for TMA memory allocations.
     job->smdata->current_addr = baseaddr;
+    // Save the end of the segment so allocations can be bounds checked.
+    job->smdata->end_addr = (uint8_t *)baseaddr + job->shmem->size;
     // Setup the TMA.
     tma_init(&job->smdata->tma);
     job->smdata->tma.data_ptr = &job->smdata->current_addr;
@@ -493,14 +560,179 @@ prepare_backing_store_for_local_job_data(
     job->smdata->jobinfo = PMIX_NEW(pmix_list_t, tma);
     job->smdata->nodeinfo = PMIX_NEW(pmix_list_t, tma);
     job->smdata->apps = PMIX_NEW(pmix_list_t, tma);
-    job->smdata->local_hashtab = PMIX_NEW(pmix_hash_table2_t, tma);
-    pmix_hash_table2_init(job->smdata->local_hashtab, ihtsize);
+    job->smdata->local_hashtab = PMIX_NEW(pmix_hash_table_t, tma);
+    if (!job->smdata->jobinfo || !job->smdata->nodeinfo ||
+        !job->smdata->apps || !job->smdata->local_hashtab) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = pmix_hash_table_init(job->smdata->local_hashtab, ihtsize);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
 
     pmix_gds_shmem_vout_smdata(job);
 
     return rc;
 }
 
+/**
+ * Releases the given job's shared-memory segment, if any. After this call
+ * requests for the job's data are handled by the full-featured gds module.
+ */
+static void
+discard_segment(
+    pmix_gds_shmem_job_t *job
+) {
+    job->smdata = NULL;
+    // The destructor detaches from and removes the segment.
+    PMIX_RELEASE(job->shmem);
+    job->shmem = PMIX_NEW(pmix_shmem_t);
+}
+
+/**
+ * Returns true if the given key can be stored in a hash table located in
+ * shared memory. Those tables refer to keys by their index in the process-local
+ * key registry, and only reserved keys are guaranteed to have the same index in
+ * every process. Qualified values are not supported there either.
+ */
+static inline bool
+key_is_segment_storable(
+    const char *key
+) {
+    return PMIX_CHECK_RESERVED_KEY(key) &&
+           !pmix_gds_shmem_keys_eq(key, PMIX_QUALIFIED_VALUE);
+}
+
+/**
+ * Returns true if the given job-level key/value pair can be served from shared
+ * memory. Everything else, including session-level information, is delivered
+ * in the residual payload and kept by the full-featured gds module.
+ */
+static bool
+kval_is_segment_storable(
+    pmix_kval_t *kv
+) {
+    if (PMIX_CHECK_KEY(kv, PMIX_SESSION_ID) ||
+        pmix_check_session_info(kv->key)) {
+        return false;
+    }
+    if (PMIX_DATA_ARRAY != kv->value->type) {
+        return key_is_segment_storable(kv->key);
+    }
+    if (PMIX_CHECK_KEY(kv, PMIX_APP_INFO_ARRAY) ||
+        PMIX_CHECK_KEY(kv, PMIX_NODE_INFO_ARRAY)) {
+        return true;
+    }
+    if (PMIX_CHECK_KEY(kv, PMIX_PROC_DATA)) {
+        const pmix_info_t *info = (pmix_info_t *)kv->value->data.darray->array;
+        const size_t ninfo = kv->value->data.darray->size;
+        // The first element is the rank.
+        for (size_t i = 1; i < ninfo; i++) {
+            if (!key_is_segment_storable(info[i].key)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Stores the storable subset of the given job-level data in the job's
+ * shared-memory segment.
+ */
+static pmix_status_t
+populate_segment(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *kvs
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_hash_table_t *ht = job->smdata->local_hashtab;
+
+    pmix_kval_t *kvi;
+    PMIX_LIST_FOREACH (kvi, kvs, pmix_kval_t) {
+        if (!kval_is_segment_storable(kvi)) {
+            PMIX_GDS_SHMEM_VOUT("deferring key=%s to residual", kvi->key);
+            continue;
+        }
+        if (PMIX_CHECK_KEY(kvi, PMIX_APP_INFO_ARRAY)) {
+            PMIX_GDS_SHMEM_VOUT("storing app info array ---------------");
+            rc = pmix_gds_shmem_store_app_array(job, kvi->value);
+        }
+        else if (PMIX_CHECK_KEY(kvi, PMIX_NODE_INFO_ARRAY)) {
+            PMIX_GDS_SHMEM_VOUT("storing node info array --------------");
+            rc = pmix_gds_shmem_store_node_array(
+                job, kvi->value, job->smdata->nodeinfo
+            );
+        }
+        else if (PMIX_CHECK_KEY(kvi, PMIX_PROC_DATA)) {
+            PMIX_GDS_SHMEM_VOUT("storing proc data --------------------");
+            rc = pmix_gds_shmem_store_proc_data(job, kvi);
+        }
+        else {
+            PMIX_GDS_SHMEM_VOUT("storing key=%s--------------", kvi->key);
+            // The hash table copies the value into the segment for us.
+            rc = pmix_hash2_store(ht, PMIX_RANK_WILDCARD, kvi, NULL, 0);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_GDS_SHMEM_VOUT(
+                "%s: failed to store key=%s (%s)", __func__,
+                kvi->key, PMIx_Error_string(rc)
+            );
+            break;
+        }
+    }
+    return rc;
+}
+
+/**
+ * Creates and populates the given job's shared-memory segment. Our estimate of
+ * the segment's size is just that, so retry with a larger segment should we
+ * run out of space.
+ */
+static pmix_status_t
+publish_segment(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *kvs,
+    size_t data_size
+) {
+    static const int max_attempts = 3;
+    pmix_status_t rc = PMIX_ERROR;
+
+    for (int i = 0; i < max_attempts; i++) {
+        rc = prepare_backing_store_for_local_job_data(
+            job, data_size, (size_t)1 << i
+        );
+        if (PMIX_SUCCESS == rc) {
+            rc = populate_segment(job, kvs);
+            if (PMIX_SUCCESS == rc) {
+                break;
+            }
+        }
+        discard_segment(job);
+        // Only exhausting the segment is worth another try.
+        if (PMIX_ERR_NOMEM != rc && PMIX_ERR_OUT_OF_RESOURCE != rc) {
+            break;
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    const size_t used = (uintptr_t)job->smdata->current_addr -
+                        (uintptr_t)job->shmem->base_address;
+    const size_t nlocal = (size_t)job->nspace->nlocalprocs;
+    pmix_output_verbose(
+        1, pmix_gds_base_framework.framework_output,
+        "gds:" PMIX_GDS_SHMEM_NAME ": namespace %s job data stored in %zd B "
+        "of a %zd B segment shared by %zd local procs: saves about %zd B "
+        "on this node versus a private copy per proc",
+        job->nspace_id, used, job->shmem->size, nlocal,
+        (1 < nlocal) ? used * (nlocal - 1) : (size_t)0
+    );
+    return rc;
+}
+
 static inline pmix_status_t
 pack_shmem_connection_info(
     pmix_gds_shmem_job_t *job,
@@ -562,78 +794,145 @@ pack_shmem_connection_info(
 }
 
 /**
- * Sets shared-memory connection information from a pmix_buffer_t by
- * unpacking the blob and saving the values for the appropriate rank.
+ * Sets the given job's shared-memory connection information from the provided
+ * key/value pair. Returns PMIX_ERR_NOT_FOUND if the pair isn't connection
+ * information.
  */
 static pmix_status_t
 unpack_shmem_connection_info(
     pmix_gds_shmem_job_t *job,
-    pmix_buffer_t *buffer
+    pmix_kval_t *kval
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
-    int32_t count = 1;
 
-    pmix_kval_t kval;
-    PMIX_CONSTRUCT(&kval, pmix_kval_t);
-    PMIX_BFROPS_UNPACK(
-        rc, pmix_client_globals.myserver,
-        buffer, &kval, &count, PMIX_KVAL
-    );
-    while (PMIX_SUCCESS == rc) {
-        // We only pack string, so make sure this is the right kind of data.
-        if (kval.value->type != PMIX_STRING) {
-            rc = PMIX_ERR_BAD_PARAM;
-            break;
-        }
-        const char *val = kval.value->data.string;
-        if (pmix_gds_shmem_keys_eq(kval.key, PMIX_GDS_SHMEM_KEY_SEG_PATH)) {
-            // Set job segment path.
-            int nw = snprintf(
-                job->shmem->backing_path, PMIX_PATH_MAX, "%s", val
-            );
-            if (nw >= PMIX_PATH_MAX) {
-                rc = PMIX_ERROR;
-                break;
-            }
-        }
-        else if (pmix_gds_shmem_keys_eq(kval.key, PMIX_GDS_SHMEM_KEY_SEG_SIZE)) {
-            // Set job shared-memory segment size.
-            rc = strtost(val, 16, &job->shmem->size);
-            if (PMIX_SUCCESS != rc) {
-                break;
-            }
+    const bool is_path = PMIX_CHECK_KEY(kval, PMIX_GDS_SHMEM_KEY_SEG_PATH);
+    const bool is_size = PMIX_CHECK_KEY(kval, PMIX_GDS_SHMEM_KEY_SEG_SIZE);
+    const bool is_addr = PMIX_CHECK_KEY(kval, PMIX_GDS_SHMEM_KEY_SEG_ADDR);
+    if (!is_path && !is_size && !is_addr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    // We only pack string, so make sure this is the right kind of data.
+    if (kval->value->type != PMIX_STRING) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    const char *val = kval->value->data.string;
+    if (is_path) {
+        // Set job segment path.
+        int nw = snprintf(
+            job->shmem->backing_path, PMIX_PATH_MAX, "%s", val
+        );
+        if (nw >= PMIX_PATH_MAX) {
+            rc = PMIX_ERROR;
         }
-        else if (pmix_gds_shmem_keys_eq(kval.key, PMIX_GDS_SHMEM_KEY_SEG_ADDR)) {
-            size_t base_addr = 0;
-            // Convert string base address to something we can use.
-            rc = strtost(val, 16, &base_addr);
-            if (PMIX_SUCCESS != rc) {
-                break;
-            }
+    }
+    else if (is_size) {
+        // Set job shared-memory segment size.
+        rc = strtost(val, 16, &job->shmem->size);
+    }
+    else {
+        size_t base_addr = 0;
+        // Convert string base address to something we can use.
+        rc = strtost(val, 16, &base_addr);
+        if (PMIX_SUCCESS == rc) {
             // Set job segment base address.
             job->shmem->base_address = (void *)base_addr;
         }
-        else {
-            rc = PMIX_ERR_BAD_PARAM;
-            break;
-        }
-        count = 1;
-        PMIX_DESTRUCT(&kval);
-        PMIX_CONSTRUCT(&kval, pmix_kval_t);
-        PMIX_BFROPS_UNPACK(
-            rc, pmix_client_globals.myserver,
-            buffer, &kval, &count, PMIX_KVAL
-        );
     }
-    // Catch last one.
-    PMIX_DESTRUCT(&kval);
-    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
-        rc = PMIX_ERR_UNPACK_FAILURE;
+    return rc;
+}
+
+/**
+ * Packs the contents of the given buffer as a byte object keyed by key.
+ */
+static pmix_status_t
+pack_buffer_as_kval(
+    pmix_peer_t *peer,
+    pmix_buffer_t *reply,
+    const char *key,
+    pmix_buffer_t *data
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_value_t blob;
+    pmix_kval_t kv = {
+        .key = (char *)key,
+        .value = &blob
+    };
+    blob.type = PMIX_BYTE_OBJECT;
+    PMIX_UNLOAD_BUFFER(data, blob.data.bo.bytes, blob.data.bo.size);
+    PMIX_BFROPS_PACK(rc, peer, reply, &kv, 1, PMIX_KVAL);
+    PMIX_VALUE_DESTRUCT(&blob);
+    if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
+    return rc;
+}
+
+/**
+ * Packs the payload the full-featured gds module would have delivered to the
+ * peer. Clients that cannot attach to our segment use it instead.
+ */
+static pmix_status_t
+pack_fallback_payload(
+    pmix_gds_shmem_job_t *job,
+    pmix_peer_t *peer,
+    pmix_buffer_t *reply
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_namespace_t *ns = peer->nptr;
+
+    pmix_buffer_t *fbuf = PMIX_NEW(pmix_buffer_t);
+    if (!fbuf) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = job->ffgds->register_job_info((struct pmix_peer_t *)peer, fbuf);
+    // The full-featured module may have cached its payload for reuse. We
+    // cache our own instead, so drop its copy.
+    if (fbuf == ns->jobbkt) {
+        PMIX_RELEASE(ns->jobbkt);
+        ns->jobbkt = NULL;
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = pack_buffer_as_kval(
+            peer, reply, PMIX_GDS_SHMEM_KEY_FALLBACK, fbuf
+        );
+    }
     else {
-        rc = PMIX_SUCCESS;
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_RELEASE(fbuf);
+    return rc;
+}
+
+/**
+ * Packs the job-level data that were not placed in the job's shared-memory
+ * segment. Clients hand them to the full-featured gds module.
+ */
+static pmix_status_t
+pack_residual_payload(
+    pmix_list_t *kvs,
+    pmix_peer_t *peer,
+    pmix_buffer_t *reply
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_buffer_t rbuf;
+    PMIX_CONSTRUCT(&rbuf, pmix_buffer_t);
+
+    pmix_kval_t *kvi;
+    PMIX_LIST_FOREACH (kvi, kvs, pmix_kval_t) {
+        if (kval_is_segment_storable(kvi)) {
+            continue;
+        }
+        PMIX_BFROPS_PACK(rc, peer, &rbuf, kvi, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&rbuf);
+            return rc;
+        }
     }
+    rc = pack_buffer_as_kval(peer, reply, PMIX_GDS_SHMEM_KEY_RESIDUAL, &rbuf);
+    PMIX_DESTRUCT(&rbuf);
     return rc;
 }
 
@@ -652,8 +951,6 @@ register_job_info(
     if (PMIX_SUCCESS != rc) {
         return rc;
     }
-    // Get the job's TMA.
-    pmix_tma_t *tma = pmix_gds_shmem_get_job_tma(job);
 
     pmix_proc_t wildcard;
     PMIX_LOAD_PROCID(&wildcard, ns->nspace, PMIX_RANK_WILDCARD);
@@ -670,130 +967,59 @@ register_job_info(
         PMIX_ERROR_LOG(rc);
         return rc;
     }
-    // Pack the data so we can see how large it is. This will help inform how
-    // large to make the shared-memory segment associated with these data.
-    pmix_buffer_t data;
-    PMIX_CONSTRUCT(&data, pmix_buffer_t);
-
-    pmix_kval_t *kvi;
-    PMIX_LIST_FOREACH (kvi, &job_cb.kvs, pmix_kval_t) {
-        PMIX_BFROPS_PACK(rc, peer, &data, kvi, 1, PMIX_KVAL);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_DESTRUCT(&job_cb);
-            PMIX_DESTRUCT(&data);
-            PMIX_ERROR_LOG(rc);
-            return rc;
-        }
-    }
-    data_size += data.bytes_allocated;
-    // No longer needed since we captured its size.
-    PMIX_DESTRUCT(&data);
-
-    rc = prepare_backing_store_for_local_job_data(job, data_size);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    pmix_hash_table2_t *ht = job->smdata->local_hashtab;
-    PMIX_LIST_FOREACH (kvi, &job_cb.kvs, pmix_kval_t) {
-        if (PMIX_DATA_ARRAY == kvi->value->type) {
-            // We support the following keys of this type.
-            if (pmix_gds_shmem_keys_eq(kvi->key, PMIX_APP_INFO_ARRAY)) {
-                PMIX_GDS_SHMEM_VOUT("storing app info array ---------------");
-                rc = pmix_gds_shmem_store_app_array(job, kvi->value);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    break;
-                }
-            }
-            else if (pmix_gds_shmem_keys_eq(kvi->key, PMIX_NODE_INFO_ARRAY)) {
-                PMIX_GDS_SHMEM_VOUT("storing node info array --------------");
-                rc = pmix_gds_shmem_store_node_array(
-                    job, kvi->value, job->smdata->nodeinfo
-                );
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    break;
-                }
-            }
-            else if (pmix_gds_shmem_keys_eq(kvi->key, PMIX_PROC_INFO_ARRAY)) {
-                PMIX_GDS_SHMEM_VOUT("storing proc info array --------------");
-                rc = pmix_gds_shmem_store_proc_data(job, kvi);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    break;
-                }
-            }
-            else {
-                rc = PMIX_ERR_NOT_SUPPORTED;
-                PMIX_ERROR_LOG(rc);
-                break;
-            }
-        }
-        else {
-            PMIX_GDS_SHMEM_VOUT("storing key=%s--------------", kvi->key);
-            pmix_kval_t *kv = PMIX_NEW(pmix_kval_t, tma);
-            kv->key = pmix_tma_strdup(tma, kvi->key);
-            PMIX_GDS_SHMEM_VALUE_XFER(rc, kv->value, kvi->value, tma);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_RELEASE(kv);
-                PMIX_ERROR_LOG(rc);
-                break;
-            }
-            rc = pmix_hash2_store(ht, PMIX_RANK_WILDCARD, kvi, NULL, 0);
+    // The segment is populated once and then only read, so
+    // only build it the first time one of our peers asks.
+    if (!job->smdata) {
+        // Pack the data so we can see how large it is. This will help inform
+        // how large to make the shared-memory segment associated with these
+        // data.
+        pmix_buffer_t data;
+        PMIX_CONSTRUCT(&data, pmix_buffer_t);
+
+        pmix_kval_t *kvi;
+        PMIX_LIST_FOREACH (kvi, &job_cb.kvs, pmix_kval_t) {
+            PMIX_BFROPS_PACK(rc, peer, &data, kvi, 1, PMIX_KVAL);
             if (PMIX_SUCCESS != rc) {
-                PMIX_RELEASE(kv);
+                PMIX_DESTRUCT(&job_cb);
+                PMIX_DESTRUCT(&data);
                 PMIX_ERROR_LOG(rc);
-                break;
+                return rc;
             }
         }
-    }
-    // No longer needed, as we already saved its data.
-    PMIX_DESTRUCT(&job_cb);
-    if (PMIX_SUCCESS != rc) {
-        return rc;
+        data_size += data.bytes_allocated;
+        // No longer needed since we captured its size.
+        PMIX_DESTRUCT(&data);
+        // Failing to publish is not an error: our
+        // clients simply fall back to private copies.
+        rc = publish_segment(job, &job_cb.kvs, data_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_GDS_SHMEM_VOUT(
+                "%s: cannot serve namespace=%s from shared memory (%s), "
+                "falling back to %s", __func__, ns->nspace,
+                PMIx_Error_string(rc), job->ffgds->name
+            );
+        }
     }
     // Now pack the payload for delivery.
     const char *msg = ns->nspace;
     PMIX_BFROPS_PACK(rc, peer, reply, &msg, 1, PMIX_STRING);
     if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&job_cb);
         PMIX_ERROR_LOG(rc);
         return rc;
     }
-
-    for (pmix_rank_t rank = 0; rank < ns->nprocs; rank++) {
-        pmix_buffer_t buff;
-        PMIX_CONSTRUCT(&buff, pmix_buffer_t);
-        PMIX_BFROPS_PACK(rc, peer, &buff, &rank, 1, PMIX_PROC_RANK);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DESTRUCT(&buff);
-            break;
-        }
-
-        rc = pack_shmem_connection_info(job, peer, &buff);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_DESTRUCT(&buff);
-            PMIX_ERROR_LOG(rc);
-            break;
-        }
-
-        pmix_value_t blob;
-        pmix_kval_t kv = {
-            .key = PMIX_PROC_BLOB,
-            .value = &blob
-        };
-        blob.type = PMIX_BYTE_OBJECT;
-        PMIX_UNLOAD_BUFFER(&buff, blob.data.bo.bytes, blob.data.bo.size);
-        PMIX_BFROPS_PACK(rc, peer, reply, &kv, 1, PMIX_KVAL);
-        PMIX_VALUE_DESTRUCT(&blob);
-        PMIX_DESTRUCT(&buff);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            break;
+    if (job->smdata) {
+        rc = pack_shmem_connection_info(job, peer, reply);
+        if (PMIX_SUCCESS == rc) {
+            rc = pack_residual_payload(&job_cb.kvs, peer, reply);
         }
     }
+    // No longer needed, as we already saved its data.
+    PMIX_DESTRUCT(&job_cb);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = pack_fallback_payload(job, peer, reply);
     if (PMIX_SUCCESS != rc) {
         return rc;
     }
@@ -858,12 +1084,230 @@ server_register_job_info(
     return register_job_info(peer_struct, reply);
 }
 
+static inline void
+relocate_obj(
+    pmix_object_t *obj,
+    ptrdiff_t delta
+) {
+    PMIX_TMA_RELOCATE(obj->obj_tma.data_ptr, delta);
+}
+
+static void
+relocate_kvals(
+    pmix_list_t *list,
+    ptrdiff_t delta
+) {
+    relocate_obj(&list->super, delta);
+    pmix_list_relocate(list, delta);
+
+    pmix_kval_t *kv;
+    PMIX_LIST_FOREACH (kv, list, pmix_kval_t) {
+        relocate_obj(&kv->super.super, delta);
+        PMIX_TMA_RELOCATE(kv->key, delta);
+        PMIX_TMA_RELOCATE(kv->value, delta);
+        pmix_gds_shmem_relocate_value(kv->value, delta);
+    }
+}
+
+static void
+relocate_nodeinfo(
+    pmix_list_t *list,
+    ptrdiff_t delta
+) {
+    relocate_obj(&list->super, delta);
+    pmix_list_relocate(list, delta);
+
+    pmix_gds_shmem_nodeinfo_t *ni;
+    PMIX_LIST_FOREACH (ni, list, pmix_gds_shmem_nodeinfo_t) {
+        relocate_obj(&ni->super.super, delta);
+        PMIX_TMA_RELOCATE(ni->hostname, delta);
+        PMIX_TMA_RELOCATE(ni->aliases, delta);
+        PMIX_TMA_RELOCATE(ni->info, delta);
+
+        relocate_obj(&ni->aliases->super, delta);
+        pmix_list_relocate(ni->aliases, delta);
+        pmix_gds_shmem_host_alias_t *alias;
+        PMIX_LIST_FOREACH (alias, ni->aliases, pmix_gds_shmem_host_alias_t) {
+            relocate_obj(&alias->super.super, delta);
+            PMIX_TMA_RELOCATE(alias->name, delta);
+        }
+        relocate_kvals(ni->info, delta);
+    }
+}
+
+static void
+relocate_apps(
+    pmix_list_t *list,
+    ptrdiff_t delta
+) {
+    relocate_obj(&list->super, delta);
+    pmix_list_relocate(list, delta);
+
+    pmix_gds_shmem_app_t *app;
+    PMIX_LIST_FOREACH (app, list, pmix_gds_shmem_app_t) {
+        relocate_obj(&app->super.super, delta);
+        PMIX_TMA_RELOCATE(app->appinfo, delta);
+        PMIX_TMA_RELOCATE(app->nodeinfo, delta);
+        relocate_kvals(app->appinfo, delta);
+        relocate_nodeinfo(app->nodeinfo, delta);
+        // app->job refers to the server's job tracker: clients never use it.
+    }
+}
+
+/**
+ * Moves every pointer into the job's segment by delta bytes, after it has been
+ * mapped delta bytes away from the address the server built it at. Every
+ * structure the server stores in the segment is walked, so this must be kept
+ * in sync with populate_segment().
+ */
+static void
+relocate_segment(
+    pmix_gds_shmem_job_t *job,
+    ptrdiff_t delta
+) {
+    pmix_gds_shmem_shared_data_t *smdata = job->smdata;
+
+    PMIX_TMA_RELOCATE(smdata->tma.data_ptr, delta);
+    PMIX_TMA_RELOCATE(smdata->current_addr, delta);
+    PMIX_TMA_RELOCATE(smdata->end_addr, delta);
+    PMIX_TMA_RELOCATE(smdata->nodeinfo, delta);
+    PMIX_TMA_RELOCATE(smdata->apps, delta);
+    PMIX_TMA_RELOCATE(smdata->local_hashtab, delta);
+    PMIX_TMA_RELOCATE(smdata->jobinfo, delta);
+
+    relocate_kvals(smdata->jobinfo, delta);
+    relocate_nodeinfo(smdata->nodeinfo, delta);
+    relocate_apps(smdata->apps, delta);
+    pmix_hash2_relocate(smdata->local_hashtab, delta);
+    // The update list is left alone: the server keeps appending to its own
+    // view, which ours no longer follows, so relocated clients ask the server
+    // to refresh their job-level info instead.
+}
+
+/**
+ * Attaches to the shared-memory segment described by the job's connection
+ * information. The data it holds contain absolute pointers, so we first try
+ * the address used by the server. Should that address be taken in this
+ * process, we map a private, copy-on-write view of the segment wherever we can
+ * and move its pointers instead: only the pages holding pointers then stop
+ * being shared with the other processes.
+ */
+static pmix_status_t
+attach_to_segment(
+    pmix_gds_shmem_job_t *job
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    void *req_addr = job->shmem->base_address;
+    bool relocate = false;
+
+    uintptr_t mmap_addr = 0;
+    rc = pmix_shmem_segment_attach(job->shmem, req_addr, &mmap_addr);
+    if (PMIX_SUCCESS == rc && mmap_addr != (uintptr_t)req_addr) {
+        PMIX_GDS_SHMEM_VOUT(
+            "%s: requested address=0x%zx is unavailable (got 0x%zx), "
+            "relocating a private view", __func__,
+            (size_t)req_addr, (size_t)mmap_addr
+        );
+        (void)pmix_shmem_segment_detach(job->shmem);
+        rc = pmix_shmem_segment_attach_private(
+            job->shmem, (void *)mmap_addr, &mmap_addr
+        );
+        relocate = true;
+    }
+    // Clients never own the backing file, and it is no longer needed once
+    // mapped. Forget its path so that we never remove it on the way out.
+    memset(job->shmem->backing_path, 0, PMIX_PATH_MAX);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: mmapd at address=0x%zx", __func__, (size_t)mmap_addr
+    );
+    // Now we need to initialize our data
+    // structures from the shared-memory segment.
+    job->smdata = job->shmem->base_address;
+    if (relocate) {
+        relocate_segment(job, (ptrdiff_t)(mmap_addr - (uintptr_t)req_addr));
+        job->relocated = true;
+    }
+    job->update_seq = job->smdata->update_seq;
+    // Protect memory: clients can only read from here.
+    if (0 != mprotect(job->shmem->base_address, job->shmem->size, PROT_READ)) {
+        job->smdata = NULL;
+        (void)pmix_shmem_segment_detach(job->shmem);
+        return PMIX_ERROR;
+    }
+    pmix_gds_shmem_vout_smdata(job);
+    // Let the namespace know its size, as the full-featured module would.
+    if (0 == job->nspace->nprocs) {
+        pmix_list_t kvs;
+        PMIX_CONSTRUCT(&kvs, pmix_list_t);
+        rc = pmix_hash2_fetch(
+            job->smdata->local_hashtab, PMIX_RANK_WILDCARD,
+            PMIX_JOB_SIZE, NULL, 0, &kvs
+        );
+        if (PMIX_SUCCESS == rc) {
+            pmix_kval_t *kv = (pmix_kval_t *)pmix_list_get_first(&kvs);
+            PMIX_VALUE_GET_NUMBER(
+                rc, kv->value, job->nspace->nprocs, uint32_t
+            );
+        }
+        PMIX_LIST_DESTRUCT(&kvs);
+        // Not having the job size is not fatal.
+        rc = PMIX_SUCCESS;
+    }
+    return rc;
+}
+
+/**
+ * Hands the given payload to the full-featured gds module.
+ */
+static pmix_status_t
+store_job_info_ffgds(
+    pmix_gds_shmem_job_t *job,
+    const char *nspace,
+    pmix_byte_object_t *bo,
+    bool has_nspace
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_buffer_t bbuff;
+    PMIX_CONSTRUCT(&bbuff, pmix_buffer_t);
+    // Note that the buffer takes ownership of the bytes.
+    PMIX_LOAD_BUFFER(
+        pmix_client_globals.myserver, &bbuff, bo->bytes, bo->size
+    );
+    // The fallback payload starts with the namespace,
+    // which the store_job_info() interface omits.
+    if (has_nspace) {
+        char *pnspace = NULL;
+        int32_t cnt = 1;
+        PMIX_BFROPS_UNPACK(
+            rc, pmix_client_globals.myserver,
+            &bbuff, &pnspace, &cnt, PMIX_STRING
+        );
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&bbuff);
+            return rc;
+        }
+        free(pnspace);
+    }
+    rc = job->ffgds->store_job_info(nspace, &bbuff);
+    PMIX_DESTRUCT(&bbuff);
+    return rc;
+}
+
 static pmix_status_t
 store_job_info(
     const char *nspace,
     pmix_buffer_t *buff
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
+    bool have_conn_info = false;
+    bool have_residual = false;
+    pmix_byte_object_t residual = {.bytes = NULL, .size = 0};
+    pmix_byte_object_t fallback = {.bytes = NULL, .size = 0};
 
     PMIX_GDS_SHMEM_VOUT(
         "%s:%s for namespace=%s", __func__,
@@ -886,41 +1330,27 @@ store_job_info(
         buff, &kval, &cnt, PMIX_KVAL
     );
     while (PMIX_SUCCESS == rc) {
-        if (PMIX_CHECK_KEY(&kval, PMIX_PROC_BLOB)) {
-            pmix_rank_t rank;
-            pmix_byte_object_t *bo = &(kval.value->data.bo);
-
-            pmix_buffer_t bbuff;
-            PMIX_CONSTRUCT(&bbuff, pmix_buffer_t);
-
-            PMIX_LOAD_BUFFER(
-                pmix_client_globals.myserver,
-                &bbuff, bo->bytes, bo->size
-            );
-            // Start by unpacking the rank.
-            cnt = 1;
-            PMIX_BFROPS_UNPACK(
-                rc, pmix_client_globals.myserver,
-                &bbuff, &rank, &cnt, PMIX_PROC_RANK
-            );
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&kval);
-                PMIX_DESTRUCT(&bbuff);
-                return rc;
-            }
-            rc = unpack_shmem_connection_info(job, &bbuff);
-            PMIX_DESTRUCT(&bbuff);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&kval);
-                return rc;
-            }
+        rc = unpack_shmem_connection_info(job, &kval);
+        if (PMIX_SUCCESS == rc) {
+            have_conn_info = true;
         }
-        else {
-            rc = PMIX_ERR_BAD_PARAM;
+        else if (PMIX_ERR_NOT_FOUND != rc) {
+            PMIX_ERROR_LOG(rc);
             break;
         }
+        else if (PMIX_CHECK_KEY(&kval, PMIX_GDS_SHMEM_KEY_RESIDUAL)) {
+            have_residual = true;
+            residual = kval.value->data.bo;
+            kval.value->data.bo.bytes = NULL;
+            kval.value->data.bo.size = 0;
+        }
+        else if (PMIX_CHECK_KEY(&kval, PMIX_GDS_SHMEM_KEY_FALLBACK)) {
+            fallback = kval.value->data.bo;
+            kval.value->data.bo.bytes = NULL;
+            kval.value->data.bo.size = 0;
+        }
+        // Anything else is info the server appends for non-hash
+        // clients, which is already covered by the payloads above.
         PMIX_DESTRUCT(&kval);
         PMIX_CONSTRUCT(&kval, pmix_kval_t);
         cnt = 1;
@@ -934,45 +1364,35 @@ store_job_info(
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         rc = PMIX_ERR_UNPACK_FAILURE;
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto out;
     }
-    // Attach to the given shared-memory segment.
-    uintptr_t mmap_addr = 0;
-    rc = pmix_shmem_segment_attach(
-        job->shmem,
-        // The base address was populated above.
-        job->shmem->base_address,
-        &mmap_addr
-    );
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
+    rc = PMIX_SUCCESS;
+    // Attach to the given shared-memory segment, if the server provided one.
+    if (have_conn_info && have_residual) {
+        rc = attach_to_segment(job);
+        if (PMIX_SUCCESS == rc) {
+            // Done. Before this point the server should have populated the
+            // shared-memory segment with the relevant data.
+            rc = store_job_info_ffgds(job, nspace, &residual, false);
+            goto out;
+        }
+        PMIX_GDS_SHMEM_VOUT(
+            "%s: cannot attach to segment for namespace=%s (%s), "
+            "falling back to %s", __func__, nspace,
+            PMIx_Error_string(rc), job->ffgds->name
+        );
+        discard_segment(job);
     }
-    // Make sure that we mapped to the requested address.
-    if (mmap_addr != (uintptr_t)job->shmem->base_address) {
-        // TODO(skg) We should add a nice error message here.
-        rc = PMIX_ERROR;
+    // Keep a private copy, as the full-featured module would.
+    if (!fallback.bytes) {
+        rc = PMIX_ERR_BAD_PARAM;
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto out;
     }
-    PMIX_GDS_SHMEM_VOUT(
-        "%s: mmapd at address=0x%zx", __func__, (size_t)mmap_addr
-    );
-    // Now we need to initialize our data
-    // structures from the shared-memory segment.
-    job->smdata = job->shmem->base_address;
-    // Update the TMA to point to its local function pointers.
-    tma_init_function_pointers(&job->smdata->tma);
-    pmix_gds_shmem_vout_smdata(job);
-    // Protect memory: clients can only read from here.
-#if 0
-    mprotect(
-        job->shmem->base_address,
-        job->shmem->size, PROT_READ
-    );
-#endif
-    // Done. Before this point the server should have populated the
-    // shared-memory segment with the relevant data.
+    rc = store_job_info_ffgds(job, nspace, &fallback, true);
+out:
+    PMIX_BYTE_OBJECT_DESTRUCT(&residual);
+    PMIX_BYTE_OBJECT_DESTRUCT(&fallback);
     return rc;
 }
 
@@ -1046,13 +1466,23 @@ server_add_nspace(
     return PMIX_SUCCESS;
 }
 
-// TODO(skg) Implement.
 static pmix_status_t
 del_nspace(
     const char *nspace
 ) {
-    PMIX_HIDE_UNUSED_PARAMS(nspace);
     PMIX_GDS_SHMEM_VOUT_HERE();
+
+    pmix_gds_shmem_job_t *job;
+    pmix_status_t rc = pmix_gds_shmem_get_job_tracker(nspace, false, &job);
+    if (PMIX_SUCCESS != rc) {
+        // Nothing to do: we never served this namespace.
+        return PMIX_SUCCESS;
+    }
+    // Releasing the tracker detaches from its segment. On the server this also
+    // removes the segment's backing file; clients already attached keep their
+    // mappings until they detach.
+    pmix_list_remove_item(&pmix_mca_gds_shmem_component.jobs, &job->super);
+    PMIX_RELEASE(job);
     return PMIX_SUCCESS;
 }
 
@@ -1096,6 +1526,55 @@ accept_kvs_resp(
     return job->ffgds->accept_kvs_resp(buff);
 }
 
+/**
+ * Publishes a job-level value registered after the job's segment was
+ * populated, such as resources registered by the host, to its clients.
+ */
+static pmix_status_t
+update_job_info(
+    const char *nspace,
+    pmix_kval_t *kv
+) {
+    pmix_gds_shmem_job_t *job;
+    pmix_status_t rc = pmix_gds_shmem_get_job_tracker(nspace, false, &job);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    // Arrays are structured data we only store when populating the segment.
+    if (!job->smdata || PMIX_DATA_ARRAY == kv->value->type ||
+        !kval_is_segment_storable(kv)) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return pmix_gds_shmem_store_update(job, kv);
+}
+
+/**
+ * Tells whether the server published updates to the job's segment since we
+ * last looked. Those are picked up by the fetch path as they are, so there is
+ * nothing to copy.
+ */
+static pmix_status_t
+refresh(
+    const char *nspace,
+    bool *changed
+) {
+    pmix_gds_shmem_job_t *job;
+    pmix_status_t rc = pmix_gds_shmem_get_job_tracker(nspace, false, &job);
+    if (PMIX_SUCCESS != rc) {
+        // Nothing was stored for this namespace.
+        *changed = false;
+        return PMIX_SUCCESS;
+    }
+    if (!job->smdata || job->relocated || job->smdata->updates_lost) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    const uint64_t seq = job->smdata->update_seq;
+    pmix_atomic_rmb();
+    *changed = (seq != job->update_seq);
+    job->update_seq = seq;
+    return PMIX_SUCCESS;
+}
+
 pmix_gds_base_module_t pmix_shmem_module = {
     .name = PMIX_GDS_SHMEM_NAME,
     .is_tsafe = false,
@@ -1112,7 +1591,9 @@ pmix_gds_base_module_t pmix_shmem_module = {
     .add_nspace = server_add_nspace,
     .del_nspace = del_nspace,
     .assemb_kvs_req = assemb_kvs_req,
-    .accept_kvs_resp = accept_kvs_resp
+    .accept_kvs_resp = accept_kvs_resp,
+    .update_job_info = update_job_info,
+    .refresh = refresh
 };
 
 /*
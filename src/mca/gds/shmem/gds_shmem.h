@@ -13,6 +13,7 @@
 #define PMIX_GDS_SHMEM_H
 
 #include "src/include/pmix_config.h"
+#include "src/include/pmix_atomic.h"
 #include "src/include/pmix_globals.h"
 
 #include "src/mca/gds/base/base.h"
@@ -27,9 +28,7 @@
 #include "src/mca/gds/gds.h"
 
 #include "include/pmix_common.h"
-
-// TODO(skg) Remove
-#include "pmix_hash_table2.h"
+#include "src/class/pmix_hash_table.h"
 
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
@@ -40,11 +39,6 @@
  */
 #define PMIX_GDS_SHMEM_NAME "shmem"
 
-/**
- * Set to 1 to completely disable this component.
- */
-#define PMIX_GDS_SHMEM_DISABLE 1
-
 /**
  * Defines a bitmask to track what information may not
  * have been provided but is computable from other info.
@@ -57,14 +51,9 @@
 #define PMIX_GDS_SHMEM_NODE_MAP  0x00000020
 
 /**
- * Default component/module priority.
+ * Default component/module priority. We want to be just above hash's priority.
  */
-#if (PMIX_GDS_SHMEM_DISABLE == 1)
-#define PMIX_GDS_SHMEM_DEFAULT_PRIORITY 0
-#else
-// We want to be just above hash's priority.
 #define PMIX_GDS_SHMEM_DEFAULT_PRIORITY 20
-#endif
 
 BEGIN_C_DECLS
 
@@ -72,6 +61,8 @@ extern pmix_gds_base_module_t pmix_shmem_module;
 
 typedef struct {
     pmix_gds_base_component_t super;
+    /** Component/module priority. */
+    int priority;
     /** List of jobs that I'm supporting. */
     pmix_list_t jobs;
 } pmix_gds_shmem_component_t;
@@ -99,6 +90,16 @@ typedef struct {
 } pmix_gds_shmem_nodeinfo_t;
 PMIX_CLASS_DECLARATION(pmix_gds_shmem_nodeinfo_t);
 
+/**
+ * A job-level value published after the segment was populated. Updates are
+ * only ever appended, so readers can walk the list without locking once they
+ * have a consistent snapshot of its length.
+ */
+typedef struct pmix_gds_shmem_update_t {
+    struct pmix_gds_shmem_update_t *next;
+    pmix_kval_t *kv;
+} pmix_gds_shmem_update_t;
+
 // Note that the shared data structures in pmix_gds_shmem_shared_data_t are
 // pointers. They need to be because their respective locations must reside on
 // the shared heap located in shared-memory and managed by the shared-memory
@@ -108,14 +109,33 @@ typedef struct {
     pmix_tma_t tma;
     /** Holds the current address of the shared-memory allocator. */
     void *current_addr;
+    /** One past the last usable address of the shared-memory segment. */
+    void *end_addr;
     /** Node information. */
     pmix_list_t *nodeinfo;
     /** List of applications in this job. */
     pmix_list_t *apps;
     /** Stores local (node) data. */
-    pmix_hash_table2_t *local_hashtab;
+    pmix_hash_table_t *local_hashtab;
     /** Job information. */
     pmix_list_t *jobinfo;
+    /**
+     * Sequence number of the update list: odd while the server is appending
+     * to it, so readers retry until they see the same even value on both
+     * sides of their read.
+     */
+    volatile uint64_t update_seq;
+    /** Number of updates in the list. */
+    size_t nupdates;
+    /** Oldest update. */
+    pmix_gds_shmem_update_t *updates_head;
+    /** Newest update. */
+    pmix_gds_shmem_update_t *updates_tail;
+    /**
+     * Set if an update did not fit in the segment: clients must then ask the
+     * server for the job-level info.
+     */
+    bool updates_lost;
 } pmix_gds_shmem_shared_data_t;
 
 typedef struct {
@@ -128,8 +148,16 @@ typedef struct {
     pmix_gds_base_module_t *ffgds;
     /** Shared-memory object. */
     pmix_shmem_t *shmem;
-    /** Points to shared data located in shared-memory segment. */
+    /**
+     * Points to shared data located in shared-memory segment. NULL if the
+     * job's data could not be served from shared memory, in which case all
+     * requests are handled by ffgds.
+     */
     pmix_gds_shmem_shared_data_t *smdata;
+    /** Set if the segment is a relocated, private view of the server's. */
+    bool relocated;
+    /** Sequence number of the update list at our last refresh. */
+    uint64_t update_seq;
 } pmix_gds_shmem_job_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_gds_shmem_job_t);
 
@@ -30,27 +30,40 @@
 
 #include "gds_shmem.h"
 
+static int
+component_register(void)
+{
+    pmix_mca_gds_shmem_component.priority = PMIX_GDS_SHMEM_DEFAULT_PRIORITY;
+    (void)pmix_mca_base_component_var_register(
+        &pmix_mca_gds_shmem_component.super, "priority",
+        "Priority of the shmem gds component. Job-level data are served "
+        "from a single shared-memory segment per node when this component "
+        "is selected (a value of 0 disables it)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_mca_gds_shmem_component.priority
+    );
+    return PMIX_SUCCESS;
+}
+
 static int
 component_query(
     pmix_mca_base_module_t **module,
     int *priority
 ) {
+    *priority = 0;
+    *module = NULL;
+    // A priority of zero means we were disabled by the user.
+    if (0 >= pmix_mca_gds_shmem_component.priority) {
+        return PMIX_ERROR;
+    }
     // See if the required system file is present.
     // See pmix_vmem_find_hole() for more information.
     if (access("/proc/self/maps", F_OK) == -1) {
-        *priority = 0;
-        *module = NULL;
         return PMIX_ERROR;
     }
-#if (PMIX_GDS_SHMEM_DISABLE == 1)
-    *priority = PMIX_GDS_SHMEM_DEFAULT_PRIORITY;
-    *module = NULL;
-    return PMIX_ERROR;
-#else
-    *priority = PMIX_GDS_SHMEM_DEFAULT_PRIORITY;
+    *priority = pmix_mca_gds_shmem_component.priority;
     *module = (pmix_mca_base_module_t *)&pmix_shmem_module;
     return PMIX_SUCCESS;
-#endif
 }
 
 /**
@@ -70,8 +83,11 @@ pmix_gds_shmem_component_t pmix_mca_gds_shmem_component = {
         ),
         /** Component query function. */
         .pmix_mca_query_component = component_query,
+        /** Component parameter registration function. */
+        .pmix_mca_register_component_params = component_register,
         .reserved = {0}
     },
+    .priority = PMIX_GDS_SHMEM_DEFAULT_PRIORITY,
     .jobs = PMIX_LIST_STATIC_INIT
 };
 
@@ -35,7 +35,6 @@ fetch_all_node_info(
     pmix_gds_shmem_nodeinfo_t *nodeinfo,
     pmix_list_t *kvs
 ) {
-    assert(false);
     size_t i = 0;
 
     pmix_kval_t *kv = PMIX_NEW(pmix_kval_t);
@@ -394,7 +393,94 @@ pmix_gds_shmem_fetch_appinfo(
     return rc;
 }
 
-#if 0
+static pmix_status_t
+copy_kval(
+    const pmix_kval_t *src,
+    pmix_kval_t **dst
+) {
+    pmix_status_t rc;
+    pmix_kval_t *kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv->key = strdup(src->key);
+    kv->value = (pmix_value_t *)malloc(sizeof(pmix_value_t));
+    if (NULL == kv->key || NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_XFER(rc, kv->value, src->value);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(kv);
+        return rc;
+    }
+    *dst = kv;
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Fetches the job-level values the server published to the segment after
+ * populating it. Those supersede what was stored before, so given a key the
+ * newest match is returned, and without one every value in kvs that was
+ * updated is replaced. Returns PMIX_ERR_NOT_FOUND if nothing was added.
+ */
+static pmix_status_t
+fetch_updates(
+    pmix_gds_shmem_job_t *job,
+    const char *key,
+    pmix_list_t *kvs
+) {
+    pmix_gds_shmem_shared_data_t *smdata = job->smdata;
+    pmix_gds_shmem_update_t *up;
+    pmix_status_t rc = PMIX_ERR_NOT_FOUND;
+    uint64_t seq;
+    size_t nupdates;
+
+    // A relocated view holds the server's addresses in its update list.
+    if (job->relocated) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    // Updates are only appended, so a consistent snapshot of the head and
+    // length is all we need to walk them while the server adds more.
+    do {
+        seq = smdata->update_seq;
+        pmix_atomic_rmb();
+        nupdates = smdata->nupdates;
+        up = smdata->updates_head;
+        pmix_atomic_rmb();
+    } while ((seq & 1) || seq != smdata->update_seq);
+
+    const pmix_kval_t *match = NULL;
+    for (size_t i = 0; i < nupdates && NULL != up; i++, up = up->next) {
+        if (NULL != key) {
+            if (PMIX_CHECK_KEY(up->kv, key)) {
+                match = up->kv;
+            }
+            continue;
+        }
+        pmix_kval_t *kv, *next;
+        PMIX_LIST_FOREACH_SAFE (kv, next, kvs, pmix_kval_t) {
+            if (PMIX_CHECK_KEY(kv, up->kv->key)) {
+                pmix_list_remove_item(kvs, &kv->super);
+                PMIX_RELEASE(kv);
+            }
+        }
+        rc = copy_kval(up->kv, &kv);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        pmix_list_append(kvs, &kv->super);
+    }
+    if (NULL != match) {
+        pmix_kval_t *kv;
+        rc = copy_kval(match, &kv);
+        if (PMIX_SUCCESS == rc) {
+            pmix_list_append(kvs, &kv->super);
+        }
+    }
+    return rc;
+}
+
 static inline pmix_status_t
 fetch_job_level_info_for_namespace(
     pmix_gds_shmem_job_t *job,
@@ -404,7 +490,6 @@ fetch_job_level_info_for_namespace(
 ) {
     // Fetch all values from the hash table tied to rank=wildcard.
     pmix_status_t rc = pmix_hash2_fetch(
-        // TODO(skg) Is this correct?
         job->smdata->local_hashtab, PMIX_RANK_WILDCARD, NULL, NULL, 0, kvs
     );
     if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_FOUND != rc) {
@@ -427,14 +512,14 @@ fetch_job_level_info_for_namespace(
     rc = pmix_gds_shmem_fetch_nodeinfo(
         NULL, job, job->smdata->nodeinfo, qualifiers, nqual, kvs
     );
-    if (PMIX_SUCCESS != rc) {
+    if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_FOUND != rc) {
         return rc;
     }
     // Collect the relevant app-level info.
     rc = pmix_gds_shmem_fetch_appinfo(
         NULL, job, job->smdata->apps, qualifiers, nqual, kvs
     );
-    if (PMIX_SUCCESS != rc) {
+    if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_FOUND != rc) {
         return rc;
     }
     // Finally, we need the job-level info for each rank in the job.
@@ -475,9 +560,13 @@ fetch_job_level_info_for_namespace(
         // Release the search result.
         PMIX_LIST_DESTRUCT(&rkvs);
     }
-    return rc;
+    // Finally, apply whatever was published since the segment was populated.
+    rc = fetch_updates(job, NULL, kvs);
+    if (PMIX_SUCCESS != rc && PMIX_ERR_NOT_FOUND != rc) {
+        return rc;
+    }
+    return PMIX_SUCCESS;
 }
-#endif
 
 pmix_status_t
 pmix_gds_shmem_fetch(
@@ -505,15 +594,39 @@ pmix_gds_shmem_fetch(
     // that's why we pass false in pmix_gds_shmem_get_job_tracker().
     pmix_gds_shmem_job_t *job;
     rc = pmix_gds_shmem_get_job_tracker(proc->nspace, false, &job);
+    if (PMIX_ERR_NOT_FOUND == rc) {
+        // Nothing has been stored for this job yet. Callers routinely ask
+        // about namespaces they have yet to learn about, so just tell them,
+        // the same way the hash component does.
+        return PMIX_ERR_INVALID_NAMESPACE;
+    }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
     }
-    pmix_hash_table2_t *ht = job->smdata->local_hashtab;
-
+    // We could not serve this job from shared
+    // memory, so the full-featured module has it all.
+    if (!job->smdata) {
+        return job->ffgds->fetch(
+            proc, scope, copy, key, qualifiers, nqual, kvs
+        );
+    }
+    pmix_hash_table_t *ht = job->smdata->local_hashtab;
+    // If the rank is wildcard and the key is NULL, then they are asking
+    // for a complete copy of the job-level info for this nspace.
     if (NULL == key && PMIX_RANK_WILDCARD == proc->rank) {
-        assert(false);
-        return PMIX_ERR_NOT_SUPPORTED;
+        rc = fetch_job_level_info_for_namespace(job, qualifiers, nqual, kvs);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        // Add whatever was kept by the full-featured module.
+        rc = job->ffgds->fetch(
+            proc, scope, copy, key, qualifiers, nqual, kvs
+        );
+        if (PMIX_ERR_NOT_FOUND == rc || PMIX_ERR_INVALID_NAMESPACE == rc) {
+            rc = PMIX_SUCCESS;
+        }
+        return rc;
     }
 
     for (size_t n = 0; n < nqual; n++) {
@@ -605,6 +718,13 @@ doover:
         }
     }
     else {
+        // Values published since the segment was populated come first.
+        if (PMIX_RANK_WILDCARD == proc->rank && NULL != key) {
+            rc = fetch_updates(job, key, kvs);
+            if (PMIX_ERR_NOT_FOUND != rc) {
+                return rc;
+            }
+        }
         rc = pmix_hash2_fetch(ht, proc->rank, key, qualifiers, nqual, kvs);
     }
     if (PMIX_SUCCESS != rc) {
@@ -70,6 +70,41 @@ out:
     return rc;
 }
 
+/**
+ * Creates a new key/value pair allocated from the given TMA that holds copies
+ * of the provided key and value. Returns PMIX_ERR_NOMEM if the TMA's backing
+ * store is exhausted.
+ */
+static pmix_status_t
+new_tma_kval(
+    pmix_tma_t *tma,
+    const char *key,
+    pmix_value_t *value,
+    pmix_kval_t **kval
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_kval_t *kv = PMIX_NEW(pmix_kval_t, tma);
+    if (!kv) {
+        rc = PMIX_ERR_NOMEM;
+        goto out;
+    }
+    kv->value = NULL;
+    kv->key = pmix_tma_strdup(tma, key);
+    if (!kv->key) {
+        rc = PMIX_ERR_NOMEM;
+        goto out;
+    }
+    PMIX_GDS_SHMEM_VALUE_XFER(rc, kv->value, value, tma);
+out:
+    if (PMIX_SUCCESS != rc && kv) {
+        PMIX_RELEASE(kv);
+        kv = NULL;
+    }
+    *kval = kv;
+    return rc;
+}
+
 /**
  * Adds the given host name to the provided list. If the host name already
  * exists, then it is not added.
@@ -122,7 +157,7 @@ cache_node_info(
 
     pmix_gds_shmem_nodeinfo_t *inodeinfo = NULL;
     inodeinfo = PMIX_NEW(pmix_gds_shmem_nodeinfo_t, tma);
-    if (!inodeinfo) {
+    if (!inodeinfo || !inodeinfo->aliases || !inodeinfo->info) {
         rc = PMIX_ERR_NOMEM;
         goto out;
     }
@@ -147,6 +182,10 @@ cache_node_info(
             inodeinfo->hostname = pmix_tma_strdup(
                 tma, info[j].value.data.string
             );
+            if (!inodeinfo->hostname) {
+                rc = PMIX_ERR_NOMEM;
+                break;
+            }
         }
         else if (PMIX_CHECK_KEY(&info[j], PMIX_HOSTNAME_ALIASES)) {
             have_node_id_info = true;
@@ -161,25 +200,19 @@ cache_node_info(
                 break;
             }
             // Need to cache this value as well.
-            pmix_kval_t *kv = PMIX_NEW(pmix_kval_t, tma);
-            kv->key = pmix_tma_strdup(tma, info[j].key);
-            kv->value = NULL;
-            PMIX_GDS_SHMEM_VALUE_XFER(rc, kv->value, &info[j].value, tma);
+            pmix_kval_t *kv = NULL;
+            rc = new_tma_kval(tma, info[j].key, &info[j].value, &kv);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kv);
                 break;
             }
             pmix_list_append(cache, &kv->super);
         }
         else {
-            pmix_kval_t *kv = PMIX_NEW(pmix_kval_t, tma);
-            kv->key = pmix_tma_strdup(tma, info[j].key);
-            kv->value = NULL;
-            PMIX_GDS_SHMEM_VALUE_XFER(rc, kv->value, &info[j].value, tma);
+            pmix_kval_t *kv = NULL;
+            rc = new_tma_kval(tma, info[j].key, &info[j].value, &kv);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kv);
                 break;
             }
             pmix_list_append(cache, &kv->super);
@@ -270,6 +303,7 @@ pmix_gds_shmem_store_app_array(
     }
     pmix_list_t *node_cache = PMIX_NEW(pmix_list_t, tma);
     if (!node_cache) {
+        PMIX_LIST_DESTRUCT(app_cache);
         return PMIX_ERR_NOMEM;
     }
 
@@ -291,11 +325,16 @@ pmix_gds_shmem_store_app_array(
             // one app described in this array.
             if (NULL != app) {
                 PMIX_RELEASE(app);
+                app = NULL;
                 rc = PMIX_ERR_BAD_PARAM;
                 PMIX_ERROR_LOG(rc);
                 goto out;
             }
             app = PMIX_NEW(pmix_gds_shmem_app_t, tma);
+            if (!app || !app->appinfo || !app->nodeinfo) {
+                rc = PMIX_ERR_NOMEM;
+                goto out;
+            }
             app->appnum = appnum;
         }
         else if (PMIX_CHECK_KEY(&info[j], PMIX_NODE_INFO_ARRAY)) {
@@ -308,12 +347,10 @@ pmix_gds_shmem_store_app_array(
             }
         }
         else {
-            pmix_kval_t *kv = PMIX_NEW(pmix_kval_t, tma);
-            kv->key = pmix_tma_strdup(tma, info[j].key);
-            PMIX_GDS_SHMEM_VALUE_XFER(rc, kv->value, &info[j].value, tma);
+            pmix_kval_t *kv = NULL;
+            rc = new_tma_kval(tma, info[j].key, &info[j].value, &kv);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kv);
                 goto out;
             }
             pmix_list_append(app_cache, &kv->super);
@@ -325,6 +362,10 @@ pmix_gds_shmem_store_app_array(
         // an appnum so long as only one app is in the job.
         if (0 == pmix_list_get_size(job->smdata->apps)) {
             app = PMIX_NEW(pmix_gds_shmem_app_t, tma);
+            if (!app || !app->appinfo || !app->nodeinfo) {
+                rc = PMIX_ERR_NOMEM;
+                goto out;
+            }
             app->appnum = 0;
         }
         else {
@@ -359,6 +400,10 @@ pmix_gds_shmem_store_app_array(
         nd = (pmix_gds_shmem_nodeinfo_t *)pmix_list_remove_first(node_cache);
     }
 out:
+    // Only reached with an app on failure, before it was added to the job.
+    if (PMIX_SUCCESS != rc && app) {
+        PMIX_RELEASE(app);
+    }
     PMIX_LIST_DESTRUCT(app_cache);
     PMIX_LIST_DESTRUCT(node_cache);
     return rc;
@@ -413,6 +458,53 @@ pmix_gds_shmem_store_proc_data(
     return rc;
 }
 
+pmix_status_t
+pmix_gds_shmem_store_update(
+    pmix_gds_shmem_job_t *job,
+    pmix_kval_t *kval
+) {
+    pmix_status_t rc;
+    pmix_gds_shmem_shared_data_t *smdata = job->smdata;
+    pmix_tma_t *tma = pmix_gds_shmem_get_job_tma(job);
+    pmix_gds_shmem_update_t *up = NULL;
+
+    pmix_kval_t *kv = NULL;
+    rc = new_tma_kval(tma, kval->key, kval->value, &kv);
+    if (PMIX_SUCCESS == rc) {
+        up = pmix_tma_malloc(tma, sizeof(*up));
+        if (!up) {
+            PMIX_RELEASE(kv);
+            rc = PMIX_ERR_NOMEM;
+        }
+    }
+
+    smdata->update_seq++;
+    pmix_atomic_wmb();
+    if (PMIX_SUCCESS == rc) {
+        up->next = NULL;
+        up->kv = kv;
+        if (smdata->updates_tail) {
+            smdata->updates_tail->next = up;
+        }
+        else {
+            smdata->updates_head = up;
+        }
+        smdata->updates_tail = up;
+        smdata->nupdates++;
+    }
+    else {
+        smdata->updates_lost = true;
+    }
+    pmix_atomic_wmb();
+    smdata->update_seq++;
+
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: nspace=%s key=%s seq=%lu (%s)", __func__, job->nspace_id,
+        kval->key, (unsigned long)smdata->update_seq, PMIx_Error_string(rc)
+    );
+    return rc;
+}
+
 // TODO(skg) Maybe we can use this to store data for register_job_info().
 pmix_status_t
 pmix_gds_shmem_store_job_array(
@@ -461,12 +553,9 @@ pmix_gds_shmem_store_job_array(
             }
         }
         else {
-            pmix_kval_t *kv = PMIX_NEW(pmix_kval_t, tma);
-            kv->key = pmix_tma_strdup(tma, iptr[j].key);
-            kv->value = NULL;
-            PMIX_GDS_SHMEM_VALUE_XFER(rc, kv->value, &iptr[j].value, tma);
+            pmix_kval_t *kv = NULL;
+            rc = new_tma_kval(tma, iptr[j].key, &iptr[j].value, &kv);
             if (PMIX_SUCCESS != rc) {
-                PMIX_RELEASE(kv);
                 PMIX_LIST_DESTRUCT(cache);
                 return rc;
             }
@@ -53,6 +53,18 @@ pmix_gds_shmem_store_proc_data(
     const pmix_kval_t *kval
 );
 
+/**
+ * Appends a job-level value to the update list of the job's segment, making
+ * it visible to the clients already attached to it. Returns PMIX_ERR_NOMEM if
+ * the segment is exhausted, in which case its clients are told to ask the
+ * server instead.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_gds_shmem_store_update(
+    pmix_gds_shmem_job_t *job,
+    pmix_kval_t *kval
+);
+
 PMIX_EXPORT pmix_status_t
 pmix_gds_shmem_store_job_array(
     pmix_info_t *info,
@@ -1026,6 +1026,86 @@ pmix_gds_shmem_value_xfer(
     return PMIX_SUCCESS;
 }
 
+/**
+ * Moves the pointers held by a data array copied by
+ * pmix_gds_shmem_copy_darray(), which never nests arrays.
+ */
+static void
+relocate_darray(
+    pmix_data_array_t *darray,
+    ptrdiff_t delta
+) {
+    PMIX_TMA_RELOCATE(darray->array, delta);
+    if (NULL == darray->array) {
+        return;
+    }
+    switch (darray->type) {
+        case PMIX_STRING: {
+            char **strs = (char **)darray->array;
+            for (size_t n = 0; n < darray->size; n++) {
+                PMIX_TMA_RELOCATE(strs[n], delta);
+            }
+            break;
+        }
+        case PMIX_INFO: {
+            pmix_info_t *info = (pmix_info_t *)darray->array;
+            for (size_t n = 0; n < darray->size; n++) {
+                pmix_gds_shmem_relocate_value(&info[n].value, delta);
+            }
+            break;
+        }
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING: {
+            pmix_byte_object_t *bo = (pmix_byte_object_t *)darray->array;
+            for (size_t n = 0; n < darray->size; n++) {
+                PMIX_TMA_RELOCATE(bo[n].bytes, delta);
+            }
+            break;
+        }
+        default:
+            // Everything else is stored by value.
+            break;
+    }
+}
+
+void
+pmix_gds_shmem_relocate_value(
+    pmix_value_t *value,
+    ptrdiff_t delta
+) {
+    if (NULL == value) {
+        return;
+    }
+    switch (value->type) {
+        case PMIX_STRING:
+            PMIX_TMA_RELOCATE(value->data.string, delta);
+            break;
+        case PMIX_PROC:
+            PMIX_TMA_RELOCATE(value->data.proc, delta);
+            break;
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING:
+        case PMIX_REGEX:
+        case PMIX_COMPRESSED_BYTE_OBJECT:
+            PMIX_TMA_RELOCATE(value->data.bo.bytes, delta);
+            break;
+        case PMIX_DATA_ARRAY:
+            PMIX_TMA_RELOCATE(value->data.darray, delta);
+            if (NULL != value->data.darray) {
+                relocate_darray(value->data.darray, delta);
+            }
+            break;
+        case PMIX_ENVAR:
+            PMIX_TMA_RELOCATE(value->data.envar.envar, delta);
+            PMIX_TMA_RELOCATE(value->data.envar.value, delta);
+            break;
+        // PMIX_POINTER values are only meaningful to the process
+        // that stored them, so there is nothing to move.
+        default:
+            break;
+    }
+}
+
 /*
  * vim: ft=cpp ts=4 sts=4 sw=4 expandtab
  */
@@ -100,6 +100,16 @@ pmix_gds_shmem_value_xfer(
     pmix_tma_t *tma
 );
 
+/**
+ * Moves the pointers held by a value copied by pmix_gds_shmem_value_xfer() by
+ * delta bytes, after the region of its TMA has been mapped elsewhere.
+ */
+PMIX_EXPORT void
+pmix_gds_shmem_relocate_value(
+    pmix_value_t *value,
+    ptrdiff_t delta
+);
+
 PMIX_EXPORT pmix_status_t
 pmix_gds_shmem_bfrops_base_copy_value(
     pmix_value_t **dest,
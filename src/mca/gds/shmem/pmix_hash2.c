@@ -38,16 +38,8 @@
 #include "src/include/pmix_hash_string.h"
 #include "src/include/pmix_stdint.h"
 
-#if 0 // TODO(skg)
 #include "src/class/pmix_hash_table.h"
-#else
-#include "pmix_hash_table2.h"
-#endif
-#if 0 // TODO(skg)
 #include "src/class/pmix_pointer_array.h"
-#else
-#include "pmix_pointer_array2.h"
-#endif
 #include "src/include/pmix_dictionary.h"
 #include "src/include/pmix_globals.h"
 #include "src/include/pmix_hash_string.h"
@@ -84,11 +76,11 @@ typedef struct {
      * received from this process.
      */
 #if 0 
-    pmix_pointer_array2_t data;
-    pmix_pointer_array2_t quals;
+    pmix_pointer_array_t data;
+    pmix_pointer_array_t quals;
 #else
-    pmix_pointer_array2_t *data;
-    pmix_pointer_array2_t *quals;
+    pmix_pointer_array_t *data;
+    pmix_pointer_array_t *quals;
 #endif
 } pmix_proc_data2_t;
 
@@ -98,15 +90,15 @@ static void pdcon(pmix_proc_data2_t *p)
     // TODO(skg) Note that we moved to PMIX_NEW. Cannot use PMIX_CONSTRUCT with
     // the TMA we care about.
 #if 0
-    PMIX_CONSTRUCT(&p->data, pmix_pointer_array2_t, tma);
-    pmix_pointer_array2_init(&p->data, 128, INT_MAX, 128);
-    PMIX_CONSTRUCT(&p->quals, pmix_pointer_array2_t, tma);
-    pmix_pointer_array2_init(&p->quals, 1, INT_MAX, 1);
+    PMIX_CONSTRUCT(&p->data, pmix_pointer_array_t, tma);
+    pmix_pointer_array_init(&p->data, 128, INT_MAX, 128);
+    PMIX_CONSTRUCT(&p->quals, pmix_pointer_array_t, tma);
+    pmix_pointer_array_init(&p->quals, 1, INT_MAX, 1);
 #else
-    p->data = PMIX_NEW(pmix_pointer_array2_t, tma);
-    pmix_pointer_array2_init(p->data, 128, INT_MAX, 128);
-    p->quals = PMIX_NEW(pmix_pointer_array2_t, tma);
-    pmix_pointer_array2_init(p->quals, 1, INT_MAX, 1);
+    p->data = PMIX_NEW(pmix_pointer_array_t, tma);
+    pmix_pointer_array_init(p->data, 128, INT_MAX, 128);
+    p->quals = PMIX_NEW(pmix_pointer_array_t, tma);
+    pmix_pointer_array_init(p->quals, 1, INT_MAX, 1);
 #endif
 }
 
@@ -120,15 +112,15 @@ static void pddes(pmix_proc_data2_t *p)
     pmix_tma_t *tma = pmix_obj_get_tma(&p->super);
 
     for (n=0; n < p->data->size; n++) {
-        d = (pmix_dstor_t*)pmix_pointer_array2_get_item(p->data, n);
+        d = (pmix_dstor_t*)pmix_pointer_array_get_item(p->data, n);
         if (NULL != d) {
             PMIX_DSTOR_RELEASE(d);
-            pmix_pointer_array2_set_item(p->data, n, NULL);
+            pmix_pointer_array_set_item(p->data, n, NULL);
         }
     }
     PMIX_DESTRUCT(&p->data);
     for (n=0; n < p->quals->size; n++) {
-        darray = (pmix_data_array_t*)pmix_pointer_array2_get_item(p->quals, n);
+        darray = (pmix_data_array_t*)pmix_pointer_array_get_item(p->quals, n);
         if (NULL != darray) {
             q = (pmix_qual_t*)darray->array;
             for (nq=0; nq < darray->size; nq++) {
@@ -139,7 +131,7 @@ static void pddes(pmix_proc_data2_t *p)
             pmix_tma_free(tma, darray->array);
             pmix_tma_free(tma, darray);
         }
-        pmix_pointer_array2_set_item(p->quals, n, NULL);
+        pmix_pointer_array_set_item(p->quals, n, NULL);
     }
     PMIX_DESTRUCT(&p->quals);
 }
@@ -147,12 +139,12 @@ static PMIX_CLASS_INSTANCE(pmix_proc_data2_t, pmix_object_t, pdcon, pddes);
 
 static pmix_dstor_t *lookup_keyval(pmix_proc_data2_t *proc, uint32_t kid,
                                    pmix_info_t *qualifiers, size_t nquals);
-static pmix_proc_data2_t *lookup_proc(pmix_hash_table2_t *jtable, uint32_t id, bool create);
+static pmix_proc_data2_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, bool create);
 static void erase_qualifiers(pmix_proc_data2_t *proc,
                              uint32_t index);
 
 
-pmix_status_t pmix_hash2_store(pmix_hash_table2_t *table,
+pmix_status_t pmix_hash2_store(pmix_hash_table_t *table,
                               pmix_rank_t rank, pmix_kval_t *kin,
                               pmix_info_t *qualifiers, size_t nquals)
 {
@@ -225,12 +217,11 @@ pmix_status_t pmix_hash2_store(pmix_hash_table2_t *table,
                             PMIX_NAME_PRINT(&pmix_globals.myid), tmp);
                 free(tmp);
             }
-            PMIX_VALUE_RELEASE(hv->value);
+            /* the value lives in the table's memory, so release it there */
+            pmix_tma_free(tma, hv->value);
+            hv->value = NULL;
         }
-        /* eventually, we want to eliminate this copy */
-        // TODO(skg) We need to modify this.
-        PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&hv->value, kin->value, PMIX_VALUE);
-        assert(false);
+        PMIX_GDS_SHMEM_BFROPS_COPY_TMA(rc, &hv->value, kin->value, PMIX_VALUE, tma);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -254,7 +245,7 @@ pmix_status_t pmix_hash2_store(pmix_hash_table2_t *table,
             darray = (pmix_data_array_t*)pmix_tma_malloc(tma, sizeof(pmix_data_array_t));
             darray->array = (pmix_qual_t*)pmix_tma_malloc(tma, m * sizeof(pmix_qual_t));
             darray->size = m;
-            hv->qualindex = pmix_pointer_array2_add(proc_data->quals, darray);
+            hv->qualindex = pmix_pointer_array_add(proc_data->quals, darray);
             qarray = (pmix_qual_t*)darray->array;
             for (n=0, m=0; n < nquals; n++) {
                 if (PMIX_INFO_IS_QUALIFIER(&qualifiers[n])) {
@@ -269,10 +260,9 @@ pmix_status_t pmix_hash2_store(pmix_hash_table2_t *table,
                         PMIX_DSTOR_RELEASE(hv);
                         return PMIX_ERR_BAD_PARAM;
                     }
-                    qarray[n].index = p->index;
-                    // TODO(skg) We need to modify this.
-                    assert(false);
-                    PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&qarray[m].value, &qualifiers[n].value, PMIX_VALUE);
+                    qarray[m].index = p->index;
+                    PMIX_GDS_SHMEM_BFROPS_COPY_TMA(rc, &qarray[m].value, &qualifiers[n].value,
+                                                   PMIX_VALUE, tma);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
                         erase_qualifiers(proc_data, hv->qualindex);
@@ -307,11 +297,11 @@ pmix_status_t pmix_hash2_store(pmix_hash_table2_t *table,
                         kin->key, PMIx_Value_string(kin->value),
                         PMIX_RANK_PRINT(rank), (unsigned)m,
                         table->ht_label);
-    pmix_pointer_array2_add(proc_data->data, hv);
+    pmix_pointer_array_add(proc_data->data, hv);
     return PMIX_SUCCESS;
 }
 
-pmix_status_t pmix_hash2_fetch(pmix_hash_table2_t *table,
+pmix_status_t pmix_hash2_fetch(pmix_hash_table_t *table,
                               pmix_rank_t rank,
                               const char *key,
                               pmix_info_t *qualifiers, size_t nquals,
@@ -353,7 +343,7 @@ pmix_status_t pmix_hash2_fetch(pmix_hash_table2_t *table,
      *     PMIX_ERR_NOT_FOUND | PMIX_ERR_NOT_FOUND | PMIX_SUCCESS
      * special logic is basing on these statuses on a client and a server */
     if (PMIX_RANK_UNDEF == rank) {
-        rc = pmix_hash_table2_get_first_key_uint32(table, &id, (void **) &proc_data,
+        rc = pmix_hash_table_get_first_key_uint32(table, &id, (void **) &proc_data,
                                                   (void **) &node);
         if (PMIX_SUCCESS != rc) {
             pmix_output_verbose(10, pmix_globals.debug_output,
@@ -394,7 +384,7 @@ pmix_status_t pmix_hash2_fetch(pmix_hash_table2_t *table,
         if (NULL == key) {
             /* copy the data */
             for (n=0; n < proc_data->data->size; n++) {
-                hv = (pmix_dstor_t*)pmix_pointer_array2_get_item(proc_data->data, n);
+                hv = (pmix_dstor_t*)pmix_pointer_array_get_item(proc_data->data, n);
                 if (NULL != hv) {
                     p = pmix_hash2_lookup_key(hv->index, NULL);
                     if (NULL == p) {
@@ -414,19 +404,13 @@ pmix_status_t pmix_hash2_fetch(pmix_hash_table2_t *table,
                                             PMIX_NAME_PRINT(&pmix_globals.myid), p->name,
                                             (unsigned)hv->value->data.size, table->ht_label, PMIX_RANK_PRINT(rank));
                         /* this is a qualified value - need to return it as such */
-                        // TODO(skg) We need to modify this.
-                        assert(false);
                         PMIX_KVAL_NEW(kv, PMIX_QUALIFIED_VALUE);
-                        darray = (pmix_data_array_t*)pmix_pointer_array2_get_item(proc_data->quals, hv->qualindex);
+                        darray = (pmix_data_array_t*)pmix_pointer_array_get_item(proc_data->quals, hv->qualindex);
                         quals = (pmix_qual_t*)darray->array;
                         nq = darray->size;
-                        // TODO(skg) We need to modify this.
-                        assert(false);
                         PMIX_DATA_ARRAY_CREATE(darray, nq+1, PMIX_INFO);
                         iptr = (pmix_info_t*)darray->array;
                         /* the first location is the actual value */
-                        // TODO(skg) We need to modify this.
-                        assert(false);
                         PMIX_LOAD_KEY(&iptr[0].key, p->string);
                         PMIx_Value_xfer(&iptr[0].value, hv->value);
                         /* now add the qualifiers */
@@ -488,7 +472,7 @@ pmix_status_t pmix_hash2_fetch(pmix_hash_table2_t *table,
             }
         }
 
-        rc = pmix_hash_table2_get_next_key_uint32(table, &id, (void **) &proc_data, node,
+        rc = pmix_hash_table_get_next_key_uint32(table, &id, (void **) &proc_data, node,
                                                  (void **) &node);
         if (PMIX_SUCCESS != rc) {
             pmix_output_verbose(10, pmix_globals.debug_output,
@@ -501,7 +485,7 @@ pmix_status_t pmix_hash2_fetch(pmix_hash_table2_t *table,
     return rc;
 }
 
-pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
+pmix_status_t pmix_hash2_remove_data(pmix_hash_table_t *table,
                                     pmix_rank_t rank, const char *key)
 {
     pmix_status_t rc = PMIX_SUCCESS;
@@ -525,7 +509,7 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
     /* if the rank is wildcard, we want to apply this to
      * all rank entries */
     if (PMIX_RANK_WILDCARD == rank) {
-        rc = pmix_hash_table2_get_first_key_uint32(table, &id, (void **) &proc_data,
+        rc = pmix_hash_table_get_first_key_uint32(table, &id, (void **) &proc_data,
                                                   (void **) &node);
         while (PMIX_SUCCESS == rc) {
             if (NULL != proc_data) {
@@ -533,7 +517,7 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
                     PMIX_RELEASE(proc_data);
                 } else {
                     for (n=0; n < proc_data->data->size; n++) {
-                        d = (pmix_dstor_t*)pmix_pointer_array2_get_item(proc_data->data, n);
+                        d = (pmix_dstor_t*)pmix_pointer_array_get_item(proc_data->data, n);
                         if (NULL != d && kid == d->index) {
                             if (NULL != d->value) {
                                 PMIX_VALUE_RELEASE(d->value);
@@ -542,13 +526,13 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
                                 erase_qualifiers(proc_data, d->qualindex);
                             }
                             pmix_tma_free(tma, d);
-                            pmix_pointer_array2_set_item(proc_data->data, n, NULL);
+                            pmix_pointer_array_set_item(proc_data->data, n, NULL);
                             break;
                         }
                     }
                 }
             }
-            rc = pmix_hash_table2_get_next_key_uint32(table, &id, (void **) &proc_data, node,
+            rc = pmix_hash_table_get_next_key_uint32(table, &id, (void **) &proc_data, node,
                                                      (void **) &node);
         }
         return PMIX_SUCCESS;
@@ -563,7 +547,7 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
     /* if key is NULL, remove all data for this proc */
     if (NULL == key) {
         for (n=0; n < proc_data->data->size; n++) {
-            d = (pmix_dstor_t*)pmix_pointer_array2_get_item(proc_data->data, n);
+            d = (pmix_dstor_t*)pmix_pointer_array_get_item(proc_data->data, n);
             if (NULL != d) {
                 if (NULL != d->value) {
                     PMIX_VALUE_RELEASE(d->value);
@@ -572,11 +556,11 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
                     erase_qualifiers(proc_data, d->qualindex);
                 }
                 pmix_tma_free(tma, d);
-                pmix_pointer_array2_set_item(proc_data->data, n, NULL);
+                pmix_pointer_array_set_item(proc_data->data, n, NULL);
             }
         }
         /* remove the proc_data object itself from the jtable */
-        pmix_hash_table2_remove_value_uint32(table, rank);
+        pmix_hash_table_remove_value_uint32(table, rank);
         /* cleanup */
         PMIX_RELEASE(proc_data);
         return PMIX_SUCCESS;
@@ -584,7 +568,7 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
 
     /* remove this item */
     for (n=0; n < proc_data->data->size; n++) {
-        d = (pmix_dstor_t*)pmix_pointer_array2_get_item(proc_data->data, n);
+        d = (pmix_dstor_t*)pmix_pointer_array_get_item(proc_data->data, n);
         if (NULL != d && kid == d->index) {
             if (NULL != d->value) {
                 PMIX_VALUE_RELEASE(d->value);
@@ -593,7 +577,7 @@ pmix_status_t pmix_hash2_remove_data(pmix_hash_table2_t *table,
                 erase_qualifiers(proc_data, d->qualindex);
             }
             pmix_tma_free(tma, d);
-            pmix_pointer_array2_set_item(proc_data->data, n, NULL);
+            pmix_pointer_array_set_item(proc_data->data, n, NULL);
             break;
         }
     }
@@ -627,7 +611,7 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data2_t *proc_data, uint32_t kid,
     }
 
     for (n=0; n < proc_data->data->size; n++) {
-        d = (pmix_dstor_t*)pmix_pointer_array2_get_item(proc_data->data, n);
+        d = (pmix_dstor_t*)pmix_pointer_array_get_item(proc_data->data, n);
         if (NULL == d) {
             continue;
         }
@@ -636,7 +620,7 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data2_t *proc_data, uint32_t kid,
                 if (UINT32_MAX == d->qualindex) {
                     continue;
                 }
-                darray = (pmix_data_array_t*)pmix_pointer_array2_get_item(proc_data->quals, d->qualindex);
+                darray = (pmix_data_array_t*)pmix_pointer_array_get_item(proc_data->quals, d->qualindex);
                 qarray = (pmix_qual_t*)darray->array;
                 nfound = 0;
                 /* check the qualifiers */
@@ -684,24 +668,71 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data2_t *proc_data, uint32_t kid,
  * Find proc_data_t container associated with given
  * pmix_identifier_t.
  */
-static pmix_proc_data2_t *lookup_proc(pmix_hash_table2_t *jtable, uint32_t id, bool create)
+static pmix_proc_data2_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, bool create)
 {
     pmix_proc_data2_t *proc_data = NULL;
     pmix_tma_t *tma = pmix_obj_get_tma(&jtable->super);
 
-    pmix_hash_table2_get_value_uint32(jtable, id, (void **) &proc_data);
+    pmix_hash_table_get_value_uint32(jtable, id, (void **) &proc_data);
     if (NULL == proc_data && create) {
         /* The proc clearly exists, so create a data structure for it */
         proc_data = PMIX_NEW(pmix_proc_data2_t, tma);
         if (NULL == proc_data) {
             return NULL;
         }
-        pmix_hash_table2_set_value_uint32(jtable, id, proc_data);
+        pmix_hash_table_set_value_uint32(jtable, id, proc_data);
     }
 
     return proc_data;
 }
 
+void pmix_hash2_relocate(pmix_hash_table_t *table, ptrdiff_t delta)
+{
+    pmix_proc_data2_t *proc_data;
+    pmix_dstor_t *hv;
+    pmix_data_array_t *darray;
+    pmix_qual_t *quals;
+    uint32_t id;
+    void *node;
+    size_t nq;
+    int n, rc;
+
+    PMIX_TMA_RELOCATE(table->super.obj_tma.data_ptr, delta);
+    pmix_hash_table_relocate(table, delta);
+
+    rc = pmix_hash_table_get_first_key_uint32(table, &id, (void **) &proc_data, &node);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_TMA_RELOCATE(proc_data->super.obj_tma.data_ptr, delta);
+        PMIX_TMA_RELOCATE(proc_data->data, delta);
+        PMIX_TMA_RELOCATE(proc_data->quals, delta);
+        PMIX_TMA_RELOCATE(proc_data->data->super.obj_tma.data_ptr, delta);
+        PMIX_TMA_RELOCATE(proc_data->quals->super.obj_tma.data_ptr, delta);
+        pmix_pointer_array_relocate(proc_data->data, delta);
+        pmix_pointer_array_relocate(proc_data->quals, delta);
+
+        for (n = 0; n < proc_data->data->size; n++) {
+            hv = (pmix_dstor_t *) pmix_pointer_array_get_item(proc_data->data, n);
+            if (NULL != hv) {
+                PMIX_TMA_RELOCATE(hv->value, delta);
+                pmix_gds_shmem_relocate_value(hv->value, delta);
+            }
+        }
+        for (n = 0; n < proc_data->quals->size; n++) {
+            darray = (pmix_data_array_t *) pmix_pointer_array_get_item(proc_data->quals, n);
+            if (NULL == darray) {
+                continue;
+            }
+            PMIX_TMA_RELOCATE(darray->array, delta);
+            quals = (pmix_qual_t *) darray->array;
+            for (nq = 0; nq < darray->size; nq++) {
+                PMIX_TMA_RELOCATE(quals[nq].value, delta);
+                pmix_gds_shmem_relocate_value(quals[nq].value, delta);
+            }
+        }
+        rc = pmix_hash_table_get_next_key_uint32(table, &id, (void **) &proc_data, node, &node);
+    }
+}
+
 void pmix_hash2_register_key(uint32_t inid,
                             pmix_regattr_input_t *ptr)
 {
@@ -710,9 +741,9 @@ void pmix_hash2_register_key(uint32_t inid,
     if (UINT32_MAX == inid) {
         /* store the pointer in the array */
 #if 0 // TODO(skg) Remove
-        pmix_pointer_array2_set_item(&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
+        pmix_pointer_array_set_item(&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
 #else
-        pmix_pointer_array2_set_item((pmix_pointer_array2_t *)&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
+        pmix_pointer_array_set_item((pmix_pointer_array_t *)&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
 #endif
         ptr->index = pmix_globals.next_keyid;
         pmix_globals.next_keyid += 1;
@@ -721,9 +752,9 @@ void pmix_hash2_register_key(uint32_t inid,
 
     /* check to see if this key was already registered */
 #if 0 // TODO(skg) Remove
-    p = pmix_pointer_array2_get_item(&pmix_globals.keyindex, inid);
+    p = pmix_pointer_array_get_item(&pmix_globals.keyindex, inid);
 #else
-    p = pmix_pointer_array2_get_item((pmix_pointer_array2_t *)&pmix_globals.keyindex, inid);
+    p = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, inid);
 #endif
     if (NULL != p) {
         /* already have this one */
@@ -731,9 +762,9 @@ void pmix_hash2_register_key(uint32_t inid,
     }
     /* store the pointer in the table */
 #if 0 // TODO(skg) Remove
-    pmix_pointer_array2_set_item(&pmix_globals.keyindex, inid, ptr);
+    pmix_pointer_array_set_item(&pmix_globals.keyindex, inid, ptr);
 #else
-    pmix_pointer_array2_set_item((pmix_pointer_array2_t *)&pmix_globals.keyindex, inid, ptr);
+    pmix_pointer_array_set_item((pmix_pointer_array_t *)&pmix_globals.keyindex, inid, ptr);
 #endif
 }
 
@@ -754,9 +785,9 @@ pmix_regattr_input_t* pmix_hash2_lookup_key(uint32_t inid,
             /* reserved keys are in the front of the table */
             for (id = 0; id < PMIX_INDEX_BOUNDARY; id++) {
 #if 0 // TODO(skg) Remove
-                ptr = pmix_pointer_array2_get_item(&pmix_globals.keyindex, id);
+                ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
 #else
-                ptr = pmix_pointer_array2_get_item((pmix_pointer_array2_t *)&pmix_globals.keyindex, id);
+                ptr = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, id);
 #endif
                 if (NULL != ptr) {
                     if (0 == strcmp(key, ptr->string)) {
@@ -770,9 +801,9 @@ pmix_regattr_input_t* pmix_hash2_lookup_key(uint32_t inid,
         /* unreserved keys are at the back of the table */
         for (id = PMIX_INDEX_BOUNDARY; id < pmix_globals.keyindex.size; id++) {
 #if 0 // TODO(skg) Remove
-            ptr = pmix_pointer_array2_get_item(&pmix_globals.keyindex, id);
+            ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
 #else
-            ptr = pmix_pointer_array2_get_item((pmix_pointer_array2_t *)&pmix_globals.keyindex, id);
+            ptr = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, id);
 #endif
             if (NULL != ptr) {
                 if (0 == strcmp(key, ptr->string)) {
@@ -798,9 +829,9 @@ pmix_regattr_input_t* pmix_hash2_lookup_key(uint32_t inid,
      * would not have an index to pass us. Thus, the pointer is either
      * found or not - we don't register it if not found. */
 #if 0 // TODO(skg) Remove
-    ptr = pmix_pointer_array2_get_item(&pmix_globals.keyindex, inid);
+    ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, inid);
 #else
-    ptr = pmix_pointer_array2_get_item((pmix_pointer_array2_t *)&pmix_globals.keyindex, inid);
+    ptr = pmix_pointer_array_get_item((pmix_pointer_array_t *)&pmix_globals.keyindex, inid);
 #endif
     return ptr;
 }
@@ -813,17 +844,17 @@ static void erase_qualifiers(pmix_proc_data2_t *proc,
     size_t n;
     pmix_tma_t *tma = pmix_obj_get_tma(&proc->super);
 
-    darray = (pmix_data_array_t*)pmix_pointer_array2_get_item(proc->quals, index);
+    darray = (pmix_data_array_t*)pmix_pointer_array_get_item(proc->quals, index);
     if (NULL == darray || NULL == darray->array) {
         return;
     }
     qarray = (pmix_qual_t*)darray->array;
     for (n=0; n < darray->size; n++) {
         if (NULL != qarray[n].value) {
-            PMIX_VALUE_RELEASE(qarray[n].value);
+            pmix_tma_free(tma, qarray[n].value);
         }
     }
     pmix_tma_free(tma, qarray);
     pmix_tma_free(tma, darray);
-    pmix_pointer_array2_set_item(proc->quals, index, NULL);
+    pmix_pointer_array_set_item(proc->quals, index, NULL);
 }
@@ -19,11 +19,7 @@
 #include "src/include/pmix_config.h"
 
 #include "src/include/pmix_globals.h"
-#if 0 // TODO(skg)
 #include "src/class/pmix_hash_table.h"
-#else
-#include "pmix_hash_table2.h"
-#endif
 #include "src/mca/bfrops/bfrops_types.h"
 
 BEGIN_C_DECLS
@@ -33,7 +29,7 @@ BEGIN_C_DECLS
  */
 PMIX_EXPORT pmix_status_t
 pmix_hash2_store(
-    pmix_hash_table2_t *table,
+    pmix_hash_table_t *table,
     pmix_rank_t rank, pmix_kval_t *kin,
     pmix_info_t *qualifiers,
     size_t nquals
@@ -45,7 +41,7 @@ pmix_hash2_store(
  */
 PMIX_EXPORT pmix_status_t
 pmix_hash2_fetch(
-    pmix_hash_table2_t *table,
+    pmix_hash_table_t *table,
     pmix_rank_t rank,
     const char *key,
     pmix_info_t *qualifiers,
@@ -63,11 +59,22 @@ pmix_hash2_fetch(
  */
 PMIX_EXPORT pmix_status_t
 pmix_hash2_remove_data(
-    pmix_hash_table2_t *table,
+    pmix_hash_table_t *table,
     pmix_rank_t rank,
     const char *key
 );
 
+/**
+ * Moves every pointer held by the given table and the data stored in it by
+ * delta bytes. For a table built with a TMA whose region has since been mapped
+ * delta bytes away from where the table was built.
+ */
+PMIX_EXPORT void
+pmix_hash2_relocate(
+    pmix_hash_table_t *table,
+    ptrdiff_t delta
+);
+
 PMIX_EXPORT void
 pmix_hash2_register_key(
     uint32_t inid,
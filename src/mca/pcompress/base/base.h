@@ -32,7 +32,11 @@ extern "C" {
  * compression limit */
 #define PMIX_STRING_SIZE_CHECK(s)                         \
     (PMIX_STRING == (s)->type && NULL != (s)->data.string \
-     && pmix_compress_base.compress_limit < strlen((s)->data.string))
+     && pmix_compress_base.string_limit < strlen((s)->data.string))
+
+/* size of the chunks handed to the callback when a string
+ * is decompressed incrementally */
+#define PMIX_COMPRESS_BASE_STREAM_CHUNK 16384
 
 #define PMIX_VALUE_COMPRESSED_STRING_UNPACK(s)                                    \
     do {                                                                          \
@@ -56,6 +60,12 @@ extern "C" {
 
 typedef struct {
     size_t compress_limit;
+    /* per-payload thresholds - strings are things like
+     * regular expressions and large PMIx_Put values, blocks
+     * are modex blobs and other PMIx_Data_compress payloads.
+     * Both default to compress_limit */
+    size_t string_limit;
+    size_t block_limit;
     bool selected;
     bool silent;
 } pmix_compress_base_t;
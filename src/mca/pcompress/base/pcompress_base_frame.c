@@ -75,6 +75,8 @@ pmix_compress_base_module_t pmix_compress = {.compress = compress_block,
                                              .decompress_string = decompress_string};
 pmix_compress_base_t pmix_compress_base = {
     .compress_limit = 0,
+    .string_limit = 0,
+    .block_limit = 0,
     .selected = false,
     .silent = false
 };
@@ -88,6 +90,20 @@ static int pmix_compress_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
                                       &pmix_compress_base.compress_limit);
 
+    pmix_compress_base.string_limit = 0;
+    (void) pmix_mca_base_var_register("pmix", "pcompress", "base", "string_limit",
+                                      "Threshold beyond which strings (e.g., regular expressions) "
+                                      "will be compressed (0 => use pcompress_base_limit)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_compress_base.string_limit);
+
+    pmix_compress_base.block_limit = 0;
+    (void) pmix_mca_base_var_register("pmix", "pcompress", "base", "block_limit",
+                                      "Threshold beyond which data blocks (e.g., modex blobs) "
+                                      "will be compressed (0 => use pcompress_base_limit)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_compress_base.block_limit);
+
     pmix_compress_base.silent = false;
     (void) pmix_mca_base_var_register("pmix", "pcompress", "base", "silence_warning",
                                       "Do not warn if compression unavailable",
@@ -102,6 +118,13 @@ static int pmix_compress_base_register(pmix_mca_base_register_flag_t flags)
  */
 static int pmix_compress_base_open(pmix_mca_base_open_flag_t flags)
 {
+    if (0 == pmix_compress_base.string_limit) {
+        pmix_compress_base.string_limit = pmix_compress_base.compress_limit;
+    }
+    if (0 == pmix_compress_base.block_limit) {
+        pmix_compress_base.block_limit = pmix_compress_base.compress_limit;
+    }
+
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_pcompress_base_framework, flags);
 }
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "pmix_config.h"
+
+#include <string.h>
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include "src/include/pmix_stdint.h"
+#include "src/util/pmix_output.h"
+
+#include "pmix_common.h"
+
+#include "src/mca/pcompress/base/base.h"
+
+#include "compress_lz4.h"
+
+static bool lz4_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen);
+
+static bool lz4_decompress(uint8_t **outbytes, size_t *outlen, const uint8_t *inbytes, size_t inlen);
+
+static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes);
+
+static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len);
+
+pmix_compress_base_module_t pmix_pcompress_lz4_module = {
+    .compress = lz4_compress,
+    .decompress = lz4_decompress,
+    .compress_string = compress_string,
+    .decompress_string = decompress_string,
+};
+
+/* as with zlib, the output carries the uncompressed size in its
+ * first 4 bytes so the decompress side can size its buffer */
+static bool do_compress(const uint8_t *inbytes, size_t inlen, size_t limit, int level,
+                        uint8_t **outbytes, size_t *outlen)
+{
+    int len, clen;
+    uint8_t *ptr;
+    uint32_t len2;
+
+    /* set default output */
+    *outbytes = NULL;
+    *outlen = 0;
+
+    if (inlen < limit || inlen > LZ4_MAX_INPUT_SIZE) {
+        return false;
+    }
+    len2 = inlen;
+
+    len = LZ4_compressBound((int) inlen);
+    if (NULL == (ptr = (uint8_t *) malloc(len + sizeof(uint32_t)))) {
+        return false;
+    }
+
+    if (0 < level) {
+        clen = LZ4_compress_HC((const char *) inbytes, (char *) ptr + sizeof(uint32_t),
+                               (int) inlen, len, level);
+    } else {
+        clen = LZ4_compress_default((const char *) inbytes, (char *) ptr + sizeof(uint32_t),
+                                    (int) inlen, len);
+    }
+    /* if this didn't result in a smaller footprint,
+     * then don't use it */
+    if (0 >= clen || clen + sizeof(uint32_t) >= inlen) {
+        free(ptr);
+        return false;
+    }
+
+    /* fold the uncompressed length into the buffer */
+    memcpy(ptr, &len2, sizeof(uint32_t));
+    *outbytes = ptr;
+    *outlen = clen + sizeof(uint32_t);
+
+    pmix_output_verbose(2, pmix_pcompress_base_framework.framework_output,
+                        "COMPRESS INPUT BLOCK OF LEN %" PRIsize_t " OUTPUT SIZE %d",
+                        inlen, clen);
+    return true; // we did the compression
+}
+
+static bool lz4_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen)
+{
+    return do_compress(inbytes, inlen, pmix_compress_base.block_limit,
+                       pmix_pcompress_lz4_block_level, outbytes, outlen);
+}
+
+static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes)
+{
+    return do_compress((uint8_t *) instring, strlen(instring), pmix_compress_base.string_limit,
+                       pmix_pcompress_lz4_string_level, outbytes, nbytes);
+}
+
+/* decompress into a buffer of len2 bytes, of which the
+ * first outlen must be filled by the payload */
+static bool doit(uint8_t **outbytes, size_t len2, size_t outlen,
+                 const uint8_t *inbytes, size_t inlen)
+{
+    uint8_t *dest;
+    int rc;
+
+    /* set the default error answer */
+    *outbytes = NULL;
+
+    if (inlen < sizeof(uint32_t) || outlen > LZ4_MAX_INPUT_SIZE) {
+        return false;
+    }
+
+    dest = (uint8_t *) malloc(len2);
+    if (NULL == dest) {
+        return false;
+    }
+
+    rc = LZ4_decompress_safe((const char *) inbytes + sizeof(uint32_t), (char *) dest,
+                             (int) (inlen - sizeof(uint32_t)), (int) outlen);
+    if (rc < 0 || (size_t) rc != outlen) {
+        free(dest);
+        return false;
+    }
+    *outbytes = dest;
+    return true;
+}
+
+static bool lz4_decompress(uint8_t **outbytes, size_t *outlen, const uint8_t *inbytes, size_t inlen)
+{
+    uint32_t len2;
+
+    /* set the default error answer */
+    *outlen = 0;
+
+    /* the first 4 bytes contains the uncompressed size */
+    memcpy(&len2, inbytes, sizeof(uint32_t));
+
+    pmix_output_verbose(2, pmix_pcompress_base_framework.framework_output,
+                        "DECOMPRESSING INPUT OF LEN %" PRIsize_t " OUTPUT %u", inlen, len2);
+
+    if (doit(outbytes, len2, len2, inbytes, inlen)) {
+        *outlen = len2;
+        return true;
+    }
+    return false;
+}
+
+static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len)
+{
+    uint32_t len2;
+
+    /* the first 4 bytes contains the uncompressed size */
+    memcpy(&len2, inbytes, sizeof(uint32_t));
+    if (len2 == UINT32_MAX) {
+        /* set the default error answer */
+        *outstring = NULL;
+        return false;
+    }
+
+    /* add one to hold the NUL terminator */
+    if (doit((uint8_t **) outstring, len2 + 1, len2, inbytes, len)) {
+        (*outstring)[len2] = '\0';
+        return true;
+    }
+
+    /* set the default error answer */
+    *outstring = NULL;
+    return false;
+}
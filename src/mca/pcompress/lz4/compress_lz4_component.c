@@ -0,0 +1,87 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "pmix_config.h"
+
+#include "compress_lz4.h"
+#include "pmix_common.h"
+#include "src/mca/pcompress/base/base.h"
+
+/*
+ * Public string for version number
+ */
+const char *pmix_compress_lz4_component_version_string
+    = "PMIX COMPRESS lz4 MCA component version " PMIX_VERSION;
+
+/*
+ * Local functionality
+ */
+static int compress_lz4_register(void);
+static int compress_lz4_query(pmix_mca_base_module_t **module, int *priority);
+
+int pmix_pcompress_lz4_priority = 30;
+int pmix_pcompress_lz4_string_level = 0;
+int pmix_pcompress_lz4_block_level = 0;
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointer to our public functions in it
+ */
+PMIX_EXPORT pmix_mca_base_component_t pmix_mca_pcompress_lz4_component = {
+    /* Handle the general mca_component_t struct containing
+     *  meta information about the component lz4
+     */
+    PMIX_COMPRESS_BASE_VERSION_2_0_0,
+
+    /* Component name and version */
+    .pmix_mca_component_name = "lz4",
+    PMIX_MCA_BASE_MAKE_VERSION(component, PMIX_MAJOR_VERSION, PMIX_MINOR_VERSION,
+                               PMIX_RELEASE_VERSION),
+
+    /* Component open and close functions */
+    .pmix_mca_query_component = compress_lz4_query,
+    .pmix_mca_register_component_params = compress_lz4_register
+};
+
+static int compress_lz4_register(void)
+{
+    pmix_pcompress_lz4_priority = 30;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_lz4_component,
+                                                "priority",
+                                                "Priority of the lz4 pcompress component. All "
+                                                "processes in a job must select the same component",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_lz4_priority);
+
+    pmix_pcompress_lz4_string_level = 0;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_lz4_component,
+                                                "string_level",
+                                                "LZ4HC compression level (1-12) used for strings "
+                                                "(0 => use the fast LZ4 compressor)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_lz4_string_level);
+
+    pmix_pcompress_lz4_block_level = 0;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_lz4_component,
+                                                "block_level",
+                                                "LZ4HC compression level (1-12) used for data blocks "
+                                                "(0 => use the fast LZ4 compressor)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_lz4_block_level);
+    return PMIX_SUCCESS;
+}
+
+static int compress_lz4_query(pmix_mca_base_module_t **module, int *priority)
+{
+    *module = (pmix_mca_base_module_t *) &pmix_pcompress_lz4_module;
+    *priority = pmix_pcompress_lz4_priority;
+
+    return PMIX_SUCCESS;
+}
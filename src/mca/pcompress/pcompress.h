@@ -63,6 +63,19 @@ typedef bool (*pmix_compress_base_module_compress_string_fn_t)(char *instring, u
 typedef bool (*pmix_compress_base_module_decompress_string_fn_t)(char **outstring, uint8_t *inbytes,
                                                                  size_t len);
 
+/**
+ * Decompress a string a chunk at a time
+ *
+ * Each chunk of the decompressed string is passed to the callback in
+ * order. Chunks are not NUL-terminated and are only valid for the
+ * duration of the callback, which returns false to stop the
+ * decompression. Components that cannot decompress incrementally
+ * leave this function NULL
+ */
+typedef bool (*pmix_compress_base_stream_cbfunc_t)(const char *chunk, size_t len, void *cbdata);
+typedef bool (*pmix_compress_base_module_decompress_string_stream_fn_t)(
+    const uint8_t *inbytes, size_t len, pmix_compress_base_stream_cbfunc_t cbfunc, void *cbdata);
+
 /**
  * Compress a block
  *
@@ -98,6 +111,7 @@ struct pmix_compress_base_module_1_0_0_t {
     /* COMPRESS STRING */
     pmix_compress_base_module_compress_string_fn_t compress_string;
     pmix_compress_base_module_decompress_string_fn_t decompress_string;
+    pmix_compress_base_module_decompress_string_stream_fn_t decompress_string_stream;
 };
 typedef struct pmix_compress_base_module_1_0_0_t pmix_compress_base_module_1_0_0_t;
 typedef struct pmix_compress_base_module_1_0_0_t pmix_compress_base_module_t;
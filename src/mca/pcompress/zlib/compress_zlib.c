@@ -48,14 +48,19 @@ static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes);
 
 static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len);
 
+static bool decompress_string_stream(const uint8_t *inbytes, size_t len,
+                                     pmix_compress_base_stream_cbfunc_t cbfunc, void *cbdata);
+
 pmix_compress_base_module_t pmix_pcompress_zlib_module = {
     .compress = zlib_compress,
     .decompress = zlib_decompress,
     .compress_string = compress_string,
     .decompress_string = decompress_string,
+    .decompress_string_stream = decompress_string_stream,
 };
 
-static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen)
+static bool do_compress(const uint8_t *inbytes, size_t inlen, size_t limit, int level,
+                        uint8_t **outbytes, size_t *outlen)
 {
     z_stream strm;
     size_t len, len2;
@@ -67,14 +72,14 @@ static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbyt
     *outbytes = NULL;
     *outlen = 0;
 
-    if (inlen < pmix_compress_base.compress_limit || inlen >= UINT32_MAX) {
+    if (inlen < limit || inlen >= UINT32_MAX) {
         return false;
     }
     len3 = inlen;
 
     /* setup the stream */
     memset(&strm, 0, sizeof(strm));
-    if (Z_OK != deflateInit(&strm, 9)) {
+    if (Z_OK != deflateInit(&strm, level)) {
         return false;
     }
 
@@ -130,6 +135,12 @@ static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbyt
     return true; // we did the compression
 }
 
+static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen)
+{
+    return do_compress(inbytes, inlen, pmix_compress_base.block_limit,
+                       pmix_pcompress_zlib_block_level, outbytes, outlen);
+}
+
 static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes)
 {
     uint32_t inlen;
@@ -138,7 +149,8 @@ static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes)
     inlen = strlen(instring);
 
     /* compress the string */
-    return zlib_compress((uint8_t *) instring, inlen, outbytes, nbytes);
+    return do_compress((uint8_t *) instring, inlen, pmix_compress_base.string_limit,
+                       pmix_pcompress_zlib_string_level, outbytes, nbytes);
 }
 
 static bool doit(uint8_t **outbytes, size_t len2, const uint8_t *inbytes, size_t inlen)
@@ -222,7 +234,7 @@ static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len)
 
     if (rc) {
         /* ensure this is NUL terminated! */
-        *outstring[len2 - 1] = '\0';
+        (*outstring)[len2 - 1] = '\0';
         return true;
     }
 
@@ -230,3 +242,41 @@ static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len)
     *outstring = NULL;
     return false;
 }
+
+static bool decompress_string_stream(const uint8_t *inbytes, size_t len,
+                                     pmix_compress_base_stream_cbfunc_t cbfunc, void *cbdata)
+{
+    uint8_t chunk[PMIX_COMPRESS_BASE_STREAM_CHUNK];
+    z_stream strm;
+    int rc;
+
+    if (len <= sizeof(uint32_t)) {
+        return false;
+    }
+
+    memset(&strm, 0, sizeof(strm));
+    if (Z_OK != inflateInit(&strm)) {
+        return false;
+    }
+    /* step over the size - we don't need it as we never
+     * hold the full string */
+    strm.avail_in = len - sizeof(uint32_t);
+    strm.next_in = (uint8_t *) (inbytes + sizeof(uint32_t));
+
+    do {
+        strm.avail_out = sizeof(chunk);
+        strm.next_out = chunk;
+        rc = inflate(&strm, Z_NO_FLUSH);
+        if (Z_OK != rc && Z_STREAM_END != rc) {
+            break;
+        }
+        if (strm.next_out != chunk
+            && !cbfunc((char *) chunk, strm.next_out - chunk, cbdata)) {
+            rc = Z_DATA_ERROR;
+            break;
+        }
+    } while (Z_STREAM_END != rc);
+
+    inflateEnd(&strm);
+    return (Z_STREAM_END == rc);
+}
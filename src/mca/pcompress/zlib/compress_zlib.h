@@ -36,6 +36,10 @@ extern "C" {
 PMIX_EXPORT extern pmix_mca_base_component_t pmix_mca_pcompress_zlib_component;
 extern pmix_compress_base_module_t pmix_pcompress_zlib_module;
 
+/* compression levels for each payload class */
+extern int pmix_pcompress_zlib_string_level;
+extern int pmix_pcompress_zlib_block_level;
+
 #if defined(c_plusplus) || defined(__cplusplus)
 }
 #endif
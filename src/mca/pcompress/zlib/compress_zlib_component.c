@@ -28,8 +28,12 @@ const char *pmix_compress_zlib_component_version_string
 /*
  * Local functionality
  */
+static int compress_zlib_register(void);
 static int compress_zlib_query(pmix_mca_base_module_t **module, int *priority);
 
+int pmix_pcompress_zlib_string_level = 9;
+int pmix_pcompress_zlib_block_level = 9;
+
 /*
  * Instantiate the public struct with all of our public information
  * and pointer to our public functions in it
@@ -46,9 +50,28 @@ PMIX_EXPORT pmix_mca_base_component_t pmix_mca_pcompress_zlib_component = {
                                PMIX_RELEASE_VERSION),
 
     /* Component open and close functions */
-    .pmix_mca_query_component = compress_zlib_query
+    .pmix_mca_query_component = compress_zlib_query,
+    .pmix_mca_register_component_params = compress_zlib_register
 };
 
+static int compress_zlib_register(void)
+{
+    pmix_pcompress_zlib_string_level = 9;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_zlib_component,
+                                                "string_level",
+                                                "Compression level (1-9) used for strings",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_zlib_string_level);
+
+    pmix_pcompress_zlib_block_level = 9;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_zlib_component,
+                                                "block_level",
+                                                "Compression level (1-9) used for data blocks",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_zlib_block_level);
+    return PMIX_SUCCESS;
+}
+
 static int compress_zlib_query(pmix_mca_base_module_t **module, int *priority)
 {
     *module = (pmix_mca_base_module_t *) &pmix_pcompress_zlib_module;
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "pmix_config.h"
+
+#include <string.h>
+#include <zstd.h>
+
+#include "src/include/pmix_stdint.h"
+#include "src/util/pmix_output.h"
+
+#include "pmix_common.h"
+
+#include "src/mca/pcompress/base/base.h"
+
+#include "compress_zstd.h"
+
+static bool zstd_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen);
+
+static bool zstd_decompress(uint8_t **outbytes, size_t *outlen, const uint8_t *inbytes, size_t inlen);
+
+static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes);
+
+static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len);
+
+static bool decompress_string_stream(const uint8_t *inbytes, size_t len,
+                                     pmix_compress_base_stream_cbfunc_t cbfunc, void *cbdata);
+
+pmix_compress_base_module_t pmix_pcompress_zstd_module = {
+    .compress = zstd_compress,
+    .decompress = zstd_decompress,
+    .compress_string = compress_string,
+    .decompress_string = decompress_string,
+    .decompress_string_stream = decompress_string_stream,
+};
+
+/* as with zlib, the output carries the uncompressed size in its
+ * first 4 bytes so the decompress side can size its buffer */
+static bool do_compress(const uint8_t *inbytes, size_t inlen, size_t limit, int level,
+                        uint8_t **outbytes, size_t *outlen)
+{
+    size_t len, clen;
+    uint8_t *ptr;
+    uint32_t len2;
+
+    /* set default output */
+    *outbytes = NULL;
+    *outlen = 0;
+
+    if (inlen < limit || inlen >= UINT32_MAX) {
+        return false;
+    }
+    len2 = inlen;
+
+    len = ZSTD_compressBound(inlen) + sizeof(uint32_t);
+    if (NULL == (ptr = (uint8_t *) malloc(len))) {
+        return false;
+    }
+
+    clen = ZSTD_compress(ptr + sizeof(uint32_t), len - sizeof(uint32_t), inbytes, inlen, level);
+    /* if this didn't result in a smaller footprint,
+     * then don't use it */
+    if (ZSTD_isError(clen) || clen + sizeof(uint32_t) >= inlen) {
+        free(ptr);
+        return false;
+    }
+
+    /* fold the uncompressed length into the buffer */
+    memcpy(ptr, &len2, sizeof(uint32_t));
+    *outbytes = ptr;
+    *outlen = clen + sizeof(uint32_t);
+
+    pmix_output_verbose(2, pmix_pcompress_base_framework.framework_output,
+                        "COMPRESS INPUT BLOCK OF LEN %" PRIsize_t " OUTPUT SIZE %" PRIsize_t "",
+                        inlen, clen);
+    return true; // we did the compression
+}
+
+static bool zstd_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen)
+{
+    return do_compress(inbytes, inlen, pmix_compress_base.block_limit,
+                       pmix_pcompress_zstd_block_level, outbytes, outlen);
+}
+
+static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes)
+{
+    return do_compress((uint8_t *) instring, strlen(instring), pmix_compress_base.string_limit,
+                       pmix_pcompress_zstd_string_level, outbytes, nbytes);
+}
+
+/* decompress into a buffer of len2 bytes, of which the
+ * first outlen must be filled by the payload */
+static bool doit(uint8_t **outbytes, size_t len2, size_t outlen,
+                 const uint8_t *inbytes, size_t inlen)
+{
+    uint8_t *dest;
+    size_t rc;
+
+    /* set the default error answer */
+    *outbytes = NULL;
+
+    if (inlen < sizeof(uint32_t)) {
+        return false;
+    }
+
+    dest = (uint8_t *) malloc(len2);
+    if (NULL == dest) {
+        return false;
+    }
+
+    rc = ZSTD_decompress(dest, outlen, inbytes + sizeof(uint32_t), inlen - sizeof(uint32_t));
+    if (ZSTD_isError(rc) || rc != outlen) {
+        free(dest);
+        return false;
+    }
+    *outbytes = dest;
+    return true;
+}
+
+static bool zstd_decompress(uint8_t **outbytes, size_t *outlen, const uint8_t *inbytes, size_t inlen)
+{
+    uint32_t len2;
+
+    /* set the default error answer */
+    *outlen = 0;
+
+    /* the first 4 bytes contains the uncompressed size */
+    memcpy(&len2, inbytes, sizeof(uint32_t));
+
+    pmix_output_verbose(2, pmix_pcompress_base_framework.framework_output,
+                        "DECOMPRESSING INPUT OF LEN %" PRIsize_t " OUTPUT %u", inlen, len2);
+
+    if (doit(outbytes, len2, len2, inbytes, inlen)) {
+        *outlen = len2;
+        return true;
+    }
+    return false;
+}
+
+static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len)
+{
+    uint32_t len2;
+
+    /* the first 4 bytes contains the uncompressed size */
+    memcpy(&len2, inbytes, sizeof(uint32_t));
+    if (len2 == UINT32_MAX) {
+        /* set the default error answer */
+        *outstring = NULL;
+        return false;
+    }
+
+    /* add one to hold the NUL terminator */
+    if (doit((uint8_t **) outstring, len2 + 1, len2, inbytes, len)) {
+        (*outstring)[len2] = '\0';
+        return true;
+    }
+
+    /* set the default error answer */
+    *outstring = NULL;
+    return false;
+}
+
+static bool decompress_string_stream(const uint8_t *inbytes, size_t len,
+                                     pmix_compress_base_stream_cbfunc_t cbfunc, void *cbdata)
+{
+    char chunk[PMIX_COMPRESS_BASE_STREAM_CHUNK];
+    ZSTD_DStream *strm;
+    ZSTD_inBuffer in;
+    ZSTD_outBuffer out;
+    size_t rc = 1;
+    bool ret = false;
+
+    if (len <= sizeof(uint32_t)) {
+        return false;
+    }
+
+    strm = ZSTD_createDStream();
+    if (NULL == strm) {
+        return false;
+    }
+    in.src = inbytes + sizeof(uint32_t);
+    in.size = len - sizeof(uint32_t);
+    in.pos = 0;
+
+    /* a return of zero indicates the frame is complete */
+    while (0 != rc) {
+        out.dst = chunk;
+        out.size = sizeof(chunk);
+        out.pos = 0;
+        rc = ZSTD_decompressStream(strm, &out, &in);
+        if (ZSTD_isError(rc)) {
+            goto done;
+        }
+        if (0 < out.pos && !cbfunc(chunk, out.pos, cbdata)) {
+            goto done;
+        }
+        if (0 != rc && in.pos == in.size && out.pos < out.size) {
+            /* truncated input */
+            goto done;
+        }
+    }
+    ret = true;
+
+done:
+    ZSTD_freeDStream(strm);
+    return ret;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * ZSTD COMPRESS component
+ *
+ * Uses the zstd library
+ */
+
+#ifndef MCA_COMPRESS_ZSTD_EXPORT_H
+#define MCA_COMPRESS_ZSTD_EXPORT_H
+
+#include "pmix_config.h"
+
+#include "src/util/pmix_output.h"
+
+#include "src/mca/mca.h"
+#include "src/mca/pcompress/pcompress.h"
+
+#if defined(c_plusplus) || defined(__cplusplus)
+extern "C" {
+#endif
+
+/* the component must be visible data for the linker to find it */
+PMIX_EXPORT extern pmix_mca_base_component_t pmix_mca_pcompress_zstd_component;
+extern pmix_compress_base_module_t pmix_pcompress_zstd_module;
+
+/* selection priority and the compression levels
+ * for each payload class */
+extern int pmix_pcompress_zstd_priority;
+extern int pmix_pcompress_zstd_string_level;
+extern int pmix_pcompress_zstd_block_level;
+
+#if defined(c_plusplus) || defined(__cplusplus)
+}
+#endif
+
+#endif /* MCA_COMPRESS_ZSTD_EXPORT_H */
@@ -0,0 +1,88 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "pmix_config.h"
+
+#include "compress_zstd.h"
+#include "pmix_common.h"
+#include "src/mca/pcompress/base/base.h"
+
+/*
+ * Public string for version number
+ */
+const char *pmix_compress_zstd_component_version_string
+    = "PMIX COMPRESS zstd MCA component version " PMIX_VERSION;
+
+/*
+ * Local functionality
+ */
+static int compress_zstd_register(void);
+static int compress_zstd_query(pmix_mca_base_module_t **module, int *priority);
+
+int pmix_pcompress_zstd_priority = 40;
+int pmix_pcompress_zstd_string_level = 3;
+int pmix_pcompress_zstd_block_level = 1;
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointer to our public functions in it
+ */
+PMIX_EXPORT pmix_mca_base_component_t pmix_mca_pcompress_zstd_component = {
+    /* Handle the general mca_component_t struct containing
+     *  meta information about the component zstd
+     */
+    PMIX_COMPRESS_BASE_VERSION_2_0_0,
+
+    /* Component name and version */
+    .pmix_mca_component_name = "zstd",
+    PMIX_MCA_BASE_MAKE_VERSION(component, PMIX_MAJOR_VERSION, PMIX_MINOR_VERSION,
+                               PMIX_RELEASE_VERSION),
+
+    /* Component open and close functions */
+    .pmix_mca_query_component = compress_zstd_query,
+    .pmix_mca_register_component_params = compress_zstd_register
+};
+
+static int compress_zstd_register(void)
+{
+    pmix_pcompress_zstd_priority = 40;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_zstd_component,
+                                                "priority",
+                                                "Priority of the zstd pcompress component. All "
+                                                "processes in a job must select the same component",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_zstd_priority);
+
+    /* strings are generally compressed once and sent many
+     * times, so they can afford more effort than blocks */
+    pmix_pcompress_zstd_string_level = 3;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_zstd_component,
+                                                "string_level",
+                                                "Compression level (1-22) used for strings",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_zstd_string_level);
+
+    /* blocks can be many MB and are on the launch path, so favor speed */
+    pmix_pcompress_zstd_block_level = 1;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_pcompress_zstd_component,
+                                                "block_level",
+                                                "Compression level (1-22) used for data blocks",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_pcompress_zstd_block_level);
+    return PMIX_SUCCESS;
+}
+
+static int compress_zstd_query(pmix_mca_base_module_t **module, int *priority)
+{
+    *module = (pmix_mca_base_module_t *) &pmix_pcompress_zstd_module;
+    *priority = pmix_pcompress_zstd_priority;
+
+    return PMIX_SUCCESS;
+}
@@ -64,6 +64,9 @@ typedef struct {
     bool completed;
     int exitcode;
     int keepalive[2];
+    /* read end of the pipe reporting a failed exec while
+     * the launch has not yet been confirmed */
+    int launch_pipe;
     pmix_pfexec_base_io_conf_t opts;
     pmix_iof_sink_t stdinsink;
     pmix_iof_read_event_t *stdoutev;
@@ -82,10 +85,16 @@ typedef struct {
 
 PMIX_EXPORT extern pmix_pfexec_globals_t pmix_pfexec_globals;
 
-/* define a function that will fork/exec a local proc */
+/* define a function that will fork/exec a local proc - it may return
+ * PMIX_OPERATION_IN_PROGRESS to indicate that the launch is to be
+ * confirmed later by the complete function */
 typedef pmix_status_t (*pmix_pfexec_base_fork_proc_fn_t)(pmix_app_t *app,
                                                          pmix_pfexec_child_t *child, char **env);
 
+/* define a function that will wait for the launch of a local proc */
+typedef pmix_status_t (*pmix_pfexec_base_complete_proc_fn_t)(pmix_app_t *app,
+                                                             pmix_pfexec_child_t *child);
+
 /* define a function type for signaling a local proc */
 typedef pmix_status_t (*pmix_pfexec_base_signal_local_fn_t)(pid_t pd, int signum);
 
@@ -97,6 +106,9 @@ typedef struct {
     const pmix_app_t *apps;
     size_t napps;
     pmix_pfexec_base_fork_proc_fn_t frkfn;
+    pmix_pfexec_base_complete_proc_fn_t cmpfn;
+    /* max number of launches left to be confirmed at a time */
+    size_t batch;
     pmix_spawn_cbfunc_t cbfunc;
     void *cbdata;
 } pmix_pfexec_fork_caddy_t;
@@ -106,6 +118,7 @@ typedef struct {
     pmix_object_t super;
     pmix_event_t ev;
     pmix_proc_t *proc;
+    size_t nprocs;
     int signal;
     pmix_pfexec_base_signal_local_fn_t sigfn;
     pmix_lock_t *lock;
@@ -118,6 +131,10 @@ PMIX_EXPORT void pmix_pfexec_base_kill_proc(int sd, short args, void *cbdata);
 
 PMIX_EXPORT void pmix_pfexec_base_signal_proc(int sd, short args, void *cbdata);
 
+PMIX_EXPORT void pmix_pfexec_base_kill_procs(int sd, short args, void *cbdata);
+
+PMIX_EXPORT void pmix_pfexec_base_signal_procs(int sd, short args, void *cbdata);
+
 PMIX_EXPORT void pmix_pfexec_check_complete(int sd, short args, void *cbdata);
 
 #define PMIX_PFEXEC_SPAWN(j, nj, a, na, fn, cbf, cbd)                    \
@@ -137,6 +154,25 @@ PMIX_EXPORT void pmix_pfexec_check_complete(int sd, short args, void *cbdata);
         pmix_event_active(&((fcd)->ev), EV_WRITE, 1);                    \
     } while (0)
 
+#define PMIX_PFEXEC_SPAWN_BATCH(j, nj, a, na, fn, cfn, bt, cbf, cbd)     \
+    do {                                                                 \
+        pmix_pfexec_fork_caddy_t *fcd;                                   \
+        fcd = PMIX_NEW(pmix_pfexec_fork_caddy_t);                        \
+        fcd->jobinfo = (j);                                              \
+        fcd->njinfo = (nj);                                              \
+        fcd->apps = (a);                                                 \
+        fcd->napps = (na);                                               \
+        fcd->frkfn = (fn);                                               \
+        fcd->cmpfn = (cfn);                                              \
+        fcd->batch = (bt);                                               \
+        fcd->cbfunc = (cbf);                                             \
+        fcd->cbdata = (cbd);                                             \
+        pmix_event_assign(&(fcd->ev), pmix_globals.evbase, -1, EV_WRITE, \
+                          pmix_pfexec_base_spawn_proc, fcd);             \
+        PMIX_POST_OBJECT((fcd));                                         \
+        pmix_event_active(&((fcd)->ev), EV_WRITE, 1);                    \
+    } while (0)
+
 #define PMIX_PFEXEC_KILL(scd, r, fn, lk)                                   \
     do {                                                                   \
         (scd) = PMIX_NEW(pmix_pfexec_signal_caddy_t);                      \
@@ -162,6 +198,33 @@ PMIX_EXPORT void pmix_pfexec_check_complete(int sd, short args, void *cbdata);
         pmix_event_active(&((scd)->ev), EV_WRITE, 1);                      \
     } while (0)
 
+#define PMIX_PFEXEC_KILL_PROCS(scd, r, nr, fn, lk)                         \
+    do {                                                                   \
+        (scd) = PMIX_NEW(pmix_pfexec_signal_caddy_t);                      \
+        (scd)->proc = (r);                                                 \
+        (scd)->nprocs = (nr);                                              \
+        (scd)->sigfn = (fn);                                               \
+        (scd)->lock = (lk);                                                \
+        pmix_event_assign(&((scd)->ev), pmix_globals.evbase, -1, EV_WRITE, \
+                          pmix_pfexec_base_kill_procs, (scd));             \
+        PMIX_POST_OBJECT((scd));                                           \
+        pmix_event_active(&((scd)->ev), EV_WRITE, 1);                      \
+    } while (0)
+
+#define PMIX_PFEXEC_SIGNAL_PROCS(scd, r, nr, nm, fn, lk)                   \
+    do {                                                                   \
+        (scd) = PMIX_NEW(pmix_pfexec_signal_caddy_t);                      \
+        (scd)->proc = (r);                                                 \
+        (scd)->nprocs = (nr);                                              \
+        (scd)->signal = (nm);                                              \
+        (scd)->sigfn = (fn);                                               \
+        (scd)->lock = (lk);                                                \
+        pmix_event_assign(&((scd)->ev), pmix_globals.evbase, -1, EV_WRITE, \
+                          pmix_pfexec_base_signal_procs, (scd));           \
+        PMIX_POST_OBJECT((scd));                                           \
+        pmix_event_active(&((scd)->ev), EV_WRITE, 1);                      \
+    } while (0)
+
 typedef struct {
     pmix_object_t super;
     pmix_event_t ev;
@@ -85,6 +85,154 @@
 #include "src/mca/pfexec/base/base.h"
 #include "src/server/pmix_server_ops.h"
 
+/* find the children among the given procs - the procs are sorted so
+ * each child can be looked up directly, either by itself or through
+ * a wildcard for its nspace. The matching children are removed from
+ * the list of children when requested */
+static pmix_pfexec_child_t **find_children(pmix_proc_t *procs, size_t nprocs, bool remove,
+                                           size_t *nfound)
+{
+    pmix_pfexec_child_t *child, *next, **found;
+    pmix_proc_t *srt, key;
+    size_t n = 0;
+
+    *nfound = 0;
+    found = (pmix_pfexec_child_t **) malloc((pmix_list_get_size(&pmix_pfexec_globals.children) + 1)
+                                            * sizeof(pmix_pfexec_child_t *));
+    srt = (pmix_proc_t *) malloc(nprocs * sizeof(pmix_proc_t));
+    if (NULL == found || NULL == srt) {
+        free(found);
+        free(srt);
+        return NULL;
+    }
+    memcpy(srt, procs, nprocs * sizeof(pmix_proc_t));
+    qsort(srt, nprocs, sizeof(pmix_proc_t), pmix_util_compare_proc);
+
+    PMIX_LIST_FOREACH_SAFE (child, next, &pmix_pfexec_globals.children, pmix_pfexec_child_t) {
+        if (NULL == bsearch(&child->proc, srt, nprocs, sizeof(pmix_proc_t),
+                            pmix_util_compare_proc)) {
+            PMIX_LOAD_PROCID(&key, child->proc.nspace, PMIX_RANK_WILDCARD);
+            if (NULL == bsearch(&key, srt, nprocs, sizeof(pmix_proc_t),
+                                pmix_util_compare_proc)) {
+                continue;
+            }
+        }
+        if (remove) {
+            /* remove the child from the list so waitpid callback won't
+             * find it as this induces unmanageable race
+             * conditions when we are deliberately killing the process */
+            pmix_list_remove_item(&pmix_pfexec_globals.children, &child->super);
+        }
+        found[n++] = child;
+    }
+    free(srt);
+    *nfound = n;
+    return found;
+}
+
+/* the same sequence as pmix_pfexec_base_kill_proc, but each step
+ * is applied to all the procs before waiting */
+void pmix_pfexec_base_kill_procs(int sd, short args, void *cbdata)
+{
+    pmix_pfexec_signal_caddy_t *scd = (pmix_pfexec_signal_caddy_t *) cbdata;
+    pmix_pfexec_child_t **children;
+    pmix_status_t *status, rc;
+    size_t n, nchildren;
+    bool retry = false;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    children = find_children(scd->proc, scd->nprocs, true, &nchildren);
+    if (NULL == children || 0 == nchildren) {
+        scd->lock->status = (NULL == children) ? PMIX_ERR_NOMEM : PMIX_SUCCESS;
+        free(children);
+        PMIX_WAKEUP_THREAD(scd->lock);
+        return;
+    }
+    status = (pmix_status_t *) malloc(nchildren * sizeof(pmix_status_t));
+    if (NULL == status) {
+        /* cannot track them, so just make sure they die */
+        for (n = 0; n < nchildren; n++) {
+            scd->sigfn(children[n]->pid, SIGKILL);
+            PMIX_RELEASE(children[n]);
+        }
+        free(children);
+        scd->lock->status = PMIX_ERR_NOMEM;
+        PMIX_WAKEUP_THREAD(scd->lock);
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, pmix_pfexec_base_framework.framework_output,
+                         "%s SENDING SIGCONT TO %lu PROCS",
+                         PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) nchildren));
+    for (n = 0; n < nchildren; n++) {
+        scd->sigfn(children[n]->pid, SIGCONT);
+    }
+    sleep(pmix_pfexec_globals.timeout_before_sigkill);
+
+    PMIX_OUTPUT_VERBOSE((5, pmix_pfexec_base_framework.framework_output,
+                         "%s SENDING SIGTERM TO %lu PROCS",
+                         PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) nchildren));
+    for (n = 0; n < nchildren; n++) {
+        status[n] = scd->sigfn(children[n]->pid, SIGTERM);
+        if (0 != status[n]) {
+            retry = true;
+        }
+    }
+
+    if (retry) {
+        sleep(pmix_pfexec_globals.timeout_before_sigkill);
+        PMIX_OUTPUT_VERBOSE((5, pmix_pfexec_base_framework.framework_output,
+                             "%s SENDING SIGKILL", PMIX_NAME_PRINT(&pmix_globals.myid)));
+        for (n = 0; n < nchildren; n++) {
+            if (0 != status[n]) {
+                status[n] = scd->sigfn(children[n]->pid, SIGKILL);
+            }
+        }
+    }
+
+    /* report the first failure, if any */
+    rc = PMIX_SUCCESS;
+    for (n = 0; n < nchildren; n++) {
+        if (PMIX_SUCCESS == rc && 0 != status[n]) {
+            rc = status[n];
+        }
+        PMIX_RELEASE(children[n]);
+    }
+    free(status);
+    free(children);
+    scd->lock->status = rc;
+    PMIX_WAKEUP_THREAD(scd->lock);
+}
+
+void pmix_pfexec_base_signal_procs(int sd, short args, void *cbdata)
+{
+    pmix_pfexec_signal_caddy_t *scd = (pmix_pfexec_signal_caddy_t *) cbdata;
+    pmix_pfexec_child_t **children;
+    pmix_status_t rc;
+    size_t n, nchildren;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    children = find_children(scd->proc, scd->nprocs, false, &nchildren);
+    if (NULL == children) {
+        scd->lock->status = PMIX_ERR_NOMEM;
+        PMIX_WAKEUP_THREAD(scd->lock);
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, pmix_pfexec_base_framework.framework_output,
+                         "%s SIGNALING %d TO %lu PROCS", PMIX_NAME_PRINT(&pmix_globals.myid),
+                         scd->signal, (unsigned long) nchildren));
+    scd->lock->status = PMIX_SUCCESS;
+    for (n = 0; n < nchildren; n++) {
+        rc = scd->sigfn(children[n]->pid, scd->signal);
+        if (PMIX_SUCCESS == scd->lock->status && 0 != rc) {
+            scd->lock->status = rc;
+        }
+    }
+    free(children);
+    PMIX_WAKEUP_THREAD(scd->lock);
+}
+
 static pmix_status_t setup_prefork(pmix_pfexec_child_t *child);
 static pmix_status_t register_nspace(char *nspace, pmix_pfexec_fork_caddy_t *fcd);
 
@@ -127,10 +275,38 @@ static pmix_status_t setup_path(pmix_app_t *app)
     return rc;
 }
 
+/* wait for the launches the fork function left for us to confirm -
+ * all of them are collected even if one fails */
+static pmix_status_t complete_launches(pmix_pfexec_fork_caddy_t *fcd, pmix_app_t *app,
+                                       pmix_pfexec_child_t **launched, size_t *nlaunched)
+{
+    pmix_pfexec_child_t *child;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+    size_t n;
+
+    for (n = 0; n < *nlaunched; n++) {
+        child = launched[n];
+        rc = fcd->cmpfn(app, child);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            pmix_list_remove_item(&pmix_pfexec_globals.children, &child->super);
+            PMIX_RELEASE(child);
+            if (PMIX_SUCCESS == ret) {
+                ret = rc;
+            }
+            continue;
+        }
+        PMIX_IOF_READ_ACTIVATE(child->stdoutev);
+        PMIX_IOF_READ_ACTIVATE(child->stderrev);
+    }
+    *nlaunched = 0;
+    return ret;
+}
+
 void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
 {
     pmix_pfexec_fork_caddy_t *fcd = (pmix_pfexec_fork_caddy_t *) cbdata;
-    pmix_app_t *app;
+    pmix_app_t *app = NULL;
     int i, n;
     size_t m, k;
     pmix_status_t rc;
@@ -138,12 +314,15 @@ void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
     pmix_nspace_t nspace;
     char basedir[MAXPATHLEN], sock[10];
     pmix_pfexec_child_t *child;
+    pmix_pfexec_child_t **launched = NULL;
+    size_t nlaunched = 0;
     pmix_rank_info_t *info;
     pmix_namespace_t *nptr;
     pmix_rank_t rank = 0;
     char tmp[2048];
     bool nohup = false;
     char *security_mode;
+    pmix_status_t ret;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     pmix_output_verbose(5, pmix_pfexec_base_framework.framework_output,
@@ -159,6 +338,17 @@ void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
         goto complete;
     }
 
+    if (NULL != fcd->cmpfn) {
+        if (0 == fcd->batch) {
+            fcd->batch = 1;
+        }
+        launched = (pmix_pfexec_child_t **) malloc(fcd->batch * sizeof(pmix_pfexec_child_t *));
+        if (NULL == launched) {
+            rc = PMIX_ERR_NOMEM;
+            goto complete;
+        }
+    }
+
     /* create a namespace for the new job */
     memset(tmp, 0, 2048);
     (void) pmix_snprintf(tmp, 2047, "%s:%lu", pmix_globals.myid.nspace,
@@ -345,6 +535,17 @@ void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
 
             rc = fcd->frkfn(app, child, env);
             pmix_argv_free(env);
+            if (PMIX_OPERATION_IN_PROGRESS == rc && NULL != launched) {
+                /* confirm the launches once we have a batch of them */
+                launched[nlaunched++] = child;
+                if (nlaunched == fcd->batch) {
+                    rc = complete_launches(fcd, app, launched, &nlaunched);
+                    if (PMIX_SUCCESS != rc) {
+                        goto complete;
+                    }
+                }
+                continue;
+            }
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 pmix_list_remove_item(&pmix_pfexec_globals.children, &child->super);
@@ -354,10 +555,27 @@ void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
             PMIX_IOF_READ_ACTIVATE(child->stdoutev);
             PMIX_IOF_READ_ACTIVATE(child->stderrev);
         }
+        if (0 < nlaunched) {
+            rc = complete_launches(fcd, app, launched, &nlaunched);
+            if (PMIX_SUCCESS != rc) {
+                goto complete;
+            }
+        }
     }
     rc = PMIX_SUCCESS;
 
 complete:
+    /* the children launched so far belong to the app we stopped in */
+    if (0 < nlaunched) {
+        ret = complete_launches(fcd, app, launched, &nlaunched);
+        if (PMIX_SUCCESS == rc) {
+            rc = ret;
+        }
+    }
+    if (NULL != launched) {
+        free(launched);
+    }
+
     /* ensure we reset our working directory back to our default location  */
     if (0 != chdir(basedir)) {
         PMIX_ERROR_LOG(PMIX_ERROR);
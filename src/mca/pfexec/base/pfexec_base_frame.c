@@ -58,7 +58,9 @@
 pmix_pfexec_base_module_t pmix_pfexec = {
     .spawn_job = NULL,
     .kill_proc = NULL,
-    .signal_proc = NULL
+    .signal_proc = NULL,
+    .kill_procs = NULL,
+    .signal_procs = NULL
 };
 
 /*
@@ -238,6 +240,7 @@ static void chcon(pmix_pfexec_child_t *p)
     p->completed = false;
     p->keepalive[0] = -1;
     p->keepalive[1] = -1;
+    p->launch_pipe = -1;
     memset(&p->opts, 0, sizeof(pmix_pfexec_base_io_conf_t));
     p->opts.p_stdin[0] = -1;
     p->opts.p_stdin[1] = -1;
@@ -264,6 +267,9 @@ static void chdes(pmix_pfexec_child_t *p)
     if (0 <= p->keepalive[1]) {
         close(p->keepalive[1]);
     }
+    if (0 <= p->launch_pipe) {
+        close(p->launch_pipe);
+    }
 }
 PMIX_CLASS_INSTANCE(pmix_pfexec_child_t,
                     pmix_list_item_t,
@@ -276,14 +282,24 @@ static void fccon(pmix_pfexec_fork_caddy_t *p)
     p->apps = NULL;
     p->napps = 0;
     p->frkfn = NULL;
+    p->cmpfn = NULL;
+    p->batch = 1;
     p->cbfunc = NULL;
     p->cbdata = NULL;
 }
 PMIX_CLASS_INSTANCE(pmix_pfexec_fork_caddy_t,
                     pmix_object_t, fccon, NULL);
 
+static void sccon(pmix_pfexec_signal_caddy_t *p)
+{
+    p->proc = NULL;
+    p->nprocs = 1;
+    p->signal = 0;
+    p->sigfn = NULL;
+    p->lock = NULL;
+}
 PMIX_CLASS_INSTANCE(pmix_pfexec_signal_caddy_t,
-                    pmix_object_t, NULL, NULL);
+                    pmix_object_t, sccon, NULL);
 
 PMIX_CLASS_INSTANCE(pmix_pfexec_cmpl_caddy_t,
                     pmix_object_t, NULL, NULL);
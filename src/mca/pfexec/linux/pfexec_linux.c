@@ -110,8 +110,18 @@
 #    include <dirent.h>
 #endif
 #include <ctype.h>
+#ifdef HAVE_SPAWN_H
+#    include <spawn.h>
+#endif
+#ifdef HAVE_TERMIOS_H
+#    include <termios.h>
+#    ifdef HAVE_TERMIO_H
+#        include <termio.h>
+#    endif
+#endif
 
 #include "src/class/pmix_pointer_array.h"
+#include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_fd.h"
 #include "src/util/pmix_environ.h"
@@ -131,6 +141,8 @@ static pmix_status_t spawn_job(const pmix_info_t job_info[], size_t ninfo, const
                                size_t napps, pmix_spawn_cbfunc_t cbfunc, void *cbdata);
 static pmix_status_t kill_proc(pmix_proc_t *proc);
 static pmix_status_t signal_proc(pmix_proc_t *proc, int32_t signal);
+static pmix_status_t kill_procs(pmix_proc_t *procs, size_t nprocs);
+static pmix_status_t signal_procs(pmix_proc_t *procs, size_t nprocs, int32_t signal);
 
 /*
  * Explicitly declared functions so that we can get the noreturn
@@ -149,6 +161,8 @@ pmix_pfexec_base_module_t pmix_pfexec_linux_module = {
     .spawn_job = spawn_job,
     .kill_proc = kill_proc,
     .signal_proc = signal_proc,
+    .kill_procs = kill_procs,
+    .signal_procs = signal_procs,
 };
 
 /* deliver a signal to a specified pid. */
@@ -219,6 +233,38 @@ static pmix_status_t signal_proc(pmix_proc_t *proc, int32_t signal)
     return rc;
 }
 
+static pmix_status_t kill_procs(pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_status_t rc;
+    pmix_lock_t mylock;
+    pmix_pfexec_signal_caddy_t *kcd;
+
+    PMIX_CONSTRUCT_LOCK(&mylock);
+    PMIX_PFEXEC_KILL_PROCS(kcd, procs, nprocs, sigproc, &mylock);
+    PMIX_WAIT_THREAD(&mylock);
+    rc = mylock.status;
+    PMIX_DESTRUCT_LOCK(&mylock);
+    PMIX_RELEASE(kcd);
+
+    return rc;
+}
+
+static pmix_status_t signal_procs(pmix_proc_t *procs, size_t nprocs, int32_t signal)
+{
+    pmix_status_t rc;
+    pmix_lock_t mylock;
+    pmix_pfexec_signal_caddy_t *scd;
+
+    PMIX_CONSTRUCT_LOCK(&mylock);
+    PMIX_PFEXEC_SIGNAL_PROCS(scd, procs, nprocs, signal, sigproc, &mylock);
+    PMIX_WAIT_THREAD(&mylock);
+    rc = mylock.status;
+    PMIX_DESTRUCT_LOCK(&mylock);
+    PMIX_RELEASE(scd);
+
+    return rc;
+}
+
 static void set_handler_linux(int sig)
 {
     struct sigaction act;
@@ -423,12 +469,9 @@ static void do_child(pmix_app_t *app, char **env, pmix_pfexec_child_t *child, in
     /* Does not return */
 }
 
-static pmix_status_t do_parent(pmix_app_t *app, pmix_pfexec_child_t *child, int read_fd)
+/* the child has its own copies of these now */
+static void close_child_ends(pmix_pfexec_child_t *child)
 {
-    pmix_status_t rc;
-    pmix_pfexec_pipe_err_msg_t msg;
-    char file[PMIX_PFEXEC_MAX_FILE_LEN + 1], topic[PMIX_PFEXEC_MAX_TOPIC_LEN + 1], *str = NULL;
-
     if (child->opts.connect_stdin && 0 <= child->opts.p_stdin[0]) {
         close(child->opts.p_stdin[0]);
     }
@@ -440,6 +483,13 @@ static pmix_status_t do_parent(pmix_app_t *app, pmix_pfexec_child_t *child, int
     if (0 <= child->keepalive[1]) {
         close(child->keepalive[1]);
     }
+}
+
+static pmix_status_t read_launch_status(pmix_app_t *app, int read_fd)
+{
+    pmix_status_t rc;
+    pmix_pfexec_pipe_err_msg_t msg;
+    char file[PMIX_PFEXEC_MAX_FILE_LEN + 1], topic[PMIX_PFEXEC_MAX_TOPIC_LEN + 1], *str = NULL;
 
     /* Block reading a message from the pipe */
     while (1) {
@@ -526,6 +576,12 @@ static pmix_status_t do_parent(pmix_app_t *app, pmix_pfexec_child_t *child, int
     return PMIX_SUCCESS;
 }
 
+static pmix_status_t do_parent(pmix_app_t *app, pmix_pfexec_child_t *child, int read_fd)
+{
+    close_child_ends(child);
+    return read_launch_status(app, read_fd);
+}
+
 /**
  *  Fork/exec the specified processes
  */
@@ -570,6 +626,141 @@ static int fork_proc(pmix_app_t *app, pmix_pfexec_child_t *child, char **env)
     return do_parent(app, child, p[0]);
 }
 
+/* Fork the proc, but leave it to wait_proc to learn whether the
+ * exec succeeded so a batch of procs can be started before we wait
+ * for the first of them */
+static int fork_proc_nowait(pmix_app_t *app, pmix_pfexec_child_t *child, char **env)
+{
+    int p[2];
+
+    if (pipe(p) < 0) {
+        PMIX_ERROR_LOG(PMIX_ERR_SYS_OTHER);
+        return PMIX_ERR_SYS_OTHER;
+    }
+    /* don't let the procs we fork after this one hold it open */
+    pmix_fd_set_cloexec(p[0]);
+
+    child->pid = fork();
+
+    if (child->pid < 0) {
+        PMIX_ERROR_LOG(PMIX_ERR_SYS_OTHER);
+        close(p[0]);
+        close(p[1]);
+        return PMIX_ERR_SYS_OTHER;
+    }
+
+    if (child->pid == 0) {
+        if (0 <= p[0]) {
+            close(p[0]);
+        }
+        if (0 <= child->keepalive[0]) {
+            close(child->keepalive[0]);
+            child->keepalive[0] = -1;
+        }
+        do_child(app, env, child, p[1]);
+        /* Does not return */
+    }
+
+    close(p[1]);
+    close_child_ends(child);
+    child->launch_pipe = p[0];
+    return PMIX_OPERATION_IN_PROGRESS;
+}
+
+static pmix_status_t wait_proc(pmix_app_t *app, pmix_pfexec_child_t *child)
+{
+    int fd = child->launch_pipe;
+
+    /* the read closes it */
+    child->launch_pipe = -1;
+    return read_launch_status(app, fd);
+}
+
+#if defined(HAVE_POSIX_SPAWN) && defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+/**
+ *  Launch the specified process with posix_spawn - this avoids
+ *  duplicating our address space for a child that is only going to
+ *  exec, and the exec failure is reported to us directly. The child
+ *  is given the same setup do_child provides - the working directory
+ *  was already set for us by the base.
+ */
+static int spawn_proc(pmix_app_t *app, pmix_pfexec_child_t *child, char **env)
+{
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    sigset_t sigs;
+    char **penv = env;
+    char dir[MAXPATHLEN];
+    int rc, nextfd = 3;
+    short flags;
+
+    if (child->opts.usepty) {
+        /* disable echo */
+        struct termios term_attrs;
+        if (tcgetattr(child->opts.p_stdout[1], &term_attrs) < 0) {
+            return PMIX_ERR_SYS_OTHER;
+        }
+        term_attrs.c_lflag &= ~(ECHO | ECHOE | ECHOK | ECHOCTL | ECHOKE | ECHONL);
+        term_attrs.c_iflag &= ~(ICRNL | INLCR | ISTRIP | INPCK | IXON);
+        term_attrs.c_oflag &= ~(OCRNL | ONLCR);
+        if (tcsetattr(child->opts.p_stdout[1], TCSANOW, &term_attrs) == -1) {
+            return PMIX_ERR_SYS_OTHER;
+        }
+    }
+
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, child->opts.p_stdin[0], fileno(stdin));
+    posix_spawn_file_actions_adddup2(&actions, child->opts.p_stdout[1], fileno(stdout));
+    posix_spawn_file_actions_adddup2(&actions, child->opts.p_stderr[1], fileno(stderr));
+    if (0 <= child->keepalive[1]) {
+        /* the keepalive pipe is the only other fd the child keeps,
+         * so it is moved to the first slot above stdio */
+        posix_spawn_file_actions_adddup2(&actions, child->keepalive[1], nextfd);
+        penv = pmix_argv_copy(env);
+        pmix_setenv("PMIX_KEEPALIVE_PIPE", "3", true, &penv);
+        ++nextfd;
+    }
+    posix_spawn_file_actions_addclosefrom_np(&actions, nextfd);
+
+    /* reset the signal handlers and mask as do_child does */
+    posix_spawnattr_init(&attr);
+    flags = POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK;
+#if HAVE_SETPGID
+    flags |= POSIX_SPAWN_SETPGROUP;
+    posix_spawnattr_setpgroup(&attr, 0);
+#endif
+    posix_spawnattr_setflags(&attr, flags);
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGTERM);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGHUP);
+    sigaddset(&sigs, SIGPIPE);
+    sigaddset(&sigs, SIGCHLD);
+    posix_spawnattr_setsigdefault(&attr, &sigs);
+    sigemptyset(&sigs);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+
+    rc = posix_spawn(&child->pid, app->cmd, &actions, &attr, app->argv, penv);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    if (penv != env) {
+        pmix_argv_free(penv);
+    }
+    close_child_ends(child);
+
+    if (0 != rc) {
+        if (NULL == getcwd(dir, sizeof(dir))) {
+            pmix_strncpy(dir, "GETCWD-FAILED", sizeof(dir));
+        }
+        pmix_show_help("help-pfexec-linux.txt", "execve error", true, pmix_globals.hostname, dir,
+                       app->cmd, strerror(rc));
+        return PMIX_ERR_SYS_OTHER;
+    }
+    return PMIX_SUCCESS;
+}
+#endif
+
 /**
  * Launch all processes allocated to the current node.
  */
@@ -580,6 +771,18 @@ static pmix_status_t spawn_job(const pmix_info_t job_info[], size_t ninfo, const
     pmix_output_verbose(5, pmix_pfexec_base_framework.framework_output,
                         "%s pfexec:linux spawning child job", PMIX_NAME_PRINT(&pmix_globals.myid));
 
+#if defined(HAVE_POSIX_SPAWN) && defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+    if (pmix_mca_pfexec_linux_component.posix_spawn) {
+        PMIX_PFEXEC_SPAWN(job_info, ninfo, apps, napps, spawn_proc, cbfunc, cbdata);
+        return PMIX_SUCCESS;
+    }
+#endif
+    if (1 < pmix_mca_pfexec_linux_component.spawn_batch) {
+        PMIX_PFEXEC_SPAWN_BATCH(job_info, ninfo, apps, napps, fork_proc_nowait, wait_proc,
+                                (size_t) pmix_mca_pfexec_linux_component.spawn_batch,
+                                cbfunc, cbdata);
+        return PMIX_SUCCESS;
+    }
     PMIX_PFEXEC_SPAWN(job_info, ninfo, apps, napps, fork_proc, cbfunc, cbdata);
 
     return PMIX_SUCCESS;
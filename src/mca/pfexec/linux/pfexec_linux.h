@@ -35,8 +35,16 @@ BEGIN_C_DECLS
 /*
  * PFEXEC Linux module
  */
+typedef struct {
+    pmix_pfexec_base_component_t super;
+    /* launch with posix_spawn when it is available */
+    bool posix_spawn;
+    /* max number of forked procs whose exec is confirmed together */
+    int spawn_batch;
+} pmix_pfexec_linux_component_t;
+
 PMIX_EXPORT extern pmix_pfexec_base_module_t pmix_pfexec_linux_module;
-PMIX_EXPORT extern pmix_pfexec_base_component_t pmix_mca_pfexec_linux_component;
+PMIX_EXPORT extern pmix_pfexec_linux_component_t pmix_mca_pfexec_linux_component;
 
 END_C_DECLS
 
@@ -42,6 +42,7 @@
 #include "src/mca/pfexec/linux/pfexec_linux.h"
 #include "src/mca/pfexec/pfexec.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_open(void);
 static pmix_status_t component_close(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
@@ -51,21 +52,43 @@ static pmix_status_t component_query(pmix_mca_base_module_t **module, int *prior
  * and pointers to our public functions in it
  */
 
-pmix_pfexec_base_component_t pmix_mca_pfexec_linux_component = {
-    PMIX_PFEXEC_BASE_VERSION_1_0_0,
-    /* Component name and version */
-    .pmix_mca_component_name = "linux",
-    PMIX_MCA_BASE_MAKE_VERSION(component,
-                               PMIX_MAJOR_VERSION,
-                               PMIX_MINOR_VERSION,
-                               PMIX_RELEASE_VERSION),
+pmix_pfexec_linux_component_t pmix_mca_pfexec_linux_component = {
+    .super = {
+        PMIX_PFEXEC_BASE_VERSION_1_0_0,
+        /* Component name and version */
+        .pmix_mca_component_name = "linux",
+        PMIX_MCA_BASE_MAKE_VERSION(component,
+                                   PMIX_MAJOR_VERSION,
+                                   PMIX_MINOR_VERSION,
+                                   PMIX_RELEASE_VERSION),
 
-    /* Component open and close functions */
-    .pmix_mca_open_component = component_open,
-    .pmix_mca_close_component = component_close,
-    .pmix_mca_query_component = component_query,
+        /* Component open and close functions */
+        .pmix_mca_open_component = component_open,
+        .pmix_mca_close_component = component_close,
+        .pmix_mca_query_component = component_query,
+        .pmix_mca_register_component_params = component_register,
+    },
+    .posix_spawn = true,
+    .spawn_batch = 32
 };
 
+static pmix_status_t component_register(void)
+{
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_pfexec_linux_component.super, "posix_spawn",
+        "Launch local procs with posix_spawn instead of fork/exec when the system "
+        "supports it [default: true]",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_pfexec_linux_component.posix_spawn);
+
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_pfexec_linux_component.super, "spawn_batch",
+        "Number of procs forked before waiting to confirm they were executed "
+        "(1 => wait for each proc) [default: 32]",
+        PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_mca_pfexec_linux_component.spawn_batch);
+
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t component_open(void)
 {
     return PMIX_SUCCESS;
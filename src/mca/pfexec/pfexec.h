@@ -59,6 +59,19 @@ typedef pmix_status_t (*pmix_pfexec_base_module_kill_process_fn_t)(pmix_proc_t *
  */
 typedef pmix_status_t (*pmix_pfexec_base_module_signal_process_fn_t)(pmix_proc_t *proc, int signum);
 
+/**
+ * Kill a set of local processes we started in a single sweep - a
+ * wildcard rank includes every local process of that nspace
+ */
+typedef pmix_status_t (*pmix_pfexec_base_module_kill_processes_fn_t)(pmix_proc_t *procs,
+                                                                     size_t nprocs);
+
+/**
+ * Signal a set of local processes we started in a single sweep
+ */
+typedef pmix_status_t (*pmix_pfexec_base_module_signal_processes_fn_t)(pmix_proc_t *procs,
+                                                                       size_t nprocs, int signum);
+
 /**
  * pfexec module version
  */
@@ -66,6 +79,8 @@ typedef struct {
     pmix_pfexec_base_module_spawn_job_fn_t spawn_job;
     pmix_pfexec_base_module_kill_process_fn_t kill_proc;
     pmix_pfexec_base_module_signal_process_fn_t signal_proc;
+    pmix_pfexec_base_module_kill_processes_fn_t kill_procs;
+    pmix_pfexec_base_module_signal_processes_fn_t signal_procs;
 } pmix_pfexec_base_module_t;
 
 /**
@@ -38,6 +38,7 @@
 #include "src/class/pmix_pointer_array.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/mca.h"
+#include "src/threads/pmix_threads.h"
 
 #include "src/mca/pgpu/pgpu.h"
 
@@ -72,6 +73,16 @@ struct pmix_pgpu_globals_t {
     pmix_list_t actives;
     pmix_list_t nspaces;
     bool selected;
+    /* the node's GPU inventory, probed once in the background when
+     * the modules are selected - the lock is active while a probe of
+     * the devices is in progress */
+    bool cache_inventory;
+    pmix_lock_t inventory_lock;
+    pmix_thread_t probe;
+    bool probe_started;
+    bool inventory_valid;
+    pmix_status_t inventory_status;
+    pmix_list_t inventory;
 };
 typedef struct pmix_pgpu_globals_t pmix_pgpu_globals_t;
 
@@ -88,6 +99,7 @@ PMIX_EXPORT void pmix_pgpu_base_local_app_finalized(pmix_namespace_t *nptr);
 PMIX_EXPORT void pmix_pgpu_base_deregister_nspace(char *nspace);
 PMIX_EXPORT pmix_status_t pmix_pgpu_base_collect_inventory(pmix_info_t directives[], size_t ndirs,
                                                            pmix_list_t *inventory);
+PMIX_EXPORT void pmix_pgpu_base_start_inventory(void);
 PMIX_EXPORT pmix_status_t pmix_pgpu_base_deliver_inventory(pmix_info_t info[], size_t ninfo,
                                                            pmix_info_t directives[], size_t ndirs);
 PMIX_EXPORT pmix_status_t pmix_pgpu_base_harvest_envars(char **incvars, char **excvars,
@@ -265,8 +265,8 @@ void pmix_pgpu_base_deregister_nspace(char *nspace)
     PMIX_RELEASE(ns);
 }
 
-pmix_status_t pmix_pgpu_base_collect_inventory(pmix_info_t directives[], size_t ndirs,
-                                               pmix_list_t *inventory)
+static pmix_status_t probe_inventory(pmix_info_t directives[], size_t ndirs,
+                                     pmix_list_t *inventory)
 {
     pmix_pgpu_base_active_module_t *active;
     pmix_status_t rc;
@@ -284,6 +284,112 @@ pmix_status_t pmix_pgpu_base_collect_inventory(pmix_info_t directives[], size_t
     return PMIX_SUCCESS;
 }
 
+/* replace the cached inventory - must be called with the lock held */
+static void cache_inventory(pmix_status_t status, pmix_list_t *inventory)
+{
+    pmix_list_item_t *item;
+
+    PMIX_LIST_DESTRUCT(&pmix_pgpu_globals.inventory);
+    PMIX_CONSTRUCT(&pmix_pgpu_globals.inventory, pmix_list_t);
+    while (NULL != (item = pmix_list_remove_first(inventory))) {
+        pmix_list_append(&pmix_pgpu_globals.inventory, item);
+    }
+    pmix_pgpu_globals.inventory_status = status;
+    pmix_pgpu_globals.inventory_valid = true;
+}
+
+static void *probe_thread(pmix_object_t *obj)
+{
+    pmix_list_t inventory;
+    pmix_status_t rc;
+    PMIX_HIDE_UNUSED_PARAMS(obj);
+
+    PMIX_CONSTRUCT(&inventory, pmix_list_t);
+    rc = probe_inventory(NULL, 0, &inventory);
+    pmix_mutex_lock(&pmix_pgpu_globals.inventory_lock.mutex);
+    cache_inventory(rc, &inventory);
+    pmix_mutex_unlock(&pmix_pgpu_globals.inventory_lock.mutex);
+    PMIX_LIST_DESTRUCT(&inventory);
+
+    pmix_output_verbose(2, pmix_pgpu_base_framework.framework_output,
+                        "pgpu:inventory probe complete: %s", PMIx_Error_string(rc));
+    PMIX_WAKEUP_THREAD(&pmix_pgpu_globals.inventory_lock);
+    return NULL;
+}
+
+/* Enumerating the devices can take a good fraction of a second per
+ * GPU, so servers start doing it as soon as the modules are selected
+ * rather than making the first job wait for it */
+void pmix_pgpu_base_start_inventory(void)
+{
+    if (!pmix_pgpu_globals.cache_inventory || pmix_pgpu_globals.probe_started
+        || pmix_pgpu_globals.inventory_valid
+        || 0 == pmix_list_get_size(&pmix_pgpu_globals.actives)) {
+        return;
+    }
+    pmix_pgpu_globals.inventory_lock.active = true;
+    pmix_pgpu_globals.probe.t_run = probe_thread;
+    pmix_pgpu_globals.probe.t_arg = NULL;
+    pmix_pgpu_globals.probe_started = true;
+    if (PMIX_SUCCESS != pmix_thread_start(&pmix_pgpu_globals.probe)) {
+        /* the first request will have to do it */
+        pmix_pgpu_globals.probe_started = false;
+        pmix_pgpu_globals.inventory_lock.active = false;
+    }
+}
+
+pmix_status_t pmix_pgpu_base_collect_inventory(pmix_info_t directives[], size_t ndirs,
+                                               pmix_list_t *inventory)
+{
+    pmix_list_t probed;
+    pmix_infolist_t *iptr, *copy;
+    pmix_status_t rc;
+    bool refresh = false;
+    size_t n;
+
+    if (0 == pmix_list_get_size(&pmix_pgpu_globals.actives)) {
+        return PMIX_SUCCESS;
+    }
+    if (!pmix_pgpu_globals.cache_inventory) {
+        return probe_inventory(directives, ndirs, inventory);
+    }
+
+    for (n = 0; n < ndirs; n++) {
+        if (PMIX_CHECK_KEY(&directives[n], PMIX_QUERY_REFRESH_CACHE)) {
+            refresh = PMIX_INFO_TRUE(&directives[n]);
+        }
+    }
+
+    /* let any probe in progress finish */
+    PMIX_WAIT_THREAD(&pmix_pgpu_globals.inventory_lock);
+
+    pmix_mutex_lock(&pmix_pgpu_globals.inventory_lock.mutex);
+    if (refresh || !pmix_pgpu_globals.inventory_valid) {
+        /* the devices have changed (e.g., hotplug), or the background
+         * probe could not be started - do it ourselves */
+        pmix_output_verbose(2, pmix_pgpu_base_framework.framework_output,
+                            "pgpu:inventory probing devices");
+        PMIX_CONSTRUCT(&probed, pmix_list_t);
+        rc = probe_inventory(directives, ndirs, &probed);
+        cache_inventory(rc, &probed);
+        PMIX_LIST_DESTRUCT(&probed);
+    }
+    rc = pmix_pgpu_globals.inventory_status;
+    if (PMIX_SUCCESS == rc) {
+        PMIX_LIST_FOREACH (iptr, &pmix_pgpu_globals.inventory, pmix_infolist_t) {
+            copy = PMIX_NEW(pmix_infolist_t);
+            if (NULL == copy) {
+                rc = PMIX_ERR_NOMEM;
+                break;
+            }
+            PMIx_Info_xfer(&copy->info, &iptr->info);
+            pmix_list_append(inventory, &copy->super);
+        }
+    }
+    pmix_mutex_unlock(&pmix_pgpu_globals.inventory_lock.mutex);
+    return rc;
+}
+
 pmix_status_t pmix_pgpu_base_deliver_inventory(pmix_info_t info[], size_t ninfo,
                                                pmix_info_t directives[], size_t ndirs)
 {
@@ -60,10 +60,33 @@ pmix_pgpu_API_module_t pmix_pgpu = {
     .deliver_inventory = pmix_pgpu_base_deliver_inventory
 };
 
+static int pmix_pgpu_register(pmix_mca_base_register_flag_t flags)
+{
+    (void) flags;
+    pmix_pgpu_globals.cache_inventory = true;
+    (void) pmix_mca_base_var_register("pmix", "pgpu", "base", "cache_inventory",
+                                      "Probe the GPUs on this node once when the server starts "
+                                      "and answer inventory requests from the result, only "
+                                      "probing again when asked to refresh it (default: true)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_pgpu_globals.cache_inventory);
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t pmix_pgpu_close(void)
 {
     pmix_pgpu_base_active_module_t *active, *prev;
 
+    /* the probe may still be talking to the modules */
+    if (pmix_pgpu_globals.probe_started) {
+        pmix_thread_join(&pmix_pgpu_globals.probe, NULL);
+        pmix_pgpu_globals.probe_started = false;
+    }
+    PMIX_DESTRUCT(&pmix_pgpu_globals.probe);
+    PMIX_LIST_DESTRUCT(&pmix_pgpu_globals.inventory);
+    PMIX_DESTRUCT_LOCK(&pmix_pgpu_globals.inventory_lock);
+    pmix_pgpu_globals.inventory_valid = false;
+
     pmix_pgpu_globals.selected = false;
 
     PMIX_LIST_FOREACH_SAFE (active, prev, &pmix_pgpu_globals.actives,
@@ -85,12 +108,19 @@ static pmix_status_t pmix_pgpu_open(pmix_mca_base_open_flag_t flags)
     /* initialize globals */
     PMIX_CONSTRUCT(&pmix_pgpu_globals.actives, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_pgpu_globals.nspaces, pmix_list_t);
+    PMIX_CONSTRUCT_LOCK(&pmix_pgpu_globals.inventory_lock);
+    pmix_pgpu_globals.inventory_lock.active = false;
+    PMIX_CONSTRUCT(&pmix_pgpu_globals.probe, pmix_thread_t);
+    pmix_pgpu_globals.probe_started = false;
+    pmix_pgpu_globals.inventory_valid = false;
+    pmix_pgpu_globals.inventory_status = PMIX_SUCCESS;
+    PMIX_CONSTRUCT(&pmix_pgpu_globals.inventory, pmix_list_t);
 
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_pgpu_base_framework, flags);
 }
 
-PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, pgpu, "PMIx GPU Operations", NULL, pmix_pgpu_open,
+PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, pgpu, "PMIx GPU Operations", pmix_pgpu_register, pmix_pgpu_open,
                                 pmix_pgpu_close, pmix_mca_pgpu_base_static_components,
                                 PMIX_MCA_BASE_FRAMEWORK_FLAG_DEFAULT);
 
@@ -26,6 +26,30 @@ BEGIN_C_DECLS
  */
 PMIX_EXPORT extern pmix_mca_base_framework_t pmix_pif_base_framework;
 
+/* whether to follow changes to the interfaces once they are known */
+PMIX_EXPORT extern bool pmix_if_watch_changes;
+
+/**
+ * Make sure the interfaces are known
+ *
+ * Opens the framework - and so enumerates the interfaces - the first
+ * time it is called. If check is true, any interface changes the
+ * kernel has reported since the last check are applied, so it should
+ * only be set at the start of a lookup and never while walking the
+ * interfaces by index.
+ */
+PMIX_EXPORT pmix_status_t pmix_pif_base_ready(bool check);
+PMIX_EXPORT void pmix_pif_base_table_finalize(void);
+
+/*
+ * Lookups in the index of the interface list - each returns the
+ * first interface in the list that matches, or NULL
+ */
+PMIX_EXPORT pmix_pif_t *pmix_pif_base_lookup_index(int if_index);
+PMIX_EXPORT pmix_pif_t *pmix_pif_base_lookup_name(const char *if_name);
+PMIX_EXPORT pmix_pif_t *pmix_pif_base_lookup_kindex(int if_kindex);
+PMIX_EXPORT pmix_pif_t *pmix_pif_base_lookup_addr(const struct sockaddr_storage *addr);
+
 END_C_DECLS
 
 #endif /* PMIX_BASE_PIF_H */
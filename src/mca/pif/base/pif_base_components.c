@@ -25,6 +25,7 @@
 pmix_list_t pmix_if_list = PMIX_LIST_STATIC_INIT;
 bool pmix_if_do_not_resolve = false;
 bool pmix_if_retain_loopback = false;
+bool pmix_if_watch_changes = true;
 
 static int pmix_pif_base_register(pmix_mca_base_register_flag_t flags);
 static int pmix_pif_base_open(pmix_mca_base_open_flag_t flags);
@@ -55,6 +56,13 @@ static int pmix_pif_base_register(pmix_mca_base_register_flag_t flags)
                                                 PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                                 &pmix_if_retain_loopback);
 
+    pmix_if_watch_changes = true;
+    (void) pmix_mca_base_framework_var_register(&pmix_pif_base_framework, "watch_changes",
+                                                "If nonzero, follow the changes the kernel reports "
+                                                "to the interfaces once they are known",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &pmix_if_watch_changes);
+
     return PMIX_SUCCESS;
 }
 
@@ -80,6 +88,7 @@ static int pmix_pif_base_close(void)
     }
     frameopen = false;
 
+    pmix_pif_base_table_finalize();
     while (NULL != (item = pmix_list_remove_first(&pmix_if_list))) {
         PMIX_RELEASE(item);
     }
@@ -0,0 +1,316 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <errno.h>
+#ifdef HAVE_FCNTL_H
+#    include <fcntl.h>
+#endif
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#if defined(HAVE_LINUX_NETLINK_H) && defined(HAVE_LINUX_RTNETLINK_H)
+#    include <linux/netlink.h>
+#    include <linux/rtnetlink.h>
+#    define PMIX_PIF_HAVE_NETLINK 1
+#endif
+
+#include "src/class/pmix_hash_table.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/base/pmix_base.h"
+#include "src/threads/pmix_mutex.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/pif/base/base.h"
+
+/* The interface list is only built when something first asks about
+ * an interface, so a client that never does so never enumerates
+ * them. The list is then indexed by internal index, name, kernel
+ * index and address. Where several entries share a name, kernel
+ * index or address, the index holds the first of them in the list -
+ * which is what a walk of the list used to find.
+ *
+ * On Linux we also listen for the kernel's link and address
+ * notifications. Nothing is read unless something is looking up an
+ * interface: the start of a lookup drains the socket and only if
+ * an interface changed do we enumerate them again */
+
+typedef struct {
+    pmix_mutex_t lock;
+    bool ready;
+    int nl_fd;
+    pmix_pif_t **byindex;
+    int nindex;
+    pmix_hash_table_t byname;
+    pmix_hash_table_t bykindex;
+    pmix_hash_table_t byaddr;
+} pmix_pif_base_table_t;
+
+static pmix_pif_base_table_t table = {
+    .lock = PMIX_MUTEX_STATIC_INIT,
+    .ready = false,
+    .nl_fd = -1,
+    .byindex = NULL,
+    .nindex = 0
+};
+
+/* the part of the address that identifies it */
+static size_t addr_key(const struct sockaddr_storage *ss, const void **key)
+{
+    if (AF_INET == ss->ss_family) {
+        *key = &((const struct sockaddr_in *) ss)->sin_addr;
+        return sizeof(struct in_addr);
+    }
+#if PMIX_ENABLE_IPV6
+    if (AF_INET6 == ss->ss_family) {
+        *key = &((const struct sockaddr_in6 *) ss)->sin6_addr;
+        return sizeof(struct in6_addr);
+    }
+#endif
+    return 0;
+}
+
+static void clear_index(void)
+{
+    if (NULL != table.byindex) {
+        free(table.byindex);
+        table.byindex = NULL;
+        PMIX_DESTRUCT(&table.byname);
+        PMIX_DESTRUCT(&table.bykindex);
+        PMIX_DESTRUCT(&table.byaddr);
+    }
+    table.nindex = 0;
+}
+
+static void build_index(void)
+{
+    pmix_pif_t *intf;
+    size_t n, len;
+    const void *key;
+    void *ptr;
+
+    clear_index();
+    n = pmix_list_get_size(&pmix_if_list);
+    PMIX_LIST_FOREACH (intf, &pmix_if_list, pmix_pif_t) {
+        if (table.nindex <= intf->if_index) {
+            table.nindex = intf->if_index + 1;
+        }
+    }
+    table.byindex = (pmix_pif_t **) calloc(table.nindex + 1, sizeof(pmix_pif_t *));
+    PMIX_CONSTRUCT(&table.byname, pmix_hash_table_t);
+    pmix_hash_table_init(&table.byname, n + 1);
+    PMIX_CONSTRUCT(&table.bykindex, pmix_hash_table_t);
+    pmix_hash_table_init(&table.bykindex, n + 1);
+    PMIX_CONSTRUCT(&table.byaddr, pmix_hash_table_t);
+    pmix_hash_table_init(&table.byaddr, n + 1);
+
+    PMIX_LIST_FOREACH (intf, &pmix_if_list, pmix_pif_t) {
+        if (0 <= intf->if_index && NULL == table.byindex[intf->if_index]) {
+            table.byindex[intf->if_index] = intf;
+        }
+        len = strlen(intf->if_name);
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&table.byname, intf->if_name, len, &ptr)) {
+            pmix_hash_table_set_value_ptr(&table.byname, intf->if_name, len, intf);
+        }
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&table.bykindex,
+                                                             intf->if_kernel_index, &ptr)) {
+            pmix_hash_table_set_value_uint32(&table.bykindex, intf->if_kernel_index, intf);
+        }
+        len = addr_key(&intf->if_addr, &key);
+        if (0 < len && PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&table.byaddr, key, len, &ptr)) {
+            pmix_hash_table_set_value_ptr(&table.byaddr, key, len, intf);
+        }
+    }
+}
+
+#ifdef PMIX_PIF_HAVE_NETLINK
+static void nl_open(void)
+{
+    struct sockaddr_nl sa;
+    int flags;
+
+    table.nl_fd = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    if (0 > table.nl_fd) {
+        pmix_output_verbose(2, pmix_pif_base_framework.framework_output,
+                            "pif:base cannot open netlink socket: %s", strerror(errno));
+        return;
+    }
+    memset(&sa, 0, sizeof(sa));
+    sa.nl_family = AF_NETLINK;
+    sa.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR;
+#    if PMIX_ENABLE_IPV6
+    sa.nl_groups |= RTMGRP_IPV6_IFADDR;
+#    endif
+    flags = fcntl(table.nl_fd, F_GETFL, 0);
+    if (0 > flags || 0 > fcntl(table.nl_fd, F_SETFL, flags | O_NONBLOCK)
+        || 0 > fcntl(table.nl_fd, F_SETFD, FD_CLOEXEC)
+        || 0 > bind(table.nl_fd, (struct sockaddr *) &sa, sizeof(sa))) {
+        pmix_output_verbose(2, pmix_pif_base_framework.framework_output,
+                            "pif:base cannot listen for interface changes: %s", strerror(errno));
+        close(table.nl_fd);
+        table.nl_fd = -1;
+    }
+}
+
+static bool nl_changed(void)
+{
+    char buf[8192];
+    struct nlmsghdr *nh;
+    ssize_t len;
+    bool changed = false;
+
+    while (1) {
+        len = recv(table.nl_fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (0 > len) {
+            if (EINTR == errno) {
+                continue;
+            }
+            if (ENOBUFS == errno) {
+                /* we missed some - assume the worst */
+                changed = true;
+                continue;
+            }
+            /* EAGAIN - nothing more is waiting */
+            break;
+        }
+        if (0 == len) {
+            break;
+        }
+        for (nh = (struct nlmsghdr *) buf; NLMSG_OK(nh, (size_t) len);
+             nh = NLMSG_NEXT(nh, len)) {
+            if (RTM_NEWLINK == nh->nlmsg_type || RTM_DELLINK == nh->nlmsg_type
+                || RTM_NEWADDR == nh->nlmsg_type || RTM_DELADDR == nh->nlmsg_type) {
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+static void refresh(void)
+{
+    pmix_mca_base_component_list_item_t *cli;
+    pmix_list_item_t *item;
+
+    pmix_output_verbose(2, pmix_pif_base_framework.framework_output,
+                        "pif:base interfaces changed - enumerating them again");
+    clear_index();
+    while (NULL != (item = pmix_list_remove_first(&pmix_if_list))) {
+        PMIX_RELEASE(item);
+    }
+    /* the components enumerate the interfaces when they are opened */
+    PMIX_LIST_FOREACH (cli, &pmix_pif_base_framework.framework_components,
+                       pmix_mca_base_component_list_item_t) {
+        if (NULL != cli->cli_component->pmix_mca_open_component) {
+            (void) cli->cli_component->pmix_mca_open_component();
+        }
+    }
+    build_index();
+}
+#endif
+
+pmix_status_t pmix_pif_base_ready(bool check)
+{
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_mutex_lock(&table.lock);
+    if (!table.ready) {
+#ifdef PMIX_PIF_HAVE_NETLINK
+        /* listen before we look, so no change can fall in between */
+        nl_open();
+#endif
+        rc = pmix_mca_base_framework_open(&pmix_pif_base_framework, PMIX_MCA_BASE_OPEN_DEFAULT);
+        if (PMIX_SUCCESS != rc) {
+            if (0 <= table.nl_fd) {
+                close(table.nl_fd);
+                table.nl_fd = -1;
+            }
+            pmix_mutex_unlock(&table.lock);
+            return rc;
+        }
+        if (!pmix_if_watch_changes && 0 <= table.nl_fd) {
+            /* now that we know we weren't to listen */
+            close(table.nl_fd);
+            table.nl_fd = -1;
+        }
+        build_index();
+        table.ready = true;
+    }
+#ifdef PMIX_PIF_HAVE_NETLINK
+    else if (check && 0 <= table.nl_fd && nl_changed()) {
+        refresh();
+    }
+#else
+    PMIX_HIDE_UNUSED_PARAMS(check);
+#endif
+    pmix_mutex_unlock(&table.lock);
+    return rc;
+}
+
+void pmix_pif_base_table_finalize(void)
+{
+    pmix_mutex_lock(&table.lock);
+    clear_index();
+    if (0 <= table.nl_fd) {
+        close(table.nl_fd);
+        table.nl_fd = -1;
+    }
+    table.ready = false;
+    pmix_mutex_unlock(&table.lock);
+}
+
+pmix_pif_t *pmix_pif_base_lookup_index(int if_index)
+{
+    if (0 > if_index || table.nindex <= if_index) {
+        return NULL;
+    }
+    return table.byindex[if_index];
+}
+
+pmix_pif_t *pmix_pif_base_lookup_name(const char *if_name)
+{
+    void *ptr;
+
+    if (NULL == table.byindex
+        || PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&table.byname, if_name,
+                                                         strlen(if_name), &ptr)) {
+        return NULL;
+    }
+    return (pmix_pif_t *) ptr;
+}
+
+pmix_pif_t *pmix_pif_base_lookup_kindex(int if_kindex)
+{
+    void *ptr;
+
+    if (NULL == table.byindex || 0 > if_kindex
+        || PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&table.bykindex,
+                                                            (uint32_t) if_kindex, &ptr)) {
+        return NULL;
+    }
+    return (pmix_pif_t *) ptr;
+}
+
+pmix_pif_t *pmix_pif_base_lookup_addr(const struct sockaddr_storage *addr)
+{
+    const void *key;
+    size_t len;
+    void *ptr;
+
+    if (NULL == table.byindex || 0 == (len = addr_key(addr, &key))
+        || PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&table.byaddr, key, len, &ptr)) {
+        return NULL;
+    }
+    return (pmix_pif_t *) ptr;
+}
@@ -77,6 +77,20 @@ struct pmix_plog_globals_t {
     bool initialized;
     bool selected;
     char **channels;
+    /* worker thread for the modules that can block, fed
+     * through a bounded queue protected by the qlock */
+    pmix_thread_t worker;
+    bool worker_started;
+    bool worker_stop;
+    pmix_lock_t qlock;
+    pmix_list_t queue;
+    int queue_max;
+    bool queue_block;
+    /* queue statistics */
+    size_t nqueued;
+    size_t ndropped;
+    size_t nblocked;
+    size_t hiwater;
 };
 typedef struct pmix_plog_globals_t pmix_plog_globals_t;
 
@@ -86,6 +100,16 @@ PMIX_EXPORT pmix_status_t pmix_plog_base_log(const pmix_proc_t *source, const pm
                                              size_t ndata, const pmix_info_t directives[],
                                              size_t ndirs, pmix_op_cbfunc_t cbfunc, void *cbdata);
 
+/* hand a request for a blocking module to the worker thread - returns
+ * PMIX_OPERATION_IN_PROGRESS if the request was queued, in which case
+ * the callback will be executed when the module is done with it */
+PMIX_EXPORT pmix_status_t pmix_plog_base_queue(pmix_plog_module_t *module,
+                                               const pmix_proc_t *source,
+                                               const pmix_info_t data[], size_t ndata,
+                                               const pmix_info_t directives[], size_t ndirs,
+                                               pmix_op_cbfunc_t cbfunc, void *cbdata);
+PMIX_EXPORT void pmix_plog_base_stop_worker(void);
+
 END_C_DECLS
 
 #endif
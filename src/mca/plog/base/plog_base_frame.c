@@ -38,7 +38,17 @@ pmix_plog_globals_t pmix_plog_globals = {
     .actives = PMIX_POINTER_ARRAY_STATIC_INIT,
     .initialized = false,
     .selected = false,
-    .channels = NULL
+    .channels = NULL,
+    .worker_started = false,
+    .worker_stop = false,
+    .qlock = PMIX_LOCK_STATIC_INIT,
+    .queue = PMIX_LIST_STATIC_INIT,
+    .queue_max = 1024,
+    .queue_block = false,
+    .nqueued = 0,
+    .ndropped = 0,
+    .nblocked = 0,
+    .hiwater = 0
 };
 pmix_plog_API_module_t pmix_plog = {.log = pmix_plog_base_log};
 
@@ -53,6 +63,18 @@ static int pmix_plog_register(pmix_mca_base_register_flag_t flags)
     if (NULL != order) {
         pmix_plog_globals.channels = pmix_argv_split(order, ',');
     }
+    pmix_mca_base_var_register("pmix", "plog", "base", "queue_max",
+                               "Maximum number of requests waiting for the logging channels "
+                               "that can block (e.g., syslog, smtp) - those channels are run "
+                               "from a worker thread unless this is 0",
+                               PMIX_MCA_BASE_VAR_TYPE_INT,
+                               &pmix_plog_globals.queue_max);
+    pmix_mca_base_var_register("pmix", "plog", "base", "queue_block",
+                               "Wait for room when the queue of requests for the logging "
+                               "channels that can block is full, instead of dropping the "
+                               "request",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &pmix_plog_globals.queue_block);
     return PMIX_SUCCESS;
 }
 
@@ -67,6 +89,12 @@ static pmix_status_t pmix_plog_close(void)
     pmix_plog_globals.initialized = false;
     pmix_plog_globals.selected = false;
 
+    /* the worker may still be using the modules */
+    pmix_plog_base_stop_worker();
+    PMIX_LIST_DESTRUCT(&pmix_plog_globals.queue);
+    PMIX_DESTRUCT(&pmix_plog_globals.worker);
+    PMIX_DESTRUCT_LOCK(&pmix_plog_globals.qlock);
+
     for (n = 0; n < pmix_plog_globals.actives.size; n++) {
         if (NULL
             == (active = (pmix_plog_base_active_module_t *)
@@ -95,6 +123,15 @@ static pmix_status_t pmix_plog_open(pmix_mca_base_open_flag_t flags)
     pmix_pointer_array_init(&pmix_plog_globals.actives, 1, INT_MAX, 1);
     PMIX_CONSTRUCT_LOCK(&pmix_plog_globals.lock);
     pmix_plog_globals.lock.active = false;
+    PMIX_CONSTRUCT_LOCK(&pmix_plog_globals.qlock);
+    pmix_plog_globals.qlock.active = false;
+    PMIX_CONSTRUCT(&pmix_plog_globals.queue, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_plog_globals.worker, pmix_thread_t);
+    pmix_plog_globals.worker_started = false;
+    pmix_plog_globals.nqueued = 0;
+    pmix_plog_globals.ndropped = 0;
+    pmix_plog_globals.nblocked = 0;
+    pmix_plog_globals.hiwater = 0;
 
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_plog_base_framework, flags);
@@ -197,8 +197,14 @@ pmix_status_t pmix_plog_base_log(const pmix_proc_t *source,
     PMIX_LIST_FOREACH (active, &channels, pmix_plog_base_active_module_t) {
         if (NULL != active->module->log) {
             mycount->nreqs++;
-            rc = active->module->log(source, data, ndata, directives, ndirs, localcbfunc,
-                                     (void *) mycount);
+            if (active->module->blocking) {
+                /* keep it off the progress thread */
+                rc = pmix_plog_base_queue(active->module, source, data, ndata, directives,
+                                          ndirs, localcbfunc, (void *) mycount);
+            } else {
+                rc = active->module->log(source, data, ndata, directives, ndirs, localcbfunc,
+                                         (void *) mycount);
+            }
             /* The plugins are required to return:
              *
              * PMIX_SUCCESS - indicating that the logging operation for
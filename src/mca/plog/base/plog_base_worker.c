@@ -0,0 +1,197 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "pmix_common.h"
+#include "src/include/pmix_globals.h"
+
+#include "src/class/pmix_list.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/plog/base/base.h"
+
+/* Modules such as syslog and smtp can block for an arbitrary time
+ * (a backed-up journal, a slow mail server), so the base runs them
+ * on a worker thread of its own instead of the progress thread. The
+ * queue between the two is bounded - when it is full, the request is
+ * either refused (and counted as dropped) or the caller waits for
+ * room, depending on pmix_plog_base_queue_block */
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_plog_module_t *module;
+    /* the caller's source may be on its stack - the data and
+     * directives stay valid until the callback is executed */
+    pmix_proc_t source;
+    const pmix_info_t *data;
+    size_t ndata;
+    const pmix_info_t *directives;
+    size_t ndirs;
+    pmix_op_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_plog_work_t;
+static void wkcon(pmix_plog_work_t *p)
+{
+    p->module = NULL;
+    p->data = NULL;
+    p->ndata = 0;
+    p->directives = NULL;
+    p->ndirs = 0;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static PMIX_CLASS_INSTANCE(pmix_plog_work_t, pmix_list_item_t, wkcon, NULL);
+
+static void workcbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_plog_work_t *wk = (pmix_plog_work_t *) cbdata;
+
+    wk->cbfunc(status, wk->cbdata);
+    PMIX_RELEASE(wk);
+}
+
+static void execute(pmix_plog_work_t *wk)
+{
+    pmix_status_t rc;
+
+    rc = wk->module->log(&wk->source, wk->data, wk->ndata, wk->directives, wk->ndirs,
+                         workcbfunc, wk);
+    if (PMIX_OPERATION_IN_PROGRESS == rc) {
+        /* the module will execute the callback */
+        return;
+    }
+    /* the request was already counted as handled when it was
+     * queued, so a module that turns out to have nothing to do
+     * with it must not turn that into an error */
+    if (PMIX_ERR_NOT_AVAILABLE == rc || PMIX_ERR_TAKE_NEXT_OPTION == rc) {
+        rc = PMIX_SUCCESS;
+    }
+    workcbfunc(rc, wk);
+}
+
+static void *worker(pmix_object_t *obj)
+{
+    pmix_plog_work_t *wk;
+    PMIX_HIDE_UNUSED_PARAMS(obj);
+
+    pmix_mutex_lock(&pmix_plog_globals.qlock.mutex);
+    while (1) {
+        wk = (pmix_plog_work_t *) pmix_list_remove_first(&pmix_plog_globals.queue);
+        if (NULL == wk) {
+            if (pmix_plog_globals.worker_stop) {
+                break;
+            }
+            pmix_condition_wait(&pmix_plog_globals.qlock.cond, &pmix_plog_globals.qlock.mutex);
+            continue;
+        }
+        /* let anyone waiting for room know there is some - this
+         * must happen before we execute the request as the caller
+         * may be holding the lock its callback needs */
+        pmix_condition_broadcast(&pmix_plog_globals.qlock.cond);
+        pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+        execute(wk);
+        pmix_mutex_lock(&pmix_plog_globals.qlock.mutex);
+    }
+    pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+    return NULL;
+}
+
+pmix_status_t pmix_plog_base_queue(pmix_plog_module_t *module, const pmix_proc_t *source,
+                                   const pmix_info_t data[], size_t ndata,
+                                   const pmix_info_t directives[], size_t ndirs,
+                                   pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_plog_work_t *wk;
+    size_t depth;
+
+    if (0 >= pmix_plog_globals.queue_max) {
+        /* no worker - call the module directly */
+        return module->log(source, data, ndata, directives, ndirs, cbfunc, cbdata);
+    }
+
+    wk = PMIX_NEW(pmix_plog_work_t);
+    if (NULL == wk) {
+        return PMIX_ERR_NOMEM;
+    }
+    wk->module = module;
+    PMIX_LOAD_PROCID(&wk->source, source->nspace, source->rank);
+    wk->data = data;
+    wk->ndata = ndata;
+    wk->directives = directives;
+    wk->ndirs = ndirs;
+    wk->cbfunc = cbfunc;
+    wk->cbdata = cbdata;
+
+    pmix_mutex_lock(&pmix_plog_globals.qlock.mutex);
+    if (!pmix_plog_globals.worker_started) {
+        pmix_plog_globals.worker.t_run = worker;
+        pmix_plog_globals.worker.t_arg = NULL;
+        pmix_plog_globals.worker_stop = false;
+        if (PMIX_SUCCESS != pmix_thread_start(&pmix_plog_globals.worker)) {
+            pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+            PMIX_RELEASE(wk);
+            return module->log(source, data, ndata, directives, ndirs, cbfunc, cbdata);
+        }
+        pmix_plog_globals.worker_started = true;
+    }
+
+    depth = pmix_list_get_size(&pmix_plog_globals.queue);
+    if ((size_t) pmix_plog_globals.queue_max <= depth) {
+        if (!pmix_plog_globals.queue_block) {
+            ++pmix_plog_globals.ndropped;
+            pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+            pmix_output_verbose(2, pmix_plog_base_framework.framework_output,
+                                "plog:queue full - dropping request for %s",
+                                module->name);
+            PMIX_RELEASE(wk);
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        ++pmix_plog_globals.nblocked;
+        while ((size_t) pmix_plog_globals.queue_max
+               <= pmix_list_get_size(&pmix_plog_globals.queue)) {
+            pmix_condition_wait(&pmix_plog_globals.qlock.cond, &pmix_plog_globals.qlock.mutex);
+        }
+    }
+    pmix_list_append(&pmix_plog_globals.queue, &wk->super);
+    ++pmix_plog_globals.nqueued;
+    depth = pmix_list_get_size(&pmix_plog_globals.queue);
+    if (pmix_plog_globals.hiwater < depth) {
+        pmix_plog_globals.hiwater = depth;
+    }
+    pmix_condition_broadcast(&pmix_plog_globals.qlock.cond);
+    pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+
+    return PMIX_OPERATION_IN_PROGRESS;
+}
+
+/* let the worker finish whatever is queued, then stop it */
+void pmix_plog_base_stop_worker(void)
+{
+    pmix_mutex_lock(&pmix_plog_globals.qlock.mutex);
+    if (!pmix_plog_globals.worker_started) {
+        pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+        return;
+    }
+    pmix_plog_globals.worker_stop = true;
+    pmix_condition_broadcast(&pmix_plog_globals.qlock.cond);
+    pmix_mutex_unlock(&pmix_plog_globals.qlock.mutex);
+
+    pmix_thread_join(&pmix_plog_globals.worker, NULL);
+    pmix_plog_globals.worker_started = false;
+
+    pmix_output_verbose(1, pmix_plog_base_framework.framework_output,
+                        "plog:worker queued %lu dropped %lu blocked %lu max depth %lu",
+                        (unsigned long) pmix_plog_globals.nqueued,
+                        (unsigned long) pmix_plog_globals.ndropped,
+                        (unsigned long) pmix_plog_globals.nblocked,
+                        (unsigned long) pmix_plog_globals.hiwater);
+}
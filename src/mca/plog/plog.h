@@ -70,6 +70,10 @@ typedef struct {
     pmix_plog_base_module_init_fn_t init;
     pmix_plog_base_module_fini_fn_t finalize;
     pmix_plog_base_module_log_fn_t log;
+    /* the log function can block (e.g., network or system daemon
+     * transactions) - the base will call it from its worker thread
+     * instead of the progress thread */
+    bool blocking;
 } pmix_plog_module_t;
 
 /**
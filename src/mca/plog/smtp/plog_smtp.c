@@ -49,7 +49,12 @@ static pmix_status_t mylog(const pmix_proc_t *source, const pmix_info_t data[],
                            void *cbdata);
 
 /* Module */
-pmix_plog_module_t pmix_plog_smtp_module = {.name = "smtp", .channels = "email", .log = mylog};
+pmix_plog_module_t pmix_plog_smtp_module = {
+    .name = "smtp",
+    .channels = "email",
+    .log = mylog,
+    .blocking = true
+};
 
 typedef enum {
     SENT_NONE,
@@ -56,7 +56,8 @@ pmix_plog_module_t pmix_plog_syslog_module = {
     .name = "syslog",
     .init = init,
     .finalize = finalize,
-    .log = mylog
+    .log = mylog,
+    .blocking = true
 };
 
 static pmix_status_t init(void)
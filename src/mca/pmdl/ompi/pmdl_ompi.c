@@ -82,6 +82,10 @@ typedef struct {
     uint32_t job_size;
     uint32_t local_size;
     uint32_t num_apps;
+    /* the envars that are the same for every proc
+     * of the job - assembled when the first one is forked */
+    char **envnames;
+    char **envvals;
 } pmdl_nspace_t;
 static void nscon(pmdl_nspace_t *p)
 {
@@ -89,8 +93,15 @@ static void nscon(pmdl_nspace_t *p)
     p->job_size = UINT32_MAX;
     p->local_size = UINT32_MAX;
     p->num_apps = UINT32_MAX;
+    p->envnames = NULL;
+    p->envvals = NULL;
 }
-static PMIX_CLASS_INSTANCE(pmdl_nspace_t, pmix_list_item_t, nscon, NULL);
+static void nsdes(pmdl_nspace_t *p)
+{
+    pmix_argv_free(p->envnames);
+    pmix_argv_free(p->envvals);
+}
+static PMIX_CLASS_INSTANCE(pmdl_nspace_t, pmix_list_item_t, nscon, nsdes);
 
 /* internal variables */
 static pmix_list_t mynspaces;
@@ -436,6 +447,11 @@ static pmix_status_t register_nspace(pmix_namespace_t *nptr)
      * different info, so we really need to recheck those
      * values that haven't already been filled */
     PMIX_LOAD_PROCID(&wildcard, nptr->nspace, PMIX_RANK_WILDCARD);
+    /* and the envars built from them may change */
+    pmix_argv_free(ns->envnames);
+    ns->envnames = NULL;
+    pmix_argv_free(ns->envvals);
+    ns->envvals = NULL;
 
     /* fetch the universe size */
     if (UINT32_MAX == ns->univ_size) {
@@ -628,104 +644,58 @@ static pmix_status_t register_nspace(pmix_namespace_t *nptr)
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***priors)
+static void add_env(pmdl_nspace_t *ns, const char *name, const char *value)
+{
+    pmix_argv_append_nosize(&ns->envnames, name);
+    pmix_argv_append_nosize(&ns->envvals, value);
+}
+
+/* assemble the envars that are the same for every proc of the
+ * job, so forking each one only has to add its own */
+static pmix_status_t build_job_env(pmdl_nspace_t *ns, const pmix_proc_t *proc)
 {
-    pmdl_nspace_t *ns, *ns2;
     char *param;
     char *ev1, **tmp;
-    pmix_proc_t wildcard, undef;
+    pmix_proc_t undef;
     pmix_status_t rc;
-    uint16_t u16;
     pmix_kval_t *kv;
     pmix_info_t info[2];
     uint32_t n;
     pmix_cb_t cb;
 
-    pmix_output_verbose(2, pmix_pmdl_base_framework.framework_output,
-                        "pmdl:ompi: setup fork for %s", PMIX_NAME_PRINT(proc));
-
-    /* don't do OMPI again if already done */
-    if (NULL != *priors) {
-        char **t2 = *priors;
-        for (n = 0; NULL != t2[n]; n++) {
-            if (0 == strncmp(t2[n], "ompi", 4)) {
-                return PMIX_ERR_TAKE_NEXT_OPTION;
-            }
-        }
-    }
-    /* flag that we worked on this */
-    pmix_argv_append_nosize(priors, "ompi");
-
-    /* see if we already have this nspace */
-    ns = NULL;
-    PMIX_LIST_FOREACH (ns2, &mynspaces, pmdl_nspace_t) {
-        if (PMIX_CHECK_NSPACE(ns2->nspace, proc->nspace)) {
-            ns = ns2;
-            break;
-        }
-    }
-    if (NULL == ns) {
-        /* we don't know anything about this one or
-         * it doesn't have any ompi-based apps */
-        return PMIX_ERR_TAKE_NEXT_OPTION;
-    }
-
-    PMIX_LOAD_PROCID(&wildcard, proc->nspace, PMIX_RANK_WILDCARD);
     PMIX_LOAD_PROCID(&undef, proc->nspace, PMIX_RANK_UNDEF);
 
     /* pass universe size */
     if (0 > asprintf(&param, "%u", ns->univ_size)) {
         return PMIX_ERR_NOMEM;
     }
-    pmix_setenv("OMPI_UNIVERSE_SIZE", param, true, env);
+    add_env(ns, "OMPI_UNIVERSE_SIZE", param);
     free(param);
 
     /* pass the comm_world size in various formats */
     if (0 > asprintf(&param, "%u", ns->job_size)) {
         return PMIX_ERR_NOMEM;
     }
-    pmix_setenv("OMPI_COMM_WORLD_SIZE", param, true, env);
-    pmix_setenv("OMPI_WORLD_SIZE", param, true, env);
-    pmix_setenv("OMPI_MCA_num_procs", param, true, env);
+    add_env(ns, "OMPI_COMM_WORLD_SIZE", param);
+    add_env(ns, "OMPI_WORLD_SIZE", param);
+    add_env(ns, "OMPI_MCA_num_procs", param);
     free(param);
 
     /* pass the local size in various formats */
     if (0 > asprintf(&param, "%u", ns->local_size)) {
         return PMIX_ERR_NOMEM;
     }
-    pmix_setenv("OMPI_COMM_WORLD_LOCAL_SIZE", param, true, env);
-    pmix_setenv("OMPI_WORLD_LOCAL_SIZE", param, true, env);
+    add_env(ns, "OMPI_COMM_WORLD_LOCAL_SIZE", param);
+    add_env(ns, "OMPI_WORLD_LOCAL_SIZE", param);
     free(param);
 
     /* pass the number of apps in the job */
     if (0 > asprintf(&param, "%u", ns->num_apps)) {
         return PMIX_ERR_NOMEM;
     }
-    pmix_setenv("OMPI_NUM_APP_CTX", param, true, env);
+    add_env(ns, "OMPI_NUM_APP_CTX", param);
     free(param);
 
-    /* pass an envar so the proc can find any files it had prepositioned */
-    PMIX_CONSTRUCT(&cb, pmix_cb_t);
-    cb.proc = (pmix_proc_t *) proc;
-    cb.copy = true;
-    cb.key = PMIX_PROCDIR;
-    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-    cb.key = NULL;
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DESTRUCT(&cb);
-        return rc;
-    }
-    /* the data is the first value on the cb.kvs list */
-    if (1 != pmix_list_get_size(&cb.kvs)) {
-        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-        PMIX_DESTRUCT(&cb);
-        return PMIX_ERR_BAD_PARAM;
-    }
-    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
-    pmix_setenv("OMPI_FILE_LOCATION", kv->value->data.string, true, env);
-    PMIX_DESTRUCT(&cb);
-
     /* pass the cwd */
     PMIX_INFO_LOAD(&info[0], PMIX_APP_INFO, NULL, PMIX_BOOL);
     PMIX_CONSTRUCT(&cb, pmix_cb_t);
@@ -752,7 +722,7 @@ static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***pr
         return PMIX_ERR_BAD_PARAM;
     }
     kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
-    pmix_setenv("OMPI_MCA_initial_wdir", kv->value->data.string, true, env);
+    add_env(ns, "OMPI_MCA_initial_wdir", kv->value->data.string);
     PMIX_DESTRUCT(&cb);
     PMIX_INFO_DESTRUCT(&info[0]);
 
@@ -785,9 +755,9 @@ static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***pr
     tmp = pmix_argv_split(kv->value->data.string, ' ');
     PMIX_DESTRUCT(&cb);
     PMIX_INFO_DESTRUCT(&info[0]);
-    pmix_setenv("OMPI_COMMAND", tmp[0], true, env);
+    add_env(ns, "OMPI_COMMAND", tmp[0]);
     ev1 = pmix_argv_join(&tmp[1], ' ');
-    pmix_setenv("OMPI_ARGV", ev1, true, env);
+    add_env(ns, "OMPI_ARGV", ev1);
     free(ev1);
     pmix_argv_free(tmp);
 
@@ -797,77 +767,15 @@ static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***pr
     memset(&sysname, 0, sizeof(sysname));
     if (-1 < uname(&sysname)) {
         if (sysname.machine[0] != '\0') {
-            pmix_setenv("OMPI_MCA_cpu_type", (const char *) &sysname.machine, true, env);
+            add_env(ns, "OMPI_MCA_cpu_type", (const char *) &sysname.machine);
         }
     }
 #endif
 
-    /* pass the rank */
-    if (0 > asprintf(&param, "%lu", (unsigned long) proc->rank)) {
-        return PMIX_ERR_NOMEM;
-    }
-    pmix_setenv("OMPI_COMM_WORLD_RANK", param, true, env);
-    free(param); /* done with this now */
-
-    /* get the proc's local rank */
-    PMIX_CONSTRUCT(&cb, pmix_cb_t);
-    cb.proc = (pmix_proc_t *) proc;
-    cb.copy = true;
-    cb.key = PMIX_LOCAL_RANK;
-    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-    cb.key = NULL;
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DESTRUCT(&cb);
-        return rc;
-    }
-    /* the data is the first value on the cb.kvs list */
-    if (1 != pmix_list_get_size(&cb.kvs)) {
-        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-        PMIX_DESTRUCT(&cb);
-        return PMIX_ERR_BAD_PARAM;
-    }
-    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
-    u16 = kv->value->data.uint16;
-    PMIX_DESTRUCT(&cb);
-    if (0 > asprintf(&param, "%lu", (unsigned long) u16)) {
-        return PMIX_ERR_NOMEM;
-    }
-    pmix_setenv("OMPI_COMM_WORLD_LOCAL_RANK", param, true, env);
-    free(param);
-
-    /* get the proc's node rank */
-    PMIX_CONSTRUCT(&cb, pmix_cb_t);
-    cb.proc = (pmix_proc_t *) proc;
-    cb.copy = true;
-    cb.key = PMIX_NODE_RANK;
-    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-    cb.key = NULL;
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DESTRUCT(&cb);
-        return rc;
-    }
-    /* the data is the first value on the cb.kvs list */
-    if (1 != pmix_list_get_size(&cb.kvs)) {
-        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
-        PMIX_DESTRUCT(&cb);
-        return PMIX_ERR_BAD_PARAM;
-    }
-    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
-    u16 = kv->value->data.uint16;
-    PMIX_DESTRUCT(&cb);
-    if (0 > asprintf(&param, "%lu", (unsigned long) u16)) {
-        return PMIX_ERR_NOMEM;
-    }
-    pmix_setenv("OMPI_COMM_WORLD_NODE_RANK", param, true, env);
-    free(param);
-
     if (1 == ns->num_apps) {
         return PMIX_SUCCESS;
     }
 
-    PMIX_LOAD_PROCID(&undef, proc->nspace, PMIX_RANK_UNDEF);
     PMIX_INFO_LOAD(&info[0], PMIX_APP_INFO, NULL, PMIX_BOOL);
     tmp = NULL;
     for (n = 0; n < ns->num_apps; n++) {
@@ -905,7 +813,7 @@ static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***pr
     if (NULL != tmp) {
         ev1 = pmix_argv_join(tmp, ' ');
         pmix_argv_free(tmp);
-        pmix_setenv("OMPI_APP_CTX_NUM_PROCS", ev1, true, env);
+        add_env(ns, "OMPI_APP_CTX_NUM_PROCS", ev1);
         free(ev1);
     }
 
@@ -947,10 +855,154 @@ static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***pr
         ev1 = pmix_argv_join(tmp, ' ');
         pmix_argv_free(tmp);
         tmp = NULL;
-        pmix_setenv("OMPI_FIRST_RANKS", ev1, true, env);
+        add_env(ns, "OMPI_FIRST_RANKS", ev1);
         free(ev1);
     }
 
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t setup_fork(const pmix_proc_t *proc, char ***env, char ***priors)
+{
+    pmdl_nspace_t *ns, *ns2;
+    char *param;
+    char *ev1;
+    pmix_status_t rc;
+    uint16_t u16;
+    pmix_kval_t *kv;
+    uint32_t n;
+    pmix_cb_t cb;
+
+    pmix_output_verbose(2, pmix_pmdl_base_framework.framework_output,
+                        "pmdl:ompi: setup fork for %s", PMIX_NAME_PRINT(proc));
+
+    /* don't do OMPI again if already done */
+    if (NULL != *priors) {
+        char **t2 = *priors;
+        for (n = 0; NULL != t2[n]; n++) {
+            if (0 == strncmp(t2[n], "ompi", 4)) {
+                return PMIX_ERR_TAKE_NEXT_OPTION;
+            }
+        }
+    }
+    /* flag that we worked on this */
+    pmix_argv_append_nosize(priors, "ompi");
+
+    /* see if we already have this nspace */
+    ns = NULL;
+    PMIX_LIST_FOREACH (ns2, &mynspaces, pmdl_nspace_t) {
+        if (PMIX_CHECK_NSPACE(ns2->nspace, proc->nspace)) {
+            ns = ns2;
+            break;
+        }
+    }
+    if (NULL == ns) {
+        /* we don't know anything about this one or
+         * it doesn't have any ompi-based apps */
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    if (NULL == ns->envnames) {
+        rc = build_job_env(ns, proc);
+        if (PMIX_SUCCESS != rc) {
+            pmix_argv_free(ns->envnames);
+            ns->envnames = NULL;
+            pmix_argv_free(ns->envvals);
+            ns->envvals = NULL;
+            return rc;
+        }
+    }
+    for (n = 0; NULL != ns->envnames[n]; n++) {
+        pmix_setenv(ns->envnames[n], ns->envvals[n], true, env);
+    }
+
+    /* pass an envar so the proc can find any files it had prepositioned */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = (pmix_proc_t *) proc;
+    cb.copy = true;
+    cb.key = PMIX_PROCDIR;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    cb.key = NULL;
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    /* the data is the first value on the cb.kvs list */
+    if (1 != pmix_list_get_size(&cb.kvs)) {
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        PMIX_DESTRUCT(&cb);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+    pmix_setenv("OMPI_FILE_LOCATION", kv->value->data.string, true, env);
+    PMIX_DESTRUCT(&cb);
+
+    /* pass the rank */
+    if (0 > asprintf(&param, "%lu", (unsigned long) proc->rank)) {
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_setenv("OMPI_COMM_WORLD_RANK", param, true, env);
+    free(param); /* done with this now */
+
+    /* get the proc's local rank */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = (pmix_proc_t *) proc;
+    cb.copy = true;
+    cb.key = PMIX_LOCAL_RANK;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    cb.key = NULL;
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    /* the data is the first value on the cb.kvs list */
+    if (1 != pmix_list_get_size(&cb.kvs)) {
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        PMIX_DESTRUCT(&cb);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+    u16 = kv->value->data.uint16;
+    PMIX_DESTRUCT(&cb);
+    if (0 > asprintf(&param, "%lu", (unsigned long) u16)) {
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_setenv("OMPI_COMM_WORLD_LOCAL_RANK", param, true, env);
+    free(param);
+
+    /* get the proc's node rank */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = (pmix_proc_t *) proc;
+    cb.copy = true;
+    cb.key = PMIX_NODE_RANK;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    cb.key = NULL;
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    /* the data is the first value on the cb.kvs list */
+    if (1 != pmix_list_get_size(&cb.kvs)) {
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        PMIX_DESTRUCT(&cb);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+    u16 = kv->value->data.uint16;
+    PMIX_DESTRUCT(&cb);
+    if (0 > asprintf(&param, "%lu", (unsigned long) u16)) {
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_setenv("OMPI_COMM_WORLD_NODE_RANK", param, true, env);
+    free(param);
+
+    if (1 == ns->num_apps) {
+        return PMIX_SUCCESS;
+    }
+
     /* provide the reincarnation number */
     PMIX_CONSTRUCT(&cb, pmix_cb_t);
     cb.proc = (pmix_proc_t *) proc;
@@ -177,7 +177,47 @@ static PMIX_CLASS_INSTANCE(sshot_group_t, pmix_object_t, group_con, group_des);
 
 /* internal functions */
 size_t curl_callback (void *contents, size_t size, size_t nmemb, void *userp);
-static int ask_fabric_controller(char *vnid_url, char *vnid_username, char *credential, char *nodes, const char *fmt, vnid_response_t *response);
+static /* The fabric manager's VNI service is not yet queried - until it is,
+ * every job is given the same placeholder values */
+pmix_status_t pmix_pnet_sshot_lease_from_fabric(char **vni, int *tclass)
+{
+    *vni = strdup("VNI");
+    if (NULL == *vni) {
+        return PMIX_ERR_NOMEM;
+    }
+    *tclass = 1234;
+    return PMIX_SUCCESS;
+}
+
+int ask_fabric_controller(char *vnid_url, char *vnid_username, char *credential, char *nodes, const char *fmt, vnid_response_t *response);
+
+/* Relative costs between two NICs in the dragonfly: the same NIC,
+ * NICs on the same switch, on switches of the same group (one
+ * switch-to-switch hop), and in different groups (a global link) */
+static const uint16_t cost_levels[4] = {0, 1, 2, 3};
+
+/* Describe the costs by the switch and group of each NIC instead
+ * of a dense matrix, which does not scale to a full system */
+static pmix_data_array_t *cost_model(pmix_data_array_t *switches, pmix_data_array_t *groups)
+{
+    pmix_data_array_t *model, levels;
+    pmix_info_t *info;
+
+    PMIX_DATA_ARRAY_CREATE(model, 4, PMIX_INFO);
+    info = (pmix_info_t *) model->array;
+    PMIX_INFO_LOAD(&info[0], PMIX_FABRIC_COST_TYPE, "hierarchical", PMIX_STRING);
+    PMIX_LOAD_KEY(info[1].key, PMIX_FABRIC_COST_SWITCHES);
+    info[1].value.type = PMIX_DATA_ARRAY;
+    info[1].value.data.darray = switches;
+    PMIX_LOAD_KEY(info[2].key, PMIX_FABRIC_COST_GROUPS);
+    info[2].value.type = PMIX_DATA_ARRAY;
+    info[2].value.data.darray = groups;
+    levels.type = PMIX_UINT16;
+    levels.size = 4;
+    levels.array = (void *) cost_levels;
+    PMIX_INFO_LOAD(&info[3], PMIX_FABRIC_COST_LEVELS, &levels, PMIX_DATA_ARRAY);
+    return model;
+}
 
 pmix_status_t pmix_pnet_sshot_register_fabric(pmix_fabric_t *fabric, const pmix_info_t directives[],
                                               size_t ndirs, pmix_op_cbfunc_t cbfunc, void *cbdata)
@@ -189,6 +229,9 @@ pmix_status_t pmix_pnet_sshot_register_fabric(pmix_fabric_t *fabric, const pmix_
 
     int num_devices = 0, num_nodes = 0;
     int err = 0;
+    size_t num_nics = 0, idx = 0;
+    pmix_data_array_t *switches = NULL, *groups = NULL;
+    uint32_t *swids = NULL, *grpids = NULL;
     json_t *root = NULL, *macs = NULL, *devices = NULL;
     json_error_t jerr;
     vnid_response_t response;
@@ -248,6 +291,17 @@ pmix_status_t pmix_pnet_sshot_register_fabric(pmix_fabric_t *fabric, const pmix_
 	return PMIX_ERROR;
     }
 
+    /* the NICs are indexed in the order they are reported */
+    for (int i = 0; i < num_nodes; i++) {
+	num_nics += json_array_size(json_array_get(macs, i));
+    }
+    if (0 < num_nics) {
+	PMIX_DATA_ARRAY_CREATE(switches, num_nics, PMIX_UINT32);
+	PMIX_DATA_ARRAY_CREATE(groups, num_nics, PMIX_UINT32);
+	swids = (uint32_t *) switches->array;
+	grpids = (uint32_t *) groups->array;
+    }
+
     for (int i = 0; i < num_nodes; i++) {
 	json_t *mac_array = json_array_get(macs, i);
 	json_t *dev_array = json_array_get(devices, i);
@@ -284,6 +338,9 @@ pmix_status_t pmix_pnet_sshot_register_fabric(pmix_fabric_t *fabric, const pmix_
 	    }
 	    char *full_name = join_names(node_nic_name_size, nname, dev, node_nic_name_format);
 	    pmix_argv_append_nosize(&swtch->members, full_name);
+	    swids[idx] = coord.switch_id;
+	    grpids[idx] = coord.group_id;
+	    ++idx;
 	}
     }
     // now loop through all group objs, and each switch, and generate the string
@@ -314,10 +371,17 @@ pmix_status_t pmix_pnet_sshot_register_fabric(pmix_fabric_t *fabric, const pmix_
     }
     if (group_members) {
 	all_info = pmix_argv_join(group_members, ';');
-	PMIX_INFO_CREATE(fabric->info, 1);
-	fabric->ninfo = 1;
+	PMIX_INFO_CREATE(fabric->info, 3);
+	fabric->ninfo = 3;
 	PMIX_INFO_LOAD(&fabric->info[0], PMIX_FABRIC_GROUPS, all_info, PMIX_STRING);
 	free(all_info);
+	PMIX_INFO_LOAD(&fabric->info[1], PMIX_FABRIC_NUM_DEVICES, &num_nics, PMIX_SIZE);
+	PMIX_LOAD_KEY(fabric->info[2].key, PMIX_FABRIC_COST_MODEL);
+	fabric->info[2].value.type = PMIX_DATA_ARRAY;
+	fabric->info[2].value.data.darray = cost_model(switches, groups);
+    } else {
+	PMIX_DATA_ARRAY_FREE(switches);
+	PMIX_DATA_ARRAY_FREE(groups);
     }
     return PMIX_OPERATION_SUCCEEDED;
 }
@@ -0,0 +1,169 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <string.h>
+
+#include "pmix_common.h"
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_output.h"
+
+#include "pnet_sshot.h"
+#include "src/mca/pnet/base/base.h"
+
+/* Asking the fabric manager for a VNI and traffic class takes a round
+ * trip to it, and the launch of the job waits on that. When the pool
+ * is enabled, we hold a number of leases ready and hand one out when
+ * a job is allocated. A worker thread of our own tops the pool back
+ * up after each one is taken, so neither the launch nor the progress
+ * thread ever waits on the fabric manager unless the pool has run
+ * dry - in which case we lease one directly, as without the pool */
+
+typedef struct {
+    pmix_list_item_t super;
+    char *vni;
+    int tclass;
+} sshot_lease_t;
+static void lscon(sshot_lease_t *p)
+{
+    p->vni = NULL;
+    p->tclass = 0;
+}
+static void lsdes(sshot_lease_t *p)
+{
+    if (NULL != p->vni) {
+        free(p->vni);
+    }
+}
+static PMIX_CLASS_INSTANCE(sshot_lease_t, pmix_list_item_t, lscon, lsdes);
+
+static struct {
+    pmix_lock_t lock;
+    pmix_list_t leases;
+    pmix_thread_t worker;
+    bool started;
+    bool stop;
+    /* the last refill failed - wait until a lease is taken
+     * before asking the fabric manager again */
+    bool stalled;
+    size_t nhits;
+    size_t nmisses;
+} pool;
+
+static void *refill(pmix_object_t *obj)
+{
+    sshot_lease_t *ls;
+    pmix_status_t rc;
+    PMIX_HIDE_UNUSED_PARAMS(obj);
+
+    pmix_mutex_lock(&pool.lock.mutex);
+    while (1) {
+        if (pool.stop) {
+            break;
+        }
+        if (pool.stalled || (size_t) pmix_mca_pnet_sshot_component.pool_size
+                                <= pmix_list_get_size(&pool.leases)) {
+            pmix_condition_wait(&pool.lock.cond, &pool.lock.mutex);
+            continue;
+        }
+        pmix_mutex_unlock(&pool.lock.mutex);
+        ls = PMIX_NEW(sshot_lease_t);
+        rc = pmix_pnet_sshot_lease_from_fabric(&ls->vni, &ls->tclass);
+        pmix_mutex_lock(&pool.lock.mutex);
+        if (PMIX_SUCCESS != rc) {
+            pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                                "pnet:sshot cannot refill the lease pool: %s",
+                                PMIx_Error_string(rc));
+            PMIX_RELEASE(ls);
+            pool.stalled = true;
+            continue;
+        }
+        pmix_list_append(&pool.leases, &ls->super);
+    }
+    pmix_mutex_unlock(&pool.lock.mutex);
+    return NULL;
+}
+
+void pmix_pnet_sshot_pool_init(void)
+{
+    PMIX_CONSTRUCT_LOCK(&pool.lock);
+    PMIX_CONSTRUCT(&pool.leases, pmix_list_t);
+    PMIX_CONSTRUCT(&pool.worker, pmix_thread_t);
+    pool.started = false;
+    pool.stop = false;
+    pool.stalled = false;
+    pool.nhits = 0;
+    pool.nmisses = 0;
+
+    if (0 >= pmix_mca_pnet_sshot_component.pool_size) {
+        return;
+    }
+    /* the worker fills the pool as soon as it starts */
+    pool.worker.t_run = refill;
+    pool.worker.t_arg = NULL;
+    if (PMIX_SUCCESS != pmix_thread_start(&pool.worker)) {
+        pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                            "pnet:sshot cannot start the lease pool worker");
+        return;
+    }
+    pool.started = true;
+}
+
+void pmix_pnet_sshot_pool_finalize(void)
+{
+    if (pool.started) {
+        pmix_mutex_lock(&pool.lock.mutex);
+        pool.stop = true;
+        pmix_condition_broadcast(&pool.lock.cond);
+        pmix_mutex_unlock(&pool.lock.mutex);
+        pmix_thread_join(&pool.worker, NULL);
+        pool.started = false;
+
+        pmix_output_verbose(1, pmix_pnet_base_framework.framework_output,
+                            "pnet:sshot lease pool hits %lu misses %lu",
+                            (unsigned long) pool.nhits, (unsigned long) pool.nmisses);
+    }
+    PMIX_LIST_DESTRUCT(&pool.leases);
+    PMIX_DESTRUCT(&pool.worker);
+    PMIX_DESTRUCT_LOCK(&pool.lock);
+}
+
+pmix_status_t pmix_pnet_sshot_lease(char **vni, int *tclass)
+{
+    sshot_lease_t *ls = NULL;
+
+    if (pool.started) {
+        pmix_mutex_lock(&pool.lock.mutex);
+        ls = (sshot_lease_t *) pmix_list_remove_first(&pool.leases);
+        if (NULL != ls) {
+            ++pool.nhits;
+        } else {
+            ++pool.nmisses;
+        }
+        /* have the worker replace what we took - or try
+         * again if it gave up */
+        pool.stalled = false;
+        pmix_condition_broadcast(&pool.lock.cond);
+        pmix_mutex_unlock(&pool.lock.mutex);
+    }
+    if (NULL == ls) {
+        return pmix_pnet_sshot_lease_from_fabric(vni, tclass);
+    }
+
+    *vni = ls->vni;
+    ls->vni = NULL;
+    *tclass = ls->tclass;
+    PMIX_RELEASE(ls);
+    return PMIX_SUCCESS;
+}
@@ -69,11 +69,13 @@ static bool sessioninfo = false;
 
 static pmix_status_t sshot_init(void)
 {
+    pmix_pnet_sshot_pool_init();
     return PMIX_SUCCESS;
 }
 
 static void sshot_finalize(void)
 {
+    pmix_pnet_sshot_pool_finalize();
 }
 
 /* PMIx_server_setup_application calls the "allocate" function
@@ -288,9 +290,16 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
     }
     /* Get back the following:
      *
-     * VNI for the job
+     * VNI and traffic class for the job - from the pool of leases
+     * if one is being held ready, so we need not wait on the
+     * fabric manager
      */
-    vni = "VNI";
+    rc = pmix_pnet_sshot_lease(&vni, &tclass);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&mydata);
+        pmix_argv_free(nodes);
+        return rc;
+    }
     /* pack the security credential - I'm not sure what form the VNI is
      * in, but will assume for now that it is a string */
     PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &mydata, &vni, 1, PMIX_STRING);
@@ -307,7 +316,6 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
 
     /* Traffic class (if supported)
      */
-    tclass = 1234;
     /* pack the traffic class, if we have it - I'm not sure what form that
      * will take, but will assume for now that it is an integer */
     PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &mydata, &tclass, 1, PMIX_INT);
@@ -522,7 +530,8 @@ static pmix_status_t setup_local_network(pmix_nspace_env_cache_t *nptr,
             PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &hostname, &cnt, PMIX_STRING);
             while (PMIX_SUCCESS == rc) {
                 /* prep the node info data array */
-                PMIX_DATA_ARRAY_CREATE(ndinfo, 2, PMIX_INFO);
+                PMIX_DATA_ARRAY_CREATE(ndinfo, pmix_mca_pnet_sshot_component.compact_endpts ? 3 : 2,
+                                       PMIX_INFO);
                 itmp = (pmix_info_t *) ndinfo->array;
 
                 /* insert the name into the nodeinfo array */
@@ -576,6 +585,24 @@ static pmix_status_t setup_local_network(pmix_nspace_env_cache_t *nptr,
                 darray->array = geometry;
                 PMIX_INFO_LOAD(&itmp[1], PMIX_FABRIC_COORDINATES, darray, PMIX_DATA_ARRAY);
 
+                if (pmix_mca_pnet_sshot_component.compact_endpts) {
+                    /* everything but the local rank is common to the procs
+                     * on this node, so store it once for the node */
+                    PMIX_ENDPOINT_CREATE(endpts, ndevs);
+                    for (d = 0; d < ndevs; d++) {
+                        endpts[d].uuid = strdup(xnames[d]);
+                        endpts[d].osname = strdup(osnames[d]);
+                        endpts[d].endpt.bytes = strdup(macs[d]);
+                        endpts[d].endpt.size = strlen(macs[d]) + 1;
+                    }
+                    darray = (pmix_data_array_t *) malloc(sizeof(pmix_data_array_t));
+                    darray->type = PMIX_ENDPOINT;
+                    darray->size = ndevs;
+                    darray->array = endpts;
+                    PMIX_INFO_LOAD(&itmp[2], PMIX_PNET_SSHOT_ENDPT_TEMPLATE, darray,
+                                   PMIX_DATA_ARRAY);
+                }
+
                 /* store it */
                 proc.rank = PMIX_RANK_WILDCARD;
                 PMIX_KVAL_NEW(kv, PMIX_NODE_INFO_ARRAY);
@@ -589,7 +616,10 @@ static pmix_status_t setup_local_network(pmix_nspace_env_cache_t *nptr,
                 }
 
                 /* get the list of local peers for this node */
-                if (0 < pmix_mca_pnet_sshot_component.numnodes) {
+                prs = NULL;
+                if (pmix_mca_pnet_sshot_component.compact_endpts) {
+                    /* the template covers them */
+                } else if (0 < pmix_mca_pnet_sshot_component.numnodes) {
                     if (0 < pmix_mca_pnet_sshot_component.ppn) {
                         /* simulating procs */
                         prs = NULL;
@@ -645,9 +675,9 @@ static pmix_status_t setup_local_network(pmix_nspace_env_cache_t *nptr,
                         darray->array = endpts;
                         /* for each fabric device, provide an endpt */
                         for (d = 0; d < ndevs; d++) {
-                            endpts[m].uuid = strdup(xnames[d]);
-                            endpts[m].osname = strdup(osnames[d]);
-                            compute_endpoint(&endpts[m], macs[d], m);
+                            endpts[d].uuid = strdup(xnames[d]);
+                            endpts[d].osname = strdup(osnames[d]);
+                            compute_endpoint(&endpts[d], macs[d], m);
                         }
                         /* store the result */
                         proc.rank = strtoul(prs[m], NULL, 10);
@@ -26,6 +26,8 @@ typedef struct {
     char *nodes;
     int numnodes;
     int ppn;
+    bool compact_endpts;
+    int pool_size;
 } pmix_pnet_sshot_component_t;
 
 /* the component must be visible data for the linker to find it */
@@ -35,11 +37,25 @@ PMIX_EXPORT extern pmix_pnet_module_t pmix_sshot_module;
 /* define a key for any blob we need to send in a launch msg */
 #define PMIX_PNET_SSHOT_BLOB "pmix.pnet.sshot.blob"
 
+/* key for the per-node endpoint template stored in the node info
+ * array when compact_endpts is set. It is an array of pmix_endpoint_t,
+ * one per NIC, whose endpt field holds the NIC's MAC address - the
+ * endpoint of a proc on that NIC is "<mac>:<local rank>" */
+#define PMIX_PNET_SSHOT_ENDPT_TEMPLATE "pmix.pnet.sshot.eptmpl"
+
 PMIX_EXPORT pmix_status_t pmix_pnet_sshot_register_fabric(pmix_fabric_t *fabric,
                                                           const pmix_info_t directives[],
                                                           size_t ndirs, pmix_op_cbfunc_t cbfunc,
                                                           void *cbdata);
 
+/* lease a VNI and traffic class for a job from the fabric manager */
+PMIX_EXPORT pmix_status_t pmix_pnet_sshot_lease_from_fabric(char **vni, int *tclass);
+
+/* the pool of leases held ready for jobs */
+PMIX_EXPORT void pmix_pnet_sshot_pool_init(void);
+PMIX_EXPORT void pmix_pnet_sshot_pool_finalize(void);
+PMIX_EXPORT pmix_status_t pmix_pnet_sshot_lease(char **vni, int *tclass);
+
 END_C_DECLS
 
 #endif
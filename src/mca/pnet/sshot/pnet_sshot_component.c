@@ -68,7 +68,9 @@ pmix_pnet_sshot_component_t pmix_mca_pnet_sshot_component = {
     .vnid_url = NULL,
     .nodes = NULL,
     .numnodes = 0,
-    .ppn = 0
+    .ppn = 0,
+    .compact_endpts = false,
+    .pool_size = 0
 };
 
 static pmix_status_t component_register(void)
@@ -106,6 +108,21 @@ static pmix_status_t component_register(void)
         PMIX_MCA_BASE_VAR_TYPE_INT,
         &pmix_mca_pnet_sshot_component.numnodes);
 
+    (void) pmix_mca_base_component_var_register(
+        component, "compact_endpts",
+        "Store one template of the fabric endpoints on each node instead of "
+        "an array of endpoints for every local proc (default: false)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_mca_pnet_sshot_component.compact_endpts);
+
+    (void) pmix_mca_base_component_var_register(
+        component, "pool_size",
+        "Number of VNI and traffic class leases to hold ready for jobs, refilled "
+        "from the fabric manager in the background (default: 0 - lease them when "
+        "each job is allocated)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_mca_pnet_sshot_component.pool_size);
+
     return PMIX_SUCCESS;
 }
 
@@ -30,6 +30,7 @@
 
 #include "pmix_common.h"
 
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
 #include "src/include/pmix_socket_errno.h"
@@ -80,20 +81,26 @@ typedef struct {
     char *address;
 } tcp_device_t;
 
-/* local tracker objects */
+/* local tracker objects - the static ports of each type/plane
+ * are held as an array of port numbers with a bitmap marking
+ * those handed out, so assignments and releases for large
+ * jobs don't have to search and copy strings */
 typedef struct {
     pmix_list_item_t super;
     pmix_list_t devices;
     char *type;
     char *plane;
-    char **ports;
+    uint16_t *ports;
     size_t nports;
+    pmix_bitmap_t inuse;
+    size_t nfree;
 } tcp_available_ports_t;
 
 typedef struct {
     pmix_list_item_t super;
     char *nspace;
-    char **ports;
+    int *slots; // indices into src->ports of the assigned ports
+    size_t nslots;
     tcp_available_ports_t *src; // source of the allocated ports
 } tcp_port_tracker_t;
 
@@ -124,6 +131,8 @@ static void tacon(tcp_available_ports_t *p)
     p->plane = NULL;
     p->ports = NULL;
     p->nports = 0;
+    PMIX_CONSTRUCT(&p->inuse, pmix_bitmap_t);
+    p->nfree = 0;
 }
 static void tades(tcp_available_ports_t *p)
 {
@@ -135,42 +144,36 @@ static void tades(tcp_available_ports_t *p)
         free(p->plane);
     }
     if (NULL != p->ports) {
-        pmix_argv_free(p->ports);
+        free(p->ports);
     }
+    PMIX_DESTRUCT(&p->inuse);
 }
 static PMIX_CLASS_INSTANCE(tcp_available_ports_t, pmix_list_item_t, tacon, tades);
 
 static void ttcon(tcp_port_tracker_t *p)
 {
     p->nspace = NULL;
-    p->ports = NULL;
+    p->slots = NULL;
+    p->nslots = 0;
     p->src = NULL;
 }
 static void ttdes(tcp_port_tracker_t *p)
 {
-    size_t n, m, mstart;
+    size_t n;
 
     if (NULL != p->nspace) {
         free(p->nspace);
     }
     if (NULL != p->src) {
-        if (NULL != p->ports) {
-            mstart = 0;
-            for (n = 0; NULL != p->ports[n]; n++) {
-                /* find an empty position */
-                for (m = mstart; m < p->src->nports; m++) {
-                    if (NULL == p->src->ports[m]) {
-                        p->src->ports[m] = strdup(p->ports[n]);
-                        mstart = m + 1;
-                        break;
-                    }
-                }
-            }
-            pmix_argv_free(p->ports);
+        /* return the ports to the pool */
+        for (n = 0; n < p->nslots; n++) {
+            pmix_bitmap_clear_bit(&p->src->inuse, p->slots[n]);
         }
+        p->src->nfree += p->nslots;
         PMIX_RELEASE(p->src); // maintain accounting
-    } else if (NULL != p->ports) {
-        pmix_argv_free(p->ports);
+    }
+    if (NULL != p->slots) {
+        free(p->slots);
     }
 }
 static PMIX_CLASS_INSTANCE(tcp_port_tracker_t, pmix_list_item_t, ttcon, ttdes);
@@ -178,8 +181,8 @@ static PMIX_CLASS_INSTANCE(tcp_port_tracker_t, pmix_list_item_t, ttcon, ttdes);
 static pmix_status_t tcp_init(void)
 {
     tcp_available_ports_t *trk;
-    char *p, **grps;
-    size_t n;
+    char *p, **grps, **ports = NULL;
+    size_t n, m;
 
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output, "pnet: tcp init");
 
@@ -218,8 +221,23 @@ static pmix_status_t tcp_init(void)
         /* extract the ports */
         *p = '\0';
         ++p;
-        pmix_util_parse_range_options(p, &trk->ports);
-        trk->nports = pmix_argv_count(trk->ports);
+        pmix_util_parse_range_options(p, &ports);
+        trk->nports = pmix_argv_count(ports);
+        if (0 < trk->nports) {
+            trk->ports = (uint16_t *) malloc(trk->nports * sizeof(uint16_t));
+            if (NULL == trk->ports
+                || PMIX_SUCCESS != pmix_bitmap_init(&trk->inuse, (int) trk->nports)) {
+                pmix_argv_free(ports);
+                pmix_argv_free(grps);
+                return PMIX_ERR_NOMEM;
+            }
+            for (m = 0; m < trk->nports; m++) {
+                trk->ports[m] = (uint16_t) strtoul(ports[m], NULL, 10);
+            }
+            trk->nfree = trk->nports;
+        }
+        pmix_argv_free(ports);
+        ports = NULL;
         /* see if they provided a plane */
         if (NULL != (p = strchr(grps[n], ':'))) {
             /* yep - save the plane */
@@ -957,54 +975,55 @@ static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
 static pmix_status_t process_request(pmix_namespace_t *nptr, char *idkey, int ports_per_node,
                                      tcp_port_tracker_t *trk, pmix_list_t *ilist)
 {
-    char **plist;
     pmix_kval_t *kv;
-    size_t m;
-    int p, ppn;
+    char *plist, *ptr;
+    int p, ppn, slot;
     tcp_available_ports_t *avail = trk->src;
 
+    if (0 == ports_per_node) {
+        /* find the maxprocs on the nodes in this nspace and
+         * allocate that number of resources */
+        return PMIX_ERR_NOT_SUPPORTED;
+    } else {
+        ppn = ports_per_node;
+    }
+    /* if there aren't enough, then that's an error */
+    if (avail->nfree < (size_t) ppn) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+
     kv = PMIX_NEW(pmix_kval_t);
     if (NULL == kv) {
         return PMIX_ERR_NOMEM;
     }
     kv->key = strdup(idkey);
     kv->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-    if (NULL == kv->value) {
+    trk->slots = (int *) malloc(ppn * sizeof(int));
+    /* room for each port as up to five digits and a comma */
+    plist = (char *) malloc(ppn * 6 + 1);
+    if (NULL == kv->value || NULL == trk->slots || NULL == plist) {
         PMIX_RELEASE(kv);
+        free(plist);
         return PMIX_ERR_NOMEM;
     }
-    kv->value->type = PMIX_STRING;
-    kv->value->data.string = NULL;
-    if (0 == ports_per_node) {
-        /* find the maxprocs on the nodes in this nspace and
-         * allocate that number of resources */
-        return PMIX_ERR_NOT_SUPPORTED;
-    } else {
-        ppn = ports_per_node;
-    }
 
-    /* assemble the list of ports */
-    p = 0;
-    plist = NULL;
-    for (m = 0; p < ppn && m < avail->nports; m++) {
-        if (NULL != avail->ports[m]) {
-            pmix_argv_append_nosize(&trk->ports, avail->ports[m]);
-            pmix_argv_append_nosize(&plist, avail->ports[m]);
-            free(avail->ports[m]);
-            avail->ports[m] = NULL;
-            ++p;
+    /* take the ports from the pool and list them */
+    ptr = plist;
+    for (p = 0; p < ppn; p++) {
+        if (PMIX_SUCCESS != pmix_bitmap_find_and_set_first_unset_bit(&avail->inuse, &slot)) {
+            PMIX_RELEASE(kv);
+            free(plist);
+            /* the caller will release trk, and that will return
+             * any allocated ports back to the pool */
+            return PMIX_ERR_OUT_OF_RESOURCE;
         }
-    }
-    /* if we couldn't find enough, then that's an error */
-    if (p < ppn) {
-        PMIX_RELEASE(kv);
-        /* the caller will release trk, and that will return
-         * any allocated ports back to the available list */
-        return PMIX_ERR_OUT_OF_RESOURCE;
+        trk->slots[trk->nslots++] = slot;
+        --avail->nfree;
+        ptr += sprintf(ptr, "%s%u", (0 == p) ? "" : ",", (unsigned) avail->ports[slot]);
     }
     /* pass the value */
-    kv->value->data.string = pmix_argv_join(plist, ',');
-    pmix_argv_free(plist);
+    kv->value->type = PMIX_STRING;
+    kv->value->data.string = plist;
     pmix_list_append(ilist, &kv->super);
 
     /* track where it came from */
@@ -1140,14 +1159,13 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo, pmix_in
                 PMIX_LIST_FOREACH (lt, &nd->resources, pmix_pnet_resource_t) {
                     if (0 == strcmp(lt->name, "tcp")) {
                         PMIX_LIST_FOREACH (prts, &lt->resources, tcp_available_ports_t) {
-                            device = NULL;
-                            if (NULL != prts->ports) {
-                                device = pmix_argv_join(prts->ports, ',');
-                            }
-                            pmix_output(0, "\tPorts: %s",
-                                        (NULL == device) ? "UNSPECIFIED" : device);
-                            if (NULL != device) {
-                                free(device);
+                            if (0 == prts->nports) {
+                                pmix_output(0, "\tPorts: UNSPECIFIED");
+                            } else {
+                                pmix_output(0, "\tPorts: %lu from %u, %lu free",
+                                            (unsigned long) prts->nports,
+                                            (unsigned) prts->ports[0],
+                                            (unsigned long) prts->nfree);
                             }
                             PMIX_LIST_FOREACH (res, &prts->devices, tcp_device_t) {
                                 pmix_output(0, "\tDevice: %s", res->device);
@@ -78,8 +78,14 @@ PMIX_EXPORT extern pmix_preg_globals_t pmix_preg_globals;
 
 PMIX_EXPORT pmix_status_t pmix_preg_base_generate_node_regex(const char *input, char **regex);
 PMIX_EXPORT pmix_status_t pmix_preg_base_generate_ppn(const char *input, char **ppn);
+PMIX_EXPORT pmix_status_t pmix_preg_base_generate_ppn_ranks(const pmix_rank_t **ranks,
+                                                            const size_t *nranks, size_t nnodes,
+                                                            char **ppn);
 PMIX_EXPORT pmix_status_t pmix_preg_base_parse_nodes(const char *regexp, char ***names);
 PMIX_EXPORT pmix_status_t pmix_preg_base_parse_procs(const char *regexp, char ***procs);
+PMIX_EXPORT pmix_status_t pmix_preg_base_parse_nodes_stream(const char *regexp,
+                                                           pmix_preg_base_node_cbfunc_t cbfunc,
+                                                           void *cbdata);
 PMIX_EXPORT pmix_status_t pmix_preg_base_copy(char **dest, size_t *len, const char *input);
 
 PMIX_EXPORT pmix_status_t pmix_preg_base_pack(pmix_buffer_t *buffer, const char *input);
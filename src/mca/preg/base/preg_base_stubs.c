@@ -66,6 +66,87 @@ pmix_status_t pmix_preg_base_generate_ppn(const char *input, char **ppn)
     return PMIX_SUCCESS;
 }
 
+/* print the ranks in the string form taken by generate_ppn */
+static char *print_ranks(const pmix_rank_t **ranks, const size_t *nranks, size_t nnodes)
+{
+    char *str, *tmp;
+    size_t n, m, len = 0, size = 64;
+    int k;
+
+    str = (char *) malloc(size);
+    if (NULL == str) {
+        return NULL;
+    }
+    str[0] = '\0';
+    for (n = 0; n < nnodes; n++) {
+        for (m = 0; m < nranks[n]; m++) {
+            /* room for the rank and a separator */
+            if (len + 16 > size) {
+                size *= 2;
+                tmp = (char *) realloc(str, size);
+                if (NULL == tmp) {
+                    free(str);
+                    return NULL;
+                }
+                str = tmp;
+            }
+            k = snprintf(str + len, size - len, "%s%u", (0 == m) ? "" : ",", ranks[n][m]);
+            len += k;
+        }
+        if (n < nnodes - 1) {
+            if (len + 2 > size) {
+                size *= 2;
+                tmp = (char *) realloc(str, size);
+                if (NULL == tmp) {
+                    free(str);
+                    return NULL;
+                }
+                str = tmp;
+            }
+            str[len++] = ';';
+            str[len] = '\0';
+        }
+    }
+    return str;
+}
+
+pmix_status_t pmix_preg_base_generate_ppn_ranks(const pmix_rank_t **ranks, const size_t *nranks,
+                                                size_t nnodes, char **ppn)
+{
+    pmix_preg_base_active_module_t *active;
+    char *input = NULL;
+
+    /* keep to the priority order of the modules - those that only
+     * take the string form get it printed for them */
+    PMIX_LIST_FOREACH (active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
+        if (NULL != active->module->generate_ppn_ranks) {
+            if (PMIX_SUCCESS == active->module->generate_ppn_ranks(ranks, nranks, nnodes, ppn)) {
+                goto done;
+            }
+        } else if (NULL != active->module->generate_ppn) {
+            if (NULL == input && NULL == (input = print_ranks(ranks, nranks, nnodes))) {
+                return PMIX_ERR_NOMEM;
+            }
+            if (PMIX_SUCCESS == active->module->generate_ppn(input, ppn)) {
+                goto done;
+            }
+        }
+    }
+
+    /* no regex could be generated */
+    if (NULL == input && NULL == (input = print_ranks(ranks, nranks, nnodes))) {
+        return PMIX_ERR_NOMEM;
+    }
+    *ppn = input;
+    return PMIX_SUCCESS;
+
+done:
+    if (NULL != input) {
+        free(input);
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_preg_base_parse_nodes(const char *regexp, char ***names)
 {
     pmix_preg_base_active_module_t *active;
@@ -83,6 +164,64 @@ pmix_status_t pmix_preg_base_parse_nodes(const char *regexp, char ***names)
     return PMIX_SUCCESS;
 }
 
+pmix_status_t pmix_preg_base_parse_nodes_stream(const char *regexp,
+                                                pmix_preg_base_node_cbfunc_t cbfunc,
+                                                void *cbdata)
+{
+    pmix_preg_base_active_module_t *active;
+    pmix_status_t rc;
+    char *tmp, *ptr, *name;
+    char **names;
+    int n;
+
+    PMIX_LIST_FOREACH (active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
+        if (NULL != active->module->parse_nodes_stream) {
+            rc = active->module->parse_nodes_stream(regexp, cbfunc, cbdata);
+            if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+                return rc;
+            }
+        } else if (NULL != active->module->parse_nodes) {
+            /* this module can only give us the full list */
+            names = NULL;
+            if (PMIX_SUCCESS == active->module->parse_nodes(regexp, &names)) {
+                rc = PMIX_SUCCESS;
+                for (n = 0; NULL != names && NULL != names[n]; n++) {
+                    if (PMIX_SUCCESS != (rc = cbfunc(names[n], cbdata))) {
+                        break;
+                    }
+                }
+                pmix_argv_free(names);
+                return rc;
+            }
+        }
+    }
+
+    /* nobody could parse it, so it must be a comma-delimited
+     * list - walk it in place, skipping empty entries */
+    if (NULL == regexp) {
+        return PMIX_SUCCESS;
+    }
+    tmp = strdup(regexp);
+    if (NULL == tmp) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = PMIX_SUCCESS;
+    name = tmp;
+    while (NULL != name) {
+        ptr = strchr(name, ',');
+        if (NULL != ptr) {
+            *ptr = '\0';
+            ++ptr;
+        }
+        if ('\0' != *name && PMIX_SUCCESS != (rc = cbfunc(name, cbdata))) {
+            break;
+        }
+        name = ptr;
+    }
+    free(tmp);
+    return rc;
+}
+
 pmix_status_t pmix_preg_base_parse_procs(const char *regexp, char ***procs)
 {
     pmix_preg_base_active_module_t *active;
@@ -0,0 +1,835 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#include <ctype.h>
+#include <stdio.h>
+
+#include "include/pmix.h"
+#include "pmix_common.h"
+
+#include "src/class/pmix_hash_table.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_printf.h"
+
+#include "preg_binmap.h"
+#include "src/mca/preg/base/base.h"
+
+/* A binary map is a NUL-terminated header of the form
+ * "binmap:<len>:" followed by <len> bytes of payload. All
+ * numeric fields in the payload are LEB128 varints.
+ *
+ * Node map payload:
+ *    kind ('N'), ntemplates, then for each template the
+ *    prefix length and bytes, the suffix length and bytes,
+ *    and the numeric format (0 => no number, 1 => unpadded,
+ *    >1 => zero-padded to that width)
+ *    nnodes, nruns, then for each run the template index and,
+ *    for numbered templates, the zigzag offset of the first
+ *    number from the end of the prior run plus the run length
+ *
+ * Proc map payload:
+ *    kind ('P'), nnodes, ngroups, then for each group the number
+ *    of consecutive nodes sharing the same layout, that layout's
+ *    number of rank ranges, and for each range the zigzag offset
+ *    of its first rank from the end of the prior range plus its
+ *    length. A block-mapped job thus encodes in a handful of bytes
+ *    regardless of the number of nodes
+ */
+
+#define PREG_BINMAP_PREFIX     "binmap:"
+#define PREG_BINMAP_NODES      'N'
+#define PREG_BINMAP_PROCS      'P'
+#define PREG_BINMAP_MAX_DIGITS 18
+
+static pmix_status_t generate_node_regex(const char *input, char **regex);
+static pmix_status_t generate_ppn(const char *input, char **ppn);
+static pmix_status_t parse_nodes(const char *regexp, char ***names);
+static pmix_status_t parse_procs(const char *regexp, char ***procs);
+static pmix_status_t copy(char **dest, size_t *len, const char *input);
+static pmix_status_t pack(pmix_buffer_t *buffer, const char *input);
+static pmix_status_t unpack(pmix_buffer_t *buffer, char **regex);
+static pmix_status_t release(char *regexp);
+static pmix_status_t parse_nodes_stream(const char *regexp, pmix_preg_base_node_cbfunc_t cbfunc,
+                                        void *cbdata);
+
+pmix_preg_module_t pmix_preg_binmap_module = {
+    .name = "binmap",
+    .generate_node_regex = generate_node_regex,
+    .generate_ppn = generate_ppn,
+    .parse_nodes = parse_nodes,
+    .parse_procs = parse_procs,
+    .copy = copy,
+    .pack = pack,
+    .unpack = unpack,
+    .release = release,
+    .parse_nodes_stream = parse_nodes_stream
+};
+
+typedef struct {
+    uint8_t *bytes;
+    size_t len;
+    size_t size;
+} binmap_buf_t;
+
+typedef struct {
+    const char *prefix;
+    size_t plen;
+    const char *suffix;
+    size_t slen;
+    uint64_t fmt;
+} binmap_template_t;
+
+static bool put_bytes(binmap_buf_t *buf, const void *src, size_t len)
+{
+    uint8_t *tmp;
+    size_t need;
+
+    need = buf->len + len;
+    if (need > buf->size) {
+        if (need < 2 * buf->size) {
+            need = 2 * buf->size;
+        }
+        if (need < 64) {
+            need = 64;
+        }
+        tmp = (uint8_t *) realloc(buf->bytes, need);
+        if (NULL == tmp) {
+            return false;
+        }
+        buf->bytes = tmp;
+        buf->size = need;
+    }
+    memcpy(&buf->bytes[buf->len], src, len);
+    buf->len += len;
+    return true;
+}
+
+static bool put_varint(binmap_buf_t *buf, uint64_t val)
+{
+    uint8_t tmp[10];
+    size_t n = 0;
+
+    do {
+        tmp[n] = val & 0x7f;
+        val >>= 7;
+        if (0 != val) {
+            tmp[n] |= 0x80;
+        }
+        ++n;
+    } while (0 != val);
+    return put_bytes(buf, tmp, n);
+}
+
+static bool get_varint(const uint8_t **ptr, const uint8_t *end, uint64_t *val)
+{
+    const uint8_t *p = *ptr;
+    uint64_t v = 0;
+    int shift = 0;
+
+    while (p < end && shift < 64) {
+        v |= (uint64_t) (*p & 0x7f) << shift;
+        if (0 == (*p++ & 0x80)) {
+            *val = v;
+            *ptr = p;
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+static uint64_t zigzag(int64_t val)
+{
+    return ((uint64_t) val << 1) ^ (uint64_t) (val >> 63);
+}
+
+static int64_t unzigzag(uint64_t val)
+{
+    return (int64_t) (val >> 1) ^ -(int64_t) (val & 1);
+}
+
+/* wrap the payload in our header */
+static pmix_status_t finish_map(binmap_buf_t *buf, char **regexp)
+{
+    char *result;
+    int hlen;
+
+    hlen = pmix_asprintf(&result, "%s%lu:", PREG_BINMAP_PREFIX, (unsigned long) buf->len);
+    if (0 > hlen) {
+        return PMIX_ERR_NOMEM;
+    }
+    result = (char *) realloc(result, hlen + 1 + buf->len);
+    if (NULL == result) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(&result[hlen + 1], buf->bytes, buf->len);
+    *regexp = result;
+    return PMIX_SUCCESS;
+}
+
+/* check the header and return the payload bounds */
+static bool open_map(const char *regexp, char kind, const uint8_t **ptr, const uint8_t **end)
+{
+    unsigned long len;
+    char *eptr;
+
+    if (NULL == regexp || 0 != strncmp(regexp, PREG_BINMAP_PREFIX, strlen(PREG_BINMAP_PREFIX))) {
+        return false;
+    }
+    len = strtoul(&regexp[strlen(PREG_BINMAP_PREFIX)], &eptr, 10);
+    if (':' != *eptr || '\0' != eptr[1] || 0 == len) {
+        return false;
+    }
+    *ptr = (const uint8_t *) &eptr[2];
+    *end = *ptr + len;
+    if (kind != (char) **ptr) {
+        return false;
+    }
+    ++(*ptr);
+    return true;
+}
+
+static size_t total_len(const char *input)
+{
+    unsigned long len;
+
+    len = strtoul(&input[strlen(PREG_BINMAP_PREFIX)], NULL, 10);
+    return strlen(input) + 1 + len;
+}
+
+/* split a name into a template and the value of its
+ * last run of digits */
+static void split_name(const char *name, binmap_template_t *tmpl, uint64_t *val)
+{
+    size_t len, s, e;
+
+    memset(tmpl, 0, sizeof(binmap_template_t));
+    *val = 0;
+    len = strlen(name);
+    tmpl->prefix = name;
+    tmpl->plen = len;
+    tmpl->suffix = &name[len];
+
+    for (e = len; 0 < e && !isdigit((unsigned char) name[e - 1]); e--) {
+        continue;
+    }
+    if (0 == e) {
+        return;
+    }
+    for (s = e; 0 < s && isdigit((unsigned char) name[s - 1]); s--) {
+        continue;
+    }
+    if (PREG_BINMAP_MAX_DIGITS < e - s) {
+        return;
+    }
+    tmpl->plen = s;
+    tmpl->suffix = &name[e];
+    tmpl->slen = len - e;
+    if ('0' == name[s] && 1 < e - s) {
+        tmpl->fmt = e - s;
+    } else {
+        tmpl->fmt = 1;
+    }
+    *val = strtoull(&name[s], NULL, 10);
+}
+
+/* see if the name is the next one in the given run */
+static bool continues_run(const binmap_template_t *tmpl, uint64_t next, const char *name)
+{
+    char digits[PREG_BINMAP_MAX_DIGITS + 2];
+    size_t len;
+    int n;
+
+    if (0 == tmpl->fmt) {
+        return false;
+    }
+    if (0 != strncmp(name, tmpl->prefix, tmpl->plen)) {
+        return false;
+    }
+    if (1 == tmpl->fmt) {
+        n = snprintf(digits, sizeof(digits), "%llu", (unsigned long long) next);
+    } else {
+        n = snprintf(digits, sizeof(digits), "%0*llu", (int) tmpl->fmt, (unsigned long long) next);
+    }
+    if (0 > n || (size_t) n >= sizeof(digits)) {
+        return false;
+    }
+    len = n;
+    if (0 != strncmp(&name[tmpl->plen], digits, len)) {
+        return false;
+    }
+    return (0 == strcmp(&name[tmpl->plen + len], tmpl->suffix));
+}
+
+static pmix_status_t generate_node_regex(const char *input, char **regexp)
+{
+    char *tmp, **names;
+    binmap_buf_t buf, runs;
+    binmap_template_t *tmpls = NULL, tmpl, *cur = NULL;
+    size_t ntmpls = 0, nruns = 0, n, klen;
+    uint64_t val, start = 0, prevend = 0, count = 0;
+    pmix_hash_table_t index;
+    void *ptr;
+    char *key = NULL, kind = PREG_BINMAP_NODES;
+    pmix_status_t rc = PMIX_ERR_NOMEM;
+
+    names = pmix_argv_split(input, ',');
+    n = pmix_argv_count(names);
+    if (0 >= pmix_preg_binmap_min_nodes || n < (size_t) pmix_preg_binmap_min_nodes) {
+        pmix_argv_free(names);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    memset(&buf, 0, sizeof(buf));
+    memset(&runs, 0, sizeof(runs));
+    PMIX_CONSTRUCT(&index, pmix_hash_table_t);
+    pmix_hash_table_init(&index, 32);
+    tmpls = (binmap_template_t *) malloc(n * sizeof(binmap_template_t));
+    if (NULL == tmpls) {
+        goto cleanup;
+    }
+
+    for (n = 0; NULL != names[n]; n++) {
+        /* the common case is the next name in the current run */
+        if (NULL != cur && continues_run(cur, start + count, names[n])) {
+            ++count;
+            continue;
+        }
+        /* close out the current run */
+        if (NULL != cur && 0 != cur->fmt) {
+            if (!put_varint(&runs, zigzag((int64_t) (start - prevend)))
+                || !put_varint(&runs, count)) {
+                goto cleanup;
+            }
+            prevend = start + count;
+        }
+        /* find or add the template for this name - the key
+         * is NUL-delimited as that cannot be part of a name */
+        split_name(names[n], &tmpl, &val);
+        klen = tmpl.plen + tmpl.slen + 24;
+        tmp = (char *) realloc(key, klen);
+        if (NULL == tmp) {
+            goto cleanup;
+        }
+        key = tmp;
+        klen = snprintf(key, klen, "%.*s%c%llu%c%s", (int) tmpl.plen, tmpl.prefix, '\0',
+                        (unsigned long long) tmpl.fmt, '\0', tmpl.suffix);
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&index, key, klen, &ptr)) {
+            cur = &tmpls[(uintptr_t) ptr];
+        } else {
+            tmpls[ntmpls] = tmpl;
+            cur = &tmpls[ntmpls];
+            pmix_hash_table_set_value_ptr(&index, key, klen, (void *) (uintptr_t) ntmpls);
+            ++ntmpls;
+        }
+        if (!put_varint(&runs, cur - tmpls)) {
+            goto cleanup;
+        }
+        ++nruns;
+        start = val;
+        count = 1;
+    }
+    if (NULL != cur && 0 != cur->fmt) {
+        if (!put_varint(&runs, zigzag((int64_t) (start - prevend))) || !put_varint(&runs, count)) {
+            goto cleanup;
+        }
+    }
+
+    /* assemble the payload */
+    if (!put_bytes(&buf, &kind, 1) || !put_varint(&buf, ntmpls)) {
+        goto cleanup;
+    }
+    for (n = 0; n < ntmpls; n++) {
+        if (!put_varint(&buf, tmpls[n].plen) || !put_bytes(&buf, tmpls[n].prefix, tmpls[n].plen)
+            || !put_varint(&buf, tmpls[n].slen) || !put_bytes(&buf, tmpls[n].suffix, tmpls[n].slen)
+            || !put_varint(&buf, tmpls[n].fmt)) {
+            goto cleanup;
+        }
+    }
+    if (!put_varint(&buf, pmix_argv_count(names)) || !put_varint(&buf, nruns)
+        || !put_bytes(&buf, runs.bytes, runs.len)) {
+        goto cleanup;
+    }
+    rc = finish_map(&buf, regexp);
+
+cleanup:
+    PMIX_DESTRUCT(&index);
+    if (NULL != key) {
+        free(key);
+    }
+    if (NULL != tmpls) {
+        free(tmpls);
+    }
+    if (NULL != buf.bytes) {
+        free(buf.bytes);
+    }
+    if (NULL != runs.bytes) {
+        free(runs.bytes);
+    }
+    pmix_argv_free(names);
+    return rc;
+}
+
+/* encode the ranks on one node relative to the
+ * end of the prior range */
+static bool encode_node_procs(char *input, uint64_t *prevend, binmap_buf_t *out)
+{
+    binmap_buf_t ranges;
+    char **ranks, *cptr;
+    uint64_t start = 0, count = 0, first, last, nranges = 0;
+    size_t n;
+    bool ret = false;
+
+    memset(&ranges, 0, sizeof(ranges));
+    ranks = pmix_argv_split(input, ',');
+    for (n = 0; NULL != ranks && NULL != ranks[n]; n++) {
+        first = strtoull(ranks[n], &cptr, 10);
+        last = first;
+        if ('-' == *cptr) {
+            last = strtoull(&cptr[1], NULL, 10);
+            if (last < first) {
+                goto done;
+            }
+        }
+        if (0 < count && first == start + count) {
+            count += last - first + 1;
+            continue;
+        }
+        if (0 < count) {
+            if (!put_varint(&ranges, zigzag((int64_t) (start - *prevend)))
+                || !put_varint(&ranges, count)) {
+                goto done;
+            }
+            *prevend = start + count;
+            ++nranges;
+        }
+        start = first;
+        count = last - first + 1;
+    }
+    if (0 < count) {
+        if (!put_varint(&ranges, zigzag((int64_t) (start - *prevend)))
+            || !put_varint(&ranges, count)) {
+            goto done;
+        }
+        *prevend = start + count;
+        ++nranges;
+    }
+    out->len = 0;
+    ret = put_varint(out, nranges) && put_bytes(out, ranges.bytes, ranges.len);
+
+done:
+    pmix_argv_free(ranks);
+    if (NULL != ranges.bytes) {
+        free(ranges.bytes);
+    }
+    return ret;
+}
+
+static pmix_status_t generate_ppn(const char *input, char **regexp)
+{
+    char **ppn;
+    binmap_buf_t buf, groups, prev, node;
+    uint64_t prevend = 0, repeat = 0, ngroups = 0;
+    size_t n;
+    char kind = PREG_BINMAP_PROCS;
+    pmix_status_t rc = PMIX_ERR_NOMEM;
+
+    ppn = pmix_argv_split(input, ';');
+    n = pmix_argv_count(ppn);
+    if (0 >= pmix_preg_binmap_min_nodes || n < (size_t) pmix_preg_binmap_min_nodes) {
+        pmix_argv_free(ppn);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    memset(&buf, 0, sizeof(buf));
+    memset(&groups, 0, sizeof(groups));
+    memset(&prev, 0, sizeof(prev));
+    memset(&node, 0, sizeof(node));
+
+    for (n = 0; NULL != ppn[n]; n++) {
+        if (!encode_node_procs(ppn[n], &prevend, &node)) {
+            rc = PMIX_ERR_BAD_PARAM;
+            goto cleanup;
+        }
+        /* consecutive nodes with the same layout are a group */
+        if (0 < repeat && node.len == prev.len && 0 == memcmp(node.bytes, prev.bytes, node.len)) {
+            ++repeat;
+            continue;
+        }
+        if (0 < repeat) {
+            if (!put_varint(&groups, repeat) || !put_bytes(&groups, prev.bytes, prev.len)) {
+                goto cleanup;
+            }
+            ++ngroups;
+        }
+        prev.len = 0;
+        if (!put_bytes(&prev, node.bytes, node.len)) {
+            goto cleanup;
+        }
+        repeat = 1;
+    }
+    if (0 < repeat) {
+        if (!put_varint(&groups, repeat) || !put_bytes(&groups, prev.bytes, prev.len)) {
+            goto cleanup;
+        }
+        ++ngroups;
+    }
+
+    /* assemble the payload */
+    if (!put_bytes(&buf, &kind, 1) || !put_varint(&buf, pmix_argv_count(ppn))
+        || !put_varint(&buf, ngroups) || !put_bytes(&buf, groups.bytes, groups.len)) {
+        goto cleanup;
+    }
+    rc = finish_map(&buf, regexp);
+
+cleanup:
+    if (NULL != buf.bytes) {
+        free(buf.bytes);
+    }
+    if (NULL != groups.bytes) {
+        free(groups.bytes);
+    }
+    if (NULL != prev.bytes) {
+        free(prev.bytes);
+    }
+    if (NULL != node.bytes) {
+        free(node.bytes);
+    }
+    pmix_argv_free(ppn);
+    return rc;
+}
+
+/* decode a node map, passing each name to the callback. The
+ * number of nodes is returned before the first callback */
+static pmix_status_t decode_nodes(const char *regexp, pmix_preg_base_node_cbfunc_t cbfunc,
+                                  void *cbdata, uint64_t *nnodes)
+{
+    const uint8_t *ptr, *end;
+    binmap_template_t *tmpls = NULL, *t;
+    uint64_t ntmpls, nruns, n, m, idx, val, delta, count = 0, base, prevend = 0;
+    char *name = NULL;
+    size_t maxlen = 0, nlen;
+    pmix_status_t rc = PMIX_ERR_UNPACK_FAILURE, ret;
+
+    if (!open_map(regexp, PREG_BINMAP_NODES, &ptr, &end)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    if (!get_varint(&ptr, end, &ntmpls) || ntmpls > (uint64_t) (end - ptr)) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    tmpls = (binmap_template_t *) calloc(ntmpls + 1, sizeof(binmap_template_t));
+    if (NULL == tmpls) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < ntmpls; n++) {
+        t = &tmpls[n];
+        if (!get_varint(&ptr, end, &val) || val > (uint64_t) (end - ptr)) {
+            goto cleanup;
+        }
+        t->prefix = (const char *) ptr;
+        t->plen = val;
+        ptr += val;
+        if (!get_varint(&ptr, end, &val) || val > (uint64_t) (end - ptr)) {
+            goto cleanup;
+        }
+        t->suffix = (const char *) ptr;
+        t->slen = val;
+        ptr += val;
+        if (!get_varint(&ptr, end, &t->fmt) || PREG_BINMAP_MAX_DIGITS < t->fmt) {
+            goto cleanup;
+        }
+        nlen = t->plen + t->slen + PREG_BINMAP_MAX_DIGITS + 2;
+        if (nlen > maxlen) {
+            maxlen = nlen;
+        }
+    }
+    if (!get_varint(&ptr, end, nnodes) || !get_varint(&ptr, end, &nruns)) {
+        goto cleanup;
+    }
+    /* one buffer is large enough for every name */
+    name = (char *) malloc(maxlen);
+    if (NULL == name) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+
+    for (n = 0; n < nruns; n++) {
+        if (!get_varint(&ptr, end, &idx) || idx >= ntmpls) {
+            goto cleanup;
+        }
+        t = &tmpls[idx];
+        if (0 == t->fmt) {
+            if (count == *nnodes) {
+                goto cleanup;
+            }
+            ++count;
+            snprintf(name, maxlen, "%.*s%.*s", (int) t->plen, t->prefix, (int) t->slen, t->suffix);
+            if (PMIX_SUCCESS != (ret = cbfunc(name, cbdata))) {
+                rc = ret;
+                goto cleanup;
+            }
+            continue;
+        }
+        if (!get_varint(&ptr, end, &delta) || !get_varint(&ptr, end, &val)
+            || val > *nnodes - count) {
+            goto cleanup;
+        }
+        count += val;
+        base = prevend + unzigzag(delta);
+        for (m = 0; m < val; m++) {
+            if (1 == t->fmt) {
+                snprintf(name, maxlen, "%.*s%llu%.*s", (int) t->plen, t->prefix,
+                         (unsigned long long) (base + m), (int) t->slen, t->suffix);
+            } else {
+                snprintf(name, maxlen, "%.*s%0*llu%.*s", (int) t->plen, t->prefix, (int) t->fmt,
+                         (unsigned long long) (base + m), (int) t->slen, t->suffix);
+            }
+            if (PMIX_SUCCESS != (ret = cbfunc(name, cbdata))) {
+                rc = ret;
+                goto cleanup;
+            }
+        }
+        prevend = base + val;
+    }
+    if (count == *nnodes && ptr == end) {
+        rc = PMIX_SUCCESS;
+    }
+
+cleanup:
+    if (NULL != name) {
+        free(name);
+    }
+    free(tmpls);
+    return rc;
+}
+
+typedef struct {
+    char **names;
+    size_t n;
+    uint64_t nnodes;
+} binmap_argv_t;
+
+static pmix_status_t add_name(const char *name, void *cbdata)
+{
+    binmap_argv_t *argv = (binmap_argv_t *) cbdata;
+
+    /* the node count is known by the time we are first
+     * called, so the array only has to be allocated once */
+    if (NULL == argv->names) {
+        argv->names = (char **) calloc(argv->nnodes + 1, sizeof(char *));
+        if (NULL == argv->names) {
+            return PMIX_ERR_NOMEM;
+        }
+    }
+    argv->names[argv->n] = strdup(name);
+    if (NULL == argv->names[argv->n]) {
+        return PMIX_ERR_NOMEM;
+    }
+    ++argv->n;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t parse_nodes(const char *regexp, char ***names)
+{
+    binmap_argv_t argv;
+    pmix_status_t rc;
+
+    memset(&argv, 0, sizeof(argv));
+    rc = decode_nodes(regexp, add_name, &argv, &argv.nnodes);
+    if (PMIX_SUCCESS != rc) {
+        if (NULL != argv.names) {
+            pmix_argv_free(argv.names);
+        }
+        return rc;
+    }
+    *names = argv.names;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t parse_nodes_stream(const char *regexp, pmix_preg_base_node_cbfunc_t cbfunc,
+                                        void *cbdata)
+{
+    uint64_t nnodes;
+
+    return decode_nodes(regexp, cbfunc, cbdata, &nnodes);
+}
+
+static pmix_status_t parse_procs(const char *regexp, char ***procs)
+{
+    const uint8_t *ptr, *end, *layout;
+    uint64_t nnodes, ngroups, repeat, nranges, n, r, i, k, delta, count, start, prevend = 0;
+    char **argv = NULL, *str = NULL, *tmp;
+    size_t len, size = 0, node = 0;
+    pmix_status_t rc = PMIX_ERR_UNPACK_FAILURE;
+
+    if (!open_map(regexp, PREG_BINMAP_PROCS, &ptr, &end)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (!get_varint(&ptr, end, &nnodes) || !get_varint(&ptr, end, &ngroups)
+        || nnodes > (uint64_t) (SIZE_MAX / sizeof(char *)) - 1) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    argv = (char **) calloc(nnodes + 1, sizeof(char *));
+    if (NULL == argv) {
+        return PMIX_ERR_NOMEM;
+    }
+
+    for (n = 0; n < ngroups; n++) {
+        if (!get_varint(&ptr, end, &repeat) || repeat > nnodes - node) {
+            goto cleanup;
+        }
+        layout = ptr;
+        for (r = 0; r < repeat; r++) {
+            /* every node in the group shares the same layout */
+            ptr = layout;
+            if (!get_varint(&ptr, end, &nranges)) {
+                goto cleanup;
+            }
+            len = 0;
+            for (i = 0; i < nranges; i++) {
+                if (!get_varint(&ptr, end, &delta) || !get_varint(&ptr, end, &count)) {
+                    goto cleanup;
+                }
+                start = prevend + unzigzag(delta);
+                for (k = 0; k < count; k++) {
+                    /* room for the rank, a comma, and the NUL */
+                    if (len + 24 > size) {
+                        size = 2 * size + 64;
+                        tmp = (char *) realloc(str, size);
+                        if (NULL == tmp) {
+                            rc = PMIX_ERR_NOMEM;
+                            goto cleanup;
+                        }
+                        str = tmp;
+                    }
+                    len += snprintf(&str[len], size - len, "%s%llu", (0 == len) ? "" : ",",
+                                    (unsigned long long) (start + k));
+                }
+                prevend = start + count;
+            }
+            argv[node] = strndup((NULL == str) ? "" : str, len);
+            if (NULL == argv[node]) {
+                rc = PMIX_ERR_NOMEM;
+                goto cleanup;
+            }
+            ++node;
+        }
+    }
+    if (node != nnodes || ptr != end) {
+        goto cleanup;
+    }
+    *procs = argv;
+    argv = NULL;
+    rc = PMIX_SUCCESS;
+
+cleanup:
+    if (NULL != str) {
+        free(str);
+    }
+    if (NULL != argv) {
+        pmix_argv_free(argv);
+    }
+    return rc;
+}
+
+static pmix_status_t copy(char **dest, size_t *len, const char *input)
+{
+    size_t slen;
+    char *tmp;
+
+    if (0 != strncmp(input, PREG_BINMAP_PREFIX, strlen(PREG_BINMAP_PREFIX))) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    slen = total_len(input);
+    tmp = (char *) malloc(slen);
+    if (NULL == tmp) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(tmp, input, slen);
+    *dest = tmp;
+    *len = slen;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t pack(pmix_buffer_t *buffer, const char *input)
+{
+    size_t slen;
+    char *ptr;
+
+    if (0 != strncmp(input, PREG_BINMAP_PREFIX, strlen(PREG_BINMAP_PREFIX))) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    slen = total_len(input);
+
+    /* ensure the buffer has enough space */
+    ptr = pmix_bfrop_buffer_extend(buffer, slen);
+    if (NULL == ptr) {
+        return PMIX_ERR_NOMEM;
+    }
+
+    /* xfer the data */
+    memcpy(ptr, input, slen);
+    buffer->bytes_used += slen;
+    buffer->pack_ptr += slen;
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t unpack(pmix_buffer_t *buffer, char **regex)
+{
+    size_t slen;
+    char *ptr, *output;
+
+    /* the value starts at the unpack_ptr */
+    ptr = buffer->unpack_ptr;
+
+    if (0 != strncmp(ptr, PREG_BINMAP_PREFIX, strlen(PREG_BINMAP_PREFIX))) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    slen = total_len(ptr);
+    if (slen > (size_t) (buffer->bytes_used - (buffer->unpack_ptr - buffer->base_ptr))) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+
+    output = (char *) malloc(slen);
+    if (NULL == output) {
+        *regex = NULL;
+        return PMIX_ERR_NOMEM;
+    }
+
+    /* xfer the data */
+    memcpy(output, ptr, slen);
+    buffer->unpack_ptr += slen;
+    *regex = output;
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t release(char *regexp)
+{
+    if (NULL == regexp) {
+        return PMIX_SUCCESS;
+    }
+    if (0 != strncmp(regexp, PREG_BINMAP_PREFIX, strlen(PREG_BINMAP_PREFIX))) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    free(regexp);
+    return PMIX_SUCCESS;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_PREG_BINMAP_H
+#define PMIX_PREG_BINMAP_H
+
+#include "src/include/pmix_config.h"
+
+#include "src/mca/preg/preg.h"
+
+BEGIN_C_DECLS
+
+/* the component must be visible data for the linker to find it */
+PMIX_EXPORT extern pmix_mca_base_component_t pmix_mca_preg_binmap_component;
+extern pmix_preg_module_t pmix_preg_binmap_module;
+
+/* smallest number of nodes for which we generate a binary map */
+extern int pmix_preg_binmap_min_nodes;
+
+END_C_DECLS
+
+#endif
@@ -0,0 +1,79 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include "src/include/pmix_config.h"
+#include "pmix_common.h"
+
+#include "preg_binmap.h"
+#include "src/mca/preg/preg.h"
+
+static pmix_status_t component_register(void);
+static pmix_status_t component_open(void);
+static pmix_status_t component_close(void);
+static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
+
+int pmix_preg_binmap_min_nodes = 1024;
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+pmix_mca_base_component_t pmix_mca_preg_binmap_component = {
+    PMIX_PREG_BASE_VERSION_1_0_0,
+
+    /* Component name and version */
+    .pmix_mca_component_name = "binmap",
+    PMIX_MCA_BASE_MAKE_VERSION(component, PMIX_MAJOR_VERSION, PMIX_MINOR_VERSION,
+                               PMIX_RELEASE_VERSION),
+
+    /* Component open and close functions */
+    .pmix_mca_open_component = component_open,
+    .pmix_mca_close_component = component_close,
+    .pmix_mca_query_component = component_query,
+    .pmix_mca_register_component_params = component_register
+};
+
+static int component_register(void)
+{
+    pmix_preg_binmap_min_nodes = 1024;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_preg_binmap_component,
+                                                "min_nodes",
+                                                "Minimum number of nodes in a node or proc map "
+                                                "before it is sent in binary form - smaller maps "
+                                                "use the string regex (0 => never)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_preg_binmap_min_nodes);
+    return PMIX_SUCCESS;
+}
+
+static int component_open(void)
+{
+    return PMIX_SUCCESS;
+}
+
+static int component_query(pmix_mca_base_module_t **module, int *priority)
+{
+    /* ahead of the string regex so we get first crack
+     * at large maps, but behind compression */
+    *priority = 75;
+    *module = (pmix_mca_base_module_t *) &pmix_preg_binmap_module;
+    return PMIX_SUCCESS;
+}
+
+static int component_close(void)
+{
+    return PMIX_SUCCESS;
+}
@@ -47,6 +47,8 @@ static pmix_status_t generate_node_regex(const char *input, char **regex);
 static pmix_status_t generate_ppn(const char *input, char **ppn);
 static pmix_status_t parse_nodes(const char *regexp, char ***names);
 static pmix_status_t parse_procs(const char *regexp, char ***procs);
+static pmix_status_t parse_nodes_stream(const char *regexp, pmix_preg_base_node_cbfunc_t cbfunc,
+                                        void *cbdata);
 static pmix_status_t copy(char **dest, size_t *len, const char *input);
 static pmix_status_t pack(pmix_buffer_t *buffer, const char *input);
 static pmix_status_t unpack(pmix_buffer_t *buffer, char **regex);
@@ -61,7 +63,8 @@ pmix_preg_module_t pmix_preg_compress_module = {
     .copy = copy,
     .pack = pack,
     .unpack = unpack,
-    .release = release
+    .release = release,
+    .parse_nodes_stream = parse_nodes_stream
 };
 
 #define PREG_COMPRESS_PREFIX "blob: component=zlib: size="
@@ -152,6 +155,7 @@ static pmix_status_t parse_nodes(const char *regexp, char ***names)
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
     idx += strlen("component=zlib:") + 1; // step over the NULL terminator
+    idx += strlen("size=");
 
     len = strtoul(&regexp[idx], &ptr, 10);
     ptr += 2; // step over colon and NULL
@@ -172,6 +176,133 @@ static pmix_status_t parse_nodes(const char *regexp, char ***names)
     *names = argv;
     return PMIX_SUCCESS;
 }
+/* track a node name that may be split across
+ * decompressed chunks */
+typedef struct {
+    pmix_preg_base_node_cbfunc_t cbfunc;
+    void *cbdata;
+    char *name;
+    size_t len;
+    size_t size;
+    size_t count;
+    pmix_status_t rc;
+} stream_tracker_t;
+
+static bool emit_name(stream_tracker_t *trk)
+{
+    /* skip empty entries as pmix_argv_split would */
+    if (0 == trk->len) {
+        return true;
+    }
+    trk->name[trk->len] = '\0';
+    trk->len = 0;
+    ++trk->count;
+    trk->rc = trk->cbfunc(trk->name, trk->cbdata);
+    return (PMIX_SUCCESS == trk->rc);
+}
+
+static bool append_name(stream_tracker_t *trk, const char *ptr, size_t len)
+{
+    char *tmp;
+    size_t need;
+
+    need = trk->len + len + 1; // leave room for the NUL terminator
+    if (need > trk->size) {
+        tmp = (char *) realloc(trk->name, need);
+        if (NULL == tmp) {
+            trk->rc = PMIX_ERR_NOMEM;
+            return false;
+        }
+        trk->name = tmp;
+        trk->size = need;
+    }
+    memcpy(&trk->name[trk->len], ptr, len);
+    trk->len += len;
+    return true;
+}
+
+static bool stream_chunk(const char *chunk, size_t len, void *cbdata)
+{
+    stream_tracker_t *trk = (stream_tracker_t *) cbdata;
+    const char *ptr, *end = chunk + len;
+
+    while (chunk < end) {
+        ptr = (const char *) memchr(chunk, ',', end - chunk);
+        if (NULL == ptr) {
+            /* the name continues into the next chunk */
+            return append_name(trk, chunk, end - chunk);
+        }
+        if (!append_name(trk, chunk, ptr - chunk) || !emit_name(trk)) {
+            return false;
+        }
+        chunk = ptr + 1;
+    }
+    return true;
+}
+
+static pmix_status_t parse_nodes_stream(const char *regexp, pmix_preg_base_node_cbfunc_t cbfunc,
+                                        void *cbdata)
+{
+    stream_tracker_t trk;
+    char *tmp, *ptr;
+    size_t len;
+    int idx;
+    bool ret;
+
+    if (0 != strncmp(regexp, "blob", 4)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    idx = strlen(regexp) + 1; // step over the NULL terminator
+
+    /* ensure we were the one who generated this blob */
+    if (0 != strncmp(&regexp[idx], "component=zlib:", strlen("component=zlib:"))) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    idx += strlen("component=zlib:") + 1; // step over the NULL terminator
+    idx += strlen("size=");
+
+    len = strtoul(&regexp[idx], &ptr, 10);
+    ptr += 2; // step over colon and NULL
+
+    memset(&trk, 0, sizeof(trk));
+    trk.cbfunc = cbfunc;
+    trk.cbdata = cbdata;
+    trk.rc = PMIX_SUCCESS;
+
+    if (NULL != pmix_compress.decompress_string_stream) {
+        /* hand the names over as each chunk is inflated */
+        ret = pmix_compress.decompress_string_stream((uint8_t *) ptr, len, stream_chunk, &trk);
+    } else {
+        /* the component can only give us the full string, but
+         * we can still avoid splitting it into an argv array */
+        if (!pmix_compress.decompress_string(&tmp, (uint8_t *) ptr, len)) {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        ret = stream_chunk(tmp, strlen(tmp), &trk);
+        free(tmp);
+    }
+    /* the last name has no trailing comma */
+    if (ret) {
+        ret = emit_name(&trk);
+    }
+    if (NULL != trk.name) {
+        free(trk.name);
+    }
+
+    if (ret) {
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != trk.rc) {
+        return trk.rc;
+    }
+    /* the decompression failed - let someone else try
+     * if we haven't already delivered any names */
+    if (0 == trk.count) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    return PMIX_ERR_UNPACK_FAILURE;
+}
+
 static pmix_status_t parse_procs(const char *regexp, char ***procs)
 {
     char *tmp, *ptr, **argv;
@@ -188,6 +319,7 @@ static pmix_status_t parse_procs(const char *regexp, char ***procs)
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
     idx += strlen("component=zlib:") + 1; // step over the NULL terminator
+    idx += strlen("size=");
 
     len = strtoul(&regexp[idx], &ptr, 10);
     ptr += 2; // step over colon and NULL
@@ -226,6 +358,7 @@ static pmix_status_t copy(char **dest, size_t *len, const char *input)
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
     idx += strlen("component=zlib:") + 1; // step over the NULL terminator
+    idx += strlen("size=");
 
     /* extract the size */
     slen = strtoul(&input[idx], NULL, 10) + strlen(PREG_COMPRESS_PREFIX) + strlen(&input[idx]) + 1;
@@ -259,6 +392,7 @@ static pmix_status_t pack(pmix_buffer_t *buffer, const char *input)
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
     idx += strlen("component=zlib:") + 1; // step over the NULL terminator
+    idx += strlen("size=");
 
     /* extract the size */
     slen = strtoul(&input[idx], NULL, 10) + strlen(PREG_COMPRESS_PREFIX) + strlen(&input[idx]) + 1;
@@ -296,6 +430,7 @@ static pmix_status_t unpack(pmix_buffer_t *buffer, char **regex)
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
     idx += strlen("component=zlib:") + 1; // step over the NULL terminator
+    idx += strlen("size=");
 
     /* extract the size */
     slen = strtoul(&ptr[idx], NULL, 10) + strlen(PREG_COMPRESS_PREFIX) + strlen(&ptr[idx]) + 1;
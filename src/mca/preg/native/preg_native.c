@@ -45,6 +45,8 @@
 
 static pmix_status_t generate_node_regex(const char *input, char **regex);
 static pmix_status_t generate_ppn(const char *input, char **ppn);
+static pmix_status_t generate_ppn_ranks(const pmix_rank_t **ranks, const size_t *nranks,
+                                        size_t nnodes, char **ppn);
 static pmix_status_t parse_nodes(const char *regexp, char ***names);
 static pmix_status_t parse_procs(const char *regexp, char ***procs);
 static pmix_status_t copy(char **dest, size_t *len, const char *input);
@@ -61,7 +63,8 @@ pmix_preg_module_t pmix_preg_native_module = {
     .copy = copy,
     .pack = pack,
     .unpack = unpack,
-    .release = release
+    .release = release,
+    .generate_ppn_ranks = generate_ppn_ranks
 };
 
 static pmix_status_t regex_parse_value_ranges(char *base, char *ranges, int num_digits,
@@ -71,248 +74,208 @@ static pmix_status_t regex_parse_value_range(char *base, char *range, int num_di
 static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names);
 static pmix_status_t pmix_regex_extract_ppn(char *regexp, char ***procs);
 
-static pmix_status_t generate_node_regex(const char *input, char **regexp)
-{
-    char *vptr, *vsave;
-    char prefix[PMIX_MAX_NODE_PREFIX];
-    int i, j, len, startnum, vnum, numdigits;
-    bool found, fullval;
-    char *suffix, *sfx;
-    pmix_regex_value_t *vreg;
-    pmix_regex_range_t *range;
-    pmix_list_t vids;
-    char **regexargs = NULL, *tmp, *tmp2;
-    char *cptr;
-    pmix_status_t rc;
+/* the regex is built in a single buffer that grows as needed */
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t size;
+} regex_out_t;
 
-    /* define the default */
-    *regexp = NULL;
+static bool out_append(regex_out_t *out, const char *str, size_t n)
+{
+    char *tmp;
+    size_t size;
 
-    /* setup the list of results */
-    PMIX_CONSTRUCT(&vids, pmix_list_t);
-
-    /* cycle thru the array of input values - first copy
-     * it so we don't overwrite what we were given*/
-    vsave = strdup(input);
-    vptr = vsave;
-    while (NULL != (cptr = strchr(vptr, ',')) || 0 < strlen(vptr)) {
-        if (NULL != cptr) {
-            *cptr = '\0';
+    if (out->len + n + 1 > out->size) {
+        size = 2 * out->size;
+        while (out->len + n + 1 > size) {
+            size *= 2;
         }
-        /* determine this node's prefix by looking for first non-alpha char */
-        fullval = false;
-        len = strlen(vptr);
-        startnum = -1;
-        memset(prefix, 0, PMIX_MAX_NODE_PREFIX);
-        for (i = 0, j = 0; i < len; i++) {
-            if (!isalpha(vptr[i])) {
-                /* found a non-alpha char */
-                if (!isdigit(vptr[i])) {
-                    /* if it is anything but a digit, we just use
-                     * the entire name
-                     */
-                    fullval = true;
-                    break;
-                }
-                /* count the size of the numeric field - but don't
-                 * add the digits to the prefix
-                 */
-                if (startnum < 0) {
-                    /* okay, this defines end of the prefix */
-                    startnum = i;
-                }
-                continue;
+        tmp = (char *) realloc(out->buf, size);
+        if (NULL == tmp) {
+            return false;
+        }
+        out->buf = tmp;
+        out->size = size;
+    }
+    memcpy(out->buf + out->len, str, n);
+    out->len += n;
+    out->buf[out->len] = '\0';
+    return true;
+}
+
+static bool out_printf(regex_out_t *out, const char *fmt, int a, int b)
+{
+    char tmp[32];
+    int n;
+
+    n = snprintf(tmp, sizeof(tmp), fmt, a, b);
+    if (0 > n || (size_t) n >= sizeof(tmp)) {
+        return false;
+    }
+    return out_append(out, tmp, n);
+}
+
+/* a node name split into its alphabetic prefix, the number that
+ * follows it and whatever follows that. Names holding anything but
+ * letters and digits, or holding no digits, cannot be compressed */
+typedef struct {
+    const char *name;
+    size_t len;
+    size_t plen;
+    const char *sfx;
+    size_t slen;
+    int num_digits;
+    int num;
+    bool full;
+} regex_name_t;
+
+static void split_name(const char *name, size_t len, regex_name_t *nm)
+{
+    size_t i;
+    char *sfx;
+    int startnum = -1;
+
+    nm->name = name;
+    nm->len = len;
+    nm->plen = 0;
+    nm->full = false;
+    for (i = 0; i < len; i++) {
+        if (!isalpha((unsigned char) name[i])) {
+            if (!isdigit((unsigned char) name[i])) {
+                nm->full = true;
+                return;
             }
             if (startnum < 0) {
-                prefix[j++] = vptr[i];
-            }
-        }
-        if (fullval || startnum < 0) {
-            /* can't compress this name - just add it to the list */
-            vreg = PMIX_NEW(pmix_regex_value_t);
-            vreg->prefix = strdup(vptr);
-            pmix_list_append(&vids, &vreg->super);
-            /* move to the next posn */
-            if (NULL == cptr) {
-                break;
+                startnum = i;
             }
-            vptr = cptr + 1;
             continue;
         }
-        /* convert the digits and get any suffix */
-        vnum = strtol(&vptr[startnum], &sfx, 10);
-        if (NULL != sfx) {
-            suffix = strdup(sfx);
-            numdigits = (int) (sfx - &vptr[startnum]);
-        } else {
-            suffix = NULL;
-            numdigits = (int) strlen(&vptr[startnum]);
+        if (startnum < 0) {
+            ++nm->plen;
         }
+    }
+    if (startnum < 0) {
+        nm->full = true;
+        return;
+    }
+    nm->num = strtol(&name[startnum], &sfx, 10);
+    nm->num_digits = (int) (sfx - &name[startnum]);
+    nm->sfx = sfx;
+    nm->slen = len - (sfx - name);
+}
 
-        /* is this value already on our list? */
-        found = false;
-        PMIX_LIST_FOREACH (vreg, &vids, pmix_regex_value_t) {
-            // The regex must preserve ordering of the values.
-            // If we disqualified this entry in a previous check then exclude it
-            // from future checks as well. This will prevent a later entry from
-            // being 'pulled forward' accidentally. For example, given:
-            // "a28n01,a99n02,a28n02"
-            // Without this 'skip' the loop would have 'a28n02' combine with
-            // 'a28n01' jumping over the 'a99n02' entry, and thus not preserving
-            // the order of the list when the regex is unpacked.
-            if (vreg->skip) {
-                continue;
-            }
+static bool out_range(regex_out_t *out, int start, int cnt)
+{
+    if (1 == cnt) {
+        return out_printf(out, "%d", start, 0);
+    }
+    return out_printf(out, "%d-%d", start, start + cnt - 1);
+}
 
-            if (0 < strlen(prefix) && NULL == vreg->prefix) {
-                continue;
-            }
-            if (0 == strlen(prefix) && NULL != vreg->prefix) {
-                continue;
-            }
-            if (0 < strlen(prefix) && NULL != vreg->prefix && 0 != strcmp(prefix, vreg->prefix)) {
-                vreg->skip = true;
-                continue;
-            }
-            if (NULL == suffix && NULL != vreg->suffix) {
-                continue;
-            }
-            if (NULL != suffix && NULL == vreg->suffix) {
-                continue;
-            }
-            if (NULL != suffix && NULL != vreg->suffix && 0 != strcmp(suffix, vreg->suffix)) {
-                vreg->skip = true;
-                continue;
-            }
-            if (numdigits != vreg->num_digits) {
-                vreg->skip = true;
-                continue;
-            }
-            /* found a match - flag it */
-            found = true;
-            /* get the last range on this nodeid - we do this
-             * to preserve order
-             */
-            range = (pmix_regex_range_t *) pmix_list_get_last(&vreg->ranges);
-            if (NULL == range) {
-                /* first range for this value */
-                range = PMIX_NEW(pmix_regex_range_t);
-                range->start = vnum;
-                range->cnt = 1;
-                pmix_list_append(&vreg->ranges, &range->super);
-                break;
-            }
-            /* see if the value is out of sequence */
-            if (vnum != (range->start + range->cnt)) {
-                /* start a new range */
-                range = PMIX_NEW(pmix_regex_range_t);
-                range->start = vnum;
-                range->cnt = 1;
-                pmix_list_append(&vreg->ranges, &range->super);
-                break;
-            }
-            /* everything matches - just increment the cnt */
-            range->cnt++;
-            break;
-        }
-        if (!found) {
-            /* need to add it */
-            vreg = PMIX_NEW(pmix_regex_value_t);
-            if (0 < strlen(prefix)) {
-                vreg->prefix = strdup(prefix);
-            }
-            if (NULL != suffix) {
-                vreg->suffix = strdup(suffix);
-            }
-            vreg->num_digits = numdigits;
-            pmix_list_append(&vids, &vreg->super);
-            /* record the first range for this value - we took
-             * care of values we can't compress above
-             */
-            range = PMIX_NEW(pmix_regex_range_t);
-            range->start = vnum;
-            range->cnt = 1;
-            pmix_list_append(&vreg->ranges, &range->super);
-        }
-        if (NULL != suffix) {
-            free(suffix);
-        }
-        /* move to the next posn */
-        if (NULL == cptr) {
-            break;
-        }
-        vptr = cptr + 1;
+static bool same_group(const regex_name_t *a, const regex_name_t *b)
+{
+    return a->plen == b->plen && a->slen == b->slen && a->num_digits == b->num_digits
+           && 0 == memcmp(a->name, b->name, a->plen) && 0 == memcmp(a->sfx, b->sfx, a->slen);
+}
+
+/* The regex must preserve the order of the nodes, so a node can only
+ * join the ranges of the node right before it - anything else in
+ * between would be pulled out of place when the regex is unpacked.
+ * That lets us compress in a single pass over the input, holding
+ * just the group being built, instead of searching all the groups
+ * found so far for every node */
+static pmix_status_t generate_node_regex(const char *input, char **regexp)
+{
+    regex_out_t out;
+    regex_name_t grp, nm;
+    const char *vptr, *cptr;
+    bool open = false;
+    int start = 0, cnt = 0;
+    size_t nitems = 0, len;
+
+    /* define the default */
+    *regexp = NULL;
+    memset(&grp, 0, sizeof(regex_name_t));
+
+    out.size = strlen(input) + 64;
+    out.buf = (char *) malloc(out.size);
+    if (NULL == out.buf) {
+        return PMIX_ERR_NOMEM;
+    }
+    out.len = 0;
+    if (!out_append(&out, "pmix[", 5)) {
+        goto nomem;
     }
-    free(vsave);
 
-    /* begin constructing the regular expression */
-    while (NULL != (vreg = (pmix_regex_value_t *) pmix_list_remove_first(&vids))) {
-        /* if no ranges, then just add the name */
-        if (0 == pmix_list_get_size(&vreg->ranges)) {
-            if (NULL != vreg->prefix) {
-                pmix_argv_append_nosize(&regexargs, vreg->prefix);
-            }
-            PMIX_RELEASE(vreg);
-            continue;
-        }
-        /* start the regex for this value with the prefix */
-        if (NULL != vreg->prefix) {
-            if (0 > asprintf(&tmp, "%s[%d:", vreg->prefix, vreg->num_digits)) {
-                return PMIX_ERR_NOMEM;
+    vptr = input;
+    while (NULL != (cptr = strchr(vptr, ',')) || '\0' != *vptr) {
+        len = (NULL == cptr) ? strlen(vptr) : (size_t) (cptr - vptr);
+        split_name(vptr, len, &nm);
+        if (open && !nm.full && same_group(&grp, &nm)) {
+            if (nm.num == start + cnt) {
+                ++cnt;
+            } else {
+                /* out of sequence - start a new range */
+                if (!out_range(&out, start, cnt) || !out_append(&out, ",", 1)) {
+                    goto nomem;
+                }
+                start = nm.num;
+                cnt = 1;
             }
         } else {
-            if (0 > asprintf(&tmp, "[%d:", vreg->num_digits)) {
-                return PMIX_ERR_NOMEM;
+            if (open) {
+                /* close the previous group */
+                if (!out_range(&out, start, cnt) || !out_append(&out, "]", 1) || !out_append(&out, grp.sfx, grp.slen)) {
+                    goto nomem;
+                }
+                open = false;
             }
-        }
-        /* add the ranges */
-        while (NULL != (range = (pmix_regex_range_t *) pmix_list_remove_first(&vreg->ranges))) {
-            if (1 == range->cnt) {
-                if (0 > asprintf(&tmp2, "%s%d,", tmp, range->start)) {
-                    return PMIX_ERR_NOMEM;
+            if (0 < nitems && !out_append(&out, ",", 1)) {
+                goto nomem;
+            }
+            ++nitems;
+            if (nm.full) {
+                /* can't compress this name - just add it */
+                if (!out_append(&out, nm.name, nm.len)) {
+                    goto nomem;
                 }
             } else {
-                if (0 > asprintf(&tmp2, "%s%d-%d,", tmp, range->start,
-                                 range->start + range->cnt - 1)) {
-                    return PMIX_ERR_NOMEM;
+                /* start the group with the prefix */
+                if (!out_append(&out, nm.name, nm.plen)
+                    || !out_printf(&out, "[%d:", nm.num_digits, 0)) {
+                    goto nomem;
                 }
+                grp = nm;
+                open = true;
+                start = nm.num;
+                cnt = 1;
             }
-            free(tmp);
-            tmp = tmp2;
-            PMIX_RELEASE(range);
         }
-        /* replace the final comma */
-        tmp[strlen(tmp) - 1] = ']';
-        if (NULL != vreg->suffix) {
-            /* add in the suffix, if provided */
-            if (0 > asprintf(&tmp2, "%s%s", tmp, vreg->suffix)) {
-                return PMIX_ERR_NOMEM;
-            }
-            free(tmp);
-            tmp = tmp2;
+        /* move to the next posn */
+        if (NULL == cptr) {
+            break;
         }
-        pmix_argv_append_nosize(&regexargs, tmp);
-        free(tmp);
-        PMIX_RELEASE(vreg);
+        vptr = cptr + 1;
     }
-
-    /* assemble final result */
-    if (NULL != regexargs) {
-        tmp = pmix_argv_join(regexargs, ',');
-        if (0 > asprintf(regexp, "pmix[%s]", tmp)) {
-            return PMIX_ERR_NOMEM;
+    if (open) {
+        if (!out_range(&out, start, cnt) || !out_append(&out, "]", 1) || !out_append(&out, grp.sfx, grp.slen)) {
+            goto nomem;
         }
-        free(tmp);
-
-        /* cleanup */
-        pmix_argv_free(regexargs);
-        rc = PMIX_SUCCESS;
-    } else {
-        rc = PMIX_ERR_TAKE_NEXT_OPTION;
     }
+    if (0 == nitems) {
+        free(out.buf);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (!out_append(&out, "]", 1)) {
+        goto nomem;
+    }
+    *regexp = out.buf;
+    return PMIX_SUCCESS;
 
-    PMIX_DESTRUCT(&vids);
-    return rc;
+nomem:
+    free(out.buf);
+    return PMIX_ERR_NOMEM;
 }
 
 static pmix_status_t generate_ppn(const char *input, char **regexp)
@@ -440,6 +403,92 @@ static pmix_status_t generate_ppn(const char *input, char **regexp)
     return PMIX_SUCCESS;
 }
 
+static bool out_rank_range(regex_out_t *out, pmix_rank_t start, pmix_rank_t cnt)
+{
+    char tmp[32];
+    int n;
+
+    if (1 == cnt) {
+        n = snprintf(tmp, sizeof(tmp), "%u", start);
+    } else {
+        n = snprintf(tmp, sizeof(tmp), "%u-%u", start, start + cnt - 1);
+    }
+    return out_append(out, tmp, n);
+}
+
+/* compress the ranks straight from the arrays, in one pass that
+ * yields the same regex generate_ppn would for their string form */
+static pmix_status_t generate_ppn_ranks(const pmix_rank_t **ranks, const size_t *nranks,
+                                        size_t nnodes, char **regexp)
+{
+    regex_out_t out;
+    pmix_rank_t start, cnt, r;
+    size_t n, m, plain = 0;
+
+    /* define the default */
+    *regexp = NULL;
+
+    if (0 == nnodes) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    out.size = 64 + 2 * nnodes;
+    out.buf = (char *) malloc(out.size);
+    if (NULL == out.buf) {
+        return PMIX_ERR_NOMEM;
+    }
+    out.len = 0;
+    if (!out_append(&out, "pmix[", 5)) {
+        goto nomem;
+    }
+
+    for (n = 0; n < nnodes; n++) {
+        if (0 < n && !out_append(&out, ";", 1)) {
+            goto nomem;
+        }
+        plain += (0 < n) ? 1 : 0;
+        cnt = 0;
+        start = 0;
+        for (m = 0; m < nranks[n]; m++) {
+            /* track how long the plain list would be */
+            r = ranks[n][m];
+            do {
+                ++plain;
+                r /= 10;
+            } while (0 < r);
+            plain += (0 < m) ? 1 : 0;
+
+            if (0 < cnt && ranks[n][m] == start + cnt) {
+                ++cnt;
+                continue;
+            }
+            if (0 < cnt
+                && (!out_rank_range(&out, start, cnt) || !out_append(&out, ",", 1))) {
+                goto nomem;
+            }
+            start = ranks[n][m];
+            cnt = 1;
+        }
+        if (0 < cnt && !out_rank_range(&out, start, cnt)) {
+            goto nomem;
+        }
+    }
+    if (!out_append(&out, "]", 1)) {
+        goto nomem;
+    }
+
+    /* if this results in a longer answer, then don't do it */
+    if (out.len > plain) {
+        free(out.buf);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    *regexp = out.buf;
+    return PMIX_SUCCESS;
+
+nomem:
+    free(out.buf);
+    return PMIX_ERR_NOMEM;
+}
+
 static pmix_status_t parse_nodes(const char *regexp, char ***names)
 {
     char *tmp, *ptr;
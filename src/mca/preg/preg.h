@@ -72,10 +72,29 @@ typedef pmix_status_t (*pmix_preg_base_module_generate_node_regex_fn_t)(const ch
  */
 typedef pmix_status_t (*pmix_preg_base_module_generate_ppn_fn_t)(const char *input, char **ppn);
 
+/* Same as generate_ppn, but taking the ranks on each node as
+ * an array of integers - ranks[n] holds the nranks[n] ranks on
+ * the n-th node - so hosts that build their map programmatically
+ * need not print it into a string first */
+typedef pmix_status_t (*pmix_preg_base_module_generate_ppn_ranks_fn_t)(const pmix_rank_t **ranks,
+                                                                       const size_t *nranks,
+                                                                       size_t nnodes, char **ppn);
+
 typedef pmix_status_t (*pmix_preg_base_module_parse_nodes_fn_t)(const char *regexp, char ***names);
 
 typedef pmix_status_t (*pmix_preg_base_module_parse_procs_fn_t)(const char *regexp, char ***procs);
 
+/* given a node regex, pass each node name to the callback in
+ * the order in which they appear in the regex. This allows the
+ * caller to store the names as they are extracted instead of
+ * holding an argv array of every node. The name is only valid for
+ * the duration of the callback - any error returned by the callback
+ * terminates the parse and is returned to the caller */
+typedef pmix_status_t (*pmix_preg_base_node_cbfunc_t)(const char *name, void *cbdata);
+
+typedef pmix_status_t (*pmix_preg_base_module_parse_nodes_stream_fn_t)(
+    const char *regexp, pmix_preg_base_node_cbfunc_t cbfunc, void *cbdata);
+
 typedef pmix_status_t (*pmix_preg_base_module_copy_fn_t)(char **dest, size_t *len,
                                                          const char *input);
 
@@ -98,6 +117,8 @@ typedef struct {
     pmix_preg_base_module_pack_fn_t pack;
     pmix_preg_base_module_unpack_fn_t unpack;
     pmix_preg_base_module_release_fn_t release;
+    pmix_preg_base_module_parse_nodes_stream_fn_t parse_nodes_stream;
+    pmix_preg_base_module_generate_ppn_ranks_fn_t generate_ppn_ranks;
 } pmix_preg_module_t;
 
 /* we just use the standard component definition */
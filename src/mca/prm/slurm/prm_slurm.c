@@ -17,6 +17,7 @@
 #include <unistd.h>
 #endif
 #include <ctype.h>
+#include <time.h>
 
 #include "pmix_common.h"
 
@@ -39,12 +40,21 @@ pmix_prm_module_t pmix_prm_slurm_module = {
     .get_remaining_time = get_remaining_time
 };
 
+/* squeue is an external command, so rather than run it each time
+ * we are asked, remember when the allocation ends and only ask
+ * again once that answer is older than the refresh interval - the
+ * time limit of a job can be changed while it runs */
+static time_t queried = 0;
+static time_t deadline = 0;
+static bool unlimited = false;
+
 static int get_remaining_time(uint32_t *timeleft)
 {
     char output[256], *cmd, *jobid, **res;
     FILE *fp;
     uint32_t tleft;
     size_t cnt;
+    time_t now;
 
     /* set the default */
     *timeleft = UINT32_MAX;
@@ -52,6 +62,15 @@ static int get_remaining_time(uint32_t *timeleft)
     if (NULL == (jobid = getenv("SLURM_JOBID"))) {
         return PMIX_ERR_TAKE_NEXT_OPTION;
     }
+
+    now = time(NULL);
+    if (0 != queried && 0 < pmix_prm_slurm_time_refresh
+        && now - queried < (time_t) pmix_prm_slurm_time_refresh) {
+        if (!unlimited) {
+            *timeleft = (deadline > now) ? (uint32_t) (deadline - now) : 0;
+        }
+        return PMIX_SUCCESS;
+    }
     if (0 > pmix_asprintf(&cmd, "squeue -h -j %s -o %%L", jobid)) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
@@ -89,6 +108,9 @@ static int get_remaining_time(uint32_t *timeleft)
     }
     pmix_argv_free(res);
 
+    queried = now;
+    unlimited = (UINT32_MAX == tleft);
+    deadline = now + (time_t) tleft;
     *timeleft = tleft;
     return PMIX_SUCCESS;
 }
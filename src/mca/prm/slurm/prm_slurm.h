@@ -25,6 +25,8 @@ BEGIN_C_DECLS
 PMIX_EXPORT extern pmix_prm_base_component_t pmix_mca_prm_slurm_component;
 extern pmix_prm_module_t pmix_prm_slurm_module;
 
+extern int pmix_prm_slurm_time_refresh;
+
 END_C_DECLS
 
 #endif /* PMIX_PRM_SLURM_H_ */
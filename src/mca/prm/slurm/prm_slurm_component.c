@@ -19,8 +19,11 @@
 #include "src/mca/prm/prm.h"
 #include "prm_slurm.h"
 
+static int component_register(void);
 static int component_query(pmix_mca_base_module_t **module, int *priority);
 
+int pmix_prm_slurm_time_refresh = 60;
+
 /*
  * Struct of function pointers and all that to let us be initialized
  */
@@ -30,8 +33,21 @@ pmix_prm_base_component_t pmix_mca_prm_slurm_component = {
     PMIX_MCA_BASE_MAKE_VERSION(component, PMIX_MAJOR_VERSION, PMIX_MINOR_VERSION,
                                 PMIX_RELEASE_VERSION),
     .pmix_mca_query_component = component_query,
+    .pmix_mca_register_component_params = component_register
 };
 
+static int component_register(void)
+{
+    pmix_prm_slurm_time_refresh = 60;
+    (void) pmix_mca_base_component_var_register(&pmix_mca_prm_slurm_component, "time_refresh",
+                                                "Number of seconds for which the end of the "
+                                                "allocation reported by squeue is reused before "
+                                                "squeue is run again (0 => run it every time)",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &pmix_prm_slurm_time_refresh);
+    return PMIX_SUCCESS;
+}
+
 static int component_query(pmix_mca_base_module_t **module, int *priority)
 {
     /* disqualify ourselves if we are not under slurm */
@@ -95,12 +95,10 @@ static pmix_status_t create_cred(struct pmix_peer_t *peer, const pmix_info_t dir
 {
     int rc;
     bool takeus;
-    char **types;
+    char **types, *mc = NULL;
     size_t n, m;
     PMIX_HIDE_UNUSED_PARAMS(peer);
 
-    PMIX_ACQUIRE_THREAD(&lock);
-
     pmix_output_verbose(2, pmix_globals.debug_output, "psec: munge create_cred");
 
     /* ensure initialization */
@@ -123,7 +121,6 @@ static pmix_status_t create_cred(struct pmix_peer_t *peer, const pmix_info_t dir
                 }
                 pmix_argv_free(types);
                 if (!takeus) {
-                    PMIX_RELEASE_THREAD(&lock);
                     return PMIX_ERR_NOT_SUPPORTED;
                 }
             }
@@ -131,38 +128,39 @@ static pmix_status_t create_cred(struct pmix_peer_t *peer, const pmix_info_t dir
     }
 
     if (initialized) {
+        /* the credential we obtained at init can serve the first
+         * request - we only need the lock to hand it out once */
+        PMIX_ACQUIRE_THREAD(&lock);
         if (!refresh) {
             refresh = true;
-            cred->bytes = strdup(mycred);
-            cred->size = strlen(mycred) + 1;
-        } else {
+            mc = mycred;
+            mycred = NULL;
+        }
+        PMIX_RELEASE_THREAD(&lock);
+        if (NULL == mc) {
             /* munge does not allow reuse of a credential, so we have to
-             * refresh it for every use */
-            if (NULL != mycred) {
-                free(mycred);
-            }
-            if (EMUNGE_SUCCESS != (rc = munge_encode(&mycred, NULL, NULL, 0))) {
+             * refresh it for every use. Do so without holding the lock
+             * so that threads asking for one at the same time don't
+             * wait on each other's trip to munged */
+            if (EMUNGE_SUCCESS != (rc = munge_encode(&mc, NULL, NULL, 0))) {
                 pmix_output_verbose(2, pmix_globals.debug_output,
                                     "psec: munge failed to create credential: %s",
                                     munge_strerror(rc));
-                PMIX_RELEASE_THREAD(&lock);
                 return PMIX_ERR_NOT_SUPPORTED;
             }
-            cred->bytes = strdup(mycred);
-            cred->size = strlen(mycred) + 1;
         }
+        cred->bytes = mc;
+        cred->size = strlen(mc) + 1;
     }
     if (NULL != info) {
         /* mark that this came from us */
         PMIX_INFO_CREATE(*info, 1);
         if (NULL == *info) {
-            PMIX_RELEASE_THREAD(&lock);
             return PMIX_ERR_NOMEM;
         }
         *ninfo = 1;
         PMIX_INFO_LOAD(info[0], PMIX_CRED_TYPE, "munge", PMIX_STRING);
     }
-    PMIX_RELEASE_THREAD(&lock);
     return PMIX_SUCCESS;
 }
 
@@ -53,7 +53,8 @@ PMIX_EXPORT extern pmix_psensor_base_t pmix_psensor_base;
 
 PMIX_EXPORT pmix_status_t pmix_psensor_base_start(pmix_peer_t *requestor, pmix_status_t error,
                                                   const pmix_info_t *monitor,
-                                                  const pmix_info_t directives[], size_t ndirs);
+                                                  const pmix_info_t directives[], size_t ndirs,
+                                                  pmix_list_t *results);
 
 PMIX_EXPORT pmix_status_t pmix_psensor_base_stop(pmix_peer_t *requestor, char *id);
 
@@ -40,11 +40,16 @@
 #endif
 #include <sys/stat.h>
 #include <sys/types.h>
+#ifdef HAVE_SYS_INOTIFY_H
+#    include <sys/inotify.h>
+#endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_path.h"
 #include "src/util/pmix_show_help.h"
 
 #include "psensor_file.h"
@@ -52,7 +57,8 @@
 
 /* declare the API functions */
 static pmix_status_t start(pmix_peer_t *requestor, pmix_status_t error, const pmix_info_t *monitor,
-                           const pmix_info_t directives[], size_t ndirs);
+                           const pmix_info_t directives[], size_t ndirs,
+                           pmix_list_t *results);
 static pmix_status_t stop(pmix_peer_t *requestor, char *id);
 
 /* instantiate the module */
@@ -63,8 +69,6 @@ typedef struct {
     pmix_list_item_t super;
     pmix_peer_t *requestor;
     char *id;
-    bool event_active;
-    pmix_event_t ev;
     pmix_event_t cdev;
     struct timeval tv;
     int tick;
@@ -81,12 +85,20 @@ typedef struct {
     pmix_data_range_t range;
     pmix_info_t *info;
     size_t ninfo;
+    /* sweeps left before the next sample */
+    time_t remaining;
+    /* inotify watch on the file, or -1 if it has to be stat'd */
+    int wd;
+    bool nfs;
+    bool changed;
+    /* result of the stat taken in the current sweep */
+    struct stat sbuf;
+    bool sbuf_valid;
 } file_tracker_t;
 static void ft_constructor(file_tracker_t *ft)
 {
     ft->requestor = NULL;
     ft->id = NULL;
-    ft->event_active = false;
     ft->tv.tv_sec = 0;
     ft->tv.tv_usec = 0;
     ft->tick = 0;
@@ -102,6 +114,12 @@ static void ft_constructor(file_tracker_t *ft)
     ft->range = PMIX_RANGE_NAMESPACE;
     ft->info = NULL;
     ft->ninfo = 0;
+    ft->remaining = 0;
+    ft->wd = -1;
+    ft->nfs = false;
+    /* the first sample always compares against the initial values */
+    ft->changed = true;
+    ft->sbuf_valid = false;
 }
 static void ft_destructor(file_tracker_t *ft)
 {
@@ -111,9 +129,6 @@ static void ft_destructor(file_tracker_t *ft)
     if (NULL != ft->id) {
         free(ft->id);
     }
-    if (ft->event_active) {
-        pmix_event_del(&ft->ev);
-    }
     if (NULL != ft->file) {
         free(ft->file);
     }
@@ -146,35 +161,141 @@ static void cd_des(file_caddy_t *p)
 }
 PMIX_CLASS_INSTANCE(file_caddy_t, pmix_object_t, cd_con, cd_des);
 
-static void file_sample(int sd, short args, void *cbdata);
+static void sweep(int sd, short args, void *cbdata);
+
+static void start_sweep(void)
+{
+    struct timeval tv = {1, 0};
+
+    pmix_event_evtimer_set(pmix_psensor_base.evbase, &pmix_mca_psensor_file_component.sweep, sweep,
+                           NULL);
+    pmix_event_evtimer_add(&pmix_mca_psensor_file_component.sweep, &tv);
+    pmix_mca_psensor_file_component.sweep_active = true;
+}
+
+#ifdef HAVE_SYS_INOTIFY_H
+static void inotify_recv(int sd, short args, void *cbdata)
+{
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event *ev;
+    file_tracker_t *ft;
+    ssize_t len;
+    char *ptr;
+    PMIX_HIDE_UNUSED_PARAMS(args, cbdata);
+
+    while (0 < (len = read(sd, buf, sizeof(buf)))) {
+        for (ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + ev->len) {
+            ev = (const struct inotify_event *) ptr;
+            if (ev->mask & IN_MOVE_SELF) {
+                /* the watch follows the inode, not the name */
+                inotify_rm_watch(sd, ev->wd);
+            }
+            PMIX_LIST_FOREACH (ft, &pmix_mca_psensor_file_component.trackers, file_tracker_t) {
+                if (ft->wd != ev->wd) {
+                    continue;
+                }
+                if (ev->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                    /* go back to stat'ing it until it reappears */
+                    ft->wd = -1;
+                } else if ((ft->file_access && (ev->mask & IN_ACCESS))
+                           || (ft->file_size && (ev->mask & IN_MODIFY))
+                           || (ft->file_mod && (ev->mask & (IN_MODIFY | IN_ATTRIB)))) {
+                    ft->changed = true;
+                }
+            }
+        }
+    }
+}
+#endif
+
+/* have the kernel tell us when a local file changes so we
+ * only need to look at it when it does */
+static void watch(file_tracker_t *ft)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+    pmix_psensor_file_component_t *c = &pmix_mca_psensor_file_component;
+
+    if (!c->use_inotify || ft->nfs || 0 <= ft->wd) {
+        return;
+    }
+    if (0 > c->inotify_fd) {
+        c->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (0 > c->inotify_fd) {
+            pmix_output_verbose(2, pmix_psensor_base_framework.framework_output,
+                                "psensor:file inotify unavailable - stat'ing files");
+            c->use_inotify = false;
+            return;
+        }
+        pmix_event_set(pmix_psensor_base.evbase, &c->inev, c->inotify_fd, EV_READ | EV_PERSIST,
+                       inotify_recv, NULL);
+        pmix_event_add(&c->inev, 0);
+        c->inev_active = true;
+    }
+    ft->wd = inotify_add_watch(c->inotify_fd, ft->file,
+                               IN_ACCESS | IN_MODIFY | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+    pmix_output_verbose(2, pmix_psensor_base_framework.framework_output,
+                        "psensor:file %s %s", ft->file, (0 <= ft->wd) ? "watched" : "stat'd");
+#else
+    PMIX_HIDE_UNUSED_PARAMS(ft);
+#endif
+}
+
+static void unwatch(file_tracker_t *ft)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+    file_tracker_t *t;
+
+    if (0 > ft->wd) {
+        return;
+    }
+    /* the kernel hands out one watch per inode */
+    PMIX_LIST_FOREACH (t, &pmix_mca_psensor_file_component.trackers, file_tracker_t) {
+        if (t != ft && t->wd == ft->wd) {
+            ft->wd = -1;
+            return;
+        }
+    }
+    inotify_rm_watch(pmix_mca_psensor_file_component.inotify_fd, ft->wd);
+    ft->wd = -1;
+#else
+    PMIX_HIDE_UNUSED_PARAMS(ft);
+#endif
+}
 
 static void add_tracker(int sd, short flags, void *cbdata)
 {
     file_tracker_t *ft = (file_tracker_t *) cbdata;
 
-    PMIX_ACQUIRE_OBJECT(fd);
+    PMIX_ACQUIRE_OBJECT(ft);
 
     PMIX_HIDE_UNUSED_PARAMS(sd, flags);
 
     /* add the tracker to our list */
     pmix_list_append(&pmix_mca_psensor_file_component.trackers, &ft->super);
 
-    /* setup the timer event */
-    pmix_event_evtimer_set(pmix_psensor_base.evbase, &ft->ev, file_sample, ft);
-    pmix_event_evtimer_add(&ft->ev, &ft->tv);
-    ft->event_active = true;
+    /* stat'ing files on a network filesystem is expensive, but
+     * inotify cannot see changes made from other nodes */
+    ft->nfs = pmix_path_nfs(ft->file, NULL);
+    watch(ft);
+
+    /* all trackers are sampled from a single timer */
+    ft->remaining = ft->tv.tv_sec;
+    if (!pmix_mca_psensor_file_component.sweep_active) {
+        start_sweep();
+    }
 }
 
 /*
  * Start monitoring of local processes
  */
 static pmix_status_t start(pmix_peer_t *requestor, pmix_status_t error, const pmix_info_t *monitor,
-                           const pmix_info_t directives[], size_t ndirs)
+                           const pmix_info_t directives[], size_t ndirs,
+                           pmix_list_t *results)
 {
     file_tracker_t *ft;
     size_t n;
 
-    PMIX_HIDE_UNUSED_PARAMS(error);
+    PMIX_HIDE_UNUSED_PARAMS(error, results);
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] checking file monitoring for requestor %s:%d",
@@ -238,6 +359,7 @@ static void del_tracker(int sd, short flags, void *cbdata)
             continue;
         }
         if (NULL == cd->id || (NULL != ft->id && 0 == strcmp(ft->id, cd->id))) {
+            unwatch(ft);
             pmix_list_remove_item(&pmix_mca_psensor_file_component.trackers, &ft->super);
             PMIX_RELEASE(ft);
         }
@@ -273,59 +395,84 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(ft);
 }
 
-static void file_sample(int sd, short args, void *cbdata)
+/* stat the file, sharing the result with any other tracker
+ * of the same file sampled in this sweep */
+static bool get_stat(file_tracker_t *ft, pmix_hash_table_t *seen)
 {
-    file_tracker_t *ft = (file_tracker_t *) cbdata;
-    struct stat buf;
-    pmix_status_t rc;
-    pmix_proc_t source;
+    file_tracker_t *prev;
 
-    PMIX_ACQUIRE_OBJECT(ft);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(seen, ft->file, strlen(ft->file),
+                                                      (void **) &prev)) {
+        ft->sbuf = prev->sbuf;
+        ft->sbuf_valid = prev->sbuf_valid;
+        return ft->sbuf_valid;
+    }
+    /* coverity[TOCTOU] */
+    ft->sbuf_valid = (0 == stat(ft->file, &ft->sbuf));
+    pmix_hash_table_set_value_ptr(seen, ft->file, strlen(ft->file), ft);
+    return ft->sbuf_valid;
+}
 
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+/* returns true if the tracker was removed */
+static bool file_sample(file_tracker_t *ft, pmix_hash_table_t *seen)
+{
+    struct stat *buf = &ft->sbuf;
+    file_tracker_t *prev;
+    pmix_status_t rc;
+    pmix_proc_t source;
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] sampling file %s", pmix_globals.myid.nspace,
                          pmix_globals.myid.rank, ft->file));
 
-    /* stat the file and get its info */
-    /* coverity[TOCTOU] */
-    if (0 > stat(ft->file, &buf)) {
-        /* cannot stat file */
-        PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
-                             "[%s:%d] could not stat %s", pmix_globals.myid.nspace,
-                             pmix_globals.myid.rank, ft->file));
-        /* re-add the timer, in case this file shows up */
-        pmix_event_evtimer_add(&ft->ev, &ft->tv);
-        return;
-    }
-
-    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
-                         "[%s:%d] size %lu access %s\tmod %s", pmix_globals.myid.nspace,
-                         pmix_globals.myid.rank, (unsigned long) buf.st_size, ctime(&buf.st_atime),
-                         ctime(&buf.st_mtime)));
-
-    if (ft->file_size) {
-        if (buf.st_size == (int64_t) ft->last_size) {
-            ft->nmisses++;
-        } else {
-            ft->nmisses = 0;
-            ft->last_size = buf.st_size;
-        }
-    } else if (ft->file_access) {
-        if (buf.st_atime == ft->last_access) {
-            ft->nmisses++;
-        } else {
-            ft->nmisses = 0;
-            ft->last_access = buf.st_atime;
+    if (0 <= ft->wd && !ft->changed) {
+        /* inotify says nothing happened */
+        ft->nmisses++;
+    } else if (0 <= ft->wd && !ft->file_size) {
+        /* the event is all we need to know */
+        ft->nmisses = 0;
+        ft->changed = false;
+    } else {
+        ft->changed = false;
+        /* stat the file and get its info */
+        if (!get_stat(ft, seen)) {
+            /* cannot stat file */
+            PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                                 "[%s:%d] could not stat %s", pmix_globals.myid.nspace,
+                                 pmix_globals.myid.rank, ft->file));
+            /* check again next time, in case this file shows up */
+            return false;
         }
-    } else if (ft->file_mod) {
-        if (buf.st_mtime == ft->last_mod) {
-            ft->nmisses++;
-        } else {
-            ft->nmisses = 0;
-            ft->last_mod = buf.st_mtime;
+
+        PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                             "[%s:%d] size %lu access %s\tmod %s", pmix_globals.myid.nspace,
+                             pmix_globals.myid.rank, (unsigned long) buf->st_size,
+                             ctime(&buf->st_atime), ctime(&buf->st_mtime)));
+
+        if (ft->file_size) {
+            if (buf->st_size == (int64_t) ft->last_size) {
+                ft->nmisses++;
+            } else {
+                ft->nmisses = 0;
+                ft->last_size = buf->st_size;
+            }
+        } else if (ft->file_access) {
+            if (buf->st_atime == ft->last_access) {
+                ft->nmisses++;
+            } else {
+                ft->nmisses = 0;
+                ft->last_access = buf->st_atime;
+            }
+        } else if (ft->file_mod) {
+            if (buf->st_mtime == ft->last_mod) {
+                ft->nmisses++;
+            } else {
+                ft->nmisses = 0;
+                ft->last_mod = buf->st_mtime;
+            }
         }
+        /* the file may have (re)appeared since we last tried */
+        watch(ft);
     }
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
@@ -338,6 +485,12 @@ static void file_sample(int sd, short args, void *cbdata)
                            ft->last_size, ctime(&ft->last_access), ctime(&ft->last_mod));
         }
         /* stop monitoring this client */
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(seen, ft->file, strlen(ft->file),
+                                                          (void **) &prev)
+            && prev == ft) {
+            pmix_hash_table_remove_value_ptr(seen, ft->file, strlen(ft->file));
+        }
+        unwatch(ft);
         pmix_list_remove_item(&pmix_mca_psensor_file_component.trackers, &ft->super);
         /* generate an event */
         pmix_strncpy(source.nspace, ft->requestor->info->pname.nspace, PMIX_MAX_NSLEN);
@@ -347,9 +500,33 @@ static void file_sample(int sd, short args, void *cbdata)
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
         }
-        return;
+        return true;
+    }
+    return false;
+}
+
+/* called once a second to sample every tracker whose
+ * check time has come around */
+static void sweep(int sd, short args, void *cbdata)
+{
+    file_tracker_t *ft, *ftnext;
+    pmix_hash_table_t *seen = &pmix_mca_psensor_file_component.seen;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    PMIX_LIST_FOREACH_SAFE (ft, ftnext, &pmix_mca_psensor_file_component.trackers,
+                            file_tracker_t) {
+        if (0 < --ft->remaining) {
+            continue;
+        }
+        ft->remaining = ft->tv.tv_sec;
+        (void) file_sample(ft, seen);
     }
+    pmix_hash_table_remove_all(seen);
 
-    /* re-add the timer */
-    pmix_event_evtimer_add(&ft->ev, &ft->tv);
+    if (0 < pmix_list_get_size(&pmix_mca_psensor_file_component.trackers)) {
+        start_sweep();
+    } else {
+        pmix_mca_psensor_file_component.sweep_active = false;
+    }
 }
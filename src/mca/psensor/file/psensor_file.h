@@ -19,7 +19,9 @@
 
 #include "src/include/pmix_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
 
 #include "src/mca/psensor/psensor.h"
 
@@ -28,6 +30,16 @@ BEGIN_C_DECLS
 typedef struct {
     pmix_psensor_base_component_t super;
     pmix_list_t trackers;
+    /* one inotify fd watching all the local files */
+    bool use_inotify;
+    int inotify_fd;
+    pmix_event_t inev;
+    bool inev_active;
+    /* single timer sampling all the trackers */
+    pmix_event_t sweep;
+    bool sweep_active;
+    /* files already stat'd during the current sweep */
+    pmix_hash_table_t seen;
 } pmix_psensor_file_component_t;
 
 PMIX_EXPORT extern pmix_psensor_file_component_t pmix_mca_psensor_file_component;
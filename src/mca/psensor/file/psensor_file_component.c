@@ -12,6 +12,10 @@
 #include "src/include/pmix_config.h"
 #include "pmix_common.h"
 
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
 #include "src/class/pmix_list.h"
 
 #include "src/mca/psensor/base/base.h"
@@ -23,6 +27,7 @@
 static int psensor_file_open(void);
 static int psensor_file_close(void);
 static int psensor_file_query(pmix_mca_base_module_t **module, int *priority);
+static int psensor_file_register(void);
 
 pmix_psensor_file_component_t pmix_mca_psensor_file_component = {
     .super = {
@@ -38,13 +43,29 @@ pmix_psensor_file_component_t pmix_mca_psensor_file_component = {
         /* Component open and close functions */
         psensor_file_open,  /* component open  */
         psensor_file_close, /* component close */
-        psensor_file_query  /* component query */
-    }
+        psensor_file_query, /* component query */
+        psensor_file_register /* component register */
+    },
+    .use_inotify = true,
+    .inotify_fd = -1
 };
 
+static int psensor_file_register(void)
+{
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_psensor_file_component.super, "inotify",
+        "Use inotify to learn of changes to files on local filesystems instead "
+        "of periodically stat'ing them (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_psensor_file_component.use_inotify);
+
+    return PMIX_SUCCESS;
+}
+
 static int psensor_file_open(void)
 {
     PMIX_CONSTRUCT(&pmix_mca_psensor_file_component.trackers, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_mca_psensor_file_component.seen, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_mca_psensor_file_component.seen, 32);
     return PMIX_SUCCESS;
 }
 
@@ -61,6 +82,20 @@ static int psensor_file_query(pmix_mca_base_module_t **module, int *priority)
 
 static int psensor_file_close(void)
 {
+    if (pmix_mca_psensor_file_component.sweep_active) {
+        pmix_event_del(&pmix_mca_psensor_file_component.sweep);
+        pmix_mca_psensor_file_component.sweep_active = false;
+    }
+    if (pmix_mca_psensor_file_component.inev_active) {
+        pmix_event_del(&pmix_mca_psensor_file_component.inev);
+        pmix_mca_psensor_file_component.inev_active = false;
+    }
+    if (0 <= pmix_mca_psensor_file_component.inotify_fd) {
+        /* drops all the watches */
+        close(pmix_mca_psensor_file_component.inotify_fd);
+        pmix_mca_psensor_file_component.inotify_fd = -1;
+    }
     PMIX_LIST_DESTRUCT(&pmix_mca_psensor_file_component.trackers);
+    PMIX_DESTRUCT(&pmix_mca_psensor_file_component.seen);
     return PMIX_SUCCESS;
 }
@@ -28,9 +28,11 @@
 
 #include "src/include/pmix_globals.h"
 #include "src/mca/ptl/base/base.h"
+#include "src/server/pmix_server_ops.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
 #include "src/util/pmix_show_help.h"
 
 #include "psensor_heartbeat.h"
@@ -39,7 +41,7 @@
 /* declare the API functions */
 static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error,
                                      const pmix_info_t *monitor, const pmix_info_t directives[],
-                                     size_t ndirs);
+                                     size_t ndirs, pmix_list_t *results);
 static pmix_status_t heartbeat_stop(pmix_peer_t *requestor, char *id);
 
 /* instantiate the module */
@@ -63,6 +65,10 @@ typedef struct {
     pmix_info_t *info;
     size_t ninfo;
     bool stopped;
+    /* shared page slot the requestor counts beats in, or -1 */
+    int slot;
+    uint64_t lastbeat;
+    time_t remaining;
 } pmix_heartbeat_trkr_t;
 
 static void ft_constructor(pmix_heartbeat_trkr_t *ft)
@@ -80,6 +86,9 @@ static void ft_constructor(pmix_heartbeat_trkr_t *ft)
     ft->info = NULL;
     ft->ninfo = 0;
     ft->stopped = false;
+    ft->slot = -1;
+    ft->lastbeat = 0;
+    ft->remaining = 0;
 }
 static void ft_destructor(pmix_heartbeat_trkr_t *ft)
 {
@@ -140,6 +149,57 @@ static void bdes(pmix_psensor_beat_t *p)
 PMIX_CLASS_INSTANCE(pmix_psensor_beat_t, pmix_object_t, bcon, bdes);
 
 static void check_heartbeat(int fd, short dummy, void *arg);
+static void sweep(int fd, short dummy, void *arg);
+
+static void start_sweep(void)
+{
+    struct timeval tv = {1, 0};
+
+    pmix_event_evtimer_set(pmix_psensor_base.evbase, &pmix_mca_psensor_heartbeat_component.sweep,
+                           sweep, NULL);
+    pmix_event_evtimer_add(&pmix_mca_psensor_heartbeat_component.sweep, &tv);
+    pmix_mca_psensor_heartbeat_component.sweep_active = true;
+}
+
+/* return the slot in the shared page the requestor can count
+ * beats in, creating the page on first use */
+static int get_slot(pmix_peer_t *requestor)
+{
+    pmix_psensor_heartbeat_component_t *c = &pmix_mca_psensor_heartbeat_component;
+    uintptr_t addr;
+    size_t size;
+    char *path;
+    pmix_status_t rc;
+
+    if (!c->use_shmem || c->page_failed || NULL == pmix_server_globals.tmpdir
+        || 0 > requestor->index || c->nslots <= requestor->index) {
+        return -1;
+    }
+    if (NULL == c->page) {
+        c->page = PMIX_NEW(pmix_shmem_t);
+        if (NULL == c->page) {
+            c->page_failed = true;
+            return -1;
+        }
+        size = (size_t) c->nslots * sizeof(uint64_t);
+        pmix_asprintf(&path, "%s/pmix_hbeat.%lu", pmix_server_globals.tmpdir,
+                      (unsigned long) getpid());
+        rc = pmix_shmem_segment_create(c->page, size, path);
+        free(path);
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_shmem_segment_attach(c->page, NULL, &addr);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(c->page);
+            c->page = NULL;
+            c->page_failed = true;
+            return -1;
+        }
+        /* ftruncate gave us a zero-filled page */
+        c->beats = (volatile uint64_t *) c->page->base_address;
+    }
+    return requestor->index;
+}
 
 static void add_tracker(int sd, short flags, void *cbdata)
 {
@@ -151,6 +211,15 @@ static void add_tracker(int sd, short flags, void *cbdata)
     /* add the tracker to our list */
     pmix_list_append(&pmix_mca_psensor_heartbeat_component.trackers, &ft->super);
 
+    if (0 <= ft->slot) {
+        /* the sweep checks it along with the other shared slots */
+        ft->remaining = ft->tv.tv_sec;
+        if (!pmix_mca_psensor_heartbeat_component.sweep_active) {
+            start_sweep();
+        }
+        return;
+    }
+
     /* setup the timer event */
     pmix_event_evtimer_set(pmix_psensor_base.evbase, &ft->ev, check_heartbeat, ft);
     pmix_event_evtimer_add(&ft->ev, &ft->tv);
@@ -159,11 +228,12 @@ static void add_tracker(int sd, short flags, void *cbdata)
 
 static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error,
                                      const pmix_info_t *monitor, const pmix_info_t directives[],
-                                     size_t ndirs)
+                                     size_t ndirs, pmix_list_t *results)
 {
     pmix_heartbeat_trkr_t *ft;
     size_t n;
     pmix_ptl_posted_recv_t *rcv;
+    uint32_t slot;
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] checking heartbeat monitoring for requestor %s:%d",
@@ -198,6 +268,18 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
         return PMIX_ERR_BAD_PARAM;
     }
 
+    /* let the requestor count its beats in the shared page, if
+     * we can. Older clients will ignore this and send messages,
+     * so we still post the recv */
+    ft->slot = get_slot(requestor);
+    if (0 <= ft->slot) {
+        ft->lastbeat = pmix_mca_psensor_heartbeat_component.beats[ft->slot];
+        slot = ft->slot;
+        PMIx_Info_list_add((void *) results, PMIX_MONITOR_HEARTBEAT_SHMEM,
+                           pmix_mca_psensor_heartbeat_component.page->backing_path, PMIX_STRING);
+        PMIx_Info_list_add((void *) results, PMIX_MONITOR_HEARTBEAT_SLOT, &slot, PMIX_UINT32);
+    }
+
     /* if the recv hasn't been posted, so so now */
     if (!pmix_mca_psensor_heartbeat_component.recv_active) {
         /* setup to receive heartbeats */
@@ -266,20 +348,13 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(ft); // maintain accounting
 }
 
-/* this function automatically gets periodically called
- * by the event library so we can check on the state
- * of the various procs we are monitoring
- */
-static void check_heartbeat(int fd, short dummy, void *cbdata)
+/* see if the proc beat during the last window and alert
+ * if it did not */
+static void check_tracker(pmix_heartbeat_trkr_t *ft)
 {
-    pmix_heartbeat_trkr_t *ft = (pmix_heartbeat_trkr_t *) cbdata;
     pmix_status_t rc;
     pmix_proc_t source;
 
-    PMIX_ACQUIRE_OBJECT(ft);
-    PMIX_HIDE_UNUSED_PARAMS(fd, dummy);
-
-
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] sensor:check_heartbeat for proc %s:%d", pmix_globals.myid.nspace,
                          pmix_globals.myid.rank, ft->requestor->info->pname.nspace,
@@ -312,11 +387,60 @@ static void check_heartbeat(int fd, short dummy, void *cbdata)
     }
     /* reset for next period */
     ft->nbeats = 0;
+}
+
+/* this function automatically gets periodically called
+ * by the event library so we can check on the state
+ * of the various procs we are monitoring
+ */
+static void check_heartbeat(int fd, short dummy, void *cbdata)
+{
+    pmix_heartbeat_trkr_t *ft = (pmix_heartbeat_trkr_t *) cbdata;
+
+    PMIX_ACQUIRE_OBJECT(ft);
+    PMIX_HIDE_UNUSED_PARAMS(fd, dummy);
+
+    check_tracker(ft);
 
     /* reset the timer */
     pmix_event_evtimer_add(&ft->ev, &ft->tv);
 }
 
+/* called once a second to read the counters in the shared page
+ * for all the procs beating there, checking those whose window
+ * has closed */
+static void sweep(int fd, short dummy, void *cbdata)
+{
+    pmix_heartbeat_trkr_t *ft;
+    uint64_t beat;
+    bool active = false;
+    PMIX_HIDE_UNUSED_PARAMS(fd, dummy, cbdata);
+
+    PMIX_LIST_FOREACH (ft, &pmix_mca_psensor_heartbeat_component.trackers, pmix_heartbeat_trkr_t) {
+        if (0 > ft->slot) {
+            continue;
+        }
+        active = true;
+        if (0 < --ft->remaining) {
+            continue;
+        }
+        beat = pmix_mca_psensor_heartbeat_component.beats[ft->slot];
+        if (beat != ft->lastbeat) {
+            ft->nbeats += (uint32_t) (beat - ft->lastbeat);
+            ft->lastbeat = beat;
+            ft->stopped = false;
+        }
+        check_tracker(ft);
+        ft->remaining = ft->tv.tv_sec;
+    }
+
+    if (active) {
+        start_sweep();
+    } else {
+        pmix_mca_psensor_heartbeat_component.sweep_active = false;
+    }
+}
+
 static void add_beat(int sd, short args, void *cbdata)
 {
     pmix_psensor_beat_t *b = (pmix_psensor_beat_t *) cbdata;
@@ -24,6 +24,7 @@
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/psensor/psensor.h"
+#include "src/util/pmix_shmem.h"
 
 BEGIN_C_DECLS
 
@@ -31,6 +32,15 @@ typedef struct {
     pmix_psensor_base_component_t super;
     bool recv_active;
     pmix_list_t trackers;
+    /* shared page of per-client beat counters */
+    bool use_shmem;
+    int nslots;
+    pmix_shmem_t *page;
+    bool page_failed;
+    volatile uint64_t *beats;
+    /* single timer checking all the counters */
+    pmix_event_t sweep;
+    bool sweep_active;
 } pmix_psensor_heartbeat_component_t;
 
 PMIX_EXPORT extern pmix_psensor_heartbeat_component_t pmix_mca_psensor_heartbeat_component;
@@ -24,6 +24,7 @@
 static int heartbeat_open(void);
 static int heartbeat_close(void);
 static int heartbeat_query(pmix_mca_base_module_t **module, int *priority);
+static int heartbeat_register(void);
 
 pmix_psensor_heartbeat_component_t pmix_mca_psensor_heartbeat_component = {
     .super = {
@@ -37,10 +38,30 @@ pmix_psensor_heartbeat_component_t pmix_mca_psensor_heartbeat_component = {
           /* Component open and close functions */
           heartbeat_open,  /* component open  */
           heartbeat_close, /* component close */
-          heartbeat_query  /* component query */
-    }
+          heartbeat_query, /* component query */
+          heartbeat_register /* component register */
+    },
+    .use_shmem = true,
+    .nslots = 1024
 };
 
+static int heartbeat_register(void)
+{
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_psensor_heartbeat_component.super, "shmem",
+        "Have clients count their heartbeats in a page shared with the server "
+        "instead of sending a message for each one (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_psensor_heartbeat_component.use_shmem);
+
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_psensor_heartbeat_component.super, "shmem_slots",
+        "Number of clients that can count heartbeats in the shared page - any "
+        "beyond this send messages (default: 1024)",
+        PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_mca_psensor_heartbeat_component.nslots);
+
+    return PMIX_SUCCESS;
+}
+
 /**
  * component open/close/init function
  */
@@ -64,7 +85,17 @@ static int heartbeat_query(pmix_mca_base_module_t **module, int *priority)
 
 static int heartbeat_close(void)
 {
+    if (pmix_mca_psensor_heartbeat_component.sweep_active) {
+        pmix_event_del(&pmix_mca_psensor_heartbeat_component.sweep);
+        pmix_mca_psensor_heartbeat_component.sweep_active = false;
+    }
     PMIX_LIST_DESTRUCT(&pmix_mca_psensor_heartbeat_component.trackers);
+    if (NULL != pmix_mca_psensor_heartbeat_component.page) {
+        /* detaches and removes the backing file */
+        PMIX_RELEASE(pmix_mca_psensor_heartbeat_component.page);
+        pmix_mca_psensor_heartbeat_component.page = NULL;
+        pmix_mca_psensor_heartbeat_component.beats = NULL;
+    }
 
     return PMIX_SUCCESS;
 }
@@ -37,12 +37,15 @@ BEGIN_C_DECLS
  *
  * directives - an array of pmix_info_t specifying relevant limits on values, and action
  *              to be taken when limits exceeded. Can include
- *              user-provided "id" string */
+ *              user-provided "id" string
+ *
+ * results - a list of pmix_infolist_t the module can add to for
+ *           return to the requestor */
 typedef pmix_status_t (*pmix_psensor_base_module_start_fn_t)(pmix_peer_t *requestor,
                                                              pmix_status_t error,
                                                              const pmix_info_t *monitor,
                                                              const pmix_info_t directives[],
-                                                             size_t ndirs);
+                                                             size_t ndirs, pmix_list_t *results);
 
 /* stop a sensor operation:
  *
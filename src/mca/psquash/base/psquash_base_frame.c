@@ -50,7 +50,9 @@ pmix_psquash_base_module_t pmix_psquash = {
     .finalize = NULL,
     .get_max_size = NULL,
     .encode_int = NULL,
-    .decode_int = NULL
+    .decode_int = NULL,
+    .encode_int_array = NULL,
+    .decode_int_array = NULL
 };
 pmix_psquash_globals_t pmix_psquash_globals = {
     .initialized = false,
@@ -217,6 +217,18 @@ static pmix_status_t flex128_encode_int(pmix_data_type_t type, void *src, void *
 static pmix_status_t flex128_decode_int(pmix_data_type_t type, void *src, size_t src_len,
                                         void *dest, size_t *dst_size);
 
+static pmix_status_t flex128_encode_int_array(pmix_data_type_t type, void *src, size_t nvals,
+                                              void *dst, size_t *size);
+
+static pmix_status_t flex128_decode_int_array(pmix_data_type_t type, void *src, size_t src_len,
+                                              size_t nvals, void *dest, size_t *src_used);
+
+static pmix_status_t adaptive_encode_int_array(pmix_data_type_t type, void *src, size_t nvals,
+                                               void *dst, size_t *size);
+
+static pmix_status_t adaptive_decode_int_array(pmix_data_type_t type, void *src, size_t src_len,
+                                               size_t nvals, void *dest, size_t *src_used);
+
 static size_t flex_pack_integer(size_t val, uint8_t out_buf[FLEX_BASE7_MAX_BUF_SIZE]);
 
 static size_t flex_unpack_integer(const uint8_t in_buf[], size_t buf_size, size_t *out_val,
@@ -228,7 +240,21 @@ pmix_psquash_base_module_t pmix_flex128_module = {.name = "flex128",
                                                   .finalize = flex128_finalize,
                                                   .get_max_size = flex128_get_max_size,
                                                   .encode_int = flex128_encode_int,
-                                                  .decode_int = flex128_decode_int};
+                                                  .decode_int = flex128_decode_int,
+                                                  .encode_int_array = flex128_encode_int_array,
+                                                  .decode_int_array = flex128_decode_int_array};
+
+/* the same, except that arrays are tagged with the encoding
+ * that suits their values - see adaptive_encode_int_array */
+pmix_psquash_base_module_t pmix_flex128_adaptive_module = {.name = "flex128",
+                                                           .int_type_is_encoded = true,
+                                                           .init = flex128_init,
+                                                           .finalize = flex128_finalize,
+                                                           .get_max_size = flex128_get_max_size,
+                                                           .encode_int = flex128_encode_int,
+                                                           .decode_int = flex128_decode_int,
+                                                           .encode_int_array = adaptive_encode_int_array,
+                                                           .decode_int_array = adaptive_decode_int_array};
 
 static pmix_status_t flex128_init(void)
 {
@@ -296,6 +322,430 @@ static pmix_status_t flex128_decode_int(pmix_data_type_t type, void *src, size_t
     return rc;
 }
 
+/* Arrays are converted in blocks of this many elements. Most of
+ * the integers we pack (ranks, sizes, counts) have small values
+ * that encode to a single byte, so each block is first checked
+ * for that case and then copied with a simple loop the compiler
+ * can vectorize. Blocks with larger values take the per-element
+ * path */
+#define FLEX128_BLOCK_SIZE 16
+
+/* convert a block of integers of C-type (type) to their
+ * flexible representation */
+#define FLEX128_BLOCK_CONVERT(type, conv, src, n, out)   \
+    do {                                                 \
+        const uint8_t *__src = (const uint8_t *) (src);  \
+        size_t __k;                                      \
+        for (__k = 0; __k < (n); __k++) {                \
+            conv(type, __src + __k * sizeof(type),       \
+                 (out)[__k]);                            \
+        }                                                \
+    } while (0)
+
+/* convert a block of flexible representations back
+ * to integers of C-type (type) */
+#define FLEX128_BLOCK_UNCONVERT(type, conv, in, n, dest) \
+    do {                                                 \
+        uint8_t *__dst = (uint8_t *) (dest);             \
+        size_t __k;                                      \
+        for (__k = 0; __k < (n); __k++) {                \
+            conv(type, (in)[__k],                        \
+                 __dst + __k * sizeof(type));            \
+        }                                                \
+    } while (0)
+
+static pmix_status_t flex128_pack_block(pmix_data_type_t type, const uint8_t *src, size_t n,
+                                        size_t vals[FLEX128_BLOCK_SIZE])
+{
+    switch (type) {
+    case PMIX_INT16:
+        FLEX128_BLOCK_CONVERT(int16_t, FLEX128_PACK_CONVERT_SIGNED, src, n, vals);
+        break;
+    case PMIX_UINT16:
+        FLEX128_BLOCK_CONVERT(uint16_t, FLEX128_PACK_CONVERT_UNSIGNED, src, n, vals);
+        break;
+    case PMIX_INT:
+    case PMIX_INT32:
+        FLEX128_BLOCK_CONVERT(int32_t, FLEX128_PACK_CONVERT_SIGNED, src, n, vals);
+        break;
+    case PMIX_UINT:
+    case PMIX_UINT32:
+        FLEX128_BLOCK_CONVERT(uint32_t, FLEX128_PACK_CONVERT_UNSIGNED, src, n, vals);
+        break;
+    case PMIX_INT64:
+        FLEX128_BLOCK_CONVERT(int64_t, FLEX128_PACK_CONVERT_SIGNED, src, n, vals);
+        break;
+    case PMIX_SIZE:
+        FLEX128_BLOCK_CONVERT(size_t, FLEX128_PACK_CONVERT_UNSIGNED, src, n, vals);
+        break;
+    case PMIX_UINT64:
+        FLEX128_BLOCK_CONVERT(uint64_t, FLEX128_PACK_CONVERT_UNSIGNED, src, n, vals);
+        break;
+    default:
+        return PMIX_ERR_BAD_PARAM;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t flex128_unpack_block(pmix_data_type_t type, const size_t vals[FLEX128_BLOCK_SIZE],
+                                          size_t n, uint8_t *dest)
+{
+    switch (type) {
+    case PMIX_INT16:
+        FLEX128_BLOCK_UNCONVERT(int16_t, FLEX128_UNPACK_CONVERT_SIGNED, vals, n, dest);
+        break;
+    case PMIX_UINT16:
+        FLEX128_BLOCK_UNCONVERT(uint16_t, FLEX128_UNPACK_CONVERT_UNSIGNED, vals, n, dest);
+        break;
+    case PMIX_INT:
+    case PMIX_INT32:
+        FLEX128_BLOCK_UNCONVERT(int32_t, FLEX128_UNPACK_CONVERT_SIGNED, vals, n, dest);
+        break;
+    case PMIX_UINT:
+    case PMIX_UINT32:
+        FLEX128_BLOCK_UNCONVERT(uint32_t, FLEX128_UNPACK_CONVERT_UNSIGNED, vals, n, dest);
+        break;
+    case PMIX_INT64:
+        FLEX128_BLOCK_UNCONVERT(int64_t, FLEX128_UNPACK_CONVERT_SIGNED, vals, n, dest);
+        break;
+    case PMIX_SIZE:
+        FLEX128_BLOCK_UNCONVERT(size_t, FLEX128_UNPACK_CONVERT_UNSIGNED, vals, n, dest);
+        break;
+    case PMIX_UINT64:
+        FLEX128_BLOCK_UNCONVERT(uint64_t, FLEX128_UNPACK_CONVERT_UNSIGNED, vals, n, dest);
+        break;
+    default:
+        return PMIX_ERR_BAD_PARAM;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t flex128_encode_int_array(pmix_data_type_t type, void *src, size_t nvals,
+                                              void *dst, size_t *size)
+{
+    pmix_status_t rc;
+    size_t vals[FLEX128_BLOCK_SIZE];
+    size_t val_size, n, k, nblk, acc;
+    uint8_t *in = (uint8_t *) src;
+    uint8_t *out = (uint8_t *) dst;
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (n = 0; n < nvals; n += nblk) {
+        nblk = nvals - n;
+        if (FLEX128_BLOCK_SIZE < nblk) {
+            nblk = FLEX128_BLOCK_SIZE;
+        }
+        rc = flex128_pack_block(type, in + n * val_size, nblk, vals);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        acc = 0;
+        for (k = 0; k < nblk; k++) {
+            acc |= vals[k];
+        }
+        if (PMIX_LIKELY(acc <= FLEX_BASE7_MASK)) {
+            /* every value fits in a single byte without
+             * a continuation flag */
+            for (k = 0; k < nblk; k++) {
+                out[k] = (uint8_t) vals[k];
+            }
+            out += nblk;
+        } else {
+            for (k = 0; k < nblk; k++) {
+                out += flex_pack_integer(vals[k], out);
+            }
+        }
+    }
+    *size = out - (uint8_t *) dst;
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t flex128_decode_int_array(pmix_data_type_t type, void *src, size_t src_len,
+                                              size_t nvals, void *dest, size_t *src_used)
+{
+    pmix_status_t rc;
+    size_t vals[FLEX128_BLOCK_SIZE];
+    size_t val_size, n, k, nblk, used, unpack_val_size;
+    uint8_t *in = (uint8_t *) src;
+    uint8_t acc;
+    size_t avail = src_len;
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (n = 0; n < nvals; n += nblk) {
+        nblk = nvals - n;
+        if (FLEX128_BLOCK_SIZE < nblk) {
+            nblk = FLEX128_BLOCK_SIZE;
+        }
+        acc = FLEX_BASE7_CONT_FLAG;
+        if (nblk <= avail) {
+            acc = 0;
+            for (k = 0; k < nblk; k++) {
+                acc |= in[k];
+            }
+        }
+        if (PMIX_LIKELY(0 == (acc & FLEX_BASE7_CONT_FLAG))) {
+            /* none of the values continue past their first byte */
+            for (k = 0; k < nblk; k++) {
+                vals[k] = in[k];
+            }
+            in += nblk;
+            avail -= nblk;
+        } else {
+            for (k = 0; k < nblk; k++) {
+                if (0 == avail) {
+                    rc = PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+                    PMIX_ERROR_LOG(rc);
+                    return rc;
+                }
+                used = flex_unpack_integer(in, avail, &vals[k], &unpack_val_size);
+                /* sanity checks */
+                if (val_size < unpack_val_size) {
+                    rc = PMIX_ERR_UNPACK_FAILURE;
+                    PMIX_ERROR_LOG(rc);
+                    return rc;
+                }
+                if (used > avail) {
+                    rc = PMIX_ERR_FATAL;
+                    PMIX_ERROR_LOG(rc);
+                    return rc;
+                }
+                in += used;
+                avail -= used;
+            }
+        }
+        rc = flex128_unpack_block(type, vals, nblk, (uint8_t *) dest + n * val_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    *src_used = in - (uint8_t *) src;
+
+    return PMIX_SUCCESS;
+}
+
+/* Arrays of at least this many elements are preceded by a tag
+ * naming their encoding. Shorter ones - most packs are of a single
+ * value - are always base-128 encoded, so they carry no tag */
+#define ADAPTIVE_MIN_VALS 8
+
+#define ADAPTIVE_TAG_FLEX  0 // base-128, as flex128_encode_int_array
+#define ADAPTIVE_TAG_FIXED 1 // the flexible representation in val_size bytes, MSB first
+#define ADAPTIVE_TAG_DELTA 2 // the first value, then the zigzagged differences, base-128
+
+/* the size of the base-128 encoding of val */
+static size_t flex_size(size_t val)
+{
+    size_t n = 1;
+
+    while (val >>= FLEX_BASE7_SHIFT) {
+        if (SIZEOF_SIZE_T == n) {
+            /* the leftover byte of flex_pack_integer */
+            return n + 1;
+        }
+        n++;
+    }
+    return n;
+}
+
+/* map a difference between two flexible representations
+ * onto an unsigned value that is small if the difference is */
+static inline size_t delta_zigzag(size_t prev, size_t val)
+{
+    size_t d = val - prev;
+
+    return (d << 1) ^ (size_t) ((int64_t) d >> 63);
+}
+
+static inline size_t delta_unzigzag(size_t prev, size_t z)
+{
+    return prev + ((z >> 1) ^ (size_t) -(int64_t) (z & 1));
+}
+
+/* Large random values - hashes, addresses - cost a byte more each
+ * in base-128 than their fixed width, while the ranks and offsets
+ * of a sorted list are often far smaller as differences. So the
+ * size of each encoding of the array is computed and the smallest
+ * used, preferring the fixed width on a tie as it decodes fastest.
+ * Computing the sizes costs a conversion pass over the array,
+ * which is cheap beside the copy into the buffer */
+static pmix_status_t adaptive_encode_int_array(pmix_data_type_t type, void *src, size_t nvals,
+                                               void *dst, size_t *size)
+{
+    pmix_status_t rc;
+    size_t vals[FLEX128_BLOCK_SIZE];
+    size_t val_size, n, k, nblk, prev = 0;
+    size_t flex_cost = 0, delta_cost = 0, fixed_cost;
+    uint8_t *in = (uint8_t *) src;
+    uint8_t *out = (uint8_t *) dst;
+    uint8_t tag;
+    int b;
+
+    if (ADAPTIVE_MIN_VALS > nvals) {
+        return flex128_encode_int_array(type, src, nvals, dst, size);
+    }
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (n = 0; n < nvals; n += nblk) {
+        nblk = nvals - n;
+        if (FLEX128_BLOCK_SIZE < nblk) {
+            nblk = FLEX128_BLOCK_SIZE;
+        }
+        rc = flex128_pack_block(type, in + n * val_size, nblk, vals);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        for (k = 0; k < nblk; k++) {
+            flex_cost += flex_size(vals[k]);
+            delta_cost += flex_size(0 == n + k ? vals[k] : delta_zigzag(prev, vals[k]));
+            prev = vals[k];
+        }
+    }
+    fixed_cost = nvals * val_size;
+    if (fixed_cost <= flex_cost && fixed_cost <= delta_cost) {
+        tag = ADAPTIVE_TAG_FIXED;
+    } else if (delta_cost < flex_cost) {
+        tag = ADAPTIVE_TAG_DELTA;
+    } else {
+        tag = ADAPTIVE_TAG_FLEX;
+    }
+    *out++ = tag;
+
+    if (ADAPTIVE_TAG_FLEX == tag) {
+        rc = flex128_encode_int_array(type, src, nvals, out, size);
+        *size += 1;
+        return rc;
+    }
+    for (n = 0; n < nvals; n += nblk) {
+        nblk = nvals - n;
+        if (FLEX128_BLOCK_SIZE < nblk) {
+            nblk = FLEX128_BLOCK_SIZE;
+        }
+        (void) flex128_pack_block(type, in + n * val_size, nblk, vals);
+        if (ADAPTIVE_TAG_FIXED == tag) {
+            for (k = 0; k < nblk; k++) {
+                for (b = (int) val_size - 1; 0 <= b; b--) {
+                    *out++ = (uint8_t) (vals[k] >> (b * CHAR_BIT));
+                }
+            }
+        } else {
+            for (k = 0; k < nblk; k++) {
+                out += flex_pack_integer(0 == n + k ? vals[k] : delta_zigzag(prev, vals[k]), out);
+                prev = vals[k];
+            }
+        }
+    }
+    *size = out - (uint8_t *) dst;
+
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t adaptive_decode_int_array(pmix_data_type_t type, void *src, size_t src_len,
+                                               size_t nvals, void *dest, size_t *src_used)
+{
+    pmix_status_t rc;
+    size_t vals[FLEX128_BLOCK_SIZE];
+    size_t val_size, n, k, nblk, used, unpack_val_size, prev = 0;
+    uint8_t *in = (uint8_t *) src;
+    size_t avail;
+    uint8_t tag;
+    size_t b;
+
+    if (ADAPTIVE_MIN_VALS > nvals) {
+        return flex128_decode_int_array(type, src, src_len, nvals, dest, src_used);
+    }
+    if (0 == src_len) {
+        rc = PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    tag = *in++;
+    avail = src_len - 1;
+    if (ADAPTIVE_TAG_FLEX == tag) {
+        rc = flex128_decode_int_array(type, in, avail, nvals, dest, src_used);
+        *src_used += 1;
+        return rc;
+    }
+    if (ADAPTIVE_TAG_FIXED != tag && ADAPTIVE_TAG_DELTA != tag) {
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (ADAPTIVE_TAG_FIXED == tag && avail < nvals * val_size) {
+        rc = PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    for (n = 0; n < nvals; n += nblk) {
+        nblk = nvals - n;
+        if (FLEX128_BLOCK_SIZE < nblk) {
+            nblk = FLEX128_BLOCK_SIZE;
+        }
+        if (ADAPTIVE_TAG_FIXED == tag) {
+            for (k = 0; k < nblk; k++) {
+                vals[k] = 0;
+                for (b = 0; b < val_size; b++) {
+                    vals[k] = (vals[k] << CHAR_BIT) | *in++;
+                }
+            }
+        } else {
+            for (k = 0; k < nblk; k++) {
+                if (0 == avail) {
+                    rc = PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+                    PMIX_ERROR_LOG(rc);
+                    return rc;
+                }
+                /* a difference may need a byte more than the
+                 * values themselves - the result is truncated
+                 * to the type below in any case */
+                used = flex_unpack_integer(in, avail, &vals[k], &unpack_val_size);
+                if (used > avail) {
+                    rc = PMIX_ERR_FATAL;
+                    PMIX_ERROR_LOG(rc);
+                    return rc;
+                }
+                if (0 < n + k) {
+                    vals[k] = delta_unzigzag(prev, vals[k]);
+                }
+                prev = vals[k];
+                in += used;
+                avail -= used;
+            }
+        }
+        rc = flex128_unpack_block(type, vals, nblk, (uint8_t *) dest + n * val_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    *src_used = in - (uint8_t *) src;
+
+    return PMIX_SUCCESS;
+}
+
 /*
  * Typical representation of a number in computer systems is:
  * A[0]*B^0 + A[1]*B^1 + A[2]*B^2 + ... + A[n]*B^n
@@ -21,6 +21,7 @@ BEGIN_C_DECLS
 /* the component must be visible data for the linker to find it */
 PMIX_EXPORT extern pmix_psquash_base_component_t pmix_mca_psquash_flex128_component;
 extern pmix_psquash_base_module_t pmix_flex128_module;
+extern pmix_psquash_base_module_t pmix_flex128_adaptive_module;
 
 END_C_DECLS
 
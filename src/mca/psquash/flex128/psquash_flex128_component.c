@@ -17,6 +17,7 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/psquash/psquash.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_open(void);
 static pmix_status_t component_close(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
@@ -40,9 +41,24 @@ pmix_psquash_base_component_t pmix_mca_psquash_flex128_component = {
         .pmix_mca_open_component = component_open,
         .pmix_mca_close_component = component_close,
         .pmix_mca_query_component = component_query,
+        .pmix_mca_register_component_params = component_register,
     },
 };
 
+static bool adaptive = false;
+
+static int component_register(void)
+{
+    adaptive = false;
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_psquash_flex128_component.base, "adaptive",
+        "Precede each array of 8 or more integers with a tag naming the encoding that "
+        "packs it smallest - fixed width, base-128, or base-128 differences between "
+        "successive values. All processes of a job must use the same setting",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &adaptive);
+    return PMIX_SUCCESS;
+}
+
 static int component_open(void)
 {
     return PMIX_SUCCESS;
@@ -51,7 +67,11 @@ static int component_open(void)
 static int component_query(pmix_mca_base_module_t **module, int *priority)
 {
     *priority = 20;
-    *module = (pmix_mca_base_module_t *) &pmix_flex128_module;
+    if (adaptive) {
+        *module = (pmix_mca_base_module_t *) &pmix_flex128_adaptive_module;
+    } else {
+        *module = (pmix_mca_base_module_t *) &pmix_flex128_module;
+    }
     return PMIX_SUCCESS;
 }
 
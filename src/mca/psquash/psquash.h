@@ -77,6 +77,39 @@ typedef pmix_status_t (*pmix_psquash_encode_int_fn_t)(pmix_data_type_t type, voi
 typedef pmix_status_t (*pmix_psquash_decode_int_fn_t)(pmix_data_type_t type, void *src,
                                                       size_t src_len, void *dest, size_t *dst_len);
 
+/**
+ * Encode an array of basic integer types into a contiguous destination
+ * buffer. The result must be identical to encoding each element in turn
+ * with encode_int. This is optional - callers fall back to encode_int
+ * if the module doesn't provide it.
+ *
+ * type     - Type of the 'src' elements (PMIX_SIZE, PMIX_INT to PMIX_UINT64)
+ * src      - pointer to an array of basic integer types
+ * nvals    - number of elements in the array
+ * dest     - pointer to buffer to store data, which must be large enough
+ *            to hold nvals elements of the maximum size
+ * dst_len  - pointer to the packed size of dest, in bytes
+ */
+typedef pmix_status_t (*pmix_psquash_encode_int_array_fn_t)(pmix_data_type_t type, void *src,
+                                                            size_t nvals, void *dest,
+                                                            size_t *dst_len);
+
+/**
+ * Decode a contiguous buffer into an array of basic integer types. This
+ * is optional - callers fall back to decode_int if the module doesn't
+ * provide it.
+ *
+ * type     - Type of the 'dest' elements (PMIX_SIZE, PMIX_INT to PMIX_UINT64)
+ * src      - pointer to buffer where data was stored
+ * src_len  - length, in bytes, of the src buffer
+ * nvals    - number of elements to decode
+ * dest     - pointer to an array of basic integer types
+ * src_used - pointer to the number of bytes consumed from src
+ */
+typedef pmix_status_t (*pmix_psquash_decode_int_array_fn_t)(pmix_data_type_t type, void *src,
+                                                            size_t src_len, size_t nvals,
+                                                            void *dest, size_t *src_used);
+
 /**
  * Base structure for a PSQUASH module
  */
@@ -95,6 +128,8 @@ typedef struct {
     /** Integer compression */
     pmix_psquash_encode_int_fn_t encode_int;
     pmix_psquash_decode_int_fn_t decode_int;
+    pmix_psquash_encode_int_array_fn_t encode_int_array;
+    pmix_psquash_decode_int_array_fn_t decode_int_array;
 } pmix_psquash_base_module_t;
 
 /**
@@ -45,5 +45,7 @@ PMIX_EXPORT extern const pmix_pstat_base_component_t pmix_mca_pstat_linux_compon
 
 PMIX_EXPORT extern const pmix_pstat_base_module_t pmix_pstat_linux_module;
 
+extern int pmix_pstat_linux_cache_interval;
+
 END_C_DECLS
 #endif /* pmix_pstat_LINUX_EXPORT_H */
@@ -46,6 +46,10 @@ const char *pmix_pstat_linux_component_version_string
  * Local function
  */
 static int pstat_linux_component_query(pmix_mca_base_module_t **module, int *priority);
+static int pstat_linux_component_register(void);
+
+/* how long, in msecs, a sample may be reused */
+int pmix_pstat_linux_cache_interval = 1000;
 
 /*
  * Instantiate the public struct with all of our public information
@@ -64,8 +68,21 @@ const pmix_pstat_base_component_t pmix_mca_pstat_linux_component = {
                                PMIX_RELEASE_VERSION),
 
     .pmix_mca_query_component = pstat_linux_component_query,
+    .pmix_mca_register_component_params = pstat_linux_component_register,
 };
 
+static int pstat_linux_component_register(void)
+{
+    (void) pmix_mca_base_component_var_register(
+        &pmix_mca_pstat_linux_component, "cache_interval",
+        "Time in msecs for which a sample is reused - once it expires, all of "
+        "the procs being tracked are resampled together. Zero resamples the "
+        "requested proc on every query (default: 1000)",
+        PMIX_MCA_BASE_VAR_TYPE_INT, &pmix_pstat_linux_cache_interval);
+
+    return PMIX_SUCCESS;
+}
+
 static int pstat_linux_component_query(pmix_mca_base_module_t **module, int *priority)
 {
     *priority = 20;
@@ -44,6 +44,7 @@
 
 #include "pstat_linux.h"
 #include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_printf.h"
 
@@ -76,6 +77,41 @@ typedef struct {
 } ndstats_t;
 static PMIX_CLASS_INSTANCE(ndstats_t, pmix_list_item_t, NULL, NULL);
 
+/* a proc we have been asked about, with its /proc files held open
+ * so that resampling it does not have to look them up again */
+typedef struct {
+    pmix_list_item_t super;
+    pid_t pid;
+    int statfd;
+    int statusfd;
+    int rollupfd;
+    bool sampled;
+    pmix_proc_stats_t stats;
+} pstat_proc_t;
+static void pcon(pstat_proc_t *p)
+{
+    p->pid = 0;
+    p->statfd = -1;
+    p->statusfd = -1;
+    p->rollupfd = -1;
+    p->sampled = false;
+    PMIX_PROC_STATS_CONSTRUCT(&p->stats);
+}
+static void pdes(pstat_proc_t *p)
+{
+    if (0 <= p->statfd) {
+        close(p->statfd);
+    }
+    if (0 <= p->statusfd) {
+        close(p->statusfd);
+    }
+    if (0 <= p->rollupfd) {
+        close(p->rollupfd);
+    }
+    PMIX_PROC_STATS_DESTRUCT(&p->stats);
+}
+static PMIX_CLASS_INSTANCE(pstat_proc_t, pmix_list_item_t, pcon, pdes);
+
 /* Local functions */
 static char *local_getline(FILE *fp);
 static char *local_stripper(char *data);
@@ -83,14 +119,26 @@ static void local_getfields(char *data, char ***fields);
 
 /* Local data */
 static char input[PMIX_STAT_MAX_LENGTH];
+static pmix_list_t procs;
+static struct timeval last_sweep;
+static bool swept = false;
+static pmix_node_stats_t ncache;
+static struct timeval last_node;
+static bool have_node = false;
 
 static int linux_module_init(void)
 {
+    PMIX_CONSTRUCT(&procs, pmix_list_t);
+    PMIX_NODE_STATS_CONSTRUCT(&ncache);
+    swept = false;
+    have_node = false;
     return PMIX_SUCCESS;
 }
 
 static int linux_module_fini(void)
 {
+    PMIX_LIST_DESTRUCT(&procs);
+    PMIX_NODE_STATS_DESTRUCT(&ncache);
     return PMIX_SUCCESS;
 }
 
@@ -129,387 +177,506 @@ static float convert_value(char *value)
     return fval;
 }
 
-static int query(pid_t pid, pmix_proc_stats_t *stats, pmix_node_stats_t *nstats)
+
+/* read the whole of an open /proc file from its start */
+static int read_proc(int fd, char *data, size_t size)
+{
+    ssize_t len;
+
+    len = pread(fd, data, size - 1, 0);
+    if (len < 0) {
+        return -1;
+    }
+    data[len] = '\0';
+    return (int) len;
+}
+
+/* find the value on the "key:" line of the given data */
+static char *find_value(char *data, const char *key)
+{
+    char *ptr = data;
+    size_t klen = strlen(key);
+
+    while (NULL != ptr && '\0' != *ptr) {
+        if (0 == strncmp(ptr, key, klen) && ':' == ptr[klen]) {
+            return ptr + klen + 1;
+        }
+        if (NULL != (ptr = strchr(ptr, '\n'))) {
+            ++ptr;
+        }
+    }
+    return NULL;
+}
+
+static bool expired(struct timeval *since, struct timeval *now)
+{
+    long msec;
+
+    msec = (now->tv_sec - since->tv_sec) * 1000 + (now->tv_usec - since->tv_usec) / 1000;
+    return msec >= pmix_pstat_linux_cache_interval;
+}
+
+static pstat_proc_t *find_proc(pid_t pid)
+{
+    pstat_proc_t *p;
+
+    PMIX_LIST_FOREACH (p, &procs, pstat_proc_t) {
+        if (p->pid == pid) {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static pstat_proc_t *track_proc(pid_t pid)
+{
+    pstat_proc_t *p;
+    char path[64];
+
+    p = PMIX_NEW(pstat_proc_t);
+    p->pid = pid;
+    pmix_snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    if (0 > (p->statfd = open(path, O_RDONLY))) {
+        /* can't access this file - most likely, this means we
+         * aren't really on a supported system, or the proc no
+         * longer exists. Just return an error
+         */
+        PMIX_RELEASE(p);
+        return NULL;
+    }
+    pmix_snprintf(path, sizeof(path), "/proc/%d/status", pid);
+    p->statusfd = open(path, O_RDONLY);
+    /* newer kernels total up the smaps for us */
+    pmix_snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", pid);
+    p->rollupfd = open(path, O_RDONLY);
+    pmix_list_append(&procs, &p->super);
+    return p;
+}
+
+static int sample_proc(pstat_proc_t *p, struct timeval *now)
 {
+    pmix_proc_stats_t *stats = &p->stats;
     char data[4096];
-    int fd;
     size_t numchars;
     char *ptr, *eptr;
-    int i;
     int len, itime;
     double dtime;
     FILE *fp;
     char *dptr, *value;
-    char **fields;
-    pmix_list_t cache;
-    dstats_t *ds;
-    ndstats_t *ns;
 
-    if (NULL != stats) {
-        /* record the time of this sample */
-        gettimeofday(&stats->sample_time, NULL);
-        /* check the nstats - don't do gettimeofday twice
-         * as it is expensive
-         */
-        if (NULL != nstats) {
-            nstats->sample_time.tv_sec = stats->sample_time.tv_sec;
-            nstats->sample_time.tv_usec = stats->sample_time.tv_usec;
-        }
-    } else if (NULL != nstats) {
-        /* record the time of this sample */
-        gettimeofday(&nstats->sample_time, NULL);
+    /* absorb all of the file's contents in one gulp - we'll process
+     * it once it is in memory for speed
+     */
+    if (0 > (len = read_proc(p->statfd, data, sizeof(data)))) {
+        /* the proc has gone away */
+        return PMIX_ERROR;
     }
 
-    if (NULL != stats) {
-        stats->node = strdup(pmix_globals.hostname);
+    PMIX_PROC_STATS_DESTRUCT(stats);
+    PMIX_PROC_STATS_CONSTRUCT(stats);
+    stats->sample_time = *now;
+    stats->node = strdup(pmix_globals.hostname);
 
-        /* create the stat filename for this proc */
-        numchars = pmix_snprintf(data, sizeof(data), "/proc/%d/stat", pid);
-        if (numchars >= sizeof(data)) {
-            return PMIX_ERROR;
+    /* the stat file consists of a single line in a carefully formatted
+     * form. Parse it field by field as per proc(3) to get the ones we want
+     */
+
+    /* we don't need to read the pid from the file - we already know it! */
+    stats->pid = p->pid;
+
+    /* the cmd is surrounded by parentheses - find the start */
+    if (NULL == (ptr = strchr(data, '('))) {
+        /* no cmd => something wrong with data, return error */
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* step over the paren */
+    ptr++;
+
+    /* find the ending paren */
+    if (NULL == (eptr = strchr(ptr, ')'))) {
+        /* no end to cmd => something wrong with data, return error */
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* save the cmd name, up to the limit of the array */
+    *eptr = '\0';
+    stats->cmd = strdup(ptr);
+    *eptr = ')';
+
+    /* move to the next field in the data */
+    ptr = next_field(eptr, len);
+
+    /* next is the process state - a single character */
+    stats->state = *ptr;
+    /* move to next field */
+    ptr = next_field(ptr, len);
+
+    /* skip fields until we get to the times */
+    ptr = next_field(ptr, len); /* ppid */
+    ptr = next_field(ptr, len); /* pgrp */
+    ptr = next_field(ptr, len); /* session */
+    ptr = next_field(ptr, len); /* tty_nr */
+    ptr = next_field(ptr, len); /* tpgid */
+    ptr = next_field(ptr, len); /* flags */
+    ptr = next_field(ptr, len); /* minflt */
+    ptr = next_field(ptr, len); /* cminflt */
+    ptr = next_field(ptr, len); /* majflt */
+    ptr = next_field(ptr, len); /* cmajflt */
+
+    /* grab the process time usage fields */
+    itime = strtoul(ptr, &ptr, 10);  /* utime */
+    itime += strtoul(ptr, &ptr, 10); /* add the stime */
+    /* convert to time in seconds */
+    dtime = (double) itime / (double) HZ;
+    stats->time.tv_sec = (int) dtime;
+    stats->time.tv_usec = (int) (1000000.0 * (dtime - stats->time.tv_sec));
+    /* move to next field */
+    ptr = next_field(ptr, len);
+
+    /* skip fields until we get to priority */
+    ptr = next_field(ptr, len); /* cutime */
+    ptr = next_field(ptr, len); /* cstime */
+
+    /* save the priority */
+    stats->priority = strtol(ptr, &ptr, 10);
+    /* move to next field */
+    ptr = next_field(ptr, len);
+
+    /* skip nice */
+    ptr = next_field(ptr, len);
+
+    /* get number of threads */
+    stats->num_threads = strtoul(ptr, &ptr, 10);
+    /* move to next field */
+    ptr = next_field(ptr, len);
+
+    /* skip fields until we get to processor id */
+    ptr = next_field(ptr, len); /* itrealvalue */
+    ptr = next_field(ptr, len); /* starttime */
+    ptr = next_field(ptr, len); /* vsize */
+    ptr = next_field(ptr, len); /* rss */
+    ptr = next_field(ptr, len); /* rss limit */
+    ptr = next_field(ptr, len); /* startcode */
+    ptr = next_field(ptr, len); /* endcode */
+    ptr = next_field(ptr, len); /* startstack */
+    ptr = next_field(ptr, len); /* kstkesp */
+    ptr = next_field(ptr, len); /* kstkeip */
+    ptr = next_field(ptr, len); /* signal */
+    ptr = next_field(ptr, len); /* blocked */
+    ptr = next_field(ptr, len); /* sigignore */
+    ptr = next_field(ptr, len); /* sigcatch */
+    ptr = next_field(ptr, len); /* wchan */
+    ptr = next_field(ptr, len); /* nswap */
+    ptr = next_field(ptr, len); /* cnswap */
+    ptr = next_field(ptr, len); /* exit_signal */
+
+    /* finally - get the processor */
+    stats->processor = strtol(ptr, NULL, 10);
+
+    /* that's all we care about from this data - ignore the rest */
+    p->sampled = true;
+
+    /* the memory usage is in the status file, parsed according to proc(3) */
+    if (0 <= p->statusfd && 0 < read_proc(p->statusfd, data, sizeof(data))) {
+        if (NULL != (value = find_value(data, "VmPeak"))) {
+            stats->peak_vsize = convert_value(value);
+        }
+        if (NULL != (value = find_value(data, "VmSize"))) {
+            stats->vsize = convert_value(value);
         }
+        if (NULL != (value = find_value(data, "VmRSS"))) {
+            stats->rss = convert_value(value);
+        }
+    }
 
-        if (0 > (fd = open(data, O_RDONLY))) {
-            /* can't access this file - most likely, this means we
-             * aren't really on a supported system, or the proc no
-             * longer exists. Just return an error
-             */
-            return PMIX_ERROR;
+    if (0 <= p->rollupfd) {
+        if (0 < read_proc(p->rollupfd, data, sizeof(data))
+            && NULL != (value = find_value(data, "Pss"))) {
+            stats->pss = convert_value(value);
         }
+        return PMIX_SUCCESS;
+    }
 
-        /* absorb all of the file's contents in one gulp - we'll process
-         * it once it is in memory for speed
-         */
-        memset(data, 0, sizeof(data));
-        len = read(fd, data, sizeof(data) - 1);
-        if (len < 0) {
-            /* This shouldn't happen! */
-            close(fd);
-            return PMIX_ERROR;
+    /* now create the smaps filename for this proc */
+    numchars = pmix_snprintf(data, sizeof(data), "/proc/%d/smaps", p->pid);
+    if (numchars >= sizeof(data)) {
+        return PMIX_SUCCESS;
+    }
+
+    if (NULL == (fp = fopen(data, "r"))) {
+        /* ignore this */
+        return PMIX_SUCCESS;
+    }
+
+    /* parse it to find lines that start with "Pss" */
+    while (NULL != (dptr = local_getline(fp))) {
+        if (NULL == (value = local_stripper(dptr))) {
+            /* cannot process */
+            continue;
+        }
+        /* look for Pss */
+        if (0 == strncmp(dptr, "Pss", strlen("Pss"))) {
+            stats->pss += convert_value(value);
         }
-        close(fd);
+    }
+    fclose(fp);
+    return PMIX_SUCCESS;
+}
+
+/* resample every proc we are tracking in one pass, dropping
+ * any that have gone away */
+static void sweep(struct timeval *now)
+{
+    pstat_proc_t *p, *pnext;
 
-        /* remove newline at end */
-        data[len] = '\0';
+    PMIX_LIST_FOREACH_SAFE (p, pnext, &procs, pstat_proc_t) {
+        if (PMIX_ERROR == sample_proc(p, now)) {
+            pmix_list_remove_item(&procs, &p->super);
+            PMIX_RELEASE(p);
+        }
+    }
+    last_sweep = *now;
+    swept = true;
+}
 
-        /* the stat file consists of a single line in a carefully formatted
-         * form. Parse it field by field as per proc(3) to get the ones we want
+static void sample_node(pmix_node_stats_t *nstats, struct timeval *now)
+{
+    char data[4096];
+    int fd;
+    char *ptr, *eptr;
+    int i;
+    int len;
+    FILE *fp;
+    char *dptr, *value;
+    char **fields;
+    pmix_list_t cache;
+    dstats_t *ds;
+    ndstats_t *ns;
+
+    PMIX_NODE_STATS_DESTRUCT(nstats);
+    PMIX_NODE_STATS_CONSTRUCT(nstats);
+    nstats->sample_time = *now;
+    nstats->node = strdup(pmix_globals.hostname);
+    last_node = *now;
+    have_node = true;
+
+    /* get the loadavg data */
+    if (0 > (fd = open("/proc/loadavg", O_RDONLY))) {
+        /* not an error if we don't find this one as it
+         * isn't critical
          */
+        goto diskstats;
+    }
 
-        /* we don't need to read the pid from the file - we already know it! */
-        stats->pid = pid;
+    /* absorb all of the file's contents in one gulp - we'll process
+     * it once it is in memory for speed
+     */
+    memset(data, 0, sizeof(data));
+    len = read(fd, data, sizeof(data) - 1);
+    close(fd);
+    if (len < 0) {
+        goto diskstats;
+    }
 
-        /* the cmd is surrounded by parentheses - find the start */
-        if (NULL == (ptr = strchr(data, '('))) {
-            /* no cmd => something wrong with data, return error */
-            return PMIX_ERR_BAD_PARAM;
-        }
-        /* step over the paren */
-        ptr++;
+    /* remove newline at end */
+    data[len] = '\0';
 
-        /* find the ending paren */
-        if (NULL == (eptr = strchr(ptr, ')'))) {
-            /* no end to cmd => something wrong with data, return error */
-            return PMIX_ERR_BAD_PARAM;
-        }
+    /* we only care about the first three numbers */
+    nstats->la = strtof(data, &ptr);
+    nstats->la5 = strtof(ptr, &eptr);
+    nstats->la15 = strtof(eptr, NULL);
 
-        /* save the cmd name, up to the limit of the array */
-        *eptr = '\0';
-        stats->cmd = strdup(ptr);
-        *eptr = ')';
-
-        /* move to the next field in the data */
-        ptr = next_field(eptr, len);
-
-        /* next is the process state - a single character */
-        stats->state = *ptr;
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip fields until we get to the times */
-        ptr = next_field(ptr, len); /* ppid */
-        ptr = next_field(ptr, len); /* pgrp */
-        ptr = next_field(ptr, len); /* session */
-        ptr = next_field(ptr, len); /* tty_nr */
-        ptr = next_field(ptr, len); /* tpgid */
-        ptr = next_field(ptr, len); /* flags */
-        ptr = next_field(ptr, len); /* minflt */
-        ptr = next_field(ptr, len); /* cminflt */
-        ptr = next_field(ptr, len); /* majflt */
-        ptr = next_field(ptr, len); /* cmajflt */
-
-        /* grab the process time usage fields */
-        itime = strtoul(ptr, &ptr, 10);  /* utime */
-        itime += strtoul(ptr, &ptr, 10); /* add the stime */
-        /* convert to time in seconds */
-        dtime = (double) itime / (double) HZ;
-        stats->time.tv_sec = (int) dtime;
-        stats->time.tv_usec = (int) (1000000.0 * (dtime - stats->time.tv_sec));
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip fields until we get to priority */
-        ptr = next_field(ptr, len); /* cutime */
-        ptr = next_field(ptr, len); /* cstime */
-
-        /* save the priority */
-        stats->priority = strtol(ptr, &ptr, 10);
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip nice */
-        ptr = next_field(ptr, len);
-
-        /* get number of threads */
-        stats->num_threads = strtoul(ptr, &ptr, 10);
-        /* move to next field */
-        ptr = next_field(ptr, len);
-
-        /* skip fields until we get to processor id */
-        ptr = next_field(ptr, len); /* itrealvalue */
-        ptr = next_field(ptr, len); /* starttime */
-        ptr = next_field(ptr, len); /* vsize */
-        ptr = next_field(ptr, len); /* rss */
-        ptr = next_field(ptr, len); /* rss limit */
-        ptr = next_field(ptr, len); /* startcode */
-        ptr = next_field(ptr, len); /* endcode */
-        ptr = next_field(ptr, len); /* startstack */
-        ptr = next_field(ptr, len); /* kstkesp */
-        ptr = next_field(ptr, len); /* kstkeip */
-        ptr = next_field(ptr, len); /* signal */
-        ptr = next_field(ptr, len); /* blocked */
-        ptr = next_field(ptr, len); /* sigignore */
-        ptr = next_field(ptr, len); /* sigcatch */
-        ptr = next_field(ptr, len); /* wchan */
-        ptr = next_field(ptr, len); /* nswap */
-        ptr = next_field(ptr, len); /* cnswap */
-        ptr = next_field(ptr, len); /* exit_signal */
-
-        /* finally - get the processor */
-        stats->processor = strtol(ptr, NULL, 10);
-
-        /* that's all we care about from this data - ignore the rest */
-
-        /* now create the status filename for this proc */
-        memset(data, 0, sizeof(data));
-        numchars = pmix_snprintf(data, sizeof(data), "/proc/%d/status", pid);
-        if (numchars >= sizeof(data)) {
-            return PMIX_ERROR;
-        }
+    /* see if we can open the meminfo file */
+    if (NULL == (fp = fopen("/proc/meminfo", "r"))) {
+        /* ignore this */
+        goto diskstats;
+    }
 
-        if (NULL == (fp = fopen(data, "r"))) {
-            /* ignore this */
-            return PMIX_SUCCESS;
+    /* read the file one line at a time */
+    while (NULL != (dptr = local_getline(fp))) {
+        if (NULL == (value = local_stripper(dptr))) {
+            /* cannot process */
+            continue;
         }
-
-        /* parse it according to proc(3) */
-        while (NULL != (dptr = local_getline(fp))) {
-            if (NULL == (value = local_stripper(dptr))) {
-                /* cannot process */
-                continue;
-            }
-            /* look for VmPeak */
-            if (0 == strncmp(dptr, "VmPeak", strlen("VmPeak"))) {
-                stats->peak_vsize = convert_value(value);
-            } else if (0 == strncmp(dptr, "VmSize", strlen("VmSize"))) {
-                stats->vsize = convert_value(value);
-            } else if (0 == strncmp(dptr, "VmRSS", strlen("VmRSS"))) {
-                stats->rss = convert_value(value);
-            }
+        if (0 == strcmp(dptr, "MemTotal")) {
+            nstats->total_mem = convert_value(value);
+        } else if (0 == strcmp(dptr, "MemFree")) {
+            nstats->free_mem = convert_value(value);
+        } else if (0 == strcmp(dptr, "Buffers")) {
+            nstats->buffers = convert_value(value);
+        } else if (0 == strcmp(dptr, "Cached")) {
+            nstats->cached = convert_value(value);
+        } else if (0 == strcmp(dptr, "SwapCached")) {
+            nstats->swap_cached = convert_value(value);
+        } else if (0 == strcmp(dptr, "SwapTotal")) {
+            nstats->swap_total = convert_value(value);
+        } else if (0 == strcmp(dptr, "SwapFree")) {
+            nstats->swap_free = convert_value(value);
+        } else if (0 == strcmp(dptr, "Mapped")) {
+            nstats->mapped = convert_value(value);
         }
-        fclose(fp);
+    }
+    fclose(fp);
 
-        /* now create the smaps filename for this proc */
-        memset(data, 0, sizeof(data));
-        numchars = pmix_snprintf(data, sizeof(data), "/proc/%d/smaps", pid);
-        if (numchars >= sizeof(data)) {
-            return PMIX_ERROR;
+diskstats:
+    /* look for the diskstats file */
+    if (NULL == (fp = fopen("/proc/diskstats", "r"))) {
+        /* not an error if we don't find this one as it
+         * isn't critical
+         */
+        goto netstats;
+    }
+    PMIX_CONSTRUCT(&cache, pmix_list_t);
+    /* read the file one line at a time */
+    while (NULL != (dptr = local_getline(fp))) {
+        /* look for the local disks */
+        if (NULL == strstr(dptr, "sd")) {
+            continue;
         }
-
-        if (NULL == (fp = fopen(data, "r"))) {
-            /* ignore this */
-            return PMIX_SUCCESS;
+        /* parse to extract the fields */
+        fields = NULL;
+        local_getfields(dptr, &fields);
+        if (NULL == fields) {
+            continue;
         }
-
-        /* parse it to find lines that start with "Pss" */
-        while (NULL != (dptr = local_getline(fp))) {
-            if (NULL == (value = local_stripper(dptr))) {
-                /* cannot process */
-                continue;
-            }
-            /* look for Pss */
-            if (0 == strncmp(dptr, "Pss", strlen("Pss"))) {
-                stats->pss += convert_value(value);
-            }
+        if (14 < pmix_argv_count(fields)) {
+            pmix_argv_free(fields);
+            continue;
         }
-        fclose(fp);
+        /* pack the ones of interest into the struct */
+        ds = PMIX_NEW(dstats_t);
+        ds->dstat.disk = strdup(fields[2]);
+        ds->dstat.num_reads_completed = strtoul(fields[3], NULL, 10);
+        ds->dstat.num_reads_merged = strtoul(fields[4], NULL, 10);
+        ds->dstat.num_sectors_read = strtoul(fields[5], NULL, 10);
+        ds->dstat.milliseconds_reading = strtoul(fields[6], NULL, 10);
+        ds->dstat.num_writes_completed = strtoul(fields[7], NULL, 10);
+        ds->dstat.num_writes_merged = strtoul(fields[8], NULL, 10);
+        ds->dstat.num_sectors_written = strtoul(fields[9], NULL, 10);
+        ds->dstat.milliseconds_writing = strtoul(fields[10], NULL, 10);
+        ds->dstat.num_ios_in_progress = strtoul(fields[11], NULL, 10);
+        ds->dstat.milliseconds_io = strtoul(fields[12], NULL, 10);
+        ds->dstat.weighted_milliseconds_io = strtoul(fields[13], NULL, 10);
+        pmix_list_append(&cache, &ds->super);
+        pmix_argv_free(fields);
     }
-
-    if (NULL != nstats) {
-        nstats->node = strdup(pmix_globals.hostname);
-
-        /* get the loadavg data */
-        if (0 > (fd = open("/proc/loadavg", O_RDONLY))) {
-            /* not an error if we don't find this one as it
-             * isn't critical
-             */
-            goto diskstats;
+    fclose(fp);
+    if (0 < (len = pmix_list_get_size(&cache))) {
+        PMIX_DISK_STATS_CREATE(nstats->diskstats, len);
+        nstats->ndiskstats = len;
+        i = 0;
+        PMIX_LIST_FOREACH (ds, &cache, dstats_t) {
+            memcpy(&nstats->diskstats[i], &ds->dstat, sizeof(pmix_disk_stats_t));
+            ++i;
         }
+    }
+    PMIX_LIST_DESTRUCT(&cache);
 
-        /* absorb all of the file's contents in one gulp - we'll process
-         * it once it is in memory for speed
+netstats:
+    /* look for the netstats file */
+    if (NULL == (fp = fopen("/proc/net/dev", "r"))) {
+        /* not an error if we don't find this one as it
+         * isn't critical
          */
-        memset(data, 0, sizeof(data));
-        len = read(fd, data, sizeof(data) - 1);
-        close(fd);
-        if (len < 0) {
-            goto diskstats;
+        return;
+    }
+    /* skip the first two lines as they are headers */
+    local_getline(fp);
+    local_getline(fp);
+    /* read the file one line at a time */
+    PMIX_CONSTRUCT(&cache, pmix_list_t);
+    while (NULL != (dptr = local_getline(fp))) {
+        /* the interface is at the start of the line */
+        if (NULL == (ptr = strchr(dptr, ':'))) {
+            continue;
         }
+        *ptr = '\0';
+        ptr++;
+        /* parse to extract the fields */
+        fields = NULL;
+        local_getfields(ptr, &fields);
+        if (NULL == fields) {
+            continue;
+        }
+        /* pack the ones of interest into the struct */
+        ns = PMIX_NEW(ndstats_t);
+        ns->nstat.net_interface = strdup(dptr);
+        ns->nstat.num_bytes_recvd = strtoul(fields[0], NULL, 10);
+        ns->nstat.num_packets_recvd = strtoul(fields[1], NULL, 10);
+        ns->nstat.num_recv_errs = strtoul(fields[2], NULL, 10);
+        ns->nstat.num_bytes_sent = strtoul(fields[8], NULL, 10);
+        ns->nstat.num_packets_sent = strtoul(fields[9], NULL, 10);
+        ns->nstat.num_send_errs = strtoul(fields[10], NULL, 10);
+        pmix_list_append(&cache, &ns->super);
+        pmix_argv_free(fields);
+    }
+    fclose(fp);
+    if (0 < (len = pmix_list_get_size(&cache))) {
+        PMIX_NET_STATS_CREATE(nstats->netstats, len);
+        nstats->nnetstats = len;
+        i = 0;
+        PMIX_LIST_FOREACH (ns, &cache, ndstats_t) {
+            memcpy(&nstats->netstats[i], &ns->nstat, sizeof(pmix_net_stats_t));
+            ++i;
+        }
+    }
+    PMIX_LIST_DESTRUCT(&cache);
+}
 
-        /* remove newline at end */
-        data[len] = '\0';
-
-        /* we only care about the first three numbers */
-        nstats->la = strtof(data, &ptr);
-        nstats->la5 = strtof(ptr, &eptr);
-        nstats->la15 = strtof(eptr, NULL);
+/* Samples are held for pmix_pstat_linux_cache_interval msecs. Once
+ * they go stale, every proc we have been asked about is resampled
+ * in the same pass, so a caller walking the local procs pays for
+ * one trip through /proc per interval rather than one per query */
+static int query(pid_t pid, pmix_proc_stats_t *stats, pmix_node_stats_t *nstats)
+{
+    struct timeval now;
+    pstat_proc_t *p;
+    pmix_proc_stats_t *pcopy;
+    pmix_node_stats_t *ncopy;
+    int rc = PMIX_SUCCESS;
 
-        /* see if we can open the meminfo file */
-        if (NULL == (fp = fopen("/proc/meminfo", "r"))) {
-            /* ignore this */
-            goto diskstats;
-        }
+    gettimeofday(&now, NULL);
 
-        /* read the file one line at a time */
-        while (NULL != (dptr = local_getline(fp))) {
-            if (NULL == (value = local_stripper(dptr))) {
-                /* cannot process */
-                continue;
-            }
-            if (0 == strcmp(dptr, "MemTotal")) {
-                nstats->total_mem = convert_value(value);
-            } else if (0 == strcmp(dptr, "MemFree")) {
-                nstats->free_mem = convert_value(value);
-            } else if (0 == strcmp(dptr, "Buffers")) {
-                nstats->buffers = convert_value(value);
-            } else if (0 == strcmp(dptr, "Cached")) {
-                nstats->cached = convert_value(value);
-            } else if (0 == strcmp(dptr, "SwapCached")) {
-                nstats->swap_cached = convert_value(value);
-            } else if (0 == strcmp(dptr, "SwapTotal")) {
-                nstats->swap_total = convert_value(value);
-            } else if (0 == strcmp(dptr, "SwapFree")) {
-                nstats->swap_free = convert_value(value);
-            } else if (0 == strcmp(dptr, "Mapped")) {
-                nstats->mapped = convert_value(value);
-            }
-        }
-        fclose(fp);
-
-    diskstats:
-        /* look for the diskstats file */
-        if (NULL == (fp = fopen("/proc/diskstats", "r"))) {
-            /* not an error if we don't find this one as it
-             * isn't critical
-             */
-            goto netstats;
+    if (NULL != stats) {
+        if (NULL == (p = find_proc(pid)) && NULL == (p = track_proc(pid))) {
+            return PMIX_ERROR;
         }
-        PMIX_CONSTRUCT(&cache, pmix_list_t);
-        /* read the file one line at a time */
-        while (NULL != (dptr = local_getline(fp))) {
-            /* look for the local disks */
-            if (NULL == strstr(dptr, "sd")) {
-                continue;
-            }
-            /* parse to extract the fields */
-            fields = NULL;
-            local_getfields(dptr, &fields);
-            if (NULL == fields) {
-                continue;
+        if (0 >= pmix_pstat_linux_cache_interval) {
+            rc = sample_proc(p, &now);
+        } else if (!swept || expired(&last_sweep, &now)) {
+            sweep(&now);
+            if (NULL == (p = find_proc(pid))) {
+                return PMIX_ERROR;
             }
-            if (14 < pmix_argv_count(fields)) {
-                pmix_argv_free(fields);
-                continue;
-            }
-            /* pack the ones of interest into the struct */
-            ds = PMIX_NEW(dstats_t);
-            ds->dstat.disk = strdup(fields[2]);
-            ds->dstat.num_reads_completed = strtoul(fields[3], NULL, 10);
-            ds->dstat.num_reads_merged = strtoul(fields[4], NULL, 10);
-            ds->dstat.num_sectors_read = strtoul(fields[5], NULL, 10);
-            ds->dstat.milliseconds_reading = strtoul(fields[6], NULL, 10);
-            ds->dstat.num_writes_completed = strtoul(fields[7], NULL, 10);
-            ds->dstat.num_writes_merged = strtoul(fields[8], NULL, 10);
-            ds->dstat.num_sectors_written = strtoul(fields[9], NULL, 10);
-            ds->dstat.milliseconds_writing = strtoul(fields[10], NULL, 10);
-            ds->dstat.num_ios_in_progress = strtoul(fields[11], NULL, 10);
-            ds->dstat.milliseconds_io = strtoul(fields[12], NULL, 10);
-            ds->dstat.weighted_milliseconds_io = strtoul(fields[13], NULL, 10);
-            pmix_list_append(&cache, &ds->super);
-            pmix_argv_free(fields);
+        } else if (!p->sampled) {
+            /* started tracking it since the last sweep */
+            rc = sample_proc(p, &now);
         }
-        fclose(fp);
-        if (0 < (len = pmix_list_get_size(&cache))) {
-            PMIX_DISK_STATS_CREATE(nstats->diskstats, len);
-            i = 0;
-            PMIX_LIST_FOREACH (ds, &cache, dstats_t) {
-                memcpy(&nstats->diskstats[i], &ds->dstat, sizeof(pmix_disk_stats_t));
-                ++i;
-            }
+        if (PMIX_SUCCESS != rc) {
+            pmix_list_remove_item(&procs, &p->super);
+            PMIX_RELEASE(p);
+            return rc;
         }
-        PMIX_LIST_DESTRUCT(&cache);
-
-    netstats:
-        /* look for the netstats file */
-        if (NULL == (fp = fopen("/proc/net/dev", "r"))) {
-            /* not an error if we don't find this one as it
-             * isn't critical
-             */
-            goto complete;
+        rc = pmix_bfrops_base_copy_pstats(&pcopy, &p->stats, PMIX_PROC_STATS);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
         }
-        /* skip the first two lines as they are headers */
-        local_getline(fp);
-        local_getline(fp);
-        /* read the file one line at a time */
-        PMIX_CONSTRUCT(&cache, pmix_list_t);
-        while (NULL != (dptr = local_getline(fp))) {
-            /* the interface is at the start of the line */
-            if (NULL == (ptr = strchr(dptr, ':'))) {
-                continue;
-            }
-            *ptr = '\0';
-            ptr++;
-            /* parse to extract the fields */
-            fields = NULL;
-            local_getfields(ptr, &fields);
-            if (NULL == fields) {
-                continue;
-            }
-            /* pack the ones of interest into the struct */
-            ns = PMIX_NEW(ndstats_t);
-            ns->nstat.net_interface = strdup(dptr);
-            ns->nstat.num_bytes_recvd = strtoul(fields[0], NULL, 10);
-            ns->nstat.num_packets_recvd = strtoul(fields[1], NULL, 10);
-            ns->nstat.num_recv_errs = strtoul(fields[2], NULL, 10);
-            ns->nstat.num_bytes_sent = strtoul(fields[8], NULL, 10);
-            ns->nstat.num_packets_sent = strtoul(fields[9], NULL, 10);
-            ns->nstat.num_send_errs = strtoul(fields[10], NULL, 10);
-            pmix_list_append(&cache, &ns->super);
-            pmix_argv_free(fields);
+        memcpy(stats, pcopy, sizeof(pmix_proc_stats_t));
+        free(pcopy);
+    }
+
+    if (NULL != nstats) {
+        if (!have_node || 0 >= pmix_pstat_linux_cache_interval || expired(&last_node, &now)) {
+            sample_node(&ncache, &now);
         }
-        fclose(fp);
-        if (0 < (len = pmix_list_get_size(&cache))) {
-            PMIX_NET_STATS_CREATE(nstats->netstats, len);
-            i = 0;
-            PMIX_LIST_FOREACH (ns, &cache, ndstats_t) {
-                memcpy(&nstats->netstats[i], &ns->nstat, sizeof(pmix_net_stats_t));
-                ++i;
-            }
+        rc = pmix_bfrops_base_copy_ndstats(&ncopy, &ncache, PMIX_NODE_STATS);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
         }
-        PMIX_LIST_DESTRUCT(&cache);
+        memcpy(nstats, ncopy, sizeof(pmix_node_stats_t));
+        free(ncopy);
     }
 
-complete:
     return PMIX_SUCCESS;
 }
 
@@ -40,6 +40,11 @@ typedef struct {
     pmix_event_base_t *evbase;
     bool selected;
     bool init;
+    /* answers to storage queries are served from a cache - once an
+     * answer is older than cache_refresh secs it is refreshed in the
+     * background, and once older than cache_expire it is no longer used */
+    int cache_refresh;
+    int cache_expire;
 } pmix_pstrg_base_t;
 
 typedef struct {
@@ -62,6 +67,7 @@ PMIX_CLASS_DECLARATION(pmix_pstrg_query_results_t);
 PMIX_EXPORT pmix_status_t pmix_pstrg_base_query(pmix_query_t queries[], size_t nqueries,
                                                 pmix_list_t *results,
                                                 pmix_pstrg_query_cbfunc_t cbfunc, void *cbdata);
+PMIX_EXPORT void pmix_pstrg_base_flush_cache(void);
 
 END_C_DECLS
 #endif
@@ -47,9 +47,29 @@ pmix_pstrg_base_t pmix_pstrg_base = {
     .actives = PMIX_LIST_STATIC_INIT,
     .evbase = NULL,
     .selected = false,
-    .init = false
+    .init = false,
+    .cache_refresh = 5,
+    .cache_expire = 60
 };
 
+static int pmix_pstrg_base_register(pmix_mca_base_register_flag_t flags)
+{
+    (void) flags;
+
+    (void) pmix_mca_base_var_register("pmix", "pstrg", "base", "cache_refresh",
+                                      "Age (in seconds) at which a cached answer to a storage "
+                                      "query is refreshed in the background while still being "
+                                      "served (0 = do not cache)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_pstrg_base.cache_refresh);
+    (void) pmix_mca_base_var_register("pmix", "pstrg", "base", "cache_expire",
+                                      "Age (in seconds) at which a cached answer to a storage "
+                                      "query is no longer served",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_pstrg_base.cache_expire);
+    return PMIX_SUCCESS;
+}
+
 static int pmix_pstrg_base_close(void)
 {
     pmix_pstrg_active_module_t *active;
@@ -60,6 +80,8 @@ static int pmix_pstrg_base_close(void)
     pmix_pstrg_base.init = false;
     pmix_pstrg_base.selected = false;
 
+    pmix_pstrg_base_flush_cache();
+
     PMIX_LIST_FOREACH (active, &pmix_pstrg_base.actives, pmix_pstrg_active_module_t) {
         if (NULL != active->module->finalize) {
             active->module->finalize();
@@ -89,8 +111,9 @@ static int pmix_pstrg_base_open(pmix_mca_base_open_flag_t flags)
     return pmix_mca_base_framework_components_open(&pmix_pstrg_base_framework, flags);
 }
 
-PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, pstrg, "PMIx Storage Support", NULL, pmix_pstrg_base_open,
-                                pmix_pstrg_base_close, pmix_mca_pstrg_base_static_components,
+PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, pstrg, "PMIx Storage Support", pmix_pstrg_base_register,
+                                pmix_pstrg_base_open, pmix_pstrg_base_close,
+                                pmix_mca_pstrg_base_static_components,
                                 PMIX_MCA_BASE_FRAMEWORK_FLAG_DEFAULT);
 
 PMIX_CLASS_INSTANCE(pmix_pstrg_active_module_t, pmix_list_item_t, NULL, NULL);
@@ -14,6 +14,10 @@
 #include "src/include/pmix_config.h"
 #include "pmix_common.h"
 
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
 #include "src/util/pmix_error.h"
 
 #include "src/mca/pstrg/base/base.h"
@@ -52,8 +56,8 @@ static void qcbfunc(pmix_status_t status, pmix_list_t *results, void *cbdata)
     return;
 }
 
-pmix_status_t pmix_pstrg_base_query(pmix_query_t queries[], size_t nqueries, pmix_list_t *results,
-                                    pmix_pstrg_query_cbfunc_t cbfunc, void *cbdata)
+static pmix_status_t query_modules(pmix_query_t queries[], size_t nqueries, pmix_list_t *results,
+                                   pmix_pstrg_query_cbfunc_t cbfunc, void *cbdata)
 {
     pmix_pstrg_active_module_t *active;
     pmix_query_caddy_t *myrollup;
@@ -121,3 +125,343 @@ pmix_status_t pmix_pstrg_base_query(pmix_query_t queries[], size_t nqueries, pmi
     PMIX_RELEASE_THREAD(&myrollup->lock);
     return PMIX_SUCCESS;
 }
+
+/* Storage attributes change slowly compared to the rate at which
+ * schedulers ask for them, so answers are kept per set of queries
+ * (keyed by their packed form). A stale answer is still served while
+ * the modules are asked again in the background. The cache may be
+ * updated from the modules' threads, hence the lock */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_byte_object_t sig;
+    size_t nqueries;
+    pmix_list_t results;
+    time_t fetched;
+    bool refreshing;
+} pmix_pstrg_cache_t;
+static void pccon(pmix_pstrg_cache_t *p)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->sig);
+    p->nqueries = 0;
+    PMIX_CONSTRUCT(&p->results, pmix_list_t);
+    p->fetched = 0;
+    p->refreshing = false;
+}
+static void pcdes(pmix_pstrg_cache_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->sig);
+    PMIX_LIST_DESTRUCT(&p->results);
+}
+static PMIX_CLASS_INSTANCE(pmix_pstrg_cache_t, pmix_list_item_t, pccon, pcdes);
+
+/* tracks a request to the modules whose answer is to be cached */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    /* held until the results the modules provided
+     * before going async have been collected */
+    pmix_lock_t lock;
+    pmix_byte_object_t sig;
+    size_t nqueries;
+    pmix_list_t partial;
+    pmix_pstrg_query_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_pstrg_fill_t;
+static void pfcon(pmix_pstrg_fill_t *p)
+{
+    PMIX_CONSTRUCT_LOCK(&p->lock);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->sig);
+    p->nqueries = 0;
+    PMIX_CONSTRUCT(&p->partial, pmix_list_t);
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void pfdes(pmix_pstrg_fill_t *p)
+{
+    PMIX_DESTRUCT_LOCK(&p->lock);
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->sig);
+    PMIX_LIST_DESTRUCT(&p->partial);
+}
+static PMIX_CLASS_INSTANCE(pmix_pstrg_fill_t, pmix_object_t, pfcon, pfdes);
+
+static pmix_list_t cache = PMIX_LIST_STATIC_INIT;
+static pmix_lock_t cache_lock = PMIX_LOCK_STATIC_INIT;
+
+static bool cacheable(pmix_query_t queries[], size_t nqueries, bool *refresh)
+{
+    size_t n, m;
+
+    *refresh = false;
+    if (0 >= pmix_pstrg_base.cache_refresh || 0 == nqueries) {
+        return false;
+    }
+    for (n = 0; n < nqueries; n++) {
+        if (NULL == queries[n].keys) {
+            return false;
+        }
+        for (m = 0; NULL != queries[n].keys[m]; m++) {
+            if (0 != strncmp(queries[n].keys[m], "pmix.strg.", strlen("pmix.strg."))) {
+                return false;
+            }
+        }
+        for (m = 0; m < queries[n].nqual; m++) {
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[m], PMIX_QUERY_REFRESH_CACHE)
+                && PMIX_INFO_TRUE(&queries[n].qualifiers[m])) {
+                *refresh = true;
+            }
+        }
+    }
+    return true;
+}
+
+static bool get_sig(pmix_query_t queries[], size_t nqueries, pmix_byte_object_t *sig)
+{
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &buf, queries, nqueries, PMIX_QUERY);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&buf);
+        return false;
+    }
+    PMIX_UNLOAD_BUFFER(&buf, sig->bytes, sig->size);
+    PMIX_DESTRUCT(&buf);
+    return true;
+}
+
+/* must be called with the cache lock held */
+static pmix_pstrg_cache_t *lookup(pmix_byte_object_t *sig)
+{
+    pmix_pstrg_cache_t *pc;
+
+    PMIX_LIST_FOREACH (pc, &cache, pmix_pstrg_cache_t) {
+        if (pc->sig.size == sig->size && 0 == memcmp(pc->sig.bytes, sig->bytes, sig->size)) {
+            return pc;
+        }
+    }
+    return NULL;
+}
+
+static void copy_results(pmix_list_t *dest, pmix_list_item_t *first, pmix_list_t *src)
+{
+    pmix_list_item_t *item;
+    pmix_kval_t *kv, *copy;
+
+    for (item = first; item != pmix_list_get_end(src); item = pmix_list_get_next(item)) {
+        kv = (pmix_kval_t *) item;
+        PMIX_KVAL_NEW(copy, kv->key);
+        if (NULL == copy) {
+            continue;
+        }
+        if (PMIX_SUCCESS != PMIx_Value_xfer(copy->value, kv->value)) {
+            PMIX_RELEASE(copy);
+            continue;
+        }
+        pmix_list_append(dest, &copy->super);
+    }
+}
+
+static void store(pmix_byte_object_t *sig, size_t nqueries, pmix_list_t *partial,
+                  pmix_list_t *results)
+{
+    pmix_pstrg_cache_t *pc;
+
+    pmix_mutex_lock(&cache_lock.mutex);
+    pc = lookup(sig);
+    if (NULL == pc) {
+        pc = PMIX_NEW(pmix_pstrg_cache_t);
+        pc->sig.bytes = (char *) malloc(sig->size);
+        memcpy(pc->sig.bytes, sig->bytes, sig->size);
+        pc->sig.size = sig->size;
+        pc->nqueries = nqueries;
+        pmix_list_append(&cache, &pc->super);
+    } else {
+        PMIX_LIST_DESTRUCT(&pc->results);
+        PMIX_CONSTRUCT(&pc->results, pmix_list_t);
+    }
+    if (NULL != partial) {
+        copy_results(&pc->results, pmix_list_get_first(partial), partial);
+    }
+    if (NULL != results) {
+        copy_results(&pc->results, pmix_list_get_first(results), results);
+    }
+    pc->fetched = time(NULL);
+    pc->refreshing = false;
+    pmix_mutex_unlock(&cache_lock.mutex);
+}
+
+static void refresh_failed(pmix_byte_object_t *sig)
+{
+    pmix_pstrg_cache_t *pc;
+
+    /* keep serving the answer we have until it expires */
+    pmix_mutex_lock(&cache_lock.mutex);
+    if (NULL != (pc = lookup(sig))) {
+        pc->refreshing = false;
+    }
+    pmix_mutex_unlock(&cache_lock.mutex);
+}
+
+static void fillcbfunc(pmix_status_t status, pmix_list_t *results, void *cbdata)
+{
+    pmix_pstrg_fill_t *fill = (pmix_pstrg_fill_t *) cbdata;
+
+    pmix_mutex_lock(&fill->lock.mutex);
+    pmix_mutex_unlock(&fill->lock.mutex);
+
+    if (PMIX_SUCCESS == status || PMIX_OPERATION_SUCCEEDED == status) {
+        store(&fill->sig, fill->nqueries, &fill->partial, results);
+    } else {
+        refresh_failed(&fill->sig);
+    }
+    if (NULL != fill->cbfunc) {
+        fill->cbfunc(status, results, fill->cbdata);
+    }
+    PMIX_RELEASE(fill);
+}
+
+/* ask the modules, caching their answer - the results may
+ * already hold answers from elsewhere, which are not cached */
+static pmix_status_t fill_cache(pmix_query_t queries[], size_t nqueries, pmix_list_t *results,
+                                pmix_pstrg_fill_t *fill)
+{
+    pmix_list_item_t *mark;
+    pmix_status_t rc;
+
+    mark = pmix_list_is_empty(results) ? pmix_list_get_end(results) : pmix_list_get_last(results);
+    PMIX_RETAIN(fill);
+    pmix_mutex_lock(&fill->lock.mutex);
+    rc = query_modules(queries, nqueries, results, fillcbfunc, fill);
+    if (PMIX_SUCCESS == rc) {
+        /* the modules will call back - keep whatever
+         * they already provided */
+        copy_results(&fill->partial, pmix_list_get_next(mark), results);
+        pmix_mutex_unlock(&fill->lock.mutex);
+        PMIX_RELEASE(fill);
+        return rc;
+    }
+    pmix_mutex_unlock(&fill->lock.mutex);
+    if (PMIX_OPERATION_SUCCEEDED == rc) {
+        copy_results(&fill->partial, pmix_list_get_next(mark), results);
+        store(&fill->sig, nqueries, &fill->partial, NULL);
+    } else {
+        refresh_failed(&fill->sig);
+    }
+    /* the callback will not be executed */
+    PMIX_RELEASE(fill);
+    PMIX_RELEASE(fill);
+    return rc;
+}
+
+static void refresh(int sd, short args, void *cbdata)
+{
+    pmix_pstrg_fill_t *fill = (pmix_pstrg_fill_t *) cbdata;
+    pmix_query_t *queries;
+    pmix_buffer_t buf;
+    pmix_list_t results;
+    pmix_status_t rc;
+    int32_t cnt;
+    size_t nqueries = fill->nqueries;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(fill);
+
+    pmix_output_verbose(5, pmix_pstrg_base_framework.framework_output,
+                        "pstrg: refreshing cached answer to %lu queries",
+                        (unsigned long) nqueries);
+
+    /* recover the queries from their packed form */
+    PMIX_QUERY_CREATE(queries, nqueries);
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(pmix_globals.mypeer, &buf, fill->sig.bytes, fill->sig.size);
+    cnt = nqueries;
+    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &buf, queries, &cnt, PMIX_QUERY);
+    /* the buffer doesn't own the signature */
+    buf.base_ptr = NULL;
+    buf.bytes_used = 0;
+    PMIX_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        refresh_failed(&fill->sig);
+        PMIX_QUERY_FREE(queries, nqueries);
+        PMIX_RELEASE(fill);
+        return;
+    }
+
+    PMIX_CONSTRUCT(&results, pmix_list_t);
+    (void) fill_cache(queries, nqueries, &results, fill);
+    PMIX_LIST_DESTRUCT(&results);
+    PMIX_QUERY_FREE(queries, nqueries);
+}
+
+pmix_status_t pmix_pstrg_base_query(pmix_query_t queries[], size_t nqueries, pmix_list_t *results,
+                                    pmix_pstrg_query_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_pstrg_cache_t *pc;
+    pmix_pstrg_fill_t *fill;
+    pmix_byte_object_t sig;
+    bool force;
+    time_t age;
+
+    if (!pmix_pstrg_base.init) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    if (!cacheable(queries, nqueries, &force) || !get_sig(queries, nqueries, &sig)) {
+        return query_modules(queries, nqueries, results, cbfunc, cbdata);
+    }
+
+    if (!force) {
+        pmix_mutex_lock(&cache_lock.mutex);
+        pc = lookup(&sig);
+        if (NULL != pc) {
+            age = time(NULL) - pc->fetched;
+            if (age < pmix_pstrg_base.cache_expire) {
+                copy_results(results, pmix_list_get_first(&pc->results), &pc->results);
+                fill = NULL;
+                if (pmix_pstrg_base.cache_refresh <= age && !pc->refreshing) {
+                    pc->refreshing = true;
+                    fill = PMIX_NEW(pmix_pstrg_fill_t);
+                    fill->sig.bytes = sig.bytes;
+                    fill->sig.size = sig.size;
+                    fill->nqueries = pc->nqueries;
+                    sig.bytes = NULL;
+                }
+                pmix_mutex_unlock(&cache_lock.mutex);
+                if (NULL != fill) {
+                    /* ask again once the caller has its answer */
+                    PMIX_THREADSHIFT(fill, refresh);
+                } else {
+                    PMIX_BYTE_OBJECT_DESTRUCT(&sig);
+                }
+                pmix_output_verbose(5, pmix_pstrg_base_framework.framework_output,
+                                    "pstrg: query answered from cache");
+                return PMIX_OPERATION_SUCCEEDED;
+            }
+            /* too old to be of use */
+            pmix_list_remove_item(&cache, &pc->super);
+            PMIX_RELEASE(pc);
+        }
+        pmix_mutex_unlock(&cache_lock.mutex);
+    }
+
+    fill = PMIX_NEW(pmix_pstrg_fill_t);
+    fill->sig.bytes = sig.bytes;
+    fill->sig.size = sig.size;
+    fill->nqueries = nqueries;
+    fill->cbfunc = cbfunc;
+    fill->cbdata = cbdata;
+    return fill_cache(queries, nqueries, results, fill);
+}
+
+void pmix_pstrg_base_flush_cache(void)
+{
+    pmix_pstrg_cache_t *pc;
+
+    pmix_mutex_lock(&cache_lock.mutex);
+    while (NULL != (pc = (pmix_pstrg_cache_t *) pmix_list_remove_first(&cache))) {
+        PMIX_RELEASE(pc);
+    }
+    pmix_mutex_unlock(&cache_lock.mutex);
+}
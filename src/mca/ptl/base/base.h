@@ -33,6 +33,7 @@
 #ifdef HAVE_STRING_H
 #    include <string.h>
 #endif
+#include <time.h>
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
@@ -100,9 +101,40 @@ struct pmix_ptl_base_t {
     int wait_to_connect;
     int handshake_wait_time;
     int handshake_max_retries;
+    int send_coalesce_max;
+    size_t send_coalesce_bytes;
+    size_t send_writev_calls;
+    size_t send_syscalls_saved;
+    int send_uring_depth;            // max peers written with one io_uring submission, 0 => off
+    size_t send_uring_calls;
+    size_t send_uring_writes;
+    int recv_pool_depth;
+    size_t recv_pool_max_size;
+    size_t recv_readahead;
+    size_t stream_chunk_size;
+    int server_progress_threads;
+    bool jobinfo_in_ack;             // return job info to clients as part of the connect handshake
+    int connect_hold_time;           // msecs to hold a client whose registration is still on its way
+    pmix_list_t held_connections;    // pmix_pending_connection_t being held for registration
+    bool server_registry;            // list rendezvous files in the node's server registry
+    int connect_threads;             // max threads handshaking when attaching to many servers
+    int reconnect_timeout;           // secs a client keeps trying to reach a restarted server
+    char *server_uri;                // "nspace.rank;uri" of the server a client connected to
+    bool reconnecting;               // client is waiting for its server to come back
+    time_t reconnect_deadline;
+    pmix_event_t reconnect_ev;
 };
 typedef struct pmix_ptl_base_t pmix_ptl_base_t;
 
+/* upper bound on the number of queued messages that can be
+ * gathered into a single writev */
+#define PMIX_PTL_COALESCE_MAX 64
+
+/* receive buffer pool covers size classes from 64 bytes
+ * through 64 Kbytes */
+#define PMIX_PTL_POOL_NCLASSES 11
+#define PMIX_PTL_POOL_MAX_SIZE (64 * 1024)
+
 PMIX_EXPORT extern pmix_ptl_base_t pmix_ptl_base;
 
 typedef struct {
@@ -115,22 +147,41 @@ typedef struct {
 } pmix_connection_t;
 PMIX_CLASS_DECLARATION(pmix_connection_t);
 
+/* one server of a multi-server attach - the server is named by
+ * a PMIX_SERVER_URI or PMIX_TOOL_ATTACHMENT_FILE in the info */
+typedef struct {
+    pmix_peer_t *peer;
+    pmix_info_t *info;
+    size_t ninfo;
+    /* returned */
+    char *nspace;
+    pmix_rank_t rank;
+    char *suri;
+    pmix_status_t status;
+} pmix_ptl_attach_t;
+
 /* API stubs */
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_notification_cbfunc(pmix_ptl_cbfunc_t cbfunc);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_connect_to_peer(struct pmix_peer_t *peer,
                                                         pmix_info_t info[], size_t ninfo);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_parse_uri_file(char *filename, pmix_list_t *connections);
+PMIX_EXPORT void pmix_ptl_base_make_connections(pmix_ptl_attach_t *attach, size_t nattach);
 
 PMIX_EXPORT pmix_status_t pmix_ptl_base_setup_connection(char *uri,
                                                          struct sockaddr_storage *connection,
                                                          size_t *len);
 
 PMIX_EXPORT void pmix_ptl_base_post_recv(int fd, short args, void *cbdata);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_repost_recv(uint32_t tag, pmix_ptl_cbfunc_t cbfunc,
+                                                    void *cbdata);
 PMIX_EXPORT void pmix_ptl_base_cancel_recv(int sd, short args, void *cbdata);
 
 PMIX_EXPORT pmix_status_t pmix_ptl_base_start_listening(pmix_info_t info[], size_t ninfo);
 PMIX_EXPORT void pmix_ptl_base_stop_listening(void);
 PMIX_EXPORT pmix_status_t pmix_base_write_rndz_file(char *filename, char *uri, bool *created);
+PMIX_EXPORT void pmix_ptl_base_registry_add(char **files);
+PMIX_EXPORT void pmix_ptl_base_registry_remove(char **files);
+PMIX_EXPORT char **pmix_ptl_base_registry_lookup(const char *prefix);
 
 /* base support functions */
 PMIX_EXPORT pmix_status_t pmix_ptl_base_check_server_uris(pmix_peer_t *peer, char **evar);
@@ -141,11 +192,46 @@ PMIX_EXPORT void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata);
 PMIX_EXPORT void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_nonblocking(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_blocking(int sd);
+PMIX_EXPORT void pmix_ptl_base_bufpool_init(void);
+PMIX_EXPORT void pmix_ptl_base_bufpool_finalize(void);
+PMIX_EXPORT char *pmix_ptl_base_bufpool_get(size_t size);
+PMIX_EXPORT void pmix_ptl_base_bufpool_return(char *ptr, size_t size);
+PMIX_EXPORT void pmix_ptl_base_bufpool_dump(int verbosity);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_io_threads_start(void);
+PMIX_EXPORT void pmix_ptl_base_io_threads_pause(void);
+PMIX_EXPORT void pmix_ptl_base_io_threads_stop(void);
+PMIX_EXPORT pmix_event_base_t *pmix_ptl_base_assign_io_thread(pmix_peer_t *peer);
+PMIX_EXPORT void pmix_ptl_base_close_peer(pmix_peer_t *peer);
+PMIX_EXPORT void pmix_ptl_base_send_batch_release(void);
+
+/* io_uring support - depth returns the number of writes that can
+ * be submitted together, setting up the ring on first use (0 => not
+ * available). The writev fills results with the bytes written or
+ * the negated errno of each write, -EINPROGRESS marking those that
+ * were never made, even when an error is returned */
+PMIX_EXPORT int pmix_ptl_base_uring_depth(void);
+PMIX_EXPORT pmix_status_t pmix_ptl_base_uring_writev(int n, const int *fds,
+                                                     const struct iovec *const *iovs,
+                                                     const int *iovcnts, ssize_t *results);
+PMIX_EXPORT void pmix_ptl_base_uring_finalize(void);
+
+/* if the recv callback left the data region of the delivered
+ * buffer in place, return it to the pool instead of letting
+ * the buffer destructor free it */
+#define PMIX_PTL_BUFPOOL_RECLAIM(b, d, n)                     \
+    do {                                                      \
+        if (NULL != (d) && (d) == (b)->base_ptr &&            \
+            (n) == (b)->bytes_allocated) {                    \
+            pmix_ptl_base_bufpool_return((b)->base_ptr, (n)); \
+            (b)->base_ptr = NULL;                             \
+        }                                                     \
+    } while (0)
 PMIX_EXPORT pmix_status_t pmix_ptl_base_send_blocking(int sd, char *ptr, size_t size);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_recv_blocking(int sd, char *data, size_t size);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_connect(struct sockaddr_storage *addr, pmix_socklen_t len,
                                                 int *fd);
 PMIX_EXPORT void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata);
+PMIX_EXPORT void pmix_ptl_base_release_held_connections(const char *nspace);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_setup_listener(pmix_info_t info[], size_t ninfo);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_send_connect_ack(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_recv_connect_ack(int sd);
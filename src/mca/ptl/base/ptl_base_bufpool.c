@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <stdlib.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_mutex.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/ptl/base/base.h"
+
+/* Size-classed cache of receive data regions. Every region is
+ * obtained from malloc at its full class size, so a region that
+ * escapes the pool (e.g., because a callback took the buffer
+ * payload) can still be released with a plain free */
+
+#define PMIX_PTL_POOL_MIN_SHIFT 6 // 64 bytes
+
+typedef struct pmix_ptl_pool_blk_t {
+    struct pmix_ptl_pool_blk_t *next;
+} pmix_ptl_pool_blk_t;
+
+typedef struct {
+    pmix_ptl_pool_blk_t *head;
+    int ncached;
+    size_t hits;
+    size_t misses;
+    size_t returns;
+    size_t drops;
+} pmix_ptl_pool_class_t;
+
+static pmix_ptl_pool_class_t pool[PMIX_PTL_POOL_NCLASSES];
+static pmix_mutex_t pool_lock;
+static bool pool_initialized = false;
+
+static inline int size_class(size_t size)
+{
+    int cls = 0;
+    size_t csize = (size_t) 1 << PMIX_PTL_POOL_MIN_SHIFT;
+
+    while (csize < size) {
+        csize <<= 1;
+        ++cls;
+    }
+    return cls;
+}
+
+static inline bool pool_active(size_t size)
+{
+    return (pool_initialized && 0 < pmix_ptl_base.recv_pool_depth &&
+            size <= pmix_ptl_base.recv_pool_max_size &&
+            size <= PMIX_PTL_POOL_MAX_SIZE);
+}
+
+void pmix_ptl_base_bufpool_init(void)
+{
+    memset(pool, 0, sizeof(pool));
+    PMIX_CONSTRUCT(&pool_lock, pmix_mutex_t);
+    pool_initialized = true;
+}
+
+void pmix_ptl_base_bufpool_finalize(void)
+{
+    pmix_ptl_pool_blk_t *blk;
+    int n;
+
+    if (!pool_initialized) {
+        return;
+    }
+    pmix_ptl_base_bufpool_dump(1);
+    pool_initialized = false;
+    for (n = 0; n < PMIX_PTL_POOL_NCLASSES; n++) {
+        while (NULL != (blk = pool[n].head)) {
+            pool[n].head = blk->next;
+            free(blk);
+        }
+        pool[n].ncached = 0;
+    }
+    PMIX_DESTRUCT(&pool_lock);
+}
+
+char *pmix_ptl_base_bufpool_get(size_t size)
+{
+    pmix_ptl_pool_blk_t *blk;
+    int cls;
+
+    if (!pool_active(size)) {
+        return (char *) malloc(size);
+    }
+    cls = size_class(size);
+
+    pmix_mutex_lock(&pool_lock);
+    blk = pool[cls].head;
+    if (NULL != blk) {
+        pool[cls].head = blk->next;
+        pool[cls].ncached--;
+        pool[cls].hits++;
+        pmix_mutex_unlock(&pool_lock);
+        return (char *) blk;
+    }
+    pool[cls].misses++;
+    pmix_mutex_unlock(&pool_lock);
+
+    /* always allocate the full class size so the region
+     * can be reused for any message in this class */
+    return (char *) malloc((size_t) 1 << (cls + PMIX_PTL_POOL_MIN_SHIFT));
+}
+
+void pmix_ptl_base_bufpool_return(char *ptr, size_t size)
+{
+    pmix_ptl_pool_blk_t *blk = (pmix_ptl_pool_blk_t *) ptr;
+    int cls;
+
+    if (NULL == ptr) {
+        return;
+    }
+    if (!pool_active(size)) {
+        free(ptr);
+        return;
+    }
+    cls = size_class(size);
+
+    pmix_mutex_lock(&pool_lock);
+    if (pool[cls].ncached < pmix_ptl_base.recv_pool_depth) {
+        blk->next = pool[cls].head;
+        pool[cls].head = blk;
+        pool[cls].ncached++;
+        pool[cls].returns++;
+        pmix_mutex_unlock(&pool_lock);
+        return;
+    }
+    pool[cls].drops++;
+    pmix_mutex_unlock(&pool_lock);
+    free(ptr);
+}
+
+void pmix_ptl_base_bufpool_dump(int verbosity)
+{
+    int n;
+
+    if (!pool_initialized ||
+        pmix_output_get_verbosity(pmix_ptl_base_framework.framework_output) < verbosity) {
+        return;
+    }
+    for (n = 0; n < PMIX_PTL_POOL_NCLASSES; n++) {
+        if (0 == pool[n].hits + pool[n].misses) {
+            continue;
+        }
+        pmix_output(pmix_ptl_base_framework.framework_output,
+                    "%s ptl:base:bufpool class %lu: hits %lu misses %lu returns %lu "
+                    "drops %lu cached %d",
+                    PMIX_NAME_PRINT(&pmix_globals.myid),
+                    (unsigned long) ((size_t) 1 << (n + PMIX_PTL_POOL_MIN_SHIFT)),
+                    (unsigned long) pool[n].hits, (unsigned long) pool[n].misses,
+                    (unsigned long) pool[n].returns, (unsigned long) pool[n].drops,
+                    pool[n].ncached);
+    }
+}
@@ -765,3 +765,185 @@ cleanup:
     }
     return rc;
 }
+
+/* A tool attaching to the servers of a whole allocation would spend
+ * most of its time waiting on the handshake with each of them in
+ * turn, so the resolution of each server's address and the handshake
+ * are done by a small pool of threads pulling servers off a shared
+ * index. Everything that touches the event base or the gds is left
+ * for the caller to complete on the progress thread */
+typedef struct {
+    pmix_mutex_t mutex;
+    pmix_ptl_attach_t *attach;
+    size_t nattach;
+    size_t next;
+    pmix_info_t *iptr;
+    size_t niptr;
+} attach_pool_t;
+
+static pmix_status_t resolve(pmix_ptl_attach_t *at)
+{
+    char *uri = NULL, *rendfile = NULL;
+    pmix_list_t connections;
+    pmix_connection_t *cn;
+    pmix_status_t rc;
+    size_t n;
+
+    for (n = 0; n < at->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&at->info[n], PMIX_SERVER_URI)
+            || PMIX_CHECK_KEY(&at->info[n], PMIX_TCP_URI)) {
+            uri = at->info[n].value.data.string;
+        } else if (PMIX_CHECK_KEY(&at->info[n], PMIX_TOOL_ATTACHMENT_FILE)) {
+            rendfile = at->info[n].value.data.string;
+        }
+    }
+    if (NULL != uri && 0 == strncmp(uri, "file:", 5)) {
+        rendfile = &uri[5];
+        uri = NULL;
+    }
+
+    if (NULL != uri) {
+        at->peer->protocol = PMIX_PROTOCOL_V2;
+        return pmix_ptl_base_parse_uri(uri, &at->nspace, &at->rank, &at->suri);
+    }
+    if (NULL == rendfile) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    PMIX_CONSTRUCT(&connections, pmix_list_t);
+    rc = pmix_ptl_base_parse_uri_file(rendfile, &connections);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_LIST_DESTRUCT(&connections);
+        return PMIX_ERR_UNREACH;
+    }
+    rc = check_connections(&connections);
+    if (PMIX_SUCCESS == rc) {
+        cn = (pmix_connection_t *) pmix_list_get_first(&connections);
+        at->nspace = cn->nspace;
+        cn->nspace = NULL;
+        at->rank = cn->rank;
+        at->suri = cn->uri;
+        cn->uri = NULL;
+        at->peer->protocol = PMIX_PROTOCOL_V2;
+        PMIX_SET_PEER_VERSION(at->peer, cn->version, 2, 0);
+    }
+    PMIX_LIST_DESTRUCT(&connections);
+    return rc;
+}
+
+static void attach_one(attach_pool_t *pool, pmix_ptl_attach_t *at)
+{
+    at->status = resolve(at);
+    if (PMIX_SUCCESS == at->status) {
+        at->status = pmix_ptl_base_make_connection(at->peer, at->suri, pool->iptr, pool->niptr);
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base: attach to %s:%u returned %s",
+                        (NULL == at->nspace) ? "UNKNOWN" : at->nspace, at->rank,
+                        PMIx_Error_string(at->status));
+}
+
+static void drain(attach_pool_t *pool)
+{
+    size_t n;
+
+    while (1) {
+        pmix_mutex_lock(&pool->mutex);
+        n = pool->next++;
+        pmix_mutex_unlock(&pool->mutex);
+        if (n >= pool->nattach) {
+            break;
+        }
+        attach_one(pool, &pool->attach[n]);
+    }
+}
+
+static void *attach_thread(pmix_object_t *obj)
+{
+    pmix_thread_t *t = (pmix_thread_t *) obj;
+
+    drain((attach_pool_t *) t->t_arg);
+    return NULL;
+}
+
+void pmix_ptl_base_make_connections(pmix_ptl_attach_t *attach, size_t nattach)
+{
+    attach_pool_t pool;
+    pmix_thread_t **threads;
+    pmix_info_t *iptr;
+    pid_t mypid;
+    char *p;
+    size_t n, niptr = 0, nthreads;
+
+    /* what we tell every server about ourselves */
+    PMIX_INFO_CREATE(iptr, 3);
+    mypid = getpid();
+    PMIX_INFO_LOAD(&iptr[niptr], PMIX_PROC_PID, &mypid, PMIX_PID);
+    ++niptr;
+    if (PMIX_PEER_IS_LAUNCHER(pmix_globals.mypeer)) {
+        PMIX_INFO_LOAD(&iptr[niptr], PMIX_LAUNCHER, NULL, PMIX_BOOL);
+        ++niptr;
+    }
+    p = pmix_ptl_base_get_cmd_line();
+    if (NULL != p) {
+        PMIX_INFO_LOAD(&iptr[niptr], PMIX_CMD_LINE, p, PMIX_STRING);
+        ++niptr;
+        free(p);
+    }
+
+    PMIX_CONSTRUCT(&pool.mutex, pmix_mutex_t);
+    pool.attach = attach;
+    pool.nattach = nattach;
+    pool.next = 0;
+    pool.iptr = iptr;
+    pool.niptr = niptr;
+
+    pmix_globals.mypeer->protocol = PMIX_PROTOCOL_V2;
+    for (n = 0; n < nattach; n++) {
+        attach[n].status = PMIX_ERR_UNREACH;
+        attach[n].rank = PMIX_RANK_UNDEF;
+    }
+
+    /* a tool that was not given an ID gets it from the first server
+     * it attaches to, so the handshakes cannot overlap until then */
+    while (pool.next < nattach
+           && (0 == strlen(pmix_globals.myid.nspace)
+               || PMIX_RANK_INVALID == pmix_globals.myid.rank)) {
+        attach_one(&pool, &attach[pool.next]);
+        ++pool.next;
+    }
+
+    nthreads = nattach - pool.next;
+    if ((size_t) pmix_ptl_base.connect_threads < nthreads) {
+        nthreads = pmix_ptl_base.connect_threads;
+    }
+    threads = NULL;
+    if (1 < nthreads) {
+        threads = (pmix_thread_t **) calloc(nthreads, sizeof(pmix_thread_t *));
+    }
+    if (NULL != threads) {
+        for (n = 0; n < nthreads; n++) {
+            threads[n] = PMIX_NEW(pmix_thread_t);
+            threads[n]->t_run = attach_thread;
+            threads[n]->t_arg = &pool;
+            if (PMIX_SUCCESS != pmix_thread_start(threads[n])) {
+                PMIX_RELEASE(threads[n]);
+                threads[n] = NULL;
+                break;
+            }
+        }
+    }
+    /* lend a hand - this also covers the case where no
+     * thread could be started */
+    drain(&pool);
+    if (NULL != threads) {
+        for (n = 0; n < nthreads && NULL != threads[n]; n++) {
+            pmix_thread_join(threads[n], NULL);
+            PMIX_RELEASE(threads[n]);
+        }
+        free(threads);
+    }
+
+    PMIX_DESTRUCT(&pool.mutex);
+    PMIX_INFO_FREE(iptr, 3);
+}
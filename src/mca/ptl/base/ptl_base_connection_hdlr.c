@@ -50,21 +50,17 @@ static void process_cbfunc(int sd, short args, void *cbdata);
 static void cnct_cbfunc(pmix_status_t status, pmix_proc_t *proc, void *cbdata);
 static void _check_cached_events(pmix_peer_t *peer);
 static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd, char *mg, size_t cnt);
+static void process_client(pmix_pending_connection_t *pnd);
+static bool jobinfo_requested(pmix_peer_t *peer, pmix_pending_connection_t *pnd);
+static pmix_status_t send_jobinfo(pmix_peer_t *peer, int sd);
 
 void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
 {
     pmix_pending_connection_t *pnd = (pmix_pending_connection_t *) cbdata;
     pmix_ptl_hdr_t hdr;
-    pmix_peer_t *peer = NULL;
-    pmix_status_t rc, reply;
+    pmix_status_t rc;
     char *msg = NULL, *mg, *p, *blob = NULL;
-    uint32_t u32;
-    size_t cnt;
-    pmix_namespace_t *nptr, *tmp;
-    pmix_rank_info_t *info = NULL, *iptr;
-    pmix_proc_t proc;
-    pmix_info_t ginfo;
-    pmix_byte_object_t cred;
+    size_t cnt, bloblen = 0;
     uint8_t major, minor, release;
 
     /* acquire the object */
@@ -79,32 +75,39 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
     /* ensure the socket is in blocking mode */
     pmix_ptl_base_set_blocking(pnd->sd);
 
-    /* ensure all is zero'd */
-    memset(&hdr, 0, sizeof(pmix_ptl_hdr_t));
+    if (NULL != pnd->msg) {
+        /* the listener already collected the request for us */
+        memcpy(&hdr, &pnd->hdr, sizeof(pmix_ptl_hdr_t));
+        msg = pnd->msg;
+        pnd->msg = NULL;
+    } else {
+        /* ensure all is zero'd */
+        memset(&hdr, 0, sizeof(pmix_ptl_hdr_t));
 
-    /* get the header */
-    if (PMIX_SUCCESS
-        != pmix_ptl_base_recv_blocking(pnd->sd, (char *) &hdr, sizeof(pmix_ptl_hdr_t))) {
-        goto error;
-    }
+        /* get the header */
+        if (PMIX_SUCCESS
+            != pmix_ptl_base_recv_blocking(pnd->sd, (char *) &hdr, sizeof(pmix_ptl_hdr_t))) {
+            goto error;
+        }
 
-    /* get the id, authentication and version payload (and possibly
-     * security credential) - to guard against potential attacks,
-     * we'll set an arbitrary limit per a define */
-    if (PMIX_MAX_CRED_SIZE < hdr.nbytes) {
-        goto error;
-    }
-    if (NULL == (msg = (char *) malloc(hdr.nbytes+1))) {
-        goto error;
-    }
-    memset(msg, 0, hdr.nbytes + 1);  // ensure NULL termination of result
-    if (PMIX_SUCCESS != pmix_ptl_base_recv_blocking(pnd->sd, msg, hdr.nbytes)) {
-        /* unable to complete the recv */
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:tool:connection_handler unable to complete recv of connect-ack "
-                            "with client ON SOCKET %d",
-                            pnd->sd);
-        goto error;
+        /* get the id, authentication and version payload (and possibly
+         * security credential) - to guard against potential attacks,
+         * we'll set an arbitrary limit per a define */
+        if (PMIX_MAX_CRED_SIZE < hdr.nbytes) {
+            goto error;
+        }
+        if (NULL == (msg = (char *) malloc(hdr.nbytes+1))) {
+            goto error;
+        }
+        memset(msg, 0, hdr.nbytes + 1);  // ensure NULL termination of result
+        if (PMIX_SUCCESS != pmix_ptl_base_recv_blocking(pnd->sd, msg, hdr.nbytes)) {
+            /* unable to complete the recv */
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:tool:connection_handler unable to complete recv of connect-ack "
+                                "with client ON SOCKET %d",
+                                pnd->sd);
+            goto error;
+        }
     }
 
     cnt = hdr.nbytes;
@@ -228,6 +231,7 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
 
         /* extract the blob */
         if (0 < cnt) {
+            bloblen = cnt;
             PMIX_PTL_GET_BLOB(blob, cnt);
         }
     }
@@ -248,9 +252,36 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
         return;
     }
 
-    /* it is a client that is connecting, so it should have
-     * been registered with us prior to being started.
-     * See if we know this nspace */
+    /* it is a client that is connecting - we are done with
+     * the connection message itself. Keep any info they passed
+     * until we know how to unpack it */
+    free(msg);
+    pnd->blob = blob;
+    pnd->bloblen = bloblen;
+    process_client(pnd);
+    return;
+
+error:
+    if (NULL != msg) {
+        free(msg);
+    }
+    if (NULL != blob) {
+        free(blob);
+    }
+    CLOSE_THE_SOCKET(pnd->sd);
+    PMIX_RELEASE(pnd);
+    return;
+}
+
+/* see if the host has registered the nspace and rank of
+ * a connecting client */
+static bool client_registered(pmix_pending_connection_t *pnd,
+                              pmix_namespace_t **nsout,
+                              pmix_rank_info_t **infoout)
+{
+    pmix_namespace_t *nptr, *tmp;
+    pmix_rank_info_t *info, *iptr;
+
     nptr = NULL;
     PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
         if (0 == strcmp(tmp->nspace, pnd->proc.nspace)) {
@@ -258,24 +289,98 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
             break;
         }
     }
-    if (NULL == nptr) {
-        /* we don't know this namespace, reject it */
-        rc = PMIX_ERR_NOT_FOUND;
-        goto error;
+    info = NULL;
+    if (NULL != nptr) {
+        PMIX_LIST_FOREACH (iptr, &nptr->ranks, pmix_rank_info_t) {
+            if (iptr->pname.rank == pnd->proc.rank) {
+                info = iptr;
+                break;
+            }
+        }
     }
+    *nsout = nptr;
+    *infoout = info;
+    /* the rank must be known and the nspace itself must have been
+     * registered for the client to get its job info */
+    return (NULL != info && SIZE_MAX != nptr->nlocalprocs);
+}
 
-    /* likewise, we should have this peer in our list */
-    info = NULL;
-    PMIX_LIST_FOREACH (iptr, &nptr->ranks, pmix_rank_info_t) {
-        if (iptr->pname.rank == pnd->proc.rank) {
-            info = iptr;
-            break;
+static void held_timeout(int sd, short args, void *cbdata)
+{
+    pmix_pending_connection_t *pnd = (pmix_pending_connection_t *) cbdata;
+
+    PMIX_ACQUIRE_OBJECT(pnd);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:connection_handler: hold expired for client %s",
+                        PMIX_NAME_PRINT(&pnd->proc));
+    pmix_list_remove_item(&pmix_ptl_base.held_connections, &pnd->super);
+    /* mark that we have waited long enough */
+    pnd->status = PMIX_ERR_TIMEOUT;
+    process_client(pnd);
+}
+
+void pmix_ptl_base_release_held_connections(const char *nspace)
+{
+    pmix_pending_connection_t *pnd, *pnext;
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info;
+
+    PMIX_LIST_FOREACH_SAFE (pnd, pnext, &pmix_ptl_base.held_connections, pmix_pending_connection_t) {
+        if (0 != strncmp(pnd->proc.nspace, nspace, PMIX_MAX_NSLEN)) {
+            continue;
+        }
+        if (!client_registered(pnd, &nptr, &info)) {
+            continue;
         }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:connection_handler: releasing held client %s",
+                            PMIX_NAME_PRINT(&pnd->proc));
+        pmix_event_del(&pnd->ev);
+        pmix_list_remove_item(&pmix_ptl_base.held_connections, &pnd->super);
+        process_client(pnd);
     }
-    if (NULL == info) {
-        /* rank unknown, reject it */
-        rc = PMIX_ERR_NOT_FOUND;
-        goto error;
+}
+
+static void process_client(pmix_pending_connection_t *pnd)
+{
+    pmix_peer_t *peer = NULL;
+    pmix_status_t rc, reply;
+    uint32_t u32;
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info = NULL;
+    pmix_proc_t proc;
+    pmix_info_t ginfo;
+    pmix_byte_object_t cred;
+    pmix_event_base_t *evbase;
+    struct timeval tv;
+    bool jobinfo;
+
+    /* the client should have been registered with us prior to
+     * being started. However, the host may be starting its procs
+     * while it is still registering them, so hold on to the
+     * connection for a while if we were asked to do so */
+    if (!client_registered(pnd, &nptr, &info)) {
+        if (0 < pmix_ptl_base.connect_hold_time && PMIX_ERR_TIMEOUT != pnd->status) {
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:base:connection_handler: holding client %s for registration",
+                                PMIX_NAME_PRINT(&pnd->proc));
+            pmix_list_append(&pmix_ptl_base.held_connections, &pnd->super);
+            tv.tv_sec = pmix_ptl_base.connect_hold_time / 1000;
+            tv.tv_usec = (pmix_ptl_base.connect_hold_time % 1000) * 1000;
+            pmix_event_evtimer_set(pmix_globals.evbase, &pnd->ev, held_timeout, pnd);
+            PMIX_POST_OBJECT(pnd);
+            pmix_event_evtimer_add(&pnd->ev, &tv);
+            return;
+        }
+        if (NULL == info) {
+            /* we don't know this nspace or rank, reject it */
+            goto error;
+        }
+        /* the rank is known, so let it proceed as it
+         * always has even though its nspace has yet
+         * to be registered */
     }
 
     /* save the version in the namespace object */
@@ -340,6 +445,9 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
         goto error;
     }
 
+    /* see if they want their job info returned with the handshake */
+    jobinfo = jobinfo_requested(peer, pnd);
+
     /* if we haven't previously stored the version for this
      * nspace, do so now */
     if (!nptr->version_stored) {
@@ -349,9 +457,6 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
         nptr->version_stored = true;
     }
 
-    free(msg); // can now release the data buffer
-    msg = NULL;
-
     /* validate the connection */
     cred.bytes = pnd->cred;
     cred.size = pnd->len;
@@ -389,6 +494,11 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
         goto error;
     }
 
+    if (jobinfo && PMIX_SUCCESS != (rc = send_jobinfo(peer, pnd->sd))) {
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "connect-ack from client completed");
 
@@ -412,12 +522,13 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
     pmix_ptl_base_set_nonblocking(pnd->sd);
 
     /* start the events for this client */
-    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, pnd->sd, EV_READ | EV_PERSIST,
-                      pmix_ptl_base_recv_handler, peer);
-    pmix_event_add(&peer->recv_event, NULL);
+    evbase = pmix_ptl_base_assign_io_thread(peer);
     peer->recv_ev_active = true;
-    pmix_event_assign(&peer->send_event, pmix_globals.evbase, pnd->sd, EV_WRITE | EV_PERSIST,
+    pmix_event_assign(&peer->send_event, evbase, pnd->sd, EV_WRITE | EV_PERSIST,
                       pmix_ptl_base_send_handler, peer);
+    pmix_event_assign(&peer->recv_event, evbase, pnd->sd, EV_READ | EV_PERSIST,
+                      pmix_ptl_base_recv_handler, peer);
+    pmix_event_add(&peer->recv_event, NULL);
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "pmix:server client %s:%u has connected on socket %d",
                         peer->info->pname.nspace, peer->info->pname.rank, peer->sd);
@@ -425,9 +536,6 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
 
     /* check the cached events and update the client */
     _check_cached_events(peer);
-    if (NULL != blob) {
-        free(blob);
-    }
 
     return;
 
@@ -436,12 +544,6 @@ error:
         info->proc_cnt--;
         PMIX_RELEASE(info);
     }
-    if (NULL != msg) {
-        free(msg);
-    }
-    if (NULL != blob) {
-        free(blob);
-    }
     if (NULL != peer) {
         pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
         PMIX_RELEASE(peer);
@@ -451,6 +553,70 @@ error:
     return;
 }
 
+/* check the info a client passed with its connection request
+ * for a request to return its job info with the handshake */
+static bool jobinfo_requested(pmix_peer_t *peer, pmix_pending_connection_t *pnd)
+{
+    pmix_buffer_t buf;
+    pmix_info_t *info;
+    size_t n, ninfo;
+    int32_t cnt;
+    pmix_status_t rc;
+    bool ret = false;
+
+    if (NULL == pnd->blob) {
+        return false;
+    }
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(peer, &buf, pnd->blob, pnd->bloblen);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, &buf, &ninfo, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc && 0 < ninfo) {
+        PMIX_INFO_CREATE(info, ninfo);
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, peer, &buf, info, &cnt, PMIX_INFO);
+        if (PMIX_SUCCESS == rc) {
+            for (n = 0; n < ninfo; n++) {
+                if (PMIX_CHECK_KEY(&info[n], PMIX_PTL_JOBINFO_KEY)) {
+                    ret = PMIX_INFO_TRUE(&info[n]);
+                    break;
+                }
+            }
+        }
+        PMIX_INFO_FREE(info, ninfo);
+    }
+    PMIX_DESTRUCT(&buf);
+    return ret;
+}
+
+/* return the client's job info as the last step of the handshake. If
+ * we cannot provide it, send a zero length so the client asks for
+ * it in the usual way */
+static pmix_status_t send_jobinfo(pmix_peer_t *peer, int sd)
+{
+    pmix_buffer_t *buf = NULL;
+    pmix_status_t rc;
+    uint32_t u32;
+
+    if (PMIX_SUCCESS != pmix_server_job_info(peer, &buf)) {
+        u32 = 0;
+    } else {
+        u32 = buf->bytes_used;
+    }
+    u32 = htonl(u32);
+    rc = pmix_ptl_base_send_blocking(sd, (char *) &u32, sizeof(uint32_t));
+    if (PMIX_SUCCESS == rc && 0 < u32) {
+        rc = pmix_ptl_base_send_blocking(sd, buf->base_ptr, buf->bytes_used);
+        if (PMIX_SUCCESS == rc) {
+            peer->nptr->ndelivered++;
+        }
+    }
+    if (NULL != buf) {
+        PMIX_RELEASE(buf);
+    }
+    return rc;
+}
+
 /* process the host's callback with tool connection info */
 static void process_cbfunc(int sd, short args, void *cbdata)
 {
@@ -464,6 +630,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     pmix_info_t ginfo;
     pmix_byte_object_t cred;
     pmix_iof_req_t *req = NULL;
+    pmix_event_base_t *evbase;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(cd);
@@ -617,12 +784,13 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     peer->info->peerid = peer->index;
 
     /* start the events for this tool */
-    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, peer->sd, EV_READ | EV_PERSIST,
-                      pmix_ptl_base_recv_handler, peer);
-    pmix_event_add(&peer->recv_event, NULL);
+    evbase = pmix_ptl_base_assign_io_thread(peer);
     peer->recv_ev_active = true;
-    pmix_event_assign(&peer->send_event, pmix_globals.evbase, peer->sd, EV_WRITE | EV_PERSIST,
+    pmix_event_assign(&peer->send_event, evbase, peer->sd, EV_WRITE | EV_PERSIST,
                       pmix_ptl_base_send_handler, peer);
+    pmix_event_assign(&peer->recv_event, evbase, peer->sd, EV_READ | EV_PERSIST,
+                      pmix_ptl_base_recv_handler, peer);
+    pmix_event_add(&peer->recv_event, NULL);
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "pmix:server tool %s:%d has connected on socket %d",
                         peer->info->pname.nspace, peer->info->pname.rank, peer->sd);
@@ -851,10 +1019,12 @@ static void _check_cached_events(pmix_peer_t *peer)
     pmix_status_t ret;
     pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
     bool matched, found;
+    int next;
 
     PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
 
-    for (i = 0; i < pmix_globals.max_events; i++) {
+    for (i = pmix_hotel_oldest_room(&pmix_globals.notifications); 0 <= i; i = next) {
+        next = pmix_hotel_next_room(&pmix_globals.notifications, i);
         pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &cd);
         if (NULL == cd) {
             continue;
@@ -883,7 +1053,7 @@ static void _check_cached_events(pmix_peer_t *peer)
                     /* if this is the last one, then evict this event
                      * from the cache */
                     if (0 == cd->nleft) {
-                        pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
+                        pmix_notify_event_uncache(cd);
                         found = true; // mark that we should release cd
                     }
                     break;
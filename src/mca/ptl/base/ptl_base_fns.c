@@ -35,6 +35,7 @@
 #endif
 #include <ctype.h>
 
+#include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
 #include "src/include/pmix_socket_errno.h"
 #include "src/util/pmix_argv.h"
@@ -67,7 +68,15 @@ pmix_status_t pmix_ptl_base_set_peer(pmix_peer_t *peer, char *evar)
 
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output, "V41 SERVER DETECTED");
 
-        /* must use the latest bfrops module */
+        /* a server of our own release shares our dictionary and
+         * can take keys by index - otherwise use the default
+         * bfrops module */
+        if (NULL != vrs && 0 == strcmp(vrs, PMIX_VERSION)) {
+            PMIX_BFROPS_SET_MODULE(rc, pmix_globals.mypeer, peer, "v42");
+            if (PMIX_SUCCESS == rc) {
+                return rc;
+            }
+        }
         PMIX_BFROPS_SET_MODULE(rc, pmix_globals.mypeer, peer, NULL);
         return rc;
     }
@@ -222,6 +231,9 @@ pmix_status_t pmix_ptl_base_setup_fork(const pmix_proc_t *proc, char ***env)
 
     pmix_setenv("PMIX_SERVER_TMPDIR", pmix_ptl_base.session_tmpdir, true, env);
     pmix_setenv("PMIX_SYSTEM_TMPDIR", pmix_ptl_base.system_tmpdir, true, env);
+    if (pmix_ptl_base.jobinfo_in_ack) {
+        pmix_setenv(PMIX_PTL_JOBINFO_ENVAR, "1", true, env);
+    }
 
     return PMIX_SUCCESS;
 }
@@ -377,8 +389,40 @@ process:
     return rc;
 }
 
+static pmix_status_t df_scan(char *dirname, char *prefix, pmix_info_t info[], size_t ninfo,
+                             pmix_list_t *connections);
+
 pmix_status_t pmix_ptl_base_df_search(char *dirname, char *prefix, pmix_info_t info[], size_t ninfo,
                                       pmix_list_t *connections)
+{
+    char **files;
+    pmix_status_t rc;
+    int n;
+
+    /* servers that registered their rendezvous files can
+     * be found without walking the tree */
+    files = pmix_ptl_base_registry_lookup(prefix);
+    for (n = 0; NULL != files && NULL != files[n]; n++) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "pmix:tool: reading registered file %s", files[n]);
+        rc = pmix_ptl_base_parse_uri_file(files[n], connections);
+        if (PMIX_SUCCESS != rc) {
+            pmix_argv_free(files);
+            return rc;
+        }
+    }
+    pmix_argv_free(files);
+    if (0 < pmix_list_get_size(connections)) {
+        return PMIX_SUCCESS;
+    }
+
+    /* servers that did not register - e.g., those of older
+     * releases - can only be found the long way */
+    return df_scan(dirname, prefix, info, ninfo, connections);
+}
+
+static pmix_status_t df_scan(char *dirname, char *prefix, pmix_info_t info[], size_t ninfo,
+                             pmix_list_t *connections)
 {
     char *newdir;
     struct stat buf;
@@ -407,7 +451,7 @@ pmix_status_t pmix_ptl_base_df_search(char *dirname, char *prefix, pmix_info_t i
         }
         /* if it is a directory, down search */
         if (S_ISDIR(buf.st_mode)) {
-            pmix_ptl_base_df_search(newdir, prefix, info, ninfo, connections);
+            df_scan(newdir, prefix, info, ninfo, connections);
             free(newdir);
             continue;
         }
@@ -648,6 +692,8 @@ void pmix_ptl_base_complete_connection(pmix_peer_t *peer, char *nspace, pmix_ran
     pmix_status_t rc;
 
     pmix_globals.connected = true;
+    /* a new server has none of the values we committed */
+    pmix_client_globals.commit_sent = false;
 
     /* setup the server info */
     if (NULL == peer->info) {
@@ -677,6 +723,14 @@ void pmix_ptl_base_complete_connection(pmix_peer_t *peer, char *nspace, pmix_ran
     }
     PMIX_RELEASE(urikv); // maintain accounting
 
+    /* remember where our server was in case we have to find it again */
+    if (peer == pmix_client_globals.myserver) {
+        if (NULL != pmix_ptl_base.server_uri) {
+            free(pmix_ptl_base.server_uri);
+        }
+        pmix_asprintf(&pmix_ptl_base.server_uri, "%s.%u;%s", nspace, rank, suri);
+    }
+
     pmix_ptl_base_set_nonblocking(peer->sd);
 
     /* setup recv event */
@@ -982,6 +1036,9 @@ void pmix_ptl_base_setup_socket(pmix_peer_t *peer)
 pmix_status_t pmix_ptl_base_client_handshake(pmix_peer_t *peer, pmix_status_t reply)
 {
     pmix_status_t rc;
+    uint32_t u32;
+    char *data;
+    size_t sz;
 
     /* see if they want us to do the handshake */
     if (PMIX_ERR_READY_FOR_HANDSHAKE == reply) {
@@ -997,6 +1054,28 @@ pmix_status_t pmix_ptl_base_client_handshake(pmix_peer_t *peer, pmix_status_t re
 
     /* receive our index into the peer's client array */
     PMIX_PTL_RECV_U32(peer->sd, pmix_globals.pindex);
+
+    /* if we asked for it, our job info comes next */
+    if (pmix_client_globals.jobinfo_in_ack) {
+        PMIX_PTL_RECV_U32(peer->sd, u32);
+        if (0 < u32) {
+            data = (char *) malloc(u32);
+            if (NULL == data) {
+                return PMIX_ERR_NOMEM;
+            }
+            rc = pmix_ptl_base_recv_blocking(peer->sd, data, u32);
+            if (PMIX_SUCCESS != rc) {
+                free(data);
+                return rc;
+            }
+            if (NULL != pmix_client_globals.jobinfo) {
+                PMIX_RELEASE(pmix_client_globals.jobinfo);
+            }
+            pmix_client_globals.jobinfo = PMIX_NEW(pmix_buffer_t);
+            sz = u32;
+            PMIX_LOAD_BUFFER(peer, pmix_client_globals.jobinfo, data, sz);
+        }
+    }
     return PMIX_SUCCESS;
 }
 
@@ -1347,12 +1426,22 @@ void pmix_ptl_base_query_servers(int sd, short args, void *cbdata)
     size_t n;
     pmix_infolist_t *iptr;
     pmix_status_t rc;
+    char **files;
 
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_CONSTRUCT(&servers, pmix_list_t);
 
-    query_servers(NULL, &servers);
+    /* start with the servers that registered their rendezvous
+     * files, and only search the tmpdir tree if there are none */
+    files = pmix_ptl_base_registry_lookup("pmix.");
+    for (n = 0; NULL != files && NULL != files[n]; n++) {
+        check_server(files[n], &servers);
+    }
+    pmix_argv_free(files);
+    if (0 == pmix_list_get_size(&servers)) {
+        query_servers(NULL, &servers);
+    }
 
     /* convert the list to an array of pmix_info_t */
     cd->ninfo = pmix_list_get_size(&servers);
@@ -45,6 +45,7 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/mca.h"
 #include "src/server/pmix_server_ops.h"
+#include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_os_dirpath.h"
 #include "src/util/pmix_environ.h"
@@ -104,7 +105,28 @@ pmix_ptl_base_t pmix_ptl_base = {
     .max_retries = 0,
     .wait_to_connect = 0,
     .handshake_wait_time = 0,
-    .handshake_max_retries = 0
+    .handshake_max_retries = 0,
+    .send_coalesce_max = 16,
+    .send_coalesce_bytes = 256 * 1024,
+    .send_writev_calls = 0,
+    .send_syscalls_saved = 0,
+    .send_uring_depth = 0,
+    .send_uring_calls = 0,
+    .send_uring_writes = 0,
+    .recv_pool_depth = 64,
+    .recv_pool_max_size = PMIX_PTL_POOL_MAX_SIZE,
+    .recv_readahead = 4096,
+    .stream_chunk_size = 1024 * 1024,
+    .jobinfo_in_ack = true,
+    .server_progress_threads = 0,
+    .connect_hold_time = 0,
+    .held_connections = PMIX_LIST_STATIC_INIT,
+    .server_registry = true,
+    .connect_threads = 16,
+    .reconnect_timeout = 0,
+    .server_uri = NULL,
+    .reconnecting = false,
+    .reconnect_deadline = 0
 };
 int pmix_ptl_base_output = -1;
 pmix_ptl_module_t pmix_ptl = {
@@ -224,12 +246,113 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
     (void) pmix_mca_base_var_register_synonym(idx, "pmix", "ptl", "tcp", "report_uri",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "send_coalesce_max",
+                                      "Max number of queued messages to a peer that can be "
+                                      "combined into a single write (1 => disable coalescing)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.send_coalesce_max);
+    if (PMIX_PTL_COALESCE_MAX < pmix_ptl_base.send_coalesce_max) {
+        pmix_ptl_base.send_coalesce_max = PMIX_PTL_COALESCE_MAX;
+    }
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "send_coalesce_bytes",
+                                      "Max number of bytes to gather into a single coalesced write",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.send_coalesce_bytes);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "send_uring_depth",
+                                      "Max number of peers whose pending sends a server hands "
+                                      "to the kernel in a single io_uring submission, so that "
+                                      "replies to many local clients at once cost one call "
+                                      "(Linux only, 0 => write to each peer from its own send "
+                                      "event)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.send_uring_depth);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "recv_pool_depth",
+                                      "Max number of cached receive buffers to hold in each "
+                                      "size class (0 => disable the receive buffer pool)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.recv_pool_depth);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "recv_pool_max_size",
+                                      "Largest message (in bytes, max 64K) whose receive buffer "
+                                      "will be taken from the pool",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.recv_pool_max_size);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "recv_readahead",
+                                      "Number of bytes to read from a peer's socket in a single "
+                                      "call when receiving messages smaller than this, so that "
+                                      "a small message and any that follow it are picked up "
+                                      "together (0 => read each header and payload separately)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.recv_readahead);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "stream_chunk_size",
+                                      "Max number of bytes of a streamed reply (e.g., the job "
+                                      "info requested by a client at init) to read before "
+                                      "handing them over for processing (0 => receive such "
+                                      "replies in one piece)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.stream_chunk_size);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "server_progress_threads",
+                                      "Number of progress threads a server uses to service "
+                                      "the sockets of its clients and tools, each peer being "
+                                      "assigned to one of them (0 => use the shared progress "
+                                      "thread)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.server_progress_threads);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "jobinfo_in_ack",
+                                      "Offer to return a client's job info as part of the "
+                                      "connection handshake instead of making it ask for it "
+                                      "in a separate request",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_ptl_base.jobinfo_in_ack);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "connect_hold_time",
+                                      "Number of msecs a server holds the connection of a client "
+                                      "whose nspace or rank has not yet been registered, so a host "
+                                      "can start its procs while it is still registering them "
+                                      "(0 => reject such connections at once)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.connect_hold_time);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "server_registry",
+                                      "Have servers list the rendezvous files they create in a "
+                                      "per-node, per-user registry in the system tmpdir, and have "
+                                      "tools look for servers there before searching the tmpdir "
+                                      "tree",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_ptl_base.server_registry);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "connect_threads",
+                                      "Maximum number of threads used to handshake with the "
+                                      "servers when a tool attaches to many of them at once",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.connect_threads);
+    if (1 > pmix_ptl_base.connect_threads) {
+        pmix_ptl_base.connect_threads = 1;
+    }
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "reconnect_timeout",
+                                      "Number of seconds a client whose connection to its server "
+                                      "drops keeps trying to reconnect to a restarted server, "
+                                      "holding its outstanding requests and cached job data "
+                                      "meanwhile (0 => fail at once)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.reconnect_timeout);
+
     return PMIX_SUCCESS;
 }
 
 static pmix_status_t pmix_ptl_close(void)
 {
     int rc;
+    pmix_pending_connection_t *pnd;
+    char **files;
 
     if (!pmix_ptl_base.initialized) {
         return PMIX_SUCCESS;
@@ -237,8 +360,20 @@ static pmix_status_t pmix_ptl_close(void)
     pmix_ptl_base.initialized = false;
     pmix_ptl_base.selected = false;
 
+    pmix_output_verbose(1, pmix_ptl_base_framework.framework_output,
+                        "ptl:base: %lu coalesced writes saved %lu send calls",
+                        (unsigned long) pmix_ptl_base.send_writev_calls,
+                        (unsigned long) pmix_ptl_base.send_syscalls_saved);
+    pmix_output_verbose(1, pmix_ptl_base_framework.framework_output,
+                        "ptl:base: %lu io_uring submissions carried %lu writes",
+                        (unsigned long) pmix_ptl_base.send_uring_calls,
+                        (unsigned long) pmix_ptl_base.send_uring_writes);
+
     /* ensure the listen thread has been shut down */
     pmix_ptl_base_stop_listening();
+    pmix_ptl_base_send_batch_release();
+    pmix_ptl_base_uring_finalize();
+    pmix_ptl_base_bufpool_finalize();
 
     if (NULL != pmix_client_globals.myserver) {
         if (0 <= pmix_client_globals.myserver->sd) {
@@ -252,8 +387,34 @@ static pmix_status_t pmix_ptl_close(void)
     /* the component will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_ptl_base.posted_recvs);
     PMIX_LIST_DESTRUCT(&pmix_ptl_base.unexpected_msgs);
+    /* drop any clients still waiting to be registered */
+    PMIX_LIST_FOREACH (pnd, &pmix_ptl_base.held_connections, pmix_pending_connection_t) {
+        pmix_event_del(&pnd->ev);
+        CLOSE_THE_SOCKET(pnd->sd);
+    }
+    PMIX_LIST_DESTRUCT(&pmix_ptl_base.held_connections);
     PMIX_DESTRUCT(&pmix_ptl_base.listener);
 
+    /* take our rendezvous files out of the registry first so
+     * no tool is sent to them while they are removed */
+    files = NULL;
+    if (pmix_ptl_base.created_system_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.system_filename);
+    }
+    if (pmix_ptl_base.created_session_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.session_filename);
+    }
+    if (pmix_ptl_base.created_pid_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.pid_filename);
+    }
+    if (pmix_ptl_base.created_nspace_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.nspace_filename);
+    }
+    if (NULL != files) {
+        pmix_ptl_base_registry_remove(files);
+        pmix_argv_free(files);
+    }
+
     if (NULL != pmix_ptl_base.system_filename) {
         if (pmix_ptl_base.created_system_filename) {
             rc = remove(pmix_ptl_base.system_filename);
@@ -312,6 +473,14 @@ static pmix_status_t pmix_ptl_close(void)
     if (NULL != pmix_ptl_base.uri) {
         free(pmix_ptl_base.uri);
     }
+    if (pmix_ptl_base.reconnecting) {
+        pmix_event_del(&pmix_ptl_base.reconnect_ev);
+        pmix_ptl_base.reconnecting = false;
+    }
+    if (NULL != pmix_ptl_base.server_uri) {
+        free(pmix_ptl_base.server_uri);
+        pmix_ptl_base.server_uri = NULL;
+    }
     if (NULL != pmix_ptl_base.urifile) {
         if (pmix_ptl_base.created_urifile) {
             /* remove the file */
@@ -351,8 +520,10 @@ static pmix_status_t pmix_ptl_open(pmix_mca_base_open_flag_t flags)
     pmix_ptl_base.initialized = true;
     PMIX_CONSTRUCT(&pmix_ptl_base.posted_recvs, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_ptl_base.unexpected_msgs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_ptl_base.held_connections, pmix_list_t);
     pmix_ptl_base.listen_thread_active = false;
     PMIX_CONSTRUCT(&pmix_ptl_base.listener, pmix_listener_t);
+    pmix_ptl_base_bufpool_init();
     pmix_ptl_base.current_tag = PMIX_PTL_TAG_DYNAMIC;
     pmix_ptl_base.connection = (struct sockaddr_storage *)malloc(sizeof(struct sockaddr_storage));
     if (NULL == pmix_ptl_base.connection) {
@@ -413,6 +584,7 @@ static void scon(pmix_ptl_send_t *p)
     p->hdr_sent = false;
     p->sdptr = NULL;
     p->sdbytes = 0;
+    p->dsent = 0;
 }
 static void sdes(pmix_ptl_send_t *p)
 {
@@ -432,9 +604,20 @@ static void rcon(pmix_ptl_recv_t *p)
     p->hdr_recvd = false;
     p->rdptr = NULL;
     p->rdbytes = 0;
+    p->stream = NULL;
+    p->strmleft = 0;
 }
 static void rdes(pmix_ptl_recv_t *p)
 {
+    if (NULL != p->stream) {
+        /* the data region is only the size of one piece */
+        if (NULL != p->data) {
+            free(p->data);
+        }
+        PMIX_RELEASE(p->stream);
+    } else if (NULL != p->data) {
+        pmix_ptl_base_bufpool_return(p->data, p->hdr.nbytes);
+    }
     if (NULL != p->peer) {
         PMIX_RELEASE(p->peer);
     }
@@ -445,15 +628,24 @@ static void prcon(pmix_ptl_posted_recv_t *p)
 {
     p->tag = UINT32_MAX;
     p->cbfunc = NULL;
+    p->strmfn = NULL;
     p->cbdata = NULL;
+    p->request = NULL;
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_posted_recv_t, pmix_list_item_t, prcon, NULL);
+static void prdes(pmix_ptl_posted_recv_t *p)
+{
+    if (NULL != p->request) {
+        PMIX_RELEASE(p->request);
+    }
+}
+PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_posted_recv_t, pmix_list_item_t, prcon, prdes);
 
 static void srcon(pmix_ptl_sr_t *p)
 {
     p->peer = NULL;
     p->bfr = NULL;
     p->cbfunc = NULL;
+    p->strmfn = NULL;
     p->cbdata = NULL;
 }
 static void srdes(pmix_ptl_sr_t *p)
@@ -470,6 +662,7 @@ static void pccon(pmix_pending_connection_t *p)
     PMIX_LOAD_PROCID(&p->proc, NULL, PMIX_RANK_UNDEF);
     p->info = NULL;
     p->ninfo = 0;
+    p->status = PMIX_SUCCESS;
     p->peer = NULL;
     p->version = NULL;
     p->bfrops = NULL;
@@ -481,6 +674,11 @@ static void pccon(pmix_pending_connection_t *p)
     p->proc_type.minor = PMIX_MINOR_WILDCARD;
     p->proc_type.release = PMIX_RELEASE_WILDCARD;
     p->proc_type.flag = 0;
+    memset(&p->hdr, 0, sizeof(pmix_ptl_hdr_t));
+    p->msg = NULL;
+    p->blob = NULL;
+    p->bloblen = 0;
+    p->rcvd = 0;
 }
 static void pcdes(pmix_pending_connection_t *p)
 {
@@ -502,8 +700,14 @@ static void pcdes(pmix_pending_connection_t *p)
     if (NULL != p->cred) {
         free(p->cred);
     }
+    if (NULL != p->blob) {
+        free(p->blob);
+    }
+    if (NULL != p->msg) {
+        free(p->msg);
+    }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_pending_connection_t, pmix_object_t, pccon, pcdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_pending_connection_t, pmix_list_item_t, pccon, pcdes);
 
 static void lcon(pmix_listener_t *p)
 {
@@ -55,6 +55,14 @@ typedef uint8_t pmix_rnd_flag_t;
 #define PMIX_LAUNCHER_CLIENT   8
 #define PMIX_SINGLETON_CLIENT  9
 
+/* a server that can return a client's job info as part of the
+ * connection handshake says so in the client's environment. The
+ * client then asks for it by including the key in its connect-ack,
+ * and the server follows the client's index with the length of the
+ * packed job info (zero if it could not be provided) and the data */
+#define PMIX_PTL_JOBINFO_ENVAR "PMIX_SERVER_JOBINFO_ACK"
+#define PMIX_PTL_JOBINFO_KEY   "pmix.ptl.jobinfo"
+
 /* The following macros are used in the ptl_base_connection_hdlr.c
  * file to parse the handshake message and extract its fields */
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/runtime/pmix_progress_threads.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/ptl/base/base.h"
+
+/* A server can spread the sockets of its clients and tools across
+ * a set of dedicated progress threads. Each of those threads only
+ * reads and writes the sockets of the peers assigned to it - every
+ * completed message is still posted to the shared progress thread,
+ * which remains the sole owner of the collective trackers, the GDS
+ * and the event notification machinery */
+
+static pmix_event_base_t **io_evbases = NULL;
+static int nio = 0;
+
+static void io_thread_name(int n, char *name, size_t len)
+{
+    snprintf(name, len, "PMIX-IO-%d", n);
+}
+
+pmix_status_t pmix_ptl_base_io_threads_start(void)
+{
+    char name[32];
+    pmix_status_t rc;
+    int n;
+
+#if PMIX_HAVE_LIBEV
+    /* libev cannot be used across threads */
+    return PMIX_SUCCESS;
+#endif
+
+    if (0 >= pmix_ptl_base.server_progress_threads) {
+        return PMIX_SUCCESS;
+    }
+
+    io_evbases = (pmix_event_base_t **) calloc(pmix_ptl_base.server_progress_threads,
+                                               sizeof(pmix_event_base_t *));
+    if (NULL == io_evbases) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < pmix_ptl_base.server_progress_threads; n++) {
+        io_thread_name(n, name, sizeof(name));
+        io_evbases[n] = pmix_progress_thread_init(name);
+        if (NULL == io_evbases[n]) {
+            rc = PMIX_ERR_INIT;
+            goto error;
+        }
+        ++nio;
+        rc = pmix_progress_thread_start(name);
+        if (PMIX_SUCCESS != rc) {
+            goto error;
+        }
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base started %d server progress threads", nio);
+    return PMIX_SUCCESS;
+
+error:
+    PMIX_ERROR_LOG(rc);
+    pmix_ptl_base_io_threads_stop();
+    return rc;
+}
+
+void pmix_ptl_base_io_threads_pause(void)
+{
+    char name[32];
+    int n;
+
+    for (n = 0; n < nio; n++) {
+        io_thread_name(n, name, sizeof(name));
+        (void) pmix_progress_thread_pause(name);
+    }
+}
+
+void pmix_ptl_base_io_threads_stop(void)
+{
+    char name[32];
+    int n;
+
+    for (n = 0; n < nio; n++) {
+        io_thread_name(n, name, sizeof(name));
+        (void) pmix_progress_thread_stop(name);
+    }
+    nio = 0;
+    if (NULL != io_evbases) {
+        free(io_evbases);
+        io_evbases = NULL;
+    }
+}
+
+pmix_event_base_t *pmix_ptl_base_assign_io_thread(pmix_peer_t *peer)
+{
+    if (0 == nio || 0 > peer->index) {
+        peer->evbase = NULL;
+        return pmix_globals.evbase;
+    }
+    peer->evbase = io_evbases[peer->index % nio];
+    return peer->evbase;
+}
+
+static void close_peer(int sd, short args, void *cbdata)
+{
+    pmix_ptl_queue_t *queue = (pmix_ptl_queue_t *) cbdata;
+    pmix_peer_t *peer = queue->peer;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(queue);
+
+    /* stop the events first so the closed socket
+     * cannot generate a "connection lost" */
+    if (peer->recv_ev_active) {
+        pmix_event_del(&peer->recv_event);
+        peer->recv_ev_active = false;
+    }
+    if (peer->send_ev_active) {
+        pmix_event_del(&peer->send_event);
+        peer->send_ev_active = false;
+    }
+    CLOSE_THE_SOCKET(peer->sd);
+    PMIX_POST_OBJECT(peer);
+    PMIX_RELEASE(queue);
+}
+
+void pmix_ptl_base_close_peer(pmix_peer_t *peer)
+{
+    pmix_ptl_queue_t *queue;
+
+    if (NULL == peer->evbase) {
+        CLOSE_THE_SOCKET(peer->sd);
+        return;
+    }
+    /* the socket belongs to the thread servicing it */
+    queue = PMIX_NEW(pmix_ptl_queue_t);
+    PMIX_RETAIN(peer);
+    queue->peer = peer;
+    pmix_event_assign(&queue->ev, peer->evbase, -1, EV_WRITE, close_peer, queue);
+    PMIX_POST_OBJECT(queue);
+    pmix_event_active(&queue->ev, EV_WRITE, 1);
+}
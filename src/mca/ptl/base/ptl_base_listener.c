@@ -136,18 +136,91 @@ void pmix_ptl_base_stop_listening(void)
     lt->socket = -1;
 }
 
+/* read whatever part of a connection request has arrived on a newly
+ * accepted socket, without blocking. Returns PMIX_SUCCESS once the
+ * complete request is in hand and PMIX_ERR_TEMP_UNAVAILABLE if more
+ * of it is yet to come - any other status means the connection is
+ * to be dropped */
+static pmix_status_t read_request(pmix_pending_connection_t *pnd)
+{
+    size_t total, want;
+    char *ptr;
+    ssize_t rc;
+
+    while (1) {
+        if (pnd->rcvd < sizeof(pmix_ptl_hdr_t)) {
+            ptr = (char *) &pnd->hdr + pnd->rcvd;
+            want = sizeof(pmix_ptl_hdr_t) - pnd->rcvd;
+        } else {
+            /* to guard against potential attacks, we'll set an
+             * arbitrary limit on the size of the request */
+            if (PMIX_MAX_CRED_SIZE < pnd->hdr.nbytes) {
+                return PMIX_ERR_BAD_PARAM;
+            }
+            if (NULL == pnd->msg) {
+                /* ensure NULL termination of the result */
+                pnd->msg = (char *) calloc(pnd->hdr.nbytes + 1, 1);
+                if (NULL == pnd->msg) {
+                    return PMIX_ERR_NOMEM;
+                }
+            }
+            total = sizeof(pmix_ptl_hdr_t) + pnd->hdr.nbytes;
+            if (pnd->rcvd == total) {
+                return PMIX_SUCCESS;
+            }
+            ptr = pnd->msg + (pnd->rcvd - sizeof(pmix_ptl_hdr_t));
+            want = total - pnd->rcvd;
+        }
+        rc = recv(pnd->sd, ptr, want, 0);
+        if (0 == rc) {
+            /* remote closed connection */
+            return PMIX_ERR_UNREACH;
+        }
+        if (rc < 0) {
+            if (EINTR == pmix_socket_errno) {
+                continue;
+            }
+            if (EAGAIN == pmix_socket_errno || EWOULDBLOCK == pmix_socket_errno) {
+                return PMIX_ERR_TEMP_UNAVAILABLE;
+            }
+            return PMIX_ERR_UNREACH;
+        }
+        pnd->rcvd += rc;
+    }
+}
+
+/* push a connection onto the event library for processing */
+static void process_connection(pmix_pending_connection_t *pnd)
+{
+    pmix_listener_t *lt = &pmix_ptl_base.listener;
+
+    pmix_event_assign(&pnd->ev, pmix_globals.evbase, -1, EV_WRITE, lt->cbfunc, pnd);
+    /* post the object */
+    PMIX_POST_OBJECT(pnd);
+    /* activate the event */
+    pmix_event_active(&pnd->ev, EV_WRITE, 1);
+}
+
 static void *listen_thread(void *obj)
 {
     (void) obj;
     int rc, max;
-    socklen_t addrlen = sizeof(struct sockaddr_storage);
-    pmix_pending_connection_t *pending_connection;
+    socklen_t addrlen;
+    pmix_pending_connection_t *pending_connection, *pnext;
+    pmix_list_t requests;
+    pmix_status_t ret;
     struct timeval timeout;
     fd_set readfds;
     pmix_listener_t *lt = &pmix_ptl_base.listener;
 
     pmix_output_verbose(8, pmix_ptl_base_framework.framework_output, "listen_thread: active");
 
+    /* connections whose request has yet to fully arrive. We read
+     * them here as the data comes in so that a storm of clients
+     * starting at once doesn't have the progress thread waiting
+     * on each of them in turn */
+    PMIX_CONSTRUCT(&requests, pmix_list_t);
+
     while (pmix_ptl_base.listen_thread_active) {
         FD_ZERO(&readfds);
         FD_SET(lt->socket, &readfds);
@@ -157,6 +230,12 @@ static void *listen_thread(void *obj)
         FD_SET(pmix_ptl_base.stop_thread[0], &readfds);
         max = (pmix_ptl_base.stop_thread[0] > max) ? pmix_ptl_base.stop_thread[0] : max;
 
+        /* add the connections still sending their request */
+        PMIX_LIST_FOREACH (pending_connection, &requests, pmix_pending_connection_t) {
+            FD_SET(pending_connection->sd, &readfds);
+            max = (pending_connection->sd > max) ? pending_connection->sd : max;
+        }
+
         /* set timeout interval */
         timeout.tv_sec = 2;
         timeout.tv_usec = 0;
@@ -169,12 +248,30 @@ static void *listen_thread(void *obj)
             /* we've been asked to terminate */
             close(pmix_ptl_base.stop_thread[0]);
             close(pmix_ptl_base.stop_thread[1]);
-            return NULL;
+            goto done;
         }
         if (rc < 0) {
             continue;
         }
 
+        /* collect whatever has arrived for the requests under way */
+        PMIX_LIST_FOREACH_SAFE (pending_connection, pnext, &requests, pmix_pending_connection_t) {
+            if (0 == FD_ISSET(pending_connection->sd, &readfds)) {
+                continue;
+            }
+            ret = read_request(pending_connection);
+            if (PMIX_ERR_TEMP_UNAVAILABLE == ret) {
+                continue;
+            }
+            pmix_list_remove_item(&requests, &pending_connection->super);
+            if (PMIX_SUCCESS != ret) {
+                CLOSE_THE_SOCKET(pending_connection->sd);
+                PMIX_RELEASE(pending_connection);
+                continue;
+            }
+            process_connection(pending_connection);
+        }
+
         /* according to the man pages, select replaces the given descriptor
          * set with a subset consisting of those descriptors that are ready
          * for the specified operation - in this case, a read. So we need to
@@ -186,22 +283,26 @@ static void *listen_thread(void *obj)
             continue;
         }
 
-        /* this descriptor is ready to be read, which means a connection
-         * request has been received - so harvest it. All we want to do
-         * here is accept the connection and push the info onto the event
-         * library for subsequent processing - we don't want to actually
-         * process the connection here as it takes too long, and so the
-         * OS might start rejecting connections due to timeout.
+        /* this descriptor is ready to be read, which means connection
+         * requests have been received - so harvest all of them. We only
+         * accept the connections and collect their requests here, pushing
+         * each onto the event library for the rest of the processing - we
+         * don't want to process the connection here as it takes too long,
+         * and so the OS might start rejecting connections due to timeout.
          */
-        pending_connection = PMIX_NEW(pmix_pending_connection_t);
-        pending_connection->protocol = lt->protocol;
-        pmix_event_assign(&pending_connection->ev, pmix_globals.evbase, -1, EV_WRITE, lt->cbfunc,
-                          pending_connection);
-        pending_connection->sd = accept(lt->socket, (struct sockaddr *) &(pending_connection->addr),
-                                        &addrlen);
-        if (pending_connection->sd < 0) {
-            PMIX_RELEASE(pending_connection);
-            if (pmix_socket_errno != EAGAIN || pmix_socket_errno != EWOULDBLOCK) {
+        while (1) {
+            pending_connection = PMIX_NEW(pmix_pending_connection_t);
+            pending_connection->protocol = lt->protocol;
+            addrlen = sizeof(struct sockaddr_storage);
+            pending_connection->sd = accept(lt->socket,
+                                            (struct sockaddr *) &(pending_connection->addr),
+                                            &addrlen);
+            if (pending_connection->sd < 0) {
+                PMIX_RELEASE(pending_connection);
+                if (EAGAIN == pmix_socket_errno || EWOULDBLOCK == pmix_socket_errno) {
+                    /* we have taken everyone who was waiting */
+                    break;
+                }
                 if (EMFILE == pmix_socket_errno || ENOBUFS == pmix_socket_errno
                     || ENOMEM == pmix_socket_errno) {
                     PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
@@ -217,19 +318,36 @@ static void *listen_thread(void *obj)
                 }
                 goto done;
             }
-            continue;
-        }
 
-        pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
-                            "listen_thread: new connection: (%d, %d)", pending_connection->sd,
-                            pmix_socket_errno);
-        /* post the object */
-        PMIX_POST_OBJECT(pending_connection);
-        /* activate the event */
-        pmix_event_active(&pending_connection->ev, EV_WRITE, 1);
+            pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
+                                "listen_thread: new connection: (%d, %d)", pending_connection->sd,
+                                pmix_socket_errno);
+            if (FD_SETSIZE <= pending_connection->sd) {
+                /* we cannot select on this one, so let the event
+                 * library read the request the old way */
+                process_connection(pending_connection);
+                continue;
+            }
+            /* the request normally follows right behind the connection,
+             * so see if it is already here */
+            pmix_ptl_base_set_nonblocking(pending_connection->sd);
+            ret = read_request(pending_connection);
+            if (PMIX_ERR_TEMP_UNAVAILABLE == ret) {
+                pmix_list_append(&requests, &pending_connection->super);
+            } else if (PMIX_SUCCESS != ret) {
+                CLOSE_THE_SOCKET(pending_connection->sd);
+                PMIX_RELEASE(pending_connection);
+            } else {
+                process_connection(pending_connection);
+            }
+        }
     }
 
 done:
+    PMIX_LIST_FOREACH (pending_connection, &requests, pmix_pending_connection_t) {
+        CLOSE_THE_SOCKET(pending_connection->sd);
+    }
+    PMIX_LIST_DESTRUCT(&requests);
     pmix_ptl_base.listen_thread_active = false;
     return NULL;
 }
@@ -314,6 +432,7 @@ pmix_status_t pmix_ptl_base_setup_listener(pmix_info_t info[], size_t ninfo)
     pid_t mypid;
     int outpipe;
     char *leftover;
+    char **files = NULL;
     size_t n;
 
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output, "ptl:tool setup_listener");
@@ -735,6 +854,24 @@ nextstep:
         pmix_ptl_base.created_nspace_filename = true;
     }
 
+    /* let tools find them without searching the tmpdir tree */
+    if (NULL != pmix_ptl_base.system_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.system_filename);
+    }
+    if (NULL != pmix_ptl_base.session_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.session_filename);
+    }
+    if (NULL != pmix_ptl_base.pid_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.pid_filename);
+    }
+    if (NULL != pmix_ptl_base.nspace_filename) {
+        pmix_argv_append_nosize(&files, pmix_ptl_base.nspace_filename);
+    }
+    if (NULL != files) {
+        pmix_ptl_base_registry_add(files);
+        pmix_argv_free(files);
+    }
+
     return PMIX_SUCCESS;
 
 sockerror:
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_TYPES_H
+#    include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_basename.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/ptl/base/base.h"
+
+/* Servers list the rendezvous files they drop in a registry kept in
+ * the system tmpdir, one per node and user, so that a tool looking
+ * for a server can read a single file instead of walking the tmpdir
+ * tree - on login nodes that tree can hold thousands of stale session
+ * directories. The registry holds one path per line and is only ever
+ * read or rewritten under an fcntl lock. Entries left behind by a
+ * server that died are dropped whenever a server registers, and are
+ * ignored by readers as the file they name no longer exists */
+
+static char *registry_path(uid_t uid)
+{
+    char *path;
+
+    if (NULL == pmix_ptl_base.system_tmpdir) {
+        return NULL;
+    }
+    if (0 > asprintf(&path, "%s/pmix-registry.%s.%lu", pmix_ptl_base.system_tmpdir,
+                     pmix_globals.hostname, (unsigned long) uid)) {
+        return NULL;
+    }
+    return path;
+}
+
+static int lock_registry(int fd, short type)
+{
+    struct flock fl;
+
+    memset(&fl, 0, sizeof(fl));
+    fl.l_type = type;
+    fl.l_whence = SEEK_SET;
+    fl.l_start = 0;
+    fl.l_len = 0;
+    while (0 != fcntl(fd, F_SETLKW, &fl)) {
+        if (EINTR != errno) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static char **read_registry(int fd)
+{
+    struct stat buf;
+    char *data, **entries;
+    ssize_t n;
+    size_t got = 0;
+
+    if (0 != fstat(fd, &buf) || 0 == buf.st_size) {
+        return NULL;
+    }
+    data = (char *) malloc(buf.st_size + 1);
+    if (NULL == data) {
+        return NULL;
+    }
+    while (got < (size_t) buf.st_size) {
+        n = pread(fd, data + got, buf.st_size - got, got);
+        if (0 > n && EINTR == errno) {
+            continue;
+        }
+        if (0 >= n) {
+            break;
+        }
+        got += n;
+    }
+    data[got] = '\0';
+    entries = pmix_argv_split(data, '\n');
+    free(data);
+    return entries;
+}
+
+static bool listed(char **files, const char *path)
+{
+    int i;
+
+    for (i = 0; NULL != files && NULL != files[i]; i++) {
+        if (0 == strcmp(files[i], path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* rewrite the registry with its live entries, adding or removing
+ * the given files */
+static void update_registry(char **files, bool add)
+{
+    char *path, **entries, **keep = NULL, *data;
+    size_t len;
+    ssize_t n;
+    int fd, i;
+
+    if (!pmix_ptl_base.server_registry || NULL == files) {
+        return;
+    }
+    path = registry_path(geteuid());
+    if (NULL == path) {
+        return;
+    }
+    fd = open(path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (0 > fd) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:registry cannot open %s: %s", path, strerror(errno));
+        free(path);
+        return;
+    }
+    if (0 != lock_registry(fd, F_WRLCK)) {
+        close(fd);
+        free(path);
+        return;
+    }
+
+    entries = read_registry(fd);
+    for (i = 0; NULL != entries && NULL != entries[i]; i++) {
+        if (listed(files, entries[i])) {
+            /* re-added below if wanted */
+            continue;
+        }
+        /* coverity[TOCTOU] */
+        if (0 != access(entries[i], F_OK)) {
+            /* left by a server that is gone */
+            continue;
+        }
+        pmix_argv_append_nosize(&keep, entries[i]);
+    }
+    pmix_argv_free(entries);
+    if (add) {
+        for (i = 0; NULL != files[i]; i++) {
+            pmix_argv_append_nosize(&keep, files[i]);
+        }
+    }
+
+    data = (NULL == keep) ? strdup("") : pmix_argv_join(keep, '\n');
+    pmix_argv_free(keep);
+    if (NULL != data) {
+        len = strlen(data);
+        if (0 < len) {
+            /* terminate the last line so appends can't run together */
+            data[len] = '\n';
+            ++len;
+        }
+        if (0 == ftruncate(fd, 0)) {
+            n = pwrite(fd, data, len, 0);
+            if (n != (ssize_t) len) {
+                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                    "ptl:base:registry write of %s failed", path);
+            }
+        }
+        free(data);
+    }
+
+    (void) lock_registry(fd, F_UNLCK);
+    close(fd);
+    free(path);
+}
+
+void pmix_ptl_base_registry_add(char **files)
+{
+    update_registry(files, true);
+}
+
+void pmix_ptl_base_registry_remove(char **files)
+{
+    update_registry(files, false);
+}
+
+static void lookup(uid_t uid, const char *prefix, char ***files)
+{
+    char *path, **entries, *base;
+    int fd, i;
+
+    path = registry_path(uid);
+    if (NULL == path) {
+        return;
+    }
+    fd = open(path, O_RDONLY);
+    free(path);
+    if (0 > fd) {
+        return;
+    }
+    if (0 != lock_registry(fd, F_RDLCK)) {
+        close(fd);
+        return;
+    }
+    entries = read_registry(fd);
+    (void) lock_registry(fd, F_UNLCK);
+    close(fd);
+
+    for (i = 0; NULL != entries && NULL != entries[i]; i++) {
+        base = pmix_basename(entries[i]);
+        if (NULL == base) {
+            continue;
+        }
+        /* coverity[TOCTOU] */
+        if (0 == strncmp(base, prefix, strlen(prefix)) && 0 == access(entries[i], R_OK)) {
+            pmix_argv_append_unique_nosize(files, entries[i]);
+        }
+        free(base);
+    }
+    pmix_argv_free(entries);
+}
+
+/* the registered rendezvous files whose name starts with the given
+ * prefix - those of our own servers first, then those of the
+ * system servers run by root */
+char **pmix_ptl_base_registry_lookup(const char *prefix)
+{
+    char **files = NULL;
+    uid_t uid;
+
+    if (!pmix_ptl_base.server_registry) {
+        return NULL;
+    }
+    uid = geteuid();
+    lookup(uid, prefix, &files);
+    if (0 != uid) {
+        lookup(0, prefix, &files);
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:registry found %d files for %s",
+                        pmix_argv_count(files), prefix);
+    return files;
+}
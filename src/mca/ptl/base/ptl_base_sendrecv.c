@@ -38,6 +38,7 @@
 #ifdef HAVE_SYS_TYPES_H
 #    include <sys/types.h>
 #endif
+#include <limits.h>
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/client/pmix_client_ops.h"
@@ -47,7 +48,9 @@
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_trace.h"
 
+#include "src/mca/bfrops/base/base.h"
 #include "src/mca/ptl/base/base.h"
 
 static void _notify_complete(pmix_status_t status, void *cbdata)
@@ -57,13 +60,159 @@ static void _notify_complete(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(chain);
 }
 
-static void lost_connection(pmix_peer_t *peer)
+/* the server is gone for good - it is possible that we have
+ * sendrecv's in progress where we are waiting for a response
+ * to arrive. Since we have lost connection to the server, that
+ * will never happen. Thus, to preclude any chance of hanging,
+ * cycle thru the list of posted recvs and complete any that are
+ * the return call from a sendrecv - i.e., any that are waiting
+ * on dynamic tags */
+static void server_lost(void)
 {
-    pmix_server_trkr_t *trk, *tnxt;
-    pmix_server_caddy_t *rinfo, *rnext;
     pmix_ptl_posted_recv_t *rcv;
     pmix_buffer_t buf;
     pmix_ptl_hdr_t hdr;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    /* must set the buffer type so it doesn't fail in unpack */
+    buf.type = pmix_client_globals.myserver->nptr->compat.type;
+    hdr.nbytes = 0; // initialize the hdr to something safe
+    PMIX_LIST_FOREACH (rcv, &pmix_ptl_base.posted_recvs, pmix_ptl_posted_recv_t) {
+        if (UINT_MAX != rcv->tag && NULL != rcv->cbfunc) {
+            /* construct and load the buffer */
+            hdr.tag = rcv->tag;
+            rcv->cbfunc(pmix_globals.mypeer, &hdr, &buf, rcv->cbdata);
+        }
+    }
+    PMIX_DESTRUCT(&buf);
+    /* if I called finalize, then don't generate an event */
+    if (!pmix_globals.mypeer->finalized) {
+        PMIX_REPORT_EVENT(PMIX_ERR_LOST_CONNECTION, pmix_client_globals.myserver,
+                          PMIX_RANGE_PROC_LOCAL, _notify_complete);
+    }
+}
+
+/* queue a message to the peer under the given tag - the
+ * message takes over the caller's reference to the buffer */
+static void queue_send(pmix_peer_t *peer, uint32_t tag, pmix_buffer_t *bfr)
+{
+    pmix_ptl_send_t *snd;
+
+    snd = PMIX_NEW(pmix_ptl_send_t);
+    snd->hdr.pindex = htonl(pmix_globals.pindex);
+    snd->hdr.tag = htonl(tag);
+    snd->hdr.nbytes = htonl(PMIX_BUFFER_TOTAL_BYTES(bfr));
+    snd->data = bfr;
+    /* always start with the header */
+    snd->sdptr = (char *) &snd->hdr;
+    snd->sdbytes = sizeof(pmix_ptl_hdr_t);
+
+    /* if there is no message on-deck, put this one there */
+    if (NULL == peer->send_msg) {
+        peer->send_msg = snd;
+    } else {
+        /* add it to the queue */
+        pmix_list_append(&peer->send_queue, &snd->super);
+    }
+    /* ensure the send event is active */
+    if (!peer->send_ev_active) {
+        peer->send_ev_active = true;
+        PMIX_POST_OBJECT(snd);
+        pmix_event_add(&peer->send_event, 0);
+    }
+}
+
+/* try to get back to a server that may have been restarted from
+ * its snapshot. We present the same credentials, so it knows us
+ * as the client it had, and then send again every request still
+ * waiting for an answer under its original tag. Our cached job
+ * data is left in place */
+static void reconnect_cb(int fd, short args, void *cbdata)
+{
+    pmix_peer_t *peer = pmix_client_globals.myserver;
+    pmix_ptl_posted_recv_t *rcv;
+    char *nspace = NULL, *suri = NULL;
+    pmix_rank_t rank;
+    pmix_status_t rc;
+    struct timeval tv = {0, 250000};
+    PMIX_HIDE_UNUSED_PARAMS(fd, args, cbdata);
+
+    if (!pmix_ptl_base.reconnecting) {
+        return;
+    }
+    if (pmix_globals.mypeer->finalized) {
+        pmix_ptl_base.reconnecting = false;
+        server_lost();
+        return;
+    }
+
+    rc = pmix_ptl_base_parse_uri(pmix_ptl_base.server_uri, &nspace, &rank, &suri);
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_ptl_base_make_connection(peer, suri, NULL, 0);
+    }
+    if (PMIX_SUCCESS != rc) {
+        if (NULL != nspace) {
+            free(nspace);
+        }
+        if (NULL != suri) {
+            free(suri);
+        }
+        if (time(NULL) < pmix_ptl_base.reconnect_deadline) {
+            pmix_event_evtimer_add(&pmix_ptl_base.reconnect_ev, &tv);
+            return;
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base could not reconnect to server %s", pmix_ptl_base.server_uri);
+        pmix_ptl_base.reconnecting = false;
+        server_lost();
+        return;
+    }
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base reconnected to server %s:%u", nspace, rank);
+    pmix_ptl_base.reconnecting = false;
+    pmix_ptl_base_complete_connection(peer, nspace, rank, suri);
+    free(nspace);
+    free(suri);
+
+    /* the recvs were prepended as they were posted, so walk
+     * them backwards to send in the original order */
+    PMIX_LIST_FOREACH_REV (rcv, &pmix_ptl_base.posted_recvs, pmix_ptl_posted_recv_t) {
+        if (NULL != rcv->request) {
+            PMIX_RETAIN(rcv->request);
+            queue_send(peer, rcv->tag, rcv->request);
+        }
+    }
+}
+
+/* hold the posted recvs, which carry the requests they answer,
+ * while we wait for the server to return. Anything that was
+ * still in the send queue either has its request held or was a
+ * one-way message, and is dropped */
+static void start_reconnect(pmix_peer_t *peer)
+{
+    struct timeval tv = {0, 250000};
+
+    if (NULL != peer->send_msg) {
+        PMIX_RELEASE(peer->send_msg);
+        peer->send_msg = NULL;
+    }
+    PMIX_LIST_DESTRUCT(&peer->send_queue);
+    PMIX_CONSTRUCT(&peer->send_queue, pmix_list_t);
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base lost connection to server %s - trying to reconnect for %d secs",
+                        pmix_ptl_base.server_uri, pmix_ptl_base.reconnect_timeout);
+    pmix_ptl_base.reconnecting = true;
+    pmix_ptl_base.reconnect_deadline = time(NULL) + pmix_ptl_base.reconnect_timeout;
+    pmix_event_evtimer_set(pmix_globals.evbase, &pmix_ptl_base.reconnect_ev, reconnect_cb, NULL);
+    pmix_event_evtimer_add(&pmix_ptl_base.reconnect_ev, &tv);
+}
+
+static void lost_connection(pmix_peer_t *peer)
+{
+    pmix_server_trkr_t *trk, *tnxt;
+    pmix_server_caddy_t *rinfo, *rnext;
     pmix_status_t rc;
     bool flag;
     size_t n;
@@ -81,6 +230,9 @@ static void lost_connection(pmix_peer_t *peer)
         PMIX_RELEASE(peer->recv_msg);
         peer->recv_msg = NULL;
     }
+    /* anything read ahead belongs to the dead socket */
+    peer->rahead_off = 0;
+    peer->rahead_len = 0;
     CLOSE_THE_SOCKET(peer->sd);
     if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) &&
         !PMIX_PEER_IS_TOOL(pmix_globals.mypeer)) {
@@ -158,8 +310,7 @@ static void lost_connection(pmix_peer_t *peer)
                                                        trk->ninfo, NULL, 0,
                                                        trk->modexcbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_trk_remove(trk);
                             PMIX_RELEASE(trk);
                         }
                     } else if (PMIX_CONNECTNB_CMD == trk->type) {
@@ -167,8 +318,7 @@ static void lost_connection(pmix_peer_t *peer)
                         rc = pmix_host_server.connect(trk->pcs, trk->npcs, trk->info,
                                                       trk->ninfo, trk->op_cbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_trk_remove(trk);
                             PMIX_RELEASE(trk);
                         }
                     } else if (PMIX_DISCONNECTNB_CMD == trk->type) {
@@ -176,8 +326,7 @@ static void lost_connection(pmix_peer_t *peer)
                         rc = pmix_host_server.disconnect(trk->pcs, trk->npcs, trk->info,
                                                          trk->ninfo, trk->op_cbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_trk_remove(trk);
                             PMIX_RELEASE(trk);
                         }
                     }
@@ -191,8 +340,11 @@ static void lost_connection(pmix_peer_t *peer)
             --peer->nptr->nlocalprocs;
         }
 
-        /* purge any notifications cached for this client */
-        pmix_server_purge_events(peer, NULL);
+        /* purge any notifications cached for this client - unless
+         * that was already done when it finalized */
+        if (!peer->purged) {
+            pmix_server_purge_events(peer, NULL);
+        }
 
         if (PMIX_PEER_IS_LAUNCHER(pmix_globals.mypeer)) {
             /* only connection I can lose is to my server, so mark it */
@@ -222,104 +374,148 @@ static void lost_connection(pmix_peer_t *peer)
         /* if this was the server to which I am connected,
          * then we need to exit */
         pmix_globals.connected = false;
-        /* it is possible that we have sendrecv's in progress where
-         * we are waiting for a response to arrive. Since we have
-         * lost connection to the server, that will never happen.
-         * Thus, to preclude any chance of hanging, cycle thru
-         * the list of posted recvs and complete any that are
-         * the return call from a sendrecv - i.e., any that are
-         * waiting on dynamic tags */
-        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
-        /* must set the buffer type so it doesn't fail in unpack */
-        buf.type = pmix_client_globals.myserver->nptr->compat.type;
-        hdr.nbytes = 0; // initialize the hdr to something safe
-        PMIX_LIST_FOREACH (rcv, &pmix_ptl_base.posted_recvs, pmix_ptl_posted_recv_t) {
-            if (UINT_MAX != rcv->tag && NULL != rcv->cbfunc) {
-                /* construct and load the buffer */
-                hdr.tag = rcv->tag;
-                rcv->cbfunc(pmix_globals.mypeer, &hdr, &buf, rcv->cbdata);
-            }
+        if (0 < pmix_ptl_base.reconnect_timeout && NULL != pmix_ptl_base.server_uri
+            && !pmix_globals.mypeer->finalized) {
+            /* unless it may be coming back */
+            start_reconnect(peer);
+            return;
         }
-        PMIX_DESTRUCT(&buf);
-        /* if I called finalize, then don't generate an event */
-        if (!pmix_globals.mypeer->finalized) {
-            PMIX_REPORT_EVENT(PMIX_ERR_LOST_CONNECTION,
-                              pmix_client_globals.myserver,
-                              PMIX_RANGE_PROC_LOCAL, _notify_complete);
+        server_lost();
+    }
+}
+
+static void lost_connection_cb(int sd, short args, void *cbdata)
+{
+    pmix_ptl_queue_t *queue = (pmix_ptl_queue_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(queue);
+    lost_connection(queue->peer);
+    PMIX_RELEASE(queue);
+}
+
+/* a peer serviced by one of the server I/O threads has its
+ * socket closed right here so nothing further can be written
+ * to it, while the accounting for its loss is done by the
+ * shared progress thread that owns the trackers */
+static void peer_lost(pmix_peer_t *peer)
+{
+    pmix_ptl_queue_t *queue;
+
+    if (NULL == peer->evbase) {
+        lost_connection(peer);
+        return;
+    }
+    CLOSE_THE_SOCKET(peer->sd);
+    queue = PMIX_NEW(pmix_ptl_queue_t);
+    PMIX_RETAIN(peer);
+    queue->peer = peer;
+    PMIX_THREADSHIFT(queue, lost_connection_cb);
+}
+
+/* the peer's name is not known until its handshake completes */
+#define PMIX_PTL_TRACE(n, p, t, b)                                            \
+    PMIX_TRACE4(n, (NULL == (p)->info) ? NULL : (p)->info->pname.nspace,      \
+                (NULL == (p)->info) ? PMIX_RANK_UNDEF : (p)->info->pname.rank, \
+                (t), (b))
+
+/* load the unsent portion of a message into at most maxiov
+ * entries of the iovec, returning the number used. The payload
+ * may be chained over several segments, so it need not all fit -
+ * whole is set to whether it did */
+static int msg_iov(pmix_ptl_send_t *msg, struct iovec *iov, int maxiov, size_t *nbytes,
+                   bool *whole)
+{
+    size_t total, dbytes = 0;
+    int n = 0;
+
+    *nbytes = 0;
+    if (!msg->hdr_sent) {
+        iov[0].iov_base = msg->sdptr;
+        iov[0].iov_len = msg->sdbytes;
+        *nbytes = msg->sdbytes;
+        n = 1;
+    }
+    total = (NULL == msg->data) ? 0 : ntohl(msg->hdr.nbytes);
+    if (msg->dsent < total && n < maxiov) {
+        n += pmix_bfrops_base_buffer_iov(msg->data, msg->dsent, &iov[n], maxiov - n, &dbytes);
+        *nbytes += dbytes;
+    }
+    *whole = (msg->dsent + dbytes == total);
+    return n;
+}
+
+/* account for nbytes of the given message having been written,
+ * returning the number of bytes that were consumed */
+static size_t msg_advance(pmix_ptl_send_t *msg, size_t nbytes)
+{
+    size_t used = 0, total;
+
+    if (!msg->hdr_sent) {
+        if (nbytes < msg->sdbytes) {
+            /* partial write of the header */
+            msg->sdptr = (char *) msg->sdptr + nbytes;
+            msg->sdbytes -= nbytes;
+            return nbytes;
         }
+        used = msg->sdbytes;
+        nbytes -= used;
+        msg->sdbytes = 0;
+        msg->hdr_sent = true;
     }
+    total = (NULL == msg->data) ? 0 : ntohl(msg->hdr.nbytes);
+    if (nbytes > total - msg->dsent) {
+        nbytes = total - msg->dsent;
+    }
+    msg->dsent += nbytes;
+    return used + nbytes;
+}
+
+static inline bool msg_done(pmix_ptl_send_t *msg)
+{
+    return msg->hdr_sent && (NULL == msg->data || msg->dsent == ntohl(msg->hdr.nbytes));
 }
 
+/* max number of iovecs a single message is written with - a message
+ * chained over more segments than that takes several writes */
+#define PMIX_PTL_MSG_IOV 16
+
 static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
 {
-    struct iovec iov[2];
+    struct iovec iov[PMIX_PTL_MSG_IOV];
     int iov_count;
-    ssize_t remain = msg->sdbytes, rc;
-
-    iov[0].iov_base = msg->sdptr;
-    iov[0].iov_len = msg->sdbytes;
-    if (!msg->hdr_sent && NULL != msg->data) {
-        iov[1].iov_base = msg->data->base_ptr;
-        iov[1].iov_len = ntohl(msg->hdr.nbytes);
-        remain += ntohl(msg->hdr.nbytes);
-        iov_count = 2;
-    } else {
-        iov_count = 1;
-    }
+    size_t remain;
+    ssize_t rc;
+    bool whole;
+
+    iov_count = msg_iov(msg, iov, PMIX_PTL_MSG_IOV, &remain, &whole);
 retry:
     rc = writev(sd, iov, iov_count);
-    if (PMIX_LIKELY(rc == remain)) {
-        /* we successfully sent the header and the msg data if any */
-        msg->hdr_sent = true;
-        msg->sdbytes = 0;
-        msg->sdptr = (char *) iov[iov_count - 1].iov_base + iov[iov_count - 1].iov_len;
-        return PMIX_SUCCESS;
-    } else if (rc < 0) {
-        if (pmix_socket_errno == EINTR) {
-            goto retry;
-        } else if (pmix_socket_errno == EAGAIN) {
-            /* tell the caller to keep this message on active,
-             * but let the event lib cycle so other messages
-             * can progress while this socket is busy
-             */
-            return PMIX_ERR_RESOURCE_BUSY;
-        } else if (pmix_socket_errno == EWOULDBLOCK) {
-            /* tell the caller to keep this message on active,
-             * but let the event lib cycle so other messages
-             * can progress while this socket is busy
-             */
-            return PMIX_ERR_WOULD_BLOCK;
-        } else {
-            /* we hit an error and cannot progress this message */
-            pmix_output(0, "pmix_ptl_base: send_msg: write failed: %s (%d) [sd = %d]",
-                        strerror(pmix_socket_errno), pmix_socket_errno, sd);
-            return PMIX_ERR_UNREACH;
-        }
-    } else {
-        /* short writev. This usually means the kernel buffer is full,
-         * so there is no point for retrying at that time.
-         * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t) rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *) msg->sdptr + rc;
-            msg->sdbytes -= rc;
-        } else {
-            /* header was fully written, but only a part of the msg data was written */
-            msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            if (NULL != msg->data) {
-                /* technically, this should never happen as iov_count
-                 * would be 1 for a zero-byte message, and so we cannot
-                 * have a case where we write the header and part of the
-                 * msg. However, code checkers don't know that and are
-                 * fooled by our earlier check for NULL, and so
-                 * we silence their warnings by using this check */
-                msg->sdptr = (char *) msg->data->base_ptr + rc;
-            }
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
-        }
+    if (PMIX_LIKELY(0 <= rc)) {
+        /* a short write usually means the kernel buffer is full, so
+         * there is no point in retrying right now - just update the
+         * msg and let the caller wait for the next send event */
+        msg_advance(msg, (size_t) rc);
+        return msg_done(msg) ? PMIX_SUCCESS : PMIX_ERR_RESOURCE_BUSY;
+    } else if (pmix_socket_errno == EINTR) {
+        goto retry;
+    } else if (pmix_socket_errno == EAGAIN) {
+        /* tell the caller to keep this message on active,
+         * but let the event lib cycle so other messages
+         * can progress while this socket is busy
+         */
         return PMIX_ERR_RESOURCE_BUSY;
+    } else if (pmix_socket_errno == EWOULDBLOCK) {
+        /* tell the caller to keep this message on active,
+         * but let the event lib cycle so other messages
+         * can progress while this socket is busy
+         */
+        return PMIX_ERR_WOULD_BLOCK;
     }
+    /* we hit an error and cannot progress this message */
+    pmix_output(0, "pmix_ptl_base: send_msg: write failed: %s (%d) [sd = %d]",
+                strerror(pmix_socket_errno), pmix_socket_errno, sd);
+    return PMIX_ERR_UNREACH;
 }
 
 static pmix_status_t read_bytes(int sd, char **buf, size_t *remain)
@@ -373,10 +569,367 @@ exit:
     return ret;
 }
 
+/* fill the remainder of a recv, taking bytes already read ahead from
+ * the socket first. Small reads are satisfied by pulling whatever the
+ * socket holds (up to the readahead size) in a single call, so that the
+ * header and payload of a small message - and any messages queued
+ * behind it - don't each cost a separate read */
+static pmix_status_t recv_bytes(pmix_peer_t *peer, char **buf, size_t *remain)
+{
+    size_t n;
+    ssize_t rc;
+
+    while (0 < *remain) {
+        if (peer->rahead_off < peer->rahead_len) {
+            n = peer->rahead_len - peer->rahead_off;
+            if (*remain < n) {
+                n = *remain;
+            }
+            memcpy(*buf, peer->rahead + peer->rahead_off, n);
+            peer->rahead_off += n;
+            *buf += n;
+            *remain -= n;
+            continue;
+        }
+        if (0 == pmix_ptl_base.recv_readahead || pmix_ptl_base.recv_readahead <= *remain) {
+            /* no point in staging it - read directly into place */
+            return read_bytes(peer->sd, buf, remain);
+        }
+        if (NULL == peer->rahead) {
+            peer->rahead = (char *) malloc(pmix_ptl_base.recv_readahead);
+            if (NULL == peer->rahead) {
+                return read_bytes(peer->sd, buf, remain);
+            }
+        }
+        peer->rahead_off = 0;
+        peer->rahead_len = 0;
+        rc = read(peer->sd, peer->rahead, pmix_ptl_base.recv_readahead);
+        if (rc < 0) {
+            if (pmix_socket_errno == EINTR) {
+                continue;
+            } else if (pmix_socket_errno == EAGAIN) {
+                return PMIX_ERR_RESOURCE_BUSY;
+            } else if (pmix_socket_errno == EWOULDBLOCK) {
+                return PMIX_ERR_WOULD_BLOCK;
+            }
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "pmix_ptl_base_msg_recv: read failed: %s (%d)",
+                                strerror(pmix_socket_errno), pmix_socket_errno);
+            return PMIX_ERR_UNREACH;
+        } else if (0 == rc) {
+            /* the remote peer closed the connection */
+            return PMIX_ERR_UNREACH;
+        }
+        peer->rahead_len = rc;
+    }
+    return PMIX_SUCCESS;
+}
+
 /*
  * A file descriptor is available/ready for send. Check the state
  * of the socket and take the appropriate action.
  */
+/* max number of iovecs a single coalesced writev may carry */
+#ifdef IOV_MAX
+#    define PMIX_PTL_IOV_MAX IOV_MAX
+#else
+#    define PMIX_PTL_IOV_MAX 1024
+#endif
+
+/* room for the iovec of a gathered write */
+#define PMIX_PTL_GATHER_IOV                                                          \
+    ((PMIX_PTL_MSG_IOV > 2 * PMIX_PTL_COALESCE_MAX) ? PMIX_PTL_MSG_IOV : 2 * PMIX_PTL_COALESCE_MAX)
+
+/* gather the on-deck message plus as many queued messages as fit
+ * within our limits into a single iovec */
+static int send_gather(pmix_peer_t *peer, struct iovec *iov, pmix_ptl_send_t **msgs, int *nmsgs,
+                       size_t *remain)
+{
+    pmix_ptl_send_t *msg;
+    int iovcnt, maxiov, maxmsgs, n;
+    size_t nbytes;
+    bool whole;
+
+    maxmsgs = pmix_ptl_base.send_coalesce_max;
+    if (PMIX_PTL_COALESCE_MAX < maxmsgs) {
+        maxmsgs = PMIX_PTL_COALESCE_MAX;
+    } else if (1 > maxmsgs) {
+        maxmsgs = 1;
+    }
+    maxiov = (PMIX_PTL_IOV_MAX < 2 * maxmsgs) ? PMIX_PTL_IOV_MAX : 2 * maxmsgs;
+    if (maxiov < PMIX_PTL_MSG_IOV) {
+        maxiov = PMIX_PTL_MSG_IOV;
+    }
+
+    /* always start with the message on-deck. A message whose
+     * payload doesn't fit in what is left of the iovec must be
+     * the last one, as the rest of it has to go out first */
+    msg = peer->send_msg;
+    iovcnt = msg_iov(msg, iov, maxiov, remain, &whole);
+    *nmsgs = 0;
+    msgs[(*nmsgs)++] = msg;
+
+    PMIX_LIST_FOREACH (msg, &peer->send_queue, pmix_ptl_send_t) {
+        if (!whole || *nmsgs == maxmsgs || maxiov < iovcnt + 2 ||
+            pmix_ptl_base.send_coalesce_bytes <= *remain) {
+            break;
+        }
+        n = msg_iov(msg, &iov[iovcnt], maxiov - iovcnt, &nbytes, &whole);
+        iovcnt += n;
+        *remain += nbytes;
+        msgs[(*nmsgs)++] = msg;
+    }
+    return iovcnt;
+}
+
+/* walk the gathered messages, releasing those that were completed
+ * by writing nbytes. Whatever was partially written is left on-deck
+ * so we resume it on the next send event */
+static pmix_status_t send_written(pmix_peer_t *peer, pmix_ptl_send_t **msgs, int nmsgs,
+                                  size_t nbytes, int *ncomplete)
+{
+    pmix_ptl_send_t *msg;
+    int n;
+
+    *ncomplete = 0;
+    for (n = 0; n < nmsgs; n++) {
+        msg = msgs[n];
+        nbytes -= msg_advance(msg, nbytes);
+        if (!msg_done(msg)) {
+            break;
+        }
+        ++(*ncomplete);
+        PMIX_PTL_TRACE(msg_send, peer, ntohl(msg->hdr.tag), ntohl(msg->hdr.nbytes));
+        if (0 < n) {
+            pmix_list_remove_item(&peer->send_queue, &msg->super);
+        }
+        PMIX_RELEASE(msg);
+        peer->send_msg = NULL;
+    }
+
+    if (n < nmsgs) {
+        /* the partially sent message becomes the one on-deck */
+        if (0 < n) {
+            pmix_list_remove_item(&peer->send_queue, &msgs[n]->super);
+            peer->send_msg = msgs[n];
+        }
+        return PMIX_ERR_RESOURCE_BUSY;
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t send_coalesced(pmix_peer_t *peer)
+{
+    struct iovec iov[PMIX_PTL_GATHER_IOV];
+    pmix_ptl_send_t *msgs[PMIX_PTL_COALESCE_MAX];
+    int iovcnt, nmsgs, ncomplete;
+    size_t remain;
+    ssize_t rc;
+    pmix_status_t ret;
+
+    iovcnt = send_gather(peer, iov, msgs, &nmsgs, &remain);
+
+retry:
+    rc = writev(peer->sd, iov, iovcnt);
+    if (rc < 0) {
+        if (pmix_socket_errno == EINTR) {
+            goto retry;
+        } else if (pmix_socket_errno == EAGAIN) {
+            return PMIX_ERR_RESOURCE_BUSY;
+        } else if (pmix_socket_errno == EWOULDBLOCK) {
+            return PMIX_ERR_WOULD_BLOCK;
+        }
+        /* we hit an error and cannot progress this message */
+        pmix_output(0, "pmix_ptl_base: send_coalesced: write failed: %s (%d) [sd = %d]",
+                    strerror(pmix_socket_errno), pmix_socket_errno, peer->sd);
+        return PMIX_ERR_UNREACH;
+    }
+
+    ret = send_written(peer, msgs, nmsgs, (size_t) rc, &ncomplete);
+    pmix_ptl_base.send_writev_calls++;
+    if (1 < ncomplete) {
+        pmix_ptl_base.send_syscalls_saved += ncomplete - 1;
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:send_coalesced sent %d of %d msgs (%lu of %lu bytes)",
+                        ncomplete, nmsgs, (unsigned long) rc, (unsigned long) remain);
+    return ret;
+}
+
+/* With io_uring, a server doesn't write to the peers on the shared
+ * progress thread from their send events. It collects them instead,
+ * and a zero-delay timer writes all of them with a single submission
+ * once every send event of the current pass has been dispatched. The
+ * peers are gathered again at that point, so anything queued to them
+ * in the meantime goes out in the same write. A write that cannot
+ * complete is left to the peer's send event, which stays armed; one
+ * that fails is retried through the regular path, which knows how to
+ * report the loss of the peer */
+typedef struct {
+    pmix_event_t ev;
+    bool active;
+    bool flushing;
+    int npeers;
+    int maxpeers;
+    pmix_peer_t **peers;
+    int *fds;
+    struct iovec *iov;
+    const struct iovec **iovs;
+    int *iovcnts;
+    ssize_t *results;
+    pmix_ptl_send_t **msgs;
+    int *nmsgs;
+} pmix_ptl_send_batch_t;
+static pmix_ptl_send_batch_t batch = {.active = false, .flushing = false, .npeers = 0,
+                                      .maxpeers = 0, .peers = NULL};
+
+static void batch_free(void)
+{
+    free(batch.peers);
+    free(batch.fds);
+    free(batch.iov);
+    free(batch.iovs);
+    free(batch.iovcnts);
+    free(batch.results);
+    free(batch.msgs);
+    free(batch.nmsgs);
+    batch.peers = NULL;
+    batch.maxpeers = 0;
+}
+
+static bool batch_setup(void)
+{
+    int depth;
+
+    depth = pmix_ptl_base_uring_depth();
+    if (2 > depth) {
+        return false;
+    }
+    batch.peers = (pmix_peer_t **) calloc(depth, sizeof(pmix_peer_t *));
+    batch.fds = (int *) calloc(depth, sizeof(int));
+    batch.iov = (struct iovec *) calloc((size_t) depth * PMIX_PTL_GATHER_IOV,
+                                        sizeof(struct iovec));
+    batch.iovs = (const struct iovec **) calloc(depth, sizeof(struct iovec *));
+    batch.iovcnts = (int *) calloc(depth, sizeof(int));
+    batch.results = (ssize_t *) calloc(depth, sizeof(ssize_t));
+    batch.msgs = (pmix_ptl_send_t **) calloc((size_t) depth * PMIX_PTL_COALESCE_MAX,
+                                             sizeof(pmix_ptl_send_t *));
+    batch.nmsgs = (int *) calloc(depth, sizeof(int));
+    if (NULL == batch.peers || NULL == batch.fds || NULL == batch.iov || NULL == batch.iovs
+        || NULL == batch.iovcnts || NULL == batch.results || NULL == batch.msgs
+        || NULL == batch.nmsgs) {
+        batch_free();
+        return false;
+    }
+    batch.maxpeers = depth;
+    return true;
+}
+
+static void batch_flush(int sd, short args, void *cbdata)
+{
+    pmix_peer_t *peer;
+    pmix_ptl_send_t **msgs;
+    size_t remain;
+    int n, k, ncomplete;
+    pmix_status_t rc;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    batch.active = false;
+    batch.flushing = true;
+
+    /* gather what each peer still has to send */
+    k = 0;
+    for (n = 0; n < batch.npeers; n++) {
+        peer = batch.peers[n];
+        peer->send_batched = false;
+        if (0 > peer->sd || NULL == peer->send_msg) {
+            /* lost or already sent */
+            PMIX_RELEASE(peer);
+            continue;
+        }
+        batch.peers[k] = peer;
+        batch.fds[k] = peer->sd;
+        batch.iovs[k] = &batch.iov[k * PMIX_PTL_GATHER_IOV];
+        batch.iovcnts[k] = send_gather(peer, &batch.iov[k * PMIX_PTL_GATHER_IOV],
+                                       &batch.msgs[k * PMIX_PTL_COALESCE_MAX], &batch.nmsgs[k],
+                                       &remain);
+        ++k;
+    }
+    batch.npeers = 0;
+
+    if (1 == k) {
+        /* nothing to gain from the ring */
+        batch.results[0] = -EINPROGRESS;
+    } else if (1 < k) {
+        (void) pmix_ptl_base_uring_writev(k, batch.fds, batch.iovs, batch.iovcnts, batch.results);
+    }
+
+    for (n = 0; n < k; n++) {
+        peer = batch.peers[n];
+        msgs = &batch.msgs[n * PMIX_PTL_COALESCE_MAX];
+        if (0 <= batch.results[n]) {
+            rc = send_written(peer, msgs, batch.nmsgs[n], (size_t) batch.results[n], &ncomplete);
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:base:send_batch sent %d of %d msgs to %s",
+                                ncomplete, batch.nmsgs[n], PMIX_PNAME_PRINT(&peer->info->pname));
+            if (PMIX_SUCCESS == rc) {
+                peer->send_msg = (pmix_ptl_send_t *) pmix_list_remove_first(&peer->send_queue);
+                if (NULL == peer->send_msg && peer->send_ev_active) {
+                    pmix_event_del(&peer->send_event);
+                    peer->send_ev_active = false;
+                }
+            }
+        } else if (-EAGAIN != batch.results[n] && -EWOULDBLOCK != batch.results[n]) {
+            /* let the regular path deal with it */
+            pmix_ptl_base_send_handler(peer->sd, PMIX_EV_WRITE, peer);
+        }
+        PMIX_POST_OBJECT(peer);
+        PMIX_RELEASE(peer);
+    }
+    batch.flushing = false;
+}
+
+/* returns true if the peer will be written with the others */
+static bool batch_add(pmix_peer_t *peer)
+{
+    if (batch.flushing || NULL != peer->evbase || 0 == pmix_ptl_base.send_uring_depth
+        || !PMIX_PEER_IS_SERVER(pmix_globals.mypeer)) {
+        return false;
+    }
+    if (0 == batch.maxpeers && !batch_setup()) {
+        /* don't try again */
+        pmix_ptl_base.send_uring_depth = 0;
+        return false;
+    }
+    if (batch.npeers == batch.maxpeers) {
+        return false;
+    }
+    PMIX_RETAIN(peer);
+    peer->send_batched = true;
+    batch.peers[batch.npeers++] = peer;
+    if (!batch.active) {
+        batch.active = true;
+        PMIX_THREADSHIFT_DELAY(&batch, batch_flush, 0);
+    }
+    return true;
+}
+
+void pmix_ptl_base_send_batch_release(void)
+{
+    int n;
+
+    if (batch.active) {
+        pmix_event_del(&batch.ev);
+        batch.active = false;
+    }
+    for (n = 0; n < batch.npeers; n++) {
+        batch.peers[n]->send_batched = false;
+        PMIX_RELEASE(batch.peers[n]);
+    }
+    batch.npeers = 0;
+    batch_free();
+}
+
 void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
 {
     pmix_peer_t *peer = (pmix_peer_t *) cbdata;
@@ -387,13 +940,47 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(peer);
 
+    if (peer->send_batched) {
+        /* it will be written with the others */
+        PMIX_POST_OBJECT(peer);
+        return;
+    }
+    if (NULL != msg && batch_add(peer)) {
+        PMIX_POST_OBJECT(peer);
+        return;
+    }
+
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "%s ptl:base:send_handler SENDING TO PEER %s tag %u with %s msg",
                         PMIX_NAME_PRINT(&pmix_globals.myid), PMIX_PNAME_PRINT(&peer->info->pname),
                         (NULL == msg) ? UINT_MAX : ntohl(msg->hdr.tag),
                         (NULL == msg) ? "NULL" : "NON-NULL");
 
-    if (NULL != msg) {
+    if (NULL != msg && 1 < pmix_ptl_base.send_coalesce_max &&
+        0 < pmix_list_get_size(&peer->send_queue)) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:send_handler COALESCING MSGS TO %s",
+                            PMIX_PNAME_PRINT(&peer->info->pname));
+        rc = send_coalesced(peer);
+        if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
+            /* exit this event and let the event lib progress */
+            PMIX_POST_OBJECT(peer);
+            return;
+        } else if (PMIX_SUCCESS != rc) {
+            pmix_output_verbose(5, pmix_ptl_base_framework.framework_output, "%s SEND ERROR %s",
+                                PMIX_NAME_PRINT(&pmix_globals.myid), PMIx_Error_string(rc));
+            // report the error
+            pmix_event_del(&peer->send_event);
+            peer->send_ev_active = false;
+            PMIX_RELEASE(peer->send_msg);
+            peer->send_msg = NULL;
+            peer_lost(peer);
+            PMIX_POST_OBJECT(peer);
+            return;
+        }
+        /* move the next in the queue into the "on-deck" position */
+        peer->send_msg = (pmix_ptl_send_t *) pmix_list_remove_first(&peer->send_queue);
+    } else if (NULL != msg) {
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:base:send_handler SENDING MSG TO %s TAG %u",
                             PMIX_PNAME_PRINT(&peer->info->pname), ntohl(msg->hdr.tag));
@@ -401,6 +988,7 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             // message is complete
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler MSG SENT");
+            PMIX_PTL_TRACE(msg_send, peer, ntohl(msg->hdr.tag), ntohl(msg->hdr.nbytes));
             PMIX_RELEASE(msg);
             peer->send_msg = NULL;
         } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
@@ -419,7 +1007,7 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             peer->send_ev_active = false;
             PMIX_RELEASE(msg);
             peer->send_msg = NULL;
-            lost_connection(peer);
+            peer_lost(peer);
             /* ensure we post the modified peer object before another thread
              * picks it back up */
             PMIX_POST_OBJECT(peer);
@@ -450,14 +1038,56 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
  * of the connection with the peer.
  */
 
+/* find the recv posted for a reply whose payload is to be streamed.
+ * The posted recvs belong to the shared progress thread, so peers
+ * serviced by a server I/O thread are never streamed */
+static pmix_ptl_posted_recv_t *stream_recv(pmix_peer_t *peer, uint32_t tag)
+{
+    pmix_ptl_posted_recv_t *rcv;
+
+    if (0 == pmix_ptl_base.stream_chunk_size || NULL != peer->evbase) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH (rcv, &pmix_ptl_base.posted_recvs, pmix_ptl_posted_recv_t) {
+        if (tag == rcv->tag) {
+            return (NULL == rcv->strmfn) ? NULL : rcv;
+        }
+    }
+    return NULL;
+}
+
+/* read as much of a streamed payload as is available, handing each
+ * piece over as soon as it has been read so it can be processed
+ * while the rest is still in transit */
+static pmix_status_t recv_stream(pmix_peer_t *peer, pmix_ptl_recv_t *msg)
+{
+    pmix_status_t rc;
+    size_t len;
+
+    while (1) {
+        rc = recv_bytes(peer, &msg->rdptr, &msg->rdbytes);
+        len = msg->rdptr - msg->data;
+        if (0 < len
+            && (PMIX_SUCCESS == rc || PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc)) {
+            msg->strmleft -= len;
+            msg->stream->strmfn(peer, &msg->hdr, msg->data, len, msg->stream->cbdata);
+            /* reuse the region for the next piece */
+            msg->rdptr = msg->data;
+            msg->rdbytes = (msg->strmleft < pmix_ptl_base.stream_chunk_size)
+                               ? msg->strmleft
+                               : pmix_ptl_base.stream_chunk_size;
+        }
+        if (PMIX_SUCCESS != rc || 0 == msg->strmleft) {
+            return rc;
+        }
+    }
+}
+
 void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
 {
     pmix_status_t rc;
     pmix_peer_t *peer = (pmix_peer_t *) cbdata;
     pmix_ptl_recv_t *msg = NULL;
-    pmix_ptl_hdr_t hdr;
-    size_t nbytes;
-    char *ptr;
     PMIX_HIDE_UNUSED_PARAMS(flags);
 
     /* acquire the object */
@@ -472,6 +1102,8 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (NULL == peer) {
         return;
     }
+
+next:
     /* allocate a new message and setup for recv */
     if (NULL == peer->recv_msg) {
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
@@ -493,15 +1125,15 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (!msg->hdr_recvd) {
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:base:recv:handler read hdr on socket %d", peer->sd);
-        nbytes = sizeof(pmix_ptl_hdr_t);
-        ptr = (char *) &hdr;
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &ptr, &nbytes))) {
+        /* read straight into the message so that a header arriving
+         * in pieces is picked up where we left off on the next event */
+        if (PMIX_SUCCESS == (rc = recv_bytes(peer, &msg->rdptr, &msg->rdbytes))) {
             /* completed reading the header */
             peer->recv_msg->hdr_recvd = true;
             /* convert the hdr to host format */
-            peer->recv_msg->hdr.pindex = ntohl(hdr.pindex);
-            peer->recv_msg->hdr.tag = ntohl(hdr.tag);
-            peer->recv_msg->hdr.nbytes = ntohl(hdr.nbytes);
+            peer->recv_msg->hdr.pindex = ntohl(peer->recv_msg->hdr.pindex);
+            peer->recv_msg->hdr.tag = ntohl(peer->recv_msg->hdr.tag);
+            peer->recv_msg->hdr.nbytes = ntohl(peer->recv_msg->hdr.nbytes);
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "%s RECVD MSG FROM %s FOR TAG %d SIZE %d",
                                 PMIX_NAME_PRINT(&pmix_globals.myid),
@@ -519,6 +1151,11 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
                 /* post it for delivery */
                 PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
                 peer->recv_msg = NULL;
+                /* the socket won't signal again for messages
+                 * we have already read ahead */
+                if (peer->rahead_off < peer->rahead_len) {
+                    goto next;
+                }
                 PMIX_POST_OBJECT(peer);
                 return;
             } else {
@@ -533,11 +1170,24 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
                                    (unsigned long) pmix_ptl_base.max_msg_size);
                     goto err_close;
                 }
-                peer->recv_msg->data = (char *) malloc(peer->recv_msg->hdr.nbytes);
-                memset(peer->recv_msg->data, 0, peer->recv_msg->hdr.nbytes);
+                msg->stream = stream_recv(peer, msg->hdr.tag);
+                if (NULL != msg->stream) {
+                    /* only a piece of the payload is held at a time */
+                    PMIX_RETAIN(msg->stream);
+                    msg->strmleft = msg->hdr.nbytes;
+                    msg->rdbytes = (msg->strmleft < pmix_ptl_base.stream_chunk_size)
+                                       ? msg->strmleft
+                                       : pmix_ptl_base.stream_chunk_size;
+                    msg->data = (char *) malloc(msg->rdbytes);
+                } else {
+                    msg->data = pmix_ptl_base_bufpool_get(msg->hdr.nbytes);
+                    msg->rdbytes = msg->hdr.nbytes;
+                }
+                if (NULL == msg->data) {
+                    goto err_close;
+                }
                 /* point to it */
-                peer->recv_msg->rdptr = peer->recv_msg->data;
-                peer->recv_msg->rdbytes = peer->recv_msg->hdr.nbytes;
+                msg->rdptr = msg->data;
             }
             /* fall thru and attempt to read the data */
         } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
@@ -560,7 +1210,12 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
          * wherever we left off, which could be at the
          * beginning or somewhere in the message
          */
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
+        if (NULL != msg->stream) {
+            rc = recv_stream(peer, msg);
+        } else {
+            rc = recv_bytes(peer, &msg->rdptr, &msg->rdbytes);
+        }
+        if (PMIX_SUCCESS == rc) {
             /* we recvd all of the message */
             pmix_output_verbose(
                 2, pmix_ptl_base_framework.framework_output,
@@ -570,6 +1225,9 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
             /* post it for delivery */
             PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
             peer->recv_msg = NULL;
+            if (peer->rahead_off < peer->rahead_len) {
+                goto next;
+            }
             /* ensure we post the modified peer object before another thread
              * picks it back up */
             PMIX_POST_OBJECT(peer);
@@ -608,7 +1266,7 @@ err_close:
         PMIX_RELEASE(peer->recv_msg);
         peer->recv_msg = NULL;
     }
-    lost_connection(peer);
+    peer_lost(peer);
     /* ensure we post the modified peer object before another thread
      * picks it back up */
     PMIX_POST_OBJECT(peer);
@@ -653,6 +1311,7 @@ void pmix_ptl_base_send(int sd, short args, void *cbdata)
         msg->hdr.pindex = pmix_globals.pindex;
         msg->hdr.tag = queue->tag;
         if (NULL != queue->buf) {
+            pmix_bfrops_base_buffer_flatten(queue->buf);
             msg->hdr.nbytes = (queue->buf)->bytes_used;
             msg->data = (queue->buf)->base_ptr;
             (queue->buf)->base_ptr = NULL;
@@ -664,6 +1323,9 @@ void pmix_ptl_base_send(int sd, short args, void *cbdata)
         return;
     }
 
+    /* replies to requests from our clients also come this way */
+    pmix_server_stats_reply(queue->peer, queue->tag);
+
     /* do we have a live connection? */
     if (queue->peer->sd < 0) {
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output, "%s no connection",
@@ -678,7 +1340,7 @@ void pmix_ptl_base_send(int sd, short args, void *cbdata)
     snd = PMIX_NEW(pmix_ptl_send_t);
     snd->hdr.pindex = htonl(pmix_globals.pindex);
     snd->hdr.tag = htonl(queue->tag);
-    snd->hdr.nbytes = htonl((queue->buf)->bytes_used);
+    snd->hdr.nbytes = htonl(PMIX_BUFFER_TOTAL_BYTES(queue->buf));
     snd->data = (queue->buf);
     /* always start with the header */
     snd->sdptr = (char *) &snd->hdr;
@@ -705,7 +1367,6 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
 {
     pmix_ptl_sr_t *ms = (pmix_ptl_sr_t *) cbdata;
     pmix_ptl_posted_recv_t *req;
-    pmix_ptl_send_t *snd;
     uint32_t tag;
     pmix_ptl_recv_t *msg;
     PMIX_HIDE_UNUSED_PARAMS(fd, args);
@@ -713,7 +1374,9 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(ms);
 
-    if (NULL == ms->peer || ms->peer->sd < 0 || NULL == ms->peer->info || NULL == ms->peer->nptr) {
+    if (NULL == ms->peer || NULL == ms->peer->info || NULL == ms->peer->nptr
+        || (ms->peer->sd < 0
+            && !(pmix_ptl_base.reconnecting && ms->peer == pmix_client_globals.myserver))) {
         /* this peer has lost connection */
         if (NULL != ms->bfr) {
             PMIX_RELEASE(ms->bfr);
@@ -740,7 +1403,13 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
         req = PMIX_NEW(pmix_ptl_posted_recv_t);
         req->tag = tag;
         req->cbfunc = ms->cbfunc;
+        req->strmfn = ms->strmfn;
         req->cbdata = ms->cbdata;
+        if (0 < pmix_ptl_base.reconnect_timeout && ms->peer == pmix_client_globals.myserver) {
+            /* keep the request in case we have to send it again */
+            PMIX_RETAIN(ms->bfr);
+            req->request = ms->bfr;
+        }
 
         pmix_output_verbose(5, pmix_ptl_base_framework.framework_output, "posting recv on tag %d",
                             req->tag);
@@ -750,6 +1419,14 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
         pmix_list_prepend(&pmix_ptl_base.posted_recvs, &req->super);
     }
 
+    if (ms->peer->sd < 0) {
+        /* we are waiting for our server to come back - any
+         * request was kept with its recv and goes out then */
+        PMIX_RELEASE(ms->bfr);
+        PMIX_RELEASE(ms);
+        return;
+    }
+
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "QUEUEING MSG TO SERVER %s ON SOCKET %d OF SIZE %d",
                         PMIX_PNAME_PRINT(&ms->peer->info->pname), ms->peer->sd,
@@ -763,6 +1440,7 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
         msg->peer = ms->peer;
         msg->hdr.pindex = pmix_globals.pindex;
         msg->hdr.tag = tag;
+        pmix_bfrops_base_buffer_flatten(ms->bfr);
         msg->hdr.nbytes = ms->bfr->bytes_used;
         msg->data = ms->bfr->base_ptr;
         ms->bfr->base_ptr = NULL;
@@ -772,32 +1450,10 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
         return;
     }
 
-    snd = PMIX_NEW(pmix_ptl_send_t);
-    snd->hdr.pindex = htonl(pmix_globals.pindex);
-    snd->hdr.tag = htonl(tag);
-    snd->hdr.nbytes = htonl(ms->bfr->bytes_used);
-    snd->data = ms->bfr;
-    /* always start with the header */
-    snd->sdptr = (char *) &snd->hdr;
-    snd->sdbytes = sizeof(pmix_ptl_hdr_t);
-
-    /* if there is no message on-deck, put this one there */
-    if (NULL == ms->peer->send_msg) {
-        ms->peer->send_msg = snd;
-    } else {
-        /* add it to the queue */
-        pmix_list_append(&ms->peer->send_queue, &snd->super);
-    }
-    /* ensure the send event is active */
-    if (!ms->peer->send_ev_active) {
-        ms->peer->send_ev_active = true;
-        PMIX_POST_OBJECT(snd);
-        pmix_event_add(&ms->peer->send_event, 0);
-    }
+    queue_send(ms->peer, tag, ms->bfr);
 
     /* cleanup */
     PMIX_RELEASE(ms);
-    PMIX_POST_OBJECT(snd);
 }
 
 void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
@@ -805,6 +1461,8 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
     pmix_ptl_recv_t *msg = (pmix_ptl_recv_t *) cbdata;
     pmix_ptl_posted_recv_t *rcv;
     pmix_buffer_t buf;
+    char *data;
+    size_t ndata;
     PMIX_HIDE_UNUSED_PARAMS(fd, flags);
 
     /* acquire the object */
@@ -814,6 +1472,7 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                         "%s:%d message received %d bytes for tag %u on socket %d",
                         pmix_globals.myid.nspace, pmix_globals.myid.rank, (int) msg->hdr.nbytes,
                         msg->hdr.tag, msg->sd);
+    PMIX_PTL_TRACE(msg_recv, msg->peer, msg->hdr.tag, msg->hdr.nbytes);
 
     /* see if we have a waiting recv for this message */
     PMIX_LIST_FOREACH (rcv, &pmix_ptl_base.posted_recvs, pmix_ptl_posted_recv_t) {
@@ -821,9 +1480,20 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                             "checking msg on tag %u for tag %u", msg->hdr.tag, rcv->tag);
 
         if (msg->hdr.tag == rcv->tag || UINT_MAX == rcv->tag) {
-            if (NULL != rcv->cbfunc) {
+            if (NULL != rcv->strmfn) {
+                /* hand over whatever was not already streamed as it
+                 * arrived - e.g., a message sent to ourselves */
+                if (NULL == msg->stream && NULL != msg->data) {
+                    rcv->strmfn(msg->peer, &msg->hdr, msg->data, msg->hdr.nbytes, rcv->cbdata);
+                }
+                if (NULL != rcv->cbfunc) {
+                    rcv->cbfunc(msg->peer, &msg->hdr, NULL, rcv->cbdata);
+                }
+            } else if (NULL != rcv->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+                data = msg->data;
+                ndata = msg->hdr.nbytes;
                 if (NULL != msg->data) {
                     PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
                 } else {
@@ -840,6 +1510,7 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                 pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                                     "%s:%d CALLBACK COMPLETE", pmix_globals.myid.nspace,
                                     pmix_globals.myid.rank);
+                PMIX_PTL_BUFPOOL_RECLAIM(&buf, data, ndata);
                 PMIX_DESTRUCT(&buf); // free's the msg data
             }
             /* done with the recv if it is a dynamic tag */
@@ -104,6 +104,7 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
     pmix_ptl_posted_recv_t *req = (pmix_ptl_posted_recv_t *) cbdata;
     pmix_ptl_recv_t *msg, *nmsg;
     pmix_buffer_t buf;
+    char *data;
 
     pmix_output_verbose(5, pmix_ptl_base_framework.framework_output, "posting recv on tag %d",
                         req->tag);
@@ -118,6 +119,7 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
             if (NULL != req->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+                data = msg->data;
                 if (NULL != msg->data) {
                     buf.base_ptr = (char *) msg->data;
                     buf.bytes_allocated = buf.bytes_used = msg->hdr.nbytes;
@@ -126,6 +128,7 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
                 }
                 msg->data = NULL; // protect the data region
                 req->cbfunc(msg->peer, &msg->hdr, &buf, req->cbdata);
+                PMIX_PTL_BUFPOOL_RECLAIM(&buf, data, msg->hdr.nbytes);
                 PMIX_DESTRUCT(&buf); // free's the msg data
             }
             pmix_list_remove_item(&pmix_ptl_base.unexpected_msgs, &msg->super);
@@ -134,6 +137,25 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
     }
 }
 
+/* a recv on a dynamic tag is done after the first message, so a
+ * reply that comes in several messages has to be received again
+ * from within the callback that got the previous one - before the
+ * progress thread can look at the next message */
+pmix_status_t pmix_ptl_base_repost_recv(uint32_t tag, pmix_ptl_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_ptl_posted_recv_t *req;
+
+    req = PMIX_NEW(pmix_ptl_posted_recv_t);
+    if (NULL == req) {
+        return PMIX_ERR_NOMEM;
+    }
+    req->tag = tag;
+    req->cbfunc = cbfunc;
+    req->cbdata = cbdata;
+    pmix_list_prepend(&pmix_ptl_base.posted_recvs, &req->super);
+    return PMIX_SUCCESS;
+}
+
 void pmix_ptl_base_cancel_recv(int fd, short args, void *cbdata)
 {
     (void) fd;
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <errno.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_UIO_H
+#    include <sys/uio.h>
+#endif
+#if defined(HAVE_LINUX_IO_URING_H) && defined(HAVE_SYS_SYSCALL_H)
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    ifndef RWF_NOWAIT
+#        define RWF_NOWAIT 0x00000008
+#    endif
+#    if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#        define PMIX_PTL_HAVE_URING 1
+#    endif
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/ptl/base/base.h"
+
+/* A server that has many peers to write to at once - the release
+ * of a fence, the distribution of a modex - would otherwise make a
+ * writev call per peer from as many send events. With io_uring,
+ * the writes of every peer whose socket became writable in a pass
+ * of the event loop are instead handed to the kernel together and
+ * completed by a single call. The writes are flagged not to wait,
+ * so the kernel completes each of them at once - with what the
+ * socket could take or with EAGAIN - and we never block on the
+ * ring. The ring is only used from the shared progress thread, and
+ * is driven through the raw syscalls so we don't need liburing */
+
+#ifdef PMIX_PTL_HAVE_URING
+
+typedef struct {
+    int fd;
+    unsigned nentries;
+    /* submission queue */
+    void *sq_ptr;
+    size_t sq_len;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    struct io_uring_sqe *sqes;
+    size_t sqes_len;
+    /* completion queue */
+    void *cq_ptr;
+    size_t cq_len;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+} pmix_ptl_uring_t;
+
+static pmix_ptl_uring_t ring = {.fd = -1};
+static bool ring_failed = false;
+
+static void ring_unmap(void)
+{
+    if (NULL != ring.sqes) {
+        munmap(ring.sqes, ring.sqes_len);
+    }
+    if (NULL != ring.cq_ptr && ring.cq_ptr != ring.sq_ptr) {
+        munmap(ring.cq_ptr, ring.cq_len);
+    }
+    if (NULL != ring.sq_ptr) {
+        munmap(ring.sq_ptr, ring.sq_len);
+    }
+    if (0 <= ring.fd) {
+        close(ring.fd);
+    }
+    memset(&ring, 0, sizeof(ring));
+    ring.fd = -1;
+}
+
+static bool ring_setup(unsigned entries)
+{
+    struct io_uring_params p;
+    void *ptr;
+    char *sq, *cq;
+
+    memset(&p, 0, sizeof(p));
+    ring.fd = (int) syscall(__NR_io_uring_setup, entries, &p);
+    if (0 > ring.fd) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:uring setup failed: %s", strerror(errno));
+        ring.fd = -1;
+        return false;
+    }
+    ring.nentries = p.sq_entries;
+
+    ring.sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring.cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+#    ifdef IORING_FEAT_SINGLE_MMAP
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring.cq_len > ring.sq_len) {
+            ring.sq_len = ring.cq_len;
+        }
+        ring.cq_len = ring.sq_len;
+    }
+#    endif
+    ptr = mmap(NULL, ring.sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd,
+               IORING_OFF_SQ_RING);
+    if (MAP_FAILED == ptr) {
+        goto fail;
+    }
+    ring.sq_ptr = ptr;
+#    ifdef IORING_FEAT_SINGLE_MMAP
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring.cq_ptr = ring.sq_ptr;
+    } else
+#    endif
+    {
+        ptr = mmap(NULL, ring.cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ring.fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == ptr) {
+            goto fail;
+        }
+        ring.cq_ptr = ptr;
+    }
+    ring.sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    ptr = mmap(NULL, ring.sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd,
+               IORING_OFF_SQES);
+    if (MAP_FAILED == ptr) {
+        goto fail;
+    }
+    ring.sqes = (struct io_uring_sqe *) ptr;
+
+    sq = (char *) ring.sq_ptr;
+    ring.sq_head = (unsigned *) (sq + p.sq_off.head);
+    ring.sq_tail = (unsigned *) (sq + p.sq_off.tail);
+    ring.sq_mask = (unsigned *) (sq + p.sq_off.ring_mask);
+    ring.sq_array = (unsigned *) (sq + p.sq_off.array);
+    cq = (char *) ring.cq_ptr;
+    ring.cq_head = (unsigned *) (cq + p.cq_off.head);
+    ring.cq_tail = (unsigned *) (cq + p.cq_off.tail);
+    ring.cq_mask = (unsigned *) (cq + p.cq_off.ring_mask);
+    ring.cqes = (struct io_uring_cqe *) (cq + p.cq_off.cqes);
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:uring ring of %u entries set up", ring.nentries);
+    return true;
+
+fail:
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:uring cannot map ring: %s", strerror(errno));
+    ring_unmap();
+    return false;
+}
+
+int pmix_ptl_base_uring_depth(void)
+{
+    if (0 >= pmix_ptl_base.send_uring_depth || ring_failed) {
+        return 0;
+    }
+    if (0 > ring.fd && !ring_setup((unsigned) pmix_ptl_base.send_uring_depth)) {
+        /* don't keep trying - just use the send events */
+        ring_failed = true;
+        return 0;
+    }
+    return (int) ring.nentries;
+}
+
+pmix_status_t pmix_ptl_base_uring_writev(int n, const int *fds, const struct iovec *const *iovs,
+                                         const int *iovcnts, ssize_t *results)
+{
+    struct io_uring_sqe *sqe;
+    struct io_uring_cqe *cqe;
+    unsigned tail, head, idx;
+    int k, submitted, done, rc;
+    bool refused = false;
+
+    if (0 > ring.fd || n > (int) ring.nentries) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    /* we always drain the ring, so it is empty on entry */
+    tail = *ring.sq_tail;
+    for (k = 0; k < n; k++) {
+        idx = tail & *ring.sq_mask;
+        sqe = &ring.sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITEV;
+        sqe->fd = fds[k];
+        sqe->addr = (uint64_t) (uintptr_t) iovs[k];
+        sqe->len = (uint32_t) iovcnts[k];
+        /* complete with EAGAIN rather than wait for the socket */
+        sqe->rw_flags = RWF_NOWAIT;
+        sqe->user_data = (uint64_t) k;
+        ring.sq_array[idx] = idx;
+        /* anything left like this was never written */
+        results[k] = -EINPROGRESS;
+        ++tail;
+    }
+    __atomic_store_n(ring.sq_tail, tail, __ATOMIC_RELEASE);
+
+    submitted = 0;
+    done = 0;
+    while (done < n) {
+        rc = (int) syscall(__NR_io_uring_enter, ring.fd, (unsigned) (n - submitted),
+                           (unsigned) (n - done), IORING_ENTER_GETEVENTS, NULL, 0);
+        if (0 > rc) {
+            if (EINTR == errno) {
+                continue;
+            }
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:base:uring submit failed: %s", strerror(errno));
+            break;
+        }
+        submitted += rc;
+        head = *ring.cq_head;
+        while (head != __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE)) {
+            cqe = &ring.cqes[head & *ring.cq_mask];
+            if (cqe->user_data < (uint64_t) n) {
+                results[cqe->user_data] = cqe->res;
+            }
+            if (-EINVAL == cqe->res || -EOPNOTSUPP == cqe->res) {
+                /* this kernel cannot write sockets this way */
+                refused = true;
+            }
+            ++head;
+            ++done;
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+    pmix_ptl_base.send_uring_calls++;
+    pmix_ptl_base.send_uring_writes += done;
+    if (done < n || refused) {
+        /* the kernel refused the ring - don't use it again */
+        ring_unmap();
+        ring_failed = true;
+        return PMIX_ERROR;
+    }
+    return PMIX_SUCCESS;
+}
+
+void pmix_ptl_base_uring_finalize(void)
+{
+    if (0 <= ring.fd) {
+        ring_unmap();
+    }
+    ring_failed = false;
+}
+
+#else
+
+int pmix_ptl_base_uring_depth(void)
+{
+    return 0;
+}
+
+pmix_status_t pmix_ptl_base_uring_writev(int n, const int *fds, const struct iovec *const *iovs,
+                                         const int *iovcnts, ssize_t *results)
+{
+    PMIX_HIDE_UNUSED_PARAMS(n, fds, iovs, iovcnts, results);
+    return PMIX_ERR_NOT_SUPPORTED;
+}
+
+void pmix_ptl_base_uring_finalize(void)
+{
+    return;
+}
+
+#endif
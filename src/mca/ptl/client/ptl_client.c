@@ -84,6 +84,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *pr, pmix_info_t *info,
     pmix_info_t *iptr;
     size_t niptr;
     pmix_data_array_t darray;
+    pmix_info_t jinfo;
     pmix_list_t connections;
     pmix_connection_t *cn;
 
@@ -203,7 +204,16 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *pr, pmix_info_t *info,
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                         "ptl:tcp:client attempt connect to %s:%u at %s", nspace, rank, suri);
 
-    rc = pmix_ptl_base_make_connection(peer, suri, NULL, 0);
+    /* if our server offered it, ask for our job info to be
+     * returned with the handshake so we needn't request it */
+    if (NULL != getenv(PMIX_PTL_JOBINFO_ENVAR)) {
+        PMIX_INFO_LOAD(&jinfo, PMIX_PTL_JOBINFO_KEY, NULL, PMIX_BOOL);
+        pmix_client_globals.jobinfo_in_ack = true;
+        rc = pmix_ptl_base_make_connection(peer, suri, &jinfo, 1);
+        PMIX_INFO_DESTRUCT(&jinfo);
+    } else {
+        rc = pmix_ptl_base_make_connection(peer, suri, NULL, 0);
+    }
     if (PMIX_SUCCESS != rc) {
         free(nspace);
         free(suri);
@@ -139,23 +139,56 @@ typedef struct pmix_ptl_module_t pmix_ptl_module_t;
         }                                                  \
     } while (0)
 
+/* as SEND_RECV, but the payload of the reply is handed to the stream
+ * function in pieces as it is read from the socket, so the caller can
+ * process it while the rest is still in transit. Once all of it has
+ * been delivered, the cbfunc is called with a NULL buffer. A lost
+ * connection still completes the recv by calling the cbfunc with an
+ * empty buffer */
+#define PMIX_PTL_SEND_RECV_STREAM(r, p, b, s, c, d)        \
+    do {                                                   \
+        pmix_ptl_sr_t *ms;                                 \
+        pmix_peer_t *pr = (pmix_peer_t *) (p);             \
+        if ((p)->finalized) {                              \
+            (r) = PMIX_ERR_UNREACH;                        \
+        } else {                                           \
+            ms = PMIX_NEW(pmix_ptl_sr_t);                  \
+            PMIX_RETAIN(pr);                               \
+            ms->peer = pr;                                 \
+            ms->bfr = (b);                                 \
+            ms->strmfn = (s);                              \
+            ms->cbfunc = (c);                              \
+            ms->cbdata = (d);                              \
+            PMIX_THREADSHIFT(ms, pmix_ptl_base_send_recv); \
+            (r) = PMIX_SUCCESS;                            \
+        }                                                  \
+    } while (0)
+
 /* (ONE-WAY) send a message to the peer. The buffer will be free'd
- * at the completion of the send */
-#define PMIX_PTL_SEND_ONEWAY(r, p, b, t)             \
-    do {                                             \
-        pmix_ptl_queue_t *q;                         \
-        pmix_peer_t *pr = (pmix_peer_t *) (p);       \
-        if ((p)->finalized) {                        \
-            (r) = PMIX_ERR_UNREACH;                  \
-        } else {                                     \
-            q = PMIX_NEW(pmix_ptl_queue_t);          \
-            PMIX_RETAIN(pr);                         \
-            q->peer = pr;                            \
-            q->buf = (b);                            \
-            q->tag = (t);                            \
-            PMIX_THREADSHIFT(q, pmix_ptl_base_send); \
-            (r) = PMIX_SUCCESS;                      \
-        }                                            \
+ * at the completion of the send. Peers serviced by a server I/O
+ * thread have the message queued directly by that thread */
+#define PMIX_PTL_SEND_ONEWAY(r, p, b, t)                                     \
+    do {                                                                     \
+        pmix_ptl_queue_t *q;                                                 \
+        pmix_peer_t *pr = (pmix_peer_t *) (p);                               \
+        if ((p)->finalized) {                                                \
+            (r) = PMIX_ERR_UNREACH;                                          \
+        } else {                                                             \
+            q = PMIX_NEW(pmix_ptl_queue_t);                                  \
+            PMIX_RETAIN(pr);                                                 \
+            q->peer = pr;                                                    \
+            q->buf = (b);                                                    \
+            q->tag = (t);                                                    \
+            if (NULL == pr->evbase) {                                        \
+                PMIX_THREADSHIFT(q, pmix_ptl_base_send);                     \
+            } else {                                                         \
+                pmix_event_assign(&q->ev, pr->evbase, -1, EV_WRITE,          \
+                                  pmix_ptl_base_send, q);                    \
+                PMIX_POST_OBJECT(q);                                         \
+                pmix_event_active(&q->ev, EV_WRITE, 1);                      \
+            }                                                                \
+            (r) = PMIX_SUCCESS;                                              \
+        }                                                                    \
     } while (0)
 
 #define PMIX_PTL_RECV(r, c, t)                                               \
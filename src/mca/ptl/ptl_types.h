@@ -216,6 +216,12 @@ typedef struct {
 typedef void (*pmix_ptl_cbfunc_t)(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf,
                                   void *cbdata);
 
+/* define the callback for a recv whose payload is handed over in
+ * pieces as it is read from the socket - each call carries the next
+ * ndata bytes of the payload, in order */
+typedef void (*pmix_ptl_stream_cbfunc_t)(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                                         char *data, size_t ndata, void *cbdata);
+
 /* define a callback function for notifying that server connection
  * has completed */
 typedef void (*pmix_ptl_connect_cbfunc_t)(pmix_status_t status, void *cbdata);
@@ -230,8 +236,11 @@ typedef struct {
     pmix_ptl_hdr_t hdr;
     pmix_buffer_t *data;
     bool hdr_sent;
+    /* what is left of the header */
     char *sdptr;
     size_t sdbytes;
+    /* how much of the payload has been written */
+    size_t dsent;
 } pmix_ptl_send_t;
 PMIX_CLASS_DECLARATION(pmix_ptl_send_t);
 
@@ -246,16 +255,24 @@ typedef struct {
     bool hdr_recvd;
     char *rdptr;
     size_t rdbytes;
+    /* the posted recv the payload is being streamed to, if any - the
+     * data region then only holds the piece currently being read */
+    struct pmix_ptl_posted_recv_t *stream;
+    size_t strmleft;
 } pmix_ptl_recv_t;
 PMIX_CLASS_DECLARATION(pmix_ptl_recv_t);
 
 /* structure for tracking posted recvs */
-typedef struct {
+typedef struct pmix_ptl_posted_recv_t {
     pmix_list_item_t super;
     pmix_event_t ev;
     uint32_t tag;
     pmix_ptl_cbfunc_t cbfunc;
+    pmix_ptl_stream_cbfunc_t strmfn;
     void *cbdata;
+    /* the request this recv answers, kept only by a client that
+     * may have to send it again to a restarted server */
+    pmix_buffer_t *request;
 } pmix_ptl_posted_recv_t;
 PMIX_CLASS_DECLARATION(pmix_ptl_posted_recv_t);
 
@@ -268,6 +285,7 @@ typedef struct {
     pmix_status_t status;
     pmix_buffer_t *bfr;
     pmix_ptl_cbfunc_t cbfunc;
+    pmix_ptl_stream_cbfunc_t strmfn;
     void *cbdata;
 } pmix_ptl_sr_t;
 PMIX_CLASS_DECLARATION(pmix_ptl_sr_t);
@@ -290,7 +308,7 @@ typedef uint16_t pmix_listener_protocol_t;
 
 /* connection support */
 typedef struct {
-    pmix_object_t super;
+    pmix_list_item_t super;
     pmix_event_t ev;
     pmix_listener_protocol_t protocol;
     int sd;
@@ -312,6 +330,11 @@ typedef struct {
     uid_t uid;
     gid_t gid;
     pmix_proc_type_t proc_type;
+    pmix_ptl_hdr_t hdr;     // header of the connection request
+    char *msg;              // body of the request, if already read by the listener
+    size_t rcvd;            // number of request bytes (header included) read so far
+    char *blob;             // packed info array a client included in its request
+    size_t bloblen;
 } pmix_pending_connection_t;
 PMIX_CLASS_DECLARATION(pmix_pending_connection_t);
 
@@ -348,6 +371,9 @@ PMIX_CLASS_DECLARATION(pmix_listener_t);
 /* provide a backdoor to the framework output for debugging */
 PMIX_EXPORT extern int pmix_ptl_base_output;
 
+/* let the server time its reply to a request from the peer */
+PMIX_EXPORT void pmix_server_stats_reply(struct pmix_peer_t *peer, uint32_t tag);
+
 #define PMIX_ACTIVATE_POST_MSG(ms)                                        \
     do {                                                                  \
         pmix_event_assign(&((ms)->ev), pmix_globals.evbase, -1, EV_WRITE, \
@@ -377,14 +403,15 @@ PMIX_EXPORT extern int pmix_ptl_base_output;
         pmix_output_verbose(5, pmix_ptl_base_output,                                            \
                             "[%s:%d] queue callback called: reply to %s:%d on tag %d size %d",  \
                             __FILE__, __LINE__, (p)->info->pname.nspace, (p)->info->pname.rank, \
-                            (t), (int) (b)->bytes_used);                                        \
+                            (t), (int) PMIX_BUFFER_TOTAL_BYTES(b));                             \
         if ((p)->finalized) {                                                                   \
             (r) = PMIX_ERR_UNREACH;                                                             \
         } else {                                                                                \
+            pmix_server_stats_reply((p), (t));                                                  \
             snd = PMIX_NEW(pmix_ptl_send_t);                                                    \
             snd->hdr.pindex = htonl(pmix_globals.pindex);                                       \
             snd->hdr.tag = htonl(t);                                                            \
-            nbytes = (b)->bytes_used;                                                           \
+            nbytes = PMIX_BUFFER_TOTAL_BYTES(b);                                                \
             snd->hdr.nbytes = htonl(nbytes);                                                    \
             snd->data = (b);                                                                    \
             /* always start with the header */                                                  \
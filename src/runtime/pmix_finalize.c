@@ -31,6 +31,7 @@
 #include "src/class/pmix_object.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/common/pmix_attributes.h"
+#include "src/common/pmix_iof.h"
 #include "src/mca/base/pmix_base.h"
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/bfrops/base/base.h"
@@ -43,16 +44,19 @@
 #include "src/mca/preg/base/base.h"
 #include "src/mca/psec/base/base.h"
 #include "src/mca/psquash/base/base.h"
+#include "src/mca/pstrg/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/threads/pmix_tsd.h"
 #include "src/util/pmix_keyval_parse.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_timings.h"
 #include "src/runtime/pmix_init_util.h"
 #include <event.h>
 
 #include "src/runtime/pmix_progress_threads.h"
 #include "src/runtime/pmix_rte.h"
+#include "src/runtime/pmix_timer.h"
 
 extern int pmix_initialized;
 extern bool pmix_init_called;
@@ -68,11 +72,20 @@ void pmix_rte_finalize(void)
         return;
     }
 
+    if (pmix_timing_startup) {
+        pmix_timing_phase_report();
+    }
+
+    /* complete any pending epilogs - those of the nspaces
+     * released below are executed in place */
+    pmix_epilog_finalize();
+
     /* release the attribute support trackers */
     pmix_release_registered_attrs();
 
-    /* close plog */
+    /* close plog and pstrg - clients may never have opened them */
     (void) pmix_mca_base_framework_close(&pmix_plog_base_framework);
+    (void) pmix_mca_base_framework_close(&pmix_pstrg_base_framework);
 
     /* close preg */
     (void) pmix_mca_base_framework_close(&pmix_preg_base_framework);
@@ -96,6 +109,16 @@ void pmix_rte_finalize(void)
     /* close GDS */
     (void) pmix_mca_base_framework_close(&pmix_gds_base_framework);
 
+    /* report and release the object pools - anything
+     * released after this returns its storage to the heap */
+    if (pmix_globals.obj_pool_report) {
+        pmix_obj_pool_report(0, NULL);
+    }
+    pmix_obj_pool_finalize(&pmix_globals.kval_pool);
+    pmix_obj_pool_finalize(&pmix_globals.buffer_pool);
+    pmix_obj_pool_finalize(&pmix_globals.send_pool);
+    pmix_obj_pool_finalize(&pmix_globals.recv_pool);
+
     /* finalize the mca */
     /* Clear out all the registered MCA params */
     pmix_deregister_params();
@@ -122,13 +145,13 @@ void pmix_rte_finalize(void)
     PMIX_DESTRUCT(&pmix_globals.events);
     PMIX_LIST_DESTRUCT(&pmix_globals.cached_events);
     /* clear any notifications */
-    for (i = 0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_checkout_and_return_occupant(&pmix_globals.notifications, i, (void **) &cd);
-        if (NULL != cd) {
-            PMIX_RELEASE(cd);
-        }
+    while (0 <= (i = pmix_hotel_oldest_room(&pmix_globals.notifications))) {
+        pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &cd);
+        pmix_notify_event_uncache(cd);
+        PMIX_RELEASE(cd);
     }
     PMIX_DESTRUCT(&pmix_globals.notifications);
+    PMIX_DESTRUCT(&pmix_globals.notify_codes);
     for (i = 0; i < pmix_globals.iof_requests.size; i++) {
         req = (pmix_iof_req_t *) pmix_pointer_array_get_item(&pmix_globals.iof_requests, i);
         if (NULL != req) {
@@ -136,6 +159,7 @@ void pmix_rte_finalize(void)
         }
     }
     PMIX_DESTRUCT(&pmix_globals.iof_requests);
+    pmix_iof_finalize();
     PMIX_LIST_DESTRUCT(&pmix_globals.stdin_targets);
     if (NULL != pmix_globals.hostname) {
         free(pmix_globals.hostname);
@@ -158,6 +182,11 @@ void pmix_rte_finalize(void)
         }
     }
     PMIX_DESTRUCT(&pmix_globals.keyindex);
+    PMIX_DESTRUCT(&pmix_globals.keynames);
+
+    /* drop any timers still pending - the progress thread is
+     * paused, and the event base still exists */
+    pmix_timer_finalize();
 
     /* now safe to release the event base */
     (void) pmix_progress_thread_stop(NULL);
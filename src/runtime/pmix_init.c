@@ -54,6 +54,7 @@
 #include "src/util/pmix_net.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_timings.h"
 
 #include "src/client/pmix_client_ops.h"
 #include "src/common/pmix_attributes.h"
@@ -101,12 +102,22 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
     .max_events = INT_MAX,
     .event_eviction_time = 0,
     .notifications = PMIX_HOTEL_STATIC_INIT,
+    .notify_codes = PMIX_HASH_TABLE_STATIC_INIT,
     .pushstdin = false,
     .stdin_targets = PMIX_LIST_STATIC_INIT,
     .tag_output = false,
     .xml_output = false,
     .timestamp_output = false,
     .output_limit = SIZE_MAX,
+    .iof_read_size = PMIX_IOF_BASE_MSG_MAX,
+    .iof_read_max = PMIX_IOF_BASE_MSG_MAX,
+    .iof_flush_usec = 10000,
+    .iof_compress_limit = 0,
+    .iof_format_threads = 0,
+    .epilog_threads = 2,
+    .shmem_hugepages = false,
+    .shmem_interleave = false,
+    .shmem_prefault = false,
     .nspaces = PMIX_LIST_STATIC_INIT,
     .topology = {NULL, NULL},
     .cpuset = {NULL, NULL},
@@ -114,7 +125,14 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
     .external_progress = false,
     .iof_flags = PMIX_IOF_FLAGS_STATIC_INIT,
     .keyindex = PMIX_POINTER_ARRAY_STATIC_INIT,
-    .next_keyid = PMIX_INDEX_BOUNDARY
+    .keynames = PMIX_HASH_TABLE_STATIC_INIT,
+    .next_keyid = PMIX_INDEX_BOUNDARY,
+    .obj_pool_max = 0,
+    .obj_pool_report = false,
+    .kval_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .buffer_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .send_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .recv_pool = PMIX_OBJ_POOL_STATIC_INIT
 };
 
 static void _notification_eviction_cbfunc(struct pmix_hotel_t *hotel, int room_num, void *occupant)
@@ -122,6 +140,7 @@ static void _notification_eviction_cbfunc(struct pmix_hotel_t *hotel, int room_n
     pmix_notify_caddy_t *cache = (pmix_notify_caddy_t *) occupant;
     PMIX_HIDE_UNUSED_PARAMS(hotel, room_num);
 
+    pmix_notify_event_uncache(cache);
     PMIX_RELEASE(cache);
 }
 
@@ -180,6 +199,14 @@ int pmix_init_util(pmix_info_t info[], size_t ninfo, char *libdir)
         return ret;
     }
 
+    /* hold the storage of the objects that are created and
+     * released most often - e.g., while storing modex data, and
+     * the descriptor of each message queued on a connection */
+    PMIX_OBJ_POOL_ATTACH(&pmix_globals.kval_pool, pmix_kval_t, pmix_globals.obj_pool_max);
+    PMIX_OBJ_POOL_ATTACH(&pmix_globals.buffer_pool, pmix_buffer_t, pmix_globals.obj_pool_max);
+    PMIX_OBJ_POOL_ATTACH(&pmix_globals.send_pool, pmix_ptl_send_t, pmix_globals.obj_pool_max);
+    PMIX_OBJ_POOL_ATTACH(&pmix_globals.recv_pool, pmix_ptl_recv_t, pmix_globals.obj_pool_max);
+
     /* initialize the mca */
     if (PMIX_SUCCESS != (ret = pmix_mca_base_open(libdir))) {
         fprintf(stderr, "pmix_mca_base_open failed\n");
@@ -191,15 +218,41 @@ int pmix_init_util(pmix_info_t info[], size_t ninfo, char *libdir)
         return ret;
     }
 
-    /* initialize pif framework */
-    ret = pmix_mca_base_framework_open(&pmix_pif_base_framework,
+    /* the pif framework is opened - and the interfaces enumerated -
+     * when something first looks up an interface, so processes
+     * that never do so don't pay for it */
+
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_rte_open_plog(void)
+{
+    pmix_status_t ret;
+
+    if (pmix_mca_base_framework_is_open(&pmix_plog_base_framework)) {
+        return PMIX_SUCCESS;
+    }
+    ret = pmix_mca_base_framework_open(&pmix_plog_base_framework,
                                        PMIX_MCA_BASE_OPEN_DEFAULT);
     if (PMIX_SUCCESS != ret) {
-        fprintf(stderr, "pmix_pif_base_open failed\n");
         return ret;
     }
+    return pmix_plog_base_select();
+}
 
-    return PMIX_SUCCESS;
+pmix_status_t pmix_rte_open_pstrg(void)
+{
+    pmix_status_t ret;
+
+    if (pmix_mca_base_framework_is_open(&pmix_pstrg_base_framework)) {
+        return PMIX_SUCCESS;
+    }
+    ret = pmix_mca_base_framework_open(&pmix_pstrg_base_framework,
+                                       PMIX_MCA_BASE_OPEN_DEFAULT);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    return pmix_pstrg_base_select();
 }
 
 int pmix_rte_init(uint32_t type, pmix_info_t info[], size_t ninfo, pmix_ptl_cbfunc_t cbfunc)
@@ -305,9 +358,13 @@ int pmix_rte_init(uint32_t type, pmix_info_t info[], size_t ninfo, pmix_ptl_cbfu
     PMIX_CONSTRUCT(&pmix_globals.notifications, pmix_hotel_t);
     ret = pmix_hotel_init(&pmix_globals.notifications, pmix_globals.max_events, pmix_globals.evbase,
                           pmix_globals.event_eviction_time, _notification_eviction_cbfunc);
+    PMIX_CONSTRUCT(&pmix_globals.notify_codes, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.notify_codes, 32);
     PMIX_CONSTRUCT(&pmix_globals.nspaces, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_globals.keyindex, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_globals.keyindex, 1024, INT_MAX, 128);
+    PMIX_CONSTRUCT(&pmix_globals.keynames, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.keynames, 256);
     /* need to hold off checking the hotel init return code
      * until after we construct all the globals so they can
      * correctly finalize */
@@ -417,6 +474,7 @@ int pmix_rte_init(uint32_t type, pmix_info_t info[], size_t ninfo, pmix_ptl_cbfu
      * will be done by the individual init functions and at the
      * time of connection to that peer */
 
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_FRAMEWORKS);
     ret = pmix_mca_base_framework_open(&pmix_psquash_base_framework,
                                        PMIX_MCA_BASE_OPEN_DEFAULT);
     if (PMIX_SUCCESS != ret) {
@@ -516,29 +574,20 @@ int pmix_rte_init(uint32_t type, pmix_info_t info[], size_t ninfo, pmix_ptl_cbfu
         goto return_error;
     }
 
-    /* open the plog and select the active plugins */
-    ret = pmix_mca_base_framework_open(&pmix_plog_base_framework,
-                                       PMIX_MCA_BASE_OPEN_DEFAULT);
-    if (PMIX_SUCCESS != ret) {
-        error = "pmix_plog_base_open";
-        goto return_error;
-    }
-    if (PMIX_SUCCESS != (ret = pmix_plog_base_select())) {
-        error = "pmix_plog_base_select";
-        goto return_error;
-    }
-
-    /* open the pstrg framework */
-    ret = pmix_mca_base_framework_open(&pmix_pstrg_base_framework,
-                                       PMIX_MCA_BASE_OPEN_DEFAULT);
-    if (PMIX_SUCCESS != ret) {
-        error = "pmix_strg_base_open";
-        goto return_error;
-    }
-    if (PMIX_SUCCESS != (ret = pmix_pstrg_base_select())) {
-        error = "pmix_pstrg_base_select";
-        goto return_error;
+    /* clients only log and query storage locally when they
+     * cannot reach their server, so those frameworks are not
+     * opened until they are first needed */
+    if (PMIX_PROC_CLIENT != type) {
+        if (PMIX_SUCCESS != (ret = pmix_rte_open_plog())) {
+            error = "pmix_plog_base_open";
+            goto return_error;
+        }
+        if (PMIX_SUCCESS != (ret = pmix_rte_open_pstrg())) {
+            error = "pmix_pstrg_base_open";
+            goto return_error;
+        }
     }
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_FRAMEWORKS);
 
     /* initialize the attribute support system */
     pmix_init_registered_attrs();
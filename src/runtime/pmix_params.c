@@ -44,6 +44,7 @@
 char *pmix_timing_output = NULL;
 bool pmix_timing_overhead = true;
 #endif
+bool pmix_timing_startup = false;
 
 static bool pmix_register_done = false;
 char *pmix_net_private_ipv4 = NULL;
@@ -51,6 +52,10 @@ int pmix_event_caching_window = 1;
 bool pmix_suppress_missing_data_warning = false;
 char *pmix_progress_thread_cpus = NULL;
 bool pmix_bind_progress_thread_reqd = false;
+int pmix_progress_thread_shift_depth = 1024;
+int pmix_progress_thread_busy_poll = 0;
+bool pmix_progress_thread_profile = false;
+int pmix_progress_thread_lag_interval = 100;
 int pmix_maxfd = 1024;
 
 pmix_status_t pmix_register_params(void)
@@ -83,6 +88,24 @@ pmix_status_t pmix_register_params(void)
         &pmix_timing_overhead);
 #endif
 
+    pmix_timing_startup = false;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", NULL, "timing_startup",
+        "Output the time spent in each startup phase (init, framework open, connect, job info, "
+        "first fence and get) when finalizing (default: false)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_timing_startup);
+
+    pmix_thread_spin_count = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "thread", "spin_count",
+        "Number of times a thread blocked in an API call checks for the reply before "
+        "it sleeps - replies that arrive while it spins are picked up without a "
+        "sleep/wakeup cycle at the cost of some CPU time (0 => sleep right away) "
+        "(default: 0)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_thread_spin_count);
+
     /* RFC1918 defines
        - 10.0.0./8
        - 172.16.0.0/12
@@ -158,6 +181,33 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &pmix_client_globals.base_verbose);
 
+    /****   CLIENT: LOG AGGREGATION PARAMS   ****/
+    (void) pmix_mca_base_var_register("pmix", "pmix", "client", "log_batch_max",
+                                      "Maximum number of non-blocking log requests to send to "
+                                      "the server in one message (1 = send each one immediately)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_client_globals.log_batch_max);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", "client", "log_batch_delay",
+                                      "Time (in msec) to hold non-blocking log requests for "
+                                      "aggregation before sending them to the server (0 = no hold)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_client_globals.log_batch_delay);
+
+    /****   CLIENT: COMMIT PARAMS   ****/
+    (void) pmix_mca_base_var_register("pmix", "pmix", "client", "commit_delta",
+                                      "After the first commit, only send the server the keys "
+                                      "put since the previous commit (default: true)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_client_globals.commit_delta);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", "client", "put_stage",
+                                      "Hold the values given to PMIx_Put in the calling thread "
+                                      "and store them together at the next commit or get "
+                                      "(default: true)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_client_globals.put_stage);
+
     /****   SERVER: VERBOSE OUTPUT PARAMS   ****/
     (void) pmix_mca_base_var_register("pmix", "pmix", "server", "get_verbose",
                                       "Verbosity for server get operations",
@@ -207,6 +257,260 @@ pmix_status_t pmix_register_params(void)
         PMIX_MCA_BASE_VAR_TYPE_BOOL,
         &pmix_server_globals.fence_localonly_opt);
 
+    pmix_server_globals.fence_pipeline = false;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "fence_pipeline",
+        "Pack each local contribution to a fence that collects data as it arrives "
+        "so the blob is ready for the host when the last local participant checks in. "
+        "Keys are always sent in native format (default: false)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.fence_pipeline);
+
+    pmix_server_globals.fence_dedup = false;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "fence_dedup",
+        "Send a value posted by several local participants in a fence that collects data "
+        "only once, in a table at the head of the node's blob, and have the receiving "
+        "servers store it once for all of those procs. Takes precedence over "
+        "fence_pipeline (default: false)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.fence_dedup);
+
+    pmix_server_globals.sched = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "sched",
+        "Handle collectives, gets and other latency-critical commands as soon as "
+        "they arrive, and queue event traffic and queries, logs and IOF behind "
+        "them (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.sched);
+
+    pmix_server_globals.sched_event_weight = 8;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "sched_event_weight",
+        "Number of queued event commands serviced each time the server "
+        "goes around its event loop (default: 8)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.sched_event_weight);
+
+    pmix_server_globals.sched_bulk_weight = 2;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "sched_bulk_weight",
+        "Number of queued query, log, IOF and monitoring commands serviced each "
+        "time the server goes around its event loop (default: 2)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.sched_bulk_weight);
+
+    pmix_server_globals.sched_tool_limit = 128;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "sched_tool_limit",
+        "Number of commands a tool may have queued in each class before further "
+        "ones are refused with PMIX_ERR_OUT_OF_RESOURCE (default: 128, 0 = unlimited)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.sched_tool_limit);
+
+    pmix_server_globals.shmem_modex = false;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "shmem_modex",
+        "Publish the data collected by a fence in a read-only shared-memory segment "
+        "so local clients can retrieve remote procs' data without contacting the "
+        "server (default: false)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.shmem_modex);
+
+    pmix_server_globals.dmodex_aggregate_window = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "dmodex_aggregate_window",
+        "Time (in usecs) to hold a direct modex request so that requests for other "
+        "procs on the same remote node can be passed to the host in a single upcall. "
+        "The host must support the PMIX_DMODEX_RANKS attribute (default: 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.dmodex_aggregate_window);
+
+    pmix_server_globals.dmodex_prefetch_window = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "dmodex_prefetch_window",
+        "Number of ranks on either side of a proc whose data is missing to request "
+        "from the host along with it. The host must support the PMIX_DMODEX_RANKS "
+        "attribute (default: 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.dmodex_prefetch_window);
+
+    pmix_server_globals.dmodex_prefetch_node = false;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "dmodex_prefetch_node",
+        "Request the data of all procs on the node of a proc whose data is missing "
+        "along with it. The host must support the PMIX_DMODEX_RANKS attribute "
+        "(default: false)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.dmodex_prefetch_node);
+
+    pmix_server_globals.event_batch_window = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "event_batch_window",
+        "Time (in usecs) to hold event notifications for a local client so that "
+        "notifications arriving in the meantime are delivered in a single message "
+        "(default: 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.event_batch_window);
+
+    pmix_server_globals.event_batch_max = 64;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "event_batch_max",
+        "Maximum number of event notifications delivered to a local client in a "
+        "single message (default: 64)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.event_batch_max);
+
+    pmix_server_globals.group_cid_block = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "group_cid_block",
+        "Number of group context IDs to ask the host to reserve for this server "
+        "whenever it must request one, so that later constructs involving only "
+        "local processes can be assigned an ID without asking the host again "
+        "(default: 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.group_cid_block);
+
+    pmix_server_globals.request_pool_max = 128;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "request_pool_max",
+        "Maximum number of objects of each class used to track inbound requests "
+        "that are held for reuse instead of being returned to the heap "
+        "(default: 128, 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+        &pmix_server_globals.request_pool_max);
+
+    pmix_server_globals.cmd_stats = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "cmd_stats",
+        "Count the requests received from local clients and tools for each "
+        "command and the time taken to reply to them, for retrieval with "
+        "PMIx_Query_info (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.cmd_stats);
+
+    pmix_server_globals.locality_matrix_max = 1024;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "locality_matrix_max",
+        "Maximum number of local processes in a job for which the relative "
+        "locality of every pair is computed from their locality strings and "
+        "included in the job info given to the clients (default: 1024, "
+        "0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+        &pmix_server_globals.locality_matrix_max);
+
+    pmix_server_globals.register_slice = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "register_slice",
+        "Number of per-proc data entries of a newly registered namespace to "
+        "cache before letting the server attend to its clients again. The "
+        "namespace is only made available to its procs once all of them are "
+        "cached (default: 0 = cache them all at once)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.register_slice);
+
+    pmix_server_globals.inventory_parallel = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "inventory_parallel",
+        "Collect the inventory from each framework on its own thread instead "
+        "of one after the other in the progress thread (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.inventory_parallel);
+
+    pmix_server_globals.inventory_cache_lifetime = 60;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "inventory_cache_lifetime",
+        "Number of seconds for which requests to collect the inventory that "
+        "carry no directives are answered with the result of the last such "
+        "collection (default: 60, 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.inventory_cache_lifetime);
+
+    pmix_server_globals.pubsub_cache = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "pubsub_cache",
+        "Keep a node-local copy of published data so that lookups of it "
+        "can be answered without asking the host (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.pubsub_cache);
+
+    pmix_server_globals.pubsub_cache_lifetime = 60;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "pubsub_cache_lifetime",
+        "Number of seconds for which data returned by the host for a lookup "
+        "is reused to answer the same lookup from the same namespace - data "
+        "published elsewhere to be removed on first read can be returned "
+        "again during that time (default: 60, 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.pubsub_cache_lifetime);
+
+    pmix_server_globals.pubsub_coalesce = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "pubsub_coalesce",
+        "Pass publishes that a proc makes while an earlier one is still with "
+        "the host up in a single call, and have local lookups waiting for the "
+        "same data share one request to the host (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.pubsub_coalesce);
+
+    pmix_server_globals.query_coalesce = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "query_coalesce",
+        "Answer identical queries from local clients that arrive while one "
+        "is being resolved with that one's answer (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.query_coalesce);
+
+    pmix_server_globals.query_cache_lifetime = 0;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "query_cache_lifetime",
+        "Number of seconds for which the answer to a query whose keys are all "
+        "listed in pmix_server_query_cache_keys is reused for the same query - "
+        "queries with PMIX_QUERY_REFRESH_CACHE are always resolved anew "
+        "(default: 0 = disabled)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.query_cache_lifetime);
+
+    pmix_server_globals.query_cache_keys = PMIX_QUERY_NUM_PSETS "," PMIX_QUERY_PSET_NAMES ","
+        PMIX_QUERY_NAMESPACES "," PMIX_QUERY_NAMESPACE_INFO "," PMIX_QUERY_PROC_TABLE ","
+        PMIX_QUERY_LOCAL_PROC_TABLE "," PMIX_QUERY_SPAWN_SUPPORT "," PMIX_QUERY_DEBUG_SUPPORT;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "query_cache_keys",
+        "Comma-delimited list of query keys whose answers may be reused "
+        "for pmix_server_query_cache_lifetime seconds",
+        PMIX_MCA_BASE_VAR_TYPE_STRING,
+        &pmix_server_globals.query_cache_keys);
+
+    pmix_server_globals.query_stream_chunk = 4096;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "query_stream_chunk",
+        "Maximum number of elements of a returned array (e.g., the proc "
+        "table) to send in one message to a requestor that asked for "
+        "PMIX_QUERY_STREAM - larger arrays are sent in slices of this "
+        "size (default: 4096, 0 = never split)",
+        PMIX_MCA_BASE_VAR_TYPE_INT,
+        &pmix_server_globals.query_stream_chunk);
+
+    pmix_server_globals.finalize_batch = true;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "finalize_batch",
+        "Remove the event, IOF and direct modex registrations of all clients "
+        "that finalize within the same pass of the event loop in one sweep "
+        "of each, instead of one sweep per client (default: true)",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+        &pmix_server_globals.finalize_batch);
+
+    pmix_server_globals.snapshot = NULL;
+    (void) pmix_mca_base_var_register(
+        "pmix", "pmix", "server", "snapshot",
+        "File in which the server keeps the nspaces, clients, process sets "
+        "and groups registered with it, so that a server restarted after a "
+        "failure restores them during PMIx_server_init. The file is removed "
+        "when the server finalizes (default: none)",
+        PMIX_MCA_BASE_VAR_TYPE_STRING,
+        &pmix_server_globals.snapshot);
+
     /* check for maximum number of pending output messages */
     pmix_globals.output_limit = (size_t) INT_MAX;
     (void) pmix_mca_base_var_register("pmix", "iof", NULL, "output_limit",
@@ -214,6 +518,80 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
                                       &pmix_globals.output_limit);
 
+    pmix_globals.iof_read_size = 65536;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "read_size",
+                                      "Number of bytes to take from a local IO channel when it "
+                                      "becomes readable - a channel that stays full is read in "
+                                      "larger passes, up to pmix_iof_read_max [default: 65536]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_globals.iof_read_size);
+
+    pmix_globals.iof_read_max = 1024 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "read_max",
+                                      "Largest number of bytes taken from a local IO channel in "
+                                      "one pass, and so the largest chunk of output handled at "
+                                      "a time [default: 1048576]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_globals.iof_read_max);
+
+    pmix_globals.iof_flush_usec = 10000;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "flush_usec",
+                                      "Longest time in microseconds a pass over a local IO "
+                                      "channel keeps reading before passing what it has on "
+                                      "[default: 10000]",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_globals.iof_flush_usec);
+
+    pmix_globals.iof_compress_limit = 0;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "compress_limit",
+                                      "Compress forwarded output of at least this many bytes "
+                                      "before sending it to a tool or client - chunks below "
+                                      "pmix_pcompress_base_block_limit are never compressed "
+                                      "(0 => never compress) [default: 0]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_globals.iof_compress_limit);
+
+    pmix_globals.iof_format_threads = 0;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "format_threads",
+                                      "Number of threads used to tag and format forwarded "
+                                      "output so the progress thread is not held up by it "
+                                      "(0 => format in the progress thread) [default: 0]",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_globals.iof_format_threads);
+
+    pmix_globals.epilog_threads = 2;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "epilog", "threads",
+                                      "Number of threads used to remove the files and "
+                                      "directories of terminated clients and jobs so the "
+                                      "progress thread is not held up by it (0 => remove "
+                                      "them in the progress thread) [default: 2]",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_globals.epilog_threads);
+
+    pmix_globals.shmem_hugepages = false;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "shmem", "hugepages",
+                                      "Advise the kernel to back shared-memory segments with "
+                                      "transparent huge pages (default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_globals.shmem_hugepages);
+
+    pmix_globals.shmem_interleave = false;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "shmem", "interleave",
+                                      "Interleave the pages of the shared-memory segments "
+                                      "created by this process across the NUMA domains of the "
+                                      "node (default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_globals.shmem_interleave);
+
+    pmix_globals.shmem_prefault = false;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "shmem", "prefault",
+                                      "Fault in all pages of a shared-memory segment when it is "
+                                      "created or attached instead of on first access - note "
+                                      "that this commits the full size of the segment "
+                                      "(default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_globals.shmem_prefault);
+
     pmix_globals.xml_output = false;
     (void) pmix_mca_base_var_register("pmix", "iof", NULL, "xml_output",
                                       "Display all output in XML format (default: false)",
@@ -252,6 +630,21 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &pmix_globals.event_eviction_time);
 
+    pmix_globals.obj_pool_max = 1024;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "obj", "pool_max",
+                                      "Maximum number of objects of each pooled class (e.g., "
+                                      "key-value pairs and buffers) held for reuse instead of "
+                                      "being returned to the heap (default: 1024, 0 = disabled)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_globals.obj_pool_max);
+
+    pmix_globals.obj_pool_report = false;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "obj", "pool_report",
+                                      "Output the number of allocations, live and peak objects "
+                                      "of each object pool at finalize (default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_globals.obj_pool_report);
+
     /* max number of IOF messages to cache */
     pmix_server_globals.max_iof_cache = 1024 * 1024;
     (void) pmix_mca_base_var_register("pmix", "pmix", "max", "iof_cache",
@@ -259,6 +652,30 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &pmix_server_globals.max_iof_cache);
 
+    pmix_server_globals.max_iof_cache_bytes = 64 * 1024 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "max", "iof_cache_bytes",
+                                      "Maximum number of bytes of IOF data to cache in memory "
+                                      "for tools that have not yet registered for it - the "
+                                      "oldest messages are dropped beyond it unless spilling "
+                                      "is enabled [default: 64MB]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_server_globals.max_iof_cache_bytes);
+
+    pmix_server_globals.iof_spill = false;
+    (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "iof_spill",
+                                      "Put the cached IOF data that does not fit in memory into "
+                                      "a file per nspace in the server's tmpdir, from which it is "
+                                      "replayed when a tool registers [default: false]",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_server_globals.iof_spill);
+
+    pmix_server_globals.max_iof_spill = 1024 * 1024 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "max", "iof_spill",
+                                      "Maximum number of bytes of the IOF spill file of an "
+                                      "nspace [default: 1GB]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_server_globals.max_iof_spill);
+
     (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "progress_thread_cpus",
                                       "Comma-delimited list of ranges of CPUs to which"
                                       "the internal PMIx progress thread is to be bound",
@@ -270,6 +687,43 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &pmix_bind_progress_thread_reqd);
 
+    (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "progress_thread_shift_depth",
+                                      "Number of requests from other threads that can be queued "
+                                      "for a progress thread without taking a lock - any more "
+                                      "wait on a locked overflow list (rounded up to a power of "
+                                      "two, 0 => always use the event library)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_progress_thread_shift_depth);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "progress_thread_busy_poll",
+                                      "Number of microseconds a bound progress thread keeps "
+                                      "polling for more work after each wakeup before it blocks "
+                                      "again - for servers given a core of their own (0 => "
+                                      "always block)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_progress_thread_busy_poll);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "progress_thread_profile",
+                                      "Whether to profile the progress threads - sample the lag "
+                                      "of each event loop and time the callbacks run from each "
+                                      "thread-shift site - for PMIX_QUERY_PROGRESS_LAG and "
+                                      "PMIX_QUERY_PROGRESS_PROFILE",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_progress_thread_profile);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "progress_thread_lag_interval",
+                                      "Number of milliseconds between samples of the event-loop "
+                                      "lag of each progress thread when profiling (0 => don't "
+                                      "sample)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_progress_thread_lag_interval);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "memory_accounting",
+                                      "Whether to count the objects of each class that are "
+                                      "alive, for PMIX_QUERY_OBJECT_USAGE",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_class_accounting);
+
     (void) pmix_mca_base_var_register("pmix", "pmix", NULL, "maxfd",
                                       "In non-Linux environments, use this value as a maximum number of file descriptors to close when forking a new child process",
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
@@ -18,9 +18,22 @@
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
+#include <errno.h>
 #include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <event.h>
+#ifdef HAVE_FCNTL_H
+#    include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_EVENTFD_H
+#    include <sys/eventfd.h>
+#endif
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
 
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
@@ -30,6 +43,27 @@
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_fd.h"
 
+#if !PMIX_HAVE_LIBEV
+/* Events shifted into a progress thread from other threads are
+ * pushed onto a bounded ring that any number of threads can fill
+ * without locks (a Vyukov-style queue, drained by the progress
+ * thread alone). Each cell's sequence number tells a producer when
+ * the slot is free and the consumer when it has been filled */
+typedef struct {
+    size_t seq;
+    pmix_event_t *ev;
+} pmix_shift_cell_t;
+
+/* Events that arrive while the ring is full wait on a locked list
+ * instead, and keep doing so until the progress thread has moved
+ * that list over - a thread's requests must not overtake the ones
+ * it queued before them */
+typedef struct pmix_shift_spill_t {
+    struct pmix_shift_spill_t *next;
+    pmix_event_t *ev;
+} pmix_shift_spill_t;
+#endif
+
 /* create a tracking object for progress threads */
 typedef struct {
     pmix_list_item_t super;
@@ -48,11 +82,36 @@ typedef struct {
     pmix_event_t block;
     bool engine_constructed;
     pmix_thread_t engine;
+
+    /* usecs to keep polling after each wakeup - only set once the
+       thread has been bound */
+    int busy_poll;
+
+    /* event-loop lag, sampled by a periodic timer when profiling */
+    pmix_event_t lag_ev;
+    bool lag_ev_added;
+    uint64_t lag_due;
+    uint64_t lag_samples;
+    uint64_t lag_total;
+    uint64_t lag_max;
 #if PMIX_HAVE_LIBEV
     ev_async async;
     pthread_mutex_t mutex;
     pthread_cond_t cond;
     pmix_list_t list;
+#else
+    pmix_shift_cell_t *shift_ring;
+    size_t shift_mask;
+    size_t shift_head;   // only touched by the progress thread
+    size_t shift_tail;   // claimed atomically by producers
+    int shift_pending;   // set once a wakeup has been signalled
+    int shift_fd[2];     // read/write ends of the wakeup descriptor
+    pmix_event_t shift_ev;
+    bool shift_ev_added;
+    pthread_mutex_t spill_lock;
+    pmix_shift_spill_t *spill_head;
+    pmix_shift_spill_t *spill_tail;
+    int spilling;        // set while the spill list is in use
 #endif
 } pmix_progress_tracker_t;
 
@@ -63,15 +122,60 @@ static void tracker_constructor(pmix_progress_tracker_t *p)
     p->ev_base = NULL;
     p->ev_active = false;
     p->engine_constructed = false;
+    p->busy_poll = 0;
+    p->lag_ev_added = false;
+    p->lag_due = 0;
+    p->lag_samples = 0;
+    p->lag_total = 0;
+    p->lag_max = 0;
 #if PMIX_HAVE_LIBEV
     pthread_mutex_init(&p->mutex, NULL);
     PMIX_CONSTRUCT(&p->list, pmix_list_t);
+#else
+    p->shift_ring = NULL;
+    p->shift_mask = 0;
+    p->shift_head = 0;
+    p->shift_tail = 0;
+    p->shift_pending = 0;
+    p->shift_fd[0] = -1;
+    p->shift_fd[1] = -1;
+    p->shift_ev_added = false;
+    pthread_mutex_init(&p->spill_lock, NULL);
+    p->spill_head = NULL;
+    p->spill_tail = NULL;
+    p->spilling = 0;
 #endif
 }
 
 static void tracker_destructor(pmix_progress_tracker_t *p)
 {
+#if !PMIX_HAVE_LIBEV
+    pmix_shift_spill_t *spill;
+#endif
+
     pmix_event_del(&p->block);
+    if (p->lag_ev_added) {
+        pmix_event_del(&p->lag_ev);
+    }
+#if !PMIX_HAVE_LIBEV
+    if (p->shift_ev_added) {
+        pmix_event_del(&p->shift_ev);
+    }
+    if (0 <= p->shift_fd[0]) {
+        close(p->shift_fd[0]);
+    }
+    if (0 <= p->shift_fd[1] && p->shift_fd[1] != p->shift_fd[0]) {
+        close(p->shift_fd[1]);
+    }
+    if (NULL != p->shift_ring) {
+        free(p->shift_ring);
+    }
+    while (NULL != (spill = p->spill_head)) {
+        p->spill_head = spill->next;
+        free(spill);
+    }
+    pthread_mutex_destroy(&p->spill_lock);
+#endif
 
     if (NULL != p->name) {
         free(p->name);
@@ -98,6 +202,193 @@ static struct timeval long_timeout = {.tv_sec = 3600, .tv_usec = 0};
 static const char *shared_thread_name = "PMIX-wide async progress thread";
 static pmix_progress_tracker_t *shared_thread_tracker = NULL;
 
+/* call sites that have been profiled - only ever pushed onto */
+static pmix_progress_site_t *profile_sites = NULL;
+
+typedef struct {
+    pmix_progress_site_t *site;
+    void *cbdata;
+} pmix_progress_call_t;
+
+static uint64_t profile_nsec(void)
+{
+#if defined(__linux__) && PMIX_HAVE_CLOCK_GETTIME
+    struct timespec tp;
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (uint64_t) tp.tv_sec * 1000000000 + (uint64_t) tp.tv_nsec;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t) tv.tv_sec * 1000000000 + (uint64_t) tv.tv_usec * 1000;
+#endif
+}
+
+static void profile_max(uint64_t *max, uint64_t val)
+{
+    uint64_t cur = __atomic_load_n(max, __ATOMIC_RELAXED);
+
+    while (cur < val
+           && !__atomic_compare_exchange_n(max, &cur, val, true, __ATOMIC_RELAXED,
+                                           __ATOMIC_RELAXED)) {
+    }
+}
+
+static void lag_schedule(pmix_progress_tracker_t *trk, uint64_t now)
+{
+    struct timeval tv;
+
+    tv.tv_sec = pmix_progress_thread_lag_interval / 1000;
+    tv.tv_usec = (pmix_progress_thread_lag_interval % 1000) * 1000;
+    trk->lag_due = now + (uint64_t) pmix_progress_thread_lag_interval * 1000000;
+    pmix_event_evtimer_add(&trk->lag_ev, &tv);
+}
+
+/* a timer that is due every interval - however late it fires is
+ * how long the loop was held up by the events ahead of it */
+static void lag_sample(int fd, short args, void *cbdata)
+{
+    pmix_progress_tracker_t *trk = (pmix_progress_tracker_t *) cbdata;
+    uint64_t now, lag;
+    PMIX_HIDE_UNUSED_PARAMS(fd, args);
+
+    now = profile_nsec();
+    lag = (now > trk->lag_due) ? (now - trk->lag_due) / 1000 : 0;
+    __atomic_add_fetch(&trk->lag_samples, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&trk->lag_total, lag, __ATOMIC_RELAXED);
+    profile_max(&trk->lag_max, lag);
+    lag_schedule(trk, now);
+}
+
+static void profiled_cb(int fd, short args, void *cbdata)
+{
+    pmix_progress_call_t *call = (pmix_progress_call_t *) cbdata;
+    pmix_progress_site_t *site = call->site;
+    void *arg = call->cbdata;
+    uint64_t start, elapsed;
+
+    /* the callback may well reuse or release the event */
+    free(call);
+    start = profile_nsec();
+    site->cbfunc(fd, args, arg);
+    elapsed = profile_nsec() - start;
+    __atomic_add_fetch(&site->count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&site->nsec, elapsed, __ATOMIC_RELAXED);
+    profile_max(&site->max_nsec, elapsed);
+}
+
+void pmix_progress_thread_shift_profiled(pmix_progress_site_t *site, pmix_event_t *ev,
+                                         void *cbdata)
+{
+    pmix_progress_call_t *call;
+    int expected = 0;
+
+    call = (pmix_progress_call_t *) malloc(sizeof(pmix_progress_call_t));
+    if (NULL == call) {
+        /* run it unprofiled */
+        pmix_event_assign(ev, pmix_globals.evbase, -1, EV_WRITE, site->cbfunc, cbdata);
+        pmix_progress_thread_shift(ev);
+        return;
+    }
+    if (__atomic_compare_exchange_n(&site->registered, &expected, 1, false, __ATOMIC_SEQ_CST,
+                                    __ATOMIC_SEQ_CST)) {
+        site->next = __atomic_load_n(&profile_sites, __ATOMIC_ACQUIRE);
+        while (!__atomic_compare_exchange_n(&profile_sites, &site->next, site, true,
+                                            __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+        }
+    }
+    call->site = site;
+    call->cbdata = cbdata;
+    pmix_event_assign(ev, pmix_globals.evbase, -1, EV_WRITE, profiled_cb, call);
+    pmix_progress_thread_shift(ev);
+}
+
+pmix_data_array_t *pmix_progress_thread_lag_report(void)
+{
+    pmix_progress_tracker_t *trk;
+    pmix_data_array_t *darray, *vals;
+    pmix_info_t *iptr;
+    uint64_t *u64;
+    size_t n;
+
+    if (!inited) {
+        return NULL;
+    }
+    n = 0;
+    PMIX_LIST_FOREACH (trk, &tracking, pmix_progress_tracker_t) {
+        if (trk->lag_ev_added) {
+            ++n;
+        }
+    }
+    if (0 == n) {
+        return NULL;
+    }
+    PMIX_DATA_ARRAY_CREATE(darray, n, PMIX_INFO);
+    iptr = (pmix_info_t *) darray->array;
+    n = 0;
+    PMIX_LIST_FOREACH (trk, &tracking, pmix_progress_tracker_t) {
+        if (!trk->lag_ev_added) {
+            continue;
+        }
+        PMIX_DATA_ARRAY_CREATE(vals, 3, PMIX_UINT64);
+        u64 = (uint64_t *) vals->array;
+        u64[0] = __atomic_load_n(&trk->lag_samples, __ATOMIC_RELAXED);
+        u64[1] = __atomic_load_n(&trk->lag_total, __ATOMIC_RELAXED);
+        u64[2] = __atomic_load_n(&trk->lag_max, __ATOMIC_RELAXED);
+        PMIX_LOAD_KEY(iptr[n].key, trk->name);
+        iptr[n].value.type = PMIX_DATA_ARRAY;
+        iptr[n].value.data.darray = vals;
+        ++n;
+    }
+    return darray;
+}
+
+pmix_data_array_t *pmix_progress_thread_profile_report(void)
+{
+    pmix_progress_site_t *site, *head;
+    pmix_data_array_t *darray, *vals;
+    pmix_info_t *iptr;
+    uint64_t *u64;
+    const char *file;
+    char *key;
+    size_t n;
+
+    head = __atomic_load_n(&profile_sites, __ATOMIC_ACQUIRE);
+    n = 0;
+    for (site = head; NULL != site; site = site->next) {
+        if (0 < __atomic_load_n(&site->count, __ATOMIC_RELAXED)) {
+            ++n;
+        }
+    }
+    if (0 == n) {
+        return NULL;
+    }
+    PMIX_DATA_ARRAY_CREATE(darray, n, PMIX_INFO);
+    iptr = (pmix_info_t *) darray->array;
+    n = 0;
+    for (site = head; NULL != site && n < darray->size; site = site->next) {
+        if (0 == __atomic_load_n(&site->count, __ATOMIC_RELAXED)) {
+            continue;
+        }
+        file = strrchr(site->file, '/');
+        file = (NULL == file) ? site->file : file + 1;
+        if (0 > asprintf(&key, "%s@%s:%d", site->name, file, site->line)) {
+            continue;
+        }
+        PMIX_DATA_ARRAY_CREATE(vals, 3, PMIX_UINT64);
+        u64 = (uint64_t *) vals->array;
+        u64[0] = __atomic_load_n(&site->count, __ATOMIC_RELAXED);
+        u64[1] = __atomic_load_n(&site->nsec, __ATOMIC_RELAXED);
+        u64[2] = __atomic_load_n(&site->max_nsec, __ATOMIC_RELAXED);
+        PMIX_LOAD_KEY(iptr[n].key, key);
+        free(key);
+        iptr[n].value.type = PMIX_DATA_ARRAY;
+        iptr[n].value.data.darray = vals;
+        ++n;
+    }
+    darray->size = n;
+    return darray;
+}
+
 #if PMIX_HAVE_LIBEV
 
 typedef enum { PMIX_EVENT_ACTIVE, PMIX_EVENT_ADD, PMIX_EVENT_DEL } pmix_event_type_t;
@@ -204,6 +495,210 @@ void pmix_event_base_loopexit(pmix_event_base_t *ev_base)
 }
 #endif
 
+#if !PMIX_HAVE_LIBEV
+static void shift_wakeup(pmix_progress_tracker_t *trk)
+{
+#    ifdef HAVE_SYS_EVENTFD_H
+    uint64_t one = 1;
+#    else
+    char one = 1;
+#    endif
+    ssize_t rc;
+
+    /* only the first producer after a drain needs to wake the thread */
+    if (0 == __atomic_exchange_n(&trk->shift_pending, 1, __ATOMIC_SEQ_CST)) {
+        do {
+            rc = write(trk->shift_fd[1], &one, sizeof(one));
+        } while (rc < 0 && EINTR == errno);
+    }
+}
+
+static bool shift_push(pmix_progress_tracker_t *trk, pmix_event_t *ev)
+{
+    pmix_shift_cell_t *cell;
+    size_t pos, seq;
+    intptr_t diff;
+
+    pos = __atomic_load_n(&trk->shift_tail, __ATOMIC_RELAXED);
+    for (;;) {
+        cell = &trk->shift_ring[pos & trk->shift_mask];
+        seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        diff = (intptr_t) seq - (intptr_t) pos;
+        if (0 == diff) {
+            if (__atomic_compare_exchange_n(&trk->shift_tail, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* the ring is full */
+            return false;
+        } else {
+            pos = __atomic_load_n(&trk->shift_tail, __ATOMIC_RELAXED);
+        }
+    }
+    cell->ev = ev;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+
+    shift_wakeup(trk);
+    return true;
+}
+
+static bool shift_spill(pmix_progress_tracker_t *trk, pmix_event_t *ev)
+{
+    pmix_shift_spill_t *spill;
+
+    spill = (pmix_shift_spill_t *) malloc(sizeof(pmix_shift_spill_t));
+    if (NULL == spill) {
+        return false;
+    }
+    spill->next = NULL;
+    spill->ev = ev;
+    pthread_mutex_lock(&trk->spill_lock);
+    if (NULL == trk->spill_tail) {
+        trk->spill_head = spill;
+    } else {
+        trk->spill_tail->next = spill;
+    }
+    trk->spill_tail = spill;
+    __atomic_store_n(&trk->spilling, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&trk->spill_lock);
+
+    shift_wakeup(trk);
+    return true;
+}
+
+static pmix_event_t *shift_pop(pmix_progress_tracker_t *trk)
+{
+    pmix_shift_cell_t *cell;
+    pmix_event_t *ev;
+
+    cell = &trk->shift_ring[trk->shift_head & trk->shift_mask];
+    if (__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) != trk->shift_head + 1) {
+        /* empty, or the producer hasn't finished filling the cell */
+        return NULL;
+    }
+    ev = cell->ev;
+    __atomic_store_n(&cell->seq, trk->shift_head + trk->shift_mask + 1, __ATOMIC_RELEASE);
+    ++trk->shift_head;
+    return ev;
+}
+
+static void shift_drain(int fd, short args, void *cbdata)
+{
+    pmix_progress_tracker_t *trk = (pmix_progress_tracker_t *) cbdata;
+    pmix_shift_spill_t *spill, *next;
+    pmix_event_t *ev;
+    char buf[64];
+    size_t n;
+    PMIX_HIDE_UNUSED_PARAMS(args);
+
+    /* consume the wakeup, then reopen the door for the next one
+     * before looking at the ring so nothing pushed from here on
+     * can be missed */
+    while (0 < read(fd, buf, sizeof(buf))) {
+        continue;
+    }
+    __atomic_store_n(&trk->shift_pending, 0, __ATOMIC_SEQ_CST);
+
+    /* run at most one ring's worth per pass so that a steady
+     * stream of requests cannot starve the other events */
+    for (n = 0; n <= trk->shift_mask; n++) {
+        if (NULL == (ev = shift_pop(trk))) {
+            break;
+        }
+        event_get_callback(ev)(-1, EV_WRITE, event_get_callback_arg(ev));
+    }
+    if (n <= trk->shift_mask) {
+        /* the ring is empty, so anything that spilled over is next
+         * in line - take the whole list and let producers go back to
+         * the ring, which we won't look at again until these are done */
+        if (0 == __atomic_load_n(&trk->spilling, __ATOMIC_SEQ_CST)) {
+            return;
+        }
+        pthread_mutex_lock(&trk->spill_lock);
+        spill = trk->spill_head;
+        trk->spill_head = NULL;
+        trk->spill_tail = NULL;
+        __atomic_store_n(&trk->spilling, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&trk->spill_lock);
+        while (NULL != spill) {
+            next = spill->next;
+            ev = spill->ev;
+            free(spill);
+            event_get_callback(ev)(-1, EV_WRITE, event_get_callback_arg(ev));
+            spill = next;
+        }
+        return;
+    }
+    pmix_event_active(&trk->shift_ev, EV_READ, 1);
+}
+
+static void shift_setup(pmix_progress_tracker_t *trk)
+{
+    size_t n, depth;
+
+    if (0 >= pmix_progress_thread_shift_depth) {
+        return;
+    }
+    for (depth = 1; depth < (size_t) pmix_progress_thread_shift_depth; depth <<= 1) {
+        continue;
+    }
+
+#    ifdef HAVE_SYS_EVENTFD_H
+    trk->shift_fd[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (0 > trk->shift_fd[0]) {
+        return;
+    }
+    trk->shift_fd[1] = trk->shift_fd[0];
+#    else
+    if (0 != pipe(trk->shift_fd)) {
+        trk->shift_fd[0] = -1;
+        trk->shift_fd[1] = -1;
+        return;
+    }
+    for (n = 0; n < 2; n++) {
+        (void) pmix_fd_set_cloexec(trk->shift_fd[n]);
+        (void) fcntl(trk->shift_fd[n], F_SETFL, fcntl(trk->shift_fd[n], F_GETFL) | O_NONBLOCK);
+    }
+#    endif
+
+    trk->shift_ring = (pmix_shift_cell_t *) malloc(depth * sizeof(pmix_shift_cell_t));
+    if (NULL == trk->shift_ring) {
+        return;
+    }
+    for (n = 0; n < depth; n++) {
+        trk->shift_ring[n].seq = n;
+        trk->shift_ring[n].ev = NULL;
+    }
+    trk->shift_mask = depth - 1;
+
+    pmix_event_assign(&trk->shift_ev, trk->ev_base, trk->shift_fd[0], EV_READ | EV_PERSIST,
+                      shift_drain, trk);
+    pmix_event_add(&trk->shift_ev, NULL);
+    trk->shift_ev_added = true;
+}
+#endif
+
+void pmix_progress_thread_shift(pmix_event_t *ev)
+{
+#if !PMIX_HAVE_LIBEV
+    pmix_progress_tracker_t *trk = shared_thread_tracker;
+
+    if (NULL != trk && NULL != trk->shift_ring && trk->ev_active &&
+        event_get_base(ev) == trk->ev_base &&
+        !pthread_equal(pthread_self(), trk->engine.t_handle)) {
+        /* once something has spilled, everything after it must too */
+        if (0 == __atomic_load_n(&trk->spilling, __ATOMIC_SEQ_CST) && shift_push(trk, ev)) {
+            return;
+        }
+        if (shift_spill(trk, ev)) {
+            return;
+        }
+    }
+#endif
+    pmix_event_active(ev, EV_WRITE, 1);
+}
+
 /*
  * If this event is fired, just restart it so that this event base
  * continues to have something to block on.
@@ -223,9 +718,23 @@ static void *progress_engine(pmix_object_t *obj)
 {
     pmix_thread_t *t = (pmix_thread_t *) obj;
     pmix_progress_tracker_t *trk = (pmix_progress_tracker_t *) t->t_arg;
+    struct timeval start, now;
+    long elapsed;
 
     while (trk->ev_active) {
         pmix_event_loop(trk->ev_base, PMIX_EVLOOP_ONCE);
+        if (0 >= trk->busy_poll) {
+            continue;
+        }
+        /* we have a core to ourselves - replies to the request we
+         * just handled are likely to follow soon, so keep polling
+         * rather than pay for another wakeup */
+        gettimeofday(&start, NULL);
+        do {
+            pmix_event_loop(trk->ev_base, PMIX_EVLOOP_NONBLOCK);
+            gettimeofday(&now, NULL);
+            elapsed = (now.tv_sec - start.tv_sec) * 1000000L + (now.tv_usec - start.tv_usec);
+        } while (trk->ev_active && elapsed < trk->busy_poll);
     }
 
     return PMIX_THREAD_CANCELLED;
@@ -278,12 +787,12 @@ static int start_progress_engine(pmix_progress_tracker_t *trk)
         for (n=0; NULL != ranges[n]; n++) {
             // look for '-'
             start = strtoul(ranges[n], &dash, 10);
-            if (NULL == dash) {
+            if ('-' != *dash) {
                 CPU_SET(start, &cpuset);
             } else {
                 ++dash;  // skip over the '-'
                 end = strtoul(dash, NULL, 10);
-                for (k=start; k < end; k++) {
+                for (k=start; k <= end; k++) {
                     CPU_SET(k, &cpuset);
                 }
             }
@@ -294,6 +803,10 @@ static int start_progress_engine(pmix_progress_tracker_t *trk)
                         (NULL == trk->name) ? "NULL" : trk->name);
             rc = PMIX_ERR_NOT_SUPPORTED;
         } else {
+            if (0 == rc) {
+                /* only spin on cores that were given to us */
+                trk->busy_poll = pmix_progress_thread_busy_poll;
+            }
             rc = PMIX_SUCCESS;
         }
         pmix_argv_free(ranges);
@@ -349,9 +862,17 @@ pmix_event_base_t *pmix_progress_thread_init(const char *name)
     pmix_event_assign(&trk->block, trk->ev_base, -1, PMIX_EV_PERSIST, dummy_timeout_cb, trk);
     pmix_event_add(&trk->block, &long_timeout);
 
+    if (pmix_progress_thread_profile && 0 < pmix_progress_thread_lag_interval) {
+        pmix_event_evtimer_set(trk->ev_base, &trk->lag_ev, lag_sample, trk);
+        lag_schedule(trk, profile_nsec());
+        trk->lag_ev_added = true;
+    }
+
 #if PMIX_HAVE_LIBEV
     ev_async_init(&trk->async, pmix_libev_ev_async_cb);
     ev_async_start((struct ev_loop *) trk->ev_base, &trk->async);
+#else
+    shift_setup(trk);
 #endif
 
     /* construct the thread object */
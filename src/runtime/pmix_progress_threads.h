@@ -84,4 +84,71 @@ PMIX_EXPORT pmix_status_t pmix_progress_thread_pause(const char *name);
  */
 PMIX_EXPORT pmix_status_t pmix_progress_thread_resume(const char *name);
 
+/**
+ * Activate an event (assigned with fd -1 and EV_WRITE) on the event
+ * base of the shared progress thread. When called from any other
+ * thread, the event is pushed onto a lock-free queue owned by the
+ * progress thread, which is woken only when the queue goes from
+ * empty to busy and then drains every queued event in one pass.
+ * If the queue is full, events wait on a locked overflow list, so
+ * the events shifted by any one thread still run in the order they
+ * were shifted. Calls made from the progress thread itself, or while
+ * it isn't running, activate the event directly.
+ */
+PMIX_EXPORT void pmix_progress_thread_shift(pmix_event_t *ev);
+
+/**
+ * Profiling of the progress threads, enabled by the
+ * pmix_progress_thread_profile MCA param. Each progress thread
+ * then samples its own event-loop lag - how late a periodic timer
+ * fires against when it was due - and every PMIX_THREADSHIFT call
+ * site accumulates the number of times its callback ran and the
+ * time spent in it. Call sites are described by a static site
+ * object that is added to a global list the first time it is used.
+ */
+typedef struct pmix_progress_site_t {
+    struct pmix_progress_site_t *next;
+    event_callback_fn cbfunc;
+    const char *name;
+    const char *file;
+    int line;
+    int registered;
+    uint64_t count;
+    uint64_t nsec;
+    uint64_t max_nsec;
+} pmix_progress_site_t;
+
+#define PMIX_PROGRESS_SITE_STATIC_INIT(c)                                          \
+    {                                                                              \
+        .next = NULL, .cbfunc = (event_callback_fn)(c), .name = #c,                \
+        .file = __FILE__, .line = __LINE__, .registered = 0, .count = 0, .nsec = 0, \
+        .max_nsec = 0                                                              \
+    }
+
+PMIX_EXPORT extern bool pmix_progress_thread_profile;
+
+/**
+ * Activate an event the way pmix_progress_thread_shift() does, but
+ * run its callback through a wrapper that charges the time it takes
+ * to the given call site. The event is assigned here.
+ */
+PMIX_EXPORT void pmix_progress_thread_shift_profiled(pmix_progress_site_t *site,
+                                                     pmix_event_t *ev, void *cbdata);
+
+/**
+ * Report the event-loop lag of each progress thread as an array of
+ * pmix_info_t keyed by thread name, each holding an array of
+ * PMIX_UINT64: the number of samples, the total lag and the largest
+ * lag in microseconds. Returns NULL if nothing has been sampled.
+ */
+PMIX_EXPORT pmix_data_array_t *pmix_progress_thread_lag_report(void);
+
+/**
+ * Report the profile of each call site that has run as an array of
+ * pmix_info_t keyed by "function@file:line", each holding an array
+ * of PMIX_UINT64: the number of calls, the total time and the
+ * longest call in nanoseconds. Returns NULL if nothing has run.
+ */
+PMIX_EXPORT pmix_data_array_t *pmix_progress_thread_profile_report(void);
+
 #endif
@@ -44,12 +44,16 @@ PMIX_EXPORT extern char *pmix_timing_sync_file;
 PMIX_EXPORT extern char *pmix_timing_output;
 PMIX_EXPORT extern bool pmix_timing_overhead;
 #endif
+PMIX_EXPORT extern bool pmix_timing_startup;
 
 PMIX_EXPORT extern char *pmix_net_private_ipv4;
 PMIX_EXPORT extern int pmix_event_caching_window;
 PMIX_EXPORT extern bool pmix_suppress_missing_data_warning;
 PMIX_EXPORT extern char *pmix_progress_thread_cpus;
 PMIX_EXPORT extern bool pmix_bind_progress_thread_reqd;
+PMIX_EXPORT extern int pmix_progress_thread_shift_depth;
+PMIX_EXPORT extern int pmix_progress_thread_busy_poll;
+PMIX_EXPORT extern int pmix_progress_thread_lag_interval;
 PMIX_EXPORT extern int pmix_maxfd;
 
 /** version string of pmix */
@@ -71,6 +75,14 @@ PMIX_EXPORT pmix_status_t pmix_rte_init(uint32_t type, pmix_info_t info[], size_
  */
 PMIX_EXPORT void pmix_rte_finalize(void);
 
+/**
+ * Open and select the plog and pstrg frameworks if they are
+ * not already open. Clients defer these until first use - must
+ * be called from within the progress thread.
+ */
+PMIX_EXPORT pmix_status_t pmix_rte_open_plog(void);
+PMIX_EXPORT pmix_status_t pmix_rte_open_pstrg(void);
+
 /**
  * Internal function.  Do not call.
  */
@@ -0,0 +1,281 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <time.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/runtime/pmix_timer.h"
+
+/* The wheel has three levels of 256 slots. Level 0 holds the timers
+ * due within the next 256 ticks, one slot per tick. Each slot of
+ * level 1 covers 256 ticks and each slot of level 2 covers 65536
+ * ticks - whenever level 0 wraps, the next slot of level 1 is
+ * redistributed onto level 0, and likewise for level 2 onto level 1.
+ * Timers further out than level 2 reaches are parked in its last
+ * slot and redistributed again when it comes up. The event is only
+ * set for the next tick that has a timer due, or for the next time
+ * level 0 wraps, so an idle wheel does not wake up every tick */
+
+#define PMIX_TIMER_LEVELS 3
+#define PMIX_TIMER_BITS   8
+#define PMIX_TIMER_SLOTS  (1 << PMIX_TIMER_BITS)
+#define PMIX_TIMER_MASK   (PMIX_TIMER_SLOTS - 1)
+
+static struct {
+    bool initialized;
+    pmix_event_t ev;
+    bool ev_active;
+    /* the last tick that was processed */
+    uint64_t now;
+    /* number of pending timers */
+    size_t count;
+    /* each slot is the head of a circular list */
+    pmix_timer_t slots[PMIX_TIMER_LEVELS][PMIX_TIMER_SLOTS];
+} wheel = {
+    .initialized = false,
+    .ev_active = false,
+    .now = 0,
+    .count = 0
+};
+
+static uint64_t current_tick(void)
+{
+#if defined(__linux__) && PMIX_HAVE_CLOCK_GETTIME
+    struct timespec tp;
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return ((uint64_t) tp.tv_sec * 1000000 + (uint64_t) tp.tv_nsec / 1000) / PMIX_TIMER_TICK_USEC;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return ((uint64_t) tv.tv_sec * 1000000 + (uint64_t) tv.tv_usec) / PMIX_TIMER_TICK_USEC;
+#endif
+}
+
+static inline void link_timer(pmix_timer_t *head, pmix_timer_t *t)
+{
+    t->next = head;
+    t->prev = head->prev;
+    head->prev->next = t;
+    head->prev = t;
+}
+
+static inline void unlink_timer(pmix_timer_t *t)
+{
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    t->next = NULL;
+    t->prev = NULL;
+}
+
+static void place(pmix_timer_t *t)
+{
+    uint64_t exp = t->expires;
+    uint64_t now = wheel.now;
+    int level, shift;
+
+    for (level = 0; level < PMIX_TIMER_LEVELS; level++) {
+        shift = level * PMIX_TIMER_BITS;
+        if ((exp >> shift) - (now >> shift) < PMIX_TIMER_SLOTS) {
+            link_timer(&wheel.slots[level][(exp >> shift) & PMIX_TIMER_MASK], t);
+            return;
+        }
+    }
+    /* beyond the reach of the wheel */
+    shift = (PMIX_TIMER_LEVELS - 1) * PMIX_TIMER_BITS;
+    link_timer(&wheel.slots[PMIX_TIMER_LEVELS - 1]
+                           [((now >> shift) + PMIX_TIMER_MASK) & PMIX_TIMER_MASK], t);
+}
+
+static void cascade(int level, int slot)
+{
+    pmix_timer_t *head = &wheel.slots[level][slot];
+    pmix_timer_t tmp, *t;
+
+    if (head->next == head) {
+        return;
+    }
+    /* move the list aside, as its timers may come back to it */
+    tmp.next = head->next;
+    tmp.prev = head->prev;
+    tmp.next->prev = &tmp;
+    tmp.prev->next = &tmp;
+    head->next = head;
+    head->prev = head;
+
+    while (tmp.next != &tmp) {
+        t = tmp.next;
+        unlink_timer(t);
+        place(t);
+    }
+}
+
+static void advance(uint64_t target)
+{
+    pmix_timer_t *head, *t;
+
+    if (0 == wheel.count) {
+        if (wheel.now < target) {
+            wheel.now = target;
+        }
+        return;
+    }
+    while (wheel.now < target) {
+        wheel.now++;
+        if (0 == (wheel.now & PMIX_TIMER_MASK)) {
+            if (0 == ((wheel.now >> PMIX_TIMER_BITS) & PMIX_TIMER_MASK)) {
+                cascade(2, (wheel.now >> (2 * PMIX_TIMER_BITS)) & PMIX_TIMER_MASK);
+            }
+            cascade(1, (wheel.now >> PMIX_TIMER_BITS) & PMIX_TIMER_MASK);
+        }
+        /* the callbacks may add and delete timers - including
+         * the ones still in this slot */
+        head = &wheel.slots[0][wheel.now & PMIX_TIMER_MASK];
+        while (head->next != head) {
+            t = head->next;
+            unlink_timer(t);
+            t->active = false;
+            --wheel.count;
+            t->cbfunc(-1, 0, t->cbdata);
+        }
+    }
+}
+
+static void schedule(void)
+{
+    struct timeval tv;
+    uint64_t next, tick, limit;
+
+    if (0 == wheel.count) {
+        if (wheel.ev_active) {
+            pmix_event_evtimer_del(&wheel.ev);
+            wheel.ev_active = false;
+        }
+        return;
+    }
+
+    /* the next tick with a timer due, up to the next wrap of level 0 */
+    limit = (wheel.now | PMIX_TIMER_MASK) + 1;
+    for (next = wheel.now + 1; next < limit; next++) {
+        if (wheel.slots[0][next & PMIX_TIMER_MASK].next
+            != &wheel.slots[0][next & PMIX_TIMER_MASK]) {
+            break;
+        }
+    }
+
+    tick = current_tick();
+    if (next <= tick) {
+        tv.tv_sec = 0;
+        tv.tv_usec = 0;
+    } else {
+        next = (next - tick) * PMIX_TIMER_TICK_USEC;
+        tv.tv_sec = next / 1000000;
+        tv.tv_usec = next % 1000000;
+    }
+    /* adding a pending event moves it to the new time */
+    pmix_event_evtimer_add(&wheel.ev, &tv);
+    wheel.ev_active = true;
+}
+
+static void tick_cb(int sd, short args, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    wheel.ev_active = false;
+    advance(current_tick());
+    schedule();
+}
+
+static void wheel_init(void)
+{
+    int level, slot;
+
+    for (level = 0; level < PMIX_TIMER_LEVELS; level++) {
+        for (slot = 0; slot < PMIX_TIMER_SLOTS; slot++) {
+            wheel.slots[level][slot].next = &wheel.slots[level][slot];
+            wheel.slots[level][slot].prev = &wheel.slots[level][slot];
+        }
+    }
+    wheel.now = current_tick();
+    wheel.count = 0;
+    pmix_event_evtimer_set(pmix_globals.evbase, &wheel.ev, tick_cb, NULL);
+    wheel.ev_active = false;
+    wheel.initialized = true;
+}
+
+void pmix_timer_add(pmix_timer_t *t, double secs, pmix_timer_cbfunc_t cbfunc, void *cbdata)
+{
+    uint64_t ticks;
+    bool earlier;
+
+    if (!wheel.initialized) {
+        wheel_init();
+    }
+    pmix_timer_del(t);
+
+    /* round up, and count from the end of the current tick, so
+     * the timer never fires early */
+    ticks = (uint64_t) (secs * 1000000.0 + PMIX_TIMER_TICK_USEC - 1) / PMIX_TIMER_TICK_USEC;
+    t->expires = current_tick() + ticks + 1;
+    t->cbfunc = cbfunc;
+    t->cbdata = cbdata;
+    t->active = true;
+    place(t);
+    ++wheel.count;
+
+    /* the event only needs to move if this is due before the
+     * tick it is set for - that is within the current rotation */
+    earlier = (t->expires <= (wheel.now | PMIX_TIMER_MASK));
+    if (!wheel.ev_active || earlier) {
+        schedule();
+    }
+}
+
+void pmix_timer_del(pmix_timer_t *t)
+{
+    if (!t->active) {
+        return;
+    }
+    unlink_timer(t);
+    t->active = false;
+    --wheel.count;
+    /* leave the event alone - if it fires with nothing due, it
+     * just moves on to the next timer */
+}
+
+void pmix_timer_finalize(void)
+{
+    pmix_timer_t *head, *t;
+    int level, slot;
+
+    if (!wheel.initialized) {
+        return;
+    }
+    if (wheel.ev_active) {
+        pmix_event_evtimer_del(&wheel.ev);
+        wheel.ev_active = false;
+    }
+    for (level = 0; level < PMIX_TIMER_LEVELS; level++) {
+        for (slot = 0; slot < PMIX_TIMER_SLOTS; slot++) {
+            head = &wheel.slots[level][slot];
+            while (head->next != head) {
+                t = head->next;
+                unlink_timer(t);
+                t->active = false;
+            }
+        }
+    }
+    wheel.count = 0;
+    wheel.initialized = false;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * Timeouts of PMIx-internal requests (fence, get, connect, group)
+ * are kept on a hierarchical timer wheel driven by a single event
+ * on the progress thread, so that thousands of outstanding requests
+ * do not each hold a libevent timer.
+ *
+ * The wheel has a resolution of PMIX_TIMER_TICK_USEC. A timer fires
+ * no earlier than requested and at most two ticks later. Timers may
+ * only be added and deleted from the progress thread, and their
+ * callbacks are executed there.
+ */
+
+#ifndef PMIX_TIMER_H
+#define PMIX_TIMER_H
+
+#include "src/include/pmix_config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+/* length of a tick of the wheel */
+#define PMIX_TIMER_TICK_USEC 10000
+
+/* same signature as an event callback, so existing timeout
+ * handlers can be used as is - they are called with (-1, 0, cbdata) */
+typedef void (*pmix_timer_cbfunc_t)(int sd, short args, void *cbdata);
+
+typedef struct pmix_timer_t {
+    struct pmix_timer_t *next;
+    struct pmix_timer_t *prev;
+    uint64_t expires;
+    pmix_timer_cbfunc_t cbfunc;
+    void *cbdata;
+    bool active;
+} pmix_timer_t;
+
+#define PMIX_TIMER_STATIC_INIT \
+    {                          \
+        .next = NULL,          \
+        .prev = NULL,          \
+        .expires = 0,          \
+        .cbfunc = NULL,        \
+        .cbdata = NULL,        \
+        .active = false        \
+    }
+
+/* setup a timer embedded in another object */
+static inline void pmix_timer_construct(pmix_timer_t *t)
+{
+    t->next = NULL;
+    t->prev = NULL;
+    t->expires = 0;
+    t->cbfunc = NULL;
+    t->cbdata = NULL;
+    t->active = false;
+}
+
+/**
+ * Arm the timer to execute cbfunc after the given number of
+ * seconds. A timer that is already pending is rescheduled.
+ */
+PMIX_EXPORT void pmix_timer_add(pmix_timer_t *t, double secs, pmix_timer_cbfunc_t cbfunc,
+                                void *cbdata);
+
+/**
+ * Cancel the timer if it is pending - safe to call if it is not
+ */
+PMIX_EXPORT void pmix_timer_del(pmix_timer_t *t);
+
+static inline bool pmix_timer_pending(pmix_timer_t *t)
+{
+    return t->active;
+}
+
+/**
+ * Stop the wheel. Timers still pending are dropped without
+ * executing their callbacks
+ */
+PMIX_EXPORT void pmix_timer_finalize(void);
+
+END_C_DECLS
+
+#endif /* PMIX_TIMER_H */
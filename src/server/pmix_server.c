@@ -51,6 +51,7 @@
 #include <sys/stat.h>
 
 #include "src/common/pmix_attributes.h"
+#include "src/common/pmix_modex_shmem.h"
 #include "src/hwloc/pmix_hwloc.h"
 #include "src/mca/base/pmix_base.h"
 #include "src/mca/base/pmix_mca_base_var.h"
@@ -63,6 +64,7 @@
 #include "src/mca/preg/preg.h"
 #include "src/mca/prm/base/base.h"
 #include "src/mca/psensor/base/base.h"
+#include "src/mca/pstat/base/base.h"
 #include "src/mca/pstrg/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/runtime/pmix_progress_threads.h"
@@ -75,6 +77,8 @@
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_timings.h"
+#include "src/util/pmix_trace.h"
 
 /* the server also needs access to client operations
  * as it can, and often does, behave as a client */
@@ -96,10 +100,41 @@ pmix_server_globals_t pmix_server_globals = {
     .iof_residuals = PMIX_LIST_STATIC_INIT,
     .psets = PMIX_LIST_STATIC_INIT,
     .max_iof_cache = 0,
+    .max_iof_cache_bytes = SIZE_MAX,
+    .iof_cache_bytes = 0,
+    .iof_spill = false,
+    .max_iof_spill = 0,
+    .iof_spills = PMIX_LIST_STATIC_INIT,
     .tool_connections_allowed = false,
     .tmpdir = NULL,
     .system_tmpdir = NULL,
     .fence_localonly_opt = false,
+    .fence_pipeline = false,
+    .fence_dedup = false,
+    .sched = true,
+    .sched_event_weight = 8,
+    .sched_bulk_weight = 2,
+    .sched_tool_limit = 128,
+    .shmem_modex = false,
+    .dmodex_aggregate_window = 0,
+    .dmodex_prefetch_window = 0,
+    .dmodex_prefetch_node = false,
+    .event_batch_window = 0,
+    .event_batch_max = 64,
+    .group_cid_block = 0,
+    .group_cid_next = 0,
+    .group_cid_left = 0,
+    .request_pool_max = 0,
+    .server_caddy_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .setup_caddy_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .shift_caddy_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .dmdx_request_pool = PMIX_OBJ_POOL_STATIC_INIT,
+    .cmd_stats = false,
+    .locality_matrix_max = 0,
+    .register_slice = 0,
+    .inventory_parallel = false,
+    .inventory_cache_lifetime = 0,
+    .snapshot = NULL,
     .get_output = -1,
     .get_verbose = 0,
     .connect_output = -1,
@@ -125,6 +160,9 @@ static char *bfrops_mode = NULL;
 static char *gds_mode = NULL;
 static pid_t mypid;
 static pmix_proc_t myparent;
+/* event that purges the clients that finalized in a pass of the loop */
+static pmix_event_t purge_ev;
+static bool purge_ev_active = false;
 
 static void pdiedfn(int fd, short flags, void *arg)
 {
@@ -150,7 +188,7 @@ static void server_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
     pmix_peer_t *peer = (pmix_peer_t *) pr;
     pmix_proc_t source;
     pmix_iof_channel_t channel;
-    pmix_byte_object_t bo;
+    pmix_byte_object_t bo, raw, *data;
     int32_t cnt;
     pmix_status_t rc;
     size_t refid, ninfo = 0;
@@ -169,6 +207,7 @@ static void server_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
         return;
     }
     PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&raw);
 
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &source, &cnt, PMIX_PROC);
@@ -209,19 +248,27 @@ static void server_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
         PMIX_ERROR_LOG(rc);
         goto cleanup;
     }
+    /* expand the data if the server compressed it */
+    rc = pmix_iof_decompress(&channel, &bo, &raw);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    data = (NULL == raw.bytes) ? &bo : &raw;
     /* lookup the handler for this IOF package */
     req = (pmix_iof_req_t *) pmix_pointer_array_get_item(&pmix_globals.iof_requests, refid);
     if (NULL != req && NULL != req->cbfunc) {
-        req->cbfunc(refid, channel, &source, &bo, info, ninfo);
+        req->cbfunc(refid, channel, &source, data, info, ninfo);
     } else {
         /* otherwise, simply write it out to the specified std IO channel */
-        if (NULL != bo.bytes && 0 < bo.size) {
-            pmix_iof_write_output(&source, channel, &bo);
+        if (NULL != data->bytes && 0 < data->size) {
+            pmix_iof_write_output(&source, channel, data);
         }
     }
 
 cleanup:
     /* cleanup the memory */
+    PMIX_BYTE_OBJECT_DESTRUCT(&raw);
     if (0 < ninfo) {
         PMIX_INFO_FREE(info, ninfo);
     }
@@ -405,14 +452,40 @@ pmix_status_t pmix_server_initialize(void)
     pmix_pointer_array_init(&pmix_server_globals.clients, 1, INT_MAX, 1);
     PMIX_CONSTRUCT(&pmix_server_globals.nspaces, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.collectives, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.trackers, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.trackers, 64);
     PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.gdata, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.events, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.event_codes, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.event_codes, 64);
     PMIX_CONSTRUCT(&pmix_server_globals.groups, pmix_list_t);
+    pmix_server_dmdx_init();
+    pmix_server_pubsub_init();
+    pmix_server_query_init();
+    pmix_server_sched_init();
+    PMIX_CONSTRUCT(&pmix_server_globals.group_ids, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.group_ids, 64);
     PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.iof_spills, pmix_list_t);
+    pmix_server_globals.iof_cache_bytes = 0;
     PMIX_CONSTRUCT(&pmix_server_globals.iof_residuals, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.psets, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.pset_names, pmix_hash_table_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.fabric_cache, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.finalizing, pmix_list_t);
+    /* hold the storage of the objects created for each inbound
+     * request so it can be reused by the ones that follow */
+    PMIX_OBJ_POOL_INIT(&pmix_server_globals.server_caddy_pool, pmix_server_caddy_t,
+                       pmix_server_globals.request_pool_max);
+    PMIX_OBJ_POOL_INIT(&pmix_server_globals.setup_caddy_pool, pmix_setup_caddy_t,
+                       pmix_server_globals.request_pool_max);
+    PMIX_OBJ_POOL_INIT(&pmix_server_globals.shift_caddy_pool, pmix_shift_caddy_t,
+                       pmix_server_globals.request_pool_max);
+    PMIX_OBJ_POOL_INIT(&pmix_server_globals.dmdx_request_pool, pmix_dmdx_request_t,
+                       pmix_server_globals.request_pool_max);
+    pmix_hash_table_init(&pmix_server_globals.pset_names, 64);
 
     pmix_output_verbose(2, pmix_server_globals.base_output, "pmix:server init called");
 
@@ -540,6 +613,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
     pmix_output_verbose(2, pmix_server_globals.base_output, "pmix:server init called");
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_INIT);
 
     /* backward compatibility fix - remove any directive to use
      * the old usock component so we avoid a warning message */
@@ -768,6 +842,18 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
         return rc;
     }
 
+    /* open the pstat framework */
+    if (PMIX_SUCCESS
+        != (rc = pmix_mca_base_framework_open(&pmix_pstat_base_framework,
+                                              PMIX_MCA_BASE_OPEN_DEFAULT))) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_pstat_base_select())) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return rc;
+    }
+
     /* if we were started to support a singleton, register it now
      * so we won't reject it when it connects to us */
     if (NULL != singleton) {
@@ -810,6 +896,10 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
             PMIX_RELEASE_THREAD(&pmix_global_lock);
             return rc;
         }
+    } else {
+        /* find our devices now so device distance requests
+         * from our clients need not walk the topology */
+        (void) pmix_hwloc_setup_distances();
     }
 
     /* open the pnet and pgpu frameworks and select their active modules for this
@@ -835,6 +925,15 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
         PMIX_RELEASE_THREAD(&pmix_global_lock);
         return rc;
     }
+    /* get the GPU inventory underway so setting up jobs
+     * never has to wait for the devices to be enumerated */
+    pmix_pgpu_base_start_inventory();
+
+    /* start any progress threads dedicated to servicing our peers */
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_io_threads_start())) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return rc;
+    }
 
     /* start listening for connections */
     if (PMIX_SUCCESS != pmix_ptl_base_start_listening(info, ninfo)) {
@@ -860,6 +959,9 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
     PMIX_WAIT_THREAD(&reglock);
     PMIX_DESTRUCT_LOCK(&reglock);
 
+    /* if we are restarting, bring back what the host had given us */
+    pmix_server_snapshot_restore();
+
     /* see if they gave us a rendezvous URI to which we are to call back */
     evar = getenv("PMIX_LAUNCHER_RNDZ_URI");
     if (NULL != evar) {
@@ -934,6 +1036,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
         PMIX_WAIT_THREAD(&releaselock);
         PMIX_DESTRUCT_LOCK(&releaselock);
     }
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_INIT);
     return PMIX_SUCCESS;
 }
 
@@ -981,6 +1084,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
      * tear down the infrastructure, including removal
      * of any events objects may be holding */
     (void) pmix_progress_thread_pause(NULL);
+    pmix_ptl_base_io_threads_pause();
 
     /* flush any residual IOF into their respective channels */
     pmix_iof_flush_residuals();
@@ -1002,10 +1106,15 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
         }
     }
     PMIX_DESTRUCT(&pmix_server_globals.clients);
+    pmix_ptl_base_io_threads_stop();
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
+    PMIX_DESTRUCT(&pmix_server_globals.trackers);
+    pmix_modex_shmem_finalize();
     PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
+    pmix_notify_batch_finalize();
+    PMIX_DESTRUCT(&pmix_server_globals.event_codes);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
     PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
         /* ensure that we do the specified cleanup - if this is an
@@ -1013,10 +1122,28 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
          * at zero refcount */
         pmix_execute_epilog(&ns->epilog);
     }
+    PMIX_DESTRUCT(&pmix_server_globals.group_ids);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.groups);
+    /* removes any spill files */
+    pmix_server_iof_cache_purge();
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.iof_spills);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof_residuals);
+    PMIX_DESTRUCT(&pmix_server_globals.pset_names);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.psets);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.fabric_cache);
+    if (purge_ev_active) {
+        pmix_event_del(&purge_ev);
+        purge_ev_active = false;
+    }
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.finalizing);
+    pmix_server_pools_finalize();
+    pmix_server_inventory_flush();
+    pmix_server_dmdx_finalize();
+    pmix_server_pubsub_finalize();
+    pmix_server_sched_finalize();
+    pmix_server_query_finalize();
+    pmix_server_snapshot_finalize();
 
     if (NULL != security_mode) {
         free(security_mode);
@@ -1034,6 +1161,8 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     }
     /* close the psensor framework */
     (void) pmix_mca_base_framework_close(&pmix_psensor_base_framework);
+    /* close the pstat framework */
+    (void) pmix_mca_base_framework_close(&pmix_pstat_base_framework);
     /* close the pnet framework */
     (void) pmix_mca_base_framework_close(&pmix_pnet_base_framework);
     /* close the pstrg framework */
@@ -1043,6 +1172,8 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     PMIX_DESTRUCT_LOCK(&pmix_global_lock);
 
     pmix_rte_finalize();
+    /* remove the topology shmem backing files */
+    pmix_hwloc_finalize();
     if (NULL != pmix_globals.mypeer) {
         PMIX_RELEASE(pmix_globals.mypeer);
     }
@@ -1062,110 +1193,60 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_WAKEUP_THREAD(lock);
 }
 
-static void _register_nspace(int sd, short args, void *cbdata)
+/* an nspace whose per-proc data is being cached a slice at a time,
+ * so that a large job does not hold up the progress thread for
+ * the whole of its registration */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_setup_caddy_t *cd;
+    pmix_namespace_t *nptr;
+    /* positions in cd->info of the PMIX_PROC_DATA entries
+     * that remain to be cached */
+    size_t *pdata;
+    size_t npdata;
+    size_t next;
+} pmix_regns_caddy_t;
+static void rgcon(pmix_regns_caddy_t *p)
+{
+    p->cd = NULL;
+    p->nptr = NULL;
+    p->pdata = NULL;
+    p->npdata = 0;
+    p->next = 0;
+}
+static void rgdes(pmix_regns_caddy_t *p)
+{
+    if (NULL != p->pdata) {
+        free(p->pdata);
+    }
+    if (NULL != p->nptr) {
+        PMIX_RELEASE(p->nptr);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_regns_caddy_t, pmix_object_t, rgcon, rgdes);
+
+/* the nspace has all its data - let everything that was
+ * waiting for it proceed */
+static pmix_status_t publish_nspace(pmix_namespace_t *nptr)
 {
-    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
-    pmix_namespace_t *nptr, *tmp;
     pmix_status_t rc;
-    size_t i, m, ninfo;
-    pmix_info_t *iptr;
+    size_t i;
     bool all_def;
     pmix_server_trkr_t *trk;
     pmix_namespace_t *ns;
     pmix_trkr_caddy_t *tcd;
-    pmix_gds_base_module_t *gds;
-    pmix_kval_t *kv;
-    pmix_proc_t proc;
-
-    PMIX_ACQUIRE_OBJECT(caddy);
-
-    pmix_output_verbose(2, pmix_server_globals.base_output, "pmix:server _register_nspace %s",
-                        cd->proc.nspace);
-
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-    /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
-    if (NULL == nptr) {
-        nptr = PMIX_NEW(pmix_namespace_t);
-        if (NULL == nptr) {
-            rc = PMIX_ERR_NOMEM;
-            goto release;
-        }
-        nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
-    }
-    if (0 > cd->nlocalprocs) {
-        gds = nptr->compat.gds;
-        if (NULL != gds) {
-            /* this is just an update */
-            for (i=0; i < cd->ninfo; i++) {
-                if (PMIX_CHECK_KEY(&cd->info[i], PMIX_PROC_DATA)) {
-                    iptr = (pmix_info_t*)cd->info[i].value.data.darray->array;
-                    ninfo = cd->info[i].value.data.darray->size;
-                    /* the first position is the rank */
-                    PMIX_LOAD_PROCID(&proc, cd->proc.nspace, iptr[0].value.data.rank);
-                    /* get the peer object for this rank */
-                    for (m=1; m < ninfo; m++) {
-                        PMIX_KVAL_NEW(kv, iptr[m].key);
-                        PMIX_VALUE_XFER(rc, kv->value, &iptr[m].value);
-                        gds->store(&proc, PMIX_REMOTE, kv);
-                        PMIX_RELEASE(kv); // maintain refcount
-                    }
-                } else if (PMIX_CHECK_KEY(&cd->info[i], PMIX_GROUP_CONTEXT_ID)) {
-                    PMIX_KVAL_NEW(kv, cd->info[i].key);
-                    PMIX_VALUE_XFER(rc, kv->value, &cd->info[i].value);
-                    gds->store(&proc, PMIX_GLOBAL, kv);
-                    PMIX_RELEASE(kv); // maintain refcount
-                }
-            }
-        }
-        rc = PMIX_SUCCESS;
-        goto release;
-    }
-    nptr->nlocalprocs = cd->nlocalprocs;
-
-    /* see if we already have everyone */
-    if (nptr->nlocalprocs == pmix_list_get_size(&nptr->ranks)) {
-        nptr->all_registered = true;
-    }
-
-    /* check info directives to see if we want to store this info */
-    for (i = 0; i < cd->ninfo; i++) {
-        if (0 == strcmp(cd->info[i].key, PMIX_REGISTER_NODATA)) {
-            /* nope - so we are done */
-            rc = PMIX_SUCCESS;
-            goto release;
-        }
-    }
-
-    /* register nspace for each activate components */
-    PMIX_GDS_ADD_NSPACE(rc, nptr->nspace, cd->nlocalprocs, cd->info, cd->ninfo);
-    if (PMIX_SUCCESS != rc) {
-        goto release;
-    }
-
-    /* store this data in our own GDS module - we will retrieve
-     * it later so it can be passed down to the launched procs
-     * once they connect to us and we know what GDS module they
-     * are using */
-    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, cd->info, cd->ninfo);
-    if (PMIX_SUCCESS != rc) {
-        goto release;
-    }
 
     /* give the programming models a chance to add anything they need */
     rc = pmix_pmdl.register_nspace(nptr);
     if (PMIX_SUCCESS != rc) {
-        goto release;
+        return rc;
     }
 
+    /* precompute the relative locality of the local procs
+     * so they need not compare locality strings themselves */
+    pmix_server_locality_matrix(nptr);
+
     /* check any pending trackers to see if they are
      * waiting for us. There is a slight race condition whereby
      * the host server could have spawned the local client and
@@ -1221,6 +1302,9 @@ static void _register_nspace(int sd, short args, void *cbdata)
         }
         /* update this tracker's status */
         trk->def_complete = all_def;
+        if (trk->def_complete) {
+            trk->local = pmix_server_trk_all_local(trk);
+        }
         /* is this now locally completed? */
         if (trk->def_complete && pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
             /* it did, so now we need to process it
@@ -1235,13 +1319,278 @@ static void _register_nspace(int sd, short args, void *cbdata)
      * in one of our nspaces, but we didn't know all the local procs
      * and so couldn't determine the proc was remote */
     pmix_pending_nspace_requests(nptr);
-    rc = PMIX_SUCCESS;
+    return PMIX_SUCCESS;
+}
 
-release:
+static void register_complete(pmix_setup_caddy_t *cd, pmix_status_t rc)
+{
+    if (PMIX_SUCCESS == rc) {
+        /* let any of its procs that connected early proceed */
+        pmix_ptl_base_release_held_connections(cd->proc.nspace);
+    }
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_REGISTER);
     cd->opcbfunc(rc, cd->cbdata);
     PMIX_RELEASE(cd);
 }
 
+static void _register_slice(int sd, short args, void *cbdata)
+{
+    pmix_regns_caddy_t *rg = (pmix_regns_caddy_t *) cbdata;
+    pmix_setup_caddy_t *cd = rg->cd;
+    pmix_namespace_t *tmp;
+    pmix_status_t rc = PMIX_ERR_NOT_FOUND;
+    size_t end;
+
+    PMIX_ACQUIRE_OBJECT(rg);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    /* the host may have deregistered the nspace meanwhile */
+    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (tmp == rg->nptr) {
+            rc = PMIX_SUCCESS;
+            break;
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        goto release;
+    }
+
+    end = rg->next + (size_t) pmix_server_globals.register_slice;
+    if (rg->npdata < end) {
+        end = rg->npdata;
+    }
+    for (; rg->next < end; rg->next++) {
+        PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, rg->nptr,
+                                &cd->info[rg->pdata[rg->next]], 1);
+        if (PMIX_SUCCESS != rc) {
+            goto release;
+        }
+    }
+    if (rg->next < rg->npdata) {
+        /* go around the event loop so any client messages
+         * that arrived meanwhile get serviced first */
+        PMIX_THREADSHIFT_DELAY(rg, _register_slice, 0);
+        return;
+    }
+
+    /* the nspace can now be seen by its clients */
+    rg->nptr->nlocalprocs = cd->nlocalprocs;
+    if (rg->nptr->nlocalprocs == pmix_list_get_size(&rg->nptr->ranks)) {
+        rg->nptr->all_registered = true;
+    }
+    rc = publish_nspace(rg->nptr);
+
+release:
+    register_complete(cd, rc);
+    PMIX_RELEASE(rg);
+}
+
+/* cache everything but the per-proc data of the nspace now, and
+ * the per-proc data in slices of pmix_server_register_slice entries
+ * on later passes of the event loop. Until the last slice is done
+ * the nspace is left looking unregistered, so its clients are held
+ * at connect and requests for its procs are deferred as they would
+ * be had the host not yet called register_nspace */
+static pmix_status_t register_sliced(pmix_setup_caddy_t *cd, pmix_namespace_t *nptr)
+{
+    pmix_regns_caddy_t *rg;
+    pmix_info_t *info;
+    size_t n, m, npdata = 0;
+    pmix_status_t rc;
+    bool first = true;
+
+    for (n = 0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_PROC_DATA)) {
+            ++npdata;
+        }
+    }
+    if (npdata <= (size_t) pmix_server_globals.register_slice) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    rg = PMIX_NEW(pmix_regns_caddy_t);
+    if (NULL == rg) {
+        return PMIX_ERR_NOMEM;
+    }
+    /* the first proc's data stays with the rest so the gds
+     * knows the job came with per-proc data */
+    rg->pdata = (size_t *) malloc((npdata - 1) * sizeof(size_t));
+    info = (pmix_info_t *) malloc((cd->ninfo - npdata + 1) * sizeof(pmix_info_t));
+    if (NULL == rg->pdata || NULL == info) {
+        if (NULL != info) {
+            free(info);
+        }
+        PMIX_RELEASE(rg);
+        return PMIX_ERR_NOMEM;
+    }
+    /* the entries are only borrowed from the caller's array */
+    for (n = 0, m = 0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_PROC_DATA) && !first) {
+            rg->pdata[rg->npdata++] = n;
+            continue;
+        }
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_PROC_DATA)) {
+            first = false;
+        }
+        memcpy(&info[m++], &cd->info[n], sizeof(pmix_info_t));
+    }
+    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, info, m);
+    free(info);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(rg);
+        return rc;
+    }
+
+    /* hide the nspace until the rest is cached */
+    nptr->nlocalprocs = SIZE_MAX;
+    nptr->all_registered = false;
+    PMIX_RETAIN(nptr);
+    rg->nptr = nptr;
+    rg->cd = cd;
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server registering data of %lu procs of %s in slices of %d",
+                        (unsigned long) npdata, nptr->nspace, pmix_server_globals.register_slice);
+    PMIX_THREADSHIFT_DELAY(rg, _register_slice, 0);
+    return PMIX_OPERATION_IN_PROGRESS;
+}
+
+/* register the nspace described by the caddy. Returns
+ * PMIX_OPERATION_IN_PROGRESS if the caddy was taken over to
+ * cache the data in slices - the registration is then completed
+ * by _register_slice */
+static pmix_status_t register_nspace_info(pmix_setup_caddy_t *cd, bool sliceable)
+{
+    pmix_namespace_t *nptr, *tmp;
+    pmix_status_t rc;
+    size_t i, m, ninfo;
+    pmix_info_t *iptr;
+    bool fresh;
+    pmix_gds_base_module_t *gds;
+    pmix_kval_t *kv;
+    pmix_proc_t proc;
+
+    /* see if we already have this nspace */
+    nptr = NULL;
+    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
+            nptr = tmp;
+            break;
+        }
+    }
+    if (NULL == nptr) {
+        nptr = PMIX_NEW(pmix_namespace_t);
+        if (NULL == nptr) {
+            return PMIX_ERR_NOMEM;
+        }
+        nptr->nspace = strdup(cd->proc.nspace);
+        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    }
+    if (0 > cd->nlocalprocs) {
+        gds = nptr->compat.gds;
+        if (NULL != gds) {
+            /* this is just an update */
+            for (i=0; i < cd->ninfo; i++) {
+                if (PMIX_CHECK_KEY(&cd->info[i], PMIX_PROC_DATA)) {
+                    iptr = (pmix_info_t*)cd->info[i].value.data.darray->array;
+                    ninfo = cd->info[i].value.data.darray->size;
+                    /* the first position is the rank */
+                    PMIX_LOAD_PROCID(&proc, cd->proc.nspace, iptr[0].value.data.rank);
+                    /* get the peer object for this rank */
+                    for (m=1; m < ninfo; m++) {
+                        PMIX_KVAL_NEW(kv, iptr[m].key);
+                        PMIX_VALUE_XFER(rc, kv->value, &iptr[m].value);
+                        gds->store(&proc, PMIX_REMOTE, kv);
+                        PMIX_RELEASE(kv); // maintain refcount
+                    }
+                } else if (PMIX_CHECK_KEY(&cd->info[i], PMIX_GROUP_CONTEXT_ID)) {
+                    PMIX_KVAL_NEW(kv, cd->info[i].key);
+                    PMIX_VALUE_XFER(rc, kv->value, &cd->info[i].value);
+                    gds->store(&proc, PMIX_GLOBAL, kv);
+                    PMIX_RELEASE(kv); // maintain refcount
+                }
+            }
+            pmix_gds_base_dcache_flush();
+        }
+        return PMIX_SUCCESS;
+    }
+    fresh = (SIZE_MAX == nptr->nlocalprocs);
+    nptr->nlocalprocs = cd->nlocalprocs;
+
+    /* see if we already have everyone */
+    if (nptr->nlocalprocs == pmix_list_get_size(&nptr->ranks)) {
+        nptr->all_registered = true;
+    }
+
+    /* see for how long to keep the modex data of its remote procs */
+    for (i = 0; i < cd->ninfo; i++) {
+        if (PMIX_CHECK_KEY(&cd->info[i], PMIX_MODEX_RELEASE_TIME)) {
+            PMIX_VALUE_GET_NUMBER(rc, &cd->info[i].value, nptr->mdx_release_time, uint32_t);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                nptr->mdx_release_time = 0;
+            }
+        } else if (PMIX_CHECK_KEY(&cd->info[i], PMIX_MODEX_RELEASE_FETCHED)) {
+            nptr->mdx_release_fetched = PMIX_INFO_TRUE(&cd->info[i]);
+        }
+    }
+
+    /* check info directives to see if we want to store this info */
+    for (i = 0; i < cd->ninfo; i++) {
+        if (0 == strcmp(cd->info[i].key, PMIX_REGISTER_NODATA)) {
+            /* nope - so we are done */
+            return PMIX_SUCCESS;
+        }
+    }
+
+    /* register nspace for each activate components */
+    PMIX_GDS_ADD_NSPACE(rc, nptr->nspace, cd->nlocalprocs, cd->info, cd->ninfo);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* a job registered for the first time can have its
+     * per-proc data cached a slice at a time */
+    if (sliceable && fresh && 0 < pmix_server_globals.register_slice) {
+        rc = register_sliced(cd, nptr);
+        if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+            return rc;
+        }
+    }
+
+    /* store this data in our own GDS module - we will retrieve
+     * it later so it can be passed down to the launched procs
+     * once they connect to us and we know what GDS module they
+     * are using */
+    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, cd->info, cd->ninfo);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    return publish_nspace(nptr);
+}
+
+static void _register_nspace(int sd, short args, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    pmix_output_verbose(2, pmix_server_globals.base_output, "pmix:server _register_nspace %s",
+                        cd->proc.nspace);
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_REGISTER);
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    rc = register_nspace_info(cd, true);
+    if (PMIX_SUCCESS == rc || PMIX_OPERATION_IN_PROGRESS == rc) {
+        pmix_server_snapshot_nspace(cd->proc.nspace, cd->nlocalprocs, cd->info, cd->ninfo);
+    }
+    if (PMIX_OPERATION_IN_PROGRESS != rc) {
+        register_complete(cd, rc);
+    }
+}
+
 /* setup the data for a job */
 PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace, int nlocalprocs,
                                                       pmix_info_t info[], size_t ninfo,
@@ -1258,7 +1607,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     pmix_strncpy(cd->proc.nspace, nspace, PMIX_MAX_NSLEN);
     cd->nlocalprocs = nlocalprocs;
     cd->opcbfunc = cbfunc;
@@ -1291,12 +1640,243 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace
     return PMIX_SUCCESS;
 }
 
-void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
+/* a set of nspaces registered together */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_nspace_t *nspaces;
+    const int *nlocalprocs;
+    pmix_info_t **info;
+    const size_t *ninfo;
+    size_t nnspaces;
+    pmix_info_t *shared;
+    size_t nshared;
+    pmix_op_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_regbulk_caddy_t;
+static void rbcon(pmix_regbulk_caddy_t *p)
+{
+    p->nspaces = NULL;
+    p->nlocalprocs = NULL;
+    p->info = NULL;
+    p->ninfo = NULL;
+    p->nnspaces = 0;
+    p->shared = NULL;
+    p->nshared = 0;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void rbdes(pmix_regbulk_caddy_t *p)
+{
+    if (NULL != p->nspaces) {
+        free(p->nspaces);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_regbulk_caddy_t, pmix_object_t, rbcon, rbdes);
+
+static void _register_nspaces(int sd, short args, void *cbdata)
+{
+    pmix_regbulk_caddy_t *rb = (pmix_regbulk_caddy_t *) cbdata;
+    pmix_setup_caddy_t cd;
+    pmix_info_t *info;
+    size_t n, ninfo;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+
+    PMIX_ACQUIRE_OBJECT(rb);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server _register_nspaces %lu nspaces", (unsigned long) rb->nnspaces);
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_REGISTER);
+
+    /* the caddy only carries the description of each nspace
+     * in turn - the info arrays stay with the caller */
+    PMIX_CONSTRUCT(&cd, pmix_setup_caddy_t);
+    for (n = 0; n < rb->nnspaces; n++) {
+        ninfo = (NULL == rb->ninfo) ? 0 : rb->ninfo[n];
+        info = (NULL == rb->info || 0 == ninfo) ? NULL : rb->info[n];
+        if (0 < rb->nshared) {
+            /* the shared entries go first so an nspace's own
+             * entries take precedence over them */
+            cd.info = (pmix_info_t *) malloc((rb->nshared + ninfo) * sizeof(pmix_info_t));
+            if (NULL == cd.info) {
+                ret = PMIX_ERR_NOMEM;
+                break;
+            }
+            memcpy(cd.info, rb->shared, rb->nshared * sizeof(pmix_info_t));
+            if (0 < ninfo) {
+                memcpy(&cd.info[rb->nshared], info, ninfo * sizeof(pmix_info_t));
+            }
+            cd.ninfo = rb->nshared + ninfo;
+        } else {
+            cd.info = info;
+            cd.ninfo = ninfo;
+        }
+        PMIX_LOAD_NSPACE(cd.proc.nspace, rb->nspaces[n]);
+        cd.nlocalprocs = rb->nlocalprocs[n];
+
+        /* these are small jobs by nature, so they are never sliced */
+        rc = register_nspace_info(&cd, false);
+        if (PMIX_SUCCESS == rc) {
+            pmix_server_snapshot_nspace(cd.proc.nspace, cd.nlocalprocs, cd.info, cd.ninfo);
+        }
+        if (0 < rb->nshared) {
+            free(cd.info);
+        }
+        if (PMIX_SUCCESS == rc) {
+            /* let any of its procs that connected early proceed */
+            pmix_ptl_base_release_held_connections(cd.proc.nspace);
+        } else {
+            pmix_output_verbose(2, pmix_server_globals.base_output,
+                                "pmix:server _register_nspaces %s failed: %s",
+                                cd.proc.nspace, PMIx_Error_string(rc));
+            if (PMIX_SUCCESS == ret) {
+                ret = rc;
+            }
+        }
+    }
+    cd.info = NULL;
+    cd.ninfo = 0;
+    PMIX_DESTRUCT(&cd);
+
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_REGISTER);
+    rb->cbfunc(ret, rb->cbdata);
+    PMIX_RELEASE(rb);
+}
+
+PMIX_EXPORT pmix_status_t PMIx_server_register_nspaces(const pmix_nspace_t nspaces[],
+                                                       const int nlocalprocs[],
+                                                       pmix_info_t *info[], const size_t ninfo[],
+                                                       size_t nnspaces,
+                                                       pmix_info_t shared[], size_t nshared,
+                                                       pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_regbulk_caddy_t *rb;
+    pmix_status_t rc;
+    pmix_lock_t mylock;
+    size_t n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == nspaces || NULL == nlocalprocs || 0 == nnspaces) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    rb = PMIX_NEW(pmix_regbulk_caddy_t);
+    if (NULL == rb) {
+        return PMIX_ERR_NOMEM;
+    }
+    rb->nspaces = (pmix_nspace_t *) malloc(nnspaces * sizeof(pmix_nspace_t));
+    if (NULL == rb->nspaces) {
+        PMIX_RELEASE(rb);
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nnspaces; n++) {
+        PMIX_LOAD_NSPACE(rb->nspaces[n], nspaces[n]);
+    }
+    rb->nlocalprocs = nlocalprocs;
+    rb->info = info;
+    rb->ninfo = ninfo;
+    rb->nnspaces = nnspaces;
+    if (0 < nshared) {
+        rb->shared = shared;
+        rb->nshared = nshared;
+    }
+    rb->cbfunc = cbfunc;
+    rb->cbdata = cbdata;
+
+    /* if the provided callback is NULL, then substitute
+     * our own internal cbfunc and block here */
+    if (NULL == cbfunc) {
+        PMIX_CONSTRUCT_LOCK(&mylock);
+        rb->cbfunc = opcbfunc;
+        rb->cbdata = &mylock;
+        PMIX_THREADSHIFT(rb, _register_nspaces);
+        PMIX_WAIT_THREAD(&mylock);
+        rc = mylock.status;
+        PMIX_DESTRUCT_LOCK(&mylock);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIX_OPERATION_SUCCEEDED;
+        }
+        return rc;
+    }
+
+    PMIX_THREADSHIFT(rb, _register_nspaces);
+    return PMIX_SUCCESS;
+}
+
+/* what is being purged - a peer, the procs matching a proc, or
+ * a batch of finalized clients whose names are sorted so they
+ * can be found with a binary search */
+typedef struct {
+    pmix_peer_t *peer;
+    pmix_proc_t *proc;
+    pmix_proc_t *batch;
+    size_t nbatch;
+} pmix_purge_target_t;
+
+static int proc_cmp(const void *a, const void *b)
+{
+    const pmix_proc_t *p1 = (const pmix_proc_t *) a;
+    const pmix_proc_t *p2 = (const pmix_proc_t *) b;
+    int rc;
+
+    rc = strncmp(p1->nspace, p2->nspace, PMIX_MAX_NSLEN);
+    if (0 != rc) {
+        return rc;
+    }
+    if (p1->rank == p2->rank) {
+        return 0;
+    }
+    return (p1->rank < p2->rank) ? -1 : 1;
+}
+
+static int nspace_cmp(const void *a, const void *b)
+{
+    return strncmp(((const pmix_proc_t *) a)->nspace, ((const pmix_proc_t *) b)->nspace,
+                   PMIX_MAX_NSLEN);
+}
+
+/* does the given proc match the target - as with PMIX_CHECK_PROCID,
+ * a wildcard rank matches any rank */
+static bool purge_proc(pmix_purge_target_t *tgt, const char *nspace, pmix_rank_t rank)
+{
+    pmix_proc_t key;
+
+    if (NULL != tgt->peer) {
+        return (NULL != tgt->peer->info
+                && PMIX_CHECK_NSPACE(tgt->peer->info->pname.nspace, nspace)
+                && PMIX_CHECK_RANK(tgt->peer->info->pname.rank, rank));
+    }
+    if (NULL != tgt->proc) {
+        return (PMIX_CHECK_NSPACE(tgt->proc->nspace, nspace)
+                && PMIX_CHECK_RANK(tgt->proc->rank, rank));
+    }
+    PMIX_LOAD_PROCID(&key, nspace, rank);
+    return (NULL != bsearch(&key, tgt->batch, tgt->nbatch, sizeof(pmix_proc_t),
+                            (PMIX_RANK_WILDCARD == rank) ? nspace_cmp : proc_cmp));
+}
+
+static bool purge_peer(pmix_purge_target_t *tgt, pmix_peer_t *peer)
+{
+    if (NULL != tgt->peer) {
+        return (peer == tgt->peer);
+    }
+    return (NULL != peer->info
+            && purge_proc(tgt, peer->info->pname.nspace, peer->info->pname.rank));
+}
+
+static void purge_events(pmix_purge_target_t *target)
 {
     pmix_regevents_info_t *reginfo, *regnext;
     pmix_peer_events_info_t *prev, *pnext;
     pmix_iof_req_t *req;
-    int i;
+    int i, next;
     pmix_notify_caddy_t *ncd;
     size_t n, m, p, ntgs;
     pmix_proc_t *tgs, *tgt;
@@ -1306,14 +1886,11 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
      * registrations they may still have on our list */
     PMIX_LIST_FOREACH_SAFE (reginfo, regnext, &pmix_server_globals.events, pmix_regevents_info_t) {
         PMIX_LIST_FOREACH_SAFE (prev, pnext, &reginfo->peers, pmix_peer_events_info_t) {
-            if ((NULL != peer && prev->peer == peer)
-                || (NULL != proc && NULL != prev->peer->info
-                    && PMIX_CHECK_PROCID(proc, &prev->peer->info->pname))) {
+            if (purge_peer(target, prev->peer)) {
                 pmix_list_remove_item(&reginfo->peers, &prev->super);
                 PMIX_RELEASE(prev);
                 if (0 == pmix_list_get_size(&reginfo->peers)) {
-                    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
-                    PMIX_RELEASE(reginfo);
+                    pmix_server_event_remove(reginfo);
                     break;
                 }
             }
@@ -1334,12 +1911,8 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
             PMIX_RELEASE(req);
             continue;
         }
-        if (NULL != peer && NULL == peer->info) {
-            continue;
-        }
-        if ((NULL != peer && NULL != peer->info
-             && PMIX_CHECK_PROCID(&req->requestor->info->pname, &peer->info->pname))
-            || (NULL != proc && PMIX_CHECK_PROCID(&req->requestor->info->pname, proc))) {
+        if (purge_proc(target, req->requestor->info->pname.nspace,
+                       req->requestor->info->pname.rank)) {
             pmix_pointer_array_set_item(&pmix_globals.iof_requests, i, NULL);
             PMIX_RELEASE(req);
         }
@@ -1347,9 +1920,7 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
 
     /* see if this proc is involved in any direct modex requests */
     PMIX_LIST_FOREACH_SAFE (dlcd, dnxt, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        if ((NULL != peer && NULL != peer->info
-             && PMIX_CHECK_PROCID(&peer->info->pname, &dlcd->proc))
-            || (NULL != proc && PMIX_CHECK_PROCID(proc, &dlcd->proc))) {
+        if (purge_proc(target, dlcd->proc.nspace, dlcd->proc.rank)) {
             /* cleanup this request */
             pmix_list_remove_item(&pmix_server_globals.local_reqs, &dlcd->super);
             /* we can release the dlcd item here because we are not
@@ -1360,14 +1931,13 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
     }
 
     /* purge this client from any cached notifications */
-    for (i = 0; i < pmix_globals.max_events; i++) {
+    for (i = pmix_hotel_oldest_room(&pmix_globals.notifications); 0 <= i; i = next) {
+        next = pmix_hotel_next_room(&pmix_globals.notifications, i);
         pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &ncd);
         if (NULL != ncd && NULL != ncd->targets && 0 < ncd->ntargets) {
             tgt = NULL;
             for (n = 0; n < ncd->ntargets; n++) {
-                if ((NULL != peer && NULL != peer->info
-                     && PMIX_CHECK_PROCID(&peer->info->pname, &ncd->targets[n]))
-                    || (NULL != proc && PMIX_CHECK_PROCID(proc, &ncd->targets[n]))) {
+                if (purge_proc(target, ncd->targets[n].nspace, ncd->targets[n].rank)) {
                     tgt = &ncd->targets[n];
                     break;
                 }
@@ -1376,10 +1946,10 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
                 /* if this client was the only target, then just
                  * evict the notification */
                 if (1 == ncd->ntargets) {
-                    pmix_hotel_checkout(&pmix_globals.notifications, i);
+                    pmix_notify_event_uncache(ncd);
                     PMIX_RELEASE(ncd);
-                } else if (PMIX_RANK_WILDCARD == tgt->rank && NULL != proc
-                           && PMIX_RANK_WILDCARD == proc->rank) {
+                } else if (PMIX_RANK_WILDCARD == tgt->rank && NULL != target->proc
+                           && PMIX_RANK_WILDCARD == target->proc->rank) {
                     /* we have to remove this target, but leave the rest */
                     ntgs = ncd->ntargets - 1;
                     PMIX_PROC_CREATE(tgs, ntgs);
@@ -1397,10 +1967,81 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
             }
         }
     }
+}
+
+void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
+{
+    pmix_purge_target_t target;
+
+    target.peer = peer;
+    target.proc = (NULL == peer) ? proc : NULL;
+    target.batch = NULL;
+    target.nbatch = 0;
+    purge_events(&target);
+
+    if (NULL != peer) {
+        /* ensure we honor any peer-level epilog requests */
+        pmix_execute_epilog(&peer->epilog);
+    }
+}
+
+/* purge all the clients that finalized since the last pass in a
+ * single sweep of each registration list - when all the procs of
+ * a large job finalize together, this replaces one sweep per proc */
+static void purge_finalized(int sd, short args, void *cbdata)
+{
+    pmix_purge_target_t target;
+    pmix_server_caddy_t *cd;
+    size_t nprocs;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+    purge_ev_active = false;
+
+    target.peer = NULL;
+    target.proc = NULL;
+    target.nbatch = 0;
+    nprocs = pmix_list_get_size(&pmix_server_globals.finalizing);
+    PMIX_PROC_CREATE(target.batch, nprocs);
+    PMIX_LIST_FOREACH (cd, &pmix_server_globals.finalizing, pmix_server_caddy_t) {
+        if (NULL != cd->peer->info) {
+            PMIX_LOAD_PROCID(&target.batch[target.nbatch], cd->peer->info->pname.nspace,
+                             cd->peer->info->pname.rank);
+            ++target.nbatch;
+        }
+    }
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server purging %lu finalized clients", (unsigned long) target.nbatch);
+    if (0 < target.nbatch) {
+        qsort(target.batch, target.nbatch, sizeof(pmix_proc_t), proc_cmp);
+        purge_events(&target);
+    }
+    PMIX_PROC_FREE(target.batch, nprocs);
 
-    if (NULL != peer) {
-        /* ensure we honor any peer-level epilog requests */
-        pmix_execute_epilog(&peer->epilog);
+    /* honor the peer-level epilog requests */
+    while (NULL != (cd = (pmix_server_caddy_t *) pmix_list_remove_first(&pmix_server_globals.finalizing))) {
+        pmix_execute_epilog(&cd->peer->epilog);
+        PMIX_RELEASE(cd);
+    }
+}
+
+void pmix_server_purge_finalized(pmix_peer_t *peer)
+{
+    pmix_server_caddy_t *cd;
+
+    if (!pmix_server_globals.finalize_batch || NULL == peer->info) {
+        pmix_server_purge_events(peer, NULL);
+        peer->purged = true;
+        return;
+    }
+    PMIX_GDS_CADDY(cd, peer, 0);
+    pmix_list_append(&pmix_server_globals.finalizing, &cd->super);
+    peer->purged = true;
+    /* the others that finalize in this pass of the event
+     * loop join the batch */
+    if (!purge_ev_active) {
+        pmix_event_assign(&purge_ev, pmix_globals.evbase, -1, EV_WRITE, purge_finalized, NULL);
+        purge_ev_active = true;
+        pmix_event_active(&purge_ev, EV_WRITE, 1);
     }
 }
 
@@ -1418,6 +2059,8 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
 
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
+    pmix_server_snapshot_nspace_delete(cd->proc.nspace);
+
     /* flush anything that is still trying to be written out */
     pmix_iof_static_dump_output(&pmix_client_globals.iof_stdout);
     pmix_iof_static_dump_output(&pmix_client_globals.iof_stderr);
@@ -1431,6 +2074,19 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
     /* let our local storage clean up */
     PMIX_GDS_DEL_NSPACE(rc, cd->proc.nspace);
 
+    /* release any modex segments published for its clients */
+    pmix_modex_shmem_release(cd->proc.nspace);
+
+    /* forget which of its procs we asked the host about */
+    pmix_server_dmdx_purge(cd->proc.nspace);
+
+    /* drop the data its procs published for the life of the job,
+     * along with the lookups we answered for it */
+    pmix_server_pubsub_purge(&cd->proc);
+
+    /* answers about the jobs in the system are now stale */
+    pmix_server_query_flush();
+
     /* remove any event registrations, IOF registrations, and
      * cached notifications targeting procs from this nspace */
     pmix_server_purge_events(NULL, &cd->proc);
@@ -1471,7 +2127,7 @@ PMIX_EXPORT void PMIx_server_deregister_nspace(const pmix_nspace_t nspace, pmix_
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     PMIX_LOAD_PROCID(&cd->proc, nspace, PMIX_RANK_WILDCARD);
     cd->opcbfunc = cbfunc;
     cd->cbdata = cbdata;
@@ -1493,12 +2149,191 @@ PMIX_EXPORT void PMIx_server_deregister_nspace(const pmix_nspace_t nspace, pmix_
     PMIX_THREADSHIFT(cd, _deregister_nspace);
 }
 
+/* node-level resources are cached one entry per node, so registering
+ * a node we already hold only changes the values it carries and
+ * deregistering one removes just that node. Either way, jobs already
+ * running are given only what changed rather than the whole array */
+static bool node_ident_key(const char *key)
+{
+    return (0 == strcmp(key, PMIX_NODEID) || 0 == strcmp(key, PMIX_HOSTNAME));
+}
+
+static bool node_ident(pmix_value_t *val, uint32_t *nodeid, char **hostname)
+{
+    pmix_info_t *iptr;
+    size_t n;
+    pmix_status_t rc;
+
+    *nodeid = UINT32_MAX;
+    *hostname = NULL;
+    if (PMIX_DATA_ARRAY != val->type || NULL == val->data.darray
+        || PMIX_INFO != val->data.darray->type) {
+        return false;
+    }
+    iptr = (pmix_info_t *) val->data.darray->array;
+    for (n = 0; n < val->data.darray->size; n++) {
+        if (PMIX_CHECK_KEY(&iptr[n], PMIX_NODEID)) {
+            PMIX_VALUE_GET_NUMBER(rc, &iptr[n].value, *nodeid, uint32_t);
+            if (PMIX_SUCCESS != rc) {
+                return false;
+            }
+        } else if (PMIX_CHECK_KEY(&iptr[n], PMIX_HOSTNAME)
+                   && PMIX_STRING == iptr[n].value.type) {
+            *hostname = iptr[n].value.data.string;
+        }
+    }
+    return (UINT32_MAX != *nodeid || NULL != *hostname);
+}
+
+/* same matching as the gds applies to node arrays */
+static pmix_kval_t *find_node_resource(pmix_value_t *val)
+{
+    pmix_kval_t *kv;
+    uint32_t nid, kvnid;
+    char *host, *kvhost;
+
+    if (!node_ident(val, &nid, &host)) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH (kv, &pmix_server_globals.gdata, pmix_kval_t) {
+        if (!PMIX_CHECK_KEY(kv, PMIX_NODE_INFO_ARRAY)
+            || !node_ident(kv->value, &kvnid, &kvhost)) {
+            continue;
+        }
+        if (UINT32_MAX != nid && UINT32_MAX != kvnid) {
+            if (nid == kvnid) {
+                return kv;
+            }
+        } else if (NULL != host && NULL != kvhost && 0 == strcmp(host, kvhost)) {
+            return kv;
+        }
+    }
+    return NULL;
+}
+
+/* fold the given values into the cached node, returning in delta the
+ * ones that are new or differ from what we held - along with the
+ * node's identifiers - or NULL if nothing changed */
+static pmix_status_t merge_node_resource(pmix_kval_t *kv, pmix_value_t *val,
+                                         pmix_data_array_t **delta)
+{
+    pmix_data_array_t *cur = kv->value->data.darray;
+    pmix_info_t *old, *upd, *merged, *chg;
+    size_t n, m, nmerged, nchg = 0, nvals = 0;
+    bool ident, changed;
+    pmix_status_t rc;
+
+    *delta = NULL;
+    old = (pmix_info_t *) cur->array;
+    upd = (pmix_info_t *) val->data.darray->array;
+    PMIX_INFO_CREATE(merged, cur->size + val->data.darray->size);
+    PMIX_INFO_CREATE(chg, val->data.darray->size);
+    for (n = 0; n < cur->size; n++) {
+        PMIX_INFO_XFER(&merged[n], &old[n]);
+    }
+    nmerged = cur->size;
+
+    for (n = 0; n < val->data.darray->size; n++) {
+        ident = node_ident_key(upd[n].key);
+        changed = true;
+        for (m = 0; m < nmerged; m++) {
+            if (PMIX_CHECK_KEY(&merged[m], upd[n].key)) {
+                break;
+            }
+        }
+        if (m < nmerged) {
+            if (PMIX_EQUAL == PMIx_Value_compare(&merged[m].value, &upd[n].value)) {
+                changed = false;
+            } else {
+                PMIX_VALUE_DESTRUCT(&merged[m].value);
+                rc = PMIx_Value_xfer(&merged[m].value, &upd[n].value);
+                if (PMIX_SUCCESS != rc) {
+                    goto error;
+                }
+            }
+        } else {
+            PMIX_INFO_XFER(&merged[nmerged], &upd[n]);
+            ++nmerged;
+        }
+        if (ident || changed) {
+            PMIX_INFO_XFER(&chg[nchg], &upd[n]);
+            ++nchg;
+            if (!ident) {
+                ++nvals;
+            }
+        }
+    }
+
+    PMIX_INFO_FREE(old, cur->size);
+    cur->array = merged;
+    cur->size = nmerged;
+
+    if (0 == nvals) {
+        PMIX_INFO_FREE(chg, val->data.darray->size);
+        return PMIX_SUCCESS;
+    }
+    *delta = (pmix_data_array_t *) malloc(sizeof(pmix_data_array_t));
+    (*delta)->type = PMIX_INFO;
+    (*delta)->size = nchg;
+    (*delta)->array = chg;
+    return PMIX_SUCCESS;
+
+error:
+    PMIX_INFO_FREE(merged, cur->size + val->data.darray->size);
+    PMIX_INFO_FREE(chg, val->data.darray->size);
+    return rc;
+}
+
+/* remove the values named in the given array from the cached node -
+ * an array that names nothing but the node removes the node */
+static void strip_node_resource(pmix_kval_t *kv, pmix_value_t *val)
+{
+    pmix_data_array_t *cur = kv->value->data.darray;
+    pmix_info_t *iptr, *old;
+    size_t n, m, k;
+    bool any = false;
+
+    iptr = (pmix_info_t *) val->data.darray->array;
+    for (n = 0; n < val->data.darray->size; n++) {
+        if (!node_ident_key(iptr[n].key)) {
+            any = true;
+            break;
+        }
+    }
+    if (!any) {
+        pmix_list_remove_item(&pmix_server_globals.gdata, &kv->super);
+        PMIX_RELEASE(kv);
+        return;
+    }
+
+    old = (pmix_info_t *) cur->array;
+    for (n = 0; n < val->data.darray->size; n++) {
+        if (node_ident_key(iptr[n].key)) {
+            continue;
+        }
+        for (m = 0; m < cur->size; m++) {
+            if (PMIX_CHECK_KEY(&old[m], iptr[n].key)) {
+                PMIX_INFO_DESTRUCT(&old[m]);
+                for (k = m + 1; k < cur->size; k++) {
+                    memcpy(&old[k - 1], &old[k], sizeof(pmix_info_t));
+                }
+                --cur->size;
+                PMIX_INFO_CONSTRUCT(&old[cur->size]);
+                break;
+            }
+        }
+    }
+}
+
 static void _register_resources(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
-    pmix_kval_t *kv;
+    pmix_kval_t *kv, *nd, *dkv;
+    pmix_namespace_t *ns;
+    pmix_data_array_t *delta;
+    pmix_proc_t proc;
     size_t n;
-    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_status_t rc = PMIX_SUCCESS, ret;
 
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
@@ -1512,7 +2347,44 @@ static void _register_resources(int sd, short args, void *cbdata)
             PMIX_RELEASE(kv);
             break;
         }
-        pmix_list_append(&pmix_server_globals.gdata, &kv->super);
+        if (!PMIX_CHECK_KEY(kv, PMIX_NODE_INFO_ARRAY)
+            || NULL == (nd = find_node_resource(kv->value))) {
+            /* something new */
+            pmix_list_append(&pmix_server_globals.gdata, &kv->super);
+            PMIX_RETAIN(kv);
+            dkv = kv;
+        } else {
+            /* an update to a node we already have */
+            rc = merge_node_resource(nd, kv->value, &delta);
+            PMIX_RELEASE(kv);
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            if (NULL == delta) {
+                continue;
+            }
+            dkv = PMIX_NEW(pmix_kval_t);
+            dkv->key = strdup(PMIX_NODE_INFO_ARRAY);
+            PMIX_VALUE_CREATE(dkv->value, 1);
+            dkv->value->type = PMIX_DATA_ARRAY;
+            dkv->value->data.darray = delta;
+        }
+        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+            if (PMIX_CHECK_KEY(dkv, PMIX_NODE_INFO_ARRAY)) {
+                /* patch the node table of jobs we already hold -
+                 * the gds merges the array into the node it names */
+                PMIX_LOAD_PROCID(&proc, ns->nspace, PMIX_RANK_WILDCARD);
+                PMIX_GDS_STORE_KV(ret, pmix_globals.mypeer, &proc, PMIX_INTERNAL, dkv);
+                if (PMIX_SUCCESS != ret) {
+                    pmix_output_verbose(2, pmix_server_globals.base_output,
+                                        "pmix:server cannot update node info of %s: %s",
+                                        ns->nspace, PMIx_Error_string(ret));
+                }
+            }
+            /* let the clients already running see it without asking */
+            pmix_gds_base_update_job_info(ns->nspace, dkv);
+        }
+        PMIX_RELEASE(dkv);
     }
 
     cd->opcbfunc(rc, cd->cbdata);
@@ -1535,7 +2407,7 @@ pmix_status_t PMIx_server_register_resources(pmix_info_t info[], size_t ninfo,
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     cd->info = info;
     cd->ninfo = ninfo;
     cd->opcbfunc = cbfunc;
@@ -1573,6 +2445,14 @@ static void _deregister_resources(int sd, short args, void *cbdata)
 
     /* find any matches in our global cache and remove them */
     for (n = 0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_NODE_INFO_ARRAY)) {
+            /* only the node it names */
+            kv = find_node_resource(&cd->info[n].value);
+            if (NULL != kv) {
+                strip_node_resource(kv, &cd->info[n].value);
+            }
+            continue;
+        }
         PMIX_LIST_FOREACH (kv, &pmix_server_globals.gdata, pmix_kval_t) {
             if (PMIX_CHECK_KEY(kv, cd->info[n].key)) {
                 pmix_list_remove_item(&pmix_server_globals.gdata, &kv->super);
@@ -1602,7 +2482,7 @@ pmix_status_t PMIx_server_deregister_resources(pmix_info_t info[], size_t ninfo,
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     cd->info = info;
     cd->ninfo = ninfo;
     cd->opcbfunc = cbfunc;
@@ -1652,6 +2532,26 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     PMIX_ACQUIRE_OBJECT(tcd);
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
+    /* if every participant turned out to be one of our clients, then
+     * there is nobody else to hear from and the host need not be
+     * involved - the callbacks thread-shift, so they can be called
+     * directly from here */
+    if (trk->local) {
+        if (PMIX_FENCENB_CMD == trk->type && pmix_server_globals.fence_localonly_opt) {
+            trk->host_called = false;
+            rc = trk->info[trk->ninfo - 1].value.data.status;
+            trk->modexcbfunc(rc, NULL, 0, trk, NULL, NULL);
+            PMIX_RELEASE(tcd);
+            return;
+        }
+        if (PMIX_CONNECTNB_CMD == trk->type || PMIX_DISCONNECTNB_CMD == trk->type) {
+            trk->host_called = false;
+            trk->op_cbfunc(PMIX_SUCCESS, trk);
+            PMIX_RELEASE(tcd);
+            return;
+        }
+    }
+
     /* we don't need to check for non-NULL APIs here as
      * that was already done when the tracker was created */
     if (PMIX_FENCENB_CMD == trk->type) {
@@ -1734,6 +2634,9 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
                         return;
                     }
                     PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
+                        if (!pmix_server_trk_collects(trk, kv->key)) {
+                            continue;
+                        }
                         PMIX_BFROPS_PACK(rc, peer, &pbkt, kv, 1, PMIX_KVAL);
                         if (PMIX_SUCCESS != rc) {
                             PMIX_ERROR_LOG(rc);
@@ -1763,8 +2666,12 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
         }
         PMIX_UNLOAD_BUFFER(&bucket, data, sz);
         PMIX_DESTRUCT(&bucket);
-        pmix_host_server.fence_nb(trk->pcs, trk->npcs, trk->info, trk->ninfo, data, sz,
-                                  trk->modexcbfunc, trk);
+        rc = pmix_host_server.fence_nb(trk->pcs, trk->npcs, trk->info, trk->ninfo, data, sz,
+                                       trk->modexcbfunc, trk);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc && NULL != data) {
+            /* the host did not take the data */
+            free(data);
+        }
     } else if (PMIX_CONNECTNB_CMD == trk->type) {
         pmix_host_server.connect(trk->pcs, trk->npcs, trk->info, trk->ninfo, trk->op_cbfunc, trk);
     } else if (PMIX_DISCONNECTNB_CMD == trk->type) {
@@ -1773,7 +2680,7 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     } else {
         /* unknown type */
         PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
     }
     PMIX_RELEASE(tcd);
@@ -1833,6 +2740,7 @@ static void _register_client(int sd, short args, void *cbdata)
     info->gid = cd->gid;
     info->server_object = cd->server_object;
     pmix_list_append(&nptr->ranks, &info->super);
+    pmix_server_snapshot_client(&cd->proc, cd->uid, cd->gid);
     /* see if we have everyone - note that nlocalprocs is set to
      * a default value to ensure we don't execute this
      * test until the host calls "register_nspace" */
@@ -1894,6 +2802,9 @@ static void _register_client(int sd, short args, void *cbdata)
             }
             /* update this tracker's status */
             trk->def_complete = all_def;
+            if (trk->def_complete) {
+                trk->local = pmix_server_trk_all_local(trk);
+            }
             /* is this now locally completed? */
             if (trk->def_complete && pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
                 /* it did, so now we need to process it
@@ -1910,6 +2821,8 @@ static void _register_client(int sd, short args, void *cbdata)
         pmix_pending_nspace_requests(nptr);
     }
     rc = PMIX_SUCCESS;
+    /* if this client connected before we knew about it, it can proceed now */
+    pmix_ptl_base_release_held_connections(cd->proc.nspace);
 
 cleanup:
     /* let the caller know we are done */
@@ -1935,7 +2848,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_client(const pmix_proc_t *proc, u
     pmix_output_verbose(2, pmix_server_globals.base_output, "pmix:server register client %s:%d",
                         proc->nspace, proc->rank);
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -1998,6 +2911,9 @@ static void _deregister_client(int sd, short args, void *cbdata)
     /* find and remove this client */
     PMIX_LIST_FOREACH (info, &nptr->ranks, pmix_rank_info_t) {
         if (info->pname.rank == cd->proc.rank) {
+            pmix_server_snapshot_client_delete(&cd->proc);
+            /* data it published for its own lifetime is now gone */
+            pmix_server_pubsub_purge(&cd->proc);
             /* if this client failed to call finalize, we still need
              * to restore any allocations that were given to it */
             peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, info->peerid);
@@ -2033,7 +2949,7 @@ static void _deregister_client(int sd, short args, void *cbdata)
                 /* ensure we close the socket to this peer so we don't
                  * generate "connection lost" events should it be
                  * subsequently "killed" by the host */
-                CLOSE_THE_SOCKET(peer->sd);
+                pmix_ptl_base_close_peer(peer);
             }
             if (nptr->nlocalprocs == nptr->nfinalized) {
                 pmix_pnet.local_app_finalized(nptr);
@@ -2068,7 +2984,7 @@ PMIX_EXPORT void PMIx_server_deregister_client(const pmix_proc_t *proc, pmix_op_
     pmix_output_verbose(2, pmix_server_globals.base_output, "pmix:server deregister client %s:%d",
                         proc->nspace, proc->rank);
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         if (NULL != cbfunc) {
             cbfunc(PMIX_ERR_NOMEM, cbdata);
@@ -2098,12 +3014,29 @@ PMIX_EXPORT void PMIx_server_deregister_client(const pmix_proc_t *proc, pmix_op_
 }
 
 /* setup the envars for a child process */
+/* get the contribution of a framework - modules only ever add
+ * to the environment, so collect theirs separately and merge it */
+static pmix_status_t setup_fork_contrib(pmix_env_builder_t *bld, const pmix_proc_t *proc,
+                                        pmix_status_t (*fn)(const pmix_proc_t *proc, char ***env))
+{
+    char **adds = NULL;
+    pmix_status_t rc;
+
+    rc = fn(proc, &adds);
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_env_builder_merge(bld, adds, true);
+    }
+    pmix_argv_free(adds);
+    return rc;
+}
+
 PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char ***env)
 {
     char rankstr[128];
     pmix_listener_t *lt;
     pmix_status_t rc;
-    char **varnames;
+    pmix_env_builder_t bld;
+    char **varnames, **result, *value;
     int n;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
@@ -2116,71 +3049,91 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:server setup_fork for nspace %s rank %u", proc->nspace, proc->rank);
 
+    /* the real environ can't be taken apart - just add to it */
+    PMIX_CONSTRUCT(&bld, pmix_env_builder_t);
+    if (environ != *env) {
+        rc = pmix_env_builder_load(&bld, *env);
+        *env = NULL;
+        if (PMIX_SUCCESS != rc) {
+            goto done;
+        }
+    }
+
     /* pass the nspace */
-    pmix_setenv("PMIX_NAMESPACE", proc->nspace, true, env);
+    pmix_env_builder_set(&bld, "PMIX_NAMESPACE", proc->nspace, true);
     /* pass the rank */
     (void) pmix_snprintf(rankstr, 127, "%u", proc->rank);
-    pmix_setenv("PMIX_RANK", rankstr, true, env);
+    pmix_env_builder_set(&bld, "PMIX_RANK", rankstr, true);
     /* pass our rendezvous info */
     lt = &pmix_ptl_base.listener;
     if (NULL != lt->uri && NULL != lt->varname) {
         varnames = pmix_argv_split(lt->varname, ':');
         for (n = 0; NULL != varnames[n]; n++) {
-            pmix_setenv(varnames[n], lt->uri, true, env);
+            pmix_env_builder_set(&bld, varnames[n], lt->uri, true);
         }
         pmix_argv_free(varnames);
     }
 
     /* pass our active security modules */
-    pmix_setenv("PMIX_SECURITY_MODE", security_mode, true, env);
+    pmix_env_builder_set(&bld, "PMIX_SECURITY_MODE", security_mode, true);
     /* pass the type of buffer we are using */
     if (PMIX_BFROP_BUFFER_FULLY_DESC == pmix_globals.mypeer->nptr->compat.type) {
-        pmix_setenv("PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_FULLY_DESC", true, env);
+        pmix_env_builder_set(&bld, "PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_FULLY_DESC", true);
     } else {
-        pmix_setenv("PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_NON_DESC", true, env);
+        pmix_env_builder_set(&bld, "PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_NON_DESC", true);
     }
     /* pass our available gds modules */
-    pmix_setenv("PMIX_GDS_MODULE", gds_mode, true, env);
+    pmix_env_builder_set(&bld, "PMIX_GDS_MODULE", gds_mode, true);
 
     /* get any PTL contribution such as tmpdir settings for session files */
-    if (PMIX_SUCCESS != (rc = pmix_ptl_base_setup_fork(proc, env))) {
+    if (PMIX_SUCCESS != (rc = setup_fork_contrib(&bld, proc, pmix_ptl_base_setup_fork))) {
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto done;
     }
 
     /* get any network contribution */
-    if (PMIX_SUCCESS != (rc = pmix_pnet.setup_fork(proc, env))) {
+    if (PMIX_SUCCESS != (rc = setup_fork_contrib(&bld, proc, pmix_pnet.setup_fork))) {
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto done;
     }
 
     /* get any GDS contributions */
-    if (PMIX_SUCCESS != (rc = pmix_gds_base_setup_fork(proc, env))) {
+    if (PMIX_SUCCESS != (rc = setup_fork_contrib(&bld, proc, pmix_gds_base_setup_fork))) {
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto done;
     }
 
     /* get any contribution for the specific programming
      * model/implementation, if known */
-    if (PMIX_SUCCESS != (rc = pmix_pmdl.setup_fork(proc, env))) {
+    if (PMIX_SUCCESS != (rc = setup_fork_contrib(&bld, proc, pmix_pmdl.setup_fork))) {
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto done;
     }
 
     /* ensure we agree on our hostname */
-    pmix_setenv("PMIX_HOSTNAME", pmix_globals.hostname, true, env);
+    pmix_env_builder_set(&bld, "PMIX_HOSTNAME", pmix_globals.hostname, true);
 
     /* communicate our version */
-    pmix_setenv("PMIX_VERSION", PMIX_VERSION, true, env);
+    pmix_env_builder_set(&bld, "PMIX_VERSION", PMIX_VERSION, true);
 
-    /* pass any global contributions */
-    if (NULL != pmix_server_globals.genvars) {
-        for (n = 0; NULL != pmix_server_globals.genvars[n]; n++) {
-            pmix_argv_append_nosize(env, pmix_server_globals.genvars[n]);
-        }
-    }
+    /* pass any global contributions - these never replaced
+     * a value that was already set */
+    rc = pmix_env_builder_merge(&bld, pmix_server_globals.genvars, false);
 
-    return PMIX_SUCCESS;
+done:
+    result = pmix_env_builder_finalize(&bld);
+    PMIX_DESTRUCT(&bld);
+    if (environ == *env) {
+        for (n = 0; NULL != result && NULL != result[n]; n++) {
+            value = strchr(result[n], '=');
+            *value = '\0';
+            setenv(result[n], value + 1, 1);
+        }
+        pmix_argv_free(result);
+    } else {
+        *env = result;
+    }
+    return rc;
 }
 
 /***************************************************************************************************
@@ -2340,7 +3293,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_dmodex_request(const pmix_proc_t *proc,
                         "%s pmix:server dmodex request for proc %s",
                         PMIX_NAME_PRINT(&pmix_globals.myid), PMIX_NAME_PRINT(proc));
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     pmix_strncpy(cd->proc.nspace, proc->nspace, PMIX_MAX_NSLEN);
     cd->proc.rank = proc->rank;
     cd->cbfunc = cbfunc;
@@ -2386,7 +3339,7 @@ PMIX_EXPORT pmix_status_t PMIx_Store_internal(const pmix_proc_t *proc, const cha
     }
 
     /* setup to thread shift this request */
-    cd = PMIX_NEW(pmix_shift_caddy_t);
+    cd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2439,6 +3392,22 @@ PMIX_EXPORT pmix_status_t PMIx_generate_ppn(const char *input, char **regexp)
     return pmix_preg.generate_ppn(input, regexp);
 }
 
+PMIX_EXPORT pmix_status_t PMIx_generate_ppn_ranks(const pmix_rank_t **ranks, const size_t *nranks,
+                                                  size_t nnodes, char **regexp)
+{
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == ranks || NULL == nranks || NULL == regexp) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    return pmix_preg.generate_ppn_ranks(ranks, nranks, nnodes, regexp);
+}
+
 static void _setup_op(pmix_status_t rc, void *cbdata)
 {
     pmix_setup_caddy_t *fcd = (pmix_setup_caddy_t *) cbdata;
@@ -2475,7 +3444,7 @@ static void _setup_app(int sd, short args, void *cbdata)
     }
 
     /* setup the return callback */
-    fcd = PMIX_NEW(pmix_setup_caddy_t);
+    fcd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == fcd) {
         rc = PMIX_ERR_NOMEM;
         PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
@@ -2530,7 +3499,7 @@ pmix_status_t PMIx_server_setup_application(const pmix_nspace_t nspace, pmix_inf
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
     /* need to threadshift this request */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2583,7 +3552,7 @@ pmix_status_t PMIx_server_setup_local_support(const pmix_nspace_t nspace, pmix_i
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
     /* need to threadshift this request */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2621,9 +3590,7 @@ static void _iofdeliver(int sd, short args, void *cbdata)
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
     pmix_iof_req_t *req;
     bool found = false;
-    pmix_iof_cache_t *iof;
     int i;
-    size_t n;
     pmix_status_t rc;
 
     PMIX_ACQUIRE_OBJECT(cd);
@@ -2662,33 +3629,7 @@ static void _iofdeliver(int sd, short args, void *cbdata)
         pmix_output_verbose(2, pmix_server_globals.iof_output,
                             "PMIx:SERVER caching IOF %d",
                             (int)cd->bo->size);
-        if (pmix_server_globals.max_iof_cache == pmix_list_get_size(&pmix_server_globals.iof)) {
-            /* remove the oldest cached message */
-            iof = (pmix_iof_cache_t *) pmix_list_remove_first(&pmix_server_globals.iof);
-            if (NULL != iof) {
-                PMIX_RELEASE(iof);
-            }
-        }
-        /* add this output to our cache so it is cached until someone
-         * registers to receive it */
-        iof = PMIX_NEW(pmix_iof_cache_t);
-        memcpy(&iof->source, cd->procs, sizeof(pmix_proc_t));
-        iof->channel = cd->channels;
-        /* copy the data */
-        PMIX_BYTE_OBJECT_CREATE(iof->bo, 1);
-        if (0 < cd->bo->size) {
-            iof->bo->bytes = (char *) malloc(cd->bo->size);
-            memcpy(iof->bo->bytes, cd->bo->bytes, cd->bo->size);
-        }
-        iof->bo->size = cd->bo->size;
-        if (0 < cd->ninfo) {
-            PMIX_INFO_CREATE(iof->info, cd->ninfo);
-            iof->ninfo = cd->ninfo;
-            for (n = 0; n < iof->ninfo; n++) {
-                PMIX_INFO_XFER(&iof->info[n], &cd->info[n]);
-            }
-        }
-        pmix_list_append(&pmix_server_globals.iof, &iof->super);
+        pmix_server_iof_cache_add(cd->procs, cd->channels, cd->bo, cd->info, cd->ninfo);
         rc = PMIX_SUCCESS;
     }
 
@@ -2715,7 +3656,7 @@ pmix_status_t PMIx_server_IOF_deliver(const pmix_proc_t *source, pmix_iof_channe
     pmix_status_t rc;
 
     /* need to threadshift this request */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2748,59 +3689,6 @@ pmix_status_t PMIx_server_IOF_deliver(const pmix_proc_t *source, pmix_iof_channe
     return PMIX_SUCCESS;
 }
 
-static void cirelease(void *cbdata)
-{
-    pmix_shift_caddy_t *cd = (pmix_shift_caddy_t *) cbdata;
-
-    PMIX_ACQUIRE_OBJECT(cd);
-
-    if (NULL != cd->info) {
-        PMIX_INFO_FREE(cd->info, cd->ninfo);
-    }
-    PMIX_RELEASE(cd);
-}
-
-static void clct(int sd, short args, void *cbdata)
-{
-    pmix_shift_caddy_t *cd = (pmix_shift_caddy_t*)cbdata;
-    pmix_list_t inventory;
-    pmix_data_array_t darray;
-    pmix_status_t rc;
-
-    PMIX_ACQUIRE_OBJECT(cd);
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-    PMIX_CONSTRUCT(&inventory, pmix_list_t);
-
-    /* collect the pnet inventory */
-    rc = pmix_pnet.collect_inventory(cd->directives, cd->ndirs, &inventory);
-    if (PMIX_SUCCESS != rc) {
-        goto report;
-    }
-
-    /* collect the pgpu inventory */
-    rc = pmix_pgpu.collect_inventory(cd->directives, cd->ndirs, &inventory);
-    if (PMIX_SUCCESS != rc) {
-        goto report;
-    }
-
-    /* convert list to an array of info */
-    rc = PMIx_Info_list_convert((void*)&inventory, &darray);
-    if (PMIX_ERR_EMPTY == rc) {
-        rc = PMIX_SUCCESS;
-    } else if (PMIX_SUCCESS == rc) {
-        cd->info = (pmix_info_t*)darray.array;
-        cd->ninfo = darray.size;
-    }
-
-report:
-    if (NULL != cd->cbfunc.infocbfunc) {
-        cd->cbfunc.infocbfunc(rc, cd->info, cd->ninfo, cd->cbdata, cirelease, cd);
-    }
-    PMIX_LIST_DESTRUCT(&inventory);
-    return;
-}
-
 pmix_status_t PMIx_server_collect_inventory(pmix_info_t directives[], size_t ndirs,
                                             pmix_info_cbfunc_t cbfunc, void *cbdata)
 {
@@ -2814,7 +3702,7 @@ pmix_status_t PMIx_server_collect_inventory(pmix_info_t directives[], size_t ndi
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
     /* need to threadshift this request */
-    cd = PMIX_NEW(pmix_shift_caddy_t);
+    cd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2822,7 +3710,7 @@ pmix_status_t PMIx_server_collect_inventory(pmix_info_t directives[], size_t ndi
     cd->ndirs = ndirs;
     cd->cbfunc.infocbfunc = cbfunc;
     cd->cbdata = cbdata;
-    PMIX_THREADSHIFT(cd, clct);
+    PMIX_THREADSHIFT(cd, pmix_server_inventory_collect);
 
     return PMIX_SUCCESS;
 }
@@ -2866,7 +3754,7 @@ pmix_status_t PMIx_server_deliver_inventory(pmix_info_t info[], size_t ninfo,
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
     /* need to threadshift this request */
-    cd = PMIX_NEW(pmix_shift_caddy_t);
+    cd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2961,13 +3849,30 @@ static void psetdef(int sd, short args, void *cbdata)
     PMIx_Notify_event(PMIX_PROCESS_SET_DEFINE, &pmix_globals.myid, PMIX_RANGE_LOCAL, mydat->info,
                       mydat->ninfo, release_info, (void *) mydat);
 
-    /* now record the process set */
+    /* now record the process set - redefining a set
+     * replaces the members it had before */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_server_globals.pset_names,
+                                                      cd->nspace, strlen(cd->nspace),
+                                                      (void **) &ps)) {
+        pmix_list_remove_item(&pmix_server_globals.psets, &ps->super);
+        PMIX_RELEASE(ps);
+    }
     ps = PMIX_NEW(pmix_pset_t);
     ps->name = strdup(cd->nspace);
-    ps->members = (pmix_proc_t *) malloc(cd->nprocs * sizeof(pmix_proc_t));
-    memcpy(ps->members, cd->procs, cd->nprocs * sizeof(pmix_proc_t));
-    ps->nmembers = cd->nprocs;
+    if (PMIX_SUCCESS != pmix_server_pset_load(ps, cd->procs, cd->nprocs)) {
+        PMIX_RELEASE(ps);
+        pmix_hash_table_remove_value_ptr(&pmix_server_globals.pset_names,
+                                         cd->nspace, strlen(cd->nspace));
+        cd->lock.status = PMIX_ERR_NOMEM;
+        pmix_server_query_flush();
+        PMIX_WAKEUP_THREAD(&cd->lock);
+        return;
+    }
     pmix_list_append(&pmix_server_globals.psets, &ps->super);
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.pset_names, ps->name,
+                                  strlen(ps->name), ps);
+    pmix_server_snapshot_pset(cd->nspace, cd->procs, cd->nprocs);
+    pmix_server_query_flush();
 
     PMIX_WAKEUP_THREAD(&cd->lock);
 }
@@ -3025,13 +3930,16 @@ static void psetdel(int sd, short args, void *cbdata)
                       mydat->ninfo, release_info, (void *) mydat);
 
     /* now find this process set */
-    PMIX_LIST_FOREACH (ps, &pmix_server_globals.psets, pmix_pset_t) {
-        if (0 == strcmp(cd->nspace, ps->name)) {
-            pmix_list_remove_item(&pmix_server_globals.psets, &ps->super);
-            PMIX_RELEASE(ps);
-            break;
-        }
-    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_server_globals.pset_names,
+                                                      cd->nspace, strlen(cd->nspace),
+                                                      (void **) &ps)) {
+        pmix_hash_table_remove_value_ptr(&pmix_server_globals.pset_names,
+                                         cd->nspace, strlen(cd->nspace));
+        pmix_list_remove_item(&pmix_server_globals.psets, &ps->super);
+        PMIX_RELEASE(ps);
+        pmix_server_snapshot_pset_delete(cd->nspace);
+    }
+    pmix_server_query_flush();
     PMIX_WAKEUP_THREAD(&cd->lock);
 }
 
@@ -3219,7 +4127,7 @@ static void spawn_cbfunc(pmix_status_t status, char *nspace, void *cbdata)
     pmix_shift_caddy_t *cd;
 
     /* need to thread-shift this request */
-    cd = PMIX_NEW(pmix_shift_caddy_t);
+    cd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     cd->status = status;
     if (NULL != nspace) {
         cd->pname.nspace = strdup(nspace);
@@ -3264,15 +4172,164 @@ static void lookup_cbfunc(pmix_status_t status, pmix_pdata_t pdata[], size_t nda
         }
     }
 
-    /* the function that created the server_caddy did a
-     * retain on the peer, so we don't have to worry about
-     * it still being present - tell the originator the result */
-    PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_RELEASE(reply);
+    /* the function that created the server_caddy did a
+     * retain on the peer, so we don't have to worry about
+     * it still being present - tell the originator the result */
+    PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(reply);
+    }
+    /* cleanup */
+    PMIX_RELEASE(cd);
+}
+
+/* add the data posted by the given remote proc to the list of
+ * blobs, packed exactly as _satisfy_request would return it
+ * to the peer in the provided caddy */
+static pmix_status_t _add_modex_blob(pmix_list_t *blobs, const char *nspace,
+                                     pmix_rank_t rank, pmix_server_caddy_t *cd)
+{
+    pmix_modex_shmem_blob_t *bl;
+    pmix_buffer_t pkt, xfer;
+    pmix_byte_object_t bo;
+    pmix_proc_t proc;
+    pmix_cb_t cb;
+    pmix_status_t rc;
+
+    PMIX_LOAD_PROCID(&proc, nspace, rank);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &proc;
+    cb.scope = PMIX_REMOTE;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&cb);
+        /* nothing was posted by this proc */
+        return PMIX_SUCCESS;
+    }
+    PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
+    PMIX_GDS_ASSEMB_KVS_REQ(rc, cd->peer, &proc, &cb.kvs, &pkt, cd);
+    PMIX_DESTRUCT(&cb);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&pkt);
+        return rc;
+    }
+    bo.bytes = (char *) pkt.unpack_ptr;
+    bo.size = pkt.bytes_used;
+    PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, cd->peer, &xfer, &bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_DESTRUCT(&pkt);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&xfer);
+        return rc;
+    }
+    bl = PMIX_NEW(pmix_modex_shmem_blob_t);
+    if (NULL == bl) {
+        PMIX_DESTRUCT(&xfer);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LOAD_PROCID(&bl->proc, nspace, rank);
+    PMIX_UNLOAD_BUFFER(&xfer, bl->blob.bytes, bl->blob.size);
+    PMIX_DESTRUCT(&xfer);
+    pmix_list_append(blobs, &bl->super);
+    return PMIX_SUCCESS;
+}
+
+/* publish the collected data of all fence participants that are
+ * not local to us in a shared-memory segment for the local clients
+ * in the nspace of the given caddy's peer */
+static pmix_status_t _publish_modex(pmix_server_trkr_t *trk, pmix_server_caddy_t *cd,
+                                    char **path)
+{
+    pmix_namespace_t *ns, *nptr;
+    pmix_rank_info_t *info;
+    pmix_list_t blobs;
+    pmix_rank_t rank, first, last;
+    pmix_status_t rc = PMIX_SUCCESS;
+    bool local;
+    size_t n;
+
+    *path = NULL;
+    PMIX_CONSTRUCT(&blobs, pmix_list_t);
+    for (n = 0; n < trk->npcs && PMIX_SUCCESS == rc; n++) {
+        nptr = NULL;
+        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+            if (PMIX_CHECK_NSPACE(ns->nspace, trk->pcs[n].nspace)) {
+                nptr = ns;
+                break;
+            }
+        }
+        if (PMIX_RANK_WILDCARD == trk->pcs[n].rank) {
+            if (NULL == nptr) {
+                /* we cannot know the membership */
+                continue;
+            }
+            first = 0;
+            last = nptr->nprocs;
+        } else {
+            first = trk->pcs[n].rank;
+            last = first + 1;
+        }
+        for (rank = first; rank < last && PMIX_SUCCESS == rc; rank++) {
+            /* local procs are not part of the collected data */
+            local = false;
+            if (NULL != nptr) {
+                PMIX_LIST_FOREACH (info, &nptr->ranks, pmix_rank_info_t) {
+                    if (info->pname.rank == rank) {
+                        local = true;
+                        break;
+                    }
+                }
+            }
+            if (!local) {
+                rc = _add_modex_blob(&blobs, trk->pcs[n].nspace, rank, cd);
+            }
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_modex_shmem_publish(cd->peer->nptr->nspace, pmix_server_globals.tmpdir,
+                                      &blobs, path);
+    }
+    PMIX_LIST_DESTRUCT(&blobs);
+    return rc;
+}
+
+/* return the path of the segment holding the collected data for the
+ * nspace of the given caddy's peer, publishing it on first use. The
+ * list caches the outcome per nspace for the duration of the modex
+ * callback, including when there was nothing to publish */
+static char *_modex_segment(pmix_server_trkr_t *trk, pmix_server_caddy_t *cd,
+                            pmix_list_t *segs)
+{
+    pmix_kval_t *kv;
+    char *path;
+    pmix_status_t rc;
+
+    PMIX_LIST_FOREACH (kv, segs, pmix_kval_t) {
+        if (PMIX_CHECK_NSPACE(kv->key, cd->peer->nptr->nspace)) {
+            return (PMIX_STRING == kv->value->type) ? kv->value->data.string : NULL;
+        }
     }
-    /* cleanup */
-    PMIX_RELEASE(cd);
+    PMIX_KVAL_NEW(kv, cd->peer->nptr->nspace);
+    if (NULL == kv) {
+        return NULL;
+    }
+    PMIX_VALUE_CONSTRUCT(kv->value);
+    pmix_list_append(segs, &kv->super);
+    rc = _publish_modex(trk, cd, &path);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_VALUE_LOAD(kv->value, path, PMIX_STRING);
+        free(path);
+        return kv->value->data.string;
+    }
+    if (PMIX_ERR_NOT_FOUND != rc) {
+        pmix_output_verbose(2, pmix_server_globals.fence_output,
+                            "server:modex_cbfunc could not publish modex for %s: %s",
+                            cd->peer->nptr->nspace, PMIx_Error_string(rc));
+    }
+    return NULL;
 }
 
 /* fence modex calls return here when the host RM has completed
@@ -3284,12 +4341,14 @@ static void _mdxcbfunc(int sd, short args, void *cbdata)
 {
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t *) cbdata;
     pmix_server_trkr_t *tracker = scd->tracker;
-    pmix_buffer_t xfer, *reply;
+    pmix_buffer_t xfer, *reply, *last = NULL;
     pmix_server_caddy_t *cd, *nxt;
+    pmix_peer_t *lastpeer;
     pmix_status_t rc = PMIX_SUCCESS, ret;
     pmix_nspace_caddy_t *nptr;
-    pmix_list_t nslist;
-    bool found;
+    pmix_list_t nslist, mdxsegs;
+    char *mdxpath, *lastpath;
+    bool found, collected = false;
 
     PMIX_ACQUIRE_OBJECT(scd);
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
@@ -3306,15 +4365,17 @@ static void _mdxcbfunc(int sd, short args, void *cbdata)
 
     /* if we get here, then there are processes waiting
      * for a response */
+    PMIX_TRACE3(fence_complete, tracker, scd->status, scd->ndata);
 
     /* if the timer is active, clear it */
     if (tracker->event_active) {
-        pmix_event_del(&tracker->ev);
+        pmix_timer_del(&tracker->timer);
     }
 
     /* pass the blobs being returned */
     PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
     PMIX_CONSTRUCT(&nslist, pmix_list_t);
+    PMIX_CONSTRUCT(&mdxsegs, pmix_list_t);
 
     if (PMIX_SUCCESS != scd->status) {
         rc = scd->status;
@@ -3361,19 +4422,59 @@ static void _mdxcbfunc(int sd, short args, void *cbdata)
             break;
         }
     }
+    collected = (PMIX_SUCCESS == rc);
+    if (collected) {
+        pmix_server_modex_collected(tracker);
+    }
 
 finish_collective:
-    /* loop across all procs in the tracker, sending them the reply */
+    /* loop across all procs in the tracker, sending them the reply. The
+     * reply is identical for every peer that speaks the same bfrops
+     * version and is pointed at the same modex segment, so pack it once
+     * and let each of those peers' send hold a reference to it */
+    lastpeer = NULL;
+    lastpath = NULL;
     PMIX_LIST_FOREACH_SAFE (cd, nxt, &tracker->local_cbs, pmix_server_caddy_t) {
-        reply = PMIX_NEW(pmix_buffer_t);
-        if (NULL == reply) {
-            break;
-        }
-        /* setup the reply, starting with the returned status */
-        PMIX_BFROPS_PACK(ret, cd->peer, reply, &rc, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-            goto cleanup;
+        /* if requested, point them at the collected data in shared
+         * memory - v1 clients expect the data in a different layout */
+        mdxpath = NULL;
+        if (collected && PMIX_SUCCESS == rc && pmix_server_globals.shmem_modex &&
+            !PMIX_PEER_IS_V1(cd->peer)) {
+            mdxpath = _modex_segment(tracker, cd, &mdxsegs);
+        }
+        if (NULL != last && mdxpath == lastpath &&
+            cd->peer->nptr->compat.bfrops == lastpeer->nptr->compat.bfrops &&
+            cd->peer->nptr->compat.type == lastpeer->nptr->compat.type) {
+            reply = last;
+            PMIX_RETAIN(reply);
+        } else {
+            reply = PMIX_NEW(pmix_buffer_t);
+            if (NULL == reply) {
+                break;
+            }
+            /* setup the reply, starting with the returned status */
+            PMIX_BFROPS_PACK(ret, cd->peer, reply, &rc, 1, PMIX_STATUS);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                PMIX_RELEASE(reply);
+                goto cleanup;
+            }
+            if (NULL != mdxpath) {
+                PMIX_BFROPS_PACK(ret, cd->peer, reply, &mdxpath, 1, PMIX_STRING);
+                if (PMIX_SUCCESS != ret) {
+                    PMIX_ERROR_LOG(ret);
+                    PMIX_RELEASE(reply);
+                    goto cleanup;
+                }
+            }
+            /* keep our own reference for the peers that follow */
+            if (NULL != last) {
+                PMIX_RELEASE(last);
+            }
+            PMIX_RETAIN(reply);
+            last = reply;
+            lastpeer = cd->peer;
+            lastpath = mdxpath;
         }
         pmix_output_verbose(2, pmix_server_globals.base_output,
                             "server:modex_cbfunc reply being sent to %s:%u",
@@ -3388,6 +4489,9 @@ finish_collective:
     }
 
 cleanup:
+    if (NULL != last) {
+        PMIX_RELEASE(last);
+    }
     /* Protect data from being free'd because RM pass
      * the pointer that is set to the middle of some
      * buffer (the case with SLURM).
@@ -3396,8 +4500,9 @@ cleanup:
     xfer.base_ptr = NULL;
     xfer.bytes_used = 0;
     PMIX_DESTRUCT(&xfer);
+    PMIX_LIST_DESTRUCT(&mdxsegs);
 
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_trk_remove(tracker);
     PMIX_RELEASE(tracker);
     PMIX_LIST_DESTRUCT(&nslist);
 
@@ -3418,7 +4523,7 @@ static void modex_cbfunc(pmix_status_t status, const char *data, size_t ndata, v
                         "server:modex_cbfunc called with %d bytes", (int) ndata);
 
     /* need to thread-shift this callback as it accesses global data */
-    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == scd) {
         /* nothing we can do */
         if (NULL != relfn) {
@@ -3470,13 +4575,24 @@ static void get_cbfunc(pmix_status_t status, const char *data, size_t ndata, voi
         PMIX_ERROR_LOG(rc);
         goto cleanup;
     }
-    /* pack the blob being returned */
-    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
-    PMIX_LOAD_BUFFER(cd->peer, &buf, data, ndata);
-    PMIX_BFROPS_COPY_PAYLOAD(rc, cd->peer, reply, &buf);
-    buf.base_ptr = NULL;
-    buf.bytes_used = 0;
-    PMIX_DESTRUCT(&buf);
+    /* pack the blob being returned - if we were given a way to
+     * release it, it can be sent from where it is */
+    if (0 < ndata && NULL != relfn) {
+        rc = pmix_bfrops_base_buffer_chain(reply, (char *) data, ndata, relfn, relcbd);
+        /* the reply releases it from now on */
+        relfn = NULL;
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    } else {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(cd->peer, &buf, data, ndata);
+        PMIX_BFROPS_COPY_PAYLOAD(rc, cd->peer, reply, &buf);
+        buf.base_ptr = NULL;
+        buf.bytes_used = 0;
+        PMIX_DESTRUCT(&buf);
+    }
     /* send the data to the requestor */
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "server:get_cbfunc reply being sent to %s:%u", cd->peer->info->pname.nspace,
@@ -3497,20 +4613,61 @@ cleanup:
     PMIX_RELEASE(cd);
 }
 
+/* fetch the job-level info for the given nspace and pack it, along
+ * with the nspace name, in the form expected by the given peer */
+static pmix_status_t pack_cnct_nspace(pmix_peer_t *peer, char *nspace,
+                                      pmix_buffer_t *pbkt)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_cb_t cb;
+    pmix_kval_t *kptr;
+
+    PMIX_LOAD_PROCID(&proc, nspace, PMIX_RANK_WILDCARD);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    /* this is for a local client, so give the gds the
+     * option of returning a complete copy of the data,
+     * or returning a pointer to local storage */
+    cb.proc = &proc;
+    cb.scope = PMIX_SCOPE_UNDEF;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, peer, &cb);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    /* pack the nspace name */
+    PMIX_BFROPS_PACK(rc, peer, pbkt, &nspace, 1, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    PMIX_LIST_FOREACH (kptr, &cb.kvs, pmix_kval_t) {
+        PMIX_BFROPS_PACK(rc, peer, pbkt, kptr, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&cb);
+            return rc;
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    return PMIX_SUCCESS;
+}
+
 static void _cnct(int sd, short args, void *cbdata)
 {
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t *) cbdata;
     pmix_server_trkr_t *tracker = scd->tracker;
     pmix_buffer_t *reply, pbkt;
-    pmix_byte_object_t bo;
+    pmix_byte_object_t *blobs = NULL;
+    pmix_peer_t *packed = NULL;
     pmix_status_t rc;
-    int i;
+    int i, nns;
     pmix_server_caddy_t *cd;
     char **nspaces = NULL;
     bool found;
-    pmix_proc_t proc;
-    pmix_cb_t cb;
-    pmix_kval_t *kptr;
 
     PMIX_ACQUIRE_OBJECT(scd);
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
@@ -3525,7 +4682,7 @@ static void _cnct(int sd, short args, void *cbdata)
 
     /* if the timer is active, clear it */
     if (tracker->event_active) {
-        pmix_event_del(&tracker->ev);
+        pmix_timer_del(&tracker->timer);
     }
 
     /* find the unique nspaces that are participating */
@@ -3545,6 +4702,22 @@ static void _cnct(int sd, short args, void *cbdata)
             }
         }
     }
+    nns = pmix_argv_count(nspaces);
+
+    /* the job info of each nspace is the same for every local proc
+     * that speaks the same protocol, so we only fetch and pack it
+     * once and then reuse the packed blob for every reply. Connecting
+     * many nspaces at a time would otherwise repeat this work for
+     * every nspace in every reply */
+    if (PMIX_SUCCESS == scd->status && 0 < nns) {
+        blobs = (pmix_byte_object_t *) calloc(nns, sizeof(pmix_byte_object_t));
+        if (NULL == blobs) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+            rc = PMIX_ERR_NOMEM;
+            cd = (pmix_server_caddy_t *) pmix_list_get_first(&tracker->local_cbs);
+            goto error;
+        }
+    }
 
     /* loop across all local procs in the tracker, sending them the reply */
     PMIX_LIST_FOREACH (cd, &tracker->local_cbs, pmix_server_caddy_t) {
@@ -3563,6 +4736,16 @@ static void _cnct(int sd, short args, void *cbdata)
             goto cleanup;
         }
         if (PMIX_SUCCESS == scd->status) {
+            /* if this proc doesn't share the protocol of the one
+             * the cached blobs were packed for, then start over */
+            if (NULL != packed &&
+                (packed->nptr->compat.bfrops != cd->peer->nptr->compat.bfrops ||
+                 packed->nptr->compat.gds != cd->peer->nptr->compat.gds)) {
+                for (i = 0; i < nns; i++) {
+                    PMIX_BYTE_OBJECT_DESTRUCT(&blobs[i]);
+                }
+                packed = NULL;
+            }
             /* loop across all participating nspaces and include their
              * job-related info */
             for (i = 0; NULL != nspaces[i]; i++) {
@@ -3572,69 +4755,42 @@ static void _cnct(int sd, short args, void *cbdata)
                     continue;
                 }
 
-                /* this is a local request, so give the gds the option
-                 * of returning a copy of the data, or a pointer to
-                 * local storage */
-                /* add the job-level info, if necessary */
-                PMIX_LOAD_PROCID(&proc, nspaces[i], PMIX_RANK_WILDCARD);
-                PMIX_CONSTRUCT(&cb, pmix_cb_t);
-                /* this is for a local client, so give the gds the
-                 * option of returning a complete copy of the data,
-                 * or returning a pointer to local storage */
-                cb.proc = &proc;
-                cb.scope = PMIX_SCOPE_UNDEF;
-                cb.copy = false;
-                PMIX_GDS_FETCH_KV(rc, cd->peer, &cb);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(reply);
-                    PMIX_DESTRUCT(&cb);
-                    goto error;
-                }
-                PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
-                /* pack the nspace name */
-                PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &nspaces[i], 1, PMIX_STRING);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(reply);
-                    PMIX_DESTRUCT(&pbkt);
-                    PMIX_DESTRUCT(&cb);
-                    goto error;
-                }
-                PMIX_LIST_FOREACH (kptr, &cb.kvs, pmix_kval_t) {
-                    PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, kptr, 1, PMIX_KVAL);
+                if (PMIX_PEER_IS_V1(cd->peer) || PMIX_PEER_IS_V20(cd->peer)) {
+                    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+                    rc = pack_cnct_nspace(cd->peer, nspaces[i], &pbkt);
                     if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
                         PMIX_RELEASE(reply);
                         PMIX_DESTRUCT(&pbkt);
-                        PMIX_DESTRUCT(&cb);
                         goto error;
                     }
-                }
-                PMIX_DESTRUCT(&cb);
-
-                if (PMIX_PEER_IS_V1(cd->peer) || PMIX_PEER_IS_V20(cd->peer)) {
                     PMIX_BFROPS_PACK(rc, cd->peer, reply, &pbkt, 1, PMIX_BUFFER);
+                    PMIX_DESTRUCT(&pbkt);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
                         PMIX_RELEASE(reply);
-                        PMIX_DESTRUCT(&pbkt);
-                        PMIX_DESTRUCT(&cb);
                         goto error;
                     }
-                } else {
-                    PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
-                    PMIX_BFROPS_PACK(rc, cd->peer, reply, &bo, 1, PMIX_BYTE_OBJECT);
+                    continue;
+                }
+
+                if (NULL == blobs[i].bytes) {
+                    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+                    rc = pack_cnct_nspace(cd->peer, nspaces[i], &pbkt);
                     if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
                         PMIX_RELEASE(reply);
                         PMIX_DESTRUCT(&pbkt);
-                        PMIX_DESTRUCT(&cb);
                         goto error;
                     }
+                    PMIX_UNLOAD_BUFFER(&pbkt, blobs[i].bytes, blobs[i].size);
+                    PMIX_DESTRUCT(&pbkt);
+                    packed = cd->peer;
+                }
+                PMIX_BFROPS_PACK(rc, cd->peer, reply, &blobs[i], 1, PMIX_BYTE_OBJECT);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_RELEASE(reply);
+                    goto error;
                 }
-
-                PMIX_DESTRUCT(&pbkt);
             }
         }
         pmix_output_verbose(2, pmix_server_globals.connect_output,
@@ -3669,10 +4825,16 @@ error:
     }
 
 cleanup:
+    if (NULL != blobs) {
+        for (i = 0; i < nns; i++) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&blobs[i]);
+        }
+        free(blobs);
+    }
     if (NULL != nspaces) {
         pmix_argv_free(nspaces);
     }
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_trk_remove(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -3688,7 +4850,7 @@ static void cnct_cbfunc(pmix_status_t status, void *cbdata)
                         "server:cnct_cbfunc called");
 
     /* need to thread-shift this callback as it accesses global data */
-    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == scd) {
         /* nothing we can do */
         return;
@@ -3719,7 +4881,7 @@ static void _discnct(int sd, short args, void *cbdata)
 
     /* if the timer is active, clear it */
     if (tracker->event_active) {
-        pmix_event_del(&tracker->ev);
+        pmix_timer_del(&tracker->timer);
     }
 
     /* loop across all local procs in the tracker, sending them the reply */
@@ -3750,7 +4912,7 @@ static void _discnct(int sd, short args, void *cbdata)
 cleanup:
     /* cleanup the tracker -- the host RM is responsible for
      * telling us when to remove the nspace from our data */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_trk_remove(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -3767,7 +4929,7 @@ static void discnct_cbfunc(pmix_status_t status, void *cbdata)
                         (NULL == tracker) ? "NULL" : tracker->pname.nspace);
 
     /* need to thread-shift this callback as it accesses global data */
-    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == scd) {
         /* nothing we can do */
         return;
@@ -3887,22 +5049,16 @@ complete:
     }
 }
 
-static void query_cbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo, void *cbdata,
-                         pmix_release_cbfunc_t release_fn, void *release_cbdata)
+/* pack and queue one message of the answer to a query */
+static void send_query_reply(pmix_server_caddy_t *cd, pmix_status_t status, pmix_info_t *info,
+                             size_t ninfo)
 {
-    pmix_query_caddy_t *qcd = (pmix_query_caddy_t *) cbdata;
-    pmix_server_caddy_t *cd = (pmix_server_caddy_t *) qcd->cbdata;
     pmix_buffer_t *reply;
     pmix_status_t rc;
 
-    pmix_output_verbose(2, pmix_server_globals.base_output,
-                        "pmix:query callback with status %s",
-                        PMIx_Error_string(status));
-
     reply = PMIX_NEW(pmix_buffer_t);
     if (NULL == reply) {
         PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
-        PMIX_RELEASE(cd);
         return;
     }
     PMIX_BFROPS_PACK(rc, cd->peer, reply, &status, 1, PMIX_STATUS);
@@ -3923,14 +5079,119 @@ static void query_cbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo,
         }
     }
 
-    /* cache the data for any future requests */
-
 complete:
     // send reply
     PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
     if (PMIX_SUCCESS != rc) {
         PMIX_RELEASE(reply);
     }
+}
+
+/* size of the elements of the array types we split */
+static size_t chunk_elem_size(pmix_data_type_t type)
+{
+    switch (type) {
+    case PMIX_PROC_INFO:
+        return sizeof(pmix_proc_info_t);
+    case PMIX_PROC:
+        return sizeof(pmix_proc_t);
+    case PMIX_STRING:
+        return sizeof(char *);
+    case PMIX_INFO:
+        return sizeof(pmix_info_t);
+    default:
+        return 0;
+    }
+}
+
+/* send each large array in the answer as a series of batches of
+ * at most chunk elements, so that no single buffer has to hold
+ * all of it, and then the rest of the answer with the given status */
+static void send_query_chunked(pmix_server_caddy_t *cd, pmix_status_t status, pmix_info_t *info,
+                               size_t ninfo, size_t chunk)
+{
+    pmix_info_t *rest, slice;
+    pmix_data_array_t *darray, part;
+    size_t n, nrest = 0, off, esize;
+
+    /* shallow copies of the entries we don't split - they
+     * are only packed, never destructed */
+    rest = (pmix_info_t *) malloc(ninfo * sizeof(pmix_info_t));
+    if (NULL == rest) {
+        send_query_reply(cd, status, info, ninfo);
+        return;
+    }
+    for (n = 0; n < ninfo; n++) {
+        darray = info[n].value.data.darray;
+        if (PMIX_DATA_ARRAY != info[n].value.type || NULL == darray
+            || darray->size <= chunk || 0 == (esize = chunk_elem_size(darray->type))) {
+            memcpy(&rest[nrest], &info[n], sizeof(pmix_info_t));
+            ++nrest;
+            continue;
+        }
+        PMIX_LOAD_KEY(slice.key, info[n].key);
+        slice.flags = info[n].flags;
+        slice.value.type = PMIX_DATA_ARRAY;
+        slice.value.data.darray = &part;
+        part.type = darray->type;
+        for (off = 0; off < darray->size; off += chunk) {
+            part.size = (darray->size - off < chunk) ? darray->size - off : chunk;
+            part.array = (char *) darray->array + off * esize;
+            send_query_reply(cd, PMIX_QUERY_PARTIAL_SUCCESS, &slice, 1);
+        }
+    }
+    send_query_reply(cd, status, (0 == nrest) ? NULL : rest, nrest);
+    free(rest);
+}
+
+static void query_cbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo, void *cbdata,
+                         pmix_release_cbfunc_t release_fn, void *release_cbdata)
+{
+    pmix_query_caddy_t *qcd = (pmix_query_caddy_t *) cbdata;
+    pmix_server_caddy_t *cd = (pmix_server_caddy_t *) qcd->cbdata;
+    pmix_status_t rc;
+    size_t chunk;
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:query callback with status %s",
+                        PMIx_Error_string(status));
+
+    if (PMIX_QUERY_PARTIAL_SUCCESS == status
+        && !pmix_server_query_streamed(qcd->queries, qcd->nqueries)) {
+        /* hold the batch until we have the rest */
+        rc = pmix_server_query_append(&qcd->info, &qcd->ninfo, info, ninfo);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        if (NULL != release_fn) {
+            release_fn(release_cbdata);
+        }
+        return;
+    }
+    if (PMIX_QUERY_PARTIAL_SUCCESS != status && 0 < qcd->ninfo) {
+        /* the final answer includes the batches we held */
+        rc = pmix_server_query_append(&qcd->info, &qcd->ninfo, info, ninfo);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        info = qcd->info;
+        ninfo = qcd->ninfo;
+    }
+
+    chunk = pmix_server_query_chunk(qcd->queries, qcd->nqueries);
+    if (0 < chunk && 0 < ninfo) {
+        send_query_chunked(cd, status, info, ninfo, chunk);
+    } else {
+        send_query_reply(cd, status, info, ninfo);
+    }
+
+    if (PMIX_QUERY_PARTIAL_SUCCESS == status) {
+        /* streamed to the requestor - the rest is still to come */
+        if (NULL != release_fn) {
+            release_fn(release_cbdata);
+        }
+        return;
+    }
 
     // cleanup
     if (NULL != qcd->queries) {
@@ -4176,6 +5437,7 @@ static void _iofreg(int sd, short args, void *cbdata)
     pmix_status_t rc;
     pmix_iof_req_t *req;
     pmix_iof_cache_t *iof, *inxt;
+    pmix_byte_object_t bo;
 
     PMIX_ACQUIRE_OBJECT(cd);
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
@@ -4231,11 +5493,13 @@ static void _iofreg(int sd, short args, void *cbdata)
                                                              cd->ncodes);
         if (NULL != req) {
             PMIX_LIST_FOREACH_SAFE (iof, inxt, &pmix_server_globals.iof, pmix_iof_cache_t) {
+                if (!pmix_server_iof_cache_data(iof, &bo)) {
+                    continue;
+                }
                 if (PMIX_OPERATION_SUCCEEDED
-                    == pmix_iof_process_iof(iof->channel, &iof->source, iof->bo, iof->info,
+                    == pmix_iof_process_iof(iof->channel, &iof->source, &bo, iof->info,
                                             iof->ninfo, req)) {
-                    pmix_list_remove_item(&pmix_server_globals.iof, &iof->super);
-                    PMIX_RELEASE(iof);
+                    pmix_server_iof_cache_remove(iof);
                 }
             }
         }
@@ -4450,6 +5714,7 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
     pmix_output_verbose(2, pmix_server_globals.base_output, "recvd pmix cmd %s from %s:%u bytes %u",
                         pmix_command_string(cmd), peer->info->pname.nspace, peer->info->pname.rank,
                         (unsigned int) buf->bytes_used);
+    pmix_server_stats_request(peer, tag, cmd);
 
     /* if I am a tool, all I can do is relay this to my primary server
      * if I am connected - if not connected, then I must return an error */
@@ -4466,28 +5731,10 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
      * function for processing */
 
     if (PMIX_REQ_CMD == cmd) {
-        reply = PMIX_NEW(pmix_buffer_t);
-        if (NULL == reply) {
-            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
-            return PMIX_ERR_NOMEM;
-        }
-        PMIX_GDS_REGISTER_JOB_INFO(rc, peer, reply);
+        rc = pmix_server_job_info(peer, &reply);
         if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(reply);
             return rc;
         }
-        /* if the peer is using the "dstore" component, then
-         * we also have to send back any session/node/app-level
-         * info so it can be stored locally in their hash */
-        if (0 != strcmp("hash", peer->nptr->compat.gds->name)) {
-            PMIX_GDS_FETCH_INFO_ARRAYS(rc, peer, reply);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(reply);
-                return rc;
-            }
-        }
         PMIX_SERVER_QUEUE_REPLY(rc, peer, tag, reply);
         if (PMIX_SUCCESS != rc) {
             PMIX_RELEASE(reply);
@@ -4540,11 +5787,18 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
         return rc;
     }
 
+    if (PMIX_GET_BATCH_CMD == cmd) {
+        PMIX_GDS_CADDY(cd, peer, tag);
+        rc = pmix_server_get_batch(buf, get_cbfunc, cd);
+        PMIX_RELEASE(cd);
+        return rc;
+    }
+
     if (PMIX_FINALIZE_CMD == cmd) {
         pmix_output_verbose(2, pmix_server_globals.base_output, "recvd FINALIZE");
         peer->nptr->nfinalized++;
         /* purge events */
-        pmix_server_purge_events(peer, NULL);
+        pmix_server_purge_finalized(peer);
         PMIX_GDS_CADDY(cd, peer, tag);
         /* call the local server, if supported */
         if (NULL != pmix_host_server.client_finalized &&
@@ -4673,6 +5927,13 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
         return rc;
     }
 
+    if (PMIX_LOG_BATCH_CMD == cmd) {
+        PMIX_GDS_CADDY(cd, peer, tag);
+        rc = pmix_server_log_batch(peer, buf, get_cbfunc, cd);
+        PMIX_RELEASE(cd);
+        return rc;
+    }
+
     if (PMIX_ALLOC_CMD == cmd) {
         PMIX_GDS_CADDY(cd, peer, tag);
         if (PMIX_SUCCESS != (rc = pmix_server_alloc(peer, buf, alloc_cbfunc, cd))) {
@@ -4780,7 +6041,7 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
 
     if (PMIX_REFRESH_CACHE == cmd) {
         PMIX_GDS_CADDY(cd, peer, tag);
-        if (PMIX_SUCCESS != (rc = pmix_server_refresh_cache(cd, buf, op_cbfunc))) {
+        if (PMIX_SUCCESS != (rc = pmix_server_refresh_cache(cd, buf))) {
             PMIX_RELEASE(cd);
         }
         return rc;
@@ -4789,35 +6050,51 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
     return PMIX_ERR_NOT_SUPPORTED;
 }
 
-void pmix_server_message_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
-                                 pmix_buffer_t *buf, void *cbdata)
+void pmix_server_reply_status(pmix_peer_t *peer, uint32_t tag, pmix_status_t status)
 {
-    pmix_peer_t *peer = (pmix_peer_t *) pr;
     pmix_buffer_t *reply;
-    pmix_status_t rc, ret;
+    pmix_status_t rc;
+
+    reply = PMIX_NEW(pmix_buffer_t);
+    if (NULL == reply) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return;
+    }
+    if (PMIX_OPERATION_SUCCEEDED == status) {
+        status = PMIX_SUCCESS;
+    }
+    PMIX_BFROPS_PACK(rc, peer, reply, &status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_SERVER_QUEUE_REPLY(rc, peer, tag, reply);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(reply);
+    }
+}
+
+void pmix_server_dispatch(pmix_peer_t *peer, uint32_t tag, pmix_buffer_t *buf)
+{
+    pmix_status_t ret;
 
     pmix_output_verbose(2, pmix_server_globals.base_output, "SWITCHYARD for %s:%u:%d",
                         peer->info->pname.nspace, peer->info->pname.rank, peer->sd);
-    PMIX_HIDE_UNUSED_PARAMS(cbdata);
 
-    ret = server_switchyard(peer, hdr->tag, buf);
+    ret = server_switchyard(peer, tag, buf);
     /* send the return, if there was an error returned */
     if (PMIX_SUCCESS != ret) {
-        reply = PMIX_NEW(pmix_buffer_t);
-        if (NULL == reply) {
-            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
-            return;
-        }
-        if (PMIX_OPERATION_SUCCEEDED == ret) {
-            ret = PMIX_SUCCESS;
-        }
-        PMIX_BFROPS_PACK(rc, pr, reply, &ret, 1, PMIX_STATUS);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-        }
-        PMIX_SERVER_QUEUE_REPLY(rc, peer, hdr->tag, reply);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_RELEASE(reply);
-        }
+        pmix_server_reply_status(peer, tag, ret);
+    }
+}
+
+void pmix_server_message_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
+                                 pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_peer_t *peer = (pmix_peer_t *) pr;
+    PMIX_HIDE_UNUSED_PARAMS(cbdata);
+
+    if (pmix_server_sched_defer(peer, hdr, buf)) {
+        return;
     }
+    pmix_server_dispatch(peer, hdr->tag, buf);
 }
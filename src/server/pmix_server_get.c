@@ -28,6 +28,7 @@
 #    include <string.h>
 #endif
 #include <fcntl.h>
+#include <limits.h>
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
@@ -45,15 +46,19 @@
 #endif
 #include <event.h>
 
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_list.h"
+#include "src/mca/bfrops/base/base.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/gds/gds.h"
+#include "src/mca/gds/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_environ.h"
+#include "src/util/pmix_trace.h"
 
 #include "pmix_server_ops.h"
 #include "src/client/pmix_client_ops.h"
@@ -91,6 +96,15 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
                                           pmix_dmdx_local_t **lcd, pmix_dmdx_request_t **rq);
 static pmix_status_t get_job_data(char *nspace, pmix_server_caddy_t *cd, pmix_buffer_t *pbkt);
 static void get_timeout(int sd, short args, void *cbdata);
+static pmix_status_t dmdx_aggregate(pmix_dmdx_local_t *lcd, pmix_info_t info[], size_t ninfo);
+static void dmdx_prefetch_hit(const char *nspace, pmix_rank_t rank);
+static void mdx_fetched(pmix_namespace_t *nptr, pmix_rank_t rank);
+
+/* direct modex upcalls made on behalf of our clients, ranks asked
+ * for ahead of need, and requests those prefetches answered */
+static uint64_t dmdx_requests = 0;
+static uint64_t dmdx_prefetched = 0;
+static uint64_t dmdx_prefetch_hits = 0;
 
 /* declare a function whose sole purpose is to
  * free data that we provided to our host server
@@ -130,8 +144,8 @@ static pmix_status_t defer_response(char *nspace, pmix_rank_t rank, pmix_server_
                         pmix_globals.myid.nspace, pmix_globals.myid.rank);
     /* if they specified a timeout, set it up now */
     if (NULL != tv && 0 < tv->tv_sec) {
-        pmix_event_evtimer_set(pmix_globals.evbase, &req->ev, get_timeout, req);
-        pmix_event_evtimer_add(&req->ev, tv);
+        pmix_timer_add(&req->timer, (double) tv->tv_sec + (double) tv->tv_usec / 1000000.0,
+                       get_timeout, req);
         req->event_active = true;
     }
     /* the peer object has been added to the new lcd tracker,
@@ -162,7 +176,6 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
     pmix_proc_t proc;
     char *data;
     size_t sz, n;
-    pmix_info_t *info;
     pmix_scope_t scope = PMIX_SCOPE_UNDEF;
     pmix_rank_info_t *iptr;
 
@@ -481,6 +494,10 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
     /* since everyone has registered, see if we already have this data */
     rc = _satisfy_request(nptr, rank, cd, diffnspace, scope, cbfunc, cbdata);
     if (PMIX_SUCCESS == rc) {
+        if (!local) {
+            dmdx_prefetch_hit(nspace, rank);
+            mdx_fetched(nptr, rank);
+        }
         /* return success as the satisfy_request function
          * calls the cbfunc for us, and it will have
          * released the cbdata object */
@@ -491,6 +508,18 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
                         pmix_globals.myid.nspace, pmix_globals.myid.rank);
 
 request:
+    /* the host already told us this key does not exist - don't
+     * ask it again until new data arrives */
+    if (!local && NULL != key) {
+        PMIX_LOAD_PROCID(&proc, nspace, rank);
+        if (pmix_gds_base_dcache_absent(&proc, key)) {
+            pmix_output_verbose(2, pmix_server_globals.get_output,
+                                "%s KEY %s KNOWN TO BE ABSENT",
+                                PMIX_NAME_PRINT(&pmix_globals.myid), key);
+            return PMIX_ERR_NOT_FOUND;
+        }
+    }
+
     /* setup to handle this remote request, but don't set any timeout as
      * this might create a race condition with our host if they also
      * support the timeout */
@@ -499,6 +528,9 @@ request:
         /* we are already waiting for the data - nothing more
          * for us to do as the function added the new request
          * to the tracker for us */
+        if (!local) {
+            dmdx_prefetch_hit(nspace, rank);
+        }
         return PMIX_SUCCESS;
     } else if (PMIX_ERR_NOT_AVAILABLE == rc) {
         /* means they requested "immediate" */
@@ -519,17 +551,19 @@ request:
      * whomever is hosting the target process */
     if (NULL != pmix_host_server.direct_modex) {
         if (NULL != key) {
-            sz = cd->ninfo;
-            PMIX_INFO_CREATE(info, sz + 1);
-            for (n = 0; n < sz; n++) {
-                PMIX_INFO_XFER(&info[n], &cd->info[n]);
-            }
-            PMIX_INFO_LOAD(&info[sz], PMIX_REQUIRED_KEY, key, PMIX_STRING);
-            if (NULL != cd->info) {
-                PMIX_INFO_FREE(cd->info, cd->ninfo);
+            rc = pmix_bfrops_base_info_array_grow(&cd->info, &cd->ninfo, 1);
+            if (PMIX_SUCCESS != rc) {
+                pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+                PMIX_RELEASE(lcd);
+                return rc;
             }
-            cd->info = info;
-            cd->ninfo = sz + 1;
+            PMIX_INFO_LOAD(&cd->info[cd->ninfo - 1], PMIX_REQUIRED_KEY, key, PMIX_STRING);
+        }
+        ++dmdx_requests;
+        PMIX_TRACE2(dmdx_request, lcd->proc.nspace, lcd->proc.rank);
+        if (PMIX_SUCCESS == dmdx_aggregate(lcd, cd->info, cd->ninfo)) {
+            /* will be requested along with its neighbors */
+            return PMIX_SUCCESS;
         }
         rc = pmix_host_server.direct_modex(&lcd->proc, cd->info, cd->ninfo, dmdx_cbfunc, lcd);
         if (PMIX_SUCCESS != rc) {
@@ -549,6 +583,209 @@ request:
     return rc;
 }
 
+/* a set of get requests from one client that are to be
+ * answered with a single reply */
+typedef struct {
+    pmix_object_t super;
+    pmix_server_caddy_t *cd;
+    pmix_modex_cbfunc_t cbfunc;
+    size_t nreqs;
+    size_t nleft;
+    pmix_buffer_t *replies;
+} pmix_get_batch_t;
+static void gbcon(pmix_get_batch_t *p)
+{
+    p->cd = NULL;
+    p->cbfunc = NULL;
+    p->nreqs = 0;
+    p->nleft = 0;
+    p->replies = NULL;
+}
+static void gbdes(pmix_get_batch_t *p)
+{
+    size_t n;
+
+    if (NULL != p->replies) {
+        for (n = 0; n < p->nreqs; n++) {
+            PMIX_DESTRUCT(&p->replies[n]);
+        }
+        free(p->replies);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_batch_t, pmix_object_t, gbcon, gbdes);
+
+/* each request in the batch is run through pmix_server_get
+ * with its own caddy */
+typedef struct {
+    pmix_server_caddy_t super;
+    pmix_get_batch_t *batch;
+    size_t idx;
+} pmix_get_batch_caddy_t;
+static void gbccon(pmix_get_batch_caddy_t *p)
+{
+    p->batch = NULL;
+    p->idx = 0;
+}
+static void gbcdes(pmix_get_batch_caddy_t *p)
+{
+    if (NULL != p->batch) {
+        PMIX_RELEASE(p->batch);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_batch_caddy_t, pmix_server_caddy_t, gbccon, gbcdes);
+
+static void batch_complete(pmix_get_batch_t *batch)
+{
+    pmix_buffer_t msg;
+    pmix_byte_object_t bo;
+    pmix_status_t rc = PMIX_SUCCESS;
+    char *data;
+    size_t n, sz;
+
+    --batch->nleft;
+    if (0 < batch->nleft) {
+        return;
+    }
+
+    /* return the individual replies in the order they were requested */
+    PMIX_CONSTRUCT(&msg, pmix_buffer_t);
+    for (n = 0; n < batch->nreqs; n++) {
+        bo.bytes = batch->replies[n].base_ptr;
+        bo.size = batch->replies[n].bytes_used;
+        PMIX_BFROPS_PACK(rc, batch->cd->peer, &msg, &bo, 1, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+    }
+    PMIX_UNLOAD_BUFFER(&msg, data, sz);
+    PMIX_DESTRUCT(&msg);
+    batch->cbfunc(rc, data, sz, batch->cd, relfn, data);
+}
+
+static void batch_reply(pmix_get_batch_t *batch, size_t idx, pmix_status_t status,
+                        const char *data, size_t ndata)
+{
+    pmix_buffer_t *reply = &batch->replies[idx];
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    /* the reply looks just like the one to an individual get */
+    PMIX_BFROPS_PACK(rc, batch->cd->peer, reply, &status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (0 < ndata) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(batch->cd->peer, &buf, data, ndata);
+        PMIX_BFROPS_COPY_PAYLOAD(rc, batch->cd->peer, reply, &buf);
+        buf.base_ptr = NULL;
+        buf.bytes_used = 0;
+        PMIX_DESTRUCT(&buf);
+    }
+}
+
+static void batch_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                         pmix_release_cbfunc_t rel, void *relcbd)
+{
+    pmix_get_batch_caddy_t *bcd = (pmix_get_batch_caddy_t *) cbdata;
+    pmix_get_batch_t *batch = bcd->batch;
+
+    batch_reply(batch, bcd->idx, status, data, ndata);
+    if (NULL != rel) {
+        rel(relcbd);
+    }
+    PMIX_RETAIN(batch);
+    PMIX_RELEASE(bcd);
+    batch_complete(batch);
+    PMIX_RELEASE(batch);
+}
+
+pmix_status_t pmix_server_get_batch(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_server_caddy_t *cd = (pmix_server_caddy_t *) cbdata;
+    pmix_get_batch_t *batch;
+    pmix_get_batch_caddy_t *bcd;
+    pmix_byte_object_t bo;
+    pmix_buffer_t sub;
+    pmix_cmd_t cmd;
+    pmix_status_t rc;
+    int32_t cnt;
+    size_t n, nreqs;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &nreqs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 == nreqs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "%s recvd GET BATCH of %lu requests",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) nreqs);
+
+    batch = PMIX_NEW(pmix_get_batch_t);
+    batch->replies = (pmix_buffer_t *) malloc(nreqs * sizeof(pmix_buffer_t));
+    if (NULL == batch->replies) {
+        PMIX_RELEASE(batch);
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nreqs; n++) {
+        PMIX_CONSTRUCT(&batch->replies[n], pmix_buffer_t);
+    }
+    batch->nreqs = nreqs;
+    /* hold the batch open until every request has been started */
+    batch->nleft = nreqs + 1;
+    PMIX_RETAIN(cd);
+    batch->cd = cd;
+    batch->cbfunc = cbfunc;
+
+    for (n = 0; n < nreqs; n++) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            batch_reply(batch, n, rc, NULL, 0);
+            --batch->nleft;
+            continue;
+        }
+        PMIX_CONSTRUCT(&sub, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(cd->peer, &sub, bo.bytes, bo.size);
+        /* each request carries the command of an individual get */
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, cd->peer, &sub, &cmd, &cnt, PMIX_COMMAND);
+        if (PMIX_SUCCESS != rc || PMIX_GETNB_CMD != cmd) {
+            batch_reply(batch, n, PMIX_ERR_BAD_PARAM, NULL, 0);
+            --batch->nleft;
+            PMIX_DESTRUCT(&sub);
+            continue;
+        }
+        bcd = PMIX_NEW(pmix_get_batch_caddy_t);
+        bcd->super.hdr.tag = cd->hdr.tag;
+        PMIX_RETAIN(cd->peer);
+        bcd->super.peer = cd->peer;
+        PMIX_RETAIN(batch);
+        bcd->batch = batch;
+        bcd->idx = n;
+        rc = pmix_server_get(&sub, batch_cbfunc, bcd);
+        PMIX_DESTRUCT(&sub);
+        if (PMIX_SUCCESS != rc) {
+            batch_reply(batch, n, rc, NULL, 0);
+            PMIX_RELEASE(bcd);
+            --batch->nleft;
+        }
+    }
+
+    /* release our own hold */
+    batch_complete(batch);
+    PMIX_RELEASE(batch);
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_info_t info[],
                                           size_t ninfo, pmix_modex_cbfunc_t cbfunc, void *cbdata,
                                           pmix_dmdx_local_t **ld, pmix_dmdx_request_t **rq)
@@ -599,7 +836,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
 complete:
     /* track this specific requester so we return the
      * data to them */
-    req = PMIX_NEW(pmix_dmdx_request_t);
+    req = PMIX_NEW(pmix_dmdx_request_t, PMIX_SERVER_POOL(dmdx_request));
     if (NULL == req) {
         *ld = lcd;
         return PMIX_ERR_NOMEM;
@@ -729,18 +966,16 @@ static pmix_status_t get_job_data(char *nspace, pmix_server_caddy_t *cd, pmix_bu
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
-                                      pmix_server_caddy_t *cd, bool diffnspace, pmix_scope_t scope,
-                                      pmix_modex_cbfunc_t cbfunc, void *cbdata)
+/* pack the data of the given rank as the reply to a get */
+static pmix_status_t pack_rank_data(pmix_namespace_t *nptr, pmix_rank_t rank,
+                                    pmix_server_caddy_t *cd, bool diffnspace, pmix_scope_t scope,
+                                    char **data, size_t *sz)
 {
     pmix_status_t rc;
-    bool found = false;
     pmix_buffer_t pbkt, pkt;
     pmix_proc_t proc;
     pmix_cb_t cb;
     pmix_byte_object_t bo;
-    char *data = NULL;
-    size_t sz = 0;
     pmix_rank_info_t *rinfo;
     pmix_peer_t *peer;
 
@@ -791,78 +1026,120 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
     }
     cb.info = NULL;
     cb.ninfo = 0;
-    if (PMIX_SUCCESS == rc) {
-        found = true;
-        PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
-        /* assemble the provided data into a byte object */
-        if (PMIX_RANK_UNDEF == rank || diffnspace) {
-            PMIX_GDS_ASSEMB_KVS_REQ(rc, pmix_globals.mypeer, &proc, &cb.kvs, &pkt, cd);
-        } else {
-            PMIX_GDS_ASSEMB_KVS_REQ(rc, cd->peer, &proc, &cb.kvs, &pkt, cd);
-        }
-        if (rc != PMIX_SUCCESS) {
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&cb);
+        PMIX_DESTRUCT(&pbkt);
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
+    /* assemble the provided data into a byte object */
+    if (PMIX_RANK_UNDEF == rank || diffnspace) {
+        PMIX_GDS_ASSEMB_KVS_REQ(rc, pmix_globals.mypeer, &proc, &cb.kvs, &pkt, cd);
+    } else {
+        PMIX_GDS_ASSEMB_KVS_REQ(rc, cd->peer, &proc, &cb.kvs, &pkt, cd);
+    }
+    if (rc != PMIX_SUCCESS) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&pkt);
+        PMIX_DESTRUCT(&pbkt);
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    if (PMIX_PEER_IS_V1(cd->peer)) {
+        /* if the client is using v1, then it expects the
+         * data returned to it in a different order than v2
+         * - so we have to do a little gyration */
+        /* pack the rank */
+        PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &rank, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DESTRUCT(&pkt);
             PMIX_DESTRUCT(&pbkt);
             PMIX_DESTRUCT(&cb);
             return rc;
         }
-        if (PMIX_PEER_IS_V1(cd->peer)) {
-            /* if the client is using v1, then it expects the
-             * data returned to it in a different order than v2
-             * - so we have to do a little gyration */
-            /* pack the rank */
-            PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &rank, 1, PMIX_PROC_RANK);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&pkt);
-                PMIX_DESTRUCT(&pbkt);
-                PMIX_DESTRUCT(&cb);
-                return rc;
-            }
-            /* now pack the data itself as a buffer */
-            PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &pkt, 1, PMIX_BUFFER);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&pkt);
-                PMIX_DESTRUCT(&pbkt);
-                PMIX_DESTRUCT(&cb);
-                return rc;
-            }
+        /* now pack the data itself as a buffer */
+        PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &pkt, 1, PMIX_BUFFER);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
             PMIX_DESTRUCT(&pkt);
-        } else {
-            // Don't unload the buffer here. Since
-            // it gets repacked, we'll lose the base_ptr
-            // to destroy pkt later.
-            bo.bytes = (char *) pkt.unpack_ptr;
-            bo.size = pkt.bytes_used;
-
-            /* pack it for transmission */
-            PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &bo, 1, PMIX_BYTE_OBJECT);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&pbkt);
-                PMIX_DESTRUCT(&cb);
-                return rc;
-            }
+            PMIX_DESTRUCT(&pbkt);
+            PMIX_DESTRUCT(&cb);
+            return rc;
+        }
+        PMIX_DESTRUCT(&pkt);
+    } else {
+        // Don't unload the buffer here. Since
+        // it gets repacked, we'll lose the base_ptr
+        // to destroy pkt later.
+        bo.bytes = (char *) pkt.unpack_ptr;
+        bo.size = pkt.bytes_used;
+
+        /* pack it for transmission - this copies the bytes */
+        PMIX_BFROPS_PACK(rc, cd->peer, &pbkt, &bo, 1, PMIX_BYTE_OBJECT);
+        PMIX_DESTRUCT(&pkt);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&pbkt);
+            PMIX_DESTRUCT(&cb);
+            return rc;
         }
     }
     PMIX_DESTRUCT(&cb);
 
-    PMIX_UNLOAD_BUFFER(&pbkt, data, sz);
+    PMIX_UNLOAD_BUFFER(&pbkt, *data, *sz);
     PMIX_DESTRUCT(&pbkt);
+    return PMIX_SUCCESS;
+}
 
-    if (found) {
-        /* pass it back */
-        cbfunc(rc, data, sz, cbdata, relfn, data);
-        // Safe to free pkt.
-        PMIX_DATA_BUFFER_DESTRUCT(&pkt);
+static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
+                                      pmix_server_caddy_t *cd, bool diffnspace, pmix_scope_t scope,
+                                      pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_status_t rc;
+    char *data = NULL;
+    size_t sz = 0;
+
+    rc = pack_rank_data(nptr, rank, cd, diffnspace, scope, &data, &sz);
+    if (PMIX_SUCCESS != rc) {
         return rc;
     }
+    /* pass it back */
+    cbfunc(rc, data, sz, cbdata, relfn, data);
+    return PMIX_SUCCESS;
+}
+
+/* the data of a remote rank packed once for all the local requests
+ * it answers - each reply holds a reference until it is sent */
+typedef struct {
+    pmix_object_t super;
+    pmix_status_t status;
+    char *data;
+    size_t ndata;
+} pmix_dmdx_shared_t;
+static void dscon(pmix_dmdx_shared_t *p)
+{
+    p->status = PMIX_SUCCESS;
+    p->data = NULL;
+    p->ndata = 0;
+}
+static void dsdes(pmix_dmdx_shared_t *p)
+{
+    if (NULL != p->data) {
+        free(p->data);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_dmdx_shared_t, pmix_object_t, dscon, dsdes);
+
+static void shared_relfn(void *cbdata)
+{
+    pmix_dmdx_shared_t *sh = (pmix_dmdx_shared_t *) cbdata;
 
-    return PMIX_ERR_NOT_FOUND;
+    PMIX_RELEASE(sh);
 }
 
+
 /* Resolve pending requests to this namespace/rank */
 pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr,
                                    pmix_rank_t rank,
@@ -873,6 +1150,8 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr,
     pmix_dmdx_local_t *cd, *ptr;
     pmix_dmdx_request_t *req, *rnext;
     pmix_server_caddy_t scd;
+    pmix_dmdx_shared_t *shared[2] = {NULL, NULL};
+    int n;
 
     /* find corresponding request (if exists) */
     if (NULL == lcd) {
@@ -914,14 +1193,33 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr,
         PMIX_CONSTRUCT(&scd, pmix_server_caddy_t);
         PMIX_RETAIN(pmix_globals.mypeer);
         scd.peer = pmix_globals.mypeer;
+        /* as they are all packed for our own peer, the reply only
+         * differs by whether the requester is in another nspace - so
+         * pack each form the first time it is needed and hand the
+         * same bytes to every request that wants it */
         PMIX_LIST_FOREACH (req, &ptr->loc_reqs, pmix_dmdx_request_t) {
-            pmix_status_t rc;
-            bool diffnspace = !PMIX_CHECK_NSPACE(nptr->nspace, req->lcd->proc.nspace);
-            rc = _satisfy_request(nptr, rank, &scd, diffnspace, scope,
-                                  req->cbfunc, req->cbdata);
-            if (PMIX_SUCCESS != rc) {
+            n = PMIX_CHECK_NSPACE(nptr->nspace, req->lcd->proc.nspace) ? 0 : 1;
+            if (NULL == shared[n]) {
+                shared[n] = PMIX_NEW(pmix_dmdx_shared_t);
+                if (NULL == shared[n]) {
+                    req->cbfunc(PMIX_ERR_NOMEM, NULL, 0, req->cbdata, NULL, NULL);
+                    continue;
+                }
+                shared[n]->status = pack_rank_data(nptr, rank, &scd, 1 == n, scope,
+                                                   &shared[n]->data, &shared[n]->ndata);
+            }
+            if (PMIX_SUCCESS != shared[n]->status) {
                 /* if we can't satisfy this particular request (missing key?) */
-                req->cbfunc(rc, NULL, 0, req->cbdata, NULL, NULL);
+                req->cbfunc(shared[n]->status, NULL, 0, req->cbdata, NULL, NULL);
+                continue;
+            }
+            PMIX_RETAIN(shared[n]);
+            req->cbfunc(PMIX_SUCCESS, shared[n]->data, shared[n]->ndata, req->cbdata,
+                        shared_relfn, shared[n]);
+        }
+        for (n = 0; n < 2; n++) {
+            if (NULL != shared[n]) {
+                PMIX_RELEASE(shared[n]);
             }
         }
         PMIX_DESTRUCT(&scd);
@@ -945,6 +1243,29 @@ cleanup:
     return PMIX_SUCCESS;
 }
 
+/* the host reported that the proc has no data for the keys
+ * required by the local requests - remember that so repeated
+ * requests for them don't go back to the host */
+static void remember_absent_keys(pmix_dmdx_local_t *lcd)
+{
+    pmix_dmdx_request_t *dm;
+    pmix_server_caddy_t *cd;
+    uint64_t gen;
+    size_t n;
+
+    gen = pmix_gds_base_dcache_generation();
+    PMIX_LIST_FOREACH (dm, &lcd->loc_reqs, pmix_dmdx_request_t) {
+        cd = (pmix_server_caddy_t *) dm->cbdata;
+        for (n = 0; n < cd->ninfo; n++) {
+            if (PMIX_CHECK_KEY(&cd->info[n], PMIX_REQUIRED_KEY)) {
+                pmix_gds_base_dcache_insert(gen, &lcd->proc, cd->info[n].value.data.string,
+                                            NULL);
+                break;
+            }
+        }
+    }
+}
+
 /* process the returned data from the host RM server */
 static void _process_dmdx_reply(int sd, short args, void *cbdata)
 {
@@ -970,6 +1291,8 @@ static void _process_dmdx_reply(int sd, short args, void *cbdata)
                         "[%s:%d] process dmdx reply from %s:%u",
                         __FILE__, __LINE__,
                         caddy->lcd->proc.nspace, caddy->lcd->proc.rank);
+    PMIX_TRACE4(dmdx_reply, caddy->lcd->proc.nspace, caddy->lcd->proc.rank, caddy->status,
+                caddy->ndata);
 
     /* find the nspace object for the proc whose data is being received */
     nptr = NULL;
@@ -1025,6 +1348,14 @@ static void _process_dmdx_reply(int sd, short args, void *cbdata)
                 pmix_list_append(&nspaces, &nm->super);
             }
         }
+        /* nobody is waiting on a prefetched proc yet, so keep
+         * its data where a request from its own nspace will look */
+        if (0 == pmix_list_get_size(&nspaces)) {
+            nm = PMIX_NEW(pmix_nspace_caddy_t);
+            PMIX_RETAIN(nptr);
+            nm->ns = nptr;
+            pmix_list_append(&nspaces, &nm->super);
+        }
         /* now go thru each unique nspace and store the data using its
          * assigned GDS component - note that if the nspace of the requesting
          * proc is different from the nspace of the proc whose data is being
@@ -1120,6 +1451,9 @@ static void _process_dmdx_reply(int sd, short args, void *cbdata)
     }
 
 complete:
+    if (PMIX_ERR_NOT_FOUND == caddy->status) {
+        remember_absent_keys(caddy->lcd);
+    }
     /* always execute the callback to avoid having the client hang */
     pmix_pending_resolve(nptr, caddy->lcd->proc.rank,
                          caddy->status, PMIX_REMOTE, caddy->lcd);
@@ -1172,3 +1506,768 @@ static void get_timeout(int sd, short args, void *cbdata)
     pmix_list_remove_item(&req->lcd->loc_reqs, &req->super);
     PMIX_RELEASE(req);
 }
+
+/* ranks of each nspace whose data we have asked the host for, and
+ * those of them that were only asked for ahead of need */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    pmix_bitmap_t requested;
+    pmix_bitmap_t prefetched;
+} pmix_dmdx_fetched_t;
+
+static void dfcon(pmix_dmdx_fetched_t *p)
+{
+    memset(p->nspace, 0, sizeof(pmix_nspace_t));
+    PMIX_CONSTRUCT(&p->requested, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&p->prefetched, pmix_bitmap_t);
+}
+static void dfdes(pmix_dmdx_fetched_t *p)
+{
+    PMIX_DESTRUCT(&p->requested);
+    PMIX_DESTRUCT(&p->prefetched);
+}
+static PMIX_CLASS_INSTANCE(pmix_dmdx_fetched_t, pmix_list_item_t, dfcon, dfdes);
+
+static pmix_list_t dmdx_fetched;
+
+static pmix_dmdx_fetched_t *dmdx_get_fetched(const char *nspace, bool create)
+{
+    pmix_dmdx_fetched_t *ft;
+
+    PMIX_LIST_FOREACH (ft, &dmdx_fetched, pmix_dmdx_fetched_t) {
+        if (PMIX_CHECK_NSPACE(ft->nspace, nspace)) {
+            return ft;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    ft = PMIX_NEW(pmix_dmdx_fetched_t);
+    PMIX_LOAD_NSPACE(ft->nspace, nspace);
+    pmix_list_append(&dmdx_fetched, &ft->super);
+    return ft;
+}
+
+static void dmdx_prefetch_hit(const char *nspace, pmix_rank_t rank)
+{
+    pmix_dmdx_fetched_t *ft;
+
+    if (INT_MAX < rank || NULL == (ft = dmdx_get_fetched(nspace, false))) {
+        return;
+    }
+    /* only count the first use of each prefetched rank */
+    if (pmix_bitmap_is_set_bit(&ft->prefetched, (int) rank)) {
+        pmix_bitmap_clear_bit(&ft->prefetched, (int) rank);
+        ++dmdx_prefetch_hits;
+    }
+}
+
+static void dmdx_prefetch_forget(const char *nspace, pmix_rank_t rank)
+{
+    pmix_dmdx_fetched_t *ft;
+
+    if (INT_MAX < rank || NULL == (ft = dmdx_get_fetched(nspace, false))) {
+        return;
+    }
+    /* the host had nothing for it yet, so allow a later
+     * miss to prefetch it again */
+    if (pmix_bitmap_is_set_bit(&ft->prefetched, (int) rank)) {
+        pmix_bitmap_clear_bit(&ft->prefetched, (int) rank);
+        pmix_bitmap_clear_bit(&ft->requested, (int) rank);
+    }
+}
+
+/* The modex data a server holds for the remote procs of an nspace
+ * can be dropped some time after the fence that collected it, or
+ * rank by rank once each local client has had it - most of it is
+ * only read during wireup. Anything asked for again is then
+ * requested from the host like data that was never collected */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_namespace_t *nptr;
+} pmix_mdx_release_t;
+
+static void mrcon(pmix_mdx_release_t *p)
+{
+    p->nptr = NULL;
+}
+static void mrdes(pmix_mdx_release_t *p)
+{
+    if (NULL != p->nptr) {
+        PMIX_RELEASE(p->nptr);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_mdx_release_t, pmix_list_item_t, mrcon, mrdes);
+
+static pmix_list_t mdx_releases;
+
+static void mdx_release_all(int sd, short args, void *cbdata)
+{
+    pmix_mdx_release_t *rel = (pmix_mdx_release_t *) cbdata;
+    pmix_namespace_t *nptr = rel->nptr;
+    pmix_rank_info_t *info;
+    pmix_bitmap_t local;
+    pmix_rank_t rank;
+    pmix_status_t rc;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_list_remove_item(&mdx_releases, &rel->super);
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "%s releasing modex data of the remote procs of %s",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), nptr->nspace);
+
+    /* our own clients' data stays - it is never asked of the host */
+    PMIX_CONSTRUCT(&local, pmix_bitmap_t);
+    PMIX_LIST_FOREACH (info, &nptr->ranks, pmix_rank_info_t) {
+        if (INT_MAX > info->pname.rank) {
+            pmix_bitmap_set_bit(&local, (int) info->pname.rank);
+        }
+    }
+    for (rank = 0; rank < nptr->nprocs && INT_MAX > rank; rank++) {
+        if (pmix_bitmap_is_set_bit(&local, (int) rank)) {
+            continue;
+        }
+        PMIX_GDS_RELEASE_MODEX(rc, nptr->nspace, rank);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+    }
+    PMIX_DESTRUCT(&local);
+    if (NULL != nptr->mdx_fetches) {
+        free(nptr->mdx_fetches);
+        nptr->mdx_fetches = NULL;
+    }
+    PMIX_RELEASE(rel);
+}
+
+void pmix_server_modex_collected(pmix_server_trkr_t *trk)
+{
+    pmix_nspace_caddy_t *nc;
+    pmix_mdx_release_t *rel, *r;
+    struct timeval tv = {0, 0};
+    uint32_t secs;
+
+    PMIX_LIST_FOREACH (nc, &trk->nslist, pmix_nspace_caddy_t) {
+        if (trk->mdx_release_fetched) {
+            nc->ns->mdx_release_fetched = true;
+        }
+        /* count the fetches of the new data afresh */
+        if (NULL != nc->ns->mdx_fetches) {
+            free(nc->ns->mdx_fetches);
+            nc->ns->mdx_fetches = NULL;
+        }
+        secs = (0 < trk->mdx_release_time) ? trk->mdx_release_time : nc->ns->mdx_release_time;
+        if (0 == secs) {
+            continue;
+        }
+        rel = NULL;
+        PMIX_LIST_FOREACH (r, &mdx_releases, pmix_mdx_release_t) {
+            if (r->nptr == nc->ns) {
+                rel = r;
+                break;
+            }
+        }
+        if (NULL == rel) {
+            rel = PMIX_NEW(pmix_mdx_release_t);
+            if (NULL == rel) {
+                continue;
+            }
+            PMIX_RETAIN(nc->ns);
+            rel->nptr = nc->ns;
+            pmix_event_evtimer_set(pmix_globals.evbase, &rel->ev, mdx_release_all, rel);
+            pmix_list_append(&mdx_releases, &rel->super);
+        }
+        /* a later fence puts off the release of what it brought */
+        tv.tv_sec = secs;
+        pmix_event_evtimer_add(&rel->ev, &tv);
+    }
+}
+
+/* a fetch of a remote proc's data has been served to a local client */
+static void mdx_fetched(pmix_namespace_t *nptr, pmix_rank_t rank)
+{
+    pmix_status_t rc;
+
+    if (!nptr->mdx_release_fetched || 0 == nptr->nlocalprocs || SIZE_MAX == nptr->nlocalprocs
+        || rank >= nptr->nprocs) {
+        return;
+    }
+    if (NULL == nptr->mdx_fetches) {
+        nptr->mdx_fetches = (uint32_t *) calloc(nptr->nprocs, sizeof(uint32_t));
+        if (NULL == nptr->mdx_fetches) {
+            return;
+        }
+    }
+    if (++nptr->mdx_fetches[rank] < nptr->nlocalprocs) {
+        return;
+    }
+    nptr->mdx_fetches[rank] = 0;
+    PMIX_GDS_RELEASE_MODEX(rc, nptr->nspace, rank);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+}
+
+void pmix_server_dmdx_purge(const char *nspace)
+{
+    pmix_dmdx_fetched_t *ft;
+    pmix_mdx_release_t *rel;
+
+    if (NULL != (ft = dmdx_get_fetched(nspace, false))) {
+        pmix_list_remove_item(&dmdx_fetched, &ft->super);
+        PMIX_RELEASE(ft);
+    }
+    PMIX_LIST_FOREACH (rel, &mdx_releases, pmix_mdx_release_t) {
+        if (PMIX_CHECK_NSPACE(rel->nptr->nspace, nspace)) {
+            pmix_event_del(&rel->ev);
+            pmix_list_remove_item(&mdx_releases, &rel->super);
+            PMIX_RELEASE(rel);
+            break;
+        }
+    }
+}
+
+bool pmix_server_dmdx_stat(const char *key, uint64_t *val)
+{
+    uint64_t v;
+
+    if (0 == strcmp(key, PMIX_QUERY_DMODEX_REQUESTS)) {
+        v = dmdx_requests;
+    } else if (0 == strcmp(key, PMIX_QUERY_DMODEX_PREFETCHED)) {
+        v = dmdx_prefetched;
+    } else if (0 == strcmp(key, PMIX_QUERY_DMODEX_PREFETCH_HITS)) {
+        v = dmdx_prefetch_hits;
+    } else {
+        return false;
+    }
+    if (NULL != val) {
+        *val = v;
+    }
+    return true;
+}
+
+static void dmdx_query_relcb(void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+
+    if (NULL != cd->info) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+    }
+    PMIX_RELEASE(cd);
+}
+
+void pmix_server_dmdx_query(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+    pmix_status_t rc;
+    uint64_t val;
+    size_t n, p, m;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    /* answer every statistic we were asked for */
+    cd->ninfo = 0;
+    for (n = 0; n < cd->nqueries; n++) {
+        for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+            if (pmix_server_dmdx_stat(cd->queries[n].keys[p], NULL)) {
+                ++cd->ninfo;
+            }
+        }
+    }
+    if (0 == cd->ninfo) {
+        rc = PMIX_ERR_NOT_FOUND;
+    } else {
+        PMIX_INFO_CREATE(cd->info, cd->ninfo);
+        m = 0;
+        for (n = 0; n < cd->nqueries; n++) {
+            for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+                if (pmix_server_dmdx_stat(cd->queries[n].keys[p], &val)) {
+                    PMIX_INFO_LOAD(&cd->info[m], cd->queries[n].keys[p], &val, PMIX_UINT64);
+                    ++m;
+                }
+            }
+        }
+        rc = PMIX_SUCCESS;
+    }
+
+    cd->cbfunc(rc, cd->info, cd->ninfo, cd->cbdata, dmdx_query_relcb, cd);
+}
+
+/* direct modex requests for procs that live on the same remote
+ * node are held for a short window so they can be passed to the
+ * host in a single upcall */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_nspace_t nspace;
+    char *hostname;
+    pmix_dmdx_local_t **lcds;
+    size_t nlcds;
+    size_t size;
+    char **keys;
+    pmix_info_t *info;
+    size_t ninfo;
+    pmix_status_t status;
+    const char *data;
+    size_t ndata;
+    pmix_release_cbfunc_t relcbfunc;
+    void *cbdata;
+} pmix_dmdx_bin_t;
+
+static void dbcon(pmix_dmdx_bin_t *p)
+{
+    memset(p->nspace, 0, sizeof(pmix_nspace_t));
+    p->hostname = NULL;
+    p->lcds = NULL;
+    p->nlcds = 0;
+    p->size = 0;
+    p->keys = NULL;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->status = PMIX_SUCCESS;
+    p->data = NULL;
+    p->ndata = 0;
+    p->relcbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void dbdes(pmix_dmdx_bin_t *p)
+{
+    if (NULL != p->hostname) {
+        free(p->hostname);
+    }
+    if (NULL != p->lcds) {
+        free(p->lcds);
+    }
+    if (NULL != p->keys) {
+        pmix_argv_free(p->keys);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_dmdx_bin_t, pmix_list_item_t, dbcon, dbdes);
+
+static pmix_list_t dmdx_bins;
+
+void pmix_server_dmdx_init(void)
+{
+    PMIX_CONSTRUCT(&dmdx_fetched, pmix_list_t);
+    PMIX_CONSTRUCT(&dmdx_bins, pmix_list_t);
+    PMIX_CONSTRUCT(&mdx_releases, pmix_list_t);
+}
+
+void pmix_server_dmdx_finalize(void)
+{
+    pmix_mdx_release_t *rel;
+
+    PMIX_LIST_FOREACH (rel, &mdx_releases, pmix_mdx_release_t) {
+        pmix_event_del(&rel->ev);
+    }
+    PMIX_LIST_DESTRUCT(&mdx_releases);
+    PMIX_LIST_DESTRUCT(&dmdx_bins);
+    PMIX_LIST_DESTRUCT(&dmdx_fetched);
+}
+
+static void dmdx_bin_resolve(pmix_dmdx_bin_t *bin, size_t n, pmix_status_t status,
+                             pmix_byte_object_t *bo)
+{
+    pmix_dmdx_reply_caddy_t *caddy;
+
+    caddy = PMIX_NEW(pmix_dmdx_reply_caddy_t);
+    caddy->status = status;
+    if (NULL != bo) {
+        caddy->data = bo->bytes;
+        caddy->ndata = bo->size;
+    }
+    caddy->lcd = bin->lcds[n];
+    bin->lcds[n] = NULL;
+    /* no release function - we are done with the
+     * data once this returns */
+    _process_dmdx_reply(0, 0, caddy);
+}
+
+static void _process_dmdx_bin_reply(int sd, short args, void *cbdata)
+{
+    pmix_dmdx_bin_t *bin = (pmix_dmdx_bin_t *) cbdata;
+    pmix_buffer_t pbkt;
+    pmix_byte_object_t bo;
+    pmix_rank_t rank;
+    pmix_status_t rc;
+    int32_t cnt;
+    size_t n;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(bin);
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "[%s:%d] process dmdx reply for %lu procs on %s from nspace %s",
+                        __FILE__, __LINE__, (unsigned long) bin->nlcds,
+                        (NULL == bin->hostname) ? "unknown" : bin->hostname, bin->nspace);
+
+    if (PMIX_SUCCESS == bin->status && NULL != bin->data) {
+        PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+        PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_globals.mypeer, &pbkt, bin->data, bin->ndata);
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, &rank, &cnt, PMIX_PROC_RANK);
+        while (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, &bo, &cnt, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            for (n = 0; n < bin->nlcds; n++) {
+                if (NULL != bin->lcds[n] && rank == bin->lcds[n]->proc.rank) {
+                    dmdx_bin_resolve(bin, n, PMIX_SUCCESS, &bo);
+                    break;
+                }
+            }
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, &rank, &cnt, PMIX_PROC_RANK);
+        }
+        pbkt.base_ptr = NULL; // protect the data
+        PMIX_DESTRUCT(&pbkt);
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        /* anyone the host didn't return data for */
+        bin->status = PMIX_ERR_NOT_FOUND;
+    } else if (PMIX_SUCCESS == bin->status) {
+        bin->status = PMIX_ERR_NOT_FOUND;
+    }
+
+    /* always resolve every request to avoid having clients hang */
+    for (n = 0; n < bin->nlcds; n++) {
+        if (NULL != bin->lcds[n]) {
+            dmdx_prefetch_forget(bin->nspace, bin->lcds[n]->proc.rank);
+            dmdx_bin_resolve(bin, n, bin->status, NULL);
+        }
+    }
+
+    /* let the host know it can release the data */
+    if (NULL != bin->relcbfunc) {
+        bin->relcbfunc(bin->cbdata);
+    }
+    PMIX_RELEASE(bin);
+}
+
+static void dmdx_bin_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                            pmix_release_cbfunc_t release_fn, void *release_cbdata)
+{
+    pmix_dmdx_bin_t *bin = (pmix_dmdx_bin_t *) cbdata;
+
+    /* we are in the host's thread */
+    bin->status = status;
+    bin->data = data;
+    bin->ndata = ndata;
+    bin->relcbfunc = release_fn;
+    bin->cbdata = release_cbdata;
+    PMIX_THREADSHIFT(bin, _process_dmdx_bin_reply);
+}
+
+static void dmdx_bin_fire(int sd, short args, void *cbdata)
+{
+    pmix_dmdx_bin_t *bin = (pmix_dmdx_bin_t *) cbdata;
+    pmix_data_array_t darray;
+    pmix_rank_t *ranks;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    size_t n, m;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_list_remove_item(&dmdx_bins, &bin->super);
+
+    bin->ninfo = pmix_argv_count(bin->keys);
+    if (1 < bin->nlcds) {
+        ++bin->ninfo;
+    }
+    if (0 < bin->ninfo) {
+        PMIX_INFO_CREATE(bin->info, bin->ninfo);
+    }
+    for (n = 0; NULL != bin->keys && NULL != bin->keys[n]; n++) {
+        PMIX_INFO_LOAD(&bin->info[n], PMIX_REQUIRED_KEY, bin->keys[n], PMIX_STRING);
+    }
+
+    if (1 == bin->nlcds) {
+        /* nobody joined - just make the usual request */
+        rc = pmix_host_server.direct_modex(&bin->lcds[0]->proc, bin->info, bin->ninfo,
+                                           dmdx_cbfunc, bin->lcds[0]);
+        if (PMIX_SUCCESS == rc) {
+            /* the host now holds the tracker */
+            PMIX_RELEASE(bin);
+            return;
+        }
+        goto error;
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "%s requesting data for %lu procs on %s from nspace %s",
+                        PMIX_NAME_PRINT(&pmix_globals.myid),
+                        (unsigned long) bin->nlcds,
+                        (NULL == bin->hostname) ? "unknown" : bin->hostname, bin->nspace);
+    ranks = (pmix_rank_t *) malloc(bin->nlcds * sizeof(pmix_rank_t));
+    if (NULL == ranks) {
+        rc = PMIX_ERR_NOMEM;
+        goto error;
+    }
+    for (m = 0; m < bin->nlcds; m++) {
+        ranks[m] = bin->lcds[m]->proc.rank;
+    }
+    darray.type = PMIX_PROC_RANK;
+    darray.size = bin->nlcds;
+    darray.array = ranks;
+    PMIX_INFO_LOAD(&bin->info[n], PMIX_DMODEX_RANKS, &darray, PMIX_DATA_ARRAY);
+    free(ranks);
+    /* address the request to the first proc so a host
+     * can route it the same way as a single one */
+    PMIX_LOAD_PROCID(&proc, bin->nspace, bin->lcds[0]->proc.rank);
+    rc = pmix_host_server.direct_modex(&proc, bin->info, bin->ninfo, dmdx_bin_cbfunc, bin);
+    if (PMIX_SUCCESS == rc) {
+        /* the bin is released when the host replies */
+        return;
+    }
+
+error:
+    /* the host won't be coming back to us for these */
+    for (n = 0; n < bin->nlcds; n++) {
+        dmdx_prefetch_forget(bin->nspace, bin->lcds[n]->proc.rank);
+        pmix_pending_resolve(NULL, bin->lcds[n]->proc.rank, rc, PMIX_REMOTE, bin->lcds[n]);
+    }
+    PMIX_RELEASE(bin);
+}
+
+static pmix_status_t dmdx_bin_add(pmix_dmdx_bin_t *bin, pmix_dmdx_local_t *lcd)
+{
+    pmix_dmdx_local_t **tmp;
+    size_t n;
+
+    if (bin->nlcds == bin->size) {
+        n = (0 == bin->size) ? 8 : 2 * bin->size;
+        tmp = (pmix_dmdx_local_t **) realloc(bin->lcds, n * sizeof(pmix_dmdx_local_t *));
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        bin->lcds = tmp;
+        bin->size = n;
+    }
+    bin->lcds[bin->nlcds++] = lcd;
+    return PMIX_SUCCESS;
+}
+
+static void dmdx_prefetch_rank(pmix_dmdx_bin_t *bin, pmix_dmdx_fetched_t *ft,
+                               pmix_namespace_t *nptr, pmix_rank_t rank)
+{
+    pmix_dmdx_local_t *lcd;
+    pmix_rank_info_t *iptr;
+
+    if (INT_MAX < rank || pmix_bitmap_is_set_bit(&ft->requested, (int) rank)) {
+        return;
+    }
+    /* our own clients will give us their data directly */
+    if (NULL != nptr) {
+        PMIX_LIST_FOREACH (iptr, &nptr->ranks, pmix_rank_info_t) {
+            if (rank == iptr->pname.rank) {
+                return;
+            }
+        }
+    }
+    /* someone may already be waiting for it */
+    PMIX_LIST_FOREACH (lcd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
+        if (PMIX_CHECK_NSPACE(lcd->proc.nspace, ft->nspace) && rank == lcd->proc.rank) {
+            return;
+        }
+    }
+
+    /* a tracker nobody is waiting on yet - any request
+     * that arrives before the data will simply join it */
+    lcd = PMIX_NEW(pmix_dmdx_local_t);
+    PMIX_LOAD_PROCID(&lcd->proc, ft->nspace, rank);
+    if (PMIX_SUCCESS != dmdx_bin_add(bin, lcd)) {
+        PMIX_RELEASE(lcd);
+        return;
+    }
+    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    pmix_bitmap_set_bit(&ft->requested, (int) rank);
+    pmix_bitmap_set_bit(&ft->prefetched, (int) rank);
+    ++dmdx_prefetched;
+}
+
+static void dmdx_prefetch(pmix_dmdx_bin_t *bin, pmix_dmdx_local_t *lcd)
+{
+    pmix_dmdx_fetched_t *ft;
+    pmix_namespace_t *ns, *nptr;
+    pmix_info_t info[2];
+    pmix_kval_t *kv;
+    pmix_proc_t proc;
+    pmix_cb_t cb;
+    pmix_status_t rc;
+    pmix_rank_t rank, lo, hi, r;
+    char **peers;
+    size_t n;
+
+    rank = lcd->proc.rank;
+    if (INT_MAX < rank) {
+        return;
+    }
+    ft = dmdx_get_fetched(lcd->proc.nspace, true);
+    pmix_bitmap_set_bit(&ft->requested, (int) rank);
+
+    nptr = NULL;
+    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+        if (PMIX_CHECK_NSPACE(ns->nspace, lcd->proc.nspace)) {
+            nptr = ns;
+            break;
+        }
+    }
+
+    /* the ranks on either side of the one they asked for */
+    if (0 < pmix_server_globals.dmodex_prefetch_window && NULL != nptr && 0 < nptr->nprocs) {
+        n = (size_t) pmix_server_globals.dmodex_prefetch_window;
+        lo = (rank > n) ? rank - n : 0;
+        hi = (rank + n < nptr->nprocs) ? rank + n : nptr->nprocs - 1;
+        for (r = lo; r <= hi; r++) {
+            if (r != rank) {
+                dmdx_prefetch_rank(bin, ft, nptr, r);
+            }
+        }
+    }
+
+    /* everyone that shares its node */
+    if (pmix_server_globals.dmodex_prefetch_node && NULL != bin->hostname) {
+        PMIX_LOAD_PROCID(&proc, lcd->proc.nspace, PMIX_RANK_UNDEF);
+        PMIX_INFO_LOAD(&info[0], PMIX_NODE_INFO, NULL, PMIX_BOOL);
+        PMIX_INFO_LOAD(&info[1], PMIX_HOSTNAME, bin->hostname, PMIX_STRING);
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = &proc;
+        cb.key = PMIX_LOCAL_PEERS;
+        cb.info = info;
+        cb.ninfo = 2;
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        if (PMIX_SUCCESS == rc) {
+            kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+            if (NULL != kv && NULL != kv->value && PMIX_STRING == kv->value->type &&
+                NULL != kv->value->data.string) {
+                peers = pmix_argv_split(kv->value->data.string, ',');
+                for (n = 0; NULL != peers && NULL != peers[n]; n++) {
+                    r = strtoul(peers[n], NULL, 10);
+                    if (r != rank) {
+                        dmdx_prefetch_rank(bin, ft, nptr, r);
+                    }
+                }
+                pmix_argv_free(peers);
+            }
+        }
+        cb.proc = NULL;
+        cb.key = NULL;
+        cb.info = NULL;
+        cb.ninfo = 0;
+        PMIX_DESTRUCT(&cb);
+        PMIX_INFO_DESTRUCT(&info[0]);
+        PMIX_INFO_DESTRUCT(&info[1]);
+    }
+}
+
+static pmix_status_t dmdx_aggregate(pmix_dmdx_local_t *lcd, pmix_info_t info[], size_t ninfo)
+{
+    pmix_dmdx_bin_t *bin, *b;
+    pmix_info_t optional;
+    pmix_kval_t *kv;
+    pmix_cb_t cb;
+    pmix_status_t rc;
+    struct timeval tv;
+    char *hostname;
+    bool prefetch;
+    size_t n;
+
+    prefetch = (0 < pmix_server_globals.dmodex_prefetch_window ||
+                pmix_server_globals.dmodex_prefetch_node);
+    if (0 >= pmix_server_globals.dmodex_aggregate_window && !prefetch) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    /* only plain requests can be combined - the host may
+     * need to act on anything else for each proc */
+    for (n = 0; n < ninfo; n++) {
+        if (!PMIX_CHECK_KEY(&info[n], PMIX_REQUIRED_KEY) &&
+            !PMIX_CHECK_KEY(&info[n], PMIX_OPTIONAL)) {
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    /* find out where the target lives */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &lcd->proc;
+    cb.key = PMIX_HOSTNAME;
+    PMIX_INFO_LOAD(&optional, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    cb.info = &optional;
+    cb.ninfo = 1;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    hostname = NULL;
+    if (PMIX_SUCCESS == rc) {
+        kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+        if (NULL != kv && NULL != kv->value && PMIX_STRING == kv->value->type &&
+            NULL != kv->value->data.string) {
+            hostname = strdup(kv->value->data.string);
+        }
+    }
+    cb.proc = NULL;
+    cb.key = NULL;
+    cb.info = NULL;
+    cb.ninfo = 0;
+    PMIX_DESTRUCT(&cb);
+    PMIX_INFO_DESTRUCT(&optional);
+    /* a prefetch doesn't need to know */
+    if (NULL == hostname && !prefetch) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    bin = NULL;
+    PMIX_LIST_FOREACH (b, &dmdx_bins, pmix_dmdx_bin_t) {
+        if (!PMIX_CHECK_NSPACE(b->nspace, lcd->proc.nspace)) {
+            continue;
+        }
+        if ((NULL == b->hostname && NULL == hostname) ||
+            (NULL != b->hostname && NULL != hostname && 0 == strcmp(b->hostname, hostname))) {
+            bin = b;
+            break;
+        }
+    }
+    if (NULL != bin) {
+        if (NULL != hostname) {
+            free(hostname);
+        }
+        if (PMIX_SUCCESS != dmdx_bin_add(bin, lcd)) {
+            /* let the caller request it on its own */
+            return PMIX_ERR_NOMEM;
+        }
+    } else {
+        bin = PMIX_NEW(pmix_dmdx_bin_t);
+        PMIX_LOAD_NSPACE(bin->nspace, lcd->proc.nspace);
+        bin->hostname = hostname;
+        if (PMIX_SUCCESS != dmdx_bin_add(bin, lcd)) {
+            PMIX_RELEASE(bin);
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_list_append(&dmdx_bins, &bin->super);
+        tv.tv_sec = pmix_server_globals.dmodex_aggregate_window / 1000000;
+        tv.tv_usec = pmix_server_globals.dmodex_aggregate_window % 1000000;
+        pmix_event_evtimer_set(pmix_globals.evbase, &bin->ev, dmdx_bin_fire, bin);
+        pmix_event_evtimer_add(&bin->ev, &tv);
+    }
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_REQUIRED_KEY) && PMIX_STRING == info[n].value.type) {
+            pmix_argv_append_unique_nosize(&bin->keys, info[n].value.data.string);
+        }
+    }
+
+    if (prefetch) {
+        dmdx_prefetch(bin, lcd);
+    }
+    return PMIX_SUCCESS;
+}
@@ -0,0 +1,276 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#include <time.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/pgpu/pgpu.h"
+#include "src/mca/pnet/pnet.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* the frameworks providing inventory, in the order
+ * their contributions are reported */
+#define PMIX_INVENTORY_NCOLLECTORS 2
+
+typedef struct {
+    pmix_thread_t thread;
+    bool started;
+    int index;
+    pmix_list_t inventory;
+    pmix_status_t status;
+    struct pmix_inventory_req_t *req;
+} pmix_inventory_worker_t;
+
+typedef struct pmix_inventory_req_t {
+    pmix_inventory_rollup_t super;
+    pmix_shift_caddy_t *cd;
+    pmix_inventory_worker_t workers[PMIX_INVENTORY_NCOLLECTORS];
+} pmix_inventory_req_t;
+
+static void ircon(pmix_inventory_req_t *p)
+{
+    int n;
+
+    p->cd = NULL;
+    for (n = 0; n < PMIX_INVENTORY_NCOLLECTORS; n++) {
+        PMIX_CONSTRUCT(&p->workers[n].thread, pmix_thread_t);
+        p->workers[n].started = false;
+        p->workers[n].index = n;
+        PMIX_CONSTRUCT(&p->workers[n].inventory, pmix_list_t);
+        p->workers[n].status = PMIX_SUCCESS;
+        p->workers[n].req = p;
+    }
+}
+static void irdes(pmix_inventory_req_t *p)
+{
+    int n;
+
+    for (n = 0; n < PMIX_INVENTORY_NCOLLECTORS; n++) {
+        PMIX_LIST_DESTRUCT(&p->workers[n].inventory);
+        PMIX_DESTRUCT(&p->workers[n].thread);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_inventory_req_t, pmix_inventory_rollup_t, ircon, irdes);
+
+/* the last inventory collected without directives - only
+ * accessed from the progress thread */
+static bool have_cached = false;
+static pmix_info_t *cached = NULL;
+static size_t ncached = 0;
+static time_t cached_at = 0;
+
+static pmix_status_t collect(int index, pmix_info_t directives[], size_t ndirs,
+                             pmix_list_t *inventory)
+{
+    if (0 == index) {
+        return pmix_pnet.collect_inventory(directives, ndirs, inventory);
+    }
+    return pmix_pgpu.collect_inventory(directives, ndirs, inventory);
+}
+
+static void cirelease(void *cbdata)
+{
+    pmix_shift_caddy_t *cd = (pmix_shift_caddy_t *) cbdata;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    if (NULL != cd->info) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+    }
+    PMIX_RELEASE(cd);
+}
+
+static pmix_status_t copy_info(pmix_info_t **dest, size_t *ndest, pmix_info_t *src, size_t nsrc)
+{
+    size_t n;
+
+    *dest = NULL;
+    *ndest = 0;
+    if (0 == nsrc) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_INFO_CREATE(*dest, nsrc);
+    if (NULL == *dest) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nsrc; n++) {
+        PMIx_Info_xfer(&(*dest)[n], &src[n]);
+    }
+    *ndest = nsrc;
+    return PMIX_SUCCESS;
+}
+
+void pmix_server_inventory_flush(void)
+{
+    if (NULL != cached) {
+        PMIX_INFO_FREE(cached, ncached);
+        cached = NULL;
+    }
+    ncached = 0;
+    have_cached = false;
+}
+
+static void report(pmix_shift_caddy_t *cd, pmix_status_t status, pmix_list_t *inventory)
+{
+    pmix_data_array_t darray;
+    pmix_status_t rc = status;
+
+    if (PMIX_SUCCESS == rc) {
+        /* convert list to an array of info */
+        rc = PMIx_Info_list_convert((void *) inventory, &darray);
+        if (PMIX_ERR_EMPTY == rc) {
+            rc = PMIX_SUCCESS;
+        } else if (PMIX_SUCCESS == rc) {
+            cd->info = (pmix_info_t *) darray.array;
+            cd->ninfo = darray.size;
+        }
+        /* directives may change what is collected, so only
+         * keep the answer to a plain request */
+        if (PMIX_SUCCESS == rc && 0 == cd->ndirs
+            && 0 < pmix_server_globals.inventory_cache_lifetime) {
+            pmix_server_inventory_flush();
+            if (PMIX_SUCCESS == copy_info(&cached, &ncached, cd->info, cd->ninfo)) {
+                have_cached = true;
+                cached_at = time(NULL);
+            }
+        }
+    }
+
+    if (NULL != cd->cbfunc.infocbfunc) {
+        cd->cbfunc.infocbfunc(rc, cd->info, cd->ninfo, cd->cbdata, cirelease, cd);
+    } else {
+        cirelease(cd);
+    }
+}
+
+static void collected(int sd, short args, void *cbdata)
+{
+    pmix_inventory_req_t *req = (pmix_inventory_req_t *) cbdata;
+    pmix_list_t inventory;
+    pmix_list_item_t *item;
+    pmix_status_t rc = PMIX_SUCCESS;
+    int n;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(req);
+
+    /* every worker has replied, so the joins cannot block for long */
+    PMIX_CONSTRUCT(&inventory, pmix_list_t);
+    for (n = 0; n < PMIX_INVENTORY_NCOLLECTORS; n++) {
+        if (req->workers[n].started) {
+            pmix_thread_join(&req->workers[n].thread, NULL);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = req->workers[n].status;
+        }
+        while (NULL != (item = pmix_list_remove_first(&req->workers[n].inventory))) {
+            pmix_list_append(&inventory, item);
+        }
+    }
+    report(req->cd, rc, &inventory);
+    PMIX_LIST_DESTRUCT(&inventory);
+    PMIX_RELEASE(req);
+}
+
+static void *collect_thread(pmix_object_t *obj)
+{
+    pmix_thread_t *t = (pmix_thread_t *) obj;
+    pmix_inventory_worker_t *w = (pmix_inventory_worker_t *) t->t_arg;
+    pmix_inventory_req_t *req = w->req;
+    bool last;
+
+    w->status = collect(w->index, req->cd->directives, req->cd->ndirs, &w->inventory);
+
+    pmix_mutex_lock(&req->super.lock.mutex);
+    last = (++req->super.replies == req->super.requests);
+    pmix_mutex_unlock(&req->super.lock.mutex);
+    if (last) {
+        /* complete the request back in the progress thread */
+        PMIX_THREADSHIFT(&req->super, collected);
+    }
+    return NULL;
+}
+
+void pmix_server_inventory_collect(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *cd = (pmix_shift_caddy_t *) cbdata;
+    pmix_inventory_req_t *req;
+    pmix_list_t inventory;
+    pmix_status_t rc;
+    size_t m;
+    int n;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    /* whatever we kept is stale if the caller says the hardware changed */
+    for (m = 0; m < cd->ndirs; m++) {
+        if (PMIX_CHECK_KEY(&cd->directives[m], PMIX_QUERY_REFRESH_CACHE)
+            && PMIX_INFO_TRUE(&cd->directives[m])) {
+            pmix_server_inventory_flush();
+            break;
+        }
+    }
+
+    if (0 == cd->ndirs && have_cached
+        && time(NULL) - cached_at < pmix_server_globals.inventory_cache_lifetime) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server inventory returned from cache");
+        rc = copy_info(&cd->info, &cd->ninfo, cached, ncached);
+        if (NULL != cd->cbfunc.infocbfunc) {
+            cd->cbfunc.infocbfunc(rc, cd->info, cd->ninfo, cd->cbdata, cirelease, cd);
+        } else {
+            cirelease(cd);
+        }
+        return;
+    }
+
+    if (!pmix_server_globals.inventory_parallel) {
+        PMIX_CONSTRUCT(&inventory, pmix_list_t);
+        rc = PMIX_SUCCESS;
+        for (n = 0; n < PMIX_INVENTORY_NCOLLECTORS && PMIX_SUCCESS == rc; n++) {
+            rc = collect(n, cd->directives, cd->ndirs, &inventory);
+        }
+        report(cd, rc, &inventory);
+        PMIX_LIST_DESTRUCT(&inventory);
+        return;
+    }
+
+    /* the probing done by the components can take a while,
+     * so keep it off the progress thread */
+    req = PMIX_NEW(pmix_inventory_req_t);
+    if (NULL == req) {
+        report(cd, PMIX_ERR_NOMEM, NULL);
+        return;
+    }
+    req->cd = cd;
+    req->super.requests = PMIX_INVENTORY_NCOLLECTORS;
+    for (n = 0; n < PMIX_INVENTORY_NCOLLECTORS; n++) {
+        req->workers[n].thread.t_run = collect_thread;
+        req->workers[n].thread.t_arg = &req->workers[n];
+        req->workers[n].started = true;
+        if (PMIX_SUCCESS != pmix_thread_start(&req->workers[n].thread)) {
+            /* do it ourselves */
+            req->workers[n].started = false;
+            collect_thread(&req->workers[n].thread.super);
+        }
+    }
+}
@@ -0,0 +1,254 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
+#include <sys/mman.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* Output for which nobody has registered yet is held for tools that
+ * attach late. The cache is bounded by the number of messages and by
+ * the bytes of their data - when either is reached, the oldest
+ * messages are dropped. If spilling is enabled, the data that does
+ * not fit in memory goes instead to a file per nspace in the server's
+ * tmpdir. The files are only appended to, and are read back through a
+ * read-only mapping, so replaying them to a registrant streams through
+ * the file in order. A file is removed once all of its messages have
+ * been delivered or dropped */
+
+static void spcon(pmix_iof_spill_t *p)
+{
+    memset(p->nspace, 0, sizeof(pmix_nspace_t));
+    p->path = NULL;
+    p->fd = -1;
+    p->size = 0;
+    p->base = NULL;
+    p->mapped = 0;
+    p->nentries = 0;
+}
+static void spdes(pmix_iof_spill_t *p)
+{
+    if (NULL != p->base) {
+        munmap(p->base, p->mapped);
+    }
+    if (0 <= p->fd) {
+        close(p->fd);
+    }
+    if (NULL != p->path) {
+        unlink(p->path);
+        free(p->path);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_iof_spill_t, pmix_list_item_t, spcon, spdes);
+
+static pmix_iof_spill_t *get_spill(const pmix_proc_t *source, size_t len)
+{
+    pmix_iof_spill_t *spill;
+
+    if (!pmix_server_globals.iof_spill || NULL == pmix_server_globals.tmpdir || 0 == len) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH (spill, &pmix_server_globals.iof_spills, pmix_iof_spill_t) {
+        if (PMIX_CHECK_NSPACE(spill->nspace, source->nspace)) {
+            if (spill->size + len > pmix_server_globals.max_iof_spill) {
+                return NULL;
+            }
+            return spill;
+        }
+    }
+    if (len > pmix_server_globals.max_iof_spill) {
+        return NULL;
+    }
+
+    spill = PMIX_NEW(pmix_iof_spill_t);
+    if (NULL == spill) {
+        return NULL;
+    }
+    PMIX_LOAD_NSPACE(spill->nspace, source->nspace);
+    if (0 > asprintf(&spill->path, "%s/pmix-iof-%s-%lu.spill", pmix_server_globals.tmpdir,
+                     source->nspace, (unsigned long) getpid())) {
+        spill->path = NULL;
+        PMIX_RELEASE(spill);
+        return NULL;
+    }
+    spill->fd = open(spill->path, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (0 > spill->fd) {
+        pmix_output_verbose(2, pmix_server_globals.iof_output,
+                            "pmix:server:iof cannot open spill file %s: %s", spill->path,
+                            strerror(errno));
+        free(spill->path);
+        spill->path = NULL;
+        PMIX_RELEASE(spill);
+        return NULL;
+    }
+    pmix_list_append(&pmix_server_globals.iof_spills, &spill->super);
+    return spill;
+}
+
+static bool spill_write(pmix_iof_spill_t *spill, const pmix_byte_object_t *bo, size_t *offset)
+{
+    size_t done = 0;
+    ssize_t n;
+
+    while (done < bo->size) {
+        n = pwrite(spill->fd, bo->bytes + done, bo->size - done, spill->size + done);
+        if (0 > n && EINTR == errno) {
+            continue;
+        }
+        if (0 >= n) {
+            return false;
+        }
+        done += n;
+    }
+    *offset = spill->size;
+    spill->size += bo->size;
+    return true;
+}
+
+void pmix_server_iof_cache_add(const pmix_proc_t *source, pmix_iof_channel_t channel,
+                               const pmix_byte_object_t *bo, const pmix_info_t *info,
+                               size_t ninfo)
+{
+    pmix_iof_cache_t *iof;
+    pmix_iof_spill_t *spill = NULL;
+    size_t n;
+
+    if (pmix_server_globals.iof_cache_bytes + bo->size > pmix_server_globals.max_iof_cache_bytes) {
+        spill = get_spill(source, bo->size);
+    }
+    /* make room for the message */
+    while (0 < pmix_list_get_size(&pmix_server_globals.iof)
+           && (pmix_server_globals.max_iof_cache <= pmix_list_get_size(&pmix_server_globals.iof)
+               || (NULL == spill
+                   && pmix_server_globals.iof_cache_bytes + bo->size
+                          > pmix_server_globals.max_iof_cache_bytes))) {
+        iof = (pmix_iof_cache_t *) pmix_list_get_first(&pmix_server_globals.iof);
+        if (NULL != spill && iof->spill == spill && 1 == spill->nentries) {
+            /* dropping the last message in the file would remove it */
+            spill = NULL;
+        }
+        pmix_server_iof_cache_remove(iof);
+    }
+
+    iof = PMIX_NEW(pmix_iof_cache_t);
+    if (NULL == iof) {
+        goto done;
+    }
+    memcpy(&iof->source, source, sizeof(pmix_proc_t));
+    iof->channel = channel;
+    PMIX_BYTE_OBJECT_CREATE(iof->bo, 1);
+    iof->bo->size = bo->size;
+    if (NULL != spill && spill_write(spill, bo, &iof->offset)) {
+        iof->spill = spill;
+        ++spill->nentries;
+    } else if (0 < bo->size) {
+        iof->bo->bytes = (char *) malloc(bo->size);
+        if (NULL == iof->bo->bytes) {
+            PMIX_RELEASE(iof);
+            goto done;
+        }
+        memcpy(iof->bo->bytes, bo->bytes, bo->size);
+        pmix_server_globals.iof_cache_bytes += bo->size;
+    }
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(iof->info, ninfo);
+        iof->ninfo = ninfo;
+        for (n = 0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&iof->info[n], &info[n]);
+        }
+    }
+    pmix_list_append(&pmix_server_globals.iof, &iof->super);
+
+done:
+    if (NULL != spill && 0 == spill->nentries) {
+        /* created for nothing */
+        pmix_list_remove_item(&pmix_server_globals.iof_spills, &spill->super);
+        PMIX_RELEASE(spill);
+    }
+}
+
+bool pmix_server_iof_cache_data(pmix_iof_cache_t *iof, pmix_byte_object_t *bo)
+{
+    pmix_iof_spill_t *spill = iof->spill;
+    void *base;
+
+    if (NULL == spill) {
+        bo->bytes = iof->bo->bytes;
+        bo->size = iof->bo->size;
+        return true;
+    }
+    if (spill->mapped < spill->size) {
+        /* the file grew since we mapped it */
+        if (NULL != spill->base) {
+            munmap(spill->base, spill->mapped);
+            spill->base = NULL;
+            spill->mapped = 0;
+        }
+        base = mmap(NULL, spill->size, PROT_READ, MAP_SHARED, spill->fd, 0);
+        if (MAP_FAILED == base) {
+            pmix_output_verbose(2, pmix_server_globals.iof_output,
+                                "pmix:server:iof cannot map spill file %s: %s", spill->path,
+                                strerror(errno));
+            return false;
+        }
+#ifdef MADV_SEQUENTIAL
+        (void) madvise(base, spill->size, MADV_SEQUENTIAL);
+#endif
+        spill->base = (char *) base;
+        spill->mapped = spill->size;
+    }
+    bo->bytes = spill->base + iof->offset;
+    bo->size = iof->bo->size;
+    return true;
+}
+
+void pmix_server_iof_cache_remove(pmix_iof_cache_t *iof)
+{
+    pmix_iof_spill_t *spill = iof->spill;
+
+    pmix_list_remove_item(&pmix_server_globals.iof, &iof->super);
+    if (NULL != spill) {
+        --spill->nentries;
+        if (0 == spill->nentries) {
+            pmix_list_remove_item(&pmix_server_globals.iof_spills, &spill->super);
+            PMIX_RELEASE(spill);
+        }
+    } else if (NULL != iof->bo) {
+        pmix_server_globals.iof_cache_bytes -= iof->bo->size;
+    }
+    PMIX_RELEASE(iof);
+}
+
+void pmix_server_iof_cache_purge(void)
+{
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
+    PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_list_t);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.iof_spills);
+    PMIX_CONSTRUCT(&pmix_server_globals.iof_spills, pmix_list_t);
+    pmix_server_globals.iof_cache_bytes = 0;
+}
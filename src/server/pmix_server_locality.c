@@ -0,0 +1,129 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#include <stdlib.h>
+
+#include "src/hwloc/pmix_hwloc.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/gds/gds.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* fetch a string value from our own GDS, returning a copy of it */
+static char *fetch_string(pmix_proc_t *proc, const char *key, pmix_info_t *info, size_t ninfo)
+{
+    pmix_cb_t cb;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    char *str = NULL;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = proc;
+    cb.key = (char *) key;
+    cb.info = info;
+    cb.ninfo = ninfo;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS == rc) {
+        kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+        if (NULL != kv && NULL != kv->value && PMIX_STRING == kv->value->type
+            && NULL != kv->value->data.string) {
+            str = strdup(kv->value->data.string);
+        }
+    }
+    cb.proc = NULL;
+    cb.key = NULL;
+    cb.info = NULL;
+    cb.ninfo = 0;
+    PMIX_DESTRUCT(&cb);
+    return str;
+}
+
+void pmix_server_locality_matrix(pmix_namespace_t *nptr)
+{
+    pmix_proc_t proc;
+    pmix_info_t info[2];
+    pmix_byte_object_t bo;
+    pmix_status_t rc;
+    char *peers, **ranks = NULL, **locs = NULL;
+    size_t n, nlocal;
+
+    if (0 == pmix_server_globals.locality_matrix_max) {
+        return;
+    }
+
+    /* get the procs from this nspace that share our node */
+    PMIX_LOAD_PROCID(&proc, nptr->nspace, PMIX_RANK_UNDEF);
+    PMIX_INFO_LOAD(&info[0], PMIX_NODE_INFO, NULL, PMIX_BOOL);
+    PMIX_INFO_LOAD(&info[1], PMIX_HOSTNAME, pmix_globals.hostname, PMIX_STRING);
+    peers = fetch_string(&proc, PMIX_LOCAL_PEERS, info, 2);
+    PMIX_INFO_DESTRUCT(&info[0]);
+    PMIX_INFO_DESTRUCT(&info[1]);
+    if (NULL == peers) {
+        return;
+    }
+    ranks = pmix_argv_split(peers, ',');
+    free(peers);
+    nlocal = pmix_argv_count(ranks);
+    if (2 > nlocal || pmix_server_globals.locality_matrix_max < nlocal) {
+        goto cleanup;
+    }
+
+    /* the host has to have given us the location of each of them */
+    locs = (char **) calloc(nlocal + 1, sizeof(char *));
+    if (NULL == locs) {
+        goto cleanup;
+    }
+    for (n = 0; n < nlocal; n++) {
+        PMIX_LOAD_PROCID(&proc, nptr->nspace, strtoul(ranks[n], NULL, 10));
+        locs[n] = fetch_string(&proc, PMIX_LOCALITY_STRING, NULL, 0);
+        if (NULL == locs[n]) {
+            pmix_output_verbose(2, pmix_server_globals.base_output,
+                                "pmix:server no locality matrix for %s - rank %s has no locality",
+                                nptr->nspace, ranks[n]);
+            goto cleanup;
+        }
+    }
+
+    rc = pmix_hwloc_get_locality_matrix(locs, nlocal, &bo);
+    if (PMIX_SUCCESS != rc) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server no locality matrix for %s: %s",
+                            nptr->nspace, PMIx_Error_string(rc));
+        goto cleanup;
+    }
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server locality matrix for %s: %lu procs in %lu bytes",
+                        nptr->nspace, (unsigned long) nlocal, (unsigned long) bo.size);
+
+    /* add it to the job info passed down to the clients */
+    PMIX_INFO_LOAD(&info[0], PMIX_LOCALITY_MATRIX, &bo, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, info, 1);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_INFO_DESTRUCT(&info[0]);
+
+cleanup:
+    pmix_argv_free(ranks);
+    if (NULL != locs) {
+        pmix_argv_free(locs);
+    }
+}
@@ -56,19 +56,23 @@
 #include "src/class/pmix_list.h"
 #include "src/common/pmix_attributes.h"
 #include "src/common/pmix_iof.h"
+#include "src/include/pmix_hash_string.h"
 #include "src/hwloc/pmix_hwloc.h"
+#include "src/mca/bfrops/base/base.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/gds/base/base.h"
 #include "src/mca/plog/plog.h"
 #include "src/mca/pnet/pnet.h"
 #include "src/mca/prm/prm.h"
 #include "src/mca/psensor/psensor.h"
+#include "src/mca/pstat/pstat.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_environ.h"
+#include "src/util/pmix_trace.h"
 
 #include "src/client/pmix_client_ops.h"
 #include "pmix_server_ops.h"
@@ -117,6 +121,46 @@ pmix_server_module_t pmix_host_server = {
     .client_connected2 = NULL
 };
 
+/* pack the job-level info a local client needs to complete its init */
+pmix_status_t pmix_server_job_info(pmix_peer_t *peer, pmix_buffer_t **reply)
+{
+    pmix_gds_base_module_t *gds = peer->nptr->compat.gds;
+    pmix_buffer_t *bkt;
+    pmix_status_t rc;
+
+    /* if it was already packed for another local client
+     * in this nspace, send them the same bytes */
+    if (NULL != gds->share_job_info &&
+        PMIX_SUCCESS == gds->share_job_info((struct pmix_peer_t *) peer, reply)) {
+        return PMIX_SUCCESS;
+    }
+
+    bkt = PMIX_NEW(pmix_buffer_t);
+    if (NULL == bkt) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_GDS_REGISTER_JOB_INFO(rc, peer, bkt);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bkt);
+        return rc;
+    }
+    /* if the peer is using the "dstore" component, then
+     * we also have to send back any session/node/app-level
+     * info so it can be stored locally in their hash */
+    if (0 != strcmp("hash", gds->name)) {
+        PMIX_GDS_FETCH_INFO_ARRAYS(rc, peer, bkt);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(bkt);
+            return rc;
+        }
+    }
+    *reply = bkt;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
                                 pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
@@ -142,31 +186,14 @@ pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
     if (PMIX_SUCCESS != rc) {
         return rc;
     }
-    /* unpack the number of procs */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, peer, buf, &nprocs, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        return rc;
-    }
-
     /* unpack any provided procs - these are the procs the caller
      * wants aborted */
-    if (0 < nprocs) {
-        PMIX_PROC_CREATE(procs, nprocs);
-        if (NULL == procs) {
-            if (NULL != msg) {
-                free(msg);
-            }
-            return PMIX_ERR_NOMEM;
-        }
-        cnt = nprocs;
-        PMIX_BFROPS_UNPACK(rc, peer, buf, procs, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            if (NULL != msg) {
-                free(msg);
-            }
-            return rc;
+    rc = pmix_unpack_proc_set(peer, buf, &procs, &nprocs);
+    if (PMIX_SUCCESS != rc) {
+        if (NULL != msg) {
+            free(msg);
         }
+        return rc;
     }
 
     /* let the local host's server execute it */
@@ -219,7 +246,10 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     /* this buffer will contain one or more buffers, each
      * representing a different scope. These need to be locally
      * stored separately so we can provide required data based
-     * on the requestor's location */
+     * on the requestor's location. After its first commit, a
+     * client only sends the keys it put since the previous one -
+     * storing a key replaces its prior value, so the rest of
+     * what it committed before is left as is */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &scope, &cnt, PMIX_SCOPE);
     while (PMIX_SUCCESS == rc) {
@@ -343,12 +373,88 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
  *         regardless of location
  * nprocs - the number of procs in the array
  */
+/* compute the signature under which a tracker is indexed. Trackers
+ * with an ID are matched on the ID alone. Otherwise the participants
+ * may be given in any order, so their contributions are combined
+ * with a commutative operation */
+static uint64_t tracker_sig(char *id, pmix_proc_t *procs,
+                            size_t nprocs, pmix_cmd_t type)
+{
+    uint64_t sig, h;
+    uint32_t nshash;
+    size_t i;
+
+    if (NULL != id) {
+        PMIX_HASH_STR(id, nshash);
+        return (uint64_t) nshash;
+    }
+    sig = ((uint64_t) type << 32) ^ (uint64_t) nprocs;
+    for (i = 0; i < nprocs; i++) {
+        PMIX_HASH_STR(procs[i].nspace, nshash);
+        h = ((uint64_t) nshash << 32) | (uint64_t) procs[i].rank;
+        /* scramble the bits so that neighboring ranks
+         * do not cancel each other out */
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        sig += h;
+    }
+    return sig;
+}
+
+static bool tracker_matches(pmix_server_trkr_t *trk, char *id, pmix_proc_t *procs,
+                            size_t nprocs, pmix_cmd_t type)
+{
+    size_t i, j;
+    size_t matches;
+
+    /* Collective operation if unique identified by
+     * the set of participating processes and the type of collective,
+     * or by the operation ID
+     */
+    if (NULL != id) {
+        return (NULL != trk->id && 0 == strcmp(id, trk->id));
+    }
+    if (nprocs != trk->npcs) {
+        return false;
+    }
+    if (type != trk->type) {
+        return false;
+    }
+    /* the procs are usually given in the same order
+     * by every participant */
+    for (i = 0; i < nprocs; i++) {
+        if (procs[i].rank != trk->pcs[i].rank
+            || 0 != strcmp(procs[i].nspace, trk->pcs[i].nspace)) {
+            break;
+        }
+    }
+    if (i == nprocs) {
+        return true;
+    }
+    matches = i;
+    for (; i < nprocs; i++) {
+        /* the procs may be in different order, so we have
+         * to do an exhaustive search */
+        for (j = 0; j < trk->npcs; j++) {
+            if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace)
+                && procs[i].rank == trk->pcs[j].rank) {
+                ++matches;
+                break;
+            }
+        }
+    }
+    return (trk->npcs == matches);
+}
+
 static pmix_server_trkr_t *get_tracker(char *id, pmix_proc_t *procs,
                                        size_t nprocs, pmix_cmd_t type)
 {
     pmix_server_trkr_t *trk;
-    size_t i, j;
-    size_t matches;
+    uint64_t sig;
+    void *ptr;
 
     pmix_output_verbose(5, pmix_server_globals.fence_output,
                         "get_tracker called with %d procs",
@@ -360,49 +466,127 @@ static pmix_server_trkr_t *get_tracker(char *id, pmix_proc_t *procs,
         return NULL;
     }
 
-    /* there is no shortcut way to search the trackers - all
-     * we can do is perform a brute-force search. Fortunately,
-     * it is highly unlikely that there will be more than one
-     * or two active at a time, and they are most likely to
-     * involve only a single proc with WILDCARD rank - so this
-     * shouldn't take long */
+    /* every active tracker has an entry under its signature, so
+     * if there is none then there is no matching tracker */
+    sig = tracker_sig(id, procs, nprocs, type);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&pmix_server_globals.trackers,
+                                                         sig, &ptr)) {
+        return NULL;
+    }
+    trk = (pmix_server_trkr_t *) ptr;
+    if (tracker_matches(trk, id, procs, nprocs, type)) {
+        return trk;
+    }
+
+    /* another tracker has the same signature - fall back to
+     * a brute-force search. This should be extremely rare */
     PMIX_LIST_FOREACH (trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-        /* Collective operation if unique identified by
-         * the set of participating processes and the type of collective,
-         * or by the operation ID
-         */
-        if (NULL != id) {
-            if (NULL != trk->id && 0 == strcmp(id, trk->id)) {
-                return trk;
-            }
-        } else {
-            if (nprocs != trk->npcs) {
-                continue;
-            }
-            if (type != trk->type) {
-                continue;
-            }
-            matches = 0;
-            for (i = 0; i < nprocs; i++) {
-                /* the procs may be in different order, so we have
-                 * to do an exhaustive search */
-                for (j = 0; j < trk->npcs; j++) {
-                    if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace)
-                        && procs[i].rank == trk->pcs[j].rank) {
-                        ++matches;
-                        break;
-                    }
-                }
-            }
-            if (trk->npcs == matches) {
-                return trk;
-            }
+        if (sig == trk->sig && tracker_matches(trk, id, procs, nprocs, type)) {
+            return trk;
         }
     }
     /* No tracker was found */
     return NULL;
 }
 
+static void pool_report(pmix_obj_pool_t *pool)
+{
+    if (2 <= pmix_output_get_verbosity(pmix_server_globals.base_output)) {
+        pmix_obj_pool_report(pmix_server_globals.base_output, pool);
+    }
+    pmix_obj_pool_finalize(pool);
+}
+
+/* release the storage held for reuse by the request pools */
+void pmix_server_pools_finalize(void)
+{
+    pool_report(&pmix_server_globals.server_caddy_pool);
+    pool_report(&pmix_server_globals.setup_caddy_pool);
+    pool_report(&pmix_server_globals.shift_caddy_pool);
+    pool_report(&pmix_server_globals.dmdx_request_pool);
+}
+
+/* remove a tracker from the list of active collectives
+ * and from the index - the caller retains its reference */
+void pmix_server_trk_remove(pmix_server_trkr_t *trk)
+{
+    pmix_server_trkr_t *t;
+    void *ptr;
+
+    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&pmix_server_globals.trackers,
+                                                         trk->sig, &ptr)
+        || ptr != (void *) trk) {
+        return;
+    }
+    pmix_hash_table_remove_value_uint64(&pmix_server_globals.trackers, trk->sig);
+    /* if another tracker shares the signature, it now
+     * takes over the entry */
+    PMIX_LIST_FOREACH (t, &pmix_server_globals.collectives, pmix_server_trkr_t) {
+        if (t->sig == trk->sig) {
+            pmix_hash_table_set_value_uint64(&pmix_server_globals.trackers, t->sig, t);
+            break;
+        }
+    }
+}
+
+/* if the participants asked for only some of their keys to be
+ * collected, see if this is one of them - the rest are left for
+ * the direct modex to fetch when they are asked for */
+bool pmix_server_trk_collects(pmix_server_trkr_t *trk, const char *key)
+{
+    size_t len;
+    int n;
+
+    if (NULL == trk->collect_keys) {
+        return true;
+    }
+    for (n = 0; NULL != trk->collect_keys[n]; n++) {
+        len = strlen(trk->collect_keys[n]);
+        if (0 < len && '*' == trk->collect_keys[n][len - 1]) {
+            if (0 == strncmp(key, trk->collect_keys[n], len - 1)) {
+                return true;
+            }
+        } else if (0 == strcmp(key, trk->collect_keys[n])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* once the tracker is fully defined, the operation is purely local
+ * if every participant is one of our clients - i.e., the number of
+ * local participants matches the number of participants across all
+ * the nspaces involved. A participant in an nspace we don't know, or
+ * whose size we were not given, is assumed to be remote */
+bool pmix_server_trk_all_local(pmix_server_trkr_t *trk)
+{
+    pmix_namespace_t *nptr, *ns;
+    size_t i, total = 0;
+
+    if (!trk->local || !trk->def_complete) {
+        return false;
+    }
+    for (i = 0; i < trk->npcs; i++) {
+        if (PMIX_RANK_WILDCARD != trk->pcs[i].rank) {
+            ++total;
+            continue;
+        }
+        nptr = NULL;
+        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
+            if (PMIX_CHECK_NSPACE(trk->pcs[i].nspace, ns->nspace)) {
+                nptr = ns;
+                break;
+            }
+        }
+        if (NULL == nptr || 0 == nptr->nprocs) {
+            return false;
+        }
+        total += nptr->nprocs;
+    }
+    return (total == trk->nlocal);
+}
+
 /* create a new object for tracking LOCAL participation in a collective
  * operation such as "fence". The only way this function can be
  * called is if at least one local client process is participating
@@ -429,6 +613,7 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs,
     pmix_rank_info_t *info;
     pmix_nspace_caddy_t *nm;
     pmix_nspace_t first;
+    void *ptr;
 
     pmix_output_verbose(5, pmix_server_globals.fence_output,
                         "new_tracker called with %d procs",
@@ -599,8 +784,16 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs,
 
     if (all_def) {
         trk->def_complete = true;
+        trk->local = pmix_server_trk_all_local(trk);
     }
     pmix_list_append(&pmix_server_globals.collectives, &trk->super);
+    /* index it unless a tracker with the same signature
+     * already holds the entry */
+    trk->sig = tracker_sig(id, procs, nprocs, type);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&pmix_server_globals.trackers,
+                                                         trk->sig, &ptr)) {
+        pmix_hash_table_set_value_uint64(&pmix_server_globals.trackers, trk->sig, trk);
+    }
     return trk;
 }
 
@@ -620,6 +813,226 @@ static void fence_timeout(int sd, short args, void *cbdata)
     PMIX_RELEASE(trk);
 }
 
+/* Values that are the same for several ranks of the node - NIC
+ * address prefixes, device lists, driver versions - can be put in
+ * the blob once. The packed form of each value the node's ranks
+ * posted is counted in a table keyed by those bytes, then every
+ * value seen more than once is numbered from one and copied into
+ * the header of the blob. The table then maps the packed value to
+ * its number, or to zero for values held by a single rank */
+static pmix_status_t _vtab_count(pmix_hash_table_t *vtab, pmix_value_t *val)
+{
+    pmix_buffer_t tmp;
+    void *count = NULL;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, val, 1, PMIX_VALUE);
+    if (PMIX_SUCCESS == rc) {
+        (void) pmix_hash_table_get_value_ptr(vtab, tmp.base_ptr, tmp.bytes_used, &count);
+        rc = pmix_hash_table_set_value_ptr(vtab, tmp.base_ptr, tmp.bytes_used,
+                                           (void *) ((uintptr_t) count + 1));
+    }
+    PMIX_DESTRUCT(&tmp);
+    return rc;
+}
+
+static pmix_status_t _vtab_build(pmix_hash_table_t *vtab, pmix_buffer_t *vals, uint32_t *nvals)
+{
+    pmix_buffer_t tmp;
+    void *key, *count, *node;
+    size_t ksize;
+    pmix_status_t rc = PMIX_SUCCESS;
+    int ret;
+
+    *nvals = 0;
+    ret = pmix_hash_table_get_first_key_ptr(vtab, &key, &ksize, &count, &node);
+    while (PMIX_SUCCESS == ret) {
+        if (1 < (uintptr_t) count) {
+            PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+            PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_globals.mypeer, &tmp, key, ksize);
+            PMIX_BFROPS_COPY_PAYLOAD(rc, pmix_globals.mypeer, vals, &tmp);
+            tmp.base_ptr = NULL;
+            PMIX_DESTRUCT(&tmp);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                return rc;
+            }
+            ++(*nvals);
+            count = (void *) (uintptr_t) *nvals;
+        } else {
+            count = NULL;
+        }
+        rc = pmix_hash_table_set_value_ptr(vtab, key, ksize, count);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        ret = pmix_hash_table_get_next_key_ptr(vtab, &key, &ksize, &count, node, &node);
+    }
+    return PMIX_SUCCESS;
+}
+
+static uint32_t _vtab_ref(pmix_hash_table_t *vtab, pmix_value_t *val)
+{
+    pmix_buffer_t tmp;
+    void *ref = NULL;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, val, 1, PMIX_VALUE);
+    if (PMIX_SUCCESS == rc) {
+        (void) pmix_hash_table_get_value_ptr(vtab, tmp.base_ptr, tmp.bytes_used, &ref);
+    }
+    PMIX_DESTRUCT(&tmp);
+    return (uint32_t) (uintptr_t) ref;
+}
+
+/* pack the remote contribution of the proc in the given caddy,
+ * prefixed by its rank relative to all participants, into a new
+ * buffer. If a value table is given, values found in it are packed
+ * as references. No buffer is returned if the proc posted nothing */
+static pmix_status_t _pack_contribution(pmix_server_trkr_t *trk, pmix_server_caddy_t *scd,
+                                        pmix_gds_modex_key_fmt_t kmap_type, char ***kmap,
+                                        pmix_hash_table_t *vtab, pmix_buffer_t **out)
+{
+    pmix_buffer_t *pbkt;
+    pmix_cb_t cb;
+    pmix_kval_t *kv;
+    pmix_proc_t pcs;
+    pmix_rank_t rel_rank;
+    pmix_nspace_caddy_t *nm;
+    pmix_status_t rc;
+    uint32_t vref;
+    bool found;
+
+    *out = NULL;
+    pmix_strncpy(pcs.nspace, scd->peer->info->pname.nspace, PMIX_MAX_NSLEN);
+    pcs.rank = scd->peer->info->pname.rank;
+    /* calculate the throughout rank */
+    rel_rank = 0;
+    found = false;
+    if (pmix_list_get_size(&trk->nslist) == 1) {
+        found = true;
+    } else {
+        PMIX_LIST_FOREACH (nm, &trk->nslist, pmix_nspace_caddy_t) {
+            if (0 == strcmp(nm->ns->nspace, pcs.nspace)) {
+                found = true;
+                break;
+            }
+            rel_rank += nm->ns->nprocs;
+        }
+    }
+    if (false == found) {
+        rc = PMIX_ERR_NOT_FOUND;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    rel_rank += pcs.rank;
+
+    /* get any remote contribution - note that there
+     * may not be a contribution */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &pcs;
+    cb.scope = PMIX_REMOTE;
+    cb.copy = true;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&cb);
+        return PMIX_SUCCESS;
+    }
+
+    pbkt = PMIX_NEW(pmix_buffer_t);
+    /* pack the relative rank */
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, pbkt, &rel_rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        PMIX_RELEASE(pbkt);
+        return rc;
+    }
+    /* pack the returned kval's */
+    PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
+        if (!pmix_server_trk_collects(trk, kv->key)) {
+            continue;
+        }
+        if (NULL != vtab) {
+            vref = _vtab_ref(vtab, kv->value);
+            rc = pmix_gds_base_modex_pack_kval(kmap_type, pbkt, kmap, kv, &vref);
+        } else {
+            rc = pmix_gds_base_modex_pack_kval(kmap_type, pbkt, kmap, kv, NULL);
+        }
+        if (rc != PMIX_SUCCESS) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&cb);
+            PMIX_RELEASE(pbkt);
+            return rc;
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    *out = pbkt;
+    return PMIX_SUCCESS;
+}
+
+/* add the contribution of the proc in the given caddy to the
+ * blob being assembled for the host as it arrives, so the blob
+ * is ready as soon as the last local participant checks in. We
+ * can't know the keys of procs that have yet to arrive, so the
+ * keys are packed in native format. Any problem simply abandons
+ * the pipeline - _collect_data will then assemble the blob at
+ * completion as usual */
+static void _pipeline_contribution(pmix_server_trkr_t *trk, pmix_server_caddy_t *cd)
+{
+    pmix_buffer_t *pbkt;
+    pmix_byte_object_t bo;
+    pmix_gds_modex_blob_info_t blob_info_byte = PMIX_GDS_COLLECT_BIT;
+    pmix_status_t rc;
+
+    if (PMIX_COLLECT_YES != trk->collect_type || !trk->def_complete) {
+        goto abandon;
+    }
+    if (1 == pmix_list_get_size(&trk->local_cbs)) {
+        /* first contribution - start the blob */
+        if (NULL != trk->pipeline) {
+            PMIX_RELEASE(trk->pipeline);
+        }
+        trk->pipeline = PMIX_NEW(pmix_buffer_t);
+        trk->npipelined = 0;
+        /* pack the modex blob info byte */
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, trk->pipeline, &blob_info_byte, 1, PMIX_BYTE);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto abandon;
+        }
+    } else if (NULL == trk->pipeline
+               || trk->npipelined + 1 != pmix_list_get_size(&trk->local_cbs)) {
+        /* a contribution was missed or a participant went away */
+        goto abandon;
+    }
+
+    rc = _pack_contribution(trk, cd, PMIX_MODEX_KEY_NATIVE_FMT, NULL, NULL, &pbkt);
+    if (PMIX_SUCCESS != rc) {
+        goto abandon;
+    }
+    if (NULL != pbkt) {
+        PMIX_UNLOAD_BUFFER(pbkt, bo.bytes, bo.size);
+        PMIX_RELEASE(pbkt);
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, trk->pipeline, &bo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo); // releases the data
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto abandon;
+        }
+    }
+    ++trk->npipelined;
+    return;
+
+abandon:
+    if (NULL != trk->pipeline) {
+        PMIX_RELEASE(trk->pipeline);
+        trk->pipeline = NULL;
+    }
+}
+
 static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
 {
     pmix_buffer_t bucket, *pbkt = NULL;
@@ -629,13 +1042,14 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
     pmix_server_caddy_t *scd;
     pmix_proc_t pcs;
     pmix_status_t rc = PMIX_SUCCESS;
-    pmix_rank_t rel_rank;
-    pmix_nspace_caddy_t *nm;
-    bool found, data_added;
     pmix_list_t rank_blobs;
     rank_blob_t *blob;
-    uint32_t kmap_size;
+    uint32_t kmap_size, nvals = 0;
     int key_idx;
+    size_t bsize;
+    pmix_hash_table_t vtab;
+    pmix_buffer_t vals;
+    bool dedup = pmix_server_globals.fence_dedup;
 
     /* key names map, the position of the key name
      * in the array determines the unique key index */
@@ -644,7 +1058,31 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
     pmix_gds_modex_blob_info_t blob_info_byte = 0;
     pmix_gds_modex_key_fmt_t kmap_type = PMIX_MODEX_KEY_INVALID;
 
+    /* if every contribution was packed as it arrived, the
+     * blob is already complete */
+    if (PMIX_COLLECT_YES == trk->collect_type && NULL != trk->pipeline
+        && trk->npipelined == pmix_list_get_size(&trk->local_cbs)) {
+        pmix_output_verbose(2, pmix_server_globals.fence_output,
+                            "fence - using pipelined data");
+        PMIX_UNLOAD_BUFFER(trk->pipeline, bo.bytes, bo.size);
+        PMIX_RELEASE(trk->pipeline);
+        trk->pipeline = NULL;
+        pmix_bfrops_base_buffer_reserve(buf, 2 * sizeof(pmix_data_type_t) + sizeof(size_t)
+                                                 + bo.size);
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &bo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo); // releases the data
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        return rc;
+    }
+
     PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    PMIX_CONSTRUCT(&vals, pmix_buffer_t);
+    PMIX_CONSTRUCT(&vtab, pmix_hash_table_t);
+    if (dedup) {
+        pmix_hash_table_init(&vtab, 256);
+    }
 
     if (PMIX_COLLECT_YES == trk->collect_type) {
        pmix_output_verbose(2, pmix_server_globals.fence_output,
@@ -672,6 +1110,9 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
                 PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
                 if (PMIX_SUCCESS == rc) {
                     PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
+                        if (!pmix_server_trk_collects(trk, kv->key)) {
+                            continue;
+                        }
                         rc = pmix_argv_append_unique_idx(&key_idx, &kmap, kv->key);
                         if (pmix_value_array_get_size(key_count_array) < (size_t)(key_idx + 1)) {
                             size_t new_size;
@@ -685,8 +1126,13 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
                         }
                         key_count = PMIX_VALUE_ARRAY_GET_BASE(key_count_array, uint32_t);
                         key_count[key_idx]++;
+                        if (dedup && PMIX_SUCCESS != _vtab_count(&vtab, kv->value)) {
+                            /* just send everything inline */
+                            dedup = false;
+                        }
                     }
                 }
+                PMIX_DESTRUCT(&cb);
             }
             for (i = 0; i < pmix_argv_count(kmap); i++) {
                 pmix_buffer_t tmp;
@@ -716,77 +1162,28 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
             pmix_output_verbose(5, pmix_server_globals.fence_output, "key packing type %s",
                                 kmap_type == PMIX_MODEX_KEY_KEYMAP_FMT ? "kmap" : "native");
         }
-        PMIX_CONSTRUCT(&rank_blobs, pmix_list_t);
-        PMIX_LIST_FOREACH (scd, &trk->local_cbs, pmix_server_caddy_t) {
-            /* get any remote contribution - note that there
-             * may not be a contribution */
-            pmix_strncpy(pcs.nspace, scd->peer->info->pname.nspace, PMIX_MAX_NSLEN);
-            pcs.rank = scd->peer->info->pname.rank;
-            pbkt = PMIX_NEW(pmix_buffer_t);
-            /* calculate the throughout rank */
-            rel_rank = 0;
-            found = false;
-            if (pmix_list_get_size(&trk->nslist) == 1) {
-                found = true;
-            } else {
-                PMIX_LIST_FOREACH (nm, &trk->nslist, pmix_nspace_caddy_t) {
-                    if (0 == strcmp(nm->ns->nspace, pcs.nspace)) {
-                        found = true;
-                        break;
-                    }
-                    rel_rank += nm->ns->nprocs;
-                }
-            }
-            if (false == found) {
-                rc = PMIX_ERR_NOT_FOUND;
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&cb);
-                PMIX_DESTRUCT(&rank_blobs);
-                PMIX_RELEASE(pbkt);
+        if (dedup) {
+            rc = _vtab_build(&vtab, &vals, &nvals);
+            if (PMIX_SUCCESS != rc) {
                 goto cleanup;
             }
-            rel_rank += pcs.rank;
-
-            /* pack the relative rank */
-            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, pbkt, &rel_rank, 1, PMIX_PROC_RANK);
+            pmix_output_verbose(5, pmix_server_globals.fence_output,
+                                "fence - %u values shared by several ranks", nvals);
+        }
+        PMIX_CONSTRUCT(&rank_blobs, pmix_list_t);
+        PMIX_LIST_FOREACH (scd, &trk->local_cbs, pmix_server_caddy_t) {
+            rc = _pack_contribution(trk, scd, kmap_type, &kmap, dedup ? &vtab : NULL, &pbkt);
             if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DESTRUCT(&cb);
                 PMIX_DESTRUCT(&rank_blobs);
-                PMIX_RELEASE(pbkt);
                 goto cleanup;
             }
-            data_added = false;
-            PMIX_CONSTRUCT(&cb, pmix_cb_t);
-            cb.proc = &pcs;
-            cb.scope = PMIX_REMOTE;
-            cb.copy = true;
-            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-            if (PMIX_SUCCESS == rc) {
-                /* pack the returned kval's */
-                PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
-                    rc = pmix_gds_base_modex_pack_kval(kmap_type, pbkt, &kmap, kv);
-                    if (rc != PMIX_SUCCESS) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DESTRUCT(&cb);
-                        PMIX_DESTRUCT(&rank_blobs);
-                        PMIX_RELEASE(pbkt);
-                        goto cleanup;
-                    }
-                }
-                data_added = true;
-            }
-            if (data_added) {
+            if (NULL != pbkt) {
                 /* add part of the process modex to the list */
                 blob = PMIX_NEW(rank_blob_t);
                 blob->buf = pbkt;
                 pmix_list_append(&rank_blobs, &blob->super);
                 pbkt = NULL;
             }
-            PMIX_DESTRUCT(&cb);
-            if (NULL != pbkt) {
-                PMIX_RELEASE(pbkt);
-            }
         }
         /* mark the collection type so we can check on the
          * receiving end that all participants did the same. Note
@@ -798,6 +1195,23 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
         if (PMIX_MODEX_KEY_KEYMAP_FMT == kmap_type) {
             blob_info_byte |= PMIX_GDS_KEYMAP_BIT;
         }
+        if (dedup) {
+            blob_info_byte |= PMIX_GDS_VALTAB_BIT;
+        }
+        /* size the bucket for the header we are about to put in it -
+         * the blobs themselves are chained on, not copied */
+        bsize = 2 * sizeof(pmix_data_type_t) + sizeof(uint8_t);
+        if (PMIX_MODEX_KEY_KEYMAP_FMT == kmap_type) {
+            for (i = 0; NULL != kmap && NULL != kmap[i]; i++) {
+                bsize += sizeof(pmix_data_type_t) + sizeof(int32_t) + strlen(kmap[i]) + 1;
+            }
+            bsize += sizeof(pmix_data_type_t) + sizeof(uint32_t);
+        }
+        if (dedup) {
+            bsize += sizeof(pmix_data_type_t) + sizeof(uint32_t) + vals.bytes_used;
+        }
+        pmix_bfrops_base_buffer_reserve(&bucket, bsize);
+
         /* pack the modex blob info byte */
         PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &blob_info_byte, 1, PMIX_BYTE);
 
@@ -811,13 +1225,22 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
                 PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, kmap, kmap_size, PMIX_STRING);
             }
         }
-        /* pack the collected blobs of processes */
+        if (dedup) {
+            /* the shared values follow, in the order of their references */
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &nvals, 1, PMIX_UINT32);
+            if (PMIX_SUCCESS == rc) {
+                PMIX_BFROPS_COPY_PAYLOAD(rc, pmix_globals.mypeer, &bucket, &vals);
+            }
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_LIST_DESTRUCT(&rank_blobs);
+                goto cleanup;
+            }
+        }
+        /* pack the collected blobs of processes - each is moved
+         * onto the bucket as a byte object */
         PMIX_LIST_FOREACH (blob, &rank_blobs, rank_blob_t) {
-            /* extract the blob */
-            PMIX_UNLOAD_BUFFER(blob->buf, bo.bytes, bo.size);
-            /* pack the returned blob */
-            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &bo, 1, PMIX_BYTE_OBJECT);
-            PMIX_BYTE_OBJECT_DESTRUCT(&bo); // releases the data
+            PMIX_BFROPS_CHAIN_PAYLOAD(rc, pmix_globals.mypeer, &bucket, blob->buf);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 goto cleanup;
@@ -842,10 +1265,13 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
     if (!PMIX_BUFFER_IS_EMPTY(&bucket)) {
         /* because the remote servers have to unpack things
          * in chunks, we have to pack the bucket as a single
-         * byte object to allow remote unpack */
-        PMIX_UNLOAD_BUFFER(&bucket, bo.bytes, bo.size);
-        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &bo, 1, PMIX_BYTE_OBJECT);
-        PMIX_BYTE_OBJECT_DESTRUCT(&bo); // releases the data
+         * byte object to allow remote unpack. The host needs
+         * the result as one blob, so this is where the pieces
+         * are finally copied together - once */
+        PMIX_BFROPS_CHAIN_PAYLOAD(rc, pmix_globals.mypeer, buf, &bucket);
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_bfrops_base_buffer_flatten(buf);
+        }
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
         }
@@ -853,6 +1279,8 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
 
 cleanup:
     PMIX_DESTRUCT(&bucket);
+    PMIX_DESTRUCT(&vals);
+    PMIX_DESTRUCT(&vtab);
     pmix_argv_free(kmap);
     return rc;
 }
@@ -865,6 +1293,9 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
     size_t nprocs;
     pmix_proc_t *procs = NULL, *newprocs;
     bool collect_data = false;
+    char *keys = NULL;
+    uint32_t mdx_time = 0;
+    bool mdx_fetched = false;
     pmix_server_trkr_t *trk;
     char *data = NULL;
     size_t sz = 0;
@@ -910,31 +1341,31 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
      * a PMIx group */
     nmbrs = nprocs;
     PMIX_CONSTRUCT(&expand, pmix_list_t);
-    /* use groups as the outer-most loop as there will
-     * usually not be any */
-    PMIX_LIST_FOREACH (grp, &pmix_server_globals.groups, pmix_group_t) {
+    if (0 < pmix_list_get_size(&pmix_server_globals.groups)) {
         for (n = 0; n < nprocs; n++) {
-            if (PMIX_CHECK_NSPACE(procs[n].nspace, grp->grpid)) {
-                /* we need to replace this proc with grp members */
-                if (PMIX_RANK_WILDCARD == procs[n].rank) {
-                    gcd = PMIX_NEW(pmix_group_caddy_t);
-                    gcd->grp = grp;
-                    gcd->idx = n;
-                    gcd->rank = PMIX_RANK_WILDCARD;
-                    pmix_list_append(&expand, &gcd->super);
-                    nmbrs += grp->nmbrs - 1; // account for replacing current proc
-                } else {
-                    /* find the matching rank */
-                    if (grp->nmbrs <= procs[n].rank) {
-                        /* the group rank is out of bounds */
-                        PMIX_LIST_DESTRUCT(&expand);
-                        rc = PMIX_ERR_BAD_PARAM;
-                        goto cleanup;
-                    }
-                    /* we own the procs array, so just replace the procs entry
-                     * with that of the member with that group rank */
-                    memcpy(&procs[n], &grp->members[procs[n].rank], sizeof(pmix_proc_t));
+            grp = pmix_server_group_lookup(procs[n].nspace);
+            if (NULL == grp) {
+                continue;
+            }
+            /* we need to replace this proc with grp members */
+            if (PMIX_RANK_WILDCARD == procs[n].rank) {
+                gcd = PMIX_NEW(pmix_group_caddy_t);
+                gcd->grp = grp;
+                gcd->idx = n;
+                gcd->rank = PMIX_RANK_WILDCARD;
+                pmix_list_append(&expand, &gcd->super);
+                nmbrs += grp->nmbrs - 1; // account for replacing current proc
+            } else {
+                /* find the matching rank */
+                if (grp->nmbrs <= procs[n].rank) {
+                    /* the group rank is out of bounds */
+                    PMIX_LIST_DESTRUCT(&expand);
+                    rc = PMIX_ERR_BAD_PARAM;
+                    goto cleanup;
                 }
+                /* we own the procs array, so just replace the procs entry
+                 * with that of the member with that group rank */
+                memcpy(&procs[n], &grp->members[procs[n].rank], sizeof(pmix_proc_t));
             }
         }
     }
@@ -989,11 +1420,14 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
             PMIX_INFO_FREE(info, ninfo);
             goto cleanup;
         }
-        /* see if we are to collect data or enforce a timeout - we don't internally care
-         * about any other directives */
+        /* see if we are to collect data (and which of it) or enforce a
+         * timeout - we don't internally care about any other directives */
         for (n = 0; n < ninf; n++) {
             if (PMIX_CHECK_KEY(&info[n], PMIX_COLLECT_DATA)) {
                 collect_data = PMIX_INFO_TRUE(&info[n]);
+            } else if (PMIX_CHECK_KEY(&info[n], PMIX_COLLECT_KEYS)
+                       && PMIX_STRING == info[n].value.type) {
+                keys = info[n].value.data.string;
             } else if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
                 PMIX_VALUE_GET_NUMBER(rc, &info[n].value, tv.tv_sec, uint32_t);
                 if (PMIX_SUCCESS != rc) {
@@ -1001,6 +1435,15 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
                     PMIX_INFO_FREE(info, ninfo);
                     return rc;
                 }
+            } else if (PMIX_CHECK_KEY(&info[n], PMIX_MODEX_RELEASE_TIME)) {
+                PMIX_VALUE_GET_NUMBER(rc, &info[n].value, mdx_time, uint32_t);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_PROC_FREE(procs, nprocs);
+                    PMIX_INFO_FREE(info, ninfo);
+                    return rc;
+                }
+            } else if (PMIX_CHECK_KEY(&info[n], PMIX_MODEX_RELEASE_FETCHED)) {
+                mdx_fetched = PMIX_INFO_TRUE(&info[n]);
             }
         }
     }
@@ -1024,9 +1467,13 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
         /* mark if they want the data back */
         if (collect_data) {
             trk->collect_type = PMIX_COLLECT_YES;
+            if (NULL != keys) {
+                trk->collect_keys = pmix_argv_split(keys, ',');
+            }
         } else {
             trk->collect_type = PMIX_COLLECT_NO;
         }
+        PMIX_TRACE3(fence_create, trk, trk->npcs, trk->nlocal);
     } else {
         switch (trk->collect_type) {
         case PMIX_COLLECT_NO:
@@ -1044,6 +1491,14 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
         }
     }
 
+    /* any participant can ask for the collected data to be released */
+    if (0 < mdx_time) {
+        trk->mdx_release_time = mdx_time;
+    }
+    if (mdx_fetched) {
+        trk->mdx_release_fetched = true;
+    }
+
     /* we only save the info structs from the first caller
      * who provides them - it is a user error to provide
      * different values from different participants */
@@ -1060,9 +1515,12 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
     /* add this contributor to the tracker so they get
      * notified when we are done */
     pmix_list_append(&trk->local_cbs, &cd->super);
+    if (pmix_server_globals.fence_pipeline && !pmix_server_globals.fence_dedup) {
+        _pipeline_contribution(trk, cd);
+    }
     /* if a timeout was specified, set it */
     if (0 < tv.tv_sec && !trk->event_active) {
-        PMIX_THREADSHIFT_DELAY(trk, fence_timeout, tv.tv_sec);
+        pmix_timer_add(&trk->timer, tv.tv_sec, fence_timeout, trk);
         trk->event_active = true;
     }
 
@@ -1079,7 +1537,7 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
          * the tracker AFTER we released it due to our internal
          * timeout firing */
         if (trk->event_active) {
-            pmix_event_del(&trk->ev);
+            pmix_timer_del(&trk->timer);
             trk->event_active = false;
         }
         /* if this is a purely local fence (i.e., all participants are local),
@@ -1146,6 +1604,10 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
         rc = pmix_host_server.fence_nb(trk->pcs, trk->npcs, trk->info, trk->ninfo, data, sz,
                                        trk->modexcbfunc, trk);
         if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
+            /* the host did not take the data */
+            if (NULL != data) {
+                free(data);
+            }
             /* clear the caddy from this tracker so it can be
              * released upon return - the switchyard will send an
              * error to this caller, and so the fence completion
@@ -1228,7 +1690,7 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer, pmix_buffer_t *buf,
         return rc;
     }
     /* we will be adding one for the user id */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -1256,7 +1718,10 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer, pmix_buffer_t *buf,
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
-    rc = pmix_host_server.publish(&proc, cd->info, cd->ninfo, opcbfunc, cd);
+    PMIX_LOAD_PROCID(&cd->proc, proc.nspace, proc.rank);
+    /* passed up together with any others from this proc
+     * that arrive while the host is working on it */
+    rc = pmix_server_pubsub_submit(cd);
 
 cleanup:
     if (PMIX_SUCCESS != rc) {
@@ -1273,6 +1738,11 @@ static void lkcbfunc(pmix_status_t status, pmix_pdata_t data[],
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
 
+    /* remember the answer for the next time it is asked for */
+    if (PMIX_SUCCESS == status) {
+        pmix_server_pubsub_learn(&cd->proc, cd->info, cd->ninfo, data, ndata);
+    }
+
     /* cleanup the caddy */
     if (NULL != cd->keys) {
         pmix_argv_free(cd->keys);
@@ -1296,9 +1766,10 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer, pmix_buffer_t *buf,
     pmix_status_t rc;
     size_t nkeys, i;
     char *sptr;
-    size_t ninfo;
+    size_t ninfo, ndata;
     pmix_proc_t proc;
     uint32_t uid;
+    pmix_pdata_t *pdata;
 
     pmix_output_verbose(2, pmix_server_globals.pub_output, "recvd LOOKUP");
 
@@ -1321,7 +1792,7 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer, pmix_buffer_t *buf,
         return rc;
     }
     /* setup the caddy */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -1368,6 +1839,21 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer, pmix_buffer_t *buf,
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
+    if (pmix_server_pubsub_lookup(&proc, cd->keys, cd->info, cd->ninfo, &pdata, &ndata)) {
+        if (NULL != cbfunc) {
+            cbfunc(PMIX_SUCCESS, pdata, ndata, cbdata);
+        }
+        PMIX_PDATA_FREE(pdata, ndata);
+        pmix_argv_free(cd->keys);
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+        PMIX_RELEASE(cd);
+        return PMIX_SUCCESS;
+    }
+    PMIX_LOAD_PROCID(&cd->proc, proc.nspace, proc.rank);
+    /* lookups waiting for the same data share one request at the host */
+    if (pmix_server_pubsub_wait(cd, &rc)) {
+        goto cleanup;
+    }
     rc = pmix_host_server.lookup(&proc, cd->keys, cd->info, cd->ninfo, lkcbfunc, cd);
 
 cleanup:
@@ -1416,7 +1902,7 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer, pmix_buffer_t *buf,
         return rc;
     }
     /* setup the caddy */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -1463,6 +1949,9 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer, pmix_buffer_t *buf,
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
+    /* stop answering from our copy right away - the host
+     * will tell the requestor if the data wasn't there */
+    pmix_server_pubsub_unpublish(&proc, cd->keys);
     rc = pmix_host_server.unpublish(&proc, cd->keys, cd->info, cd->ninfo, opcbfunc, cd);
 
 cleanup:
@@ -1485,6 +1974,9 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
     pmix_buffer_t *msg;
     pmix_status_t rc;
     pmix_iof_cache_t *iof, *ionext;
+    pmix_byte_object_t bo, cbo;
+    pmix_iof_channel_t channel;
+    bool compressed;
 
     /* if it was successful, and there are IOF requests, then
      * register them now */
@@ -1517,6 +2009,9 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
             if (PMIX_CHECK_PROCID(&iof->source, &req->requestor->info->pname)) {
                 continue;
             }
+            if (!pmix_server_iof_cache_data(iof, &bo)) {
+                continue;
+            }
             pmix_output_verbose(2, pmix_server_globals.iof_output,
                                 "PMIX:SERVER:SPAWN delivering cached IOF from %s to %s",
                                 PMIX_NAME_PRINT(&iof->source),
@@ -1535,9 +2030,12 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
                 break;
             }
             /* provide the channel */
-            PMIX_BFROPS_PACK(rc, req->requestor, msg, &iof->channel, 1, PMIX_IOF_CHANNEL);
+            channel = iof->channel;
+            compressed = pmix_iof_compress(req->requestor, &channel, &bo, &cbo);
+            PMIX_BFROPS_PACK(rc, req->requestor, msg, &channel, 1, PMIX_IOF_CHANNEL);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
+                PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                 PMIX_RELEASE(msg);
                 break;
             }
@@ -1545,6 +2043,7 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
             PMIX_BFROPS_PACK(rc, req->requestor, msg, &req->remote_id, 1, PMIX_SIZE);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
+                PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                 PMIX_RELEASE(msg);
                 break;
             }
@@ -1552,6 +2051,7 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
             PMIX_BFROPS_PACK(rc, req->requestor, msg, &iof->ninfo, 1, PMIX_SIZE);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
+                PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                 PMIX_RELEASE(msg);
                 break;
             }
@@ -1559,12 +2059,15 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
                 PMIX_BFROPS_PACK(rc, req->requestor, msg, iof->info, iof->ninfo, PMIX_INFO);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
+                    PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
                     PMIX_RELEASE(msg);
                     break;
                 }
             }
             /* pack the data */
-            PMIX_BFROPS_PACK(rc, req->requestor, msg, iof->bo, 1, PMIX_BYTE_OBJECT);
+            PMIX_BFROPS_PACK(rc, req->requestor, msg, compressed ? &cbo : &bo, 1,
+                             PMIX_BYTE_OBJECT);
+            PMIX_BYTE_OBJECT_DESTRUCT(&cbo);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(msg);
@@ -1577,8 +2080,7 @@ void pmix_server_spcbfunc(pmix_status_t status, char nspace[], void *cbdata)
                 PMIX_RELEASE(msg);
             }
             /* remove it from the list since it has now been forwarded */
-            pmix_list_remove_item(&pmix_server_globals.iof, &iof->super);
-            PMIX_RELEASE(iof);
+            pmix_server_iof_cache_remove(iof);
         }
     }
 
@@ -1659,7 +2161,7 @@ pmix_status_t pmix_server_spawn(pmix_peer_t *peer, pmix_buffer_t *buf,
     }
 
     /* setup */
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2067,7 +2569,7 @@ pmix_status_t pmix_server_connect(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
     /* if a timeout was specified, set it */
     if (PMIX_SUCCESS == rc && 0 < tv.tv_sec) {
         PMIX_RETAIN(trk);
-        PMIX_THREADSHIFT_DELAY(trk, connect_timeout, tv.tv_sec);
+        pmix_timer_add(&trk->timer, tv.tv_sec, connect_timeout, trk);
         trk->event_active = true;
     }
 
@@ -2084,11 +2586,10 @@ cleanup:
 static void _check_cached_events(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *scd = (pmix_setup_caddy_t *) cbdata;
-    pmix_notify_caddy_t *cd;
+    pmix_notify_caddy_t *cd, **cds = NULL;
     pmix_range_trkr_t rngtrk;
     pmix_proc_t proc;
-    int i;
-    size_t k, n;
+    size_t i, n, ncds = 0;
     bool found, matched;
     pmix_buffer_t *relay;
     pmix_status_t ret = PMIX_SUCCESS;
@@ -2099,28 +2600,9 @@ static void _check_cached_events(int sd, short args, void *cbdata)
     /* check if any matching notifications have been cached */
     rngtrk.procs = NULL;
     rngtrk.nprocs = 0;
-    for (i = 0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_knock(&pmix_globals.notifications, i, (void **) &cd);
-        if (NULL == cd) {
-            continue;
-        }
-        found = false;
-        if (NULL == scd->codes) {
-            if (!cd->nondefault) {
-                /* they registered a default event handler - always matches */
-                found = true;
-            }
-        } else {
-            for (k = 0; k < scd->ncodes; k++) {
-                if (scd->codes[k] == cd->status) {
-                    found = true;
-                    break;
-                }
-            }
-        }
-        if (!found) {
-            continue;
-        }
+    ret = pmix_notify_event_cached(scd->codes, scd->ncodes, &cds, &ncds);
+    for (i = 0; i < ncds; i++) {
+        cd = cds[i];
         /* check if the affected procs (if given) match those they
          * wanted to know about */
         if (!pmix_notify_check_affected(cd->affected, cd->naffected, scd->procs, scd->nprocs)) {
@@ -2157,7 +2639,7 @@ static void _check_cached_events(int sd, short args, void *cbdata)
                     /* if this is the last one, then evict this event
                      * from the cache */
                     if (0 == cd->nleft) {
-                        pmix_hotel_checkout(&pmix_globals.notifications, cd->room);
+                        pmix_notify_event_uncache(cd);
                         found = true; // mark that we should release cd
                     }
                     break;
@@ -2213,6 +2695,9 @@ static void _check_cached_events(int sd, short args, void *cbdata)
             PMIX_RELEASE(cd);
         }
     }
+    if (NULL != cds) {
+        free(cds);
+    }
     /* release the caddy */
     if (NULL != scd->codes) {
         free(scd->codes);
@@ -2264,7 +2749,6 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
     pmix_peer_events_info_t *prev = NULL;
     pmix_setup_caddy_t *scd;
     bool enviro_events = false;
-    bool found;
     pmix_proc_t *affected = NULL;
     size_t naffected = 0;
 
@@ -2359,24 +2843,22 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
      * default event handler. In that case, check only for default
      * handlers and add this request to it, if not already present */
     if (0 == ncodes) {
-        PMIX_LIST_FOREACH (reginfo, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if (PMIX_MAX_ERR_CONSTANT == reginfo->code) {
-                /* both are default handlers */
-                prev = PMIX_NEW(pmix_peer_events_info_t);
-                if (NULL == prev) {
-                    rc = PMIX_ERR_NOMEM;
-                    goto cleanup;
-                }
-                PMIX_RETAIN(peer);
-                prev->peer = peer;
-                if (NULL != affected) {
-                    PMIX_PROC_CREATE(prev->affected, naffected);
-                    prev->naffected = naffected;
-                    memcpy(prev->affected, affected, naffected * sizeof(pmix_proc_t));
-                }
-                pmix_list_append(&reginfo->peers, &prev->super);
-                break;
+        reginfo = pmix_server_event_lookup(PMIX_MAX_ERR_CONSTANT);
+        if (NULL != reginfo) {
+            /* both are default handlers */
+            prev = PMIX_NEW(pmix_peer_events_info_t);
+            if (NULL == prev) {
+                rc = PMIX_ERR_NOMEM;
+                goto cleanup;
+            }
+            PMIX_RETAIN(peer);
+            prev->peer = peer;
+            if (NULL != affected) {
+                PMIX_PROC_CREATE(prev->affected, naffected);
+                prev->naffected = naffected;
+                memcpy(prev->affected, affected, naffected * sizeof(pmix_proc_t));
             }
+            pmix_list_append(&reginfo->peers, &prev->super);
         }
         rc = PMIX_OPERATION_SUCCEEDED;
         goto cleanup;
@@ -2385,16 +2867,11 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
     /* store the event registration info so we can call the registered
      * client when the server notifies the event */
     for (n = 0; n < ncodes; n++) {
-        found = false;
-        PMIX_LIST_FOREACH (reginfo, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if (PMIX_MAX_ERR_CONSTANT == reginfo->code) {
-                continue;
-            } else if (codes[n] == reginfo->code) {
-                found = true;
-                break;
-            }
+        reginfo = NULL;
+        if (PMIX_MAX_ERR_CONSTANT != codes[n]) {
+            reginfo = pmix_server_event_lookup(codes[n]);
         }
-        if (found) {
+        if (NULL != reginfo) {
             /* found it - add this request */
             prev = PMIX_NEW(pmix_peer_events_info_t);
             if (NULL == prev) {
@@ -2419,6 +2896,8 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
             }
             rptr->code = codes[n];
             pmix_list_append(&pmix_server_globals.events, &rptr->super);
+            pmix_hash_table_set_value_uint32(&pmix_server_globals.event_codes,
+                                             (uint32_t) rptr->code, rptr);
             prev = PMIX_NEW(pmix_peer_events_info_t);
             if (NULL == prev) {
                 rc = PMIX_ERR_NOMEM;
@@ -2445,7 +2924,7 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
         }
         /* need to ensure the arrays don't go away until after the
          * host RM is done with them */
-        scd = PMIX_NEW(pmix_setup_caddy_t);
+        scd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
         if (NULL == scd) {
             rc = PMIX_ERR_NOMEM;
             goto cleanup;
@@ -2502,7 +2981,7 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_buffer_t *buf,
          * occur after we send the registration response back to the client,
          * thus guaranteeing that the client will get their registration
          * callback prior to delivery of an event notification */
-        scd = PMIX_NEW(pmix_setup_caddy_t);
+        scd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
         PMIX_RETAIN(peer);
         scd->peer = peer;
         scd->codes = codes;
@@ -2538,7 +3017,6 @@ void pmix_server_deregister_events(pmix_peer_t *peer, pmix_buffer_t *buf)
     int32_t cnt;
     pmix_status_t rc, code;
     pmix_regevents_info_t *reginfo = NULL;
-    pmix_regevents_info_t *reginfo_next;
     pmix_peer_events_info_t *prev;
 
     pmix_output_verbose(2, pmix_server_globals.event_output,
@@ -2550,32 +3028,286 @@ void pmix_server_deregister_events(pmix_peer_t *peer, pmix_buffer_t *buf)
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
     while (PMIX_SUCCESS == rc) {
-        PMIX_LIST_FOREACH_SAFE (reginfo, reginfo_next, &pmix_server_globals.events,
-                                pmix_regevents_info_t) {
-            if (code == reginfo->code) {
-                /* found it - remove this peer from the list */
-                PMIX_LIST_FOREACH (prev, &reginfo->peers, pmix_peer_events_info_t) {
-                    if (prev->peer == peer) {
-                        /* found it */
-                        pmix_list_remove_item(&reginfo->peers, &prev->super);
-                        PMIX_RELEASE(prev);
-                        break;
-                    }
+        reginfo = pmix_server_event_lookup(code);
+        if (NULL != reginfo) {
+            /* found it - remove this peer from the list */
+            PMIX_LIST_FOREACH (prev, &reginfo->peers, pmix_peer_events_info_t) {
+                if (prev->peer == peer) {
+                    /* found it */
+                    pmix_list_remove_item(&reginfo->peers, &prev->super);
+                    PMIX_RELEASE(prev);
+                    break;
                 }
-                /* if all of the peers for this code are now gone, then remove it */
-                if (0 == pmix_list_get_size(&reginfo->peers)) {
-                    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
-                    /* if this was registered with the host, then deregister it */
-                    PMIX_RELEASE(reginfo);
+            }
+            /* if all of the peers for this code are now gone, then remove it */
+            if (0 == pmix_list_get_size(&reginfo->peers)) {
+                pmix_server_event_remove(reginfo);
+            }
+        }
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
+    }
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+}
+
+pmix_regevents_info_t *pmix_server_event_lookup(pmix_status_t code)
+{
+    pmix_regevents_info_t *reginfo = NULL;
+    pmix_status_t rc;
+
+    rc = pmix_hash_table_get_value_uint32(&pmix_server_globals.event_codes,
+                                          (uint32_t) code, (void **) &reginfo);
+    if (PMIX_SUCCESS != rc) {
+        return NULL;
+    }
+    return reginfo;
+}
+
+void pmix_server_event_remove(pmix_regevents_info_t *reginfo)
+{
+    pmix_hash_table_remove_value_uint32(&pmix_server_globals.event_codes,
+                                        (uint32_t) reginfo->code);
+    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
+    PMIX_RELEASE(reginfo);
+}
+
+void pmix_server_group_add(pmix_group_t *grp)
+{
+    pmix_list_append(&pmix_server_globals.groups, &grp->super);
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.group_ids, grp->grpid,
+                                  strlen(grp->grpid), grp);
+}
+
+pmix_group_t *pmix_server_group_lookup(const char *grpid)
+{
+    pmix_group_t *grp = NULL;
+    pmix_status_t rc;
+
+    if (NULL == grpid) {
+        return NULL;
+    }
+    rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.group_ids, grpid,
+                                       strlen(grpid), (void **) &grp);
+    if (PMIX_SUCCESS != rc) {
+        return NULL;
+    }
+    return grp;
+}
+
+/* removes the group from the registry - the caller
+ * retains the reference that was held by it */
+void pmix_server_group_remove(pmix_group_t *grp)
+{
+    pmix_server_snapshot_group_delete(grp->grpid);
+    pmix_hash_table_remove_value_ptr(&pmix_server_globals.group_ids, grp->grpid,
+                                     strlen(grp->grpid));
+    pmix_list_remove_item(&pmix_server_globals.groups, &grp->super);
+}
+
+static void group_map_free(pmix_group_t *grp)
+{
+    size_t n;
+
+    for (n = 0; n < grp->nmap; n++) {
+        if (NULL != grp->map[n].ranks) {
+            free(grp->map[n].ranks);
+        }
+        PMIX_DESTRUCT(&grp->map[n].bits);
+    }
+    if (NULL != grp->map) {
+        free(grp->map);
+    }
+    grp->map = NULL;
+    grp->nmap = 0;
+}
+
+typedef struct {
+    const pmix_proc_t *proc;
+    size_t idx;
+} group_sort_t;
+
+static int group_sort_cmp(const void *a, const void *b)
+{
+    const group_sort_t *x = (const group_sort_t *) a;
+    const group_sort_t *y = (const group_sort_t *) b;
+    int rc;
+
+    rc = strncmp(x->proc->nspace, y->proc->nspace, PMIX_MAX_NSLEN);
+    if (0 != rc) {
+        return rc;
+    }
+    if (x->proc->rank != y->proc->rank) {
+        return (x->proc->rank < y->proc->rank) ? -1 : 1;
+    }
+    return (x->idx < y->idx) ? -1 : (x->idx > y->idx);
+}
+
+/* Group members are kept in the order given by the caller, as that
+ * order defines the rank of each member within the group. Lookups
+ * use an index instead: one entry per nspace, sorted by name, each
+ * holding its member ranks in sorted order along with their group
+ * positions. When the explicit ranks of an nspace are not too sparse
+ * they are also flagged in a bitmap so a membership test is a
+ * single bit check */
+pmix_status_t pmix_server_group_index(pmix_group_t *grp)
+{
+    group_sort_t *srt;
+    pmix_group_nsmap_t *nsm;
+    pmix_rank_t maxrank;
+    size_t n, m, start, nexplicit;
+
+    group_map_free(grp);
+    if (0 == grp->nmbrs) {
+        return PMIX_SUCCESS;
+    }
+
+    srt = (group_sort_t *) malloc(grp->nmbrs * sizeof(group_sort_t));
+    if (NULL == srt) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < grp->nmbrs; n++) {
+        srt[n].proc = &grp->members[n];
+        srt[n].idx = n;
+    }
+    qsort(srt, grp->nmbrs, sizeof(group_sort_t), group_sort_cmp);
+
+    /* count the nspaces */
+    grp->nmap = 1;
+    for (n = 1; n < grp->nmbrs; n++) {
+        if (!PMIX_CHECK_NSPACE(srt[n].proc->nspace, srt[n - 1].proc->nspace)) {
+            ++grp->nmap;
+        }
+    }
+    grp->map = (pmix_group_nsmap_t *) calloc(grp->nmap, sizeof(pmix_group_nsmap_t));
+    if (NULL == grp->map) {
+        grp->nmap = 0;
+        free(srt);
+        return PMIX_ERR_NOMEM;
+    }
+    for (m = 0; m < grp->nmap; m++) {
+        PMIX_CONSTRUCT(&grp->map[m].bits, pmix_bitmap_t);
+    }
+
+    start = 0;
+    for (m = 0; m < grp->nmap; m++) {
+        nsm = &grp->map[m];
+        PMIX_LOAD_NSPACE(nsm->nspace, srt[start].proc->nspace);
+        for (n = start + 1; n < grp->nmbrs; n++) {
+            if (!PMIX_CHECK_NSPACE(srt[n].proc->nspace, nsm->nspace)) {
+                break;
+            }
+        }
+        nsm->nranks = n - start;
+        nsm->ranks = (pmix_group_rank_t *) malloc(nsm->nranks * sizeof(pmix_group_rank_t));
+        if (NULL == nsm->ranks) {
+            free(srt);
+            group_map_free(grp);
+            return PMIX_ERR_NOMEM;
+        }
+        maxrank = 0;
+        nexplicit = 0;
+        for (n = 0; n < nsm->nranks; n++) {
+            nsm->ranks[n].rank = srt[start + n].proc->rank;
+            nsm->ranks[n].idx = srt[start + n].idx;
+            if (PMIX_RANK_WILDCARD == nsm->ranks[n].rank) {
+                nsm->wildcard = true;
+            } else if (PMIX_RANK_VALID > nsm->ranks[n].rank) {
+                maxrank = nsm->ranks[n].rank;
+                ++nexplicit;
+            }
+        }
+        /* don't spend more than a word per member on the bitmap */
+        if (0 < nexplicit && maxrank < INT_MAX && maxrank / 64 <= nexplicit &&
+            PMIX_SUCCESS == pmix_bitmap_init(&nsm->bits, (int) maxrank + 1)) {
+            nsm->dense = true;
+            for (n = 0; n < nsm->nranks; n++) {
+                if (PMIX_RANK_VALID > nsm->ranks[n].rank) {
+                    pmix_bitmap_set_bit(&nsm->bits, (int) nsm->ranks[n].rank);
                 }
             }
         }
-        cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
+        start += nsm->nranks;
+    }
+    free(srt);
+    pmix_server_snapshot_group(grp);
+    return PMIX_SUCCESS;
+}
+
+pmix_group_nsmap_t *pmix_server_group_nsmap(pmix_group_t *grp, const char *nspace)
+{
+    size_t lo = 0, hi = grp->nmap, mid;
+    int rc;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        rc = strncmp(nspace, grp->map[mid].nspace, PMIX_MAX_NSLEN);
+        if (0 == rc) {
+            return &grp->map[mid];
+        }
+        if (rc < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+/* flag the group position of every member of the nspace that
+ * has the given rank, returning the number newly flagged */
+static size_t group_flag_rank(pmix_group_nsmap_t *nsm, pmix_rank_t rank, pmix_bitmap_t *flags)
+{
+    size_t lo = 0, hi = nsm->nranks, mid, cnt = 0;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (nsm->ranks[mid].rank < rank) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
     }
-    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
-        PMIX_ERROR_LOG(rc);
+    for (; lo < nsm->nranks && rank == nsm->ranks[lo].rank; lo++) {
+        if (!pmix_bitmap_is_set_bit(flags, (int) nsm->ranks[lo].idx)) {
+            pmix_bitmap_set_bit(flags, (int) nsm->ranks[lo].idx);
+            ++cnt;
+        }
+    }
+    return cnt;
+}
+
+/* matches the way PMIX_CHECK_PROCID treats wildcard ranks */
+bool pmix_server_group_is_member(pmix_group_t *grp, const pmix_proc_t *proc)
+{
+    pmix_group_nsmap_t *nsm;
+    size_t lo, hi, mid;
+
+    nsm = pmix_server_group_nsmap(grp, proc->nspace);
+    if (NULL == nsm) {
+        return false;
+    }
+    if (nsm->wildcard || PMIX_RANK_WILDCARD == proc->rank) {
+        return true;
     }
+    if (nsm->dense && PMIX_RANK_VALID > proc->rank) {
+        return pmix_bitmap_is_set_bit(&nsm->bits, (int) proc->rank);
+    }
+    lo = 0;
+    hi = nsm->nranks;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (nsm->ranks[mid].rank == proc->rank) {
+            return true;
+        }
+        if (proc->rank < nsm->ranks[mid].rank) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return false;
 }
 
 static void local_cbfunc(pmix_status_t status, void *cbdata)
@@ -2756,9 +3488,10 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer, pmix_buffer_t *buf,
         }
     }
 
-    /* let the query function handle it */
-    rc = PMIx_Query_info_nb(cd->queries, cd->nqueries,
-                            cbfunc, (void*)cd);
+    /* let the query function handle it - identical queries
+     * from other clients may share the answer */
+    cd->cbfunc = cbfunc;
+    rc = pmix_server_query_submit(cd);
 
     if (PMIX_SUCCESS != rc) {
         PMIX_RELEASE(cd);
@@ -2795,7 +3528,7 @@ pmix_status_t pmix_server_log(pmix_peer_t *peer, pmix_buffer_t *buf,
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
 
-    cd = PMIX_NEW(pmix_shift_caddy_t);
+    cd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -2871,6 +3604,190 @@ exit:
     return rc;
 }
 
+/* a set of log requests from one client that are to be
+ * answered with a single reply */
+typedef struct {
+    pmix_object_t super;
+    pmix_server_caddy_t *cd;
+    pmix_modex_cbfunc_t cbfunc;
+    size_t nreqs;
+    size_t nleft;
+    pmix_status_t *status;
+} pmix_log_batch_t;
+static void lbcon(pmix_log_batch_t *p)
+{
+    p->cd = NULL;
+    p->cbfunc = NULL;
+    p->nreqs = 0;
+    p->nleft = 0;
+    p->status = NULL;
+}
+static void lbdes(pmix_log_batch_t *p)
+{
+    if (NULL != p->status) {
+        free(p->status);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_log_batch_t, pmix_object_t, lbcon, lbdes);
+
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_log_batch_t *batch;
+    size_t idx;
+    pmix_status_t status;
+} pmix_log_batch_caddy_t;
+static void lbccon(pmix_log_batch_caddy_t *p)
+{
+    p->batch = NULL;
+    p->idx = 0;
+    p->status = PMIX_SUCCESS;
+}
+static void lbcdes(pmix_log_batch_caddy_t *p)
+{
+    if (NULL != p->batch) {
+        PMIX_RELEASE(p->batch);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_log_batch_caddy_t, pmix_object_t, lbccon, lbcdes);
+
+static void logbatch_relfn(void *cbdata)
+{
+    char *data = (char *) cbdata;
+
+    if (NULL != data) {
+        free(data);
+    }
+}
+
+static void logbatch_complete(pmix_log_batch_t *batch)
+{
+    pmix_buffer_t msg;
+    pmix_status_t rc;
+    char *data;
+    size_t sz;
+
+    --batch->nleft;
+    if (0 < batch->nleft) {
+        return;
+    }
+
+    /* return the individual statuses in the order they were sent */
+    PMIX_CONSTRUCT(&msg, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, batch->cd->peer, &msg, batch->status, batch->nreqs, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_UNLOAD_BUFFER(&msg, data, sz);
+    PMIX_DESTRUCT(&msg);
+    batch->cbfunc(rc, data, sz, batch->cd, logbatch_relfn, data);
+}
+
+static void logbatch_done(int sd, short args, void *cbdata)
+{
+    pmix_log_batch_caddy_t *bcd = (pmix_log_batch_caddy_t *) cbdata;
+    pmix_log_batch_t *batch = bcd->batch;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(bcd);
+
+    batch->status[bcd->idx] = bcd->status;
+    PMIX_RETAIN(batch);
+    PMIX_RELEASE(bcd);
+    logbatch_complete(batch);
+    PMIX_RELEASE(batch);
+}
+
+/* the log channels may call back from their own threads */
+static void logbatch_cbfn(pmix_status_t status, void *cbdata)
+{
+    pmix_log_batch_caddy_t *bcd = (pmix_log_batch_caddy_t *) cbdata;
+
+    bcd->status = status;
+    PMIX_THREADSHIFT(bcd, logbatch_done);
+}
+
+pmix_status_t pmix_server_log_batch(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                    pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_server_caddy_t *cd = (pmix_server_caddy_t *) cbdata;
+    pmix_log_batch_t *batch;
+    pmix_log_batch_caddy_t *bcd;
+    pmix_byte_object_t bo;
+    pmix_buffer_t sub;
+    pmix_cmd_t cmd;
+    pmix_status_t rc;
+    int32_t cnt;
+    size_t n, nreqs;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &nreqs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 == nreqs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "recvd log batch of %lu requests from client", (unsigned long) nreqs);
+
+    batch = PMIX_NEW(pmix_log_batch_t);
+    batch->status = (pmix_status_t *) calloc(nreqs, sizeof(pmix_status_t));
+    if (NULL == batch->status) {
+        PMIX_RELEASE(batch);
+        return PMIX_ERR_NOMEM;
+    }
+    batch->nreqs = nreqs;
+    /* hold the batch open until every request has been started */
+    batch->nleft = nreqs + 1;
+    PMIX_RETAIN(cd);
+    batch->cd = cd;
+    batch->cbfunc = cbfunc;
+
+    /* each request is exactly what the client would have sent
+     * for an individual log, so pass it down the same way */
+    for (n = 0; n < nreqs; n++) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            batch->status[n] = rc;
+            --batch->nleft;
+            continue;
+        }
+        PMIX_CONSTRUCT(&sub, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(peer, &sub, bo.bytes, bo.size);
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, &sub, &cmd, &cnt, PMIX_COMMAND);
+        if (PMIX_SUCCESS != rc || PMIX_LOG_CMD != cmd) {
+            batch->status[n] = PMIX_ERR_BAD_PARAM;
+            --batch->nleft;
+            PMIX_DESTRUCT(&sub);
+            continue;
+        }
+        bcd = PMIX_NEW(pmix_log_batch_caddy_t);
+        PMIX_RETAIN(batch);
+        bcd->batch = batch;
+        bcd->idx = n;
+        rc = pmix_server_log(peer, &sub, logbatch_cbfn, bcd);
+        PMIX_DESTRUCT(&sub);
+        if (PMIX_SUCCESS != rc) {
+            /* includes PMIX_OPERATION_SUCCEEDED - returned
+             * as-is, just as for an individual request */
+            batch->status[n] = rc;
+            PMIX_RELEASE(bcd);
+            --batch->nleft;
+        }
+    }
+
+    /* release our own hold */
+    logbatch_complete(batch);
+    PMIX_RELEASE(batch);
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_alloc(pmix_peer_t *peer, pmix_buffer_t *buf,
                                 pmix_info_cbfunc_t cbfunc,
                                 void *cbdata)
@@ -2941,15 +3858,88 @@ typedef struct {
 } pmix_srvr_epi_caddy_t;
 static PMIX_CLASS_INSTANCE(pmix_srvr_epi_caddy_t, pmix_list_item_t, NULL, NULL);
 
+/* Job control requests can target every rank of a large job, so
+ * the targets are sorted once and grouped by nspace rather than
+ * scanning the nspaces and local clients for each of them */
+static pmix_status_t find_epilogs(pmix_peer_t *peer, pmix_proc_t *targets, size_t ntargets,
+                                  pmix_list_t *epicache)
+{
+    pmix_srvr_epi_caddy_t *epicd;
+    pmix_namespace_t *nptr, *tmp;
+    pmix_peer_t *pr;
+    pmix_proc_t *srt, key;
+    size_t n;
+    int m;
+
+    if (NULL == targets) {
+        epicd = PMIX_NEW(pmix_srvr_epi_caddy_t);
+        epicd->epi = &peer->nptr->epilog;
+        pmix_list_append(epicache, &epicd->super);
+        return PMIX_SUCCESS;
+    }
+
+    srt = (pmix_proc_t *) malloc(ntargets * sizeof(pmix_proc_t));
+    if (NULL == srt) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(srt, targets, ntargets * sizeof(pmix_proc_t));
+    qsort(srt, ntargets, sizeof(pmix_proc_t), pmix_util_compare_proc);
+
+    /* look up each nspace once - if the rank is wildcard,
+     * then we use the epilog for the nspace */
+    nptr = NULL;
+    for (n = 0; n < ntargets; n++) {
+        if (NULL == nptr || !PMIX_CHECK_NSPACE(nptr->nspace, srt[n].nspace)) {
+            nptr = NULL;
+            PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
+                if (0 == strcmp(tmp->nspace, srt[n].nspace)) {
+                    nptr = tmp;
+                    break;
+                }
+            }
+            if (NULL == nptr) {
+                nptr = PMIX_NEW(pmix_namespace_t);
+                if (NULL == nptr) {
+                    free(srt);
+                    return PMIX_ERR_NOMEM;
+                }
+                nptr->nspace = strdup(srt[n].nspace);
+                pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+            }
+        }
+        if (PMIX_RANK_WILDCARD == srt[n].rank) {
+            epicd = PMIX_NEW(pmix_srvr_epi_caddy_t);
+            epicd->epi = &nptr->epilog;
+            pmix_list_append(epicache, &epicd->super);
+        }
+    }
+
+    /* we need to find the precise peer for the others - we can
+     * only do cleanup for a local client */
+    for (m = 0; m < pmix_server_globals.clients.size; m++) {
+        pr = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, m);
+        if (NULL == pr) {
+            continue;
+        }
+        PMIX_LOAD_PROCID(&key, pr->info->pname.nspace, pr->info->pname.rank);
+        if (NULL != bsearch(&key, srt, ntargets, sizeof(pmix_proc_t), pmix_util_compare_proc)) {
+            epicd = PMIX_NEW(pmix_srvr_epi_caddy_t);
+            epicd->epi = &pr->epilog;
+            pmix_list_append(epicache, &epicd->super);
+        }
+    }
+
+    free(srt);
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer, pmix_buffer_t *buf,
                                    pmix_info_cbfunc_t cbfunc,
                                    void *cbdata)
 {
-    int32_t cnt, m;
+    int32_t cnt;
     pmix_status_t rc;
     pmix_query_caddy_t *cd;
-    pmix_namespace_t *nptr, *tmp;
-    pmix_peer_t *pr;
     pmix_proc_t proc;
     size_t n;
     bool recurse = false, leave_topdir = false, duplicate;
@@ -2973,75 +3963,12 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer, pmix_buffer_t *buf,
 
     PMIX_CONSTRUCT(&epicache, pmix_list_t);
 
-    /* unpack the number of targets */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, peer, buf, &cd->ntargets, &cnt, PMIX_SIZE);
+    /* unpack the targets */
+    rc = pmix_unpack_proc_set(peer, buf, &cd->targets, &cd->ntargets);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto exit;
     }
-    if (0 < cd->ntargets) {
-        PMIX_PROC_CREATE(cd->targets, cd->ntargets);
-        cnt = cd->ntargets;
-        PMIX_BFROPS_UNPACK(rc, peer, buf, cd->targets, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            goto exit;
-        }
-    }
-
-    /* check targets to find proper place to put any epilog requests */
-    if (NULL == cd->targets) {
-        epicd = PMIX_NEW(pmix_srvr_epi_caddy_t);
-        epicd->epi = &peer->nptr->epilog;
-        pmix_list_append(&epicache, &epicd->super);
-    } else {
-        for (n = 0; n < cd->ntargets; n++) {
-            /* find the nspace of this proc */
-            nptr = NULL;
-            PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-                if (0 == strcmp(tmp->nspace, cd->targets[n].nspace)) {
-                    nptr = tmp;
-                    break;
-                }
-            }
-            if (NULL == nptr) {
-                nptr = PMIX_NEW(pmix_namespace_t);
-                if (NULL == nptr) {
-                    rc = PMIX_ERR_NOMEM;
-                    goto exit;
-                }
-                nptr->nspace = strdup(cd->targets[n].nspace);
-                pmix_list_append(&pmix_globals.nspaces, &nptr->super);
-            }
-            /* if the rank is wildcard, then we use the epilog for the nspace */
-            if (PMIX_RANK_WILDCARD == cd->targets[n].rank) {
-                epicd = PMIX_NEW(pmix_srvr_epi_caddy_t);
-                epicd->epi = &nptr->epilog;
-                pmix_list_append(&epicache, &epicd->super);
-            } else {
-                /* we need to find the precise peer - we can only
-                 * do cleanup for a local client */
-                for (m = 0; m < pmix_server_globals.clients.size; m++) {
-                    if (NULL
-                        == (pr = (pmix_peer_t *)
-                                pmix_pointer_array_get_item(&pmix_server_globals.clients, m))) {
-                        continue;
-                    }
-                    if (0
-                        != strncmp(pr->info->pname.nspace, cd->targets[n].nspace, PMIX_MAX_NSLEN)) {
-                        continue;
-                    }
-                    if (pr->info->pname.rank == cd->targets[n].rank) {
-                        epicd = PMIX_NEW(pmix_srvr_epi_caddy_t);
-                        epicd->epi = &pr->epilog;
-                        pmix_list_append(&epicache, &epicd->super);
-                        break;
-                    }
-                }
-            }
-        }
-    }
 
     /* unpack the number of info objects */
     cnt = 1;
@@ -3123,6 +4050,14 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer, pmix_buffer_t *buf,
         }
     }
     if (0 < cnt) {
+        /* find the proper place to put the epilog requests */
+        rc = find_epilogs(peer, cd->targets, cd->ntargets, &epicache);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_LIST_DESTRUCT(&cachedirs);
+            PMIX_LIST_DESTRUCT(&cachefiles);
+            PMIX_LIST_DESTRUCT(&ignorefiles);
+            goto exit;
+        }
         /* handle any ignore directives first */
         PMIX_LIST_FOREACH (cf, &ignorefiles, pmix_cleanup_file_t) {
             PMIX_LIST_FOREACH (epicd, &epicache, pmix_srvr_epi_caddy_t) {
@@ -3238,6 +4173,91 @@ exit:
     return rc;
 }
 
+static void monitor_release(void *cbdata)
+{
+    pmix_data_array_t *darray = (pmix_data_array_t *) cbdata;
+
+    PMIX_DATA_ARRAY_FREE(darray);
+}
+
+/* report the resource usage of this node, or of each local proc
+ * in the requestor's nspace, from the samples held by pstat */
+static pmix_status_t monitor_stats(pmix_peer_t *requestor, pmix_info_t *monitor,
+                                   pmix_list_t *results)
+{
+    pmix_proc_stats_t pstats;
+    pmix_node_stats_t nstats;
+    pmix_peer_t *peer;
+    pmix_proc_t proc;
+    pmix_info_t optional;
+    pmix_cb_t cb;
+    pmix_kval_t *kv;
+    pid_t pid;
+    pmix_status_t rc;
+    int n;
+
+    if (PMIX_CHECK_KEY(monitor, PMIX_MONITOR_NODE_STATS)) {
+        PMIX_NODE_STATS_CONSTRUCT(&nstats);
+        rc = pmix_pstat.query(0, NULL, &nstats);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Info_list_add((void *) results, PMIX_MONITOR_NODE_STATS, &nstats,
+                                    PMIX_NODE_STATS);
+        }
+        PMIX_NODE_STATS_DESTRUCT(&nstats);
+        return rc;
+    }
+
+    PMIX_INFO_LOAD(&optional, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    for (n = 0; n < pmix_server_globals.clients.size; n++) {
+        peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, n);
+        if (NULL == peer
+            || !PMIX_CHECK_NSPACE(peer->info->pname.nspace, requestor->info->pname.nspace)) {
+            continue;
+        }
+        /* clients don't give us their pid, so we can only
+         * report those whose pid the host told us */
+        PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = &proc;
+        cb.key = PMIX_PROC_PID;
+        cb.info = &optional;
+        cb.ninfo = 1;
+        pid = 0;
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        if (PMIX_SUCCESS == rc) {
+            kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+            if (NULL != kv) {
+                PMIX_VALUE_GET_NUMBER(rc, kv->value, pid, pid_t);
+            }
+        }
+        cb.proc = NULL;
+        cb.key = NULL;
+        cb.info = NULL;
+        cb.ninfo = 0;
+        PMIX_DESTRUCT(&cb);
+        if (0 == pid) {
+            continue;
+        }
+        PMIX_PROC_STATS_CONSTRUCT(&pstats);
+        rc = pmix_pstat.query(pid, &pstats, NULL);
+        if (PMIX_ERR_NOT_SUPPORTED == rc) {
+            return rc;
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_LOAD_PROCID(&pstats.proc, peer->info->pname.nspace, peer->info->pname.rank);
+            rc = PMIx_Info_list_add((void *) results, PMIX_MONITOR_PROC_STATS, &pstats,
+                                    PMIX_PROC_STATS);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_PROC_STATS_DESTRUCT(&pstats);
+                return rc;
+            }
+        }
+        /* a proc that has just exited is simply left out */
+        PMIX_PROC_STATS_DESTRUCT(&pstats);
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_monitor(pmix_peer_t *peer, pmix_buffer_t *buf,
                                   pmix_info_cbfunc_t cbfunc,
                                   void *cbdata)
@@ -3247,6 +4267,8 @@ pmix_status_t pmix_server_monitor(pmix_peer_t *peer, pmix_buffer_t *buf,
     pmix_status_t rc, error;
     pmix_query_caddy_t *cd;
     pmix_proc_t proc;
+    pmix_list_t results;
+    pmix_data_array_t *darray;
 
     pmix_output_verbose(2, pmix_server_globals.base_output, "recvd monitor request from client");
 
@@ -3293,7 +4315,33 @@ pmix_status_t pmix_server_monitor(pmix_peer_t *peer, pmix_buffer_t *buf,
 
     /* see if they are requesting one of the monitoring
      * methods we internally support */
-    rc = pmix_psensor.start(peer, error, &monitor, cd->info, cd->ninfo);
+    PMIX_CONSTRUCT(&results, pmix_list_t);
+    if (PMIX_CHECK_KEY(&monitor, PMIX_MONITOR_PROC_STATS)
+        || PMIX_CHECK_KEY(&monitor, PMIX_MONITOR_NODE_STATS)) {
+        rc = monitor_stats(peer, &monitor, &results);
+    } else {
+        rc = pmix_psensor.start(peer, error, &monitor, cd->info, cd->ninfo, &results);
+    }
+    if (PMIX_SUCCESS == rc && 0 < pmix_list_get_size(&results)) {
+        /* pass back what the sensor wants the requestor to know */
+        darray = (pmix_data_array_t *) malloc(sizeof(pmix_data_array_t));
+        if (NULL == darray) {
+            PMIX_LIST_DESTRUCT(&results);
+            rc = PMIX_ERR_NOMEM;
+            goto exit;
+        }
+        rc = PMIx_Info_list_convert((void *) &results, darray);
+        PMIX_LIST_DESTRUCT(&results);
+        if (PMIX_SUCCESS != rc) {
+            free(darray);
+            goto exit;
+        }
+        PMIX_INFO_DESTRUCT(&monitor);
+        cbfunc(PMIX_SUCCESS, (pmix_info_t *) darray->array, darray->size, cd,
+               monitor_release, darray);
+        return PMIX_SUCCESS;
+    }
+    PMIX_LIST_DESTRUCT(&results);
     if (PMIX_SUCCESS == rc) {
         rc = PMIX_OPERATION_SUCCEEDED;
         goto exit;
@@ -3462,7 +4510,7 @@ pmix_status_t pmix_server_iofreg(pmix_peer_t *peer, pmix_buffer_t *buf,
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -3575,7 +4623,7 @@ pmix_status_t pmix_server_iofdereg(pmix_peer_t *peer, pmix_buffer_t *buf,
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -3677,7 +4725,7 @@ pmix_status_t pmix_server_iofstdin(pmix_peer_t *peer,
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    cd = PMIX_NEW(pmix_setup_caddy_t);
+    cd = PMIX_NEW(pmix_setup_caddy_t, PMIX_SERVER_POOL(setup_caddy));
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
@@ -3796,6 +4844,31 @@ error:
     PMIX_RELEASE(cd);
 }
 
+/* see if a group construct asked for a context ID, and whether
+ * it was declared to involve only local procs */
+static bool group_wants_cid(pmix_server_trkr_t *trk, bool *forced)
+{
+    bool want = false;
+    size_t n;
+
+    *forced = false;
+    for (n = 0; n < trk->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&trk->info[n], PMIX_GROUP_ASSIGN_CONTEXT_ID)) {
+            want = PMIX_INFO_TRUE(&trk->info[n]);
+        } else if (PMIX_CHECK_KEY(&trk->info[n], PMIX_GROUP_LOCAL_ONLY)) {
+            *forced = PMIX_INFO_TRUE(&trk->info[n]);
+        }
+    }
+    return want;
+}
+
+static void grp_cid_release(void *cbdata)
+{
+    pmix_info_t *info = (pmix_info_t *) cbdata;
+
+    PMIX_INFO_FREE(info, 1);
+}
+
 static void _grpcbfunc(int sd, short args, void *cbdata)
 {
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t *) cbdata;
@@ -3804,6 +4877,7 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
     pmix_buffer_t *reply, xfer, dblob, rankblob;
     pmix_status_t ret;
     size_t n, ctxid = SIZE_MAX, ngrpinfo;
+    size_t cidbase = SIZE_MAX, cidblock = 0;
     pmix_group_t *grp;
     pmix_byte_object_t *bo = NULL, pbo;
     pmix_nspace_caddy_t *nptr;
@@ -3838,7 +4912,7 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
 
     /* if the timer is active, clear it */
     if (trk->event_active) {
-        pmix_event_del(&trk->ev);
+        pmix_timer_del(&trk->timer);
     }
     grp = (pmix_group_t *) trk->cbdata;
 
@@ -3847,7 +4921,7 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
     if (trk->hybrid) {
         /* we destructed the group */
         if (NULL != grp) {
-            pmix_list_remove_item(&pmix_server_globals.groups, &grp->super);
+            pmix_server_group_remove(grp);
             PMIX_RELEASE(grp);
         }
     } else {
@@ -3862,8 +4936,28 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
                 }
             } else if (PMIX_CHECK_KEY(&scd->info[n], PMIX_GROUP_ENDPT_DATA)) {
                 bo = &scd->info[n].value.data.bo;
+            } else if (PMIX_CHECK_KEY(&scd->info[n], PMIX_GROUP_CONTEXT_ID_BASE)) {
+                PMIX_VALUE_GET_NUMBER(ret, &scd->info[n].value, cidbase, size_t);
+                if (PMIX_SUCCESS != ret) {
+                    PMIX_ERROR_LOG(ret);
+                }
+            } else if (PMIX_CHECK_KEY(&scd->info[n], PMIX_GROUP_CONTEXT_ID_BLOCK)) {
+                PMIX_VALUE_GET_NUMBER(ret, &scd->info[n].value, cidblock, size_t);
+                if (PMIX_SUCCESS != ret) {
+                    PMIX_ERROR_LOG(ret);
+                    cidblock = 0;
+                }
             }
         }
+        /* if the host reserved a block of context IDs for us,
+         * then take it as our new lease */
+        if (SIZE_MAX != cidbase && 0 < cidblock) {
+            pmix_output_verbose(2, pmix_server_globals.connect_output,
+                                "server:grpcbfunc leased %lu ctxids starting at %lu",
+                                (unsigned long) cidblock, (unsigned long) cidbase);
+            pmix_server_globals.group_cid_next = cidbase;
+            pmix_server_globals.group_cid_left = cidblock;
+        }
     }
 
     /* if data was returned, then we need to have the modex cbfunc
@@ -3935,8 +5029,11 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
                 }
             } else if (index == infoidx) {
                 /* this is packed differently, at least for now, so we have
-                 * to unpack it and process it directly */
-                if (ctxid_given) {
+                 * to unpack it and process it directly. The values are
+                 * qualified by the context ID or, if the group has none,
+                 * by the group ID - either way the members find them
+                 * here instead of asking the host for them */
+                if (ctxid_given || NULL != grp) {
                     /* the blob consists of a set of byte objects, each containing the ID
                      * of the contributing proc followed by the pmix_info_t they
                      * provided */
@@ -3995,10 +5092,15 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
                         for (n=0; n < ngrpinfo; n++) {
                             PMIX_DATA_ARRAY_CONSTRUCT(&darray, 2, PMIX_INFO);
                             iptr = (pmix_info_t*)darray.array;
-                            /* the primary value is in the first position */
-                            PMIX_INFO_XFER(&iptr[0], &grpinfo[n]);
-                            /* add the context ID qualifier */
-                            PMIX_INFO_LOAD(&iptr[1], PMIX_GROUP_CONTEXT_ID, &ctxid, PMIX_SIZE);
+                            /* the primary value is in the first position - it
+                             * is not needed after being stored */
+                            pmix_bfrops_base_info_move(&iptr[0], &grpinfo[n]);
+                            /* add the context ID or group ID qualifier */
+                            if (ctxid_given) {
+                                PMIX_INFO_LOAD(&iptr[1], PMIX_GROUP_CONTEXT_ID, &ctxid, PMIX_SIZE);
+                            } else {
+                                PMIX_INFO_LOAD(&iptr[1], PMIX_GROUP_ID, grp->grpid, PMIX_STRING);
+                            }
                             PMIX_INFO_SET_QUALIFIER(&iptr[1]);
                             /* add it to the kval */
                             val.data.darray = &darray;
@@ -4065,7 +5167,7 @@ release:
     }
 
     /* remove the tracker from the list */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    pmix_server_trk_remove(trk);
   //  PMIX_RELEASE(trk);
 
     /* we are done */
@@ -4095,7 +5197,7 @@ static void grpcbfunc(pmix_status_t status,
     }
 
     /* need to thread-shift this callback as it accesses global data */
-    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd = PMIX_NEW(pmix_shift_caddy_t, PMIX_SERVER_POOL(shift_caddy));
     if (NULL == scd) {
         /* nothing we can do */
         if (NULL != relfn) {
@@ -4122,20 +5224,24 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
     pmix_status_t rc;
     char *grpid;
     pmix_proc_t *procs;
-    pmix_group_t *grp, *pgrp;
-    pmix_info_t *info = NULL, *iptr = NULL, *grpinfoptr = NULL;
-    size_t n, ninfo, ninf, nprocs, n2, ngrpinfo = 0;
+    pmix_group_t *grp;
+    pmix_info_t *info = NULL, *grpinfoptr = NULL, *cidinfo;
+    size_t n, ninfo, ninf, nprocs, ngrpinfo = 0;
     pmix_server_trkr_t *trk;
     struct timeval tv = {0, 0};
     bool need_cxtid = false;
-    bool match, force_local = false;
+    bool force_local = false;
     bool embed_barrier = false;
     bool barrier_directive_included = false;
     bool sorted = false;
+    char *keys = NULL;
     pmix_buffer_t bucket, bkt;
     pmix_byte_object_t bo;
     pmix_grpinfo_t *g = NULL;
     pmix_regattr_input_t *p;
+    pmix_group_nsmap_t *nsm;
+    pmix_bitmap_t local;
+    size_t nlocal;
 
     pmix_output_verbose(2, pmix_server_globals.connect_output,
                         "recvd grpconstruct cmd");
@@ -4154,13 +5260,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
     }
 
     /* see if we already have this group */
-    grp = NULL;
-    PMIX_LIST_FOREACH (pgrp, &pmix_server_globals.groups, pmix_group_t) {
-        if (0 == strcmp(grpid, pgrp->grpid)) {
-            grp = pgrp;
-            break;
-        }
-    }
+    grp = pmix_server_group_lookup(grpid);
     if (NULL == grp) {
         /* create a new entry */
         grp = PMIX_NEW(pmix_group_t);
@@ -4169,7 +5269,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
             goto error;
         }
         grp->grpid = grpid;
-        pmix_list_append(&pmix_server_globals.groups, &grp->super);
+        pmix_server_group_add(grp);
     } else {
         free(grpid);
     }
@@ -4202,6 +5302,11 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
         grp->members = procs;
         grp->nmbrs = nprocs;
         sorted = true;
+        rc = pmix_server_group_index(grp);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
     } else {
         PMIX_PROC_FREE(procs, nprocs);
     }
@@ -4246,6 +5351,9 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
         } else if (PMIX_CHECK_KEY(&info[n], PMIX_EMBED_BARRIER)) {
             embed_barrier = PMIX_INFO_TRUE(&info[n]);
             barrier_directive_included = true;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_COLLECT_KEYS)
+                   && PMIX_STRING == info[n].value.type) {
+            keys = info[n].value.data.string;
         } else if (PMIX_CHECK_KEY(&info[n], PMIX_GROUP_INFO)) {
             grpinfoptr = (pmix_info_t*)info[n].value.data.darray->array;
             ngrpinfo = info[n].value.data.darray->size;
@@ -4290,8 +5398,13 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
             goto error;
         }
         /* group members must have access to all endpoint info
-         * upon completion of the construct operation */
+         * upon completion of the construct operation - or, if
+         * they named the keys they share within the group, to
+         * those keys, with the rest left for the direct modex */
         trk->collect_type = PMIX_COLLECT_YES;
+        if (NULL != keys) {
+            trk->collect_keys = pmix_argv_split(keys, ',');
+        }
         /* mark as being a construct operation */
         trk->hybrid = false;
         /* pass along the grp object */
@@ -4308,38 +5421,47 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
          * requesting a context ID - if both conditions are met, then we
          * can just locally process the request without bothering the host.
          * This is meant to provide an optimized path for a fairly common
-         * operation */
+         * operation. A context ID can also be handled locally if we still
+         * hold some from a block the host reserved for us */
         if (force_local) {
             trk->local = true;
-        } else if (need_cxtid) {
+        } else if (need_cxtid && 0 == pmix_server_globals.group_cid_left) {
             trk->local = false;
         } else {
-            trk->local = true;
+            /* every member must either reference the local procs or
+             * match one of our clients - flag each member a client
+             * matches, checking each client against the group index */
+            PMIX_CONSTRUCT(&local, pmix_bitmap_t);
+            if (PMIX_SUCCESS != pmix_bitmap_init(&local, (int) grp->nmbrs)) {
+                PMIX_DESTRUCT(&local);
+                PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+                rc = PMIX_ERR_NOMEM;
+                goto error;
+            }
+            nlocal = 0;
             for (n = 0; n < grp->nmbrs; n++) {
-                /* if this entry references the local procs, then
-                 * we can skip it */
                 if (PMIX_RANK_LOCAL_PEERS == grp->members[n].rank ||
                     PMIX_RANK_LOCAL_NODE == grp->members[n].rank) {
+                    pmix_bitmap_set_bit(&local, (int) n);
+                    ++nlocal;
+                }
+            }
+            for (m = 0; m < pmix_server_globals.clients.size && nlocal < grp->nmbrs; m++) {
+                pr = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, m);
+                if (NULL == pr) {
                     continue;
                 }
-                /* see if it references a specific local proc */
-                match = false;
-                for (m = 0; m < pmix_server_globals.clients.size; m++) {
-                    pr = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, m);
-                    if (NULL == pr) {
-                        continue;
-                    }
-                    if (PMIX_CHECK_PROCID(&grp->members[n], &pr->info->pname)) {
-                        match = true;
-                        break;
-                    }
+                nsm = pmix_server_group_nsmap(grp, pr->info->pname.nspace);
+                if (NULL == nsm) {
+                    continue;
                 }
-                if (!match) {
-                    /* this requires a non_local operation */
-                    trk->local = false;
-                    break;
+                nlocal += group_flag_rank(nsm, pr->info->pname.rank, &local);
+                if (nsm->wildcard) {
+                    nlocal += group_flag_rank(nsm, PMIX_RANK_WILDCARD, &local);
                 }
             }
+            trk->local = (nlocal == grp->nmbrs);
+            PMIX_DESTRUCT(&local);
         }
     } else {
         /* cleanup */
@@ -4357,7 +5479,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
 
     /* if a timeout was specified, set it */
     if (0 < tv.tv_sec) {
-        PMIX_THREADSHIFT_DELAY(trk, grp_timeout, tv.tv_sec);
+        pmix_timer_add(&trk->timer, tv.tv_sec, grp_timeout, trk);
         trk->event_active = true;
     }
 
@@ -4370,27 +5492,54 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
                             "local group op complete with %d procs", (int) trk->npcs);
 
         if (trk->local) {
-            /* nothing further needs to be done - we have
-             * created the local group. let the grpcbfunc
-             * threadshift the result */
-            grpcbfunc(PMIX_SUCCESS, NULL, 0, trk, NULL, NULL);
-            return PMIX_SUCCESS;
+            if (!group_wants_cid(trk, &force_local)) {
+                /* nothing further needs to be done - we have
+                 * created the local group. let the grpcbfunc
+                 * threadshift the result */
+                grpcbfunc(PMIX_SUCCESS, NULL, 0, trk, NULL, NULL);
+                return PMIX_SUCCESS;
+            }
+            if (0 < pmix_server_globals.group_cid_left) {
+                /* assign the next context ID from our block */
+                PMIX_INFO_CREATE(cidinfo, 1);
+                PMIX_INFO_LOAD(cidinfo, PMIX_GROUP_CONTEXT_ID,
+                               &pmix_server_globals.group_cid_next, PMIX_SIZE);
+                ++pmix_server_globals.group_cid_next;
+                --pmix_server_globals.group_cid_left;
+                pmix_output_verbose(2, pmix_server_globals.connect_output,
+                                    "local group op assigned ctxid %lu from block",
+                                    (unsigned long) cidinfo->value.data.size);
+                grpcbfunc(PMIX_SUCCESS, cidinfo, 1, trk, grp_cid_release, cidinfo);
+                return PMIX_SUCCESS;
+            }
+            if (force_local) {
+                /* they told us to keep this local, so complete
+                 * it without an ID as we always have */
+                grpcbfunc(PMIX_SUCCESS, NULL, 0, trk, NULL, NULL);
+                return PMIX_SUCCESS;
+            }
+            /* our block ran out while the local contributions
+             * were arriving, so the host has to assign it */
+            trk->local = false;
         }
 
         /* if they direct us to not embed a barrier, then we won't gather
-         * the data for distribution */
+         * the data for distribution - unless they named the keys they
+         * want carried, which are cheap enough to gather anyway and
+         * save each member a direct modex for them afterwards */
         if (!barrier_directive_included ||
             (barrier_directive_included && embed_barrier) ||
+            NULL != trk->collect_keys ||
             0 < pmix_list_get_size(&trk->grpinfo)) {
             /* collect any remote contributions provided by group members */
             PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
             rc = _collect_data(trk, &bucket);
             if (PMIX_SUCCESS != rc) {
                 if (trk->event_active) {
-                    pmix_event_del(&trk->ev);
+                    pmix_timer_del(&trk->timer);
                 }
                 /* remove the tracker from the list */
-                pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+                pmix_server_trk_remove(trk);
                 PMIX_RELEASE(trk);
                 PMIX_DESTRUCT(&bucket);
                 return rc;
@@ -4402,11 +5551,6 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
              * fence operation */
             if (0 < bo.size ||
                 0 < pmix_list_get_size(&trk->grpinfo)) {
-                n2 = trk->ninfo + 1;
-                PMIX_INFO_CREATE(iptr, n2);
-                for (n = 0; n < trk->ninfo; n++) {
-                    PMIX_INFO_XFER(&iptr[n], &trk->info[n]);
-                }
                 /* add the endpt data */
                 PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
                 if (0 < bo.size) {
@@ -4453,20 +5597,36 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
                     PMIX_BYTE_OBJECT_DESTRUCT(&bo);
                 }
                 PMIX_UNLOAD_BUFFER(&bucket, bo.bytes, bo.size);
-                PMIX_INFO_LOAD(&iptr[n2-1], PMIX_GROUP_ENDPT_DATA, &bo, PMIX_BYTE_OBJECT);
-                PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-                /* replace the tracker's info array */
-                PMIX_INFO_FREE(trk->info, trk->ninfo);
-                trk->info = iptr;
-                trk->ninfo = n2;
-                iptr = NULL;
+                /* extend the tracker's info array - the payload is
+                 * handed to the info rather than copied */
+                rc = pmix_bfrops_base_info_array_grow(&trk->info, &trk->ninfo, 1);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+                    goto error;
+                }
+                PMIX_LOAD_KEY(trk->info[trk->ninfo - 1].key, PMIX_GROUP_ENDPT_DATA);
+                trk->info[trk->ninfo - 1].value.type = PMIX_BYTE_OBJECT;
+                trk->info[trk->ninfo - 1].value.data.bo.bytes = bo.bytes;
+                trk->info[trk->ninfo - 1].value.data.bo.size = bo.size;
+            }
+        }
+        /* if the host is going to assign a context ID anyway, ask it to
+         * reserve a block of them for us while it is at it */
+        if (0 < pmix_server_globals.group_cid_block &&
+            0 == pmix_server_globals.group_cid_left &&
+            group_wants_cid(trk, &force_local)) {
+            rc = pmix_bfrops_base_info_array_grow(&trk->info, &trk->ninfo, 1);
+            if (PMIX_SUCCESS != rc) {
+                goto error;
             }
+            n = pmix_server_globals.group_cid_block;
+            PMIX_INFO_LOAD(&trk->info[trk->ninfo - 1], PMIX_GROUP_CONTEXT_ID_BLOCK, &n, PMIX_SIZE);
         }
         rc = pmix_host_server.group(PMIX_GROUP_CONSTRUCT, grp->grpid, trk->pcs, trk->npcs,
                                     trk->info, trk->ninfo, grpcbfunc, trk);
         if (PMIX_SUCCESS != rc) {
             if (trk->event_active) {
-                pmix_event_del(&trk->ev);
+                pmix_timer_del(&trk->timer);
             }
             if (PMIX_OPERATION_SUCCEEDED == rc) {
                 /* let the grpcbfunc threadshift the result */
@@ -4474,7 +5634,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
                 return PMIX_SUCCESS;
             }
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
             return rc;
         }
@@ -4486,9 +5646,6 @@ error:
     if (NULL != info) {
         PMIX_INFO_FREE(info, ninfo);
     }
-    if (NULL != iptr) {
-        PMIX_INFO_FREE(iptr, n2);
-    }
     return rc;
 }
 
@@ -4503,7 +5660,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
     pmix_info_t *info = NULL;
     size_t n, ninfo, ninf;
     pmix_server_trkr_t *trk;
-    pmix_group_t *grp, *pgrp;
+    pmix_group_t *grp;
     struct timeval tv = {0, 0};
 
     pmix_output_verbose(2, pmix_server_globals.connect_output,
@@ -4522,14 +5679,8 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
         goto error;
     }
 
-    /* find this group in our list */
-    grp = NULL;
-    PMIX_LIST_FOREACH (pgrp, &pmix_server_globals.groups, pmix_group_t) {
-        if (0 == strcmp(grpid, pgrp->grpid)) {
-            grp = pgrp;
-            break;
-        }
-    }
+    /* find this group in our registry */
+    grp = pmix_server_group_lookup(grpid);
     free(grpid);
 
     /* if not found, then this is an error - we cannot
@@ -4602,7 +5753,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
 
     /* if a timeout was specified, set it */
     if (0 < tv.tv_sec) {
-        PMIX_THREADSHIFT_DELAY(trk, grp_timeout, tv.tv_sec);
+        pmix_timer_add(&trk->timer, tv.tv_sec, grp_timeout, trk);
         trk->event_active = true;
     }
 
@@ -4619,7 +5770,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
                                     trk->info, trk->ninfo, grpcbfunc, trk);
         if (PMIX_SUCCESS != rc) {
             if (trk->event_active) {
-                pmix_event_del(&trk->ev);
+                pmix_timer_del(&trk->timer);
             }
             if (PMIX_OPERATION_SUCCEEDED == rc) {
                 /* let the grpcbfunc threadshift the result */
@@ -4627,7 +5778,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
                 return PMIX_SUCCESS;
             }
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
             return rc;
         }
@@ -4642,13 +5793,312 @@ error:
     return rc;
 }
 
-static void _fabric_response(int sd, short args, void *cbdata)
+/* The server keeps the last answer it got for each fabric, along
+ * with a revision number that is bumped whenever that answer
+ * changes. Requestors are given the revision with the info, and
+ * pass it back when they ask for an update - if they already hold
+ * the previous revision, they are only sent the entries that
+ * changed since, which for large fabrics is a small part of the
+ * whole. Entries are matched by key, so answers that repeat a key
+ * are always sent in full */
+typedef struct {
+    pmix_list_item_t super;
+    size_t index;
+    uint64_t revision;
+    pmix_info_t *info;
+    size_t ninfo;
+    /* the changes from the previous revision */
+    bool have_delta;
+    pmix_info_t *delta;
+    size_t ndelta;
+} pmix_fabric_cache_t;
+static void fccon(pmix_fabric_cache_t *p)
+{
+    p->index = 0;
+    p->revision = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->have_delta = false;
+    p->delta = NULL;
+    p->ndelta = 0;
+}
+static void fcdes(pmix_fabric_cache_t *p)
+{
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    if (NULL != p->delta) {
+        PMIX_INFO_FREE(p->delta, p->ndelta);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_fabric_cache_t, pmix_list_item_t, fccon, fcdes);
+
+/* a register or update request while its answer is assembled */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_query_caddy_t *qcd;
+    bool have_index;
+    size_t index;
+    /* the revision the requestor holds - zero if none */
+    uint64_t revision;
+    pmix_status_t status;
+    /* the answer as provided by pnet or the host */
+    pmix_info_t *info;
+    size_t ninfo;
+    /* the answer as sent to the requestor */
+    pmix_info_t *out;
+    size_t nout;
+} pmix_fabric_trk_t;
+static void ftcon(pmix_fabric_trk_t *p)
 {
-    pmix_query_caddy_t *qcd = (pmix_query_caddy_t *) cbdata;
+    p->qcd = NULL;
+    p->have_index = false;
+    p->index = 0;
+    p->revision = 0;
+    p->status = PMIX_SUCCESS;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->out = NULL;
+    p->nout = 0;
+}
+static void ftdes(pmix_fabric_trk_t *p)
+{
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    if (NULL != p->out) {
+        PMIX_INFO_FREE(p->out, p->nout);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_fabric_trk_t, pmix_object_t, ftcon, ftdes);
+
+static pmix_info_t *find_fabric_key(pmix_info_t *info, size_t ninfo, const char *key)
+{
+    size_t n;
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], key)) {
+            return &info[n];
+        }
+    }
+    return NULL;
+}
+
+/* the keys we add to the answer ourselves */
+static bool is_fabric_marker(pmix_info_t *info)
+{
+    return PMIX_CHECK_KEY(info, PMIX_FABRIC_INDEX) || PMIX_CHECK_KEY(info, PMIX_FABRIC_REVISION)
+           || PMIX_CHECK_KEY(info, PMIX_FABRIC_DELTA);
+}
+
+static bool unique_fabric_keys(pmix_info_t *info, size_t ninfo)
+{
+    size_t n;
+
+    for (n = 1; n < ninfo; n++) {
+        if (NULL != find_fabric_key(info, n, info[n].key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* the entries of nw that are not in old or differ from it, plus
+ * an undefined value for each key of old that is not in nw */
+static void fabric_delta(pmix_info_t *old, size_t nold, pmix_info_t *nw, size_t nnew,
+                         pmix_list_t *delta)
+{
+    pmix_infolist_t *iptr;
+    pmix_info_t *match;
+    size_t n;
+
+    for (n = 0; n < nnew; n++) {
+        match = find_fabric_key(old, nold, nw[n].key);
+        if (NULL != match && PMIX_EQUAL == PMIx_Value_compare(&match->value, &nw[n].value)) {
+            continue;
+        }
+        iptr = PMIX_NEW(pmix_infolist_t);
+        PMIX_INFO_XFER(&iptr->info, &nw[n]);
+        pmix_list_append(delta, &iptr->super);
+    }
+    for (n = 0; n < nold; n++) {
+        if (NULL == find_fabric_key(nw, nnew, old[n].key)) {
+            iptr = PMIX_NEW(pmix_infolist_t);
+            PMIX_LOAD_KEY(iptr->info.key, old[n].key);
+            iptr->info.value.type = PMIX_UNDEF;
+            pmix_list_append(delta, &iptr->super);
+        }
+    }
+}
+
+static pmix_fabric_cache_t *update_fabric_cache(size_t index, pmix_info_t *info, size_t ninfo)
+{
+    pmix_fabric_cache_t *fc, *cache = NULL;
+    pmix_infolist_t *iptr;
+    pmix_list_t delta;
+    size_t n;
+
+    PMIX_LIST_FOREACH (fc, &pmix_server_globals.fabric_cache, pmix_fabric_cache_t) {
+        if (fc->index == index) {
+            cache = fc;
+            break;
+        }
+    }
+    if (NULL != cache && unique_fabric_keys(info, ninfo)
+        && unique_fabric_keys(cache->info, cache->ninfo)) {
+        PMIX_CONSTRUCT(&delta, pmix_list_t);
+        fabric_delta(cache->info, cache->ninfo, info, ninfo, &delta);
+        if (0 == pmix_list_get_size(&delta)) {
+            /* nothing changed */
+            PMIX_LIST_DESTRUCT(&delta);
+            return cache;
+        }
+        if (NULL != cache->delta) {
+            PMIX_INFO_FREE(cache->delta, cache->ndelta);
+        }
+        cache->ndelta = pmix_list_get_size(&delta);
+        PMIX_INFO_CREATE(cache->delta, cache->ndelta);
+        n = 0;
+        PMIX_LIST_FOREACH (iptr, &delta, pmix_infolist_t) {
+            PMIX_INFO_XFER(&cache->delta[n], &iptr->info);
+            ++n;
+        }
+        PMIX_LIST_DESTRUCT(&delta);
+        cache->have_delta = true;
+    } else if (NULL != cache) {
+        if (NULL != cache->delta) {
+            PMIX_INFO_FREE(cache->delta, cache->ndelta);
+        }
+        cache->have_delta = false;
+    } else {
+        cache = PMIX_NEW(pmix_fabric_cache_t);
+        cache->index = index;
+        pmix_list_append(&pmix_server_globals.fabric_cache, &cache->super);
+    }
+
+    /* keep a copy of the new answer */
+    if (NULL != cache->info) {
+        PMIX_INFO_FREE(cache->info, cache->ninfo);
+    }
+    cache->ninfo = ninfo;
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(cache->info, ninfo);
+        for (n = 0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&cache->info[n], &info[n]);
+        }
+    }
+    ++cache->revision;
+    return cache;
+}
+
+static void fabric_release(void *cbdata)
+{
+    pmix_fabric_trk_t *trk = (pmix_fabric_trk_t *) cbdata;
+    PMIX_RELEASE(trk);
+}
+
+static void fabric_respond(int sd, short args, void *cbdata)
+{
+    pmix_fabric_trk_t *trk = (pmix_fabric_trk_t *) cbdata;
+    pmix_query_caddy_t *qcd = trk->qcd;
+    pmix_fabric_cache_t *cache;
+    pmix_info_t *iptr, *src;
+    size_t n, m, nsrc;
+    pmix_status_t rc;
+    bool delta;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
-    qcd->cbfunc(PMIX_SUCCESS, qcd->info, qcd->ninfo, qcd->cbdata, NULL, NULL);
-    PMIX_RELEASE(qcd);
+    if (PMIX_SUCCESS != trk->status) {
+        qcd->cbfunc(trk->status, NULL, 0, qcd, fabric_release, trk);
+        return;
+    }
+    if (!trk->have_index) {
+        iptr = find_fabric_key(trk->info, trk->ninfo, PMIX_FABRIC_INDEX);
+        if (NULL != iptr) {
+            PMIX_VALUE_GET_NUMBER(rc, &iptr->value, trk->index, size_t);
+            trk->have_index = (PMIX_SUCCESS == rc);
+        }
+    }
+    if (!trk->have_index) {
+        /* nothing to key the answer on - pass it along as is */
+        qcd->cbfunc(PMIX_SUCCESS, trk->info, trk->ninfo, qcd, fabric_release, trk);
+        return;
+    }
+
+    /* strip anything we add ourselves before caching the answer */
+    for (n = 0, m = 0; n < trk->ninfo; n++) {
+        if (!is_fabric_marker(&trk->info[n])) {
+            if (m != n) {
+                memcpy(&trk->info[m], &trk->info[n], sizeof(pmix_info_t));
+                PMIX_INFO_CONSTRUCT(&trk->info[n]);
+            }
+            ++m;
+        } else {
+            PMIX_INFO_DESTRUCT(&trk->info[n]);
+            PMIX_INFO_CONSTRUCT(&trk->info[n]);
+        }
+    }
+    cache = update_fabric_cache(trk->index, trk->info, m);
+
+    if (trk->revision == cache->revision) {
+        /* the requestor is up to date */
+        delta = true;
+        src = NULL;
+        nsrc = 0;
+    } else if (0 < trk->revision && trk->revision + 1 == cache->revision && cache->have_delta) {
+        delta = true;
+        src = cache->delta;
+        nsrc = cache->ndelta;
+    } else {
+        delta = false;
+        src = cache->info;
+        nsrc = cache->ninfo;
+    }
+    trk->nout = nsrc + (delta ? 3 : 2);
+    PMIX_INFO_CREATE(trk->out, trk->nout);
+    PMIX_INFO_LOAD(&trk->out[0], PMIX_FABRIC_INDEX, &cache->index, PMIX_SIZE);
+    PMIX_INFO_LOAD(&trk->out[1], PMIX_FABRIC_REVISION, &cache->revision, PMIX_UINT64);
+    m = 2;
+    if (delta) {
+        PMIX_INFO_LOAD(&trk->out[2], PMIX_FABRIC_DELTA, NULL, PMIX_BOOL);
+        m = 3;
+    }
+    for (n = 0; n < nsrc; n++) {
+        if (PMIX_UNDEF == src[n].value.type) {
+            PMIX_LOAD_KEY(trk->out[m + n].key, src[n].key);
+        } else {
+            PMIX_INFO_XFER(&trk->out[m + n], &src[n]);
+        }
+    }
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:fabric %lu at revision %lu - returning %s with %lu entries",
+                        (unsigned long) cache->index, (unsigned long) cache->revision,
+                        delta ? "changes" : "all", (unsigned long) nsrc);
+    qcd->cbfunc(PMIX_SUCCESS, trk->out, trk->nout, qcd, fabric_release, trk);
+}
+
+/* the answer from the host */
+static void fabric_host_cbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo,
+                               void *cbdata, pmix_release_cbfunc_t release_fn,
+                               void *release_cbdata)
+{
+    pmix_fabric_trk_t *trk = (pmix_fabric_trk_t *) cbdata;
+    size_t n;
+
+    trk->status = status;
+    if (PMIX_SUCCESS == status && 0 < ninfo) {
+        PMIX_INFO_CREATE(trk->info, ninfo);
+        trk->ninfo = ninfo;
+        for (n = 0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&trk->info[n], &info[n]);
+        }
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    /* the cache can only be touched in our progress thread */
+    PMIX_THREADSHIFT(trk, fabric_respond);
 }
 
 static void frcbfunc(pmix_status_t status, void *cbdata)
@@ -4669,6 +6119,7 @@ pmix_status_t pmix_server_fabric_register(pmix_server_caddy_t *cd, pmix_buffer_t
     int32_t cnt;
     pmix_status_t rc;
     pmix_query_caddy_t *qcd = NULL;
+    pmix_fabric_trk_t *trk;
     pmix_proc_t proc;
     pmix_fabric_t fabric;
 
@@ -4688,50 +6139,44 @@ pmix_status_t pmix_server_fabric_register(pmix_server_caddy_t *cd, pmix_buffer_t
     PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &qcd->ninfo, &cnt, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        PMIX_RELEASE(qcd);
         goto exit;
     }
     /* unpack the directives */
     if (0 < qcd->ninfo) {
-        PMIX_INFO_CREATE(cd->info, qcd->ninfo);
+        PMIX_INFO_CREATE(qcd->info, qcd->ninfo);
         cnt = qcd->ninfo;
         PMIX_BFROPS_UNPACK(rc, cd->peer, buf, qcd->info, &cnt, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(qcd);
             goto exit;
         }
     }
 
+    trk = PMIX_NEW(pmix_fabric_trk_t);
+    trk->qcd = qcd;
+
     /* see if we support this request ourselves */
     PMIX_FABRIC_CONSTRUCT(&fabric);
     rc = pmix_pnet.register_fabric(&fabric, qcd->info, qcd->ninfo, frcbfunc, qcd);
-    if (PMIX_OPERATION_SUCCEEDED == rc) {
-        /* we need to respond, but we want to ensure
-         * that occurs _after_ the client returns from its API */
-        if (NULL != qcd->info) {
-            PMIX_INFO_FREE(qcd->info, qcd->ninfo);
-        }
-        qcd->info = fabric.info;
-        qcd->ninfo = fabric.ninfo;
-        PMIX_THREADSHIFT(qcd, _fabric_response);
-        return PMIX_SUCCESS;
-    } else if (PMIX_SUCCESS == rc) {
+    if (PMIX_SUCCESS == rc) {
         PMIX_WAIT_THREAD(&qcd->lock);
+        rc = PMIX_OPERATION_SUCCEEDED;
+    }
+    if (PMIX_OPERATION_SUCCEEDED == rc) {
         /* we need to respond, but we want to ensure
          * that occurs _after_ the client returns from its API */
-        if (NULL != qcd->info) {
-            PMIX_INFO_FREE(qcd->info, qcd->ninfo);
-        }
-        qcd->info = fabric.info;
-        qcd->ninfo = fabric.ninfo;
-        PMIX_THREADSHIFT(qcd, _fabric_response);
+        trk->have_index = true;
+        trk->index = fabric.index;
+        trk->info = fabric.info;
+        trk->ninfo = fabric.ninfo;
+        PMIX_THREADSHIFT(trk, fabric_respond);
         return PMIX_SUCCESS;
     }
 
     /* if we don't internally support it, see if
      * our host does */
     if (NULL == pmix_host_server.fabric) {
+        PMIX_RELEASE(trk);
         rc = PMIX_ERR_NOT_SUPPORTED;
         goto exit;
     }
@@ -4740,17 +6185,17 @@ pmix_status_t pmix_server_fabric_register(pmix_server_caddy_t *cd, pmix_buffer_t
     PMIX_LOAD_PROCID(&proc, cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
 
     /* ask the host to execute the request */
-    if (PMIX_SUCCESS
-        != (rc = pmix_host_server.fabric(&proc, PMIX_FABRIC_REQUEST_INFO, qcd->info, qcd->ninfo,
-                                         cbfunc, qcd))) {
+    rc = pmix_host_server.fabric(&proc, PMIX_FABRIC_REQUEST_INFO, qcd->info, qcd->ninfo,
+                                 fabric_host_cbfunc, trk);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(trk);
         goto exit;
     }
     return PMIX_SUCCESS;
 
 exit:
-    if (NULL != qcd) {
-        PMIX_RELEASE(qcd);
-    }
+    PMIX_RELEASE(qcd);
+    PMIX_RELEASE(cd);
     return rc;
 }
 
@@ -4759,8 +6204,10 @@ pmix_status_t pmix_server_fabric_update(pmix_server_caddy_t *cd, pmix_buffer_t *
 {
     int32_t cnt;
     size_t index;
+    uint64_t revision = 0;
     pmix_status_t rc;
     pmix_query_caddy_t *qcd;
+    pmix_fabric_trk_t *trk;
     pmix_proc_t proc;
     pmix_fabric_t fabric;
 
@@ -4772,6 +6219,7 @@ pmix_status_t pmix_server_fabric_update(pmix_server_caddy_t *cd, pmix_buffer_t *
         return PMIX_ERR_NOMEM;
     }
     PMIX_RETAIN(cd);
+    qcd->cbfunc = cbfunc;
     qcd->cbdata = cd;
 
     /* unpack the fabric index */
@@ -4781,6 +6229,22 @@ pmix_status_t pmix_server_fabric_update(pmix_server_caddy_t *cd, pmix_buffer_t *
         PMIX_ERROR_LOG(rc);
         goto exit;
     }
+    /* the revision the client holds - older clients don't send it */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &revision, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto exit;
+        }
+        revision = 0;
+    }
+
+    trk = PMIX_NEW(pmix_fabric_trk_t);
+    trk->qcd = qcd;
+    trk->have_index = true;
+    trk->index = index;
+    trk->revision = revision;
 
     /* see if we support this request ourselves */
     PMIX_FABRIC_CONSTRUCT(&fabric);
@@ -4789,18 +6253,16 @@ pmix_status_t pmix_server_fabric_update(pmix_server_caddy_t *cd, pmix_buffer_t *
     if (PMIX_SUCCESS == rc) {
         /* we need to respond, but we want to ensure
          * that occurs _after_ the client returns from its API */
-        if (NULL != qcd->info) {
-            PMIX_INFO_FREE(qcd->info, qcd->ninfo);
-        }
-        qcd->info = fabric.info;
-        qcd->ninfo = fabric.ninfo;
-        PMIX_THREADSHIFT(qcd, _fabric_response);
+        trk->info = fabric.info;
+        trk->ninfo = fabric.ninfo;
+        PMIX_THREADSHIFT(trk, fabric_respond);
         return rc;
     }
 
     /* if we don't internally support it, see if
      * our host does */
     if (NULL == pmix_host_server.fabric) {
+        PMIX_RELEASE(trk);
         rc = PMIX_ERR_NOT_SUPPORTED;
         goto exit;
     }
@@ -4814,14 +6276,17 @@ pmix_status_t pmix_server_fabric_update(pmix_server_caddy_t *cd, pmix_buffer_t *
     PMIX_INFO_LOAD(&qcd->info[0], PMIX_FABRIC_INDEX, &index, PMIX_SIZE);
 
     /* ask the host to execute the request */
-    if (PMIX_SUCCESS
-        != (rc = pmix_host_server.fabric(&proc, PMIX_FABRIC_UPDATE_INFO, qcd->info, qcd->ninfo,
-                                         cbfunc, qcd))) {
+    rc = pmix_host_server.fabric(&proc, PMIX_FABRIC_UPDATE_INFO, qcd->info, qcd->ninfo,
+                                 fabric_host_cbfunc, trk);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(trk);
         goto exit;
     }
     return PMIX_SUCCESS;
 
 exit:
+    PMIX_RELEASE(qcd);
+    PMIX_RELEASE(cd);
     return rc;
 }
 
@@ -4925,12 +6390,85 @@ cleanup:
     return rc;
 }
 
+/* A client refreshing its cache tells us the proc it wants and the
+ * epoch of the data it got from us last time. We only send back the
+ * values stored for that proc since then, along with the current
+ * epoch for it to present next time. Clients that don't provide an
+ * epoch are told this isn't supported, as before. On success the
+ * reply has been sent and the caddy released */
 pmix_status_t pmix_server_refresh_cache(pmix_server_caddy_t *cd,
-                                        pmix_buffer_t *buf,
-                                        pmix_op_cbfunc_t cbfunc)
+                                        pmix_buffer_t *buf)
 {
-    PMIX_HIDE_UNUSED_PARAMS(cd, buf, cbfunc);
-    return PMIX_ERR_NOT_SUPPORTED;
+    pmix_gds_base_module_t *gds = pmix_globals.mypeer->nptr->compat.gds;
+    pmix_proc_t proc;
+    uint64_t since, epoch;
+    int32_t cnt;
+    pmix_list_t kvs;
+    pmix_buffer_t *reply, pkt;
+    pmix_byte_object_t bo;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &proc, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &since, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (NULL == gds->fetch_changed) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    PMIX_CONSTRUCT(&kvs, pmix_list_t);
+    rc = gds->fetch_changed(&proc, since, &epoch, &kvs);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_LIST_DESTRUCT(&kvs);
+        return rc;
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "%s REFRESH CACHE OF %s FOR %s: %lu VALUES SINCE EPOCH %lu",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), PMIX_NAME_PRINT(&proc),
+                        PMIX_PNAME_PRINT(&cd->peer->info->pname),
+                        (unsigned long) pmix_list_get_size(&kvs), (unsigned long) since);
+
+    reply = PMIX_NEW(pmix_buffer_t);
+    if (NULL == reply) {
+        PMIX_LIST_DESTRUCT(&kvs);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_BFROPS_PACK(rc, cd->peer, reply, &ret, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, cd->peer, reply, &epoch, 1, PMIX_UINT64);
+    }
+    if (PMIX_SUCCESS == rc && 0 < pmix_list_get_size(&kvs)) {
+        /* the values go back the way a get returns them */
+        PMIX_CONSTRUCT(&pkt, pmix_buffer_t);
+        PMIX_GDS_ASSEMB_KVS_REQ(rc, pmix_globals.mypeer, &proc, &kvs, &pkt, cd);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_UNLOAD_BUFFER(&pkt, bo.bytes, bo.size);
+            PMIX_BFROPS_PACK(rc, cd->peer, reply, &bo, 1, PMIX_BYTE_OBJECT);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        }
+        PMIX_DESTRUCT(&pkt);
+    }
+    PMIX_LIST_DESTRUCT(&kvs);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(reply);
+        return rc;
+    }
+
+    PMIX_SERVER_QUEUE_REPLY(rc, cd->peer, cd->hdr.tag, reply);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(reply);
+    }
+    PMIX_RELEASE(cd);
+    return PMIX_SUCCESS;
 }
 
 /*****    INSTANCE SERVER LIBRARY CLASSES    *****/
@@ -4949,6 +6487,7 @@ PMIX_CLASS_INSTANCE(pmix_grpinfo_t,
 
 static void tcon(pmix_server_trkr_t *t)
 {
+    pmix_timer_construct(&t->timer);
     t->event_active = false;
     t->host_called = false;
     t->local = true;
@@ -4957,6 +6496,9 @@ static void tcon(pmix_server_trkr_t *t)
     t->pname.rank = PMIX_RANK_UNDEF;
     t->pcs = NULL;
     t->npcs = 0;
+    t->sig = 0;
+    t->pipeline = NULL;
+    t->npipelined = 0;
     PMIX_CONSTRUCT(&t->nslist, pmix_list_t);
     PMIX_CONSTRUCT_LOCK(&t->lock);
     t->def_complete = false;
@@ -4968,6 +6510,9 @@ static void tcon(pmix_server_trkr_t *t)
     PMIX_CONSTRUCT(&t->grpinfo, pmix_list_t);
     /* this needs to be set explicitly */
     t->collect_type = PMIX_COLLECT_INVALID;
+    t->collect_keys = NULL;
+    t->mdx_release_time = 0;
+    t->mdx_release_fetched = false;
     t->modexcbfunc = NULL;
     t->op_cbfunc = NULL;
     t->hybrid = false;
@@ -4975,6 +6520,7 @@ static void tcon(pmix_server_trkr_t *t)
 }
 static void tdes(pmix_server_trkr_t *t)
 {
+    pmix_timer_del(&t->timer);
     if (NULL != t->id) {
         free(t->id);
     }
@@ -4982,12 +6528,18 @@ static void tdes(pmix_server_trkr_t *t)
     if (NULL != t->pcs) {
         free(t->pcs);
     }
+    if (NULL != t->pipeline) {
+        PMIX_RELEASE(t->pipeline);
+    }
     PMIX_LIST_DESTRUCT(&t->local_cbs);
     if (NULL != t->info) {
         PMIX_INFO_FREE(t->info, t->ninfo);
     }
     PMIX_LIST_DESTRUCT(&t->grpinfo);
     PMIX_LIST_DESTRUCT(&t->nslist);
+    if (NULL != t->collect_keys) {
+        pmix_argv_free(t->collect_keys);
+    }
 }
 PMIX_CLASS_INSTANCE(pmix_server_trkr_t, pmix_list_item_t, tcon, tdes);
 
@@ -5089,15 +6641,13 @@ PMIX_CLASS_INSTANCE(pmix_dmdx_remote_t, pmix_list_item_t, dmcon, dmdes);
 
 static void dmrqcon(pmix_dmdx_request_t *p)
 {
-    memset(&p->ev, 0, sizeof(pmix_event_t));
+    pmix_timer_construct(&p->timer);
     p->event_active = false;
     p->lcd = NULL;
 }
 static void dmrqdes(pmix_dmdx_request_t *p)
 {
-    if (p->event_active) {
-        pmix_event_del(&p->ev);
-    }
+    pmix_timer_del(&p->timer);
     if (NULL != p->lcd) {
         PMIX_RELEASE(p->lcd);
     }
@@ -5174,9 +6724,12 @@ static void grcon(pmix_group_t *p)
     p->grpid = NULL;
     p->members = NULL;
     p->nmbrs = 0;
+    p->map = NULL;
+    p->nmap = 0;
 }
 static void grdes(pmix_group_t *p)
 {
+    group_map_free(p);
     if (NULL != p->grpid) {
         free(p->grpid);
     }
@@ -5191,6 +6744,8 @@ PMIX_CLASS_INSTANCE(pmix_group_caddy_t, pmix_list_item_t, NULL, NULL);
 static void iocon(pmix_iof_cache_t *p)
 {
     p->bo = NULL;
+    p->spill = NULL;
+    p->offset = 0;
     p->info = NULL;
     p->ninfo = 0;
 }
@@ -5206,7 +6761,8 @@ PMIX_CLASS_INSTANCE(pmix_iof_cache_t, pmix_list_item_t, iocon, iodes);
 static void pscon(pmix_pset_t *p)
 {
     p->name = NULL;
-    p->members = NULL;
+    p->ranges = NULL;
+    p->nranges = 0;
     p->nmembers = 0;
 }
 static void psdes(pmix_pset_t *p)
@@ -5214,8 +6770,99 @@ static void psdes(pmix_pset_t *p)
     if (NULL != p->name) {
         free(p->name);
     }
-    if (NULL != p->members) {
-        free(p->members);
+    if (NULL != p->ranges) {
+        free(p->ranges);
     }
 }
 PMIX_CLASS_INSTANCE(pmix_pset_t, pmix_list_item_t, pscon, psdes);
+
+/* special ranks (e.g., the wildcard) never join a run */
+static bool pset_extends(const pmix_proc_t *prev, const pmix_proc_t *next)
+{
+    return (PMIX_RANK_VALID > prev->rank && next->rank == prev->rank + 1 &&
+            PMIX_RANK_VALID >= next->rank && PMIX_CHECK_NSPACE(prev->nspace, next->nspace));
+}
+
+pmix_status_t pmix_server_pset_load(pmix_pset_t *ps, const pmix_proc_t *members, size_t nmembers)
+{
+    size_t n, nranges = 0;
+    pmix_pset_range_t *rg;
+
+    for (n = 0; n < nmembers; n++) {
+        if (0 == n || !pset_extends(&members[n - 1], &members[n])) {
+            ++nranges;
+        }
+    }
+    if (NULL != ps->ranges) {
+        free(ps->ranges);
+        ps->ranges = NULL;
+    }
+    ps->nranges = 0;
+    ps->nmembers = 0;
+    if (0 == nranges) {
+        return PMIX_SUCCESS;
+    }
+    ps->ranges = (pmix_pset_range_t *) malloc(nranges * sizeof(pmix_pset_range_t));
+    if (NULL == ps->ranges) {
+        return PMIX_ERR_NOMEM;
+    }
+    rg = NULL;
+    for (n = 0; n < nmembers; n++) {
+        if (NULL != rg && pset_extends(&members[n - 1], &members[n])) {
+            rg->last = members[n].rank;
+            continue;
+        }
+        rg = &ps->ranges[ps->nranges++];
+        PMIX_LOAD_NSPACE(rg->nspace, members[n].nspace);
+        rg->first = members[n].rank;
+        rg->last = members[n].rank;
+    }
+    ps->nmembers = nmembers;
+    return PMIX_SUCCESS;
+}
+
+/* procs must hold ps->nmembers entries */
+void pmix_server_pset_expand(const pmix_pset_t *ps, pmix_proc_t *procs)
+{
+    size_t n, m = 0;
+    pmix_rank_t r;
+
+    for (n = 0; n < ps->nranges; n++) {
+        for (r = ps->ranges[n].first;; r++) {
+            PMIX_LOAD_PROCID(&procs[m], ps->ranges[n].nspace, r);
+            ++m;
+            if (r == ps->ranges[n].last) {
+                break;
+            }
+        }
+    }
+}
+
+/* answer a PMIX_QUERY_PSET_MEMBERSHIP query for a process set
+ * defined by our host - must be called from the progress thread */
+pmix_status_t pmix_server_pset_membership(const char *name, pmix_kval_t **kv)
+{
+    pmix_pset_t *ps;
+    pmix_data_array_t *darray;
+    pmix_kval_t *k;
+
+    if (NULL == name ||
+        PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.pset_names,
+                                                      name, strlen(name), (void **) &ps)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    PMIX_KVAL_NEW(k, PMIX_QUERY_PSET_MEMBERSHIP);
+    if (NULL == k || NULL == k->value) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_DATA_ARRAY_CREATE(darray, ps->nmembers, PMIX_PROC);
+    if (NULL == darray) {
+        PMIX_RELEASE(k);
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_server_pset_expand(ps, (pmix_proc_t *) darray->array);
+    k->value->type = PMIX_DATA_ARRAY;
+    k->value->data.darray = darray;
+    *kv = k;
+    return PMIX_SUCCESS;
+}
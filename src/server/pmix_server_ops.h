@@ -25,7 +25,9 @@
 #include "src/include/pmix_types.h"
 
 #include "include/pmix_server.h"
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_hotel.h"
+#include "src/class/pmix_obj_pool.h"
 #include "src/include/pmix_globals.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_hash.h"
@@ -119,7 +121,7 @@ PMIX_CLASS_DECLARATION(pmix_dmdx_local_t);
 
 typedef struct {
     pmix_list_item_t super;
-    pmix_event_t ev;
+    pmix_timer_t timer;
     bool event_active;
     pmix_dmdx_local_t *lcd;
     pmix_modex_cbfunc_t cbfunc; // cbfunc to be executed when data is available
@@ -144,11 +146,29 @@ typedef struct {
 } pmix_regevents_info_t;
 PMIX_CLASS_DECLARATION(pmix_regevents_info_t);
 
+/* position of a member rank within a group */
+typedef struct {
+    pmix_rank_t rank;
+    size_t idx;
+} pmix_group_rank_t;
+
+/* the members of a group that belong to one nspace */
+typedef struct {
+    pmix_nspace_t nspace;
+    pmix_group_rank_t *ranks; // sorted by rank, including any wildcard or special ranks
+    size_t nranks;
+    bool wildcard;            // the whole nspace is a member
+    bool dense;               // every explicit rank is flagged in the bitmap
+    pmix_bitmap_t bits;
+} pmix_group_nsmap_t;
+
 typedef struct {
     pmix_list_item_t super;
     char *grpid;
     pmix_proc_t *members;
     size_t nmbrs;
+    pmix_group_nsmap_t *map;  // index of the members, sorted by nspace
+    size_t nmap;
 } pmix_group_t;
 PMIX_CLASS_DECLARATION(pmix_group_t);
 
@@ -160,20 +180,48 @@ typedef struct {
 } pmix_group_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_group_caddy_t);
 
+/* file holding the cached output of an nspace that did not fit in
+ * the in-memory cache */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    char *path;
+    int fd;
+    size_t size;     // bytes written to the file
+    char *base;      // read-only mapping of the file
+    size_t mapped;   // bytes covered by the mapping
+    size_t nentries; // cached messages whose data is in the file
+} pmix_iof_spill_t;
+PMIX_CLASS_DECLARATION(pmix_iof_spill_t);
+
 typedef struct {
     pmix_list_item_t super;
     pmix_proc_t source;
     pmix_iof_channel_t channel;
+    /* if the data was spilled, bo->bytes is NULL and the
+     * bo->size bytes are at the offset in the spill file */
     pmix_byte_object_t *bo;
+    pmix_iof_spill_t *spill;
+    size_t offset;
     pmix_info_t *info;
     size_t ninfo;
 } pmix_iof_cache_t;
 PMIX_CLASS_DECLARATION(pmix_iof_cache_t);
 
+/* a run of consecutive ranks of one nspace */
+typedef struct {
+    pmix_nspace_t nspace;
+    pmix_rank_t first;
+    pmix_rank_t last;
+} pmix_pset_range_t;
+
+/* most process sets are a few rank ranges of one nspace, so the
+ * members are held as runs, in the order they were given */
 typedef struct {
     pmix_list_item_t super;
     char *name;
-    pmix_proc_t *members;
+    pmix_pset_range_t *ranges;
+    size_t nranges;
     size_t nmembers;
 } pmix_pset_t;
 PMIX_CLASS_DECLARATION(pmix_pset_t);
@@ -182,21 +230,66 @@ typedef struct {
     pmix_list_t nspaces;          // list of pmix_nspace_t for the nspaces we know about
     pmix_pointer_array_t clients; // array of pmix_peer_t local clients
     pmix_list_t collectives;      // list of active pmix_server_trkr_t
+    pmix_hash_table_t trackers;   // active pmix_server_trkr_t indexed by signature
     pmix_list_t remote_pnd; // list of pmix_dmdx_remote_t awaiting arrival of data fror servicing
                             // remote req's
     pmix_list_t local_reqs;     // list of pmix_dmdx_local_t awaiting arrival of data from local neighbours
     pmix_list_t gdata;  // cache of data given to me for passing to all clients
     char **genvars;     // argv array of envars given to me for passing to all clients
     pmix_list_t events; // list of pmix_regevents_info_t registered events
+    pmix_hash_table_t event_codes; // pmix_regevents_info_t indexed by status code
     pmix_list_t groups; // list of pmix_group_t group memberships
+    pmix_hash_table_t group_ids; // pmix_group_t indexed by group ID
     pmix_list_t iof;    // IO to be forwarded to clients
     pmix_list_t iof_residuals;  // leftover bytes waiting for newline
     pmix_list_t psets;  // list of known psets and memberships
+    pmix_hash_table_t pset_names; // pmix_pset_t indexed by pset name
+    pmix_list_t fabric_cache;     // last answer for each fabric, to send updates as deltas
+    pmix_list_t finalizing;       // pmix_server_caddy_t of finalized clients awaiting a batched purge
     size_t max_iof_cache; // max number of IOF messages to cache
+    size_t max_iof_cache_bytes; // max bytes of IOF data to cache in memory
+    size_t iof_cache_bytes;     // bytes of IOF data cached in memory
+    bool iof_spill;             // put IOF data beyond the memory cap into a file per nspace
+    size_t max_iof_spill;       // max bytes of the spill file of an nspace
+    pmix_list_t iof_spills;     // list of pmix_iof_spill_t
     bool tool_connections_allowed;
     char *tmpdir;             // temporary directory for this server
     char *system_tmpdir;      // system tmpdir
     bool fence_localonly_opt; // local-only fence optimization
+    bool fence_pipeline;      // assemble local fence contributions as they arrive
+    bool fence_dedup;         // send values common to several local ranks once per fence blob
+    bool sched;               // queue event and bulk commands behind the urgent ones
+    int sched_event_weight;   // event commands serviced per scheduler pass
+    int sched_bulk_weight;    // query/log/IOF commands serviced per scheduler pass
+    int sched_tool_limit;     // commands a tool may have waiting in each class
+    bool shmem_modex;         // serve collected modex data to local clients from shared memory
+    int dmodex_aggregate_window; // usecs to hold dmodex requests for procs on the same node
+    int dmodex_prefetch_window;  // number of ranks either side of a dmodex miss to also request
+    bool dmodex_prefetch_node;   // also request all ranks on the node of a dmodex miss
+    int event_batch_window;      // usecs to hold event notifications for a client
+    int event_batch_max;         // max number of notifications held for a client
+    int group_cid_block;         // number of context IDs to lease from the host at a time
+    size_t group_cid_next;       // next unused context ID in the current lease
+    size_t group_cid_left;       // number of context IDs left in the current lease
+    size_t request_pool_max;     // max request objects of each class held for reuse
+    pmix_obj_pool_t server_caddy_pool; // storage for pmix_server_caddy_t
+    pmix_obj_pool_t setup_caddy_pool;  // storage for pmix_setup_caddy_t
+    pmix_obj_pool_t shift_caddy_pool;  // storage for pmix_shift_caddy_t
+    pmix_obj_pool_t dmdx_request_pool; // storage for pmix_dmdx_request_t
+    bool cmd_stats;              // track per-command request counts and reply latency
+    size_t locality_matrix_max;  // max local procs in an nspace to publish a locality matrix for
+    int register_slice;          // per-proc data entries of an nspace to cache per event loop pass
+    bool inventory_parallel;      // run the inventory collection of each framework on its own thread
+    int inventory_cache_lifetime; // secs to answer inventory requests from the last collection
+    bool pubsub_cache;            // answer repeat lookups from data published or found before
+    int pubsub_cache_lifetime;    // secs to reuse the answer to a lookup the host resolved
+    bool pubsub_coalesce;         // combine publishes and waiting lookups into shared upcalls
+    bool query_coalesce;          // share the answer to identical queries from local clients
+    int query_cache_lifetime;     // secs to reuse the answer to a query of cacheable keys
+    char *query_cache_keys;       // comma-delimited list of query keys whose answers may be reused
+    int query_stream_chunk;       // max elements per batch of an array streamed to a requestor
+    bool finalize_batch;          // purge the clients that finalized in the same event loop pass together
+    char *snapshot;               // file in which to keep the server's state for a restart
     // verbosity for server get operations
     int get_output;
     int get_verbose;
@@ -223,12 +316,15 @@ typedef struct {
     int base_verbose;
 } pmix_server_globals_t;
 
-#define PMIX_GDS_CADDY(c, p, t)              \
-    do {                                     \
-        (c) = PMIX_NEW(pmix_server_caddy_t); \
-        (c)->hdr.tag = (t);                  \
-        PMIX_RETAIN((p));                    \
-        (c)->peer = (p);                     \
+/* allocator for one of the request objects pooled by the server */
+#define PMIX_SERVER_POOL(n) pmix_obj_pool_tma(&pmix_server_globals.n##_pool)
+
+#define PMIX_GDS_CADDY(c, p, t)                                              \
+    do {                                                                     \
+        (c) = PMIX_NEW(pmix_server_caddy_t, PMIX_SERVER_POOL(server_caddy)); \
+        (c)->hdr.tag = (t);                                                  \
+        PMIX_RETAIN((p));                                                    \
+        (c)->peer = (p);                                                     \
     } while (0)
 
 #define PMIX_SETUP_COLLECTIVE(c, t)        \
@@ -244,13 +340,20 @@ typedef struct {
         pmix_event_active(&((c)->ev), EV_WRITE, 1);                                 \
     } while (0)
 
+PMIX_EXPORT void pmix_server_pools_finalize(void);
+
 PMIX_EXPORT bool pmix_server_trk_update(pmix_server_trkr_t *trk);
+PMIX_EXPORT void pmix_server_trk_remove(pmix_server_trkr_t *trk);
+PMIX_EXPORT bool pmix_server_trk_all_local(pmix_server_trkr_t *trk);
+PMIX_EXPORT bool pmix_server_trk_collects(pmix_server_trkr_t *trk, const char *key);
 
 PMIX_EXPORT void pmix_pending_nspace_requests(pmix_namespace_t *nptr);
 PMIX_EXPORT pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
                                                pmix_status_t status, pmix_scope_t scope,
                                                pmix_dmdx_local_t *lcd);
 
+PMIX_EXPORT pmix_status_t pmix_server_job_info(pmix_peer_t *peer, pmix_buffer_t **reply);
+
 PMIX_EXPORT pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
                                             pmix_op_cbfunc_t cbfunc, void *cbdata);
 
@@ -263,6 +366,116 @@ PMIX_EXPORT pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer
 PMIX_EXPORT pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc,
                                           void *cbdata);
 
+PMIX_EXPORT pmix_status_t pmix_server_get_batch(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc,
+                                                void *cbdata);
+
+PMIX_EXPORT void pmix_server_dmdx_init(void);
+PMIX_EXPORT void pmix_server_dmdx_finalize(void);
+PMIX_EXPORT void pmix_server_dmdx_purge(const char *nspace);
+
+/* the data of a fence has been stored - see when to release it */
+PMIX_EXPORT void pmix_server_modex_collected(pmix_server_trkr_t *trk);
+
+PMIX_EXPORT bool pmix_server_dmdx_stat(const char *key, uint64_t *val);
+
+PMIX_EXPORT void pmix_server_dmdx_query(int sd, short args, void *cbdata);
+
+/* per-command request counts and reply latency - replies are
+ * recorded by pmix_server_stats_reply, declared in ptl_types.h */
+PMIX_EXPORT void pmix_server_stats_request(pmix_peer_t *peer, uint32_t tag, pmix_cmd_t cmd);
+
+PMIX_EXPORT bool pmix_server_stats_key(const char *key);
+
+PMIX_EXPORT void pmix_server_stats_query(int sd, short args, void *cbdata);
+
+/* process set members */
+PMIX_EXPORT pmix_status_t pmix_server_pset_load(pmix_pset_t *ps, const pmix_proc_t *members,
+                                                size_t nmembers);
+PMIX_EXPORT void pmix_server_pset_expand(const pmix_pset_t *ps, pmix_proc_t *procs);
+PMIX_EXPORT pmix_status_t pmix_server_pset_membership(const char *name, pmix_kval_t **kv);
+
+/* add the relative locality of the nspace's local procs to its job info */
+PMIX_EXPORT void pmix_server_locality_matrix(pmix_namespace_t *nptr);
+
+/* collect the local inventory for PMIx_server_collect_inventory */
+PMIX_EXPORT void pmix_server_inventory_collect(int sd, short args, void *cbdata);
+
+PMIX_EXPORT void pmix_server_inventory_flush(void);
+
+/* node-local cache of published data - must be called from the
+ * progress thread, except for pmix_server_pubsub_learn */
+PMIX_EXPORT void pmix_server_pubsub_init(void);
+PMIX_EXPORT void pmix_server_pubsub_finalize(void);
+PMIX_EXPORT void pmix_server_pubsub_publish(const pmix_proc_t *publisher, pmix_info_t info[],
+                                            size_t ninfo);
+PMIX_EXPORT void pmix_server_pubsub_unpublish(const pmix_proc_t *publisher, char **keys);
+PMIX_EXPORT bool pmix_server_pubsub_lookup(const pmix_proc_t *requestor, char **keys,
+                                           pmix_info_t info[], size_t ninfo,
+                                           pmix_pdata_t **pdata, size_t *ndata);
+PMIX_EXPORT void pmix_server_pubsub_learn(const pmix_proc_t *requestor, pmix_info_t info[],
+                                          size_t ninfo, pmix_pdata_t pdata[], size_t ndata);
+PMIX_EXPORT void pmix_server_pubsub_purge(const pmix_proc_t *proc);
+/* hand a publish request to the host, combined with others from
+ * the same proc that arrive while one is outstanding */
+PMIX_EXPORT pmix_status_t pmix_server_pubsub_submit(pmix_setup_caddy_t *cd);
+/* returns false if the lookup is not waiting for its data - else
+ * it was either attached to an outstanding host request for the
+ * same data, or one was issued, with the result in rc */
+PMIX_EXPORT bool pmix_server_pubsub_wait(pmix_setup_caddy_t *cd, pmix_status_t *rc);
+
+/* output cached until someone registers for it - must be called from
+ * the progress thread. The data of a cached message is obtained with
+ * pmix_server_iof_cache_data, and remains valid until the next
+ * message is added to the cache */
+PMIX_EXPORT void pmix_server_iof_cache_add(const pmix_proc_t *source, pmix_iof_channel_t channel,
+                                           const pmix_byte_object_t *bo, const pmix_info_t *info,
+                                           size_t ninfo);
+PMIX_EXPORT bool pmix_server_iof_cache_data(pmix_iof_cache_t *iof, pmix_byte_object_t *bo);
+PMIX_EXPORT void pmix_server_iof_cache_remove(pmix_iof_cache_t *iof);
+PMIX_EXPORT void pmix_server_iof_cache_purge(void);
+
+/* snapshot of the server's state for a restart - the restore is
+ * called by PMIx_server_init, the rest from the progress thread */
+PMIX_EXPORT void pmix_server_snapshot_restore(void);
+PMIX_EXPORT void pmix_server_snapshot_finalize(void);
+PMIX_EXPORT void pmix_server_snapshot_nspace(const char *nspace, int nlocalprocs,
+                                             pmix_info_t *info, size_t ninfo);
+PMIX_EXPORT void pmix_server_snapshot_nspace_delete(const char *nspace);
+PMIX_EXPORT void pmix_server_snapshot_client(const pmix_proc_t *proc, uid_t uid, gid_t gid);
+PMIX_EXPORT void pmix_server_snapshot_client_delete(const pmix_proc_t *proc);
+PMIX_EXPORT void pmix_server_snapshot_pset(const char *name, const pmix_proc_t *members,
+                                           size_t nmembers);
+PMIX_EXPORT void pmix_server_snapshot_pset_delete(const char *name);
+PMIX_EXPORT void pmix_server_snapshot_group(const pmix_group_t *grp);
+PMIX_EXPORT void pmix_server_snapshot_group_delete(const char *grpid);
+
+/* priority classes of inbound commands - must be called from the
+ * progress thread. pmix_server_sched_defer returns true if it took
+ * the message, which is then handed to pmix_server_dispatch later */
+typedef enum {
+    PMIX_SERVER_CLASS_URGENT,   // collectives, gets, commits - never deferred
+    PMIX_SERVER_CLASS_EVENT,    // event notification and registration
+    PMIX_SERVER_CLASS_BULK,     // queries, logs, IOF, monitoring
+    PMIX_SERVER_NCLASSES
+} pmix_server_class_t;
+
+PMIX_EXPORT void pmix_server_sched_init(void);
+PMIX_EXPORT void pmix_server_sched_finalize(void);
+PMIX_EXPORT bool pmix_server_sched_defer(pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                                         pmix_buffer_t *buf);
+PMIX_EXPORT void pmix_server_dispatch(pmix_peer_t *peer, uint32_t tag, pmix_buffer_t *buf);
+PMIX_EXPORT void pmix_server_reply_status(pmix_peer_t *peer, uint32_t tag, pmix_status_t status);
+
+/* queries from local clients - must be called from the progress thread */
+PMIX_EXPORT void pmix_server_query_init(void);
+PMIX_EXPORT void pmix_server_query_finalize(void);
+PMIX_EXPORT pmix_status_t pmix_server_query_submit(pmix_query_caddy_t *cd);
+PMIX_EXPORT bool pmix_server_query_streamed(pmix_query_t *queries, size_t nqueries);
+PMIX_EXPORT size_t pmix_server_query_chunk(pmix_query_t *queries, size_t nqueries);
+PMIX_EXPORT pmix_status_t pmix_server_query_append(pmix_info_t **info, size_t *ninfo,
+                                                   pmix_info_t *add, size_t nadd);
+PMIX_EXPORT void pmix_server_query_flush(void);
+
 PMIX_EXPORT pmix_status_t pmix_server_publish(pmix_peer_t *peer, pmix_buffer_t *buf,
                                               pmix_op_cbfunc_t cbfunc, void *cbdata);
 
@@ -294,12 +507,29 @@ PMIX_EXPORT pmix_status_t pmix_server_register_events(pmix_peer_t *peer, pmix_bu
 
 PMIX_EXPORT void pmix_server_deregister_events(pmix_peer_t *peer, pmix_buffer_t *buf);
 
+/* lookup the registrations for a status code, and remove
+ * an emptied registration from the list and index */
+PMIX_EXPORT pmix_regevents_info_t *pmix_server_event_lookup(pmix_status_t code);
+PMIX_EXPORT void pmix_server_event_remove(pmix_regevents_info_t *reginfo);
+
+/* group registry - pmix_server_group_index must be called
+ * whenever the members of a group are set or changed */
+PMIX_EXPORT void pmix_server_group_add(pmix_group_t *grp);
+PMIX_EXPORT pmix_group_t *pmix_server_group_lookup(const char *grpid);
+PMIX_EXPORT void pmix_server_group_remove(pmix_group_t *grp);
+PMIX_EXPORT pmix_status_t pmix_server_group_index(pmix_group_t *grp);
+PMIX_EXPORT pmix_group_nsmap_t *pmix_server_group_nsmap(pmix_group_t *grp, const char *nspace);
+PMIX_EXPORT bool pmix_server_group_is_member(pmix_group_t *grp, const pmix_proc_t *proc);
+
 PMIX_EXPORT pmix_status_t pmix_server_query(pmix_peer_t *peer, pmix_buffer_t *buf,
                                             pmix_info_cbfunc_t cbfunc, void *cbdata);
 
 PMIX_EXPORT pmix_status_t pmix_server_log(pmix_peer_t *peer, pmix_buffer_t *buf,
                                           pmix_op_cbfunc_t cbfunc, void *cbdata);
 
+PMIX_EXPORT pmix_status_t pmix_server_log_batch(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                                pmix_modex_cbfunc_t cbfunc, void *cbdata);
+
 PMIX_EXPORT pmix_status_t pmix_server_alloc(pmix_peer_t *peer, pmix_buffer_t *buf,
                                             pmix_info_cbfunc_t cbfunc, void *cbdata);
 
@@ -341,6 +571,8 @@ PMIX_EXPORT void pmix_server_message_handler(struct pmix_peer_t *pr, pmix_ptl_hd
 
 PMIX_EXPORT void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc);
 
+PMIX_EXPORT void pmix_server_purge_finalized(pmix_peer_t *peer);
+
 PMIX_EXPORT pmix_status_t pmix_server_fabric_register(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
                                                       pmix_info_cbfunc_t cbfunc);
 
@@ -360,8 +592,7 @@ PMIX_EXPORT pmix_status_t pmix_server_device_dists(pmix_server_caddy_t *cd,
                                                    pmix_device_dist_cbfunc_t cbfunc);
 
 PMIX_EXPORT pmix_status_t pmix_server_refresh_cache(pmix_server_caddy_t *cd,
-                                                    pmix_buffer_t *buf,
-                                                    pmix_op_cbfunc_t cbfunc);
+                                                    pmix_buffer_t *buf);
 
 PMIX_EXPORT void pmix_server_query_cbfunc(pmix_status_t status,
                                           pmix_info_t *info, size_t ninfo, void *cbdata,
@@ -0,0 +1,958 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#include <time.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* A node-local copy of the data published through us, plus the
+ * answers the host gave to lookups from our clients. Repeat lookups
+ * of the same keys are then answered without an upcall to the host,
+ * whose data server is frequently on another node. Only accessed
+ * from the progress thread */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_pdata_t pdata;
+    uint32_t uid;
+    pmix_data_range_t range;
+    pmix_persistence_t persistence;
+    /* answers from the host were found relative to the requestor,
+     * so only reuse them for lookups from the same nspace using
+     * the same range - and only for a while as the data may
+     * be unpublished elsewhere */
+    bool learned;
+    pmix_nspace_t nspace;
+    time_t expires;
+} pmix_pubsub_entry_t;
+static void pscon(pmix_pubsub_entry_t *p)
+{
+    PMIX_PDATA_CONSTRUCT(&p->pdata);
+    p->uid = 0;
+    p->range = PMIX_RANGE_SESSION;
+    p->persistence = PMIX_PERSIST_SESSION;
+    p->learned = false;
+    memset(p->nspace, 0, sizeof(pmix_nspace_t));
+    p->expires = 0;
+}
+static void psdes(pmix_pubsub_entry_t *p)
+{
+    PMIX_PDATA_DESTRUCT(&p->pdata);
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_entry_t, pmix_list_item_t, pscon, psdes);
+
+/* caddy for shifting an answer from the host into the progress thread */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_proc_t requestor;
+    uint32_t uid;
+    pmix_data_range_t range;
+    pmix_pdata_t *pdata;
+    size_t ndata;
+} pmix_pubsub_learn_t;
+static void plcon(pmix_pubsub_learn_t *p)
+{
+    p->pdata = NULL;
+    p->ndata = 0;
+}
+static void pldes(pmix_pubsub_learn_t *p)
+{
+    if (NULL != p->pdata) {
+        PMIX_PDATA_FREE(p->pdata, p->ndata);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_learn_t, pmix_object_t, plcon, pldes);
+
+/* a publish or lookup request parked with a batch or a wait tracker */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_setup_caddy_t *cd;
+} pmix_pubsub_req_t;
+static void prcon(pmix_pubsub_req_t *p)
+{
+    p->cd = NULL;
+}
+static void prdes(pmix_pubsub_req_t *p)
+{
+    if (NULL != p->cd) {
+        if (NULL != p->cd->keys) {
+            pmix_argv_free(p->cd->keys);
+        }
+        if (NULL != p->cd->info) {
+            PMIX_INFO_FREE(p->cd->info, p->cd->ninfo);
+        }
+        PMIX_RELEASE(p->cd);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_req_t, pmix_list_item_t, prcon, prdes);
+
+/* publishes from a proc that arrive while an earlier one from it
+ * is still with the host are passed up together once it completes.
+ * The host interface takes a single publisher per call, so this is
+ * as far as they can be combined */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_proc_t proc;
+    pmix_list_t pending;  // requests waiting for the next upcall
+    pmix_list_t inflight; // requests covered by the current upcall
+    pmix_info_t *info;    // combined info of the current upcall, if combined
+    size_t ninfo;
+    pmix_status_t status;
+} pmix_pubsub_batch_t;
+static void pbcon(pmix_pubsub_batch_t *p)
+{
+    PMIX_CONSTRUCT(&p->pending, pmix_list_t);
+    PMIX_CONSTRUCT(&p->inflight, pmix_list_t);
+    p->info = NULL;
+    p->ninfo = 0;
+    p->status = PMIX_SUCCESS;
+}
+static void pbdes(pmix_pubsub_batch_t *p)
+{
+    PMIX_LIST_DESTRUCT(&p->pending);
+    PMIX_LIST_DESTRUCT(&p->inflight);
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_batch_t, pmix_list_item_t, pbcon, pbdes);
+
+/* local lookups waiting (PMIX_WAIT) for the same keys under the
+ * same directives share a single lookup at the host. They are
+ * released by its answer, or earlier if one of our own clients
+ * publishes the data */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    bool active;
+    pmix_proc_t requestor; // rank only matters for proc-local range
+    char **keys;
+    pmix_info_t *info;
+    size_t ninfo;
+    uint32_t uid;
+    pmix_data_range_t range;
+    int wait;
+    int timeout;
+    pmix_list_t waiters;
+    pmix_status_t status;
+    pmix_pubsub_learn_t *answer;
+} pmix_pubsub_wait_t;
+static void pwcon(pmix_pubsub_wait_t *p)
+{
+    p->active = false;
+    p->keys = NULL;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->uid = 0;
+    p->range = PMIX_RANGE_SESSION;
+    p->wait = 0;
+    p->timeout = 0;
+    PMIX_CONSTRUCT(&p->waiters, pmix_list_t);
+    p->status = PMIX_SUCCESS;
+    p->answer = NULL;
+}
+static void pwdes(pmix_pubsub_wait_t *p)
+{
+    if (NULL != p->keys) {
+        pmix_argv_free(p->keys);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    PMIX_LIST_DESTRUCT(&p->waiters);
+    if (NULL != p->answer) {
+        PMIX_RELEASE(p->answer);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_wait_t, pmix_list_item_t, pwcon, pwdes);
+
+static pmix_list_t pubsub;
+static pmix_list_t batches;
+static pmix_list_t waits;
+
+static void wake_waiters(void);
+
+/* is the publisher within the given range of the requestor? */
+static bool in_range(const pmix_proc_t *publisher, const pmix_proc_t *requestor,
+                     pmix_data_range_t range)
+{
+    switch (range) {
+    case PMIX_RANGE_PROC_LOCAL:
+        return PMIX_CHECK_PROCID(publisher, requestor);
+    case PMIX_RANGE_NAMESPACE:
+        return PMIX_CHECK_NSPACE(publisher->nspace, requestor->nspace);
+    case PMIX_RANGE_CUSTOM:
+    case PMIX_RANGE_INVALID:
+        /* we cannot tell */
+        return false;
+    default:
+        /* everyone we serve is on this node */
+        return true;
+    }
+}
+
+static void get_directives(pmix_info_t info[], size_t ninfo, uint32_t *uid,
+                           pmix_data_range_t *range, pmix_persistence_t *persistence,
+                           bool *cacheable)
+{
+    size_t n;
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_USERID)) {
+            *uid = info[n].value.data.uint32;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_RANGE)) {
+            *range = info[n].value.data.range;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_PERSISTENCE)) {
+            if (NULL != persistence) {
+                *persistence = info[n].value.data.persist;
+            }
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_ACCESS_PERMISSIONS)
+                   || PMIX_CHECK_KEY(&info[n], PMIX_ACCESS_USERIDS)
+                   || PMIX_CHECK_KEY(&info[n], PMIX_ACCESS_GRPIDS)) {
+            /* only the host can enforce these */
+            *cacheable = false;
+        }
+    }
+}
+
+static bool is_directive(pmix_info_t *info)
+{
+    return (PMIX_CHECK_KEY(info, PMIX_USERID) || PMIX_CHECK_KEY(info, PMIX_GRPID)
+            || PMIX_CHECK_KEY(info, PMIX_RANGE) || PMIX_CHECK_KEY(info, PMIX_PERSISTENCE)
+            || PMIX_CHECK_KEY(info, PMIX_TIMEOUT));
+}
+
+void pmix_server_pubsub_publish(const pmix_proc_t *publisher, pmix_info_t info[], size_t ninfo)
+{
+    pmix_pubsub_entry_t *p, *pnext;
+    uint32_t uid = 0;
+    pmix_data_range_t range = PMIX_RANGE_SESSION;
+    pmix_persistence_t persistence = PMIX_PERSIST_SESSION;
+    bool cacheable = true;
+    size_t n;
+
+    if (!pmix_server_globals.pubsub_cache) {
+        return;
+    }
+    get_directives(info, ninfo, &uid, &range, &persistence, &cacheable);
+    /* data removed on first read has to be read from the host */
+    if (!cacheable || PMIX_PERSIST_FIRST_READ == persistence
+        || PMIX_PERSIST_INVALID == persistence || PMIX_RANGE_CUSTOM == range
+        || PMIX_RANGE_INVALID == range) {
+        return;
+    }
+
+    for (n = 0; n < ninfo; n++) {
+        if (is_directive(&info[n])) {
+            continue;
+        }
+        /* the new value replaces anything we had for this key */
+        PMIX_LIST_FOREACH_SAFE (p, pnext, &pubsub, pmix_pubsub_entry_t) {
+            if (PMIX_CHECK_KEY(&p->pdata, info[n].key)
+                && (p->learned || PMIX_CHECK_PROCID(&p->pdata.proc, publisher))) {
+                pmix_list_remove_item(&pubsub, &p->super);
+                PMIX_RELEASE(p);
+            }
+        }
+        p = PMIX_NEW(pmix_pubsub_entry_t);
+        PMIX_LOAD_PROCID(&p->pdata.proc, publisher->nspace, publisher->rank);
+        PMIX_LOAD_KEY(p->pdata.key, info[n].key);
+        PMIx_Value_xfer(&p->pdata.value, &info[n].value);
+        p->uid = uid;
+        p->range = range;
+        p->persistence = persistence;
+        pmix_list_append(&pubsub, &p->super);
+    }
+
+    /* someone here may be waiting for it */
+    wake_waiters();
+}
+
+void pmix_server_pubsub_unpublish(const pmix_proc_t *publisher, char **keys)
+{
+    pmix_pubsub_entry_t *p, *pnext;
+    size_t n;
+
+    PMIX_LIST_FOREACH_SAFE (p, pnext, &pubsub, pmix_pubsub_entry_t) {
+        if (NULL == keys) {
+            /* everything they published */
+            if (PMIX_CHECK_PROCID(&p->pdata.proc, publisher)) {
+                pmix_list_remove_item(&pubsub, &p->super);
+                PMIX_RELEASE(p);
+            }
+            continue;
+        }
+        for (n = 0; NULL != keys[n]; n++) {
+            if (PMIX_CHECK_KEY(&p->pdata, keys[n])
+                && (p->learned || PMIX_CHECK_PROCID(&p->pdata.proc, publisher))) {
+                pmix_list_remove_item(&pubsub, &p->super);
+                PMIX_RELEASE(p);
+                break;
+            }
+        }
+    }
+}
+
+static pmix_pubsub_entry_t *find(const pmix_proc_t *requestor, uint32_t uid,
+                                 pmix_data_range_t range, const char *key, time_t now)
+{
+    pmix_pubsub_entry_t *p;
+
+    PMIX_LIST_FOREACH (p, &pubsub, pmix_pubsub_entry_t) {
+        if (!PMIX_CHECK_KEY(&p->pdata, key) || p->uid != uid) {
+            continue;
+        }
+        if (p->learned) {
+            if (p->range == range && now < p->expires
+                && PMIX_CHECK_NSPACE(p->nspace, requestor->nspace)) {
+                return p;
+            }
+        } else if (in_range(&p->pdata.proc, requestor, p->range)
+                   && in_range(&p->pdata.proc, requestor, range)) {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+bool pmix_server_pubsub_lookup(const pmix_proc_t *requestor, char **keys, pmix_info_t info[],
+                               size_t ninfo, pmix_pdata_t **pdata, size_t *ndata)
+{
+    pmix_pubsub_entry_t **found;
+    uint32_t uid = 0;
+    pmix_data_range_t range = PMIX_RANGE_SESSION;
+    bool cacheable = true;
+    time_t now;
+    size_t n, nkeys;
+
+    *pdata = NULL;
+    *ndata = 0;
+    if (!pmix_server_globals.pubsub_cache || 0 == pmix_list_get_size(&pubsub)) {
+        return false;
+    }
+    get_directives(info, ninfo, &uid, &range, NULL, &cacheable);
+    nkeys = pmix_argv_count(keys);
+    if (!cacheable || 0 == nkeys) {
+        return false;
+    }
+
+    /* we only answer if we have all of them - otherwise the
+     * host has to be asked anyway */
+    found = (pmix_pubsub_entry_t **) malloc(nkeys * sizeof(pmix_pubsub_entry_t *));
+    if (NULL == found) {
+        return false;
+    }
+    now = time(NULL);
+    for (n = 0; n < nkeys; n++) {
+        if (NULL == (found[n] = find(requestor, uid, range, keys[n], now))) {
+            free(found);
+            return false;
+        }
+    }
+
+    PMIX_PDATA_CREATE(*pdata, nkeys);
+    if (NULL == *pdata) {
+        free(found);
+        return false;
+    }
+    for (n = 0; n < nkeys; n++) {
+        PMIX_PDATA_XFER(&(*pdata)[n], &found[n]->pdata);
+    }
+    *ndata = nkeys;
+    free(found);
+    pmix_output_verbose(2, pmix_server_globals.pub_output,
+                        "pmix:server lookup of %lu keys for %s answered locally",
+                        (unsigned long) nkeys, PMIX_NAME_PRINT(requestor));
+    return true;
+}
+
+static void remember(pmix_pubsub_learn_t *lk)
+{
+    pmix_pubsub_entry_t *p, *pnext;
+    time_t expires;
+    size_t n;
+
+    expires = time(NULL) + pmix_server_globals.pubsub_cache_lifetime;
+    for (n = 0; n < lk->ndata; n++) {
+        PMIX_LIST_FOREACH_SAFE (p, pnext, &pubsub, pmix_pubsub_entry_t) {
+            if (p->learned && p->uid == lk->uid && p->range == lk->range
+                && PMIX_CHECK_KEY(&p->pdata, lk->pdata[n].key)
+                && PMIX_CHECK_NSPACE(p->nspace, lk->requestor.nspace)) {
+                pmix_list_remove_item(&pubsub, &p->super);
+                PMIX_RELEASE(p);
+            }
+        }
+        p = PMIX_NEW(pmix_pubsub_entry_t);
+        PMIX_PDATA_XFER(&p->pdata, &lk->pdata[n]);
+        p->uid = lk->uid;
+        p->range = lk->range;
+        p->learned = true;
+        PMIX_LOAD_NSPACE(p->nspace, lk->requestor.nspace);
+        p->expires = expires;
+        pmix_list_append(&pubsub, &p->super);
+    }
+}
+
+static void learn(int sd, short args, void *cbdata)
+{
+    pmix_pubsub_learn_t *lk = (pmix_pubsub_learn_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(lk);
+    remember(lk);
+    PMIX_RELEASE(lk);
+}
+
+/* may be called from any thread as it is given the results of
+ * the host's lookup function */
+void pmix_server_pubsub_learn(const pmix_proc_t *requestor, pmix_info_t info[], size_t ninfo,
+                              pmix_pdata_t pdata[], size_t ndata)
+{
+    pmix_pubsub_learn_t *lk;
+    bool cacheable = true;
+    size_t n;
+
+    if (!pmix_server_globals.pubsub_cache || 0 >= pmix_server_globals.pubsub_cache_lifetime
+        || 0 == ndata) {
+        return;
+    }
+    lk = PMIX_NEW(pmix_pubsub_learn_t);
+    if (NULL == lk) {
+        return;
+    }
+    lk->uid = 0;
+    lk->range = PMIX_RANGE_SESSION;
+    get_directives(info, ninfo, &lk->uid, &lk->range, NULL, &cacheable);
+    if (!cacheable || PMIX_RANGE_CUSTOM == lk->range || PMIX_RANGE_INVALID == lk->range) {
+        PMIX_RELEASE(lk);
+        return;
+    }
+    PMIX_LOAD_PROCID(&lk->requestor, requestor->nspace, requestor->rank);
+    PMIX_PDATA_CREATE(lk->pdata, ndata);
+    if (NULL == lk->pdata) {
+        PMIX_RELEASE(lk);
+        return;
+    }
+    lk->ndata = ndata;
+    for (n = 0; n < ndata; n++) {
+        PMIX_PDATA_XFER(&lk->pdata[n], &pdata[n]);
+    }
+    PMIX_THREADSHIFT(lk, learn);
+}
+
+void pmix_server_pubsub_purge(const pmix_proc_t *proc)
+{
+    pmix_pubsub_entry_t *p, *pnext;
+    bool job = (PMIX_RANK_WILDCARD == proc->rank);
+
+    PMIX_LIST_FOREACH_SAFE (p, pnext, &pubsub, pmix_pubsub_entry_t) {
+        if (p->learned) {
+            /* nobody is left to ask for these */
+            if (job && PMIX_CHECK_NSPACE(p->nspace, proc->nspace)) {
+                pmix_list_remove_item(&pubsub, &p->super);
+                PMIX_RELEASE(p);
+            }
+            continue;
+        }
+        if (!PMIX_CHECK_PROCID(&p->pdata.proc, proc)) {
+            continue;
+        }
+        if (PMIX_PERSIST_PROC == p->persistence
+            || (job && PMIX_PERSIST_APP == p->persistence)) {
+            pmix_list_remove_item(&pubsub, &p->super);
+            PMIX_RELEASE(p);
+        }
+    }
+}
+
+/****    PUBLISH BATCHING    ****/
+
+static void pub_complete(pmix_setup_caddy_t *cd, pmix_status_t status)
+{
+    if (NULL != cd->info) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+    }
+    if (NULL != cd->opcbfunc) {
+        cd->opcbfunc(status, cd->cbdata);
+    }
+    PMIX_RELEASE(cd);
+}
+
+static bool has_key(pmix_setup_caddy_t *cd, const char *key)
+{
+    size_t n;
+
+    for (n = 0; n < cd->ninfo; n++) {
+        if (!is_directive(&cd->info[n]) && PMIX_CHECK_KEY(&cd->info[n], key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* can the data in cd go up in the same call as that of the
+ * requests already in the batch? */
+static bool compatible(pmix_pubsub_batch_t *batch, pmix_setup_caddy_t *cd)
+{
+    pmix_pubsub_req_t *req, *head;
+    uint32_t uid1 = 0, uid2 = 0;
+    pmix_data_range_t range1 = PMIX_RANGE_SESSION, range2 = PMIX_RANGE_SESSION;
+    pmix_persistence_t pers1 = PMIX_PERSIST_SESSION, pers2 = PMIX_PERSIST_SESSION;
+    bool ok1 = true, ok2 = true;
+    size_t n;
+
+    head = (pmix_pubsub_req_t *) pmix_list_get_first(&batch->inflight);
+    get_directives(head->cd->info, head->cd->ninfo, &uid1, &range1, &pers1, &ok1);
+    get_directives(cd->info, cd->ninfo, &uid2, &range2, &pers2, &ok2);
+    /* access restrictions are passed through as given */
+    if (!ok1 || !ok2 || uid1 != uid2 || range1 != range2 || pers1 != pers2) {
+        return false;
+    }
+    /* a key published twice must reach the host in order */
+    for (n = 0; n < cd->ninfo; n++) {
+        if (is_directive(&cd->info[n])) {
+            continue;
+        }
+        PMIX_LIST_FOREACH (req, &batch->inflight, pmix_pubsub_req_t) {
+            if (has_key(req->cd, cd->info[n].key)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void pub_next(pmix_pubsub_batch_t *batch);
+
+static void pub_done(pmix_pubsub_batch_t *batch, pmix_status_t status)
+{
+    pmix_pubsub_req_t *req;
+
+    if (NULL != batch->info) {
+        PMIX_INFO_FREE(batch->info, batch->ninfo);
+        batch->info = NULL;
+        batch->ninfo = 0;
+    }
+    while (NULL != (req = (pmix_pubsub_req_t *) pmix_list_remove_first(&batch->inflight))) {
+        /* only keep what the host accepted */
+        if (PMIX_SUCCESS == status) {
+            pmix_server_pubsub_publish(&batch->proc, req->cd->info, req->cd->ninfo);
+        }
+        pub_complete(req->cd, status);
+        req->cd = NULL;
+        PMIX_RELEASE(req);
+    }
+    pub_next(batch);
+}
+
+static void pubshift(int sd, short args, void *cbdata)
+{
+    pmix_pubsub_batch_t *batch = (pmix_pubsub_batch_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(batch);
+    pub_done(batch, batch->status);
+    /* release the reference held by the host */
+    PMIX_RELEASE(batch);
+}
+
+static void pubcbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_pubsub_batch_t *batch = (pmix_pubsub_batch_t *) cbdata;
+
+    batch->status = status;
+    PMIX_THREADSHIFT(batch, pubshift);
+}
+
+static void pub_next(pmix_pubsub_batch_t *batch)
+{
+    pmix_pubsub_req_t *req, *rnext, *head;
+    pmix_info_t *info;
+    size_t ninfo, n, m, nreqs;
+    pmix_status_t rc;
+
+    if (0 == pmix_list_get_size(&batch->pending)) {
+        /* nothing more from this proc */
+        pmix_list_remove_item(&batches, &batch->super);
+        PMIX_RELEASE(batch);
+        return;
+    }
+
+    /* take everything that can go up together with the oldest */
+    head = (pmix_pubsub_req_t *) pmix_list_remove_first(&batch->pending);
+    pmix_list_append(&batch->inflight, &head->super);
+    ninfo = head->cd->ninfo;
+    PMIX_LIST_FOREACH_SAFE (req, rnext, &batch->pending, pmix_pubsub_req_t) {
+        if (!compatible(batch, req->cd)) {
+            /* leave the rest for the next round so
+             * that they reach the host in order */
+            break;
+        }
+        pmix_list_remove_item(&batch->pending, &req->super);
+        pmix_list_append(&batch->inflight, &req->super);
+        for (n = 0; n < req->cd->ninfo; n++) {
+            if (!is_directive(&req->cd->info[n])) {
+                ++ninfo;
+            }
+        }
+    }
+
+    nreqs = pmix_list_get_size(&batch->inflight);
+    if (1 == nreqs) {
+        info = head->cd->info;
+        ninfo = head->cd->ninfo;
+    } else {
+        /* the directives of the first, the data of all */
+        PMIX_INFO_CREATE(batch->info, ninfo);
+        if (NULL == batch->info) {
+            pub_done(batch, PMIX_ERR_NOMEM);
+            return;
+        }
+        batch->ninfo = ninfo;
+        m = 0;
+        PMIX_LIST_FOREACH (req, &batch->inflight, pmix_pubsub_req_t) {
+            for (n = 0; n < req->cd->ninfo; n++) {
+                if (req == head || !is_directive(&req->cd->info[n])) {
+                    PMIX_INFO_XFER(&batch->info[m], &req->cd->info[n]);
+                    ++m;
+                }
+            }
+        }
+        info = batch->info;
+        pmix_output_verbose(2, pmix_server_globals.pub_output,
+                            "pmix:server passing %lu publish requests from %s up together",
+                            (unsigned long) nreqs, PMIX_NAME_PRINT(&batch->proc));
+    }
+
+    PMIX_RETAIN(batch);
+    rc = pmix_host_server.publish(&batch->proc, info, ninfo, pubcbfunc, batch);
+    if (PMIX_SUCCESS == rc) {
+        /* the rest waits for the host to respond */
+        return;
+    }
+    PMIX_RELEASE(batch);
+    if (PMIX_OPERATION_SUCCEEDED == rc) {
+        rc = PMIX_SUCCESS;
+    }
+    /* completes the inflight requests and moves on */
+    pub_done(batch, rc);
+}
+
+static void pubsingle(int sd, short args, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    /* only keep what the host accepted */
+    if (PMIX_SUCCESS == cd->status) {
+        pmix_server_pubsub_publish(&cd->proc, cd->info, cd->ninfo);
+    }
+    pub_complete(cd, cd->status);
+}
+
+static void pubsinglecb(pmix_status_t status, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
+
+    cd->status = status;
+    PMIX_THREADSHIFT(cd, pubsingle);
+}
+
+pmix_status_t pmix_server_pubsub_submit(pmix_setup_caddy_t *cd)
+{
+    pmix_pubsub_batch_t *batch;
+    pmix_pubsub_req_t *req;
+    pmix_status_t rc;
+
+    if (!pmix_server_globals.pubsub_coalesce) {
+        rc = pmix_host_server.publish(&cd->proc, cd->info, cd->ninfo, pubsinglecb, cd);
+        if (PMIX_OPERATION_SUCCEEDED == rc) {
+            pmix_server_pubsub_publish(&cd->proc, cd->info, cd->ninfo);
+        }
+        return rc;
+    }
+
+    req = PMIX_NEW(pmix_pubsub_req_t);
+    if (NULL == req) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LIST_FOREACH (batch, &batches, pmix_pubsub_batch_t) {
+        if (PMIX_CHECK_PROCID(&batch->proc, &cd->proc)) {
+            /* an earlier request of theirs is with the host */
+            req->cd = cd;
+            pmix_list_append(&batch->pending, &req->super);
+            return PMIX_SUCCESS;
+        }
+    }
+    batch = PMIX_NEW(pmix_pubsub_batch_t);
+    if (NULL == batch) {
+        PMIX_RELEASE(req);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LOAD_PROCID(&batch->proc, cd->proc.nspace, cd->proc.rank);
+    req->cd = cd;
+    pmix_list_append(&batch->pending, &req->super);
+    pmix_list_append(&batches, &batch->super);
+    pub_next(batch);
+    return PMIX_SUCCESS;
+}
+/****    SHARED WAITING LOOKUPS    ****/
+
+static void get_wait(pmix_info_t info[], size_t ninfo, bool *wait, int *nwait, int *timeout)
+{
+    size_t n;
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_WAIT)) {
+            *wait = true;
+            *nwait = info[n].value.data.integer;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
+            *timeout = info[n].value.data.integer;
+        }
+    }
+}
+
+static void lookup_complete(pmix_pubsub_req_t *req, pmix_status_t status, pmix_pdata_t *pdata,
+                            size_t ndata)
+{
+    if (NULL != req->cd->lkcbfunc) {
+        req->cd->lkcbfunc(status, pdata, ndata, req->cd->cbdata);
+    }
+    PMIX_RELEASE(req);
+}
+
+/* answer whichever waiters can now be served from our copy */
+static void wake_waiters(void)
+{
+    pmix_pubsub_wait_t *trk, *tnext;
+    pmix_pubsub_req_t *req, *rnext;
+    pmix_pdata_t *pdata;
+    size_t ndata;
+
+    PMIX_LIST_FOREACH_SAFE (trk, tnext, &waits, pmix_pubsub_wait_t) {
+        PMIX_LIST_FOREACH_SAFE (req, rnext, &trk->waiters, pmix_pubsub_req_t) {
+            if (pmix_server_pubsub_lookup(&req->cd->proc, req->cd->keys, req->cd->info,
+                                          req->cd->ninfo, &pdata, &ndata)) {
+                pmix_list_remove_item(&trk->waiters, &req->super);
+                lookup_complete(req, PMIX_SUCCESS, pdata, ndata);
+                PMIX_PDATA_FREE(pdata, ndata);
+            }
+        }
+        if (0 == pmix_list_get_size(&trk->waiters)) {
+            /* the host will still answer - we just
+             * no longer have anyone to give it to */
+            trk->active = false;
+            pmix_list_remove_item(&waits, &trk->super);
+            PMIX_RELEASE(trk);
+        }
+    }
+}
+
+static void waitshift(int sd, short args, void *cbdata)
+{
+    pmix_pubsub_wait_t *trk = (pmix_pubsub_wait_t *) cbdata;
+    pmix_pubsub_req_t *req;
+    pmix_pdata_t *pdata = NULL;
+    size_t ndata = 0;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(trk);
+
+    if (NULL != trk->answer) {
+        pdata = trk->answer->pdata;
+        ndata = trk->answer->ndata;
+        if (PMIX_SUCCESS == trk->status && pmix_server_globals.pubsub_cache
+            && 0 < pmix_server_globals.pubsub_cache_lifetime) {
+            remember(trk->answer);
+        }
+    }
+    if (trk->active) {
+        trk->active = false;
+        pmix_list_remove_item(&waits, &trk->super);
+        pmix_output_verbose(2, pmix_server_globals.pub_output,
+                            "pmix:server waiting lookup answered for %lu local requests",
+                            (unsigned long) pmix_list_get_size(&trk->waiters));
+        while (NULL != (req = (pmix_pubsub_req_t *) pmix_list_remove_first(&trk->waiters))) {
+            lookup_complete(req, trk->status, pdata, ndata);
+        }
+        /* release the list's reference */
+        PMIX_RELEASE(trk);
+    }
+    /* release the host's reference */
+    PMIX_RELEASE(trk);
+}
+
+static void waitcbfunc(pmix_status_t status, pmix_pdata_t data[], size_t ndata, void *cbdata)
+{
+    pmix_pubsub_wait_t *trk = (pmix_pubsub_wait_t *) cbdata;
+    bool cacheable = true;
+    size_t n;
+
+    /* the data is only valid until we return */
+    trk->status = status;
+    if (PMIX_SUCCESS == status && 0 < ndata) {
+        trk->answer = PMIX_NEW(pmix_pubsub_learn_t);
+        if (NULL != trk->answer) {
+            PMIX_LOAD_PROCID(&trk->answer->requestor, trk->requestor.nspace,
+                             trk->requestor.rank);
+            trk->answer->uid = 0;
+            trk->answer->range = PMIX_RANGE_SESSION;
+            get_directives(trk->info, trk->ninfo, &trk->answer->uid, &trk->answer->range, NULL,
+                           &cacheable);
+            PMIX_PDATA_CREATE(trk->answer->pdata, ndata);
+            if (NULL == trk->answer->pdata) {
+                PMIX_RELEASE(trk->answer);
+                trk->answer = NULL;
+                trk->status = PMIX_ERR_NOMEM;
+            } else {
+                trk->answer->ndata = ndata;
+                for (n = 0; n < ndata; n++) {
+                    PMIX_PDATA_XFER(&trk->answer->pdata[n], &data[n]);
+                }
+            }
+        } else {
+            trk->status = PMIX_ERR_NOMEM;
+        }
+    }
+    PMIX_THREADSHIFT(trk, waitshift);
+}
+
+static bool same_wait(pmix_pubsub_wait_t *trk, pmix_setup_caddy_t *cd, uint32_t uid,
+                      pmix_data_range_t range, int nwait, int timeout)
+{
+    size_t n;
+
+    if (trk->uid != uid || trk->range != range || trk->wait != nwait
+        || trk->timeout != timeout || !PMIX_CHECK_NSPACE(trk->requestor.nspace, cd->proc.nspace)
+        || (PMIX_RANGE_PROC_LOCAL == range && trk->requestor.rank != cd->proc.rank)) {
+        return false;
+    }
+    if (pmix_argv_count(trk->keys) != pmix_argv_count(cd->keys)) {
+        return false;
+    }
+    for (n = 0; NULL != cd->keys[n]; n++) {
+        if (0 != strcmp(trk->keys[n], cd->keys[n])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool pmix_server_pubsub_wait(pmix_setup_caddy_t *cd, pmix_status_t *rc)
+{
+    pmix_pubsub_wait_t *trk;
+    pmix_pubsub_req_t *req;
+    uint32_t uid = 0;
+    pmix_data_range_t range = PMIX_RANGE_SESSION;
+    bool cacheable = true, wait = false;
+    int nwait = 0, timeout = 0;
+    size_t n;
+
+    if (!pmix_server_globals.pubsub_coalesce || NULL == cd->keys) {
+        return false;
+    }
+    get_wait(cd->info, cd->ninfo, &wait, &nwait, &timeout);
+    if (!wait) {
+        return false;
+    }
+    get_directives(cd->info, cd->ninfo, &uid, &range, NULL, &cacheable);
+    if (!cacheable || PMIX_RANGE_CUSTOM == range || PMIX_RANGE_INVALID == range) {
+        return false;
+    }
+
+    req = PMIX_NEW(pmix_pubsub_req_t);
+    if (NULL == req) {
+        *rc = PMIX_ERR_NOMEM;
+        return true;
+    }
+    PMIX_LIST_FOREACH (trk, &waits, pmix_pubsub_wait_t) {
+        if (same_wait(trk, cd, uid, range, nwait, timeout)) {
+            /* someone is already waiting for this */
+            req->cd = cd;
+            pmix_list_append(&trk->waiters, &req->super);
+            pmix_output_verbose(2, pmix_server_globals.pub_output,
+                                "pmix:server lookup for %s joins a waiting one",
+                                PMIX_NAME_PRINT(&cd->proc));
+            *rc = PMIX_SUCCESS;
+            return true;
+        }
+    }
+
+    /* ask the host on behalf of everyone who will want this */
+    trk = PMIX_NEW(pmix_pubsub_wait_t);
+    if (NULL == trk) {
+        PMIX_RELEASE(req);
+        *rc = PMIX_ERR_NOMEM;
+        return true;
+    }
+    PMIX_LOAD_PROCID(&trk->requestor, cd->proc.nspace, cd->proc.rank);
+    trk->keys = pmix_argv_copy(cd->keys);
+    PMIX_INFO_CREATE(trk->info, cd->ninfo);
+    if (NULL == trk->keys || NULL == trk->info) {
+        PMIX_RELEASE(req);
+        PMIX_RELEASE(trk);
+        *rc = PMIX_ERR_NOMEM;
+        return true;
+    }
+    trk->ninfo = cd->ninfo;
+    for (n = 0; n < cd->ninfo; n++) {
+        PMIX_INFO_XFER(&trk->info[n], &cd->info[n]);
+    }
+    trk->uid = uid;
+    trk->range = range;
+    trk->wait = nwait;
+    trk->timeout = timeout;
+
+    PMIX_RETAIN(trk);
+    *rc = pmix_host_server.lookup(&trk->requestor, trk->keys, trk->info, trk->ninfo, waitcbfunc,
+                                  trk);
+    if (PMIX_SUCCESS != *rc) {
+        /* the caller still owns the request */
+        PMIX_RELEASE(req);
+        PMIX_RELEASE(trk);
+        PMIX_RELEASE(trk);
+        return true;
+    }
+    req->cd = cd;
+    pmix_list_append(&trk->waiters, &req->super);
+    trk->active = true;
+    pmix_list_append(&waits, &trk->super);
+    return true;
+}
+
+void pmix_server_pubsub_init(void)
+{
+    PMIX_CONSTRUCT(&pubsub, pmix_list_t);
+    PMIX_CONSTRUCT(&batches, pmix_list_t);
+    PMIX_CONSTRUCT(&waits, pmix_list_t);
+}
+
+void pmix_server_pubsub_finalize(void)
+{
+    PMIX_LIST_DESTRUCT(&waits);
+    PMIX_LIST_DESTRUCT(&batches);
+    PMIX_LIST_DESTRUCT(&pubsub);
+}
@@ -0,0 +1,394 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#include <time.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* Queries from local clients are answered by the server on their
+ * behalf, so the answer does not depend on which client asked.
+ * Identical queries that arrive while one is being resolved share
+ * its answer, and the answers to queries whose keys are listed in
+ * pmix_server_query_cache_keys are kept for a while. Both are keyed
+ * by the packed form of the queries. Only accessed from the
+ * progress thread */
+
+/* a client query parked until the shared one completes */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_query_caddy_t *cd;
+} pmix_server_query_req_t;
+static void qrcon(pmix_server_query_req_t *p)
+{
+    p->cd = NULL;
+}
+static void qrdes(pmix_server_query_req_t *p)
+{
+    if (NULL != p->cd) {
+        PMIX_RELEASE(p->cd);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_server_query_req_t, pmix_list_item_t, qrcon, qrdes);
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_byte_object_t sig;
+    bool cacheable;
+    /* a query being resolved */
+    pmix_list_t waiters;
+    /* the answer */
+    pmix_status_t status;
+    pmix_info_t *info;
+    size_t ninfo;
+    time_t expires;
+} pmix_server_query_trk_t;
+static void qtcon(pmix_server_query_trk_t *p)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->sig);
+    p->cacheable = false;
+    PMIX_CONSTRUCT(&p->waiters, pmix_list_t);
+    p->status = PMIX_SUCCESS;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->expires = 0;
+}
+static void qtdes(pmix_server_query_trk_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->sig);
+    PMIX_LIST_DESTRUCT(&p->waiters);
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_server_query_trk_t, pmix_list_item_t, qtcon, qtdes);
+
+static pmix_list_t inflight;
+static pmix_list_t cached;
+static char **cache_keys = NULL;
+
+static bool wants_refresh(pmix_query_t *queries, size_t nqueries)
+{
+    size_t n, m;
+
+    for (n = 0; n < nqueries; n++) {
+        for (m = 0; m < queries[n].nqual; m++) {
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[m], PMIX_QUERY_REFRESH_CACHE)
+                && PMIX_INFO_TRUE(&queries[n].qualifiers[m])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* the host may return an answer in batches - requestors that
+ * asked for PMIX_QUERY_STREAM get each of them as it comes, which
+ * rules out sharing the answer with anyone else */
+bool pmix_server_query_streamed(pmix_query_t *queries, size_t nqueries)
+{
+    size_t n, m;
+
+    for (n = 0; n < nqueries; n++) {
+        for (m = 0; m < queries[n].nqual; m++) {
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[m], PMIX_QUERY_STREAM)
+                && PMIX_INFO_TRUE(&queries[n].qualifiers[m])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* the max number of array elements per message of a streamed
+ * answer - zero if the answer is not streamed or not to be split */
+size_t pmix_server_query_chunk(pmix_query_t *queries, size_t nqueries)
+{
+    size_t n, m;
+    uint32_t chunk;
+    pmix_status_t rc;
+
+    if (!pmix_server_query_streamed(queries, nqueries)) {
+        return 0;
+    }
+    for (n = 0; n < nqueries; n++) {
+        for (m = 0; m < queries[n].nqual; m++) {
+            if (PMIX_CHECK_KEY(&queries[n].qualifiers[m], PMIX_QUERY_STREAM_CHUNK)) {
+                PMIX_VALUE_GET_NUMBER(rc, &queries[n].qualifiers[m].value, chunk, uint32_t);
+                if (PMIX_SUCCESS == rc) {
+                    return chunk;
+                }
+            }
+        }
+    }
+    if (0 > pmix_server_globals.query_stream_chunk) {
+        return 0;
+    }
+    return pmix_server_globals.query_stream_chunk;
+}
+
+/* add a batch of results to those already held */
+pmix_status_t pmix_server_query_append(pmix_info_t **info, size_t *ninfo, pmix_info_t *add,
+                                       size_t nadd)
+{
+    pmix_info_t *tmp;
+    size_t n;
+
+    if (0 == nadd) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_INFO_CREATE(tmp, *ninfo + nadd);
+    if (NULL == tmp) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < *ninfo; n++) {
+        PMIX_INFO_XFER(&tmp[n], &(*info)[n]);
+    }
+    for (n = 0; n < nadd; n++) {
+        PMIX_INFO_XFER(&tmp[*ninfo + n], &add[n]);
+    }
+    if (NULL != *info) {
+        PMIX_INFO_FREE(*info, *ninfo);
+    }
+    *info = tmp;
+    *ninfo += nadd;
+    return PMIX_SUCCESS;
+}
+
+static bool is_cache_key(const char *key)
+{
+    size_t n;
+
+    for (n = 0; NULL != cache_keys[n]; n++) {
+        if (0 == strcmp(cache_keys[n], key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_cacheable(pmix_query_t *queries, size_t nqueries)
+{
+    size_t n, m;
+
+    if (NULL == cache_keys || 0 >= pmix_server_globals.query_cache_lifetime) {
+        return false;
+    }
+    for (n = 0; n < nqueries; n++) {
+        if (NULL == queries[n].keys) {
+            return false;
+        }
+        for (m = 0; NULL != queries[n].keys[m]; m++) {
+            if (!is_cache_key(queries[n].keys[m])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool get_sig(pmix_query_t *queries, size_t nqueries, pmix_byte_object_t *sig)
+{
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &buf, queries, nqueries, PMIX_QUERY);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&buf);
+        return false;
+    }
+    PMIX_UNLOAD_BUFFER(&buf, sig->bytes, sig->size);
+    PMIX_DESTRUCT(&buf);
+    return true;
+}
+
+static pmix_server_query_trk_t *find(pmix_list_t *list, pmix_byte_object_t *sig)
+{
+    pmix_server_query_trk_t *trk;
+
+    PMIX_LIST_FOREACH (trk, list, pmix_server_query_trk_t) {
+        if (trk->sig.size == sig->size && 0 == memcmp(trk->sig.bytes, sig->bytes, sig->size)) {
+            return trk;
+        }
+    }
+    return NULL;
+}
+
+static void reply(pmix_query_caddy_t *cd, pmix_status_t status, pmix_info_t *info,
+                  size_t ninfo)
+{
+    /* the callback releases the caddy - the info stays with us */
+    if (NULL != cd->cbfunc) {
+        cd->cbfunc(status, info, ninfo, cd, NULL, NULL);
+    } else {
+        PMIX_RELEASE(cd);
+    }
+}
+
+static void answer(int sd, short args, void *cbdata)
+{
+    pmix_server_query_trk_t *trk = (pmix_server_query_trk_t *) cbdata;
+    pmix_server_query_req_t *req;
+    pmix_query_caddy_t *cd;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(trk);
+
+    pmix_list_remove_item(&inflight, &trk->super);
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server query answered for %lu local requests",
+                        (unsigned long) pmix_list_get_size(&trk->waiters));
+    while (NULL != (req = (pmix_server_query_req_t *) pmix_list_remove_first(&trk->waiters))) {
+        cd = req->cd;
+        req->cd = NULL;
+        PMIX_RELEASE(req);
+        reply(cd, trk->status, trk->info, trk->ninfo);
+    }
+
+    if (trk->cacheable && PMIX_SUCCESS == trk->status) {
+        trk->expires = time(NULL) + pmix_server_globals.query_cache_lifetime;
+        pmix_list_append(&cached, &trk->super);
+        return;
+    }
+    PMIX_RELEASE(trk);
+}
+
+/* may be called from any thread */
+static void qcbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo, void *cbdata,
+                    pmix_release_cbfunc_t release_fn, void *release_cbdata)
+{
+    pmix_server_query_trk_t *trk = (pmix_server_query_trk_t *) cbdata;
+    pmix_status_t rc;
+
+    /* batches of a partial answer are held until the last one */
+    rc = pmix_server_query_append(&trk->info, &trk->ninfo, info, ninfo);
+    if (PMIX_QUERY_PARTIAL_SUCCESS != status) {
+        trk->status = (PMIX_SUCCESS == rc) ? status : rc;
+    } else if (PMIX_SUCCESS != rc) {
+        trk->status = rc;
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    if (PMIX_QUERY_PARTIAL_SUCCESS != status) {
+        PMIX_THREADSHIFT(trk, answer);
+    }
+}
+
+pmix_status_t pmix_server_query_submit(pmix_query_caddy_t *cd)
+{
+    pmix_server_query_trk_t *trk;
+    pmix_server_query_req_t *req;
+    pmix_byte_object_t sig;
+    pmix_status_t rc;
+    time_t now;
+
+    if (!pmix_server_globals.query_coalesce
+        || wants_refresh(cd->queries, cd->nqueries)
+        || pmix_server_query_streamed(cd->queries, cd->nqueries)
+        || !get_sig(cd->queries, cd->nqueries, &sig)) {
+        /* let the query function handle it */
+        return PMIx_Query_info_nb(cd->queries, cd->nqueries, cd->cbfunc, cd);
+    }
+
+    /* do we have a recent answer? */
+    if (NULL != (trk = find(&cached, &sig))) {
+        now = time(NULL);
+        if (now < trk->expires) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&sig);
+            pmix_output_verbose(2, pmix_server_globals.base_output,
+                                "pmix:server query answered from cache");
+            reply(cd, trk->status, trk->info, trk->ninfo);
+            return PMIX_SUCCESS;
+        }
+        pmix_list_remove_item(&cached, &trk->super);
+        PMIX_RELEASE(trk);
+    }
+
+    req = PMIX_NEW(pmix_server_query_req_t);
+    if (NULL == req) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&sig);
+        return PMIX_ERR_NOMEM;
+    }
+
+    /* is someone already asking? */
+    if (NULL != (trk = find(&inflight, &sig))) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&sig);
+        req->cd = cd;
+        pmix_list_append(&trk->waiters, &req->super);
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server query joins an identical one in progress");
+        return PMIX_SUCCESS;
+    }
+
+    trk = PMIX_NEW(pmix_server_query_trk_t);
+    if (NULL == trk) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&sig);
+        PMIX_RELEASE(req);
+        return PMIX_ERR_NOMEM;
+    }
+    trk->sig.bytes = sig.bytes;
+    trk->sig.size = sig.size;
+    trk->cacheable = is_cacheable(cd->queries, cd->nqueries);
+    /* the queries of the first requestor are used for all */
+    rc = PMIx_Query_info_nb(cd->queries, cd->nqueries, qcbfunc, trk);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(req);
+        PMIX_RELEASE(trk);
+        return rc;
+    }
+    req->cd = cd;
+    pmix_list_append(&trk->waiters, &req->super);
+    pmix_list_append(&inflight, &trk->super);
+    return PMIX_SUCCESS;
+}
+
+void pmix_server_query_flush(void)
+{
+    pmix_server_query_trk_t *trk;
+
+    while (NULL != (trk = (pmix_server_query_trk_t *) pmix_list_remove_first(&cached))) {
+        PMIX_RELEASE(trk);
+    }
+}
+
+void pmix_server_query_init(void)
+{
+    PMIX_CONSTRUCT(&inflight, pmix_list_t);
+    PMIX_CONSTRUCT(&cached, pmix_list_t);
+    if (NULL != pmix_server_globals.query_cache_keys) {
+        cache_keys = pmix_argv_split(pmix_server_globals.query_cache_keys, ',');
+    }
+}
+
+void pmix_server_query_finalize(void)
+{
+    PMIX_LIST_DESTRUCT(&cached);
+    PMIX_LIST_DESTRUCT(&inflight);
+    if (NULL != cache_keys) {
+        pmix_argv_free(cache_keys);
+        cache_keys = NULL;
+    }
+}
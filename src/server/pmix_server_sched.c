@@ -0,0 +1,243 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/ptl/base/base.h"
+#include "src/util/pmix_name_fns.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* Inbound commands are put in one of three classes. Collectives,
+ * gets, commits and anything not listed below are handled as soon
+ * as they arrive. Event traffic and the bulk requests - queries,
+ * logs, IOF and monitoring, mostly from tools - wait in a queue per
+ * class that is drained from a zero-delay timer, so every socket
+ * that became readable in the meantime is serviced first. Each pass
+ * takes at most the configured weight of messages from each queue.
+ * The messages of a peer are never reordered: while any of them are
+ * waiting, later ones join the same queue regardless of class. A
+ * tool that already has its limit of messages waiting in a class is
+ * told to back off with PMIX_ERR_OUT_OF_RESOURCE. Only accessed
+ * from the progress thread */
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_peer_t *peer;
+    uint32_t tag;
+    pmix_buffer_t buf;
+    char *data;
+    size_t ndata;
+} pmix_server_msg_t;
+static void msgcon(pmix_server_msg_t *p)
+{
+    p->peer = NULL;
+    p->tag = 0;
+    PMIX_CONSTRUCT(&p->buf, pmix_buffer_t);
+    p->data = NULL;
+    p->ndata = 0;
+}
+static void msgdes(pmix_server_msg_t *p)
+{
+    PMIX_PTL_BUFPOOL_RECLAIM(&p->buf, p->data, p->ndata);
+    PMIX_DESTRUCT(&p->buf);
+    if (NULL != p->peer) {
+        PMIX_RELEASE(p->peer);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_server_msg_t, pmix_list_item_t, msgcon, msgdes);
+
+typedef struct {
+    pmix_event_t ev;
+    bool initialized;
+    bool active;
+    pmix_list_t queues[PMIX_SERVER_NCLASSES];
+    size_t ntool[PMIX_SERVER_NCLASSES];
+} pmix_server_sched_t;
+static pmix_server_sched_t sched = {.initialized = false, .active = false};
+
+static pmix_server_class_t classify(pmix_cmd_t cmd)
+{
+    switch (cmd) {
+    case PMIX_NOTIFY_CMD:
+    case PMIX_NOTIFY_BATCH_CMD:
+    case PMIX_REGEVENTS_CMD:
+    case PMIX_DEREGEVENTS_CMD:
+        return PMIX_SERVER_CLASS_EVENT;
+    case PMIX_QUERY_CMD:
+    case PMIX_LOG_CMD:
+    case PMIX_LOG_BATCH_CMD:
+    case PMIX_IOF_PULL_CMD:
+    case PMIX_IOF_PUSH_CMD:
+    case PMIX_IOF_DEREG_CMD:
+    case PMIX_MONITOR_CMD:
+        return PMIX_SERVER_CLASS_BULK;
+    default:
+        return PMIX_SERVER_CLASS_URGENT;
+    }
+}
+
+static void drain(int sd, short args, void *cbdata)
+{
+    pmix_server_msg_t *msg;
+    int c, n, weight;
+    bool more = false;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    sched.active = false;
+    for (c = PMIX_SERVER_CLASS_EVENT; c < PMIX_SERVER_NCLASSES; c++) {
+        weight = (PMIX_SERVER_CLASS_EVENT == c) ? pmix_server_globals.sched_event_weight
+                                                : pmix_server_globals.sched_bulk_weight;
+        if (1 > weight) {
+            weight = 1;
+        }
+        for (n = 0; n < weight; n++) {
+            msg = (pmix_server_msg_t *) pmix_list_remove_first(&sched.queues[c]);
+            if (NULL == msg) {
+                break;
+            }
+            --msg->peer->nqueued;
+            if (PMIX_PEER_IS_TOOL(msg->peer)) {
+                --sched.ntool[c];
+            }
+            pmix_server_dispatch(msg->peer, msg->tag, &msg->buf);
+            PMIX_RELEASE(msg);
+        }
+        if (!pmix_list_is_empty(&sched.queues[c])) {
+            more = true;
+        }
+    }
+    if (more) {
+        sched.active = true;
+        PMIX_THREADSHIFT_DELAY(&sched, drain, 0);
+    }
+}
+
+void pmix_server_sched_init(void)
+{
+    int c;
+
+    if (sched.initialized) {
+        return;
+    }
+    for (c = 0; c < PMIX_SERVER_NCLASSES; c++) {
+        PMIX_CONSTRUCT(&sched.queues[c], pmix_list_t);
+        sched.ntool[c] = 0;
+    }
+    sched.active = false;
+    sched.initialized = true;
+}
+
+void pmix_server_sched_finalize(void)
+{
+    pmix_server_msg_t *msg;
+    int c;
+
+    if (!sched.initialized) {
+        return;
+    }
+    if (sched.active) {
+        pmix_event_del(&sched.ev);
+        sched.active = false;
+    }
+    for (c = 0; c < PMIX_SERVER_NCLASSES; c++) {
+        PMIX_LIST_FOREACH (msg, &sched.queues[c], pmix_server_msg_t) {
+            --msg->peer->nqueued;
+        }
+        PMIX_LIST_DESTRUCT(&sched.queues[c]);
+    }
+    sched.initialized = false;
+}
+
+bool pmix_server_sched_defer(pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf)
+{
+    pmix_server_class_t c;
+    pmix_server_msg_t *msg;
+    pmix_cmd_t cmd;
+    int32_t cnt = 1;
+    char *ptr;
+    pmix_status_t rc;
+
+    if (!sched.initialized || !pmix_server_globals.sched || NULL == buf
+        || PMIX_BUFFER_IS_EMPTY(buf)) {
+        return false;
+    }
+
+    if (0 < peer->nqueued) {
+        /* keep behind what this peer already has waiting */
+        c = (pmix_server_class_t) peer->qclass;
+    } else {
+        /* look at the command without consuming it */
+        ptr = buf->unpack_ptr;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &cmd, &cnt, PMIX_COMMAND);
+        buf->unpack_ptr = ptr;
+        if (PMIX_SUCCESS != rc) {
+            return false;
+        }
+        c = classify(cmd);
+        if (PMIX_SERVER_CLASS_URGENT == c) {
+            return false;
+        }
+    }
+
+    if (PMIX_PEER_IS_TOOL(peer) && 0 < pmix_server_globals.sched_tool_limit
+        && (size_t) pmix_server_globals.sched_tool_limit <= sched.ntool[c]) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server:sched rejecting msg from tool %s - %lu waiting in class %d",
+                            PMIX_PNAME_PRINT(&peer->info->pname), (unsigned long) sched.ntool[c],
+                            (int) c);
+        pmix_server_reply_status(peer, hdr->tag, PMIX_ERR_OUT_OF_RESOURCE);
+        return true;
+    }
+
+    msg = PMIX_NEW(pmix_server_msg_t);
+    if (NULL == msg) {
+        return false;
+    }
+    PMIX_RETAIN(peer);
+    msg->peer = peer;
+    msg->tag = hdr->tag;
+    /* take over the data of the message */
+    msg->data = buf->base_ptr;
+    msg->ndata = buf->bytes_allocated;
+    msg->buf.type = buf->type;
+    msg->buf.base_ptr = buf->base_ptr;
+    msg->buf.pack_ptr = buf->pack_ptr;
+    msg->buf.unpack_ptr = buf->unpack_ptr;
+    msg->buf.bytes_allocated = buf->bytes_allocated;
+    msg->buf.bytes_used = buf->bytes_used;
+    buf->base_ptr = NULL;
+    buf->pack_ptr = NULL;
+    buf->unpack_ptr = NULL;
+    buf->bytes_allocated = 0;
+    buf->bytes_used = 0;
+
+    pmix_list_append(&sched.queues[c], &msg->super);
+    peer->qclass = c;
+    ++peer->nqueued;
+    if (PMIX_PEER_IS_TOOL(peer)) {
+        ++sched.ntool[c];
+    }
+    if (!sched.active) {
+        sched.active = true;
+        PMIX_THREADSHIFT_DELAY(&sched, drain, 0);
+    }
+    return true;
+}
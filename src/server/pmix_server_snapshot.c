@@ -0,0 +1,723 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
+#include <sys/mman.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_output.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* The state the host gave us - its nspaces and their job info, its
+ * clients, and the process sets and groups - is appended as it changes
+ * to a snapshot file, so a server that restarts after a failure can
+ * restore it before its clients reconnect. The file starts with:
+ *
+ *    char     magic[8]      "PMIXSNP1"
+ *    uint32_t order         0x01020304 in the byte order of the host
+ *    uint32_t buftype       type of the packed buffers
+ *    char     bfrops[16]    bfrops module that packed them
+ *
+ * followed by records of:
+ *
+ *    uint32_t size          bytes of the payload
+ *    uint32_t crc           CRC-32 of the payload
+ *    payload                a packed buffer starting with the record type
+ *
+ * The file is only appended to while the server runs. A record that
+ * was torn by the failure fails its check and ends the restore. The
+ * restore replays the records that are still live and rewrites the
+ * file with just those, so it does not grow across restarts. The file
+ * is removed when the server finalizes */
+
+#define PMIX_SNAPSHOT_MAGIC "PMIXSNP1"
+#define PMIX_SNAPSHOT_ORDER 0x01020304
+#define PMIX_SNAPSHOT_BFROPS_LEN 16
+
+typedef struct {
+    char magic[8];
+    uint32_t order;
+    uint32_t buftype;
+    char bfrops[PMIX_SNAPSHOT_BFROPS_LEN];
+} pmix_snapshot_header_t;
+
+typedef struct {
+    uint32_t size;
+    uint32_t crc;
+} pmix_snapshot_record_t;
+
+#define PMIX_SNAPSHOT_NSPACE     1
+#define PMIX_SNAPSHOT_NSPACE_DEL 2
+#define PMIX_SNAPSHOT_CLIENT     3
+#define PMIX_SNAPSHOT_CLIENT_DEL 4
+#define PMIX_SNAPSHOT_PSET       5
+#define PMIX_SNAPSHOT_PSET_DEL   6
+#define PMIX_SNAPSHOT_GROUP      7
+#define PMIX_SNAPSHOT_GROUP_DEL  8
+
+/* a live record read back from the file */
+typedef struct {
+    pmix_list_item_t super;
+    uint8_t type;
+    char *name;
+    pmix_proc_t proc;
+    int nlocalprocs;
+    uint32_t uid;
+    uint32_t gid;
+    pmix_info_t *info;
+    size_t ninfo;
+    pmix_proc_t *procs;
+    size_t nprocs;
+} pmix_snapshot_entry_t;
+static void sncon(pmix_snapshot_entry_t *p)
+{
+    p->type = 0;
+    p->name = NULL;
+    memset(&p->proc, 0, sizeof(pmix_proc_t));
+    p->nlocalprocs = 0;
+    p->uid = 0;
+    p->gid = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->procs = NULL;
+    p->nprocs = 0;
+}
+static void sndes(pmix_snapshot_entry_t *p)
+{
+    if (NULL != p->name) {
+        free(p->name);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    if (NULL != p->procs) {
+        PMIX_PROC_FREE(p->procs, p->nprocs);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_snapshot_entry_t, pmix_list_item_t, sncon, sndes);
+
+static int snapshot_fd = -1;
+static bool replaying = false;
+
+static uint32_t snapshot_crc(const char *data, size_t size)
+{
+    static uint32_t table[256];
+    static bool init = false;
+    uint32_t crc, c;
+    size_t n;
+    int k;
+
+    if (!init) {
+        for (n = 0; n < 256; n++) {
+            c = (uint32_t) n;
+            for (k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+            }
+            table[n] = c;
+        }
+        init = true;
+    }
+    crc = 0xFFFFFFFFU;
+    for (n = 0; n < size; n++) {
+        crc = table[(crc ^ (uint8_t) data[n]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+static bool write_all(int fd, const char *data, size_t size)
+{
+    ssize_t n;
+
+    while (0 < size) {
+        n = write(fd, data, size);
+        if (0 > n && EINTR == errno) {
+            continue;
+        }
+        if (0 >= n) {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+static void fill_header(pmix_snapshot_header_t *hdr)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    memcpy(hdr->magic, PMIX_SNAPSHOT_MAGIC, sizeof(hdr->magic));
+    hdr->order = PMIX_SNAPSHOT_ORDER;
+    hdr->buftype = (uint32_t) pmix_globals.mypeer->nptr->compat.type;
+    pmix_strncpy(hdr->bfrops, pmix_globals.mypeer->nptr->compat.bfrops->version,
+                 PMIX_SNAPSHOT_BFROPS_LEN - 1);
+}
+
+/* write the record as a single write so a failure can
+ * only tear the last one */
+static bool write_record(int fd, pmix_buffer_t *buf)
+{
+    pmix_snapshot_record_t rec;
+    char *data;
+    bool ret;
+
+    rec.size = (uint32_t) buf->bytes_used;
+    rec.crc = snapshot_crc(buf->base_ptr, buf->bytes_used);
+    data = (char *) malloc(sizeof(rec) + buf->bytes_used);
+    if (NULL == data) {
+        return false;
+    }
+    memcpy(data, &rec, sizeof(rec));
+    memcpy(data + sizeof(rec), buf->base_ptr, buf->bytes_used);
+    ret = write_all(fd, data, sizeof(rec) + buf->bytes_used);
+    free(data);
+    return ret;
+}
+
+static pmix_status_t pack_entry(pmix_buffer_t *buf, pmix_snapshot_entry_t *e)
+{
+    pmix_status_t rc;
+
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->type, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    switch (e->type) {
+    case PMIX_SNAPSHOT_NSPACE:
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->name, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->nlocalprocs, 1, PMIX_INT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->ninfo, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < e->ninfo) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, e->info, e->ninfo, PMIX_INFO);
+        }
+        break;
+    case PMIX_SNAPSHOT_CLIENT:
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->proc, 1, PMIX_PROC);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->uid, 1, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->gid, 1, PMIX_UINT32);
+        }
+        break;
+    case PMIX_SNAPSHOT_CLIENT_DEL:
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->proc, 1, PMIX_PROC);
+        break;
+    case PMIX_SNAPSHOT_PSET:
+    case PMIX_SNAPSHOT_GROUP:
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->name, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->nprocs, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < e->nprocs) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, e->procs, e->nprocs, PMIX_PROC);
+        }
+        break;
+    default:
+        /* the deletions of nspaces, psets and groups */
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &e->name, 1, PMIX_STRING);
+        break;
+    }
+    return rc;
+}
+
+static pmix_status_t unpack_entry(pmix_buffer_t *buf, pmix_snapshot_entry_t *e)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->type, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    switch (e->type) {
+    case PMIX_SNAPSHOT_NSPACE:
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->name, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->nlocalprocs, &cnt, PMIX_INT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->ninfo, &cnt, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < e->ninfo) {
+            PMIX_INFO_CREATE(e->info, e->ninfo);
+            cnt = e->ninfo;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, e->info, &cnt, PMIX_INFO);
+        }
+        break;
+    case PMIX_SNAPSHOT_CLIENT:
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->proc, &cnt, PMIX_PROC);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->uid, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->gid, &cnt, PMIX_UINT32);
+        }
+        break;
+    case PMIX_SNAPSHOT_CLIENT_DEL:
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->proc, &cnt, PMIX_PROC);
+        break;
+    case PMIX_SNAPSHOT_PSET:
+    case PMIX_SNAPSHOT_GROUP:
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->name, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->nprocs, &cnt, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < e->nprocs) {
+            PMIX_PROC_CREATE(e->procs, e->nprocs);
+            cnt = e->nprocs;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, e->procs, &cnt, PMIX_PROC);
+        }
+        break;
+    case PMIX_SNAPSHOT_NSPACE_DEL:
+    case PMIX_SNAPSHOT_PSET_DEL:
+    case PMIX_SNAPSHOT_GROUP_DEL:
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &e->name, &cnt, PMIX_STRING);
+        break;
+    default:
+        rc = PMIX_ERR_BAD_PARAM;
+        break;
+    }
+    return rc;
+}
+
+static void append(pmix_snapshot_entry_t *e)
+{
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+
+    if (0 > snapshot_fd || replaying) {
+        return;
+    }
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    rc = pack_entry(&buf, e);
+    if (PMIX_SUCCESS != rc || !write_record(snapshot_fd, &buf)) {
+        /* a snapshot missing a change would restore the wrong
+         * state, so stop taking them */
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server snapshot of %s failed - snapshots disabled",
+                            pmix_server_globals.snapshot);
+        close(snapshot_fd);
+        snapshot_fd = -1;
+        unlink(pmix_server_globals.snapshot);
+    }
+    PMIX_DESTRUCT(&buf);
+}
+
+static bool same_name(pmix_snapshot_entry_t *e, const char *name)
+{
+    return (NULL != e->name && 0 == strcmp(e->name, name));
+}
+
+/* apply a record to the live ones - deletions remove what they
+ * delete, and a redefined pset or group replaces the old one */
+static void apply(pmix_list_t *live, pmix_snapshot_entry_t *e)
+{
+    pmix_snapshot_entry_t *old, *next;
+    bool drop;
+
+    PMIX_LIST_FOREACH_SAFE (old, next, live, pmix_snapshot_entry_t) {
+        switch (e->type) {
+        case PMIX_SNAPSHOT_NSPACE_DEL:
+            drop = ((PMIX_SNAPSHOT_NSPACE == old->type && same_name(old, e->name))
+                    || (PMIX_SNAPSHOT_CLIENT == old->type
+                        && PMIX_CHECK_NSPACE(old->proc.nspace, e->name)));
+            break;
+        case PMIX_SNAPSHOT_CLIENT_DEL:
+            drop = (PMIX_SNAPSHOT_CLIENT == old->type && PMIX_CHECK_PROCID(&old->proc, &e->proc));
+            break;
+        case PMIX_SNAPSHOT_PSET:
+        case PMIX_SNAPSHOT_PSET_DEL:
+            drop = (PMIX_SNAPSHOT_PSET == old->type && same_name(old, e->name));
+            break;
+        case PMIX_SNAPSHOT_GROUP:
+        case PMIX_SNAPSHOT_GROUP_DEL:
+            drop = (PMIX_SNAPSHOT_GROUP == old->type && same_name(old, e->name));
+            break;
+        default:
+            drop = false;
+            break;
+        }
+        if (drop) {
+            pmix_list_remove_item(live, &old->super);
+            PMIX_RELEASE(old);
+        }
+    }
+    switch (e->type) {
+    case PMIX_SNAPSHOT_NSPACE:
+    case PMIX_SNAPSHOT_CLIENT:
+    case PMIX_SNAPSHOT_PSET:
+    case PMIX_SNAPSHOT_GROUP:
+        pmix_list_append(live, &e->super);
+        break;
+    default:
+        PMIX_RELEASE(e);
+        break;
+    }
+}
+
+/* read the live records from the file - returns false if it
+ * cannot be used at all */
+static bool load(const char *path, pmix_list_t *live)
+{
+    pmix_snapshot_header_t hdr, *fhdr;
+    pmix_snapshot_record_t rec;
+    pmix_snapshot_entry_t *e;
+    pmix_buffer_t buf;
+    struct stat st;
+    char *base, *ptr;
+    size_t pos, nrecs = 0;
+    pmix_status_t rc;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (0 > fd) {
+        return false;
+    }
+    if (0 != fstat(fd, &st) || (size_t) st.st_size < sizeof(hdr)) {
+        close(fd);
+        return false;
+    }
+    base = (char *) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        return false;
+    }
+#ifdef MADV_SEQUENTIAL
+    (void) madvise(base, st.st_size, MADV_SEQUENTIAL);
+#endif
+
+    /* only a snapshot we could have written ourselves is usable */
+    fill_header(&hdr);
+    fhdr = (pmix_snapshot_header_t *) base;
+    if (0 != memcmp(fhdr, &hdr, sizeof(hdr))) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server snapshot %s was not written by this version", path);
+        munmap(base, st.st_size);
+        return false;
+    }
+
+    pos = sizeof(hdr);
+    while (pos + sizeof(rec) <= (size_t) st.st_size) {
+        memcpy(&rec, base + pos, sizeof(rec));
+        if ((size_t) rec.size > (size_t) st.st_size - pos - sizeof(rec)
+            || rec.crc != snapshot_crc(base + pos + sizeof(rec), rec.size)) {
+            /* torn by the failure */
+            break;
+        }
+        e = PMIX_NEW(pmix_snapshot_entry_t);
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        ptr = base + pos + sizeof(rec);
+        PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_globals.mypeer, &buf, ptr, rec.size);
+        rc = unpack_entry(&buf, e);
+        /* the payload belongs to the mapping */
+        buf.base_ptr = NULL;
+        PMIX_DESTRUCT(&buf);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(e);
+            break;
+        }
+        apply(live, e);
+        pos += sizeof(rec) + rec.size;
+        ++nrecs;
+    }
+    munmap(base, st.st_size);
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server snapshot %s: %lu records, %lu live", path,
+                        (unsigned long) nrecs, (unsigned long) pmix_list_get_size(live));
+    return true;
+}
+
+/* start a new file holding just the live records - written
+ * aside and renamed so a failure here leaves the old one */
+static int rewrite(const char *path, pmix_list_t *live)
+{
+    pmix_snapshot_header_t hdr;
+    pmix_snapshot_entry_t *e;
+    pmix_buffer_t buf;
+    char *tmp;
+    bool ok;
+    int fd;
+
+    if (0 > asprintf(&tmp, "%s.%lu", path, (unsigned long) getpid())) {
+        return -1;
+    }
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (0 > fd) {
+        free(tmp);
+        return -1;
+    }
+    fill_header(&hdr);
+    ok = write_all(fd, (char *) &hdr, sizeof(hdr));
+    PMIX_LIST_FOREACH (e, live, pmix_snapshot_entry_t) {
+        if (!ok) {
+            break;
+        }
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        ok = (PMIX_SUCCESS == pack_entry(&buf, e) && write_record(fd, &buf));
+        PMIX_DESTRUCT(&buf);
+    }
+    if (!ok || 0 != rename(tmp, path)) {
+        close(fd);
+        unlink(tmp);
+        free(tmp);
+        return -1;
+    }
+    free(tmp);
+    /* the rest of our writes are appends */
+    if (0 > fcntl(fd, F_SETFL, O_APPEND)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void restore_groups(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t *) cbdata;
+    pmix_list_t *live = (pmix_list_t *) scd->cbdata;
+    pmix_snapshot_entry_t *e;
+    pmix_group_t *grp;
+
+    PMIX_ACQUIRE_OBJECT(scd);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_LIST_FOREACH (e, live, pmix_snapshot_entry_t) {
+        if (PMIX_SNAPSHOT_GROUP != e->type || NULL != pmix_server_group_lookup(e->name)) {
+            continue;
+        }
+        grp = PMIX_NEW(pmix_group_t);
+        grp->grpid = e->name;
+        grp->members = e->procs;
+        grp->nmbrs = e->nprocs;
+        e->name = NULL;
+        e->procs = NULL;
+        e->nprocs = 0;
+        if (PMIX_SUCCESS != pmix_server_group_index(grp)) {
+            PMIX_RELEASE(grp);
+            continue;
+        }
+        pmix_server_group_add(grp);
+    }
+    PMIX_POST_OBJECT(scd);
+    PMIX_WAKEUP_THREAD(&scd->lock);
+}
+
+void pmix_server_snapshot_restore(void)
+{
+    pmix_list_t live;
+    pmix_snapshot_entry_t *e;
+    pmix_shift_caddy_t *scd;
+    pmix_status_t rc;
+    bool restored;
+
+    if (NULL == pmix_server_globals.snapshot || '\0' == pmix_server_globals.snapshot[0]) {
+        return;
+    }
+
+    PMIX_CONSTRUCT(&live, pmix_list_t);
+    restored = load(pmix_server_globals.snapshot, &live);
+    snapshot_fd = rewrite(pmix_server_globals.snapshot, &live);
+    if (0 > snapshot_fd) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server cannot write snapshot %s: %s",
+                            pmix_server_globals.snapshot, strerror(errno));
+    }
+    if (!restored || 0 == pmix_list_get_size(&live)) {
+        PMIX_LIST_DESTRUCT(&live);
+        return;
+    }
+
+    /* replay the live records through the usual paths, which
+     * must not record them again. The host's objects for the
+     * clients did not survive, so they are restored without */
+    replaying = true;
+    PMIX_LIST_FOREACH (e, &live, pmix_snapshot_entry_t) {
+        switch (e->type) {
+        case PMIX_SNAPSHOT_NSPACE:
+            rc = PMIx_server_register_nspace(e->name, e->nlocalprocs, e->info, e->ninfo, NULL,
+                                             NULL);
+            break;
+        case PMIX_SNAPSHOT_CLIENT:
+            rc = PMIx_server_register_client(&e->proc, e->uid, e->gid, NULL, NULL, NULL);
+            break;
+        case PMIX_SNAPSHOT_PSET:
+            rc = PMIx_server_define_process_set(e->procs, e->nprocs, e->name);
+            break;
+        default:
+            rc = PMIX_OPERATION_SUCCEEDED;
+            break;
+        }
+        if (PMIX_OPERATION_SUCCEEDED != rc && PMIX_SUCCESS != rc) {
+            pmix_output_verbose(2, pmix_server_globals.base_output,
+                                "pmix:server snapshot restore of a record of type %u failed: %s",
+                                (unsigned) e->type, PMIx_Error_string(rc));
+        }
+    }
+    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd->cbdata = &live;
+    PMIX_THREADSHIFT(scd, restore_groups);
+    PMIX_WAIT_THREAD(&scd->lock);
+    PMIX_RELEASE(scd);
+    replaying = false;
+
+    PMIX_LIST_DESTRUCT(&live);
+}
+
+void pmix_server_snapshot_finalize(void)
+{
+    if (0 > snapshot_fd) {
+        return;
+    }
+    close(snapshot_fd);
+    snapshot_fd = -1;
+    /* a server that finalized has nothing to restore */
+    unlink(pmix_server_globals.snapshot);
+}
+
+void pmix_server_snapshot_nspace(const char *nspace, int nlocalprocs, pmix_info_t *info,
+                                 size_t ninfo)
+{
+    pmix_snapshot_entry_t e;
+    size_t n, m;
+
+    if (0 > snapshot_fd || replaying) {
+        return;
+    }
+    PMIX_CONSTRUCT(&e, pmix_snapshot_entry_t);
+    e.type = PMIX_SNAPSHOT_NSPACE;
+    e.name = strdup(nspace);
+    e.nlocalprocs = nlocalprocs;
+    /* addresses mean nothing to the next server */
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_POINTER != info[n].value.type) {
+            ++e.ninfo;
+        }
+    }
+    if (0 < e.ninfo) {
+        PMIX_INFO_CREATE(e.info, e.ninfo);
+        for (n = 0, m = 0; n < ninfo; n++) {
+            if (PMIX_POINTER != info[n].value.type) {
+                PMIX_INFO_XFER(&e.info[m], &info[n]);
+                ++m;
+            }
+        }
+    }
+    append(&e);
+    PMIX_DESTRUCT(&e);
+}
+
+static void record(uint8_t type, const char *name, const pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_snapshot_entry_t e;
+
+    if (0 > snapshot_fd || replaying) {
+        return;
+    }
+    PMIX_CONSTRUCT(&e, pmix_snapshot_entry_t);
+    e.type = type;
+    e.name = (char *) name;
+    e.procs = (pmix_proc_t *) procs;
+    e.nprocs = nprocs;
+    append(&e);
+    /* nothing here was ours */
+    e.name = NULL;
+    e.procs = NULL;
+    e.nprocs = 0;
+    PMIX_DESTRUCT(&e);
+}
+
+void pmix_server_snapshot_nspace_delete(const char *nspace)
+{
+    record(PMIX_SNAPSHOT_NSPACE_DEL, nspace, NULL, 0);
+}
+
+void pmix_server_snapshot_client(const pmix_proc_t *proc, uid_t uid, gid_t gid)
+{
+    pmix_snapshot_entry_t e;
+
+    if (0 > snapshot_fd || replaying) {
+        return;
+    }
+    PMIX_CONSTRUCT(&e, pmix_snapshot_entry_t);
+    e.type = PMIX_SNAPSHOT_CLIENT;
+    PMIX_XFER_PROCID(&e.proc, proc);
+    e.uid = (uint32_t) uid;
+    e.gid = (uint32_t) gid;
+    append(&e);
+    PMIX_DESTRUCT(&e);
+}
+
+void pmix_server_snapshot_client_delete(const pmix_proc_t *proc)
+{
+    pmix_snapshot_entry_t e;
+
+    if (0 > snapshot_fd || replaying) {
+        return;
+    }
+    PMIX_CONSTRUCT(&e, pmix_snapshot_entry_t);
+    e.type = PMIX_SNAPSHOT_CLIENT_DEL;
+    PMIX_XFER_PROCID(&e.proc, proc);
+    append(&e);
+    PMIX_DESTRUCT(&e);
+}
+
+void pmix_server_snapshot_pset(const char *name, const pmix_proc_t *members, size_t nmembers)
+{
+    record(PMIX_SNAPSHOT_PSET, name, members, nmembers);
+}
+
+void pmix_server_snapshot_pset_delete(const char *name)
+{
+    record(PMIX_SNAPSHOT_PSET_DEL, name, NULL, 0);
+}
+
+void pmix_server_snapshot_group(const pmix_group_t *grp)
+{
+    record(PMIX_SNAPSHOT_GROUP, grp->grpid, grp->members, grp->nmbrs);
+}
+
+void pmix_server_snapshot_group_delete(const char *grpid)
+{
+    record(PMIX_SNAPSHOT_GROUP_DEL, grpid, NULL, 0);
+}
@@ -0,0 +1,229 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_stdint.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+#include <time.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_mutex.h"
+
+#include "src/server/pmix_server_ops.h"
+
+/* reply latency is binned by powers of two: bucket zero counts
+ * replies sent within a usec of the request arriving, and bucket
+ * n counts those taking [2^(n-1), 2^n) usec */
+#define PMIX_SERVER_STATS_BUCKETS 32
+
+/* bound on the requests tracked for one peer - commands that are
+ * never answered would otherwise accumulate until it disconnects */
+#define PMIX_SERVER_STATS_MAX_PENDING 256
+
+typedef struct {
+    uint64_t requests;
+    uint64_t replies;
+    uint64_t buckets[PMIX_SERVER_STATS_BUCKETS];
+} pmix_server_cmd_stats_t;
+
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t tag;
+    pmix_cmd_t cmd;
+    uint64_t arrived;
+} pmix_server_reqstamp_t;
+static PMIX_CLASS_INSTANCE(pmix_server_reqstamp_t, pmix_list_item_t, NULL, NULL);
+
+/* requests and replies may be handled by different threads */
+static pmix_mutex_t stats_lock = PMIX_MUTEX_STATIC_INIT;
+static pmix_server_cmd_stats_t cmd_stats[UINT8_MAX + 1];
+
+static uint64_t stats_usec(void)
+{
+#if defined(__linux__) && PMIX_HAVE_CLOCK_GETTIME
+    struct timespec tp;
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (uint64_t) tp.tv_sec * 1000000 + (uint64_t) tp.tv_nsec / 1000;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t) tv.tv_sec * 1000000 + (uint64_t) tv.tv_usec;
+#endif
+}
+
+void pmix_server_stats_request(pmix_peer_t *peer, uint32_t tag, pmix_cmd_t cmd)
+{
+    pmix_server_reqstamp_t *stamp;
+    pmix_list_item_t *item;
+
+    if (!pmix_server_globals.cmd_stats) {
+        return;
+    }
+    pmix_mutex_lock(&stats_lock);
+    ++cmd_stats[cmd].requests;
+    /* oneway messages carry no tag and get no reply */
+    if (PMIX_PTL_TAG_DYNAMIC <= tag) {
+        if (PMIX_SERVER_STATS_MAX_PENDING <= pmix_list_get_size(&peer->pending_reqs)) {
+            item = pmix_list_remove_first(&peer->pending_reqs);
+            PMIX_RELEASE(item);
+        }
+        stamp = PMIX_NEW(pmix_server_reqstamp_t);
+        stamp->tag = tag;
+        stamp->cmd = cmd;
+        stamp->arrived = stats_usec();
+        pmix_list_append(&peer->pending_reqs, &stamp->super);
+    }
+    pmix_mutex_unlock(&stats_lock);
+}
+
+void pmix_server_stats_reply(struct pmix_peer_t *p, uint32_t tag)
+{
+    pmix_peer_t *peer = (pmix_peer_t *) p;
+    pmix_server_reqstamp_t *stamp;
+    uint64_t elapsed;
+    int bucket;
+
+    if (PMIX_PTL_TAG_DYNAMIC > tag || pmix_list_is_empty(&peer->pending_reqs)) {
+        return;
+    }
+    pmix_mutex_lock(&stats_lock);
+    PMIX_LIST_FOREACH (stamp, &peer->pending_reqs, pmix_server_reqstamp_t) {
+        if (stamp->tag == tag) {
+            elapsed = stats_usec() - stamp->arrived;
+            for (bucket = 0; 0 < elapsed && bucket < PMIX_SERVER_STATS_BUCKETS - 1; bucket++) {
+                elapsed >>= 1;
+            }
+            ++cmd_stats[stamp->cmd].replies;
+            ++cmd_stats[stamp->cmd].buckets[bucket];
+            pmix_list_remove_item(&peer->pending_reqs, &stamp->super);
+            PMIX_RELEASE(stamp);
+            break;
+        }
+    }
+    pmix_mutex_unlock(&stats_lock);
+}
+
+bool pmix_server_stats_key(const char *key)
+{
+    return (0 == strcmp(key, PMIX_QUERY_SERVER_CMD_STATS)
+            || 0 == strcmp(key, PMIX_QUERY_SERVER_LOCAL_REQS)
+            || 0 == strcmp(key, PMIX_QUERY_SERVER_COLLECTIVES));
+}
+
+/* must be called with the stats lock held */
+static void load_cmd_stats(pmix_info_t *info)
+{
+    pmix_data_array_t *darray, *counts;
+    pmix_info_t *iptr;
+    uint64_t *vals;
+    size_t ncmds, n, nbuckets;
+    int cmd;
+
+    ncmds = 0;
+    for (cmd = 0; cmd <= UINT8_MAX; cmd++) {
+        if (0 < cmd_stats[cmd].requests) {
+            ++ncmds;
+        }
+    }
+    PMIX_DATA_ARRAY_CREATE(darray, ncmds, PMIX_INFO);
+    iptr = (pmix_info_t *) darray->array;
+    n = 0;
+    for (cmd = 0; cmd <= UINT8_MAX && n < ncmds; cmd++) {
+        if (0 == cmd_stats[cmd].requests) {
+            continue;
+        }
+        /* leave off the empty tail of the histogram */
+        for (nbuckets = PMIX_SERVER_STATS_BUCKETS; 0 < nbuckets; nbuckets--) {
+            if (0 < cmd_stats[cmd].buckets[nbuckets - 1]) {
+                break;
+            }
+        }
+        PMIX_DATA_ARRAY_CREATE(counts, 2 + nbuckets, PMIX_UINT64);
+        vals = (uint64_t *) counts->array;
+        vals[0] = cmd_stats[cmd].requests;
+        vals[1] = cmd_stats[cmd].replies;
+        memcpy(&vals[2], cmd_stats[cmd].buckets, nbuckets * sizeof(uint64_t));
+        PMIX_LOAD_KEY(iptr[n].key, pmix_command_string((pmix_cmd_t) cmd));
+        iptr[n].value.type = PMIX_DATA_ARRAY;
+        iptr[n].value.data.darray = counts;
+        ++n;
+    }
+    PMIX_LOAD_KEY(info->key, PMIX_QUERY_SERVER_CMD_STATS);
+    info->value.type = PMIX_DATA_ARRAY;
+    info->value.data.darray = darray;
+}
+
+static void stats_query_relcb(void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+
+    if (NULL != cd->info) {
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+    }
+    PMIX_RELEASE(cd);
+}
+
+void pmix_server_stats_query(int sd, short args, void *cbdata)
+{
+    pmix_query_caddy_t *cd = (pmix_query_caddy_t *) cbdata;
+    pmix_status_t rc;
+    uint64_t val;
+    size_t n, p, m;
+    char *key;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    /* answer every statistic we were asked for */
+    cd->ninfo = 0;
+    for (n = 0; n < cd->nqueries; n++) {
+        for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+            if (pmix_server_stats_key(cd->queries[n].keys[p])) {
+                ++cd->ninfo;
+            }
+        }
+    }
+    if (0 == cd->ninfo) {
+        rc = PMIX_ERR_NOT_FOUND;
+    } else {
+        PMIX_INFO_CREATE(cd->info, cd->ninfo);
+        m = 0;
+        for (n = 0; n < cd->nqueries; n++) {
+            for (p = 0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[p]; p++) {
+                key = cd->queries[n].keys[p];
+                if (0 == strcmp(key, PMIX_QUERY_SERVER_CMD_STATS)) {
+                    pmix_mutex_lock(&stats_lock);
+                    load_cmd_stats(&cd->info[m]);
+                    pmix_mutex_unlock(&stats_lock);
+                    ++m;
+                } else if (0 == strcmp(key, PMIX_QUERY_SERVER_LOCAL_REQS)) {
+                    val = pmix_list_get_size(&pmix_server_globals.local_reqs);
+                    PMIX_INFO_LOAD(&cd->info[m], key, &val, PMIX_UINT64);
+                    ++m;
+                } else if (0 == strcmp(key, PMIX_QUERY_SERVER_COLLECTIVES)) {
+                    val = pmix_list_get_size(&pmix_server_globals.collectives);
+                    PMIX_INFO_LOAD(&cd->info[m], key, &val, PMIX_UINT64);
+                    ++m;
+                }
+            }
+        }
+        rc = PMIX_SUCCESS;
+    }
+
+    cd->cbfunc(rc, cd->info, cd->ninfo, cd->cbdata, stats_query_relcb, cd);
+}
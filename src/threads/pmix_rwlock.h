@@ -0,0 +1,64 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_THREADS_RWLOCK_H
+#define PMIX_THREADS_RWLOCK_H
+
+#include "src/include/pmix_config.h"
+
+#include <pthread.h>
+
+#include "pmix_common.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @file
+ *
+ * Reader-writer locks
+ *
+ * For data that is read from several threads at once and only
+ * rarely changed. Unlike pmix_mutex_t these are not objects - they
+ * are embedded in arrays and statics - so they are set up with
+ * pmix_rwlock_init or PMIX_RWLOCK_STATIC_INIT.
+ */
+
+typedef pthread_rwlock_t pmix_rwlock_t;
+
+#define PMIX_RWLOCK_STATIC_INIT PTHREAD_RWLOCK_INITIALIZER
+
+static inline void pmix_rwlock_init(pmix_rwlock_t *l)
+{
+    pthread_rwlock_init(l, NULL);
+}
+
+static inline void pmix_rwlock_destroy(pmix_rwlock_t *l)
+{
+    pthread_rwlock_destroy(l);
+}
+
+static inline void pmix_rwlock_rdlock(pmix_rwlock_t *l)
+{
+    pthread_rwlock_rdlock(l);
+}
+
+static inline void pmix_rwlock_wrlock(pmix_rwlock_t *l)
+{
+    pthread_rwlock_wrlock(l);
+}
+
+static inline void pmix_rwlock_unlock(pmix_rwlock_t *l)
+{
+    pthread_rwlock_unlock(l);
+}
+
+END_C_DECLS
+
+#endif /* PMIX_THREADS_RWLOCK_H */
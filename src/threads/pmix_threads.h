@@ -57,6 +57,10 @@ typedef struct pmix_thread_t pmix_thread_t;
 PMIX_EXPORT extern bool pmix_debug_threads;
 #endif
 
+/* number of times a waiting thread checks the lock before it
+ * sleeps on the condition - 0 => sleep right away */
+PMIX_EXPORT extern int pmix_thread_spin_count;
+
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_thread_t);
 
 #define pmix_condition_wait(a, b) pthread_cond_wait(a, &(b)->m_lock_pthread)
@@ -80,6 +84,13 @@ typedef struct {
         .active = false                     \
     }
 
+/* Spin until the lock is released or pmix_thread_spin_count checks
+ * have been made, easing off the core for the first half and giving
+ * it up for the second. Replies that arrive within a few
+ * microseconds then don't cost a sleep and a wakeup of the waiting
+ * thread. Returns true if the lock was released */
+PMIX_EXPORT bool pmix_thread_spin_wait(volatile bool *active);
+
 #define PMIX_CONSTRUCT_LOCK(l)                     \
     do {                                           \
         PMIX_CONSTRUCT(&(l)->mutex, pmix_mutex_t); \
@@ -125,6 +136,9 @@ typedef struct {
 #if PMIX_ENABLE_DEBUG
 #    define PMIX_WAIT_THREAD(lck)                                               \
         do {                                                                    \
+            if (0 < pmix_thread_spin_count) {                                   \
+                (void) pmix_thread_spin_wait(&(lck)->active);                   \
+            }                                                                   \
             pmix_mutex_lock(&(lck)->mutex);                                     \
             if (pmix_debug_threads) {                                           \
                 pmix_output(0, "Waiting for thread %s:%d", __FILE__, __LINE__); \
@@ -141,6 +155,9 @@ typedef struct {
 #else
 #    define PMIX_WAIT_THREAD(lck)                                 \
         do {                                                      \
+            if (0 < pmix_thread_spin_count) {                     \
+                (void) pmix_thread_spin_wait(&(lck)->active);     \
+            }                                                     \
             pmix_mutex_lock(&(lck)->mutex);                       \
             while ((lck)->active) {                               \
                 pmix_condition_wait(&(lck)->cond, &(lck)->mutex); \
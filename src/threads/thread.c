@@ -24,10 +24,14 @@
 #include "pmix_config.h"
 
 #include "pmix_common.h"
+
+#include <sched.h>
+
 #include "src/threads/pmix_threads.h"
 #include "src/threads/pmix_tsd.h"
 
 bool pmix_debug_threads = false;
+int pmix_thread_spin_count = 0;
 
 static void pmix_thread_construct(pmix_thread_t *t);
 
@@ -129,3 +133,24 @@ void pmix_thread_set_main(void)
 {
     pmix_main_thread = pthread_self();
 }
+
+bool pmix_thread_spin_wait(volatile bool *active)
+{
+    int n;
+
+    for (n = 0; n < pmix_thread_spin_count; n++) {
+        if (!*active) {
+            return true;
+        }
+        if (n < pmix_thread_spin_count / 2) {
+#if defined(__x86_64__) || defined(__i386__)
+            __asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+            __asm__ __volatile__("yield");
+#endif
+        } else {
+            sched_yield();
+        }
+    }
+    return !*active;
+}
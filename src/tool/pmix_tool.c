@@ -64,6 +64,7 @@
 #include "src/mca/ptl/base/base.h"
 #include "src/runtime/pmix_progress_threads.h"
 #include "src/runtime/pmix_rte.h"
+#include "src/runtime/pmix_timer.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_error.h"
@@ -72,6 +73,7 @@
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_timings.h"
 
 #define PMIX_MAX_RETRIES 10
 
@@ -278,7 +280,7 @@ static void tool_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
     pmix_peer_t *peer = (pmix_peer_t *) pr;
     pmix_proc_t source;
     pmix_iof_channel_t channel;
-    pmix_byte_object_t bo;
+    pmix_byte_object_t bo, raw, *data;
     int32_t cnt;
     pmix_status_t rc;
     size_t refid, ninfo = 0;
@@ -294,6 +296,7 @@ static void tool_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
         return;
     }
     PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&raw);
 
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &source, &cnt, PMIX_PROC);
@@ -328,29 +331,38 @@ static void tool_iof_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
             goto cleanup;
         }
     }
+    /* the output is only needed until it has been delivered */
     cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+    PMIX_BFROPS_UNPACK_VIEW(rc, peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
     }
+    /* expand the data if the server compressed it */
+    rc = pmix_iof_decompress(&channel, &bo, &raw);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+    data = (NULL == raw.bytes) ? &bo : &raw;
     /* lookup the handler for this IOF package */
     req = (pmix_iof_req_t *) pmix_pointer_array_get_item(&pmix_globals.iof_requests, refid);
     if (NULL != req && NULL != req->cbfunc) {
-        req->cbfunc(refid, channel, &source, &bo, info, ninfo);
+        req->cbfunc(refid, channel, &source, data, info, ninfo);
     } else {
         /* otherwise, simply write it out to the specified std IO channel */
-        if (NULL != bo.bytes && 0 < bo.size) {
-            pmix_iof_write_output(&source, channel, &bo);
+        if (NULL != data->bytes && 0 < data->size) {
+            pmix_iof_write_output(&source, channel, data);
         }
     }
 
 cleanup:
     /* cleanup the memory */
+    PMIX_BYTE_OBJECT_DESTRUCT(&raw);
     if (0 < ninfo) {
         PMIX_INFO_FREE(info, ninfo);
     }
-    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    PMIX_BFROPS_VIEW_FREE(buf, bo.bytes);
 }
 
 /* callback to receive job info */
@@ -475,6 +487,8 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc, pmix_info_t info[], size_t nin
         PMIX_RELEASE_THREAD(&pmix_global_lock);
         return PMIX_SUCCESS;
     }
+    pmix_timing_phase_start(PMIX_TIMING_PHASE_INIT);
+
     /* init the parent procid to something innocuous */
     PMIX_LOAD_PROCID(&myparent, NULL, PMIX_RANK_UNDEF);
 
@@ -754,8 +768,10 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc, pmix_info_t info[], size_t nin
         }
     } else {
         /* connect to the server */
+        pmix_timing_phase_start(PMIX_TIMING_PHASE_CONNECT);
         rc = pmix_ptl.connect_to_peer((struct pmix_peer_t *) pmix_client_globals.myserver, info,
                                       ninfo);
+        pmix_timing_phase_stop(PMIX_TIMING_PHASE_CONNECT);
         if (PMIX_SUCCESS != rc) {
             /* if connection wasn't optional, then error out */
             if (!connect_optional) {
@@ -1077,6 +1093,7 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc, pmix_info_t info[], size_t nin
 
     /* register the tool supported attrs */
     rc = pmix_register_tool_attrs();
+    pmix_timing_phase_stop(PMIX_TIMING_PHASE_INIT);
 
     return rc;
 }
@@ -1416,7 +1433,9 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
     struct timeval tv = {5, 0};
     int n;
     pmix_peer_t *peer;
-    pmix_pfexec_child_t *child;
+    pmix_pfexec_child_t *child, *next;
+    pmix_proc_t *kprocs;
+    size_t nchildren;
     pmix_lock_t lock;
     pmix_event_t ev;
 
@@ -1480,8 +1499,22 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
             pmix_event_del(pmix_pfexec_globals.handler);
             pmix_pfexec_globals.active = false;
         }
-        PMIX_LIST_FOREACH (child, &pmix_pfexec_globals.children, pmix_pfexec_child_t) {
-            pmix_pfexec.kill_proc(&child->proc);
+        nchildren = pmix_list_get_size(&pmix_pfexec_globals.children);
+        if (0 < nchildren && NULL != pmix_pfexec.kill_procs
+            && NULL != (kprocs = (pmix_proc_t *) malloc(nchildren * sizeof(pmix_proc_t)))) {
+            /* terminate them all in one sweep so we wait for
+             * them only once */
+            n = 0;
+            PMIX_LIST_FOREACH (child, &pmix_pfexec_globals.children, pmix_pfexec_child_t) {
+                PMIX_LOAD_PROCID(&kprocs[n], child->proc.nspace, child->proc.rank);
+                ++n;
+            }
+            pmix_pfexec.kill_procs(kprocs, nchildren);
+            free(kprocs);
+        } else {
+            PMIX_LIST_FOREACH_SAFE (child, next, &pmix_pfexec_globals.children, pmix_pfexec_child_t) {
+                pmix_pfexec.kill_proc(&child->proc);
+            }
         }
     }
 
@@ -1526,11 +1559,19 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
     (void) pmix_mca_base_framework_close(&pmix_pnet_base_framework);
     PMIX_DESTRUCT(&pmix_server_globals.clients);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
+    PMIX_DESTRUCT(&pmix_server_globals.trackers);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
+    pmix_notify_batch_finalize();
+    PMIX_DESTRUCT(&pmix_server_globals.event_codes);
+    PMIX_DESTRUCT(&pmix_server_globals.group_ids);
+    PMIX_DESTRUCT(&pmix_server_globals.pset_names);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
+    pmix_server_iof_cache_purge();
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.iof_spills);
+    pmix_server_pools_finalize();
 
     (void) pmix_mca_base_framework_close(&pmix_pfexec_base_framework);
     (void) pmix_mca_base_framework_close(&pmix_pmdl_base_framework);
@@ -1556,27 +1597,10 @@ pmix_status_t PMIx_tool_connect_to_server(pmix_proc_t *proc, pmix_info_t info[],
     return rc;
 }
 
-static void retry_attach(int sd, short args, void *cbdata)
+static pmix_peer_t *new_server_peer(void)
 {
-    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
-    pmix_kval_t *kptr;
     pmix_peer_t *peer;
-    size_t n;
-    pmix_status_t rc;
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-    PMIX_ACQUIRE_OBJECT(cb);
-
-    /* check for directives */
-    cb->checked = false;
-    for (n = 0; n < cb->ninfo; n++) {
-        if (PMIX_CHECK_KEY(&cb->info[n], PMIX_PRIMARY_SERVER)) {
-            cb->checked = PMIX_INFO_TRUE(&cb->info[n]);
-            break;
-        }
-    }
 
-    /* ask the ptl to establish connection to the new server */
     peer = PMIX_NEW(pmix_peer_t);
     /* setup the infrastructure - assume this new server will follow
      * same rules as our current one */
@@ -1586,6 +1610,66 @@ static void retry_attach(int sd, short args, void *cbdata)
     peer->nptr->compat.psec = pmix_globals.mypeer->nptr->compat.psec;
     peer->nptr->compat.type = pmix_globals.mypeer->nptr->compat.type;
     peer->nptr->compat.gds = pmix_globals.mypeer->nptr->compat.gds;
+    return peer;
+}
+
+static void set_primary(pmix_peer_t *peer)
+{
+    pmix_kval_t *kptr;
+    pmix_status_t rc;
+
+    /* point our active server at this new one */
+    pmix_client_globals.myserver = peer;
+    /* mark that we are connected */
+    pmix_globals.connected = true;
+    /* update our active server's ID in the local key-value store */
+    kptr = PMIX_NEW(pmix_kval_t);
+    kptr->key = strdup(PMIX_SERVER_NSPACE);
+    PMIX_VALUE_CREATE(kptr->value, 1);
+    kptr->value->type = PMIX_STRING;
+    kptr->value->data.string = strdup(peer->info->pname.nspace);
+    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, kptr);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_RELEASE(kptr); // maintain accounting
+    kptr = PMIX_NEW(pmix_kval_t);
+    kptr->key = strdup(PMIX_SERVER_RANK);
+    PMIX_VALUE_CREATE(kptr->value, 1);
+    kptr->value->type = PMIX_PROC_RANK;
+    kptr->value->data.rank = peer->info->pname.rank;
+    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, kptr);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_RELEASE(kptr); // maintain accounting
+}
+
+static bool is_primary(pmix_info_t *info, size_t ninfo)
+{
+    size_t n;
+
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_PRIMARY_SERVER)) {
+            return PMIX_INFO_TRUE(&info[n]);
+        }
+    }
+    return false;
+}
+
+static void retry_attach(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_peer_t *peer;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cb);
+
+    /* check for directives */
+    cb->checked = is_primary(cb->info, cb->ninfo);
+
+    /* ask the ptl to establish connection to the new server */
+    peer = new_server_peer();
 
     cb->status = pmix_ptl.connect_to_peer((struct pmix_peer_t *) peer, cb->info, cb->ninfo);
 
@@ -1596,31 +1680,7 @@ static void retry_attach(int sd, short args, void *cbdata)
         /* add the peer to our known clients */
         pmix_pointer_array_add(&pmix_server_globals.clients, peer);
         if (cb->checked) {
-            /* point our active server at this new one */
-            pmix_client_globals.myserver = peer;
-            /* mark that we are connected */
-            pmix_globals.connected = true;
-            /* update our active server's ID in the local key-value store */
-            kptr = PMIX_NEW(pmix_kval_t);
-            kptr->key = strdup(PMIX_SERVER_NSPACE);
-            PMIX_VALUE_CREATE(kptr->value, 1);
-            kptr->value->type = PMIX_STRING;
-            kptr->value->data.string = strdup(peer->info->pname.nspace);
-            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, kptr);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-            }
-            PMIX_RELEASE(kptr); // maintain accounting
-            kptr = PMIX_NEW(pmix_kval_t);
-            kptr->key = strdup(PMIX_SERVER_RANK);
-            PMIX_VALUE_CREATE(kptr->value, 1);
-            kptr->value->type = PMIX_PROC_RANK;
-            kptr->value->data.rank = peer->info->pname.rank;
-            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, PMIX_INTERNAL, kptr);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-            }
-            PMIX_RELEASE(kptr); // maintain accounting
+            set_primary(peer);
         }
 
     } else {
@@ -1677,6 +1737,112 @@ pmix_status_t PMIx_tool_attach_to_server(pmix_proc_t *myproc, pmix_proc_t *serve
     return PMIX_SUCCESS;
 }
 
+static void complete_attach(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_ptl_attach_t *attach = (pmix_ptl_attach_t *) cb->cbdata;
+    size_t n;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cb);
+
+    for (n = 0; n < cb->nvals; n++) {
+        if (PMIX_SUCCESS != attach[n].status) {
+            PMIX_RELEASE(attach[n].peer);
+            attach[n].peer = NULL;
+            continue;
+        }
+        pmix_ptl_base_complete_connection(attach[n].peer, attach[n].nspace, attach[n].rank,
+                                          attach[n].suri);
+        /* add the peer to our known clients */
+        pmix_pointer_array_add(&pmix_server_globals.clients, attach[n].peer);
+        if (is_primary(attach[n].info, attach[n].ninfo)) {
+            set_primary(attach[n].peer);
+        }
+    }
+
+    PMIX_WAKEUP_THREAD(&cb->lock);
+    PMIX_POST_OBJECT(cb);
+}
+
+pmix_status_t PMIx_tool_attach_to_servers(pmix_proc_t *myproc, pmix_info_t *info[],
+                                          size_t ninfo[], size_t nservers,
+                                          pmix_proc_t servers[], pmix_status_t status[])
+{
+    pmix_ptl_attach_t *attach;
+    pmix_cb_t *cb;
+    size_t n, nattached = 0;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    /* check for bozo error */
+    if (NULL == info || NULL == ninfo || 0 == nservers || NULL == status) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    attach = (pmix_ptl_attach_t *) calloc(nservers, sizeof(pmix_ptl_attach_t));
+    if (NULL == attach) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nservers; n++) {
+        attach[n].peer = new_server_peer();
+        attach[n].info = info[n];
+        attach[n].ninfo = ninfo[n];
+    }
+
+    /* the handshakes block, so they are done here and by the
+     * ptl's threads rather than in the progress thread */
+    pmix_ptl_base_make_connections(attach, nservers);
+
+    /* hook the connected servers into the event base */
+    cb = PMIX_NEW(pmix_cb_t);
+    cb->cbdata = attach;
+    cb->nvals = nservers;
+    PMIX_THREADSHIFT(cb, complete_attach);
+    PMIX_WAIT_THREAD(&cb->lock);
+    cb->cbdata = NULL;
+    PMIX_RELEASE(cb);
+
+    for (n = 0; n < nservers; n++) {
+        status[n] = attach[n].status;
+        if (PMIX_SUCCESS == attach[n].status) {
+            if (NULL != servers) {
+                PMIX_LOAD_PROCID(&servers[n], attach[n].nspace, attach[n].rank);
+            }
+            ++nattached;
+        } else if (PMIX_SUCCESS == rc) {
+            /* report the first failure if none succeeded */
+            rc = attach[n].status;
+        }
+        if (NULL != attach[n].nspace) {
+            free(attach[n].nspace);
+        }
+        if (NULL != attach[n].suri) {
+            free(attach[n].suri);
+        }
+    }
+    free(attach);
+
+    /* if they gave us an address, we pass back our name */
+    if (NULL != myproc) {
+        memcpy(myproc, &pmix_globals.myid, sizeof(pmix_proc_t));
+    }
+
+    if (nattached == nservers) {
+        return PMIX_SUCCESS;
+    }
+    if (0 < nattached) {
+        return PMIX_ERR_PARTIAL_SUCCESS;
+    }
+    return rc;
+}
+
 static void disc(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
@@ -1853,6 +2019,418 @@ pmix_status_t PMIx_tool_get_servers(pmix_proc_t *servers[], size_t *nservers)
     return rc;
 }
 
+/* a query sent to several servers at once - each server's reply
+ * lands in its slot, and the caller is called back once all of them
+ * have replied or the timeout fired */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_timer_t timer;
+    pmix_proc_t *servers;
+    size_t nservers;
+    pmix_query_t *queries;
+    size_t nqueries;
+    double timeout;
+    pmix_status_t *status;
+    pmix_info_t **info;
+    size_t *ninfo;
+    size_t npending;
+    bool completed;
+    pmix_info_t *results;
+    pmix_info_cbfunc_t cbfunc;
+    void *cbdata;
+} pmix_fanout_t;
+
+static void focon(pmix_fanout_t *p)
+{
+    pmix_timer_construct(&p->timer);
+    p->servers = NULL;
+    p->nservers = 0;
+    p->queries = NULL;
+    p->nqueries = 0;
+    p->timeout = 0.0;
+    p->status = NULL;
+    p->info = NULL;
+    p->ninfo = NULL;
+    p->npending = 0;
+    p->completed = false;
+    p->results = NULL;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void fodes(pmix_fanout_t *p)
+{
+    size_t n;
+
+    for (n = 0; n < p->nservers; n++) {
+        if (NULL != p->info && NULL != p->info[n]) {
+            PMIX_INFO_FREE(p->info[n], p->ninfo[n]);
+        }
+    }
+    if (NULL != p->results) {
+        PMIX_INFO_FREE(p->results, p->nservers);
+    }
+    if (NULL != p->servers) {
+        PMIX_PROC_FREE(p->servers, p->nservers);
+    }
+    if (NULL != p->status) {
+        free(p->status);
+    }
+    if (NULL != p->info) {
+        free(p->info);
+    }
+    if (NULL != p->ninfo) {
+        free(p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_fanout_t, pmix_object_t, focon, fodes);
+
+typedef struct {
+    pmix_object_t super;
+    pmix_fanout_t *fan;
+    size_t idx;
+} pmix_fanout_reply_t;
+
+static void frcon(pmix_fanout_reply_t *p)
+{
+    p->fan = NULL;
+    p->idx = 0;
+}
+static void frdes(pmix_fanout_reply_t *p)
+{
+    if (NULL != p->fan) {
+        PMIX_RELEASE(p->fan);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_fanout_reply_t, pmix_object_t, frcon, frdes);
+
+static void fanout_release(void *cbdata)
+{
+    pmix_fanout_t *fan = (pmix_fanout_t *) cbdata;
+
+    PMIX_RELEASE(fan);
+}
+
+static void fanout_complete(pmix_fanout_t *fan)
+{
+    pmix_info_t *srv;
+    pmix_data_array_t *darray;
+    pmix_status_t rc = PMIX_SUCCESS;
+    size_t n, m, nok = 0;
+
+    fan->completed = true;
+    pmix_timer_del(&fan->timer);
+
+    PMIX_INFO_CREATE(fan->results, fan->nservers);
+    for (n = 0; n < fan->nservers; n++) {
+        if (PMIX_SUCCESS == fan->status[n]) {
+            ++nok;
+        } else if (PMIX_SUCCESS == rc) {
+            rc = fan->status[n];
+        }
+        PMIX_DATA_ARRAY_CREATE(darray, 3 + fan->ninfo[n], PMIX_INFO);
+        srv = (pmix_info_t *) darray->array;
+        PMIX_INFO_LOAD(&srv[0], PMIX_SERVER_NSPACE, fan->servers[n].nspace, PMIX_STRING);
+        PMIX_INFO_LOAD(&srv[1], PMIX_SERVER_RANK, &fan->servers[n].rank, PMIX_PROC_RANK);
+        PMIX_INFO_LOAD(&srv[2], PMIX_QUERY_SERVER_STATUS, &fan->status[n], PMIX_STATUS);
+        for (m = 0; m < fan->ninfo[n]; m++) {
+            PMIX_INFO_XFER(&srv[3 + m], &fan->info[n][m]);
+        }
+        PMIX_LOAD_KEY(fan->results[n].key, PMIX_SERVER_INFO_ARRAY);
+        fan->results[n].value.type = PMIX_DATA_ARRAY;
+        fan->results[n].value.data.darray = darray;
+    }
+    if (nok == fan->nservers) {
+        rc = PMIX_SUCCESS;
+    } else if (0 < nok) {
+        rc = PMIX_ERR_PARTIAL_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:tool query of %lu servers complete: %lu succeeded",
+                        (unsigned long) fan->nservers, (unsigned long) nok);
+
+    if (NULL != fan->cbfunc) {
+        PMIX_RETAIN(fan);
+        fan->cbfunc(rc, fan->results, fan->nservers, fan->cbdata, fanout_release, fan);
+    }
+}
+
+static void fanout_timeout(int sd, short args, void *cbdata)
+{
+    pmix_fanout_t *fan = (pmix_fanout_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    /* the servers that have not replied keep their
+     * timeout status, and their late replies are dropped */
+    fan->npending = 0;
+    fanout_complete(fan);
+}
+
+static void fanout_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
+                          pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_fanout_reply_t *reply = (pmix_fanout_reply_t *) cbdata;
+    pmix_fanout_t *fan = reply->fan;
+    size_t idx = reply->idx, ninfo;
+    pmix_status_t rc, status;
+    int cnt;
+    PMIX_HIDE_UNUSED_PARAMS(hdr);
+
+    if (fan->completed) {
+        /* arrived after the timeout */
+        PMIX_RELEASE(reply);
+        return;
+    }
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection */
+    if (NULL == buf || PMIX_BUFFER_IS_EMPTY(buf)) {
+        fan->status[idx] = PMIX_ERR_UNREACH;
+        goto done;
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &status, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        fan->status[idx] = rc;
+        goto done;
+    }
+    fan->status[idx] = status;
+    if (PMIX_SUCCESS != status) {
+        goto done;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &ninfo, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        fan->status[idx] = rc;
+        goto done;
+    }
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(fan->info[idx], ninfo);
+        fan->ninfo[idx] = ninfo;
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, fan->info[idx], &cnt, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_INFO_FREE(fan->info[idx], fan->ninfo[idx]);
+            fan->info[idx] = NULL;
+            fan->ninfo[idx] = 0;
+            fan->status[idx] = rc;
+        }
+    }
+
+done:
+    if (0 == --fan->npending) {
+        fanout_complete(fan);
+    }
+    PMIX_RELEASE(reply);
+}
+
+static pmix_peer_t *find_server(const pmix_proc_t *proc)
+{
+    pmix_peer_t *pr;
+    int n;
+
+    for (n = 0; n < pmix_server_globals.clients.size; n++) {
+        pr = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, n);
+        if (NULL != pr && PMIX_CHECK_NSPACE(proc->nspace, pr->info->pname.nspace)
+            && PMIX_CHECK_RANK(proc->rank, pr->info->pname.rank)) {
+            return pr;
+        }
+    }
+    return NULL;
+}
+
+static void fanout(int sd, short args, void *cbdata)
+{
+    pmix_fanout_t *fan = (pmix_fanout_t *) cbdata;
+    pmix_cmd_t cmd = PMIX_QUERY_CMD;
+    pmix_fanout_reply_t *reply;
+    pmix_buffer_t *msg;
+    pmix_peer_t *pr;
+    pmix_status_t rc;
+    size_t n;
+    int i;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(fan);
+
+    if (NULL == fan->servers) {
+        /* all the servers we are attached to */
+        for (i = 0; i < pmix_server_globals.clients.size; i++) {
+            if (NULL != pmix_pointer_array_get_item(&pmix_server_globals.clients, i)) {
+                ++fan->nservers;
+            }
+        }
+        if (0 < fan->nservers) {
+            PMIX_PROC_CREATE(fan->servers, fan->nservers);
+        }
+        n = 0;
+        for (i = 0; i < pmix_server_globals.clients.size && n < fan->nservers; i++) {
+            pr = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, i);
+            if (NULL != pr) {
+                PMIX_LOAD_PROCID(&fan->servers[n], pr->info->pname.nspace, pr->info->pname.rank);
+                ++n;
+            }
+        }
+    }
+    if (0 == fan->nservers) {
+        if (NULL != fan->cbfunc) {
+            fan->cbfunc(PMIX_ERR_UNREACH, NULL, 0, fan->cbdata, NULL, NULL);
+        }
+        PMIX_RELEASE(fan);
+        return;
+    }
+
+    fan->status = (pmix_status_t *) malloc(fan->nservers * sizeof(pmix_status_t));
+    fan->info = (pmix_info_t **) calloc(fan->nservers, sizeof(pmix_info_t *));
+    fan->ninfo = (size_t *) calloc(fan->nservers, sizeof(size_t));
+    for (n = 0; n < fan->nservers; n++) {
+        fan->status[n] = PMIX_ERR_TIMEOUT;
+    }
+
+    /* keep a count of one while sending so a reply that comes
+     * back at once cannot complete the operation under us */
+    fan->npending = 1;
+    for (n = 0; n < fan->nservers; n++) {
+        pr = find_server(&fan->servers[n]);
+        if (NULL == pr) {
+            fan->status[n] = PMIX_ERR_NOT_FOUND;
+            continue;
+        }
+        msg = PMIX_NEW(pmix_buffer_t);
+        PMIX_BFROPS_PACK(rc, pr, msg, &cmd, 1, PMIX_COMMAND);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pr, msg, &fan->nqueries, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pr, msg, fan->queries, fan->nqueries, PMIX_QUERY);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(msg);
+            fan->status[n] = rc;
+            continue;
+        }
+        reply = PMIX_NEW(pmix_fanout_reply_t);
+        PMIX_RETAIN(fan);
+        reply->fan = fan;
+        reply->idx = n;
+        PMIX_PTL_SEND_RECV(rc, pr, msg, fanout_cbfunc, (void *) reply);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(msg);
+            PMIX_RELEASE(reply);
+            fan->status[n] = rc;
+            continue;
+        }
+        ++fan->npending;
+    }
+
+    if (0 == --fan->npending) {
+        fanout_complete(fan);
+    } else if (0.0 < fan->timeout) {
+        /* the replies hold their own references */
+        pmix_timer_add(&fan->timer, fan->timeout, fanout_timeout, fan);
+    }
+    PMIX_RELEASE(fan);
+}
+
+pmix_status_t PMIx_tool_query_servers_nb(const pmix_proc_t servers[], size_t nservers,
+                                         pmix_query_t queries[], size_t nqueries,
+                                         pmix_info_t info[], size_t ninfo,
+                                         pmix_info_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_fanout_t *fan;
+    size_t n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == queries || 0 == nqueries || (NULL != servers && 0 == nservers)) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    fan = PMIX_NEW(pmix_fanout_t);
+    if (NULL == fan) {
+        return PMIX_ERR_NOMEM;
+    }
+    if (NULL != servers) {
+        PMIX_PROC_CREATE(fan->servers, nservers);
+        memcpy(fan->servers, servers, nservers * sizeof(pmix_proc_t));
+        fan->nservers = nservers;
+    }
+    fan->queries = queries;
+    fan->nqueries = nqueries;
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
+            fan->timeout = (double) info[n].value.data.integer;
+        }
+    }
+    fan->cbfunc = cbfunc;
+    fan->cbdata = cbdata;
+    PMIX_THREADSHIFT(fan, fanout);
+    return PMIX_SUCCESS;
+}
+
+static void fanout_block(pmix_status_t status, pmix_info_t info[], size_t ninfo, void *cbdata,
+                         pmix_release_cbfunc_t release_fn, void *release_cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    size_t n;
+
+    cb->status = status;
+    if (NULL != info) {
+        cb->ninfo = ninfo;
+        PMIX_INFO_CREATE(cb->info, cb->ninfo);
+        for (n = 0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&cb->info[n], &info[n]);
+        }
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    PMIX_WAKEUP_THREAD(&cb->lock);
+}
+
+pmix_status_t PMIx_tool_query_servers(const pmix_proc_t servers[], size_t nservers,
+                                      pmix_query_t queries[], size_t nqueries,
+                                      pmix_info_t info[], size_t ninfo,
+                                      pmix_info_t **results, size_t *nresults)
+{
+    pmix_cb_t cb;
+    pmix_status_t rc;
+
+    if (NULL == results || NULL == nresults) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *results = NULL;
+    *nresults = 0;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    rc = PMIx_tool_query_servers_nb(servers, nservers, queries, nqueries, info, ninfo,
+                                    fanout_block, (void *) &cb);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    PMIX_WAIT_THREAD(&cb.lock);
+    rc = cb.status;
+    *results = cb.info;
+    *nresults = cb.ninfo;
+    cb.info = NULL;
+    cb.ninfo = 0;
+    PMIX_DESTRUCT(&cb);
+
+    return rc;
+}
+
 static void retry_set(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
@@ -182,6 +182,14 @@ int main(int argc, char *argv[])
         pmix_info_do_type();
         acted = true;
     }
+    if (pmix_cmd_line_is_taken(pmix_info_cmd_line, "compress")) {
+        pmix_info_do_compress();
+        acted = true;
+    }
+    if (pmix_cmd_line_is_taken(pmix_info_cmd_line, "perf")) {
+        pmix_info_do_perf();
+        acted = true;
+    }
 
     /* If no command line args are specified, show default set */
 
@@ -37,9 +37,13 @@
 #endif
 
 #include <errno.h>
+#include <stdio.h>
+#include <sys/time.h>
 
+#include "include/pmix_tool.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
+#include "src/include/pmix_globals.h"
 #include "src/runtime/pmix_rte.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_cmd_line.h"
@@ -50,10 +54,16 @@
 
 #include "src/include/pmix_frameworks.h"
 #include "src/include/pmix_portable_platform.h"
+#include "src/include/pmix_stdint.h"
 
 #include "pinfo.h"
 #include "src/mca/base/pmix_mca_base_component_repository.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/mca/gds/base/base.h"
+#include "src/mca/pcompress/base/base.h"
 #include "src/mca/pinstalldirs/pinstalldirs.h"
+#include "src/mca/preg/preg.h"
+#include "src/mca/psquash/psquash.h"
 #include "support.h"
 
 const char *pmix_info_path_prefix = "prefix";
@@ -123,8 +133,10 @@ static struct option poptions[] = {
     PMIX_OPTION_SHORT_DEFINE("all", PMIX_ARG_NONE, 'a'),
     PMIX_OPTION_DEFINE("arch", PMIX_ARG_NONE),
     PMIX_OPTION_SHORT_DEFINE("config", PMIX_ARG_NONE, 'c'),
+    PMIX_OPTION_DEFINE("compress", PMIX_ARG_OPTIONAL),
     PMIX_OPTION_DEFINE("hostname", PMIX_ARG_NONE),
     PMIX_OPTION_DEFINE("param", PMIX_ARG_REQD),
+    PMIX_OPTION_DEFINE("perf", PMIX_ARG_NONE),
     PMIX_OPTION_DEFINE("path", PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE("show-version", PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE("pretty-print", PMIX_ARG_NONE),
@@ -684,6 +696,546 @@ void pmix_info_do_hostname(void)
     pmix_info_out("Configure host", "config:host", PMIX_CONFIGURE_HOST);
 }
 
+static double compress_time_usec(struct timeval *start)
+{
+    struct timeval end;
+
+    gettimeofday(&end, NULL);
+    return (double) (end.tv_sec - start->tv_sec) * 1000000.0
+           + (double) (end.tv_usec - start->tv_usec);
+}
+
+/* the default samples - a comma-delimited list of node names
+ * such as is found in a regular expression, and a block of
+ * key-value records such as is found in a modex blob */
+static char *compress_string_sample(void)
+{
+    char **nodes = NULL, name[64], *str;
+    int n;
+
+    for (n = 0; n < 16384; n++) {
+        snprintf(name, sizeof(name), "node%05d", n);
+        pmix_argv_append_nosize(&nodes, name);
+    }
+    str = pmix_argv_join(nodes, ',');
+    pmix_argv_free(nodes);
+    return str;
+}
+
+static uint8_t *compress_block_sample(size_t *size)
+{
+    pmix_cli_item_t *opt;
+    uint8_t *block, *ptr;
+    size_t n, len, total;
+    uint32_t rank;
+    FILE *fp;
+    long fsize;
+
+    opt = pmix_cmd_line_get_param(pmix_info_cmd_line, "compress");
+    if (NULL != opt && NULL != opt->values && NULL != opt->values[0]) {
+        fp = fopen(opt->values[0], "r");
+        if (NULL == fp) {
+            fprintf(stderr, "Could not open %s: %s\n", opt->values[0], strerror(errno));
+            return NULL;
+        }
+        fseek(fp, 0, SEEK_END);
+        fsize = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+        block = NULL;
+        if (0 < fsize && NULL != (block = (uint8_t *) malloc(fsize))) {
+            *size = fread(block, 1, fsize, fp);
+        }
+        fclose(fp);
+        return block;
+    }
+
+    total = 4 * 1024 * 1024;
+    block = (uint8_t *) malloc(total);
+    if (NULL == block) {
+        return NULL;
+    }
+    ptr = block;
+    for (n = 0; ptr + 128 < block + total; n++) {
+        rank = n;
+        memcpy(ptr, &rank, sizeof(rank));
+        ptr += sizeof(rank);
+        len = snprintf((char *) ptr, 120, "pmix.hostname%cnode%05u%cpmix.lrank%c%u%c",
+                       '\0', (unsigned) (n / 64), '\0', '\0', (unsigned) (n % 64), '\0');
+        ptr += len + 1;
+    }
+    *size = ptr - block;
+    return block;
+}
+
+static void compress_report(const char *component, const char *class, size_t inlen,
+                            bool compressed, size_t outlen, double ctime, double dtime)
+{
+    char *pretty, *plain, *value;
+
+    if (0 > asprintf(&pretty, "%s %s", component, class)) {
+        return;
+    }
+    if (0 > asprintf(&plain, "pcompress:%s:%s", component, class)) {
+        free(pretty);
+        return;
+    }
+    if (!compressed) {
+        if (0 > asprintf(&value, "%" PRIsize_t " bytes not compressed", inlen)) {
+            value = NULL;
+        }
+    } else if (0 > asprintf(&value, "%" PRIsize_t " -> %" PRIsize_t " bytes, ratio %.2f, "
+                            "compress %.1f MB/s, decompress %.1f MB/s",
+                            inlen, outlen, (double) inlen / (double) outlen,
+                            (double) inlen / ctime, (double) inlen / dtime)) {
+        value = NULL;
+    }
+    if (NULL != value) {
+        pmix_info_out(pretty, plain, value);
+        free(value);
+    }
+    free(pretty);
+    free(plain);
+}
+
+void pmix_info_do_compress(void)
+{
+    pmix_mca_base_component_list_item_t *cli;
+    pmix_compress_base_module_t *module;
+    pmix_mca_base_module_t *mod;
+    struct timeval start;
+    char *string, *str2;
+    uint8_t *block, *out, *back;
+    size_t slen, blen = 0, outlen, backlen;
+    double ctime, dtime;
+    bool ok;
+    int priority, n, reps = 5;
+
+    if (PMIX_SUCCESS != pmix_mca_base_framework_open(&pmix_pcompress_base_framework,
+                                                     PMIX_MCA_BASE_OPEN_DEFAULT)) {
+        fprintf(stderr, "Could not open the pcompress framework\n");
+        return;
+    }
+
+    string = compress_string_sample();
+    slen = strlen(string);
+    block = compress_block_sample(&blen);
+    if (NULL == block) {
+        free(string);
+        return;
+    }
+
+    PMIX_LIST_FOREACH (cli, &pmix_pcompress_base_framework.framework_components,
+                       pmix_mca_base_component_list_item_t) {
+        if (NULL == cli->cli_component->pmix_mca_query_component
+            || PMIX_SUCCESS != cli->cli_component->pmix_mca_query_component(&mod, &priority)
+            || NULL == mod) {
+            continue;
+        }
+        module = (pmix_compress_base_module_t *) mod;
+        if (NULL != module->init && PMIX_SUCCESS != module->init()) {
+            continue;
+        }
+
+        /* string payload */
+        ctime = dtime = 0.0;
+        outlen = 0;
+        ok = true;
+        for (n = 0; ok && n < reps; n++) {
+            out = NULL;
+            gettimeofday(&start, NULL);
+            ok = module->compress_string(string, &out, &outlen);
+            ctime += compress_time_usec(&start);
+            if (ok) {
+                str2 = NULL;
+                gettimeofday(&start, NULL);
+                ok = module->decompress_string(&str2, out, outlen);
+                dtime += compress_time_usec(&start);
+                if (ok && 0 != strcmp(string, str2)) {
+                    fprintf(stderr, "%s: string round trip failed\n",
+                            cli->cli_component->pmix_mca_component_name);
+                    ok = false;
+                }
+                free(str2);
+            }
+            free(out);
+        }
+        compress_report(cli->cli_component->pmix_mca_component_name, "string", slen,
+                        ok, outlen, ctime / reps, dtime / reps);
+
+        /* data block payload */
+        ctime = dtime = 0.0;
+        outlen = 0;
+        ok = true;
+        for (n = 0; ok && n < reps; n++) {
+            out = NULL;
+            gettimeofday(&start, NULL);
+            ok = module->compress(block, blen, &out, &outlen);
+            ctime += compress_time_usec(&start);
+            if (ok) {
+                back = NULL;
+                gettimeofday(&start, NULL);
+                ok = module->decompress(&back, &backlen, out, outlen);
+                dtime += compress_time_usec(&start);
+                if (ok && (backlen != blen || 0 != memcmp(block, back, blen))) {
+                    fprintf(stderr, "%s: block round trip failed\n",
+                            cli->cli_component->pmix_mca_component_name);
+                    ok = false;
+                }
+                free(back);
+            }
+            free(out);
+        }
+        compress_report(cli->cli_component->pmix_mca_component_name, "block", blen,
+                        ok, outlen, ctime / reps, dtime / reps);
+
+        if (NULL != module->finalize) {
+            module->finalize();
+        }
+    }
+
+    free(string);
+    free(block);
+}
+
+/* The performance report. The library is started as a tool that
+ * connects to nobody so that the components it selects on this
+ * platform are the ones measured, exactly as a client or tool here
+ * would use them */
+
+static void perf_out(const char *framework, const char *component, const char *test,
+                     const char *value)
+{
+    char *pretty, *plain;
+
+    if (0 > asprintf(&pretty, "%s %s %s", framework, component, test)) {
+        return;
+    }
+    if (0 > asprintf(&plain, "perf:%s:%s:%s", framework, component, test)) {
+        free(pretty);
+        return;
+    }
+    pmix_info_out(pretty, plain, value);
+    free(pretty);
+    free(plain);
+}
+
+static void perf_bfrops_run(pmix_bfrops_module_t *module, const char *test, void *src,
+                            int32_t nvals, pmix_data_type_t type, int reps)
+{
+    pmix_buffer_t buf;
+    struct timeval start;
+    double ptime = 0.0, utime = 0.0;
+    size_t bytes = 0;
+    int32_t cnt;
+    pmix_info_t *info;
+    void *dest;
+    pmix_status_t rc = PMIX_SUCCESS;
+    char value[256];
+    int n;
+
+    for (n = 0; PMIX_SUCCESS == rc && n < reps; n++) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        buf.type = pmix_bfrops_globals.default_type;
+        gettimeofday(&start, NULL);
+        rc = module->pack(&buf, src, nvals, type);
+        ptime += compress_time_usec(&start);
+        if (PMIX_SUCCESS == rc) {
+            bytes = buf.bytes_used;
+            if (PMIX_INFO == type) {
+                PMIX_INFO_CREATE(info, nvals);
+                dest = info;
+            } else {
+                dest = malloc(nvals * sizeof(uint32_t));
+            }
+            cnt = nvals;
+            gettimeofday(&start, NULL);
+            rc = module->unpack(&buf, dest, &cnt, type);
+            utime += compress_time_usec(&start);
+            if (PMIX_INFO == type) {
+                PMIX_INFO_FREE(info, nvals);
+            } else {
+                free(dest);
+            }
+        }
+        PMIX_DESTRUCT(&buf);
+    }
+    if (PMIX_SUCCESS != rc) {
+        snprintf(value, sizeof(value), "failed: %s", PMIx_Error_string(rc));
+    } else {
+        ptime /= reps;
+        utime /= reps;
+        snprintf(value, sizeof(value),
+                 "%d values in %" PRIsize_t " bytes, pack %.1f MB/s (%.0f values/s), "
+                 "unpack %.1f MB/s (%.0f values/s)",
+                 nvals, bytes, (double) bytes / ptime, (double) nvals * 1000000.0 / ptime,
+                 (double) bytes / utime, (double) nvals * 1000000.0 / utime);
+    }
+    perf_out("bfrops", module->version, test, value);
+}
+
+static void perf_bfrops(int reps)
+{
+    pmix_bfrops_base_active_module_t *active;
+    pmix_info_t *info;
+    uint32_t *ints;
+    char name[64];
+    uint16_t lrank;
+    int32_t n, ninfo = 16384, nints = 1048576;
+
+    /* job-level info as it is registered, and a block of
+     * integers such as a map of ranks */
+    PMIX_INFO_CREATE(info, ninfo);
+    for (n = 0; n < ninfo; n++) {
+        if (0 == n % 2) {
+            snprintf(name, sizeof(name), "node%05d", n);
+            PMIX_INFO_LOAD(&info[n], PMIX_HOSTNAME, name, PMIX_STRING);
+        } else {
+            lrank = n % 64;
+            PMIX_INFO_LOAD(&info[n], PMIX_LOCAL_RANK, &lrank, PMIX_UINT16);
+        }
+    }
+    ints = (uint32_t *) malloc(nints * sizeof(uint32_t));
+    for (n = 0; n < nints; n++) {
+        ints[n] = n;
+    }
+
+    PMIX_LIST_FOREACH (active, &pmix_bfrops_globals.actives, pmix_bfrops_base_active_module_t) {
+        perf_bfrops_run(active->module, "info", info, ninfo, PMIX_INFO, reps);
+        perf_bfrops_run(active->module, "uint32", ints, nints, PMIX_UINT32, reps);
+    }
+
+    PMIX_INFO_FREE(info, ninfo);
+    free(ints);
+}
+
+static void perf_psquash(int reps)
+{
+    uint64_t *vals, *back;
+    uint8_t *enc;
+    size_t n, nvals = 1048576, max, len = 0, used, dlen;
+    struct timeval start;
+    double etime = 0.0, dtime = 0.0;
+    pmix_status_t rc;
+    char value[256];
+    int r;
+
+    if (NULL == pmix_psquash.encode_int || NULL == pmix_psquash.get_max_size) {
+        return;
+    }
+    rc = pmix_psquash.get_max_size(PMIX_UINT64, &max);
+    if (PMIX_SUCCESS != rc) {
+        return;
+    }
+    /* mostly small values - ranks, counts and sizes - with
+     * the odd large one */
+    vals = (uint64_t *) malloc(nvals * sizeof(uint64_t));
+    back = (uint64_t *) malloc(nvals * sizeof(uint64_t));
+    enc = (uint8_t *) malloc(nvals * max);
+    if (NULL == vals || NULL == back || NULL == enc) {
+        free(vals);
+        free(back);
+        free(enc);
+        return;
+    }
+    for (n = 0; n < nvals; n++) {
+        vals[n] = (0 == n % 64) ? (uint64_t) n << 32 : n % 4096;
+    }
+
+    for (r = 0; PMIX_SUCCESS == rc && r < reps; r++) {
+        gettimeofday(&start, NULL);
+        if (NULL != pmix_psquash.encode_int_array) {
+            rc = pmix_psquash.encode_int_array(PMIX_UINT64, vals, nvals, enc, &len);
+        } else {
+            for (n = 0, len = 0; PMIX_SUCCESS == rc && n < nvals; n++) {
+                rc = (pmix_psquash.encode_int)(PMIX_UINT64, &vals[n], enc + len, &used);
+                len += used;
+            }
+        }
+        etime += compress_time_usec(&start);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        gettimeofday(&start, NULL);
+        if (NULL != pmix_psquash.decode_int_array) {
+            rc = pmix_psquash.decode_int_array(PMIX_UINT64, enc, len, nvals, back, &used);
+        } else {
+            for (n = 0, used = 0; PMIX_SUCCESS == rc && n < nvals; n++) {
+                rc = (pmix_psquash.decode_int)(PMIX_UINT64, enc + used, len - used, &back[n], &dlen);
+                used += dlen;
+            }
+        }
+        dtime += compress_time_usec(&start);
+        if (PMIX_SUCCESS == rc && 0 != memcmp(vals, back, nvals * sizeof(uint64_t))) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+        }
+    }
+
+    if (PMIX_SUCCESS != rc) {
+        snprintf(value, sizeof(value), "failed: %s", PMIx_Error_string(rc));
+    } else {
+        etime /= reps;
+        dtime /= reps;
+        snprintf(value, sizeof(value),
+                 "%" PRIsize_t " values in %" PRIsize_t " bytes (%.2f bytes/value), "
+                 "encode %.1f Mvalues/s, decode %.1f Mvalues/s",
+                 nvals, len, (double) len / (double) nvals,
+                 (double) nvals / etime, (double) nvals / dtime);
+    }
+    perf_out("psquash", pmix_psquash.name, "uint64", value);
+
+    free(vals);
+    free(back);
+    free(enc);
+}
+
+static void perf_gds(pmix_proc_t *myproc)
+{
+    pmix_gds_base_module_t *module = pmix_globals.mypeer->nptr->compat.gds;
+    pmix_proc_t proc;
+    pmix_kval_t *kv;
+    pmix_cb_t cb;
+    struct timeval start;
+    double stime = 0.0, ftime = 0.0;
+    pmix_status_t rc = PMIX_SUCCESS;
+    char key[PMIX_MAX_KEYLEN + 1], value[256];
+    uint32_t r, k, nranks = 1024, nkeys = 16;
+
+    /* what a modex leaves behind - a few values for each proc */
+    for (r = 0; PMIX_SUCCESS == rc && r < nranks; r++) {
+        PMIX_LOAD_PROCID(&proc, myproc->nspace, r);
+        for (k = 0; PMIX_SUCCESS == rc && k < nkeys; k++) {
+            snprintf(key, sizeof(key), "pmix.perf.%u", k);
+            PMIX_KVAL_NEW(kv, key);
+            if (NULL == kv) {
+                rc = PMIX_ERR_NOMEM;
+                break;
+            }
+            kv->value->type = PMIX_UINT32;
+            kv->value->data.uint32 = r * nkeys + k;
+            gettimeofday(&start, NULL);
+            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &proc, PMIX_REMOTE, kv);
+            stime += compress_time_usec(&start);
+            PMIX_RELEASE(kv);
+        }
+    }
+    for (r = 0; PMIX_SUCCESS == rc && r < nranks; r++) {
+        PMIX_LOAD_PROCID(&proc, myproc->nspace, r);
+        for (k = 0; PMIX_SUCCESS == rc && k < nkeys; k++) {
+            snprintf(key, sizeof(key), "pmix.perf.%u", k);
+            PMIX_CONSTRUCT(&cb, pmix_cb_t);
+            cb.proc = &proc;
+            cb.key = key;
+            cb.scope = PMIX_SCOPE_UNDEF;
+            cb.copy = false;
+            gettimeofday(&start, NULL);
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+            ftime += compress_time_usec(&start);
+            if (PMIX_OPERATION_SUCCEEDED == rc) {
+                rc = PMIX_SUCCESS;
+            }
+            if (PMIX_SUCCESS == rc && 1 != pmix_list_get_size(&cb.kvs)) {
+                rc = PMIX_ERR_NOT_FOUND;
+            }
+            PMIX_DESTRUCT(&cb);
+        }
+    }
+
+    if (PMIX_SUCCESS != rc) {
+        snprintf(value, sizeof(value), "failed: %s", PMIx_Error_string(rc));
+    } else {
+        snprintf(value, sizeof(value), "%u values, store %.2f usec, fetch %.2f usec",
+                 nranks * nkeys, stime / (nranks * nkeys), ftime / (nranks * nkeys));
+    }
+    perf_out("gds", module->name, "store/fetch", value);
+}
+
+static void perf_preg(int reps)
+{
+    char *input, *regex = NULL, **names = NULL, *component;
+    struct timeval start;
+    double gtime = 0.0, ptime = 0.0;
+    size_t nnodes, len = 0;
+    pmix_status_t rc = PMIX_SUCCESS;
+    char value[256];
+    int n;
+
+    input = compress_string_sample();
+    if (NULL == input) {
+        return;
+    }
+    nnodes = 1;
+    for (n = 0; '\0' != input[n]; n++) {
+        if (',' == input[n]) {
+            ++nnodes;
+        }
+    }
+
+    for (n = 0; PMIX_SUCCESS == rc && n < reps; n++) {
+        if (NULL != regex) {
+            free(regex);
+            regex = NULL;
+        }
+        gettimeofday(&start, NULL);
+        rc = pmix_preg.generate_node_regex(input, &regex);
+        gtime += compress_time_usec(&start);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        gettimeofday(&start, NULL);
+        rc = pmix_preg.parse_nodes(regex, &names);
+        ptime += compress_time_usec(&start);
+        if (PMIX_SUCCESS == rc && nnodes != (size_t) pmix_argv_count(names)) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+        }
+        pmix_argv_free(names);
+        names = NULL;
+    }
+
+    /* the regex names the component that generated it */
+    component = NULL;
+    if (PMIX_SUCCESS == rc && NULL != regex) {
+        len = strlen(regex);
+        component = strndup(regex, strcspn(regex, "[:"));
+    }
+    if (PMIX_SUCCESS != rc) {
+        snprintf(value, sizeof(value), "failed: %s", PMIx_Error_string(rc));
+    } else {
+        snprintf(value, sizeof(value),
+                 "%" PRIsize_t " nodes in %" PRIsize_t " bytes, generate %.2f msec, "
+                 "parse %.2f msec",
+                 nnodes, len, gtime / reps / 1000.0, ptime / reps / 1000.0);
+    }
+    perf_out("preg", (NULL == component) ? "base" : component, "nodes", value);
+
+    free(component);
+    free(regex);
+    free(input);
+}
+
+void pmix_info_do_perf(void)
+{
+    pmix_proc_t myproc;
+    pmix_info_t info;
+    pmix_status_t rc;
+    int reps = 5;
+
+    PMIX_INFO_LOAD(&info, PMIX_TOOL_DO_NOT_CONNECT, NULL, PMIX_BOOL);
+    rc = PMIx_tool_init(&myproc, &info, 1);
+    PMIX_INFO_DESTRUCT(&info);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_tool_init failed: %s\n", PMIx_Error_string(rc));
+        return;
+    }
+
+    perf_bfrops(reps);
+    perf_psquash(reps);
+    pmix_info_do_compress();
+    perf_gds(&myproc);
+    perf_preg(reps);
+
+    PMIx_tool_finalize();
+}
+
 static char *escape_quotes(const char *value)
 {
     const char *src;
@@ -90,6 +90,10 @@ PMIX_EXPORT void pmix_info_do_arch(void);
 
 PMIX_EXPORT void pmix_info_do_hostname(void);
 
+PMIX_EXPORT void pmix_info_do_compress(void);
+
+PMIX_EXPORT void pmix_info_do_perf(void);
+
 PMIX_EXPORT void pmix_info_do_type(void);
 
 PMIX_EXPORT void pmix_info_out(const char *pretty_message, const char *plain_message,
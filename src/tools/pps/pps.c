@@ -118,6 +118,7 @@ static struct option ppsoptions[] = {
     PMIX_OPTION_DEFINE(PMIX_CLI_NAMESPACE, PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE(PMIX_CLI_URI, PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE("nodes", PMIX_ARG_NONE),
+    PMIX_OPTION_DEFINE("tree", PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE(PMIX_CLI_TMPDIR, PMIX_ARG_REQD),
 
     PMIX_OPTION_END
@@ -210,6 +211,8 @@ int main(int argc, char *argv[])
     myquery_data_t myquery_data;
     mylock_t mylock;
     pmix_cli_result_t results;
+    pmix_cli_item_t *opt;
+    uint32_t radix;
     PMIX_HIDE_UNUSED_PARAMS(argc);
 
     /* protect against problems if someone passes us thru a pipe
@@ -306,6 +309,12 @@ int main(int argc, char *argv[])
     nq = 1;
     PMIX_QUERY_CREATE(query, nq);
     PMIX_ARGV_APPEND(rc, query[0].keys, PMIX_QUERY_NAMESPACES);
+    /* let the host gather the answer through a tree of its servers */
+    if (NULL != (opt = pmix_cmd_line_get_param(&results, "tree"))) {
+        radix = strtoul(opt->values[0], NULL, 10);
+        PMIX_QUERY_QUALIFIERS_CREATE(&query[0], 1);
+        PMIX_INFO_LOAD(&query[0].qualifiers[0], PMIX_QUERY_TREE_RADIX, &radix, PMIX_UINT32);
+    }
     /* setup the caddy to retrieve the data */
     PMIX_CONSTRUCT_LOCK(&myquery_data.lock.lock);
     myquery_data.info = NULL;
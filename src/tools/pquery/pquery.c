@@ -75,12 +75,43 @@ typedef struct {
  * Once we have dealt with the returned data, we must
  * call the release_fn so that the PMIx library can
  * cleanup */
+static bool stream = false;
+
+static void print_results(pmix_info_t *info, size_t ninfo)
+{
+    const char *attr;
+    char *result;
+    size_t n;
+
+    for (n = 0; n < ninfo; n++) {
+        if (NULL == (attr = pmix_attributes_reverse_lookup(info[n].key))) {
+            fprintf(stdout, "%s: ", info[n].key);
+        } else {
+            fprintf(stdout, "%s: ", attr);
+        }
+        fprintf(stdout, "\n");
+        result = PMIx_Value_string(&info[n].value);
+        fprintf(stderr, "  %s\n", (NULL == result) ? "NULL" : result);
+        free(result);
+    }
+}
+
 static void querycbfunc(pmix_status_t status, pmix_info_t *info, size_t ninfo, void *cbdata,
                         pmix_release_cbfunc_t release_fn, void *release_cbdata)
 {
     myquery_data_t *mq = (myquery_data_t *) cbdata;
     size_t n;
 
+    if (stream && PMIX_QUERY_PARTIAL_SUCCESS == status) {
+        /* a batch of a streamed answer - print it as it comes
+         * and keep waiting for the rest */
+        print_results(info, ninfo);
+        if (NULL != release_fn) {
+            release_fn(release_cbdata);
+        }
+        return;
+    }
+
     fprintf(stderr, "pquery: Query returned status %s\n", PMIx_Error_string(status));
     mq->status = status;
     /* save the returned info - the PMIx library "owns" it
@@ -154,6 +185,8 @@ static struct option pqoptions[] = {
     PMIX_OPTION_DEFINE(PMIX_CLI_NAMESPACE, PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE(PMIX_CLI_URI, PMIX_ARG_REQD),
     PMIX_OPTION_DEFINE(PMIX_CLI_TMPDIR, PMIX_ARG_REQD),
+    PMIX_OPTION_DEFINE("tree", PMIX_ARG_REQD),
+    PMIX_OPTION_DEFINE("stream", PMIX_ARG_NONE),
 
     PMIX_OPTION_END
 };
@@ -181,9 +214,10 @@ int main(int argc, char **argv)
     char **qprs;
     char *strt, *endp, *kptr;
     pmix_infolist_t *iptr;
-    char *str, *result;
+    char *str;
     pmix_query_t *queries;
     pmix_rank_t rank = 0;
+    uint32_t radix = 0;
     char hostname[PMIX_PATH_MAX];
 
     PMIX_HIDE_UNUSED_PARAMS(argc);
@@ -339,6 +373,13 @@ int main(int argc, char **argv)
     }
     PMIX_DESTRUCT_LOCK(&mylock.lock);
 
+    /* ask the host to gather the answer through a tree of its
+     * servers, and/or to pass it along in batches */
+    if (NULL != (opt = pmix_cmd_line_get_param(&results, "tree"))) {
+        radix = strtoul(opt->values[0], NULL, 10);
+    }
+    stream = pmix_cmd_line_is_taken(&results, "stream");
+
     /* generate the queries */
     PMIX_CONSTRUCT(&querylist, pmix_list_t);
     for (n = 0; NULL != qkeys[n]; n++) {
@@ -382,6 +423,16 @@ int main(int argc, char **argv)
                 pmix_list_append(&qlist, &iptr->super);
             }
         }
+        if (0 < radix) {
+            iptr = PMIX_NEW(pmix_infolist_t);
+            PMIX_INFO_LOAD(&iptr->info, PMIX_QUERY_TREE_RADIX, &radix, PMIX_UINT32);
+            pmix_list_append(&qlist, &iptr->super);
+        }
+        if (stream) {
+            iptr = PMIX_NEW(pmix_infolist_t);
+            PMIX_INFO_LOAD(&iptr->info, PMIX_QUERY_STREAM, &stream, PMIX_BOOL);
+            pmix_list_append(&qlist, &iptr->super);
+        }
         /* convert the key */
         if (NULL == (attr = pmix_attributes_lookup(qkeys[n]))) {
             fprintf(stderr, "Failed to lookup %s\n", qkeys[n]);
@@ -427,21 +478,13 @@ int main(int argc, char **argv)
         rc = mq.status;
     } else {
         if (0 == mq.ninfo) {
-            fprintf(stderr, "Query returned zero results\n");
+            if (!stream) {
+                fprintf(stderr, "Query returned zero results\n");
+            }
             goto done;
         }
         /* print out the returned value(s) */
-        for (n = 0; n < mq.ninfo; n++) {
-            if (NULL == (attr = pmix_attributes_reverse_lookup(mq.info[n].key))) {
-                fprintf(stdout, "%s: ", mq.info[n].key);
-            } else {
-                fprintf(stdout, "%s: ", attr);
-            }
-            fprintf(stdout, "\n");
-            result = PMIx_Value_string(&mq.info[n].value);
-            fprintf(stderr, "  %s\n", (NULL == result) ? "NULL" : result);
-            free(result);
-        }
+        print_results(mq.info, mq.ninfo);
     }
 
 done:
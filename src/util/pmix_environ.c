@@ -328,3 +328,215 @@ pmix_status_t pmix_util_harvest_envars(char **incvars, char **excvars, pmix_list
     }
     return PMIX_SUCCESS;
 }
+
+static void ebcon(pmix_env_builder_t *p)
+{
+    PMIX_CONSTRUCT(&p->index, pmix_hash_table_t);
+    pmix_hash_table_init(&p->index, 64);
+    p->entries = NULL;
+    p->nentries = 0;
+    p->size = 0;
+}
+static void ebdes(pmix_env_builder_t *p)
+{
+    size_t n;
+
+    PMIX_DESTRUCT(&p->index);
+    for (n = 0; n < p->nentries; n++) {
+        if (NULL != p->entries[n]) {
+            free(p->entries[n]);
+        }
+    }
+    if (NULL != p->entries) {
+        free(p->entries);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_env_builder_t, pmix_object_t, ebcon, ebdes);
+
+/* the length of the name in a "name=value" string */
+static size_t env_name_len(const char *entry)
+{
+    const char *eq = strchr(entry, '=');
+
+    return (NULL == eq) ? strlen(entry) : (size_t) (eq - entry);
+}
+
+static size_t env_lookup(pmix_env_builder_t *bld, const char *name, size_t len)
+{
+    void *pos;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&bld->index, name, len, &pos)) {
+        return 0;
+    }
+    return (size_t) (uintptr_t) pos;
+}
+
+/* the builder takes ownership of the entry */
+static pmix_status_t env_put(pmix_env_builder_t *bld, char *entry, size_t len, bool overwrite)
+{
+    size_t pos, size;
+    char **tmp;
+
+    pos = env_lookup(bld, entry, len);
+    if (0 < pos) {
+        if (!overwrite) {
+            free(entry);
+            return PMIX_ERR_EXISTS;
+        }
+        free(bld->entries[pos - 1]);
+        bld->entries[pos - 1] = entry;
+        return PMIX_SUCCESS;
+    }
+
+    if (bld->nentries == bld->size) {
+        size = (0 == bld->size) ? 64 : 2 * bld->size;
+        tmp = (char **) realloc(bld->entries, size * sizeof(char *));
+        if (NULL == tmp) {
+            free(entry);
+            return PMIX_ERR_NOMEM;
+        }
+        bld->entries = tmp;
+        bld->size = size;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_set_value_ptr(&bld->index, entry, len,
+                                                      (void *) (uintptr_t) (bld->nentries + 1))) {
+        free(entry);
+        return PMIX_ERR_NOMEM;
+    }
+    bld->entries[bld->nentries++] = entry;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_env_builder_load(pmix_env_builder_t *bld, char **env)
+{
+    pmix_status_t rc = PMIX_SUCCESS;
+    size_t n;
+
+    if (NULL == env) {
+        return PMIX_SUCCESS;
+    }
+    assert(env != environ);
+
+    for (n = 0; NULL != env[n]; n++) {
+        if (PMIX_SUCCESS == rc) {
+            /* as with pmix_setenv, a later duplicate replaces
+             * the earlier one */
+            rc = env_put(bld, env[n], env_name_len(env[n]), true);
+        } else {
+            free(env[n]);
+        }
+    }
+    free(env);
+    return rc;
+}
+
+pmix_status_t pmix_env_builder_set(pmix_env_builder_t *bld, const char *name, const char *value,
+                                   bool overwrite)
+{
+    char *entry;
+    size_t len;
+
+    len = strlen(name);
+    if (!overwrite && 0 < env_lookup(bld, name, len)) {
+        return PMIX_ERR_EXISTS;
+    }
+    if (0 > pmix_asprintf(&entry, "%s=%s", name, (NULL == value) ? "" : value)) {
+        return PMIX_ERR_NOMEM;
+    }
+    return env_put(bld, entry, len, overwrite);
+}
+
+pmix_status_t pmix_env_builder_merge(pmix_env_builder_t *bld, char **env, bool overwrite)
+{
+    pmix_status_t rc;
+    char *entry;
+    size_t n, len;
+
+    if (NULL == env) {
+        return PMIX_SUCCESS;
+    }
+    for (n = 0; NULL != env[n]; n++) {
+        len = env_name_len(env[n]);
+        if (!overwrite && 0 < env_lookup(bld, env[n], len)) {
+            continue;
+        }
+        entry = strdup(env[n]);
+        if (NULL == entry) {
+            return PMIX_ERR_NOMEM;
+        }
+        rc = env_put(bld, entry, len, true);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_env_builder_unset(pmix_env_builder_t *bld, const char *name)
+{
+    size_t pos, len;
+
+    len = strlen(name);
+    pos = env_lookup(bld, name, len);
+    if (0 == pos) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    pmix_hash_table_remove_value_ptr(&bld->index, name, len);
+    free(bld->entries[pos - 1]);
+    bld->entries[pos - 1] = NULL;
+    return PMIX_SUCCESS;
+}
+
+char *pmix_env_builder_get(pmix_env_builder_t *bld, const char *name)
+{
+    size_t pos, len;
+
+    len = env_name_len(name);
+    pos = env_lookup(bld, name, len);
+    if (0 == pos) {
+        return NULL;
+    }
+    return &bld->entries[pos - 1][len + 1];
+}
+
+char **pmix_env_builder_finalize(pmix_env_builder_t *bld)
+{
+    char **env;
+    size_t n, m;
+
+    pmix_hash_table_remove_all(&bld->index);
+    if (0 == bld->nentries) {
+        return NULL;
+    }
+    /* close the gaps left by unset variables */
+    for (n = 0, m = 0; n < bld->nentries; n++) {
+        if (NULL != bld->entries[n]) {
+            bld->entries[m++] = bld->entries[n];
+        }
+    }
+    env = bld->entries;
+    if (0 == m) {
+        free(env);
+        env = NULL;
+    } else {
+        if (m == bld->size) {
+            /* need room for the terminator */
+            env = (char **) realloc(bld->entries, (m + 1) * sizeof(char *));
+            if (NULL == env) {
+                for (n = 0; n < m; n++) {
+                    free(bld->entries[n]);
+                }
+                free(bld->entries);
+                bld->entries = NULL;
+                bld->nentries = 0;
+                bld->size = 0;
+                return NULL;
+            }
+        }
+        env[m] = NULL;
+    }
+    bld->entries = NULL;
+    bld->nentries = 0;
+    bld->size = 0;
+    return env;
+}
@@ -41,6 +41,7 @@
 #endif
 
 #include "pmix_common.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 
 BEGIN_C_DECLS
@@ -132,6 +133,62 @@ PMIX_EXPORT char * pmix_getenv(const char *name, char **env) __pmix_attribute_no
 PMIX_EXPORT pmix_status_t pmix_unsetenv(const char *name, char ***env)
     __pmix_attribute_nonnull__(1);
 
+/**
+ * Builder for an environ-like array that is edited many times
+ * before it is used - e.g., the environment of a child being
+ * forked. The variables are indexed by name, so each edit is a
+ * hash lookup instead of a scan of the array, and the array is
+ * only assembled once, by pmix_env_builder_finalize().
+ */
+typedef struct {
+    pmix_object_t super;
+    /* name => position in entries + 1 */
+    pmix_hash_table_t index;
+    /* "name=value" strings - NULL where a variable was unset */
+    char **entries;
+    size_t nentries;
+    size_t size;
+} pmix_env_builder_t;
+PMIX_CLASS_DECLARATION(pmix_env_builder_t);
+
+/**
+ * Take over the strings of an environ-like array, which is then
+ * freed. The array must not be environ. Must be called before
+ * any other change is made to the builder.
+ */
+PMIX_EXPORT pmix_status_t pmix_env_builder_load(pmix_env_builder_t *bld, char **env);
+
+/**
+ * Same as pmix_setenv() - returns PMIX_ERR_EXISTS if the variable
+ * is already set and overwrite is false
+ */
+PMIX_EXPORT pmix_status_t pmix_env_builder_set(pmix_env_builder_t *bld, const char *name,
+                                               const char *value, bool overwrite);
+
+/**
+ * Set each of the "name=value" strings of an environ-like array.
+ * Variables that are already set are left alone unless overwrite
+ * is true.
+ */
+PMIX_EXPORT pmix_status_t pmix_env_builder_merge(pmix_env_builder_t *bld, char **env,
+                                                 bool overwrite);
+
+/**
+ * Same as pmix_unsetenv()
+ */
+PMIX_EXPORT pmix_status_t pmix_env_builder_unset(pmix_env_builder_t *bld, const char *name);
+
+/**
+ * Same as pmix_getenv()
+ */
+PMIX_EXPORT char *pmix_env_builder_get(pmix_env_builder_t *bld, const char *name);
+
+/**
+ * Assemble the environ-like array, to be freed with pmix_argv_free().
+ * The builder is left empty.
+ */
+PMIX_EXPORT char **pmix_env_builder_finalize(pmix_env_builder_t *bld);
+
 /* A consistent way to retrieve the home and tmp directory on all supported
  * platforms.
  */
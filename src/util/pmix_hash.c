@@ -35,11 +35,152 @@
 #include "src/include/pmix_globals.h"
 #include "src/include/pmix_hash_string.h"
 #include "src/mca/bfrops/bfrops.h"
+#include "src/threads/pmix_rwlock.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
 
 #include "src/util/pmix_hash.h"
 
+/**
+ * Entry in the per-proc key index. Each slot tracks the
+ * location in the data array of the unqualified value for
+ * the key, plus the head of the chain of qualified values
+ * stored under that same key
+ */
+typedef struct {
+    uint32_t kid;
+    int unqual;
+    int qual;
+} pmix_kindex_t;
+
+#define PMIX_KINDEX_EMPTY       UINT32_MAX
+#define PMIX_KINDEX_INIT_SIZE   32
+/* number of qualifiers we translate without allocating */
+#define PMIX_HASH_MAX_INLINE_QUALS  8
+/* longest string (including its NULL terminator) held inline */
+#define PMIX_HASH_INLINE_STRLEN     32
+
+/**
+ * Storage entry as allocated here. Small values - scalars and
+ * short strings - are held alongside the entry instead of being
+ * copied to the heap, with the entry's value pointing at ival.
+ * A full pmix_value_t is only created when the data is fetched.
+ * A value stored as shared belongs to the owner object, which
+ * the entry holds a reference on in place of the inline string
+ */
+typedef struct {
+    pmix_dstor_t d;
+    /* epoch at which the value was last stored */
+    uint64_t stamp;
+    pmix_value_t ival;
+    union {
+        char istr[PMIX_HASH_INLINE_STRLEN];
+        pmix_object_t *owner;
+    } u;
+} pmix_hash_dstor_t;
+
+static pmix_dstor_t *dstor_new(uint32_t kid)
+{
+    pmix_hash_dstor_t *hd;
+
+    hd = (pmix_hash_dstor_t*)pmix_malloc(sizeof(pmix_hash_dstor_t));
+    if (NULL == hd) {
+        return NULL;
+    }
+    hd->d.index = kid;
+    hd->d.qualindex = UINT32_MAX;
+    hd->d.value = NULL;
+    hd->stamp = 0;
+    return &hd->d;
+}
+
+static void dstor_clear_value(pmix_dstor_t *d)
+{
+    pmix_hash_dstor_t *hd = (pmix_hash_dstor_t*)d;
+
+    if (NULL != d->value && &hd->ival != d->value) {
+        if (NULL != hd->u.owner) {
+            PMIX_RELEASE(hd->u.owner);
+        } else {
+            PMIX_VALUE_RELEASE(d->value);
+        }
+    }
+    d->value = NULL;
+}
+
+static void dstor_release(pmix_dstor_t *d)
+{
+    dstor_clear_value(d);
+    free(d);
+}
+
+static pmix_status_t dstor_set_value(pmix_dstor_t *d, pmix_value_t *val,
+                                     pmix_object_t *owner)
+{
+    pmix_hash_dstor_t *hd = (pmix_hash_dstor_t*)d;
+    pmix_status_t rc;
+    size_t len;
+
+    if (NULL != val) {
+        switch (val->type) {
+        case PMIX_STRING:
+            if (NULL == val->data.string) {
+                break;
+            }
+            len = strlen(val->data.string) + 1;
+            if (PMIX_HASH_INLINE_STRLEN < len) {
+                break;
+            }
+            memcpy(hd->u.istr, val->data.string, len);
+            hd->ival.type = PMIX_STRING;
+            hd->ival.data.string = hd->u.istr;
+            d->value = &hd->ival;
+            return PMIX_SUCCESS;
+        case PMIX_BOOL:
+        case PMIX_BYTE:
+        case PMIX_SIZE:
+        case PMIX_PID:
+        case PMIX_INT:
+        case PMIX_INT8:
+        case PMIX_INT16:
+        case PMIX_INT32:
+        case PMIX_INT64:
+        case PMIX_UINT:
+        case PMIX_UINT8:
+        case PMIX_UINT16:
+        case PMIX_UINT32:
+        case PMIX_UINT64:
+        case PMIX_FLOAT:
+        case PMIX_DOUBLE:
+        case PMIX_TIMEVAL:
+        case PMIX_TIME:
+        case PMIX_STATUS:
+        case PMIX_PROC_RANK:
+        case PMIX_PERSIST:
+        case PMIX_SCOPE:
+        case PMIX_DATA_RANGE:
+        case PMIX_PROC_STATE:
+        case PMIX_DATA_TYPE:
+            /* the value is entirely held in the struct */
+            hd->ival = *val;
+            d->value = &hd->ival;
+            return PMIX_SUCCESS;
+        default:
+            break;
+        }
+    }
+
+    if (NULL != owner) {
+        PMIX_RETAIN(owner);
+        hd->u.owner = owner;
+        d->value = val;
+        return PMIX_SUCCESS;
+    }
+    hd->u.owner = NULL;
+    PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&d->value, val, PMIX_VALUE);
+    return rc;
+}
+
 /**
  * Data for a particular pmix process
  * The name association is maintained in the
@@ -51,6 +192,16 @@ typedef struct {
      received from this process */
     pmix_pointer_array_t data;
     pmix_pointer_array_t quals;
+    /* open-addressed index of the data array by key id */
+    pmix_kindex_t *kindex;
+    uint32_t ksize;
+    uint32_t kcount;
+    /* links between qualified entries that share a key id,
+     * indexed by location in the data array */
+    int *qnext;
+    int qnsize;
+    /* epoch of the last change to the data of this proc */
+    uint64_t epoch;
 } pmix_proc_data_t;
 static void pdcon(pmix_proc_data_t *p)
 {
@@ -58,6 +209,12 @@ static void pdcon(pmix_proc_data_t *p)
     pmix_pointer_array_init(&p->data, 128, INT_MAX, 128);
     PMIX_CONSTRUCT(&p->quals, pmix_pointer_array_t);
     pmix_pointer_array_init(&p->quals, 1, INT_MAX, 1);
+    p->kindex = NULL;
+    p->ksize = 0;
+    p->kcount = 0;
+    p->qnext = NULL;
+    p->qnsize = 0;
+    p->epoch = 0;
 }
 static void pddes(pmix_proc_data_t *p)
 {
@@ -70,7 +227,7 @@ static void pddes(pmix_proc_data_t *p)
     for (n=0; n < p->data.size; n++) {
         d = (pmix_dstor_t*)pmix_pointer_array_get_item(&p->data, n);
         if (NULL != d) {
-            PMIX_DSTOR_RELEASE(d);
+            dstor_release(d);
             pmix_pointer_array_set_item(&p->data, n, NULL);
         }
     }
@@ -90,19 +247,44 @@ static void pddes(pmix_proc_data_t *p)
         pmix_pointer_array_set_item(&p->quals, n, NULL);
     }
     PMIX_DESTRUCT(&p->quals);
+    if (NULL != p->kindex) {
+        free(p->kindex);
+    }
+    if (NULL != p->qnext) {
+        free(p->qnext);
+    }
 }
 static PMIX_CLASS_INSTANCE(pmix_proc_data_t, pmix_object_t, pdcon, pddes);
 
+/* Every change to the data of any proc takes the next value of a
+ * single counter, so the epochs of a proc only ever grow - even if
+ * its data is removed and stored again - and a reader that saw a
+ * given epoch can be sent just the values stamped after it. Stores
+ * of modex data can run on several threads at once */
+static uint64_t hash_epoch = 0;
+
+static inline void mark_changed(pmix_proc_data_t *proc, pmix_dstor_t *d)
+{
+    proc->epoch = __atomic_add_fetch(&hash_epoch, 1, __ATOMIC_RELAXED);
+    if (NULL != d) {
+        ((pmix_hash_dstor_t*)d)->stamp = proc->epoch;
+    }
+}
+
 static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc, uint32_t kid,
                                    pmix_info_t *qualifiers, size_t nquals);
 static pmix_proc_data_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, bool create);
 static void erase_qualifiers(pmix_proc_data_t *proc,
                              uint32_t index);
+static pmix_kindex_t *kindex_lookup(pmix_proc_data_t *proc, uint32_t kid, bool create);
+static pmix_status_t kindex_add(pmix_proc_data_t *proc, pmix_dstor_t *d, int loc);
+static void kindex_remove(pmix_proc_data_t *proc, uint32_t kid);
 
 
-pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
-                              pmix_rank_t rank, pmix_kval_t *kin,
-                              pmix_info_t *qualifiers, size_t nquals)
+static pmix_status_t hash_store(pmix_hash_table_t *table,
+                                pmix_rank_t rank, pmix_kval_t *kin,
+                                pmix_info_t *qualifiers, size_t nquals,
+                                pmix_object_t *owner)
 {
     pmix_proc_data_t *proc_data;
     uint32_t kid;
@@ -112,6 +294,7 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
     pmix_data_array_t *darray;
     pmix_qual_t *qarray;
     size_t n, m = 0;
+    int loc;
 
     pmix_output_verbose(10, pmix_globals.debug_output,
                         "HASH:STORE:QUAL rank %s key %s",
@@ -168,19 +351,19 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                             PMIX_NAME_PRINT(&pmix_globals.myid), tmp);
                 free(tmp);
             }
-            PMIX_VALUE_RELEASE(hv->value);
+            dstor_clear_value(hv);
         }
-        /* eventually, we want to eliminate this copy */
-        PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&hv->value, kin->value, PMIX_VALUE);
+        rc = dstor_set_value(hv, kin->value, owner);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
         }
+        mark_changed(proc_data, hv);
         return PMIX_SUCCESS;
     }
 
     /* we don't already have it, so create it */
-    PMIX_DSTOR_NEW(hv, kid);
+    hv = dstor_new(kid);
     if (NULL == hv) {
         return PMIX_ERR_NOMEM;
     }
@@ -207,15 +390,15 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                                             PMIX_NAME_PRINT(&pmix_globals.myid),
                                             kin->key);
                         erase_qualifiers(proc_data, hv->qualindex);
-                        PMIX_DSTOR_RELEASE(hv);
+                        dstor_release(hv);
                         return PMIX_ERR_BAD_PARAM;
                     }
-                    qarray[n].index = p->index;
+                    qarray[m].index = p->index;
                     PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&qarray[m].value, &qualifiers[n].value, PMIX_VALUE);
                     if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
                         erase_qualifiers(proc_data, hv->qualindex);
-                        PMIX_DSTOR_RELEASE(hv);
+                        dstor_release(hv);
                         return rc;
                     }
                     ++m;
@@ -224,15 +407,14 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
         }
     }
 
-    /* eventually, we want to eliminate this copy */
-    PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **)&hv->value, kin->value, PMIX_VALUE);
+    rc = dstor_set_value(hv, kin->value, owner);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         if (UINT32_MAX != hv->qualindex) {
             /* release the associated qualifiers */
             erase_qualifiers(proc_data, hv->qualindex);
         }
-        PMIX_DSTOR_RELEASE(hv);
+        dstor_release(hv);
         return rc;
     }
     if (9 < pmix_output_get_verbosity(pmix_globals.debug_output)) {
@@ -244,7 +426,84 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                     table->ht_label);
         free(v);
     }
-    pmix_pointer_array_add(&proc_data->data, hv);
+    loc = pmix_pointer_array_add(&proc_data->data, hv);
+    if (0 > loc) {
+        if (UINT32_MAX != hv->qualindex) {
+            erase_qualifiers(proc_data, hv->qualindex);
+        }
+        dstor_release(hv);
+        return PMIX_ERR_NOMEM;
+    }
+    rc = kindex_add(proc_data, hv, loc);
+    if (PMIX_SUCCESS != rc) {
+        pmix_pointer_array_set_item(&proc_data->data, loc, NULL);
+        if (UINT32_MAX != hv->qualindex) {
+            erase_qualifiers(proc_data, hv->qualindex);
+        }
+        dstor_release(hv);
+        return rc;
+    }
+    mark_changed(proc_data, hv);
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
+                              pmix_rank_t rank, pmix_kval_t *kin,
+                              pmix_info_t *qualifiers, size_t nquals)
+{
+    return hash_store(table, rank, kin, qualifiers, nquals, NULL);
+}
+
+pmix_status_t pmix_hash_store_shared(pmix_hash_table_t *table,
+                                     pmix_rank_t rank, pmix_kval_t *kin,
+                                     pmix_object_t *owner)
+{
+    return hash_store(table, rank, kin, NULL, 0, owner);
+}
+
+/* append a copy of the given entry to the list - a qualified
+ * value is returned as an array holding the value followed by
+ * its qualifiers */
+static pmix_status_t export_kval(pmix_proc_data_t *proc_data, pmix_dstor_t *hv,
+                                 pmix_regattr_input_t *p, pmix_list_t *kvals)
+{
+    pmix_kval_t *kv;
+    pmix_info_t *iptr;
+    pmix_data_array_t *darray;
+    pmix_qual_t *quals;
+    size_t nq, m;
+
+    if (UINT32_MAX != hv->qualindex) {
+        /* this is a qualified value - need to return it as such */
+        PMIX_KVAL_NEW(kv, PMIX_QUALIFIED_VALUE);
+        darray = (pmix_data_array_t*)pmix_pointer_array_get_item(&proc_data->quals, hv->qualindex);
+        quals = (pmix_qual_t*)darray->array;
+        nq = darray->size;
+        PMIX_DATA_ARRAY_CREATE(darray, nq+1, PMIX_INFO);
+        iptr = (pmix_info_t*)darray->array;
+        /* the first location is the actual value */
+        PMIX_LOAD_KEY(&iptr[0].key, p->string);
+        PMIx_Value_xfer(&iptr[0].value, hv->value);
+        /* now add the qualifiers */
+        for (m=0; m < nq; m++) {
+            p = pmix_hash_lookup_key(quals[m].index, NULL);
+            if (NULL == p) {
+                /* should never happen */
+                PMIX_RELEASE(kv);
+                PMIX_DATA_ARRAY_FREE(darray);
+                return PMIX_ERR_BAD_PARAM;
+            }
+            PMIX_LOAD_KEY(&iptr[m+1].key, p->string);
+            PMIx_Value_xfer(&iptr[m+1].value, quals[m].value);
+            PMIX_INFO_SET_QUALIFIER(&iptr[m+1]);
+        }
+        kv->value->type = PMIX_DATA_ARRAY;
+        kv->value->data.darray = darray;
+    } else {
+        PMIX_KVAL_NEW(kv, p->string);
+        PMIx_Value_xfer(kv->value, hv->value);
+    }
+    pmix_list_append(kvals, &kv->super);
     return PMIX_SUCCESS;
 }
 
@@ -260,13 +519,9 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table,
     uint32_t id, kid=UINT32_MAX;
     char *node;
     pmix_regattr_input_t *p;
-    pmix_info_t *iptr;
-    size_t nq, m;
     int n;
     pmix_kval_t *kv;
     bool fullsearch = false;
-    pmix_data_array_t *darray;
-    pmix_qual_t *quals;
 
     pmix_output_verbose(10, pmix_globals.debug_output,
                         "%s HASH:FETCH id %s key %s",
@@ -340,36 +595,10 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table,
                                             "%s INCLUDE %s VALUE %u FROM TABLE %s FOR RANK %s",
                                             PMIX_NAME_PRINT(&pmix_globals.myid), p->name,
                                             (unsigned)hv->value->data.size, table->ht_label, PMIX_RANK_PRINT(rank));
-                        /* this is a qualified value - need to return it as such */
-                        PMIX_KVAL_NEW(kv, PMIX_QUALIFIED_VALUE);
-                        darray = (pmix_data_array_t*)pmix_pointer_array_get_item(&proc_data->quals, hv->qualindex);
-                        quals = (pmix_qual_t*)darray->array;
-                        nq = darray->size;
-                        PMIX_DATA_ARRAY_CREATE(darray, nq+1, PMIX_INFO);
-                        iptr = (pmix_info_t*)darray->array;
-                        /* the first location is the actual value */
-                        PMIX_LOAD_KEY(&iptr[0].key, p->string);
-                        PMIx_Value_xfer(&iptr[0].value, hv->value);
-                        /* now add the qualifiers */
-                        for (m=0; m < nq; m++) {
-                            p = pmix_hash_lookup_key(quals[m].index, NULL);
-                            if (NULL == p) {
-                                /* should never happen */
-                                PMIX_RELEASE(kv);
-                                PMIX_DATA_ARRAY_FREE(darray);
-                                return PMIX_ERR_BAD_PARAM;
-                            }
-                            PMIX_LOAD_KEY(&iptr[m+1].key, p->string);
-                            PMIx_Value_xfer(&iptr[m+1].value, quals[m].value);
-                            PMIX_INFO_SET_QUALIFIER(&iptr[m+1]);
-                        }
-                        kv->value->type = PMIX_DATA_ARRAY;
-                        kv->value->data.darray = darray;
-                        pmix_list_append(kvals, &kv->super);
-                    } else {
-                        PMIX_KVAL_NEW(kv, p->string);
-                        PMIx_Value_xfer(kv->value, hv->value);
-                        pmix_list_append(kvals, &kv->super);
+                    }
+                    rc = export_kval(proc_data, hv, p, kvals);
+                    if (PMIX_SUCCESS != rc) {
+                        return rc;
                     }
                 }
             }
@@ -408,6 +637,44 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table,
     return rc;
 }
 
+pmix_status_t pmix_hash_fetch_changed(pmix_hash_table_t *table, pmix_rank_t rank,
+                                      uint64_t since, uint64_t *epoch,
+                                      pmix_list_t *kvals)
+{
+    pmix_proc_data_t *proc_data;
+    pmix_dstor_t *hv;
+    pmix_regattr_input_t *p;
+    pmix_status_t rc;
+    int n;
+
+    *epoch = 0;
+    proc_data = lookup_proc(table, rank, false);
+    if (NULL == proc_data) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    *epoch = proc_data->epoch;
+    if (proc_data->epoch <= since) {
+        /* nothing has changed */
+        return PMIX_SUCCESS;
+    }
+
+    for (n=0; n < proc_data->data.size; n++) {
+        hv = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
+        if (NULL == hv || ((pmix_hash_dstor_t*)hv)->stamp <= since) {
+            continue;
+        }
+        p = pmix_hash_lookup_key(hv->index, NULL);
+        if (NULL == p) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        rc = export_kval(proc_data, hv, p, kvals);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
                                     pmix_rank_t rank, const char *key)
 {
@@ -438,20 +705,7 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
                 if (NULL == key) {
                     PMIX_RELEASE(proc_data);
                 } else {
-                    for (n=0; n < proc_data->data.size; n++) {
-                        d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
-                        if (NULL != d && kid == d->index) {
-                            if (NULL != d->value) {
-                                PMIX_VALUE_RELEASE(d->value);
-                            }
-                            if (UINT32_MAX != d->qualindex) {
-                                erase_qualifiers(proc_data, d->qualindex);
-                            }
-                            free(d);
-                            pmix_pointer_array_set_item(&proc_data->data, n, NULL);
-                            break;
-                        }
-                    }
+                    kindex_remove(proc_data, kid);
                 }
             }
             rc = pmix_hash_table_get_next_key_uint32(table, &id, (void **) &proc_data, node,
@@ -471,13 +725,10 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
         for (n=0; n < proc_data->data.size; n++) {
             d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
             if (NULL != d) {
-                if (NULL != d->value) {
-                    PMIX_VALUE_RELEASE(d->value);
-                }
                 if (UINT32_MAX != d->qualindex) {
                     erase_qualifiers(proc_data, d->qualindex);
                 }
-                free(d);
+                dstor_release(d);
                 pmix_pointer_array_set_item(&proc_data->data, n, NULL);
             }
         }
@@ -489,38 +740,67 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     }
 
     /* remove this item */
-    for (n=0; n < proc_data->data.size; n++) {
-        d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
-        if (NULL != d && kid == d->index) {
-            if (NULL != d->value) {
-                PMIX_VALUE_RELEASE(d->value);
-            }
-            if (UINT32_MAX != d->qualindex) {
-                erase_qualifiers(proc_data, d->qualindex);
-            }
-            free(d);
-            pmix_pointer_array_set_item(&proc_data->data, n, NULL);
-            break;
-        }
-    }
+    kindex_remove(proc_data, kid);
 
     return PMIX_SUCCESS;
 }
 
 /**
- * Find data for a given key in a given pmix_list_t.
+ * Find data for a given key in the given proc data object. The
+ * key index takes us directly to the entries stored under this
+ * key id - only qualified entries need to be checked individually
  */
-static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
-                                   pmix_info_t *qualifiers, size_t nquals)
+static bool match_quals(pmix_proc_data_t *proc_data, pmix_dstor_t *d,
+                        pmix_info_t *qualifiers, size_t nquals,
+                        uint32_t *qids, size_t numquals)
 {
-    pmix_dstor_t *d;
     pmix_data_array_t *darray;
     pmix_qual_t *qarray;
+    size_t m, nq, nfound = 0, nq2 = 0;
+
+    darray = (pmix_data_array_t*)pmix_pointer_array_get_item(&proc_data->quals, d->qualindex);
+    if (NULL == darray) {
+        return false;
+    }
+    qarray = (pmix_qual_t*)darray->array;
+    /* check the qualifiers */
+    for (m=0; m < nquals; m++) {
+        /* if this isn't marked as a qualifier, skip it */
+        if (!PMIX_INFO_IS_QUALIFIER(&qualifiers[m])) {
+            continue;
+        }
+        for (nq=0; nq < darray->size; nq++) {
+            /* see if the keys match */
+            if (qarray[nq].index == qids[nq2]) {
+                /* if the values don't match, then we reject
+                 * this entry */
+                if (PMIX_EQUAL == PMIx_Value_compare(&qualifiers[m].value, qarray[nq].value)) {
+                    /* match! */
+                    ++nfound;
+                    break;
+                }
+            }
+        }
+        ++nq2;
+    }
+    /* did we get a complete match? */
+    return (nfound == numquals);
+}
+
+static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
+                                   pmix_info_t *qualifiers, size_t nquals)
+{
+    pmix_dstor_t *d, *ret = NULL;
+    pmix_kindex_t *ki;
     pmix_regattr_input_t *p;
-    size_t m, numquals = 0, nq, nfound;
+    uint32_t qinline[PMIX_HASH_MAX_INLINE_QUALS], *qids = qinline;
+    size_t m, numquals = 0;
     int n;
 
-    p = pmix_hash_lookup_key(kid, NULL);
+    ki = kindex_lookup(proc_data, kid, false);
+    if (NULL == ki) {
+        return NULL;
+    }
 
     if (NULL != qualifiers) {
         /* count the qualifiers */
@@ -532,58 +812,54 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
         }
     }
 
-    for (n=0; n < proc_data->data.size; n++) {
+    if (0 == numquals) {
+        /* if the stored key is also "unqualified",
+         * then return it */
+        if (0 > ki->unqual) {
+            return NULL;
+        }
+        return (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, ki->unqual);
+    }
+
+    if (0 > ki->qual) {
+        return NULL;
+    }
+
+    /* translate the qualifier keys once up front rather
+     * than for every candidate entry */
+    if (PMIX_HASH_MAX_INLINE_QUALS < numquals) {
+        qids = (uint32_t*)pmix_malloc(numquals * sizeof(uint32_t));
+        if (NULL == qids) {
+            return NULL;
+        }
+    }
+    for (m=0, numquals=0; m < nquals; m++) {
+        if (PMIX_INFO_IS_QUALIFIER(&qualifiers[m])) {
+            p = pmix_hash_lookup_key(UINT32_MAX, qualifiers[m].key);
+            if (NULL == p) {
+                /* we don't know this key */
+                goto done;
+            }
+            qids[numquals++] = p->index;
+        }
+    }
+
+    for (n = ki->qual; 0 <= n; n = proc_data->qnext[n]) {
         d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc_data->data, n);
         if (NULL == d) {
             continue;
         }
-        if (kid == d->index) {
-            if (0 < numquals) {
-                if (UINT32_MAX == d->qualindex) {
-                    continue;
-                }
-                darray = (pmix_data_array_t*)pmix_pointer_array_get_item(&proc_data->quals, d->qualindex);
-                qarray = (pmix_qual_t*)darray->array;
-                nfound = 0;
-                /* check the qualifiers */
-                for (m=0; m < nquals; m++) {
-                    /* if this isn't marked as a qualifier, skip it */
-                    if (!PMIX_INFO_IS_QUALIFIER(&qualifiers[m])) {
-                        continue;
-                    }
-                    p = pmix_hash_lookup_key(UINT32_MAX, qualifiers[m].key);
-                    if (NULL == p) {
-                        /* we don't know this key */
-                        return NULL;
-                    }
-                    for (nq=0; nq < darray->size; nq++) {
-                        /* see if the keys match */
-                        if (qarray[nq].index == p->index) {
-                            /* if the values don't match, then we reject
-                             * this entry */
-                            if (PMIX_EQUAL == PMIx_Value_compare(&qualifiers[m].value, qarray[nq].value)) {
-                                /* match! */
-                                ++nfound;
-                                break;
-                            }
-                        }
-                    }
-                }
-                /* did we get a complete match? */
-                if (nfound == numquals) {
-                    return d;
-                }
-            } else {
-                /* if the stored key is also "unqualified",
-                 * then return it */
-                if (UINT32_MAX == d->qualindex) {
-                    return d;
-                }
-            }
+        if (match_quals(proc_data, d, qualifiers, nquals, qids, numquals)) {
+            ret = d;
+            break;
         }
     }
 
-    return NULL;
+done:
+    if (qinline != qids) {
+        free(qids);
+    }
+    return ret;
 }
 
 /**
@@ -592,8 +868,13 @@ static pmix_dstor_t *lookup_keyval(pmix_proc_data_t *proc_data, uint32_t kid,
  */
 static pmix_proc_data_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, bool create)
 {
-    pmix_proc_data_t *proc_data = NULL;
+    pmix_proc_data_t *proc_data;
 
+    /* ranks of a job of known size are indexed directly */
+    proc_data = (pmix_proc_data_t *) pmix_hash_table_get_dense_uint32(jtable, id);
+    if (NULL != proc_data) {
+        return proc_data;
+    }
     pmix_hash_table_get_value_uint32(jtable, id, (void **) &proc_data);
     if (NULL == proc_data && create) {
         /* The proc clearly exists, so create a data structure for it */
@@ -607,8 +888,34 @@ static pmix_proc_data_t *lookup_proc(pmix_hash_table_t *jtable, uint32_t id, boo
     return proc_data;
 }
 
-void pmix_hash_register_key(uint32_t inid,
-                            pmix_regattr_input_t *ptr)
+/* must match dictionary_hash() in contrib/construct_dictionary.py */
+static inline uint32_t dictionary_hash(const char *key, uint32_t seed)
+{
+    const unsigned char *str = (const unsigned char*)key;
+    uint32_t hash = seed;
+
+    while (*str) {
+        hash += *str++;
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    return hash + (hash << 15);
+}
+
+/* the key registry is shared by every table in the process. Once
+ * tables are used from several threads, a lookup holds the registry
+ * shared and only the registration of a new key holds it exclusive */
+static bool keys_locked = false;
+static pmix_rwlock_t keys_lock = PMIX_RWLOCK_STATIC_INIT;
+
+void pmix_hash_lock_keys(void)
+{
+    keys_locked = true;
+}
+
+static void add_key(uint32_t inid, pmix_regattr_input_t *ptr)
 {
     pmix_regattr_input_t *p = NULL;
 
@@ -617,6 +924,9 @@ void pmix_hash_register_key(uint32_t inid,
         pmix_pointer_array_set_item(&pmix_globals.keyindex, pmix_globals.next_keyid, ptr);
         ptr->index = pmix_globals.next_keyid;
         pmix_globals.next_keyid += 1;
+        /* and index it by name so it can be found directly */
+        pmix_hash_table_set_value_ptr(&pmix_globals.keynames, ptr->string,
+                                      strlen(ptr->string), ptr);
         return;
     }
 
@@ -630,10 +940,25 @@ void pmix_hash_register_key(uint32_t inid,
     pmix_pointer_array_set_item(&pmix_globals.keyindex, inid, ptr);
 }
 
-pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
-                                           const char *key)
+void pmix_hash_register_key(uint32_t inid,
+                            pmix_regattr_input_t *ptr)
+{
+    if (keys_locked) {
+        pmix_rwlock_wrlock(&keys_lock);
+        add_key(inid, ptr);
+        pmix_rwlock_unlock(&keys_lock);
+        return;
+    }
+    add_key(inid, ptr);
+}
+
+/* find a key - an unreserved key that isn't indexed by name
+ * yet is only indexed or registered if reg is true */
+static pmix_regattr_input_t *find_key(uint32_t inid, const char *key, bool reg)
 {
     int id;
+    uint32_t seed, slot;
+    size_t len;
     pmix_regattr_input_t *ptr = NULL;
 
     if (UINT32_MAX == inid) {
@@ -642,23 +967,35 @@ pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
             return NULL;
         }
         if (PMIX_CHECK_RESERVED_KEY(key)) {
-            /* reserved keys are in the front of the table */
-            for (id = 0; id < PMIX_INDEX_BOUNDARY; id++) {
-                ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
-                if (NULL != ptr) {
-                    if (0 == strcmp(key, ptr->string)) {
-                        return ptr;
-                    }
-                }
+            /* reserved keys are in the front of the table - their
+             * slot comes straight from the dictionary's perfect hash */
+            seed = pmix_dictionary_hash_seeds[dictionary_hash(key, 0)
+                                              % PMIX_DICTIONARY_HASH_BUCKETS];
+            slot = pmix_dictionary_hash_slots[dictionary_hash(key, seed)
+                                              & (PMIX_DICTIONARY_HASH_SIZE - 1)];
+            if (UINT32_MAX != slot && 0 == strcmp(key, pmix_dictionary[slot].string)) {
+                return pmix_pointer_array_get_item(&pmix_globals.keyindex, slot);
             }
             /* reserved keys must already have been registered */
             return NULL;
         }
         /* unreserved keys are at the back of the table */
+        len = strlen(key);
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_globals.keynames, key, len,
+                                                          (void **) &ptr)) {
+            return ptr;
+        }
+        if (!reg) {
+            return NULL;
+        }
+        /* keys placed in the table by other means have to be
+         * searched for - index them so we only do this once */
         for (id = PMIX_INDEX_BOUNDARY; id < pmix_globals.keyindex.size; id++) {
             ptr = pmix_pointer_array_get_item(&pmix_globals.keyindex, id);
             if (NULL != ptr) {
                 if (0 == strcmp(key, ptr->string)) {
+                    pmix_hash_table_set_value_ptr(&pmix_globals.keynames, ptr->string,
+                                                  len, ptr);
                     return ptr;
                 }
             }
@@ -671,7 +1008,7 @@ pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
         ptr->description = (char**)pmix_malloc(2 * sizeof(char*));
         ptr->description[0] = strdup("USER DEFINED");
         ptr->description[1] = NULL;
-        pmix_hash_register_key(UINT32_MAX, ptr);
+        add_key(UINT32_MAX, ptr);
         return ptr;
     }
 
@@ -684,6 +1021,26 @@ pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
     return ptr;
 }
 
+pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
+                                           const char *key)
+{
+    pmix_regattr_input_t *ptr;
+
+    if (!keys_locked) {
+        return find_key(inid, key, true);
+    }
+    pmix_rwlock_rdlock(&keys_lock);
+    ptr = find_key(inid, key, false);
+    pmix_rwlock_unlock(&keys_lock);
+    if (NULL == ptr && UINT32_MAX == inid && NULL != key && !PMIX_CHECK_RESERVED_KEY(key)) {
+        /* someone may have registered it since we looked */
+        pmix_rwlock_wrlock(&keys_lock);
+        ptr = find_key(inid, key, true);
+        pmix_rwlock_unlock(&keys_lock);
+    }
+    return ptr;
+}
+
 static void erase_qualifiers(pmix_proc_data_t *proc,
                              uint32_t index)
 {
@@ -705,3 +1062,165 @@ static void erase_qualifiers(pmix_proc_data_t *proc,
     free(darray);
     pmix_pointer_array_set_item(&proc->quals, index, NULL);
 }
+
+static inline uint32_t kindex_hash(uint32_t kid, uint32_t mask)
+{
+    /* key ids are handed out sequentially, so a multiplicative
+     * hash spreads them nicely across the table */
+    return (kid * 2654435761U) & mask;
+}
+
+static pmix_kindex_t *kindex_find(pmix_kindex_t *table, uint32_t size, uint32_t kid)
+{
+    uint32_t mask = size - 1;
+    uint32_t n;
+
+    for (n = kindex_hash(kid, mask); ; n = (n + 1) & mask) {
+        if (kid == table[n].kid || PMIX_KINDEX_EMPTY == table[n].kid) {
+            return &table[n];
+        }
+    }
+}
+
+static pmix_status_t kindex_grow(pmix_proc_data_t *proc)
+{
+    pmix_kindex_t *table, *ki;
+    uint32_t size, n;
+
+    size = (0 == proc->ksize) ? PMIX_KINDEX_INIT_SIZE : 2 * proc->ksize;
+    table = (pmix_kindex_t*)pmix_malloc(size * sizeof(pmix_kindex_t));
+    if (NULL == table) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n=0; n < size; n++) {
+        table[n].kid = PMIX_KINDEX_EMPTY;
+        table[n].unqual = -1;
+        table[n].qual = -1;
+    }
+    /* rehash the existing entries */
+    for (n=0; n < proc->ksize; n++) {
+        if (PMIX_KINDEX_EMPTY != proc->kindex[n].kid) {
+            ki = kindex_find(table, size, proc->kindex[n].kid);
+            *ki = proc->kindex[n];
+        }
+    }
+    if (NULL != proc->kindex) {
+        free(proc->kindex);
+    }
+    proc->kindex = table;
+    proc->ksize = size;
+    return PMIX_SUCCESS;
+}
+
+static pmix_kindex_t *kindex_lookup(pmix_proc_data_t *proc, uint32_t kid, bool create)
+{
+    pmix_kindex_t *ki;
+
+    if (0 == proc->ksize) {
+        if (!create) {
+            return NULL;
+        }
+        if (PMIX_SUCCESS != kindex_grow(proc)) {
+            return NULL;
+        }
+    }
+    ki = kindex_find(proc->kindex, proc->ksize, kid);
+    if (PMIX_KINDEX_EMPTY != ki->kid) {
+        return ki;
+    }
+    if (!create) {
+        return NULL;
+    }
+    /* keep the load factor at or below one half */
+    if (2 * (proc->kcount + 1) > proc->ksize) {
+        if (PMIX_SUCCESS != kindex_grow(proc)) {
+            return NULL;
+        }
+        ki = kindex_find(proc->kindex, proc->ksize, kid);
+    }
+    ki->kid = kid;
+    proc->kcount++;
+    return ki;
+}
+
+static pmix_status_t kindex_add(pmix_proc_data_t *proc, pmix_dstor_t *d, int loc)
+{
+    pmix_kindex_t *ki;
+    int *tmp, size, n, *link;
+
+    ki = kindex_lookup(proc, d->index, true);
+    if (NULL == ki) {
+        return PMIX_ERR_NOMEM;
+    }
+    if (UINT32_MAX == d->qualindex) {
+        ki->unqual = loc;
+        return PMIX_SUCCESS;
+    }
+
+    /* qualified entry - make sure the chain array covers this location */
+    if (loc >= proc->qnsize) {
+        size = (0 == proc->qnsize) ? proc->data.size : proc->qnsize;
+        while (size <= loc) {
+            size *= 2;
+        }
+        tmp = (int*)realloc(proc->qnext, size * sizeof(int));
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        for (n = proc->qnsize; n < size; n++) {
+            tmp[n] = -1;
+        }
+        proc->qnext = tmp;
+        proc->qnsize = size;
+    }
+    /* append to the end of the chain so that lookups see
+     * entries in the order they were stored */
+    link = &ki->qual;
+    while (0 <= *link) {
+        link = &proc->qnext[*link];
+    }
+    *link = loc;
+    proc->qnext[loc] = -1;
+    return PMIX_SUCCESS;
+}
+
+static void kindex_remove(pmix_proc_data_t *proc, uint32_t kid)
+{
+    pmix_kindex_t *ki;
+    pmix_dstor_t *d;
+    int loc, *link, *target = NULL;
+
+    ki = kindex_lookup(proc, kid, false);
+    if (NULL == ki) {
+        return;
+    }
+
+    /* remove the entry for this key that sits lowest in the
+     * data array, unqualified or not */
+    loc = ki->unqual;
+    for (link = &ki->qual; 0 <= *link; link = &proc->qnext[*link]) {
+        if (0 > loc || *link < loc) {
+            loc = *link;
+            target = link;
+        }
+    }
+    if (0 > loc) {
+        return;
+    }
+    if (NULL == target) {
+        ki->unqual = -1;
+    } else {
+        *target = proc->qnext[loc];
+        proc->qnext[loc] = -1;
+    }
+
+    d = (pmix_dstor_t*)pmix_pointer_array_get_item(&proc->data, loc);
+    if (NULL != d) {
+        if (UINT32_MAX != d->qualindex) {
+            erase_qualifiers(proc, d->qualindex);
+        }
+        dstor_release(d);
+        pmix_pointer_array_set_item(&proc->data, loc, NULL);
+    }
+    mark_changed(proc, NULL);
+}
@@ -29,6 +29,14 @@ PMIX_EXPORT pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
                                           pmix_rank_t rank, pmix_kval_t *kin,
                                           pmix_info_t *qualifiers, size_t nquals);
 
+/* store a value that belongs to the given object without copying
+ * it. The entry holds a reference on the owner for as long as it
+ * holds the value, so values common to many ranks can be kept
+ * once. Small values are still held in the entry itself */
+PMIX_EXPORT pmix_status_t pmix_hash_store_shared(pmix_hash_table_t *table,
+                                                 pmix_rank_t rank, pmix_kval_t *kin,
+                                                 pmix_object_t *owner);
+
 /* Fetch the value for a specified key and rank from within
  * the given hash_table */
 PMIX_EXPORT pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
@@ -36,6 +44,14 @@ PMIX_EXPORT pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t
                                           pmix_info_t *qualifiers, size_t nquals,
                                           pmix_list_t *kvals);
 
+/* Fetch the values stored for the specified rank after the given
+ * epoch, returning the epoch of the latest change to its data. The
+ * epoch is zero if the table holds nothing for the rank. Removed
+ * values advance the epoch but are not reported */
+PMIX_EXPORT pmix_status_t pmix_hash_fetch_changed(pmix_hash_table_t *table, pmix_rank_t rank,
+                                                  uint64_t since, uint64_t *epoch,
+                                                  pmix_list_t *kvals);
+
 /* remove the specified key-value from the given hash_table.
  * A NULL key will result in removal of all data for the
  * given rank. A rank of PMIX_RANK_WILDCARD indicates that
@@ -53,6 +69,10 @@ PMIX_EXPORT void pmix_hash_register_key(uint32_t inid,
 PMIX_EXPORT pmix_regattr_input_t* pmix_hash_lookup_key(uint32_t inid,
                                                        const char *key);
 
+/* guard the key registry against use from several threads
+ * at once - for stores that are accessed that way */
+PMIX_EXPORT void pmix_hash_lock_keys(void);
+
 END_C_DECLS
 
 #endif /* PMIX_HASH_H */
@@ -87,15 +87,12 @@ int pmix_ifnametoaddr(const char *if_name, struct sockaddr *addr, int length)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (strcmp(intf->if_name, if_name) == 0) {
-            memcpy(addr, &intf->if_addr, length);
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)
+        || NULL == (intf = pmix_pif_base_lookup_name(if_name))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(addr, &intf->if_addr, length);
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -107,14 +104,11 @@ int pmix_ifnametoindex(const char *if_name)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (strcmp(intf->if_name, if_name) == 0) {
-            return intf->if_index;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)
+        || NULL == (intf = pmix_pif_base_lookup_name(if_name))) {
+        return -1;
     }
-    return -1;
+    return intf->if_index;
 }
 
 /*
@@ -126,14 +120,12 @@ int16_t pmix_ifnametokindex(const char *if_name)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (strcmp(intf->if_name, if_name) == 0) {
-            return intf->if_kernel_index;
-        }
+    /* may be called while walking the interfaces - don't refresh */
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_name(if_name))) {
+        return -1;
     }
-    return -1;
+    return intf->if_kernel_index;
 }
 
 /*
@@ -145,14 +137,11 @@ int pmix_ifindextokindex(int if_index)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (if_index == intf->if_index) {
-            return intf->if_kernel_index;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return -1;
     }
-    return -1;
+    return intf->if_kernel_index;
 }
 
 /*
@@ -165,6 +154,8 @@ int pmix_ifaddrtoname(const char *if_addr, char *if_name, int length)
     pmix_pif_t *intf;
     int error;
     struct addrinfo hints, *res = NULL, *r;
+    struct sockaddr_storage ss;
+    size_t len;
 
     /* if the user asked us not to resolve interfaces, then just return */
     if (pmix_if_do_not_resolve) {
@@ -174,6 +165,10 @@ int pmix_ifaddrtoname(const char *if_addr, char *if_name, int length)
         return PMIX_ERR_NOT_FOUND;
     }
 
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
     memset(&hints, 0, sizeof(hints));
     hints.ai_family = PF_UNSPEC;
     hints.ai_socktype = SOCK_STREAM;
@@ -187,30 +182,14 @@ int pmix_ifaddrtoname(const char *if_addr, char *if_name, int length)
     }
 
     for (r = res; r != NULL; r = r->ai_next) {
-        for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-             intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-             intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-
-            if (AF_INET == r->ai_family) {
-                struct sockaddr_in ipv4;
-                struct sockaddr_in *inaddr;
-
-                inaddr = (struct sockaddr_in *) &intf->if_addr;
-                memcpy(&ipv4, r->ai_addr, r->ai_addrlen);
-
-                if (inaddr->sin_addr.s_addr == ipv4.sin_addr.s_addr) {
-                    pmix_strncpy(if_name, intf->if_name, length - 1);
-                    freeaddrinfo(res);
-                    return PMIX_SUCCESS;
-                }
-            } else {
-                if (IN6_ARE_ADDR_EQUAL(&((struct sockaddr_in6 *) &intf->if_addr)->sin6_addr,
-                                       &((struct sockaddr_in6 *) r->ai_addr)->sin6_addr)) {
-                    pmix_strncpy(if_name, intf->if_name, length - 1);
-                    freeaddrinfo(res);
-                    return PMIX_SUCCESS;
-                }
-            }
+        memset(&ss, 0, sizeof(ss));
+        len = (r->ai_addrlen < sizeof(ss)) ? r->ai_addrlen : sizeof(ss);
+        memcpy(&ss, r->ai_addr, len);
+        intf = pmix_pif_base_lookup_addr(&ss);
+        if (NULL != intf) {
+            pmix_strncpy(if_name, intf->if_name, length - 1);
+            freeaddrinfo(res);
+            return PMIX_SUCCESS;
         }
     }
     if (NULL != res) {
@@ -234,6 +213,10 @@ int16_t pmix_ifaddrtokindex(const char *if_addr)
     int if_kernel_index;
     size_t len;
 
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
     memset(&hints, 0, sizeof(hints));
     hints.ai_family = PF_UNSPEC;
     hints.ai_socktype = SOCK_STREAM;
@@ -289,6 +272,9 @@ int16_t pmix_ifaddrtokindex(const char *if_addr)
 
 int pmix_ifcount(void)
 {
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)) {
+        return 0;
+    }
     return pmix_list_get_size(&pmix_if_list);
 }
 
@@ -301,6 +287,10 @@ int pmix_ifbegin(void)
 {
     pmix_pif_t *intf;
 
+    /* the start of a walk - pick up any changes first */
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)) {
+        return (-1);
+    }
     intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
     if (NULL != intf)
         return intf->if_index;
@@ -317,22 +307,19 @@ int pmix_ifnext(int if_index)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            do {
-                pmix_pif_t *if_next = (pmix_pif_t *) pmix_list_get_next(intf);
-                pmix_pif_t *if_end = (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-                if (if_next == if_end) {
-                    return -1;
-                }
-                intf = if_next;
-            } while (intf->if_index == if_index);
-            return intf->if_index;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return (-1);
     }
-    return (-1);
+    do {
+        pmix_pif_t *if_next = (pmix_pif_t *) pmix_list_get_next(intf);
+        pmix_pif_t *if_end = (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
+        if (if_next == if_end) {
+            return -1;
+        }
+        intf = if_next;
+    } while (intf->if_index == if_index);
+    return intf->if_index;
 }
 
 /*
@@ -344,15 +331,12 @@ int pmix_ifindextoaddr(int if_index, struct sockaddr *if_addr, unsigned int leng
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(if_addr, &intf->if_addr, MIN(length, sizeof(intf->if_addr)));
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_addr, &intf->if_addr, MIN(length, sizeof(intf->if_addr)));
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -363,15 +347,12 @@ int pmix_ifkindextoaddr(int if_kindex, struct sockaddr *if_addr, unsigned int le
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_kernel_index == if_kindex) {
-            memcpy(if_addr, &intf->if_addr, MIN(length, sizeof(intf->if_addr)));
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_kindex(if_kindex))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_addr, &intf->if_addr, MIN(length, sizeof(intf->if_addr)));
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -383,15 +364,12 @@ int pmix_ifindextomask(int if_index, uint32_t *if_mask, int length)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(if_mask, &intf->if_mask, length);
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_mask, &intf->if_mask, length);
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -403,15 +381,12 @@ int pmix_ifindextomac(int if_index, uint8_t mac[6])
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(mac, &intf->if_mac, 6);
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(mac, &intf->if_mac, 6);
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -423,15 +398,12 @@ int pmix_ifindextomtu(int if_index, int *mtu)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            *mtu = intf->ifmtu;
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    *mtu = intf->ifmtu;
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -443,15 +415,12 @@ int pmix_ifindextoflags(int if_index, uint32_t *if_flags)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(if_flags, &intf->if_flags, sizeof(uint32_t));
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_flags, &intf->if_flags, sizeof(uint32_t));
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -463,15 +432,12 @@ int pmix_ifindextoname(int if_index, char *if_name, int length)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            pmix_strncpy(if_name, intf->if_name, length - 1);
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    pmix_strncpy(if_name, intf->if_name, length - 1);
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -483,15 +449,12 @@ int pmix_ifkindextoname(int if_kindex, char *if_name, int length)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_kernel_index == if_kindex) {
-            pmix_strncpy(if_name, intf->if_name, length - 1);
-            return PMIX_SUCCESS;
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_kindex(if_kindex))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    pmix_strncpy(if_name, intf->if_name, length - 1);
+    return PMIX_SUCCESS;
 }
 
 #    define ADDRLEN 100
@@ -609,16 +572,11 @@ bool pmix_ifisloopback(int if_index)
 {
     pmix_pif_t *intf;
 
-    for (intf = (pmix_pif_t *) pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t *) pmix_list_get_end(&pmix_if_list);
-         intf = (pmix_pif_t *) pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            if ((intf->if_flags & IFF_LOOPBACK) != 0) {
-                return true;
-            }
-        }
+    if (PMIX_SUCCESS != pmix_pif_base_ready(false)
+        || NULL == (intf = pmix_pif_base_lookup_index(if_index))) {
+        return false;
     }
-    return false;
+    return (intf->if_flags & IFF_LOOPBACK) != 0;
 }
 
 /* Determine if an interface matches any entry in the given list, taking
@@ -683,6 +641,9 @@ void pmix_ifgetaliases(char ***aliases)
     struct sockaddr_in6 *addr6;
 #    endif
 
+    if (PMIX_SUCCESS != pmix_pif_base_ready(true)) {
+        return;
+    }
     PMIX_LIST_FOREACH(intf, &pmix_if_list, pmix_pif_t)
     {
         addr = (struct sockaddr_in *) &intf->if_addr;
@@ -24,12 +24,21 @@
 #include "src/include/pmix_config.h"
 
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "pmix_common.h"
+#include "src/include/pmix_globals.h"
 #include "src/util/keyval/keyval_lex.h"
 #include "src/util/pmix_keyval_parse.h"
+#include "src/util/pmix_os_path.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_printf.h"
 #include "src/util/pmix_string_copy.h"
 #include "src/threads/pmix_threads.h"
 
@@ -47,11 +56,255 @@ static void parse_error(int num, const char *filename);
 static char *env_str = NULL;
 static int envsize = 1024;
 
+static int add_to_env_str(char *var, char *val);
+
+/* A parsed file can be kept in a cache file in a node-local directory
+ * so that every other process on the node that reads it just maps
+ * the result instead of opening and lexing the original. The cache
+ * records what the parse produced - each callback with its line and
+ * each environment variable - in order, and is replayed in the same
+ * order. It is only used while the original has the same identity,
+ * size and times it had when the cache was made, and only if it
+ * belongs to us. Files that did not parse cleanly are not cached, so
+ * their errors are still reported */
+#define PMIX_KEYVAL_CACHE_MAGIC "PMIXKVC1"
+
+typedef struct {
+    char magic[8];
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime;
+    int64_t ctime;
+    uint32_t pathlen;
+    uint32_t nrecs;
+    uint64_t datalen;
+} pmix_keyval_cache_hdr_t;
+
+/* each record is followed by the name and then the value, both
+ * NULL-terminated - a NULL value has no bytes at all */
+typedef struct {
+    uint32_t kind;
+    int32_t lineno;
+    uint32_t namelen;
+    uint32_t vallen;
+} pmix_keyval_cache_rec_t;
+
+#define PMIX_KEYVAL_CACHE_PARAM 0
+#define PMIX_KEYVAL_CACHE_ENV   1
+
+static bool recording = false;
+static bool parse_failed = false;
+static char *rec_buf = NULL;
+static size_t rec_len = 0;
+static size_t rec_size = 0;
+static uint32_t rec_count = 0;
+static pmix_keyval_parse_fn_t rec_target = NULL;
+
+static void record(uint32_t kind, int lineno, const char *name, const char *value)
+{
+    pmix_keyval_cache_rec_t rec;
+    size_t need;
+    char *tmp;
+
+    rec.kind = kind;
+    rec.lineno = lineno;
+    rec.namelen = strlen(name) + 1;
+    rec.vallen = (NULL == value) ? 0 : strlen(value) + 1;
+    need = rec_len + sizeof(rec) + rec.namelen + rec.vallen;
+    if (need > rec_size) {
+        rec_size = (0 == rec_size) ? 4096 : rec_size;
+        while (rec_size < need) {
+            rec_size *= 2;
+        }
+        tmp = (char *) realloc(rec_buf, rec_size);
+        if (NULL == tmp) {
+            /* just don't cache this one */
+            parse_failed = true;
+            return;
+        }
+        rec_buf = tmp;
+    }
+    memcpy(rec_buf + rec_len, &rec, sizeof(rec));
+    rec_len += sizeof(rec);
+    memcpy(rec_buf + rec_len, name, rec.namelen);
+    rec_len += rec.namelen;
+    if (0 < rec.vallen) {
+        memcpy(rec_buf + rec_len, value, rec.vallen);
+        rec_len += rec.vallen;
+    }
+    ++rec_count;
+}
+
+static void record_callback(const char *file, int lineno, const char *name, const char *value)
+{
+    PMIX_HIDE_UNUSED_PARAMS(lineno);
+
+    record(PMIX_KEYVAL_CACHE_PARAM, pmix_util_keyval_parse_lineno, name, value);
+    rec_target(file, 0, name, value);
+}
+
+static char *cache_path(const char *filename, const char *cachedir)
+{
+    const unsigned char *str;
+    uint64_t hash = 14695981039346656037ULL;
+    char *name, *path;
+
+    /* name the cache after the file and its reader */
+    for (str = (const unsigned char *) filename; '\0' != *str; str++) {
+        hash ^= *str;
+        hash *= 1099511628211ULL;
+    }
+    if (0 > pmix_asprintf(&name, "pmix-keyval-%lu-%016llx.cache", (unsigned long) geteuid(),
+                          (unsigned long long) hash)) {
+        return NULL;
+    }
+    path = pmix_os_path(false, cachedir, name, NULL);
+    free(name);
+    return path;
+}
+
+static void fill_hdr(pmix_keyval_cache_hdr_t *hdr, const struct stat *sbuf, const char *filename)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    memcpy(hdr->magic, PMIX_KEYVAL_CACHE_MAGIC, sizeof(hdr->magic));
+    hdr->dev = (uint64_t) sbuf->st_dev;
+    hdr->ino = (uint64_t) sbuf->st_ino;
+    hdr->size = (uint64_t) sbuf->st_size;
+    hdr->mtime = (int64_t) sbuf->st_mtime;
+    hdr->ctime = (int64_t) sbuf->st_ctime;
+    hdr->pathlen = strlen(filename) + 1;
+}
+
+/* replay the cache of the file if it is still good */
+static bool cache_load(const char *filename, const char *cpath, const struct stat *fbuf,
+                       pmix_keyval_parse_fn_t callback)
+{
+    pmix_keyval_cache_hdr_t want, *hdr;
+    pmix_keyval_cache_rec_t rec;
+    struct stat sbuf;
+    char *base, *ptr, *end, *name, *value;
+    uint32_t n;
+    bool ok = false;
+    int fd;
+
+    fd = open(cpath, O_RDONLY);
+    if (0 > fd) {
+        return false;
+    }
+    if (0 != fstat(fd, &sbuf) || sbuf.st_uid != geteuid()
+        || (size_t) sbuf.st_size < sizeof(*hdr)) {
+        close(fd);
+        return false;
+    }
+    base = (char *) mmap(NULL, sbuf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == base) {
+        return false;
+    }
+
+    hdr = (pmix_keyval_cache_hdr_t *) base;
+    fill_hdr(&want, fbuf, filename);
+    end = base + sbuf.st_size;
+    ptr = base + sizeof(*hdr);
+    if (0 != memcmp(hdr->magic, want.magic, sizeof(want.magic)) || hdr->dev != want.dev
+        || hdr->ino != want.ino || hdr->size != want.size || hdr->mtime != want.mtime
+        || hdr->ctime != want.ctime || hdr->pathlen != want.pathlen
+        || (size_t)(end - ptr) < hdr->pathlen
+        || 0 != memcmp(ptr, filename, hdr->pathlen)
+        || (uint64_t)(end - ptr - hdr->pathlen) != hdr->datalen) {
+        goto done;
+    }
+    ptr += hdr->pathlen;
+
+    /* make sure every record is whole before replaying any of them */
+    name = ptr;
+    for (n = 0; n < hdr->nrecs; n++) {
+        if ((size_t)(end - ptr) < sizeof(rec)) {
+            goto done;
+        }
+        memcpy(&rec, ptr, sizeof(rec));
+        ptr += sizeof(rec);
+        if (0 == rec.namelen || (size_t)(end - ptr) < (size_t) rec.namelen + rec.vallen
+            || '\0' != ptr[rec.namelen - 1]
+            || (0 < rec.vallen && '\0' != ptr[rec.namelen + rec.vallen - 1])) {
+            goto done;
+        }
+        ptr += rec.namelen + rec.vallen;
+    }
+    if (ptr != end) {
+        goto done;
+    }
+
+    ptr = name;
+    for (n = 0; n < hdr->nrecs; n++) {
+        memcpy(&rec, ptr, sizeof(rec));
+        ptr += sizeof(rec);
+        name = ptr;
+        value = (0 == rec.vallen) ? NULL : ptr + rec.namelen;
+        ptr += rec.namelen + rec.vallen;
+        if (PMIX_KEYVAL_CACHE_ENV == rec.kind) {
+            add_to_env_str(name, value);
+        } else {
+            pmix_util_keyval_parse_lineno = rec.lineno;
+            callback(filename, 0, name, value);
+        }
+    }
+    ok = true;
+
+done:
+    munmap(base, sbuf.st_size);
+    return ok;
+}
+
+/* write what we recorded where the other readers of the file will
+ * find it - the rename makes it appear all at once */
+static void cache_store(const char *filename, const char *cpath, const struct stat *fbuf)
+{
+    pmix_keyval_cache_hdr_t hdr;
+    char *tmppath;
+    FILE *fp;
+    int fd;
+    bool ok;
+
+    if (0 > pmix_asprintf(&tmppath, "%s.%lu", cpath, (unsigned long) getpid())) {
+        return;
+    }
+    fd = open(tmppath, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (0 > fd) {
+        free(tmppath);
+        return;
+    }
+    fp = fdopen(fd, "w");
+    if (NULL == fp) {
+        close(fd);
+        unlink(tmppath);
+        free(tmppath);
+        return;
+    }
+    fill_hdr(&hdr, fbuf, filename);
+    hdr.nrecs = rec_count;
+    hdr.datalen = rec_len;
+    ok = (1 == fwrite(&hdr, sizeof(hdr), 1, fp)
+          && 1 == fwrite(filename, hdr.pathlen, 1, fp)
+          && (0 == rec_len || 1 == fwrite(rec_buf, rec_len, 1, fp)));
+    if (0 != fclose(fp)) {
+        ok = false;
+    }
+    if (!ok || 0 != rename(tmppath, cpath)) {
+        unlink(tmppath);
+    }
+    free(tmppath);
+}
+
 void pmix_util_keyval_parse_finalize(void)
 {
     free(key_buffer);
     key_buffer = NULL;
     key_buffer_len = 0;
+    free(rec_buf);
+    rec_buf = NULL;
+    rec_size = 0;
 
     PMIX_DESTRUCT(&keyval_mutex);
 }
@@ -63,19 +316,14 @@ int pmix_util_keyval_parse_init(void)
     return PMIX_SUCCESS;
 }
 
-int pmix_util_keyval_parse(const char *filename, pmix_keyval_parse_fn_t callback)
+static int parse_file(const char *filename, pmix_keyval_parse_fn_t callback)
 {
     int val;
-    int ret = PMIX_SUCCESS;
-    ;
-
-    pmix_mutex_lock(&keyval_mutex);
 
     /* Open the pmix */
     pmix_util_keyval_yyin = fopen(filename, "r");
     if (NULL == pmix_util_keyval_yyin) {
-        ret = PMIX_ERR_NOT_FOUND;
-        goto cleanup;
+        return PMIX_ERR_NOT_FOUND;
     }
 
     pmix_util_keyval_parse_done = false;
@@ -111,12 +359,58 @@ int pmix_util_keyval_parse(const char *filename, pmix_keyval_parse_fn_t callback
     }
     fclose(pmix_util_keyval_yyin);
     pmix_util_keyval_yylex_destroy();
+    return PMIX_SUCCESS;
+}
 
-cleanup:
+int pmix_util_keyval_parse(const char *filename, pmix_keyval_parse_fn_t callback)
+{
+    int ret;
+
+    pmix_mutex_lock(&keyval_mutex);
+    ret = parse_file(filename, callback);
     pmix_mutex_unlock(&keyval_mutex);
     return ret;
 }
 
+int pmix_util_keyval_parse_cached(const char *filename, const char *cachedir,
+                                  pmix_keyval_parse_fn_t callback)
+{
+    struct stat fbuf;
+    char *cpath;
+    int ret;
+
+    if (NULL == cachedir || 0 != stat(filename, &fbuf) || !S_ISREG(fbuf.st_mode)) {
+        return pmix_util_keyval_parse(filename, callback);
+    }
+    cpath = cache_path(filename, cachedir);
+    if (NULL == cpath) {
+        return pmix_util_keyval_parse(filename, callback);
+    }
+
+    pmix_mutex_lock(&keyval_mutex);
+    if (cache_load(filename, cpath, &fbuf, callback)) {
+        pmix_mutex_unlock(&keyval_mutex);
+        free(cpath);
+        return PMIX_SUCCESS;
+    }
+
+    /* parse it ourselves, recording the results */
+    recording = true;
+    parse_failed = false;
+    rec_len = 0;
+    rec_count = 0;
+    rec_target = callback;
+    ret = parse_file(filename, record_callback);
+    recording = false;
+    rec_target = NULL;
+    if (PMIX_SUCCESS == ret && !parse_failed) {
+        cache_store(filename, cpath, &fbuf);
+    }
+    pmix_mutex_unlock(&keyval_mutex);
+    free(cpath);
+    return ret;
+}
+
 static int parse_line(const char *filename, pmix_keyval_parse_fn_t callback)
 {
     int val;
@@ -175,6 +469,7 @@ static int parse_line(const char *filename, pmix_keyval_parse_fn_t callback)
 
 static void parse_error(int num, const char *filename)
 {
+    parse_failed = true;
     /* JMS need better error/warning message here */
     pmix_output(0, "keyval parser: error %d reading file %s at line %d:\n  %s\n", num, filename,
                 pmix_util_keyval_yynewlines, pmix_util_keyval_yytext);
@@ -259,6 +554,9 @@ static int add_to_env_str(char *var, char *val)
     if (NULL == var) {
         return PMIX_ERR_BAD_PARAM;
     }
+    if (recording) {
+        record(PMIX_KEYVAL_CACHE_ENV, 0, var, val);
+    }
 
     varsz = strlen(var);
     if (NULL != val) {
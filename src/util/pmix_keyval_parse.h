@@ -51,6 +51,16 @@ typedef void (*pmix_keyval_parse_fn_t)(const char *file, int lineno,
  */
 PMIX_EXPORT int pmix_util_keyval_parse(const char *filename, pmix_keyval_parse_fn_t callback);
 
+/**
+ * Parse \c filename as pmix_util_keyval_parse() does, keeping what
+ * the parse produced in a cache file in \c cachedir. Later parses of
+ * the same unchanged file, by this or any other process of the same
+ * user that uses the same directory, replay the cache instead. A
+ * NULL \c cachedir parses the file without caching.
+ */
+PMIX_EXPORT int pmix_util_keyval_parse_cached(const char *filename, const char *cachedir,
+                                              pmix_keyval_parse_fn_t callback);
+
 PMIX_EXPORT int pmix_util_keyval_parse_init(void);
 
 PMIX_EXPORT void pmix_util_keyval_parse_finalize(void);
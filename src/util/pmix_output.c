@@ -43,6 +43,7 @@
 
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_output.h"
+#include "src/util/pmix_output_async.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_printf.h"
 
@@ -91,9 +92,10 @@ static void destruct(pmix_object_t *stream);
 static int do_open(int output_id, pmix_output_stream_t *lds);
 static int open_file(int i);
 static void free_descriptor(int output_id);
-static int make_string(char **out, char **no_newline_string, output_desc_t *ldi, const char *format,
-                       va_list arglist);
+static int make_string(char **out, char *no_newline_string, output_desc_t *ldi);
 static int output(int output_id, const char *format, va_list arglist);
+static int emit(int output_id, char *str);
+static void async_emit(int output_id, char *str);
 
 #define PMIX_OUTPUT_MAX_STREAMS 64
 #if defined(HAVE_SYSLOG)
@@ -205,6 +207,15 @@ bool pmix_output_init(void)
 
     /* Open the default verbose stream */
     verbose_stream = pmix_output_open(&verbose);
+
+    /* hand the output to a writer thread if asked to */
+    if (NULL != getenv("PMIX_OUTPUT_ASYNC")) {
+        if (0 > asprintf(&str, "%s/%sasync.bin", output_dir, output_prefix)) {
+            str = NULL;
+        }
+        pmix_output_async_init(async_emit, str);
+        free(str);
+    }
     return true;
 }
 
@@ -289,6 +300,8 @@ void pmix_output_close(int output_id)
 
     if (output_id >= 0 && output_id < PMIX_OUTPUT_MAX_STREAMS && info[output_id].ldi_used
         && info[output_id].ldi_enabled) {
+        /* let the writer thread output what is queued for it */
+        pmix_output_async_flush();
         free_descriptor(output_id);
 
         /* If no one has the syslog open, we should close it */
@@ -424,6 +437,7 @@ void pmix_output_hexdump(int verbose_level, int output_id, void *ptr, int buflen
 void pmix_output_finalize(void)
 {
     if (initialized) {
+        pmix_output_async_finalize();
         if (verbose_stream != -1) {
             pmix_output_close(verbose_stream);
         }
@@ -741,27 +755,23 @@ static void free_descriptor(int output_id)
     }
 }
 
-static int make_string(char **out, char **no_newline_string, output_desc_t *ldi, const char *format,
-                       va_list arglist)
+static int make_string(char **out, char *no_newline_string, output_desc_t *ldi)
 {
     size_t len, total_len, temp_str_len;
     bool want_newline = false;
     char *temp_str;
 
-    /* Make the formatted string */
+    /* Decorate the formatted string */
     *out = NULL;
-    if (0 > vasprintf(no_newline_string, format, arglist)) {
-        return PMIX_ERR_NOMEM;
-    }
-    total_len = len = strlen(*no_newline_string);
-    if ('\n' != (*no_newline_string)[len - 1]) {
+    total_len = len = strlen(no_newline_string);
+    if ('\n' != no_newline_string[len - 1]) {
         want_newline = true;
         ++total_len;
     } else if (NULL != ldi->ldi_suffix) {
         /* if we have a suffix, then we don't want a
          * newline to appear before it
          */
-        (*no_newline_string)[len - 1] = '\0';
+        no_newline_string[len - 1] = '\0';
         want_newline = true; /* add newline to end after suffix */
         /* total_len won't change since we just moved the newline
          * to appear after the suffix
@@ -780,29 +790,29 @@ static int make_string(char **out, char **no_newline_string, output_desc_t *ldi,
     temp_str_len = total_len * 2;
     if (NULL != ldi->ldi_prefix && NULL != ldi->ldi_suffix) {
         if (want_newline) {
-            pmix_snprintf(temp_str, temp_str_len, "%s%s%s\n", ldi->ldi_prefix, *no_newline_string,
+            pmix_snprintf(temp_str, temp_str_len, "%s%s%s\n", ldi->ldi_prefix, no_newline_string,
                      ldi->ldi_suffix);
         } else {
-            pmix_snprintf(temp_str, temp_str_len, "%s%s%s", ldi->ldi_prefix, *no_newline_string,
+            pmix_snprintf(temp_str, temp_str_len, "%s%s%s", ldi->ldi_prefix, no_newline_string,
                      ldi->ldi_suffix);
         }
     } else if (NULL != ldi->ldi_prefix) {
         if (want_newline) {
-            pmix_snprintf(temp_str, temp_str_len, "%s%s\n", ldi->ldi_prefix, *no_newline_string);
+            pmix_snprintf(temp_str, temp_str_len, "%s%s\n", ldi->ldi_prefix, no_newline_string);
         } else {
-            pmix_snprintf(temp_str, temp_str_len, "%s%s", ldi->ldi_prefix, *no_newline_string);
+            pmix_snprintf(temp_str, temp_str_len, "%s%s", ldi->ldi_prefix, no_newline_string);
         }
     } else if (NULL != ldi->ldi_suffix) {
         if (want_newline) {
-            pmix_snprintf(temp_str, temp_str_len, "%s%s\n", *no_newline_string, ldi->ldi_suffix);
+            pmix_snprintf(temp_str, temp_str_len, "%s%s\n", no_newline_string, ldi->ldi_suffix);
         } else {
-            pmix_snprintf(temp_str, temp_str_len, "%s%s", *no_newline_string, ldi->ldi_suffix);
+            pmix_snprintf(temp_str, temp_str_len, "%s%s", no_newline_string, ldi->ldi_suffix);
         }
     } else {
         if (want_newline) {
-            pmix_snprintf(temp_str, temp_str_len, "%s\n", *no_newline_string);
+            pmix_snprintf(temp_str, temp_str_len, "%s\n", no_newline_string);
         } else {
-            pmix_snprintf(temp_str, temp_str_len, "%s", *no_newline_string);
+            pmix_snprintf(temp_str, temp_str_len, "%s", no_newline_string);
         }
     }
     *out = temp_str;
@@ -817,8 +827,7 @@ static int make_string(char **out, char **no_newline_string, output_desc_t *ldi,
 static int output(int output_id, const char *format, va_list arglist)
 {
     int rc = PMIX_SUCCESS;
-    char *str = NULL, *out = NULL;
-    output_desc_t *ldi;
+    char *str = NULL;
 
     /* Setup */
 
@@ -828,12 +837,39 @@ static int output(int output_id, const char *format, va_list arglist)
 
     /* If it's valid, used, and enabled, output */
 
+    if (output_id >= 0 && output_id < PMIX_OUTPUT_MAX_STREAMS && info[output_id].ldi_used
+        && info[output_id].ldi_enabled) {
+        /* leave the formatting and the writes to the writer thread
+         * if there is one */
+        if (pmix_output_async_enqueue(output_id, format, arglist)) {
+            return PMIX_SUCCESS;
+        }
+
+        /* Make the string */
+        if (0 > vasprintf(&str, format, arglist)) {
+            return PMIX_ERR_NOMEM;
+        }
+        rc = emit(output_id, str);
+        free(str);
+    }
+    return rc;
+}
+
+/*
+ * Write a formatted message to the sinks of a stream
+ */
+static int emit(int output_id, char *str)
+{
+    int rc = PMIX_SUCCESS;
+    char *out = NULL;
+    output_desc_t *ldi;
+
     if (output_id >= 0 && output_id < PMIX_OUTPUT_MAX_STREAMS && info[output_id].ldi_used
         && info[output_id].ldi_enabled) {
         ldi = &info[output_id];
 
         /* Make the strings */
-        if (PMIX_SUCCESS != (rc = make_string(&out, &str, ldi, format, arglist))) {
+        if (PMIX_SUCCESS != (rc = make_string(&out, str, ldi))) {
             goto cleanup;
         }
 
@@ -893,20 +929,20 @@ static int output(int output_id, const char *format, va_list arglist)
                 }
             }
         }
-        free(str);
-        str = NULL;
     }
 
 cleanup:
-    if (NULL != str) {
-        free(str);
-    }
     if (NULL != out) {
         free(out);
     }
     return rc;
 }
 
+static void async_emit(int output_id, char *str)
+{
+    (void) emit(output_id, str);
+}
+
 int pmix_output_get_verbosity(int output_id)
 {
     if (output_id >= 0 && output_id < PMIX_OUTPUT_MAX_STREAMS && info[output_id].ldi_used) {
@@ -90,6 +90,10 @@ BEGIN_C_DECLS
  *                        output sent to syslog at that priority
  * PMIX_OUTPUT_SYSLOG_IDENT - a string identifier for the log
  *
+ * Output can also be handed to a writer thread, or recorded in binary
+ * form for offline decoding, by setting PMIX_OUTPUT_ASYNC - see
+ * pmix_output_async.h
+ *
  * We also define two global variables that notify all other
  * layers that output is being redirected to syslog at the given
  * priority. These are used, for example, by the IO forwarding
@@ -0,0 +1,887 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "pmix_common.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#    include <sys/stat.h>
+#endif
+
+#include "src/include/pmix_atomic.h"
+#include "src/include/pmix_globals.h"
+#include "src/threads/pmix_threads.h"
+#include "src/threads/pmix_tsd.h"
+#include "src/util/pmix_output_async.h"
+
+/* default size of the ring of a thread */
+#define PMIX_OUTPUT_ASYNC_RING_SIZE (256 * 1024)
+/* largest record a caller builds - a message with longer string
+ * arguments is output synchronously */
+#define PMIX_OUTPUT_ASYNC_MAX_RECORD 4096
+/* how long the writer sleeps when all the rings are empty */
+#define PMIX_OUTPUT_ASYNC_IDLE_NSEC 1000000
+/* the rest of the ring is unused, the next record is at its start */
+#define PMIX_OUTPUT_ASYNC_WRAP 0xffffffffu
+#define PMIX_OUTPUT_ASYNC_MAGIC "PMIXLOG1"
+#define PMIX_OUTPUT_ASYNC_VERSION 1
+
+/* A record is the header, the format string with its NUL, and for
+ * each conversion of the format a one-byte tag and the value of its
+ * argument: 'i' int64, 'u' uint64, 'f' double, 'p' uint64 pointer,
+ * 's' a uint32 length and the bytes of the string without its NUL,
+ * 'n' a NULL string. Records are padded to 8 bytes. The binary mode
+ * writes the records as they are, after a file header of the magic
+ * string, the version and 0x01020304 in host byte order - the
+ * decoder in contrib depends on this layout */
+typedef struct {
+    uint32_t len;
+    uint16_t stream;
+    uint16_t nargs;
+    uint32_t thread;
+    uint32_t fmtlen;
+    uint64_t nsec;
+} pmix_output_record_t;
+
+/* Each thread that outputs has a ring of its own - only that thread
+ * writes to it and only the writer thread reads from it, so neither
+ * takes a lock. Rings are never released: when its thread exits, a
+ * ring is handed to the next thread that needs one */
+typedef struct pmix_output_ring_t {
+    struct pmix_output_ring_t *next;
+    char *buf;
+    uint64_t size;
+    uint32_t id;
+    /* bytes written by the owner and consumed by the writer, since
+     * the ring was created */
+    volatile uint64_t head;
+    volatile uint64_t tail;
+    /* messages that did not fit, and how many were reported */
+    volatile uint64_t dropped;
+    uint64_t reported;
+    volatile bool idle;
+} pmix_output_ring_t;
+
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t size;
+} pmix_output_strbuf_t;
+
+typedef enum {
+    PMIX_OUTPUT_LEN_NONE,
+    PMIX_OUTPUT_LEN_HH,
+    PMIX_OUTPUT_LEN_H,
+    PMIX_OUTPUT_LEN_L,
+    PMIX_OUTPUT_LEN_LL,
+    PMIX_OUTPUT_LEN_Z,
+    PMIX_OUTPUT_LEN_J,
+    PMIX_OUTPUT_LEN_T,
+    PMIX_OUTPUT_LEN_BIG_L
+} pmix_output_len_t;
+
+static struct {
+    volatile bool active;
+    volatile bool stop;
+    bool started;
+    bool binary;
+    bool key_created;
+    bool atfork;
+    pmix_output_async_emit_fn_t emit;
+    int fd;
+    uint64_t ring_size;
+    pmix_tsd_key_t key;
+    pmix_mutex_t lock;
+    pmix_output_ring_t *volatile rings;
+    uint32_t nrings;
+    pmix_thread_t writer;
+    pmix_output_strbuf_t text;
+    char *out;
+    size_t outlen;
+} async = {
+    .active = false,
+    .stop = false,
+    .started = false,
+    .binary = false,
+    .key_created = false,
+    .atfork = false,
+    .emit = NULL,
+    .fd = -1,
+    .ring_size = PMIX_OUTPUT_ASYNC_RING_SIZE,
+    .lock = PMIX_MUTEX_STATIC_INIT,
+    .rings = NULL,
+    .nrings = 0,
+    .text = {NULL, 0, 0},
+    .out = NULL,
+    .outlen = 0
+};
+
+/************************************************************************/
+/* the side of the threads calling pmix_output */
+
+static void release_ring(void *ptr)
+{
+    pmix_output_ring_t *ring = (pmix_output_ring_t *) ptr;
+
+    if (NULL != ring) {
+        pmix_mutex_lock(&async.lock);
+        ring->idle = true;
+        pmix_mutex_unlock(&async.lock);
+    }
+}
+
+static pmix_output_ring_t *get_ring(void)
+{
+    pmix_output_ring_t *ring;
+    void *ptr = NULL;
+
+    if (PMIX_SUCCESS == pmix_tsd_getspecific(async.key, &ptr) && NULL != ptr) {
+        return (pmix_output_ring_t *) ptr;
+    }
+
+    pmix_mutex_lock(&async.lock);
+    for (ring = async.rings; NULL != ring; ring = ring->next) {
+        if (ring->idle) {
+            ring->idle = false;
+            break;
+        }
+    }
+    if (NULL == ring) {
+        ring = (pmix_output_ring_t *) calloc(1, sizeof(pmix_output_ring_t));
+        if (NULL != ring) {
+            ring->buf = (char *) malloc(async.ring_size);
+            if (NULL == ring->buf) {
+                free(ring);
+                ring = NULL;
+            } else {
+                ring->size = async.ring_size;
+                ring->id = async.nrings++;
+                ring->next = async.rings;
+                /* the writer walks the list without the lock */
+                pmix_atomic_wmb();
+                async.rings = ring;
+            }
+        }
+    }
+    pmix_mutex_unlock(&async.lock);
+
+    if (NULL != ring) {
+        pmix_tsd_setspecific(async.key, ring);
+    }
+    return ring;
+}
+
+static const char *parse_spec(const char *p, pmix_output_len_t *lmod)
+{
+    /* flags, width and precision */
+    while ('\0' != *p && NULL != strchr("-+ #0'", *p)) {
+        ++p;
+    }
+    while (isdigit((unsigned char) *p)) {
+        ++p;
+    }
+    if ('.' == *p) {
+        ++p;
+        while (isdigit((unsigned char) *p)) {
+            ++p;
+        }
+    }
+    *lmod = PMIX_OUTPUT_LEN_NONE;
+    switch (*p) {
+    case 'h':
+        ++p;
+        if ('h' == *p) {
+            ++p;
+            *lmod = PMIX_OUTPUT_LEN_HH;
+        } else {
+            *lmod = PMIX_OUTPUT_LEN_H;
+        }
+        break;
+    case 'l':
+        ++p;
+        if ('l' == *p) {
+            ++p;
+            *lmod = PMIX_OUTPUT_LEN_LL;
+        } else {
+            *lmod = PMIX_OUTPUT_LEN_L;
+        }
+        break;
+    case 'q':
+        ++p;
+        *lmod = PMIX_OUTPUT_LEN_LL;
+        break;
+    case 'z':
+        ++p;
+        *lmod = PMIX_OUTPUT_LEN_Z;
+        break;
+    case 'j':
+        ++p;
+        *lmod = PMIX_OUTPUT_LEN_J;
+        break;
+    case 't':
+        ++p;
+        *lmod = PMIX_OUTPUT_LEN_T;
+        break;
+    case 'L':
+        ++p;
+        *lmod = PMIX_OUTPUT_LEN_BIG_L;
+        break;
+    default:
+        break;
+    }
+    return p;
+}
+
+static int64_t signed_arg(pmix_output_len_t lmod, va_list *ap)
+{
+    switch (lmod) {
+    case PMIX_OUTPUT_LEN_L:
+        return (int64_t) va_arg(*ap, long);
+    case PMIX_OUTPUT_LEN_LL:
+        return (int64_t) va_arg(*ap, long long);
+    case PMIX_OUTPUT_LEN_Z:
+        return (int64_t) va_arg(*ap, ssize_t);
+    case PMIX_OUTPUT_LEN_J:
+        return (int64_t) va_arg(*ap, intmax_t);
+    case PMIX_OUTPUT_LEN_T:
+        return (int64_t) va_arg(*ap, ptrdiff_t);
+    case PMIX_OUTPUT_LEN_HH:
+        return (int64_t) (signed char) va_arg(*ap, int);
+    case PMIX_OUTPUT_LEN_H:
+        return (int64_t) (short) va_arg(*ap, int);
+    default:
+        return (int64_t) va_arg(*ap, int);
+    }
+}
+
+static uint64_t unsigned_arg(pmix_output_len_t lmod, va_list *ap)
+{
+    switch (lmod) {
+    case PMIX_OUTPUT_LEN_L:
+        return (uint64_t) va_arg(*ap, unsigned long);
+    case PMIX_OUTPUT_LEN_LL:
+        return (uint64_t) va_arg(*ap, unsigned long long);
+    case PMIX_OUTPUT_LEN_Z:
+        return (uint64_t) va_arg(*ap, size_t);
+    case PMIX_OUTPUT_LEN_J:
+        return (uint64_t) va_arg(*ap, uintmax_t);
+    case PMIX_OUTPUT_LEN_T:
+        return (uint64_t) va_arg(*ap, ptrdiff_t);
+    case PMIX_OUTPUT_LEN_HH:
+        return (uint64_t) (unsigned char) va_arg(*ap, unsigned int);
+    case PMIX_OUTPUT_LEN_H:
+        return (uint64_t) (unsigned short) va_arg(*ap, unsigned int);
+    default:
+        return (uint64_t) va_arg(*ap, unsigned int);
+    }
+}
+
+/* copy the format and its arguments into a record - returns the
+ * length of the record, or 0 if the message cannot be captured */
+static uint32_t capture(char *rec, uint32_t thread, int output_id, const char *format,
+                        va_list arglist)
+{
+    pmix_output_record_t hdr;
+    pmix_output_len_t lmod;
+    char *pos, *end = rec + PMIX_OUTPUT_ASYNC_MAX_RECORD;
+    const char *p, *sval;
+    struct timespec ts;
+    size_t fmtlen, slen;
+    uint32_t len32;
+    int64_t ival;
+    uint64_t uval;
+    double dval;
+    uint16_t nargs = 0;
+    uint32_t rc = 0;
+    char tag;
+    va_list ap;
+
+    fmtlen = strlen(format) + 1;
+    if (sizeof(hdr) + fmtlen > PMIX_OUTPUT_ASYNC_MAX_RECORD) {
+        return 0;
+    }
+    pos = rec + sizeof(hdr);
+    memcpy(pos, format, fmtlen);
+    pos += fmtlen;
+
+    va_copy(ap, arglist);
+    for (p = format; '\0' != *p; p++) {
+        if ('%' != *p) {
+            continue;
+        }
+        ++p;
+        if ('%' == *p) {
+            continue;
+        }
+        /* a "*" width or precision ends up as the conversion, and
+         * is refused below */
+        p = parse_spec(p, &lmod);
+        if ((size_t) (end - pos) < 1 + sizeof(uint64_t)) {
+            goto done;
+        }
+        switch (*p) {
+        case 'd':
+        case 'i':
+        case 'c':
+            tag = 'i';
+            ival = ('c' == *p) ? (int64_t) va_arg(ap, int) : signed_arg(lmod, &ap);
+            memcpy(pos + 1, &ival, sizeof(ival));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            tag = 'u';
+            uval = unsigned_arg(lmod, &ap);
+            memcpy(pos + 1, &uval, sizeof(uval));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            tag = 'f';
+            if (PMIX_OUTPUT_LEN_BIG_L == lmod) {
+                dval = (double) va_arg(ap, long double);
+            } else {
+                dval = va_arg(ap, double);
+            }
+            memcpy(pos + 1, &dval, sizeof(dval));
+            break;
+        case 'p':
+            tag = 'p';
+            uval = (uint64_t) (uintptr_t) va_arg(ap, void *);
+            memcpy(pos + 1, &uval, sizeof(uval));
+            break;
+        case 's':
+            sval = va_arg(ap, const char *);
+            if (NULL == sval) {
+                tag = 'n';
+                break;
+            }
+            tag = 's';
+            slen = strlen(sval);
+            if ((size_t) (end - pos) < 1 + sizeof(len32) + slen) {
+                goto done;
+            }
+            len32 = (uint32_t) slen;
+            memcpy(pos + 1, &len32, sizeof(len32));
+            memcpy(pos + 1 + sizeof(len32), sval, slen);
+            break;
+        default:
+            /* e.g., %n or %m */
+            goto done;
+        }
+        *pos = tag;
+        if ('s' == tag) {
+            pos += 1 + sizeof(len32) + len32;
+        } else if ('n' == tag) {
+            pos += 1;
+        } else {
+            pos += 1 + sizeof(uint64_t);
+        }
+        ++nargs;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    hdr.len = (uint32_t) (((pos - rec) + 7) & ~((ptrdiff_t) 7));
+    if (hdr.len > PMIX_OUTPUT_ASYNC_MAX_RECORD) {
+        goto done;
+    }
+    memset(pos, 0, hdr.len - (pos - rec));
+    hdr.stream = (uint16_t) output_id;
+    hdr.nargs = nargs;
+    hdr.thread = thread;
+    hdr.fmtlen = (uint32_t) fmtlen;
+    hdr.nsec = (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+    memcpy(rec, &hdr, sizeof(hdr));
+    rc = hdr.len;
+
+done:
+    va_end(ap);
+    return rc;
+}
+
+static uint32_t build(char *rec, uint32_t thread, int output_id, const char *format, ...)
+{
+    va_list ap;
+    uint32_t len;
+
+    va_start(ap, format);
+    len = capture(rec, thread, output_id, format, ap);
+    va_end(ap);
+    return len;
+}
+
+static bool push(pmix_output_ring_t *ring, const char *rec, uint32_t len)
+{
+    uint64_t head, tail, off, skip = 0;
+    uint32_t wrap = PMIX_OUTPUT_ASYNC_WRAP;
+
+    head = ring->head;
+    tail = ring->tail;
+    /* the writer is done with the space up to the tail */
+    pmix_atomic_rmb();
+    off = head % ring->size;
+    if (ring->size - off < len) {
+        skip = ring->size - off;
+    }
+    if (ring->size - (head - tail) < skip + len) {
+        return false;
+    }
+    if (0 < skip) {
+        memcpy(ring->buf + off, &wrap, sizeof(wrap));
+        off = 0;
+    }
+    memcpy(ring->buf + off, rec, len);
+    /* the record must be complete before the writer can see it */
+    pmix_atomic_wmb();
+    ring->head = head + skip + len;
+    return true;
+}
+
+static void wait_for(pmix_output_ring_t *ring, uint64_t target)
+{
+    struct timespec ts = {0, PMIX_OUTPUT_ASYNC_IDLE_NSEC / 10};
+
+    while (async.started && (int64_t) (target - ring->tail) > 0) {
+        nanosleep(&ts, NULL);
+    }
+}
+
+bool pmix_output_async_enqueue(int output_id, const char *format, va_list arglist)
+{
+    char rec[PMIX_OUTPUT_ASYNC_MAX_RECORD];
+    pmix_output_ring_t *ring;
+    uint32_t len;
+
+    if (!async.active) {
+        return false;
+    }
+    ring = get_ring();
+    if (NULL == ring) {
+        return false;
+    }
+    len = capture(rec, ring->id, output_id, format, arglist);
+    if (0 == len) {
+        /* the caller outputs it - after what we queued before */
+        wait_for(ring, ring->head);
+        return false;
+    }
+    if (!push(ring, rec, len)) {
+        /* rather than block the caller */
+        ring->dropped++;
+    }
+    return true;
+}
+
+void pmix_output_async_flush(void)
+{
+    pmix_output_ring_t *ring;
+
+    if (!async.started) {
+        return;
+    }
+    for (ring = async.rings; NULL != ring; ring = ring->next) {
+        wait_for(ring, ring->head);
+    }
+}
+
+/************************************************************************/
+/* the side of the writer thread */
+
+static void sb_append(pmix_output_strbuf_t *sb, const char *fmt, ...)
+{
+    va_list ap;
+    size_t size;
+    char *tmp;
+    int n;
+
+    while (1) {
+        va_start(ap, fmt);
+        n = vsnprintf(sb->buf + sb->len, sb->size - sb->len, fmt, ap);
+        va_end(ap);
+        if (0 > n) {
+            return;
+        }
+        if ((size_t) n < sb->size - sb->len) {
+            sb->len += n;
+            return;
+        }
+        size = 2 * sb->size;
+        while (size < sb->len + n + 1) {
+            size *= 2;
+        }
+        tmp = (char *) realloc(sb->buf, size);
+        if (NULL == tmp) {
+            return;
+        }
+        sb->buf = tmp;
+        sb->size = size;
+    }
+}
+
+/* the formatted message of a record, in the text buffer */
+static void format_record(const char *rec)
+{
+    pmix_output_strbuf_t *sb = &async.text;
+    pmix_output_record_t hdr;
+    pmix_output_len_t lmod;
+    const char *fmt, *args, *p, *q, *start;
+    char spec[64], *str;
+    size_t n;
+    uint32_t len32;
+    int64_t ival;
+    uint64_t uval;
+    double dval;
+
+    memcpy(&hdr, rec, sizeof(hdr));
+    fmt = rec + sizeof(hdr);
+    args = fmt + hdr.fmtlen;
+    sb->len = 0;
+    sb->buf[0] = '\0';
+
+    for (p = fmt; '\0' != *p;) {
+        if ('%' != *p) {
+            q = strchr(p, '%');
+            n = (NULL == q) ? strlen(p) : (size_t) (q - p);
+            sb_append(sb, "%.*s", (int) n, p);
+            p += n;
+            continue;
+        }
+        start = p++;
+        if ('%' == *p) {
+            sb_append(sb, "%%");
+            ++p;
+            continue;
+        }
+        /* the flags, width and precision as given - the length
+         * modifier is replaced by that of the value we kept */
+        q = parse_spec(p, &lmod);
+        n = 0;
+        for (; start < q && n < sizeof(spec) - 4; start++) {
+            if (NULL != strchr("hlqzjtL", *start)) {
+                continue;
+            }
+            spec[n++] = *start;
+        }
+        p = q + 1;
+
+        switch (*args) {
+        case 'i':
+            memcpy(&ival, args + 1, sizeof(ival));
+            args += 1 + sizeof(ival);
+            if ('c' == *q) {
+                spec[n++] = 'c';
+                spec[n] = '\0';
+                sb_append(sb, spec, (int) ival);
+            } else {
+                spec[n++] = 'l';
+                spec[n++] = 'l';
+                spec[n++] = *q;
+                spec[n] = '\0';
+                sb_append(sb, spec, (long long) ival);
+            }
+            break;
+        case 'u':
+            memcpy(&uval, args + 1, sizeof(uval));
+            args += 1 + sizeof(uval);
+            spec[n++] = 'l';
+            spec[n++] = 'l';
+            spec[n++] = *q;
+            spec[n] = '\0';
+            sb_append(sb, spec, (unsigned long long) uval);
+            break;
+        case 'f':
+            memcpy(&dval, args + 1, sizeof(dval));
+            args += 1 + sizeof(dval);
+            spec[n++] = *q;
+            spec[n] = '\0';
+            sb_append(sb, spec, dval);
+            break;
+        case 'p':
+            memcpy(&uval, args + 1, sizeof(uval));
+            args += 1 + sizeof(uval);
+            spec[n++] = 'p';
+            spec[n] = '\0';
+            sb_append(sb, spec, (void *) (uintptr_t) uval);
+            break;
+        case 's':
+            memcpy(&len32, args + 1, sizeof(len32));
+            str = strndup(args + 1 + sizeof(len32), len32);
+            args += 1 + sizeof(len32) + len32;
+            spec[n++] = 's';
+            spec[n] = '\0';
+            if (NULL != str) {
+                sb_append(sb, spec, str);
+                free(str);
+            }
+            break;
+        default:
+            ++args;
+            spec[n++] = 's';
+            spec[n] = '\0';
+            sb_append(sb, spec, "(null)");
+            break;
+        }
+    }
+}
+
+static void flush_binary(void)
+{
+    size_t done = 0;
+    ssize_t n;
+
+    while (done < async.outlen) {
+        n = write(async.fd, async.out + done, async.outlen - done);
+        if (0 > n && EINTR == errno) {
+            continue;
+        }
+        if (0 >= n) {
+            break;
+        }
+        done += n;
+    }
+    async.outlen = 0;
+}
+
+static void deliver(const char *rec, uint32_t len)
+{
+    pmix_output_record_t hdr;
+
+    if (async.binary) {
+        if (async.outlen + len > 16 * PMIX_OUTPUT_ASYNC_MAX_RECORD) {
+            flush_binary();
+        }
+        memcpy(async.out + async.outlen, rec, len);
+        async.outlen += len;
+        return;
+    }
+    memcpy(&hdr, rec, sizeof(hdr));
+    format_record(rec);
+    async.emit(hdr.stream, async.text.buf);
+}
+
+static bool drain(pmix_output_ring_t *ring)
+{
+    char rec[PMIX_OUTPUT_ASYNC_MAX_RECORD];
+    uint64_t head, tail, off, dropped;
+    uint32_t len;
+    bool any = false;
+
+    head = ring->head;
+    /* the records up to the head are complete */
+    pmix_atomic_rmb();
+    tail = ring->tail;
+    while (tail != head) {
+        off = tail % ring->size;
+        memcpy(&len, ring->buf + off, sizeof(len));
+        if (PMIX_OUTPUT_ASYNC_WRAP == len) {
+            tail += ring->size - off;
+            continue;
+        }
+        deliver(ring->buf + off, len);
+        tail += len;
+        any = true;
+    }
+    /* done reading the space before handing it back */
+    pmix_atomic_wmb();
+    ring->tail = tail;
+
+    dropped = ring->dropped;
+    if (dropped != ring->reported) {
+        len = build(rec, ring->id, 0, "[pmix_output: %lu messages dropped by thread %u]",
+                    (unsigned long) (dropped - ring->reported), (unsigned int) ring->id);
+        if (0 < len) {
+            deliver(rec, len);
+        }
+        ring->reported = dropped;
+    }
+    return any;
+}
+
+static bool drain_all(void)
+{
+    pmix_output_ring_t *ring;
+    bool any = false;
+
+    for (ring = async.rings; NULL != ring; ring = ring->next) {
+        if (drain(ring)) {
+            any = true;
+        }
+    }
+    if (async.binary && 0 < async.outlen) {
+        flush_binary();
+    }
+    return any;
+}
+
+static void *writer(pmix_object_t *obj)
+{
+    struct timespec ts = {0, PMIX_OUTPUT_ASYNC_IDLE_NSEC};
+    PMIX_HIDE_UNUSED_PARAMS(obj);
+
+    while (!async.stop) {
+        if (!drain_all()) {
+            nanosleep(&ts, NULL);
+        }
+    }
+    return NULL;
+}
+
+/************************************************************************/
+
+static void child_after_fork(void)
+{
+    /* the writer thread was not forked */
+    async.active = false;
+    async.started = false;
+}
+
+static bool open_binary(const char *path)
+{
+    uint32_t word;
+    ssize_t n;
+    char head[16];
+
+    async.fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (0 > async.fd) {
+        return false;
+    }
+    memcpy(head, PMIX_OUTPUT_ASYNC_MAGIC, 8);
+    word = PMIX_OUTPUT_ASYNC_VERSION;
+    memcpy(head + 8, &word, sizeof(word));
+    word = 0x01020304;
+    memcpy(head + 12, &word, sizeof(word));
+    n = write(async.fd, head, sizeof(head));
+    if (n != (ssize_t) sizeof(head)) {
+        close(async.fd);
+        async.fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool pmix_output_async_init(pmix_output_async_emit_fn_t emit, const char *default_file)
+{
+    char *str;
+    const char *path;
+    unsigned long size;
+
+    if (async.started) {
+        return true;
+    }
+    str = getenv("PMIX_OUTPUT_ASYNC");
+    if (NULL == str || '\0' == *str || 0 == strcmp(str, "0")) {
+        return false;
+    }
+    async.binary = (0 == strcasecmp(str, "binary"));
+
+    str = getenv("PMIX_OUTPUT_ASYNC_RING");
+    if (NULL != str) {
+        size = strtoul(str, NULL, 10);
+        /* room for a few of the largest records */
+        if (size < 4 * PMIX_OUTPUT_ASYNC_MAX_RECORD) {
+            size = 4 * PMIX_OUTPUT_ASYNC_MAX_RECORD;
+        }
+        async.ring_size = (uint64_t) (size & ~7UL);
+    }
+
+    if (!async.key_created) {
+        if (PMIX_SUCCESS != pmix_tsd_key_create(&async.key, release_ring)) {
+            return false;
+        }
+        async.key_created = true;
+    }
+    if (!async.atfork) {
+        if (0 != pthread_atfork(NULL, NULL, child_after_fork)) {
+            return false;
+        }
+        async.atfork = true;
+    }
+
+    if (async.binary) {
+        path = getenv("PMIX_OUTPUT_ASYNC_FILE");
+        if (NULL == path) {
+            path = default_file;
+        }
+        if (NULL == path || !open_binary(path)) {
+            return false;
+        }
+        async.out = (char *) malloc(16 * PMIX_OUTPUT_ASYNC_MAX_RECORD);
+        if (NULL == async.out) {
+            close(async.fd);
+            async.fd = -1;
+            return false;
+        }
+        async.outlen = 0;
+    } else {
+        async.text.size = PMIX_OUTPUT_ASYNC_MAX_RECORD;
+        async.text.buf = (char *) malloc(async.text.size);
+        if (NULL == async.text.buf) {
+            return false;
+        }
+    }
+    async.emit = emit;
+
+    PMIX_CONSTRUCT(&async.writer, pmix_thread_t);
+    async.writer.t_run = writer;
+    async.writer.t_arg = NULL;
+    async.stop = false;
+    if (PMIX_SUCCESS != pmix_thread_start(&async.writer)) {
+        PMIX_DESTRUCT(&async.writer);
+        pmix_output_async_finalize();
+        return false;
+    }
+    async.started = true;
+    async.active = true;
+    return true;
+}
+
+void pmix_output_async_finalize(void)
+{
+    if (async.started) {
+        /* anything output from now on is written by the caller */
+        async.active = false;
+        async.stop = true;
+        pmix_thread_join(&async.writer, NULL);
+        PMIX_DESTRUCT(&async.writer);
+        async.started = false;
+        drain_all();
+    }
+    if (0 <= async.fd) {
+        close(async.fd);
+        async.fd = -1;
+    }
+    free(async.out);
+    async.out = NULL;
+    async.outlen = 0;
+    free(async.text.buf);
+    async.text.buf = NULL;
+    async.text.size = 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * Asynchronous back-end of pmix_output, enabled by setting the
+ * PMIX_OUTPUT_ASYNC environment variable:
+ *
+ * PMIX_OUTPUT_ASYNC=text    - messages are formatted and written to
+ *                             their streams by a writer thread
+ * PMIX_OUTPUT_ASYNC=binary  - the writer thread appends the raw records
+ *                             to a file, to be decoded offline with
+ *                             contrib/pmix_output_decode.py
+ * PMIX_OUTPUT_ASYNC_FILE    - the file for the binary mode (defaults
+ *                             to <tmpdir>/pmix-output-pid<pid>-async.bin)
+ * PMIX_OUTPUT_ASYNC_RING    - size in bytes of the per-thread ring
+ *                             (defaults to 256KB)
+ *
+ * A thread calling pmix_output does not format the message - it
+ * copies the format and its arguments into a ring of its own, which
+ * only the writer thread consumes, so the caller takes no lock and
+ * makes no system call. When a ring is full the message is dropped
+ * and counted, and the writer reports the count. Messages whose format
+ * cannot be captured (e.g., a "*" width) are output synchronously.
+ */
+
+#ifndef PMIX_OUTPUT_ASYNC_H
+#define PMIX_OUTPUT_ASYNC_H
+
+#include "src/include/pmix_config.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+
+BEGIN_C_DECLS
+
+/* write a formatted message to a stream - supplied by pmix_output,
+ * which may modify the message */
+typedef void (*pmix_output_async_emit_fn_t)(int output_id, char *msg);
+
+/**
+ * Start the writer thread if PMIX_OUTPUT_ASYNC asks for it. The
+ * default_file is used in binary mode if PMIX_OUTPUT_ASYNC_FILE
+ * is not set. Returns true if the asynchronous mode is active.
+ */
+PMIX_EXPORT bool pmix_output_async_init(pmix_output_async_emit_fn_t emit, const char *default_file);
+
+/**
+ * Queue a message for the writer thread. Returns false if the message
+ * was not taken and must be output by the caller.
+ */
+PMIX_EXPORT bool pmix_output_async_enqueue(int output_id, const char *format, va_list arglist);
+
+/**
+ * Wait until the messages queued so far have been written
+ */
+PMIX_EXPORT void pmix_output_async_flush(void);
+
+/**
+ * Write the messages still queued and stop the writer thread
+ */
+PMIX_EXPORT void pmix_output_async_finalize(void);
+
+END_C_DECLS
+
+#endif /* PMIX_OUTPUT_ASYNC_H */
@@ -34,6 +34,7 @@
 #include <fcntl.h>
 #endif
 #include <sys/mman.h>
+#include <hwloc.h>
 
 static void
 shmem_construct(
@@ -42,6 +43,7 @@ shmem_construct(
     s->size = 0;
     s->base_address = 0;
     memset(s->backing_path, 0, PMIX_PATH_MAX);
+    s->owner = false;
 }
 
 static void
@@ -79,6 +81,7 @@ pmix_shmem_segment_create(
         goto out;
     }
     shmem->size = size;
+    shmem->owner = true;
     pmix_string_copy(shmem->backing_path, backing_path, PMIX_PATH_MAX);
 out:
     if (-1 != fd) {
@@ -90,10 +93,55 @@ out:
     return rc;
 }
 
-pmix_status_t
-pmix_shmem_segment_attach(
+/**
+ * The segments are read by clients on every socket, so on request their
+ * pages are spread across the NUMA domains, backed by huge pages where
+ * the kernel can, and faulted in up front. The backing file is sparse
+ * until its pages are first touched - placement and huge pages are
+ * decided then - so the creator sets the policy and touches the pages
+ * before anyone else maps them. The others only need their own page
+ * tables populated.
+ */
+static void
+place_segment(
+    pmix_shmem_t *shmem
+) {
+    size_t pgsz, off;
+    volatile char *p;
+
+#ifdef MADV_HUGEPAGE
+    if (pmix_globals.shmem_hugepages) {
+        (void)madvise(shmem->base_address, shmem->size, MADV_HUGEPAGE);
+    }
+#endif
+    if (!shmem->owner) {
+        return;
+    }
+    if (pmix_globals.shmem_interleave && NULL != pmix_globals.topology.topology) {
+        hwloc_topology_t topo = (hwloc_topology_t)pmix_globals.topology.topology;
+        hwloc_const_nodeset_t nodes = hwloc_topology_get_topology_nodeset(topo);
+        if (NULL != nodes && 1 < hwloc_bitmap_weight(nodes)) {
+            // Not fatal - the pages then go where the kernel puts them.
+            (void)hwloc_set_area_membind(
+                topo, shmem->base_address, shmem->size, nodes,
+                HWLOC_MEMBIND_INTERLEAVE, HWLOC_MEMBIND_BYNODESET
+            );
+        }
+    }
+    if (pmix_globals.shmem_prefault) {
+        pgsz = (size_t)sysconf(_SC_PAGESIZE);
+        p = (volatile char *)shmem->base_address;
+        for (off = 0; off < shmem->size; off += pgsz) {
+            p[off] = p[off];
+        }
+    }
+}
+
+static pmix_status_t
+map_segment(
     pmix_shmem_t *shmem,
     void *requested_base_address,
+    int flags,
     uintptr_t *actual_base_address
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
@@ -103,15 +151,24 @@ pmix_shmem_segment_attach(
         rc = PMIX_ERR_FILE_OPEN_FAILURE;
         goto out;
     }
+#ifdef MAP_POPULATE
+    // The creator must set the memory policy before the pages exist.
+    if (pmix_globals.shmem_prefault && !shmem->owner) {
+        flags |= MAP_POPULATE;
+    }
+#endif
 
     shmem->base_address = mmap(
         requested_base_address, shmem->size,
-        PROT_READ | PROT_WRITE, MAP_SHARED,
+        PROT_READ | PROT_WRITE, flags,
         fd, 0
     );
     if (MAP_FAILED == shmem->base_address) {
         rc = PMIX_ERR_NOMEM;
     }
+    else {
+        place_segment(shmem);
+    }
     *actual_base_address = (uintptr_t)shmem->base_address;
 out:
     if (-1 != fd) {
@@ -123,6 +180,28 @@ out:
     return rc;
 }
 
+pmix_status_t
+pmix_shmem_segment_attach(
+    pmix_shmem_t *shmem,
+    void *requested_base_address,
+    uintptr_t *actual_base_address
+) {
+    return map_segment(
+        shmem, requested_base_address, MAP_SHARED, actual_base_address
+    );
+}
+
+pmix_status_t
+pmix_shmem_segment_attach_private(
+    pmix_shmem_t *shmem,
+    void *requested_base_address,
+    uintptr_t *actual_base_address
+) {
+    return map_segment(
+        shmem, requested_base_address, MAP_PRIVATE, actual_base_address
+    );
+}
+
 pmix_status_t
 pmix_shmem_segment_detach(
     pmix_shmem_t *shmem
@@ -24,6 +24,8 @@ typedef struct pmix_shmem_t {
     void *base_address;
     /** Buffer holding path to backing store. */
     char backing_path[PMIX_PATH_MAX];
+    /** Whether we created the backing store. */
+    bool owner;
 } pmix_shmem_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_shmem_t);
 
@@ -41,6 +43,18 @@ pmix_shmem_segment_attach(
     uintptr_t *actual_base_address
 );
 
+/**
+ * Like pmix_shmem_segment_attach(), but the mapping is copy-on-write: pages
+ * are shared with the other processes until this one writes to them, and
+ * writes are never seen by anybody else.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_shmem_segment_attach_private(
+    pmix_shmem_t *shmem,
+    void *requested_base_address,
+    uintptr_t *actual_base_address
+);
+
 PMIX_EXPORT pmix_status_t
 pmix_shmem_segment_detach(
     pmix_shmem_t *shmem
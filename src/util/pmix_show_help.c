@@ -535,6 +535,123 @@ static pmix_status_t find_topic(FILE *fp,
     return PMIX_ERR_NOT_FOUND;
 }
 
+/*
+ * A line of a topic asking for the lines of another topic to be
+ * included, given as "#include#file#topic"
+ */
+static pmix_status_t include_topic(char ***array, char *line)
+{
+    char *file, *tp;
+
+    /* keyword "include" found - check for file/topic */
+    file = &line[strlen("#include#")];
+    if (0 == strlen(file)) {
+        /* missing filename */
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* see if they provided a topic */
+    tp = strchr(file, '#');
+    if (NULL != tp) {
+        *tp = '\0';  // NULL-terminate the filename
+        ++tp;
+    }
+    return load_array(array, file, tp);
+}
+
+/* must match catalog_hash() in contrib/construct_help_catalog.py,
+ * hashing the file name and topic as "file#topic" */
+static uint32_t catalog_hash(const char *file, size_t flen, const char *topic, uint32_t seed)
+{
+    const unsigned char *str;
+    uint32_t hash = seed;
+    size_t n;
+
+    str = (const unsigned char*)file;
+    for (n = 0; n < flen; n++) {
+        hash += str[n];
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    hash += '#';
+    hash += (hash << 10);
+    hash ^= (hash >> 6);
+    for (str = (const unsigned char*)topic; '\0' != *str; str++) {
+        hash += *str;
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    return hash + (hash << 15);
+}
+
+/*
+ * Find the text of a topic in the catalog built into the library
+ */
+static const char *catalog_lookup(const char *base, const char *topic)
+{
+    const pmix_show_help_topic_t *t;
+    uint32_t seed, slot;
+    size_t len;
+
+    if (NULL == topic || 0 == pmix_show_help_catalog_size) {
+        return NULL;
+    }
+    if (NULL == base) {
+        base = default_filename;
+    }
+    /* the catalog names files without their suffix */
+    len = strlen(base);
+    if (4 <= len && 0 == strcmp(base + len - 4, ".txt")) {
+        len -= 4;
+    }
+
+    seed = pmix_show_help_catalog_seeds[catalog_hash(base, len, topic, 0)
+                                        % pmix_show_help_catalog_nbuckets];
+    slot = pmix_show_help_catalog_slots[catalog_hash(base, len, topic, seed)
+                                        & (pmix_show_help_catalog_hsize - 1)];
+    if (UINT32_MAX == slot) {
+        return NULL;
+    }
+    t = &pmix_show_help_catalog[slot];
+    if (0 != strncmp(t->file, base, len) || '\0' != t->file[len] || 0 != strcmp(t->topic, topic)) {
+        return NULL;
+    }
+    return t->text;
+}
+
+/*
+ * Make a list of the lines of a topic found in the catalog
+ */
+static pmix_status_t catalog_topic(const char *text, char ***array)
+{
+    const char *eol;
+    char *line;
+    pmix_status_t rc;
+
+    while ('\0' != *text) {
+        eol = strchr(text, '\n');
+        if (NULL == eol) {
+            eol = text + strlen(text);
+        }
+        line = strndup(text, eol - text);
+        if (NULL == line) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        if (0 == strncmp(line, "#include#", strlen("#include#"))) {
+            rc = include_topic(array, line);
+        } else {
+            rc = pmix_argv_append_nosize(array, line);
+        }
+        free(line);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        text = ('\0' == *eol) ? eol : eol + 1;
+    }
+    return PMIX_SUCCESS;
+}
+
 /*
  * We have an open file, and we're pointed at the right topic.  So
  * read in all the lines in the topic and make a list of them.
@@ -542,27 +659,14 @@ static pmix_status_t find_topic(FILE *fp,
 static pmix_status_t read_topic(FILE *fp, char ***array)
 {
     int rc;
-    char *line, *file, *tp;
+    char *line;
 
     while (NULL != (line = localgetline(fp))) {
         /* the topic ends when we see either the end of
          * the file (indicated by a NULL return) or the
          * beginning of the next topic */
         if (0 == strncmp(line, "#include#", strlen("#include#"))) {
-            /* keyword "include" found - check for file/topic */
-            file = &line[strlen("#include#")];
-            if (0 == strlen(file)) {
-                /* missing filename */
-                free(line);
-                return PMIX_ERR_BAD_PARAM;
-            }
-            /* see if they provided a topic */
-            tp = strchr(file, '#');
-            if (NULL != tp) {
-                *tp = '\0';  // NULL-terminate the filename
-                ++tp;
-            }
-            rc = load_array(array, file, tp);
+            rc = include_topic(array, line);
             if (PMIX_SUCCESS != rc) {
                 free(line);
                 return rc;
@@ -595,6 +699,17 @@ static pmix_status_t load_array(char ***array,
 {
     int ret;
     FILE *fp;
+    const char *text;
+
+    /* the topics we were built with need no file */
+    text = catalog_lookup(filename, topic);
+    if (NULL != text) {
+        ret = catalog_topic(text, array);
+        if (PMIX_SUCCESS != ret) {
+            pmix_argv_free(*array);
+        }
+        return ret;
+    }
 
     ret = open_file(filename, topic, &fp);
     if (PMIX_SUCCESS != ret) {
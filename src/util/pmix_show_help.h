@@ -187,6 +187,27 @@ PMIX_EXPORT pmix_status_t pmix_show_help_norender(const char *filename,
 
 PMIX_EXPORT extern bool pmix_show_help_enabled;
 
+/* The topics of the help files in the source tree are compiled into
+ * the library by contrib/construct_help_catalog.py, so looking them
+ * up does not touch the filesystem. The file is named without its
+ * ".txt" suffix, and the text holds the lines of the topic - each
+ * terminated by a newline - with comments removed and includes left
+ * to be resolved when the topic is loaded. Topics are found through
+ * a perfect hash of "file#topic" built the same way as that of the
+ * dictionary. Only files that cannot be found here are read */
+typedef struct {
+    const char *file;
+    const char *topic;
+    const char *text;
+} pmix_show_help_topic_t;
+
+PMIX_EXPORT extern const pmix_show_help_topic_t pmix_show_help_catalog[];
+PMIX_EXPORT extern const size_t pmix_show_help_catalog_size;
+PMIX_EXPORT extern const uint32_t pmix_show_help_catalog_nbuckets;
+PMIX_EXPORT extern const uint32_t pmix_show_help_catalog_hsize;
+PMIX_EXPORT extern const uint32_t pmix_show_help_catalog_seeds[];
+PMIX_EXPORT extern const uint32_t pmix_show_help_catalog_slots[];
+
 END_C_DECLS
 
 #endif
@@ -32,16 +32,111 @@
 #ifdef HAVE_SYS_RESOURCE_H
 #    include <sys/resource.h>
 #endif
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_name_fns.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_timings.h"
+
+typedef struct {
+    double start;
+    double elapsed;
+    int depth;
+    bool done;
+} pmix_timing_phase_data_t;
+
+static pmix_timing_phase_data_t phases[PMIX_TIMING_PHASE_MAX];
+
+static const char *phase_names[PMIX_TIMING_PHASE_MAX] = {
+    "init", "frameworks", "open", "connect", "jobinfo", "topology", "register", "fence",
+    "get"
+};
+
+static double phase_ts(void)
+{
+#if defined(__linux__) && PMIX_HAVE_CLOCK_GETTIME
+    struct timespec tp;
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (double) tp.tv_sec + (double) tp.tv_nsec / 1.0e9;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1.0e6;
+#endif
+}
+
+void pmix_timing_phase_start(pmix_timing_phase_t phase)
+{
+    pmix_timing_phase_data_t *p = &phases[phase];
+
+    if (PMIX_TIMING_PHASE_OPEN != phase && p->done) {
+        return;
+    }
+    /* fence and get calls made by our own init are not
+     * what the caller wants to see */
+    if (PMIX_TIMING_PHASE_FENCE <= phase && 0 < phases[PMIX_TIMING_PHASE_INIT].depth) {
+        return;
+    }
+    /* nested phases are timed from the outermost start */
+    if (0 == p->depth++) {
+        p->start = phase_ts();
+    }
+}
+
+void pmix_timing_phase_stop(pmix_timing_phase_t phase)
+{
+    pmix_timing_phase_data_t *p = &phases[phase];
+
+    if (0 == p->depth || 0 < --p->depth) {
+        return;
+    }
+    p->elapsed += phase_ts() - p->start;
+    p->done = true;
+}
+
+const char *pmix_timing_phase_name(pmix_timing_phase_t phase)
+{
+    return phase_names[phase];
+}
+
+bool pmix_timing_phase_elapsed(pmix_timing_phase_t phase, double *elapsed)
+{
+    if (!phases[phase].done) {
+        return false;
+    }
+    *elapsed = phases[phase].elapsed;
+    return true;
+}
+
+void pmix_timing_phase_report(void)
+{
+    char *line = NULL, *tmp;
+    double elapsed;
+    int n;
+
+    for (n = 0; n < PMIX_TIMING_PHASE_MAX; n++) {
+        if (!pmix_timing_phase_elapsed(n, &elapsed)) {
+            continue;
+        }
+        if (0 > asprintf(&tmp, "%s %s %.6f", (NULL == line) ? "" : line, phase_names[n],
+                         elapsed)) {
+            break;
+        }
+        free(line);
+        line = tmp;
+    }
+    if (NULL != line) {
+        pmix_output(0, "%s startup timing (sec):%s", PMIX_NAME_PRINT(&pmix_globals.myid), line);
+        free(line);
+    }
+}
 
 #if PMIX_ENABLE_TIMING
 
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
-#include "src/include/pmix_globals.h"
 #include "src/util/pmix_basename.h"
-#include "src/util/pmix_output.h"
-
-#include "src/util/pmix_timings.h"
 
 #define DELTAS_SANE_LIMIT (10 * 1024 * 1024)
 
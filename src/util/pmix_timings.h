@@ -18,6 +18,43 @@
 
 #include "src/class/pmix_list.h"
 
+/* Startup phase timers. These are always built as they cost a
+ * single clock read at each end of a phase - the times can be
+ * obtained with the PMIX_QUERY_STARTUP_TIMING query and are output
+ * at finalize if the pmix_timing_startup param is set. Each phase
+ * other than "open" only times its first occurrence */
+typedef enum {
+    PMIX_TIMING_PHASE_INIT,          // PMIx_Init, PMIx_server_init or PMIx_tool_init
+    PMIX_TIMING_PHASE_FRAMEWORKS,    // opening and selecting the runtime frameworks
+    PMIX_TIMING_PHASE_OPEN,          // total time spent opening frameworks
+    PMIX_TIMING_PHASE_CONNECT,       // connecting to the server
+    PMIX_TIMING_PHASE_JOBINFO,       // obtaining and storing our job info
+    PMIX_TIMING_PHASE_TOPOLOGY,      // obtaining our topology and, for a server, sharing it
+    PMIX_TIMING_PHASE_REGISTER,      // server processing of the first registered nspace
+    PMIX_TIMING_PHASE_FENCE,         // first PMIx_Fence after init
+    PMIX_TIMING_PHASE_GET,           // first PMIx_Get after init that needed the progress thread
+    PMIX_TIMING_PHASE_MAX
+} pmix_timing_phase_t;
+
+PMIX_EXPORT void pmix_timing_phase_start(pmix_timing_phase_t phase);
+PMIX_EXPORT void pmix_timing_phase_stop(pmix_timing_phase_t phase);
+
+/**
+ * Return the name of a phase
+ */
+PMIX_EXPORT const char *pmix_timing_phase_name(pmix_timing_phase_t phase);
+
+/**
+ * Return true and the time spent in the phase in seconds
+ * if the phase has been timed
+ */
+PMIX_EXPORT bool pmix_timing_phase_elapsed(pmix_timing_phase_t phase, double *elapsed);
+
+/**
+ * Output the times of all phases that have been timed
+ */
+PMIX_EXPORT void pmix_timing_phase_report(void);
+
 #if PMIX_ENABLE_TIMING
 
 #    define PMIX_TIMING_DESCR_MAX   1024
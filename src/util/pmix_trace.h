@@ -0,0 +1,55 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file
+ *
+ * Static tracepoints on the hot paths of the library. When PMIx is
+ * configured with --enable-pmix-usdt, each expands to a USDT probe
+ * in the "pmix" provider that tools such as bpftrace, perf, or
+ * SystemTap can attach to - an unattached probe costs a single nop.
+ * Otherwise they compile to nothing.
+ *
+ * Probes (arguments in order):
+ *
+ *    msg_send        peer nspace, peer rank, tag, bytes - message written to a peer
+ *    msg_recv        peer nspace, peer rank, tag, bytes - message taken for processing
+ *    gds_store       nspace, rank, key - data stored in the hash component
+ *    gds_fetch       nspace, rank, key - data requested from the hash component
+ *    fence_create    tracker, number of procs, number of local procs
+ *    fence_complete  tracker, status, bytes of collected data
+ *    dmdx_request    nspace, rank - direct modex request passed to the host
+ *    dmdx_reply      nspace, rank, status, bytes - host reply to a direct modex
+ *    event_notify    status, source nspace, source rank - server notifying clients
+ *    event_dispatch  status - event being passed to the local handlers
+ */
+
+#ifndef PMIX_TRACE_H
+#define PMIX_TRACE_H
+
+#include "src/include/pmix_config.h"
+
+#if PMIX_ENABLE_USDT
+
+#    include <sys/sdt.h>
+
+#    define PMIX_TRACE1(n, a)          DTRACE_PROBE1(pmix, n, a)
+#    define PMIX_TRACE2(n, a, b)       DTRACE_PROBE2(pmix, n, a, b)
+#    define PMIX_TRACE3(n, a, b, c)    DTRACE_PROBE3(pmix, n, a, b, c)
+#    define PMIX_TRACE4(n, a, b, c, d) DTRACE_PROBE4(pmix, n, a, b, c, d)
+
+#else
+
+#    define PMIX_TRACE1(n, a)
+#    define PMIX_TRACE2(n, a, b)
+#    define PMIX_TRACE3(n, a, b, c)
+#    define PMIX_TRACE4(n, a, b, c, d)
+
+#endif
+
+#endif /* PMIX_TRACE_H */
@@ -681,9 +681,10 @@ static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const
     PMIX_HIDE_UNUSED_PARAMS(procs, nprocs, info, ninfo);
 
     pmix_output(0, "SERVER: FENCENB");
-    /* pass the provided data back to each participating proc */
+    /* pass the provided data back to each participating proc - it
+     * is ours, so let the server release it when done */
     if (NULL != cbfunc) {
-        cbfunc(PMIX_SUCCESS, data, ndata, cbdata, NULL, NULL);
+        cbfunc(PMIX_SUCCESS, data, ndata, cbdata, free, data);
     }
     return PMIX_SUCCESS;
 }
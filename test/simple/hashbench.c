@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Microbenchmark for the uint32/uint64 paths of pmix_hash_table_t -
+ * the ones used for the per-rank tables of the gds. Stores N keys,
+ * then times lookups that hit (in rank order and in random order),
+ * lookups that miss, a traversal, and the removal of every key, and
+ * prints the time per operation in nanoseconds as one JSON object:
+ *
+ *    hashbench -n 100000 -i 10 -k 64
+ *
+ * where -n is the number of keys, -i the number of timed passes
+ * (the best is reported) and -k the key width (32 or 64).
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/class/pmix_hash_table.h"
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1.0e9 + (double) ts.tv_nsec;
+}
+
+static int set_value(pmix_hash_table_t *ht, int width, uint64_t key, void *value)
+{
+    if (32 == width) {
+        return pmix_hash_table_set_value_uint32(ht, (uint32_t) key, value);
+    }
+    return pmix_hash_table_set_value_uint64(ht, key, value);
+}
+
+static int get_value(pmix_hash_table_t *ht, int width, uint64_t key, void **value)
+{
+    if (32 == width) {
+        return pmix_hash_table_get_value_uint32(ht, (uint32_t) key, value);
+    }
+    return pmix_hash_table_get_value_uint64(ht, key, value);
+}
+
+static int remove_value(pmix_hash_table_t *ht, int width, uint64_t key)
+{
+    if (32 == width) {
+        return pmix_hash_table_remove_value_uint32(ht, (uint32_t) key);
+    }
+    return pmix_hash_table_remove_value_uint64(ht, key);
+}
+
+static size_t traverse(pmix_hash_table_t *ht, int width)
+{
+    uint32_t k32;
+    uint64_t k64;
+    void *value, *node;
+    size_t n = 0;
+    int rc;
+
+    if (32 == width) {
+        rc = pmix_hash_table_get_first_key_uint32(ht, &k32, &value, &node);
+        while (PMIX_SUCCESS == rc) {
+            ++n;
+            rc = pmix_hash_table_get_next_key_uint32(ht, &k32, &value, node, &node);
+        }
+    } else {
+        rc = pmix_hash_table_get_first_key_uint64(ht, &k64, &value, &node);
+        while (PMIX_SUCCESS == rc) {
+            ++n;
+            rc = pmix_hash_table_get_next_key_uint64(ht, &k64, &value, node, &node);
+        }
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_hash_table_t ht;
+    uint64_t *keys, *order, tmp;
+    size_t nkeys = 100000, n, j;
+    int iters = 10, width = 32, i, opt, errors = 0;
+    double t0, best[6];
+    const char *names[6] = {"insert", "get_seq", "get_random", "get_miss", "traverse", "remove"};
+    void *value;
+
+    while (-1 != (opt = getopt(argc, argv, "n:i:k:h"))) {
+        switch (opt) {
+        case 'n':
+            nkeys = strtoul(optarg, NULL, 10);
+            break;
+        case 'i':
+            iters = atoi(optarg);
+            break;
+        case 'k':
+            width = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n nkeys] [-i iterations] [-k 32|64]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (0 == nkeys || 0 >= iters || (32 != width && 64 != width)) {
+        fprintf(stderr, "%s: bad arguments\n", argv[0]);
+        exit(1);
+    }
+
+    keys = (uint64_t *) malloc(nkeys * sizeof(uint64_t));
+    order = (uint64_t *) malloc(nkeys * sizeof(uint64_t));
+    if (NULL == keys || NULL == order) {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        exit(1);
+    }
+    /* the keys are ranks - for 64-bit keys put a job id above them */
+    for (n = 0; n < nkeys; n++) {
+        keys[n] = (32 == width) ? n : ((uint64_t) 0x1234 << 32) | n;
+        order[n] = keys[n];
+    }
+    srand(12345);
+    for (n = nkeys - 1; 0 < n; n--) {
+        j = (size_t) rand() % (n + 1);
+        tmp = order[n];
+        order[n] = order[j];
+        order[j] = tmp;
+    }
+    for (i = 0; i < 6; i++) {
+        best[i] = -1.0;
+    }
+
+#define HASHBENCH_TIME(idx, stmt)                      \
+    do {                                               \
+        double _dt;                                    \
+        t0 = now();                                    \
+        stmt;                                          \
+        _dt = (now() - t0) / (double) nkeys;           \
+        if (best[idx] < 0.0 || _dt < best[idx]) {      \
+            best[idx] = _dt;                           \
+        }                                              \
+    } while (0)
+
+    for (i = 0; i < iters; i++) {
+        PMIX_CONSTRUCT(&ht, pmix_hash_table_t);
+        pmix_hash_table_init(&ht, 256);
+
+        HASHBENCH_TIME(0, for (n = 0; n < nkeys; n++) {
+            set_value(&ht, width, keys[n], &keys[n]);
+        });
+        HASHBENCH_TIME(1, for (n = 0; n < nkeys; n++) {
+            if (PMIX_SUCCESS != get_value(&ht, width, keys[n], &value) || value != &keys[n]) {
+                ++errors;
+            }
+        });
+        HASHBENCH_TIME(2, for (n = 0; n < nkeys; n++) {
+            if (PMIX_SUCCESS != get_value(&ht, width, order[n], &value)) {
+                ++errors;
+            }
+        });
+        HASHBENCH_TIME(3, for (n = 0; n < nkeys; n++) {
+            if (PMIX_SUCCESS == get_value(&ht, width, keys[n] + nkeys, &value)) {
+                ++errors;
+            }
+        });
+        HASHBENCH_TIME(4, if (nkeys != traverse(&ht, width)) { ++errors; });
+        HASHBENCH_TIME(5, for (n = 0; n < nkeys; n++) {
+            if (PMIX_SUCCESS != remove_value(&ht, width, order[n])) {
+                ++errors;
+            }
+        });
+        if (0 != pmix_hash_table_get_size(&ht)) {
+            ++errors;
+        }
+        PMIX_DESTRUCT(&ht);
+    }
+
+    printf("{\"benchmark\": \"hash_table_uint%d\", \"keys\": %lu, \"iterations\": %d, "
+           "\"errors\": %d, \"ns_per_op\": {", width, (unsigned long) nkeys, iters, errors);
+    for (i = 0; i < 6; i++) {
+        printf("%s\"%s\": %.2f", (0 == i) ? "" : ", ", names[i], best[i]);
+    }
+    printf("}}\n");
+
+    free(keys);
+    free(order);
+    return (0 == errors) ? 0 : 1;
+}
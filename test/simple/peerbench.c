@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Microbenchmark for the server's walks over its local clients.
+ * Creates N peer objects, scattered through the heap as they would
+ * be after clients come and go, and times the kind of pass the server
+ * makes when it fans a message out - select the peers of one nspace
+ * that have not finalized - and a pass over the send state of every
+ * peer. Prints the time per peer in nanoseconds, along with the size
+ * of the peer object and how much of it the hot fields span, as one
+ * JSON object:
+ *
+ *    peerbench -n 10000 -i 10 -j 4
+ *
+ * where -n is the number of peers, -i the number of timed passes
+ * (the best is reported) and -j the number of nspaces the peers are
+ * spread over. Run it under "perf stat -e cache-misses" to compare
+ * the misses taken by different layouts of pmix_peer_t.
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/class/pmix_pointer_array.h"
+#include "src/include/pmix_globals.h"
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1.0e9 + (double) ts.tv_nsec;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_pointer_array_t clients;
+    pmix_peer_t *peer;
+    void **filler;
+    char **nspaces;
+    size_t npeers = 10000, n, hits, idle, expected;
+    int iters = 10, njobs = 4, i, opt, errors = 0;
+    double t0, dt, best[2] = {-1.0, -1.0};
+
+    while (-1 != (opt = getopt(argc, argv, "n:i:j:h"))) {
+        switch (opt) {
+        case 'n':
+            npeers = strtoul(optarg, NULL, 10);
+            break;
+        case 'i':
+            iters = atoi(optarg);
+            break;
+        case 'j':
+            njobs = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n npeers] [-i iterations] [-j njobs]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (0 == npeers || 0 >= iters || 0 >= njobs) {
+        fprintf(stderr, "%s: bad arguments\n", argv[0]);
+        exit(1);
+    }
+
+    nspaces = (char **) malloc(njobs * sizeof(char *));
+    filler = (void **) malloc(npeers * sizeof(void *));
+    if (NULL == nspaces || NULL == filler) {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        exit(1);
+    }
+    for (i = 0; i < njobs; i++) {
+        if (0 > asprintf(&nspaces[i], "peerbench-job-%d", i)) {
+            fprintf(stderr, "%s: out of memory\n", argv[0]);
+            exit(1);
+        }
+    }
+
+    PMIX_CONSTRUCT(&clients, pmix_pointer_array_t);
+    pmix_pointer_array_init(&clients, 128, INT_MAX, 128);
+    srand(12345);
+    expected = 0;
+    for (n = 0; n < npeers; n++) {
+        peer = PMIX_NEW(pmix_peer_t);
+        peer->info = PMIX_NEW(pmix_rank_info_t);
+        peer->info->pname.nspace = strdup(nspaces[n % njobs]);
+        peer->info->pname.rank = n / njobs;
+        /* a few have already finalized */
+        peer->finalized = (0 == n % 17);
+        if (0 == n % njobs && !peer->finalized) {
+            ++expected;
+        }
+        peer->index = pmix_pointer_array_add(&clients, peer);
+        /* keep the peers apart as a long-running server would */
+        filler[n] = malloc(64 + rand() % 4096);
+    }
+
+    for (i = 0; i < iters; i++) {
+        /* select the live members of one nspace */
+        t0 = now();
+        hits = 0;
+        for (n = 0; n < (size_t) clients.size; n++) {
+            peer = (pmix_peer_t *) pmix_pointer_array_get_item(&clients, n);
+            if (NULL == peer || peer->finalized) {
+                continue;
+            }
+            if (0 == strcmp(peer->info->pname.nspace, nspaces[0])) {
+                ++hits;
+            }
+        }
+        dt = (now() - t0) / (double) npeers;
+        if (best[0] < 0.0 || dt < best[0]) {
+            best[0] = dt;
+        }
+        if (hits != expected) {
+            ++errors;
+        }
+
+        /* look at the send state of every peer */
+        t0 = now();
+        idle = 0;
+        for (n = 0; n < (size_t) clients.size; n++) {
+            peer = (pmix_peer_t *) pmix_pointer_array_get_item(&clients, n);
+            if (NULL == peer) {
+                continue;
+            }
+            if (NULL == peer->send_msg && !peer->send_ev_active && 0 > peer->sd
+                && pmix_list_is_empty(&peer->send_queue)) {
+                ++idle;
+            }
+        }
+        dt = (now() - t0) / (double) npeers;
+        if (best[1] < 0.0 || dt < best[1]) {
+            best[1] = dt;
+        }
+        if (idle != npeers) {
+            ++errors;
+        }
+    }
+
+    printf("{\"benchmark\": \"peer_walk\", \"peers\": %lu, \"nspaces\": %d, \"iterations\": %d, "
+           "\"errors\": %d, \"peer_size\": %lu, \"hot_bytes\": %lu, "
+           "\"ns_per_peer\": {\"select_nspace\": %.2f, \"send_state\": %.2f}}\n",
+           (unsigned long) npeers, njobs, iters, errors, (unsigned long) sizeof(pmix_peer_t),
+           (unsigned long) offsetof(pmix_peer_t, protocol), best[0], best[1]);
+
+    for (n = 0; n < (size_t) clients.size; n++) {
+        peer = (pmix_peer_t *) pmix_pointer_array_get_item(&clients, n);
+        if (NULL != peer) {
+            PMIX_RELEASE(peer);
+        }
+    }
+    PMIX_DESTRUCT(&clients);
+    for (n = 0; n < npeers; n++) {
+        free(filler[n]);
+    }
+    free(filler);
+    for (i = 0; i < njobs; i++) {
+        free(nspaces[i]);
+    }
+    free(nspaces);
+    return (0 == errors) ? 0 : 1;
+}
@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Benchmark client for the PMIx client API and the local server.
+ * Every rank runs the selected benchmarks in lockstep and rank 0
+ * prints one JSON object per benchmark, aggregated across all ranks,
+ * so the output can be compared between builds. Run it under
+ * simptest to exercise a single server:
+ *
+ *    simptest -n 8 -e ./simpbench -i 1000 -s 1024 -o results.json
+ *
+ * or under any PMIx launcher to control the number of ranks on
+ * each node.
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+#include "include/pmix_tool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_argv.h"
+
+#include "simptest.h"
+
+/* event code used by the notify benchmark */
+#define SIMPBENCH_EVENT (PMIX_EXTERNAL_ERR_BASE - 100)
+
+typedef struct {
+    double min;
+    double max;
+    double sum;
+    size_t n;
+} bench_stats_t;
+
+typedef struct {
+    const char *name;
+    pmix_status_t (*fn)(bench_stats_t *st);
+    bench_stats_t stats;
+    bool selected;
+    bool done;
+} bench_t;
+
+static pmix_proc_t myproc;
+static pmix_proc_t *peers = NULL;
+static uint32_t nprocs = 1;
+static pmix_rank_t peer;
+static int iters = 100;
+static int warmup = 2;
+static size_t size = 64;
+static char *payload = NULL;
+static double init_usec = 0.0;
+static volatile int nevents = 0;
+
+static double usec(void)
+{
+#if PMIX_HAVE_CLOCK_GETTIME
+    struct timespec tp;
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (double) tp.tv_sec * 1.0e6 + (double) tp.tv_nsec / 1.0e3;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec * 1.0e6 + (double) tv.tv_usec;
+#endif
+}
+
+static void record(bench_stats_t *st, double t)
+{
+    if (0 == st->n || t < st->min) {
+        st->min = t;
+    }
+    if (0 == st->n || t > st->max) {
+        st->max = t;
+    }
+    st->sum += t;
+    ++st->n;
+}
+
+static pmix_status_t fence(bool collect)
+{
+    pmix_info_t info;
+    pmix_status_t rc;
+
+    if (!collect) {
+        return PMIx_Fence(NULL, 0, NULL, 0);
+    }
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, NULL, PMIX_BOOL);
+    rc = PMIx_Fence(NULL, 0, &info, 1);
+    PMIX_INFO_DESTRUCT(&info);
+    return rc;
+}
+
+static pmix_status_t put_payload(const char *key)
+{
+    pmix_value_t val;
+
+    val.type = PMIX_BYTE_OBJECT;
+    val.data.bo.bytes = payload;
+    val.data.bo.size = size;
+    return PMIx_Put(PMIX_GLOBAL, key, &val);
+}
+
+static pmix_status_t get_peer(const char *key, pmix_info_t *info, size_t ninfo)
+{
+    pmix_proc_t proc;
+    pmix_value_t *val = NULL;
+    pmix_status_t rc;
+
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, peer);
+    rc = PMIx_Get(&proc, key, info, ninfo, &val);
+    if (NULL != val) {
+        PMIX_VALUE_RELEASE(val);
+    }
+    return rc;
+}
+
+static pmix_status_t bench_put_commit(bench_stats_t *st)
+{
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        if (PMIX_SUCCESS != (rc = put_payload("simpbench.put"))) {
+            return rc;
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t fence_loop(bench_stats_t *st, bool collect)
+{
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        if (PMIX_SUCCESS != (rc = fence(collect))) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t bench_fence(bench_stats_t *st)
+{
+    return fence_loop(st, false);
+}
+
+static pmix_status_t bench_fence_collect(bench_stats_t *st)
+{
+    return fence_loop(st, true);
+}
+
+static pmix_status_t bench_get_hit(bench_stats_t *st)
+{
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    if (PMIX_SUCCESS != (rc = put_payload("simpbench.hit"))
+        || PMIX_SUCCESS != (rc = PMIx_Commit())
+        || PMIX_SUCCESS != (rc = fence(true))) {
+        return rc;
+    }
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        if (PMIX_SUCCESS != (rc = get_peer("simpbench.hit", NULL, 0))) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t bench_get_miss(bench_stats_t *st)
+{
+    pmix_info_t info;
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    /* optional keys are only looked for locally */
+    PMIX_INFO_LOAD(&info, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        rc = get_peer("simpbench.miss", &info, 1);
+        if (PMIX_ERR_NOT_FOUND != rc) {
+            PMIX_INFO_DESTRUCT(&info);
+            return (PMIX_SUCCESS == rc) ? PMIX_ERROR : rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    PMIX_INFO_DESTRUCT(&info);
+    return PMIX_SUCCESS;
+}
+
+/* a new key after a fence that did not collect data must be
+ * obtained from the server - via the host when the peer is on
+ * another node */
+static pmix_status_t bench_dmodex(bench_stats_t *st)
+{
+    char key[PMIX_MAX_KEYLEN + 1];
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    for (i = -warmup; i < iters; i++) {
+        snprintf(key, sizeof(key), "simpbench.dmdx.%d", i + warmup);
+        if (PMIX_SUCCESS != (rc = put_payload(key))
+            || PMIX_SUCCESS != (rc = PMIx_Commit())
+            || PMIX_SUCCESS != (rc = fence(false))) {
+            return rc;
+        }
+        t = usec();
+        if (PMIX_SUCCESS != (rc = get_peer(key, NULL, 0))) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static void notify_fn(size_t evhdlr_registration_id, pmix_status_t status,
+                      const pmix_proc_t *source, pmix_info_t info[], size_t ninfo,
+                      pmix_info_t results[], size_t nresults,
+                      pmix_event_notification_cbfunc_fn_t cbfunc, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(evhdlr_registration_id, status, source, info, ninfo, results,
+                            nresults);
+    ++nevents;
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void notify_reg(pmix_status_t status, size_t refid, void *cbdata)
+{
+    mylock_t *lock = (mylock_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(refid);
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+/* time from rank 0 notifying the namespace until every other
+ * rank has seen the event and joined a fence - compare with the
+ * fence benchmark for the cost of the notification itself */
+static pmix_status_t bench_notify(bench_stats_t *st)
+{
+    pmix_status_t code = SIMPBENCH_EVENT, rc;
+    pmix_info_t info;
+    mylock_t lock;
+    struct timespec ts = {0, 1000};
+    double t;
+    int i;
+
+    if (nprocs < 2) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    DEBUG_CONSTRUCT_LOCK(&lock);
+    PMIx_Register_event_handler(&code, 1, NULL, 0, notify_fn, notify_reg, &lock);
+    DEBUG_WAIT_THREAD(&lock);
+    rc = lock.status;
+    DEBUG_DESTRUCT_LOCK(&lock);
+    if (PMIX_SUCCESS != rc || PMIX_SUCCESS != (rc = fence(false))) {
+        return rc;
+    }
+
+    PMIX_INFO_LOAD(&info, PMIX_EVENT_DO_NOT_CACHE, NULL, PMIX_BOOL);
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        if (0 == myproc.rank) {
+            rc = PMIx_Notify_event(code, &myproc, PMIX_RANGE_NAMESPACE, &info, 1, NULL, NULL);
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+        } else {
+            while (nevents <= i + warmup) {
+                nanosleep(&ts, NULL);
+            }
+        }
+        if (PMIX_SUCCESS != (rc = fence(false))) {
+            break;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    PMIX_INFO_DESTRUCT(&info);
+    return rc;
+}
+
+static pmix_status_t bench_group(bench_stats_t *st)
+{
+    pmix_info_t *results;
+    size_t nresults;
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        results = NULL;
+        nresults = 0;
+        rc = PMIx_Group_construct("simpbench", peers, nprocs, NULL, 0, &results, &nresults);
+        if (NULL != results) {
+            PMIX_INFO_FREE(results, nresults);
+        }
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Group_destruct("simpbench", NULL, 0))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* stdin forwarded through the server to rank 0 */
+static pmix_status_t bench_iof(bench_stats_t *st)
+{
+    pmix_byte_object_t bo;
+    pmix_proc_t target;
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    PMIX_LOAD_PROCID(&target, myproc.nspace, 0);
+    bo.bytes = payload;
+    bo.size = size;
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        if (PMIX_SUCCESS != (rc = PMIx_IOF_push(&target, 1, &bo, NULL, 0, NULL, NULL))) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* every rank connecting to all the others at once */
+static pmix_status_t bench_connect(bench_stats_t *st)
+{
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    double t;
+    int i;
+
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    for (i = -warmup; i < iters; i++) {
+        t = usec();
+        if (PMIX_SUCCESS != (rc = PMIx_Connect(&proc, 1, NULL, 0))) {
+            return rc;
+        }
+        if (0 <= i) {
+            record(st, usec() - t);
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Disconnect(&proc, 1, NULL, 0))) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* all ranks start at once, so this is the cost of a connection
+ * storm on the server */
+static pmix_status_t bench_init(bench_stats_t *st)
+{
+    record(st, init_usec);
+    return PMIX_SUCCESS;
+}
+
+static bench_t benchmarks[] = {
+    {.name = "init", .fn = bench_init},
+    {.name = "put_commit", .fn = bench_put_commit},
+    {.name = "fence", .fn = bench_fence},
+    {.name = "fence_collect", .fn = bench_fence_collect},
+    {.name = "get_hit", .fn = bench_get_hit},
+    {.name = "get_miss", .fn = bench_get_miss},
+    {.name = "dmodex", .fn = bench_dmodex},
+    {.name = "notify", .fn = bench_notify},
+    {.name = "group", .fn = bench_group},
+    {.name = "iof", .fn = bench_iof},
+    {.name = "connect", .fn = bench_connect},
+    {.name = NULL}
+};
+
+static void usage(void)
+{
+    bench_t *b;
+
+    fprintf(stderr, "usage: simpbench <options>\n");
+    fprintf(stderr, "    -i N          Timed iterations of each benchmark (default: 100)\n");
+    fprintf(stderr, "    -w N          Untimed warmup iterations (default: 2)\n");
+    fprintf(stderr, "    -s N          Bytes of data put, fetched and pushed (default: 64)\n");
+    fprintf(stderr, "    -b a,b,...    Benchmarks to run (default: all)\n");
+    fprintf(stderr, "    -o file       Write the results to file instead of stdout\n");
+    fprintf(stderr, "benchmarks:");
+    for (b = benchmarks; NULL != b->name; b++) {
+        fprintf(stderr, " %s", b->name);
+    }
+    fprintf(stderr, "\n");
+}
+
+/* share our results so rank 0 can report across all ranks */
+static pmix_status_t gather(FILE *out)
+{
+    char key[PMIX_MAX_KEYLEN + 1];
+    bench_stats_t total, *st;
+    pmix_value_t val, *rval;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    bench_t *b;
+    uint32_t r;
+
+    for (b = benchmarks; NULL != b->name; b++) {
+        if (!b->done) {
+            continue;
+        }
+        snprintf(key, sizeof(key), "simpbench.res.%s", b->name);
+        val.type = PMIX_BYTE_OBJECT;
+        val.data.bo.bytes = (char *) &b->stats;
+        val.data.bo.size = sizeof(bench_stats_t);
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &val))) {
+            return rc;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Commit()) || PMIX_SUCCESS != (rc = fence(true))) {
+        return rc;
+    }
+    if (0 != myproc.rank) {
+        return PMIX_SUCCESS;
+    }
+
+    for (b = benchmarks; NULL != b->name; b++) {
+        if (!b->done) {
+            continue;
+        }
+        snprintf(key, sizeof(key), "simpbench.res.%s", b->name);
+        memset(&total, 0, sizeof(total));
+        for (r = 0; r < nprocs; r++) {
+            PMIX_LOAD_PROCID(&proc, myproc.nspace, r);
+            rval = NULL;
+            rc = PMIx_Get(&proc, key, NULL, 0, &rval);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+            st = (bench_stats_t *) rval->data.bo.bytes;
+            if (0 < st->n) {
+                if (0 == total.n || st->min < total.min) {
+                    total.min = st->min;
+                }
+                if (0 == total.n || st->max > total.max) {
+                    total.max = st->max;
+                }
+                total.sum += st->sum;
+                total.n += st->n;
+            }
+            PMIX_VALUE_RELEASE(rval);
+        }
+        fprintf(out,
+                "{\"benchmark\":\"%s\",\"ranks\":%u,\"iterations\":%d,\"bytes\":%lu,"
+                "\"samples\":%lu,\"min_usec\":%.3f,\"avg_usec\":%.3f,\"max_usec\":%.3f}\n",
+                b->name, nprocs, iters, (unsigned long) size, (unsigned long) total.n, total.min,
+                (0 == total.n) ? 0.0 : total.sum / (double) total.n, total.max);
+    }
+    return PMIX_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    pmix_value_t *val = NULL;
+    pmix_proc_t proc;
+    char **names = NULL, *outfile = NULL;
+    FILE *out = stdout;
+    bench_t *b;
+    double t;
+    uint32_t r;
+    int n, m;
+
+    for (n = 1; n < argc; n++) {
+        if (0 == strcmp("-i", argv[n]) && NULL != argv[n + 1]) {
+            iters = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-w", argv[n]) && NULL != argv[n + 1]) {
+            warmup = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-s", argv[n]) && NULL != argv[n + 1]) {
+            size = strtoul(argv[++n], NULL, 10);
+        } else if (0 == strcmp("-b", argv[n]) && NULL != argv[n + 1]) {
+            names = pmix_argv_split(argv[++n], ',');
+        } else if (0 == strcmp("-o", argv[n]) && NULL != argv[n + 1]) {
+            outfile = argv[++n];
+        } else {
+            usage();
+            exit(1);
+        }
+    }
+    if (iters < 1 || warmup < 0 || 0 == size) {
+        usage();
+        exit(1);
+    }
+    for (b = benchmarks; NULL != b->name; b++) {
+        b->selected = (NULL == names);
+        for (m = 0; NULL != names && NULL != names[m]; m++) {
+            if (0 == strcmp(names[m], b->name)) {
+                b->selected = true;
+            }
+        }
+    }
+    for (m = 0; NULL != names && NULL != names[m]; m++) {
+        for (b = benchmarks; NULL != b->name; b++) {
+            if (0 == strcmp(names[m], b->name)) {
+                break;
+            }
+        }
+        if (NULL == b->name) {
+            fprintf(stderr, "simpbench: unknown benchmark %s\n", names[m]);
+            usage();
+            exit(1);
+        }
+    }
+    pmix_argv_free(names);
+
+    t = usec();
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "simpbench: PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(rc);
+    }
+    init_usec = usec() - t;
+
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val))) {
+        fprintf(stderr, "simpbench %u: PMIx_Get job size failed: %s\n", myproc.rank,
+                PMIx_Error_string(rc));
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+    peer = (myproc.rank + 1) % nprocs;
+    PMIX_PROC_CREATE(peers, nprocs);
+    for (r = 0; r < nprocs; r++) {
+        PMIX_LOAD_PROCID(&peers[r], myproc.nspace, r);
+    }
+    payload = (char *) malloc(size);
+    memset(payload, 'x', size);
+
+    if (0 == myproc.rank && NULL != outfile) {
+        if (NULL == (out = fopen(outfile, "w"))) {
+            fprintf(stderr, "simpbench: cannot open %s\n", outfile);
+            rc = PMIX_ERR_FILE_OPEN_FAILURE;
+            goto done;
+        }
+    }
+
+    for (b = benchmarks; NULL != b->name; b++) {
+        if (!b->selected) {
+            continue;
+        }
+        /* start each benchmark together */
+        if (PMIX_SUCCESS != (rc = fence(false))) {
+            goto done;
+        }
+        rc = b->fn(&b->stats);
+        if (PMIX_ERR_NOT_SUPPORTED == rc) {
+            continue;
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "simpbench %u: %s failed: %s\n", myproc.rank, b->name,
+                    PMIx_Error_string(rc));
+            goto done;
+        }
+        b->done = true;
+    }
+
+    rc = gather(out);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "simpbench %u: collecting results failed: %s\n", myproc.rank,
+                PMIx_Error_string(rc));
+    }
+
+done:
+    if (stdout != out) {
+        fclose(out);
+    }
+    if (NULL != peers) {
+        PMIX_PROC_FREE(peers, nprocs);
+    }
+    if (NULL != payload) {
+        free(payload);
+    }
+    PMIx_Finalize(NULL, 0);
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
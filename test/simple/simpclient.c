@@ -117,6 +117,8 @@ int main(int argc, char **argv)
     bool all_local, local;
     pmix_rank_t *locals = NULL;
     pmix_topology_t topo;
+    pmix_locality_t loc1, loc2;
+    pmix_value_t *lval1, *lval2;
 
     if (1 < argc) {
         if (0 == strcmp("-abort", argv[1])) {
@@ -235,6 +237,31 @@ int main(int argc, char **argv)
     }
     pmix_argv_free(peers);
 
+    /* our relative locality to each peer must match
+     * that given by comparing our locality strings */
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, myproc.rank);
+    if (PMIX_SUCCESS == PMIx_Get(&myproc, PMIX_LOCALITY_STRING, NULL, 0, &lval1)) {
+        for (n = 0; n < nprocs; n++) {
+            proc.rank = n;
+            loc1 = loc2 = PMIX_LOCALITY_UNKNOWN;
+            if (PMIX_SUCCESS != PMIx_Get(&proc, PMIX_LOCALITY_STRING, NULL, 0, &lval2)) {
+                continue;
+            }
+            rc = PMIx_Get_relative_locality(lval1->data.string, lval2->data.string, &loc1);
+            if (PMIX_SUCCESS == rc) {
+                rc = PMIx_Get_proc_relative_locality(&myproc, &proc, &loc2);
+            }
+            if (PMIX_SUCCESS != rc || loc1 != loc2) {
+                pmix_output(0, "Client ns %s rank %d: relative locality to rank %u %04x but %04x: %s",
+                            myproc.nspace, myproc.rank, n, loc1, loc2, PMIx_Error_string(rc));
+                exit(1);
+            }
+            PMIX_VALUE_RELEASE(lval2);
+        }
+        PMIX_VALUE_RELEASE(lval1);
+    }
+    PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+
     for (cnt = 0; cnt < MAXCNT; cnt++) {
         pmix_output(0, "Client %s:%d executing loop %d", myproc.nspace, myproc.rank, cnt);
         (void) asprintf(&tmp, "%s-%d-local-%d", myproc.nspace, myproc.rank, cnt);
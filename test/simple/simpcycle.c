@@ -31,6 +31,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -42,9 +43,59 @@
 
 #define MAXCNT 1
 
+/* event code registered and deregistered by the soak loop */
+#define SIMPCYCLE_EVENT (PMIX_EXTERNAL_ERR_BASE - 101)
+
 static volatile bool completed = false;
 static pmix_proc_t myproc;
 
+/* operations timed by the soak loop - each iteration is one
+ * init/finalize cycle of this client with the others in its
+ * nspace, so a server that leaks or fragments shows up as
+ * latency drifting upward from the first iterations to the
+ * last */
+enum {
+    SOAK_INIT,
+    SOAK_REGEVENT,
+    SOAK_DEREGEVENT,
+    SOAK_GROUP_CONSTRUCT,
+    SOAK_GROUP_DESTRUCT,
+    SOAK_CONNECT,
+    SOAK_DISCONNECT,
+    SOAK_FINALIZE,
+    SOAK_NOPS
+};
+
+static const char *soak_names[SOAK_NOPS] = {"init", "regevent", "deregevent",
+                                            "group_construct", "group_destruct",
+                                            "connect", "disconnect", "finalize"};
+
+static double usec(void)
+{
+    struct timespec tp;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (double) tp.tv_sec * 1.0e6 + (double) tp.tv_nsec / 1.0e3;
+}
+
+static int dblcmp(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static double mean(const double *t, int n)
+{
+    double sum = 0.0;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        sum += t[i];
+    }
+    return (0 == n) ? 0.0 : sum / (double) n;
+}
+
 static void notification_fn(size_t evhdlr_registration_id, pmix_status_t status,
                             const pmix_proc_t *source, pmix_info_t info[], size_t ninfo,
                             pmix_info_t results[], size_t nresults,
@@ -93,6 +144,157 @@ static void model_callback(size_t evhdlr_registration_id, pmix_status_t status,
     }
 }
 
+/* print the percentiles of each operation, along with the ratio of
+ * the mean of the last quarter of the iterations to the first */
+static void soak_report(double *t[], int iters)
+{
+    double *sorted, first, last;
+    int op, q = (iters < 4) ? 1 : iters / 4;
+
+    sorted = (double *) malloc(iters * sizeof(double));
+    if (NULL == sorted) {
+        return;
+    }
+    printf("{\"soak\":\"client\",\"proc\":\"%s:%u\",\"iterations\":%d,\"usec\":{",
+           myproc.nspace, myproc.rank, iters);
+    for (op = 0; op < SOAK_NOPS; op++) {
+        memcpy(sorted, t[op], iters * sizeof(double));
+        qsort(sorted, iters, sizeof(double), dblcmp);
+        first = mean(t[op], q);
+        last = mean(t[op] + iters - q, q);
+        printf("%s\"%s\":{\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f,"
+               "\"drift\":%.3f}",
+               (0 == op) ? "" : ",", soak_names[op], sorted[(iters - 1) / 2],
+               sorted[(iters - 1) * 90 / 100], sorted[(iters - 1) * 99 / 100],
+               sorted[iters - 1], (0.0 == first) ? 0.0 : last / first);
+    }
+    printf("}}\n");
+    fflush(stdout);
+    free(sorted);
+}
+
+static int soak_loop(int iters)
+{
+    double *t[SOAK_NOPS], start;
+    pmix_status_t rc = PMIX_SUCCESS, code = SIMPCYCLE_EVENT;
+    pmix_value_t *val;
+    pmix_proc_t proc, *procs = NULL;
+    pmix_info_t *results;
+    size_t nresults;
+    uint32_t nprocs = 0, r;
+    char grp[PMIX_MAX_NSLEN + 1];
+    int i, op;
+
+    for (op = 0; op < SOAK_NOPS; op++) {
+        t[op] = (double *) calloc(iters, sizeof(double));
+        if (NULL == t[op]) {
+            fprintf(stderr, "simpcycle: out of memory\n");
+            exit(1);
+        }
+    }
+
+    for (i = 0; i < iters; i++) {
+        start = usec();
+        if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+            fprintf(stderr, "Client soak %d: PMIx_Init failed: %s\n", i, PMIx_Error_string(rc));
+            break;
+        }
+        t[SOAK_INIT][i] = usec() - start;
+
+        if (NULL == procs) {
+            PMIX_LOAD_PROCID(&proc, myproc.nspace, PMIX_RANK_WILDCARD);
+            if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val))) {
+                fprintf(stderr, "Client %s:%u: PMIx_Get job size failed: %s\n", myproc.nspace,
+                        myproc.rank, PMIx_Error_string(rc));
+                PMIx_Finalize(NULL, 0);
+                break;
+            }
+            nprocs = val->data.uint32;
+            PMIX_VALUE_RELEASE(val);
+            PMIX_PROC_CREATE(procs, nprocs);
+            for (r = 0; r < nprocs; r++) {
+                PMIX_LOAD_PROCID(&procs[r], myproc.nspace, r);
+            }
+        }
+
+        /* a blocking registration returns the handler's reference */
+        start = usec();
+        rc = PMIx_Register_event_handler(&code, 1, NULL, 0, notification_fn, NULL, NULL);
+        t[SOAK_REGEVENT][i] = usec() - start;
+        if (0 > rc) {
+            fprintf(stderr, "Client %s:%u: register event failed: %s\n", myproc.nspace,
+                    myproc.rank, PMIx_Error_string(rc));
+            PMIx_Finalize(NULL, 0);
+            break;
+        }
+        start = usec();
+        rc = PMIx_Deregister_event_handler((size_t) rc, NULL, NULL);
+        t[SOAK_DEREGEVENT][i] = usec() - start;
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client %s:%u: deregister event failed: %s\n", myproc.nspace,
+                    myproc.rank, PMIx_Error_string(rc));
+            PMIx_Finalize(NULL, 0);
+            break;
+        }
+
+        /* a new group each time so its tracking is not reused */
+        snprintf(grp, sizeof(grp), "simpcycle-%d", i);
+        results = NULL;
+        nresults = 0;
+        start = usec();
+        rc = PMIx_Group_construct(grp, procs, nprocs, NULL, 0, &results, &nresults);
+        t[SOAK_GROUP_CONSTRUCT][i] = usec() - start;
+        if (NULL != results) {
+            PMIX_INFO_FREE(results, nresults);
+        }
+        if (PMIX_SUCCESS == rc) {
+            start = usec();
+            rc = PMIx_Group_destruct(grp, NULL, 0);
+            t[SOAK_GROUP_DESTRUCT][i] = usec() - start;
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client %s:%u: group %s failed: %s\n", myproc.nspace, myproc.rank,
+                    grp, PMIx_Error_string(rc));
+            PMIx_Finalize(NULL, 0);
+            break;
+        }
+
+        start = usec();
+        rc = PMIx_Connect(&proc, 1, NULL, 0);
+        t[SOAK_CONNECT][i] = usec() - start;
+        if (PMIX_SUCCESS == rc) {
+            start = usec();
+            rc = PMIx_Disconnect(&proc, 1, NULL, 0);
+            t[SOAK_DISCONNECT][i] = usec() - start;
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Client %s:%u: connect failed: %s\n", myproc.nspace, myproc.rank,
+                    PMIx_Error_string(rc));
+            PMIx_Finalize(NULL, 0);
+            break;
+        }
+
+        start = usec();
+        if (PMIX_SUCCESS != (rc = PMIx_Finalize(NULL, 0))) {
+            fprintf(stderr, "Client soak %d: PMIx_Finalize failed: %s\n", i,
+                    PMIx_Error_string(rc));
+            break;
+        }
+        t[SOAK_FINALIZE][i] = usec() - start;
+    }
+
+    if (PMIX_SUCCESS == rc) {
+        soak_report(t, iters);
+    }
+    if (NULL != procs) {
+        PMIX_PROC_FREE(procs, nprocs);
+    }
+    for (op = 0; op < SOAK_NOPS; op++) {
+        free(t[op]);
+    }
+    return rc;
+}
+
 int main(int argc, char **argv)
 {
     int rc, nprocs;
@@ -103,7 +305,20 @@ int main(int argc, char **argv)
     pmix_info_t *iptr;
     size_t ninfo;
     pmix_status_t code;
-    PMIX_HIDE_UNUSED_PARAMS(argc, argv);
+    int n, iters;
+
+    /* run the soak loop instead if asked */
+    for (n = 1; n < argc; n++) {
+        if ((0 == strcmp("-soak", argv[n]) || 0 == strcmp("--soak", argv[n]))
+            && NULL != argv[n + 1]) {
+            iters = strtol(argv[n + 1], NULL, 10);
+            if (0 >= iters) {
+                fprintf(stderr, "simpcycle: bad number of soak iterations\n");
+                exit(1);
+            }
+            return (PMIX_SUCCESS == soak_loop(iters)) ? 0 : 1;
+        }
+    }
 
     /* init us and declare we are a test programming model */
     PMIX_INFO_CREATE(iptr, 2);
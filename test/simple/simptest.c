@@ -103,6 +103,9 @@ static pmix_status_t grp_fn(pmix_group_operation_t op, char *gpid,
                             const pmix_proc_t procs[], size_t nprocs,
                             const pmix_info_t directives[], size_t ndirs,
                             pmix_info_cbfunc_t cbfunc, void *cbdata);
+static pmix_status_t stdin_fn(const pmix_proc_t *source, const pmix_proc_t targets[],
+                              size_t ntargets, const pmix_info_t directives[], size_t ndirs,
+                              const pmix_byte_object_t *bo, pmix_op_cbfunc_t cbfunc, void *cbdata);
 
 static pmix_server_module_t mymodule = {
     .client_connected = connected,
@@ -125,6 +128,7 @@ static pmix_server_module_t mymodule = {
     .allocate = alloc_fn,
     .job_control = jctrl_fn,
     .monitor = mon_fn,
+    .push_stdin = stdin_fn,
     .group = grp_fn
 };
 
@@ -615,7 +619,9 @@ static void set_namespace(int nprocs, char *nspace, pmix_op_cbfunc_t cbfunc, myx
     pmix_info_t *isv1, *isv2;
     myxfer_t cd, lock;
     pmix_status_t rc;
-    char tmp[50], **agg = NULL;
+    char tmp[50], **agg = NULL, *locstr;
+    pmix_cpuset_t cpuset;
+    long ncpus;
 
     /* everything on one node */
     PMIx_generate_regex(pmix_globals.hostname, &regex);
@@ -707,10 +713,23 @@ static void set_namespace(int nprocs, char *nspace, pmix_op_cbfunc_t cbfunc, myx
     }
 
     /* add the proc-specific data */
+    ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (0 >= ncpus) {
+        ncpus = 1;
+    }
     for (m = 0; m < nprocs; m++) {
+        /* pretend each proc is bound to its own cpu */
+        locstr = NULL;
+        snprintf(tmp, 50, "hwloc:%ld", (long) m % ncpus);
+        if (PMIX_SUCCESS == PMIx_Parse_cpuset_string(tmp, &cpuset)) {
+            if (PMIX_SUCCESS != PMIx_server_generate_locality_string(&cpuset, &locstr)) {
+                locstr = NULL;
+            }
+            PMIx_Cpuset_destruct(&cpuset);
+        }
         pmix_strncpy(x->info[n].key, PMIX_PROC_DATA, PMIX_MAX_KEYLEN);
         x->info[n].value.type = PMIX_DATA_ARRAY;
-        PMIX_DATA_ARRAY_CREATE(array, 6, PMIX_INFO);
+        PMIX_DATA_ARRAY_CREATE(array, (NULL == locstr) ? 6 : 7, PMIX_INFO);
         x->info[n].value.data.darray = array;
         info = (pmix_info_t *) array->array;
         k = 0;
@@ -741,6 +760,13 @@ static void set_namespace(int nprocs, char *nspace, pmix_op_cbfunc_t cbfunc, myx
         info[k].value.type = PMIX_STRING;
         info[k].value.data.string = strdup(pmix_globals.hostname);
         ++k;
+
+        if (NULL != locstr) {
+            pmix_strncpy(info[k].key, PMIX_LOCALITY_STRING, PMIX_MAX_KEYLEN);
+            info[k].value.type = PMIX_STRING;
+            info[k].value.data.string = locstr;
+            ++k;
+        }
         /* move to next proc */
         ++n;
     }
@@ -824,9 +850,11 @@ static void fencbfn(int sd, short args, void *cbdata)
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t *) cbdata;
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
-    /* pass the provided data back to each participating proc */
+    /* pass the provided data back to each participating proc - it
+     * was malloc'd and is ours, so let the server release it */
     if (NULL != scd->cbfunc.modexcbfunc) {
-        scd->cbfunc.modexcbfunc(scd->status, scd->data, scd->ndata, scd->cbdata, NULL, NULL);
+        scd->cbfunc.modexcbfunc(scd->status, scd->data, scd->ndata, scd->cbdata, free,
+                                (void *) scd->data);
     }
     PMIX_RELEASE(scd);
 }
@@ -1287,25 +1315,60 @@ static pmix_status_t grp_fn(pmix_group_operation_t op, char *gpid,
 {
     mylog_t *lg = (mylog_t *) malloc(sizeof(mylog_t));
     pmix_info_t *info;
-    size_t n;
-    size_t ctxid = 1;
+    size_t n, m = 1;
+    static size_t ctxid = 1;
+    size_t block = 0;
     PMIX_HIDE_UNUSED_PARAMS(op, gpid, procs, nprocs);
 
     memset(lg, 0, sizeof(mylog_t));
     if (PMIX_GROUP_CONSTRUCT == op) {
-        PMIX_INFO_CREATE(info, 2);
+        PMIX_INFO_CREATE(info, 4);
         PMIX_INFO_LOAD(&info[0], PMIX_GROUP_CONTEXT_ID, &ctxid, PMIX_SIZE);
+        ++ctxid;
         for (n=0; n < ndirs; n++) {
             if (PMIX_CHECK_KEY(&directives[n], PMIX_GROUP_ENDPT_DATA)) {
-                PMIX_INFO_XFER(&info[1], &directives[n]);
-                break;
+                PMIX_INFO_XFER(&info[m], &directives[n]);
+                ++m;
+            } else if (PMIX_CHECK_KEY(&directives[n], PMIX_GROUP_CONTEXT_ID_BLOCK)) {
+                block = directives[n].value.data.size;
             }
         }
+        if (0 < block) {
+            /* reserve the requested block for the server */
+            PMIX_INFO_LOAD(&info[m], PMIX_GROUP_CONTEXT_ID_BASE, &ctxid, PMIX_SIZE);
+            ++m;
+            PMIX_INFO_LOAD(&info[m], PMIX_GROUP_CONTEXT_ID_BLOCK, &block, PMIX_SIZE);
+            ++m;
+            ctxid += block;
+        }
         lg->info = info;
-        lg->ninfo = 2;
+        lg->ninfo = m;
     }
     lg->infocbfunc = cbfunc;
     lg->cbdata = cbdata;
     SIMPTEST_THREADSHIFT(lg, grpbar);
     return PMIX_SUCCESS;
 }
+
+static void stdinbar(int sd, short args, void *cbdata)
+{
+    mylog_t *lg = (mylog_t *) cbdata;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+    lg->cbfunc(PMIX_SUCCESS, lg->cbdata);
+    free(lg);
+}
+
+static pmix_status_t stdin_fn(const pmix_proc_t *source, const pmix_proc_t targets[],
+                              size_t ntargets, const pmix_info_t directives[], size_t ndirs,
+                              const pmix_byte_object_t *bo, pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    mylog_t *lg = (mylog_t *) malloc(sizeof(mylog_t));
+    PMIX_HIDE_UNUSED_PARAMS(source, targets, ntargets, directives, ndirs, bo);
+
+    /* we have no children reading stdin, so just accept the data */
+    memset(lg, 0, sizeof(mylog_t));
+    lg->cbfunc = cbfunc;
+    lg->cbdata = cbdata;
+    SIMPTEST_THREADSHIFT(lg, stdinbar);
+    return PMIX_SUCCESS;
+}
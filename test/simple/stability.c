@@ -33,6 +33,7 @@
 
 #include <errno.h>
 #include <signal.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
@@ -45,6 +46,8 @@
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_printf.h"
+#include "src/mca/pstat/pstat.h"
+#include "src/server/pmix_server_ops.h"
 
 #include "simptest.h"
 
@@ -89,6 +92,9 @@ static void tool_connect_fn(pmix_info_t *info, size_t ninfo, pmix_tool_connectio
 static void log_fn(const pmix_proc_t *client, const pmix_info_t data[], size_t ndata,
                    const pmix_info_t directives[], size_t ndirs, pmix_op_cbfunc_t cbfunc,
                    void *cbdata);
+static pmix_status_t grp_fn(pmix_group_operation_t op, char *gpid, const pmix_proc_t procs[],
+                            size_t nprocs, const pmix_info_t directives[], size_t ndirs,
+                            pmix_info_cbfunc_t cbfunc, void *cbdata);
 
 static pmix_server_module_t mymodule = {.client_connected = connected,
                                         .client_finalized = finalized,
@@ -106,7 +112,8 @@ static pmix_server_module_t mymodule = {.client_connected = connected,
                                         .notify_event = notify_event,
                                         .query = query_fn,
                                         .tool_connected = tool_connect_fn,
-                                        .log = log_fn};
+                                        .log = log_fn,
+                                        .group = grp_fn};
 
 typedef struct {
     pmix_list_item_t super;
@@ -159,6 +166,25 @@ static pmix_list_t children;
 static bool istimeouttest = false;
 static bool nettest = false;
 static bool arrays = false;
+static bool soak = false;
+
+/* taken by the soak test at the end of each cycle, once the
+ * cycle's nspace has been deregistered - the server should be
+ * back where it was after the previous cycle */
+typedef struct {
+    float rss;   // MBytes
+    float vsize; // MBytes
+    size_t nspaces;
+    size_t clients;
+    size_t collectives;
+    size_t events;
+    size_t groups;
+    size_t dmdx;
+    size_t iof;
+    double reg_usec;
+    double run_usec;
+    double dereg_usec;
+} soak_sample_t;
 
 static void set_namespace(int nprocs, char *ranks, char *nspace, pmix_op_cbfunc_t cbfunc,
                           myxfer_t *x);
@@ -206,10 +232,137 @@ static void setup_cbfunc(pmix_status_t status, pmix_info_t info[], size_t ninfo,
     DEBUG_WAKEUP_THREAD(&x->lock);
 }
 
+static double usec(void)
+{
+    struct timespec tp;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (double) tp.tv_sec * 1.0e6 + (double) tp.tv_nsec / 1.0e3;
+}
+
+/* the clients are gone and the server is idle between cycles,
+ * so its tracking lists can be read from here */
+static void soak_sample(soak_sample_t *s)
+{
+    pmix_proc_stats_t stats;
+    pmix_peer_t *peer;
+    int n;
+
+    PMIX_PROC_STATS_CONSTRUCT(&stats);
+    if (NULL != pmix_pstat.query && PMIX_SUCCESS == pmix_pstat.query(getpid(), &stats, NULL)) {
+        s->rss = stats.rss;
+        s->vsize = stats.vsize;
+    }
+    PMIX_PROC_STATS_DESTRUCT(&stats);
+
+    s->nspaces = pmix_list_get_size(&pmix_globals.nspaces);
+    s->clients = 0;
+    for (n = 0; n < pmix_server_globals.clients.size; n++) {
+        peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_server_globals.clients, n);
+        if (NULL != peer) {
+            ++s->clients;
+        }
+    }
+    s->collectives = pmix_list_get_size(&pmix_server_globals.collectives);
+    s->events = pmix_list_get_size(&pmix_server_globals.events);
+    s->groups = pmix_list_get_size(&pmix_server_globals.groups);
+    s->dmdx = pmix_list_get_size(&pmix_server_globals.local_reqs)
+              + pmix_list_get_size(&pmix_server_globals.remote_pnd);
+    s->iof = pmix_list_get_size(&pmix_server_globals.iof);
+}
+
+static void soak_print(const char *label, int cycle, soak_sample_t *s)
+{
+    printf("{\"soak\":\"%s\",\"cycle\":%d,\"rss_mb\":%.2f,\"vsize_mb\":%.2f,"
+           "\"nspaces\":%lu,\"clients\":%lu,\"collectives\":%lu,\"events\":%lu,"
+           "\"groups\":%lu,\"dmdx\":%lu,\"iof\":%lu,"
+           "\"usec\":{\"register\":%.1f,\"run\":%.1f,\"deregister\":%.1f}}\n",
+           label, cycle, s->rss, s->vsize, (unsigned long) s->nspaces,
+           (unsigned long) s->clients, (unsigned long) s->collectives,
+           (unsigned long) s->events, (unsigned long) s->groups, (unsigned long) s->dmdx,
+           (unsigned long) s->iof, s->reg_usec, s->run_usec, s->dereg_usec);
+    fflush(stdout);
+}
+
+static int dblcmp(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static void soak_latency(const char *name, soak_sample_t *s, int n, size_t offset, bool comma)
+{
+    double *t, first = 0.0, last = 0.0;
+    int m, q = (n < 4) ? 1 : n / 4;
+
+    t = (double *) malloc(n * sizeof(double));
+    if (NULL == t) {
+        return;
+    }
+    for (m = 0; m < n; m++) {
+        t[m] = *(double *) ((char *) &s[m] + offset);
+        if (m < q) {
+            first += t[m];
+        }
+        if (n - q <= m) {
+            last += t[m];
+        }
+    }
+    qsort(t, n, sizeof(double), dblcmp);
+    printf("%s\"%s\":{\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"max\":%.1f,\"drift\":%.3f}",
+           comma ? "," : "", name, t[(n - 1) / 2], t[(n - 1) * 90 / 100], t[(n - 1) * 99 / 100],
+           t[n - 1], (0.0 == first) ? 0.0 : last / first);
+    free(t);
+}
+
+/* the first cycle warms up the server's caches and pools, so the
+ * growth is measured from there: a least-squares fit of the RSS
+ * over the remaining cycles, and the objects still being tracked
+ * at the end that were not there after the first cycle */
+static void soak_report(soak_sample_t *s, int n)
+{
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, slope = 0.0, k;
+    float peak = 0.0;
+    int m;
+
+    for (m = 1; m < n; m++) {
+        sx += m;
+        sy += s[m].rss;
+        sxx += (double) m * m;
+        sxy += m * s[m].rss;
+    }
+    k = (double) (n - 1);
+    if (2 < n && 0.0 != k * sxx - sx * sx) {
+        slope = (k * sxy - sx * sy) / (k * sxx - sx * sx);
+    }
+    for (m = 0; m < n; m++) {
+        if (peak < s[m].rss) {
+            peak = s[m].rss;
+        }
+    }
+    printf("{\"soak\":\"summary\",\"cycles\":%d,\"rss_first_mb\":%.2f,\"rss_last_mb\":%.2f,"
+           "\"rss_peak_mb\":%.2f,\"rss_kb_per_cycle\":%.2f,"
+           "\"leaked\":{\"nspaces\":%ld,\"clients\":%ld,\"collectives\":%ld,\"events\":%ld,"
+           "\"groups\":%ld,\"dmdx\":%ld,\"iof\":%ld},\"usec\":{",
+           n, s[0].rss, s[n - 1].rss, peak, slope * 1024.0,
+           (long) s[n - 1].nspaces - (long) s[0].nspaces,
+           (long) s[n - 1].clients - (long) s[0].clients,
+           (long) s[n - 1].collectives - (long) s[0].collectives,
+           (long) s[n - 1].events - (long) s[0].events,
+           (long) s[n - 1].groups - (long) s[0].groups, (long) s[n - 1].dmdx - (long) s[0].dmdx,
+           (long) s[n - 1].iof - (long) s[0].iof);
+    soak_latency("register", s, n, offsetof(soak_sample_t, reg_usec), false);
+    soak_latency("run", s, n, offsetof(soak_sample_t, run_usec), true);
+    soak_latency("deregister", s, n, offsetof(soak_sample_t, dereg_usec), true);
+    printf("}}\n");
+    fflush(stdout);
+}
+
 int main(int argc, char **argv)
 {
     char **client_env = NULL;
-    char **client_argv = NULL;
+    char **client_argv = NULL, **client_args = NULL;
     char *tmp, **atmp, *executable = NULL, *nspace;
     int rc, nprocs = 1, n, k;
     uid_t myuid;
@@ -223,6 +376,8 @@ int main(int argc, char **argv)
     mylock_t mylock;
     int ncycles = 1, m, delay = 0;
     sigset_t unblock;
+    soak_sample_t *samples = NULL;
+    double t0;
 
     /* smoke test */
     if (PMIX_SUCCESS != 0) {
@@ -245,7 +400,7 @@ int main(int argc, char **argv)
                 istimeouttest = true;
             }
             for (k = n + 2; NULL != argv[k]; k++) {
-                pmix_argv_append_nosize(&client_argv, argv[k]);
+                pmix_argv_append_nosize(&client_args, argv[k]);
             }
             n += k;
         } else if ((0 == strcmp("-reps", argv[n]) || 0 == strcmp("--reps", argv[n]))
@@ -254,13 +409,19 @@ int main(int argc, char **argv)
         } else if ((0 == strcmp("-sleep", argv[n]) || 0 == strcmp("--sleep", argv[n]))
                    && NULL != argv[n + 1]) {
             delay = strtol(argv[n + 1], NULL, 10);
+        } else if (0 == strcmp("-soak", argv[n]) || 0 == strcmp("--soak", argv[n])) {
+            soak = true;
         } else if (0 == strcmp("-h", argv[n])) {
             /* print the options and exit */
             fprintf(stderr, "usage: simptest <options>\n");
             fprintf(stderr, "    -n N     Number of clients to run\n");
             fprintf(stderr,
                     "    -e foo   Name of the client executable to run (default: simpclient\n");
-            fprintf(stderr, "    -reps N  Cycle for N repetitions");
+            fprintf(stderr, "    -reps N  Cycle for N repetitions\n");
+            fprintf(stderr, "    -sleep N Seconds to wait between cycles\n");
+            fprintf(stderr, "    -soak    Report the server's memory, tracked objects and\n"
+                            "             latencies after each cycle as JSON on stdout, e.g.\n"
+                            "             stability -n 4 -reps 1000 -soak -e ./simpcycle -soak 10\n");
             fprintf(stderr, "    -net-test  Test network endpt assignments\n");
             fprintf(stderr, "    -arrays  Use the job session array to pass registration info\n");
             exit(0);
@@ -345,8 +506,17 @@ int main(int argc, char **argv)
                       wait_signal_callback, &handler);
     pmix_event_add(&handler, NULL);
 
+    if (soak) {
+        samples = (soak_sample_t *) calloc(ncycles, sizeof(soak_sample_t));
+        if (NULL == samples) {
+            fprintf(stderr, "Out of memory for %d soak samples\n", ncycles);
+            exit(1);
+        }
+    }
+
     for (m = 0; m < ncycles; m++) {
         fprintf(stderr, "Running cycle %d\n", m);
+        t0 = usec();
         /* we have a single namespace for all clients */
         atmp = NULL;
         for (n = 0; n < nprocs; n++) {
@@ -363,6 +533,7 @@ int main(int argc, char **argv)
 
         /* set common argv and env */
         client_env = pmix_argv_copy(environ);
+        client_argv = pmix_argv_copy(client_args);
         pmix_argv_prepend_nosize(&client_argv, executable);
 
         wakeup = nprocs;
@@ -375,6 +546,10 @@ int main(int argc, char **argv)
         free(tmp);
         free(nspace);
         PMIX_RELEASE(x);
+        if (soak) {
+            samples[m].reg_usec = usec() - t0;
+            t0 = usec();
+        }
 
         /* fork/exec the test */
         for (n = 0; n < nprocs; n++) {
@@ -434,6 +609,10 @@ int main(int argc, char **argv)
             }
             ++n;
         }
+        if (soak) {
+            samples[m].run_usec = usec() - t0;
+            t0 = usec();
+        }
 
         /* deregister the clients */
         for (n = 0; n < nprocs; n++) {
@@ -452,8 +631,17 @@ int main(int argc, char **argv)
         PMIX_LIST_DESTRUCT(&children);
         PMIX_CONSTRUCT(&children, pmix_list_t);
 
+        if (soak) {
+            samples[m].dereg_usec = usec() - t0;
+            soak_sample(&samples[m]);
+            soak_print("cycle", m, &samples[m]);
+        }
+
         sleep(delay);
     }
+    if (soak && 0 < ncycles) {
+        soak_report(samples, ncycles);
+    }
 
 done:
     /* deregister the event handlers */
@@ -463,6 +651,10 @@ done:
     PMIX_LIST_DESTRUCT(&pubdata);
 
     free(executable);
+    pmix_argv_free(client_args);
+    if (NULL != samples) {
+        free(samples);
+    }
 
     /* finalize the server library */
     if (PMIX_SUCCESS != (rc = PMIx_server_finalize())) {
@@ -1050,3 +1242,14 @@ static void wait_signal_callback(int fd, short event, void *arg)
         }
     }
 }
+
+static pmix_status_t grp_fn(pmix_group_operation_t op, char *gpid, const pmix_proc_t procs[],
+                            size_t nprocs, const pmix_info_t directives[], size_t ndirs,
+                            pmix_info_cbfunc_t cbfunc, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(op, gpid, procs, nprocs, directives, ndirs, cbfunc, cbdata);
+
+    /* there is only one server, so all the participants are
+     * already here - nothing to add */
+    return PMIX_OPERATION_SUCCEEDED;
+}
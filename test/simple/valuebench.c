@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Microbenchmark for PMIx_Value_compare and PMIx_Value_xfer - the
+ * operations behind qualifier matching and event filtering. For a
+ * set of value types, times the comparison of two equal values and
+ * the copy (including the destruct of the copy), and prints the time
+ * per call in nanoseconds as one JSON object:
+ *
+ *    valuebench -n 1000000 -i 5
+ *
+ * where -n is the number of calls per pass and -i the number of
+ * timed passes (the best is reported).
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define VALUEBENCH_NTYPES 8
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1.0e9 + (double) ts.tv_nsec;
+}
+
+static void load(pmix_value_t *v, int idx)
+{
+    bool flag = true;
+    uint32_t u32 = 12345;
+    size_t sz = 1234567;
+    pmix_status_t status = PMIX_ERR_TIMEOUT;
+    pmix_proc_t proc;
+    pmix_byte_object_t bo;
+    pmix_data_array_t darray;
+    uint32_t vals[4] = {1, 2, 3, 4};
+
+    switch (idx) {
+    case 0:
+        PMIX_VALUE_LOAD(v, &flag, PMIX_BOOL);
+        break;
+    case 1:
+        PMIX_VALUE_LOAD(v, &u32, PMIX_UINT32);
+        break;
+    case 2:
+        PMIX_VALUE_LOAD(v, &sz, PMIX_SIZE);
+        break;
+    case 3:
+        PMIX_VALUE_LOAD(v, &status, PMIX_STATUS);
+        break;
+    case 4:
+        PMIX_VALUE_LOAD(v, "pmix.bench.string", PMIX_STRING);
+        break;
+    case 5:
+        PMIX_LOAD_PROCID(&proc, "valuebench", 7);
+        PMIX_VALUE_LOAD(v, &proc, PMIX_PROC);
+        break;
+    case 6:
+        bo.bytes = "0123456789abcdef0123456789abcdef";
+        bo.size = 32;
+        PMIX_VALUE_LOAD(v, &bo, PMIX_BYTE_OBJECT);
+        break;
+    default:
+        darray.type = PMIX_UINT32;
+        darray.size = 4;
+        darray.array = vals;
+        PMIX_VALUE_LOAD(v, &darray, PMIX_DATA_ARRAY);
+        break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *names[VALUEBENCH_NTYPES] = {"bool", "uint32", "size", "status",
+                                            "string", "proc", "byte_object", "data_array"};
+    pmix_value_t v1, v2, copy;
+    size_t ncalls = 1000000, n;
+    int iters = 5, i, t, opt, errors = 0;
+    double t0, dt, cmp[VALUEBENCH_NTYPES], xfer[VALUEBENCH_NTYPES];
+
+    while (-1 != (opt = getopt(argc, argv, "n:i:h"))) {
+        switch (opt) {
+        case 'n':
+            ncalls = strtoul(optarg, NULL, 10);
+            break;
+        case 'i':
+            iters = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n calls] [-i iterations]\n", argv[0]);
+            exit(1);
+        }
+    }
+    if (0 == ncalls || 0 >= iters) {
+        fprintf(stderr, "%s: bad arguments\n", argv[0]);
+        exit(1);
+    }
+
+    for (t = 0; t < VALUEBENCH_NTYPES; t++) {
+        PMIX_VALUE_CONSTRUCT(&v1);
+        PMIX_VALUE_CONSTRUCT(&v2);
+        load(&v1, t);
+        load(&v2, t);
+        cmp[t] = -1.0;
+        xfer[t] = -1.0;
+        for (i = 0; i < iters; i++) {
+            t0 = now();
+            for (n = 0; n < ncalls; n++) {
+                if (PMIX_EQUAL != PMIx_Value_compare(&v1, &v2)) {
+                    ++errors;
+                }
+            }
+            dt = (now() - t0) / (double) ncalls;
+            if (cmp[t] < 0.0 || dt < cmp[t]) {
+                cmp[t] = dt;
+            }
+
+            t0 = now();
+            for (n = 0; n < ncalls; n++) {
+                if (PMIX_SUCCESS != PMIx_Value_xfer(&copy, &v1)) {
+                    ++errors;
+                }
+                PMIx_Value_destruct(&copy);
+            }
+            dt = (now() - t0) / (double) ncalls;
+            if (xfer[t] < 0.0 || dt < xfer[t]) {
+                xfer[t] = dt;
+            }
+        }
+        PMIX_VALUE_DESTRUCT(&v1);
+        PMIX_VALUE_DESTRUCT(&v2);
+    }
+
+    printf("{\"benchmark\": \"value_ops\", \"calls\": %lu, \"iterations\": %d, \"errors\": %d, "
+           "\"ns_per_call\": {", (unsigned long) ncalls, iters, errors);
+    for (t = 0; t < VALUEBENCH_NTYPES; t++) {
+        printf("%s\"%s\": {\"compare\": %.2f, \"xfer\": %.2f}", (0 == t) ? "" : ", ", names[t],
+               cmp[t], xfer[t]);
+    }
+    printf("}}\n");
+
+    return (0 == errors) ? 0 : 1;
+}
@@ -27,6 +27,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "src/mca/preg/preg.h"
@@ -42,13 +44,85 @@
 #define TEST_PROCS  "1,2,3,4;5-8;9,11-12;17-20;21-24;100"
 #define TEST_NODES2 "c712f6n01,c712f6n02,c712f6n03"
 
+/* TEST_PROCS written out in full, and as arrays */
+#define TEST_PROCS_FULL "1,2,3,4;5,6,7,8;9,11,12;17,18,19,20;21,22,23,24;100"
+static const pmix_rank_t test_node0[] = {1, 2, 3, 4};
+static const pmix_rank_t test_node1[] = {5, 6, 7, 8};
+static const pmix_rank_t test_node2[] = {9, 11, 12};
+static const pmix_rank_t test_node3[] = {17, 18, 19, 20};
+static const pmix_rank_t test_node4[] = {21, 22, 23, 24};
+static const pmix_rank_t test_node5[] = {100};
+static const pmix_rank_t *test_ranks[] = {test_node0, test_node1, test_node2,
+                                          test_node3, test_node4, test_node5};
+static const size_t test_nranks[] = {4, 4, 3, 4, 4, 1};
+
 bool spawn_wait = false;
 
+/* time the generation of the regex for an allocation of nnodes
+ * nodes, listed in the random order a scheduler may hand them
+ * over, and check that it unpacks to the same list */
+static int regex_bench(int nnodes)
+{
+    char **names = NULL, **nodes, *input, *regex, tmp[64];
+    struct timespec t0, t1;
+    pmix_status_t rc;
+    int i, j, errors = 0;
+    double dt;
+
+    for (i = 0; i < nnodes; i++) {
+        snprintf(tmp, sizeof(tmp), "node%05d", i);
+        pmix_argv_append_nosize(&names, tmp);
+    }
+    srand(12345);
+    for (i = nnodes - 1; 0 < i; i--) {
+        j = rand() % (i + 1);
+        input = names[i];
+        names[i] = names[j];
+        names[j] = input;
+    }
+    input = pmix_argv_join(names, ',');
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    rc = PMIx_generate_regex(input, &regex);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    dt = (double) (t1.tv_sec - t0.tv_sec) * 1.0e3 + (double) (t1.tv_nsec - t0.tv_nsec) / 1.0e6;
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "Regex generation failed: %d\n", rc);
+        ++errors;
+    } else {
+        rc = pmix_preg.parse_nodes(regex, &nodes);
+        free(regex);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "Node reverse failed: %d\n", rc);
+            ++errors;
+        } else {
+            regex = pmix_argv_join(nodes, ',');
+            if (0 != strcmp(regex, input)) {
+                fprintf(stderr, "Node reverse does not match the input\n");
+                ++errors;
+            }
+            free(regex);
+            pmix_argv_free(nodes);
+        }
+    }
+    fprintf(stderr, "REGEX: %d unsorted nodes in %.3f msecs\n", nnodes, dt);
+
+    free(input);
+    pmix_argv_free(names);
+    return errors;
+}
+
 int main(int argc, char **argv)
 {
-    char *regex;
+    char *regex, *regex2;
     char **nodes, **procs;
     pmix_status_t rc;
+    int nnodes = 0;
+
+    /* optionally time a large allocation */
+    if (2 < argc && 0 == strcmp(argv[1], "-n")) {
+        nnodes = atoi(argv[2]);
+    }
 
     /* smoke test */
     if (PMIX_SUCCESS != 0) {
@@ -94,6 +168,31 @@ int main(int argc, char **argv)
         fprintf(stderr, "PPN reverse failed: %d\n", rc);
     }
 
+    /* the array form must describe the same procs */
+    PMIx_generate_ppn(TEST_PROCS_FULL, &regex);
+    rc = PMIx_generate_ppn_ranks(test_ranks, test_nranks, 6, &regex2);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PPN from ranks failed: %d\n", rc);
+        return 1;
+    }
+    procs = NULL;
+    rc = pmix_preg.parse_procs(regex, &procs);
+    free(regex);
+    regex = (PMIX_SUCCESS == rc) ? pmix_argv_join(procs, ';') : NULL;
+    pmix_argv_free(procs);
+    procs = NULL;
+    rc = pmix_preg.parse_procs(regex2, &procs);
+    free(regex2);
+    regex2 = (PMIX_SUCCESS == rc) ? pmix_argv_join(procs, ';') : NULL;
+    pmix_argv_free(procs);
+    if (NULL == regex || NULL == regex2 || 0 != strcmp(regex, regex2)) {
+        fprintf(stderr, "PPN from ranks differs: %s\n", (NULL == regex2) ? "NULL" : regex2);
+        return 1;
+    }
+    fprintf(stderr, "PPN FROM RANKS: %s\n\n", regex2);
+    free(regex);
+    free(regex2);
+
     fprintf(stderr, "NODES: %s\n", TEST_NODES2);
     PMIx_generate_regex(TEST_NODES2, &regex);
     fprintf(stderr, "REGEX: %s\n\n", regex);
@@ -109,5 +208,9 @@ int main(int argc, char **argv)
     } else {
         fprintf(stderr, "Node reverse failed: %d\n\n\n", rc);
     }
+
+    if (0 < nnodes && 0 != regex_bench(nnodes)) {
+        return 1;
+    }
     return 0;
 }
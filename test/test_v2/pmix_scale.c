@@ -0,0 +1,625 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Scale harness for a single server. Starts a real PMIx server in
+ * this process and connects N emulated clients to it, each running
+ * as a thread that speaks the PTL protocol over its own socket -
+ * the same connect handshake and packed commands a client library
+ * would send. This lets us drive thousands of "clients" against one
+ * server on one box without launching a process for each, and time
+ * the phases where scaling cliffs show up:
+ *
+ *    connect   all clients connect and handshake at once
+ *    fence     every client joins a job-wide fence, -f times
+ *    get       every client asks the server for a job-level key, -g times
+ *    events    the host notifies the local clients of -e events
+ *    finalize  every client finalizes and disconnects
+ *
+ *    pmix_scale -n 4096 -f 10 -g 10 -e 100
+ *
+ * The time of each phase is printed in msecs as one JSON object. The
+ * clients do not run the client library, so they hold no data of
+ * their own - a get is answered from the job info the server holds.
+ */
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pmix_server.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/psec/psec.h"
+#include "src/mca/ptl/base/base.h"
+#include "src/threads/pmix_threads.h"
+#include "src/util/pmix_argv.h"
+
+#define SCALE_NSPACE "pmix-scale"
+#define SCALE_EVENT  (PMIX_EXTERNAL_ERR_BASE - 11)
+
+typedef struct {
+    pthread_t thread;
+    pmix_rank_t rank;
+    int sd;
+    int32_t pindex;
+    uint32_t tag;
+    int events;
+    int errors;
+} scale_client_t;
+
+static pthread_barrier_t barrier;
+static char *server_uri = NULL;
+static pmix_byte_object_t cred;
+static int nfences = 10, ngets = 10, nevents = 100;
+static volatile int failed = 0;
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1.0e3 + (double) ts.tv_nsec / 1.0e6;
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_lock_t *lock = (pmix_lock_t *) cbdata;
+
+    lock->status = status;
+    PMIX_WAKEUP_THREAD(lock);
+}
+
+static void noop(pmix_status_t status, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(status, cbdata);
+}
+
+static void release_data(void *cbdata)
+{
+    free(cbdata);
+}
+
+/* the only host in the job is us - hand the local data straight
+ * back, it is ours to release */
+static pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
+                                const pmix_info_t info[], size_t ninfo, char *data,
+                                size_t ndata, pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    PMIX_HIDE_UNUSED_PARAMS(procs, nprocs, info, ninfo);
+
+    cbfunc(PMIX_SUCCESS, data, ndata, cbdata, release_data, data);
+    return PMIX_SUCCESS;
+}
+
+static pmix_server_module_t scale_module = {
+    .fence_nb = fencenb_fn
+};
+
+/* the connect handshake of a simple client */
+static pmix_status_t connect_client(scale_client_t *c)
+{
+    struct sockaddr_storage addr;
+    size_t len, csize = 0;
+    char *nspace = NULL, *suri = NULL, *msg;
+    char *sec, *bfrops, *gds = "hash";
+    uint8_t flag = PMIX_SIMPLE_CLIENT, bftype;
+    pmix_ptl_hdr_t hdr;
+    pmix_rank_t rank;
+    uint32_t u32;
+    pmix_status_t rc;
+
+    rc = pmix_ptl_base_parse_uri(server_uri, &nspace, &rank, &suri);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = pmix_ptl_base_setup_connection(suri, &addr, &len);
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_ptl_base_connect(&addr, len, &c->sd);
+    }
+    free(nspace);
+    free(suri);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    sec = pmix_globals.mypeer->nptr->compat.psec->name;
+    bfrops = pmix_globals.mypeer->nptr->compat.bfrops->version;
+    bftype = pmix_globals.mypeer->nptr->compat.type;
+
+    memset(&hdr, 0, sizeof(pmix_ptl_hdr_t));
+    hdr.pindex = -1;
+    hdr.tag = UINT32_MAX;
+    hdr.nbytes = strlen(sec) + 1 + sizeof(uint32_t) + cred.size + 1
+                 + strlen(SCALE_NSPACE) + 1 + sizeof(uint32_t) + strlen(PMIX_VERSION) + 1
+                 + strlen(bfrops) + 1 + 1 + strlen(gds) + 1;
+    msg = (char *) calloc(1, sizeof(hdr) + hdr.nbytes);
+    if (NULL == msg) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(msg, &hdr, sizeof(pmix_ptl_hdr_t));
+    csize += sizeof(pmix_ptl_hdr_t);
+    PMIX_PTL_PUT_STRING(sec);
+    PMIX_PTL_PUT_U32(cred.size);
+    PMIX_PTL_PUT_BLOB(cred.bytes, cred.size);
+    PMIX_PTL_PUT_U8(flag);
+    PMIX_PTL_PUT_STRING(SCALE_NSPACE);
+    PMIX_PTL_PUT_U32(c->rank);
+    PMIX_PTL_PUT_STRING(PMIX_VERSION);
+    PMIX_PTL_PUT_STRING(bfrops);
+    PMIX_PTL_PUT_U8(bftype);
+    PMIX_PTL_PUT_STRING(gds);
+
+    rc = pmix_ptl_base_send_blocking(c->sd, msg, csize);
+    free(msg);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    /* the server's verdict, then our index in its client array */
+    rc = pmix_ptl_base_recv_blocking(c->sd, (char *) &u32, sizeof(uint32_t));
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = ntohl(u32))) {
+        return rc;
+    }
+    rc = pmix_ptl_base_recv_blocking(c->sd, (char *) &u32, sizeof(uint32_t));
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    c->pindex = ntohl(u32);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t send_cmd(scale_client_t *c, pmix_buffer_t *buf)
+{
+    pmix_ptl_hdr_t hdr;
+    pmix_status_t rc;
+
+    rc = pmix_bfrops_base_buffer_flatten(buf);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    memset(&hdr, 0, sizeof(pmix_ptl_hdr_t));
+    hdr.pindex = htonl(c->pindex);
+    hdr.tag = htonl(++c->tag);
+    hdr.nbytes = htonl(buf->bytes_used);
+    rc = pmix_ptl_base_send_blocking(c->sd, (char *) &hdr, sizeof(pmix_ptl_hdr_t));
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_ptl_base_send_blocking(c->sd, buf->base_ptr, buf->bytes_used);
+    }
+    return rc;
+}
+
+/* read messages until the one with the given tag arrives, counting
+ * any event notifications that come in before it. Returns the
+ * status at the front of the reply */
+static pmix_status_t recv_msg(scale_client_t *c, uint32_t tag)
+{
+    pmix_ptl_hdr_t hdr;
+    pmix_buffer_t buf;
+    pmix_status_t rc, ret;
+    char *data;
+    int32_t cnt = 1;
+
+    while (1) {
+        rc = pmix_ptl_base_recv_blocking(c->sd, (char *) &hdr, sizeof(pmix_ptl_hdr_t));
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        hdr.tag = ntohl(hdr.tag);
+        hdr.nbytes = ntohl(hdr.nbytes);
+        data = NULL;
+        if (0 < hdr.nbytes) {
+            data = (char *) malloc(hdr.nbytes);
+            if (NULL == data) {
+                return PMIX_ERR_NOMEM;
+            }
+            rc = pmix_ptl_base_recv_blocking(c->sd, data, hdr.nbytes);
+            if (PMIX_SUCCESS != rc) {
+                free(data);
+                return rc;
+            }
+        }
+        if (PMIX_PTL_TAG_NOTIFY == hdr.tag) {
+            ++c->events;
+        }
+        if (tag != hdr.tag) {
+            free(data);
+            continue;
+        }
+        if (NULL == data) {
+            return PMIX_SUCCESS;
+        }
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(pmix_globals.mypeer, &buf, data, hdr.nbytes);
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &buf, &ret, &cnt, PMIX_STATUS);
+        PMIX_DESTRUCT(&buf);
+        return (PMIX_SUCCESS == rc) ? ret : rc;
+    }
+}
+
+/* send a command and wait for its reply */
+static pmix_status_t sendrecv(scale_client_t *c, pmix_buffer_t *buf)
+{
+    pmix_status_t rc;
+
+    if (NULL == buf) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = send_cmd(c, buf);
+    PMIX_RELEASE(buf);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    return recv_msg(c, c->tag);
+}
+
+static pmix_buffer_t *pack_cmd(pmix_cmd_t cmd)
+{
+    pmix_buffer_t *buf;
+    pmix_status_t rc;
+
+    buf = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(buf);
+        return NULL;
+    }
+    return buf;
+}
+
+#define SCALE_PACK(b, d, n, t)                                          \
+    do {                                                                \
+        pmix_status_t _rc;                                              \
+        PMIX_BFROPS_PACK(_rc, pmix_globals.mypeer, (b), (d), (n), (t)); \
+        if (PMIX_SUCCESS != _rc) {                                      \
+            PMIX_RELEASE(b);                                            \
+            return _rc;                                                 \
+        }                                                               \
+    } while (0)
+
+static pmix_status_t fence(scale_client_t *c)
+{
+    pmix_buffer_t *buf;
+    pmix_proc_t proc;
+    size_t n = 1, ninfo = 0;
+
+    if (NULL == (buf = pack_cmd(PMIX_FENCENB_CMD))) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LOAD_PROCID(&proc, SCALE_NSPACE, PMIX_RANK_WILDCARD);
+    SCALE_PACK(buf, &n, 1, PMIX_SIZE);
+    SCALE_PACK(buf, &proc, 1, PMIX_PROC);
+    SCALE_PACK(buf, &ninfo, 1, PMIX_SIZE);
+    return sendrecv(c, buf);
+}
+
+static pmix_status_t get(scale_client_t *c)
+{
+    pmix_buffer_t *buf;
+    char *nspace = SCALE_NSPACE, *key = PMIX_JOB_SIZE;
+    pmix_rank_t rank = PMIX_RANK_WILDCARD;
+    size_t ninfo = 0;
+
+    if (NULL == (buf = pack_cmd(PMIX_GETNB_CMD))) {
+        return PMIX_ERR_NOMEM;
+    }
+    SCALE_PACK(buf, &nspace, 1, PMIX_STRING);
+    SCALE_PACK(buf, &rank, 1, PMIX_PROC_RANK);
+    SCALE_PACK(buf, &ninfo, 1, PMIX_SIZE);
+    SCALE_PACK(buf, &key, 1, PMIX_STRING);
+    return sendrecv(c, buf);
+}
+
+static pmix_status_t register_event(scale_client_t *c)
+{
+    pmix_buffer_t *buf;
+    pmix_status_t code = SCALE_EVENT;
+    size_t n = 1, ninfo = 0;
+
+    if (NULL == (buf = pack_cmd(PMIX_REGEVENTS_CMD))) {
+        return PMIX_ERR_NOMEM;
+    }
+    SCALE_PACK(buf, &n, 1, PMIX_SIZE);
+    SCALE_PACK(buf, &code, 1, PMIX_STATUS);
+    SCALE_PACK(buf, &ninfo, 1, PMIX_SIZE);
+    return sendrecv(c, buf);
+}
+
+/* wait for all the notifications of the event phase - the tag of
+ * an event is never used for a reply, so read until we have them */
+static pmix_status_t wait_events(scale_client_t *c)
+{
+    pmix_ptl_hdr_t hdr;
+    pmix_status_t rc;
+    char *data;
+
+    while (c->events < nevents) {
+        rc = pmix_ptl_base_recv_blocking(c->sd, (char *) &hdr, sizeof(pmix_ptl_hdr_t));
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        hdr.nbytes = ntohl(hdr.nbytes);
+        if (0 < hdr.nbytes) {
+            data = (char *) malloc(hdr.nbytes);
+            if (NULL == data) {
+                return PMIX_ERR_NOMEM;
+            }
+            rc = pmix_ptl_base_recv_blocking(c->sd, data, hdr.nbytes);
+            free(data);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+        }
+        if (PMIX_PTL_TAG_NOTIFY == ntohl(hdr.tag)) {
+            ++c->events;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* each step is entered and left together by all the clients and
+ * the main thread, which times it */
+#define SCALE_STEP(c, op)                      \
+    do {                                       \
+        pthread_barrier_wait(&barrier);        \
+        if (!failed && PMIX_SUCCESS != (op)) { \
+            ++(c)->errors;                     \
+            failed = 1;                        \
+        }                                      \
+        pthread_barrier_wait(&barrier);        \
+    } while (0)
+
+static void *client_thread(void *arg)
+{
+    scale_client_t *c = (scale_client_t *) arg;
+    int i;
+
+    SCALE_STEP(c, connect_client(c));
+    SCALE_STEP(c, register_event(c));
+    for (i = 0; i < nfences; i++) {
+        SCALE_STEP(c, fence(c));
+    }
+    for (i = 0; i < ngets; i++) {
+        SCALE_STEP(c, get(c));
+    }
+    SCALE_STEP(c, wait_events(c));
+    SCALE_STEP(c, sendrecv(c, pack_cmd(PMIX_FINALIZE_CMD)));
+    if (0 <= c->sd) {
+        close(c->sd);
+    }
+    return NULL;
+}
+
+/* time one step of the clients */
+static double step(pmix_status_t (*fn)(void))
+{
+    double t0;
+
+    pthread_barrier_wait(&barrier);
+    t0 = now();
+    if (NULL != fn && !failed && PMIX_SUCCESS != fn()) {
+        failed = 1;
+    }
+    pthread_barrier_wait(&barrier);
+    return now() - t0;
+}
+
+static pmix_status_t notify(void)
+{
+    pmix_proc_t source;
+    pmix_status_t rc;
+    int i;
+
+    PMIX_LOAD_PROCID(&source, pmix_globals.myid.nspace, pmix_globals.myid.rank);
+    for (i = 0; i < nevents; i++) {
+        rc = PMIx_Notify_event(SCALE_EVENT, &source, PMIX_RANGE_LOCAL, NULL, 0, noop, NULL);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t setup_job(int nclients)
+{
+    pmix_rank_t *ranks;
+    const pmix_rank_t *rptr;
+    size_t nranks = nclients;
+    char hostname[PMIX_MAXHOSTNAMELEN], *regex = NULL, *ppn = NULL, **env = NULL;
+    pmix_info_t *info;
+    pmix_proc_t proc;
+    pmix_lock_t lock;
+    pmix_status_t rc;
+    uint32_t u32 = nclients;
+    int i;
+
+    gethostname(hostname, sizeof(hostname));
+    ranks = (pmix_rank_t *) malloc(nclients * sizeof(pmix_rank_t));
+    if (NULL == ranks) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (i = 0; i < nclients; i++) {
+        ranks[i] = i;
+    }
+    rptr = ranks;
+    PMIx_generate_regex(hostname, &regex);
+    rc = PMIx_generate_ppn_ranks(&rptr, &nranks, 1, &ppn);
+    free(ranks);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    PMIX_INFO_CREATE(info, 5);
+    PMIX_INFO_LOAD(&info[0], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[1], PMIX_UNIV_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[2], PMIX_LOCAL_SIZE, &u32, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[3], PMIX_NODE_MAP, regex, PMIX_REGEX);
+    PMIX_INFO_LOAD(&info[4], PMIX_PROC_MAP, ppn, PMIX_REGEX);
+    free(regex);
+    free(ppn);
+
+    PMIX_CONSTRUCT_LOCK(&lock);
+    rc = PMIx_server_register_nspace(SCALE_NSPACE, nclients, info, 5, opcbfunc, &lock);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_WAIT_THREAD(&lock);
+        rc = lock.status;
+    }
+    PMIX_DESTRUCT_LOCK(&lock);
+    PMIX_INFO_FREE(info, 5);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    for (i = 0; i < nclients; i++) {
+        PMIX_LOAD_PROCID(&proc, SCALE_NSPACE, i);
+        PMIX_CONSTRUCT_LOCK(&lock);
+        rc = PMIx_server_register_client(&proc, geteuid(), getegid(), NULL, opcbfunc, &lock);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_WAIT_THREAD(&lock);
+            rc = lock.status;
+        }
+        PMIX_DESTRUCT_LOCK(&lock);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    /* pick up the server's URI the way a client would */
+    PMIX_LOAD_PROCID(&proc, SCALE_NSPACE, 0);
+    rc = PMIx_server_setup_fork(&proc, &env);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    for (i = 0; NULL != env && NULL != env[i]; i++) {
+        if (0 == strncmp(env[i], "PMIX_SERVER_URI41=", strlen("PMIX_SERVER_URI41="))) {
+            server_uri = strdup(env[i] + strlen("PMIX_SERVER_URI41="));
+            break;
+        }
+    }
+    pmix_argv_free(env);
+    return (NULL == server_uri) ? PMIX_ERR_NOT_FOUND : PMIX_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    scale_client_t *clients;
+    pthread_attr_t attr;
+    struct rlimit rl;
+    pmix_status_t rc;
+    int nclients = 512, i, opt, errors = 0;
+    double t_connect, t_fence = 0.0, t_get = 0.0, t_events, t_finalize;
+
+    while (-1 != (opt = getopt(argc, argv, "n:f:g:e:h"))) {
+        switch (opt) {
+        case 'n':
+            nclients = atoi(optarg);
+            break;
+        case 'f':
+            nfences = atoi(optarg);
+            break;
+        case 'g':
+            ngets = atoi(optarg);
+            break;
+        case 'e':
+            nevents = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-n nclients] [-f nfences] [-g ngets] [-e nevents]\n",
+                    argv[0]);
+            exit(1);
+        }
+    }
+    if (0 >= nclients || 0 > nfences || 0 > ngets || 0 > nevents) {
+        fprintf(stderr, "%s: bad arguments\n", argv[0]);
+        exit(1);
+    }
+
+    /* every client takes a socket at each end */
+    if (0 == getrlimit(RLIMIT_NOFILE, &rl) && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        (void) setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    rc = PMIx_server_init(&scale_module, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s: server init failed: %s\n", argv[0], PMIx_Error_string(rc));
+        exit(1);
+    }
+    rc = setup_job(nclients);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s: job setup failed: %s\n", argv[0], PMIx_Error_string(rc));
+        PMIx_server_finalize();
+        exit(1);
+    }
+    /* every client presents the credential we would */
+    PMIX_BYTE_OBJECT_CONSTRUCT(&cred);
+    PMIX_PSEC_CREATE_CRED(rc, pmix_globals.mypeer, NULL, 0, NULL, 0, &cred);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s: no credential: %s\n", argv[0], PMIx_Error_string(rc));
+        PMIx_server_finalize();
+        exit(1);
+    }
+
+    clients = (scale_client_t *) calloc(nclients, sizeof(scale_client_t));
+    if (NULL == clients) {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        exit(1);
+    }
+    pthread_barrier_init(&barrier, NULL, nclients + 1);
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+    for (i = 0; i < nclients; i++) {
+        clients[i].rank = i;
+        clients[i].sd = -1;
+        clients[i].tag = PMIX_PTL_TAG_DYNAMIC;
+        if (0 != pthread_create(&clients[i].thread, &attr, client_thread, &clients[i])) {
+            fprintf(stderr, "%s: cannot start client %d\n", argv[0], i);
+            exit(1);
+        }
+    }
+    pthread_attr_destroy(&attr);
+
+    t_connect = step(NULL);
+    (void) step(NULL);
+    for (i = 0; i < nfences; i++) {
+        t_fence += step(NULL);
+    }
+    for (i = 0; i < ngets; i++) {
+        t_get += step(NULL);
+    }
+    t_events = step(notify);
+    t_finalize = step(NULL);
+
+    for (i = 0; i < nclients; i++) {
+        pthread_join(clients[i].thread, NULL);
+        errors += clients[i].errors;
+    }
+    if (failed && 0 == errors) {
+        errors = 1;
+    }
+
+    printf("{\"benchmark\": \"server_scale\", \"clients\": %d, \"fences\": %d, \"gets\": %d, "
+           "\"events\": %d, \"errors\": %d, \"msecs\": {\"connect\": %.3f, \"fence\": %.3f, "
+           "\"get\": %.3f, \"events\": %.3f, \"finalize\": %.3f}}\n",
+           nclients, nfences, ngets, nevents, errors, t_connect,
+           (0 < nfences) ? t_fence / nfences : 0.0, (0 < ngets) ? t_get / ngets : 0.0,
+           t_events, t_finalize);
+
+    pthread_barrier_destroy(&barrier);
+    free(clients);
+    PMIX_BYTE_OBJECT_DESTRUCT(&cred);
+    free(server_uri);
+    PMIx_server_finalize();
+    return (0 == errors) ? 0 : 1;
+}
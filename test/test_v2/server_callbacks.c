@@ -144,7 +144,7 @@ pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_in
 
     if ((pmix_list_get_size(server_list) == 1) && (my_server_id == 0)) {
         if (NULL != cbfunc) {
-            cbfunc(PMIX_SUCCESS, data, ndata, cbdata, NULL, NULL);
+            cbfunc(PMIX_SUCCESS, data, ndata, cbdata, free, data);
         }
         return PMIX_SUCCESS;
     }